@@ -19,6 +19,7 @@
 
 #define APP_TRACE_MAX_TX_BUFF_UART          CONFIG_APPTRACE_UART_TX_BUFF_SIZE
 #define APP_TRACE_MAX_TX_MSG_UART           CONFIG_APPTRACE_UART_TX_MSG_SIZE
+#define APP_TRACE_TX_MSG_BLOCKS_UART        CONFIG_APPTRACE_UART_TX_MSG_BLOCKS
 
 /** UART HW transport data */
 typedef struct {
@@ -31,9 +32,9 @@ typedef struct {
     uint8_t *tx_data_buff;
     int32_t tx_data_buff_in;
     int32_t tx_data_buff_out;
-// TX message buffer
+// TX message buffers, each one can be held by a different writer
     uint8_t *tx_msg_buff;
-    uint32_t tx_msg_buff_size;
+    uint32_t tx_msg_buff_size[APP_TRACE_TX_MSG_BLOCKS_UART];
 
 // RX message buffer
     uint8_t *down_buffer;
@@ -148,7 +149,6 @@ static esp_err_t esp_apptrace_send_uart_data(esp_apptrace_uart_data_t *hw_data,
     if (esp_apptrace_uart_unlock(hw_data) != ESP_OK) {
         assert(false && "Failed to unlock apptrace data!");
     }
-
     return ESP_OK;
 }
 
@@ -172,6 +172,7 @@ static void send_buff_data(esp_apptrace_uart_data_t *hw_data, esp_apptrace_tmo_t
 }
 
 #define APP_TRACE_UART_STOP_WAIT_TMO    1000000 //us
+#define APP_TRACE_UART_TX_POLL_TICKS    1
 
 static void esp_apptrace_send_uart_tx_task(void *arg)
 {
@@ -181,8 +182,13 @@ static void esp_apptrace_send_uart_tx_task(void *arg)
 
     vTaskDelay(10);
     while (1) {
-        send_buff_data(hw_data, &tmo);
-        vTaskDelay(10);
+        // Writers don't wake up the task: they may run in the SystemView trace hooks, called by the
+        // scheduler and by the task notification functions. Poll the ring buffer every tick instead.
+        vTaskDelay(APP_TRACE_UART_TX_POLL_TICKS);
+        // Send everything, the data may wrap around the end of the ring buffer
+        while (hw_data->tx_data_buff_in != hw_data->tx_data_buff_out) {
+            send_buff_data(hw_data, &tmo);
+        }
         if (hw_data->circular_buff_overflow == true)
         {
             hw_data->circular_buff_overflow = false;
@@ -208,12 +214,12 @@ static esp_err_t esp_apptrace_uart_init(esp_apptrace_uart_data_t *hw_data)
         }
         hw_data->tx_data_buff_in = 0;
         hw_data->tx_data_buff_out = 0;
-        hw_data->tx_msg_buff =  (uint8_t *)heap_caps_malloc(APP_TRACE_MAX_TX_MSG_UART, MALLOC_CAP_INTERNAL|MALLOC_CAP_8BIT);
+        hw_data->tx_msg_buff =  (uint8_t *)heap_caps_malloc(APP_TRACE_MAX_TX_MSG_UART * APP_TRACE_TX_MSG_BLOCKS_UART, MALLOC_CAP_INTERNAL|MALLOC_CAP_8BIT);
         if (hw_data->tx_msg_buff == NULL)
         {
             return ESP_ERR_NO_MEM;
         }
-        hw_data->tx_msg_buff_size = 0;
+        memset(hw_data->tx_msg_buff_size, 0, sizeof(hw_data->tx_msg_buff_size));
         hw_data->down_buffer_size = 0;
         hw_data->message_buff_overflow = false;
         hw_data->circular_buff_overflow = false;
@@ -254,22 +260,23 @@ static esp_err_t esp_apptrace_uart_init(esp_apptrace_uart_data_t *hw_data)
 
 static uint8_t *esp_apptrace_uart_up_buffer_get(esp_apptrace_uart_data_t *hw_data, uint32_t size, esp_apptrace_tmo_t *tmo)
 {
-    uint8_t *ptr;
+    uint8_t *ptr = NULL;
     if (size > APP_TRACE_MAX_TX_MSG_UART) {
         hw_data->message_buff_overflow = true;
         return NULL;
     }
-    if (hw_data->tx_msg_buff_size != 0)
-    {
-        // A previous message was not sent.
-        return NULL;
-    }
     esp_err_t res = esp_apptrace_uart_lock(hw_data, tmo);
     if (res != ESP_OK) {
         return NULL;
     }
-    ptr = hw_data->tx_msg_buff;
-    hw_data->tx_msg_buff_size = size;
+    for (int i = 0; i < APP_TRACE_TX_MSG_BLOCKS_UART; i++) {
+        if (hw_data->tx_msg_buff_size[i] == 0) {
+            ptr = &hw_data->tx_msg_buff[i * APP_TRACE_MAX_TX_MSG_UART];
+            hw_data->tx_msg_buff_size[i] = size;
+            break;
+        }
+    }
+    // If ptr is NULL, all message buffers are held by writers whose messages were not sent yet.
 
     // now we can safely unlock apptrace to allow other tasks/ISRs to get other buffers and write their data
     if (esp_apptrace_uart_unlock(hw_data) != ESP_OK) {
@@ -280,9 +287,11 @@ static uint8_t *esp_apptrace_uart_up_buffer_get(esp_apptrace_uart_data_t *hw_dat
 
 static esp_err_t esp_apptrace_uart_up_buffer_put(esp_apptrace_uart_data_t *hw_data, uint8_t *ptr, esp_apptrace_tmo_t *tmo)
 {
-    esp_err_t res = esp_apptrace_send_uart_data(hw_data, (const char *)ptr, hw_data->tx_msg_buff_size, tmo);
+    int block = (ptr - hw_data->tx_msg_buff) / APP_TRACE_MAX_TX_MSG_UART;
+    assert(block >= 0 && block < APP_TRACE_TX_MSG_BLOCKS_UART);
+    esp_err_t res = esp_apptrace_send_uart_data(hw_data, (const char *)ptr, hw_data->tx_msg_buff_size[block], tmo);
     // Clear size to indicate that we've sent data
-    hw_data->tx_msg_buff_size = 0;
+    hw_data->tx_msg_buff_size[block] = 0;
     return res;
 }
 
@@ -5,6 +5,7 @@
  */
 
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
@@ -31,9 +32,40 @@
 #include "esp_attr.h"
 #include "esp_bootloader_desc.h"
 #include "esp_flash.h"
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+#include "mbedtls/sha256.h"
+#endif
 
 #define SUB_TYPE_ID(i) (i & 0x0F)
 
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+#define OTA_IMAGE_DIGEST_LEN    32
+#define OTA_IMAGE_CHECKSUM_INIT 0xEF
+
+typedef enum {
+    OTA_STREAM_HEADER,          /* Image header */
+    OTA_STREAM_SEGMENT_HEADER,  /* Header of the next segment */
+    OTA_STREAM_SEGMENT_DATA,    /* Data of the current segment */
+    OTA_STREAM_PADDING,         /* Padding to 16 bytes, ending with the checksum byte */
+    OTA_STREAM_DIGEST,          /* Appended SHA-256 digest */
+    OTA_STREAM_DONE,            /* Whole image received, e.g. a signature may follow */
+    OTA_STREAM_FAILED,          /* Invalid image */
+} ota_stream_state_t;
+
+/* Image layout and digest computed from the data passed to esp_ota_write() */
+typedef struct {
+    ota_stream_state_t state;
+    uint32_t offset;            /* Offset of the next byte in the image */
+    uint32_t remain;            /* Bytes left in the current field */
+    uint8_t segment;            /* Index of the current segment */
+    uint8_t checksum;           /* XOR of the segment data */
+    uint8_t field_len;          /* Bytes received of a header, the padding or the digest */
+    uint8_t field[OTA_IMAGE_DIGEST_LEN];
+    esp_image_header_t header;
+    mbedtls_sha256_context sha;
+} ota_stream_verify_t;
+#endif
+
 /* Partial_data is word aligned so no reallocation is necessary for encrypted flash write */
 typedef struct ota_ops_entry_ {
     uint32_t handle;
@@ -42,6 +74,10 @@ typedef struct ota_ops_entry_ {
     uint32_t wrote_size;
     uint8_t partial_bytes;
     WORD_ALIGNED_ATTR uint8_t partial_data[16];
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+    bool stream_verify;         /* Image written in order by esp_ota_write() */
+    ota_stream_verify_t verify;
+#endif
     LIST_ENTRY(ota_ops_entry_) entries;
 } ota_ops_entry_t;
 
@@ -50,6 +86,15 @@ static LIST_HEAD(ota_ops_entries_head, ota_ops_entry_) s_ota_ops_entries_head =
 
 static uint32_t s_ota_ops_last_handle = 0;
 
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+/* Last image verified by esp_ota_end() while it was written, so that
+ * esp_ota_set_boot_partition() doesn't need to read it back again */
+static struct {
+    uint32_t address;           /* Address of the partition, 0 if none */
+    uint8_t digest[OTA_IMAGE_DIGEST_LEN];
+} s_ota_verified;
+#endif
+
 const static char *TAG = "esp_ota_ops";
 
 /* Return true if this is an OTA app partition */
@@ -101,6 +146,164 @@ static esp_err_t image_validate(const esp_partition_t *partition, esp_image_load
     return ESP_OK;
 }
 
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+static void stream_verify_init(ota_stream_verify_t *v)
+{
+    memset(v, 0, sizeof(ota_stream_verify_t));
+    v->state = OTA_STREAM_HEADER;
+    v->remain = sizeof(esp_image_header_t);
+    v->checksum = OTA_IMAGE_CHECKSUM_INIT;
+    mbedtls_sha256_init(&v->sha);
+    mbedtls_sha256_starts(&v->sha, false);
+}
+
+static void stream_verify_fail(ota_stream_verify_t *v, const char *reason)
+{
+    ESP_LOGE(TAG, "OTA image is invalid at offset 0x%"PRIx32": %s", v->offset, reason);
+    v->state = OTA_STREAM_FAILED;
+}
+
+/* Move to the next segment header, or to the padding after the last segment */
+static void stream_verify_next_segment(ota_stream_verify_t *v)
+{
+    if (v->segment < v->header.segment_count) {
+        v->state = OTA_STREAM_SEGMENT_HEADER;
+        v->remain = sizeof(esp_image_segment_header_t);
+    } else {
+        v->state = OTA_STREAM_PADDING;
+        v->remain = ((v->offset + 1 + 15) & ~15) - v->offset;
+    }
+}
+
+/* Called when the last byte of the current field is received */
+static void stream_verify_field_done(ota_stream_verify_t *v)
+{
+    switch (v->state) {
+    case OTA_STREAM_HEADER:
+        memcpy(&v->header, v->field, sizeof(esp_image_header_t));
+        if (bootloader_common_check_chip_validity(&v->header, ESP_IMAGE_APPLICATION) != ESP_OK) {
+            stream_verify_fail(v, "not built for this chip");
+        } else if (v->header.segment_count > ESP_IMAGE_MAX_SEGMENTS) {
+            stream_verify_fail(v, "too many segments");
+        } else {
+            stream_verify_next_segment(v);
+        }
+        break;
+    case OTA_STREAM_SEGMENT_HEADER: {
+        esp_image_segment_header_t segment;
+        memcpy(&segment, v->field, sizeof(segment));
+        if ((segment.data_len & 3) != 0 || segment.data_len >= 16 * 1024 * 1024) {
+            stream_verify_fail(v, "invalid segment length");
+            break;
+        }
+        v->segment++;
+        if (segment.data_len == 0) {
+            stream_verify_next_segment(v);
+        } else {
+            v->state = OTA_STREAM_SEGMENT_DATA;
+            v->remain = segment.data_len;
+        }
+        break;
+    }
+    case OTA_STREAM_SEGMENT_DATA:
+        stream_verify_next_segment(v);
+        break;
+    case OTA_STREAM_PADDING:
+        if (v->field[v->field_len - 1] != v->checksum) {
+            stream_verify_fail(v, "checksum failed");
+        } else if (v->header.hash_appended) {
+            v->state = OTA_STREAM_DIGEST;
+            v->remain = OTA_IMAGE_DIGEST_LEN;
+        } else {
+            v->state = OTA_STREAM_DONE;
+        }
+        break;
+    case OTA_STREAM_DIGEST:
+        v->state = OTA_STREAM_DONE;
+        break;
+    default:
+        break;
+    }
+    v->field_len = 0;
+}
+
+/* Parse the image layout and update its checksum and digest with the data written in order */
+static void stream_verify_update(ota_stream_verify_t *v, const uint8_t *data, size_t size)
+{
+    while (size > 0 && v->state < OTA_STREAM_DONE) {
+        const size_t len = MIN(size, v->remain);
+
+        if (v->state == OTA_STREAM_SEGMENT_DATA) {
+            for (size_t i = 0; i < len; i++) {
+                v->checksum ^= data[i];
+            }
+        } else {
+            memcpy(v->field + v->field_len, data, len);
+            v->field_len += len;
+        }
+        /* The appended digest covers everything before it */
+        if (v->state != OTA_STREAM_DIGEST) {
+            mbedtls_sha256_update(&v->sha, data, len);
+        }
+
+        data += len;
+        size -= len;
+        v->offset += len;
+        v->remain -= len;
+        if (v->remain == 0) {
+            stream_verify_field_done(v);
+        }
+    }
+}
+
+/* Check the streamed image against the layout read back from the segment headers in flash */
+static esp_err_t stream_verify_finish(ota_stream_verify_t *v, const esp_partition_t *partition)
+{
+    uint8_t digest[OTA_IMAGE_DIGEST_LEN];
+    esp_image_metadata_t data;
+    const esp_partition_pos_t part_pos = {
+        .offset = partition->address,
+        .size = partition->size,
+    };
+
+    if (v->state != OTA_STREAM_DONE) {
+        if (v->state != OTA_STREAM_FAILED) {
+            stream_verify_fail(v, "image is truncated");
+        }
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    mbedtls_sha256_finish(&v->sha, digest);
+    if (v->header.hash_appended && memcmp(digest, v->field, OTA_IMAGE_DIGEST_LEN) != 0) {
+        ESP_LOGE(TAG, "OTA image hash failed");
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    /* Checks the mapping of the segments and that the image fits in the partition */
+    if (esp_image_get_metadata(&part_pos, &data) != ESP_OK || data.image_len != v->offset
+            || (v->header.hash_appended && memcmp(data.image_digest, digest, OTA_IMAGE_DIGEST_LEN) != 0)) {
+        ESP_LOGE(TAG, "OTA image in flash doesn't match the written image");
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    return ESP_OK;
+}
+
+/* Check that the image in the partition is still the one verified by esp_ota_end(),
+   only the segment headers and the appended digest are read back from flash */
+static bool stream_verified_image_matches(const esp_partition_t *partition)
+{
+    esp_image_metadata_t data;
+    const esp_partition_pos_t part_pos = {
+        .offset = partition->address,
+        .size = partition->size,
+    };
+
+    if (s_ota_verified.address == 0 || s_ota_verified.address != partition->address) {
+        return false;
+    }
+    return esp_image_get_metadata(&part_pos, &data) == ESP_OK && data.image.hash_appended
+           && memcmp(data.image_digest, s_ota_verified.digest, OTA_IMAGE_DIGEST_LEN) == 0;
+}
+#endif // CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+
 static esp_ota_img_states_t set_new_state_otadata(void)
 {
 #ifdef CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE
@@ -144,6 +347,12 @@ esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp
     }
 #endif
 
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+    if (s_ota_verified.address == partition->address) {
+        s_ota_verified.address = 0;
+    }
+#endif
+
     if (image_size != OTA_WITH_SEQUENTIAL_WRITES) {
         // If input image size is 0 or OTA_SIZE_UNKNOWN, erase entire partition
         if ((image_size == 0) || (image_size == OTA_SIZE_UNKNOWN)) {
@@ -167,6 +376,10 @@ esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp
     new_entry->part = partition;
     new_entry->handle = ++s_ota_ops_last_handle;
     new_entry->need_erase = (image_size == OTA_WITH_SEQUENTIAL_WRITES);
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+    new_entry->stream_verify = true;
+    stream_verify_init(&new_entry->verify);
+#endif
     *out_handle = new_entry->handle;
     return ESP_OK;
 }
@@ -211,6 +424,12 @@ esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
                 return ESP_ERR_OTA_VALIDATE_FAILED;
             }
 
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+            if (it->stream_verify) {
+                stream_verify_update(&it->verify, data_bytes, size);
+            }
+#endif
+
             if (esp_flash_encryption_enabled()) {
                 /* Can only write 16 byte blocks to flash, so need to cache anything else */
                 size_t copy_len;
@@ -226,6 +445,9 @@ esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
                     /* write 16 byte to partition */
                     ret = esp_partition_write(it->part, it->wrote_size, it->partial_data, 16);
                     if (ret != ESP_OK) {
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+                        it->stream_verify = false;
+#endif
                         return ret;
                     }
                     it->partial_bytes = 0;
@@ -247,6 +469,12 @@ esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t size)
             if(ret == ESP_OK){
                 it->wrote_size += size;
             }
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+            if (ret != ESP_OK) {
+                /* The data may be written again, verify the image from flash in esp_ota_end() */
+                it->stream_verify = false;
+            }
+#endif
             return ret;
         }
     }
@@ -280,6 +508,10 @@ esp_err_t esp_ota_write_with_offset(esp_ota_handle_t handle, const void *data, s
                 ESP_LOGE(TAG, "Size should be 16byte aligned for flash encryption case");
                 return ESP_ERR_INVALID_ARG;
             }
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+            /* The data may not be in order, verify the image from flash in esp_ota_end() */
+            it->stream_verify = false;
+#endif
             ret = esp_partition_write(it->part, offset, data_bytes, size);
             if (ret == ESP_OK) {
                 it->wrote_size += size;
@@ -312,6 +544,9 @@ esp_err_t esp_ota_abort(esp_ota_handle_t handle)
         return ESP_ERR_NOT_FOUND;
     }
     LIST_REMOVE(it, entries);
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+    mbedtls_sha256_free(&it->verify.sha);
+#endif
     free(it);
     return ESP_OK;
 }
@@ -344,6 +579,19 @@ esp_err_t esp_ota_end(esp_ota_handle_t handle)
         it->partial_bytes = 0;
     }
 
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+    if (it->stream_verify) {
+        ret = stream_verify_finish(&it->verify, it->part);
+#if CONFIG_APP_UPDATE_VERIFY_READBACK
+        if (ret != ESP_OK) {
+            goto cleanup;
+        }
+#else
+        goto cleanup;
+#endif
+    }
+#endif
+
     esp_image_metadata_t data;
     const esp_partition_pos_t part_pos = {
       .offset = it->part->address,
@@ -357,6 +605,14 @@ esp_err_t esp_ota_end(esp_ota_handle_t handle)
 
  cleanup:
     LIST_REMOVE(it, entries);
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+    if (ret == ESP_OK && it->stream_verify && it->verify.header.hash_appended) {
+        /* The digest was checked against the one in flash by stream_verify_finish() */
+        s_ota_verified.address = it->part->address;
+        memcpy(s_ota_verified.digest, it->verify.field, OTA_IMAGE_DIGEST_LEN);
+    }
+    mbedtls_sha256_free(&it->verify.sha);
+#endif
     free(it);
     return ret;
 }
@@ -440,7 +696,11 @@ esp_err_t esp_ota_set_boot_partition(const esp_partition_t *partition)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (image_validate(partition, ESP_IMAGE_VERIFY) != ESP_OK) {
+    bool verified = false;
+#if CONFIG_APP_UPDATE_VERIFY_ON_WRITE
+    verified = stream_verified_image_matches(partition);
+#endif
+    if (!verified && image_validate(partition, ESP_IMAGE_VERIFY) != ESP_OK) {
         return ESP_ERR_OTA_VALIDATE_FAILED;
     }
 
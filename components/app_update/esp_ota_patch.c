@@ -0,0 +1,314 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_ota_ops.h"
+#include "esp_ota_patch.h"
+#include "miniz.h"
+
+/*
+An OTA patch is a 64 byte header followed by the payload. The payload is either the app image itself or a delta against
+the running app, and it's optionally compressed as a zlib stream, decompressed with the miniz inflater in ROM.
+
+A delta is a sequence of commands which copy bytes from the running app partition or insert new bytes. The resulting
+image is produced in order, so it's written with esp_ota_write() as the patch is received and esp_ota_end() verifies
+it like a full image.
+*/
+
+#define COPY_BUF_SIZE       1024
+#define COPY_CMD_SIZE       9
+#define INSERT_CMD_SIZE     5
+
+struct esp_ota_patch {
+    esp_ota_handle_t ota_handle;
+    esp_err_t err;
+    esp_ota_patch_header_t header;
+    size_t header_len;
+    uint32_t image_len;
+    // decompression
+    tinfl_decompressor *inflator;
+    uint8_t *dict;
+    size_t dict_pos;
+    bool inflate_done;
+    // delta
+    const esp_partition_t *base;
+    uint8_t *copy_buf;
+    uint8_t cmd[COPY_CMD_SIZE];
+    size_t cmd_len;
+    uint32_t insert_left;
+};
+
+const static char *TAG = "esp_ota_patch";
+
+static inline uint32_t get_le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static esp_err_t write_image(esp_ota_patch_handle_t h, const uint8_t *data, size_t size)
+{
+    if (size > h->header.image_size - h->image_len) {
+        ESP_LOGE(TAG, "Patch produces more than %" PRIu32 " bytes", h->header.image_size);
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    esp_err_t err = esp_ota_write(h->ota_handle, data, size);
+    if (err == ESP_OK) {
+        h->image_len += size;
+    }
+    return err;
+}
+
+static esp_err_t copy_from_base(esp_ota_patch_handle_t h, uint32_t offset, uint32_t size)
+{
+    if (offset > h->base->size || size > h->base->size - offset) {
+        ESP_LOGE(TAG, "Copy of 0x%" PRIx32 " bytes at 0x%" PRIx32 " is outside of the running partition", size, offset);
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    while (size > 0) {
+        size_t chunk = MIN(size, COPY_BUF_SIZE);
+        esp_err_t err = esp_partition_read(h->base, offset, h->copy_buf, chunk);
+        if (err != ESP_OK) {
+            return err;
+        }
+        err = write_image(h, h->copy_buf, chunk);
+        if (err != ESP_OK) {
+            return err;
+        }
+        offset += chunk;
+        size -= chunk;
+    }
+    return ESP_OK;
+}
+
+/* Process the decompressed payload: the image itself, or the commands of a delta */
+static esp_err_t process_payload(esp_ota_patch_handle_t h, const uint8_t *data, size_t size)
+{
+    if (!(h->header.flags & ESP_OTA_PATCH_FLAG_DELTA)) {
+        return write_image(h, data, size);
+    }
+
+    while (size > 0) {
+        if (h->insert_left > 0) {
+            size_t chunk = MIN(size, h->insert_left);
+            esp_err_t err = write_image(h, data, chunk);
+            if (err != ESP_OK) {
+                return err;
+            }
+            h->insert_left -= chunk;
+            data += chunk;
+            size -= chunk;
+            continue;
+        }
+
+        // commands can be split between writes, they're collected in h->cmd
+        h->cmd[h->cmd_len++] = *data++;
+        size--;
+        size_t cmd_size;
+        if (h->cmd[0] == ESP_OTA_PATCH_CMD_COPY) {
+            cmd_size = COPY_CMD_SIZE;
+        } else if (h->cmd[0] == ESP_OTA_PATCH_CMD_INSERT) {
+            cmd_size = INSERT_CMD_SIZE;
+        } else {
+            ESP_LOGE(TAG, "Invalid delta command 0x%02x", h->cmd[0]);
+            return ESP_ERR_OTA_VALIDATE_FAILED;
+        }
+        if (h->cmd_len < cmd_size) {
+            continue;
+        }
+        h->cmd_len = 0;
+        if (h->cmd[0] == ESP_OTA_PATCH_CMD_COPY) {
+            esp_err_t err = copy_from_base(h, get_le32(&h->cmd[1]), get_le32(&h->cmd[5]));
+            if (err != ESP_OK) {
+                return err;
+            }
+        } else {
+            h->insert_left = get_le32(&h->cmd[1]);
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t inflate_payload(esp_ota_patch_handle_t h, const uint8_t *data, size_t size)
+{
+    if (h->inflate_done) {
+        ESP_LOGE(TAG, "Data after the end of the compressed payload");
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+
+    while (true) {
+        size_t in_bytes = size;
+        size_t out_bytes = TINFL_LZ_DICT_SIZE - h->dict_pos;
+        // the output wraps around the dictionary, which holds the last 32 KB of decompressed data
+        tinfl_status status = tinfl_decompress(h->inflator, data, &in_bytes, h->dict, h->dict + h->dict_pos, &out_bytes,
+                                               TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_HAS_MORE_INPUT);
+        data += in_bytes;
+        size -= in_bytes;
+        if (out_bytes > 0) {
+            esp_err_t err = process_payload(h, h->dict + h->dict_pos, out_bytes);
+            if (err != ESP_OK) {
+                return err;
+            }
+            h->dict_pos = (h->dict_pos + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+        }
+
+        if (status < TINFL_STATUS_DONE) {
+            ESP_LOGE(TAG, "Decompression failed (%d)", status);
+            return ESP_ERR_OTA_VALIDATE_FAILED;
+        } else if (status == TINFL_STATUS_DONE) {
+            h->inflate_done = true;
+            if (size > 0) {
+                ESP_LOGE(TAG, "Data after the end of the compressed payload");
+                return ESP_ERR_OTA_VALIDATE_FAILED;
+            }
+            return ESP_OK;
+        } else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && size == 0) {
+            return ESP_OK;
+        }
+    }
+}
+
+static esp_err_t check_header(esp_ota_patch_handle_t h)
+{
+    const esp_ota_patch_header_t *header = &h->header;
+
+    if (header->magic != ESP_OTA_PATCH_MAGIC) {
+        ESP_LOGE(TAG, "Invalid patch magic 0x%08" PRIx32, header->magic);
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    if (header->version != ESP_OTA_PATCH_VERSION) {
+        ESP_LOGE(TAG, "Unsupported patch version %d", header->version);
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    if (header->flags & ~(ESP_OTA_PATCH_FLAG_COMPRESSED | ESP_OTA_PATCH_FLAG_DELTA)) {
+        ESP_LOGE(TAG, "Unsupported patch flags 0x%02x", header->flags);
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+
+    if (header->flags & ESP_OTA_PATCH_FLAG_DELTA) {
+        uint8_t digest[32];
+        h->base = esp_ota_get_running_partition();
+        esp_err_t err = esp_partition_get_sha256(h->base, digest);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (memcmp(digest, header->base_digest, sizeof(digest)) != 0) {
+            ESP_LOGE(TAG, "Patch doesn't apply to the running app");
+            return ESP_ERR_OTA_VALIDATE_FAILED;
+        }
+        h->copy_buf = malloc(COPY_BUF_SIZE);
+        if (h->copy_buf == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    if (header->flags & ESP_OTA_PATCH_FLAG_COMPRESSED) {
+        h->inflator = malloc(sizeof(tinfl_decompressor));
+        h->dict = malloc(TINFL_LZ_DICT_SIZE);
+        if (h->inflator == NULL || h->dict == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        tinfl_init(h->inflator);
+    }
+
+    ESP_LOGI(TAG, "Applying %s%s patch, image size %" PRIu32, (header->flags & ESP_OTA_PATCH_FLAG_COMPRESSED) ? "compressed " : "",
+             (header->flags & ESP_OTA_PATCH_FLAG_DELTA) ? "delta" : "full image", header->image_size);
+    return ESP_OK;
+}
+
+static void free_patch(esp_ota_patch_handle_t h)
+{
+    free(h->inflator);
+    free(h->dict);
+    free(h->copy_buf);
+    free(h);
+}
+
+esp_err_t esp_ota_patch_begin(esp_ota_handle_t ota_handle, esp_ota_patch_handle_t *out_handle)
+{
+    if (out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_ota_patch_handle_t h = calloc(1, sizeof(struct esp_ota_patch));
+    if (h == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    h->ota_handle = ota_handle;
+    *out_handle = h;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_patch_write(esp_ota_patch_handle_t handle, const void *data, size_t size)
+{
+    if (handle == NULL || data == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->err != ESP_OK) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uint8_t *p = data;
+    esp_err_t err = ESP_OK;
+    if (handle->header_len < sizeof(esp_ota_patch_header_t)) {
+        size_t chunk = MIN(size, sizeof(esp_ota_patch_header_t) - handle->header_len);
+        memcpy((uint8_t *)&handle->header + handle->header_len, p, chunk);
+        handle->header_len += chunk;
+        p += chunk;
+        size -= chunk;
+        if (handle->header_len == sizeof(esp_ota_patch_header_t)) {
+            err = check_header(handle);
+        }
+    }
+
+    if (err == ESP_OK && size > 0) {
+        if (handle->header.flags & ESP_OTA_PATCH_FLAG_COMPRESSED) {
+            err = inflate_payload(handle, p, size);
+        } else {
+            err = process_payload(handle, p, size);
+        }
+    }
+    handle->err = err;
+    return err;
+}
+
+esp_err_t esp_ota_patch_end(esp_ota_patch_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = handle->err;
+    if (err != ESP_OK) {
+        err = ESP_ERR_INVALID_STATE;
+    } else if (handle->header_len < sizeof(esp_ota_patch_header_t)
+            || ((handle->header.flags & ESP_OTA_PATCH_FLAG_COMPRESSED) && !handle->inflate_done)
+            || handle->cmd_len > 0 || handle->insert_left > 0) {
+        ESP_LOGE(TAG, "Patch is incomplete");
+        err = ESP_ERR_OTA_VALIDATE_FAILED;
+    } else if (handle->image_len != handle->header.image_size) {
+        ESP_LOGE(TAG, "Patch produced %" PRIu32 " bytes instead of %" PRIu32, handle->image_len, handle->header.image_size);
+        err = ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    free_patch(handle);
+    return err;
+}
+
+esp_err_t esp_ota_patch_abort(esp_ota_patch_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    free_patch(handle);
+    return ESP_OK;
+}
@@ -0,0 +1,111 @@
+#!/usr/bin/env python
+#
+# esp_ota_patch_gen is used to generate OTA patches applied by esp_ota_patch_write():
+# compressed app images, and deltas against the app running on the device
+#
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+import argparse
+import struct
+import sys
+import zlib
+
+PATCH_MAGIC = 0x50544f45
+PATCH_VERSION = 1
+PATCH_FLAG_COMPRESSED = 1 << 0
+PATCH_FLAG_DELTA = 1 << 1
+
+CMD_COPY = 0x01
+CMD_INSERT = 0x02
+
+IMAGE_MAGIC = 0xE9
+IMAGE_HEADER_SIZE = 24
+SEGMENT_HEADER_SIZE = 8
+DIGEST_SIZE = 32
+
+# Size of the blocks of the base image the delta looks for in the new image
+BLOCK_SIZE = 64
+
+
+def image_digest(image):  # type: (bytes) -> bytes
+    """ Return the SHA-256 appended to an app image, as returned by esp_partition_get_sha256() on the device """
+    if len(image) < IMAGE_HEADER_SIZE or image[0] != IMAGE_MAGIC:
+        raise ValueError('Base is not an app image')
+    segment_count = image[1]
+    hash_appended = image[23]
+    if not hash_appended:
+        raise ValueError('Base image has no SHA-256 appended')
+    pos = IMAGE_HEADER_SIZE
+    for _ in range(segment_count):
+        _, seg_len = struct.unpack_from('<II', image, pos)
+        pos += SEGMENT_HEADER_SIZE + seg_len
+    # checksum byte, padded to 16 bytes
+    pos = (pos + 16) & ~15
+    if pos + DIGEST_SIZE > len(image):
+        raise ValueError('Base image is truncated')
+    return image[pos:pos + DIGEST_SIZE]
+
+
+def make_delta(base, new):  # type: (bytes, bytes) -> bytes
+    """ Return the commands producing new from the blocks of base """
+    blocks = {}
+    for offset in range(0, len(base) - BLOCK_SIZE + 1, BLOCK_SIZE):
+        blocks.setdefault(base[offset:offset + BLOCK_SIZE], offset)
+
+    delta = bytearray()
+    literal_start = 0
+    i = 0
+    while i + BLOCK_SIZE <= len(new):
+        src = blocks.get(new[i:i + BLOCK_SIZE])
+        if src is None:
+            i += 1
+            continue
+        # extend the match backwards into the pending literal bytes, then forwards
+        while i > literal_start and src > 0 and new[i - 1] == base[src - 1]:
+            i -= 1
+            src -= 1
+        length = 0
+        while i + length < len(new) and src + length < len(base) and new[i + length] == base[src + length]:
+            length += 1
+        if i > literal_start:
+            delta += struct.pack('<BI', CMD_INSERT, i - literal_start) + new[literal_start:i]
+        delta += struct.pack('<BII', CMD_COPY, src, length)
+        i += length
+        literal_start = i
+    if literal_start < len(new):
+        delta += struct.pack('<BI', CMD_INSERT, len(new) - literal_start) + new[literal_start:]
+    return bytes(delta)
+
+
+def main():  # type: () -> None
+    parser = argparse.ArgumentParser('ESP-IDF OTA Patch Generator')
+    parser.add_argument('--base', help='App image running on the device, to generate a delta against it', type=argparse.FileType('rb'))
+    parser.add_argument('--compress', help='Compress the patch', action='store_true')
+    parser.add_argument('image', help='New app image', type=argparse.FileType('rb'))
+    parser.add_argument('output', help='Output patch file', type=argparse.FileType('wb'))
+    args = parser.parse_args()
+
+    new = args.image.read()
+    flags = 0
+    base_digest = b'\x00' * DIGEST_SIZE
+    payload = new
+    if args.base:
+        base = args.base.read()
+        base_digest = image_digest(base)
+        payload = make_delta(base, new)
+        flags |= PATCH_FLAG_DELTA
+    if args.compress:
+        payload = zlib.compress(payload, 9)
+        flags |= PATCH_FLAG_COMPRESSED
+
+    header = struct.pack('<IBBHI32s20s', PATCH_MAGIC, PATCH_VERSION, flags, 0, len(new), base_digest, b'\x00' * 20)
+    args.output.write(header + payload)
+    print('Patch of {} bytes for an image of {} bytes'.format(len(header) + len(payload), len(new)))
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except ValueError as e:
+        print(e, file=sys.stderr)
+        sys.exit(2)
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_ota_ops.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OTA_PATCH_MAGIC             0x50544f45  /*!< Magic word of the OTA patch header, "EOTP" */
+#define ESP_OTA_PATCH_VERSION           1           /*!< Version of the OTA patch format */
+
+#define ESP_OTA_PATCH_FLAG_COMPRESSED   (1 << 0)    /*!< The payload is a zlib stream */
+#define ESP_OTA_PATCH_FLAG_DELTA        (1 << 1)    /*!< The payload is a delta against the running app instead of the app image */
+
+#define ESP_OTA_PATCH_CMD_COPY          0x01        /*!< Copy bytes of the running app image: u32 source offset, u32 length */
+#define ESP_OTA_PATCH_CMD_INSERT        0x02        /*!< Insert the following bytes: u32 length, followed by the bytes */
+
+/**
+ * @brief Header of an OTA patch, stored uncompressed in front of the payload
+ *
+ * All the fields are little endian.
+ */
+typedef struct {
+    uint32_t magic;                 /*!< ESP_OTA_PATCH_MAGIC */
+    uint8_t version;                /*!< ESP_OTA_PATCH_VERSION */
+    uint8_t flags;                  /*!< ESP_OTA_PATCH_FLAG_x flags */
+    uint16_t reserved0;             /*!< Reserved, 0 */
+    uint32_t image_size;            /*!< Size of the resulting app image in bytes */
+    uint8_t base_digest[32];        /*!< SHA-256 of the running app image, as returned by esp_partition_get_sha256(), only checked for a delta */
+    uint8_t reserved[20];           /*!< Reserved, 0 */
+} esp_ota_patch_header_t;
+
+_Static_assert(sizeof(esp_ota_patch_header_t) == 64, "esp_ota_patch_header_t should be 64 bytes");
+
+/**
+ * @brief Opaque handle of an OTA patch being applied
+ */
+typedef struct esp_ota_patch *esp_ota_patch_handle_t;
+
+/**
+ * @brief Start applying an OTA patch to an OTA update
+ *
+ * The patch is written with esp_ota_patch_write() instead of esp_ota_write(), the resulting app image is written
+ * to the update partition with esp_ota_write() as the patch is received. The decompression needs about 43 KB of heap.
+ *
+ * @param ota_handle Handle of the OTA update, returned by esp_ota_begin()
+ * @param out_handle On success, the handle of the patch
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: out_handle is NULL
+ *    - ESP_ERR_NO_MEM: Cannot allocate memory for the patch
+ */
+esp_err_t esp_ota_patch_begin(esp_ota_handle_t ota_handle, esp_ota_patch_handle_t *out_handle);
+
+/**
+ * @brief Write the next part of an OTA patch
+ *
+ * The patch can be written in chunks of any size. The header is checked once it's complete: a delta is only applied
+ * if the digest of the running app matches the base digest of the patch.
+ *
+ * @param handle Handle of the patch, returned by esp_ota_patch_begin()
+ * @param data Data of the patch
+ * @param size Size of the data in bytes
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: handle or data is NULL
+ *    - ESP_ERR_OTA_VALIDATE_FAILED: The patch is invalid, or it doesn't apply to the running app
+ *    - ESP_ERR_INVALID_STATE: A previous write failed
+ *    - Errors returned by esp_ota_write() and esp_partition_read()
+ */
+esp_err_t esp_ota_patch_write(esp_ota_patch_handle_t handle, const void *data, size_t size);
+
+/**
+ * @brief Finish applying an OTA patch and free the handle
+ *
+ * Checks that the whole patch was written and the resulting image has the size given by the header. It must be
+ * called before esp_ota_end(), which verifies the resulting image. The handle is freed in any case.
+ *
+ * @param handle Handle of the patch, returned by esp_ota_patch_begin()
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: handle is NULL
+ *    - ESP_ERR_OTA_VALIDATE_FAILED: The patch is incomplete
+ *    - ESP_ERR_INVALID_STATE: A previous write failed
+ */
+esp_err_t esp_ota_patch_end(esp_ota_patch_handle_t handle);
+
+/**
+ * @brief Abort applying an OTA patch and free the handle
+ *
+ * The OTA update itself must still be aborted with esp_ota_abort().
+ *
+ * @param handle Handle of the patch, returned by esp_ota_patch_begin()
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: handle is NULL
+ */
+esp_err_t esp_ota_patch_abort(esp_ota_patch_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,11 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/param.h>
 #include "esp_log.h"
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -14,6 +15,7 @@
 #include <unity.h>
 #include <test_utils.h>
 #include <esp_ota_ops.h>
+#include "esp_image_format.h"
 
 /* These OTA tests currently don't assume an OTA partition exists
    on the device, so they're a bit limited
@@ -122,3 +124,67 @@ TEST_CASE("esp_ota_get_running_partition points to correct address", "[spi_flash
     ESP_LOGI("running bin", "0x%p", (void*)part->address);
     TEST_ASSERT_EQUAL_HEX32(factory->address, part->address);
 }
+
+/* Copy the running app to the update partition in chunks which don't match the image layout,
+ * flipping the byte at corrupt_offset if it is within the copied length */
+static esp_err_t write_running_app(const esp_partition_t *update, uint32_t len, uint32_t corrupt_offset)
+{
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    const size_t chunk = 1000;
+    uint8_t *buf = malloc(chunk);
+    TEST_ASSERT_NOT_NULL(buf);
+
+    esp_ota_handle_t handle;
+    TEST_ESP_OK(esp_ota_begin(update, OTA_WITH_SEQUENTIAL_WRITES, &handle));
+    for (uint32_t offset = 0; offset < len; offset += chunk) {
+        size_t size = MIN(chunk, len - offset);
+        TEST_ESP_OK(esp_partition_read(running, offset, buf, size));
+        if (corrupt_offset >= offset && corrupt_offset < offset + size) {
+            buf[corrupt_offset - offset] ^= 0x01;
+        }
+        TEST_ESP_OK(esp_ota_write(handle, buf, size));
+    }
+    free(buf);
+    return esp_ota_end(handle);
+}
+
+TEST_CASE("esp_ota_end verifies the written image", "[ota]")
+{
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    const esp_partition_t *update = esp_ota_get_next_update_partition(NULL);
+    TEST_ASSERT_NOT_NULL(update);
+
+    const esp_partition_pos_t running_pos = {
+        .offset = running->address,
+        .size = running->size,
+    };
+    esp_image_metadata_t data;
+    TEST_ESP_OK(esp_image_verify(ESP_IMAGE_VERIFY_SILENT, &running_pos, &data));
+
+    TEST_ESP_OK(write_running_app(update, data.image_len, UINT32_MAX));
+    TEST_ESP_ERR(ESP_ERR_OTA_VALIDATE_FAILED, write_running_app(update, data.image_len, data.image_len / 2));
+    TEST_ESP_ERR(ESP_ERR_OTA_VALIDATE_FAILED, write_running_app(update, data.image_len - 16, UINT32_MAX));
+}
+
+TEST_CASE("esp_ota_set_boot_partition accepts the image verified by esp_ota_end", "[ota]")
+{
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    const esp_partition_t *update = esp_ota_get_next_update_partition(NULL);
+    TEST_ASSERT_NOT_NULL(update);
+
+    const esp_partition_pos_t running_pos = {
+        .offset = running->address,
+        .size = running->size,
+    };
+    esp_image_metadata_t data;
+    TEST_ESP_OK(esp_image_verify(ESP_IMAGE_VERIFY_SILENT, &running_pos, &data));
+
+    TEST_ESP_OK(write_running_app(update, data.image_len, UINT32_MAX));
+    TEST_ESP_OK(esp_ota_set_boot_partition(update));
+
+    // The image has changed since esp_ota_end(), so it is verified again
+    TEST_ESP_OK(esp_partition_erase_range(update, 0, update->erase_size));
+    TEST_ESP_ERR(ESP_ERR_OTA_VALIDATE_FAILED, esp_ota_set_boot_partition(update));
+
+    TEST_ESP_OK(esp_ota_set_boot_partition(running));
+}
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+
+#include <unity.h>
+#include <test_utils.h>
+#include <esp_ota_ops.h>
+#include <esp_ota_patch.h>
+#include "esp_image_format.h"
+#include "miniz.h"
+
+/* The patches are built at runtime against the running app, the resulting image is the running app itself */
+
+static uint32_t running_image_len(void)
+{
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    const esp_partition_pos_t pos = {
+        .offset = running->address,
+        .size = running->size,
+    };
+    esp_image_metadata_t data;
+    TEST_ESP_OK(esp_image_verify(ESP_IMAGE_VERIFY_SILENT, &pos, &data));
+    return data.image_len;
+}
+
+static void make_header(esp_ota_patch_header_t *header, uint8_t flags, uint32_t image_size)
+{
+    memset(header, 0, sizeof(esp_ota_patch_header_t));
+    header->magic = ESP_OTA_PATCH_MAGIC;
+    header->version = ESP_OTA_PATCH_VERSION;
+    header->flags = flags;
+    header->image_size = image_size;
+    TEST_ESP_OK(esp_partition_get_sha256(esp_ota_get_running_partition(), header->base_digest));
+}
+
+static size_t make_cmd(uint8_t *buf, uint8_t cmd, uint32_t offset, uint32_t len)
+{
+    buf[0] = cmd;
+    if (cmd == ESP_OTA_PATCH_CMD_COPY) {
+        memcpy(&buf[1], &offset, sizeof(offset));
+        memcpy(&buf[5], &len, sizeof(len));
+        return 9;
+    }
+    memcpy(&buf[1], &len, sizeof(len));
+    return 5;
+}
+
+/* Write the data in small chunks to split the header and the commands between writes */
+static void patch_write(esp_ota_patch_handle_t patch, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    while (size > 0) {
+        size_t chunk = MIN(size, 7);
+        TEST_ESP_OK(esp_ota_patch_write(patch, p, chunk));
+        p += chunk;
+        size -= chunk;
+    }
+}
+
+static void check_update_partition(const esp_partition_t *update)
+{
+    uint8_t running_digest[32];
+    uint8_t update_digest[32];
+    TEST_ESP_OK(esp_partition_get_sha256(esp_ota_get_running_partition(), running_digest));
+    TEST_ESP_OK(esp_partition_get_sha256(update, update_digest));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(running_digest, update_digest, sizeof(running_digest));
+}
+
+TEST_CASE("esp_ota_patch applies a delta against the running app", "[ota]")
+{
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    const esp_partition_t *update = esp_ota_get_next_update_partition(NULL);
+    TEST_ASSERT_NOT_NULL(update);
+    uint32_t image_len = running_image_len();
+    uint32_t copy_len = image_len / 2;
+
+    esp_ota_handle_t ota_handle;
+    esp_ota_patch_handle_t patch;
+    TEST_ESP_OK(esp_ota_begin(update, OTA_WITH_SEQUENTIAL_WRITES, &ota_handle));
+    TEST_ESP_OK(esp_ota_patch_begin(ota_handle, &patch));
+
+    esp_ota_patch_header_t header;
+    make_header(&header, ESP_OTA_PATCH_FLAG_DELTA, image_len);
+    patch_write(patch, &header, sizeof(header));
+
+    uint8_t cmd[9];
+    patch_write(patch, cmd, make_cmd(cmd, ESP_OTA_PATCH_CMD_COPY, 0, copy_len));
+    patch_write(patch, cmd, make_cmd(cmd, ESP_OTA_PATCH_CMD_INSERT, 0, image_len - copy_len));
+    uint8_t *buf = malloc(512);
+    TEST_ASSERT_NOT_NULL(buf);
+    for (uint32_t offset = copy_len; offset < image_len; offset += 512) {
+        size_t len = MIN(512, image_len - offset);
+        TEST_ESP_OK(esp_partition_read(running, offset, buf, len));
+        TEST_ESP_OK(esp_ota_patch_write(patch, buf, len));
+    }
+    free(buf);
+
+    TEST_ESP_OK(esp_ota_patch_end(patch));
+    TEST_ESP_OK(esp_ota_end(ota_handle));
+    check_update_partition(update);
+}
+
+TEST_CASE("esp_ota_patch applies a compressed delta", "[ota]")
+{
+    const esp_partition_t *update = esp_ota_get_next_update_partition(NULL);
+    TEST_ASSERT_NOT_NULL(update);
+    uint32_t image_len = running_image_len();
+
+    uint8_t cmd[9];
+    size_t cmd_len = make_cmd(cmd, ESP_OTA_PATCH_CMD_COPY, 0, image_len);
+    uint8_t compressed[64];
+    size_t compressed_len = sizeof(compressed);
+    tdefl_compressor *comp = calloc(1, sizeof(tdefl_compressor));
+    TEST_ASSERT_NOT_NULL(comp);
+    TEST_ASSERT_EQUAL(TDEFL_STATUS_OKAY, tdefl_init(comp, NULL, NULL, TDEFL_WRITE_ZLIB_HEADER | TDEFL_DEFAULT_MAX_PROBES));
+    TEST_ASSERT_EQUAL(TDEFL_STATUS_DONE, tdefl_compress(comp, cmd, &cmd_len, compressed, &compressed_len, TDEFL_FINISH));
+    free(comp);
+
+    esp_ota_handle_t ota_handle;
+    esp_ota_patch_handle_t patch;
+    TEST_ESP_OK(esp_ota_begin(update, OTA_WITH_SEQUENTIAL_WRITES, &ota_handle));
+    TEST_ESP_OK(esp_ota_patch_begin(ota_handle, &patch));
+
+    esp_ota_patch_header_t header;
+    make_header(&header, ESP_OTA_PATCH_FLAG_DELTA | ESP_OTA_PATCH_FLAG_COMPRESSED, image_len);
+    patch_write(patch, &header, sizeof(header));
+    patch_write(patch, compressed, compressed_len);
+
+    TEST_ESP_OK(esp_ota_patch_end(patch));
+    TEST_ESP_OK(esp_ota_end(ota_handle));
+    check_update_partition(update);
+}
+
+TEST_CASE("esp_ota_patch rejects a delta against another app", "[ota]")
+{
+    const esp_partition_t *update = esp_ota_get_next_update_partition(NULL);
+    TEST_ASSERT_NOT_NULL(update);
+
+    esp_ota_handle_t ota_handle;
+    esp_ota_patch_handle_t patch;
+    TEST_ESP_OK(esp_ota_begin(update, OTA_WITH_SEQUENTIAL_WRITES, &ota_handle));
+    TEST_ESP_OK(esp_ota_patch_begin(ota_handle, &patch));
+
+    esp_ota_patch_header_t header;
+    make_header(&header, ESP_OTA_PATCH_FLAG_DELTA, running_image_len());
+    header.base_digest[0] ^= 0xff;
+    TEST_ASSERT_EQUAL(ESP_ERR_OTA_VALIDATE_FAILED, esp_ota_patch_write(patch, &header, sizeof(header)));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_ota_patch_write(patch, &header, sizeof(header)));
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_ota_patch_end(patch));
+    TEST_ESP_OK(esp_ota_abort(ota_handle));
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -10,6 +10,7 @@
 #include "bootloader_utility.h"
 #include "bootloader_common.h"
 #include "bootloader_hooks.h"
+#include "esp_boot_trace.h"
 
 static const char *TAG = "boot";
 
@@ -23,6 +24,10 @@ static int selected_boot_partition(const bootloader_state_t *bs);
  */
 void __attribute__((noreturn)) call_start_cpu0(void)
 {
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_record(ESP_BOOT_TRACE_BOOTLOADER_START);
+#endif
+
     // (0. Call the before-init hook, if available)
     if (bootloader_before_init) {
         bootloader_before_init();
@@ -32,6 +37,9 @@ void __attribute__((noreturn)) call_start_cpu0(void)
     if (bootloader_init() != ESP_OK) {
         bootloader_reset();
     }
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_record(ESP_BOOT_TRACE_BOOTLOADER_INIT_DONE);
+#endif
 
     // (1.1 Call the after-init hook, if available)
     if (bootloader_after_init) {
@@ -52,6 +60,9 @@ void __attribute__((noreturn)) call_start_cpu0(void)
     if (boot_index == INVALID_INDEX) {
         bootloader_reset();
     }
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_record(ESP_BOOT_TRACE_PARTITION_SELECTED);
+#endif
 
     // 3. Load the app image for booting
     bootloader_utility_load_boot_image(&bs, boot_index);
@@ -228,6 +228,54 @@ esp_partition_pos_t* bootloader_common_get_rtc_retain_mem_partition(void);
  */
 void bootloader_common_update_rtc_retain_mem(esp_partition_pos_t* partition, bool reboot_counter);
 
+#if CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP_CHECK_DIGEST
+/**
+ * @brief Returns the digest of the validated application from rtc_retain_mem
+ *
+ * Note: This function operates the RTC FAST memory which available only for PRO_CPU.
+ *       Make sure that this function is used only PRO_CPU.
+ *
+ * @return digest: If rtc_retain_mem is valid and holds a digest.
+ *        - NULL: If it is not valid, or the digest was cleared.
+ */
+const uint8_t* bootloader_common_get_rtc_retain_mem_image_digest(void);
+
+/**
+ * @brief Update the digest of the validated application in rtc_retain_mem.
+ *
+ * The fast booting from the deep sleep skips the validation only if the application still has this digest.
+ * Note: This function operates the RTC FAST memory which available only for PRO_CPU.
+ *       Make sure that this function is used only PRO_CPU.
+ *
+ * @param[in] digest  Appended SHA-256 digest of the validated application, 32 bytes. NULL clears the digest, when the
+ *                    loaded application wasn't validated.
+ */
+void bootloader_common_update_rtc_retain_mem_image_digest(const uint8_t *digest);
+#endif // CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP_CHECK_DIGEST
+
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+/**
+ * @brief Returns the boot trace recorded by the bootloader from rtc_retain_mem
+ *
+ * Note: This function operates the RTC FAST memory which available only for PRO_CPU.
+ *       Make sure that this function is used only PRO_CPU.
+ *
+ * @return boot trace: If rtc_retain_mem is valid.
+ *        - NULL: If it is not valid.
+ */
+const esp_boot_trace_bootloader_t* bootloader_common_get_rtc_retain_mem_boot_trace(void);
+
+/**
+ * @brief Update the boot trace of the bootloader in rtc_retain_mem.
+ *
+ * Note: This function operates the RTC FAST memory which available only for PRO_CPU.
+ *       Make sure that this function is used only PRO_CPU.
+ *
+ * @param[in] boot_trace  Boot trace of the bootloader.
+ */
+void bootloader_common_update_rtc_retain_mem_boot_trace(const esp_boot_trace_bootloader_t *boot_trace);
+#endif // CONFIG_BOOTLOADER_BOOT_TRACE
+
 /**
  * @brief Reset entire rtc_retain_mem.
  *
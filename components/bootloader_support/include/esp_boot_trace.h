@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Points of the boot recorded by the boot trace, in the order of the boot
+ */
+typedef enum {
+    ESP_BOOT_TRACE_BOOTLOADER_START,        /*!< The 2nd stage bootloader starts, after the ROM loaded it */
+    ESP_BOOT_TRACE_BOOTLOADER_INIT_DONE,    /*!< The hardware is initialized by the bootloader */
+    ESP_BOOT_TRACE_PARTITION_SELECTED,      /*!< The partition table is loaded and the boot partition is selected */
+    ESP_BOOT_TRACE_IMAGE_LOADED,            /*!< The app image is verified and loaded */
+    ESP_BOOT_TRACE_BOOTLOADER_END,          /*!< The bootloader jumps to the app */
+    ESP_BOOT_TRACE_APP_START,               /*!< The app starts, in call_start_cpu0 */
+    ESP_BOOT_TRACE_CORE_INIT_DONE,          /*!< The core init functions of the app are done */
+    ESP_BOOT_TRACE_SECONDARY_INIT_DONE,     /*!< The secondary init functions of the app are done */
+    ESP_BOOT_TRACE_APP_MAIN,                /*!< app_main is called */
+    ESP_BOOT_TRACE_POINT_NUM,               /*!< Number of the boot trace points */
+} esp_boot_trace_point_t;
+
+/**
+ * @brief Number of the boot trace points recorded by the bootloader
+ */
+#define ESP_BOOT_TRACE_BOOTLOADER_POINT_NUM     ESP_BOOT_TRACE_APP_START
+
+/**
+ * @brief Boot trace of the bootloader, passed to the app in the RTC FAST memory
+ */
+typedef struct {
+    uint32_t time_us[ESP_BOOT_TRACE_BOOTLOADER_POINT_NUM]; /*!< Time of each point in microseconds since the chip reset, 0 if not recorded */
+    uint32_t last_us;                                      /*!< Time of the last recorded point */
+    uint32_t last_cycles;                                  /*!< CPU cycle count at the last recorded point */
+} esp_boot_trace_bootloader_t;
+
+/**
+ * @brief Record the time of a boot trace point
+ *
+ * Only available if CONFIG_BOOTLOADER_BOOT_TRACE is enabled.
+ *
+ * The time is measured with the CPU cycle counter. It's only called by the bootloader and the startup code of the app,
+ * each point is recorded once.
+ *
+ * @param point Boot trace point
+ */
+void esp_boot_trace_record(esp_boot_trace_point_t point);
+
+/**
+ * @brief Get the time of a boot trace point
+ *
+ * Only available in the app, if CONFIG_BOOTLOADER_BOOT_TRACE is enabled.
+ *
+ * @param point Boot trace point
+ *
+ * @return Time of the point in microseconds since the chip reset, 0 if the point isn't recorded
+ */
+uint32_t esp_boot_trace_get_time(esp_boot_trace_point_t point);
+
+/**
+ * @brief Print the boot trace, with the time of each point and the duration since the previous point
+ *
+ * Only available in the app, if CONFIG_BOOTLOADER_BOOT_TRACE is enabled.
+ */
+void esp_boot_trace_print(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -10,6 +10,7 @@
 #include "esp_flash_partitions.h"
 #include "esp_app_format.h"
 #include "esp_assert.h"
+#include "esp_boot_trace.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -56,6 +57,12 @@ typedef struct {
         uint8_t val;
     } flags;
     uint8_t reserve;                /*!< Reserve */
+#ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP_CHECK_DIGEST
+    uint8_t image_digest[ESP_IMAGE_HASH_LEN]; /*!< Appended SHA-256 digest of the application validated before the deep sleep */
+#endif
+#ifdef CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_bootloader_t boot_trace; /*!< Boot trace recorded by the bootloader during this boot */
+#endif
 #ifdef CONFIG_BOOTLOADER_CUSTOM_RESERVE_RTC
     uint8_t custom[CONFIG_BOOTLOADER_CUSTOM_RESERVE_RTC_SIZE]; /*!< Reserve for custom propose */
 #endif
@@ -152,6 +159,17 @@ esp_err_t esp_image_get_metadata(const esp_partition_pos_t *part, esp_image_meta
  */
 esp_err_t bootloader_load_image(const esp_partition_pos_t *part, esp_image_metadata_t *data);
 
+/**
+ * @brief Check whether bootloader_load_image() validates the images it loads (available only in space of bootloader).
+ *
+ * The validation is skipped with CONFIG_BOOTLOADER_SKIP_VALIDATE_ALWAYS, or with
+ * CONFIG_BOOTLOADER_SKIP_VALIDATE_ON_POWER_ON after a power-on reset. The fields of the image metadata which are only
+ * set by the validation, such as image_digest, aren't valid then.
+ *
+ * @return true if the images are validated when loaded at this boot
+ */
+bool bootloader_load_image_validates(void);
+
 /**
  * @brief Load an app image without verification (available only in space of bootloader).
  *
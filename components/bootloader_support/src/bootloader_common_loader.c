@@ -213,6 +213,56 @@ esp_partition_pos_t* bootloader_common_get_rtc_retain_mem_partition(void)
     return NULL;
 }
 
+#if CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP_CHECK_DIGEST
+const uint8_t* bootloader_common_get_rtc_retain_mem_image_digest(void)
+{
+    if (is_retain_mem_valid()) {
+        const uint8_t *digest = bootloader_common_get_rtc_retain_mem()->image_digest;
+        // A cleared digest means that no validated application is known
+        for (int i = 0; i < ESP_IMAGE_HASH_LEN; i++) {
+            if (digest[i] != 0) {
+                return digest;
+            }
+        }
+    }
+    return NULL;
+}
+
+void bootloader_common_update_rtc_retain_mem_image_digest(const uint8_t *digest)
+{
+    rtc_retain_mem_t* rtc_retain_mem = bootloader_common_get_rtc_retain_mem();
+    if (!is_retain_mem_valid()) {
+        bootloader_common_reset_rtc_retain_mem();
+    }
+    if (digest != NULL) {
+        memcpy(rtc_retain_mem->image_digest, digest, sizeof(rtc_retain_mem->image_digest));
+    } else {
+        memset(rtc_retain_mem->image_digest, 0, sizeof(rtc_retain_mem->image_digest));
+    }
+    update_rtc_retain_mem_crc();
+}
+#endif // CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP_CHECK_DIGEST
+
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+const esp_boot_trace_bootloader_t* bootloader_common_get_rtc_retain_mem_boot_trace(void)
+{
+    if (is_retain_mem_valid()) {
+        return &bootloader_common_get_rtc_retain_mem()->boot_trace;
+    }
+    return NULL;
+}
+
+void bootloader_common_update_rtc_retain_mem_boot_trace(const esp_boot_trace_bootloader_t *boot_trace)
+{
+    rtc_retain_mem_t* rtc_retain_mem = bootloader_common_get_rtc_retain_mem();
+    if (!is_retain_mem_valid()) {
+        bootloader_common_reset_rtc_retain_mem();
+    }
+    memcpy(&rtc_retain_mem->boot_trace, boot_trace, sizeof(rtc_retain_mem->boot_trace));
+    update_rtc_retain_mem_crc();
+}
+#endif // CONFIG_BOOTLOADER_BOOT_TRACE
+
 void bootloader_common_update_rtc_retain_mem(esp_partition_pos_t* partition, bool reboot_counter)
 {
     rtc_retain_mem_t* rtc_retain_mem = bootloader_common_get_rtc_retain_mem();
@@ -50,6 +50,7 @@
 #include "bootloader_memory_utils.h"
 #include "esp_efuse.h"
 #include "esp_fault.h"
+#include "esp_boot_trace.h"
 
 static const char *TAG = "boot";
 
@@ -451,7 +452,7 @@ static bool try_load_partition(const esp_partition_pos_t *partition, esp_image_m
 
 // ota_has_initial_contents flag is set if factory does not present in partition table and
 // otadata has initial content(0xFFFFFFFF), then set actual ota_seq.
-static void set_actual_ota_seq(const bootloader_state_t *bs, int index)
+static void set_actual_ota_seq(const bootloader_state_t *bs, int index, const esp_image_metadata_t *image_data)
 {
     if (index > FACTORY_INDEX && ota_has_initial_contents == true) {
         esp_ota_select_entry_t otadata;
@@ -471,12 +472,41 @@ static void set_actual_ota_seq(const bootloader_state_t *bs, int index)
 #ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP
     esp_partition_pos_t partition = index_to_partition(bs, index);
     bootloader_common_update_rtc_retain_mem(&partition, true);
+#ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP_CHECK_DIGEST
+    // The digest is only read from flash by the validation, otherwise no image is known to be validated
+    if (bootloader_load_image_validates() && image_data->image.hash_appended) {
+        bootloader_common_update_rtc_retain_mem_image_digest(image_data->image_digest);
+    } else {
+        bootloader_common_update_rtc_retain_mem_image_digest(NULL);
+    }
+#endif
 #else
     bootloader_common_update_rtc_retain_mem(NULL, true);
 #endif
 #endif // CONFIG_BOOTLOADER_RESERVE_RTC_MEM
 }
 
+#ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP_CHECK_DIGEST
+/* Check that the image still has the appended SHA-256 digest of the image validated before the deep sleep */
+static bool is_image_validated_before_deep_sleep(const esp_image_metadata_t *image_data)
+{
+    const uint8_t *validated_digest = bootloader_common_get_rtc_retain_mem_image_digest();
+    uint8_t image_digest[ESP_IMAGE_HASH_LEN];
+
+    if (validated_digest == NULL || !image_data->image.hash_appended) {
+        return false;
+    }
+    if (bootloader_flash_read(image_data->start_addr + image_data->image_len - ESP_IMAGE_HASH_LEN, image_digest, ESP_IMAGE_HASH_LEN, true) != ESP_OK) {
+        return false;
+    }
+    if (memcmp(image_digest, validated_digest, ESP_IMAGE_HASH_LEN) != 0) {
+        ESP_LOGW(TAG, "App image changed since it was validated");
+        return false;
+    }
+    return true;
+}
+#endif // CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP_CHECK_DIGEST
+
 #ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP
 void bootloader_utility_load_boot_image_from_deep_sleep(void)
 {
@@ -484,7 +514,11 @@ void bootloader_utility_load_boot_image_from_deep_sleep(void)
 #if SOC_RTC_FAST_MEM_SUPPORTED
         esp_partition_pos_t *partition = bootloader_common_get_rtc_retain_mem_partition();
         esp_image_metadata_t image_data;
-        if (partition != NULL && bootloader_load_image_no_verify(partition, &image_data) == ESP_OK) {
+        if (partition != NULL && bootloader_load_image_no_verify(partition, &image_data) == ESP_OK
+#ifdef CONFIG_BOOTLOADER_SKIP_VALIDATE_IN_DEEP_SLEEP_CHECK_DIGEST
+            && is_image_validated_before_deep_sleep(&image_data)
+#endif
+            ) {
             ESP_LOGI(TAG, "Fast booting app from partition at offset 0x%"PRIx32, partition->offset);
             bootloader_common_update_rtc_retain_mem(NULL, true);
             load_image(&image_data);
@@ -539,7 +573,7 @@ void bootloader_utility_load_boot_image(const bootloader_state_t *bs, int start_
         }
         ESP_LOGD(TAG, TRY_LOG_FORMAT, index, part.offset, part.size);
         if (check_anti_rollback(&part) && try_load_partition(&part, &image_data)) {
-            set_actual_ota_seq(bs, index);
+            set_actual_ota_seq(bs, index, &image_data);
             load_image(&image_data);
         }
         log_invalid_app_partition(index);
@@ -553,7 +587,7 @@ void bootloader_utility_load_boot_image(const bootloader_state_t *bs, int start_
         }
         ESP_LOGD(TAG, TRY_LOG_FORMAT, index, part.offset, part.size);
         if (check_anti_rollback(&part) && try_load_partition(&part, &image_data)) {
-            set_actual_ota_seq(bs, index);
+            set_actual_ota_seq(bs, index, &image_data);
             load_image(&image_data);
         }
         log_invalid_app_partition(index);
@@ -572,6 +606,10 @@ void bootloader_utility_load_boot_image(const bootloader_state_t *bs, int start_
 // Copy loaded segments to RAM, set up caches for mapped segments, and start application.
 static void load_image(const esp_image_metadata_t *image_data)
 {
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_record(ESP_BOOT_TRACE_IMAGE_LOADED);
+#endif
+
     /**
      * Rough steps for a first boot, when encryption and secure boot are both disabled:
      *   1) Generate secure boot key and write to EFUSE.
@@ -941,6 +979,9 @@ static void set_cache_and_start_app(
 
     ESP_LOGD(TAG, "start: 0x%08"PRIx32, entry_addr);
     bootloader_atexit();
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_record(ESP_BOOT_TRACE_BOOTLOADER_END);
+#endif
     typedef void (*entry_t)(void) __attribute__((noreturn));
     entry_t entry = ((entry_t) entry_addr);
 
@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <inttypes.h>
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "esp_boot_trace.h"
+#include "bootloader_common.h"
+
+/*
+ * The boot trace measures the time with the CPU cycle counter, which starts counting at the chip reset and isn't reset
+ * when the bootloader jumps to the app. The bootloader records its points into rtc_retain_mem, the app keeps its points
+ * in DRAM and joins both time bases at the start of the app.
+ */
+
+#ifdef BOOTLOADER_BUILD
+
+void esp_boot_trace_record(esp_boot_trace_point_t point)
+{
+    uint32_t cycles = esp_cpu_get_cycle_count();
+    uint32_t ticks_per_us = esp_rom_get_cpu_ticks_per_us();
+    const esp_boot_trace_bootloader_t *prev = bootloader_common_get_rtc_retain_mem_boot_trace();
+    esp_boot_trace_bootloader_t boot_trace = { 0 };
+    uint32_t time_us;
+
+    if (point != ESP_BOOT_TRACE_BOOTLOADER_START && prev != NULL) {
+        // The bootloader doesn't rescale the cycle counter when it changes the CPU frequency,
+        // so only the cycles since the last point are converted with the current frequency
+        boot_trace = *prev;
+        time_us = prev->last_us + (cycles - prev->last_cycles) / ticks_per_us;
+    } else {
+        // The ROM runs at a single CPU frequency, the trace of the previous boot is dropped
+        time_us = cycles / ticks_per_us;
+    }
+    boot_trace.time_us[point] = time_us;
+    boot_trace.last_us = time_us;
+    boot_trace.last_cycles = cycles;
+    bootloader_common_update_rtc_retain_mem_boot_trace(&boot_trace);
+}
+
+#else // !BOOTLOADER_BUILD
+
+#define APP_POINT_NUM   (ESP_BOOT_TRACE_POINT_NUM - ESP_BOOT_TRACE_BOOTLOADER_POINT_NUM)
+
+static const char *s_point_names[ESP_BOOT_TRACE_POINT_NUM] = {
+    [ESP_BOOT_TRACE_BOOTLOADER_START] = "bootloader start",
+    [ESP_BOOT_TRACE_BOOTLOADER_INIT_DONE] = "bootloader init done",
+    [ESP_BOOT_TRACE_PARTITION_SELECTED] = "partition selected",
+    [ESP_BOOT_TRACE_IMAGE_LOADED] = "image loaded",
+    [ESP_BOOT_TRACE_BOOTLOADER_END] = "bootloader end",
+    [ESP_BOOT_TRACE_APP_START] = "app start",
+    [ESP_BOOT_TRACE_CORE_INIT_DONE] = "core init done",
+    [ESP_BOOT_TRACE_SECONDARY_INIT_DONE] = "secondary init done",
+    [ESP_BOOT_TRACE_APP_MAIN] = "app_main",
+};
+
+static uint32_t s_app_time_us[APP_POINT_NUM];
+static uint32_t s_app_recorded;
+static uint32_t s_app_start_cycles;
+static uint32_t s_app_start_ticks_per_us;
+
+// Called from call_start_cpu0 before the cache is configured by the app
+void IRAM_ATTR esp_boot_trace_record(esp_boot_trace_point_t point)
+{
+    if (point < ESP_BOOT_TRACE_APP_START || point >= ESP_BOOT_TRACE_POINT_NUM) {
+        return;
+    }
+    uint32_t cycles = esp_cpu_get_cycle_count();
+    uint32_t ticks_per_us = esp_rom_get_cpu_ticks_per_us();
+    if (point == ESP_BOOT_TRACE_APP_START) {
+        s_app_start_cycles = cycles;
+        s_app_start_ticks_per_us = ticks_per_us;
+    }
+    // The app rescales the cycle counter when it changes the CPU frequency, the cycle count
+    // converted with the current frequency keeps a single time base
+    s_app_time_us[point - ESP_BOOT_TRACE_APP_START] = cycles / ticks_per_us;
+    s_app_recorded |= 1 << (point - ESP_BOOT_TRACE_APP_START);
+}
+
+uint32_t esp_boot_trace_get_time(esp_boot_trace_point_t point)
+{
+    if (point >= ESP_BOOT_TRACE_POINT_NUM) {
+        return 0;
+    }
+    const esp_boot_trace_bootloader_t *boot_trace = bootloader_common_get_rtc_retain_mem_boot_trace();
+    if (point < ESP_BOOT_TRACE_BOOTLOADER_POINT_NUM) {
+        return boot_trace ? boot_trace->time_us[point] : 0;
+    }
+    uint32_t index = point - ESP_BOOT_TRACE_APP_START;
+    if (!(s_app_recorded & (1 << index)) || !(s_app_recorded & 1)) {
+        return 0;
+    }
+    uint32_t app_start_us = s_app_time_us[0];
+    if (boot_trace != NULL && boot_trace->last_us != 0) {
+        app_start_us = boot_trace->last_us + (s_app_start_cycles - boot_trace->last_cycles) / s_app_start_ticks_per_us;
+    }
+    return app_start_us + (s_app_time_us[index] - s_app_time_us[0]);
+}
+
+void esp_boot_trace_print(void)
+{
+    uint32_t prev_us = 0;
+
+    printf("Boot trace:\n");
+    printf("%-22s %10s %10s\n", "point", "time (us)", "delta (us)");
+    for (int i = 0; i < ESP_BOOT_TRACE_POINT_NUM; i++) {
+        uint32_t time_us = esp_boot_trace_get_time(i);
+        if (time_us == 0) {
+            continue;
+        }
+        printf("%-22s %10"PRIu32" %10"PRIu32"\n", s_point_names[i], time_us, time_us - prev_us);
+        prev_us = time_us;
+    }
+}
+
+#endif // !BOOTLOADER_BUILD
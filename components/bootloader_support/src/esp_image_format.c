@@ -53,6 +53,12 @@ static const char *TAG = "esp_image";
 /* Headroom to ensure between stack SP (at time of checking) and data loaded from flash */
 #define STACK_LOAD_HEADROOM 32768
 
+#if SOC_CACHE_PRELOAD_SUPPORTED && defined(BOOTLOADER_BUILD)
+/* The cache preloads the next chunk of a mapped segment from flash, while the CPU does the checksum and the SHA
+   of the current chunk. The chunk is far smaller than the DCache, so that both chunks stay in it. */
+#define IMAGE_PRELOAD_CHUNK 0x1000
+#endif
+
 #ifdef BOOTLOADER_BUILD
 /* 64 bits of random data to obfuscate loaded RAM with, until verification is complete
    (Means loaded code isn't executable until after the secure boot check.)
@@ -254,29 +260,32 @@ err:
     return err;
 }
 
-esp_err_t bootloader_load_image(const esp_partition_pos_t *part, esp_image_metadata_t *data)
+bool bootloader_load_image_validates(void)
 {
-#if !defined(BOOTLOADER_BUILD)
-    return ESP_FAIL;
-#else
-    esp_image_load_mode_t mode = ESP_IMAGE_LOAD;
-
-#if !defined(CONFIG_SECURE_BOOT)
+#if defined(BOOTLOADER_BUILD) && !defined(CONFIG_SECURE_BOOT)
     /* Skip validation under particular configurations */
 #if CONFIG_BOOTLOADER_SKIP_VALIDATE_ALWAYS
-    mode = ESP_IMAGE_LOAD_NO_VALIDATE;
+    return false;
 #elif CONFIG_BOOTLOADER_SKIP_VALIDATE_ON_POWER_ON
     if (esp_rom_get_reset_reason(0) == RESET_REASON_CHIP_POWER_ON
 #if SOC_EFUSE_HAS_EFUSE_RST_BUG
         || esp_rom_get_reset_reason(0) == RESET_REASON_CORE_EFUSE_CRC
 #endif
         ) {
-        mode = ESP_IMAGE_LOAD_NO_VALIDATE;
+        return false;
     }
 #endif // CONFIG_BOOTLOADER_SKIP_...
-#endif // CONFIG_SECURE_BOOT
+#endif // BOOTLOADER_BUILD && !CONFIG_SECURE_BOOT
+    return true;
+}
 
- return image_load(mode, part, data);
+esp_err_t bootloader_load_image(const esp_partition_pos_t *part, esp_image_metadata_t *data)
+{
+#if !defined(BOOTLOADER_BUILD)
+    return ESP_FAIL;
+#else
+    esp_image_load_mode_t mode = bootloader_load_image_validates() ? ESP_IMAGE_LOAD : ESP_IMAGE_LOAD_NO_VALIDATE;
+    return image_load(mode, part, data);
 #endif // BOOTLOADER_BUILD
 }
 
@@ -714,8 +723,26 @@ static esp_err_t process_segment_data(int segment, intptr_t load_addr, uint32_t
 #endif // CONFIG_BOOTLOADER_APP_ANTI_ROLLBACK
     }
 
+#ifdef IMAGE_PRELOAD_CHUNK
+    bool preloading = false;
+    uint32_t autoload = 0;
+#endif
     for (size_t i = 0; i < data_len; i += 4) {
         int w_i = i / 4; // Word index
+#ifdef IMAGE_PRELOAD_CHUNK
+        if (i % IMAGE_PRELOAD_CHUNK == 0) {
+            if (preloading) {
+                while (!cache_ll_is_preload_done(CACHE_LL_LEVEL_EXT_MEM, CACHE_TYPE_DATA, CACHE_LL_ID_ALL)) {
+                }
+                cache_ll_end_preload(CACHE_LL_LEVEL_EXT_MEM, CACHE_TYPE_DATA, CACHE_LL_ID_ALL, autoload);
+            }
+            preloading = (data_len - i > IMAGE_PRELOAD_CHUNK);
+            if (preloading) {
+                autoload = cache_ll_start_preload_addr(CACHE_LL_LEVEL_EXT_MEM, CACHE_TYPE_DATA, CACHE_LL_ID_ALL, (uint32_t)&src[w_i] + IMAGE_PRELOAD_CHUNK,
+                                                       MIN(IMAGE_PRELOAD_CHUNK, data_len - i - IMAGE_PRELOAD_CHUNK));
+            }
+        }
+#endif
         uint32_t w = src[w_i];
         if (checksum != NULL) {
             *checksum ^= w;
@@ -10,6 +10,10 @@
 #include "bt_common.h"
 #include "osi/mutex.h"
 #include "esp_attr.h"
+#if (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
+#include "esp_app_trace.h"
+#include "esp_timer.h"
+#endif
 
 #if (BT_HCI_LOG_INCLUDED == TRUE)
 #define BT_HCI_LOG_PRINT_TAG                     (1)
@@ -34,8 +38,96 @@ static const char s_hex_to_char_mapping[16] = {
 static bt_hci_log_t g_bt_hci_log_data_ctl  = {0};
 static bt_hci_log_t g_bt_hci_log_adv_ctl  = {0};
 
+#if (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
+#if CONFIG_APPTRACE_DEST_JTAG
+#define BT_HCI_LOG_APPTRACE_DEST                 ESP_APPTRACE_DEST_JTAG
+#else
+#define BT_HCI_LOG_APPTRACE_DEST                 ESP_APPTRACE_DEST_UART
+#endif
+#define BT_HCI_LOG_APPTRACE_TMO                  (10 * 1000)
+
+#define BTSNOOP_HDR_SIZE                         (16)
+#define BTSNOOP_REC_HDR_SIZE                     (24)
+#define BTSNOOP_VERSION                          (1)
+#define BTSNOOP_DATALINK_H4                      (1002)
+// btsnoop timestamps are microseconds since midnight, January 1st, 0 AD
+#define BTSNOOP_EPOCH_DELTA                      (0x00dcddb30f2f8000ULL)
+#define BTSNOOP_FLAG_RECEIVED                    (1 << 0)
+#define BTSNOOP_FLAG_CMD_EVT                     (1 << 1)
+
+static bool s_btsnoop_started;
+static uint32_t s_btsnoop_drops;
+
+static inline void IRAM_ATTR btsnoop_put_be32(uint8_t *p, uint32_t val)
+{
+    p[0] = val >> 24;
+    p[1] = val >> 16;
+    p[2] = val >> 8;
+    p[3] = val;
+}
+
+static esp_err_t bt_hci_log_btsnoop_init(void)
+{
+    uint8_t hdr[BTSNOOP_HDR_SIZE] = {'b', 't', 's', 'n', 'o', 'o', 'p', '\0'};
+    esp_err_t ret;
+
+    if (s_btsnoop_started) {
+        return ESP_OK;
+    }
+
+    btsnoop_put_be32(&hdr[8], BTSNOOP_VERSION);
+    btsnoop_put_be32(&hdr[12], BTSNOOP_DATALINK_H4);
+    ret = esp_apptrace_write(BT_HCI_LOG_APPTRACE_DEST, hdr, sizeof(hdr), BT_HCI_LOG_APPTRACE_TMO);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    s_btsnoop_drops = 0;
+    s_btsnoop_started = true;
+    return ESP_OK;
+}
+
+esp_err_t IRAM_ATTR bt_hci_log_record_hci_pkt(bool received, uint8_t *data, uint16_t data_len)
+{
+    uint8_t *rec;
+    uint32_t flags;
+    uint64_t timestamp;
+
+    if (!s_btsnoop_started || !data || !data_len) {
+        return ESP_FAIL;
+    }
+
+    // the record is built in the trace buffer, the packet is only copied once and never waits for the host
+    rec = esp_apptrace_buffer_get(BT_HCI_LOG_APPTRACE_DEST, BTSNOOP_REC_HDR_SIZE + data_len, 0);
+    if (!rec) {
+        __atomic_fetch_add(&s_btsnoop_drops, 1, __ATOMIC_RELAXED);
+        return ESP_ERR_NO_MEM;
+    }
+
+    flags = received ? BTSNOOP_FLAG_RECEIVED : 0;
+    if (data[0] == HCI_LOG_DATA_TYPE_COMMAND || data[0] == HCI_LOG_DATA_TYPE_EVENT) {
+        flags |= BTSNOOP_FLAG_CMD_EVT;
+    }
+    timestamp = esp_timer_get_time() + BTSNOOP_EPOCH_DELTA;
+
+    btsnoop_put_be32(&rec[0], data_len);
+    btsnoop_put_be32(&rec[4], data_len);
+    btsnoop_put_be32(&rec[8], flags);
+    btsnoop_put_be32(&rec[12], __atomic_load_n(&s_btsnoop_drops, __ATOMIC_RELAXED));
+    btsnoop_put_be32(&rec[16], timestamp >> 32);
+    btsnoop_put_be32(&rec[20], timestamp);
+    memcpy(&rec[BTSNOOP_REC_HDR_SIZE], data, data_len);
+
+    return esp_apptrace_buffer_put(BT_HCI_LOG_APPTRACE_DEST, rec, 0);
+}
+#endif // (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
+
 esp_err_t bt_hci_log_init(void)
 {
+#if (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
+    // the text buffers are not used, bt_hci_log_record_hci_data() and the other text records fail
+    return bt_hci_log_btsnoop_init();
+#else
     uint8_t *g_bt_hci_log_data_buffer = NULL;
     uint8_t *g_bt_hci_log_adv_buffer  = NULL;
 
@@ -67,10 +159,19 @@ esp_err_t bt_hci_log_init(void)
     osi_mutex_new((osi_mutex_t *)&g_bt_hci_log_adv_ctl.mutex_lock);
 
     return ESP_OK;
+#endif // (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
 }
 
 esp_err_t bt_hci_log_deinit(void)
 {
+#if (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
+    if (s_btsnoop_started) {
+        s_btsnoop_started = false;
+        esp_apptrace_flush(BT_HCI_LOG_APPTRACE_DEST, BT_HCI_LOG_APPTRACE_TMO);
+    }
+
+    return ESP_OK;
+#else
     if (g_bt_hci_log_data_ctl.p_hci_log_buffer) {
         free(g_bt_hci_log_data_ctl.p_hci_log_buffer);
         g_bt_hci_log_data_ctl.p_hci_log_buffer = NULL;
@@ -88,6 +189,7 @@ esp_err_t bt_hci_log_deinit(void)
     memset(&g_bt_hci_log_adv_ctl, 0, sizeof(bt_hci_log_t));
 
     return ESP_OK;
+#endif // (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
 }
 
 #if (BT_HCI_LOG_PRINT_TAG)
@@ -323,7 +425,13 @@ esp_err_t IRAM_ATTR bt_hci_log_record_hci_adv(uint8_t data_type, uint8_t *data,
 
 void bt_hci_log_hci_data_show(void)
 {
+#if (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
+    if (s_btsnoop_started) {
+        esp_apptrace_flush(BT_HCI_LOG_APPTRACE_DEST, BT_HCI_LOG_APPTRACE_TMO);
+    }
+#else
     bt_hci_log_data_show(&g_bt_hci_log_data_ctl);
+#endif
 }
 
 void bt_hci_log_hci_adv_show(void)
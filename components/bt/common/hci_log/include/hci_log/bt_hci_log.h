@@ -7,6 +7,8 @@
 #ifndef __ESP_BT_HCI_LOG_H__
 #define __ESP_BT_HCI_LOG_H__
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -35,8 +37,9 @@ extern "C" {
 esp_err_t bt_hci_log_record_custom_data(char *string, uint8_t *data, uint8_t data_len);
 /**
  *
- * @brief           This function is called to print all hci data record
- *
+ * @brief           This function is called to print all hci data record,
+ *                  or to flush the btsnoop records to the trace host
+ *                  when CONFIG_BT_HCI_LOG_OUTPUT_APPTRACE is enabled
  *
  * @return          None
  *
@@ -101,6 +104,21 @@ esp_err_t bt_hci_log_record_hci_data(uint8_t data_type, uint8_t *data, uint8_t d
  */
 esp_err_t bt_hci_log_record_hci_adv(uint8_t data_type, uint8_t *data, uint8_t data_len);
 
+/**
+ *
+ * @brief           This function is called to record a complete hci packet in btsnoop format,
+ *                  when CONFIG_BT_HCI_LOG_OUTPUT_APPTRACE is enabled,
+ *                  and can only be called internally by Bluetooth
+ *
+ * @param received : true for the packets from the controller to the host
+ * @param data :    hci packet, starting with the H4 packet type
+ * @param data_len : the length of the packet
+ * @return          ESP_OK - success, ESP_ERR_NO_MEM - the trace buffer is full and the packet is dropped,
+ *                  other - failed
+ *
+ */
+esp_err_t bt_hci_log_record_hci_pkt(bool received, uint8_t *data, uint16_t data_len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -84,6 +84,12 @@
 #define BT_HCI_LOG_INCLUDED  FALSE
 #endif
 
+#if (BT_HCI_LOG_INCLUDED == TRUE) && UC_BT_HCI_LOG_OUTPUT_APPTRACE
+#define BT_HCI_LOG_BTSNOOP_INCLUDED  TRUE
+#else
+#define BT_HCI_LOG_BTSNOOP_INCLUDED  FALSE
+#endif
+
 #if UC_BT_HCI_LOG_DATA_BUFFER_SIZE
 #define HCI_LOG_DATA_BUFFER_SIZE  UC_BT_HCI_LOG_DATA_BUFFER_SIZE
 #else
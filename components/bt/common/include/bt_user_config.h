@@ -107,6 +107,54 @@
 #define UC_BT_BLUEDROID_MEM_DEBUG FALSE
 #endif
 
+#ifdef CONFIG_BT_BLUEDROID_LOCKLESS_WORK_QUEUE
+#define UC_BT_BLUEDROID_LOCKLESS_WORK_QUEUE TRUE
+#else
+#define UC_BT_BLUEDROID_LOCKLESS_WORK_QUEUE FALSE
+#endif
+
+#ifdef CONFIG_BT_BLUEDROID_PKT_POOL
+#define UC_BT_BLUEDROID_PKT_POOL TRUE
+#else
+#define UC_BT_BLUEDROID_PKT_POOL FALSE
+#endif
+
+#ifdef CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_SIZE
+#define UC_BT_BLUEDROID_PKT_POOL_SMALL_BUF_SIZE     CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_SIZE
+#else
+#define UC_BT_BLUEDROID_PKT_POOL_SMALL_BUF_SIZE     96
+#endif
+
+#ifdef CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM
+#define UC_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM      CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM
+#else
+#define UC_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM      16
+#endif
+
+#ifdef CONFIG_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_SIZE
+#define UC_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_SIZE    CONFIG_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_SIZE
+#else
+#define UC_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_SIZE    288
+#endif
+
+#ifdef CONFIG_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_NUM
+#define UC_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_NUM     CONFIG_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_NUM
+#else
+#define UC_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_NUM     16
+#endif
+
+#ifdef CONFIG_BT_BLUEDROID_PKT_POOL_LARGE_BUF_SIZE
+#define UC_BT_BLUEDROID_PKT_POOL_LARGE_BUF_SIZE     CONFIG_BT_BLUEDROID_PKT_POOL_LARGE_BUF_SIZE
+#else
+#define UC_BT_BLUEDROID_PKT_POOL_LARGE_BUF_SIZE     1064
+#endif
+
+#ifdef CONFIG_BT_BLUEDROID_PKT_POOL_LARGE_BUF_NUM
+#define UC_BT_BLUEDROID_PKT_POOL_LARGE_BUF_NUM      CONFIG_BT_BLUEDROID_PKT_POOL_LARGE_BUF_NUM
+#else
+#define UC_BT_BLUEDROID_PKT_POOL_LARGE_BUF_NUM      0
+#endif
+
 #ifdef CONFIG_BT_ALLOCATION_FROM_SPIRAM_FIRST
 #define UC_HEAP_ALLOCATION_FROM_SPIRAM_FIRST    CONFIG_BT_ALLOCATION_FROM_SPIRAM_FIRST
 #else
@@ -126,6 +174,12 @@
 #define UC_BT_HCI_LOG_DEBUG_EN  FALSE
 #endif
 
+#ifdef CONFIG_BT_HCI_LOG_OUTPUT_APPTRACE
+#define UC_BT_HCI_LOG_OUTPUT_APPTRACE  TRUE
+#else
+#define UC_BT_HCI_LOG_OUTPUT_APPTRACE  FALSE
+#endif
+
 #ifdef CONFIG_BT_HCI_LOG_DATA_BUFFER_SIZE
 #define UC_BT_HCI_LOG_DATA_BUFFER_SIZE  CONFIG_BT_HCI_LOG_DATA_BUFFER_SIZE
 #else
@@ -241,5 +241,10 @@ void *osi_calloc_func(size_t size)
 
 void osi_free_func(void *ptr)
 {
+#if UC_BT_BLUEDROID_PKT_POOL
+    if (osi_pkt_pool_free(ptr)) {
+        return;
+    }
+#endif
     free(ptr);
 }
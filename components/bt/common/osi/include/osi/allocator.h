@@ -22,6 +22,10 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include "esp_heap_caps.h"
+#include "bt_user_config.h"
+#if UC_BT_BLUEDROID_PKT_POOL
+#include "osi/pkt_pool.h"
+#endif
 
 char *osi_strdup(const char *str);
 
@@ -113,12 +117,23 @@ do {                                                    \
 } while(0)
 #endif
 
+#if UC_BT_BLUEDROID_PKT_POOL
+#define osi_free(ptr)                                   \
+do {                                                    \
+    void *tmp_point = (void *)(ptr);                    \
+    if (!osi_pkt_pool_free(tmp_point)) {                \
+        osi_mem_dbg_clean(tmp_point, __func__, __LINE__); \
+        free(tmp_point);                                \
+    }                                                   \
+} while (0)
+#else
 #define osi_free(ptr)                                   \
 do {                                                    \
     void *tmp_point = (void *)(ptr);                    \
     osi_mem_dbg_clean(tmp_point, __func__, __LINE__);   \
     free(tmp_point);                                    \
 } while (0)
+#endif /* UC_BT_BLUEDROID_PKT_POOL */
 
 #else
 
@@ -134,10 +149,23 @@ do {                                                    \
 // Memory alloc function with print and assertion when fails
 #define osi_malloc(size)                  osi_malloc_func((size))
 #define osi_calloc(size)                  osi_calloc_func((size))
+#if UC_BT_BLUEDROID_PKT_POOL
+#define osi_free(p)                       osi_free_func((p))
+#else
 #define osi_free(p)                       free((p))
+#endif /* UC_BT_BLUEDROID_PKT_POOL */
 
 #endif /* HEAP_MEMORY_DEBUG */
 
+// Packet buffers, allocated from the packet pools if they're enabled and freed with osi_free
+#if UC_BT_BLUEDROID_PKT_POOL
+#define osi_pkt_malloc(size)              osi_pkt_pool_malloc((size))
+#define osi_pkt_calloc(size)              osi_pkt_pool_calloc((size))
+#else
+#define osi_pkt_malloc(size)              osi_malloc((size))
+#define osi_pkt_calloc(size)              osi_calloc((size))
+#endif /* UC_BT_BLUEDROID_PKT_POOL */
+
 #define FREE_AND_RESET(a)   \
 do {                        \
     if (a) {                \
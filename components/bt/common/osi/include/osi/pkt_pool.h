@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _PKT_POOL_H_
+#define _PKT_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OSI_PKT_POOL_CLASS_NUM      3
+
+typedef struct {
+    uint16_t buf_size;          /* size of the buffers of the class */
+    uint16_t buf_num;           /* number of buffers of the class */
+    uint16_t in_use;            /* number of buffers currently allocated */
+    uint16_t high_water;        /* maximum number of buffers allocated at the same time */
+    uint32_t alloc_count;       /* number of allocations served by the class */
+    uint32_t exhausted_count;   /* number of allocations which found the class exhausted, served by a larger class or the heap */
+} osi_pkt_pool_stats_t;
+
+// Preallocates the buffers of the packet pools. Returns false if the memory
+// can't be allocated. Calling it again while the pools exist has no effect.
+bool osi_pkt_pool_init(void);
+
+// Frees the memory of the packet pools. The pools are kept if buffers are
+// still allocated from them.
+void osi_pkt_pool_deinit(void);
+
+// Allocates a packet buffer of |size| bytes from the smallest pool it fits
+// into. Falls back to the heap if the size is larger than the largest pool
+// or the pools are exhausted. The buffer is freed with |osi_free|.
+void *osi_pkt_pool_malloc(size_t size);
+
+// Same as |osi_pkt_pool_malloc|, the first |size| bytes are zeroed.
+void *osi_pkt_pool_calloc(size_t size);
+
+// Returns the buffer to its pool. Returns false if |ptr| isn't a pool buffer,
+// in which case the caller must free it.
+bool osi_pkt_pool_free(void *ptr);
+
+// Copies the statistics of the pool |class_idx| to |stats|. Returns false if
+// the class doesn't exist.
+bool osi_pkt_pool_get_stats(uint8_t class_idx, osi_pkt_pool_stats_t *stats);
+
+// Prints the statistics of all pools.
+void osi_pkt_pool_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PKT_POOL_H_ */
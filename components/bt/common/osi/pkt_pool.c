@@ -0,0 +1,206 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+
+#include "bt_common.h"
+#include "osi/allocator.h"
+#include "osi/pkt_pool.h"
+#include "freertos/FreeRTOS.h"
+
+#if UC_BT_BLUEDROID_PKT_POOL
+
+/*
+ * The HCI packets, ACL fragments and L2CAP PDUs are allocated and freed at a high rate while connections are active,
+ * which fragments the heap. The packet pools preallocate buffers of a few size classes in a single block at the stack
+ * init and keep the free buffers of each class in a list. Since the classes are stored one after the other in the
+ * block, the class of a buffer is found from its address, so osi_free() returns the pool buffers to their pool and
+ * frees the others.
+ */
+
+typedef struct pool_buf {
+    struct pool_buf *next;
+} pool_buf_t;
+
+typedef struct {
+    uint8_t *start;
+    uint8_t *end;
+    pool_buf_t *free_list;
+    osi_pkt_pool_stats_t stats;
+} pool_class_t;
+
+static const uint16_t s_buf_sizes[OSI_PKT_POOL_CLASS_NUM] = {
+    UC_BT_BLUEDROID_PKT_POOL_SMALL_BUF_SIZE,
+    UC_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_SIZE,
+    UC_BT_BLUEDROID_PKT_POOL_LARGE_BUF_SIZE,
+};
+
+static const uint16_t s_buf_nums[OSI_PKT_POOL_CLASS_NUM] = {
+    UC_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM,
+    UC_BT_BLUEDROID_PKT_POOL_MEDIUM_BUF_NUM,
+    UC_BT_BLUEDROID_PKT_POOL_LARGE_BUF_NUM,
+};
+
+static pool_class_t s_classes[OSI_PKT_POOL_CLASS_NUM];
+static uint8_t *s_pool_start;
+static uint8_t *s_pool_end;
+static portMUX_TYPE s_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+
+bool osi_pkt_pool_init(void)
+{
+    size_t total = 0;
+
+    if (s_pool_start) {
+        return true;
+    }
+
+    for (int i = 0; i < OSI_PKT_POOL_CLASS_NUM; i++) {
+        // the buffers hold BT_HDR structures, keep them word aligned
+        uint16_t buf_size = (s_buf_sizes[i] + 3) & ~3;
+        memset(&s_classes[i], 0, sizeof(pool_class_t));
+        s_classes[i].stats.buf_size = buf_size;
+        s_classes[i].stats.buf_num = s_buf_nums[i];
+        total += buf_size * s_buf_nums[i];
+    }
+    if (total == 0) {
+        return true;
+    }
+
+    uint8_t *block = osi_malloc(total);
+    if (!block) {
+        OSI_TRACE_ERROR("%s failed to allocate %u bytes\n", __func__, total);
+        return false;
+    }
+
+    uint8_t *p = block;
+    for (int i = 0; i < OSI_PKT_POOL_CLASS_NUM; i++) {
+        pool_class_t *cls = &s_classes[i];
+        cls->start = p;
+        for (int j = 0; j < cls->stats.buf_num; j++) {
+            pool_buf_t *buf = (pool_buf_t *)p;
+            buf->next = cls->free_list;
+            cls->free_list = buf;
+            p += cls->stats.buf_size;
+        }
+        cls->end = p;
+    }
+    s_pool_start = block;
+    s_pool_end = p;
+    return true;
+}
+
+void osi_pkt_pool_deinit(void)
+{
+    if (!s_pool_start) {
+        return;
+    }
+
+    for (int i = 0; i < OSI_PKT_POOL_CLASS_NUM; i++) {
+        if (s_classes[i].stats.in_use) {
+            OSI_TRACE_WARNING("%s %u buffers of %u bytes still in use, keep the pools\n", __func__,
+                              s_classes[i].stats.in_use, s_classes[i].stats.buf_size);
+            return;
+        }
+    }
+
+    // the block must not be taken for a pool buffer when it's freed
+    uint8_t *block = s_pool_start;
+    s_pool_start = NULL;
+    s_pool_end = NULL;
+    memset(s_classes, 0, sizeof(s_classes));
+    osi_free(block);
+}
+
+void *osi_pkt_pool_malloc(size_t size)
+{
+    pool_buf_t *buf = NULL;
+
+    portENTER_CRITICAL(&s_pool_lock);
+    for (int i = 0; i < OSI_PKT_POOL_CLASS_NUM; i++) {
+        pool_class_t *cls = &s_classes[i];
+        if (size > cls->stats.buf_size || cls->stats.buf_num == 0) {
+            continue;
+        }
+        if (cls->free_list) {
+            buf = cls->free_list;
+            cls->free_list = buf->next;
+            cls->stats.alloc_count++;
+            if (++cls->stats.in_use > cls->stats.high_water) {
+                cls->stats.high_water = cls->stats.in_use;
+            }
+            break;
+        }
+        // the larger classes are tried before falling back to the heap
+        cls->stats.exhausted_count++;
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+
+    if (buf) {
+        return buf;
+    }
+    return osi_malloc(size);
+}
+
+void *osi_pkt_pool_calloc(size_t size)
+{
+    void *p = osi_pkt_pool_malloc(size);
+
+    if (p) {
+        memset(p, 0, size);
+    }
+    return p;
+}
+
+bool osi_pkt_pool_free(void *ptr)
+{
+    uint8_t *p = ptr;
+
+    if (p < s_pool_start || p >= s_pool_end) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&s_pool_lock);
+    for (int i = 0; i < OSI_PKT_POOL_CLASS_NUM; i++) {
+        pool_class_t *cls = &s_classes[i];
+        if (p >= cls->start && p < cls->end) {
+            assert((p - cls->start) % cls->stats.buf_size == 0);
+            pool_buf_t *buf = (pool_buf_t *)p;
+            buf->next = cls->free_list;
+            cls->free_list = buf;
+            cls->stats.in_use--;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+    return true;
+}
+
+bool osi_pkt_pool_get_stats(uint8_t class_idx, osi_pkt_pool_stats_t *stats)
+{
+    if (class_idx >= OSI_PKT_POOL_CLASS_NUM || !stats) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&s_pool_lock);
+    *stats = s_classes[class_idx].stats;
+    portEXIT_CRITICAL(&s_pool_lock);
+    return true;
+}
+
+void osi_pkt_pool_dump(void)
+{
+    osi_pkt_pool_stats_t stats;
+
+    for (uint8_t i = 0; i < OSI_PKT_POOL_CLASS_NUM; i++) {
+        osi_pkt_pool_get_stats(i, &stats);
+        OSI_TRACE_ERROR("--> pool %u: size %uB, num %u, in use %u, high water %u, allocs %" PRIu32 ", exhausted %" PRIu32 "\n",
+                        i, stats.buf_size, stats.buf_num, stats.in_use, stats.high_water,
+                        stats.alloc_count, stats.exhausted_count);
+    }
+}
+
+#endif /* UC_BT_BLUEDROID_PKT_POOL */
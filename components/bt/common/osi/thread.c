@@ -30,10 +30,28 @@ struct work_item {
     void *context;
 };
 
+#if UC_BT_BLUEDROID_LOCKLESS_WORK_QUEUE
+/*
+ * Ring buffer of work items with multiple posters and a single consumer, the thread. The posters serialize with a
+ * spinlock held only while the item is copied, the thread takes the items without locking. Both indexes run freely,
+ * the ring size is the capacity rounded up to a power of two.
+ */
+struct work_queue {
+    struct work_item *items;
+    size_t capacity;
+    uint32_t mask;
+    uint32_t head;              /*!< Next item taken by the thread, only written by the thread */
+    uint32_t tail;              /*!< Next item posted, written by the posters under the lock */
+    uint32_t waiters;           /*!< Number of posters waiting for space */
+    portMUX_TYPE lock;
+    osi_sem_t space_sem;        /*!< Given by the thread when it frees space for the waiting posters */
+};
+#else
 struct work_queue {
     QueueHandle_t queue;
     size_t capacity;
 };
+#endif
 
 struct osi_thread {
   TaskHandle_t thread_handle;           /*!< Store the thread object */
@@ -43,6 +61,9 @@ struct osi_thread {
   struct work_queue **work_queues;      /*!< Point to queue array, and the priority inverse array index */
   osi_sem_t work_sem;
   osi_sem_t stop_sem;
+#if UC_BT_BLUEDROID_LOCKLESS_WORK_QUEUE
+  bool idle;                            /*!< The thread waits for work_sem, posters only give it when set */
+#endif
 };
 
 struct osi_thread_start_arg {
@@ -61,6 +82,127 @@ struct osi_event {
 
 static const size_t DEFAULT_WORK_QUEUE_CAPACITY = 100;
 
+#if UC_BT_BLUEDROID_LOCKLESS_WORK_QUEUE
+static struct work_queue *osi_work_queue_create(size_t capacity)
+{
+    if (capacity == 0) {
+        return NULL;
+    }
+
+    uint32_t ring_size = 1;
+    while (ring_size < capacity) {
+        ring_size <<= 1;
+    }
+
+    struct work_queue *wq = (struct work_queue *)osi_calloc(sizeof(struct work_queue));
+    if (wq != NULL) {
+        wq->items = (struct work_item *)osi_malloc(ring_size * sizeof(struct work_item));
+        if (wq->items != NULL && osi_sem_new(&wq->space_sem, 1, 0) == 0) {
+            wq->capacity = capacity;
+            wq->mask = ring_size - 1;
+            portMUX_INITIALIZE(&wq->lock);
+            return wq;
+        }
+        if (wq->items != NULL) {
+            osi_free(wq->items);
+        }
+        osi_free(wq);
+    }
+
+    return NULL;
+}
+
+static void osi_work_queue_delete(struct work_queue *wq)
+{
+    if (wq != NULL) {
+        osi_sem_free(&wq->space_sem);
+        osi_free(wq->items);
+        wq->items = NULL;
+        wq->capacity = 0;
+        osi_free(wq);
+    }
+    return;
+}
+
+static bool osi_thead_work_queue_get(struct work_queue *wq, struct work_item *item)
+{
+    assert (wq != NULL);
+    assert (item != NULL);
+
+    // pairs with the store of the tail by the posters, the item is complete once the tail covers it
+    uint32_t tail = __atomic_load_n(&wq->tail, __ATOMIC_SEQ_CST);
+    if (wq->head == tail) {
+        return false;
+    }
+
+    *item = wq->items[wq->head & wq->mask];
+    __atomic_store_n(&wq->head, wq->head + 1, __ATOMIC_RELEASE);
+
+    if (__atomic_load_n(&wq->waiters, __ATOMIC_ACQUIRE) != 0) {
+        osi_sem_give(&wq->space_sem);
+    }
+    return true;
+}
+
+static bool osi_thead_work_queue_put(struct work_queue *wq, const struct work_item *item, uint32_t timeout)
+{
+    assert (wq != NULL);
+    assert (item != NULL);
+
+    TickType_t start = xTaskGetTickCount();
+
+    while (1) {
+        portENTER_CRITICAL(&wq->lock);
+        uint32_t tail = wq->tail;
+        uint32_t used = tail - __atomic_load_n(&wq->head, __ATOMIC_ACQUIRE);
+        if (used < wq->capacity) {
+            wq->items[tail & wq->mask] = *item;
+            __atomic_store_n(&wq->tail, tail + 1, __ATOMIC_SEQ_CST);
+            bool wake_waiter = (wq->waiters != 0 && used + 1 < wq->capacity);
+            portEXIT_CRITICAL(&wq->lock);
+            // pass the wake up on to the other posters waiting for space
+            if (wake_waiter) {
+                osi_sem_give(&wq->space_sem);
+            }
+            return true;
+        }
+        wq->waiters++;
+        portEXIT_CRITICAL(&wq->lock);
+
+        uint32_t wait_ms = timeout;
+        if (timeout != OSI_SEM_MAX_TIMEOUT) {
+            uint32_t elapsed_ms = (xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+            wait_ms = (elapsed_ms < timeout) ? timeout - elapsed_ms : 0;
+        }
+        bool woken = (wait_ms != 0 && osi_sem_take(&wq->space_sem, wait_ms) == 0);
+
+        portENTER_CRITICAL(&wq->lock);
+        wq->waiters--;
+        portEXIT_CRITICAL(&wq->lock);
+        if (!woken) {
+            return false;
+        }
+    }
+}
+
+static size_t osi_thead_work_queue_len(struct work_queue *wq)
+{
+    assert (wq != NULL);
+    assert (wq->capacity != 0);
+
+    return __atomic_load_n(&wq->tail, __ATOMIC_ACQUIRE) - __atomic_load_n(&wq->head, __ATOMIC_ACQUIRE);
+}
+
+static bool osi_thread_has_work(osi_thread_t *thread)
+{
+    for (int i = 0; i < thread->work_queue_num; i++) {
+        if (osi_thead_work_queue_len(thread->work_queues[i]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+#else
 static struct work_queue *osi_work_queue_create(size_t capacity)
 {
     if (capacity == 0) {
@@ -143,6 +285,8 @@ static size_t osi_thead_work_queue_len(struct work_queue *wq)
     return 0;
 }
 
+#endif /* UC_BT_BLUEDROID_LOCKLESS_WORK_QUEUE */
+
 static void osi_thread_run(void *arg)
 {
     struct osi_thread_start_arg *start = (struct osi_thread_start_arg *)arg;
@@ -168,6 +312,17 @@ static void osi_thread_run(void *arg)
             } else {
                 idx++;
             }
+#if UC_BT_BLUEDROID_LOCKLESS_WORK_QUEUE
+            if (idx == thread->work_queue_num) {
+                /* All queues are empty: mark the thread idle so that the next post gives work_sem, then check the
+                 * queues again for an item posted before the posters could see the flag. If a poster already
+                 * cleared the flag, work_sem is given and the next take returns at once. */
+                __atomic_store_n(&thread->idle, true, __ATOMIC_SEQ_CST);
+                if (osi_thread_has_work(thread) && __atomic_exchange_n(&thread->idle, false, __ATOMIC_SEQ_CST)) {
+                    idx = 0;
+                }
+            }
+#endif
         }
     }
 
@@ -220,6 +375,9 @@ osi_thread_t *osi_thread_create(const char *name, size_t stack_size, int priorit
     }
 
     thread->stop = false;
+#if UC_BT_BLUEDROID_LOCKLESS_WORK_QUEUE
+    thread->idle = true;
+#endif
     thread->work_queues = (struct work_queue **)osi_calloc(sizeof(struct work_queue *) * work_queue_num);
     if (thread->work_queues == NULL) {
         goto _err;
@@ -345,6 +503,12 @@ bool osi_thread_post(osi_thread_t *thread, osi_thread_func_t func, void *context
         return false;
     }
 
+#if UC_BT_BLUEDROID_LOCKLESS_WORK_QUEUE
+    // the thread drains all queues before it waits again, so it only needs to be woken up when it's idle
+    if (!__atomic_exchange_n(&thread->idle, false, __ATOMIC_SEQ_CST)) {
+        return true;
+    }
+#endif
     osi_sem_give(&thread->work_sem);
 
     return true;
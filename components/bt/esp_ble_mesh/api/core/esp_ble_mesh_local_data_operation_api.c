@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2017-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2017-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -50,6 +50,22 @@ uint8_t esp_ble_mesh_get_element_count(void)
     return btc_ble_mesh_elem_count();
 }
 
+esp_err_t esp_ble_mesh_get_net_cache_stats(esp_ble_mesh_net_cache_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    btc_ble_mesh_net_cache_stats_get(stats);
+    return ESP_OK;
+}
+
+esp_err_t esp_ble_mesh_reset_net_cache_stats(void)
+{
+    btc_ble_mesh_net_cache_stats_reset();
+    return ESP_OK;
+}
+
 esp_ble_mesh_model_t *esp_ble_mesh_find_vendor_model(const esp_ble_mesh_elem_t *element,
                                                      uint16_t company_id, uint16_t model_id)
 {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2017-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2017-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -68,6 +68,29 @@ esp_ble_mesh_elem_t *esp_ble_mesh_find_element(uint16_t element_addr);
  */
 uint8_t esp_ble_mesh_get_element_count(void);
 
+/**
+ * @brief         Get the statistics of the network message cache and the
+ *                Replay Protection List since the last reset.
+ *
+ * @note          The statistics can be used to choose the values of
+ *                CONFIG_BLE_MESH_MSG_CACHE_SIZE and CONFIG_BLE_MESH_CRPL.
+ *
+ * @param[out]    stats: Pointer to the statistics.
+ *
+ * @return        ESP_OK on success or error code otherwise.
+ *
+ */
+esp_err_t esp_ble_mesh_get_net_cache_stats(esp_ble_mesh_net_cache_stats_t *stats);
+
+/**
+ * @brief         Reset the statistics of the network message cache and the
+ *                Replay Protection List.
+ *
+ * @return        ESP_OK on success or error code otherwise.
+ *
+ */
+esp_err_t esp_ble_mesh_reset_net_cache_stats(void);
+
 /**
  * @brief        Find the Vendor specific model with the given element,
  *               the company ID and the Vendor Model ID.
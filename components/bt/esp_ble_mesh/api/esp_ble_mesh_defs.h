@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2017-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2017-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -2500,6 +2500,17 @@ typedef union {
     } server_model_update_state;                /*!< Event parameter of ESP_BLE_MESH_SERVER_MODEL_UPDATE_STATE_COMP_EVT */
 } esp_ble_mesh_model_cb_param_t;
 
+/** Statistics of the network message cache and the Replay Protection List */
+typedef struct {
+    uint32_t msg_cache_lookups;     /*!< Network PDUs checked against the message cache */
+    uint32_t msg_cache_hits;        /*!< Network PDUs found in the message cache, i.e. dropped as duplicates */
+    uint32_t msg_cache_evictions;   /*!< Message cache entries replaced by newer messages */
+    uint32_t rpl_lookups;           /*!< Messages checked against the Replay Protection List */
+    uint32_t rpl_index_hits;        /*!< RPL lookups whose source address was found through the hash index */
+    uint32_t rpl_replays;           /*!< Messages rejected as replayed */
+    uint32_t rpl_full;              /*!< Messages rejected because the Replay Protection List is full */
+} esp_ble_mesh_net_cache_stats_t;
+
 #ifdef __cplusplus
 }
 #endif
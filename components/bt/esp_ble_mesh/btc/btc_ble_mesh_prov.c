@@ -1148,6 +1148,26 @@ uint8_t btc_ble_mesh_elem_count(void)
     return bt_mesh_elem_count();
 }
 
+void btc_ble_mesh_net_cache_stats_get(esp_ble_mesh_net_cache_stats_t *stats)
+{
+    struct bt_mesh_net_cache_stats net_stats = {0};
+
+    bt_mesh_net_cache_stats_get(&net_stats);
+
+    stats->msg_cache_lookups = net_stats.msg_cache_lookups;
+    stats->msg_cache_hits = net_stats.msg_cache_hits;
+    stats->msg_cache_evictions = net_stats.msg_cache_evictions;
+    stats->rpl_lookups = net_stats.rpl_lookups;
+    stats->rpl_index_hits = net_stats.rpl_index_hits;
+    stats->rpl_replays = net_stats.rpl_replays;
+    stats->rpl_full = net_stats.rpl_full;
+}
+
+void btc_ble_mesh_net_cache_stats_reset(void)
+{
+    bt_mesh_net_cache_stats_reset();
+}
+
 esp_ble_mesh_model_t *btc_ble_mesh_model_find_vnd(const esp_ble_mesh_elem_t *elem,
                                                   uint16_t company, uint16_t id)
 {
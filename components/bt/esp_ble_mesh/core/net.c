@@ -65,6 +65,21 @@ static struct {
 } msg_cache[CONFIG_BLE_MESH_MSG_CACHE_SIZE];
 static uint16_t msg_cache_next;
 
+/* Open addressing index of the message cache keyed by SRC and SEQ, so that
+ * a received Network PDU is checked without scanning the whole cache. Each
+ * slot holds the index of the cache entry plus one, or 0 when it is empty.
+ * The table has twice as many slots as the cache, so probe sequences stay
+ * short and there is always an empty slot to terminate them.
+ */
+#define MSG_CACHE_HASH_SIZE     (CONFIG_BLE_MESH_MSG_CACHE_SIZE * 2)
+static uint16_t msg_cache_hash[MSG_CACHE_HASH_SIZE];
+
+static struct {
+    uint32_t lookups;
+    uint32_t hits;
+    uint32_t evictions;
+} msg_cache_stats;
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
     .local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -107,14 +122,71 @@ static bool check_dup(struct net_buf_simple *data)
     return false;
 }
 
+static uint32_t msg_cache_hash_slot(uint16_t src, uint32_t seq)
+{
+    uint32_t key = ((uint32_t)src << 17) | (seq & BIT_MASK(17));
+
+    /* Multiplicative hashing spreads the consecutive SEQs of a source */
+    return (key * 2654435761U) % MSG_CACHE_HASH_SIZE;
+}
+
+/* Check if the slot x lies cyclically in (lo, hi] */
+static bool msg_cache_hash_between(uint32_t x, uint32_t lo, uint32_t hi)
+{
+    return (lo <= hi) ? (x > lo && x <= hi) : (x > lo || x <= hi);
+}
+
+static void msg_cache_hash_remove(uint16_t idx)
+{
+    uint32_t slot = msg_cache_hash_slot(msg_cache[idx].src, msg_cache[idx].seq);
+    uint32_t next = 0U;
+
+    while (msg_cache_hash[slot] != idx + 1) {
+        if (msg_cache_hash[slot] == 0U) {
+            return;
+        }
+        slot = (slot + 1) % MSG_CACHE_HASH_SIZE;
+    }
+
+    msg_cache_hash[slot] = 0U;
+
+    /* Shift back the following entries of the probe sequence which can't
+     * be reached any more through the emptied slot.
+     */
+    for (next = (slot + 1) % MSG_CACHE_HASH_SIZE; msg_cache_hash[next];
+         next = (next + 1) % MSG_CACHE_HASH_SIZE) {
+        uint16_t entry = msg_cache_hash[next] - 1;
+        uint32_t home = msg_cache_hash_slot(msg_cache[entry].src, msg_cache[entry].seq);
+
+        if (!msg_cache_hash_between(home, slot, next)) {
+            msg_cache_hash[slot] = msg_cache_hash[next];
+            msg_cache_hash[next] = 0U;
+            slot = next;
+        }
+    }
+}
+
+static void msg_cache_reset(void)
+{
+    (void)memset(msg_cache, 0, sizeof(msg_cache));
+    (void)memset(msg_cache_hash, 0, sizeof(msg_cache_hash));
+    msg_cache_next = 0U;
+}
+
 static bool msg_cache_match(struct bt_mesh_net_rx *rx,
                             struct net_buf_simple *pdu)
 {
-    int i;
+    uint16_t src = BLE_MESH_NET_HDR_SRC(pdu->data);
+    uint32_t seq = BLE_MESH_NET_HDR_SEQ(pdu->data) & BIT_MASK(17);
+    uint32_t slot = msg_cache_hash_slot(src, seq);
 
-    for (i = 0; i < ARRAY_SIZE(msg_cache); i++) {
-        if (msg_cache[i].src == BLE_MESH_NET_HDR_SRC(pdu->data) &&
-            msg_cache[i].seq == (BLE_MESH_NET_HDR_SEQ(pdu->data) & BIT_MASK(17))) {
+    msg_cache_stats.lookups++;
+
+    for (; msg_cache_hash[slot]; slot = (slot + 1) % MSG_CACHE_HASH_SIZE) {
+        uint16_t idx = msg_cache_hash[slot] - 1;
+
+        if (msg_cache[idx].src == src && msg_cache[idx].seq == seq) {
+            msg_cache_stats.hits++;
             return true;
         }
     }
@@ -124,10 +196,34 @@ static bool msg_cache_match(struct bt_mesh_net_rx *rx,
 
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
+    uint32_t slot = 0U;
+
     rx->msg_cache_idx = msg_cache_next++;
+    msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+    /* The oldest entry is replaced */
+    if (msg_cache[rx->msg_cache_idx].src != BLE_MESH_ADDR_UNASSIGNED) {
+        msg_cache_hash_remove(rx->msg_cache_idx);
+        msg_cache_stats.evictions++;
+    }
+
     msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
     msg_cache[rx->msg_cache_idx].seq = rx->seq;
-    msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+    slot = msg_cache_hash_slot(rx->ctx.addr, rx->seq);
+    while (msg_cache_hash[slot]) {
+        slot = (slot + 1) % MSG_CACHE_HASH_SIZE;
+    }
+    msg_cache_hash[slot] = rx->msg_cache_idx + 1;
+}
+
+/* Remove the entry added for a message which was just received */
+static void msg_cache_remove_last(struct bt_mesh_net_rx *rx)
+{
+    msg_cache_hash_remove(rx->msg_cache_idx);
+    msg_cache[rx->msg_cache_idx].src = BLE_MESH_ADDR_UNASSIGNED;
+    /* Rewind the next index now that we're not using this entry */
+    msg_cache_next = rx->msg_cache_idx;
 }
 
 #if CONFIG_BLE_MESH_PROVISIONER
@@ -138,12 +234,29 @@ void bt_mesh_msg_cache_clear(uint16_t unicast_addr, uint8_t elem_num)
     for (i = 0; i < ARRAY_SIZE(msg_cache); i++) {
         if (msg_cache[i].src >= unicast_addr &&
             msg_cache[i].src < unicast_addr + elem_num) {
+            msg_cache_hash_remove(i);
             memset(&msg_cache[i], 0, sizeof(msg_cache[i]));
         }
     }
 }
 #endif /* CONFIG_BLE_MESH_PROVISIONER */
 
+void bt_mesh_net_cache_stats_get(struct bt_mesh_net_cache_stats *stats)
+{
+    stats->msg_cache_lookups = msg_cache_stats.lookups;
+    stats->msg_cache_hits = msg_cache_stats.hits;
+    stats->msg_cache_evictions = msg_cache_stats.evictions;
+
+    bt_mesh_rpl_stats_get(stats);
+}
+
+void bt_mesh_net_cache_stats_reset(void)
+{
+    (void)memset(&msg_cache_stats, 0, sizeof(msg_cache_stats));
+
+    bt_mesh_rpl_stats_reset();
+}
+
 struct bt_mesh_subnet *bt_mesh_subnet_get(uint16_t net_idx)
 {
     if (bt_mesh_is_provisioned()) {
@@ -489,8 +602,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 
     BT_DBG("NetKey %s", bt_hex(key, 16));
 
-    (void)memset(msg_cache, 0, sizeof(msg_cache));
-    msg_cache_next = 0U;
+    msg_cache_reset();
 
     sub = &bt_mesh.sub[0];
 
@@ -1969,9 +2081,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
     */
     if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
         BT_WARN("Removing rejected message from Network Message Cache");
-        msg_cache[rx.msg_cache_idx].src = BLE_MESH_ADDR_UNASSIGNED;
-        /* Rewind the next index now that we're not using this entry */
-        msg_cache_next = rx.msg_cache_idx;
+        msg_cache_remove_last(&rx);
     }
 
     /* Relay if this was a group/virtual address, or if the destination
@@ -2081,8 +2191,7 @@ void bt_mesh_net_reset(void)
     memset(friend_cred, 0, sizeof(friend_cred));
 #endif
 
-    memset(msg_cache, 0, sizeof(msg_cache));
-    msg_cache_next = 0U;
+    msg_cache_reset();
 
     memset(dup_cache, 0, sizeof(dup_cache));
     dup_cache_next = 0U;
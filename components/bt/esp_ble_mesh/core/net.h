@@ -2,7 +2,7 @@
 
 /*
  * SPDX-FileCopyrightText: 2017 Intel Corporation
- * SPDX-FileContributor: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -428,6 +428,20 @@ extern struct bt_mesh_net bt_mesh;
 
 void bt_mesh_msg_cache_clear(uint16_t unicast_addr, uint8_t elem_num);
 
+struct bt_mesh_net_cache_stats {
+    uint32_t msg_cache_lookups;     /* Network PDUs checked against the message cache */
+    uint32_t msg_cache_hits;        /* Network PDUs found in the message cache */
+    uint32_t msg_cache_evictions;   /* Message cache entries replaced by newer messages */
+    uint32_t rpl_lookups;           /* Messages checked against the RPL */
+    uint32_t rpl_index_hits;        /* RPL lookups whose source was found through the index */
+    uint32_t rpl_replays;           /* Messages rejected as replayed */
+    uint32_t rpl_full;              /* Messages rejected because the RPL is full */
+};
+
+void bt_mesh_net_cache_stats_get(struct bt_mesh_net_cache_stats *stats);
+
+void bt_mesh_net_cache_stats_reset(void);
+
 int bt_mesh_net_keys_create(struct bt_mesh_subnet_keys *keys,
                             const uint8_t key[16]);
 
@@ -2,7 +2,7 @@
 
 /*
  * SPDX-FileCopyrightText: 2017 Intel Corporation
- * SPDX-FileContributor: 2018-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -15,6 +15,117 @@
 #include "mesh.h"
 #include "settings.h"
 
+/* Open addressing index of the RPL keyed by source address. Each slot holds
+ * the index of an RPL entry plus one, or 0 when it is empty. The RPL is also
+ * modified outside of this file (e.g. restored from flash or cleared on IV
+ * Update), so a slot is only a hint which is verified against the entry it
+ * points to, and a source missing from the index is looked up in the RPL
+ * itself before it is considered new.
+ */
+#define RPL_HASH_SIZE   (CONFIG_BLE_MESH_CRPL * 2)
+static uint16_t rpl_hash[RPL_HASH_SIZE];
+static uint32_t rpl_hash_used;
+
+static struct {
+    uint32_t lookups;
+    uint32_t index_hits;
+    uint32_t replays;
+    uint32_t full;
+} rpl_stats;
+
+static uint32_t rpl_hash_slot(uint16_t src)
+{
+    return (src * 2654435761U) % RPL_HASH_SIZE;
+}
+
+static void rpl_hash_insert(size_t index)
+{
+    uint32_t slot = rpl_hash_slot(bt_mesh.rpl[index].src);
+
+    while (rpl_hash[slot]) {
+        slot = (slot + 1) % RPL_HASH_SIZE;
+    }
+    rpl_hash[slot] = index + 1;
+    rpl_hash_used++;
+}
+
+static void rpl_hash_rebuild(void)
+{
+    (void)memset(rpl_hash, 0, sizeof(rpl_hash));
+    rpl_hash_used = 0U;
+
+    for (size_t i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+        if (bt_mesh.rpl[i].src != BLE_MESH_ADDR_UNASSIGNED) {
+            rpl_hash_insert(i);
+        }
+    }
+}
+
+static void rpl_hash_add(struct bt_mesh_rpl *rpl, uint16_t src)
+{
+    /* Drop the stale slots once the table is half full, so that there are
+     * always empty slots terminating the probe sequences.
+     */
+    if (rpl_hash_used >= RPL_HASH_SIZE / 2) {
+        rpl_hash_rebuild();
+    }
+
+    /* A slot is keyed by the source address stored in the entry, which is
+     * set for the empty entry returned for a segmented message only once
+     * the message is complete, so key it here already.
+     */
+    uint16_t old_src = rpl->src;
+    rpl->src = src;
+    rpl_hash_insert(rpl - bt_mesh.rpl);
+    rpl->src = old_src;
+}
+
+static struct bt_mesh_rpl *rpl_hash_find(uint16_t src)
+{
+    for (uint32_t slot = rpl_hash_slot(src); rpl_hash[slot];
+         slot = (slot + 1) % RPL_HASH_SIZE) {
+        struct bt_mesh_rpl *rpl = &bt_mesh.rpl[rpl_hash[slot] - 1];
+
+        if (rpl->src == src) {
+            return rpl;
+        }
+    }
+
+    return NULL;
+}
+
+/* Find the RPL entry of the source, or an empty entry for a new source */
+static struct bt_mesh_rpl *rpl_find(uint16_t src)
+{
+    struct bt_mesh_rpl *empty = NULL;
+    struct bt_mesh_rpl *rpl = rpl_hash_find(src);
+
+    if (rpl) {
+        rpl_stats.index_hits++;
+        return rpl;
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+        rpl = &bt_mesh.rpl[i];
+
+        if (rpl->src == src) {
+            /* Entry which was not indexed yet, e.g. restored from flash */
+            rpl_hash_add(rpl, src);
+            return rpl;
+        }
+
+        if (empty == NULL && rpl->src == BLE_MESH_ADDR_UNASSIGNED) {
+            empty = rpl;
+        }
+    }
+
+    if (empty) {
+        rpl_hash_add(empty, src);
+    }
+
+    return empty;
+}
+
 void bt_mesh_update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
 {
     rpl->src = rx->ctx.addr;
@@ -33,46 +144,50 @@ void bt_mesh_update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
  */
 static bool rpl_check_and_store(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 {
-    for (size_t i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-        struct bt_mesh_rpl *rpl = &bt_mesh.rpl[i];
+    struct bt_mesh_rpl *rpl = NULL;
 
-        /* Empty slot */
-        if (rpl->src == BLE_MESH_ADDR_UNASSIGNED) {
-            if (match) {
-                *match = rpl;
-            } else {
-                bt_mesh_update_rpl(rpl, rx);
-            }
+    rpl_stats.lookups++;
+
+    rpl = rpl_find(rx->ctx.addr);
+    if (rpl == NULL) {
+        rpl_stats.full++;
+        BT_ERR("RPL is full!");
+        return true;
+    }
 
-            return false;
+    /* Empty slot */
+    if (rpl->src == BLE_MESH_ADDR_UNASSIGNED) {
+        if (match) {
+            *match = rpl;
+        } else {
+            bt_mesh_update_rpl(rpl, rx);
         }
 
-        /* Existing slot for given address */
-        if (rpl->src == rx->ctx.addr) {
-            if (rx->old_iv && !rpl->old_iv) {
-                return true;
-            }
+        return false;
+    }
 
-            if ((!rx->old_iv && rpl->old_iv) ||
-                rpl->seq < rx->seq) {
-                if (match) {
-                    *match = rpl;
-                } else {
-                    bt_mesh_update_rpl(rpl, rx);
-                }
+    /* Existing slot for given address */
+    if (rx->old_iv && !rpl->old_iv) {
+        rpl_stats.replays++;
+        return true;
+    }
 
-                return false;
-            }
+    if ((!rx->old_iv && rpl->old_iv) ||
+        rpl->seq < rx->seq) {
+        if (match) {
+            *match = rpl;
+        } else {
+            bt_mesh_update_rpl(rpl, rx);
+        }
+
+        return false;
+    }
 
 #if CONFIG_BLE_MESH_NOT_RELAY_REPLAY_MSG
-            rx->replay_msg = 1;
+    rx->replay_msg = 1;
 #endif
 
-            return true;
-        }
-    }
-
-    BT_ERR("RPL is full!");
+    rpl_stats.replays++;
     return true;
 }
 
@@ -133,8 +248,23 @@ void bt_mesh_rpl_reset_single(uint16_t src, bool erase)
 void bt_mesh_rpl_reset(bool erase)
 {
     (void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+    (void)memset(rpl_hash, 0, sizeof(rpl_hash));
+    rpl_hash_used = 0U;
 
     if (IS_ENABLED(CONFIG_BLE_MESH_SETTINGS) && erase) {
         bt_mesh_clear_rpl();
     }
 }
+
+void bt_mesh_rpl_stats_get(struct bt_mesh_net_cache_stats *stats)
+{
+    stats->rpl_lookups = rpl_stats.lookups;
+    stats->rpl_index_hits = rpl_stats.index_hits;
+    stats->rpl_replays = rpl_stats.replays;
+    stats->rpl_full = rpl_stats.full;
+}
+
+void bt_mesh_rpl_stats_reset(void)
+{
+    (void)memset(&rpl_stats, 0, sizeof(rpl_stats));
+}
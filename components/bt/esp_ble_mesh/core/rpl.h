@@ -2,7 +2,7 @@
 
 /*
  * SPDX-FileCopyrightText: 2017 Intel Corporation
- * SPDX-FileContributor: 2018-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -26,6 +26,10 @@ void bt_mesh_rpl_reset_single(uint16_t src, bool erase);
 
 void bt_mesh_rpl_reset(bool erase);
 
+void bt_mesh_rpl_stats_get(struct bt_mesh_net_cache_stats *stats);
+
+void bt_mesh_rpl_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -144,6 +144,13 @@ esp_err_t esp_bluedroid_init_with_cfg(esp_bluedroid_config_t *cfg)
     osi_mem_dbg_init();
 #endif
 
+#if UC_BT_BLUEDROID_PKT_POOL
+    if (!osi_pkt_pool_init()) {
+        LOG_ERROR("Bluedroid packet pool initialize fail");
+        return ESP_ERR_NO_MEM;
+    }
+#endif
+
     ret = bluedriod_config_init(cfg);
     if (ret != BT_STATUS_SUCCESS) {
         LOG_ERROR("Bluedroid stack initialize fail, ret:%d", ret);
@@ -230,6 +237,10 @@ esp_err_t esp_bluedroid_deinit(void)
 
     bluedriod_config_deinit();
 
+#if UC_BT_BLUEDROID_PKT_POOL
+    osi_pkt_pool_deinit();
+#endif
+
 #if (BT_HCI_LOG_INCLUDED == TRUE)
     bt_hci_log_deinit();
 #endif // (BT_HCI_LOG_INCLUDED == TRUE)
@@ -540,7 +540,9 @@ static void host_send_pkt_available_cb(void)
 
 void bt_record_hci_data(uint8_t *data, uint16_t len)
 {
-#if (BT_HCI_LOG_INCLUDED == TRUE)
+#if (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
+    bt_hci_log_record_hci_pkt(true, data, len);
+#elif (BT_HCI_LOG_INCLUDED == TRUE)
     if ((data[0] == DATA_TYPE_EVENT) && (data[1] == HCI_BLE_EVENT) && ((data[3] ==  HCI_BLE_ADV_PKT_RPT_EVT) || (data[3] == HCI_BLE_DIRECT_ADV_EVT)
 #if (BLE_ADV_REPORT_FLOW_CONTROL == TRUE)
         || (data[3] ==  HCI_BLE_ADV_DISCARD_REPORT_EVT)
@@ -574,7 +576,7 @@ static int host_recv_pkt_cb(uint8_t *data, uint16_t len)
 
     if (!is_adv_rpt) {
         pkt_size = BT_HDR_SIZE + len;
-        pkt = (BT_HDR *) osi_calloc(pkt_size);
+        pkt = (BT_HDR *) osi_pkt_calloc(pkt_size);
         if (!pkt) {
             HCI_TRACE_ERROR("%s couldn't acquire memory for inbound data buffer.\n", __func__);
             assert(0);
@@ -170,7 +170,7 @@ static void reassemble_and_dispatch(BT_HDR *packet)
                 callbacks->reassembled(packet);
                 return;
             }
-            partial_packet = (BT_HDR *)osi_calloc(full_length + sizeof(BT_HDR));
+            partial_packet = (BT_HDR *)osi_pkt_calloc(full_length + sizeof(BT_HDR));
 
             if (partial_packet == NULL) {
                HCI_TRACE_WARNING("%s full_length %d no memory.\n", __func__, full_length);
@@ -55,7 +55,7 @@ typedef struct {
 
 static inline BT_HDR *hci_get_cmd_buf(size_t param_len)
 {
-    pkt_linked_item_t *linked_pkt = osi_calloc(HCI_CMD_LINKED_BUF_SIZE(param_len));
+    pkt_linked_item_t *linked_pkt = osi_pkt_calloc(HCI_CMD_LINKED_BUF_SIZE(param_len));
     if (linked_pkt == NULL) {
         return NULL;
     }
@@ -416,7 +416,7 @@ BOOLEAN l2c_is_cmd_rejected (UINT8 cmd_code, UINT8 id, tL2C_LCB *p_lcb)
 *******************************************************************************/
 BT_HDR *l2cu_build_header (tL2C_LCB *p_lcb, UINT16 len, UINT8 cmd, UINT8 id)
 {
-    BT_HDR  *p_buf = (BT_HDR *)osi_malloc(L2CAP_CMD_BUF_SIZE);
+    BT_HDR  *p_buf = (BT_HDR *)osi_pkt_malloc(L2CAP_CMD_BUF_SIZE);
     UINT8   *p;
 
     if (!p_buf) {
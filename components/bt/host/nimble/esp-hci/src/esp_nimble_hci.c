@@ -65,7 +65,9 @@ void ble_hci_trans_cfg_hs(ble_hci_trans_rx_cmd_fn *cmd_cb,
 
 void esp_vhci_host_send_packet_wrapper(uint8_t *data, uint16_t len)
 {
-#if (BT_HCI_LOG_INCLUDED == TRUE)
+#if (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
+    bt_hci_log_record_hci_pkt(false, data, len);
+#elif (BT_HCI_LOG_INCLUDED == TRUE)
     bt_hci_log_record_hci_data(data[0], &data[1], len - 1);
 #endif
     esp_vhci_host_send_packet(data, len);
@@ -197,7 +199,9 @@ static void dummy_controller_rcv_pkt_ready(void)
 
 void bt_record_hci_data(uint8_t *data, uint16_t len)
 {
-#if (BT_HCI_LOG_INCLUDED == TRUE)
+#if (BT_HCI_LOG_BTSNOOP_INCLUDED == TRUE)
+    bt_hci_log_record_hci_pkt(true, data, len);
+#elif (BT_HCI_LOG_INCLUDED == TRUE)
     if ((data[0] == BLE_HCI_UART_H4_EVT) && (data[1] == BLE_HCI_EVCODE_LE_META) && ((data[3] ==  BLE_HCI_LE_SUBEV_ADV_RPT) || (data[3] == BLE_HCI_LE_SUBEV_DIRECT_ADV_RPT)
         || (data[3] == BLE_HCI_LE_SUBEV_EXT_ADV_RPT) || (data[3] == BLE_HCI_LE_SUBEV_PERIODIC_ADV_RPT))) {
         bt_hci_log_record_hci_adv(HCI_LOG_DATA_TYPE_ADV, &data[2], len - 2);
@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ESP_NIMBLE_NOTIFY_H__
+#define __ESP_NIMBLE_NOTIFY_H__
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Notification sent by esp_nimble_gatts_notify_batch()
+ */
+typedef struct {
+    uint16_t conn_handle;   /*!< Connection the notification is sent to */
+    uint16_t attr_handle;   /*!< Value handle of the characteristic */
+    const void *value;      /*!< Value to notify, several notifications can point to the same value */
+    uint16_t len;           /*!< Length of the value */
+} esp_nimble_notify_t;
+
+/**
+ * @brief Send a batch of GATT notifications
+ *
+ * The notifications are sent in order with ble_gatts_notify_custom(). Before
+ * sending any of them, the number of free msys mbufs is checked against the
+ * number needed by the whole batch, so the batch isn't cut short because the
+ * mbufs of the first notifications are still queued to the controller.
+ *
+ * @param[in]  notifs   Notifications to send
+ * @param[in]  count    Number of notifications
+ * @param[out] out_sent Number of notifications sent, can be NULL
+ *
+ * @return
+ *    - ESP_OK if all the notifications are sent
+ *    - ESP_ERR_INVALID_ARG if notifs is NULL or a value is NULL
+ *    - ESP_ERR_NO_MEM if there aren't enough free mbufs for the batch, no notification is sent
+ *    - ESP_FAIL if a notification failed, the following ones are not sent
+ */
+esp_err_t esp_nimble_gatts_notify_batch(const esp_nimble_notify_t *notifs, int count, int *out_sent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESP_NIMBLE_NOTIFY_H__ */
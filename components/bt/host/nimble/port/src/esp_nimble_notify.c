@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_log.h"
+#include "host/ble_hs.h"
+#include "esp_nimble_notify.h"
+
+/* ATT opcode and attribute handle, L2CAP header and ACL header prepended by the host to the value */
+#define NOTIFY_HDR_LEN      (3 + 4 + 4)
+
+static const char *TAG = "esp_nimble_notify";
+
+static int notify_mbuf_count(uint16_t len)
+{
+    /* the first block of the chain also holds the packet header */
+    int data_len = sizeof(struct os_mbuf_pkthdr) + NOTIFY_HDR_LEN + len;
+    int block_len = MYNEWT_VAL(MSYS_1_BLOCK_SIZE) - sizeof(struct os_mbuf);
+
+    return (data_len + block_len - 1) / block_len;
+}
+
+esp_err_t esp_nimble_gatts_notify_batch(const esp_nimble_notify_t *notifs, int count, int *out_sent)
+{
+    int needed = 0;
+    int sent = 0;
+    esp_err_t err = ESP_OK;
+
+    if (out_sent) {
+        *out_sent = 0;
+    }
+    if (notifs == NULL || count < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (notifs[i].value == NULL && notifs[i].len > 0) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        needed += notify_mbuf_count(notifs[i].len);
+    }
+    if (os_msys_num_free() < needed) {
+        ESP_LOGD(TAG, "%d mbufs needed for %d notifications, %d free", needed, count, os_msys_num_free());
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (int i = 0; i < count; i++) {
+        /* the host prepends the headers to the chain and frees it once sent, so each notification has its own */
+        struct os_mbuf *om = ble_hs_mbuf_from_flat(notifs[i].value, notifs[i].len);
+        if (om == NULL) {
+            err = ESP_FAIL;
+            break;
+        }
+        int rc = ble_gatts_notify_custom(notifs[i].conn_handle, notifs[i].attr_handle, om);
+        if (rc != 0) {
+            ESP_LOGD(TAG, "notification %d to conn %d failed, rc=%d", i, notifs[i].conn_handle, rc);
+            err = ESP_FAIL;
+            break;
+        }
+        sent++;
+    }
+
+    if (out_sent) {
+        *out_sent = sent;
+    }
+    return err;
+}
@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+/*
+ Tests for the work queues of the OSI threads
+*/
+
+#include <stdbool.h>
+
+#include "unity.h"
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "osi/thread.h"
+
+#define TEST_POSTERS        2
+#define TEST_POSTS          1000
+#define TEST_QUEUE_LEN      5
+
+static uint32_t s_last[TEST_POSTERS];
+static uint32_t s_count;
+static bool s_in_order;
+static bool s_post_failed;
+
+static osi_thread_t *s_thread;
+static SemaphoreHandle_t s_done;
+
+static void work_func(void *context)
+{
+    uint32_t value = (uint32_t)context;
+    uint32_t poster = value >> 16;
+    uint32_t seq = value & 0xffff;
+
+    if (seq != s_last[poster] + 1) {
+        s_in_order = false;
+    }
+    s_last[poster] = seq;
+    s_count++;
+}
+
+static void poster_task(void *arg)
+{
+    uint32_t poster = (uint32_t)arg;
+
+    for (uint32_t seq = 1; seq <= TEST_POSTS; seq++) {
+        // the queue is short, the posts wait for space
+        if (!osi_thread_post(s_thread, work_func, (void *)((poster << 16) | seq), poster % 2, OSI_THREAD_MAX_TIMEOUT)) {
+            s_post_failed = true;
+        }
+    }
+    xSemaphoreGive(s_done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("osi thread runs the work posted by several tasks in order", "[bt_common]")
+{
+    const size_t queue_len[2] = { TEST_QUEUE_LEN, TEST_QUEUE_LEN };
+
+    s_count = 0;
+    s_in_order = true;
+    s_post_failed = false;
+    for (int i = 0; i < TEST_POSTERS; i++) {
+        s_last[i] = 0;
+    }
+    s_done = xSemaphoreCreateCounting(TEST_POSTERS, 0);
+    TEST_ASSERT_NOT_NULL(s_done);
+    s_thread = osi_thread_create("test_osi", 2048, 5, OSI_THREAD_CORE_0, 2, queue_len);
+    TEST_ASSERT_NOT_NULL(s_thread);
+
+    for (uint32_t i = 0; i < TEST_POSTERS; i++) {
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(poster_task, "test_poster", 2048, (void *)i, 5, NULL, i % CONFIG_FREERTOS_NUMBER_OF_CORES));
+    }
+    for (int i = 0; i < TEST_POSTERS; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(s_done, pdMS_TO_TICKS(5000)));
+    }
+    // let the thread run the last items, and the idle task free the posters
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    TEST_ASSERT_FALSE(s_post_failed);
+    TEST_ASSERT_EQUAL(TEST_POSTERS * TEST_POSTS, s_count);
+    TEST_ASSERT_TRUE(s_in_order);
+
+    osi_thread_free(s_thread);
+    vSemaphoreDelete(s_done);
+}
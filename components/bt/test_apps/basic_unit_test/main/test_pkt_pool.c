@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+/*
+ Tests for the Bluedroid packet pools
+*/
+
+#include <stdbool.h>
+
+#include "unity.h"
+#include "sdkconfig.h"
+#include "osi/allocator.h"
+
+#if CONFIG_BT_BLUEDROID_PKT_POOL
+
+TEST_CASE("packet pools serve the smallest class and fall back to the heap", "[bt_common]")
+{
+    osi_pkt_pool_stats_t small, medium;
+    void *bufs[CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM];
+
+    TEST_ASSERT_TRUE(osi_pkt_pool_init());
+    TEST_ASSERT_TRUE(osi_pkt_pool_get_stats(0, &small));
+    TEST_ASSERT_EQUAL(0, small.in_use);
+
+    for (int i = 0; i < CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM; i++) {
+        bufs[i] = osi_pkt_calloc(CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_SIZE);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+    }
+    TEST_ASSERT_TRUE(osi_pkt_pool_get_stats(0, &small));
+    TEST_ASSERT_EQUAL(CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM, small.in_use);
+    TEST_ASSERT_EQUAL(CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM, small.high_water);
+
+    // the small class is exhausted, the next buffer comes from the medium class
+    void *buf = osi_pkt_malloc(1);
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_TRUE(osi_pkt_pool_get_stats(0, &small));
+    TEST_ASSERT_TRUE(osi_pkt_pool_get_stats(1, &medium));
+    TEST_ASSERT_EQUAL(1, small.exhausted_count);
+    TEST_ASSERT_EQUAL(1, medium.in_use);
+    osi_free(buf);
+
+    // larger than every class, allocated from the heap
+    buf = osi_pkt_malloc(8192 + 1);
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_FALSE(osi_pkt_pool_free(buf));
+    osi_free(buf);
+
+    for (int i = 0; i < CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM; i++) {
+        osi_free(bufs[i]);
+    }
+    TEST_ASSERT_TRUE(osi_pkt_pool_get_stats(0, &small));
+    TEST_ASSERT_TRUE(osi_pkt_pool_get_stats(1, &medium));
+    TEST_ASSERT_EQUAL(0, small.in_use);
+    TEST_ASSERT_EQUAL(0, medium.in_use);
+    TEST_ASSERT_EQUAL(CONFIG_BT_BLUEDROID_PKT_POOL_SMALL_BUF_NUM, small.high_water);
+
+    osi_pkt_pool_deinit();
+}
+
+#endif /* CONFIG_BT_BLUEDROID_PKT_POOL */
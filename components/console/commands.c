@@ -18,6 +18,9 @@
 
 #define ANSI_COLOR_DEFAULT      39      /** Default foreground color */
 
+/** Number of buckets of the command hash table, a power of two */
+#define CMD_HASH_BUCKETS        32
+
 typedef struct cmd_item_ {
     /**
      * Command name (statically allocated by application)
@@ -37,6 +40,7 @@ typedef struct cmd_item_ {
     void *argtable;                                     //!< optional pointer to arg table
     void *context;                                      //!< optional pointer to user context
     SLIST_ENTRY(cmd_item_) next;                        //!< next command in the list
+    SLIST_ENTRY(cmd_item_) hash_next;                   //!< next command in the hash bucket
 } cmd_item_t;
 
 typedef void (*const fn_print_arg_t)(cmd_item_t*);
@@ -44,6 +48,9 @@ typedef void (*const fn_print_arg_t)(cmd_item_t*);
 /** linked list of command structures */
 static SLIST_HEAD(cmd_list_, cmd_item_) s_cmd_list;
 
+/** hash table of the commands, by name, so the lookup doesn't depend on the number of commands */
+static SLIST_HEAD(cmd_bucket_, cmd_item_) s_cmd_hash[CMD_HASH_BUCKETS];
+
 /** run-time configuration options */
 static esp_console_config_t s_config = {
     .heap_alloc_caps = MALLOC_CAP_DEFAULT
@@ -52,6 +59,9 @@ static esp_console_config_t s_config = {
 /** temporary buffer used for command line parsing */
 static char *s_tmp_line_buf;
 
+/** temporary array of the arguments of the parsed command line */
+static char **s_tmp_argv;
+
 static const cmd_item_t *find_command_by_name(const char *name);
 
 static esp_console_help_verbose_level_e s_verbose_level = ESP_CONSOLE_HELP_VERBOSE_LEVEL_1;
@@ -75,6 +85,14 @@ esp_err_t esp_console_init(const esp_console_config_t *config)
     if (s_tmp_line_buf == NULL) {
         return ESP_ERR_NO_MEM;
     }
+    if (s_config.max_cmdline_args > 0) {
+        s_tmp_argv = heap_caps_calloc(s_config.max_cmdline_args, sizeof(char *), s_config.heap_alloc_caps);
+        if (s_tmp_argv == NULL) {
+            free(s_tmp_line_buf);
+            s_tmp_line_buf = NULL;
+            return ESP_ERR_NO_MEM;
+        }
+    }
     return ESP_OK;
 }
 
@@ -85,18 +103,35 @@ esp_err_t esp_console_deinit(void)
     }
     free(s_tmp_line_buf);
     s_tmp_line_buf = NULL;
+    free(s_tmp_argv);
+    s_tmp_argv = NULL;
     cmd_item_t *it, *tmp;
     SLIST_FOREACH_SAFE(it, &s_cmd_list, next, tmp) {
         SLIST_REMOVE(&s_cmd_list, it, cmd_item_, next);
         free(it->hint);
         free(it);
     }
+    for (int i = 0; i < CMD_HASH_BUCKETS; i++) {
+        SLIST_INIT(&s_cmd_hash[i]);
+    }
     return ESP_OK;
 }
 
+static uint32_t cmd_hash(const char *name)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    return hash & (CMD_HASH_BUCKETS - 1);
+}
+
 void esp_console_rm_item_free_hint(cmd_item_t *item)
 {
     SLIST_REMOVE(&s_cmd_list, item, cmd_item_, next);
+    SLIST_REMOVE(&s_cmd_hash[cmd_hash(item->command)], item, cmd_item_, hash_next);
     free(item->hint);
 }
 
@@ -183,6 +218,7 @@ esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd)
 #endif
         SLIST_INSERT_AFTER(last, item, next);
     }
+    SLIST_INSERT_HEAD(&s_cmd_hash[cmd_hash(item->command)], item, hash_next);
     return ESP_OK;
 }
 
@@ -203,32 +239,24 @@ void esp_console_get_completion(const char *buf, linenoiseCompletions *lc)
 
 const char *esp_console_get_hint(const char *buf, int *color, int *bold)
 {
-    size_t len = strlen(buf);
-    cmd_item_t *it;
-    SLIST_FOREACH(it, &s_cmd_list, next) {
-        if (strlen(it->command) == len &&
-                strncmp(buf, it->command, len) == 0) {
-            *color = s_config.hint_color;
-            *bold = s_config.hint_bold;
-            return it->hint;
-        }
+    const cmd_item_t *it = find_command_by_name(buf);
+    if (it) {
+        *color = s_config.hint_color;
+        *bold = s_config.hint_bold;
+        return it->hint;
     }
     return NULL;
 }
 
 static const cmd_item_t *find_command_by_name(const char *name)
 {
-    const cmd_item_t *cmd = NULL;
     cmd_item_t *it;
-    size_t len = strlen(name);
-    SLIST_FOREACH(it, &s_cmd_list, next) {
-        if (strlen(it->command) == len &&
-                strcmp(name, it->command) == 0) {
-            cmd = it;
-            break;
+    SLIST_FOREACH(it, &s_cmd_hash[cmd_hash(name)], hash_next) {
+        if (strcmp(name, it->command) == 0) {
+            return it;
         }
     }
-    return cmd;
+    return NULL;
 }
 
 esp_err_t esp_console_run(const char *cmdline, int *cmd_ret)
@@ -236,7 +264,8 @@ esp_err_t esp_console_run(const char *cmdline, int *cmd_ret)
     if (s_tmp_line_buf == NULL) {
         return ESP_ERR_INVALID_STATE;
     }
-    char **argv = (char **) heap_caps_calloc(s_config.max_cmdline_args, sizeof(char *), s_config.heap_alloc_caps);
+    /* The argument array is allocated once at init, like the line buffer */
+    char **argv = s_tmp_argv;
     if (argv == NULL) {
         return ESP_ERR_NO_MEM;
     }
@@ -245,12 +274,10 @@ esp_err_t esp_console_run(const char *cmdline, int *cmd_ret)
     size_t argc = esp_console_split_argv(s_tmp_line_buf, argv,
                                          s_config.max_cmdline_args);
     if (argc == 0) {
-        free(argv);
         return ESP_ERR_INVALID_ARG;
     }
     const cmd_item_t *cmd = find_command_by_name(argv[0]);
     if (cmd == NULL) {
-        free(argv);
         return ESP_ERR_NOT_FOUND;
     }
     if (cmd->func) {
@@ -259,7 +286,6 @@ esp_err_t esp_console_run(const char *cmdline, int *cmd_ret)
     if (cmd->func_w_context) {
         *cmd_ret = (*cmd->func_w_context)(cmd->context, argc, argv);
     }
-    free(argv);
     return ESP_OK;
 }
 
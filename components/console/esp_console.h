@@ -10,6 +10,7 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include <stdbool.h>
 #include "sdkconfig.h"
 #include "esp_heap_caps.h"
 #include "esp_err.h"
@@ -55,6 +56,10 @@ typedef struct {
     BaseType_t task_core_id;       //!< repl task affinity, i.e. which core the task is pinned to
     const char *prompt;            //!< prompt (NULL represents default: "esp> ")
     size_t max_cmdline_length;     //!< maximum length of a command line. If 0, default value will be used
+    bool batch_mode;               /*!< read the command lines without line editing, echo, prompt and history,
+                                        for commands sent by a program rather than typed */
+    uint32_t exec_queue_len;       /*!< if not 0, the command lines are queued to a separate task which runs them,
+                                        so the next lines are read while a command runs. Number of lines queued */
 } esp_console_repl_config_t;
 
 /**
@@ -70,6 +75,8 @@ typedef struct {
         .task_core_id = tskNO_AFFINITY,   \
         .prompt = NULL,                   \
         .max_cmdline_length = 0,          \
+        .batch_mode = false,              \
+        .exec_queue_len = 0,              \
 }
 
 #if CONFIG_ESP_CONSOLE_UART_DEFAULT || CONFIG_ESP_CONSOLE_UART_CUSTOM
@@ -5,6 +5,9 @@
  */
 
 #include "sdkconfig.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include <sys/cdefs.h> // __containerof
 #include "esp_console.h"
 #include "console_private.h"
@@ -22,6 +25,11 @@ esp_err_t esp_console_setup_prompt(const char *prompt, esp_console_repl_com_t *r
     }
     snprintf(repl_com->prompt, CONSOLE_PROMPT_MAX_LEN - 1, LOG_COLOR_I "%s " LOG_RESET_COLOR, prompt_temp);
 
+    if (repl_com->batch_mode) {
+        /* No prompt is printed, and the program on the other side doesn't answer the probe */
+        return ESP_OK;
+    }
+
     /* Figure out if the terminal supports escape sequences */
     int probe_status = linenoiseProbe();
     if (probe_status) {
@@ -99,6 +107,136 @@ _exit:
     return ret;
 }
 
+static void esp_console_run_line(const char *line)
+{
+    /* Try to run the command */
+    int ret;
+    esp_err_t err = esp_console_run(line, &ret);
+    if (err == ESP_ERR_NOT_FOUND) {
+        printf("Unrecognized command\n");
+    } else if (err == ESP_ERR_INVALID_ARG) {
+        // command was empty
+    } else if (err == ESP_OK && ret != ESP_OK) {
+        printf("Command returned non-zero error code: 0x%x (%s)\n", ret, esp_err_to_name(ret));
+    } else if (err != ESP_OK) {
+        printf("Internal error: %s\n", esp_err_to_name(err));
+    }
+}
+
+static void esp_console_exec_task(void *args)
+{
+    esp_console_exec_t *exec = (esp_console_exec_t *) args;
+    char *line;
+
+    while (!exec->stop) {
+        if (xQueueReceive(exec->queue, &line, portMAX_DELAY) != pdTRUE || line == NULL) {
+            continue;
+        }
+        if (exec->out) {
+            /* The commands print to the console of the REPL */
+            stdin = exec->in;
+            stdout = exec->out;
+            stderr = exec->out;
+        }
+        esp_console_run_line(line);
+        linenoiseFree(line);
+    }
+
+    /* The REPL was deleted, possibly by the command which just ran */
+    while (xQueueReceive(exec->queue, &line, 0) == pdTRUE) {
+        linenoiseFree(line);
+    }
+    vQueueDelete(exec->queue);
+    free(exec);
+    ESP_LOGD(TAG, "executor stopped");
+    vTaskDelete(NULL);
+}
+
+esp_err_t esp_console_setup_exec(const esp_console_repl_config_t *repl_config, esp_console_repl_com_t *repl_com)
+{
+    repl_com->batch_mode = repl_config->batch_mode;
+    repl_com->exec = NULL;
+    if (repl_config->exec_queue_len == 0) {
+        return ESP_OK;
+    }
+
+    esp_console_exec_t *exec = calloc(1, sizeof(esp_console_exec_t));
+    if (!exec) {
+        return ESP_ERR_NO_MEM;
+    }
+    exec->queue = xQueueCreate(repl_config->exec_queue_len, sizeof(char *));
+    if (!exec->queue) {
+        free(exec);
+        return ESP_ERR_NO_MEM;
+    }
+    /* The commands run with the stack size and priority the REPL task would run them with */
+    if (xTaskCreatePinnedToCore(esp_console_exec_task, "console_exec", repl_config->task_stack_size,
+                                exec, repl_config->task_priority, NULL, repl_config->task_core_id) != pdTRUE) {
+        vQueueDelete(exec->queue);
+        free(exec);
+        return ESP_FAIL;
+    }
+    repl_com->exec = exec;
+    return ESP_OK;
+}
+
+void esp_console_stop_exec(esp_console_repl_com_t *repl_com)
+{
+    esp_console_exec_t *exec = repl_com->exec;
+    if (!exec) {
+        return;
+    }
+    repl_com->exec = NULL;
+    exec->stop = true;
+    /* Wake the executor up if it waits for a line, otherwise it stops after the current command */
+    char *wakeup = NULL;
+    xQueueSendToFront(exec->queue, &wakeup, 0);
+}
+
+/* Read a line without echo nor line editing. The VFS read() returns at the end of a line,
+ * so unlike linenoise there is no system call per character */
+static char *esp_console_read_batch_line(size_t max_cmdline_length)
+{
+    char *buf = malloc(max_cmdline_length);
+    size_t len = 0;
+    bool truncated = false;
+    if (buf == NULL) {
+        return NULL;
+    }
+
+    while (true) {
+        char chunk[64];
+        ssize_t n = read(fileno(stdin), chunk, sizeof(chunk));
+        if (n <= 0) {
+            vTaskDelay(1);
+            continue;
+        }
+        char *end = memchr(chunk, '\n', n);
+        size_t copy = end ? end - chunk : n;
+        if (len + copy > max_cmdline_length - 1) {
+            copy = max_cmdline_length - 1 - len;
+            truncated = true;
+        }
+        memcpy(buf + len, chunk, copy);
+        len += copy;
+        if (end) {
+            break;
+        }
+    }
+    if (len > 0 && buf[len - 1] == '\r') {
+        len--;
+    }
+    buf[len] = '\0';
+    if (len == 0 || truncated) {
+        if (truncated) {
+            printf("Command line too long\n");
+        }
+        free(buf);
+        return NULL;
+    }
+    return buf;
+}
+
 esp_err_t esp_console_start_repl(esp_console_repl_t *repl)
 {
     esp_err_t ret = ESP_OK;
@@ -136,6 +274,10 @@ void esp_console_repl_task(void *args)
         stdin = fopen(path, "r");
         stdout = fopen(path, "w");
         stderr = stdout;
+        if (repl_com->exec) {
+            repl_com->exec->in = stdin;
+            repl_com->exec->out = stdout;
+        }
     }
 
     /* Disable buffering on stdin of the current task.
@@ -144,46 +286,49 @@ void esp_console_repl_task(void *args)
     setvbuf(stdin, NULL, _IONBF, 0);
 
     /* This message shall be printed here and not earlier as the stdout
-     * has just been set above. */
-    printf("\r\n"
-           "Type 'help' to get the list of commands.\r\n"
-           "Use UP/DOWN arrows to navigate through command history.\r\n"
-           "Press TAB when typing command name to auto-complete.\r\n");
-
-    if (linenoiseIsDumbMode()) {
+     * has just been set above. The program sending the commands in batch mode doesn't need it. */
+    if (!repl_com->batch_mode) {
         printf("\r\n"
-               "Your terminal application does not support escape sequences.\n\n"
-               "Line editing and history features are disabled.\n\n"
-               "On Windows, try using Putty instead.\r\n");
+               "Type 'help' to get the list of commands.\r\n"
+               "Use UP/DOWN arrows to navigate through command history.\r\n"
+               "Press TAB when typing command name to auto-complete.\r\n");
+
+        if (linenoiseIsDumbMode()) {
+            printf("\r\n"
+                   "Your terminal application does not support escape sequences.\n\n"
+                   "Line editing and history features are disabled.\n\n"
+                   "On Windows, try using Putty instead.\r\n");
+        }
     }
 
     linenoiseSetMaxLineLen(repl_com->max_cmdline_length);
     while (repl_com->state == CONSOLE_REPL_STATE_START) {
-        char *line = linenoise(repl_com->prompt);
+        char *line;
+        if (repl_com->batch_mode) {
+            line = esp_console_read_batch_line(repl_com->max_cmdline_length);
+        } else {
+            line = linenoise(repl_com->prompt);
+        }
         if (line == NULL) {
             ESP_LOGD(TAG, "empty line");
             /* Ignore empty lines */
             continue;
         }
-        /* Add the command to the history */
-        linenoiseHistoryAdd(line);
-        /* Save command history to filesystem */
-        if (repl_com->history_save_path) {
-            linenoiseHistorySave(repl_com->history_save_path);
+        if (!repl_com->batch_mode) {
+            /* Add the command to the history */
+            linenoiseHistoryAdd(line);
+            /* Save command history to filesystem */
+            if (repl_com->history_save_path) {
+                linenoiseHistorySave(repl_com->history_save_path);
+            }
         }
 
-        /* Try to run the command */
-        int ret;
-        esp_err_t err = esp_console_run(line, &ret);
-        if (err == ESP_ERR_NOT_FOUND) {
-            printf("Unrecognized command\n");
-        } else if (err == ESP_ERR_INVALID_ARG) {
-            // command was empty
-        } else if (err == ESP_OK && ret != ESP_OK) {
-            printf("Command returned non-zero error code: 0x%x (%s)\n", ret, esp_err_to_name(ret));
-        } else if (err != ESP_OK) {
-            printf("Internal error: %s\n", esp_err_to_name(err));
+        if (repl_com->exec && repl_com->state == CONSOLE_REPL_STATE_START) {
+            /* The executor frees the line once the command has run */
+            xQueueSend(repl_com->exec->queue, &line, portMAX_DELAY);
+            continue;
         }
+        esp_console_run_line(line);
         /* linenoise allocates line buffer on the heap, so need to free it */
         linenoiseFree(line);
     }
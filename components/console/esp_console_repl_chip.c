@@ -73,6 +73,12 @@ esp_err_t esp_console_new_repl_usb_cdc(const esp_console_dev_usb_cdc_config_t *d
         goto _exit;
     }
 
+    // setup batch mode and command executor
+    ret = esp_console_setup_exec(repl_config, &cdc_repl->repl_com);
+    if (ret != ESP_OK) {
+        goto _exit;
+    }
+
     // setup prompt
     esp_console_setup_prompt(repl_config->prompt, &cdc_repl->repl_com);
 
@@ -92,6 +98,7 @@ esp_err_t esp_console_new_repl_usb_cdc(const esp_console_dev_usb_cdc_config_t *d
     return ESP_OK;
 _exit:
     if (cdc_repl) {
+        esp_console_stop_exec(&cdc_repl->repl_com);
         esp_console_deinit();
         free(cdc_repl);
     }
@@ -150,6 +157,12 @@ esp_err_t esp_console_new_repl_usb_serial_jtag(const esp_console_dev_usb_serial_
         goto _exit;
     }
 
+    // setup batch mode and command executor
+    ret = esp_console_setup_exec(repl_config, &usb_serial_jtag_repl->repl_com);
+    if (ret != ESP_OK) {
+        goto _exit;
+    }
+
     // setup prompt
     esp_console_setup_prompt(repl_config->prompt, &usb_serial_jtag_repl->repl_com);
 
@@ -169,6 +182,7 @@ esp_err_t esp_console_new_repl_usb_serial_jtag(const esp_console_dev_usb_serial_
     return ESP_OK;
 _exit:
     if (usb_serial_jtag_repl) {
+        esp_console_stop_exec(&usb_serial_jtag_repl->repl_com);
         esp_console_deinit();
         free(usb_serial_jtag_repl);
     }
@@ -251,6 +265,12 @@ esp_err_t esp_console_new_repl_uart(const esp_console_dev_uart_config_t *dev_con
         goto _exit;
     }
 
+    // setup batch mode and command executor
+    ret = esp_console_setup_exec(repl_config, &uart_repl->repl_com);
+    if (ret != ESP_OK) {
+        goto _exit;
+    }
+
     // setup prompt
     esp_console_setup_prompt(repl_config->prompt, &uart_repl->repl_com);
 
@@ -271,6 +291,7 @@ esp_err_t esp_console_new_repl_uart(const esp_console_dev_uart_config_t *dev_con
     return ESP_OK;
 _exit:
     if (uart_repl) {
+        esp_console_stop_exec(&uart_repl->repl_com);
         esp_console_deinit();
         uart_driver_delete(dev_config->channel);
         free(uart_repl);
@@ -295,6 +316,7 @@ static esp_err_t esp_console_repl_uart_delete(esp_console_repl_t *repl)
         goto _exit;
     }
     repl_com->state = CONSOLE_REPL_STATE_DEINIT;
+    esp_console_stop_exec(repl_com);
     esp_console_deinit();
     uart_vfs_dev_use_nonblocking(uart_repl->uart_channel);
     uart_driver_delete(uart_repl->uart_channel);
@@ -317,6 +339,7 @@ static esp_err_t esp_console_repl_usb_cdc_delete(esp_console_repl_t *repl)
         goto _exit;
     }
     repl_com->state = CONSOLE_REPL_STATE_DEINIT;
+    esp_console_stop_exec(repl_com);
     esp_console_deinit();
     free(cdc_repl);
 _exit:
@@ -337,6 +360,7 @@ static esp_err_t esp_console_repl_usb_serial_jtag_delete(esp_console_repl_t *rep
         goto _exit;
     }
     repl_com->state = CONSOLE_REPL_STATE_DEINIT;
+    esp_console_stop_exec(repl_com);
     esp_console_deinit();
     usb_serial_jtag_vfs_use_nonblocking();
     usb_serial_jtag_driver_uninstall();
@@ -74,6 +74,7 @@ static esp_err_t esp_console_repl_linux_delete(esp_console_repl_t *repl)
         goto _exit;
     }
     repl_com->state = CONSOLE_REPL_STATE_DEINIT;
+    esp_console_stop_exec(repl_com);
     esp_console_deinit();
 
     free(linux_repl);
@@ -115,6 +116,12 @@ static esp_err_t esp_console_new_repl_linux(const esp_console_repl_config_t *rep
     // Make sure the setup works on Linux without buffering or additional processing
     prepare_input_stream();
 
+    // setup batch mode and command executor
+    ret = esp_console_setup_exec(repl_config, &linux_repl->repl_com);
+    if (ret != ESP_OK) {
+        goto _exit;
+    }
+
     // setup prompt
     esp_console_setup_prompt(repl_config->prompt, &linux_repl->repl_com);
 
@@ -134,6 +141,7 @@ static esp_err_t esp_console_new_repl_linux(const esp_console_repl_config_t *rep
     return ESP_OK;
 _exit:
     if (linux_repl) {
+        esp_console_stop_exec(&linux_repl->repl_com);
         esp_console_deinit();
         free(linux_repl);
     }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,9 +8,11 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
 #include "esp_console.h"
 
 #define CONSOLE_PROMPT_MAX_LEN (32)
@@ -28,6 +30,14 @@ typedef enum {
     CONSOLE_REPL_STATE_START,
 } repl_state_t;
 
+// Executor of the command lines, owned by the executor task which frees it once stopped
+typedef struct {
+    QueueHandle_t queue;                // command lines to run
+    FILE *in;                           // standard streams of the REPL task, if not the default ones
+    FILE *out;
+    volatile bool stop;                 // set when the REPL is deleted
+} esp_console_exec_t;
+
 typedef struct {
     esp_console_repl_t repl_core;        // base class
     char prompt[CONSOLE_PROMPT_MAX_LEN]; // Prompt to be printed before each line
@@ -35,6 +45,8 @@ typedef struct {
     const char *history_save_path;
     TaskHandle_t task_hdl;              // REPL task handle
     size_t max_cmdline_length;          // Maximum length of a command line. If 0, default value will be used.
+    bool batch_mode;                    // No line editing, echo, prompt and history
+    esp_console_exec_t *exec;           // Executor of the command lines, NULL if they are run by the REPL task
 } esp_console_repl_com_t;
 
 typedef struct {
@@ -45,6 +57,8 @@ typedef struct {
 void esp_console_repl_task(void *args);
 
 esp_err_t esp_console_common_init(size_t max_cmdline_length, esp_console_repl_com_t *repl_com);
+esp_err_t esp_console_setup_exec(const esp_console_repl_config_t *repl_config, esp_console_repl_com_t *repl_com);
+void esp_console_stop_exec(esp_console_repl_com_t *repl_com);
 esp_err_t esp_console_setup_prompt(const char *prompt, esp_console_repl_com_t *repl_com);
 esp_err_t esp_console_setup_history(const char *history_path,
                                     uint32_t max_history_len,
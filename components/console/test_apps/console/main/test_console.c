@@ -274,6 +274,50 @@ TEST_CASE("esp console test with context", "[console]")
     TEST_ESP_OK(esp_console_deinit());
 }
 
+static int do_count_cmd_with_context(void *context, int argc, char **argv)
+{
+    (*(int *)context)++;
+    return 0;
+}
+
+TEST_CASE("esp console run with many commands registered", "[console]")
+{
+    esp_console_config_t console_config = ESP_CONSOLE_CONFIG_DEFAULT();
+    TEST_ESP_OK(esp_console_init(&console_config));
+
+    static char names[100][8];
+    int counts[100] = { 0 };
+    for (int i = 0; i < 100; i++) {
+        snprintf(names[i], sizeof(names[i]), "cmd%d", i);
+        const esp_console_cmd_t cmd = {
+            .command = names[i],
+            .help = "Count the calls",
+            .func_w_context = do_count_cmd_with_context,
+            .context = &counts[i],
+        };
+        TEST_ESP_OK(esp_console_cmd_register(&cmd));
+    }
+
+    int ret;
+    for (int i = 0; i < 100; i++) {
+        TEST_ESP_OK(esp_console_run(names[i], &ret));
+        TEST_ASSERT_EQUAL(0, ret);
+        TEST_ASSERT_EQUAL(1, counts[i]);
+    }
+
+    // deregistered and unknown commands, and prefixes of registered commands, are not found
+    for (int i = 0; i < 100; i += 2) {
+        TEST_ESP_OK(esp_console_cmd_deregister(names[i]));
+    }
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(i % 2 ? ESP_OK : ESP_ERR_NOT_FOUND, esp_console_run(names[i], &ret));
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_console_run("cmd", &ret));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_console_run("cmd1000", &ret));
+
+    TEST_ESP_OK(esp_console_deinit());
+}
+
 TEST_CASE("esp console help command - set verbose level = 0", "[console][ignore]")
 {
     esp_console_repl_config_t repl_config = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
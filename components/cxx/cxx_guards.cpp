@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,206 +8,166 @@
 #include <assert.h>
 #include <cxxabi.h>
 #include <stdint.h>
-#include <limits.h>
-#include <algorithm>
-#include <sys/lock.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
 
 using __cxxabiv1::__guard;
 
-static SemaphoreHandle_t s_static_init_mutex = NULL;        //!< lock used for the critical section
-static SemaphoreHandle_t s_static_init_wait_sem = NULL;     //!< counting semaphore used by the waiting tasks
-static portMUX_TYPE s_init_spinlock = portMUX_INITIALIZER_UNLOCKED;   //!< spinlock used to guard initialization of the above two primitives
-static size_t s_static_init_waiting_count = 0;              //!< number of tasks which are waiting for static init guards
-#ifndef _NDEBUG
-static size_t s_static_init_max_waiting_count = 0;          //!< maximum ever value of the above; can be inspected using GDB for debugging purposes
-#endif
-
 extern "C" int __cxa_guard_acquire(__guard* pg);
 extern "C" void __cxa_guard_release(__guard* pg) throw();
 extern "C" void __cxa_guard_abort(__guard* pg) throw();
 extern "C" void __cxa_guard_dummy(void);
 
+/**
+ * Task waiting for the initialization guarded by a guard object to complete.
+ * Lives on the stack of the waiting task, for as long as the task waits.
+ */
+typedef struct guard_waiter {
+    struct guard_waiter* next;
+    SemaphoreHandle_t sem;      //!< given when the guard is released or aborted
+} guard_waiter_t;
+
 /**
  * Layout of the guard object (defined by the ABI).
  *
  * Compiler will check lower byte before calling guard functions.
+ * The other bytes are free for the implementation, the list of the waiting tasks is kept there.
  */
 typedef struct {
     uint8_t ready;      //!< nonzero if initialization is done
     uint8_t pending;    //!< nonzero if initialization is in progress
+    uint8_t reserved[2];
+    guard_waiter_t* waiters;    //!< tasks waiting for the initialization in progress
 } guard_t;
 
-static void static_init_prepare()
+static_assert(sizeof(guard_t) <= sizeof(__guard), "guard_t doesn't fit in the ABI guard object");
+
+/* The state of all guard objects is only changed inside short critical sections, there is no global mutex.
+ * Tasks only block when the object they need is being initialized by another task, and they are only woken
+ * up when that object is released or aborted.
+ */
+static portMUX_TYPE s_guard_spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * Acquire the guard if nobody else holds it.
+ * Must be called in the critical section.
+ *
+ * @return 0 if the object is initialized, 1 if the guard was acquired, -1 if another task holds it
+ */
+static int try_acquire(guard_t* g)
 {
-    portENTER_CRITICAL(&s_init_spinlock);
-    if (s_static_init_mutex == NULL) {
-        s_static_init_mutex = xSemaphoreCreateMutex();
-        s_static_init_wait_sem = xSemaphoreCreateCounting(INT_MAX, 0);
-        if (s_static_init_mutex == NULL || s_static_init_wait_sem == NULL) {
-            // no way to bail out of static initialization without these
-            abort();
-        }
+    if (g->ready) {
+        return 0;
     }
-    portEXIT_CRITICAL(&s_init_spinlock);
+    if (!g->pending) {
+        g->pending = 1;
+        return 1;
+    }
+    return -1;
 }
 
 /**
- * Use s_static_init_wait_sem to wait until guard->pending == 0.
- * Preconditions:
- * - s_static_init_mutex taken
- * - guard.pending == 1
- * Postconditions:
- * - s_static_init_mutex taken
- * - guard.pending == 0
+ * Detach the waiting tasks from the guard.
+ * Must be called in the critical section, the waiters have to be woken up when it is exited.
  */
-static void wait_for_guard_obj(guard_t* g)
+static guard_waiter_t* take_waiters(guard_t* g)
 {
-    s_static_init_waiting_count++;
-#ifndef _NDEBUG
-    s_static_init_max_waiting_count = std::max(s_static_init_waiting_count,
-                                               s_static_init_max_waiting_count);
-#endif
-
-    do {
-        auto result = xSemaphoreGive(s_static_init_mutex);
-        assert(result);
-        static_cast<void>(result);
-        /* Task may be preempted here, but this isn't a problem,
-         * as the semaphore will be given exactly the s_static_init_waiting_count
-         * number of times; eventually the current task will execute next statement,
-         * which will immediately succeed.
-         */
-        result = xSemaphoreTake(s_static_init_wait_sem, portMAX_DELAY);
-        assert(result);
-        /* At this point the semaphore was given, so all waiting tasks have woken up.
-         * We take s_static_init_mutex before accessing the state of the guard
-         * object again.
-         */
-        result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
-        assert(result);
-        /* Semaphore may have been given because some other guard object became ready.
-         * Check the guard object we need and wait again if it is still pending.
-         */
-    } while (g->pending);
-    s_static_init_waiting_count--;
+    guard_waiter_t* waiters = g->waiters;
+    g->waiters = NULL;
+    return waiters;
 }
 
-/**
- * Unblock tasks waiting for static initialization to complete.
- * Preconditions:
- * - s_static_init_mutex taken
- * Postconditions:
- * - s_static_init_mutex taken
- */
-static void signal_waiting_tasks()
+static void wake_waiters(guard_waiter_t* waiters)
 {
-    auto count = s_static_init_waiting_count;
-    while (count--) {
-        xSemaphoreGive(s_static_init_wait_sem);
+    while (waiters) {
+        /* The waiter may return, and its node go out of scope, as soon as its semaphore is given */
+        guard_waiter_t* next = waiters->next;
+        xSemaphoreGive(waiters->sem);
+        waiters = next;
     }
 }
 
 extern "C" int __cxa_guard_acquire(__guard* pg)
 {
     guard_t* g = reinterpret_cast<guard_t*>(pg);
-    const auto scheduler_started = xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
-    if (!scheduler_started) {
-        if (g->pending) {
-            /* Before the scheduler has started, there we don't support simultaneous
-             * static initialization. This may be implemented using a spinlock and a
-             * s32c1i instruction, though.
-             */
-            abort();
-        }
-    } else {
-        if (s_static_init_mutex == NULL) {
-            static_init_prepare();
-        }
 
-        /* We don't need to use double-checked locking pattern here, as the compiler
-         * must generate code to check if the first byte of *pg is non-zero, before
-         * calling __cxa_guard_acquire.
+    portENTER_CRITICAL(&s_guard_spinlock);
+    int ret = try_acquire(g);
+    portEXIT_CRITICAL(&s_guard_spinlock);
+    if (ret >= 0) {
+        return ret;
+    }
+
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        /* Before the scheduler has started, there we don't support simultaneous
+         * static initialization.
          */
-        auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
-        assert(result);
-        static_cast<void>(result);
-        if (g->pending) {
-            /* Another task is doing initialization at the moment; wait until it calls
-             * __cxa_guard_release or __cxa_guard_abort
-             */
-            wait_for_guard_obj(g);
+        abort();
+    }
+
+    /* Another task is doing initialization at the moment; wait until it calls
+     * __cxa_guard_release or __cxa_guard_abort
+     */
+    StaticSemaphore_t sem_buffer;
+    guard_waiter_t waiter = {
+        .next = NULL,
+        .sem = xSemaphoreCreateBinaryStatic(&sem_buffer),
+    };
+    while (true) {
+        portENTER_CRITICAL(&s_guard_spinlock);
+        ret = try_acquire(g);
+        if (ret < 0) {
+            waiter.next = g->waiters;
+            g->waiters = &waiter;
+        }
+        portEXIT_CRITICAL(&s_guard_spinlock);
+        if (ret >= 0) {
             /* At this point there are two scenarios:
              * - the task which was doing static initialization has called __cxa_guard_release,
              *   which means that g->ready is set. We need to return 0.
              * - the task which was doing static initialization has called __cxa_guard_abort,
-             *   which means that g->ready is not set; we should acquire the guard and return 1,
+             *   which means that g->ready is not set; we acquired the guard and return 1,
              *   same as for the case if we didn't have to wait.
              * Note: actually the second scenario is unlikely to occur in the current
              * configuration because exception support is disabled.
              */
+            break;
         }
-    }
-    int ret;
-    if (g->ready) {
-        /* Static initialization has been done by another task; nothing to do here */
-        ret = 0;
-    } else {
-        /* Current task can start doing static initialization */
-        g->pending = 1;
-        ret = 1;
-    }
-    if (scheduler_started) {
-        auto result = xSemaphoreGive(s_static_init_mutex);
+        auto result = xSemaphoreTake(waiter.sem, portMAX_DELAY);
         assert(result);
         static_cast<void>(result);
+        /* After an abort, another waiter may have acquired the guard first, check again */
     }
+    vSemaphoreDelete(waiter.sem);
     return ret;
 }
 
 extern "C" void __cxa_guard_release(__guard* pg) throw()
 {
     guard_t* g = reinterpret_cast<guard_t*>(pg);
-    const auto scheduler_started = xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
-    if (scheduler_started) {
-        auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
-        assert(result);
-        static_cast<void>(result);
-    }
+    portENTER_CRITICAL(&s_guard_spinlock);
     assert(g->pending && "tried to release a guard which wasn't acquired");
     g->pending = 0;
     /* Initialization was successful */
     g->ready = 1;
-    if (scheduler_started) {
-        /* Unblock the tasks waiting for static initialization to complete */
-        signal_waiting_tasks();
-        auto result = xSemaphoreGive(s_static_init_mutex);
-        assert(result);
-        static_cast<void>(result);
-    }
+    guard_waiter_t* waiters = take_waiters(g);
+    portEXIT_CRITICAL(&s_guard_spinlock);
+    /* Unblock the tasks waiting for static initialization to complete */
+    wake_waiters(waiters);
 }
 
 extern "C" void __cxa_guard_abort(__guard* pg) throw()
 {
     guard_t* g = reinterpret_cast<guard_t*>(pg);
-    const auto scheduler_started = xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
-    if (scheduler_started) {
-        auto result = xSemaphoreTake(s_static_init_mutex, portMAX_DELAY);
-        assert(result);
-        static_cast<void>(result);
-    }
+    portENTER_CRITICAL(&s_guard_spinlock);
     assert(!g->ready && "tried to abort a guard which is ready");
     assert(g->pending && "tried to release a guard which is not acquired");
     g->pending = 0;
-    if (scheduler_started) {
-        /* Unblock the tasks waiting for static initialization to complete */
-        signal_waiting_tasks();
-        auto result = xSemaphoreGive(s_static_init_mutex);
-        assert(result);
-        static_cast<void>(result);
-    }
+    guard_waiter_t* waiters = take_waiters(g);
+    portEXIT_CRITICAL(&s_guard_spinlock);
+    /* Unblock the tasks waiting for static initialization to complete */
+    wake_waiters(waiters);
 }
 
 /**
@@ -129,6 +129,89 @@ TEST_CASE("static initialization guards work as expected", "[misc]")
     vTaskDelay(10); // Allow tasks to clean up, avoids race with leak detector
 }
 
+#if CONFIG_FREERTOS_TASK_PROFILING
+/*
+ * This test checks that releasing a static initialization guard doesn't wake up
+ * the tasks waiting for another guard. One task initializes an object and blocks
+ * until the test lets it finish, another task waits for that object, and the test
+ * task initializes other objects in the meantime. The waiting task must not be
+ * switched in until the object it waits for is initialized.
+ */
+static SemaphoreHandle_t s_blocking_init_started;
+static SemaphoreHandle_t s_blocking_init_go;
+static SemaphoreHandle_t s_blocking_init_done;
+
+struct BlockingInit {
+    BlockingInit() : value(42)
+    {
+        xSemaphoreGive(s_blocking_init_started);
+        xSemaphoreTake(s_blocking_init_go, portMAX_DELAY);
+    }
+    int value;
+};
+
+static void blocking_init_task(void* arg)
+{
+    static BlockingInit blocking_init;
+    if (blocking_init.value == 42) {
+        xSemaphoreGive(s_blocking_init_done);
+    }
+    vTaskDelete(NULL);
+}
+
+template<int obj>
+struct FastInit {
+    FastInit() : value(obj)
+    {
+    }
+    int value;
+};
+
+template<int obj>
+static int fast_init()
+{
+    static FastInit<obj> fast_init;
+    return fast_init.value;
+}
+
+TEST_CASE("static initialization guard release only wakes the tasks waiting for it", "[misc]")
+{
+    unity_utils_set_leak_level(300);
+    s_blocking_init_started = xSemaphoreCreateBinary();
+    s_blocking_init_go = xSemaphoreCreateBinary();
+    s_blocking_init_done = xSemaphoreCreateCounting(2, 0);
+    TEST_ASSERT_NOT_NULL(s_blocking_init_started);
+    TEST_ASSERT_NOT_NULL(s_blocking_init_go);
+    TEST_ASSERT_NOT_NULL(s_blocking_init_done);
+
+    TEST_ASSERT_TRUE(xTaskCreatePinnedToCore(blocking_init_task, "init", 2048, NULL, 3, NULL, tskNO_AFFINITY));
+    TEST_ASSERT_TRUE(xSemaphoreTake(s_blocking_init_started, 100 / portTICK_PERIOD_MS));
+    TaskHandle_t waiter;
+    TEST_ASSERT_TRUE(xTaskCreatePinnedToCore(blocking_init_task, "wait", 2048, NULL, 3, &waiter, tskNO_AFFINITY));
+    vTaskDelay(10 / portTICK_PERIOD_MS); // let the waiter block on the guard
+
+    TaskProfilingInfo_t before;
+    TaskProfilingInfo_t after;
+    vTaskGetProfilingInfo(waiter, &before);
+    TEST_ASSERT_EQUAL(0, fast_init<0>());
+    TEST_ASSERT_EQUAL(1, fast_init<1>());
+    TEST_ASSERT_EQUAL(2, fast_init<2>());
+    TEST_ASSERT_EQUAL(3, fast_init<3>());
+    vTaskDelay(10 / portTICK_PERIOD_MS); // a waiter which was woken up would run now
+    vTaskGetProfilingInfo(waiter, &after);
+    TEST_ASSERT_EQUAL(before.ulContextSwitches, after.ulContextSwitches);
+
+    xSemaphoreGive(s_blocking_init_go);
+    TEST_ASSERT_TRUE(xSemaphoreTake(s_blocking_init_done, 100 / portTICK_PERIOD_MS));
+    TEST_ASSERT_TRUE(xSemaphoreTake(s_blocking_init_done, 100 / portTICK_PERIOD_MS));
+    vSemaphoreDelete(s_blocking_init_started);
+    vSemaphoreDelete(s_blocking_init_go);
+    vSemaphoreDelete(s_blocking_init_done);
+
+    vTaskDelay(10); // Allow tasks to clean up, avoids race with leak detector
+}
+#endif // CONFIG_FREERTOS_TASK_PROFILING
+
 struct GlobalInitTest {
     GlobalInitTest() : index(order++)
     {
@@ -76,6 +76,8 @@ static const char *TAG = "esp-tls";
 #define _esp_tls_server_session_delete      esp_mbedtls_server_session_delete
 #define _esp_tls_server_session_ticket_ctx_init    esp_mbedtls_server_session_ticket_ctx_init
 #define _esp_tls_server_session_ticket_ctx_free    esp_mbedtls_server_session_ticket_ctx_free
+#define _esp_tls_server_session_cache_ctx_init     esp_mbedtls_server_session_cache_ctx_init
+#define _esp_tls_server_session_cache_ctx_free     esp_mbedtls_server_session_cache_ctx_free
 #define _esp_tls_get_bytes_avail            esp_mbedtls_get_bytes_avail
 #define _esp_tls_init_global_ca_store       esp_mbedtls_init_global_ca_store
 #define _esp_tls_set_global_ca_store        esp_mbedtls_set_global_ca_store                 /*!< Callback function for setting global CA store data for TLS/SSL */
@@ -666,6 +668,13 @@ void esp_tls_free_client_session(esp_tls_client_session_t *client_session)
 }
 #endif /* CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS */
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+void esp_tls_client_session_cache_clear(void)
+{
+    esp_mbedtls_session_cache_clear();
+}
+#endif /* CONFIG_ESP_TLS_CLIENT_SESSION_CACHE */
+
 
 esp_err_t esp_tls_cfg_server_session_tickets_init(esp_tls_cfg_server_t *cfg)
 {
@@ -696,6 +705,34 @@ void esp_tls_cfg_server_session_tickets_free(esp_tls_cfg_server_t *cfg)
 #endif
 }
 
+esp_err_t esp_tls_cfg_server_session_cache_init(esp_tls_cfg_server_t *cfg, size_t max_entries)
+{
+#if defined(CONFIG_ESP_TLS_SERVER_SESSION_CACHE)
+    if (!cfg || cfg->session_cache_ctx || max_entries == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    cfg->session_cache_ctx = calloc(1, sizeof(esp_tls_server_session_cache_ctx_t));
+    if (!cfg->session_cache_ctx) {
+        return ESP_ERR_NO_MEM;
+    }
+    _esp_tls_server_session_cache_ctx_init(cfg->session_cache_ctx, max_entries);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+void esp_tls_cfg_server_session_cache_free(esp_tls_cfg_server_t *cfg)
+{
+#if defined(CONFIG_ESP_TLS_SERVER_SESSION_CACHE)
+    if (cfg && cfg->session_cache_ctx) {
+        _esp_tls_server_session_cache_ctx_free(cfg->session_cache_ctx);
+        free(cfg->session_cache_ctx);
+        cfg->session_cache_ctx = NULL;
+    }
+#endif
+}
+
 /**
  * @brief      Create a server side TLS/SSL connection
  */
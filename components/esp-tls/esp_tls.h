@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2017-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2017-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -18,6 +18,10 @@
 #include "mbedtls/entropy.h"
 #include "mbedtls/ctr_drbg.h"
 #endif
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_CACHE
+#include <sys/lock.h>
+#include "mbedtls/ssl_cache.h"
+#endif
 #elif CONFIG_ESP_TLS_USING_WOLFSSL
 #include "wolfssl/wolfcrypt/settings.h"
 #include "wolfssl/ssl.h"
@@ -227,6 +231,16 @@ typedef struct esp_tls_server_session_ticket_ctx {
 } esp_tls_server_session_ticket_ctx_t;
 #endif
 
+#if defined(CONFIG_ESP_TLS_SERVER_SESSION_CACHE)
+/**
+ * @brief Session cache of a TLS server, which keeps the sessions of its clients by their session ID
+ */
+typedef struct esp_tls_server_session_cache_ctx {
+    mbedtls_ssl_cache_context cache;                                            /*!< mbedTLS session cache */
+    _lock_t lock;                                                               /*!< Serializes the accesses of concurrent handshakes */
+} esp_tls_server_session_cache_ctx_t;
+#endif
+
 #if defined(CONFIG_ESP_TLS_SERVER_CERT_SELECT_HOOK)
 /**
  * @brief tls handshake callback
@@ -314,6 +328,14 @@ typedef struct esp_tls_cfg_server {
                                                     to free the data associated with this context. */
 #endif
 
+#if defined(CONFIG_ESP_TLS_SERVER_SESSION_CACHE)
+    esp_tls_server_session_cache_ctx_t * session_cache_ctx; /*!< Session cache shared by the connections of the server.
+                                                    You have to call esp_tls_cfg_server_session_cache_init
+                                                    to use it.
+                                                    Call esp_tls_cfg_server_session_cache_free
+                                                    to free the cached sessions. */
+#endif
+
     void *userdata;                             /*!< User data to be added to the ssl context.
                                                   Can be retrieved by callbacks */
 #if defined(CONFIG_ESP_TLS_SERVER_CERT_SELECT_HOOK)
@@ -349,6 +371,32 @@ esp_err_t esp_tls_cfg_server_session_tickets_init(esp_tls_cfg_server_t *cfg);
  */
 void esp_tls_cfg_server_session_tickets_free(esp_tls_cfg_server_t *cfg);
 
+/**
+ * @brief Initialize the server side TLS session cache
+ *
+ * This function creates the session cache of the server, which keeps the
+ * sessions of the clients so that a client reconnecting with the session ID
+ * of a previous connection resumes the session, without a full handshake.
+ * The cache is shared by all sessions created with cfg.
+ * Use esp_tls_cfg_server_session_cache_free to free the cache.
+ *
+ * @param[in]  cfg          server configuration as esp_tls_cfg_server_t
+ * @param[in]  max_entries  maximum number of sessions in the cache, the oldest one is replaced when it's full
+ * @return
+ *             ESP_OK if setup succeeded
+ *             ESP_ERR_INVALID_ARG if max_entries is 0 or the cache is already initialized
+ *             ESP_ERR_NO_MEM if memory allocation failed
+ *             ESP_ERR_NOT_SUPPORTED if the session cache is not available due to build configuration
+ */
+esp_err_t esp_tls_cfg_server_session_cache_init(esp_tls_cfg_server_t *cfg, size_t max_entries);
+
+/**
+ * @brief Free the server side TLS session cache
+ *
+ * @param cfg server configuration as esp_tls_cfg_server_t
+ */
+void esp_tls_cfg_server_session_cache_free(esp_tls_cfg_server_t *cfg);
+
 typedef struct esp_tls esp_tls_t;
 
 /**
@@ -752,6 +800,16 @@ esp_tls_client_session_t *esp_tls_get_client_session(esp_tls_t *tls);
  */
 void esp_tls_free_client_session(esp_tls_client_session_t *client_session);
 #endif /* CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS */
+
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+/**
+ * @brief Remove all the sessions from the client session cache
+ *
+ * The next connection to each server performs a full handshake. This can be used e.g.
+ * after the trusted CA certificates were changed, as a resumed session is not verified again.
+ */
+void esp_tls_client_session_cache_clear(void);
+#endif /* CONFIG_ESP_TLS_CLIENT_SESSION_CACHE */
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/lock.h>
 #include <netdb.h>
 
 #include <http_parser.h>
@@ -19,6 +20,8 @@
 #include <errno.h>
 #include "esp_log.h"
 #include "esp_check.h"
+#include "mbedtls/platform_util.h"
+#include "mbedtls/sha256.h"
 
 #ifdef CONFIG_MBEDTLS_HARDWARE_ECDSA_SIGN
 #include "ecdsa/ecdsa_alt.h"
@@ -81,6 +84,9 @@ typedef struct esp_tls_pki_t {
 } esp_tls_pki_t;
 
 static esp_err_t set_server_config(esp_tls_cfg_server_t *cfg, esp_tls_t *tls);
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+static void session_cache_resume(esp_tls_t *tls);
+#endif
 
 esp_err_t esp_create_mbedtls_handle(const char *hostname, size_t hostlen, const void *cfg, esp_tls_t *tls, void *server_params)
 {
@@ -164,6 +170,11 @@ esp_err_t esp_create_mbedtls_handle(const char *hostname, size_t hostlen, const
     }
     mbedtls_ssl_set_bio(&tls->ssl, &tls->server_fd, mbedtls_net_send, mbedtls_net_recv, NULL);
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+    if (tls->role == ESP_TLS_CLIENT) {
+        session_cache_resume(tls);
+    }
+#endif
     return ESP_OK;
 
 exit:
@@ -181,6 +192,211 @@ void *esp_mbedtls_get_ssl_context(esp_tls_t *tls)
     return (void*)&tls->ssl;
 }
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+/*
+ * Sessions of the client connections, shared by all the esp-tls clients.
+ * An entry belongs to a key which covers everything a resumed session would skip
+ * checking: the server name and port, the name verified in its certificate, the
+ * trusted CA certificates and the client certificate. It is replaced by the session
+ * of every new connection with the same key. When the cache is full, the entry
+ * used least recently makes room for a new one.
+ */
+typedef struct {
+    char *host;
+    unsigned char key[ESP_TLS_SESSION_CACHE_KEY_LEN];
+    mbedtls_ssl_session session;
+    uint32_t last_used;
+} session_cache_entry_t;
+
+static session_cache_entry_t s_session_cache[CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE];
+static uint32_t s_session_cache_clock;
+static _lock_t s_session_cache_lock;
+
+static bool session_cache_is_usable(const esp_tls_cfg_t *cfg)
+{
+    /* A resumed session skips the certificate verification, so only sessions of
+     * verified servers are cached */
+    return cfg->client_session == NULL && cfg->psk_hint_key == NULL && !cfg->skip_common_name &&
+           !cfg->use_secure_element &&
+           (cfg->crt_bundle_attach != NULL || cfg->use_global_ca_store || cfg->cacert_buf != NULL);
+}
+
+static void session_cache_key_update(mbedtls_sha256_context *sha, const void *data, size_t len)
+{
+    /* The length is hashed too, so that the fields can't run into each other */
+    uint32_t field_len = len;
+    mbedtls_sha256_update(sha, (const unsigned char *)&field_len, sizeof(field_len));
+    if (len > 0) {
+        mbedtls_sha256_update(sha, data, len);
+    }
+}
+
+/* Derives the cache key of a connection, returns false if the connection can't be cached */
+static bool session_cache_key_init(esp_tls_t *tls, const char *hostname, size_t hostlen, const esp_tls_cfg_t *cfg)
+{
+    struct sockaddr_storage peer;
+    socklen_t peer_len = sizeof(peer);
+    uint16_t port;
+    if (getpeername(tls->sockfd, (struct sockaddr *)&peer, &peer_len) != 0) {
+        return false;
+    }
+    if (peer.ss_family == AF_INET) {
+        port = ((struct sockaddr_in *)&peer)->sin_port;
+#if CONFIG_LWIP_IPV6
+    } else if (peer.ss_family == AF_INET6) {
+        port = ((struct sockaddr_in6 *)&peer)->sin6_port;
+#endif
+    } else {
+        return false;
+    }
+    uint8_t use_global_ca_store = cfg->use_global_ca_store;
+
+    mbedtls_sha256_context sha;
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts(&sha, 0);
+    session_cache_key_update(&sha, hostname, hostlen);
+    session_cache_key_update(&sha, &port, sizeof(port));
+    session_cache_key_update(&sha, cfg->common_name, cfg->common_name ? strlen(cfg->common_name) : 0);
+    /* The CA certificates are hashed by content, a buffer may be reused for other certificates */
+    session_cache_key_update(&sha, cfg->cacert_buf, cfg->cacert_buf ? cfg->cacert_bytes : 0);
+    session_cache_key_update(&sha, &cfg->crt_bundle_attach, sizeof(cfg->crt_bundle_attach));
+    session_cache_key_update(&sha, &use_global_ca_store, sizeof(use_global_ca_store));
+    session_cache_key_update(&sha, &cfg->clientcert_buf, sizeof(cfg->clientcert_buf));
+    mbedtls_sha256_finish(&sha, tls->session_cache_key);
+    mbedtls_sha256_free(&sha);
+    return true;
+}
+
+static session_cache_entry_t *session_cache_find(const esp_tls_t *tls)
+{
+    for (int i = 0; i < CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE; i++) {
+        session_cache_entry_t *entry = &s_session_cache[i];
+        if (entry->host != NULL && memcmp(entry->key, tls->session_cache_key, sizeof(entry->key)) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void session_cache_entry_free(session_cache_entry_t *entry)
+{
+    if (entry->host != NULL) {
+        free(entry->host);
+        mbedtls_ssl_session_free(&entry->session);
+        memset(entry, 0, sizeof(session_cache_entry_t));
+    }
+}
+
+static void session_cache_resume(esp_tls_t *tls)
+{
+    if (tls->session_cache_host == NULL) {
+        return;
+    }
+    _lock_acquire(&s_session_cache_lock);
+    session_cache_entry_t *entry = session_cache_find(tls);
+    if (entry != NULL) {
+        int ret = mbedtls_ssl_set_session(&tls->ssl, &entry->session);
+        if (ret == 0) {
+            ESP_LOGD(TAG, "Resuming the cached session of %s", tls->session_cache_host);
+            entry->last_used = ++s_session_cache_clock;
+        } else {
+            ESP_LOGD(TAG, "Dropping the cached session of %s, mbedtls_ssl_set_session returned -0x%04X", tls->session_cache_host, -ret);
+            session_cache_entry_free(entry);
+        }
+    }
+    _lock_release(&s_session_cache_lock);
+}
+
+static void session_cache_store(esp_tls_t *tls)
+{
+    if (tls->session_cache_host == NULL) {
+        return;
+    }
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    int ret = mbedtls_ssl_get_session(&tls->ssl, &session);
+    if (ret != 0) {
+        ESP_LOGD(TAG, "Failed to obtain the session of %s, returned -0x%04X", tls->session_cache_host, -ret);
+        mbedtls_ssl_session_free(&session);
+        return;
+    }
+    char *host = strdup(tls->session_cache_host);
+    if (host == NULL) {
+        mbedtls_ssl_session_free(&session);
+        return;
+    }
+
+    _lock_acquire(&s_session_cache_lock);
+    session_cache_entry_t *entry = session_cache_find(tls);
+    if (entry == NULL) {
+        /* Free entries have never been used, so they are taken first */
+        entry = &s_session_cache[0];
+        for (int i = 1; i < CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE; i++) {
+            if (s_session_cache[i].last_used < entry->last_used) {
+                entry = &s_session_cache[i];
+            }
+        }
+    }
+    session_cache_entry_free(entry);
+    entry->host = host;
+    memcpy(entry->key, tls->session_cache_key, sizeof(entry->key));
+    entry->session = session;
+    entry->last_used = ++s_session_cache_clock;
+    _lock_release(&s_session_cache_lock);
+    ESP_LOGD(TAG, "Cached the session of %s", tls->session_cache_host);
+}
+
+static void session_cache_remove(esp_tls_t *tls)
+{
+    if (tls->session_cache_host == NULL) {
+        return;
+    }
+    _lock_acquire(&s_session_cache_lock);
+    session_cache_entry_t *entry = session_cache_find(tls);
+    if (entry != NULL) {
+        session_cache_entry_free(entry);
+    }
+    _lock_release(&s_session_cache_lock);
+}
+
+/* Copies the cached session of the connection through its serialized form */
+static int session_cache_copy(esp_tls_t *tls, mbedtls_ssl_session *session)
+{
+    int ret = MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    if (tls->session_cache_host == NULL) {
+        return ret;
+    }
+    _lock_acquire(&s_session_cache_lock);
+    session_cache_entry_t *entry = session_cache_find(tls);
+    if (entry != NULL) {
+        size_t len = 0;
+        mbedtls_ssl_session_save(&entry->session, NULL, 0, &len);
+        unsigned char *buf = calloc(1, len);
+        if (buf == NULL) {
+            ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
+        } else {
+            ret = mbedtls_ssl_session_save(&entry->session, buf, len, &len);
+            if (ret == 0) {
+                ret = mbedtls_ssl_session_load(session, buf, len);
+            }
+            mbedtls_platform_zeroize(buf, len);
+            free(buf);
+        }
+    }
+    _lock_release(&s_session_cache_lock);
+    return ret;
+}
+
+void esp_mbedtls_session_cache_clear(void)
+{
+    _lock_acquire(&s_session_cache_lock);
+    for (int i = 0; i < CONFIG_ESP_TLS_CLIENT_SESSION_CACHE_SIZE; i++) {
+        session_cache_entry_free(&s_session_cache[i]);
+    }
+    _lock_release(&s_session_cache_lock);
+}
+#endif /* CONFIG_ESP_TLS_CLIENT_SESSION_CACHE */
+
 #ifdef CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
 esp_tls_client_session_t *esp_mbedtls_get_client_session(esp_tls_t *tls)
 {
@@ -196,6 +412,12 @@ esp_tls_client_session_t *esp_mbedtls_get_client_session(esp_tls_t *tls)
     }
 
     int ret = mbedtls_ssl_get_session(&tls->ssl, &(client_session->saved_session));
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+    if (ret != 0) {
+        /* A TLS 1.3 session can be obtained only once, it may already belong to the cache */
+        ret = session_cache_copy(tls, &(client_session->saved_session));
+    }
+#endif
     if (ret != 0) {
         ESP_LOGE(TAG, "Error in obtaining the client ssl session");
         mbedtls_print_error_msg(ret);
@@ -230,6 +452,12 @@ int esp_mbedtls_handshake(esp_tls_t *tls, const esp_tls_cfg_t *cfg)
     ret = mbedtls_ssl_handshake(&tls->ssl);
     if (ret == 0) {
         tls->conn_state = ESP_TLS_DONE;
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+        /* A TLS 1.3 session is cached once the server sent a ticket after the handshake */
+        if (mbedtls_ssl_get_version_number(&tls->ssl) != MBEDTLS_SSL_VERSION_TLS1_3) {
+            session_cache_store(tls);
+        }
+#endif
 
 #ifdef CONFIG_ESP_TLS_USE_DS_PERIPHERAL
         esp_ds_release_ds_lock();
@@ -245,6 +473,9 @@ int esp_mbedtls_handshake(esp_tls_t *tls, const esp_tls_cfg_t *cfg)
                 /* This is to check whether handshake failed due to invalid certificate*/
                 esp_mbedtls_verify_certificate(tls);
             }
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+            session_cache_remove(tls);
+#endif
             tls->conn_state = ESP_TLS_FAIL;
             return -1;
         }
@@ -265,6 +496,11 @@ ssize_t esp_mbedtls_read(esp_tls_t *tls, char *data, size_t datalen)
     if (mbedtls_ssl_get_version_number(&tls->ssl) == MBEDTLS_SSL_VERSION_TLS1_3) {
         while (ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET || tls->ssl.MBEDTLS_PRIVATE(state) == MBEDTLS_SSL_TLS1_3_NEW_SESSION_TICKET) {
             ESP_LOGD(TAG, "got session ticket in TLS 1.3 connection, retry read");
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+            if (ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) {
+                session_cache_store(tls);
+            }
+#endif
             ret = mbedtls_ssl_read(&tls->ssl, (unsigned char *)data, datalen);
         }
     }
@@ -379,6 +615,10 @@ void esp_mbedtls_cleanup(esp_tls_t *tls)
 #ifdef CONFIG_ESP_TLS_USE_DS_PERIPHERAL
     esp_ds_release_ds_lock();
 #endif
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+    free(tls->session_cache_host);
+    tls->session_cache_host = NULL;
+#endif
 }
 
 static esp_err_t set_ca_cert(esp_tls_t *tls, const unsigned char *cacert, size_t cacert_len)
@@ -555,6 +795,50 @@ void esp_mbedtls_server_session_ticket_ctx_free(esp_tls_server_session_ticket_ct
 }
 #endif
 
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_CACHE
+static int esp_mbedtls_server_session_cache_get(void *data, unsigned char const *session_id, size_t session_id_len, mbedtls_ssl_session *session)
+{
+    esp_tls_server_session_cache_ctx_t *ctx = data;
+    _lock_acquire(&ctx->lock);
+    int ret = mbedtls_ssl_cache_get(&ctx->cache, session_id, session_id_len, session);
+    _lock_release(&ctx->lock);
+    if (ret == 0) {
+        ESP_LOGD(TAG, "Resuming a cached session");
+    }
+    return ret;
+}
+
+static int esp_mbedtls_server_session_cache_set(void *data, unsigned char const *session_id, size_t session_id_len, const mbedtls_ssl_session *session)
+{
+    esp_tls_server_session_cache_ctx_t *ctx = data;
+    _lock_acquire(&ctx->lock);
+    int ret = mbedtls_ssl_cache_set(&ctx->cache, session_id, session_id_len, session);
+    _lock_release(&ctx->lock);
+    if (ret != 0) {
+        ESP_LOGD(TAG, "Caching the session resulted in error code -0x%04X", -ret);
+    }
+    return ret;
+}
+
+void esp_mbedtls_server_session_cache_ctx_init(esp_tls_server_session_cache_ctx_t *ctx, size_t max_entries)
+{
+    _lock_init(&ctx->lock);
+    mbedtls_ssl_cache_init(&ctx->cache);
+    mbedtls_ssl_cache_set_max_entries(&ctx->cache, max_entries);
+#if defined(MBEDTLS_HAVE_TIME)
+    mbedtls_ssl_cache_set_timeout(&ctx->cache, CONFIG_ESP_TLS_SERVER_SESSION_CACHE_TIMEOUT);
+#endif
+}
+
+void esp_mbedtls_server_session_cache_ctx_free(esp_tls_server_session_cache_ctx_t *ctx)
+{
+    if (ctx) {
+        mbedtls_ssl_cache_free(&ctx->cache);
+        _lock_close(&ctx->lock);
+    }
+}
+#endif
+
 static esp_err_t set_server_config(esp_tls_cfg_server_t *cfg, esp_tls_t *tls)
 {
     assert(cfg != NULL);
@@ -685,6 +969,15 @@ static esp_err_t set_server_config(esp_tls_cfg_server_t *cfg, esp_tls_t *tls)
     }
 #endif
 
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_CACHE
+    if (cfg->session_cache_ctx) {
+        ESP_LOGD(TAG, "Enabling server-side tls session cache");
+        mbedtls_ssl_conf_session_cache(&tls->conf, cfg->session_cache_ctx,
+                esp_mbedtls_server_session_cache_get,
+                esp_mbedtls_server_session_cache_set);
+    }
+#endif
+
     return ESP_OK;
 }
 
@@ -712,6 +1005,12 @@ esp_err_t set_client_config(const char *hostname, size_t hostlen, esp_tls_cfg_t
             free(use_host);
             return ESP_ERR_MBEDTLS_SSL_SET_HOSTNAME_FAILED;
         }
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+        if (session_cache_is_usable(cfg) && session_cache_key_init(tls, hostname, hostlen, cfg)) {
+            tls->session_cache_host = use_host;
+            use_host = NULL;
+        }
+#endif
         free(use_host);
     }
 
@@ -987,6 +1286,10 @@ esp_err_t esp_mbedtls_set_global_ca_store(const unsigned char *cacert_pem_buf, c
             return ret;
         }
     }
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+    /* The cached sessions were verified with the previous global CA store */
+    esp_mbedtls_session_cache_clear();
+#endif
     ret = mbedtls_x509_crt_parse(global_cacert, cacert_pem_buf, cacert_pem_bytes);
     if (ret < 0) {
         ESP_LOGE(TAG, "mbedtls_x509_crt_parse of global CA cert returned -0x%04X", -ret);
@@ -1013,6 +1316,9 @@ void esp_mbedtls_free_global_ca_store(void)
         mbedtls_x509_crt_free(global_cacert);
         free(global_cacert);
         global_cacert = NULL;
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+        esp_mbedtls_session_cache_clear();
+#endif
     }
 }
 
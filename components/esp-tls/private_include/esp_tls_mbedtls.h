@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -92,6 +92,22 @@ esp_err_t esp_mbedtls_server_session_ticket_ctx_init(esp_tls_server_session_tick
 void esp_mbedtls_server_session_ticket_ctx_free(esp_tls_server_session_ticket_ctx_t *cfg);
 #endif
 
+#ifdef CONFIG_ESP_TLS_SERVER_SESSION_CACHE
+/**
+ * Internal function to setup server side session cache
+ *
+ * /note :- The function can only be used with mbedtls ssl library
+ */
+void esp_mbedtls_server_session_cache_ctx_init(esp_tls_server_session_cache_ctx_t *ctx, size_t max_entries);
+
+/**
+ * Internal function to free server side session cache
+ *
+ * /note :- The function can only be used with mbedtls ssl library
+ */
+void esp_mbedtls_server_session_cache_ctx_free(esp_tls_server_session_cache_ctx_t *ctx);
+#endif
+
 /**
  * Internal Callback for set_client_config_function
  */
@@ -109,6 +125,13 @@ esp_tls_client_session_t *esp_mbedtls_get_client_session(esp_tls_t *tls);
 void esp_mbedtls_free_client_session(esp_tls_client_session_t *client_session);
 #endif
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+/**
+ * Internal Callback for esp_tls_client_session_cache_clear
+ */
+void esp_mbedtls_session_cache_clear(void);
+#endif
+
 /**
  * Internal Callback for mbedtls_init_global_ca_store
  */
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -34,6 +34,10 @@
 #include "wolfssl/ssl.h"
 #endif
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+#define ESP_TLS_SESSION_CACHE_KEY_LEN   32  /*!< Length of the cache key of a client session, a SHA-256 hash */
+#endif
+
 struct esp_tls {
 #ifdef CONFIG_ESP_TLS_USING_MBEDTLS
     mbedtls_ssl_context ssl;                                                    /*!< TLS/SSL context */
@@ -94,6 +98,13 @@ struct esp_tls {
 
     esp_tls_error_handle_t error_handle;                                        /*!< handle to error descriptor */
 
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_CACHE
+    char *session_cache_host;                                                   /*!< Server name under which the session is cached,
+                                                                                     NULL if the connection does not use the cache */
+
+    unsigned char session_cache_key[ESP_TLS_SESSION_CACHE_KEY_LEN];             /*!< Hash of the server address and of the
+                                                                                     trust configuration of the connection */
+#endif
 };
 
 // Function pointer for the server configuration API
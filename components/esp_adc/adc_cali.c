@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -42,3 +42,22 @@ esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltag
 
     return handle->raw_to_voltage(handle->ctx, raw, voltage);
 }
+
+esp_err_t adc_cali_raw_to_voltage_batch(adc_cali_handle_t handle, const uint16_t *raw, int *voltage, size_t num)
+{
+    ESP_RETURN_ON_FALSE(handle && ((raw && voltage) || num == 0), ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    ESP_RETURN_ON_FALSE(handle->ctx, ESP_ERR_INVALID_STATE, TAG, "no calibration scheme, create a scheme first");
+
+    if (handle->raw_to_voltage_batch) {
+        return handle->raw_to_voltage_batch(handle->ctx, raw, voltage, num);
+    }
+
+    for (size_t i = 0; i < num; i++) {
+        esp_err_t ret = handle->raw_to_voltage(handle->ctx, raw[i], &voltage[i]);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    return ESP_OK;
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -54,8 +54,12 @@ typedef struct {
     adc_atten_t atten;                             ///< ADC attenuation
     cali_chars_first_step_t chars_first_step;      ///< Calibration first step characteristics
     cali_chars_second_step_t chars_second_step;    ///< Calibration second step characteristics
+    int16_t *lut;                                  ///< Precomputed voltage of each raw value, NULL if not used
 } cali_chars_curve_fitting_t;
 
+// number of entries of the lookup table, one per raw value
+#define CURVE_FITTING_LUT_SIZE    (1L << SOC_ADC_RTC_MAX_BITWIDTH)
+
 /* ----------------------- Characterization Functions ----------------------- */
 static void get_first_step_reference_point(int version_num, adc_unit_t unit_id, adc_atten_t atten, adc_calib_info_t *calib_info);
 static void calc_first_step_coefficients(const adc_calib_info_t *parsed_data, cali_chars_curve_fitting_t *chars);
@@ -64,6 +68,8 @@ static esp_err_t check_valid(const adc_cali_curve_fitting_config_t *config);
 
 /* ------------------------ Interface Functions --------------------------- */
 static esp_err_t cali_raw_to_voltage(void *arg, int raw, int *voltage);
+static esp_err_t cali_raw_to_voltage_lut(void *arg, int raw, int *voltage);
+static esp_err_t cali_raw_to_voltage_batch_lut(void *arg, const uint16_t *raw, int *voltage, size_t num);
 
 /* ------------------------- Public API ------------------------------------- */
 esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_config_t *config, adc_cali_handle_t *ret_handle)
@@ -99,14 +105,26 @@ esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_conf
     chars->chan = config->chan;
     chars->atten = config->atten;
 
+    if (config->flags.use_lut) {
+        uint32_t caps = config->flags.lut_in_psram ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL;
+        chars->lut = (int16_t *)heap_caps_malloc(CURVE_FITTING_LUT_SIZE * sizeof(int16_t), caps | MALLOC_CAP_8BIT);
+        ESP_GOTO_ON_FALSE(chars->lut, ESP_ERR_NO_MEM, err, TAG, "no memory for the calibration lookup table");
+        for (int raw = 0; raw < CURVE_FITTING_LUT_SIZE; raw++) {
+            int voltage = 0;
+            cali_raw_to_voltage(chars, raw, &voltage);
+            chars->lut[raw] = (int16_t)voltage;
+        }
+        scheme->raw_to_voltage = cali_raw_to_voltage_lut;
+        scheme->raw_to_voltage_batch = cali_raw_to_voltage_batch_lut;
+    }
+
     *ret_handle = scheme;
 
     return ESP_OK;
 
 err:
-    if (scheme) {
-        free(scheme);
-    }
+    free(chars);
+    free(scheme);
     return ret;
 }
 
@@ -114,6 +132,10 @@ esp_err_t adc_cali_delete_scheme_curve_fitting(adc_cali_handle_t handle)
 {
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
 
+    cali_chars_curve_fitting_t *chars = handle->ctx;
+    if (chars) {
+        free(chars->lut);
+    }
     free(handle->ctx);
     handle->ctx = NULL;
 
@@ -147,6 +169,35 @@ static esp_err_t cali_raw_to_voltage(void *arg, int raw, int *voltage)
     return ESP_OK;
 }
 
+static esp_err_t cali_raw_to_voltage_lut(void *arg, int raw, int *voltage)
+{
+    cali_chars_curve_fitting_t *ctx = arg;
+
+    if (raw < 0 || raw >= CURVE_FITTING_LUT_SIZE) {
+        return cali_raw_to_voltage(arg, raw, voltage);
+    }
+    // the channel compensation is already folded into the table
+    *voltage = ctx->lut[raw];
+
+    return ESP_OK;
+}
+
+static esp_err_t cali_raw_to_voltage_batch_lut(void *arg, const uint16_t *raw, int *voltage, size_t num)
+{
+    cali_chars_curve_fitting_t *ctx = arg;
+    const int16_t *lut = ctx->lut;
+
+    for (size_t i = 0; i < num; i++) {
+        if (raw[i] < CURVE_FITTING_LUT_SIZE) {
+            voltage[i] = lut[raw[i]];
+        } else {
+            cali_raw_to_voltage(arg, raw[i], &voltage[i]);
+        }
+    }
+
+    return ESP_OK;
+}
+
 /* ----------------------- Characterization Functions ----------------------- */
 //To get the reference point (Dout, Vin)
 static void get_first_step_reference_point(int version_num, adc_unit_t unit_id, adc_atten_t atten, adc_calib_info_t *calib_info)
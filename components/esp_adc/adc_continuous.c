@@ -8,6 +8,8 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
 #include "sdkconfig.h"
 #if CONFIG_ADC_ENABLE_DEBUG_LOG
 // The local log level must be defined before including esp_log.h
@@ -269,6 +271,9 @@ esp_err_t adc_continuous_start(adc_continuous_handle_t handle)
     }
 
     handle->fsm = ADC_FSM_STARTED;
+    //drop the partial averages of the previous run
+    memset(handle->avg_sum, 0, sizeof(handle->avg_sum));
+    memset(handle->avg_cnt, 0, sizeof(handle->avg_cnt));
     sar_periph_ctrl_adc_continuous_power_acquire();
     //reset flags
     if (handle->use_adc1) {
@@ -390,6 +395,108 @@ esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint
     return ret;
 }
 
+// Parse the unit, channel and raw data of a conversion result, return false if the result is invalid
+static inline bool s_adc_parse_result(adc_continuous_handle_t handle, const adc_digi_output_data_t *p, adc_unit_t *unit, adc_channel_t *channel, uint32_t *raw)
+{
+#if CONFIG_IDF_TARGET_ESP32
+    *unit = ADC_UNIT_1;
+    *channel = p->type1.channel;
+    *raw = p->type1.data;
+#elif CONFIG_IDF_TARGET_ESP32S2
+    if (handle->hal_digi_ctrlr_cfg.conv_mode == ADC_CONV_BOTH_UNIT || handle->hal_digi_ctrlr_cfg.conv_mode == ADC_CONV_ALTER_UNIT) {
+        *unit = p->type2.unit ? ADC_UNIT_2 : ADC_UNIT_1;
+        *channel = p->type2.channel;
+        *raw = p->type2.data;
+    } else {
+        *unit = (handle->hal_digi_ctrlr_cfg.conv_mode == ADC_CONV_SINGLE_UNIT_2) ? ADC_UNIT_2 : ADC_UNIT_1;
+        *channel = p->type1.channel;
+        *raw = p->type1.data;
+    }
+#elif CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32C2 || CONFIG_IDF_TARGET_ESP32S3 || CONFIG_IDF_TARGET_ESP32P4
+    *unit = p->type2.unit ? ADC_UNIT_2 : ADC_UNIT_1;
+    *channel = p->type2.channel;
+    *raw = p->type2.data;
+#else
+    *unit = ADC_UNIT_1;
+    *channel = p->type2.channel;
+    *raw = p->type2.data;
+#endif
+    return (*unit < SOC_ADC_PERIPH_NUM) && (*channel < SOC_ADC_CHANNEL_NUM(*unit));
+}
+
+esp_err_t adc_continuous_read_planar(adc_continuous_handle_t handle, adc_continuous_channel_data_t *channels, uint32_t channel_num, uint32_t avg_len, uint32_t timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_STATE, ADC_TAG, "The driver isn't initialised");
+    ESP_RETURN_ON_FALSE(handle->fsm == ADC_FSM_STARTED, ESP_ERR_INVALID_STATE, ADC_TAG, "The driver is already stopped");
+    ESP_RETURN_ON_FALSE(channels && channel_num && avg_len, ESP_ERR_INVALID_ARG, ADC_TAG, "invalid argument");
+
+    //map each (unit, channel) to its output array, so that a conversion result is dispatched without searching
+    int8_t index_map[SOC_ADC_PERIPH_NUM][SOC_ADC_MAX_CHANNEL_NUM];
+    memset(index_map, -1, sizeof(index_map));
+    uint32_t min_samples = UINT32_MAX;
+    for (uint32_t i = 0; i < channel_num; i++) {
+        adc_continuous_channel_data_t *ch = &channels[i];
+        ESP_RETURN_ON_FALSE(ch->unit < SOC_ADC_PERIPH_NUM && ch->channel < SOC_ADC_CHANNEL_NUM(ch->unit), ESP_ERR_INVALID_ARG, ADC_TAG, "invalid channel %"PRIu32, i);
+        ESP_RETURN_ON_FALSE(ch->samples && ch->max_samples, ESP_ERR_INVALID_ARG, ADC_TAG, "no sample buffer of channel %"PRIu32, i);
+        ESP_RETURN_ON_FALSE(index_map[ch->unit][ch->channel] < 0, ESP_ERR_INVALID_ARG, ADC_TAG, "duplicated channel %"PRIu32, i);
+        index_map[ch->unit][ch->channel] = i;
+        ch->sample_num = 0;
+        min_samples = MIN(min_samples, ch->max_samples);
+    }
+
+    if (avg_len != handle->avg_len) {
+        memset(handle->avg_sum, 0, sizeof(handle->avg_sum));
+        memset(handle->avg_cnt, 0, sizeof(handle->avg_cnt));
+        handle->avg_len = avg_len;
+    }
+
+    TickType_t ticks_to_wait = timeout_ms / portTICK_PERIOD_MS;
+    if (timeout_ms == ADC_MAX_DELAY) {
+        ticks_to_wait = portMAX_DELAY;
+    }
+
+    //with each channel appearing once in the pattern, this length never overflows the smallest output array
+    size_t length_max = (size_t)min_samples * avg_len * handle->hal_digi_ctrlr_cfg.adc_pattern_len * SOC_ADC_DIGI_RESULT_BYTES;
+    size_t size = 0;
+    uint8_t *data = xRingbufferReceiveUpTo(handle->ringbuf_hdl, &size, ticks_to_wait, length_max);
+    if (!data) {
+        ESP_LOGV(ADC_TAG, "No data, increase timeout");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    //demultiplex the results straight from the internal pool, without copying them out first
+    for (size_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= size; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        adc_unit_t unit;
+        adc_channel_t chan;
+        uint32_t raw;
+        if (!s_adc_parse_result(handle, (const adc_digi_output_data_t *)&data[i], &unit, &chan, &raw)) {
+            continue;
+        }
+        int8_t idx = index_map[unit][chan];
+        if (idx < 0) {
+            continue;
+        }
+        adc_continuous_channel_data_t *ch = &channels[idx];
+        if (avg_len == 1) {
+            if (ch->sample_num < ch->max_samples) {
+                ch->samples[ch->sample_num++] = raw;
+            }
+            continue;
+        }
+        handle->avg_sum[unit][chan] += raw;
+        if (++handle->avg_cnt[unit][chan] == avg_len) {
+            if (ch->sample_num < ch->max_samples) {
+                ch->samples[ch->sample_num++] = handle->avg_sum[unit][chan] / avg_len;
+            }
+            handle->avg_sum[unit][chan] = 0;
+            handle->avg_cnt[unit][chan] = 0;
+        }
+    }
+    vRingbufferReturnItem(handle->ringbuf_hdl, data);
+
+    return ESP_OK;
+}
+
 esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle)
 {
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_STATE, ADC_TAG, "The driver isn't initialised");
@@ -99,6 +99,9 @@ struct adc_continuous_ctx_t {
 #if SOC_ADC_MONITOR_SUPPORTED
     adc_monitor_t                   *adc_monitor[SOC_ADC_DIGI_MONITOR_NUM];    // adc monitor context
 #endif
+    uint32_t                        avg_len;                    //Number of raw results averaged into one sample by `adc_continuous_read_planar`
+    uint32_t                        avg_sum[SOC_ADC_PERIPH_NUM][SOC_ADC_MAX_CHANNEL_NUM];  //Partial sums of the averaged samples, kept across reads
+    uint32_t                        avg_cnt[SOC_ADC_PERIPH_NUM][SOC_ADC_MAX_CHANNEL_NUM];  //Number of raw results in the partial sums
     size_t                          adc_desc_size;
     adc_dma_t                       adc_dma;
     adc_dma_intr_func_t             adc_intr_func;
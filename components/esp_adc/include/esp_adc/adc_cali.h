@@ -1,11 +1,13 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #pragma once
 
+#include <stdint.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "esp_bit_defs.h"
 #include "hal/adc_types.h"
@@ -53,6 +55,24 @@ esp_err_t adc_cali_check_scheme(adc_cali_scheme_ver_t *scheme_mask);
  */
 esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage);
 
+/**
+ * @brief Convert an array of ADC raw data to calibrated voltages
+ *
+ * This is faster than calling `adc_cali_raw_to_voltage` for each raw data, especially with a scheme using a lookup
+ * table, and suits the per channel arrays filled by `adc_continuous_read_planar`.
+ *
+ * @param[in]  handle     ADC calibration handle
+ * @param[in]  raw        Array of ADC raw data
+ * @param[out] voltage    Array of calibrated ADC voltages (in mV), with `num` elements
+ * @param[in]  num        Number of raw data
+ *
+ * @return
+ *         - ESP_OK:                On success
+ *         - ESP_ERR_INVALID_ARG:   Invalid argument
+ *         - ESP_ERR_INVALID_STATE: Invalid state, scheme didn't registered
+ */
+esp_err_t adc_cali_raw_to_voltage_batch(adc_cali_handle_t handle, const uint16_t *raw, int *voltage, size_t num);
+
 #ifdef __cplusplus
 }
 #endif
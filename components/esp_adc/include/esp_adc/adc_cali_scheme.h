@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -24,6 +24,10 @@ typedef struct {
     adc_channel_t chan;         ///< ADC channel, for chips with SOC_ADC_CALIB_CHAN_COMPENS_SUPPORTED, calibration can be per channel
     adc_atten_t atten;          ///< ADC attenuation
     adc_bitwidth_t bitwidth;    ///< ADC raw output bitwidth
+    struct {
+        uint32_t use_lut: 1;        ///< Precompute the voltage of every raw value when creating the scheme, so that a conversion is a table lookup
+        uint32_t lut_in_psram: 1;   ///< Allocate the lookup table (8 KB) from PSRAM instead of internal memory
+    } flags;                    ///< Calibration scheme config flags
 } adc_cali_curve_fitting_config_t;
 
 /**
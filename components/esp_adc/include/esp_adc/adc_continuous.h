@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -175,6 +175,42 @@ esp_err_t adc_continuous_start(adc_continuous_handle_t handle);
  */
 esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint32_t length_max, uint32_t *out_length, uint32_t timeout_ms);
 
+/**
+ * @brief Samples of one ADC channel, filled by `adc_continuous_read_planar`
+ */
+typedef struct {
+    adc_unit_t unit;            ///< ADC unit of the channel
+    adc_channel_t channel;      ///< ADC channel
+    uint16_t *samples;          ///< Array receiving the raw data (or the averaged raw data) of the channel
+    uint32_t max_samples;       ///< Number of elements of `samples`
+    uint32_t sample_num;        ///< Number of samples written into `samples` by the last read, set by the driver
+} adc_continuous_channel_data_t;
+
+/**
+ * @brief Read the Conversion Results from ADC under continuous mode, demultiplexed into one array per channel.
+ *
+ * Unlike `adc_continuous_read`, the Conversion Results are parsed directly from the driver internal pool,
+ * and the raw data of each channel is written into its own array, so no intermediate buffer nor parsing is needed.
+ * Every `avg_len` consecutive raw data of a channel are averaged into one sample. The partial averages are kept
+ * across the calls, and dropped when the ADC is started again or `avg_len` changes.
+ *
+ * @note Each channel should appear only once in the ADC pattern, otherwise the samples which don't fit into the
+ *       arrays are dropped. Conversion Results of the channels not listed in `channels` are dropped as well.
+ *
+ * @param[in]    handle              ADC continuous mode driver handle
+ * @param[inout] channels            Channels to read, `sample_num` of each channel is set on return
+ * @param[in]    channel_num         Number of the channels
+ * @param[in]    avg_len             Number of raw data averaged into one sample, 1 to disable averaging
+ * @param[in]    timeout_ms          Time to wait for data via this API, in millisecond.
+ *
+ * @return
+ *         - ESP_ERR_INVALID_STATE Driver state is invalid.
+ *         - ESP_ERR_INVALID_ARG   Invalid argument
+ *         - ESP_ERR_TIMEOUT       Operation timed out
+ *         - ESP_OK                On success
+ */
+esp_err_t adc_continuous_read_planar(adc_continuous_handle_t handle, adc_continuous_channel_data_t *channels, uint32_t channel_num, uint32_t avg_len, uint32_t timeout_ms);
+
 /**
  * @brief Stop the ADC. After this, the hardware stops working.
  *
@@ -1,9 +1,10 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #pragma once
+#include <stddef.h>
 #include "esp_types.h"
 #include "esp_err.h"
 
@@ -32,6 +33,22 @@ struct adc_cali_scheme_t {
      */
     esp_err_t (*raw_to_voltage)(void *arg, int raw, int *voltage);
 
+    /**
+     * @brief Convert an array of ADC raw data to calibrated voltages
+     *
+     * Optional, `raw_to_voltage` is called for each raw data if it's NULL
+     *
+     * @param[in]  arg        ///< ADC calibration scheme specific context
+     * @param[in]  raw        ///< Array of ADC raw data
+     * @param[out] voltage    ///< Array of calibrated ADC voltages (in mV)
+     * @param[in]  num        ///< Number of raw data
+     *
+     * @return
+     *         - ESP_OK:                On success
+     *         - ESP_ERR_INVALID_ARG:   Invalid argument
+     */
+    esp_err_t (*raw_to_voltage_batch)(void *arg, const uint16_t *raw, int *voltage, size_t num);
+
     /**
      * @brief ADC calibration specific contexts
      * Can be customized to difference calibration schemes
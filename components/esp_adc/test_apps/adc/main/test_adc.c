@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
+#include "esp_heap_caps.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "soc/adc_periph.h"
@@ -301,6 +302,67 @@ TEST_CASE("test ADC2 Single Read with Light Sleep", "[adc]")
 
 #endif  //#if SOC_ADC_CALIBRATION_V1_SUPPORTED
 
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+/*---------------------------------------------------------------
+        ADC Calibration Lookup Table
+---------------------------------------------------------------*/
+#define TEST_CALI_LUT_RAW_NUM    (1 << SOC_ADC_RTC_MAX_BITWIDTH)
+
+TEST_CASE("ADC calibration lookup table matches curve fitting", "[adc]")
+{
+    uint16_t *raw = heap_caps_malloc(TEST_CALI_LUT_RAW_NUM * sizeof(uint16_t), MALLOC_CAP_DEFAULT);
+    int *voltage = heap_caps_malloc(TEST_CALI_LUT_RAW_NUM * sizeof(int), MALLOC_CAP_DEFAULT);
+    TEST_ASSERT(raw && voltage);
+    for (int i = 0; i < TEST_CALI_LUT_RAW_NUM; i++) {
+        raw[i] = i;
+    }
+
+    for (int i = 0; i < TEST_ATTEN_NUMS; i++) {
+        adc_cali_curve_fitting_config_t cali_config = {
+            .unit_id = ADC_UNIT_1,
+            .chan = ADC1_TEST_CHAN0,
+            .atten = g_test_atten[i],
+            .bitwidth = ADC_BITWIDTH_DEFAULT,
+        };
+        adc_cali_handle_t handle = NULL;
+        esp_err_t ret = adc_cali_create_scheme_curve_fitting(&cali_config, &handle);
+        if (ret == ESP_ERR_NOT_SUPPORTED) {
+            ESP_LOGW(TAG, "no efuse burnt, jump test");
+            break;
+        }
+        TEST_ESP_OK(ret);
+
+        adc_cali_handle_t lut_handle = NULL;
+        cali_config.flags.use_lut = true;
+        TEST_ESP_OK(adc_cali_create_scheme_curve_fitting(&cali_config, &lut_handle));
+
+        TEST_ESP_OK(adc_cali_raw_to_voltage_batch(lut_handle, raw, voltage, TEST_CALI_LUT_RAW_NUM));
+        for (int j = 0; j < TEST_CALI_LUT_RAW_NUM; j++) {
+            int expected = 0;
+            int lut_voltage = 0;
+            TEST_ESP_OK(adc_cali_raw_to_voltage(handle, j, &expected));
+            TEST_ESP_OK(adc_cali_raw_to_voltage(lut_handle, j, &lut_voltage));
+            TEST_ASSERT_EQUAL(expected, lut_voltage);
+            TEST_ASSERT_EQUAL(expected, voltage[j]);
+        }
+
+        // schemes without a lookup table convert a batch one raw data after the other
+        TEST_ESP_OK(adc_cali_raw_to_voltage_batch(handle, raw, voltage, TEST_CALI_LUT_RAW_NUM));
+        for (int j = 0; j < TEST_CALI_LUT_RAW_NUM; j++) {
+            int expected = 0;
+            TEST_ESP_OK(adc_cali_raw_to_voltage(handle, j, &expected));
+            TEST_ASSERT_EQUAL(expected, voltage[j]);
+        }
+
+        TEST_ESP_OK(adc_cali_delete_scheme_curve_fitting(lut_handle));
+        TEST_ESP_OK(adc_cali_delete_scheme_curve_fitting(handle));
+    }
+
+    free(raw);
+    free(voltage);
+}
+#endif  //#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+
 #if SOC_ADC_MONITOR_SUPPORTED && CONFIG_SOC_ADC_DMA_SUPPORTED
 #if CONFIG_IDF_TARGET_ESP32S2
 #define TEST_ADC_FORMAT_TYPE   ADC_DIGI_OUTPUT_FORMAT_TYPE1
@@ -211,6 +211,69 @@ TEST_CASE("ADC continuous big conv_frame_size test", "[adc_continuous]")
     free(result);
 }
 
+#define ADC_PLANAR_TEST_SAMPLES    64
+#define ADC_PLANAR_TEST_AVG_LEN    4
+
+TEST_CASE("ADC continuous planar read with averaging", "[adc_continuous]")
+{
+    adc_continuous_handle_t handle = NULL;
+    adc_continuous_handle_cfg_t adc_config = {
+        .max_store_buf_size = ADC_FRAME_TEST_SIZE,
+        .conv_frame_size = ADC_FRAME_TEST_SIZE,
+    };
+    TEST_ESP_OK(adc_continuous_new_handle(&adc_config, &handle));
+
+    adc_continuous_config_t dig_cfg = {
+        .sample_freq_hz = 50 * 1000,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DRIVER_TEST_OUTPUT_TYPE,
+    };
+    adc_digi_pattern_config_t adc_pattern[SOC_ADC_PATT_LEN_MAX] = {0};
+    adc_pattern[0].atten = ADC_ATTEN_DB_12;
+    adc_pattern[0].channel = ADC1_TEST_CHAN0;
+    adc_pattern[0].unit = ADC_UNIT_1;
+    adc_pattern[0].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    dig_cfg.adc_pattern = adc_pattern;
+    dig_cfg.pattern_num = 1;
+    TEST_ESP_OK(adc_continuous_config(handle, &dig_cfg));
+
+    uint16_t *samples = calloc(ADC_PLANAR_TEST_SAMPLES, sizeof(uint16_t));
+    TEST_ASSERT(samples);
+    adc_continuous_channel_data_t chan_data = {
+        .unit = ADC_UNIT_1,
+        .channel = ADC1_TEST_CHAN0,
+        .samples = samples,
+        .max_samples = ADC_PLANAR_TEST_SAMPLES,
+    };
+
+    // a channel listed twice is rejected
+    adc_continuous_channel_data_t dup_data[2] = {chan_data, chan_data};
+    TEST_ESP_OK(adc_continuous_start(handle));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, adc_continuous_read_planar(handle, dup_data, 2, 1, ADC_MAX_DELAY));
+    TEST_ESP_OK(adc_continuous_stop(handle));
+
+    for (int level = 0; level < 2; level++) {
+        test_adc_set_io_level(ADC_UNIT_1, ADC1_TEST_CHAN0, level);
+        TEST_ESP_OK(adc_continuous_start(handle));
+        for (int i = 0; i < 5; i++) {
+            TEST_ESP_OK(adc_continuous_read_planar(handle, &chan_data, 1, ADC_PLANAR_TEST_AVG_LEN, ADC_MAX_DELAY));
+            esp_rom_printf("sample_num: %" PRIu32 "\n", chan_data.sample_num);
+            TEST_ASSERT_LESS_OR_EQUAL_UINT32(ADC_PLANAR_TEST_SAMPLES, chan_data.sample_num);
+            for (int j = 0; j < chan_data.sample_num; j++) {
+                if (level) {
+                    TEST_ASSERT_INT_WITHIN(ADC_TEST_HIGH_THRESH, ADC_TEST_HIGH_VAL_DMA, samples[j]);
+                } else {
+                    TEST_ASSERT_INT_WITHIN(ADC_TEST_LOW_THRESH, ADC_TEST_LOW_VAL, samples[j]);
+                }
+            }
+        }
+        TEST_ESP_OK(adc_continuous_stop(handle));
+    }
+
+    TEST_ESP_OK(adc_continuous_deinit(handle));
+    free(samples);
+}
+
 #define ADC_FLUSH_TEST_SIZE    64
 
 TEST_CASE("ADC continuous flush internal pool", "[adc_continuous][manual][ignore]")
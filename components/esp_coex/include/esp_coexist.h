@@ -8,6 +8,7 @@
 #define __ESP_COEXIST_H__
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "esp_err.h"
 #include "hal/gpio_types.h"
 
@@ -219,6 +220,63 @@ esp_err_t esp_external_coex_set_validate_high(bool is_high_valid);
 esp_err_t esp_coex_wifi_i154_enable(void);
 #endif
 
+#if CONFIG_ESP_COEX_ADAPTIVE_POLICY
+/**
+ * @brief Radio declaring its traffic demand to the coexistence policy
+ */
+typedef enum {
+    ESP_COEX_RADIO_WIFI = 0,        /*!< Wi-Fi */
+    ESP_COEX_RADIO_BT,              /*!< Bluetooth and BLE */
+    ESP_COEX_RADIO_IEEE802154,      /*!< IEEE802.15.4 */
+    ESP_COEX_RADIO_NUM,             /*!< Radio numbers */
+} esp_coex_radio_t;
+
+/**
+ * @brief Traffic demand of a radio
+ */
+typedef struct {
+    uint32_t queued_bytes;          /*!< Bytes waiting to be sent or expected to be received, 0 if the radio is idle */
+    uint32_t max_latency_ms;        /*!< Maximum latency tolerated by the traffic, 0 if it has no latency requirement */
+} esp_coex_demand_t;
+
+/**
+ * @brief Statistics of the coexistence policy
+ */
+typedef struct {
+    esp_coex_prefer_t prefer;                       /*!< Preference currently selected */
+    uint64_t prefer_time_us[ESP_COEX_PREFER_NUM];   /*!< Time spent with each preference */
+    uint32_t switch_count;                          /*!< Number of times the preference changed */
+    uint32_t demand_count[ESP_COEX_RADIO_NUM];      /*!< Number of demands declared by each radio */
+    uint64_t busy_time_us[ESP_COEX_RADIO_NUM];      /*!< Time each radio declared queued traffic */
+} esp_coex_policy_stats_t;
+
+/**
+ * @brief Declare the traffic demand of a radio
+ *
+ * The preference is selected from the demands of all the radios: a radio with queued traffic and a
+ * latency requirement is preferred over one without, then the radio with the tightest latency, then
+ * the only busy side. Otherwise the preference is balanced. IEEE802.15.4 shares the Bluetooth side of
+ * the preference.
+ *
+ * @param radio : radio declaring the demand
+ * @param demand : current demand of the radio
+ * @return : ESP_OK - success, ESP_ERR_INVALID_ARG - invalid radio or demand, other - failed to set the preference
+ */
+esp_err_t esp_coex_demand_set(esp_coex_radio_t radio, const esp_coex_demand_t *demand);
+
+/**
+ * @brief Get the statistics of the coexistence policy
+ * @param stats : statistics, the times are counted up to the call
+ * @return : ESP_OK - success, ESP_ERR_INVALID_ARG - stats is NULL
+ */
+esp_err_t esp_coex_policy_get_stats(esp_coex_policy_stats_t *stats);
+
+/**
+ * @brief Clear the statistics of the coexistence policy, the demands and the selected preference are kept
+ */
+void esp_coex_policy_reset_stats(void);
+#endif
+
 #if CONFIG_ESP_COEX_GPIO_DEBUG
 /**
  * @brief Enable coexist GPIO debug.
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <sys/lock.h>
+#include <sys/param.h>
+#include "esp_coexist.h"
+#include "esp_timer.h"
+
+/*
+ * The coexistence scheme only knows the state of each stack (connected, scanning, ...), not how much traffic they
+ * have to carry. The stacks declare their queued traffic and latency requirement here, and the preference given to
+ * the coexistence scheme is selected from them. The demands are declared when the traffic changes, not per packet,
+ * so a lock is taken for the whole selection, which also keeps the preference set in the coexistence library in
+ * line with the one accounted here.
+ */
+
+#define LATENCY_NONE    UINT32_MAX
+
+static _lock_t s_policy_lock;
+static esp_coex_demand_t s_demand[ESP_COEX_RADIO_NUM];
+static esp_coex_policy_stats_t s_stats = {
+    .prefer = ESP_COEX_PREFER_BALANCE,
+};
+static int64_t s_prefer_since;
+static int64_t s_busy_since[ESP_COEX_RADIO_NUM];
+
+static uint32_t demand_latency(const esp_coex_demand_t *demand)
+{
+    if (demand->queued_bytes == 0 || demand->max_latency_ms == 0) {
+        return LATENCY_NONE;
+    }
+    return demand->max_latency_ms;
+}
+
+static esp_coex_prefer_t policy_select(void)
+{
+    const esp_coex_demand_t *wifi = &s_demand[ESP_COEX_RADIO_WIFI];
+    const esp_coex_demand_t *bt = &s_demand[ESP_COEX_RADIO_BT];
+    const esp_coex_demand_t *i154 = &s_demand[ESP_COEX_RADIO_IEEE802154];
+    uint32_t wifi_latency = demand_latency(wifi);
+    uint32_t bt_latency = MIN(demand_latency(bt), demand_latency(i154));
+    bool wifi_busy = wifi->queued_bytes > 0;
+    bool bt_busy = bt->queued_bytes > 0 || i154->queued_bytes > 0;
+
+    if (wifi_latency < bt_latency) {
+        return ESP_COEX_PREFER_WIFI;
+    }
+    if (bt_latency < wifi_latency) {
+        return ESP_COEX_PREFER_BT;
+    }
+    if (wifi_busy && !bt_busy) {
+        return ESP_COEX_PREFER_WIFI;
+    }
+    if (bt_busy && !wifi_busy) {
+        return ESP_COEX_PREFER_BT;
+    }
+    return ESP_COEX_PREFER_BALANCE;
+}
+
+static void stats_update(esp_coex_policy_stats_t *stats, int64_t now)
+{
+    stats->prefer_time_us[stats->prefer] += now - s_prefer_since;
+    for (int i = 0; i < ESP_COEX_RADIO_NUM; i++) {
+        if (s_demand[i].queued_bytes > 0) {
+            stats->busy_time_us[i] += now - s_busy_since[i];
+        }
+    }
+}
+
+esp_err_t esp_coex_demand_set(esp_coex_radio_t radio, const esp_coex_demand_t *demand)
+{
+    esp_err_t ret = ESP_OK;
+
+    if (radio >= ESP_COEX_RADIO_NUM || demand == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    _lock_acquire(&s_policy_lock);
+    int64_t now = esp_timer_get_time();
+    bool was_busy = s_demand[radio].queued_bytes > 0;
+    bool is_busy = demand->queued_bytes > 0;
+
+    if (was_busy) {
+        s_stats.busy_time_us[radio] += now - s_busy_since[radio];
+    }
+    if (was_busy || is_busy) {
+        s_busy_since[radio] = now;
+    }
+    s_demand[radio] = *demand;
+    s_stats.demand_count[radio]++;
+
+    esp_coex_prefer_t prefer = policy_select();
+    if (prefer != s_stats.prefer) {
+        ret = esp_coex_preference_set(prefer);
+        if (ret == ESP_OK) {
+            s_stats.prefer_time_us[s_stats.prefer] += now - s_prefer_since;
+            s_prefer_since = now;
+            s_stats.prefer = prefer;
+            s_stats.switch_count++;
+        }
+    }
+    _lock_release(&s_policy_lock);
+    return ret;
+}
+
+esp_err_t esp_coex_policy_get_stats(esp_coex_policy_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    _lock_acquire(&s_policy_lock);
+    *stats = s_stats;
+    stats_update(stats, esp_timer_get_time());
+    _lock_release(&s_policy_lock);
+    return ESP_OK;
+}
+
+void esp_coex_policy_reset_stats(void)
+{
+    _lock_acquire(&s_policy_lock);
+    int64_t now = esp_timer_get_time();
+    esp_coex_prefer_t prefer = s_stats.prefer;
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.prefer = prefer;
+    s_prefer_since = now;
+    for (int i = 0; i < ESP_COEX_RADIO_NUM; i++) {
+        s_busy_since[i] = now;
+    }
+    _lock_release(&s_policy_lock);
+}
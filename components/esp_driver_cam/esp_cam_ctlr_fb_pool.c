@@ -0,0 +1,259 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_cache.h"
+#include "esp_private/esp_cache_private.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/idf_additions.h"
+#include "soc/soc_caps.h"
+#include "esp_cam_ctlr.h"
+#include "esp_cam_ctlr_fb_pool.h"
+#if SOC_ISP_SUPPORTED
+#include "driver/isp_ae.h"
+#include "driver/isp_awb.h"
+#include "driver/isp_hist.h"
+#endif
+
+#define CAM_FB_POOL_MEM_ALLOC_CAPS      (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+
+static const char *TAG = "CAM_FB_POOL";
+
+struct esp_cam_fb_pool_t {
+    esp_cam_fb_t *fbs;              // Frames of the pool, in internal RAM as they are accessed in ISR
+    uint32_t fb_num;                // Number of frames
+    QueueHandle_t free_queue;       // Frames free for capturing
+    QueueHandle_t ready_queue;      // Captured frames, in the capturing order
+    uint32_t seq;                   // Sequence number of the next captured frame
+    portMUX_TYPE spinlock;          // Spinlock protecting the statistics below
+    uint32_t stats_flags;           // Statistics done since the previous captured frame
+    isp_ae_result_t ae;             // Latest AE statistics
+    isp_awb_stat_result_t awb;      // Latest AWB statistics
+    isp_hist_result_t hist;         // Latest histogram statistics
+};
+
+IRAM_ATTR static bool cam_fb_pool_on_get_new_trans(esp_cam_ctlr_handle_t handle, esp_cam_ctlr_trans_t *trans, void *user_data)
+{
+    esp_cam_fb_pool_handle_t pool = (esp_cam_fb_pool_handle_t)user_data;
+    BaseType_t high_task_woken = pdFALSE;
+    esp_cam_fb_t *fb = NULL;
+
+    // Overwrite the oldest captured frame if all the frames are in use, so that the latest frames are kept
+    if (xQueueReceiveFromISR(pool->free_queue, &fb, &high_task_woken) != pdTRUE &&
+            xQueueReceiveFromISR(pool->ready_queue, &fb, &high_task_woken) != pdTRUE) {
+        fb = NULL;
+    }
+    if (fb) {
+        trans->buffer = fb->buffer;
+        trans->buflen = fb->buflen;
+    } else {
+        // Leave the transaction empty, the controller falls back to its backup buffer, i.e. the frame is dropped
+        trans->buffer = NULL;
+        trans->buflen = 0;
+    }
+    return high_task_woken == pdTRUE;
+}
+
+IRAM_ATTR static bool cam_fb_pool_on_trans_finished(esp_cam_ctlr_handle_t handle, esp_cam_ctlr_trans_t *trans, void *user_data)
+{
+    esp_cam_fb_pool_handle_t pool = (esp_cam_fb_pool_handle_t)user_data;
+    BaseType_t high_task_woken = pdFALSE;
+    esp_cam_fb_t *fb = NULL;
+    // The next transaction may be got before the current one finishes, so look the frame up by its buffer
+    for (uint32_t i = 0; i < pool->fb_num; i++) {
+        if (pool->fbs[i].buffer == trans->buffer) {
+            fb = &pool->fbs[i];
+            break;
+        }
+    }
+    if (!fb) {
+        return false;
+    }
+    fb->received_size = trans->received_size;
+    fb->seq = pool->seq++;
+
+    portENTER_CRITICAL_ISR(&pool->spinlock);
+    fb->stats_flags = pool->stats_flags;
+    if (pool->stats_flags & ESP_CAM_FB_STATS_AE) {
+        fb->ae = pool->ae;
+    }
+    if (pool->stats_flags & ESP_CAM_FB_STATS_AWB) {
+        fb->awb = pool->awb;
+    }
+    if (pool->stats_flags & ESP_CAM_FB_STATS_HIST) {
+        fb->hist = pool->hist;
+    }
+    pool->stats_flags = 0;
+    portEXIT_CRITICAL_ISR(&pool->spinlock);
+
+    // The ready queue holds all the frames, it can't be full
+    xQueueSendFromISR(pool->ready_queue, &fb, &high_task_woken);
+    return high_task_woken == pdTRUE;
+}
+
+#if SOC_ISP_SUPPORTED
+IRAM_ATTR static bool cam_fb_pool_on_ae_done(isp_ae_ctlr_t ae_ctlr, const esp_isp_ae_env_detector_evt_data_t *edata, void *user_data)
+{
+    esp_cam_fb_pool_handle_t pool = (esp_cam_fb_pool_handle_t)user_data;
+    portENTER_CRITICAL_ISR(&pool->spinlock);
+    pool->ae = edata->ae_result;
+    pool->stats_flags |= ESP_CAM_FB_STATS_AE;
+    portEXIT_CRITICAL_ISR(&pool->spinlock);
+    return false;
+}
+
+IRAM_ATTR static bool cam_fb_pool_on_awb_done(isp_awb_ctlr_t awb_ctlr, const esp_isp_awb_evt_data_t *edata, void *user_data)
+{
+    esp_cam_fb_pool_handle_t pool = (esp_cam_fb_pool_handle_t)user_data;
+    portENTER_CRITICAL_ISR(&pool->spinlock);
+    pool->awb = edata->awb_result;
+    pool->stats_flags |= ESP_CAM_FB_STATS_AWB;
+    portEXIT_CRITICAL_ISR(&pool->spinlock);
+    return false;
+}
+
+IRAM_ATTR static bool cam_fb_pool_on_hist_done(isp_hist_ctlr_t hist_ctlr, const esp_isp_hist_evt_data_t *edata, void *user_data)
+{
+    esp_cam_fb_pool_handle_t pool = (esp_cam_fb_pool_handle_t)user_data;
+    portENTER_CRITICAL_ISR(&pool->spinlock);
+    pool->hist = edata->hist_result;
+    pool->stats_flags |= ESP_CAM_FB_STATS_HIST;
+    portEXIT_CRITICAL_ISR(&pool->spinlock);
+    return false;
+}
+
+static esp_err_t cam_fb_pool_register_isp_callbacks(esp_cam_fb_pool_handle_t pool, const esp_cam_fb_pool_config_t *config)
+{
+    if (config->ae_ctlr) {
+        esp_isp_ae_env_detector_evt_cbs_t ae_cbs = {
+            .on_env_statistics_done = cam_fb_pool_on_ae_done,
+        };
+        ESP_RETURN_ON_ERROR(esp_isp_ae_env_detector_register_event_callbacks(config->ae_ctlr, &ae_cbs, pool), TAG, "register AE callbacks failed");
+    }
+    if (config->awb_ctlr) {
+        esp_isp_awb_cbs_t awb_cbs = {
+            .on_statistics_done = cam_fb_pool_on_awb_done,
+        };
+        ESP_RETURN_ON_ERROR(esp_isp_awb_register_event_callbacks(config->awb_ctlr, &awb_cbs, pool), TAG, "register AWB callbacks failed");
+    }
+    if (config->hist_ctlr) {
+        esp_isp_hist_cbs_t hist_cbs = {
+            .on_statistics_done = cam_fb_pool_on_hist_done,
+        };
+        ESP_RETURN_ON_ERROR(esp_isp_hist_register_event_callbacks(config->hist_ctlr, &hist_cbs, pool), TAG, "register histogram callbacks failed");
+    }
+    return ESP_OK;
+}
+#endif
+
+static void cam_fb_pool_free(esp_cam_fb_pool_handle_t pool)
+{
+    if (pool->fbs) {
+        for (uint32_t i = 0; i < pool->fb_num; i++) {
+            free(pool->fbs[i].buffer);
+        }
+        free(pool->fbs);
+    }
+    if (pool->free_queue) {
+        vQueueDeleteWithCaps(pool->free_queue);
+    }
+    if (pool->ready_queue) {
+        vQueueDeleteWithCaps(pool->ready_queue);
+    }
+    free(pool);
+}
+
+esp_err_t esp_cam_ctlr_new_fb_pool(esp_cam_ctlr_handle_t ctlr, const esp_cam_fb_pool_config_t *config, esp_cam_fb_pool_handle_t *ret_pool)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(ctlr && config && ret_pool && config->fb_num, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+#if !SOC_ISP_SUPPORTED
+    ESP_RETURN_ON_FALSE(!config->ae_ctlr && !config->awb_ctlr && !config->hist_ctlr, ESP_ERR_INVALID_ARG, TAG, "ISP statistics not supported");
+#endif
+
+    size_t fb_size = config->fb_size;
+    if (fb_size == 0) {
+        ESP_RETURN_ON_ERROR(esp_cam_ctlr_get_frame_buffer_len(ctlr, &fb_size), TAG, "get frame size failed");
+    }
+
+    esp_cam_fb_pool_handle_t pool = heap_caps_calloc(1, sizeof(struct esp_cam_fb_pool_t), CAM_FB_POOL_MEM_ALLOC_CAPS);
+    ESP_RETURN_ON_FALSE(pool, ESP_ERR_NO_MEM, TAG, "no mem for frame buffer pool");
+    pool->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    pool->fb_num = config->fb_num;
+    pool->free_queue = xQueueCreateWithCaps(config->fb_num, sizeof(esp_cam_fb_t *), CAM_FB_POOL_MEM_ALLOC_CAPS);
+    pool->ready_queue = xQueueCreateWithCaps(config->fb_num, sizeof(esp_cam_fb_t *), CAM_FB_POOL_MEM_ALLOC_CAPS);
+    ESP_GOTO_ON_FALSE(pool->free_queue && pool->ready_queue, ESP_ERR_NO_MEM, err, TAG, "no mem for frame queues");
+    pool->fbs = heap_caps_calloc(config->fb_num, sizeof(esp_cam_fb_t), CAM_FB_POOL_MEM_ALLOC_CAPS);
+    ESP_GOTO_ON_FALSE(pool->fbs, ESP_ERR_NO_MEM, err, TAG, "no mem for frames");
+
+    // Whole cache lines per buffer, so that invalidating a frame doesn't touch its neighbours
+    size_t dma_alignment = 4;
+    size_t cache_alignment = 1;
+    ESP_GOTO_ON_ERROR(esp_cache_get_alignment(MALLOC_CAP_SPIRAM | MALLOC_CAP_DMA, &cache_alignment), err, TAG, "failed to get cache alignment");
+    size_t alignment = MAX(cache_alignment, dma_alignment);
+    fb_size = (fb_size + alignment - 1) & ~(alignment - 1);
+    for (uint32_t i = 0; i < config->fb_num; i++) {
+        esp_cam_fb_t *fb = &pool->fbs[i];
+        fb->buffer = heap_caps_aligned_calloc(alignment, 1, fb_size, MALLOC_CAP_SPIRAM);
+        ESP_GOTO_ON_FALSE(fb->buffer, ESP_ERR_NO_MEM, err, TAG, "no mem for frame buffer %"PRIu32, i);
+        fb->buflen = fb_size;
+        // Write back the zeroed buffer, so that no dirty cache line overwrites the captured data later
+        esp_cache_msync(fb->buffer, fb_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+        xQueueSend(pool->free_queue, &fb, 0);
+    }
+
+#if SOC_ISP_SUPPORTED
+    ESP_GOTO_ON_ERROR(cam_fb_pool_register_isp_callbacks(pool, config), err, TAG, "register ISP callbacks failed");
+#endif
+    esp_cam_ctlr_evt_cbs_t cbs = {
+        .on_get_new_trans = cam_fb_pool_on_get_new_trans,
+        .on_trans_finished = cam_fb_pool_on_trans_finished,
+    };
+    ESP_GOTO_ON_ERROR(esp_cam_ctlr_register_event_callbacks(ctlr, &cbs, pool), err, TAG, "register controller callbacks failed");
+
+    ESP_LOGD(TAG, "new frame buffer pool %p, %"PRIu32" frames of %u bytes", pool, pool->fb_num, fb_size);
+    *ret_pool = pool;
+    return ESP_OK;
+
+err:
+    cam_fb_pool_free(pool);
+    return ret;
+}
+
+esp_err_t esp_cam_fb_pool_acquire(esp_cam_fb_pool_handle_t pool, esp_cam_fb_t **ret_fb, uint32_t timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(pool && ret_fb, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    TickType_t ticks = (timeout_ms == ESP_CAM_CTLR_MAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    if (xQueueReceive(pool->ready_queue, ret_fb, ticks) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_cam_fb_pool_release(esp_cam_fb_pool_handle_t pool, esp_cam_fb_t *fb)
+{
+    ESP_RETURN_ON_FALSE(pool && fb, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    ESP_RETURN_ON_FALSE(fb >= pool->fbs && fb < pool->fbs + pool->fb_num, ESP_ERR_INVALID_ARG, TAG, "frame %p doesn't belong to the pool", fb);
+    // The free queue holds all the frames, it can't be full
+    xQueueSend(pool->free_queue, &fb, 0);
+    return ESP_OK;
+}
+
+esp_err_t esp_cam_fb_pool_del(esp_cam_fb_pool_handle_t pool)
+{
+    ESP_RETURN_ON_FALSE(pool, ESP_ERR_INVALID_ARG, TAG, "invalid argument: null pointer");
+    cam_fb_pool_free(pool);
+    return ESP_OK;
+}
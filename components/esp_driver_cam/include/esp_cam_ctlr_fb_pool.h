@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_cam_ctlr_types.h"
+#include "driver/isp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_CAM_FB_STATS_AE     (1 << 0)    ///< AE statistics of the frame are valid
+#define ESP_CAM_FB_STATS_AWB    (1 << 1)    ///< AWB statistics of the frame are valid
+#define ESP_CAM_FB_STATS_HIST   (1 << 2)    ///< Histogram statistics of the frame are valid
+
+/**
+ * @brief ESP CAM frame buffer pool handle
+ */
+typedef struct esp_cam_fb_pool_t *esp_cam_fb_pool_handle_t;
+
+/**
+ * @brief Frame of a frame buffer pool
+ */
+typedef struct {
+    void *buffer;                   ///< Frame buffer, owned by the pool
+    size_t buflen;                  ///< Length of the frame buffer
+    size_t received_size;           ///< Size of the received frame
+    uint32_t seq;                   ///< Sequence number of the frames captured into the pool, a gap means frames were overwritten
+    uint32_t stats_flags;           ///< Bit mask of ESP_CAM_FB_STATS_AE, ESP_CAM_FB_STATS_AWB and ESP_CAM_FB_STATS_HIST, telling which statistics are valid
+    isp_ae_result_t ae;             ///< AE statistics done while the frame was captured
+    isp_awb_stat_result_t awb;      ///< AWB statistics done while the frame was captured
+    isp_hist_result_t hist;         ///< Histogram statistics done while the frame was captured
+} esp_cam_fb_t;
+
+/**
+ * @brief ESP CAM frame buffer pool configuration
+ */
+typedef struct {
+    uint32_t fb_num;                ///< Number of frame buffers
+    size_t fb_size;                 ///< Size of each frame buffer, set to 0 to use the frame size of the controller
+    isp_ae_ctlr_t ae_ctlr;          ///< AE controller whose statistics are attached to the frames, can be NULL
+    isp_awb_ctlr_t awb_ctlr;        ///< AWB controller whose statistics are attached to the frames, can be NULL
+    isp_hist_ctlr_t hist_ctlr;      ///< Histogram controller whose statistics are attached to the frames, can be NULL
+} esp_cam_fb_pool_config_t;
+
+/**
+ * @brief Create a pool of frame buffers which the camera controller captures into
+ *
+ * The frame buffers are allocated from PSRAM, aligned to the cache line. The pool registers the event callbacks of the
+ * camera controller, and the statistics callbacks of the given ISP controllers, so none of them should be registered
+ * by the user. The captured frames are got by `esp_cam_fb_pool_acquire` and given back by `esp_cam_fb_pool_release`.
+ * When no frame buffer is free, the oldest captured frame that isn't acquired is overwritten.
+ *
+ * @note The pool must be created before the camera controller and the ISP controllers are enabled.
+ * @note The driver internal backup buffer of the camera controller must not be disabled, it receives the frames
+ *       while all the frame buffers are acquired by the user.
+ *
+ * @param[in]  ctlr      ESP CAM controller handle
+ * @param[in]  config    Frame buffer pool configuration
+ * @param[out] ret_pool  Returned frame buffer pool handle
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument
+ *        - ESP_ERR_INVALID_STATE: Invalid state, the controllers are already enabled
+ *        - ESP_ERR_NO_MEM:        Out of memory
+ */
+esp_err_t esp_cam_ctlr_new_fb_pool(esp_cam_ctlr_handle_t ctlr, const esp_cam_fb_pool_config_t *config, esp_cam_fb_pool_handle_t *ret_pool);
+
+/**
+ * @brief Acquire the oldest captured frame of a frame buffer pool
+ *
+ * @param[in]  pool        Frame buffer pool handle
+ * @param[out] ret_fb      Returned frame, valid until it's released
+ * @param[in]  timeout_ms  Timeout in ms, ESP_CAM_CTLR_MAX_DELAY to wait forever
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument
+ *        - ESP_ERR_TIMEOUT:       No frame is captured within the timeout
+ */
+esp_err_t esp_cam_fb_pool_acquire(esp_cam_fb_pool_handle_t pool, esp_cam_fb_t **ret_fb, uint32_t timeout_ms);
+
+/**
+ * @brief Release an acquired frame, so that its buffer can capture a new frame
+ *
+ * @param[in]  pool  Frame buffer pool handle
+ * @param[in]  fb    Frame acquired by `esp_cam_fb_pool_acquire`
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument
+ */
+esp_err_t esp_cam_fb_pool_release(esp_cam_fb_pool_handle_t pool, esp_cam_fb_t *fb);
+
+/**
+ * @brief Delete a frame buffer pool
+ *
+ * @note The camera controller must be stopped and the ISP controllers must be disabled before the pool is deleted.
+ *       The event callbacks registered by the pool stay registered, so the controllers must not be enabled again
+ *       before other callbacks are registered.
+ *
+ * @param[in]  pool  Frame buffer pool handle
+ *
+ * @return
+ *        - ESP_OK
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument
+ */
+esp_err_t esp_cam_fb_pool_del(esp_cam_fb_pool_handle_t pool);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,6 +8,7 @@
 #include "unity.h"
 #include "esp_cam_ctlr_csi.h"
 #include "esp_cam_ctlr.h"
+#include "esp_cam_ctlr_fb_pool.h"
 
 TEST_CASE("TEST CSI driver allocation", "[csi]")
 {
@@ -61,3 +62,39 @@ TEST_CASE("TEST CSI driver no backup buffer usage", "[csi]")
     TEST_ASSERT_EQUAL(0, bk_buffer_len);
     TEST_ESP_OK(esp_cam_ctlr_del(handle));
 }
+
+TEST_CASE("TEST CSI driver frame buffer pool", "[csi]")
+{
+    esp_cam_ctlr_csi_config_t csi_config = {
+        .ctlr_id = 0,
+        .h_res = 800,
+        .v_res = 640,
+        .lane_bit_rate_mbps = 200,
+        .input_data_color_type = CAM_CTLR_COLOR_RAW8,
+        .output_data_color_type = CAM_CTLR_COLOR_RGB565,
+        .data_lane_num = 2,
+        .byte_swap_en = false,
+        .queue_items = 1,
+    };
+    esp_cam_ctlr_handle_t handle = NULL;
+    TEST_ESP_OK(esp_cam_new_csi_ctlr(&csi_config, &handle));
+
+    esp_cam_fb_pool_config_t pool_config = {
+        .fb_num = 3,
+    };
+    esp_cam_fb_pool_handle_t pool = NULL;
+    TEST_ESP_OK(esp_cam_ctlr_new_fb_pool(handle, &pool_config, &pool));
+
+    // No frame is captured before the controller starts
+    esp_cam_fb_t *fb = NULL;
+    TEST_ESP_ERR(ESP_ERR_TIMEOUT, esp_cam_fb_pool_acquire(pool, &fb, 10));
+    esp_cam_fb_t foreign_fb = {};
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_cam_fb_pool_release(pool, &foreign_fb));
+    TEST_ESP_OK(esp_cam_fb_pool_del(pool));
+
+    // The pool can't take over the callbacks of an enabled controller
+    TEST_ESP_OK(esp_cam_ctlr_enable(handle));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_cam_ctlr_new_fb_pool(handle, &pool_config, &pool));
+    TEST_ESP_OK(esp_cam_ctlr_disable(handle));
+    TEST_ESP_OK(esp_cam_ctlr_del(handle));
+}
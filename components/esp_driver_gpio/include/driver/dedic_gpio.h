@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "esp_attr.h"
 #include "soc/soc_caps.h"
@@ -133,6 +134,91 @@ uint32_t dedic_gpio_bundle_read_out(dedic_gpio_bundle_handle_t bundle) IRAM_ATTR
  */
 uint32_t dedic_gpio_bundle_read_in(dedic_gpio_bundle_handle_t bundle) IRAM_ATTR;
 
+/**
+ * @brief Type of Dedicated GPIO program
+ */
+typedef struct dedic_gpio_program_t *dedic_gpio_program_handle_t;
+
+/**
+ * @brief Type of Dedicated GPIO program operation
+ */
+typedef enum {
+    DEDIC_GPIO_OP_WRITE,      /*!< Write `value` to the GPIOs in `mask` of the output bundle */
+    DEDIC_GPIO_OP_WRITE_DATA, /*!< Write the next element of the `tx_values` passed to `dedic_gpio_run_program` to the GPIOs in `mask` of the output bundle */
+    DEDIC_GPIO_OP_READ,       /*!< Read the GPIOs in `mask` of the input bundle into the next element of the `rx_values` passed to `dedic_gpio_run_program` */
+    DEDIC_GPIO_OP_DELAY,      /*!< Wait `delay_ns` nanoseconds */
+} dedic_gpio_op_type_t;
+
+/**
+ * @brief Type of Dedicated GPIO program operation
+ */
+typedef struct {
+    dedic_gpio_op_type_t type; /*!< Operation type */
+    uint32_t mask;             /*!< Mask of the GPIOs to write or read, seen from the view of the bundle */
+    union {
+        uint32_t value;        /*!< Value to write, for DEDIC_GPIO_OP_WRITE, low bit represents low member in the bundle */
+        uint32_t delay_ns;     /*!< Time to wait in nanoseconds, for DEDIC_GPIO_OP_DELAY */
+    };
+} dedic_gpio_op_t;
+
+/**
+ * @brief Type of Dedicated GPIO program configuration
+ */
+typedef struct {
+    dedic_gpio_bundle_handle_t out_bundle; /*!< Bundle that the write operations work on, can be NULL if there're no write operations */
+    dedic_gpio_bundle_handle_t in_bundle;  /*!< Bundle that the read operations work on, can be NULL if there're no read operations */
+    const dedic_gpio_op_t *ops;            /*!< Array of operations, executed in order */
+    size_t num_ops;                        /*!< Number of operations */
+} dedic_gpio_program_config_t;
+
+/**
+ * @brief Compile a sequence of operations into a Dedicated GPIO program
+ *
+ * The masks and the values are shifted to the dedicated channels of the bundles, consecutive delays are merged,
+ * and the delays are converted into CPU cycles, so that running the program only costs a few instructions per operation.
+ *
+ * @note The delays are converted with the CPU frequency at the time of compiling.
+ *       If the CPU frequency may change (e.g. Dynamic Frequency Scaling is enabled), hold an `ESP_PM_CPU_FREQ_MAX` lock
+ *       when compiling and running the program.
+ *
+ * @param[in] config Configuration of the program
+ * @param[out] ret_program Returned handle of the program
+ * @return
+ *      - ESP_OK: Compile the program successfully
+ *      - ESP_ERR_INVALID_ARG: Compile the program failed because of invalid argument, e.g. a mask is out of the bundle
+ *      - ESP_ERR_NO_MEM: Compile the program failed because of no capable memory
+ */
+esp_err_t dedic_gpio_new_program(const dedic_gpio_program_config_t *config, dedic_gpio_program_handle_t *ret_program);
+
+/**
+ * @brief Delete a Dedicated GPIO program
+ *
+ * @param[in] program Handle of the program that returned from `dedic_gpio_new_program`
+ * @return
+ *      - ESP_OK: Delete the program successfully
+ *      - ESP_ERR_INVALID_ARG: Delete the program failed because of invalid argument
+ */
+esp_err_t dedic_gpio_del_program(dedic_gpio_program_handle_t program);
+
+/**
+ * @brief Run a Dedicated GPIO program
+ *
+ * Each delay is counted from the end of the previous delay rather than from the end of the previous operation,
+ * so the time spent on the operations is compensated and the timing of the waveform is deterministic.
+ *
+ * @note The program must run on the CPU core that the bundles are installed on.
+ *       Disable the interrupts around this function if the waveform must not be stretched by an interrupt.
+ * @note For performance reasons, this function doesn't check the validity of any parameters, and is placed in IRAM.
+ *
+ * @param[in] program Handle of the program that returned from `dedic_gpio_new_program`
+ * @param[in] tx_values Values for the DEDIC_GPIO_OP_WRITE_DATA operations, in order, low bit represents low member in the bundle.
+ *                      Can be NULL if there're no such operations.
+ * @param[out] rx_values Values read by the DEDIC_GPIO_OP_READ operations, in order, low bit represents low member in the bundle.
+ *                       Can be NULL if there're no such operations.
+ * @return Number of values read into `rx_values`
+ */
+size_t dedic_gpio_run_program(dedic_gpio_program_handle_t program, const uint32_t *tx_values, uint32_t *rx_values) IRAM_ATTR;
+
 #if SOC_DEDIC_GPIO_HAS_INTERRUPT
 
 /**
@@ -20,6 +20,7 @@
 #include "hal/dedic_gpio_cpu_ll.h"
 #include "esp_private/gpio.h"
 #include "esp_private/periph_ctrl.h"
+#include "esp_private/esp_clk.h"
 #include "esp_rom_gpio.h"
 #include "freertos/FreeRTOS.h"
 #include "driver/dedic_gpio.h"
@@ -36,6 +37,7 @@ static const char *TAG = "dedic_gpio";
 
 typedef struct dedic_gpio_platform_t dedic_gpio_platform_t;
 typedef struct dedic_gpio_bundle_t dedic_gpio_bundle_t;
+typedef struct dedic_gpio_program_t dedic_gpio_program_t;
 
 // Dedicated GPIO driver platform, GPIO bundles will be installed onto it
 static dedic_gpio_platform_t *s_platform[SOC_CPU_CORES_NUM];
@@ -57,6 +59,18 @@ struct dedic_gpio_platform_t {
 #endif
 };
 
+// Operation of a compiled program, the operands are already shifted to the dedicated channels
+typedef struct {
+    dedic_gpio_op_type_t type;
+    uint32_t mask;  // mask of the dedicated channels
+    uint32_t arg;   // value for WRITE, offset of the bundle for WRITE_DATA and READ, CPU cycles for DELAY
+} dedic_gpio_program_op_t;
+
+struct dedic_gpio_program_t {
+    size_t num_ops;                 // number of compiled operations
+    dedic_gpio_program_op_t ops[];  // compiled operations
+};
+
 struct dedic_gpio_bundle_t {
     int core_id;    // CPU core ID, a GPIO bundle must be installed to a specific CPU core
     uint32_t out_mask;   // mask of output channels in the bank
@@ -397,6 +411,106 @@ uint32_t dedic_gpio_bundle_read_in(dedic_gpio_bundle_handle_t bundle)
     return (value & bundle->in_mask) >> (bundle->in_offset);
 }
 
+esp_err_t dedic_gpio_new_program(const dedic_gpio_program_config_t *config, dedic_gpio_program_handle_t *ret_program)
+{
+    esp_err_t ret = ESP_OK;
+    dedic_gpio_program_t *program = NULL;
+    ESP_GOTO_ON_FALSE(config && ret_program && config->ops && config->num_ops, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    // the program is accessed by the IRAM function, so it's allocated from the internal memory
+    program = heap_caps_calloc(1, sizeof(dedic_gpio_program_t) + config->num_ops * sizeof(dedic_gpio_program_op_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_GOTO_ON_FALSE(program, ESP_ERR_NO_MEM, err, TAG, "no mem for program");
+
+    uint64_t cpu_freq_hz = esp_clk_cpu_freq();
+    dedic_gpio_bundle_t *out = config->out_bundle;
+    dedic_gpio_bundle_t *in = config->in_bundle;
+    size_t n = 0;
+    for (size_t i = 0; i < config->num_ops; i++) {
+        const dedic_gpio_op_t *op = &config->ops[i];
+        dedic_gpio_program_op_t *cop = &program->ops[n];
+        switch (op->type) {
+        case DEDIC_GPIO_OP_WRITE:
+        case DEDIC_GPIO_OP_WRITE_DATA:
+            ESP_GOTO_ON_FALSE(out && op->mask && ((op->mask << out->out_offset) & ~out->out_mask) == 0, ESP_ERR_INVALID_ARG, err,
+                              TAG, "invalid write mask in operation %zu", i);
+            cop->type = op->type;
+            cop->mask = op->mask << out->out_offset;
+            cop->arg = (op->type == DEDIC_GPIO_OP_WRITE) ? (op->value << out->out_offset) : out->out_offset;
+            n++;
+            break;
+        case DEDIC_GPIO_OP_READ:
+            ESP_GOTO_ON_FALSE(in && op->mask && ((op->mask << in->in_offset) & ~in->in_mask) == 0, ESP_ERR_INVALID_ARG, err,
+                              TAG, "invalid read mask in operation %zu", i);
+            cop->type = op->type;
+            cop->mask = op->mask << in->in_offset;
+            cop->arg = in->in_offset;
+            n++;
+            break;
+        case DEDIC_GPIO_OP_DELAY: {
+            uint32_t cycles = (uint32_t)((op->delay_ns * cpu_freq_hz + 500000000) / 1000000000);
+            if (!cycles) {
+                break;
+            }
+            // consecutive delays are merged into one
+            if (n && program->ops[n - 1].type == DEDIC_GPIO_OP_DELAY) {
+                program->ops[n - 1].arg += cycles;
+            } else {
+                cop->type = DEDIC_GPIO_OP_DELAY;
+                cop->arg = cycles;
+                n++;
+            }
+            break;
+        }
+        default:
+            ESP_GOTO_ON_FALSE(false, ESP_ERR_INVALID_ARG, err, TAG, "invalid type of operation %zu", i);
+        }
+    }
+    program->num_ops = n;
+    *ret_program = program;
+    return ESP_OK;
+
+err:
+    free(program);
+    return ret;
+}
+
+esp_err_t dedic_gpio_del_program(dedic_gpio_program_handle_t program)
+{
+    ESP_RETURN_ON_FALSE(program, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(program);
+    return ESP_OK;
+}
+
+size_t dedic_gpio_run_program(dedic_gpio_program_handle_t program, const uint32_t *tx_values, uint32_t *rx_values)
+{
+    // For performance reasons, we don't want to check the validation of parameters here
+    const dedic_gpio_program_op_t *op = program->ops;
+    const dedic_gpio_program_op_t *end = op + program->num_ops;
+    size_t rx_num = 0;
+    esp_cpu_cycle_count_t deadline = esp_cpu_get_cycle_count();
+    for (; op < end; op++) {
+        switch (op->type) {
+        case DEDIC_GPIO_OP_WRITE:
+            dedic_gpio_cpu_ll_write_mask(op->mask, op->arg);
+            break;
+        case DEDIC_GPIO_OP_WRITE_DATA:
+            dedic_gpio_cpu_ll_write_mask(op->mask, *tx_values++ << op->arg);
+            break;
+        case DEDIC_GPIO_OP_READ:
+            rx_values[rx_num++] = (dedic_gpio_cpu_ll_read_in() & op->mask) >> op->arg;
+            break;
+        case DEDIC_GPIO_OP_DELAY:
+            // count from the previous deadline, so the time spent on the operations in between is compensated
+            deadline += op->arg;
+            while ((int32_t)(deadline - esp_cpu_get_cycle_count()) > 0) {
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return rx_num;
+}
+
 #if SOC_DEDIC_GPIO_HAS_INTERRUPT
 esp_err_t dedic_gpio_bundle_set_interrupt_and_callback(dedic_gpio_bundle_handle_t bundle, uint32_t mask, dedic_gpio_intr_type_t intr_type, dedic_gpio_isr_callback_t cb_isr, void *cb_args)
 {
@@ -5,12 +5,15 @@
  */
 
 #include <string.h>
+#include <inttypes.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "unity.h"
 #include "unity_test_utils.h"
 #include "esp_rom_sys.h"
+#include "esp_cpu.h"
+#include "esp_private/esp_clk.h"
 #include "soc/soc_caps.h"
 #include "hal/dedic_gpio_cpu_ll.h"
 #include "driver/gpio.h"
@@ -231,3 +234,70 @@ TEST_CASE("Dedicated_GPIO_interrupt_and_callback", "[dedic_gpio]")
     TEST_ESP_OK(dedic_gpio_del_bundle(bundle));
     vSemaphoreDelete(sem);
 }
+
+TEST_CASE("Dedicated_GPIO_program", "[dedic_gpio]")
+{
+    // configure GPIO, the output is looped back to the input
+#if CONFIG_IDF_TARGET_ESP32P4
+    const int bundle_gpios[] = {20, 21};
+#else
+    const int bundle_gpios[] = {0, 1};
+#endif
+    gpio_config_t io_conf = {
+        .mode = GPIO_MODE_INPUT_OUTPUT,
+    };
+    for (int i = 0; i < sizeof(bundle_gpios) / sizeof(bundle_gpios[0]); i++) {
+        io_conf.pin_bit_mask = 1ULL << bundle_gpios[i];
+        gpio_config(&io_conf);
+    }
+    dedic_gpio_bundle_handle_t bundle = NULL;
+    dedic_gpio_bundle_config_t bundle_config = {
+        .gpio_array = bundle_gpios,
+        .array_size = sizeof(bundle_gpios) / sizeof(bundle_gpios[0]),
+        .flags = {
+            .in_en = 1,
+            .out_en = 1,
+        },
+    };
+    TEST_ESP_OK(dedic_gpio_new_bundle(&bundle_config, &bundle));
+
+    const dedic_gpio_op_t ops[] = {
+        { .type = DEDIC_GPIO_OP_WRITE, .mask = 0x03, .value = 0x00 },
+        { .type = DEDIC_GPIO_OP_READ, .mask = 0x03 },
+        { .type = DEDIC_GPIO_OP_WRITE_DATA, .mask = 0x03 },
+        { .type = DEDIC_GPIO_OP_DELAY, .delay_ns = 50 * 1000 },
+        { .type = DEDIC_GPIO_OP_READ, .mask = 0x03 },
+        { .type = DEDIC_GPIO_OP_WRITE_DATA, .mask = 0x01 },
+        { .type = DEDIC_GPIO_OP_DELAY, .delay_ns = 25 * 1000 },
+        { .type = DEDIC_GPIO_OP_DELAY, .delay_ns = 25 * 1000 },
+        { .type = DEDIC_GPIO_OP_READ, .mask = 0x03 },
+    };
+    dedic_gpio_program_config_t program_config = {
+        .out_bundle = bundle,
+        .in_bundle = bundle,
+        .ops = ops,
+        .num_ops = sizeof(ops) / sizeof(ops[0]),
+    };
+    dedic_gpio_program_handle_t program = NULL;
+    // reading without input bundle is not allowed
+    program_config.in_bundle = NULL;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, dedic_gpio_new_program(&program_config, &program));
+    program_config.in_bundle = bundle;
+    TEST_ESP_OK(dedic_gpio_new_program(&program_config, &program));
+
+    const uint32_t tx_values[] = {0x02, 0x01};
+    uint32_t rx_values[3] = {0};
+    uint32_t start = esp_cpu_get_cycle_count();
+    TEST_ASSERT_EQUAL(3, dedic_gpio_run_program(program, tx_values, rx_values));
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    TEST_ASSERT_EQUAL_HEX32(0x00, rx_values[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x02, rx_values[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x03, rx_values[2]);
+    // the delays add up to 100us
+    uint32_t elapsed_us = cycles / (esp_clk_cpu_freq() / 1000000);
+    printf("program took %"PRIu32" us\r\n", elapsed_us);
+    TEST_ASSERT_UINT32_WITHIN(10, 100, elapsed_us);
+
+    TEST_ESP_OK(dedic_gpio_del_program(program));
+    TEST_ESP_OK(dedic_gpio_del_bundle(bundle));
+}
@@ -205,3 +205,91 @@ TEST_CASE("gpio_etm_self_trigger_multi_action", "[etm]")
     TEST_ESP_OK(esp_etm_del_channel(etm_channel_a));
     TEST_ESP_OK(esp_etm_del_channel(etm_channel_b));
 }
+
+TEST_CASE("gpio_etm_graph_pipeline", "[etm]")
+{
+    // GPIO 0 any edge event ---> GPIO 1 toggle task
+    // GPIO 1 any edge event ---> GPIO 2 toggle task
+    const uint32_t input_gpio = 0;
+    const uint32_t middle_gpio = 1;
+    const uint32_t output_gpio = 2;
+
+    printf("allocate GPIO etm events and tasks\r\n");
+    esp_etm_event_handle_t gpio_event_a = NULL;
+    esp_etm_event_handle_t gpio_event_b = NULL;
+    esp_etm_task_handle_t gpio_task_a = NULL;
+    esp_etm_task_handle_t gpio_task_b = NULL;
+    gpio_etm_event_config_t gpio_event_config = {
+        .edge = GPIO_ETM_EVENT_EDGE_ANY,
+    };
+    TEST_ESP_OK(gpio_new_etm_event(&gpio_event_config, &gpio_event_a));
+    TEST_ESP_OK(gpio_new_etm_event(&gpio_event_config, &gpio_event_b));
+    gpio_etm_task_config_t gpio_task_config = {
+        .action = GPIO_ETM_TASK_ACTION_TOG,
+    };
+    TEST_ESP_OK(gpio_new_etm_task(&gpio_task_config, &gpio_task_a));
+    TEST_ESP_OK(gpio_new_etm_task(&gpio_task_config, &gpio_task_b));
+    TEST_ESP_OK(gpio_etm_event_bind_gpio(gpio_event_a, input_gpio));
+    TEST_ESP_OK(gpio_etm_event_bind_gpio(gpio_event_b, middle_gpio));
+    TEST_ESP_OK(gpio_etm_task_add_gpio(gpio_task_a, middle_gpio));
+    TEST_ESP_OK(gpio_etm_task_add_gpio(gpio_task_b, output_gpio));
+
+    printf("initialize gpio\r\n");
+    gpio_config_t gpio_cfg = {
+        .intr_type = GPIO_INTR_DISABLE,
+        .mode = GPIO_MODE_INPUT_OUTPUT,
+        .pin_bit_mask = (1ULL << input_gpio) | (1ULL << middle_gpio) | (1ULL << output_gpio),
+    };
+    TEST_ESP_OK(gpio_config(&gpio_cfg));
+    TEST_ESP_OK(gpio_set_level(input_gpio, 0));
+    TEST_ESP_OK(gpio_set_level(middle_gpio, 0));
+    TEST_ESP_OK(gpio_set_level(output_gpio, 0));
+
+    printf("invalid graphs are rejected\r\n");
+    esp_etm_graph_handle_t graph = NULL;
+    esp_etm_graph_edge_t bad_edges[] = {
+        { .event = gpio_event_a, .task = gpio_task_a },
+        { .event = gpio_event_a, .task = gpio_task_a },
+    };
+    esp_etm_graph_config_t graph_config = {
+        .edges = bad_edges,
+        .num_edges = 2,
+    };
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_etm_new_graph(&graph_config, &graph));
+    bad_edges[1].task = NULL;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_etm_new_graph(&graph_config, &graph));
+
+    printf("build the pipeline\r\n");
+    esp_etm_graph_edge_t edges[] = {
+        { .event = gpio_event_a, .task = gpio_task_a },
+        { .event = gpio_event_b, .task = gpio_task_b },
+    };
+    graph_config.edges = edges;
+    TEST_ESP_OK(esp_etm_new_graph(&graph_config, &graph));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_etm_graph_disable(graph));
+    TEST_ESP_OK(esp_etm_graph_enable(graph));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_etm_del_graph(graph));
+    TEST_ESP_OK(esp_etm_graph_dump(graph, stdout));
+
+    // each edge of the input toggles the middle GPIO, whose edge toggles the output GPIO
+    for (int i = 1; i <= 4; i++) {
+        TEST_ESP_OK(gpio_set_level(input_gpio, i & 0x01));
+        vTaskDelay(pdMS_TO_TICKS(10));
+        TEST_ASSERT_EQUAL(i & 0x01, gpio_get_level(middle_gpio));
+        TEST_ASSERT_EQUAL(i & 0x01, gpio_get_level(output_gpio));
+    }
+
+    // with the graph disabled, the input doesn't reach the output anymore
+    TEST_ESP_OK(esp_etm_graph_disable(graph));
+    TEST_ESP_OK(gpio_set_level(input_gpio, 1));
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL(0, gpio_get_level(output_gpio));
+
+    TEST_ESP_OK(esp_etm_del_graph(graph));
+    TEST_ESP_OK(gpio_etm_task_rm_gpio(gpio_task_a, middle_gpio));
+    TEST_ESP_OK(gpio_etm_task_rm_gpio(gpio_task_b, output_gpio));
+    TEST_ESP_OK(esp_etm_del_task(gpio_task_a));
+    TEST_ESP_OK(esp_etm_del_task(gpio_task_b));
+    TEST_ESP_OK(esp_etm_del_event(gpio_event_a));
+    TEST_ESP_OK(esp_etm_del_event(gpio_event_b));
+}
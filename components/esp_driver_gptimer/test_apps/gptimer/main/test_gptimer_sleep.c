@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <inttypes.h>
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -15,6 +16,9 @@
 #include "esp_private/sleep_cpu.h"
 #include "esp_private/esp_sleep_internal.h"
 #include "esp_private/esp_pmu.h"
+#if SOC_TIMER_SUPPORT_SLEEP_RETENTION
+#include "esp_private/sleep_retention.h"
+#endif
 
 static bool test_gptimer_alarm_stop_callback(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data)
 {
@@ -29,8 +33,9 @@ static bool test_gptimer_alarm_stop_callback(gptimer_handle_t timer, const gptim
  * @brief Test the GPTimer driver can still work after light sleep
  *
  * @param allow_pd Whether to allow power down the peripheral in light sleep
+ * @param lazy_restore Whether to restore the timer group context by the CPU on demand, instead of by REGDMA
  */
-static void test_gptimer_sleep_retention(bool allow_pd)
+static void test_gptimer_sleep_retention(bool allow_pd, bool lazy_restore)
 {
     TaskHandle_t task_handle =  xTaskGetCurrentTaskHandle();
     gptimer_config_t timer_config = {
@@ -41,6 +46,12 @@ static void test_gptimer_sleep_retention(bool allow_pd)
     };
     gptimer_handle_t timer = NULL;
     TEST_ESP_OK(gptimer_new_timer(&timer_config, &timer));
+#if SOC_TIMER_SUPPORT_SLEEP_RETENTION
+    if (lazy_restore) {
+        // the first timer is allocated from group 0
+        TEST_ESP_OK(sleep_retention_module_set_restore_mode(SLEEP_RETENTION_MODULE_TG0_TIMER, SLEEP_RETENTION_RESTORE_ON_DEMAND));
+    }
+#endif
     gptimer_event_callbacks_t cbs = {
         .on_alarm = test_gptimer_alarm_stop_callback,
     };
@@ -89,6 +100,22 @@ static void test_gptimer_sleep_retention(bool allow_pd)
 #endif
     esp_sleep_set_sleep_context(NULL);
 
+#if SOC_TIMER_SUPPORT_SLEEP_RETENTION
+    if (lazy_restore) {
+        // restore the timer group before the first access
+        TEST_ESP_OK(sleep_retention_module_restore(SLEEP_RETENTION_MODULE_TG0_TIMER));
+        sleep_retention_module_stats_t stats;
+        TEST_ESP_OK(sleep_retention_module_get_stats(SLEEP_RETENTION_MODULE_TG0_TIMER, &stats));
+        printf("timer group context: %"PRIu32" words, restored by CPU %"PRIu32" words in %"PRIu32" us\r\n", stats.context_words, stats.lazy_words, stats.last_restore_us);
+        TEST_ASSERT_EQUAL(1, stats.restore_count);
+        TEST_ASSERT_NOT_EQUAL(0, stats.lazy_words);
+        // nothing left to restore
+        TEST_ESP_OK(sleep_retention_module_restore(SLEEP_RETENTION_MODULE_TG0_TIMER));
+        TEST_ESP_OK(sleep_retention_module_get_stats(SLEEP_RETENTION_MODULE_TG0_TIMER, &stats));
+        TEST_ASSERT_EQUAL(1, stats.restore_count);
+    }
+#endif
+
     uint64_t count_value_after_sleep = 0;
     TEST_ESP_OK(gptimer_get_raw_count(timer, &count_value_after_sleep));
     printf("count value after sleep wakeup: %llu\n", count_value_after_sleep);
@@ -112,8 +139,15 @@ static void test_gptimer_sleep_retention(bool allow_pd)
 
 TEST_CASE("gptimer can work after light sleep", "[gptimer]")
 {
-    test_gptimer_sleep_retention(false);
+    test_gptimer_sleep_retention(false, false);
 #if SOC_TIMER_SUPPORT_SLEEP_RETENTION
-    test_gptimer_sleep_retention(true);
+    test_gptimer_sleep_retention(true, false);
 #endif
 }
+
+#if SOC_TIMER_SUPPORT_SLEEP_RETENTION
+TEST_CASE("gptimer can work after light sleep with lazy retention restore", "[gptimer]")
+{
+    test_gptimer_sleep_retention(true, true);
+}
+#endif
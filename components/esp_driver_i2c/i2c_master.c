@@ -32,6 +32,7 @@
 #include "hal/i2c_hal.h"
 #include "hal/gpio_hal.h"
 #include "esp_memory_utils.h"
+#include "esp_timer.h"
 #include "freertos/idf_additions.h"
 
 static const char *TAG = "i2c.master";
@@ -582,6 +583,20 @@ static void s_i2c_send_command_async(i2c_master_bus_handle_t i2c_master, BaseTyp
     i2c_hal_master_trans_start(hal);
 }
 
+// Should be called with the spinlock taken, when the operations of a new transaction are set in `i2c_trans`
+static void s_i2c_stats_trans_start(i2c_master_bus_handle_t i2c_master)
+{
+    size_t bytes = 0;
+    for (size_t i = 0; i < i2c_master->i2c_trans.cmd_count; i++) {
+        i2c_operation_t *i2c_operation = &i2c_master->i2c_trans.ops[i];
+        if (i2c_operation->hw_cmd.op_code == I2C_LL_CMD_WRITE || i2c_operation->hw_cmd.op_code == I2C_LL_CMD_READ) {
+            bytes += i2c_operation->total_bytes;
+        }
+    }
+    i2c_master->trans_bytes = bytes;
+    i2c_master->trans_start_time = esp_timer_get_time();
+}
+
 static esp_err_t s_i2c_transaction_start(i2c_master_dev_handle_t i2c_dev, int xfer_timeout_ms)
 {
     i2c_master_bus_handle_t i2c_master = i2c_dev->master_bus;
@@ -603,6 +618,7 @@ static esp_err_t s_i2c_transaction_start(i2c_master_dev_handle_t i2c_dev, int xf
     i2c_master->cmd_idx = 0;
     i2c_master->rx_cnt = 0;
     i2c_master->read_len_static = 0;
+    s_i2c_stats_trans_start(i2c_master);
 
     I2C_CLOCK_SRC_ATOMIC() {
         i2c_hal_set_bus_timing(hal, i2c_dev->scl_speed_hz, i2c_master->base->clk_src, i2c_master->base->clk_src_freq_hz);
@@ -674,6 +690,31 @@ IRAM_ATTR static void i2c_isr_receive_handler(i2c_master_bus_t *i2c_master)
 #endif
 }
 
+static void IRAM_ATTR i2c_isr_stats_handler(i2c_master_bus_t *i2c_master, uint32_t int_mask)
+{
+    if (!(int_mask & (I2C_LL_INTR_NACK | I2C_LL_INTR_TIMEOUT | I2C_LL_INTR_ARBITRATION | I2C_LL_INTR_MST_COMPLETE))) {
+        return;
+    }
+    portENTER_CRITICAL_ISR(&i2c_master->base->spinlock);
+    // the transaction may be reported twice, e.g. a NACK is followed by the completion of the STOP command
+    if (i2c_master->trans_start_time) {
+        i2c_master_bus_stats_t *stats = &i2c_master->stats;
+        if (int_mask & I2C_LL_INTR_NACK) {
+            stats->nack_count++;
+        } else if (int_mask & I2C_LL_INTR_TIMEOUT) {
+            stats->timeout_count++;
+        } else if (int_mask & I2C_LL_INTR_ARBITRATION) {
+            stats->arbitration_lost_count++;
+        } else {
+            stats->bytes += i2c_master->trans_bytes;
+        }
+        stats->trans_count++;
+        stats->busy_time_us += esp_timer_get_time() - i2c_master->trans_start_time;
+        i2c_master->trans_start_time = 0;
+    }
+    portEXIT_CRITICAL_ISR(&i2c_master->base->spinlock);
+}
+
 static void IRAM_ATTR i2c_master_isr_handler_default(void *arg)
 {
     i2c_master_bus_handle_t i2c_master = (i2c_master_bus_t*) arg;
@@ -688,6 +729,7 @@ static void IRAM_ATTR i2c_master_isr_handler_default(void *arg)
     if (int_mask == 0) {
         return;
     }
+    i2c_isr_stats_handler(i2c_master, int_mask);
 
     if (int_mask & I2C_LL_INTR_NACK) {
         atomic_store(&i2c_master->status, I2C_STATUS_ACK_ERROR);
@@ -750,6 +792,9 @@ static void IRAM_ATTR i2c_master_isr_handler_default(void *arg)
                     i2c_ll_rxfifo_rst(hal->dev);
                     i2c_master->i2c_trans = t;
                     memcpy(i2c_master->i2c_ops, t.ops, t.cmd_count * sizeof(i2c_operation_t));
+                    portENTER_CRITICAL_ISR(&i2c_master->base->spinlock);
+                    s_i2c_stats_trans_start(i2c_master);
+                    portEXIT_CRITICAL_ISR(&i2c_master->base->spinlock);
 
                     s_i2c_send_command_async(i2c_master, &HPTaskAwoken);
                 }
@@ -1030,6 +1075,7 @@ esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *bus_config, i2c_mast
     ret = esp_intr_alloc_intrstatus(i2c_periph_signal[i2c_port_num].irq, isr_flags, (uint32_t)i2c_ll_get_interrupt_status_reg(hal->dev), I2C_LL_MASTER_EVENT_INTR, i2c_master_isr_handler_default, i2c_master, &i2c_master->base->intr_handle);
     ESP_GOTO_ON_ERROR(ret, err, TAG, "install i2c master interrupt failed");
     atomic_init(&i2c_master->status, I2C_STATUS_IDLE);
+    i2c_master->stats_reset_time = esp_timer_get_time();
 
     i2c_ll_master_set_filter(hal->dev, bus_config->glitch_ignore_cnt);
 
@@ -1123,6 +1169,26 @@ esp_err_t i2c_master_bus_reset(i2c_master_bus_handle_t bus_handle)
     return ESP_OK;
 }
 
+esp_err_t i2c_master_bus_get_stats(i2c_master_bus_handle_t bus_handle, i2c_master_bus_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(bus_handle && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    portENTER_CRITICAL(&bus_handle->base->spinlock);
+    *stats = bus_handle->stats;
+    stats->elapsed_time_us = esp_timer_get_time() - bus_handle->stats_reset_time;
+    portEXIT_CRITICAL(&bus_handle->base->spinlock);
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_reset_stats(i2c_master_bus_handle_t bus_handle)
+{
+    ESP_RETURN_ON_FALSE(bus_handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    portENTER_CRITICAL(&bus_handle->base->spinlock);
+    memset(&bus_handle->stats, 0, sizeof(bus_handle->stats));
+    bus_handle->stats_reset_time = esp_timer_get_time();
+    portEXIT_CRITICAL(&bus_handle->base->spinlock);
+    return ESP_OK;
+}
+
 esp_err_t i2c_master_get_bus_handle(i2c_port_num_t port_num, i2c_master_bus_handle_t *ret_handle)
 {
     ESP_RETURN_ON_FALSE((port_num < SOC_I2C_NUM), ESP_ERR_INVALID_ARG, TAG, "invalid i2c port number");
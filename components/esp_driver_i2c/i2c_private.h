@@ -16,6 +16,7 @@
 #include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "freertos/ringbuf.h"
+#include "driver/i2c_master.h"
 #include "driver/i2c_slave.h"
 #include "esp_private/periph_ctrl.h"
 #include "esp_pm.h"
@@ -171,6 +172,10 @@ struct i2c_master_bus_t {
     i2c_operation_t (*i2c_async_ops)[I2C_STATIC_OPERATION_ARRAY_MAX]; // pointer to asynchronous operation(s).
     uint32_t ops_prepare_idx;                                        // Index for the operations can be written into `i2c_async_ops` array.
     uint32_t ops_cur_size;                                           // Indicates how many operations have already put in `i2c_async_ops`.
+    i2c_master_bus_stats_t stats;                                    // Bus statistics, protected by the spinlock
+    int64_t stats_reset_time;                                        // Time when the statistics were reset, in us
+    int64_t trans_start_time;                                        // Start time of the transaction on the bus, in us, 0 if there is none
+    size_t trans_bytes;                                              // Data bytes of the transaction on the bus
     i2c_transaction_t i2c_trans_pool[];                              // I2C transaction pool.
 };
 
@@ -70,6 +70,19 @@ typedef struct {
     i2c_master_callback_t on_trans_done;  /*!< I2C master transaction finish callback */
 } i2c_master_event_callbacks_t;
 
+/**
+ * @brief I2C master bus statistics, counted since the bus is created or the statistics are reset
+ */
+typedef struct {
+    uint32_t trans_count;            /*!< Number of transactions finished on the bus, including the failed ones */
+    uint32_t nack_count;             /*!< Number of transactions stopped by a NACK */
+    uint32_t timeout_count;          /*!< Number of transactions stopped by a hardware timeout, e.g. SCL is stretched longer than `scl_wait_us` */
+    uint32_t arbitration_lost_count; /*!< Number of transactions stopped by losing the bus arbitration */
+    uint64_t bytes;                  /*!< Number of data bytes of the successful transactions, the address bytes are not included */
+    uint64_t busy_time_us;           /*!< Time spent in transactions, including the time SCL is stretched by the devices */
+    uint64_t elapsed_time_us;        /*!< Time since the statistics were reset, `busy_time_us / elapsed_time_us` gives the bus utilization */
+} i2c_master_bus_stats_t;
+
 /**
  * @brief Allocate an I2C master bus
  *
@@ -260,6 +273,29 @@ esp_err_t i2c_master_bus_reset(i2c_master_bus_handle_t bus_handle);
  */
 esp_err_t i2c_master_bus_wait_all_done(i2c_master_bus_handle_t bus_handle, int timeout_ms);
 
+/**
+ * @brief Get the statistics of the I2C master bus
+ *
+ * @note The statistics are updated in the interrupt handler, so they cover both the synchronous and the asynchronous transactions of all the devices on the bus.
+ *
+ * @param[in] bus_handle I2C bus handle
+ * @param[out] stats Returned statistics
+ * @return
+ *      - ESP_OK: Get statistics successfully
+ *      - ESP_ERR_INVALID_ARG: Get statistics failed because of invalid argument
+ */
+esp_err_t i2c_master_bus_get_stats(i2c_master_bus_handle_t bus_handle, i2c_master_bus_stats_t *stats);
+
+/**
+ * @brief Reset the statistics of the I2C master bus
+ *
+ * @param[in] bus_handle I2C bus handle
+ * @return
+ *      - ESP_OK: Reset statistics successfully
+ *      - ESP_ERR_INVALID_ARG: Reset statistics failed because of invalid argument
+ */
+esp_err_t i2c_master_bus_reset_stats(i2c_master_bus_handle_t bus_handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 #include "sdkconfig.h"
 #include "unity.h"
 #include "freertos/FreeRTOS.h"
@@ -347,6 +348,39 @@ TEST_CASE("I2C master transaction receive check nack return value", "[i2c]")
     _test_i2c_del_bus_device(bus_handle, dev_handle);
 }
 
+TEST_CASE("I2C master bus statistics", "[i2c]")
+{
+    uint8_t data_wr[DATA_LENGTH] = { 0 };
+    i2c_master_bus_stats_t stats;
+
+    i2c_master_bus_handle_t bus_handle;
+    i2c_master_dev_handle_t dev_handle;
+    _test_i2c_new_bus_device(&bus_handle, &dev_handle);
+    TEST_ESP_OK(i2c_master_bus_get_stats(bus_handle, &stats));
+    TEST_ASSERT_EQUAL(0, stats.trans_count);
+
+    // no device on the bus, each transaction is stopped by a NACK
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, i2c_master_transmit(dev_handle, data_wr, DATA_LENGTH, -1));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, i2c_master_transmit(dev_handle, data_wr, DATA_LENGTH, -1));
+    // probe is not counted
+    TEST_ESP_ERR(ESP_ERR_NOT_FOUND, i2c_master_probe(bus_handle, 0x22, -1));
+    TEST_ESP_OK(i2c_master_bus_get_stats(bus_handle, &stats));
+    printf("trans %"PRIu32", nack %"PRIu32", busy %"PRIu64"us / %"PRIu64"us\n", stats.trans_count, stats.nack_count, stats.busy_time_us, stats.elapsed_time_us);
+    TEST_ASSERT_EQUAL(2, stats.trans_count);
+    TEST_ASSERT_EQUAL(2, stats.nack_count);
+    TEST_ASSERT_EQUAL(0, stats.timeout_count);
+    TEST_ASSERT_EQUAL(0, stats.bytes);
+    TEST_ASSERT_GREATER_THAN(0, stats.busy_time_us);
+    TEST_ASSERT_GREATER_OR_EQUAL(stats.busy_time_us, stats.elapsed_time_us);
+
+    TEST_ESP_OK(i2c_master_bus_reset_stats(bus_handle));
+    TEST_ESP_OK(i2c_master_bus_get_stats(bus_handle, &stats));
+    TEST_ASSERT_EQUAL(0, stats.trans_count);
+    TEST_ASSERT_EQUAL(0, stats.nack_count);
+    TEST_ASSERT_EQUAL(0, stats.busy_time_us);
+    _test_i2c_del_bus_device(bus_handle, dev_handle);
+}
+
 TEST_CASE("Test get handle with known port", "[i2c]")
 {
     i2c_master_bus_handle_t handle;
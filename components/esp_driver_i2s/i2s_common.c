@@ -65,6 +65,7 @@
 
 #include "esp_rom_gpio.h"
 #include "esp_memory_utils.h"
+#include "esp_timer.h"
 
 /* The actual max size of DMA buffer is 4095
  * Reserve several bytes for alignment, so that the position of the slot data in the buffer will be relatively fixed */
@@ -446,6 +447,7 @@ uint32_t i2s_get_buf_size(i2s_chan_handle_t handle, uint32_t data_bit_width, uin
         bufsize = frame_num * bytes_per_frame;
         ESP_LOGW(TAG, "dma frame num is out of dma buffer size, limited to %"PRIu32, frame_num);
     }
+    handle->dma.buf_frame_num = bufsize / bytes_per_frame;
     return bufsize;
 }
 
@@ -589,7 +591,10 @@ static bool IRAM_ATTR i2s_dma_rx_callback(gdma_channel_handle_t dma_chan, gdma_e
         .data = &(finish_desc->buf),
         .dma_buf = (void *)finish_desc->buf,
         .size = handle->dma.buf_size,
+        .frame_index = handle->dma.frame_cnt,
+        .timestamp = esp_timer_get_time(),
     };
+    handle->dma.frame_cnt += handle->dma.buf_frame_num;
     if (handle->callbacks.on_recv) {
         user_need_yield |= handle->callbacks.on_recv(handle, &evt, handle->user_data);
     }
@@ -620,7 +625,10 @@ static bool IRAM_ATTR i2s_dma_tx_callback(gdma_channel_handle_t dma_chan, gdma_e
         .data = &(finish_desc->buf),
         .dma_buf = curr_buf,
         .size = handle->dma.buf_size,
+        .frame_index = handle->dma.frame_cnt,
+        .timestamp = esp_timer_get_time(),
     };
+    handle->dma.frame_cnt += handle->dma.buf_frame_num;
     if (handle->dma.auto_clear_before_cb) {
         memset(curr_buf, 0, handle->dma.buf_size);
     }
@@ -675,6 +683,9 @@ static void IRAM_ATTR i2s_dma_rx_callback(void *arg)
         evt.data = &(finish_desc->buf);
         evt.dma_buf = (void *)finish_desc->buf;
         evt.size = handle->dma.buf_size;
+        evt.frame_index = handle->dma.frame_cnt;
+        evt.timestamp = esp_timer_get_time();
+        handle->dma.frame_cnt += handle->dma.buf_frame_num;
         if (handle->callbacks.on_recv) {
             user_need_yield |= handle->callbacks.on_recv(handle, &evt, handle->user_data);
         }
@@ -716,6 +727,9 @@ static void IRAM_ATTR i2s_dma_tx_callback(void *arg)
         evt.data = &(finish_desc->buf);
         evt.dma_buf = curr_buf;
         evt.size = handle->dma.buf_size;
+        evt.frame_index = handle->dma.frame_cnt;
+        evt.timestamp = esp_timer_get_time();
+        handle->dma.frame_cnt += handle->dma.buf_frame_num;
         // Auto clear the dma buffer before data sent
         if (handle->dma.auto_clear_before_cb) {
             memset(curr_buf, 0, handle->dma.buf_size);
@@ -1162,6 +1176,7 @@ esp_err_t i2s_channel_enable(i2s_chan_handle_t handle)
 #if CONFIG_PM_ENABLE
     esp_pm_lock_acquire(handle->pm_lock);
 #endif
+    handle->dma.frame_cnt = 0;
     handle->start(handle);
     handle->state = I2S_CHAN_STATE_RUNNING;
     /* Reset queue */
@@ -1194,6 +1209,7 @@ esp_err_t i2s_channel_disable(i2s_chan_handle_t handle)
     /* Reset the descriptor pointer */
     handle->dma.curr_ptr = NULL;
     handle->dma.curr_desc = NULL;
+    handle->dma.acquired_buf = NULL;
     handle->dma.rw_pos = 0;
     handle->stop(handle);
 #if CONFIG_PM_ENABLE
@@ -1353,6 +1369,47 @@ esp_err_t i2s_channel_read(i2s_chan_handle_t handle, void *dest, size_t size, si
     return ret;
 }
 
+esp_err_t i2s_channel_acquire_dma_buf(i2s_chan_handle_t handle, void **dma_buf, size_t *size, uint32_t timeout_ms)
+{
+    I2S_NULL_POINTER_CHECK(TAG, handle);
+    ESP_RETURN_ON_FALSE(dma_buf && size, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    void *buf = NULL;
+    /* The binary semaphore is kept until the buffer is released, so that no reading / writing operation can interleave */
+    ESP_RETURN_ON_FALSE(xSemaphoreTake(handle->binary, pdMS_TO_TICKS(timeout_ms)) == pdTRUE, ESP_ERR_INVALID_STATE, TAG, "The channel is not enabled");
+    if (handle->state != I2S_CHAN_STATE_RUNNING) {
+        xSemaphoreGive(handle->binary);
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (xQueueReceive(handle->msg_queue, &buf, pdMS_TO_TICKS(timeout_ms)) == pdFALSE) {
+        xSemaphoreGive(handle->binary);
+        return ESP_ERR_TIMEOUT;
+    }
+    /* The whole buffer is handed over, the next reading / writing operation starts from a new buffer */
+    handle->dma.curr_ptr = buf;
+    handle->dma.rw_pos = handle->dma.buf_size;
+    handle->dma.acquired_buf = buf;
+    *dma_buf = buf;
+    *size = handle->dma.buf_size;
+    return ESP_OK;
+}
+
+esp_err_t i2s_channel_release_dma_buf(i2s_chan_handle_t handle, void *dma_buf)
+{
+    I2S_NULL_POINTER_CHECK(TAG, handle);
+    ESP_RETURN_ON_FALSE(dma_buf && dma_buf == handle->dma.acquired_buf, ESP_ERR_INVALID_ARG, TAG, "the buffer is not acquired");
+
+#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
+    /* The data written in place has to reach the memory before the DMA sends it */
+    if (handle->dir == I2S_DIR_TX) {
+        esp_cache_msync(dma_buf, handle->dma.buf_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+    }
+#endif
+    handle->dma.acquired_buf = NULL;
+    xSemaphoreGive(handle->binary);
+    return ESP_OK;
+}
+
 #if SOC_I2S_SUPPORTS_TX_SYNC_CNT
 uint32_t i2s_sync_get_bclk_count(i2s_chan_handle_t tx_handle)
 {
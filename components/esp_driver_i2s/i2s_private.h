@@ -116,11 +116,14 @@ typedef struct {
     uint32_t                desc_num;       /*!< I2S DMA buffer number, it is also the number of DMA descriptor */
     uint32_t                frame_num;      /*!< I2S frame number in one DMA buffer. One frame means one-time sample data in all slots */
     uint32_t                buf_size;       /*!< dma buffer size */
+    uint32_t                buf_frame_num;  /*!< Actual frame number in one DMA buffer, after the buffer size alignment */
+    uint64_t                frame_cnt;      /*!< Number of frames finished by the DMA since the channel was enabled */
     bool                    auto_clear_after_cb;     /*!< Set to auto clear DMA TX descriptor after callback, i2s will always send zero automatically if no data to send */
     bool                    auto_clear_before_cb;    /*!< Set to auto clear DMA TX descriptor before callback, i2s will always send zero automatically if no data to send */
     uint32_t                rw_pos;         /*!< reading/writing pointer position */
     void                    *curr_ptr;      /*!< Pointer to current dma buffer */
     void                    *curr_desc;     /*!< Pointer to current dma descriptor used for pre-load */
+    void                    *acquired_buf;  /*!< DMA buffer acquired by i2s_channel_acquire_dma_buf, NULL if none */
     lldesc_t                **desc;         /*!< dma descriptor array */
     uint8_t                 **bufs;         /*!< dma buffer array */
 } i2s_dma_t;
@@ -232,6 +232,39 @@ esp_err_t i2s_channel_write(i2s_chan_handle_t handle, const void *src, size_t si
  */
 esp_err_t i2s_channel_read(i2s_chan_handle_t handle, void *dest, size_t size, size_t *bytes_read, uint32_t timeout_ms);
 
+/**
+ * @brief Acquire the next DMA buffer of the channel, to process the data in place instead of copying it
+ * @note  Only allowed to be called when the channel state is RUNNING.
+ *        For RX channel, the acquired buffer contains the received data. For TX channel, the data written into
+ *        the acquired buffer is sent after calling `i2s_channel_release_dma_buf`.
+ * @note  The DMA keeps on moving along the circular DMA buffers, so the acquired buffer has to be released
+ *        before the DMA wraps around to it, i.e., within (`dma_desc_num` - 1) DMA buffer periods.
+ * @note  `i2s_channel_read`, `i2s_channel_write` and `i2s_channel_disable` are blocked until the buffer is released.
+ *        The cache synchronization of the buffer is done by the driver when it is needed.
+ *
+ * @param[in]   handle      I2S channel handler
+ * @param[out]  dma_buf     The acquired DMA buffer
+ * @param[out]  size        Size of the acquired DMA buffer, in bytes
+ * @param[in]   timeout_ms  Max block time
+ * @return
+ *      - ESP_OK    Acquire successfully
+ *      - ESP_ERR_INVALID_ARG   NULL pointer
+ *      - ESP_ERR_TIMEOUT       No DMA buffer finished by the DMA within timeout_ms
+ *      - ESP_ERR_INVALID_STATE The channel is not enabled
+ */
+esp_err_t i2s_channel_acquire_dma_buf(i2s_chan_handle_t handle, void **dma_buf, size_t *size, uint32_t timeout_ms);
+
+/**
+ * @brief Release the DMA buffer acquired by `i2s_channel_acquire_dma_buf`
+ *
+ * @param[in]   handle      I2S channel handler
+ * @param[in]   dma_buf     The DMA buffer returned by `i2s_channel_acquire_dma_buf`
+ * @return
+ *      - ESP_OK    Release successfully
+ *      - ESP_ERR_INVALID_ARG   NULL pointer or the buffer is not the acquired one
+ */
+esp_err_t i2s_channel_release_dma_buf(i2s_chan_handle_t handle, void *dma_buf);
+
 /**
  * @brief Set event callbacks for I2S channel
  *
@@ -85,6 +85,10 @@ typedef struct {
                                   *  also the buffer size that dropped when queue overflow.
                                   *  It is related to the dma_frame_num and data_bit_width, typically it is fixed when data_bit_width is not changed.
                                   */
+    uint64_t            frame_index; /**< Index of the first frame of the DMA buffer, counted since the channel was enabled.
+                                      *  The channels started by the same ETM event have the same index for the frames transported at the same time.
+                                      */
+    int64_t             timestamp;  /**< Time of the DMA EOF interrupt of the DMA buffer, in microseconds of `esp_timer_get_time` */
 } i2s_event_data_t;
 
 /**
@@ -632,6 +632,63 @@ TEST_CASE("I2S_loopback_test", "[i2s]")
     TEST_ESP_OK(i2s_del_channel(rx_handle));
 }
 
+TEST_CASE("I2S_zero_copy_loopback_test", "[i2s]")
+{
+    i2s_chan_handle_t tx_handle;
+    i2s_chan_handle_t rx_handle;
+
+    i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_0, I2S_ROLE_MASTER);
+    i2s_std_config_t std_cfg = {
+        .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(SAMPLE_RATE),
+        .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(SAMPLE_BITS, I2S_SLOT_MODE_STEREO),
+        .gpio_cfg = I2S_TEST_MASTER_DEFAULT_PIN,
+    };
+    TEST_ESP_OK(i2s_new_channel(&chan_cfg, &tx_handle, &rx_handle));
+    TEST_ESP_OK(i2s_channel_init_std_mode(tx_handle, &std_cfg));
+    TEST_ESP_OK(i2s_channel_init_std_mode(rx_handle, &std_cfg));
+    i2s_test_io_config(I2S_TEST_MODE_LOOPBACK);
+
+    void *buf = NULL;
+    size_t size = 0;
+    /* Not allowed before the channel is enabled */
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, i2s_channel_acquire_dma_buf(tx_handle, &buf, &size, 0));
+    TEST_ESP_OK(i2s_channel_enable(tx_handle));
+    TEST_ESP_OK(i2s_channel_enable(rx_handle));
+
+    /* Fill the TX DMA buffers in place */
+    for (int i = 0; i < chan_cfg.dma_desc_num; i++) {
+        TEST_ESP_OK(i2s_channel_acquire_dma_buf(tx_handle, &buf, &size, 1000));
+        TEST_ASSERT_GREATER_THAN(I2S_SEND_BUF_LEN, size);
+        memset(buf, 0, size);
+        for (int j = 0; j < I2S_SEND_BUF_LEN; j++) {
+            ((uint8_t *)buf)[j] = j + 1;
+        }
+        TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, i2s_channel_release_dma_buf(tx_handle, (uint8_t *)buf + 1));
+        TEST_ESP_OK(i2s_channel_release_dma_buf(tx_handle, buf));
+    }
+
+    /* Look for the data in the RX DMA buffers without copying them */
+    bool is_success = false;
+    for (int i = 0; i < 20 && !is_success; i++) {
+        TEST_ESP_OK(i2s_channel_acquire_dma_buf(rx_handle, &buf, &size, 1000));
+        const uint8_t *recv_buf = (const uint8_t *)buf;
+        for (int k = 0; k + I2S_SEND_BUF_LEN <= size && !is_success; k++) {
+            int j = 0;
+            while (j < I2S_SEND_BUF_LEN && recv_buf[k + j] == j + 1) {
+                j++;
+            }
+            is_success = (j == I2S_SEND_BUF_LEN);
+        }
+        TEST_ESP_OK(i2s_channel_release_dma_buf(rx_handle, buf));
+    }
+    TEST_ASSERT(is_success);
+
+    TEST_ESP_OK(i2s_channel_disable(tx_handle));
+    TEST_ESP_OK(i2s_channel_disable(rx_handle));
+    TEST_ESP_OK(i2s_del_channel(tx_handle));
+    TEST_ESP_OK(i2s_del_channel(rx_handle));
+}
+
 #if SOC_I2S_NUM > 1
 TEST_CASE("I2S_master_write_slave_read_test", "[i2s]")
 {
@@ -6,6 +6,8 @@
 
 #include <stdio.h>
 #include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "unity.h"
 #include "unity_test_utils.h"
 #include "esp_attr.h"
@@ -237,3 +239,104 @@ TEST_CASE("i2s_etm_task_test", "[etm]")
 
     s_i2s_deinit();
 }
+
+#if SOC_I2S_NUM > 1
+typedef struct {
+    uint32_t evt_cnt;
+    i2s_event_data_t first_evt;
+    i2s_event_data_t second_evt;
+} test_i2s_sync_evt_t;
+
+static IRAM_ATTR bool s_i2s_sync_on_recv(i2s_chan_handle_t handle, i2s_event_data_t *event, void *user_ctx)
+{
+    test_i2s_sync_evt_t *sync_evt = (test_i2s_sync_evt_t *)user_ctx;
+    if (sync_evt->evt_cnt == 0) {
+        sync_evt->first_evt = *event;
+    } else if (sync_evt->evt_cnt == 1) {
+        sync_evt->second_evt = *event;
+    }
+    sync_evt->evt_cnt++;
+    return false;
+}
+
+TEST_CASE("i2s_etm_sync_start_test", "[etm]")
+{
+    i2s_chan_handle_t rx_handle[2] = {};
+    test_i2s_sync_evt_t sync_evt[2] = {};
+    esp_etm_task_handle_t start_task[2] = {};
+    esp_etm_channel_handle_t etm_chan[2] = {};
+
+    /* GPIO init */
+    s_gpio_init();
+    gpio_etm_event_config_t gpio_event_cfg = {
+        .edge = GPIO_ETM_EVENT_EDGE_POS,
+    };
+    esp_etm_event_handle_t gpio_pos_event_handle;
+    TEST_ESP_OK(gpio_new_etm_event(&gpio_event_cfg, &gpio_pos_event_handle));
+    TEST_ESP_OK(gpio_etm_event_bind_gpio(gpio_pos_event_handle, TEST_GPIO_ETM_NUM));
+
+    /* Two I2S controllers, both started by the same GPIO ETM event */
+    i2s_std_config_t std_cfg = {
+        .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(48000),
+        .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(32, I2S_SLOT_MODE_STEREO),
+        .gpio_cfg = {
+            .mclk = I2S_GPIO_UNUSED,
+            .bclk = I2S_GPIO_UNUSED,
+            .ws = I2S_GPIO_UNUSED,
+            .dout = I2S_GPIO_UNUSED,
+            .din = I2S_GPIO_UNUSED,
+        },
+    };
+    i2s_event_callbacks_t cbs = {
+        .on_recv = s_i2s_sync_on_recv,
+    };
+    i2s_etm_task_config_t i2s_start_task_cfg = {
+        .task_type = I2S_ETM_TASK_START,
+    };
+    esp_etm_channel_config_t etm_config = {};
+    for (int i = 0; i < 2; i++) {
+        i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_0 + i, I2S_ROLE_MASTER);
+        chan_cfg.dma_desc_num = TEST_DESC_NUM;
+        chan_cfg.dma_frame_num = TEST_FRAME_NUM;
+        TEST_ESP_OK(i2s_new_channel(&chan_cfg, NULL, &rx_handle[i]));
+        TEST_ESP_OK(i2s_channel_init_std_mode(rx_handle[i], &std_cfg));
+        TEST_ESP_OK(i2s_channel_register_event_callback(rx_handle[i], &cbs, &sync_evt[i]));
+        TEST_ESP_OK(i2s_new_etm_task(rx_handle[i], &i2s_start_task_cfg, &start_task[i]));
+        TEST_ESP_OK(esp_etm_new_channel(&etm_config, &etm_chan[i]));
+        TEST_ESP_OK(esp_etm_channel_connect(etm_chan[i], gpio_pos_event_handle, start_task[i]));
+        TEST_ESP_OK(esp_etm_channel_enable(etm_chan[i]));
+    }
+
+    TEST_ESP_OK(i2s_channel_enable(rx_handle[0]));
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ESP_OK(i2s_channel_enable(rx_handle[1]));
+    vTaskDelay(pdMS_TO_TICKS(20));
+    // Not started until the ETM event
+    TEST_ASSERT_EQUAL(0, sync_evt[0].evt_cnt);
+    TEST_ASSERT_EQUAL(0, sync_evt[1].evt_cnt);
+    TEST_ESP_OK(gpio_set_level(TEST_GPIO_ETM_NUM, 1));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ESP_OK(i2s_channel_disable(rx_handle[0]));
+    TEST_ESP_OK(i2s_channel_disable(rx_handle[1]));
+
+    for (int i = 0; i < 2; i++) {
+        printf("I2S%d: evt %"PRIu32", first buffer at %"PRId64" us, second buffer at %"PRId64" us\n", i,
+               sync_evt[i].evt_cnt, sync_evt[i].first_evt.timestamp, sync_evt[i].second_evt.timestamp);
+        TEST_ASSERT_GREATER_OR_EQUAL(2, sync_evt[i].evt_cnt);
+        TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)sync_evt[i].first_evt.frame_index);
+        TEST_ASSERT_EQUAL_UINT32(TEST_FRAME_NUM, (uint32_t)sync_evt[i].second_evt.frame_index);
+    }
+    // The buffers of the same index are finished at the same time, only the interrupt latency differs
+    int64_t skew = sync_evt[0].first_evt.timestamp - sync_evt[1].first_evt.timestamp;
+    TEST_ASSERT_LESS_THAN(100, skew < 0 ? -skew : skew);
+
+    /* Test finished, free the resources */
+    for (int i = 0; i < 2; i++) {
+        TEST_ESP_OK(esp_etm_channel_disable(etm_chan[i]));
+        TEST_ESP_OK(esp_etm_del_task(start_task[i]));
+        TEST_ESP_OK(esp_etm_del_channel(etm_chan[i]));
+        TEST_ESP_OK(i2s_del_channel(rx_handle[i]));
+    }
+    TEST_ESP_OK(esp_etm_del_event(gpio_pos_event_handle));
+}
+#endif  // SOC_I2S_NUM > 1
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "esp_err.h"
 #include "jpeg_types.h"
 #include "hal/jpeg_types.h"
@@ -48,6 +49,49 @@ typedef struct {
     jpeg_dec_buffer_alloc_direction_t buffer_direction;  /*!< Buffer direction for jpeg decoder memory allocation */
 } jpeg_decode_memory_alloc_cfg_t;
 
+/**
+ * @brief Type of JPEG decode stream handle
+ */
+typedef struct jpeg_decode_stream_t *jpeg_decode_stream_handle_t;
+
+/**
+ * @brief Information about a decoded stripe of a picture
+ */
+typedef struct {
+    uint8_t *buffer;         /*!< Output buffer holding the decoded stripe, one of the buffers given in `jpeg_decode_stream_cfg_t` */
+    uint32_t out_size;       /*!< Length of the decoded data in the buffer */
+    uint32_t y;              /*!< Vertical position of the first pixel row of the stripe in the picture */
+    uint32_t height;         /*!< Number of pixel rows of the stripe in the picture */
+    bool last;               /*!< Whether this is the last stripe of the picture */
+} jpeg_decode_stripe_t;
+
+/**
+ * @brief Callback invoked when a stripe of a streamed picture is decoded
+ *
+ * @note The callback is invoked in the task that calls `jpeg_decoder_stream_feed`. The buffer of the stripe
+ *       is reused after the other output buffers of the ring have been used once.
+ *
+ * @param[in] stream Handle of the decode stream
+ * @param[in] stripe Information about the decoded stripe
+ * @param[in] user_data User data given in `jpeg_decode_stream_cfg_t`
+ */
+typedef void (*jpeg_decode_stripe_cb_t)(jpeg_decode_stream_handle_t stream, const jpeg_decode_stripe_t *stripe, void *user_data);
+
+/**
+ * @brief Configuration parameters for a JPEG decode stream
+ */
+typedef struct {
+    jpeg_decode_cfg_t decode_cfg;         /*!< Output configuration of the decoded stripes */
+    uint32_t stripe_mcu_rows;             /*!< Number of MCU rows per stripe, the picture must contain restart markers (DRI) so that it can be cut into stripes.
+                                               Set to 0, or stream a picture without restart markers, to decode the whole picture as one stripe */
+    uint8_t *const *stripe_bufs;          /*!< Ring of output buffers for the stripes, allocated by `jpeg_alloc_decoder_mem` */
+    uint32_t num_stripe_bufs;             /*!< Number of buffers in `stripe_bufs` */
+    uint32_t stripe_buf_size;             /*!< Size of each buffer in `stripe_bufs` */
+    uint32_t max_stripe_input_size;       /*!< Maximum size of a compressed stripe, including the JPEG header of the picture */
+    jpeg_decode_stripe_cb_t on_stripe_done; /*!< Callback invoked when a stripe is decoded */
+    void *user_data;                      /*!< User data passed to `on_stripe_done` */
+} jpeg_decode_stream_cfg_t;
+
 /**
  * @brief Acquire a JPEG decode engine with the specified configuration.
  *
@@ -120,6 +164,55 @@ esp_err_t jpeg_decoder_process(jpeg_decoder_handle_t decoder_engine, const jpeg_
  */
 esp_err_t jpeg_del_decoder_engine(jpeg_decoder_handle_t decoder_engine);
 
+/**
+ * @brief Create a stream that decodes pictures fed in chunks, e.g. read from flash or received from network
+ *
+ * The compressed data is collected until a stripe of `stripe_mcu_rows` MCU rows is complete, which is recognized
+ * by the restart markers of the picture. The stripe is then decoded into the next buffer of the output ring and
+ * `on_stripe_done` is invoked. Neither the whole compressed picture nor the whole decoded picture needs to be held in memory.
+ * After the end of a picture, the stream is ready for the next picture, e.g. the next frame of an MJPEG stream.
+ *
+ * @param[in] decoder_engine Handle of the JPEG decoder instance that decodes the stripes.
+ * @param[in] stream_cfg Config structure of the stream.
+ * @param[out] ret_stream Pointer to a variable that will receive the stream handle.
+ * @return
+ *      - ESP_OK: Create JPEG decode stream successfully.
+ *      - ESP_ERR_INVALID_ARG: Create JPEG decode stream failed because of invalid argument.
+ *      - ESP_ERR_NO_MEM: Create JPEG decode stream failed because of out of memory.
+ */
+esp_err_t jpeg_decoder_new_stream(jpeg_decoder_handle_t decoder_engine, const jpeg_decode_stream_cfg_t *stream_cfg, jpeg_decode_stream_handle_t *ret_stream);
+
+/**
+ * @brief Feed a chunk of compressed data to a JPEG decode stream
+ *
+ * The stripes completed by the chunk are decoded before this function returns. A chunk can end at any byte of the picture.
+ *
+ * @note If an error is returned, the rest of the current picture is dropped, and the stream waits for the next picture.
+ *
+ * @param[in] stream Handle of the decode stream.
+ * @param[in] data Pointer to the chunk of compressed data.
+ * @param[in] size Size of the chunk in bytes.
+ * @return
+ *      - ESP_OK: Feed data successfully.
+ *      - ESP_ERR_INVALID_ARG: Feed data failed because of invalid argument, or the data is not a valid JPEG stream.
+ *      - ESP_ERR_INVALID_SIZE: A compressed stripe exceeds `max_stripe_input_size`.
+ *      - ESP_ERR_NOT_SUPPORTED: The picture can't be cut into stripes of `stripe_mcu_rows` MCU rows by its restart interval,
+ *                               or its coding process is not supported by the decoder.
+ */
+esp_err_t jpeg_decoder_stream_feed(jpeg_decode_stream_handle_t stream, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Delete a JPEG decode stream
+ *
+ * The unfinished picture of the stream, if any, is dropped. The output buffers are not freed.
+ *
+ * @param[in] stream Handle of the decode stream.
+ * @return
+ *      - ESP_OK: Delete JPEG decode stream successfully.
+ *      - ESP_ERR_INVALID_ARG: Delete JPEG decode stream failed because of invalid argument.
+ */
+esp_err_t jpeg_decoder_del_stream(jpeg_decode_stream_handle_t stream);
+
 /**
  * @brief A helper function to allocate memory space for JPEG decoder.
  *
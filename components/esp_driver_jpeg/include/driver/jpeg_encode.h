@@ -7,6 +7,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "esp_err.h"
 #include "jpeg_types.h"
 #include "hal/jpeg_types.h"
@@ -88,6 +89,121 @@ esp_err_t jpeg_encoder_process(jpeg_encoder_handle_t encoder_engine, const jpeg_
  */
 esp_err_t jpeg_del_encoder_engine(jpeg_encoder_handle_t encoder_engine);
 
+/**
+ * @brief Type of MJPEG encoder handle
+ */
+typedef struct jpeg_mjpeg_encoder_t *jpeg_mjpeg_encoder_handle_t;
+
+/**
+ * @brief Encoded frame of a MJPEG encoder
+ */
+typedef struct {
+    uint8_t *jpeg_buf;          /*!< Buffer holding the JPEG picture, owned by the MJPEG encoder */
+    uint32_t jpeg_size;         /*!< Size of the JPEG picture in bytes */
+    uint32_t quality;           /*!< Quality the frame is encoded with */
+} jpeg_mjpeg_frame_t;
+
+/**
+ * @brief Callback invoked when the MJPEG encoder no longer needs a raw frame
+ *
+ * @note The callback is invoked in the task of the MJPEG encoder, the raw frame can be given back to the camera in it.
+ *
+ * @param[in] mjpeg_encoder Handle of the MJPEG encoder
+ * @param[in] raw_buf Raw frame pushed by `jpeg_mjpeg_encoder_push_raw`
+ * @param[in] dropped Whether the frame is dropped without being encoded, because no JPEG buffer is free
+ * @param[in] user_data User data given in `jpeg_mjpeg_encoder_config_t`
+ */
+typedef void (*jpeg_mjpeg_raw_done_cb_t)(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, const uint8_t *raw_buf, bool dropped, void *user_data);
+
+/**
+ * @brief MJPEG encoder configuration
+ */
+typedef struct {
+    jpeg_encode_cfg_t encode_cfg;           /*!< Encode configuration of the frames, `image_quality` is the quality of the first frame */
+    uint32_t target_frame_size;             /*!< Target size of an encoded frame in bytes, i.e. target bitrate / 8 / frame rate.
+                                                 The quality is adjusted per frame to approach it. Set to 0 to encode with a fixed quality */
+    uint32_t min_quality;                   /*!< Lowest quality the rate control may select, 1 if set to 0 */
+    uint32_t max_quality;                   /*!< Highest quality the rate control may select, 100 if set to 0 */
+    uint32_t raw_queue_depth;               /*!< Number of raw frames that can be pending for encoding */
+    uint32_t num_jpeg_bufs;                 /*!< Number of JPEG buffers, i.e. encoded frames that can be held by the user at the same time plus one */
+    uint32_t jpeg_buf_size;                 /*!< Size of each JPEG buffer */
+    uint32_t task_priority;                 /*!< Priority of the encoding task */
+    jpeg_mjpeg_raw_done_cb_t on_raw_done;   /*!< Callback invoked when a raw frame is encoded or dropped */
+    void *user_data;                        /*!< User data passed to `on_raw_done` */
+} jpeg_mjpeg_encoder_config_t;
+
+/**
+ * @brief Create a MJPEG encoder which encodes raw frames back-to-back, e.g. frames captured by a camera controller
+ *
+ * The raw frames are encoded from the pushed buffers directly, without being copied. Each encoded frame is put into
+ * one of the JPEG buffers owned by the MJPEG encoder, and can be fetched by `jpeg_mjpeg_encoder_get_frame`.
+ *
+ * @param[in] encoder_engine Handle of the JPEG encoder instance that encodes the frames.
+ * @param[in] config MJPEG encoder configuration.
+ * @param[out] ret_mjpeg_encoder Pointer to a variable that will receive the MJPEG encoder handle.
+ * @return
+ *      - ESP_OK: Create MJPEG encoder successfully.
+ *      - ESP_ERR_INVALID_ARG: Create MJPEG encoder failed because of invalid argument.
+ *      - ESP_ERR_NO_MEM: Create MJPEG encoder failed because of out of memory.
+ */
+esp_err_t jpeg_new_mjpeg_encoder(jpeg_encoder_handle_t encoder_engine, const jpeg_mjpeg_encoder_config_t *config, jpeg_mjpeg_encoder_handle_t *ret_mjpeg_encoder);
+
+/**
+ * @brief Push a raw frame to a MJPEG encoder
+ *
+ * @note This function can be called in ISR context, e.g. in the `on_trans_finished` callback of a camera controller.
+ *       The raw frame must not be modified until `on_raw_done` is invoked for it.
+ *
+ * @param[in] mjpeg_encoder Handle of the MJPEG encoder.
+ * @param[in] raw_buf Raw frame in the format of `encode_cfg`.
+ * @param[in] raw_size Size of the raw frame in bytes.
+ * @return
+ *      - ESP_OK: Push raw frame successfully.
+ *      - ESP_ERR_INVALID_ARG: Push raw frame failed because of invalid argument.
+ *      - ESP_ERR_INVALID_STATE: Push raw frame failed because the raw frame queue is full.
+ */
+esp_err_t jpeg_mjpeg_encoder_push_raw(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, const uint8_t *raw_buf, uint32_t raw_size);
+
+/**
+ * @brief Get an encoded frame from a MJPEG encoder
+ *
+ * The frames are got in the order of the pushed raw frames. The JPEG buffer of the frame must be given back by
+ * `jpeg_mjpeg_encoder_return_frame`, e.g. after it's sent out.
+ *
+ * @param[in] mjpeg_encoder Handle of the MJPEG encoder.
+ * @param[out] frame Encoded frame.
+ * @param[in] timeout_ms Time to wait for an encoded frame in ms, -1 means wait forever.
+ * @return
+ *      - ESP_OK: Get encoded frame successfully.
+ *      - ESP_ERR_INVALID_ARG: Get encoded frame failed because of invalid argument.
+ *      - ESP_ERR_TIMEOUT: No encoded frame within the timeout.
+ */
+esp_err_t jpeg_mjpeg_encoder_get_frame(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, jpeg_mjpeg_frame_t *frame, int timeout_ms);
+
+/**
+ * @brief Give the JPEG buffer of an encoded frame back to a MJPEG encoder
+ *
+ * @param[in] mjpeg_encoder Handle of the MJPEG encoder.
+ * @param[in] frame Encoded frame got by `jpeg_mjpeg_encoder_get_frame`.
+ * @return
+ *      - ESP_OK: Return encoded frame successfully.
+ *      - ESP_ERR_INVALID_ARG: Return encoded frame failed because of invalid argument.
+ */
+esp_err_t jpeg_mjpeg_encoder_return_frame(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, const jpeg_mjpeg_frame_t *frame);
+
+/**
+ * @brief Delete a MJPEG encoder
+ *
+ * The pending raw frames are dropped, with `on_raw_done` invoked for them in the calling task. The JPEG buffers are freed,
+ * including the ones of the frames not returned yet.
+ *
+ * @param[in] mjpeg_encoder Handle of the MJPEG encoder.
+ * @return
+ *      - ESP_OK: Delete MJPEG encoder successfully.
+ *      - ESP_ERR_INVALID_ARG: Delete MJPEG encoder failed because of invalid argument.
+ */
+esp_err_t jpeg_del_mjpeg_encoder(jpeg_mjpeg_encoder_handle_t mjpeg_encoder);
+
 /**
  * @brief A helper function to allocate memory space for JPEG encoder.
  *
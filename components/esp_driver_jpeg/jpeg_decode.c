@@ -230,6 +230,7 @@ esp_err_t jpeg_decoder_process(jpeg_decoder_handle_t decoder_engine, const jpeg_
         .channel_flags = DMA2D_CHANNEL_FUNCTION_FLAG_RX_REORDER,
         .user_config = decoder_engine,
         .on_job_picked = jpeg_dec_transaction_on_picked,
+        .client = DMA2D_CLIENT_JPEG,
     };
 
     // Before 2DDMA starts. sync buffer from cache to psram
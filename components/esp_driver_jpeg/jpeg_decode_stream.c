@@ -0,0 +1,326 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_err.h"
+#include "driver/jpeg_decode.h"
+#include "esp_heap_caps.h"
+#include "hal/jpeg_defs.h"
+#if CONFIG_JPEG_ENABLE_DEBUG_LOG
+// The local log level must be defined before including esp_log.h
+// Set the maximum log level for this source file
+#define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
+#endif
+#include "esp_log.h"
+#include "esp_check.h"
+
+static const char *TAG = "jpeg.decode_stream";
+
+/*
+ * A stripe is decoded as a picture of its own: the header of the picture with the height in SOF patched to the
+ * height of the stripe, followed by the entropy coded data of the stripe and EOI. The restart marker that ends a
+ * stripe is dropped, and the restart markers inside a stripe are renumbered from RST0.
+ */
+struct jpeg_decode_stream_t {
+    jpeg_decoder_handle_t decoder_engine;   // Decoder engine that decodes the stripes
+    jpeg_decode_stream_cfg_t cfg;           // Stream configuration, `stripe_bufs` points to the copy below
+    uint8_t **stripe_bufs;                  // Copy of the output buffer ring
+    uint8_t *in_buf;                        // Compressed data of the current stripe, starting with the header
+    uint32_t in_len;                        // Length of the data in in_buf
+    uint32_t header_len;                    // Length of the header in in_buf, 0 while the header is incomplete
+    uint32_t sof_height_offset;             // Offset of the height field of SOF in in_buf
+    uint32_t height;                        // Height of the picture
+    uint32_t mcu_h;                         // Height of an MCU
+    uint32_t rst_per_stripe;                // Number of restart intervals per stripe, 0 for one stripe per picture
+    uint32_t rst_cnt;                       // Number of restart markers seen in the current stripe
+    uint32_t next_y;                        // Vertical position of the current stripe
+    uint32_t buf_idx;                       // Index of the output buffer for the current stripe
+    bool prev_ff;                           // The previous byte of the entropy coded data is 0xFF
+    bool skip_picture;                      // Drop the data until the end of the current picture
+};
+
+static inline uint16_t jpeg_stream_get_u16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+static void jpeg_stream_reset_picture(jpeg_decode_stream_handle_t stream)
+{
+    stream->in_len = 0;
+    stream->header_len = 0;
+    stream->rst_cnt = 0;
+    stream->next_y = 0;
+    stream->prev_ff = false;
+}
+
+// Parse the collected header, return ESP_ERR_NOT_FINISHED if more data is needed
+static esp_err_t jpeg_stream_parse_header(jpeg_decode_stream_handle_t stream)
+{
+    const uint8_t *buf = stream->in_buf;
+    uint32_t len = stream->in_len;
+    uint32_t mcu_w = 0;
+    uint32_t width = 0;
+    uint16_t ri = 0;
+
+    if (len < 2) {
+        return ESP_ERR_NOT_FINISHED;
+    }
+    ESP_RETURN_ON_FALSE(jpeg_stream_get_u16(buf) == JPEG_M_SOI, ESP_ERR_INVALID_ARG, TAG, "picture doesn't start with SOI");
+
+    uint32_t pos = 2;
+    while (true) {
+        // Skip fill bytes before the marker
+        while (pos + 1 < len && buf[pos] == 0xFF && buf[pos + 1] == 0xFF) {
+            pos++;
+        }
+        if (pos + 4 > len) {
+            return ESP_ERR_NOT_FINISHED;
+        }
+        ESP_RETURN_ON_FALSE(buf[pos] == 0xFF, ESP_ERR_INVALID_ARG, TAG, "marker expected at offset %" PRIu32, pos);
+        uint16_t marker = jpeg_stream_get_u16(&buf[pos]);
+        uint32_t seg_len = jpeg_stream_get_u16(&buf[pos + 2]);
+        if (pos + 2 + seg_len > len) {
+            return ESP_ERR_NOT_FINISHED;
+        }
+        switch (marker) {
+        case JPEG_M_SOF0: {
+            ESP_RETURN_ON_FALSE(seg_len >= 11, ESP_ERR_INVALID_ARG, TAG, "invalid SOF0 marker");
+            uint8_t num_comp = buf[pos + 9];
+            uint8_t sampling = buf[pos + 11];
+            stream->sof_height_offset = pos + 5;
+            stream->height = jpeg_stream_get_u16(&buf[pos + 5]);
+            width = jpeg_stream_get_u16(&buf[pos + 7]);
+            mcu_w = (num_comp == 1) ? 8 : 8 * (sampling >> 4);
+            stream->mcu_h = (num_comp == 1) ? 8 : 8 * (sampling & 0x0F);
+            ESP_RETURN_ON_FALSE(stream->height && width && mcu_w && stream->mcu_h, ESP_ERR_INVALID_ARG, TAG, "invalid SOF0 marker");
+            break;
+        }
+        case JPEG_M_SOF1:
+        case JPEG_M_SOF2:
+        case JPEG_M_SOF3:
+        case JPEG_M_SOF5:
+        case JPEG_M_SOF6:
+        case JPEG_M_SOF7:
+        case JPEG_M_SOF9:
+        case JPEG_M_SOF10:
+        case JPEG_M_SOF11:
+        case JPEG_M_SOF13:
+        case JPEG_M_SOF14:
+        case JPEG_M_SOF15:
+            ESP_LOGE(TAG, "only baseline picture can be streamed, SOF marker 0x%" PRIx16, marker);
+            return ESP_ERR_NOT_SUPPORTED;
+        case JPEG_M_DRI:
+            ESP_RETURN_ON_FALSE(seg_len >= 4, ESP_ERR_INVALID_ARG, TAG, "invalid DRI marker");
+            ri = jpeg_stream_get_u16(&buf[pos + 4]);
+            break;
+        default:
+            break;
+        }
+        pos += 2 + seg_len;
+        if (marker == JPEG_M_SOS) {
+            break;
+        }
+    }
+    ESP_RETURN_ON_FALSE(stream->sof_height_offset, ESP_ERR_INVALID_ARG, TAG, "SOF marker not found before SOS");
+
+    stream->rst_per_stripe = 0;
+    if (stream->cfg.stripe_mcu_rows && ri) {
+        uint32_t mcus_per_stripe = ((width + mcu_w - 1) / mcu_w) * stream->cfg.stripe_mcu_rows;
+        ESP_RETURN_ON_FALSE(mcus_per_stripe % ri == 0, ESP_ERR_NOT_SUPPORTED, TAG,
+                            "stripe of %" PRIu32 " MCUs is not a multiple of restart interval %" PRIu16, mcus_per_stripe, ri);
+        stream->rst_per_stripe = mcus_per_stripe / ri;
+    }
+    stream->header_len = pos;
+    ESP_LOGD(TAG, "header %" PRIu32 " bytes, %" PRIu32 "x%" PRIu32 ", %" PRIu32 " restart intervals per stripe",
+             stream->header_len, width, stream->height, stream->rst_per_stripe);
+    return ESP_OK;
+}
+
+static esp_err_t jpeg_stream_decode_stripe(jpeg_decode_stream_handle_t stream, bool last)
+{
+    uint32_t stripe_h = stream->height - stream->next_y;
+    if (!last) {
+        stripe_h = stream->cfg.stripe_mcu_rows * stream->mcu_h;
+        ESP_RETURN_ON_FALSE(stream->next_y + stripe_h < stream->height, ESP_ERR_INVALID_ARG, TAG, "more stripes than the picture height");
+    }
+
+    stream->in_buf[stream->sof_height_offset] = stripe_h >> 8;
+    stream->in_buf[stream->sof_height_offset + 1] = stripe_h & 0xFF;
+    stream->in_buf[stream->in_len++] = JPEG_M_EOI >> 8;
+    stream->in_buf[stream->in_len++] = JPEG_M_EOI & 0xFF;
+
+    jpeg_decode_stripe_t stripe = {
+        .buffer = stream->stripe_bufs[stream->buf_idx],
+        .y = stream->next_y,
+        .height = stripe_h,
+        .last = last,
+    };
+    ESP_RETURN_ON_ERROR(jpeg_decoder_process(stream->decoder_engine, &stream->cfg.decode_cfg, stream->in_buf, stream->in_len,
+                                             stripe.buffer, stream->cfg.stripe_buf_size, &stripe.out_size), TAG, "decode stripe failed");
+    if (stream->cfg.on_stripe_done) {
+        stream->cfg.on_stripe_done(stream, &stripe, stream->cfg.user_data);
+    }
+
+    stream->buf_idx = (stream->buf_idx + 1) % stream->cfg.num_stripe_bufs;
+    stream->next_y += stripe_h;
+    stream->in_len = stream->header_len;
+    stream->rst_cnt = 0;
+    return ESP_OK;
+}
+
+// Append entropy coded data to the current stripe, keep 2 bytes for EOI
+static inline esp_err_t jpeg_stream_append(jpeg_decode_stream_handle_t stream, uint8_t b0, uint8_t b1, uint32_t num)
+{
+    ESP_RETURN_ON_FALSE(stream->in_len + num + 2 <= stream->cfg.max_stripe_input_size, ESP_ERR_INVALID_SIZE, TAG,
+                        "compressed stripe exceeds %" PRIu32 " bytes", stream->cfg.max_stripe_input_size);
+    stream->in_buf[stream->in_len++] = b0;
+    if (num > 1) {
+        stream->in_buf[stream->in_len++] = b1;
+    }
+    return ESP_OK;
+}
+
+// Drop the data until EOI, return the number of bytes dropped
+static uint32_t jpeg_stream_skip_picture(jpeg_decode_stream_handle_t stream, const uint8_t *data, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++) {
+        if (stream->prev_ff && data[i] == (JPEG_M_EOI & 0xFF)) {
+            stream->skip_picture = false;
+            stream->prev_ff = false;
+            return i + 1;
+        }
+        stream->prev_ff = (data[i] == 0xFF);
+    }
+    return size;
+}
+
+static esp_err_t jpeg_stream_feed_scan(jpeg_decode_stream_handle_t stream, const uint8_t *data, uint32_t size, uint32_t *consumed)
+{
+    uint32_t i = 0;
+    for (; i < size; i++) {
+        uint8_t b = data[i];
+        if (!stream->prev_ff) {
+            if (b == 0xFF) {
+                stream->prev_ff = true;
+            } else {
+                ESP_RETURN_ON_ERROR(jpeg_stream_append(stream, b, 0, 1), TAG, "append data failed");
+            }
+            continue;
+        }
+        if (b == 0xFF) {
+            continue; // fill byte
+        }
+        stream->prev_ff = false;
+        if (b >= (JPEG_M_RST0 & 0xFF) && b <= (JPEG_M_RST7 & 0xFF)) {
+            stream->rst_cnt++;
+            if (stream->rst_cnt == stream->rst_per_stripe) {
+                ESP_RETURN_ON_ERROR(jpeg_stream_decode_stripe(stream, false), TAG, "decode stripe failed");
+            } else {
+                uint8_t rst = (JPEG_M_RST0 & 0xFF) + ((stream->rst_cnt - 1) & 0x07);
+                ESP_RETURN_ON_ERROR(jpeg_stream_append(stream, 0xFF, rst, 2), TAG, "append data failed");
+            }
+        } else if (b == (JPEG_M_EOI & 0xFF)) {
+            ESP_RETURN_ON_ERROR(jpeg_stream_decode_stripe(stream, true), TAG, "decode stripe failed");
+            jpeg_stream_reset_picture(stream);
+            i++;
+            break;
+        } else {
+            ESP_RETURN_ON_ERROR(jpeg_stream_append(stream, 0xFF, b, 2), TAG, "append data failed");
+        }
+    }
+    *consumed = i;
+    return ESP_OK;
+}
+
+esp_err_t jpeg_decoder_new_stream(jpeg_decoder_handle_t decoder_engine, const jpeg_decode_stream_cfg_t *stream_cfg, jpeg_decode_stream_handle_t *ret_stream)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(decoder_engine && stream_cfg && ret_stream, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(stream_cfg->stripe_bufs && stream_cfg->num_stripe_bufs && stream_cfg->stripe_buf_size,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid output buffers");
+    ESP_RETURN_ON_FALSE(stream_cfg->max_stripe_input_size > 2, ESP_ERR_INVALID_ARG, TAG, "invalid max_stripe_input_size");
+    for (uint32_t i = 0; i < stream_cfg->num_stripe_bufs; i++) {
+        ESP_RETURN_ON_FALSE(stream_cfg->stripe_bufs[i], ESP_ERR_INVALID_ARG, TAG, "invalid output buffer %" PRIu32, i);
+    }
+
+    jpeg_decode_stream_handle_t stream = (jpeg_decode_stream_handle_t)heap_caps_calloc(1, sizeof(struct jpeg_decode_stream_t), MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(stream, ESP_ERR_NO_MEM, TAG, "no memory for jpeg decode stream");
+    stream->stripe_bufs = (uint8_t **)heap_caps_calloc(stream_cfg->num_stripe_bufs, sizeof(uint8_t *), MALLOC_CAP_8BIT);
+    ESP_GOTO_ON_FALSE(stream->stripe_bufs, ESP_ERR_NO_MEM, err, TAG, "no memory for output buffer ring");
+    memcpy(stream->stripe_bufs, stream_cfg->stripe_bufs, stream_cfg->num_stripe_bufs * sizeof(uint8_t *));
+
+    jpeg_decode_memory_alloc_cfg_t mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_INPUT_BUFFER,
+    };
+    size_t allocated_size = 0;
+    stream->in_buf = (uint8_t *)jpeg_alloc_decoder_mem(stream_cfg->max_stripe_input_size, &mem_cfg, &allocated_size);
+    ESP_GOTO_ON_FALSE(stream->in_buf, ESP_ERR_NO_MEM, err, TAG, "no memory for stripe input buffer");
+
+    stream->decoder_engine = decoder_engine;
+    stream->cfg = *stream_cfg;
+    stream->cfg.stripe_bufs = stream->stripe_bufs;
+    jpeg_stream_reset_picture(stream);
+    *ret_stream = stream;
+    return ESP_OK;
+
+err:
+    free(stream->stripe_bufs);
+    free(stream);
+    return ret;
+}
+
+esp_err_t jpeg_decoder_stream_feed(jpeg_decode_stream_handle_t stream, const uint8_t *data, uint32_t size)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(stream && (data || size == 0), ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    while (size) {
+        uint32_t consumed = 0;
+        if (stream->skip_picture) {
+            consumed = jpeg_stream_skip_picture(stream, data, size);
+        } else if (stream->header_len == 0) {
+            // Collect the header, the part of the chunk after the header is scanned as entropy coded data
+            uint32_t header_copy_len = stream->in_len;
+            consumed = stream->cfg.max_stripe_input_size - stream->in_len;
+            consumed = (consumed < size) ? consumed : size;
+            memcpy(stream->in_buf + stream->in_len, data, consumed);
+            stream->in_len += consumed;
+            stream->sof_height_offset = 0;
+            ret = jpeg_stream_parse_header(stream);
+            if (ret == ESP_ERR_NOT_FINISHED) {
+                ESP_GOTO_ON_FALSE(stream->in_len < stream->cfg.max_stripe_input_size, ESP_ERR_INVALID_SIZE, err, TAG,
+                                  "header exceeds %" PRIu32 " bytes", stream->cfg.max_stripe_input_size);
+                ret = ESP_OK;
+            } else {
+                ESP_GOTO_ON_ERROR(ret, err, TAG, "parse header failed");
+                consumed = stream->header_len - header_copy_len;
+                stream->in_len = stream->header_len;
+            }
+        } else {
+            ESP_GOTO_ON_ERROR(jpeg_stream_feed_scan(stream, data, size, &consumed), err, TAG, "scan data failed");
+        }
+        data += consumed;
+        size -= consumed;
+    }
+    return ESP_OK;
+
+err:
+    // Drop the rest of the picture, the data fed later is skipped until the end of the picture
+    jpeg_stream_reset_picture(stream);
+    stream->skip_picture = true;
+    return ret;
+}
+
+esp_err_t jpeg_decoder_del_stream(jpeg_decode_stream_handle_t stream)
+{
+    ESP_RETURN_ON_FALSE(stream, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(stream->in_buf);
+    free(stream->stripe_bufs);
+    free(stream);
+    return ESP_OK;
+}
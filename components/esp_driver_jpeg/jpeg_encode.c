@@ -246,6 +246,7 @@ esp_err_t jpeg_encoder_process(jpeg_encoder_handle_t encoder_engine, const jpeg_
         .channel_flags = DMA2D_CHANNEL_FUNCTION_FLAG_TX_REORDER,
         .user_config = encoder_engine,
         .on_job_picked = s_jpeg_enc_transaction_on_job_picked,
+        .client = DMA2D_CLIENT_JPEG,
     };
 
     ESP_GOTO_ON_ERROR(dma2d_enqueue(encoder_engine->dma2d_group_handle, &trans_desc, encoder_engine->trans_desc), err2, TAG, "DMA2D enqueue failed");
@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/idf_additions.h"
+#if CONFIG_JPEG_ENABLE_DEBUG_LOG
+// The local log level must be defined before including esp_log.h
+// Set the maximum log level for this source file
+#define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
+#endif
+#include "esp_log.h"
+#include "esp_check.h"
+#include "jpeg_private.h"
+#include "driver/jpeg_encode.h"
+
+static const char *TAG = "jpeg.mjpeg";
+
+#define JPEG_MJPEG_TASK_STACK_SIZE      4096
+#define JPEG_MJPEG_QUALITY_DEAD_BAND    10      // Frame size error in percent tolerated by the rate control
+#define JPEG_MJPEG_QUALITY_MAX_STEP     10      // Maximum quality change between two frames
+
+typedef struct {
+    const uint8_t *buf;     // NULL asks the encoding task to exit
+    uint32_t size;
+} jpeg_mjpeg_raw_t;
+
+struct jpeg_mjpeg_encoder_t {
+    jpeg_encoder_handle_t encoder_engine;   // JPEG encoder engine that encodes the frames
+    jpeg_mjpeg_encoder_config_t config;     // MJPEG encoder configuration
+    uint32_t quality;                       // Quality of the next frame
+    uint8_t **jpeg_bufs;                    // JPEG buffers
+    QueueHandle_t raw_queue;                // Queue of the raw frames to encode
+    QueueHandle_t free_queue;               // Queue of the free JPEG buffers
+    QueueHandle_t frame_queue;              // Queue of the encoded frames
+    TaskHandle_t task;                      // Encoding task
+    SemaphoreHandle_t exit_sem;             // Given by the encoding task when it exits
+};
+
+// Adjust the quality of the next frame by the size of the current one
+static void jpeg_mjpeg_update_quality(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, uint32_t frame_size)
+{
+    uint32_t target = mjpeg_encoder->config.target_frame_size;
+    if (target == 0) {
+        return;
+    }
+    // The size of a JPEG picture rises roughly linearly with the quality in the useful range, so step the quality
+    // proportionally to the relative size error, and keep it if the error is small to avoid oscillation
+    int32_t err_percent = (int32_t)(((int64_t)frame_size - target) * 100 / target);
+    if (err_percent > -JPEG_MJPEG_QUALITY_DEAD_BAND && err_percent < JPEG_MJPEG_QUALITY_DEAD_BAND) {
+        return;
+    }
+    int32_t step = err_percent / JPEG_MJPEG_QUALITY_DEAD_BAND;
+    step = (step > JPEG_MJPEG_QUALITY_MAX_STEP) ? JPEG_MJPEG_QUALITY_MAX_STEP : step;
+    step = (step < -JPEG_MJPEG_QUALITY_MAX_STEP) ? -JPEG_MJPEG_QUALITY_MAX_STEP : step;
+    int32_t quality = (int32_t)mjpeg_encoder->quality - step;
+    quality = (quality < (int32_t)mjpeg_encoder->config.min_quality) ? (int32_t)mjpeg_encoder->config.min_quality : quality;
+    quality = (quality > (int32_t)mjpeg_encoder->config.max_quality) ? (int32_t)mjpeg_encoder->config.max_quality : quality;
+    ESP_LOGD(TAG, "frame size %" PRIu32 ", quality %" PRIu32 " -> %" PRId32, frame_size, mjpeg_encoder->quality, quality);
+    mjpeg_encoder->quality = quality;
+}
+
+static void jpeg_mjpeg_raw_done(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, const uint8_t *raw_buf, bool dropped)
+{
+    if (mjpeg_encoder->config.on_raw_done) {
+        mjpeg_encoder->config.on_raw_done(mjpeg_encoder, raw_buf, dropped, mjpeg_encoder->config.user_data);
+    }
+}
+
+static void jpeg_mjpeg_task(void *arg)
+{
+    jpeg_mjpeg_encoder_handle_t mjpeg_encoder = (jpeg_mjpeg_encoder_handle_t)arg;
+    jpeg_mjpeg_raw_t raw = {};
+    while (xQueueReceive(mjpeg_encoder->raw_queue, &raw, portMAX_DELAY) == pdTRUE && raw.buf) {
+        jpeg_mjpeg_frame_t frame = {};
+        // Don't stall the camera if all the JPEG buffers are held by the user, drop the frame instead
+        if (xQueueReceive(mjpeg_encoder->free_queue, &frame.jpeg_buf, 0) != pdTRUE) {
+            ESP_LOGD(TAG, "no free jpeg buffer, drop frame %p", raw.buf);
+            jpeg_mjpeg_raw_done(mjpeg_encoder, raw.buf, true);
+            continue;
+        }
+
+        jpeg_encode_cfg_t encode_cfg = mjpeg_encoder->config.encode_cfg;
+        encode_cfg.image_quality = mjpeg_encoder->quality;
+        frame.quality = mjpeg_encoder->quality;
+        esp_err_t ret = jpeg_encoder_process(mjpeg_encoder->encoder_engine, &encode_cfg, raw.buf, raw.size,
+                                             frame.jpeg_buf, mjpeg_encoder->config.jpeg_buf_size, &frame.jpeg_size);
+        jpeg_mjpeg_raw_done(mjpeg_encoder, raw.buf, ret != ESP_OK);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "encode frame %p failed: %s", raw.buf, esp_err_to_name(ret));
+            xQueueSend(mjpeg_encoder->free_queue, &frame.jpeg_buf, 0);
+            continue;
+        }
+        jpeg_mjpeg_update_quality(mjpeg_encoder, frame.jpeg_size);
+        // The frame queue holds all the JPEG buffers, it can't be full
+        xQueueSend(mjpeg_encoder->frame_queue, &frame, 0);
+    }
+    xSemaphoreGive(mjpeg_encoder->exit_sem);
+    vTaskSuspend(NULL);
+}
+
+static void jpeg_mjpeg_encoder_free(jpeg_mjpeg_encoder_handle_t mjpeg_encoder)
+{
+    if (mjpeg_encoder->jpeg_bufs) {
+        for (uint32_t i = 0; i < mjpeg_encoder->config.num_jpeg_bufs; i++) {
+            free(mjpeg_encoder->jpeg_bufs[i]);
+        }
+        free(mjpeg_encoder->jpeg_bufs);
+    }
+    if (mjpeg_encoder->raw_queue) {
+        vQueueDeleteWithCaps(mjpeg_encoder->raw_queue);
+    }
+    if (mjpeg_encoder->free_queue) {
+        vQueueDeleteWithCaps(mjpeg_encoder->free_queue);
+    }
+    if (mjpeg_encoder->frame_queue) {
+        vQueueDeleteWithCaps(mjpeg_encoder->frame_queue);
+    }
+    if (mjpeg_encoder->exit_sem) {
+        vSemaphoreDeleteWithCaps(mjpeg_encoder->exit_sem);
+    }
+    free(mjpeg_encoder);
+}
+
+esp_err_t jpeg_new_mjpeg_encoder(jpeg_encoder_handle_t encoder_engine, const jpeg_mjpeg_encoder_config_t *config, jpeg_mjpeg_encoder_handle_t *ret_mjpeg_encoder)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(encoder_engine && config && ret_mjpeg_encoder, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->raw_queue_depth && config->num_jpeg_bufs && config->jpeg_buf_size, ESP_ERR_INVALID_ARG, TAG, "invalid queue depth or jpeg buffers");
+    ESP_RETURN_ON_FALSE(config->min_quality <= 100 && config->max_quality <= 100, ESP_ERR_INVALID_ARG, TAG, "invalid quality range");
+
+    jpeg_mjpeg_encoder_handle_t mjpeg_encoder = (jpeg_mjpeg_encoder_handle_t)heap_caps_calloc(1, sizeof(struct jpeg_mjpeg_encoder_t), JPEG_MEM_ALLOC_CAPS);
+    ESP_RETURN_ON_FALSE(mjpeg_encoder, ESP_ERR_NO_MEM, TAG, "no memory for mjpeg encoder");
+    mjpeg_encoder->encoder_engine = encoder_engine;
+    mjpeg_encoder->config = *config;
+    mjpeg_encoder->config.min_quality = config->min_quality ? config->min_quality : 1;
+    mjpeg_encoder->config.max_quality = config->max_quality ? config->max_quality : 100;
+    ESP_GOTO_ON_FALSE(mjpeg_encoder->config.min_quality <= mjpeg_encoder->config.max_quality, ESP_ERR_INVALID_ARG, err, TAG, "invalid quality range");
+    mjpeg_encoder->quality = config->encode_cfg.image_quality;
+    mjpeg_encoder->quality = (mjpeg_encoder->quality < mjpeg_encoder->config.min_quality) ? mjpeg_encoder->config.min_quality : mjpeg_encoder->quality;
+    mjpeg_encoder->quality = (mjpeg_encoder->quality > mjpeg_encoder->config.max_quality) ? mjpeg_encoder->config.max_quality : mjpeg_encoder->quality;
+
+    mjpeg_encoder->raw_queue = xQueueCreateWithCaps(config->raw_queue_depth + 1, sizeof(jpeg_mjpeg_raw_t), JPEG_MEM_ALLOC_CAPS);
+    mjpeg_encoder->free_queue = xQueueCreateWithCaps(config->num_jpeg_bufs, sizeof(uint8_t *), JPEG_MEM_ALLOC_CAPS);
+    mjpeg_encoder->frame_queue = xQueueCreateWithCaps(config->num_jpeg_bufs, sizeof(jpeg_mjpeg_frame_t), JPEG_MEM_ALLOC_CAPS);
+    mjpeg_encoder->exit_sem = xSemaphoreCreateBinaryWithCaps(JPEG_MEM_ALLOC_CAPS);
+    ESP_GOTO_ON_FALSE(mjpeg_encoder->raw_queue && mjpeg_encoder->free_queue && mjpeg_encoder->frame_queue && mjpeg_encoder->exit_sem,
+                      ESP_ERR_NO_MEM, err, TAG, "no memory for mjpeg encoder queues");
+
+    mjpeg_encoder->jpeg_bufs = (uint8_t **)heap_caps_calloc(config->num_jpeg_bufs, sizeof(uint8_t *), JPEG_MEM_ALLOC_CAPS);
+    ESP_GOTO_ON_FALSE(mjpeg_encoder->jpeg_bufs, ESP_ERR_NO_MEM, err, TAG, "no memory for jpeg buffer list");
+    jpeg_encode_memory_alloc_cfg_t mem_cfg = {
+        .buffer_direction = JPEG_ENC_ALLOC_OUTPUT_BUFFER,
+    };
+    for (uint32_t i = 0; i < config->num_jpeg_bufs; i++) {
+        size_t allocated_size = 0;
+        mjpeg_encoder->jpeg_bufs[i] = (uint8_t *)jpeg_alloc_encoder_mem(config->jpeg_buf_size, &mem_cfg, &allocated_size);
+        ESP_GOTO_ON_FALSE(mjpeg_encoder->jpeg_bufs[i], ESP_ERR_NO_MEM, err, TAG, "no memory for jpeg buffer %" PRIu32, i);
+        xQueueSend(mjpeg_encoder->free_queue, &mjpeg_encoder->jpeg_bufs[i], 0);
+    }
+
+    ESP_GOTO_ON_FALSE(xTaskCreate(jpeg_mjpeg_task, "mjpeg_enc", JPEG_MJPEG_TASK_STACK_SIZE, mjpeg_encoder, config->task_priority, &mjpeg_encoder->task) == pdPASS,
+                      ESP_ERR_NO_MEM, err, TAG, "create mjpeg encoding task failed");
+    *ret_mjpeg_encoder = mjpeg_encoder;
+    return ESP_OK;
+
+err:
+    jpeg_mjpeg_encoder_free(mjpeg_encoder);
+    return ret;
+}
+
+esp_err_t jpeg_mjpeg_encoder_push_raw(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, const uint8_t *raw_buf, uint32_t raw_size)
+{
+    ESP_RETURN_ON_FALSE_ISR(mjpeg_encoder && raw_buf && raw_size, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    jpeg_mjpeg_raw_t raw = {
+        .buf = raw_buf,
+        .size = raw_size,
+    };
+    BaseType_t sent = pdFALSE;
+    // One slot of the raw queue is kept for the exit request
+    if (xPortInIsrContext()) {
+        BaseType_t high_task_woken = pdFALSE;
+        if (uxQueueMessagesWaitingFromISR(mjpeg_encoder->raw_queue) < mjpeg_encoder->config.raw_queue_depth) {
+            sent = xQueueSendFromISR(mjpeg_encoder->raw_queue, &raw, &high_task_woken);
+        }
+        if (high_task_woken == pdTRUE) {
+            portYIELD_FROM_ISR();
+        }
+    } else if (uxQueueMessagesWaiting(mjpeg_encoder->raw_queue) < mjpeg_encoder->config.raw_queue_depth) {
+        sent = xQueueSend(mjpeg_encoder->raw_queue, &raw, 0);
+    }
+    ESP_RETURN_ON_FALSE_ISR(sent == pdTRUE, ESP_ERR_INVALID_STATE, TAG, "raw frame queue is full");
+    return ESP_OK;
+}
+
+esp_err_t jpeg_mjpeg_encoder_get_frame(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, jpeg_mjpeg_frame_t *frame, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(mjpeg_encoder && frame, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    TickType_t ticks = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    if (xQueueReceive(mjpeg_encoder->frame_queue, frame, ticks) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+esp_err_t jpeg_mjpeg_encoder_return_frame(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, const jpeg_mjpeg_frame_t *frame)
+{
+    ESP_RETURN_ON_FALSE(mjpeg_encoder && frame && frame->jpeg_buf, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    bool found = false;
+    for (uint32_t i = 0; i < mjpeg_encoder->config.num_jpeg_bufs; i++) {
+        if (mjpeg_encoder->jpeg_bufs[i] == frame->jpeg_buf) {
+            found = true;
+            break;
+        }
+    }
+    ESP_RETURN_ON_FALSE(found, ESP_ERR_INVALID_ARG, TAG, "buffer %p doesn't belong to the mjpeg encoder", frame->jpeg_buf);
+    // The free queue holds all the JPEG buffers, it can't be full
+    xQueueSend(mjpeg_encoder->free_queue, &frame->jpeg_buf, 0);
+    return ESP_OK;
+}
+
+esp_err_t jpeg_del_mjpeg_encoder(jpeg_mjpeg_encoder_handle_t mjpeg_encoder)
+{
+    ESP_RETURN_ON_FALSE(mjpeg_encoder, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    // Drop the pending raw frames, then ask the encoding task to exit
+    jpeg_mjpeg_raw_t raw = {};
+    while (xQueueReceive(mjpeg_encoder->raw_queue, &raw, 0) == pdTRUE) {
+        jpeg_mjpeg_raw_done(mjpeg_encoder, raw.buf, true);
+    }
+    raw.buf = NULL;
+    xQueueSend(mjpeg_encoder->raw_queue, &raw, portMAX_DELAY);
+    xSemaphoreTake(mjpeg_encoder->exit_sem, portMAX_DELAY);
+    vTaskDelete(mjpeg_encoder->task);
+
+    jpeg_mjpeg_encoder_free(mjpeg_encoder);
+    return ESP_OK;
+}
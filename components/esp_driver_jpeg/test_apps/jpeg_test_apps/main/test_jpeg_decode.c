@@ -16,6 +16,7 @@
 #include "esp_log.h"
 #include "test_jpeg_performance.h"
 #include "esp_system.h"
+#include "esp_heap_caps.h"
 #include "ccomp_timer.h"
 
 extern const uint8_t image_esp1080_jpg_start[] asm("_binary_esp1080_jpg_start");
@@ -87,3 +88,106 @@ TEST_CASE("JPEG decode performance test for 1080*1920 YUV->RGB picture", "[jpeg]
     free(tx_buf_1080p);
     TEST_ESP_OK(jpeg_del_decoder_engine(jpgd_handle));
 }
+
+typedef struct {
+    uint8_t *picture;
+    uint32_t offset;
+    uint32_t next_y;
+    uint32_t stripe_cnt;
+    bool last_seen;
+} test_jpeg_stream_ctx_t;
+
+static void test_jpeg_on_stripe_done(jpeg_decode_stream_handle_t stream, const jpeg_decode_stripe_t *stripe, void *user_data)
+{
+    test_jpeg_stream_ctx_t *ctx = (test_jpeg_stream_ctx_t *)user_data;
+    TEST_ASSERT_EQUAL_UINT32(ctx->next_y, stripe->y);
+    // Stripes are decoded in order, the decoded stripes make up the whole picture
+    memcpy(ctx->picture + ctx->offset, stripe->buffer, stripe->out_size);
+    ctx->offset += stripe->out_size;
+    ctx->next_y += stripe->height;
+    ctx->stripe_cnt++;
+    ctx->last_seen = stripe->last;
+}
+
+TEST_CASE("JPEG decode stream fed in chunks", "[jpeg]")
+{
+    jpeg_decoder_handle_t jpgd_handle;
+    jpeg_decode_stream_handle_t stream;
+
+    jpeg_decode_engine_cfg_t decode_eng_cfg = {
+        .timeout_ms = 40,
+    };
+    jpeg_decode_cfg_t decode_cfg = {
+        .output_format = JPEG_DECODE_OUT_FORMAT_RGB565,
+    };
+    jpeg_decode_memory_alloc_cfg_t rx_mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_OUTPUT_BUFFER,
+    };
+    jpeg_decode_memory_alloc_cfg_t tx_mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_INPUT_BUFFER,
+    };
+
+    size_t bit_stream_length = (size_t)image_esp1080_jpg_end - (size_t)image_esp1080_jpg_start;
+    size_t tx_buffer_size;
+    uint8_t *tx_buf = (uint8_t*)jpeg_alloc_decoder_mem(bit_stream_length, &tx_mem_cfg, &tx_buffer_size);
+    TEST_ASSERT_NOT_NULL(tx_buf);
+    memcpy(tx_buf, image_esp1080_jpg_start, bit_stream_length);
+
+    size_t rx_buffer_size;
+    uint8_t *ref_buf = (uint8_t*)jpeg_alloc_decoder_mem(1080 * 1920 * 2, &rx_mem_cfg, &rx_buffer_size);
+    uint8_t *picture = (uint8_t*)heap_caps_calloc(1, rx_buffer_size, MALLOC_CAP_SPIRAM);
+    uint8_t *stripe_bufs[2];
+    size_t stripe_buffer_size;
+    for (int i = 0; i < 2; i++) {
+        stripe_bufs[i] = (uint8_t*)jpeg_alloc_decoder_mem(1080 * 1920 * 2, &rx_mem_cfg, &stripe_buffer_size);
+        TEST_ASSERT_NOT_NULL(stripe_bufs[i]);
+    }
+    TEST_ASSERT_NOT_NULL(ref_buf);
+    TEST_ASSERT_NOT_NULL(picture);
+
+    TEST_ESP_OK(jpeg_new_decoder_engine(&decode_eng_cfg, &jpgd_handle));
+    uint32_t ref_size = 0;
+    TEST_ESP_OK(jpeg_decoder_process(jpgd_handle, &decode_cfg, tx_buf, bit_stream_length, ref_buf, rx_buffer_size, &ref_size));
+
+    test_jpeg_stream_ctx_t ctx = {
+        .picture = picture,
+    };
+    jpeg_decode_stream_cfg_t stream_cfg = {
+        .decode_cfg = decode_cfg,
+        .stripe_mcu_rows = 8,
+        .stripe_bufs = stripe_bufs,
+        .num_stripe_bufs = 2,
+        .stripe_buf_size = stripe_buffer_size,
+        .max_stripe_input_size = bit_stream_length + 2,
+        .on_stripe_done = test_jpeg_on_stripe_done,
+        .user_data = &ctx,
+    };
+    TEST_ESP_OK(jpeg_decoder_new_stream(jpgd_handle, &stream_cfg, &stream));
+
+    // Feed the picture twice in odd sized chunks, as if it were received from network
+    const uint32_t chunk_size = 1459;
+    for (int round = 0; round < 2; round++) {
+        memset(&ctx, 0, sizeof(ctx));
+        ctx.picture = picture;
+        for (uint32_t pos = 0; pos < bit_stream_length; pos += chunk_size) {
+            uint32_t len = (bit_stream_length - pos < chunk_size) ? bit_stream_length - pos : chunk_size;
+            TEST_ESP_OK(jpeg_decoder_stream_feed(stream, image_esp1080_jpg_start + pos, len));
+        }
+        TEST_ASSERT_TRUE(ctx.last_seen);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, ctx.stripe_cnt);
+        TEST_ASSERT_EQUAL_UINT32(ref_size, ctx.offset);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, picture, ref_size);
+    }
+
+    // Data that isn't a JPEG picture is rejected
+    const uint8_t garbage[] = {0x12, 0x34, 0x56, 0x78};
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, jpeg_decoder_stream_feed(stream, garbage, sizeof(garbage)));
+
+    TEST_ESP_OK(jpeg_decoder_del_stream(stream));
+    TEST_ESP_OK(jpeg_del_decoder_engine(jpgd_handle));
+    free(tx_buf);
+    free(ref_buf);
+    free(picture);
+    free(stripe_bufs[0]);
+    free(stripe_bufs[1]);
+}
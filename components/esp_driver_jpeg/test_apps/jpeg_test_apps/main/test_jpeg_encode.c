@@ -118,3 +118,98 @@ TEST_CASE("jpeg initialize twice test", "[jpeg]")
     TEST_ESP_OK(jpeg_del_encoder_engine(encoder_handle));
     TEST_ESP_OK(jpeg_del_decoder_engine(decoder_handle));
 }
+
+typedef struct {
+    uint32_t done_cnt;
+    uint32_t dropped_cnt;
+} test_mjpeg_ctx_t;
+
+static void test_mjpeg_on_raw_done(jpeg_mjpeg_encoder_handle_t mjpeg_encoder, const uint8_t *raw_buf, bool dropped, void *user_data)
+{
+    test_mjpeg_ctx_t *ctx = (test_mjpeg_ctx_t *)user_data;
+    ctx->done_cnt++;
+    ctx->dropped_cnt += dropped;
+}
+
+TEST_CASE("JPEG MJPEG encoder rate control", "[jpeg]")
+{
+    jpeg_encoder_handle_t jpeg_handle = NULL;
+    jpeg_mjpeg_encoder_handle_t mjpeg_handle = NULL;
+
+    jpeg_encode_engine_cfg_t encode_eng_cfg = {
+        .timeout_ms = 40,
+    };
+    jpeg_encode_cfg_t enc_config = {
+        .src_type = JPEG_ENCODE_IN_FORMAT_RGB888,
+        .sub_sample = JPEG_DOWN_SAMPLING_YUV422,
+        .image_quality = 90,
+        .width = 640,
+        .height = 480,
+    };
+    jpeg_encode_memory_alloc_cfg_t tx_mem_cfg = {
+        .buffer_direction = JPEG_ENC_ALLOC_INPUT_BUFFER,
+    };
+
+    size_t rgb_file_size = (size_t)image_esp480_rgb_end - (size_t)image_esp480_rgb_start;
+    size_t tx_buffer_size = 0;
+    uint8_t *raw_buf = (uint8_t*)jpeg_alloc_encoder_mem(rgb_file_size, &tx_mem_cfg, &tx_buffer_size);
+    TEST_ASSERT_NOT_NULL(raw_buf);
+    memcpy(raw_buf, image_esp480_rgb_start, rgb_file_size);
+    TEST_ESP_OK(jpeg_new_encoder_engine(&encode_eng_cfg, &jpeg_handle));
+
+    test_mjpeg_ctx_t ctx = {};
+    jpeg_mjpeg_encoder_config_t mjpeg_config = {
+        .encode_cfg = enc_config,
+        .target_frame_size = 0,
+        .raw_queue_depth = 2,
+        .num_jpeg_bufs = 2,
+        .jpeg_buf_size = 480 * 640 * 3,
+        .task_priority = 5,
+        .on_raw_done = test_mjpeg_on_raw_done,
+        .user_data = &ctx,
+    };
+    TEST_ESP_OK(jpeg_new_mjpeg_encoder(jpeg_handle, &mjpeg_config, &mjpeg_handle));
+
+    // Fixed quality without a target frame size
+    jpeg_mjpeg_frame_t frame = {};
+    TEST_ESP_OK(jpeg_mjpeg_encoder_push_raw(mjpeg_handle, raw_buf, rgb_file_size));
+    TEST_ESP_OK(jpeg_mjpeg_encoder_get_frame(mjpeg_handle, &frame, 1000));
+    TEST_ASSERT_EQUAL_UINT32(90, frame.quality);
+    uint32_t full_size = frame.jpeg_size;
+    TEST_ESP_OK(jpeg_mjpeg_encoder_return_frame(mjpeg_handle, &frame));
+    TEST_ESP_OK(jpeg_mjpeg_encoder_push_raw(mjpeg_handle, raw_buf, rgb_file_size));
+    TEST_ESP_OK(jpeg_mjpeg_encoder_get_frame(mjpeg_handle, &frame, 1000));
+    TEST_ASSERT_EQUAL_UINT32(90, frame.quality);
+    TEST_ESP_OK(jpeg_mjpeg_encoder_return_frame(mjpeg_handle, &frame));
+    TEST_ESP_OK(jpeg_del_mjpeg_encoder(mjpeg_handle));
+    TEST_ASSERT_EQUAL_UINT32(2, ctx.done_cnt);
+
+    // The quality goes down until the frames approach the target size
+    mjpeg_config.target_frame_size = full_size / 3;
+    TEST_ESP_OK(jpeg_new_mjpeg_encoder(jpeg_handle, &mjpeg_config, &mjpeg_handle));
+    for (int i = 0; i < 20; i++) {
+        TEST_ESP_OK(jpeg_mjpeg_encoder_push_raw(mjpeg_handle, raw_buf, rgb_file_size));
+        TEST_ESP_OK(jpeg_mjpeg_encoder_get_frame(mjpeg_handle, &frame, 1000));
+        TEST_ESP_OK(jpeg_mjpeg_encoder_return_frame(mjpeg_handle, &frame));
+    }
+    TEST_ASSERT_LESS_THAN_UINT32(90, frame.quality);
+    TEST_ASSERT_LESS_THAN_UINT32(full_size / 2, frame.jpeg_size);
+
+    // A raw frame is dropped when all the JPEG buffers are held
+    jpeg_mjpeg_frame_t held[2];
+    ctx.dropped_cnt = 0;
+    for (int i = 0; i < 2; i++) {
+        TEST_ESP_OK(jpeg_mjpeg_encoder_push_raw(mjpeg_handle, raw_buf, rgb_file_size));
+        TEST_ESP_OK(jpeg_mjpeg_encoder_get_frame(mjpeg_handle, &held[i], 1000));
+    }
+    TEST_ESP_OK(jpeg_mjpeg_encoder_push_raw(mjpeg_handle, raw_buf, rgb_file_size));
+    TEST_ESP_ERR(ESP_ERR_TIMEOUT, jpeg_mjpeg_encoder_get_frame(mjpeg_handle, &frame, 100));
+    TEST_ASSERT_EQUAL_UINT32(1, ctx.dropped_cnt);
+    for (int i = 0; i < 2; i++) {
+        TEST_ESP_OK(jpeg_mjpeg_encoder_return_frame(mjpeg_handle, &held[i]));
+    }
+
+    TEST_ESP_OK(jpeg_del_mjpeg_encoder(mjpeg_handle));
+    TEST_ESP_OK(jpeg_del_encoder_engine(jpeg_handle));
+    free(raw_buf);
+}
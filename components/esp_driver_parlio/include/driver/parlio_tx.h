@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -119,6 +119,25 @@ typedef struct {
  */
 typedef bool (*parlio_tx_done_callback_t)(parlio_tx_unit_handle_t tx_unit, const parlio_tx_done_event_data_t *edata, void *user_ctx);
 
+/**
+ * @brief Type of Parallel IO TX loop half done event data
+ */
+typedef struct {
+    const void *buffer; /*!< The half of the loop payload that has just been transmitted, it can be refilled until the other half is transmitted */
+    size_t size;        /*!< Size of the half, in bytes */
+} parlio_tx_loop_event_data_t;
+
+/**
+ * @brief Prototype of parlio tx loop transmission event callback
+ * @param[in] tx_unit Parallel IO TX unit that created by `parlio_new_tx_unit`
+ * @param[in] edata Point to Parallel IO TX loop event data. The lifecycle of this pointer memory is inside this function,
+ *                  user should copy it into static memory if used outside this function.
+ * @param[in] user_ctx User registered context, passed from `parlio_tx_unit_register_event_callbacks`
+ *
+ * @return Whether a high priority task has been waken up by this callback function
+ */
+typedef bool (*parlio_tx_loop_callback_t)(parlio_tx_unit_handle_t tx_unit, const parlio_tx_loop_event_data_t *edata, void *user_ctx);
+
 /**
  * @brief Group of Parallel IO TX callbacks
  * @note The callbacks are all running under ISR environment
@@ -127,6 +146,7 @@ typedef bool (*parlio_tx_done_callback_t)(parlio_tx_unit_handle_t tx_unit, const
  */
 typedef struct {
     parlio_tx_done_callback_t on_trans_done; /*!< Event callback, invoked when one transmission is finished */
+    parlio_tx_loop_callback_t on_loop_half_done; /*!< Event callback, invoked when one half of the payload of a loop transmission is transmitted */
 } parlio_tx_event_callbacks_t;
 
 /**
@@ -153,6 +173,10 @@ typedef struct {
     uint32_t idle_value; /*!< The value on the data line when the parallel IO is in idle state */
     struct {
         uint32_t queue_nonblocking : 1; /*!< If set, when the transaction queue is full, driver will not block the thread but return directly */
+        uint32_t loop_transmission : 1; /*!< If set, the payload is transmitted repeatedly without any gap, until the TX unit is disabled.
+                                             The payload is divided into two halves, and `on_loop_half_done` is invoked each time a half is transmitted,
+                                             so that the half can be refilled while the other one is being transmitted (ping-pong buffer).
+                                             Only supported when SOC_PARLIO_TX_SIZE_BY_DMA is available */
     } flags;                            /*!< Transmit specific config flags */
 } parlio_transmit_config_t;
 
@@ -160,6 +184,9 @@ typedef struct {
  * @brief Transmit data on by Parallel IO TX unit
  *
  * @note After the function returns, it doesn't mean the transaction is finished. This function only constructs a transaction structure and push into a queue.
+ * @note A loop transmission never finishes, so `on_trans_done` is not invoked for it, and the transactions queued after it won't start
+ *       until the TX unit is disabled and enabled again. If the payload is refilled in `on_loop_half_done` and it's in a cacheable memory,
+ *       the refilled half should be written back by `esp_cache_msync` before it's transmitted again.
  *
  * @param[in] tx_unit Parallel IO TX unit that created by `parlio_new_tx_unit`
  * @param[in] payload Pointer to the data to be transmitted
@@ -169,6 +196,7 @@ typedef struct {
  *      - ESP_OK: Transmit data successfully
  *      - ESP_ERR_INVALID_ARG: Transmit data failed because of invalid argument
  *      - ESP_ERR_INVALID_STATE: Transmit data failed because the Parallel IO TX unit is not enabled
+ *      - ESP_ERR_NOT_SUPPORTED: Transmit data failed because the loop transmission is not supported by hardware
  *      - ESP_FAIL: Transmit data failed because of other error
  */
 esp_err_t parlio_tx_unit_transmit(parlio_tx_unit_handle_t tx_unit, const void *payload, size_t payload_bits, const parlio_transmit_config_t *config);
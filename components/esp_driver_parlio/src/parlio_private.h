@@ -57,6 +57,7 @@ typedef dma_descriptor_align8_t     parlio_dma_desc_t;
 #endif // defined(SOC_GDMA_TRIG_PERIPH_PARLIO0_BUS)
 
 #define ALIGN_UP(num, align)    (((num) + ((align) - 1)) & ~((align) - 1))
+#define ALIGN_DOWN(num, align)  ((num) & ~((align) - 1))
 
 #if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
 #define PARLIO_MAX_ALIGNED_DMA_BUF_SIZE     DMA_DESCRIPTOR_BUFFER_MAX_SIZE_64B_ALIGNED
@@ -44,6 +44,10 @@ typedef struct {
     uint32_t idle_value; // Parallel IO bus idle value
     const void *payload; // payload to be transmitted
     size_t payload_bits; // payload size in bits
+    size_t loop_half_size; // size of the first half of the payload, in bytes, only for the loop transmission
+    struct {
+        uint32_t loop_transmission: 1; // whether the payload is transmitted repeatedly
+    } flags;
 } parlio_tx_trans_desc_t;
 
 typedef struct parlio_tx_unit_t {
@@ -69,11 +73,17 @@ typedef struct parlio_tx_unit_t {
     uint32_t idle_value_mask;          // mask of idle value
     _Atomic parlio_tx_fsm_t fsm;       // Driver FSM state
     parlio_tx_done_callback_t on_trans_done; // callback function when the transmission is done
+    parlio_tx_loop_callback_t on_loop_half_done; // callback function when one half of the loop payload is transmitted
     void *user_data;                   // user data passed to the callback function
+    uint32_t loop_half_end_idx[2];     // index of the last DMA link list item of each half of the loop payload
+    uint32_t loop_next_half;           // the half of the loop payload that is expected to be transmitted next
     parlio_tx_trans_desc_t trans_desc_pool[];   // transaction descriptor pool
 } parlio_tx_unit_t;
 
 static void parlio_tx_default_isr(void *args);
+#if SOC_PARLIO_TX_SIZE_BY_DMA
+static bool parlio_tx_default_dma_send_done_callback(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data);
+#endif
 
 static esp_err_t parlio_tx_create_trans_queue(parlio_tx_unit_t *tx_unit, const parlio_tx_unit_config_t *config)
 {
@@ -216,6 +226,14 @@ static esp_err_t parlio_tx_unit_init_dma(parlio_tx_unit_t *tx_unit, const parlio
 
     // throw the error to the caller
     ESP_RETURN_ON_ERROR(gdma_new_link_list(&dma_link_config, &tx_unit->dma_link), TAG, "create DMA link list failed");
+
+#if SOC_PARLIO_TX_SIZE_BY_DMA
+    // the loop transmission tracks the transmitted halves of the payload by the descriptor done event
+    gdma_tx_event_callbacks_t cbs = {
+        .on_send_done = parlio_tx_default_dma_send_done_callback,
+    };
+    ESP_RETURN_ON_ERROR(gdma_register_tx_event_callbacks(tx_unit->dma_chan, &cbs, tx_unit), TAG, "register DMA callbacks failed");
+#endif
     return ESP_OK;
 }
 
@@ -304,6 +322,10 @@ esp_err_t parlio_new_tx_unit(const parlio_tx_unit_config_t *config, parlio_tx_un
     // create DMA descriptors
     // DMA descriptors must be placed in internal SRAM
     size_t dma_nodes_num = config->max_transfer_size / DMA_DESCRIPTOR_BUFFER_MAX_SIZE + 1;
+#if SOC_PARLIO_TX_SIZE_BY_DMA
+    // the loop transmission mounts the two halves of the payload separately, which may take one more node
+    dma_nodes_num++;
+#endif
     unit->dma_nodes_num = dma_nodes_num;
 
     unit->max_transfer_bits = config->max_transfer_size * 8;
@@ -416,32 +438,60 @@ esp_err_t parlio_tx_unit_register_event_callbacks(parlio_tx_unit_handle_t tx_uni
     if (cbs->on_trans_done) {
         ESP_RETURN_ON_FALSE(esp_ptr_in_iram(cbs->on_trans_done), ESP_ERR_INVALID_ARG, TAG, "on_trans_done callback not in IRAM");
     }
+    if (cbs->on_loop_half_done) {
+        ESP_RETURN_ON_FALSE(esp_ptr_in_iram(cbs->on_loop_half_done), ESP_ERR_INVALID_ARG, TAG, "on_loop_half_done callback not in IRAM");
+    }
     if (user_data) {
         ESP_RETURN_ON_FALSE(esp_ptr_internal(user_data), ESP_ERR_INVALID_ARG, TAG, "user context not in internal RAM");
     }
 #endif
 
     tx_unit->on_trans_done = cbs->on_trans_done;
+    tx_unit->on_loop_half_done = cbs->on_loop_half_done;
     tx_unit->user_data = user_data;
     return ESP_OK;
 }
 
+// Mount the two halves of the loop payload to the DMA link list, and link them as a ring
+static void IRAM_ATTR parlio_tx_mount_loop_payload(parlio_tx_unit_t *tx_unit, parlio_tx_trans_desc_t *t)
+{
+    size_t size = t->payload_bits / 8;
+    gdma_buffer_mount_config_t mount_config = {
+        .buffer = (void *)t->payload,
+        .length = t->loop_half_size,
+    };
+    gdma_link_mount_buffers(tx_unit->dma_link, 0, &mount_config, 1, &tx_unit->loop_half_end_idx[0]);
+    mount_config.buffer = (uint8_t *)t->payload + t->loop_half_size;
+    mount_config.length = size - t->loop_half_size;
+    gdma_link_mount_buffers(tx_unit->dma_link, tx_unit->loop_half_end_idx[0] + 1, &mount_config, 1, &tx_unit->loop_half_end_idx[1]);
+    gdma_link_concat(tx_unit->dma_link, tx_unit->loop_half_end_idx[1], tx_unit->dma_link, 0);
+    tx_unit->loop_next_half = 0;
+}
+
 static void IRAM_ATTR parlio_tx_do_transaction(parlio_tx_unit_t *tx_unit, parlio_tx_trans_desc_t *t)
 {
     parlio_hal_context_t *hal = &tx_unit->base.group->hal;
 
     tx_unit->cur_trans = t;
 
-    // DMA transfer data based on bytes not bits, so convert the bit length to bytes, round up
-    gdma_buffer_mount_config_t mount_config = {
-        .buffer = (void *)t->payload,
-        .length = (t->payload_bits + 7) / 8,
-        .flags = {
-            .mark_eof = true,
-            .mark_final = true, // singly link list, mark final descriptor
-        }
-    };
-    gdma_link_mount_buffers(tx_unit->dma_link, 0, &mount_config, 1, NULL);
+    if (t->flags.loop_transmission) {
+        parlio_tx_mount_loop_payload(tx_unit, t);
+    } else {
+        // DMA transfer data based on bytes not bits, so convert the bit length to bytes, round up
+        gdma_buffer_mount_config_t mount_config = {
+            .buffer = (void *)t->payload,
+            .length = (t->payload_bits + 7) / 8,
+            .flags = {
+                .mark_eof = true,
+                .mark_final = true, // singly link list, mark final descriptor
+            }
+        };
+        gdma_link_mount_buffers(tx_unit->dma_link, 0, &mount_config, 1, NULL);
+    }
+#if SOC_PARLIO_TX_SIZE_BY_DMA
+    // the ring of the loop transmission has no EOF item, so ending the transaction on the DMA EOF makes it never end
+    parlio_ll_tx_set_eof_condition(hal->regs, t->flags.loop_transmission ? PARLIO_LL_TX_EOF_COND_DMA_EOF : PARLIO_LL_TX_EOF_COND_DATA_LEN);
+#endif
 
     parlio_ll_tx_reset_fifo(hal->regs);
     PARLIO_RCC_ATOMIC() {
@@ -541,6 +591,9 @@ esp_err_t parlio_tx_unit_transmit(parlio_tx_unit_handle_t tx_unit, const void *p
 #if !SOC_PARLIO_TRANS_BIT_ALIGN
     ESP_RETURN_ON_FALSE((payload_bits % 8) == 0, ESP_ERR_INVALID_ARG, TAG, "payload bit length must be multiple of 8");
 #endif // !SOC_PARLIO_TRANS_BIT_ALIGN
+#if !SOC_PARLIO_TX_SIZE_BY_DMA
+    ESP_RETURN_ON_FALSE(!config->flags.loop_transmission, ESP_ERR_NOT_SUPPORTED, TAG, "loop transmission is not supported");
+#endif
 
     size_t cache_line_size = 0;
     size_t alignment = 0;
@@ -551,6 +604,14 @@ esp_err_t parlio_tx_unit_transmit(parlio_tx_unit_handle_t tx_unit, const void *p
     ESP_RETURN_ON_FALSE((payload_bits & (alignment - 1)) == 0, ESP_ERR_INVALID_ARG, TAG, "payload size not aligned");
     cache_line_size = cache_hal_get_cache_line_size(cache_type, CACHE_TYPE_DATA);
 
+    size_t loop_half_size = 0;
+    if (config->flags.loop_transmission) {
+        // the second half must start at an address that the DMA can access, and on a boundary of the bus width
+        ESP_RETURN_ON_FALSE((payload_bits % 8) == 0, ESP_ERR_INVALID_ARG, TAG, "loop payload bit length must be multiple of 8");
+        loop_half_size = ALIGN_DOWN(payload_bits / 8 / 2, MAX(alignment, 4));
+        ESP_RETURN_ON_FALSE(loop_half_size, ESP_ERR_INVALID_ARG, TAG, "loop payload too small to be divided into halves");
+    }
+
     if (cache_line_size > 0) {
         // Write back to cache to synchronize the cache before DMA start
         ESP_RETURN_ON_ERROR(esp_cache_msync((void *)payload, (payload_bits + 7) / 8,
@@ -575,6 +636,8 @@ esp_err_t parlio_tx_unit_transmit(parlio_tx_unit_handle_t tx_unit, const void *p
     t->payload = payload;
     t->payload_bits = payload_bits;
     t->idle_value = config->idle_value & tx_unit->idle_value_mask;
+    t->loop_half_size = loop_half_size;
+    t->flags.loop_transmission = config->flags.loop_transmission;
 
     // send the transaction descriptor to progress queue
     ESP_RETURN_ON_FALSE(xQueueSend(tx_unit->trans_queues[PARLIO_TX_QUEUE_PROGRESS], &t, 0) == pdTRUE,
@@ -596,6 +659,47 @@ esp_err_t parlio_tx_unit_transmit(parlio_tx_unit_handle_t tx_unit, const void *p
     return ESP_OK;
 }
 
+#if SOC_PARLIO_TX_SIZE_BY_DMA
+static bool IRAM_ATTR parlio_tx_default_dma_send_done_callback(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data)
+{
+    parlio_tx_unit_t *tx_unit = (parlio_tx_unit_t *)user_data;
+    parlio_tx_trans_desc_t *t = tx_unit->cur_trans;
+    bool need_yield = false;
+    if (!t || !t->flags.loop_transmission) {
+        return false;
+    }
+
+    // the DMA gives the items back to the CPU once they're sent, so a half is transmitted when its last item is owned by the CPU
+    // check both halves in order, in case the other half was also transmitted before the interrupt got served
+    for (int i = 0; i < 2; i++) {
+        uint32_t half = tx_unit->loop_next_half;
+        gdma_lli_owner_t owner = GDMA_LLI_OWNER_DMA;
+        gdma_link_get_owner(tx_unit->dma_link, tx_unit->loop_half_end_idx[half], &owner);
+        if (owner != GDMA_LLI_OWNER_CPU) {
+            break;
+        }
+        // give the items of the half back to the DMA, for the next round of the ring
+        uint32_t start_idx = half ? tx_unit->loop_half_end_idx[0] + 1 : 0;
+        for (uint32_t idx = start_idx; idx <= tx_unit->loop_half_end_idx[half]; idx++) {
+            gdma_link_set_owner(tx_unit->dma_link, idx, GDMA_LLI_OWNER_DMA);
+        }
+        tx_unit->loop_next_half = !half;
+
+        parlio_tx_loop_callback_t loop_cb = tx_unit->on_loop_half_done;
+        if (loop_cb) {
+            parlio_tx_loop_event_data_t edata = {
+                .buffer = half ? (const uint8_t *)t->payload + t->loop_half_size : t->payload,
+                .size = half ? t->payload_bits / 8 - t->loop_half_size : t->loop_half_size,
+            };
+            if (loop_cb(tx_unit, &edata, tx_unit->user_data)) {
+                need_yield = true;
+            }
+        }
+    }
+    return need_yield;
+}
+#endif // SOC_PARLIO_TX_SIZE_BY_DMA
+
 static void IRAM_ATTR parlio_tx_default_isr(void *args)
 {
     parlio_tx_unit_t *tx_unit = (parlio_tx_unit_t *)args;
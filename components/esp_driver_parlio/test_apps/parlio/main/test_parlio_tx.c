@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <inttypes.h>
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -274,3 +275,75 @@ TEST_CASE("parallel_tx_clock_gating", "[paralio_tx]")
     TEST_ESP_OK(parlio_del_tx_unit(tx_unit));
 }
 #endif // SOC_PARLIO_TX_CLK_SUPPORT_GATING
+
+#if SOC_PARLIO_TX_SIZE_BY_DMA
+typedef struct {
+    uint32_t half_done_count[2];
+    const void *payload;
+} test_parlio_loop_ctx_t;
+
+TEST_PARLIO_CALLBACK_ATTR
+static bool test_parlio_tx_loop_half_done_callback(parlio_tx_unit_handle_t tx_unit, const parlio_tx_loop_event_data_t *edata, void *user_ctx)
+{
+    test_parlio_loop_ctx_t *ctx = (test_parlio_loop_ctx_t *)user_ctx;
+    ctx->half_done_count[edata->buffer == ctx->payload ? 0 : 1]++;
+    return false;
+}
+
+TEST_CASE("parallel_tx_loop_transmission", "[parlio_tx]")
+{
+    printf("install parlio tx unit\r\n");
+    parlio_tx_unit_handle_t tx_unit = NULL;
+    parlio_tx_unit_config_t config = {
+        .clk_src = PARLIO_CLK_SRC_DEFAULT,
+        .data_width = 8,
+        .clk_in_gpio_num = -1,  // use internal clock source
+        .valid_gpio_num = -1,   // don't generate valid signal
+        .clk_out_gpio_num = TEST_CLK_GPIO,
+        .data_gpio_nums = {
+            TEST_DATA0_GPIO,
+            TEST_DATA1_GPIO,
+            TEST_DATA2_GPIO,
+            TEST_DATA3_GPIO,
+            TEST_DATA4_GPIO,
+            TEST_DATA5_GPIO,
+            TEST_DATA6_GPIO,
+            TEST_DATA7_GPIO,
+        },
+        .output_clk_freq_hz = 1 * 1000 * 1000,
+        .trans_queue_depth = 4,
+        .max_transfer_size = 256,
+        .bit_pack_order = PARLIO_BIT_PACK_ORDER_LSB,
+        .sample_edge = PARLIO_SAMPLE_EDGE_POS,
+    };
+    TEST_ESP_OK(parlio_new_tx_unit(&config, &tx_unit));
+
+    __attribute__((aligned(64))) static uint8_t payload[256] = {0};
+    for (int i = 0; i < 256; i++) {
+        payload[i] = i;
+    }
+    static test_parlio_loop_ctx_t loop_ctx = {};
+    loop_ctx.payload = payload;
+    parlio_tx_event_callbacks_t cbs = {
+        .on_loop_half_done = test_parlio_tx_loop_half_done_callback,
+    };
+    TEST_ESP_OK(parlio_tx_unit_register_event_callbacks(tx_unit, &cbs, &loop_ctx));
+    TEST_ESP_OK(parlio_tx_unit_enable(tx_unit));
+
+    printf("start loop transmission\r\n");
+    parlio_transmit_config_t transmit_config = {
+        .idle_value = 0x00,
+        .flags.loop_transmission = true,
+    };
+    TEST_ESP_OK(parlio_tx_unit_transmit(tx_unit, payload, sizeof(payload) * 8, &transmit_config));
+    // at 1MHz, each half of 128 bytes takes 128us
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ESP_OK(parlio_tx_unit_disable(tx_unit));
+    printf("half done count: %"PRIu32", %"PRIu32"\r\n", loop_ctx.half_done_count[0], loop_ctx.half_done_count[1]);
+    // the loop never ends by itself, both halves should have been transmitted many rounds
+    TEST_ASSERT_GREATER_THAN(100, loop_ctx.half_done_count[0]);
+    TEST_ASSERT_INT_WITHIN(1, loop_ctx.half_done_count[0], loop_ctx.half_done_count[1]);
+
+    TEST_ESP_OK(parlio_del_tx_unit(tx_unit));
+}
+#endif // SOC_PARLIO_TX_SIZE_BY_DMA
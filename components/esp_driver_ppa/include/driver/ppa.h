@@ -287,6 +287,99 @@ typedef struct {
  */
 esp_err_t ppa_do_fill(ppa_client_handle_t ppa_client, const ppa_fill_oper_config_t *config);
 
+/**
+ * @brief Type of PPA operation list handle
+ */
+typedef struct ppa_oper_list_t *ppa_oper_list_handle_t;
+
+/**
+ * @brief Type of PPA operation list done callback
+ *
+ * @param[in] oper_list PPA operation list handle
+ * @param[in] event_data PPA event data
+ * @param[in] user_data User registered data from calling `ppa_do_oper_list`
+ *
+ * @return Whether a task switch is needed after the callback function returns, this is usually due to the callback
+ *         wakes up some high priority task.
+ */
+typedef bool (*ppa_oper_list_callback_t)(ppa_oper_list_handle_t oper_list, ppa_event_data_t *event_data, void *user_data);
+
+/**
+ * @brief A collection of configuration items for creating a PPA operation list
+ */
+typedef struct {
+    uint32_t max_oper_num;                      /*!< The maximum number of operations in one submission of the list */
+    ppa_oper_list_callback_t on_list_done;      /*!< Invoked when all the operations of a submission finish, can be NULL */
+} ppa_oper_list_config_t;
+
+/**
+ * @brief One operation in a PPA operation list
+ */
+typedef struct {
+    ppa_client_handle_t client;                 /*!< PPA client handle to perform the operation, the operation type follows the client */
+    union {
+        const ppa_srm_oper_config_t *srm_config;        /*!< Configurations of the operation, if the client is for SRM operations */
+        const ppa_blend_oper_config_t *blend_config;    /*!< Configurations of the operation, if the client is for blend operations */
+        const ppa_fill_oper_config_t *fill_config;      /*!< Configurations of the operation, if the client is for fill operations */
+    };
+    bool depend_on_prev;                        /*!< Whether the operation can only start after the previous operation in the list finishes,
+                                                     e.g. it reads the output of the previous operation.
+                                                     Otherwise, it may run at the same time as the previous operation on the other PPA engine */
+} ppa_oper_list_item_t;
+
+/**
+ * @brief Create a PPA operation list, which submits a sequence of PPA operations at once
+ *
+ * @param[in] config Pointer to a collection of configurations for the operation list
+ * @param[out] ret_oper_list Returned operation list handle
+ *
+ * @return
+ *      - ESP_OK: Create the operation list successfully
+ *      - ESP_ERR_INVALID_ARG: Create the operation list failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Create the operation list failed because out of memory
+ */
+esp_err_t ppa_new_oper_list(const ppa_oper_list_config_t *config, ppa_oper_list_handle_t *ret_oper_list);
+
+/**
+ * @brief Delete a PPA operation list
+ *
+ * @param[in] oper_list PPA operation list handle, allocated by `ppa_new_oper_list`
+ *
+ * @return
+ *      - ESP_OK: Delete the operation list successfully
+ *      - ESP_ERR_INVALID_ARG: Delete the operation list failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Delete the operation list failed because its operations are not finished
+ */
+esp_err_t ppa_del_oper_list(ppa_oper_list_handle_t oper_list);
+
+/**
+ * @brief Perform a sequence of PPA operations with one submission
+ *
+ * All the operations are checked and prepared before the first one starts. Each following operation is started from
+ * the interrupt context as soon as the operation it depends on finishes, so there's no task round trip between the operations.
+ * Operations on different PPA engines (SRM, and blend/fill) overlap if they don't depend on each other.
+ *
+ * @note The `mode` and `user_data` of the operation configurations are ignored, as well as the `on_trans_done` callbacks
+ *       of the clients. The completion of the whole sequence is reported by the `on_list_done` callback of the list instead.
+ * @note Each client takes one of its pending transaction slots per operation in the list until the operation finishes,
+ *       so its `max_pending_trans_num` has to be no less than the number of its operations in the list.
+ * @note The clients must not be unregistered until the operations of the list finish.
+ *
+ * @param[in] oper_list PPA operation list handle
+ * @param[in] items Array of the operations, in the order to be performed, the array can be released once the function returns
+ * @param[in] num_items Number of the operations, no more than `max_oper_num`
+ * @param[in] mode Determines whether to block until all the operations finish, see `ppa_trans_mode_t`
+ * @param[in] user_data User registered data to be passed into `on_list_done` callback function
+ *
+ * @return
+ *      - ESP_OK: Perform the operations successfully
+ *      - ESP_ERR_INVALID_ARG: Perform the operations failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Perform the operations failed because the previous submission of the list is not finished
+ *      - ESP_FAIL: Perform the operations failed because a client's pending transactions has reached its maximum capacity,
+ *                  or some operations failed to start
+ */
+esp_err_t ppa_do_oper_list(ppa_oper_list_handle_t oper_list, const ppa_oper_list_item_t *items, uint32_t num_items, ppa_trans_mode_t mode, void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -372,6 +372,7 @@ static bool ppa_malloc_transaction(QueueHandle_t trans_elm_ptr_queue, uint32_t t
         trans_on_picked_desc->trans_elm = new_trans_elm;
         dma_trans_desc->user_config = (void *)trans_on_picked_desc;
         dma_trans_desc->on_job_picked = ppa_oper_trans_on_picked_func[oper_type];
+        dma_trans_desc->client = DMA2D_CLIENT_PPA;
         new_trans_elm->trans_desc = dma_trans_desc;
         new_trans_elm->dma_trans_placeholder = dma_trans_elm;
         new_trans_elm->sem = ppa_trans_sem;
@@ -398,6 +399,7 @@ bool ppa_recycle_transaction(ppa_client_handle_t ppa_client, ppa_trans_t *trans_
     // Reset transaction and send back to client's trans_elm_ptr_queue
     // TODO: To be very safe, we shall memset all to 0, and reconnect necessary pointers?
     BaseType_t HPTaskAwoken;
+    trans_elm->oper_list = NULL;
     BaseType_t sent = xQueueSendFromISR(ppa_client->trans_elm_ptr_queue, &trans_elm, &HPTaskAwoken);
     assert(sent);
     return HPTaskAwoken;
@@ -463,6 +465,60 @@ err:
     return ret;
 }
 
+// This function never blocks, it is allowed to be called in ISR
+esp_err_t ppa_do_operation_no_wait(ppa_engine_t *ppa_engine_base, ppa_trans_t *trans_elm, bool *need_yield)
+{
+    esp_err_t ret = ESP_OK;
+    esp_err_t pm_lock_ret __attribute__((unused));
+    BaseType_t HPTaskAwoken = pdFALSE;
+
+    // Send transaction into PPA engine queue, the caller is responsible for the client's pending transaction count
+    portENTER_CRITICAL_SAFE(&ppa_engine_base->spinlock);
+    STAILQ_INSERT_TAIL(&ppa_engine_base->trans_stailq, trans_elm, entry);
+    portEXIT_CRITICAL_SAFE(&ppa_engine_base->spinlock);
+
+    BaseType_t taken = xPortInIsrContext() ? xSemaphoreTakeFromISR(ppa_engine_base->sem, &HPTaskAwoken) : xSemaphoreTake(ppa_engine_base->sem, 0);
+    *need_yield = (HPTaskAwoken == pdTRUE);
+    if (taken == pdTRUE) {
+        // Same as ppa_do_operation, the transaction may have been started and completed by the transaction chain already
+        bool found = false;
+        ppa_trans_t *temp = NULL;
+        portENTER_CRITICAL_SAFE(&ppa_engine_base->spinlock);
+        STAILQ_FOREACH(temp, &ppa_engine_base->trans_stailq, entry) {
+            if (temp == trans_elm) {
+                found = true;
+                break;
+            }
+        }
+        portEXIT_CRITICAL_SAFE(&ppa_engine_base->spinlock);
+        if (found) {
+#if CONFIG_PM_ENABLE
+            pm_lock_ret = esp_pm_lock_acquire(ppa_engine_base->pm_lock);
+            assert((pm_lock_ret == ESP_OK) && "acquire pm_lock failed");
+#endif
+            ret = ppa_dma2d_enqueue(trans_elm);
+            if (ret != ESP_OK) {
+                portENTER_CRITICAL_SAFE(&ppa_engine_base->spinlock);
+                STAILQ_REMOVE(&ppa_engine_base->trans_stailq, trans_elm, ppa_trans_s, entry);
+                portEXIT_CRITICAL_SAFE(&ppa_engine_base->spinlock);
+#if CONFIG_PM_ENABLE
+                pm_lock_ret = esp_pm_lock_release(ppa_engine_base->pm_lock);
+                assert((pm_lock_ret == ESP_OK) && "release pm_lock failed");
+#endif
+            }
+        }
+        if (!found || ret != ESP_OK) {
+            if (xPortInIsrContext()) {
+                xSemaphoreGiveFromISR(ppa_engine_base->sem, &HPTaskAwoken);
+                *need_yield |= (HPTaskAwoken == pdTRUE);
+            } else {
+                xSemaphoreGive(ppa_engine_base->sem);
+            }
+        }
+    }
+    return ret;
+}
+
 bool ppa_transaction_done_cb(dma2d_channel_handle_t dma2d_chan, dma2d_event_data_t *event_data, void *user_data)
 {
     bool need_yield = false;
@@ -474,6 +530,8 @@ bool ppa_transaction_done_cb(dma2d_channel_handle_t dma2d_chan, dma2d_event_data
     // Save callback contexts
     ppa_event_callback_t done_cb = client->done_cb;
     void *trans_elm_user_data = trans_elm->user_data;
+    ppa_oper_list_t *oper_list = trans_elm->oper_list;
+    uint32_t oper_list_index = trans_elm->oper_list_index;
 
     ppa_trans_t *next_start_trans = NULL;
     portENTER_CRITICAL_ISR(&engine_base->spinlock);
@@ -505,8 +563,10 @@ bool ppa_transaction_done_cb(dma2d_channel_handle_t dma2d_chan, dma2d_event_data
 #endif
     }
 
-    // Process last transaction's callback
-    if (done_cb) {
+    // Process last transaction's callback, a transaction of an operation list reports to the list instead
+    if (oper_list) {
+        need_yield |= ppa_oper_list_on_trans_done(oper_list, oper_list_index);
+    } else if (done_cb) {
         ppa_event_data_t edata = {};
         need_yield |= done_cb(client, &edata, trans_elm_user_data);
     }
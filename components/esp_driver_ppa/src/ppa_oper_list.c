@@ -0,0 +1,221 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/idf_additions.h"
+#include "esp_heap_caps.h"
+#include "driver/ppa.h"
+#include "ppa_priv.h"
+
+static const char *TAG = "ppa_oper_list";
+
+esp_err_t ppa_new_oper_list(const ppa_oper_list_config_t *config, ppa_oper_list_handle_t *ret_oper_list)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_oper_list && config->max_oper_num, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    ppa_oper_list_t *oper_list = (ppa_oper_list_t *)heap_caps_calloc(1, sizeof(ppa_oper_list_t) + config->max_oper_num * sizeof(oper_list->opers[0]),
+                                                                     PPA_MEM_ALLOC_CAPS);
+    ESP_RETURN_ON_FALSE(oper_list, ESP_ERR_NO_MEM, TAG, "no mem for operation list");
+    oper_list->sem = xSemaphoreCreateBinaryWithCaps(PPA_MEM_ALLOC_CAPS);
+    ESP_GOTO_ON_FALSE(oper_list->sem, ESP_ERR_NO_MEM, err, TAG, "no mem for operation list semaphore");
+
+    oper_list->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    oper_list->max_oper_num = config->max_oper_num;
+    oper_list->done_cb = config->on_list_done;
+    *ret_oper_list = oper_list;
+    return ESP_OK;
+
+err:
+    free(oper_list);
+    return ret;
+}
+
+esp_err_t ppa_del_oper_list(ppa_oper_list_handle_t oper_list)
+{
+    ESP_RETURN_ON_FALSE(oper_list, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    bool busy = false;
+    portENTER_CRITICAL(&oper_list->spinlock);
+    busy = oper_list->busy;
+    portEXIT_CRITICAL(&oper_list->spinlock);
+    ESP_RETURN_ON_FALSE(!busy, ESP_ERR_INVALID_STATE, TAG, "operation list still has unfinished operations");
+
+    vSemaphoreDeleteWithCaps(oper_list->sem);
+    free(oper_list);
+    return ESP_OK;
+}
+
+// Mark an operation as finished, return whether all the operations of the submission have finished
+static bool ppa_oper_list_mark_done(ppa_oper_list_t *oper_list, uint32_t index)
+{
+    bool all_done = false;
+    portENTER_CRITICAL_SAFE(&oper_list->spinlock);
+    oper_list->opers[index].done = true;
+    oper_list->done_cnt++;
+    all_done = (oper_list->done_cnt == oper_list->oper_num);
+    portEXIT_CRITICAL_SAFE(&oper_list->spinlock);
+    return all_done;
+}
+
+static bool ppa_oper_list_finish(ppa_oper_list_t *oper_list)
+{
+    bool need_yield = false;
+    BaseType_t HPTaskAwoken = pdFALSE;
+    // Save callback contexts, the list can be submitted again once it is not busy
+    ppa_oper_list_callback_t done_cb = oper_list->done_cb;
+    void *user_data = oper_list->user_data;
+
+    portENTER_CRITICAL_SAFE(&oper_list->spinlock);
+    oper_list->busy = false;
+    portEXIT_CRITICAL_SAFE(&oper_list->spinlock);
+
+    // Release list semaphore to unblock ppa_do_oper_list
+    xSemaphoreGiveFromISR(oper_list->sem, &HPTaskAwoken);
+    need_yield |= (HPTaskAwoken == pdTRUE);
+
+    if (done_cb) {
+        ppa_event_data_t edata = {};
+        need_yield |= done_cb(oper_list, &edata, user_data);
+    }
+    return need_yield;
+}
+
+// Start the operations whose dependency is satisfied, in the order of the list
+// This function is allowed to be called in ISR
+static bool ppa_oper_list_start_pending(ppa_oper_list_t *oper_list)
+{
+    bool need_yield = false;
+    while (true) {
+        ppa_trans_t *trans_elm = NULL;
+        uint32_t index = 0;
+        portENTER_CRITICAL_SAFE(&oper_list->spinlock);
+        index = oper_list->next_start_idx;
+        if (index < oper_list->oper_num &&
+                (!oper_list->opers[index].depend_on_prev || oper_list->opers[index - 1].done)) {
+            trans_elm = oper_list->opers[index].trans_elm;
+            oper_list->next_start_idx++;
+        }
+        portEXIT_CRITICAL_SAFE(&oper_list->spinlock);
+        if (!trans_elm) {
+            break;
+        }
+
+        ppa_client_t *client = trans_elm->client;
+        bool yield = false;
+        esp_err_t ret = ppa_do_operation_no_wait(client->engine, trans_elm, &yield);
+        need_yield |= yield;
+        if (ret != ESP_OK) {
+            // Count the operation as finished, so that the rest of the list won't wait forever
+            portENTER_CRITICAL_SAFE(&oper_list->spinlock);
+            oper_list->failed = true;
+            portEXIT_CRITICAL_SAFE(&oper_list->spinlock);
+            portENTER_CRITICAL_SAFE(&client->spinlock);
+            client->trans_cnt--;
+            portEXIT_CRITICAL_SAFE(&client->spinlock);
+            need_yield |= ppa_recycle_transaction(client, trans_elm);
+            if (ppa_oper_list_mark_done(oper_list, index)) {
+                need_yield |= ppa_oper_list_finish(oper_list);
+                break;
+            }
+        }
+    }
+    return need_yield;
+}
+
+bool ppa_oper_list_on_trans_done(ppa_oper_list_t *oper_list, uint32_t index)
+{
+    if (ppa_oper_list_mark_done(oper_list, index)) {
+        return ppa_oper_list_finish(oper_list);
+    }
+    return ppa_oper_list_start_pending(oper_list);
+}
+
+esp_err_t ppa_do_oper_list(ppa_oper_list_handle_t oper_list, const ppa_oper_list_item_t *items, uint32_t num_items, ppa_trans_mode_t mode, void *user_data)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(oper_list && items && num_items, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(num_items <= oper_list->max_oper_num, ESP_ERR_INVALID_ARG, TAG, "exceed max_oper_num of the list");
+    ESP_RETURN_ON_FALSE(mode <= PPA_TRANS_MODE_NON_BLOCKING, ESP_ERR_INVALID_ARG, TAG, "invalid mode");
+    for (uint32_t i = 0; i < num_items; i++) {
+        ESP_RETURN_ON_FALSE(items[i].client && items[i].srm_config, ESP_ERR_INVALID_ARG, TAG, "invalid operation %"PRIu32, i);
+    }
+
+    bool busy = false;
+    portENTER_CRITICAL(&oper_list->spinlock);
+    busy = oper_list->busy;
+    oper_list->busy = true;
+    portEXIT_CRITICAL(&oper_list->spinlock);
+    ESP_RETURN_ON_FALSE(!busy, ESP_ERR_INVALID_STATE, TAG, "previous submission of the list not finished");
+
+    // Check and prepare all the operations before starting any of them, so that the list either runs entirely or not at all
+    uint32_t prepared_num = 0;
+    for (; prepared_num < num_items; prepared_num++) {
+        const ppa_oper_list_item_t *item = &items[prepared_num];
+        ppa_trans_t *trans_elm = NULL;
+        switch (item->client->oper_type) {
+        case PPA_OPERATION_SRM:
+            ret = ppa_srm_prepare_transaction(item->client, item->srm_config, &trans_elm);
+            break;
+        case PPA_OPERATION_BLEND:
+            ret = ppa_blend_prepare_transaction(item->client, item->blend_config, &trans_elm);
+            break;
+        case PPA_OPERATION_FILL:
+            ret = ppa_fill_prepare_transaction(item->client, item->fill_config, &trans_elm);
+            break;
+        default:
+            ret = ESP_ERR_INVALID_ARG;
+            break;
+        }
+        ESP_GOTO_ON_ERROR(ret, err, TAG, "prepare operation %"PRIu32" failed", prepared_num);
+
+        trans_elm->oper_list = oper_list;
+        trans_elm->oper_list_index = prepared_num;
+        oper_list->opers[prepared_num].trans_elm = trans_elm;
+        oper_list->opers[prepared_num].depend_on_prev = (prepared_num > 0) && item->depend_on_prev;
+        oper_list->opers[prepared_num].done = false;
+        // The prepared transaction counts as pending, which prevents the client from being unregistered
+        portENTER_CRITICAL(&item->client->spinlock);
+        item->client->trans_cnt++;
+        portEXIT_CRITICAL(&item->client->spinlock);
+    }
+
+    oper_list->oper_num = num_items;
+    oper_list->next_start_idx = 0;
+    oper_list->done_cnt = 0;
+    oper_list->failed = false;
+    oper_list->user_data = user_data;
+    xSemaphoreTake(oper_list->sem, 0); // Ensure no list semaphore before the operations start
+
+    ppa_oper_list_start_pending(oper_list);
+
+    if (mode == PPA_TRANS_MODE_BLOCKING) {
+        xSemaphoreTake(oper_list->sem, portMAX_DELAY); // Given in the ISR
+        ESP_RETURN_ON_FALSE(!oper_list->failed, ESP_FAIL, TAG, "some operations failed to start");
+    }
+    return ESP_OK;
+
+err:
+    for (uint32_t i = 0; i < prepared_num; i++) {
+        ppa_trans_t *trans_elm = oper_list->opers[i].trans_elm;
+        ppa_client_t *client = trans_elm->client;
+        portENTER_CRITICAL(&client->spinlock);
+        client->trans_cnt--;
+        portEXIT_CRITICAL(&client->spinlock);
+        ppa_recycle_transaction(client, trans_elm);
+    }
+    portENTER_CRITICAL(&oper_list->spinlock);
+    oper_list->busy = false;
+    portEXIT_CRITICAL(&oper_list->spinlock);
+    return ret;
+}
@@ -183,6 +183,8 @@ typedef struct {
 
 /***************************** TRANSACTION ***********************************/
 
+typedef struct ppa_oper_list_t ppa_oper_list_t;
+
 // PPA transaction element
 typedef struct ppa_trans_s {
     STAILQ_ENTRY(ppa_trans_s) entry;              // Link entry
@@ -191,6 +193,8 @@ typedef struct ppa_trans_s {
     SemaphoreHandle_t sem;                        // Semaphore to block when the transaction has not finished
     ppa_client_t *client;                         // Pointer to the client who requested the transaction
     void *user_data;                              // User registered event data (per transaction)
+    ppa_oper_list_t *oper_list;                   // Pointer to the operation list that the transaction belongs to, NULL if it is submitted alone
+    uint32_t oper_list_index;                     // Index of the transaction in the operation list
 } ppa_trans_t;
 
 typedef struct {
@@ -215,6 +219,34 @@ bool ppa_transaction_done_cb(dma2d_channel_handle_t dma2d_chan, dma2d_event_data
 
 bool ppa_recycle_transaction(ppa_client_handle_t ppa_client, ppa_trans_t *trans_elm);
 
+esp_err_t ppa_srm_prepare_transaction(ppa_client_handle_t ppa_client, const ppa_srm_oper_config_t *config, ppa_trans_t **ret_trans_elm);
+esp_err_t ppa_blend_prepare_transaction(ppa_client_handle_t ppa_client, const ppa_blend_oper_config_t *config, ppa_trans_t **ret_trans_elm);
+esp_err_t ppa_fill_prepare_transaction(ppa_client_handle_t ppa_client, const ppa_fill_oper_config_t *config, ppa_trans_t **ret_trans_elm);
+
+/******************************* OPERATION LIST *******************************/
+
+struct ppa_oper_list_t {
+    portMUX_TYPE spinlock;                        // Operation list level spinlock
+    SemaphoreHandle_t sem;                        // Semaphore to block when the operations have not finished
+    ppa_oper_list_callback_t done_cb;             // Operation list done callback
+    void *user_data;                              // User registered event data (per submission)
+    bool busy;                                    // Whether a submission of the list is in progress
+    bool failed;                                  // Whether any operation of the submission failed to start
+    uint32_t max_oper_num;                        // Maximum number of operations in one submission
+    uint32_t oper_num;                            // Number of operations in the current submission
+    uint32_t next_start_idx;                      // Index of the next operation to be started
+    uint32_t done_cnt;                            // Number of finished operations
+    struct {
+        ppa_trans_t *trans_elm;                   // Pointer to the prepared transaction element
+        bool depend_on_prev;                      // Whether the operation waits for the previous one to finish
+        bool done;                                // Whether the operation has finished
+    } opers[];
+};
+
+esp_err_t ppa_do_operation_no_wait(ppa_engine_t *ppa_engine_base, ppa_trans_t *trans_elm, bool *need_yield);
+
+bool ppa_oper_list_on_trans_done(ppa_oper_list_t *oper_list, uint32_t index);
+
 /****************************** PPA DRIVER ***********************************/
 
 struct ppa_platform_t {
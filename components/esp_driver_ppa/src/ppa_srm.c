@@ -167,7 +167,7 @@ bool ppa_srm_transaction_on_picked(uint32_t num_chans, const dma2d_trans_channel
     return false;
 }
 
-esp_err_t ppa_do_scale_rotate_mirror(ppa_client_handle_t ppa_client, const ppa_srm_oper_config_t *config)
+esp_err_t ppa_srm_prepare_transaction(ppa_client_handle_t ppa_client, const ppa_srm_oper_config_t *config, ppa_trans_t **ret_trans_elm)
 {
     ESP_RETURN_ON_FALSE(ppa_client && config, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
     ESP_RETURN_ON_FALSE(ppa_client->oper_type == PPA_OPERATION_SRM, ESP_ERR_INVALID_ARG, TAG, "client is not for SRM operations");
@@ -280,14 +280,21 @@ esp_err_t ppa_do_scale_rotate_mirror(ppa_client_handle_t ppa_client, const ppa_s
         trans_elm->client = ppa_client;
         trans_elm->user_data = config->user_data;
         xSemaphoreTake(trans_elm->sem, 0); // Ensure no transaction semaphore before transaction starts
-
-        ret = ppa_do_operation(ppa_client, ppa_client->engine, trans_elm, config->mode);
-        if (ret != ESP_OK) {
-            ppa_recycle_transaction(ppa_client, trans_elm);
-        }
+        *ret_trans_elm = trans_elm;
     } else {
         ret = ESP_FAIL;
         ESP_LOGE(TAG, "exceed maximum pending transactions for the client, consider increase max_pending_trans_num");
     }
     return ret;
 }
+
+esp_err_t ppa_do_scale_rotate_mirror(ppa_client_handle_t ppa_client, const ppa_srm_oper_config_t *config)
+{
+    ppa_trans_t *trans_elm = NULL;
+    ESP_RETURN_ON_ERROR(ppa_srm_prepare_transaction(ppa_client, config, &trans_elm), TAG, "prepare SRM transaction failed");
+    esp_err_t ret = ppa_do_operation(ppa_client, ppa_client->engine, trans_elm, config->mode);
+    if (ret != ESP_OK) {
+        ppa_recycle_transaction(ppa_client, trans_elm);
+    }
+    return ret;
+}
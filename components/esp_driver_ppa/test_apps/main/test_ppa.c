@@ -531,6 +531,121 @@ TEST_CASE("ppa_fill_basic_data_correctness_check", "[PPA]")
     free(out_buf);
 }
 
+static bool ppa_oper_list_done_cb(ppa_oper_list_handle_t oper_list, ppa_event_data_t *event_data, void *user_data)
+{
+    SemaphoreHandle_t sem = (SemaphoreHandle_t)user_data;
+    BaseType_t high_task_wakeup = pdFALSE;
+    xSemaphoreGiveFromISR(sem, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+}
+
+TEST_CASE("ppa_oper_list_fill_srm_fill_chain", "[PPA]")
+{
+    const uint32_t w = 32;
+    const uint32_t h = 32;
+    const ppa_fill_color_mode_t cm = PPA_FILL_COLOR_MODE_RGB565;
+    const color_pixel_argb8888_data_t bg_color = {.a = 0xFF, .r = 0xFF, .g = 0x00, .b = 0x00};
+    const color_pixel_argb8888_data_t overlay_color = {.a = 0xFF, .r = 0x00, .g = 0x00, .b = 0xFF};
+
+    const uint32_t buf_len = w * h * sizeof(uint16_t);
+    uint32_t buf_size = ALIGN_UP(buf_len, 64);
+    uint8_t *mid_buf = heap_caps_aligned_calloc(64, buf_size, sizeof(uint8_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+    uint8_t *out_buf = heap_caps_aligned_calloc(64, buf_size, sizeof(uint8_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(mid_buf);
+    TEST_ASSERT_NOT_NULL(out_buf);
+
+    ppa_client_handle_t srm_client;
+    ppa_client_handle_t fill_client;
+    ppa_client_config_t ppa_client_config = {
+        .oper_type = PPA_OPERATION_SRM,
+        .max_pending_trans_num = 1,
+    };
+    TEST_ESP_OK(ppa_register_client(&ppa_client_config, &srm_client));
+    ppa_client_config.oper_type = PPA_OPERATION_FILL;
+    ppa_client_config.max_pending_trans_num = 2; // two fill operations in the list
+    TEST_ESP_OK(ppa_register_client(&ppa_client_config, &fill_client));
+
+    ppa_oper_list_handle_t oper_list;
+    ppa_oper_list_config_t oper_list_config = {
+        .max_oper_num = 3,
+        .on_list_done = ppa_oper_list_done_cb,
+    };
+    TEST_ESP_OK(ppa_new_oper_list(&oper_list_config, &oper_list));
+
+    // Fill the whole intermediate picture with the background color
+    ppa_fill_oper_config_t bg_fill_config = {
+        .out.buffer = mid_buf,
+        .out.buffer_size = buf_size,
+        .out.pic_w = w,
+        .out.pic_h = h,
+        .out.fill_cm = cm,
+        .fill_block_w = w,
+        .fill_block_h = h,
+        .fill_argb_color = bg_color,
+    };
+    // Copy the intermediate picture to the output picture
+    ppa_srm_oper_config_t srm_config = {
+        .in.buffer = mid_buf,
+        .in.pic_w = w,
+        .in.pic_h = h,
+        .in.block_w = w,
+        .in.block_h = h,
+        .in.srm_cm = PPA_SRM_COLOR_MODE_RGB565,
+        .out.buffer = out_buf,
+        .out.buffer_size = buf_size,
+        .out.pic_w = w,
+        .out.pic_h = h,
+        .out.srm_cm = PPA_SRM_COLOR_MODE_RGB565,
+        .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
+        .scale_x = 1.0,
+        .scale_y = 1.0,
+    };
+    // Fill the top half of the output picture with the overlay color
+    ppa_fill_oper_config_t overlay_fill_config = {
+        .out.buffer = out_buf,
+        .out.buffer_size = buf_size,
+        .out.pic_w = w,
+        .out.pic_h = h,
+        .out.fill_cm = cm,
+        .fill_block_w = w,
+        .fill_block_h = h / 2,
+        .fill_argb_color = overlay_color,
+    };
+    ppa_oper_list_item_t items[] = {
+        { .client = fill_client, .fill_config = &bg_fill_config },
+        { .client = srm_client, .srm_config = &srm_config, .depend_on_prev = true },
+        { .client = fill_client, .fill_config = &overlay_fill_config, .depend_on_prev = true },
+    };
+
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(sem);
+    for (int round = 0; round < 2; round++) {
+        memset(out_buf, 0, buf_len);
+        esp_cache_msync((void *)out_buf, buf_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+        // The first round waits for the callback, the second round blocks inside the function
+        ppa_trans_mode_t mode = (round == 0) ? PPA_TRANS_MODE_NON_BLOCKING : PPA_TRANS_MODE_BLOCKING;
+        TEST_ESP_OK(ppa_do_oper_list(oper_list, items, sizeof(items) / sizeof(items[0]), mode, sem));
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(sem, pdMS_TO_TICKS(1000)));
+        // Only one completion event for the whole list
+        TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(sem, pdMS_TO_TICKS(10)));
+
+        const color_pixel_rgb565_data_t bg_pixel = {.r = bg_color.r >> 3, .g = bg_color.g >> 2, .b = bg_color.b >> 3};
+        const color_pixel_rgb565_data_t overlay_pixel = {.r = overlay_color.r >> 3, .g = overlay_color.g >> 2, .b = overlay_color.b >> 3};
+        TEST_ASSERT_EACH_EQUAL_UINT16(overlay_pixel.val, (void *)out_buf, w * h / 2);
+        TEST_ASSERT_EACH_EQUAL_UINT16(bg_pixel.val, (void *)(out_buf + buf_len / 2), w * h / 2);
+    }
+
+    // The list is too short for the operations
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, ppa_do_oper_list(oper_list, items, 4, PPA_TRANS_MODE_BLOCKING, NULL));
+
+    TEST_ESP_OK(ppa_del_oper_list(oper_list));
+    TEST_ESP_OK(ppa_unregister_client(srm_client));
+    TEST_ESP_OK(ppa_unregister_client(fill_client));
+    vSemaphoreDelete(sem);
+    free(mid_buf);
+    free(out_buf);
+}
+
 /* All performance tests are tested under the following situations:
  * - Testing PPA speed where in_buffer(s) and out_buffer all located in PSRAM
  * - Only 2D-DMA is using PSRAM
@@ -116,8 +116,11 @@ typedef struct {
     rmt_symbol_word_t bit0; /*!< How to represent BIT0 in RMT symbol */
     rmt_symbol_word_t bit1; /*!< How to represent BIT1 in RMT symbol */
     struct {
-        uint32_t msb_first: 1; /*!< Whether to encode MSB bit first */
-    } flags;                   /*!< Encoder config flag */
+        uint32_t msb_first: 1;         /*!< Whether to encode MSB bit first */
+        uint32_t with_symbol_table: 1; /*!< Pre-encode all the 256 byte values into a symbol table (8 KB),
+                                            so that the ISR copies 8 symbols per byte instead of encoding bit by bit.
+                                            Useful for transmitting a huge amount of bytes, e.g., driving a large LED strip. */
+    } flags;                           /*!< Encoder config flag */
 } rmt_bytes_encoder_config_t;
 
 /**
@@ -156,6 +159,7 @@ esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t *config, rmt_en
  *
  * @note The configurations of the bytes encoder is also set up by `rmt_new_bytes_encoder()`.
  *       This function is used to update the configuration of the bytes encoder at runtime.
+ * @note If the encoder was created with a symbol table, the table is rebuilt from the new configuration. The `with_symbol_table` flag itself can't be changed.
  *
  * @param[in] bytes_encoder Bytes encoder handle, created by e.g `rmt_new_bytes_encoder()`
  * @param[in] config Bytes encoder configuration
@@ -58,9 +58,24 @@ typedef struct {
     struct extra_rmt_receive_flags {
         uint32_t en_partial_rx: 1; /*!< Set this flag if the incoming data is very long, and the driver can only receive the data piece by piece,
                                         because the user buffer is not sufficient to save all the data. */
+        uint32_t en_continuous_rx: 1; /*!< Set this flag to keep receiving frames until the channel is disabled by `rmt_disable()`.
+                                           The receiver is restarted right after each frame, without calling `rmt_receive()` again. */
     } flags;                       /*!< Receive specific config flags */
 } rmt_receive_config_t;
 
+/**
+ * @brief RMT RX bit decoder configuration
+ */
+typedef struct {
+    rmt_symbol_word_t bit0; /*!< How to represent BIT0 in RMT symbol */
+    rmt_symbol_word_t bit1; /*!< How to represent BIT1 in RMT symbol */
+    uint16_t tolerance;     /*!< Maximum difference between a received duration and the expected one, in RMT ticks */
+    /// Bit decoder specific flags
+    struct {
+        uint32_t msb_first: 1; /*!< Whether the first received bit is the MSB of a byte */
+    } flags;                   /*!< Bit decoder config flags */
+} rmt_rx_bit_decoder_config_t;
+
 /**
  * @brief Create a RMT RX channel
  *
@@ -113,6 +128,28 @@ esp_err_t rmt_receive(rmt_channel_handle_t rx_channel, void *buffer, size_t buff
  */
 esp_err_t rmt_rx_register_event_callbacks(rmt_channel_handle_t rx_channel, const rmt_rx_event_callbacks_t *cbs, void *user_data);
 
+/**
+ * @brief Decode the received RMT symbols into bits, each symbol carries one bit
+ *
+ * @note This function is supposed to be called in the `on_recv_done` callback, so that the received frame can be checked without a copy.
+ *       It will be placed in IRAM if CONFIG_RMT_ISR_IRAM_SAFE is enabled.
+ * @note The second half of the last symbol is ignored if its duration is zero, i.e., it is merged into the idle level.
+ *
+ * @param[in] config Bit decoder configurations
+ * @param[in] symbols The received RMT symbols
+ * @param[in] num_symbols Number of the received RMT symbols
+ * @param[out] data Buffer to save the decoded bits
+ * @param[in] data_size Size of the `data` buffer, in bytes
+ * @param[out] ret_num_bits Number of decoded bits, also returned when an error happens
+ * @return
+ *      - ESP_OK: All the symbols are decoded successfully
+ *      - ESP_ERR_INVALID_ARG: Decode failed because of invalid argument
+ *      - ESP_ERR_INVALID_RESPONSE: Decode stopped because a symbol matches neither BIT0 nor BIT1
+ *      - ESP_ERR_INVALID_SIZE: Decode stopped because the `data` buffer is full
+ */
+esp_err_t rmt_rx_decode_bits(const rmt_rx_bit_decoder_config_t *config, const rmt_symbol_word_t *symbols, size_t num_symbols,
+                             uint8_t *data, size_t data_size, size_t *ret_num_bits);
+
 #ifdef __cplusplus
 }
 #endif
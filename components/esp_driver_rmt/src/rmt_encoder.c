@@ -28,6 +28,7 @@ typedef struct rmt_bytes_encoder_t {
     size_t last_byte_index; // index of the encoding byte in the primary stream
     rmt_symbol_word_t bit0; // bit zero representing
     rmt_symbol_word_t bit1; // bit one representing
+    rmt_symbol_word_t (*symbol_table)[8]; // pre-encoded symbols of each byte value, optional
     struct {
         uint32_t msb_first: 1; // encode MSB firstly
     } flags;
@@ -59,6 +60,16 @@ static esp_err_t rmt_bytes_encoder_reset(rmt_encoder_t *encoder)
     return ESP_OK;
 }
 
+static void rmt_bytes_encoder_build_symbol_table(rmt_bytes_encoder_t *bytes_encoder)
+{
+    for (int value = 0; value < 256; value++) {
+        for (int i = 0; i < 8; i++) {
+            int bit = bytes_encoder->flags.msb_first ? (value >> (7 - i)) & 0x01 : (value >> i) & 0x01;
+            bytes_encoder->symbol_table[value][i] = bit ? bytes_encoder->bit1 : bytes_encoder->bit0;
+        }
+    }
+}
+
 static size_t IRAM_ATTR rmt_encode_bytes(rmt_encoder_t *encoder, rmt_channel_handle_t channel,
                                          const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state)
 {
@@ -98,6 +109,16 @@ static size_t IRAM_ATTR rmt_encode_bytes(rmt_encoder_t *encoder, rmt_channel_han
 
     size_t len = encode_len;
     while (len > 0) {
+        if (bytes_encoder->symbol_table && bit_index == 0 && len >= 8) {
+            // the whole byte fits in the memory, copy its symbols from the table
+            const rmt_symbol_word_t *symbols = bytes_encoder->symbol_table[raw_data[byte_index]];
+            for (int i = 0; i < 8; i++) {
+                mem_to_nc[tx_chan->mem_off++] = symbols[i];
+            }
+            len -= 8;
+            byte_index++;
+            continue;
+        }
         // start from last time truncated encoding
         uint8_t cur_byte = raw_data[byte_index];
         // bit-wise reverse
@@ -393,6 +414,7 @@ static size_t IRAM_ATTR rmt_encode_simple(rmt_encoder_t *encoder, rmt_channel_ha
 static esp_err_t rmt_del_bytes_encoder(rmt_encoder_t *encoder)
 {
     rmt_bytes_encoder_t *bytes_encoder = __containerof(encoder, rmt_bytes_encoder_t, base);
+    free(bytes_encoder->symbol_table);
     free(bytes_encoder);
     return ESP_OK;
 }
@@ -427,8 +449,9 @@ static esp_err_t rmt_del_simple_encoder(rmt_encoder_t *encoder)
 esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder)
 {
     esp_err_t ret = ESP_OK;
+    rmt_bytes_encoder_t *encoder = NULL;
     ESP_GOTO_ON_FALSE(config && ret_encoder, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
-    rmt_bytes_encoder_t *encoder = rmt_alloc_encoder_mem(sizeof(rmt_bytes_encoder_t));
+    encoder = rmt_alloc_encoder_mem(sizeof(rmt_bytes_encoder_t));
     ESP_GOTO_ON_FALSE(encoder, ESP_ERR_NO_MEM, err, TAG, "no mem for bytes encoder");
     encoder->base.encode = rmt_encode_bytes;
     encoder->base.del = rmt_del_bytes_encoder;
@@ -436,10 +459,19 @@ esp_err_t rmt_new_bytes_encoder(const rmt_bytes_encoder_config_t *config, rmt_en
     encoder->bit0 = config->bit0;
     encoder->bit1 = config->bit1;
     encoder->flags.msb_first = config->flags.msb_first;
+    if (config->flags.with_symbol_table) {
+        encoder->symbol_table = rmt_alloc_encoder_mem(256 * sizeof(encoder->symbol_table[0]));
+        ESP_GOTO_ON_FALSE(encoder->symbol_table, ESP_ERR_NO_MEM, err, TAG, "no mem for bytes encoder symbol table");
+        rmt_bytes_encoder_build_symbol_table(encoder);
+    }
     // return general encoder handle
     *ret_encoder = &encoder->base;
     ESP_LOGD(TAG, "new bytes encoder @%p", encoder);
+    return ret;
 err:
+    if (encoder) {
+        free(encoder);
+    }
     return ret;
 }
 
@@ -450,6 +482,9 @@ esp_err_t rmt_bytes_encoder_update_config(rmt_encoder_handle_t bytes_encoder, co
     encoder->bit0 = config->bit0;
     encoder->bit1 = config->bit1;
     encoder->flags.msb_first = config->flags.msb_first;
+    if (encoder->symbol_table) {
+        rmt_bytes_encoder_build_symbol_table(encoder);
+    }
     return ESP_OK;
 }
 
@@ -190,6 +190,7 @@ typedef struct {
     int dma_desc_index;         // tracking the DMA descriptor used by ping-pong
     struct {
         uint32_t en_partial_rx: 1; // packet is too long, we need to notify the user to process the data piece by piece, in a ping-pong approach
+        uint32_t en_continuous_rx: 1; // restart the receiver after each frame, until the channel is disabled
     } flags;
 } rmt_rx_trans_desc_t;
 
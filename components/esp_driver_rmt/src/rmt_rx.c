@@ -378,6 +378,64 @@ esp_err_t rmt_rx_register_event_callbacks(rmt_channel_handle_t channel, const rm
     return ESP_OK;
 }
 
+__attribute__((always_inline))
+static inline bool rmt_rx_symbol_duration_match(uint32_t duration, uint32_t expected, uint32_t tolerance)
+{
+    return duration + tolerance >= expected && duration <= expected + tolerance;
+}
+
+__attribute__((always_inline))
+static inline bool rmt_rx_symbol_match(const rmt_symbol_word_t *symbol, const rmt_symbol_word_t *expected,
+                                       uint32_t tolerance, bool first_half_only)
+{
+    if (symbol->level0 != expected->level0 ||
+            !rmt_rx_symbol_duration_match(symbol->duration0, expected->duration0, tolerance)) {
+        return false;
+    }
+    if (first_half_only) {
+        return true;
+    }
+    return symbol->level1 == expected->level1 &&
+           rmt_rx_symbol_duration_match(symbol->duration1, expected->duration1, tolerance);
+}
+
+esp_err_t rmt_rx_decode_bits(const rmt_rx_bit_decoder_config_t *config, const rmt_symbol_word_t *symbols, size_t num_symbols,
+                             uint8_t *data, size_t data_size, size_t *ret_num_bits)
+{
+    // no log here, this function is supposed to be called in the `on_recv_done` callback
+    if (!config || !symbols || !data || !ret_num_bits) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t ret = ESP_OK;
+    size_t num_bits = 0;
+    for (size_t i = 0; i < num_symbols; i++) {
+        if (num_bits >= data_size * 8) {
+            ret = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+        // the second half of the last symbol is merged into the idle level, its duration is zero
+        bool first_half_only = (i == num_symbols - 1) && symbols[i].duration1 == 0;
+        uint8_t bit;
+        if (rmt_rx_symbol_match(&symbols[i], &config->bit0, config->tolerance, first_half_only)) {
+            bit = 0;
+        } else if (rmt_rx_symbol_match(&symbols[i], &config->bit1, config->tolerance, first_half_only)) {
+            bit = 1;
+        } else {
+            ret = ESP_ERR_INVALID_RESPONSE;
+            break;
+        }
+        uint8_t mask = config->flags.msb_first ? (0x80 >> (num_bits % 8)) : (1 << (num_bits % 8));
+        if (bit) {
+            data[num_bits / 8] |= mask;
+        } else {
+            data[num_bits / 8] &= ~mask;
+        }
+        num_bits++;
+    }
+    *ret_num_bits = num_bits;
+    return ret;
+}
+
 esp_err_t rmt_receive(rmt_channel_handle_t channel, void *buffer, size_t buffer_size, const rmt_receive_config_t *config)
 {
     ESP_RETURN_ON_FALSE_ISR(channel && buffer && buffer_size && config, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
@@ -428,6 +486,7 @@ esp_err_t rmt_receive(rmt_channel_handle_t channel, void *buffer, size_t buffer_
     t->copy_dest_off = 0;
     t->dma_desc_index = 0;
     t->flags.en_partial_rx = config->flags.en_partial_rx;
+    t->flags.en_continuous_rx = config->flags.en_continuous_rx;
 
 #if SOC_RMT_SUPPORT_DMA
     if (channel->dma_chan) {
@@ -462,6 +521,7 @@ esp_err_t rmt_receive(rmt_channel_handle_t channel, void *buffer, size_t buffer_
 
     // saying we're in running state, this state will last until the receiving is done
     // i.e., we will switch back to the enable state in the receive done interrupt handler
+    // for continuous receive, this state will last until the channel is disabled
     atomic_store(&channel->fsm, RMT_FSM_RUN);
 
     return ESP_OK;
@@ -600,7 +660,7 @@ static bool IRAM_ATTR rmt_isr_handle_rx_done(rmt_rx_channel_t *rx_chan)
 
     rmt_ll_clear_interrupt_status(hal->regs, RMT_LL_EVENT_RX_DONE(channel_id));
     portENTER_CRITICAL_ISR(&channel->spinlock);
-    // disable the RX engine, it will be enabled again when next time user calls `rmt_receive()`
+    // disable the RX engine, it will be enabled again when next time user calls `rmt_receive()`, or below for continuous receive
     rmt_ll_rx_enable(hal->regs, channel_id, false);
     portEXIT_CRITICAL_ISR(&channel->spinlock);
 
@@ -662,16 +722,27 @@ static bool IRAM_ATTR rmt_isr_handle_rx_done(rmt_rx_channel_t *rx_chan)
 
     trans_desc->copy_dest_off += copy_size;
     trans_desc->received_symbol_num += copy_size / sizeof(rmt_symbol_word_t);
-    // switch back to the enable state, then user can call `rmt_receive` to start a new receive
-    atomic_store(&channel->fsm, RMT_FSM_ENABLE);
+    rmt_rx_done_event_data_t edata = {
+        .received_symbols = trans_desc->buffer,
+        .num_symbols = trans_desc->received_symbol_num,
+        .flags.is_last = true,
+    };
+    if (trans_desc->flags.en_continuous_rx) {
+        // restart the receiver right away, the next frame is saved from the beginning of the user buffer again
+        trans_desc->copy_dest_off = 0;
+        trans_desc->received_symbol_num = 0;
+        rx_chan->mem_off = 0;
+        portENTER_CRITICAL_ISR(&channel->spinlock);
+        rmt_ll_rx_reset_pointer(hal->regs, channel_id);
+        rmt_ll_rx_enable(hal->regs, channel_id, true);
+        portEXIT_CRITICAL_ISR(&channel->spinlock);
+    } else {
+        // switch back to the enable state, then user can call `rmt_receive` to start a new receive
+        atomic_store(&channel->fsm, RMT_FSM_ENABLE);
+    }
 
     // notify the user that all RMT symbols are received done
     if (cb) {
-        rmt_rx_done_event_data_t edata = {
-            .received_symbols = trans_desc->buffer,
-            .num_symbols = trans_desc->received_symbol_num,
-            .flags.is_last = true,
-        };
         if (cb(channel, &edata, rx_chan->user_data)) {
             need_yield = true;
         }
@@ -797,6 +868,40 @@ static size_t IRAM_ATTR rmt_rx_count_symbols_for_single_block(rmt_rx_channel_t *
     return received_bytes / sizeof(rmt_symbol_word_t);
 }
 
+// In continuous receive, a frame starts from any DMA node, and may wrap around the end of the user buffer
+static bool IRAM_ATTR rmt_rx_notify_continuous_frame(rmt_rx_channel_t *rx_chan)
+{
+    bool need_yield = false;
+    rmt_channel_t *channel = &rx_chan->base;
+    rmt_rx_trans_desc_t *trans_desc = &rx_chan->trans_desc;
+    int start_index = trans_desc->dma_desc_index;
+    int index = start_index;
+    size_t received_bytes = 0;
+    bool eof = false;
+
+    for (int i = 0; i < rx_chan->num_dma_nodes && !eof; i++) {
+        received_bytes += rx_chan->dma_nodes_nc[index].dw0.length;
+        eof = rx_chan->dma_nodes_nc[index].dw0.suc_eof;
+        index = (index + 1) % rx_chan->num_dma_nodes;
+        // the symbols are only continuous in memory until the end of the user buffer
+        if ((eof || index == 0) && rx_chan->on_recv_done) {
+            rmt_rx_done_event_data_t edata = {
+                .received_symbols = rx_chan->dma_nodes_nc[start_index].buffer,
+                .num_symbols = ALIGN_UP(received_bytes, sizeof(rmt_symbol_word_t)) / sizeof(rmt_symbol_word_t),
+                .flags.is_last = eof,
+            };
+            if (rx_chan->on_recv_done(channel, &edata, rx_chan->user_data)) {
+                need_yield = true;
+            }
+            start_index = index;
+            received_bytes = 0;
+        }
+    }
+    // the next frame is received into the DMA node after the EOF one
+    trans_desc->dma_desc_index = index;
+    return need_yield;
+}
+
 static bool IRAM_ATTR rmt_dma_rx_one_block_cb(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data)
 {
     bool need_yield = false;
@@ -813,7 +918,13 @@ static bool IRAM_ATTR rmt_dma_rx_one_block_cb(gdma_channel_handle_t dma_chan, gd
         esp_cache_msync(trans_desc->buffer, trans_desc->buffer_size, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
     }
 
-    if (event_data->flags.normal_eof) {
+    if (event_data->flags.normal_eof && trans_desc->flags.en_continuous_rx) {
+        // keep the RX engine running for the next frame
+        portENTER_CRITICAL_ISR(&channel->spinlock);
+        rmt_ll_rx_enable(hal->regs, channel_id, true);
+        portEXIT_CRITICAL_ISR(&channel->spinlock);
+        need_yield = rmt_rx_notify_continuous_frame(rx_chan);
+    } else if (event_data->flags.normal_eof) {
         // if the DMA received an EOF, it means the RMT peripheral has received an "end marker"
         portENTER_CRITICAL_ISR(&channel->spinlock);
         // disable the RX engine, it will be enabled again in the next `rmt_receive()`
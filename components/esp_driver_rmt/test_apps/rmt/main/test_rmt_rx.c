@@ -432,3 +432,250 @@ TEST_CASE("rmt rx filter functionality", "[rmt]")
         test_rmt_receive_filter(clk_srcs[i]);
     }
 }
+
+#define TEST_RMT_CONTINUOUS_FRAMES 5
+
+typedef struct {
+    TaskHandle_t task_to_notify;
+    size_t received_frames;
+    uint8_t decoded[TEST_RMT_CONTINUOUS_FRAMES][2];
+    esp_err_t decode_ret[TEST_RMT_CONTINUOUS_FRAMES];
+} test_continuous_rx_user_data_t;
+
+static const rmt_rx_bit_decoder_config_t test_bit_decoder_config = {
+    .bit0 = {.level0 = 1, .duration0 = 3, .level1 = 0, .duration1 = 9},
+    .bit1 = {.level0 = 1, .duration0 = 9, .level1 = 0, .duration1 = 3},
+    .tolerance = 2,
+    .flags.msb_first = true,
+};
+
+TEST_RMT_CALLBACK_ATTR
+static bool test_rmt_continuous_receive_done(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *edata, void *user_data)
+{
+    BaseType_t high_task_wakeup = pdFALSE;
+    test_continuous_rx_user_data_t *test_user_data = (test_continuous_rx_user_data_t *)user_data;
+    size_t frame = test_user_data->received_frames;
+    if (edata->flags.is_last && frame < TEST_RMT_CONTINUOUS_FRAMES) {
+        // decode the frame in place, the driver is already receiving the next one
+        size_t num_bits = 0;
+        test_user_data->decode_ret[frame] = rmt_rx_decode_bits(&test_bit_decoder_config, edata->received_symbols, edata->num_symbols,
+                                                               test_user_data->decoded[frame], sizeof(test_user_data->decoded[frame]), &num_bits);
+        test_user_data->received_frames++;
+        vTaskNotifyGiveFromISR(test_user_data->task_to_notify, &high_task_wakeup);
+    }
+    return high_task_wakeup == pdTRUE;
+}
+
+static void test_rmt_continuous_receive(size_t mem_block_symbols, bool with_dma)
+{
+    uint32_t const test_rx_buffer_symbols = 64;
+    rmt_symbol_word_t *receive_user_buf = heap_caps_aligned_calloc(64, test_rx_buffer_symbols, sizeof(rmt_symbol_word_t),
+                                                                   MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(receive_user_buf);
+
+    rmt_rx_channel_config_t rx_channel_cfg = {
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = 1000000, // 1MHz, 1 tick = 1us
+        .mem_block_symbols = mem_block_symbols,
+        .gpio_num = TEST_RMT_GPIO_NUM_A,
+        .flags.with_dma = with_dma,
+    };
+    printf("install rx channel\r\n");
+    rmt_channel_handle_t rx_channel = NULL;
+    TEST_ESP_OK(rmt_new_rx_channel(&rx_channel_cfg, &rx_channel));
+
+    printf("register rx event callbacks\r\n");
+    rmt_rx_event_callbacks_t cbs = {
+        .on_recv_done = test_rmt_continuous_receive_done,
+    };
+    test_continuous_rx_user_data_t test_user_data = {
+        .task_to_notify = xTaskGetCurrentTaskHandle(),
+    };
+    TEST_ESP_OK(rmt_rx_register_event_callbacks(rx_channel, &cbs, &test_user_data));
+
+    // use TX channel to simulate the input signal
+    rmt_tx_channel_config_t tx_channel_cfg = {
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = 1000000, // 1MHz, 1 tick = 1us
+        .mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL,
+        .trans_queue_depth = 4,
+        .gpio_num = TEST_RMT_GPIO_NUM_A,
+    };
+    printf("install tx channel\r\n");
+    rmt_channel_handle_t tx_channel = NULL;
+    TEST_ESP_OK(rmt_new_tx_channel(&tx_channel_cfg, &tx_channel));
+
+    printf("install bytes encoder\r\n");
+    rmt_encoder_handle_t bytes_encoder = NULL;
+    rmt_bytes_encoder_config_t encoder_cfg = {
+        .bit0 = test_bit_decoder_config.bit0,
+        .bit1 = test_bit_decoder_config.bit1,
+        .flags.msb_first = true,
+    };
+    TEST_ESP_OK(rmt_new_bytes_encoder(&encoder_cfg, &bytes_encoder));
+    rmt_transmit_config_t transmit_config = {
+        .loop_count = 0, // no loop
+    };
+
+    printf("enable tx and rx channels\r\n");
+    TEST_ESP_OK(rmt_enable(tx_channel));
+    TEST_ESP_OK(rmt_enable(rx_channel));
+
+    rmt_receive_config_t rx_config = {
+        .signal_range_min_ns = 1250,
+        .signal_range_max_ns = 20000, // a frame ends when the line keeps idle for 20us
+        .flags.en_continuous_rx = true,
+    };
+    // only one receive call for all the frames
+    TEST_ESP_OK(rmt_receive(rx_channel, receive_user_buf, test_rx_buffer_symbols * sizeof(rmt_symbol_word_t), &rx_config));
+    // the channel is busy until it's disabled
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, rmt_receive(rx_channel, receive_user_buf, test_rx_buffer_symbols * sizeof(rmt_symbol_word_t), &rx_config));
+
+    uint8_t frames[TEST_RMT_CONTINUOUS_FRAMES][2];
+    for (int i = 0; i < TEST_RMT_CONTINUOUS_FRAMES; i++) {
+        frames[i][0] = 0xA5 ^ (i * 17);
+        frames[i][1] = 0x3C + i;
+        TEST_ESP_OK(rmt_transmit(tx_channel, bytes_encoder, frames[i], sizeof(frames[i]), &transmit_config));
+        TEST_ESP_OK(rmt_tx_wait_all_done(tx_channel, -1));
+        TEST_ASSERT_NOT_EQUAL(0, ulTaskNotifyTake(pdFALSE, pdMS_TO_TICKS(1000)));
+    }
+
+    printf("received %zu frames\r\n", test_user_data.received_frames);
+    TEST_ASSERT_EQUAL(TEST_RMT_CONTINUOUS_FRAMES, test_user_data.received_frames);
+    for (int i = 0; i < TEST_RMT_CONTINUOUS_FRAMES; i++) {
+        TEST_ESP_OK(test_user_data.decode_ret[i]);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(frames[i], test_user_data.decoded[i], sizeof(frames[i]));
+    }
+
+    printf("disable tx and rx channels\r\n");
+    TEST_ESP_OK(rmt_disable(tx_channel));
+    TEST_ESP_OK(rmt_disable(rx_channel));
+    printf("delete channels and encoder\r\n");
+    TEST_ESP_OK(rmt_del_channel(rx_channel));
+    TEST_ESP_OK(rmt_del_channel(tx_channel));
+    TEST_ESP_OK(rmt_del_encoder(bytes_encoder));
+    free(receive_user_buf);
+}
+
+TEST_CASE("rmt rx continuous receive", "[rmt]")
+{
+    test_rmt_continuous_receive(SOC_RMT_MEM_WORDS_PER_CHANNEL, false);
+#if SOC_RMT_SUPPORT_DMA
+    test_rmt_continuous_receive(256, true);
+#endif
+}
+
+TEST_CASE("rmt rx decode bits", "[rmt]")
+{
+    rmt_symbol_word_t symbols[] = {
+        {.level0 = 1, .duration0 = 9, .level1 = 0, .duration1 = 3},
+        {.level0 = 1, .duration0 = 2, .level1 = 0, .duration1 = 10},
+        {.level0 = 1, .duration0 = 10, .level1 = 0, .duration1 = 4},
+        {.level0 = 1, .duration0 = 3, .level1 = 0, .duration1 = 0}, // merged into the idle level
+    };
+    uint8_t data[1] = {};
+    size_t num_bits = 0;
+    TEST_ESP_OK(rmt_rx_decode_bits(&test_bit_decoder_config, symbols, 4, data, sizeof(data), &num_bits));
+    TEST_ASSERT_EQUAL(4, num_bits);
+    TEST_ASSERT_EQUAL_HEX8(0xA0, data[0]);
+
+    // a symbol in the middle of the frame must match both halves
+    symbols[1].duration1 = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_RESPONSE, rmt_rx_decode_bits(&test_bit_decoder_config, symbols, 4, data, sizeof(data), &num_bits));
+    TEST_ASSERT_EQUAL(1, num_bits);
+    symbols[1].duration1 = 10;
+
+    // the data buffer can only save 8 bits
+    rmt_symbol_word_t long_frame[9];
+    for (int i = 0; i < 9; i++) {
+        long_frame[i] = test_bit_decoder_config.bit1;
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, rmt_rx_decode_bits(&test_bit_decoder_config, long_frame, 9, data, sizeof(data), &num_bits));
+    TEST_ASSERT_EQUAL(8, num_bits);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, data[0]);
+}
+
+static void test_rmt_bytes_encoder_symbol_table(bool msb_first)
+{
+    uint32_t const test_rx_buffer_symbols = 64;
+    rmt_symbol_word_t *receive_user_buf = heap_caps_aligned_calloc(64, test_rx_buffer_symbols, sizeof(rmt_symbol_word_t),
+                                                                   MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(receive_user_buf);
+
+    rmt_rx_channel_config_t rx_channel_cfg = {
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = 1000000, // 1MHz, 1 tick = 1us
+        .mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL,
+        .gpio_num = TEST_RMT_GPIO_NUM_A,
+    };
+    rmt_channel_handle_t rx_channel = NULL;
+    TEST_ESP_OK(rmt_new_rx_channel(&rx_channel_cfg, &rx_channel));
+    rmt_rx_event_callbacks_t cbs = {
+        .on_recv_done = test_rmt_received_done,
+    };
+    test_rx_user_data_t test_user_data = {
+        .task_to_notify = xTaskGetCurrentTaskHandle(),
+        .received_symbol_num = 0,
+    };
+    TEST_ESP_OK(rmt_rx_register_event_callbacks(rx_channel, &cbs, &test_user_data));
+
+    // use TX channel to simulate the input signal
+    rmt_tx_channel_config_t tx_channel_cfg = {
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = 1000000, // 1MHz, 1 tick = 1us
+        .mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL,
+        .trans_queue_depth = 4,
+        .gpio_num = TEST_RMT_GPIO_NUM_A,
+    };
+    rmt_channel_handle_t tx_channel = NULL;
+    TEST_ESP_OK(rmt_new_tx_channel(&tx_channel_cfg, &tx_channel));
+
+    printf("install bytes encoder with symbol table\r\n");
+    rmt_bytes_encoder_config_t encoder_cfg = {
+        .bit0 = test_bit_decoder_config.bit0,
+        .bit1 = test_bit_decoder_config.bit1,
+        .flags.msb_first = msb_first,
+        .flags.with_symbol_table = true,
+    };
+    rmt_encoder_handle_t bytes_encoder = NULL;
+    TEST_ESP_OK(rmt_new_bytes_encoder(&encoder_cfg, &bytes_encoder));
+    rmt_transmit_config_t transmit_config = {
+        .loop_count = 0, // no loop
+    };
+
+    TEST_ESP_OK(rmt_enable(tx_channel));
+    TEST_ESP_OK(rmt_enable(rx_channel));
+
+    rmt_receive_config_t rx_config = {
+        .signal_range_min_ns = 1250,
+        .signal_range_max_ns = 20000,
+    };
+    TEST_ESP_OK(rmt_receive(rx_channel, receive_user_buf, test_rx_buffer_symbols * sizeof(rmt_symbol_word_t), &rx_config));
+    const uint8_t payload[] = {0xF0, 0x69, 0xAE, 0x01};
+    TEST_ESP_OK(rmt_transmit(tx_channel, bytes_encoder, payload, sizeof(payload), &transmit_config));
+    TEST_ASSERT_NOT_EQUAL(0, ulTaskNotifyTake(pdFALSE, pdMS_TO_TICKS(1000)));
+    printf("received %zu symbols\r\n", test_user_data.received_symbol_num);
+    TEST_ASSERT_EQUAL(sizeof(payload) * 8, test_user_data.received_symbol_num);
+
+    // the symbols from the table must be the same as those encoded bit by bit
+    rmt_rx_bit_decoder_config_t decoder_cfg = test_bit_decoder_config;
+    decoder_cfg.flags.msb_first = msb_first;
+    uint8_t decoded[sizeof(payload)] = {};
+    size_t num_bits = 0;
+    TEST_ESP_OK(rmt_rx_decode_bits(&decoder_cfg, receive_user_buf, test_user_data.received_symbol_num, decoded, sizeof(decoded), &num_bits));
+    TEST_ASSERT_EQUAL(sizeof(payload) * 8, num_bits);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(payload, decoded, sizeof(payload));
+
+    TEST_ESP_OK(rmt_disable(tx_channel));
+    TEST_ESP_OK(rmt_disable(rx_channel));
+    TEST_ESP_OK(rmt_del_channel(rx_channel));
+    TEST_ESP_OK(rmt_del_channel(tx_channel));
+    TEST_ESP_OK(rmt_del_encoder(bytes_encoder));
+    free(receive_user_buf);
+}
+
+TEST_CASE("rmt bytes encoder with symbol table", "[rmt]")
+{
+    test_rmt_bytes_encoder_symbol_table(true);
+    test_rmt_bytes_encoder_symbol_table(false);
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -50,6 +50,12 @@ typedef struct {
 #define SDIO_SLAVE_FLAG_DEFAULT_SPEED       BIT(3)      /**< Disable the highspeed support of the hardware. */
 #define SDIO_SLAVE_FLAG_HIGH_SPEED          0           /**< Enable the highspeed support of the hardware. This is the
         default option. The host will see highspeed capability, but the mode actually used is determined by the host. */
+    int                 send_aggregate_num; ///< Packet mode only. Max number of queued packets the host reads in one transfer. The packets queued while
+    ///< the previous transfer is in flight are merged into one packet, so the host gets one new packet interrupt and one transfer for all of
+    ///< them, and the protocol between host and slave should delimit them. Set to 0 or 1 to send the packets one by one.
+    int                 recv_pool_num;      ///< Number of receiving buffers of `recv_buffer_size` bytes the driver allocates, registers and loads
+    ///< during initialization. The handles of these buffers are returned by ``sdio_slave_recv_packet`` like the registered ones, and
+    ///< should be loaded again by ``sdio_slave_recv_load_buf`` after use. Set to 0 if the application registers all buffers itself.
 } sdio_slave_config_t;
 
 /** Handle of a receive buffer, register a handle by calling ``sdio_slave_recv_register_buf``. Use the handle to load the buffer to the
@@ -197,6 +203,27 @@ uint8_t* sdio_slave_recv_get_buf(sdio_slave_buf_handle_t handle, size_t *len_o);
  */
 esp_err_t sdio_slave_send_queue(uint8_t* addr, size_t len, void* arg, TickType_t wait);
 
+/// Buffer to send, used by ``sdio_slave_send_queue_batch``
+typedef struct {
+    uint8_t    *addr;   ///< Address for data to be sent. The buffer should be DMA capable and 32-bit aligned.
+    size_t      len;    ///< Length of the data, should not be longer than 4092 bytes.
+    void       *arg;    ///< Argument to returned in ``sdio_slave_send_get_finished``.
+} sdio_slave_send_item_t;
+
+/** Put several sending transfers into the send queue at once. Same as calling ``sdio_slave_send_queue`` for each item in
+ *  order, but the queue is locked only once, and either all items are queued or none of them.
+ *
+ * @param items Buffers to send. Each of them is returned by ``sdio_slave_send_get_finished`` after it is sent.
+ * @param count Number of items, should not be larger than the `send_queue_size`.
+ * @param wait Time to wait for each free slot if the queue is full.
+ *
+ * @return
+ *     - ESP_ERR_INVALID_ARG if an item is invalid or the count is larger than the queue size.
+ *     - ESP_ERR_TIMEOUT if the queue doesn't have room for all the items until timeout, nothing is queued.
+ *     - ESP_OK if success.
+ */
+esp_err_t sdio_slave_send_queue_batch(const sdio_slave_send_item_t *items, size_t count, TickType_t wait);
+
 /** Return the ownership of a finished transaction.
  * @param out_arg Argument of the finished transaction. Set to NULL if unused.
  * @param wait Time to wait if there's no finished sending transaction.
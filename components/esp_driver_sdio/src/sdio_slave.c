@@ -148,6 +148,7 @@ typedef struct {
     /*------- receiving ---------------*/
     recv_tailq_t        recv_reg_list;  // removed from the link list, registered but not used now
     portMUX_TYPE        recv_spinlock;
+    uint8_t             *recv_pool_buf; // buffers allocated by the driver for `recv_pool_num`
 } sdio_context_t;
 
 #define CONTEXT_INIT_VAL { \
@@ -162,6 +163,7 @@ typedef struct {
     /*------- receiving ---------------*/ \
     .recv_reg_list  =   TAILQ_HEAD_INITIALIZER(context.recv_reg_list), \
     .recv_spinlock  =   portMUX_INITIALIZER_UNLOCKED, \
+    .recv_pool_buf  =   NULL, \
 }
 
 static sdio_context_t context = CONTEXT_INIT_VAL;
@@ -213,6 +215,8 @@ static inline void deinit_context(void)
     if (context.remain_cnt != NULL) {
         vSemaphoreDelete(context.remain_cnt);
     }
+    free(context.recv_pool_buf);
+    context.recv_pool_buf = NULL;
     free(context.hal->send_desc_queue.data);
     context.hal->send_desc_queue.data = NULL;
     free(context.hal);
@@ -222,6 +226,8 @@ static inline void deinit_context(void)
 static esp_err_t init_context(const sdio_slave_config_t *config)
 {
     SDIO_SLAVE_CHECK(*(uint32_t *)&context.config == 0, "sdio slave already initialized", ESP_ERR_INVALID_STATE);
+    SDIO_SLAVE_CHECK(config->send_aggregate_num >= 0 && config->recv_pool_num >= 0, "invalid aggregate or pool num", ESP_ERR_INVALID_ARG);
+    SDIO_SLAVE_CHECK(config->recv_pool_num == 0 || config->recv_buffer_size > 0, "pool needs a receiving buffer size", ESP_ERR_INVALID_ARG);
     context = (sdio_context_t)CONTEXT_INIT_VAL;
     context.config = *config;
 
@@ -236,6 +242,7 @@ static esp_err_t init_context(const sdio_slave_config_t *config)
     context.hal->no_highspeed = (config->flags & SDIO_SLAVE_FLAG_DEFAULT_SPEED) == SDIO_SLAVE_FLAG_DEFAULT_SPEED;
     context.hal->send_queue_size = config->send_queue_size;
     context.hal->recv_buffer_size = config->recv_buffer_size;
+    context.hal->send_aggregate_num = config->send_aggregate_num;
     //initialize ringbuffer resources
     sdio_ringbuf_t *buf = &(context.hal->send_desc_queue);
     //one item is not used.
@@ -277,6 +284,30 @@ no_mem:
     return ESP_ERR_NO_MEM;
 }
 
+// allocate the buffers of the pool, then register and load them as the app does
+static esp_err_t recv_pool_init(int pool_num)
+{
+    if (pool_num == 0) {
+        return ESP_OK;
+    }
+    const size_t stride = (context.config.recv_buffer_size + 3) & ~3;
+    context.recv_pool_buf = (uint8_t *)heap_caps_malloc(stride * pool_num, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+    if (context.recv_pool_buf == NULL) {
+        SDIO_SLAVE_LOGE("cannot allocate receiving pool");
+        return ESP_ERR_NO_MEM;
+    }
+    for (int i = 0; i < pool_num; i++) {
+        sdio_slave_buf_handle_t handle = sdio_slave_recv_register_buf(context.recv_pool_buf + i * stride);
+        if (handle == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        esp_err_t ret = sdio_slave_recv_load_buf(handle);
+        assert(ret == ESP_OK);
+        (void)ret;
+    }
+    return ESP_OK;
+}
+
 static void configure_pin(int pin, uint32_t func, bool pullup)
 {
     const int sdmmc_func = func;
@@ -370,6 +401,12 @@ esp_err_t sdio_slave_initialize(sdio_slave_config_t *config)
         return r;
     }
 
+    r = recv_pool_init(config->recv_pool_num);
+    if (r != ESP_OK) {
+        sdio_slave_deinit();
+        return r;
+    }
+
     sdio_slave_reset();
     return ESP_OK;
 }
@@ -611,6 +648,36 @@ esp_err_t sdio_slave_send_queue(uint8_t *addr, size_t len, void *arg, TickType_t
     return ESP_OK;
 }
 
+esp_err_t sdio_slave_send_queue_batch(const sdio_slave_send_item_t *items, size_t count, TickType_t wait)
+{
+    SDIO_SLAVE_CHECK(items != NULL && count <= (size_t)context.config.send_queue_size, "invalid items or count", ESP_ERR_INVALID_ARG);
+    for (size_t i = 0; i < count; i++) {
+        SDIO_SLAVE_CHECK(items[i].len > 0, "len <= 0", ESP_ERR_INVALID_ARG);
+        SDIO_SLAVE_CHECK(esp_ptr_dma_capable(items[i].addr) && (uint32_t)items[i].addr % 4 == 0,
+                         "buffer to send should be DMA capable and 32-bit aligned", ESP_ERR_INVALID_ARG);
+    }
+
+    size_t taken = 0;
+    while (taken < count) {
+        if (xSemaphoreTake(context.remain_cnt, wait) != pdTRUE) {
+            // give back the slots already taken, so that nothing is queued
+            while (taken-- > 0) {
+                xSemaphoreGive(context.remain_cnt);
+            }
+            return ESP_ERR_TIMEOUT;
+        }
+        taken++;
+    }
+
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL(&context.write_spinlock);
+    for (size_t i = 0; i < count && ret == ESP_OK; i++) {
+        ret = sdio_slave_hal_send_queue(context.hal, items[i].addr, items[i].len, items[i].arg);
+    }
+    portEXIT_CRITICAL(&context.write_spinlock);
+    return ret;
+}
+
 esp_err_t sdio_slave_send_get_finished(void **out_arg, TickType_t wait)
 {
     void *arg = NULL;
@@ -27,7 +27,8 @@ extern "C" {
              SDMMC_HOST_FLAG_4BIT | \
              SDMMC_HOST_FLAG_1BIT | \
              SDMMC_HOST_FLAG_DDR  | \
-             SDMMC_HOST_FLAG_DEINIT_ARG, \
+             SDMMC_HOST_FLAG_DEINIT_ARG | \
+             SDMMC_HOST_FLAG_SG, \
     .slot = SDMMC_HOST_SLOT_1, \
     .max_freq_khz = SDMMC_FREQ_DEFAULT, \
     .io_voltage = 3.3f, \
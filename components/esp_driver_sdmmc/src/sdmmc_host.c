@@ -233,6 +233,13 @@ void sdmmc_host_get_clk_dividers(uint32_t freq_khz, int *host_div, int *card_div
     }
 #endif
     // Calculate new dividers
+#if SOC_SDMMC_UHS_I_SUPPORTED
+    if (freq_khz * 1000 >= clk_src_freq_hz / 2) {
+        *host_div = 2;       // 160 MHz / 2 = 80 MHz, for UHS-I and HS200 modes
+        *card_div = 0;
+        return;
+    }
+#endif
     if (freq_khz >= SDMMC_FREQ_HIGHSPEED) {
         *host_div = 4;       // 160 MHz / 4 = 40 MHz
         *card_div = 0;
@@ -42,6 +42,8 @@ typedef enum {
 typedef struct {
     uint8_t* ptr;
     size_t size_remaining;
+    size_t buf_remaining;               // bytes of the current buffer not given to a descriptor yet
+    const sdmmc_sg_entry_t* next_sg;    // next buffer of a scatter-gather transfer
     size_t next_desc;
     size_t desc_remaining;
 } sdmmc_transfer_state_t;
@@ -78,6 +80,8 @@ static void process_command_response(uint32_t status, sdmmc_command_t* cmd);
 static void fill_dma_descriptors(size_t num_desc);
 static size_t get_free_descriptors_count(void);
 static bool wait_for_busy_cleared(uint32_t timeout_ms);
+static esp_err_t check_data_buffer(int slot, const void* buf, size_t size);
+static esp_err_t sync_data_buffers(const sdmmc_command_t* cmdinfo, int flags);
 
 esp_err_t sdmmc_host_transaction_handler_init(void)
 {
@@ -117,11 +121,6 @@ esp_err_t sdmmc_host_do_transaction(int slot, sdmmc_command_t* cmdinfo)
     esp_pm_lock_acquire(s_pm_lock);
 #endif
 
-#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
-    // cache sync related
-    size_t cache_sync_len = 0;
-#endif
-
     // dispose of any events which happened asynchronously
     handle_idle_state_events();
     // convert cmdinfo to hardware register value
@@ -134,33 +133,58 @@ esp_err_t sdmmc_host_do_transaction(int slot, sdmmc_command_t* cmdinfo)
             ret = ESP_ERR_INVALID_SIZE;
             goto out;
         }
-        esp_dma_mem_info_t dma_mem_info;
-        sdmmc_host_get_dma_info(slot, &dma_mem_info);
-#ifdef SOC_SDMMC_PSRAM_DMA_CAPABLE
-        dma_mem_info.extra_heap_caps |= MALLOC_CAP_SPIRAM;
-#endif
-        if (!esp_dma_is_buffer_alignment_satisfied(cmdinfo->data, cmdinfo->buflen, dma_mem_info)) {
-            ESP_LOGE(TAG, "%s: buffer %p can not be used for DMA", __func__, cmdinfo->data);
-            ret = ESP_ERR_INVALID_ARG;
-            goto out;
+        size_t desc_count = 0;
+        if (cmdinfo->sg) {
+            size_t total = 0;
+            for (size_t i = 0; i < cmdinfo->sg_count; ++i) {
+                const sdmmc_sg_entry_t* entry = &cmdinfo->sg[i];
+                // Each buffer but the last one is a whole number of 32-bit words for the FIFO
+                if (entry->size == 0 || (entry->size % 4 != 0 && i != cmdinfo->sg_count - 1)) {
+                    ESP_LOGE(TAG, "%s: invalid size of buffer %d: %d", __func__, i, entry->size);
+                    ret = ESP_ERR_INVALID_SIZE;
+                    goto out;
+                }
+                ret = check_data_buffer(slot, entry->buf, entry->size);
+                if (ret != ESP_OK) {
+                    goto out;
+                }
+                total += entry->size;
+                desc_count += (entry->size + SDMMC_DMA_MAX_BUF_LEN - 1) / SDMMC_DMA_MAX_BUF_LEN;
+            }
+            if (total != cmdinfo->datalen) {
+                ESP_LOGE(TAG, "%s: size of the buffers %d does not match datalen %d", __func__, total, cmdinfo->datalen);
+                ret = ESP_ERR_INVALID_SIZE;
+                goto out;
+            }
+        } else {
+            ret = check_data_buffer(slot, cmdinfo->data, cmdinfo->buflen);
+            if (ret != ESP_OK) {
+                goto out;
+            }
+            desc_count = (cmdinfo->datalen + SDMMC_DMA_MAX_BUF_LEN - 1) / SDMMC_DMA_MAX_BUF_LEN;
         }
 
-#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
-        cache_sync_len = cmdinfo->buflen;
-        ret = esp_cache_msync((void *)cmdinfo->data, cache_sync_len, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+        ret = sync_data_buffers(cmdinfo, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
         if (ret != ESP_OK) {
             goto out;
         }
-#endif
         // this clears "owned by IDMAC" bits
         memset(s_dma_desc, 0, sizeof(s_dma_desc));
         // initialize first descriptor
         s_dma_desc[0].first_descriptor = 1;
         // save transfer info
-        s_cur_transfer.ptr = (uint8_t*) cmdinfo->data;
         s_cur_transfer.size_remaining = cmdinfo->datalen;
+        if (cmdinfo->sg) {
+            s_cur_transfer.ptr = NULL;
+            s_cur_transfer.buf_remaining = 0;
+            s_cur_transfer.next_sg = cmdinfo->sg;
+        } else {
+            s_cur_transfer.ptr = (uint8_t*) cmdinfo->data;
+            s_cur_transfer.buf_remaining = cmdinfo->datalen;
+            s_cur_transfer.next_sg = NULL;
+        }
         s_cur_transfer.next_desc = 0;
-        s_cur_transfer.desc_remaining = (cmdinfo->datalen + SDMMC_DMA_MAX_BUF_LEN - 1) / SDMMC_DMA_MAX_BUF_LEN;
+        s_cur_transfer.desc_remaining = desc_count;
         // prepare descriptors
         fill_dma_descriptors(SDMMC_DMA_DESC_CNT);
         // write transfer info into hardware
@@ -188,14 +212,12 @@ esp_err_t sdmmc_host_do_transaction(int slot, sdmmc_command_t* cmdinfo)
     }
     s_is_app_cmd = (ret == ESP_OK && cmdinfo->opcode == MMC_APP_CMD);
 
-#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
     if (cmdinfo->data) {
-        ret = esp_cache_msync((void *)cmdinfo->data, cache_sync_len, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
-        if (ret != ESP_OK) {
-            goto out;
+        esp_err_t sync_ret = sync_data_buffers(cmdinfo, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+        if (ret == ESP_OK) {
+            ret = sync_ret;
         }
     }
-#endif
 
 out:
 #ifdef CONFIG_PM_ENABLE
@@ -205,6 +227,36 @@ out:
     return ret;
 }
 
+static esp_err_t check_data_buffer(int slot, const void* buf, size_t size)
+{
+    esp_dma_mem_info_t dma_mem_info;
+    sdmmc_host_get_dma_info(slot, &dma_mem_info);
+#ifdef SOC_SDMMC_PSRAM_DMA_CAPABLE
+    dma_mem_info.extra_heap_caps |= MALLOC_CAP_SPIRAM;
+#endif
+    if (!esp_dma_is_buffer_alignment_satisfied(buf, size, dma_mem_info)) {
+        ESP_LOGE(TAG, "%s: buffer %p can not be used for DMA", __func__, buf);
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t sync_data_buffers(const sdmmc_command_t* cmdinfo, int flags)
+{
+#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
+    if (cmdinfo->sg == NULL) {
+        return esp_cache_msync(cmdinfo->data, cmdinfo->buflen, flags);
+    }
+    for (size_t i = 0; i < cmdinfo->sg_count; ++i) {
+        esp_err_t ret = esp_cache_msync(cmdinfo->sg[i].buf, cmdinfo->sg[i].size, flags);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+#endif
+    return ESP_OK;
+}
+
 static size_t get_free_descriptors_count(void)
 {
     const size_t next = s_cur_transfer.next_desc;
@@ -237,12 +289,18 @@ static void fill_dma_descriptors(size_t num_desc)
         if (s_cur_transfer.size_remaining == 0) {
             return;
         }
+        if (s_cur_transfer.buf_remaining == 0) {
+            // continue with the next buffer of a scatter-gather transfer
+            s_cur_transfer.ptr = (uint8_t*) s_cur_transfer.next_sg->buf;
+            s_cur_transfer.buf_remaining = s_cur_transfer.next_sg->size;
+            s_cur_transfer.next_sg++;
+        }
         const size_t next = s_cur_transfer.next_desc;
         sdmmc_desc_t* desc = &s_dma_desc[next];
         assert(!desc->owned_by_idmac);
         size_t size_to_fill =
-            (s_cur_transfer.size_remaining < SDMMC_DMA_MAX_BUF_LEN) ?
-            s_cur_transfer.size_remaining : SDMMC_DMA_MAX_BUF_LEN;
+            (s_cur_transfer.buf_remaining < SDMMC_DMA_MAX_BUF_LEN) ?
+            s_cur_transfer.buf_remaining : SDMMC_DMA_MAX_BUF_LEN;
         bool last = size_to_fill == s_cur_transfer.size_remaining;
         desc->last_descriptor = last;
         desc->second_address_chained = 1;
@@ -253,6 +311,7 @@ static void fill_dma_descriptors(size_t num_desc)
         desc->buffer1_size = (size_to_fill + 3) & (~3);
 
         s_cur_transfer.size_remaining -= size_to_fill;
+        s_cur_transfer.buf_remaining -= size_to_fill;
         s_cur_transfer.ptr += size_to_fill;
         s_cur_transfer.next_desc = (s_cur_transfer.next_desc + 1) % SDMMC_DMA_DESC_CNT;
         ESP_LOGV(TAG, "fill %d desc=%d rem=%d next=%d last=%d sz=%d",
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -38,6 +38,18 @@ void sdmmc_test_rw_performance(sdmmc_card_t *card, FILE *perf_log);
  */
 void sdmmc_test_rw_unaligned_buffer(sdmmc_card_t* card);
 
+/**
+ * @brief Test read/write with several buffers
+ *
+ * This function verifies that data written from or read into several buffers with
+ * sdmmc_write_sectors_sg and sdmmc_read_sectors_sg is the same as with a single buffer.
+ *
+ * This test function works both with SDMMC and SDSPI hosts.
+ *
+ * @param card Pointer to the card object, must be initialized before calling this function.
+ */
+void sdmmc_test_rw_scatter_gather(sdmmc_card_t* card);
+
 /**
  * @brief Test read/write with offset
  *
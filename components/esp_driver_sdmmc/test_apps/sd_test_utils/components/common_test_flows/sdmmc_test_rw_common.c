@@ -103,7 +103,8 @@ static void do_single_rw_perf_test(sdmmc_card_t* card, size_t start_block,
 
 void sdmmc_test_rw_unaligned_buffer(sdmmc_card_t* card)
 {
-    const size_t buffer_size = 4096;
+    // Not a multiple of the number of blocks copied through the temporary buffer at once
+    const size_t buffer_size = 25 * 512;
     const size_t block_count = buffer_size / 512;
     const size_t extra = 4;
     const size_t total_size = buffer_size + extra;
@@ -132,6 +133,59 @@ void sdmmc_test_rw_unaligned_buffer(sdmmc_card_t* card)
     free(buffer);
 }
 
+void sdmmc_test_rw_scatter_gather(sdmmc_card_t* card)
+{
+    // The second buffer is larger than the buffer of one DMA descriptor
+    const size_t block_counts[] = { 1, 9, 2 };
+    const size_t entry_count = sizeof(block_counts) / sizeof(block_counts[0]);
+    const size_t block_count = 12;
+    const size_t buffer_size = block_count * 512;
+    esp_dma_mem_info_t dma_mem_info = {
+        .dma_alignment_bytes = 64,
+    };
+    uint8_t *buffer = NULL;
+    size_t actual_size = 0;
+    TEST_ESP_OK(esp_dma_capable_malloc(buffer_size, &dma_mem_info, (void**) &buffer, &actual_size));
+    sdmmc_sg_entry_t sg[entry_count];
+    for (size_t i = 0; i < entry_count; ++i) {
+        sg[i].size = block_counts[i] * 512;
+        actual_size = 0;
+        TEST_ESP_OK(esp_dma_capable_malloc(sg[i].size, &dma_mem_info, &sg[i].buf, &actual_size));
+    }
+
+    // Gather the buffers into one write, then read contiguously
+    const uint32_t seed = 0x1234abcd;
+    fill_buffer(seed, buffer, buffer_size / sizeof(uint32_t));
+    size_t offset = 0;
+    for (size_t i = 0; i < entry_count; ++i) {
+        memcpy(sg[i].buf, buffer + offset, sg[i].size);
+        offset += sg[i].size;
+    }
+    TEST_ESP_OK(sdmmc_write_sectors_sg(card, sg, entry_count, 0));
+    memset(buffer, 0xcc, buffer_size);
+    TEST_ESP_OK(sdmmc_read_sectors(card, buffer, 0, block_count));
+    check_buffer(seed, buffer, buffer_size / sizeof(uint32_t));
+
+    // Scatter one read into the buffers
+    for (size_t i = 0; i < entry_count; ++i) {
+        memset(sg[i].buf, 0xcc, sg[i].size);
+    }
+    TEST_ESP_OK(sdmmc_read_sectors_sg(card, sg, entry_count, 0));
+    offset = 0;
+    for (size_t i = 0; i < entry_count; ++i) {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(buffer + offset, sg[i].buf, sg[i].size);
+        offset += sg[i].size;
+    }
+
+    sdmmc_sg_entry_t bad_entry = { .buf = buffer, .size = 100 };
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, sdmmc_write_sectors_sg(card, &bad_entry, 1, 0));
+
+    for (size_t i = 0; i < entry_count; ++i) {
+        free(sg[i].buf);
+    }
+    free(buffer);
+}
+
 void sdmmc_test_rw_performance(sdmmc_card_t *card, FILE *perf_log)
 {
     sdmmc_card_print_info(stdout, card);
@@ -78,6 +78,12 @@ void sdmmc_test_sd_begin(int slot, int width, int freq_khz, int ddr, sdmmc_card_
         config.flags |= SDMMC_HOST_FLAG_DDR;
     }
 
+#if SOC_SDMMC_UHS_I_SUPPORTED
+    if (width == 4 && freq_khz > SDMMC_FREQ_HIGHSPEED) {
+        config.flags |= SDMMC_HOST_FLAG_UHS1;
+    }
+#endif
+
 #if SOC_SDMMC_IO_POWER_EXTERNAL
 #define SDMMC_PWR_LDO_CHANNEL   4
     sd_pwr_ctrl_ldo_config_t ldo_config = {
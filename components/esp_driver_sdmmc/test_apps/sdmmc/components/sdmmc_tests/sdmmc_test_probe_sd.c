@@ -1,10 +1,11 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stddef.h>
 #include "unity.h"
+#include "soc/soc_caps.h"
 #include "sdmmc_cmd.h"
 #include "sdmmc_test_begin_end_sd.h"
 
@@ -41,6 +42,13 @@ TEST_CASE("sdmmc probe, slot 0, 4-bit DDR", "[sdmmc]")
     do_one_sdmmc_probe_test(SLOT_0, 4, SDMMC_FREQ_HIGHSPEED, WITH_DDR);
 }
 
+#if SOC_SDMMC_UHS_I_SUPPORTED
+TEST_CASE("sdmmc probe, slot 0, 4-bit UHS-I SDR50", "[sdmmc]")
+{
+    do_one_sdmmc_probe_test(SLOT_0, 4, SDMMC_FREQ_SDR50, NO_DDR);
+}
+#endif
+
 TEST_CASE("sdmmc probe, slot 0, 8-bit", "[sdmmc]")
 {
     do_one_sdmmc_probe_test(SLOT_0, 8, SDMMC_FREQ_PROBING, NO_DDR);
@@ -106,3 +106,25 @@ TEST_CASE("sdmmc read/write using unaligned buffer, slot 1, 4-bit", "[sdmmc]")
 {
     do_one_sdmmc_rw_test_unaligned_buffer(SLOT_1, 4, SDMMC_FREQ_DEFAULT, 0);
 }
+
+/* ========== Read/write tests with several source/destination buffers, SD ========== */
+
+static void do_one_sdmmc_rw_test_scatter_gather(int slot, int width, int freq_khz, int ddr)
+{
+    sdmmc_card_t card;
+    sdmmc_test_sd_skip_if_board_incompatible(slot, width, freq_khz, ddr);
+    sdmmc_test_sd_begin(slot, width, freq_khz, ddr, &card);
+    sdmmc_card_print_info(stdout, &card);
+    sdmmc_test_rw_scatter_gather(&card);
+    sdmmc_test_sd_end(&card);
+}
+
+TEST_CASE("sdmmc read/write using scatter-gather buffers, slot 0, 4-bit", "[sdmmc]")
+{
+    do_one_sdmmc_rw_test_scatter_gather(SLOT_0, 4, SDMMC_FREQ_DEFAULT, 0);
+}
+
+TEST_CASE("sdmmc read/write using scatter-gather buffers, slot 1, 4-bit", "[sdmmc]")
+{
+    do_one_sdmmc_rw_test_scatter_gather(SLOT_1, 4, SDMMC_FREQ_DEFAULT, 0);
+}
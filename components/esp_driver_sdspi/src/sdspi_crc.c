@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,7 +7,7 @@
 #include <stdint.h>
 #include "sdspi_crc.h"
 #include "sdkconfig.h"
-#include "esp_rom_crc.h"
+#include "esp_crc.h"
 
 static const uint8_t crc7_table[256] = {
     0x00,  0x09,  0x12,  0x1b,  0x24,  0x2d,  0x36,  0x3f,  0x48,  0x41,  0x5a,  0x53,  0x6c,  0x65,  0x7e,  0x77,
@@ -41,5 +41,5 @@ uint8_t sdspi_crc7(const uint8_t *data, size_t size)
 /// Return CRC16 of data, in the on-the-wire format used by SD protocol
 uint16_t sdspi_crc16(const uint8_t* data, size_t size)
 {
-    return __builtin_bswap16(esp_rom_crc16_be(UINT16_MAX, data, size) ^ UINT16_MAX);
+    return __builtin_bswap16(esp_crc16_be(UINT16_MAX, data, size) ^ UINT16_MAX);
 }
@@ -159,6 +159,8 @@ typedef struct {
 } spi_transaction_ext_t ;
 
 typedef struct spi_device_t *spi_device_handle_t;  ///< Handle for a device on a SPI bus
+typedef struct spi_trans_chain_t *spi_trans_chain_handle_t;  ///< Handle for a chain of SPI transactions, see ``spi_device_trans_chain_create``
+typedef struct spi_trans_template_t *spi_trans_template_handle_t;  ///< Handle for a pre-compiled SPI transaction, see ``spi_device_trans_template_create``
 /**
  * @brief Allocate a device on a SPI bus
  *
@@ -259,6 +261,89 @@ esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transactio
  */
 esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
 
+/**
+ * @brief Prepare a chain of transactions which are sent back-to-back as one interrupt transaction.
+ *
+ * The transactions of a chain are checked and prepared once here, and every time the chain is queued by
+ * ``spi_device_queue_trans_chain``, they are sent one after another directly from the SPI interrupt, without
+ * going through the transaction queue, the bus arbitration or the ``pre_cb`` and ``post_cb`` of each
+ * transaction. ``pre_cb`` is only called for the first transaction and ``post_cb`` for the last one.
+ * This is meant for sequences of small transactions sent repeatedly, e.g. reading a sensor, where the
+ * fixed cost per transaction would dominate.
+ *
+ * The CS line is toggled between the transactions, unless ``SPI_TRANS_CS_KEEP_ACTIVE`` is set on a
+ * transaction; as no other device can use the bus between the transactions of a chain, the bus only has
+ * to be acquired if the flag is set on the last transaction.
+ *
+ * If the host is in SCT mode (see ``spi_bus_multi_trans_mode_enable``) when the chain is created, the
+ * transactions must be ``spi_multi_transaction_t``, and the whole chain is run by the hardware from one
+ * DMA descriptor list, with a single interrupt when it is done.
+ *
+ * @note The buffers of the transactions are used directly by the DMA, they must be DMA-capable and meet the
+ *       alignment of ``SPI_TRANS_DMA_BUFFER_ALIGN_MANUAL``. The transactions and their buffers must be kept
+ *       until the chain is deleted, and may only be modified while the chain is not queued. Only the data of the
+ *       buffers may be changed, not the lengths or flags of the transactions.
+ *
+ * @param handle Device handle obtained using spi_host_add_dev
+ * @param trans_list Transactions of the chain, in the order they are sent
+ * @param trans_num Number of transactions in ``trans_list``
+ * @param[out] ret_chain Handle of the chain
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid, or a buffer cannot be used by the DMA directly
+ *         - ESP_ERR_NO_MEM        if out of memory
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_trans_chain_create(spi_device_handle_t handle, spi_transaction_t *const trans_list[], uint32_t trans_num, spi_trans_chain_handle_t *ret_chain);
+
+/**
+ * @brief Delete a chain of transactions created by ``spi_device_trans_chain_create``
+ *
+ * @param chain Handle of the chain
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *         - ESP_ERR_INVALID_STATE if the chain is still queued
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_trans_chain_delete(spi_trans_chain_handle_t chain);
+
+/**
+ * @brief Queue a chain of transactions for interrupt transaction execution. Get the result by ``spi_device_get_trans_chain_result``.
+ *
+ * The chain takes one entry of the transaction queue of the device, and can be queued together with single
+ * transactions of the same device. It is completed after all its transactions are done.
+ *
+ * @param chain Handle of the chain
+ * @param ticks_to_wait Ticks to wait until there's room in the queue; use portMAX_DELAY to
+ *                      never time out.
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid. This can happen if SPI_TRANS_CS_KEEP_ACTIVE flag is specified
+ *                                 on the last transaction while the bus was not acquired
+ *         - ESP_ERR_TIMEOUT       if there was no room in the queue before ticks_to_wait expired
+ *         - ESP_ERR_INVALID_STATE if the chain is already queued, the SCT mode of the host was changed since the chain
+ *                                 was created, or a polling transaction is not finished
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_queue_trans_chain(spi_trans_chain_handle_t chain, TickType_t ticks_to_wait);
+
+/**
+ * @brief Get the result of a chain of transactions queued earlier by ``spi_device_queue_trans_chain``.
+ *
+ * The results of the device are returned in the order the transactions and chains were queued; this must
+ * only be called when the next result of the device is a chain.
+ *
+ * @param handle Device handle obtained using spi_host_add_dev
+ * @param[out] chain Handle of the completed chain
+ * @param ticks_to_wait Ticks to wait until there's a returned item; use portMAX_DELAY to never time
+ *                      out.
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *         - ESP_ERR_NOT_SUPPORTED if flag `SPI_DEVICE_NO_RETURN_RESULT` is set
+ *         - ESP_ERR_INVALID_STATE if the returned item is a single transaction, which is then released
+ *         - ESP_ERR_TIMEOUT       if there was no completed chain before ticks_to_wait expired
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_get_trans_chain_result(spi_device_handle_t handle, spi_trans_chain_handle_t *chain, TickType_t ticks_to_wait);
+
 /**
  * @brief Immediately start a polling transaction.
  *
@@ -320,6 +405,69 @@ esp_err_t spi_device_polling_end(spi_device_handle_t handle, TickType_t ticks_to
  */
 esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
 
+/**
+ * @brief Compile a transaction into a template which can be sent repeatedly as a polling transaction at a low CPU cost.
+ *
+ * The transaction is checked, its register configuration is computed and its DMA descriptors are built once here.
+ * Sending the template with ``spi_device_polling_start_template`` then only writes the prepared configuration to
+ * the peripheral and starts the DMA, e.g. to read the same register of an ADC many times per second.
+ *
+ * @note The buffers of the transaction are used directly by the DMA, they must be DMA-capable and meet the
+ *       alignment of ``SPI_TRANS_DMA_BUFFER_ALIGN_MANUAL``. The transaction and its buffers must be kept until the
+ *       template is deleted. Only the data of the buffers may be changed between two sends, not the descriptor.
+ *
+ * @param handle Device handle obtained using spi_host_add_dev
+ * @param trans_desc Description of the transaction
+ * @param[out] ret_template Handle of the template
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid, or a buffer cannot be used by the DMA directly
+ *         - ESP_ERR_NO_MEM        if out of memory
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_trans_template_create(spi_device_handle_t handle, spi_transaction_t *trans_desc, spi_trans_template_handle_t *ret_template);
+
+/**
+ * @brief Delete a template created by ``spi_device_trans_template_create``
+ *
+ * @param trans_template Handle of the template, must not be in flight
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_trans_template_delete(spi_trans_template_handle_t trans_template);
+
+/**
+ * @brief Immediately start a polling transaction from a template. Finish it with ``spi_device_polling_end``.
+ *
+ * Same as ``spi_device_polling_start``, using the configuration prepared by ``spi_device_trans_template_create``.
+ *
+ * @param trans_template Handle of the template
+ * @param ticks_to_wait Ticks to wait until there's room in the queue;
+ *              currently only portMAX_DELAY is supported.
+ *
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid. This can happen if SPI_TRANS_CS_KEEP_ACTIVE flag is specified while
+ *                                 the bus was not acquired (`spi_device_acquire_bus()` should be called first)
+ *         - ESP_ERR_TIMEOUT       if the device cannot get control of the bus before ``ticks_to_wait`` expired
+ *         - ESP_ERR_INVALID_STATE if previous transactions are not finished
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_polling_start_template(spi_trans_template_handle_t trans_template, TickType_t ticks_to_wait);
+
+/**
+ * @brief Send a polling transaction from a template, wait for it to complete, and return the result
+ *
+ * This function is the equivalent of calling spi_device_polling_start_template() followed by spi_device_polling_end().
+ *
+ * @param trans_template Handle of the template
+ * @return
+ *         - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *         - ESP_ERR_TIMEOUT       if the device cannot get control of the bus
+ *         - ESP_ERR_INVALID_STATE if previous transactions of same device are not finished
+ *         - ESP_OK                on success
+ */
+esp_err_t spi_device_polling_transmit_template(spi_trans_template_handle_t trans_template);
+
 /**
  * @brief Occupy the SPI bus for a device to do continuous transactions.
  *
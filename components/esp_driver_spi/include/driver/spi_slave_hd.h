@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2010-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2010-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -84,6 +84,8 @@ typedef struct {
     uint32_t queue_size;                        ///< Transaction queue size. This sets how many transactions can be 'in the air' (queued using spi_slave_hd_queue_trans but not yet finished using spi_slave_hd_get_trans_result) at the same time
     spi_dma_chan_t dma_chan;                    ///< DMA channel to used.
     spi_slave_hd_callback_config_t cb_config;   ///< Callback configuration
+    uint32_t pool_buf_num;                      ///< Append mode only. Number of DMA buffers the driver allocates for each of TX and RX, not larger than ``queue_size``. Set to 0 to disable the buffer pool. See ``spi_slave_hd_get_pool_trans``
+    uint32_t pool_buf_size;                     ///< Size of each buffer of the pool in bytes, multiples of 4 bytes and not larger than 4092 bytes. RX transactions of the pool always receive this length
 } spi_slave_hd_slot_config_t;
 
 /**
@@ -205,6 +207,43 @@ esp_err_t spi_slave_hd_append_trans(spi_host_device_t host_id, spi_slave_chan_t
  */
 esp_err_t spi_slave_hd_get_append_trans_res(spi_host_device_t host_id, spi_slave_chan_t chan, spi_slave_hd_data_t **out_trans, TickType_t timeout);
 
+/**
+ * @brief Get a free TX transaction of the buffer pool (append mode)
+ *
+ * The buffers of the pool are allocated by the driver to meet the DMA requirements, so that they are sent without being
+ * copied. Fill the data into ``trans->data``, set ``trans->len`` and load the transaction by ``spi_slave_hd_append_trans``.
+ * When it is returned by ``spi_slave_hd_get_append_trans_res``, give it back by ``spi_slave_hd_recycle_pool_trans``.
+ *
+ * @note The RX transactions of the pool are loaded by the driver during initialization, so that the DMA always has buffers
+ *       to receive into. They are returned by ``spi_slave_hd_get_append_trans_res`` and should be given back by
+ *       ``spi_slave_hd_recycle_pool_trans`` once the received data is processed, which loads them again.
+ *
+ * @param host_id   Host to get the transaction
+ * @param[out] out_trans Free TX transaction of the pool
+ * @param timeout   Timeout before a transaction of the pool is free
+ * @return
+ *  - ESP_OK: on success
+ *  - ESP_ERR_INVALID_ARG: The input argument is invalid
+ *  - ESP_ERR_TIMEOUT: All the TX transactions of the pool are in use until timeout
+ *  - ESP_ERR_INVALID_STATE: The buffer pool is not enabled, see ``pool_buf_num`` of ``spi_slave_hd_slot_config_t``
+ */
+esp_err_t spi_slave_hd_get_pool_trans(spi_host_device_t host_id, spi_slave_hd_data_t **out_trans, TickType_t timeout);
+
+/**
+ * @brief Give a transaction back to the buffer pool (append mode)
+ *
+ * A TX transaction becomes free for ``spi_slave_hd_get_pool_trans`` again, while an RX transaction is loaded again to receive data.
+ *
+ * @param host_id   Host of the transaction
+ * @param chan      SPI_SLAVE_CHAN_TX or SPI_SLAVE_CHAN_RX
+ * @param trans     Transaction of the pool, returned by ``spi_slave_hd_get_append_trans_res``
+ * @return
+ *  - ESP_OK: on success
+ *  - ESP_ERR_INVALID_ARG: The transaction doesn't belong to the pool of this channel
+ *  - ESP_ERR_INVALID_STATE: The buffer pool is not enabled, or the RX transaction can't be loaded again
+ */
+esp_err_t spi_slave_hd_recycle_pool_trans(spi_host_device_t host_id, spi_slave_chan_t chan, spi_slave_hd_data_t *trans);
+
 #ifdef __cplusplus
 }
 #endif
@@ -162,6 +162,7 @@ typedef struct {
     const uint32_t *buffer_to_send;    //equals to tx_data, if SPI_TRANS_USE_RXDATA is applied; otherwise if original buffer wasn't in DMA-capable memory, this gets the address of a temporary buffer that is;
     //otherwise sets to the original buffer or NULL if no buffer is assigned.
     uint32_t *buffer_to_rcv;           //similar to buffer_to_send
+    struct spi_trans_chain_t *chain;   //the chain this transaction belongs to, or NULL for single transactions
 #if SOC_SPI_SCT_SUPPORTED
     uint32_t reserved[2];              //As we create the queue when in init, to use sct mode private descriptor as a queue item (when in sct mode), we need to add a dummy member here to keep the same size with `spi_sct_trans_priv_t`.
 #endif
@@ -176,6 +177,7 @@ typedef struct {
     uint32_t                *sct_conf_buffer;
     uint16_t                tx_used_desc_num;
     uint16_t                rx_used_desc_num;
+    struct spi_trans_chain_t *chain;  //the chain owning the conf buffer and the descriptors, or NULL if they come from the pool
 } spi_sct_trans_priv_t;
 _Static_assert(sizeof(spi_trans_priv_t) == sizeof(spi_sct_trans_priv_t));   //size of spi_trans_priv_t must be the same as size of spi_sct_trans_priv_t
 
@@ -229,6 +231,32 @@ struct spi_device_t {
     spi_bus_lock_dev_handle_t dev_lock;
 };
 
+/// Chain of transactions prepared by `spi_device_trans_chain_create`
+struct spi_trans_chain_t {
+    spi_device_t *dev;
+    uint32_t trans_num;
+    uint32_t cur_index;             //index of the transaction in flight, only used by the ISR
+    volatile bool queued;           //set when queued, cleared by the ISR when the last transaction is done
+    bool sct_mode;                  //the chain is run by the hardware from the descriptors below
+    spi_trans_priv_t *trans_buf;    //prepared buffers of each transaction, not used in SCT mode
+#if SOC_SPI_SCT_SUPPORTED
+    spi_sct_trans_priv_t sct_trans;
+    spi_dma_desc_t *sct_tx_desc;
+    spi_dma_desc_t *sct_rx_desc;
+#endif
+};
+
+/// Transaction compiled by `spi_device_trans_template_create`
+struct spi_trans_template_t {
+    spi_device_t *dev;
+    spi_trans_priv_t trans_buf;
+    spi_hal_trans_config_t hal_trans;   //register configuration of the transaction
+    spi_dma_desc_t *dmadesc_tx;         //DMA descriptors of the template, NULL without DMA or data
+    spi_dma_desc_t *dmadesc_rx;
+    uint32_t tx_desc_num;
+    uint32_t rx_desc_num;
+};
+
 static spi_host_t* bus_driver_ctx[SOC_SPI_PERIPH_NUM] = {};
 
 static void spi_intr(void *arg);
@@ -730,12 +758,11 @@ static void SPI_MASTER_ISR_ATTR s_spi_prepare_data(spi_device_t *dev, const spi_
 
 static void SPI_MASTER_ISR_ATTR spi_format_hal_trans_struct(spi_device_t *dev, spi_trans_priv_t *trans_buf, spi_hal_trans_config_t *hal_trans)
 {
-    spi_host_t *host = dev->host;
     spi_transaction_t *trans = trans_buf->trans;
     hal_trans->tx_bitlen = trans->length;
     hal_trans->rx_bitlen = trans->rxlength;
-    hal_trans->rcv_buffer = (uint8_t*)host->cur_trans_buf.buffer_to_rcv;
-    hal_trans->send_buffer = (uint8_t*)host->cur_trans_buf.buffer_to_send;
+    hal_trans->rcv_buffer = (uint8_t*)trans_buf->buffer_to_rcv;
+    hal_trans->send_buffer = (uint8_t*)trans_buf->buffer_to_send;
     hal_trans->cmd = trans->cmd;
     hal_trans->addr = trans->addr;
 
@@ -786,14 +813,67 @@ static void SPI_MASTER_ISR_ATTR spi_new_trans(spi_device_t *dev, spi_trans_priv_
     spi_hal_setup_trans(hal, hal_dev, &hal_trans);
     s_spi_prepare_data(dev, &hal_trans);
 
-    //Call pre-transmission callback, if any
-    if (dev->cfg.pre_cb) {
+    //Call pre-transmission callback, if any. It is only called once for a chain.
+    if (dev->cfg.pre_cb && (trans_buf->chain == NULL || trans_buf->chain->cur_index == 0)) {
         dev->cfg.pre_cb(trans);
     }
     //Kick off transfer
     spi_hal_user_start(hal);
 }
 
+static void SPI_MASTER_ISR_ATTR s_spi_dma_rearm_desc(spi_dma_desc_t *dmadesc, uint32_t desc_num)
+{
+    dmadesc = ADDR_DMA_2_CPU(dmadesc);
+    for (int i = 0; i < desc_num; i++) {
+        dmadesc[i].dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+    }
+}
+
+// Same as `spi_new_trans`, but the configuration and the DMA descriptors have been prepared by `spi_device_trans_template_create`
+static void SPI_MASTER_ISR_ATTR spi_new_trans_template(struct spi_trans_template_t *trans_template)
+{
+    spi_device_t *dev = trans_template->dev;
+    spi_host_t *host = dev->host;
+    spi_hal_context_t *hal = &host->hal;
+    spi_hal_dev_config_t *hal_dev = &dev->hal_dev;
+    const spi_hal_trans_config_t *hal_trans = &trans_template->hal_trans;
+
+    host->cur_cs = dev->id;
+    spi_setup_device(dev);
+    spi_hal_setup_trans(hal, hal_dev, hal_trans);
+
+    if (host->bus_attr->dma_enabled) {
+        const spi_dma_ctx_t *dma_ctx = host->dma_ctx;
+        if (trans_template->dmadesc_rx) {
+            s_spi_dma_rearm_desc(trans_template->dmadesc_rx, trans_template->rx_desc_num);
+            spi_dma_reset(dma_ctx->rx_dma_chan);
+            spi_hal_hw_prepare_rx(hal->hw);
+            spi_dma_start(dma_ctx->rx_dma_chan, trans_template->dmadesc_rx);
+        }
+#if CONFIG_IDF_TARGET_ESP32
+        else if (!hal_dev->half_duplex) {
+            //DMA temporary workaround: let RX DMA work somehow to avoid the issue in ESP32 v0/v1 silicon
+            spi_ll_dma_rx_enable(hal->hw, 1);
+            spi_dma_start(dma_ctx->rx_dma_chan, NULL);
+        }
+#endif
+        if (trans_template->dmadesc_tx) {
+            s_spi_dma_rearm_desc(trans_template->dmadesc_tx, trans_template->tx_desc_num);
+            spi_dma_reset(dma_ctx->tx_dma_chan);
+            spi_hal_hw_prepare_tx(hal->hw);
+            spi_dma_start(dma_ctx->tx_dma_chan, trans_template->dmadesc_tx);
+        }
+    } else {
+        spi_hal_push_tx_buffer(hal, hal_trans);
+    }
+    spi_hal_enable_data_line(hal->hw, (!hal_dev->half_duplex && hal_trans->rcv_buffer) || hal_trans->send_buffer, !!hal_trans->rcv_buffer);
+
+    if (dev->cfg.pre_cb) {
+        dev->cfg.pre_cb(trans_template->trans_buf.trans);
+    }
+    spi_hal_user_start(hal);
+}
+
 // The function is called when a transaction is done, in ISR or in the task.
 // Fetch the data from FIFO and call the ``post_cb``.
 static void SPI_MASTER_ISR_ATTR spi_post_trans(spi_host_t *host)
@@ -808,10 +888,37 @@ static void SPI_MASTER_ISR_ATTR spi_post_trans(spi_host_t *host)
     if (dev->cfg.post_cb) {
         dev->cfg.post_cb(cur_trans);
     }
+    if (host->cur_trans_buf.chain) {
+        host->cur_trans_buf.chain->queued = false;
+    }
 
     host->cur_cs = DEV_NUM_MAX;
 }
 
+// The function is called when a transaction of a chain is done in the ISR, start the next one of the chain if there is.
+// The ISR can then return at once: the bus stays with the device, and nothing is returned until the chain is done.
+static bool SPI_MASTER_ISR_ATTR spi_trans_chain_next(spi_host_t *host)
+{
+    struct spi_trans_chain_t *chain = host->cur_trans_buf.chain;
+    if (chain == NULL || chain->cur_index + 1 >= chain->trans_num) {
+        return false;
+    }
+
+    if (!host->bus_attr->dma_enabled) {
+        spi_hal_fetch_result(&host->hal);
+    }
+    chain->cur_index++;
+    host->cur_trans_buf = chain->trans_buf[chain->cur_index];
+#if CONFIG_IDF_TARGET_ESP32
+    if (host->bus_attr->dma_enabled && (host->cur_trans_buf.buffer_to_rcv || host->cur_trans_buf.buffer_to_send)) {
+        //This workaround is only for esp32, where tx_dma_chan and rx_dma_chan are always same
+        spicommon_dmaworkaround_transfer_active(host->dma_ctx->tx_dma_chan.chan_id);
+    }
+#endif  //#if CONFIG_IDF_TARGET_ESP32
+    spi_new_trans(chain->dev, &host->cur_trans_buf);
+    return true;
+}
+
 #if SOC_SPI_SCT_SUPPORTED
 static void SPI_MASTER_ISR_ATTR spi_sct_set_hal_trans_config(spi_multi_transaction_t *trans_header, spi_hal_trans_config_t *hal_trans)
 {
@@ -874,7 +981,12 @@ static void SPI_MASTER_ISR_ATTR spi_post_sct_trans(spi_host_t *host)
         assert(host->cur_sct_trans.rx_used_desc_num == 0);
     }
 
-    free(host->cur_sct_trans.sct_conf_buffer);
+    if (host->cur_sct_trans.chain) {
+        //The conf buffer and the descriptors of a chain are kept for the next time it's queued
+        host->cur_sct_trans.chain->queued = false;
+    } else {
+        free(host->cur_sct_trans.sct_conf_buffer);
+    }
     portENTER_CRITICAL_ISR(&host->spinlock);
     spi_hal_sct_tx_dma_desc_recycle(&host->sct_desc_pool, host->cur_sct_trans.tx_used_desc_num);
     spi_hal_sct_rx_dma_desc_recycle(&host->sct_desc_pool, host->cur_sct_trans.rx_used_desc_num);
@@ -937,6 +1049,15 @@ static void SPI_MASTER_ISR_ATTR spi_intr(void *arg)
 #endif
         }
 
+        if (!host->sct_mode_enabled && spi_trans_chain_next(host)) {
+            //The next transaction of the chain is in flight, keep the interrupt enabled for it
+            spi_bus_lock_bg_exit(bus_attr->lock, true, &do_yield);
+            if (do_yield) {
+                portYIELD_FROM_ISR();
+            }
+            return;
+        }
+
 #if SOC_SPI_SCT_SUPPORTED
         if (host->sct_mode_enabled) {
             //cur_cs is changed to DEV_NUM_MAX here
@@ -1188,6 +1309,15 @@ clean_up:
     return ESP_ERR_NO_MEM;
 }
 
+// Whether the buffers given to the DMA are the ones of the transaction, not temporary buffers allocated by `setup_priv_desc`
+static bool priv_desc_is_direct(const spi_trans_priv_t *trans_buf)
+{
+    const spi_transaction_t *trans_desc = trans_buf->trans;
+    bool tx_direct = !trans_buf->buffer_to_send || (void *)trans_buf->buffer_to_send == &trans_desc->tx_data[0] || trans_buf->buffer_to_send == trans_desc->tx_buffer;
+    bool rx_direct = !trans_buf->buffer_to_rcv || (void *)trans_buf->buffer_to_rcv == &trans_desc->rx_data[0] || trans_buf->buffer_to_rcv == trans_desc->rx_buffer;
+    return tx_direct && rx_direct;
+}
+
 esp_err_t SPI_MASTER_ATTR spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait)
 {
     esp_err_t ret = check_trans_valid(handle, trans_desc);
@@ -1351,6 +1481,25 @@ void SPI_MASTER_ISR_ATTR spi_device_release_bus(spi_device_t *dev)
     (void) ret;
 }
 
+static SPI_MASTER_ISR_ATTR esp_err_t polling_acquire_bus(spi_device_handle_t handle, const spi_transaction_t *trans_desc, TickType_t ticks_to_wait)
+{
+    esp_err_t ret;
+    /* If device_acquiring_lock is set to handle, it means that the user has already
+     * acquired the bus thanks to the function `spi_device_acquire_bus()`.
+     * In that case, we don't need to take the lock again. */
+    if (handle->host->device_acquiring_lock != handle) {
+        /* The user cannot ask for the CS to keep active has the bus is not locked/acquired. */
+        if ((trans_desc->flags & SPI_TRANS_CS_KEEP_ACTIVE) != 0) {
+            ret = ESP_ERR_INVALID_ARG;
+        } else {
+            ret = spi_bus_lock_acquire_start(handle->dev_lock, ticks_to_wait);
+        }
+    } else {
+        ret = spi_bus_lock_wait_bg_done(handle->dev_lock, ticks_to_wait);
+    }
+    return ret;
+}
+
 esp_err_t SPI_MASTER_ISR_ATTR spi_device_polling_start(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait)
 {
     esp_err_t ret;
@@ -1368,19 +1517,7 @@ esp_err_t SPI_MASTER_ISR_ATTR spi_device_polling_start(spi_device_handle_t handl
         return ret;
     }
 
-    /* If device_acquiring_lock is set to handle, it means that the user has already
-     * acquired the bus thanks to the function `spi_device_acquire_bus()`.
-     * In that case, we don't need to take the lock again. */
-    if (host->device_acquiring_lock != handle) {
-        /* The user cannot ask for the CS to keep active has the bus is not locked/acquired. */
-        if ((trans_desc->flags & SPI_TRANS_CS_KEEP_ACTIVE) != 0) {
-            ret = ESP_ERR_INVALID_ARG;
-        } else {
-            ret = spi_bus_lock_acquire_start(handle->dev_lock, ticks_to_wait);
-        }
-    } else {
-        ret = spi_bus_lock_wait_bg_done(handle->dev_lock, ticks_to_wait);
-    }
+    ret = polling_acquire_bus(handle, trans_desc, ticks_to_wait);
     if (ret != ESP_OK) {
         uninstall_priv_desc(&priv_polling_trans);
         ESP_LOGE(SPI_TAG, "polling can't get buslock");
@@ -1456,6 +1593,110 @@ esp_err_t SPI_MASTER_ISR_ATTR spi_device_polling_transmit(spi_device_handle_t ha
     return spi_device_polling_end(handle, portMAX_DELAY);
 }
 
+esp_err_t spi_device_trans_template_delete(spi_trans_template_handle_t trans_template)
+{
+    SPI_CHECK(trans_template, "invalid template handle", ESP_ERR_INVALID_ARG);
+    free(trans_template->dmadesc_tx);
+    free(trans_template->dmadesc_rx);
+    free(trans_template);
+    return ESP_OK;
+}
+
+static spi_dma_desc_t *s_template_alloc_dma_desc(const void *buffer, uint32_t bitlen, bool is_rx, uint32_t *desc_num)
+{
+    uint32_t len = (bitlen + 7) / 8;
+    *desc_num = (len + DMA_DESCRIPTOR_BUFFER_MAX_SIZE_4B_ALIGNED - 1) / DMA_DESCRIPTOR_BUFFER_MAX_SIZE_4B_ALIGNED;
+    spi_dma_desc_t *dmadesc = heap_caps_aligned_calloc(DMA_DESC_MEM_ALIGN_SIZE, 1, sizeof(spi_dma_desc_t) * (*desc_num), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (dmadesc) {
+        spicommon_dma_desc_setup_link(dmadesc, buffer, len, is_rx);
+    }
+    return dmadesc;
+}
+
+esp_err_t spi_device_trans_template_create(spi_device_handle_t handle, spi_transaction_t *trans_desc, spi_trans_template_handle_t *ret_template)
+{
+    SPI_CHECK(trans_desc && ret_template, "invalid arguments", ESP_ERR_INVALID_ARG);
+    esp_err_t ret = check_trans_valid(handle, trans_desc);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    spi_host_t *host = handle->host;
+
+    struct spi_trans_template_t *trans_template = heap_caps_calloc(1, sizeof(struct spi_trans_template_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    SPI_CHECK(trans_template, "No enough memory", ESP_ERR_NO_MEM);
+    trans_template->dev = handle;
+    trans_template->trans_buf.trans = trans_desc;
+    ret = setup_priv_desc(host, &trans_template->trans_buf);
+    if (ret != ESP_OK) {
+        free(trans_template);
+        return ret;
+    }
+    //The template is sent many times, it can't use temporary buffers which would need to be copied each time
+    if (!priv_desc_is_direct(&trans_template->trans_buf)) {
+        uninstall_priv_desc(&trans_template->trans_buf);
+        free(trans_template);
+        ESP_LOGE(SPI_TAG, "buffers of template not DMA-capable or not aligned to %d", host->bus_attr->internal_mem_align_size);
+        return ESP_ERR_INVALID_ARG;
+    }
+    spi_format_hal_trans_struct(handle, &trans_template->trans_buf, &trans_template->hal_trans);
+
+    if (host->bus_attr->dma_enabled) {
+        const spi_trans_priv_t *trans_buf = &trans_template->trans_buf;
+        if (trans_buf->buffer_to_send) {
+            trans_template->dmadesc_tx = s_template_alloc_dma_desc(trans_buf->buffer_to_send, trans_desc->length, false, &trans_template->tx_desc_num);
+        }
+        if (trans_buf->buffer_to_rcv) {
+            trans_template->dmadesc_rx = s_template_alloc_dma_desc(trans_buf->buffer_to_rcv, trans_desc->rxlength, true, &trans_template->rx_desc_num);
+        }
+        if ((trans_buf->buffer_to_send && !trans_template->dmadesc_tx) || (trans_buf->buffer_to_rcv && !trans_template->dmadesc_rx)) {
+            spi_device_trans_template_delete(trans_template);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    *ret_template = trans_template;
+    return ESP_OK;
+}
+
+esp_err_t SPI_MASTER_ISR_ATTR spi_device_polling_start_template(spi_trans_template_handle_t trans_template, TickType_t ticks_to_wait)
+{
+    SPI_CHECK(trans_template, "invalid template handle", ESP_ERR_INVALID_ARG);
+    SPI_CHECK(ticks_to_wait == portMAX_DELAY, "currently timeout is not available for polling transactions", ESP_ERR_INVALID_ARG);
+    spi_device_t *handle = trans_template->dev;
+    spi_host_t *host = handle->host;
+    SPI_CHECK(!spi_bus_device_is_polling(handle), "Cannot send polling transaction while the previous polling transaction is not terminated.", ESP_ERR_INVALID_STATE);
+
+    esp_err_t ret = polling_acquire_bus(handle, trans_template->trans_buf.trans, ticks_to_wait);
+    if (ret != ESP_OK) {
+        ESP_LOGE(SPI_TAG, "polling can't get buslock");
+        return ret;
+    }
+
+#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
+    if (host->bus_attr->dma_enabled && trans_template->trans_buf.buffer_to_send) {
+        ret = esp_cache_msync((void *)trans_template->trans_buf.buffer_to_send, (trans_template->trans_buf.trans->length + 7) / 8, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+        assert(ret == ESP_OK);
+    }
+#endif
+
+    //Polling, no interrupt is used.
+    host->polling = true;
+    host->cur_trans_buf = trans_template->trans_buf;
+    spi_new_trans_template(trans_template);
+
+    return ESP_OK;
+}
+
+esp_err_t SPI_MASTER_ISR_ATTR spi_device_polling_transmit_template(spi_trans_template_handle_t trans_template)
+{
+    esp_err_t ret = spi_device_polling_start_template(trans_template, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    return spi_device_polling_end(trans_template->dev, portMAX_DELAY);
+}
+
 esp_err_t spi_bus_get_max_transaction_len(spi_host_device_t host_id, size_t *max_bytes)
 {
     SPI_CHECK(is_valid_host(host_id), "invalid host", ESP_ERR_INVALID_ARG);
@@ -1895,3 +2136,253 @@ esp_err_t SPI_MASTER_ATTR spi_device_get_multi_trans_result(spi_device_handle_t
     return ESP_OK;
 }
 #endif  //#if SOC_SPI_SCT_SUPPORTED
+
+/*-----------------------------------------------------------
+ * Transaction chains
+ *-----------------------------------------------------------*/
+#if SOC_SPI_SCT_SUPPORTED
+static esp_err_t s_sct_trans_chain_prepare(struct spi_trans_chain_t *chain, spi_transaction_t *const trans_list[])
+{
+    spi_device_t *handle = chain->dev;
+    const uint32_t trans_num = chain->trans_num;
+    uint32_t tx_desc_num = 0;
+    uint32_t rx_desc_num = 0;
+    for (int i = 0; i < trans_num; i++) {
+        SPI_CHECK(!(trans_list[i]->flags & SPI_TRANS_CS_KEEP_ACTIVE), "SPI_TRANS_CS_KEEP_ACTIVE not supported in SCT mode", ESP_ERR_INVALID_ARG);
+        //1 desc for the conf_buffer, other for data.
+        tx_desc_num += 1 + s_sct_desc_get_required_num((trans_list[i]->length + 7) / 8);
+        if (trans_list[i]->rx_buffer) {
+            rx_desc_num += s_sct_desc_get_required_num((trans_list[i]->rxlength + 7) / 8);
+        }
+    }
+
+    uint16_t alignment = handle->host->bus_attr->internal_mem_align_size;
+    uint32_t *conf_buffer = heap_caps_aligned_alloc(alignment, (trans_num * SOC_SPI_SCT_BUFFER_NUM_MAX * sizeof(uint32_t)), MALLOC_CAP_DMA);
+    chain->sct_tx_desc = heap_caps_aligned_calloc(DMA_DESC_MEM_ALIGN_SIZE, 1, sizeof(spi_dma_desc_t) * tx_desc_num, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (rx_desc_num) {
+        chain->sct_rx_desc = heap_caps_aligned_calloc(DMA_DESC_MEM_ALIGN_SIZE, 1, sizeof(spi_dma_desc_t) * rx_desc_num, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    }
+    chain->sct_trans.sct_conf_buffer = conf_buffer;
+    if (!conf_buffer || !chain->sct_tx_desc || (rx_desc_num && !chain->sct_rx_desc)) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_sct_init_conf_buffer(&handle->host->hal, conf_buffer, trans_num);
+
+    //The descriptors are private to the chain, so the segments are simply laid out one after another
+    spi_dma_desc_t *tx_desc = chain->sct_tx_desc;
+    spi_dma_desc_t *rx_desc = chain->sct_rx_desc;
+    spi_dma_desc_t *tx_tail = NULL;
+    spi_dma_desc_t *rx_tail = NULL;
+    for (int i = 0; i < trans_num; i++) {
+        spi_multi_transaction_t *seg_trans_desc = (spi_multi_transaction_t *)trans_list[i];
+        uint32_t *seg_conf_buffer = &conf_buffer[i * SOC_SPI_SCT_BUFFER_NUM_MAX];
+        s_sct_format_conf_buffer(handle, seg_trans_desc, seg_conf_buffer, (i == (trans_num - 1)));
+
+        //TX
+        spi_dma_desc_t *conf_desc = s_sct_setup_desc_anywhere(chain->sct_tx_desc, tx_desc, tx_desc_num, seg_conf_buffer, SOC_SPI_SCT_BUFFER_NUM_MAX * 4, false);
+        if (tx_tail) {
+            tx_tail->next = conf_desc;
+        }
+        tx_tail = conf_desc;
+        tx_desc = conf_desc + 1;
+        uint32_t tx_buf_len = (seg_trans_desc->base.length + 7) / 8;
+        if (seg_trans_desc->base.tx_buffer && tx_buf_len) {
+            conf_desc->next = tx_desc;
+            tx_tail = s_sct_setup_desc_anywhere(chain->sct_tx_desc, tx_desc, tx_desc_num, seg_trans_desc->base.tx_buffer, tx_buf_len, false);
+            tx_desc = tx_tail + 1;
+        }
+
+        //RX
+        if (seg_trans_desc->base.rx_buffer) {
+            spi_dma_desc_t *rx_head = rx_desc;
+            uint32_t rx_buf_len = (seg_trans_desc->base.rxlength + 7) / 8;
+            if (rx_tail) {
+                rx_tail->next = rx_head;
+            }
+            rx_tail = s_sct_setup_desc_anywhere(chain->sct_rx_desc, rx_head, rx_desc_num, seg_trans_desc->base.rx_buffer, rx_buf_len, true);
+            rx_desc = rx_tail + 1;
+        }
+    }
+
+    chain->sct_trans.tx_seg_head = chain->sct_tx_desc;
+    chain->sct_trans.rx_seg_head = chain->sct_rx_desc;
+    chain->sct_trans.sct_trans_desc_head = (spi_multi_transaction_t *)trans_list[0];
+    chain->sct_trans.chain = chain;
+    return ESP_OK;
+}
+#endif  //#if SOC_SPI_SCT_SUPPORTED
+
+#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
+static void s_trans_chain_sync_buffers(struct spi_trans_chain_t *chain, bool before_trans)
+{
+    if (chain->sct_mode || !chain->dev->host->bus_attr->dma_enabled) {
+        return;
+    }
+    for (int i = 0; i < chain->trans_num; i++) {
+        const spi_trans_priv_t *trans_buf = &chain->trans_buf[i];
+        if (before_trans && trans_buf->buffer_to_send) {
+            esp_err_t ret = esp_cache_msync((void *)trans_buf->buffer_to_send, (trans_buf->trans->length + 7) / 8, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+            assert(ret == ESP_OK);
+        }
+        if (trans_buf->buffer_to_rcv) {
+            esp_err_t ret = esp_cache_msync((void *)trans_buf->buffer_to_rcv, (trans_buf->trans->rxlength + 7) / 8, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+            assert(ret == ESP_OK);
+        }
+    }
+}
+#endif
+
+esp_err_t spi_device_trans_chain_delete(spi_trans_chain_handle_t chain)
+{
+    SPI_CHECK(chain, "invalid chain handle", ESP_ERR_INVALID_ARG);
+    SPI_CHECK(!chain->queued, "chain is still queued", ESP_ERR_INVALID_STATE);
+#if SOC_SPI_SCT_SUPPORTED
+    free(chain->sct_trans.sct_conf_buffer);
+    free(chain->sct_tx_desc);
+    free(chain->sct_rx_desc);
+#endif
+    free(chain->trans_buf);
+    free(chain);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_trans_chain_create(spi_device_handle_t handle, spi_transaction_t *const trans_list[], uint32_t trans_num, spi_trans_chain_handle_t *ret_chain)
+{
+    SPI_CHECK(handle && trans_list && trans_num && ret_chain, "invalid arguments", ESP_ERR_INVALID_ARG);
+    spi_host_t *host = handle->host;
+    esp_err_t ret = ESP_OK;
+
+    for (int i = 0; i < trans_num; i++) {
+        SPI_CHECK(trans_list[i], "invalid transaction", ESP_ERR_INVALID_ARG);
+        ret = check_trans_valid(handle, trans_list[i]);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    struct spi_trans_chain_t *chain = heap_caps_calloc(1, sizeof(struct spi_trans_chain_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    SPI_CHECK(chain, "No enough memory", ESP_ERR_NO_MEM);
+    chain->dev = handle;
+    chain->trans_num = trans_num;
+    chain->sct_mode = host->sct_mode_enabled;
+
+#if SOC_SPI_SCT_SUPPORTED
+    if (chain->sct_mode) {
+        ret = s_sct_trans_chain_prepare(chain, trans_list);
+        goto out;
+    }
+#endif
+
+    chain->trans_buf = heap_caps_calloc(trans_num, sizeof(spi_trans_priv_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (chain->trans_buf == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto out;
+    }
+    for (int i = 0; i < trans_num; i++) {
+        spi_trans_priv_t *trans_buf = &chain->trans_buf[i];
+        spi_transaction_t *trans_desc = trans_list[i];
+        trans_buf->trans = trans_desc;
+        trans_buf->chain = chain;
+        ret = setup_priv_desc(host, trans_buf);
+        if (ret != ESP_OK) {
+            goto out;
+        }
+        //The chain is sent from the ISR many times, it can't use temporary buffers which would need to be copied each time
+        if (!priv_desc_is_direct(trans_buf)) {
+            uninstall_priv_desc(trans_buf);
+            ESP_LOGE(SPI_TAG, "buffers of transaction %d in chain not DMA-capable or not aligned to %d", i, host->bus_attr->internal_mem_align_size);
+            ret = ESP_ERR_INVALID_ARG;
+            goto out;
+        }
+    }
+
+out:
+    if (ret != ESP_OK) {
+        spi_device_trans_chain_delete(chain);
+        return ret;
+    }
+    *ret_chain = chain;
+    return ESP_OK;
+}
+
+esp_err_t SPI_MASTER_ATTR spi_device_queue_trans_chain(spi_trans_chain_handle_t chain, TickType_t ticks_to_wait)
+{
+    SPI_CHECK(chain, "invalid chain handle", ESP_ERR_INVALID_ARG);
+    spi_device_t *handle = chain->dev;
+    spi_host_t *host = handle->host;
+    SPI_CHECK(!chain->queued, "chain is already queued", ESP_ERR_INVALID_STATE);
+    SPI_CHECK(chain->sct_mode == host->sct_mode_enabled, "SCT mode changed since the chain was created", ESP_ERR_INVALID_STATE);
+    SPI_CHECK(!spi_bus_device_is_polling(handle), "Cannot queue new transaction while previous polling transaction is not terminated.", ESP_ERR_INVALID_STATE);
+
+    const void *trans_buf = NULL;
+    if (chain->sct_mode) {
+#if SOC_SPI_SCT_SUPPORTED
+        trans_buf = &chain->sct_trans;
+#endif
+    } else {
+        /* The CS can only be kept active after the chain if the bus has been acquired, as with `spi_device_queue_trans()`.
+         * Between the transactions of the chain, no other device can use the bus. */
+        if (host->device_acquiring_lock != handle && (chain->trans_buf[chain->trans_num - 1].trans->flags & SPI_TRANS_CS_KEEP_ACTIVE)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
+        s_trans_chain_sync_buffers(chain, true);
+#endif
+        chain->cur_index = 0;
+        trans_buf = &chain->trans_buf[0];
+    }
+    chain->queued = true;
+
+#ifdef CONFIG_PM_ENABLE
+    esp_pm_lock_acquire(host->bus_attr->pm_lock);
+#endif
+
+    BaseType_t r = xQueueSend(handle->trans_queue, trans_buf, ticks_to_wait);
+    if (!r) {
+        chain->queued = false;
+#ifdef CONFIG_PM_ENABLE
+        //Release APB frequency lock
+        esp_pm_lock_release(host->bus_attr->pm_lock);
+#endif
+        return ESP_ERR_TIMEOUT;
+    }
+
+    // The ISR will be invoked at correct time by the lock with `spi_bus_intr_enable`.
+    return spi_bus_lock_bg_request(handle->dev_lock);
+}
+
+esp_err_t SPI_MASTER_ATTR spi_device_get_trans_chain_result(spi_device_handle_t handle, spi_trans_chain_handle_t *chain, TickType_t ticks_to_wait)
+{
+    SPI_CHECK(handle && chain, "invalid arguments", ESP_ERR_INVALID_ARG);
+    //if SPI_DEVICE_NO_RETURN_RESULT is set, ret_queue will always be empty
+    SPI_CHECK(!(handle->cfg.flags & SPI_DEVICE_NO_RETURN_RESULT), "API not Supported!", ESP_ERR_NOT_SUPPORTED);
+
+    struct spi_trans_chain_t *ret_chain;
+#if SOC_SPI_SCT_SUPPORTED
+    if (handle->host->sct_mode_enabled) {
+        spi_sct_trans_priv_t sct_desc;
+        if (!xQueueReceive(handle->ret_queue, (void *)&sct_desc, ticks_to_wait)) {
+            return ESP_ERR_TIMEOUT;
+        }
+        ret_chain = sct_desc.chain;
+    } else
+#endif
+    {
+        spi_trans_priv_t trans_buf;
+        if (!xQueueReceive(handle->ret_queue, (void *)&trans_buf, ticks_to_wait)) {
+            return ESP_ERR_TIMEOUT;
+        }
+        ret_chain = trans_buf.chain;
+        if (ret_chain == NULL && handle->host->bus_attr->dma_enabled) {
+            uninstall_priv_desc(&trans_buf);
+        }
+    }
+    SPI_CHECK(ret_chain, "returned item is not a chain", ESP_ERR_INVALID_STATE);
+
+#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
+    s_trans_chain_sync_buffers(ret_chain, false);
+#endif
+    *chain = ret_chain;
+    return ESP_OK;
+}
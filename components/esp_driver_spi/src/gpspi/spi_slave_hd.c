@@ -57,6 +57,13 @@ typedef struct {
 
     spi_slave_hd_trans_priv_t tx_curr_trans;
     spi_slave_hd_trans_priv_t rx_curr_trans;
+
+    uint32_t pool_buf_num;
+    size_t pool_buf_size;
+    size_t pool_buf_stride;             //size of each pool buffer, aligned up to the DMA alignment
+    uint8_t *pool_buf;                  //pool buffers, TX ones followed by RX ones
+    spi_slave_hd_data_t *pool_trans;    //pool transactions, in the same order as the buffers
+    QueueHandle_t tx_pool_queue;        //TX pool transactions free to use
 #ifdef CONFIG_PM_ENABLE
     esp_pm_lock_handle_t pm_lock;
 #endif
@@ -78,6 +85,7 @@ static void s_spi_slave_hd_append_legacy_isr(void *arg);
 #endif // SOC_GDMA_SUPPORTED
 
 static void s_spi_slave_hd_segment_isr(void *arg);
+static esp_err_t s_spi_slave_hd_pool_init(spi_host_device_t host_id, const spi_slave_hd_slot_config_t *config);
 
 esp_err_t spi_slave_hd_init(spi_host_device_t host_id, const spi_bus_config_t *bus_config, const spi_slave_hd_slot_config_t *config)
 {
@@ -244,6 +252,13 @@ esp_err_t spi_slave_hd_init(spi_host_device_t host_id, const spi_bus_config_t *b
     }
     spi_slave_hd_hal_enable_event_intr(&host->hal, event);
 
+    if (config->pool_buf_num) {
+        ret = s_spi_slave_hd_pool_init(host_id, config);
+        if (ret != ESP_OK) {
+            goto cleanup;
+        }
+    }
+
     return ESP_OK;
 
 cleanup:
@@ -277,6 +292,11 @@ esp_err_t spi_slave_hd_deinit(spi_host_device_t host_id)
     if (host->rx_cnting_sem) {
         vSemaphoreDelete(host->rx_cnting_sem);
     }
+    if (host->tx_pool_queue) {
+        vQueueDelete(host->tx_pool_queue);
+    }
+    free(host->pool_trans);
+    free(host->pool_buf);
     esp_intr_free(host->intr);
     esp_intr_free(host->intr_dma);
 #ifdef CONFIG_PM_ENABLE
@@ -587,6 +607,11 @@ static void s_spi_slave_hd_destroy_priv_trans(spi_host_device_t host, spi_slave_
 #endif  //SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
 }
 
+static inline bool s_spi_slave_hd_is_pool_buffer(spi_slave_hd_slot_t *host, const uint8_t *data)
+{
+    return host->pool_buf && data >= host->pool_buf && data < host->pool_buf + 2 * host->pool_buf_num * host->pool_buf_stride;
+}
+
 static esp_err_t s_spi_slave_hd_setup_priv_trans(spi_host_device_t host, spi_slave_hd_trans_priv_t *priv_trans, spi_slave_chan_t chan)
 {
     spi_slave_hd_data_t *orig_trans = priv_trans->trans;
@@ -597,7 +622,10 @@ static esp_err_t s_spi_slave_hd_setup_priv_trans(spi_host_device_t host, spi_sla
     uint16_t alignment = spihost[host]->internal_mem_align_size;
     uint32_t byte_len = orig_trans->len;
 
-    if (((uint32_t)orig_trans->data) | (byte_len & (alignment - 1))) {
+    if (s_spi_slave_hd_is_pool_buffer(spihost[host], orig_trans->data)) {
+        //pool buffers are aligned, and have room up to the aligned length
+        byte_len = (byte_len + alignment - 1) & (~(alignment - 1));
+    } else if ((((uint32_t)orig_trans->data) | byte_len) & (alignment - 1)) {
         ESP_RETURN_ON_FALSE(orig_trans->flags & SPI_SLAVE_HD_TRANS_DMA_BUFFER_ALIGN_AUTO, ESP_ERR_INVALID_ARG, TAG, "data buffer addr&len not align to %d, or not dma_capable", alignment);
         byte_len = (byte_len + alignment - 1) & (~(alignment - 1));  // up align to alignment
         ESP_LOGD(TAG, "Re-allocate %s buffer of len %" PRIu32 " for DMA", (chan == SPI_SLAVE_CHAN_TX) ? "TX" : "RX", byte_len);
@@ -607,9 +635,11 @@ static esp_err_t s_spi_slave_hd_setup_priv_trans(spi_host_device_t host, spi_sla
         }
     }
     if (chan == SPI_SLAVE_CHAN_TX) {
-        ESP_COMPILER_DIAGNOSTIC_PUSH_IGNORE("-Wanalyzer-overlapping-buffers") // TODO IDF-11086
-        memcpy(priv_trans->aligned_buffer, orig_trans->data, orig_trans->len);
-        ESP_COMPILER_DIAGNOSTIC_POP("-Wanalyzer-overlapping-buffers")
+        if (priv_trans->aligned_buffer != orig_trans->data) {
+            ESP_COMPILER_DIAGNOSTIC_PUSH_IGNORE("-Wanalyzer-overlapping-buffers") // TODO IDF-11086
+            memcpy(priv_trans->aligned_buffer, orig_trans->data, orig_trans->len);
+            ESP_COMPILER_DIAGNOSTIC_POP("-Wanalyzer-overlapping-buffers")
+        }
         esp_err_t ret = esp_cache_msync((void *)priv_trans->aligned_buffer, byte_len, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
         ESP_RETURN_ON_FALSE(ESP_OK == ret, ESP_ERR_INVALID_STATE, TAG, "mem sync c2m(writeback) fail");
     } else {
@@ -819,3 +849,78 @@ esp_err_t spi_slave_hd_get_append_trans_res(spi_host_device_t host_id, spi_slave
 
     return ret;
 }
+
+//---------------------------------------------------------Append Mode Buffer Pool-----------------------------------------------------------//
+static esp_err_t s_spi_slave_hd_pool_init(spi_host_device_t host_id, const spi_slave_hd_slot_config_t *config)
+{
+    spi_slave_hd_slot_t *host = spihost[host_id];
+    uint32_t num = config->pool_buf_num;
+
+    SPIHD_CHECK(host->append_mode && host->dma_enabled, "The buffer pool needs append mode and DMA", ESP_ERR_INVALID_ARG);
+    SPIHD_CHECK(num <= config->queue_size, "Pool buffer number should not be larger than the queue size", ESP_ERR_INVALID_ARG);
+    SPIHD_CHECK(config->pool_buf_size > 0 && config->pool_buf_size % 4 == 0 && config->pool_buf_size <= SPI_MAX_DMA_LEN &&
+                config->pool_buf_size <= host->max_transfer_sz, "Invalid pool buffer size", ESP_ERR_INVALID_ARG);
+
+    uint16_t alignment = host->internal_mem_align_size;
+    host->pool_buf_stride = (config->pool_buf_size + alignment - 1) & (~(alignment - 1));
+    host->pool_buf = heap_caps_aligned_calloc(alignment, 2 * num, host->pool_buf_stride, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    host->pool_trans = heap_caps_calloc(2 * num, sizeof(spi_slave_hd_data_t), MALLOC_CAP_INTERNAL);
+    host->tx_pool_queue = xQueueCreate(num, sizeof(spi_slave_hd_data_t *));
+    if (!host->pool_buf || !host->pool_trans || !host->tx_pool_queue) {
+        return ESP_ERR_NO_MEM;
+    }
+    host->pool_buf_num = num;
+    host->pool_buf_size = config->pool_buf_size;
+
+    for (uint32_t i = 0; i < 2 * num; i++) {
+        host->pool_trans[i] = (spi_slave_hd_data_t) {
+            .data = host->pool_buf + i * host->pool_buf_stride,
+            .len = config->pool_buf_size,
+        };
+    }
+    for (uint32_t i = 0; i < num; i++) {
+        spi_slave_hd_data_t *trans = &host->pool_trans[i];
+        xQueueSend(host->tx_pool_queue, &trans, 0);
+    }
+    //load all the RX buffers, so that the master can write continuously without waiting for the app
+    for (uint32_t i = num; i < 2 * num; i++) {
+        esp_err_t ret = spi_slave_hd_append_trans(host_id, SPI_SLAVE_CHAN_RX, &host->pool_trans[i], 0);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t spi_slave_hd_get_pool_trans(spi_host_device_t host_id, spi_slave_hd_data_t **out_trans, TickType_t timeout)
+{
+    SPIHD_CHECK(VALID_HOST(host_id) && spihost[host_id] && out_trans, "Invalid argument", ESP_ERR_INVALID_ARG);
+    spi_slave_hd_slot_t *host = spihost[host_id];
+    SPIHD_CHECK(host->pool_buf_num, "The buffer pool is not enabled", ESP_ERR_INVALID_STATE);
+
+    if (xQueueReceive(host->tx_pool_queue, out_trans, timeout) == pdFALSE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+esp_err_t spi_slave_hd_recycle_pool_trans(spi_host_device_t host_id, spi_slave_chan_t chan, spi_slave_hd_data_t *trans)
+{
+    SPIHD_CHECK(VALID_HOST(host_id) && spihost[host_id], "Invalid host", ESP_ERR_INVALID_ARG);
+    spi_slave_hd_slot_t *host = spihost[host_id];
+    SPIHD_CHECK(host->pool_buf_num, "The buffer pool is not enabled", ESP_ERR_INVALID_STATE);
+    SPIHD_CHECK(chan == SPI_SLAVE_CHAN_TX || chan == SPI_SLAVE_CHAN_RX, "Invalid channel", ESP_ERR_INVALID_ARG);
+
+    spi_slave_hd_data_t *first = host->pool_trans + (chan == SPI_SLAVE_CHAN_TX ? 0 : host->pool_buf_num);
+    SPIHD_CHECK(trans >= first && trans < first + host->pool_buf_num, "Transaction doesn't belong to the pool of this channel", ESP_ERR_INVALID_ARG);
+
+    trans->len = host->pool_buf_size;
+    if (chan == SPI_SLAVE_CHAN_TX) {
+        BaseType_t ret = xQueueSend(host->tx_pool_queue, &trans, 0);
+        SPIHD_CHECK(ret == pdTRUE, "Transaction is already in the pool", ESP_ERR_INVALID_ARG);
+        return ESP_OK;
+    }
+    trans->trans_len = 0;
+    esp_err_t err = spi_slave_hd_append_trans(host_id, SPI_SLAVE_CHAN_RX, trans, 0);
+    return (err == ESP_OK) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
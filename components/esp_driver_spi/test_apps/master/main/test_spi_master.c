@@ -315,6 +315,118 @@ TEST_CASE("SPI Master test", "[spi]")
     TEST_ASSERT(success);
 }
 
+#define TEST_CHAIN_TRANS_NUM    8
+#define TEST_CHAIN_TRANS_LEN    64
+
+static void test_trans_chain_loopback(bool dma)
+{
+    spi_device_handle_t handle = setup_spi_bus_loopback(1000000, dma);
+    uint8_t *sendbuf[TEST_CHAIN_TRANS_NUM];
+    uint8_t *recvbuf[TEST_CHAIN_TRANS_NUM];
+    spi_transaction_t trans[TEST_CHAIN_TRANS_NUM] = {};
+    spi_transaction_t *trans_list[TEST_CHAIN_TRANS_NUM];
+    for (int i = 0; i < TEST_CHAIN_TRANS_NUM; i++) {
+        sendbuf[i] = spi_bus_dma_memory_alloc(TEST_SPI_HOST, TEST_CHAIN_TRANS_LEN, 0);
+        recvbuf[i] = spi_bus_dma_memory_alloc(TEST_SPI_HOST, TEST_CHAIN_TRANS_LEN, 0);
+        TEST_ASSERT(sendbuf[i] && recvbuf[i]);
+        trans[i].length = TEST_CHAIN_TRANS_LEN * 8;
+        trans[i].tx_buffer = sendbuf[i];
+        trans[i].rx_buffer = recvbuf[i];
+        // CS is kept active between some transactions of the chain
+        trans[i].flags = (i % 2) ? 0 : SPI_TRANS_CS_KEEP_ACTIVE;
+        trans_list[i] = &trans[i];
+    }
+
+    spi_trans_chain_handle_t chain;
+    TEST_ESP_OK(spi_device_trans_chain_create(handle, trans_list, TEST_CHAIN_TRANS_NUM, &chain));
+
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < TEST_CHAIN_TRANS_NUM; i++) {
+            test_fill_random_to_buffer(round * TEST_CHAIN_TRANS_NUM + i, sendbuf[i], TEST_CHAIN_TRANS_LEN);
+            memset(recvbuf[i], 0x55, TEST_CHAIN_TRANS_LEN);
+        }
+        TEST_ESP_OK(spi_device_queue_trans_chain(chain, portMAX_DELAY));
+        TEST_ESP_ERR(ESP_ERR_INVALID_STATE, spi_device_queue_trans_chain(chain, portMAX_DELAY));
+        TEST_ESP_ERR(ESP_ERR_INVALID_STATE, spi_device_trans_chain_delete(chain));
+
+        spi_trans_chain_handle_t done_chain;
+        TEST_ESP_OK(spi_device_get_trans_chain_result(handle, &done_chain, portMAX_DELAY));
+        TEST_ASSERT_EQUAL_PTR(chain, done_chain);
+        for (int i = 0; i < TEST_CHAIN_TRANS_NUM; i++) {
+            spitest_cmp_or_dump(sendbuf[i], recvbuf[i], TEST_CHAIN_TRANS_LEN);
+        }
+        // single transactions still work between the chains
+        TEST_ASSERT(spi_test(handle, TEST_CHAIN_TRANS_LEN));
+    }
+    TEST_ESP_OK(spi_device_trans_chain_delete(chain));
+
+    for (int i = 0; i < TEST_CHAIN_TRANS_NUM; i++) {
+        free(sendbuf[i]);
+        free(recvbuf[i]);
+    }
+    master_free_device_bus(handle);
+}
+
+TEST_CASE("SPI Master transaction chain", "[spi]")
+{
+    printf("Testing transaction chain with DMA\n");
+    test_trans_chain_loopback(true);
+    printf("Testing transaction chain without DMA\n");
+    test_trans_chain_loopback(false);
+}
+
+static void test_trans_template_loopback(bool dma)
+{
+    spi_device_handle_t handle = setup_spi_bus_loopback(1000000, dma);
+    uint8_t *sendbuf = spi_bus_dma_memory_alloc(TEST_SPI_HOST, TEST_CHAIN_TRANS_LEN, 0);
+    uint8_t *recvbuf = spi_bus_dma_memory_alloc(TEST_SPI_HOST, TEST_CHAIN_TRANS_LEN, 0);
+    TEST_ASSERT(sendbuf && recvbuf);
+    spi_transaction_t trans = {
+        .length = TEST_CHAIN_TRANS_LEN * 8,
+        .tx_buffer = sendbuf,
+        .rx_buffer = recvbuf,
+    };
+
+    spi_trans_template_handle_t trans_template;
+    TEST_ESP_OK(spi_device_trans_template_create(handle, &trans, &trans_template));
+    for (int i = 0; i < 16; i++) {
+        test_fill_random_to_buffer(i, sendbuf, TEST_CHAIN_TRANS_LEN);
+        memset(recvbuf, 0x55, TEST_CHAIN_TRANS_LEN);
+        TEST_ESP_OK(spi_device_polling_transmit_template(trans_template));
+        spitest_cmp_or_dump(sendbuf, recvbuf, TEST_CHAIN_TRANS_LEN);
+        // other transactions in between don't change the template
+        if (i % 4 == 0) {
+            TEST_ASSERT(spi_test(handle, 21));
+        }
+    }
+
+    const int count = 100;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < count; i++) {
+        TEST_ESP_OK(spi_device_polling_transmit(handle, &trans));
+    }
+    int64_t trans_time = esp_timer_get_time() - start;
+    start = esp_timer_get_time();
+    for (int i = 0; i < count; i++) {
+        TEST_ESP_OK(spi_device_polling_transmit_template(trans_template));
+    }
+    int64_t template_time = esp_timer_get_time() - start;
+    printf("%d polling transactions: %lld us, from template: %lld us\n", count, trans_time, template_time);
+
+    TEST_ESP_OK(spi_device_trans_template_delete(trans_template));
+    free(sendbuf);
+    free(recvbuf);
+    master_free_device_bus(handle);
+}
+
+TEST_CASE("SPI Master transaction template", "[spi]")
+{
+    printf("Testing transaction template with DMA\n");
+    test_trans_template_loopback(true);
+    printf("Testing transaction template without DMA\n");
+    test_trans_template_loopback(false);
+}
+
 TEST_CASE("SPI Master test, interaction of multiple devs", "[spi]")
 {
     esp_err_t ret;
@@ -8,6 +8,7 @@
 */
 
 #include "esp_log.h"
+#include "esp_memory_utils.h"
 #include "test_utils.h"
 #include "test_spi_utils.h"
 #include "soc/spi_periph.h"
@@ -1072,4 +1073,48 @@ void master_run_essl(void)
 }
 
 TEST_CASE_MULTIPLE_DEVICES("SPI Slave HD: Append mode", "[spi_ms]", master_run_essl, slave_run_append);
+
+#define TEST_POOL_BUF_NUM   4
+#define TEST_POOL_BUF_SIZE  512
+
+TEST_CASE("test spi slave hd append mode buffer pool", "[spi][spi_slv_hd]")
+{
+    spi_bus_config_t bus_cfg = SPI_BUS_TEST_DEFAULT_CONFIG();
+    bus_cfg.max_transfer_sz = 4092;
+
+    spi_slave_hd_slot_config_t slave_hd_cfg = SPI_SLOT_TEST_DEFAULT_CONFIG();
+    slave_hd_cfg.flags |= SPI_SLAVE_HD_APPEND_MODE;
+    slave_hd_cfg.dma_chan = SPI_DMA_CH_AUTO;
+    slave_hd_cfg.pool_buf_num = slave_hd_cfg.queue_size + 1;
+    slave_hd_cfg.pool_buf_size = TEST_POOL_BUF_SIZE;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, spi_slave_hd_init(TEST_SPI_HOST, &bus_cfg, &slave_hd_cfg));
+    slave_hd_cfg.pool_buf_num = TEST_POOL_BUF_NUM;
+    TEST_ESP_OK(spi_slave_hd_init(TEST_SPI_HOST, &bus_cfg, &slave_hd_cfg));
+
+    spi_slave_hd_data_t *tx_trans[TEST_POOL_BUF_NUM];
+    for (int i = 0; i < TEST_POOL_BUF_NUM; i++) {
+        TEST_ESP_OK(spi_slave_hd_get_pool_trans(TEST_SPI_HOST, &tx_trans[i], 0));
+        TEST_ASSERT_EQUAL(TEST_POOL_BUF_SIZE, tx_trans[i]->len);
+        TEST_ASSERT(esp_ptr_dma_capable(tx_trans[i]->data));
+    }
+    spi_slave_hd_data_t *extra_trans;
+    TEST_ESP_ERR(ESP_ERR_TIMEOUT, spi_slave_hd_get_pool_trans(TEST_SPI_HOST, &extra_trans, 0));
+
+    // TX transactions can't be given back as RX ones, nor user ones to the pool
+    spi_slave_hd_data_t user_trans = {};
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, spi_slave_hd_recycle_pool_trans(TEST_SPI_HOST, SPI_SLAVE_CHAN_RX, tx_trans[0]));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, spi_slave_hd_recycle_pool_trans(TEST_SPI_HOST, SPI_SLAVE_CHAN_TX, &user_trans));
+
+    tx_trans[0]->len = 16;
+    TEST_ESP_OK(spi_slave_hd_recycle_pool_trans(TEST_SPI_HOST, SPI_SLAVE_CHAN_TX, tx_trans[0]));
+    TEST_ESP_OK(spi_slave_hd_get_pool_trans(TEST_SPI_HOST, &extra_trans, 0));
+    TEST_ASSERT_EQUAL_PTR(tx_trans[0], extra_trans);
+    TEST_ASSERT_EQUAL(TEST_POOL_BUF_SIZE, extra_trans->len);
+
+    // all the RX buffers are loaded by the driver, nothing received without the master
+    spi_slave_hd_data_t *rx_trans;
+    TEST_ESP_ERR(ESP_ERR_TIMEOUT, spi_slave_hd_get_append_trans_res(TEST_SPI_HOST, SPI_SLAVE_CHAN_RX, &rx_trans, 0));
+
+    TEST_ESP_OK(spi_slave_hd_deinit(TEST_SPI_HOST));
+}
 #endif //SOC_SPI_SUPPORT_SLAVE_HD_VER2
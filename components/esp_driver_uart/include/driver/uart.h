@@ -117,6 +117,48 @@ typedef intr_handle_t uart_isr_handle_t;
  */
 esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size, QueueHandle_t* uart_queue, int intr_alloc_flags);
 
+#if SOC_UART_SUPPORT_UHCI_DMA
+/**
+ * @brief UART DMA mode configuration
+ */
+typedef struct {
+    size_t rx_dma_buf_size;     /*!< Size of the buffer the received data is written into by the DMA.
+                                     The buffer is split in several blocks, each block is moved to the RX ring buffer
+                                     when it is full or when the RX line becomes idle. */
+} uart_dma_config_t;
+
+/**
+ * @brief Install UART driver with the RX and TX data moved by the DMA through the UHCI controller.
+ *
+ * The received data is written by the DMA into a circular buffer and moved to the RX ring buffer without an interrupt
+ * per RX FIFO threshold. If tx_buffer_size is not zero, the data of the TX ring buffer is also sent by the DMA.
+ * uart_read_bytes, uart_write_bytes and the UART_DATA events keep the same behavior as with uart_driver_install.
+ *
+ * @note There is only one UHCI controller, so only one UART port can use the DMA mode at a time. LP UART is not supported.
+ * @note Pattern detection is not supported in DMA mode. uart_write_bytes_with_break and the RS485 modes are not supported
+ *       if tx_buffer_size is not zero.
+ * @note If the RX ring buffer is full, the newly received data is discarded and a UART_BUFFER_FULL event is sent,
+ *       as the DMA can't be paused.
+ *
+ * @param uart_num UART port number, the max port number is (SOC_UART_HP_NUM -1).
+ * @param rx_buffer_size UART RX ring buffer size.
+ * @param tx_buffer_size UART TX ring buffer size. If set to zero, the TX data is written into the TX FIFO by the CPU.
+ * @param queue_size UART event queue size/depth.
+ * @param uart_queue UART event queue handle (out param), see uart_driver_install.
+ * @param intr_alloc_flags Flags used to allocate the UART interrupt, see uart_driver_install.
+ * @param dma_config DMA mode configuration
+ *
+ * @return
+ *     - ESP_OK   Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE The UHCI controller is used by another UART port
+ *     - ESP_ERR_NO_MEM Out of memory
+ *     - ESP_FAIL Failed to install the UART driver
+ */
+esp_err_t uart_driver_install_with_dma(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size, QueueHandle_t* uart_queue,
+                                       int intr_alloc_flags, const uart_dma_config_t *dma_config);
+#endif
+
 /**
  * @brief Uninstall UART driver.
  *
@@ -856,6 +898,88 @@ esp_err_t uart_set_loop_back(uart_port_t uart_num, bool loop_back_en);
   */
 void uart_set_always_rx_timeout(uart_port_t uart_num, bool always_rx_timeout_en);
 
+/**
+ * @brief How the end of a packet is detected in packet mode
+ */
+typedef enum {
+    UART_PACKET_END_IDLE,       /*!< A packet ends when the RX line is idle for the RX timeout */
+    UART_PACKET_END_DELIMITER,  /*!< A packet ends with the delimiter byte, which is part of the packet */
+    UART_PACKET_END_LENGTH,     /*!< The packet length is given by get_packet_len from the first bytes of the packet */
+} uart_packet_end_t;
+
+/**
+ * @brief Callback invoked in the UART ISR when a packet has been received
+ *
+ * @param uart_num UART port number
+ * @param data The packet, in the packet buffer of the driver. Only valid until the callback returns.
+ * @param len Length of the packet
+ * @param user_ctx User context given in uart_packet_config_t
+ *
+ * @return Whether a higher priority task has been woken up by the callback
+ */
+typedef bool (*uart_rx_packet_cb_t)(uart_port_t uart_num, const uint8_t *data, size_t len, void *user_ctx);
+
+/**
+ * @brief Callback invoked in the UART ISR to get the length of a packet from its first bytes
+ *
+ * @param data The first bytes of the packet
+ * @param len Number of bytes received so far, the callback is invoked for every new byte until it returns a length
+ * @param user_ctx User context given in uart_packet_config_t
+ *
+ * @return Length of the whole packet, or 0 if more bytes are needed
+ */
+typedef size_t (*uart_packet_len_cb_t)(const uint8_t *data, size_t len, void *user_ctx);
+
+/**
+ * @brief UART packet mode configuration
+ */
+typedef struct {
+    uart_packet_end_t end_mode;             /*!< How the end of a packet is detected */
+    size_t max_packet_len;                  /*!< Size of the packet buffer, longer packets are dropped */
+    uint8_t rx_timeout;                     /*!< RX timeout in symbol periods, see uart_set_rx_timeout. 0 keeps the current value */
+    uint8_t delimiter;                      /*!< Last byte of a packet for UART_PACKET_END_DELIMITER */
+    uart_packet_len_cb_t get_packet_len;    /*!< Packet length callback for UART_PACKET_END_LENGTH */
+    uart_rx_packet_cb_t on_packet;          /*!< Callback invoked for each received packet */
+    void *user_ctx;                         /*!< User context passed to the callbacks */
+} uart_packet_config_t;
+
+/**
+ * @brief Enable the packet mode of the RX path
+ *
+ * In packet mode, the data read from the RX FIFO is gathered by the UART ISR in a packet buffer instead of
+ * the RX ring buffer. Each complete packet is given to the on_packet callback, so the application neither copies
+ * the data out of the ring buffer nor wakes up on every UART_DATA event.
+ *
+ * @note The callbacks are invoked in the UART ISR, they must be short and must not block.
+ *       They must be placed in IRAM if CONFIG_UART_ISR_IN_IRAM is enabled.
+ * @note No UART_DATA event is sent and uart_read_bytes gets no data. A UART_BUFFER_FULL event is sent when
+ *       a packet longer than max_packet_len is dropped.
+ * @note Not supported along with the DMA mode.
+ *
+ * @param uart_num UART port number, the max port number is (UART_NUM_MAX -1).
+ * @param config Packet mode configuration
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Driver is not installed, or packet mode is already enabled
+ *     - ESP_ERR_NOT_SUPPORTED The driver is installed in DMA mode
+ *     - ESP_ERR_NO_MEM Out of memory
+ */
+esp_err_t uart_enable_packet_mode(uart_port_t uart_num, const uart_packet_config_t *config);
+
+/**
+ * @brief Disable the packet mode of the RX path, a partially received packet is dropped
+ *
+ * @param uart_num UART port number, the max port number is (UART_NUM_MAX -1).
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Driver is not installed
+ */
+esp_err_t uart_disable_packet_mode(uart_port_t uart_num);
+
 #ifdef __cplusplus
 }
 #endif
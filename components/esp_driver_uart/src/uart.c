@@ -39,6 +39,12 @@
 #include "clk_ctrl_os.h"
 #include "esp_pm.h"
 #include "esp_private/sleep_retention.h"
+#if SOC_UART_SUPPORT_UHCI_DMA
+#include "esp_private/gdma.h"
+#include "esp_private/periph_ctrl.h"
+#include "hal/uhci_ll.h"
+#include "hal/dma_types.h"
+#endif
 
 #ifdef CONFIG_UART_ISR_IN_IRAM
 #define UART_ISR_ATTR     IRAM_ATTR
@@ -48,6 +54,12 @@
 #define UART_MALLOC_CAPS  MALLOC_CAP_DEFAULT
 #endif
 
+#if CONFIG_UART_ISR_IN_IRAM || CONFIG_GDMA_ISR_IRAM_SAFE
+#define UART_DMA_ISR_ATTR IRAM_ATTR
+#else
+#define UART_DMA_ISR_ATTR
+#endif
+
 // Whether to use the APB_MAX lock.
 // Requirement of each chip, to keep sending:
 // - ESP32, S2, C3, S3: Protect APB, which is the core clock and clock of UART FIFO
@@ -70,6 +82,9 @@ static const char *UART_TAG = "uart";
 #define UART_TX_IDLE_NUM_DEFAULT        (0)
 #define UART_PATTERN_DET_QLEN_DEFAULT   (10)
 #define UART_MIN_WAKEUP_THRESH          (UART_LL_MIN_WAKEUP_THRESH)
+#define UART_DMA_RX_DESC_NUM            (8)
+#define UART_DMA_RX_IDLE_THRESH         (UART_TOUT_THRESH_DEFAULT * 10)   // in bit time, about UART_TOUT_THRESH_DEFAULT symbols
+#define UART_DMA_MALLOC_CAPS            (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT)
 
 #if (SOC_UART_LP_NUM >= 1)
 #define UART_THRESHOLD_NUM(uart_num, field_name) ((uart_num < SOC_UART_HP_NUM) ? field_name : LP_##field_name)
@@ -126,6 +141,28 @@ typedef struct {
     int *data;
 } uart_pat_rb_t;
 
+#if SOC_UART_SUPPORT_UHCI_DMA
+typedef struct {
+    uhci_dev_t *uhci;                   /*!< UHCI controller attached to the port */
+    gdma_channel_handle_t rx_chan;      /*!< GDMA RX channel */
+    gdma_channel_handle_t tx_chan;      /*!< GDMA TX channel, NULL if the TX data is written by the CPU */
+    dma_descriptor_t *rx_desc;          /*!< Circular list of RX descriptors */
+    uint8_t *rx_buf;                    /*!< RX DMA buffer, split between the RX descriptors */
+    size_t rx_desc_buf_size;            /*!< Size of the buffer of each RX descriptor */
+    int rx_desc_idx;                    /*!< Next RX descriptor to move to the RX ring buffer */
+    dma_descriptor_t *tx_desc;          /*!< TX descriptor */
+    void *tx_item;                      /*!< TX ring buffer item being sent, NULL if the TX DMA is idle */
+    SemaphoreHandle_t tx_idle_sem;      /*!< Given when the TX DMA becomes idle */
+} uart_dma_t;
+#endif
+
+typedef struct {
+    uart_packet_config_t config;        /*!< Packet mode configuration */
+    size_t len;                         /*!< Number of bytes of the current packet received so far */
+    size_t expected_len;                /*!< Length of the current packet given by get_packet_len, 0 if not known yet */
+    uint8_t buf[];                      /*!< Packet buffer, max_packet_len bytes */
+} uart_rx_packet_t;
+
 typedef struct {
     uart_port_t uart_num;               /*!< UART port number*/
     int event_queue_size;               /*!< UART event queue size*/
@@ -158,6 +195,10 @@ typedef struct {
     SemaphoreHandle_t tx_fifo_sem;      /*!< UART TX FIFO semaphore*/
     SemaphoreHandle_t tx_done_sem;      /*!< UART TX done semaphore*/
     SemaphoreHandle_t tx_brk_sem;       /*!< UART TX send break done semaphore*/
+    uart_rx_packet_t *rx_pkt;           /*!< RX packet mode context, NULL if the packet mode is disabled */
+#if SOC_UART_SUPPORT_UHCI_DMA
+    uart_dma_t *dma;                    /*!< UHCI DMA context, NULL if the port doesn't use the DMA mode */
+#endif
 #if PROTECT_APB
     esp_pm_lock_handle_t pm_lock;   ///< Power management lock
 #endif
@@ -196,6 +237,17 @@ static uart_context_t uart_context[UART_NUM_MAX] = {
 
 static portMUX_TYPE uart_selectlock = portMUX_INITIALIZER_UNLOCKED;
 
+#if SOC_UART_SUPPORT_UHCI_DMA
+// Port using the UHCI controller, UART_NUM_MAX if none
+static uart_port_t s_uart_dma_port = UART_NUM_MAX;
+DEFINE_CRIT_SECTION_LOCK_STATIC(s_uart_dma_spinlock);
+#define UART_IS_DMA_RX(uart_num)    (p_uart_obj[uart_num]->dma != NULL)
+#define UART_IS_DMA_TX(uart_num)    (p_uart_obj[uart_num]->dma != NULL && p_uart_obj[uart_num]->dma->tx_chan != NULL)
+#else
+#define UART_IS_DMA_RX(uart_num)    (false)
+#define UART_IS_DMA_TX(uart_num)    (false)
+#endif
+
 #if SOC_UART_SUPPORT_SLEEP_RETENTION && CONFIG_PM_POWER_DOWN_PERIPHERAL_IN_LIGHT_SLEEP
 static esp_err_t uart_create_sleep_retention_link_cb(void *arg);
 #endif
@@ -446,6 +498,10 @@ esp_err_t uart_enable_intr_mask(uart_port_t uart_num, uint32_t enable_mask)
 {
     ESP_RETURN_ON_FALSE((uart_num < UART_NUM_MAX), ESP_FAIL, UART_TAG, "uart_num error");
     UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+    if (p_uart_obj[uart_num] && UART_IS_DMA_RX(uart_num)) {
+        // The RX FIFO is read by the UHCI, it must not be read by the ISR as well
+        enable_mask &= ~(UART_INTR_RXFIFO_FULL | UART_INTR_RXFIFO_TOUT);
+    }
     /* Keep track of the interrupt toggling. In fact, without such variable,
      * once the RX buffer is full and the RX interrupts disabled, it is
      * impossible what was the previous state (enabled/disabled) of these
@@ -616,6 +672,7 @@ esp_err_t uart_enable_pattern_det_baud_intr(uart_port_t uart_num, char pattern_c
     ESP_RETURN_ON_FALSE(chr_tout >= 0 && chr_tout <= UART_THRESHOLD_NUM(uart_num, UART_RX_GAP_TOUT_V), ESP_FAIL, UART_TAG, "uart pattern set error\n");
     ESP_RETURN_ON_FALSE(post_idle >= 0 && post_idle <= UART_THRESHOLD_NUM(uart_num, UART_POST_IDLE_NUM_V), ESP_FAIL, UART_TAG, "uart pattern set error\n");
     ESP_RETURN_ON_FALSE(pre_idle >= 0 && pre_idle <= UART_THRESHOLD_NUM(uart_num, UART_PRE_IDLE_NUM_V), ESP_FAIL, UART_TAG, "uart pattern set error\n");
+    ESP_RETURN_ON_FALSE(!p_uart_obj[uart_num] || !UART_IS_DMA_RX(uart_num), ESP_ERR_NOT_SUPPORTED, UART_TAG, "pattern detection not supported in DMA mode");
     uart_at_cmd_t at_cmd = {0};
     at_cmd.cmd_char = pattern_chr;
     at_cmd.char_num = chr_num;
@@ -991,6 +1048,55 @@ static uint32_t UART_ISR_ATTR uart_enable_tx_write_fifo(uart_port_t uart_num, co
 }
 
 //internal isr handler for default driver code.
+// Gather the data of the RX FIFO into the packet buffer and give the complete packets to the user callback
+static bool UART_ISR_ATTR uart_rx_packet_handle(uart_obj_t *p_uart, uint32_t uart_intr_status, uart_event_t *uart_event)
+{
+    uart_port_t uart_num = p_uart->uart_num;
+    uart_rx_packet_t *pkt = p_uart->rx_pkt;
+    const uart_packet_config_t *config = &pkt->config;
+    bool rx_tout = (uart_intr_status & UART_INTR_RXFIFO_TOUT) != 0;
+    bool need_yield = false;
+
+    int rx_fifo_len = uart_hal_get_rxfifo_len(&(uart_context[uart_num].hal));
+    if (config->end_mode == UART_PACKET_END_IDLE && !rx_tout && rx_fifo_len > 0) {
+        rx_fifo_len--; // leave one byte in the fifo, so that the end of the packet triggers uart_intr_rxfifo_tout
+    }
+    uart_hal_read_rxfifo(&(uart_context[uart_num].hal), p_uart->rx_data_buf, &rx_fifo_len);
+    uart_hal_clr_intsts_mask(&(uart_context[uart_num].hal), UART_INTR_RXFIFO_TOUT | UART_INTR_RXFIFO_FULL | UART_INTR_CMD_CHAR_DET);
+
+    for (int i = 0; i < rx_fifo_len; i++) {
+        uint8_t data = p_uart->rx_data_buf[i];
+        if (pkt->len < config->max_packet_len) {
+            pkt->buf[pkt->len] = data;
+        }
+        pkt->len++;
+        bool end = false;
+        if (config->end_mode == UART_PACKET_END_DELIMITER) {
+            end = (data == config->delimiter);
+        } else if (config->end_mode == UART_PACKET_END_LENGTH) {
+            if (pkt->expected_len == 0) {
+                // The header must fit in the packet buffer, otherwise the packet can't be delimited
+                pkt->expected_len = (pkt->len <= config->max_packet_len) ?
+                                    config->get_packet_len(pkt->buf, pkt->len, config->user_ctx) : pkt->len;
+            }
+            end = (pkt->expected_len != 0 && pkt->len >= pkt->expected_len);
+        } else if (i == rx_fifo_len - 1) {
+            end = rx_tout;
+        }
+        if (!end) {
+            continue;
+        }
+        if (pkt->len <= config->max_packet_len) {
+            need_yield |= config->on_packet(uart_num, pkt->buf, pkt->len, config->user_ctx);
+        } else {
+            uart_event->type = UART_BUFFER_FULL;
+        }
+        pkt->len = 0;
+        pkt->expected_len = 0;
+    }
+    return need_yield;
+}
+
 static void UART_ISR_ATTR uart_rx_intr_handler_default(void *param)
 {
     uart_obj_t *p_uart = (uart_obj_t *) param;
@@ -1119,7 +1225,10 @@ static void UART_ISR_ATTR uart_rx_intr_handler_default(void *param)
                 uart_intr_status |= UART_INTR_CMD_CHAR_DET;
                 pat_flg = 0;
             }
-            if (p_uart->rx_buffer_full_flg == false) {
+            if (p_uart->rx_pkt) {
+                // The data doesn't go through the RX ring buffer in packet mode
+                need_yield |= uart_rx_packet_handle(p_uart, uart_intr_status, &uart_event);
+            } else if (p_uart->rx_buffer_full_flg == false) {
                 rx_fifo_len = uart_hal_get_rxfifo_len(&(uart_context[uart_num].hal));
                 if ((p_uart_obj[uart_num]->rx_always_timeout_flg) && !(uart_intr_status & UART_INTR_RXFIFO_TOUT)) {
                     rx_fifo_len--; // leave one byte in the fifo in order to trigger uart_intr_rxfifo_tout
@@ -1324,6 +1433,280 @@ static void UART_ISR_ATTR uart_rx_intr_handler_default(void *param)
     }
 }
 
+#if SOC_UART_SUPPORT_UHCI_DMA
+static void UART_DMA_ISR_ATTR uart_dma_rx_desc_reset(dma_descriptor_t *desc)
+{
+    desc->dw0.length = 0;
+    desc->dw0.suc_eof = 0;
+    desc->dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+}
+
+// Handles both the RX done and the RX EOF events, the RX descriptors released by the DMA are moved to the RX ring buffer
+static bool UART_DMA_ISR_ATTR uart_dma_rx_cb(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data)
+{
+    uart_obj_t *p_uart = (uart_obj_t *)user_data;
+    uart_dma_t *dma = p_uart->dma;
+    uart_port_t uart_num = p_uart->uart_num;
+    BaseType_t HPTaskAwoken = pdFALSE;
+    bool need_yield = false;
+    bool buffer_full = false;
+    bool idle = false;
+    size_t recv_len = 0;
+
+    // The DMA keeps on writing into the next descriptors, at most a full turn of the list can be released
+    for (int i = 0; i < UART_DMA_RX_DESC_NUM; i++) {
+        dma_descriptor_t *desc = &dma->rx_desc[dma->rx_desc_idx];
+        if (desc->dw0.owner != DMA_DESCRIPTOR_BUFFER_OWNER_CPU) {
+            break;
+        }
+        size_t len = desc->dw0.length;
+        idle = desc->dw0.suc_eof;
+        if (len > 0) {
+            if (xRingbufferSendFromISR(p_uart->rx_ring_buf, desc->buffer, len, &HPTaskAwoken) == pdTRUE) {
+                recv_len += len;
+            } else {
+                // The DMA can't be paused until the ring buffer is read, the data is dropped
+                buffer_full = true;
+            }
+            need_yield |= (HPTaskAwoken == pdTRUE);
+        }
+        uart_dma_rx_desc_reset(desc);
+        dma->rx_desc_idx = (dma->rx_desc_idx + 1) % UART_DMA_RX_DESC_NUM;
+    }
+    if (recv_len == 0 && !buffer_full) {
+        return need_yield;
+    }
+
+    UART_ENTER_CRITICAL_ISR(&(uart_context[uart_num].spinlock));
+    p_uart->rx_buffered_len += recv_len;
+    UART_EXIT_CRITICAL_ISR(&(uart_context[uart_num].spinlock));
+    UART_ENTER_CRITICAL_ISR(&uart_selectlock);
+    if (p_uart->uart_select_notif_callback) {
+        p_uart->uart_select_notif_callback(uart_num, UART_SELECT_READ_NOTIF, &HPTaskAwoken);
+        need_yield |= (HPTaskAwoken == pdTRUE);
+    }
+    UART_EXIT_CRITICAL_ISR(&uart_selectlock);
+
+    if (p_uart->event_queue) {
+        uart_event_t uart_event = {
+            .type = UART_DATA,
+            .size = recv_len,
+            .timeout_flag = idle,
+        };
+        if (recv_len > 0) {
+            xQueueSendFromISR(p_uart->event_queue, (void *)&uart_event, &HPTaskAwoken);
+            need_yield |= (HPTaskAwoken == pdTRUE);
+        }
+        if (buffer_full) {
+            uart_event.type = UART_BUFFER_FULL;
+            uart_event.size = 0;
+            xQueueSendFromISR(p_uart->event_queue, (void *)&uart_event, &HPTaskAwoken);
+            need_yield |= (HPTaskAwoken == pdTRUE);
+        }
+    }
+    return need_yield;
+}
+
+// Mounts the next item of the TX ring buffer on the TX descriptor, must be called in the UART critical section
+static bool UART_DMA_ISR_ATTR uart_dma_tx_start_next(uart_obj_t *p_uart)
+{
+    uart_dma_t *dma = p_uart->dma;
+    size_t size = 0;
+    dma->tx_item = xRingbufferReceiveFromISR(p_uart->tx_ring_buf, &size);
+    if (dma->tx_item == NULL) {
+        return false;
+    }
+    dma->tx_desc->buffer = dma->tx_item;
+    dma->tx_desc->dw0.size = size;
+    dma->tx_desc->dw0.length = size;
+    dma->tx_desc->dw0.suc_eof = 1;
+    dma->tx_desc->dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+    dma->tx_desc->next = NULL;
+    gdma_start(dma->tx_chan, (intptr_t)dma->tx_desc);
+    return true;
+}
+
+static bool UART_DMA_ISR_ATTR uart_dma_tx_eof_cb(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data)
+{
+    uart_obj_t *p_uart = (uart_obj_t *)user_data;
+    uart_dma_t *dma = p_uart->dma;
+    uart_port_t uart_num = p_uart->uart_num;
+    BaseType_t HPTaskAwoken = pdFALSE;
+    bool need_yield = false;
+
+    UART_ENTER_CRITICAL_ISR(&(uart_context[uart_num].spinlock));
+    p_uart->tx_len_tot -= dma->tx_desc->dw0.length;
+    vRingbufferReturnItemFromISR(p_uart->tx_ring_buf, dma->tx_item, &HPTaskAwoken);
+    need_yield |= (HPTaskAwoken == pdTRUE);
+    bool busy = uart_dma_tx_start_next(p_uart);
+    UART_EXIT_CRITICAL_ISR(&(uart_context[uart_num].spinlock));
+
+    if (!busy) {
+        xSemaphoreGiveFromISR(dma->tx_idle_sem, &HPTaskAwoken);
+        need_yield |= (HPTaskAwoken == pdTRUE);
+    }
+    UART_ENTER_CRITICAL_ISR(&uart_selectlock);
+    if (p_uart->uart_select_notif_callback) {
+        p_uart->uart_select_notif_callback(uart_num, UART_SELECT_WRITE_NOTIF, &HPTaskAwoken);
+        need_yield |= (HPTaskAwoken == pdTRUE);
+    }
+    UART_EXIT_CRITICAL_ISR(&uart_selectlock);
+    return need_yield;
+}
+
+static void uart_dma_tx_kick(uart_port_t uart_num)
+{
+    uart_obj_t *p_uart = p_uart_obj[uart_num];
+    UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+    if (p_uart->dma->tx_item == NULL) {
+        uart_dma_tx_start_next(p_uart);
+    }
+    UART_EXIT_CRITICAL(&(uart_context[uart_num].spinlock));
+}
+
+static void uart_dma_rx_start(uart_port_t uart_num)
+{
+    uart_dma_t *dma = p_uart_obj[uart_num]->dma;
+    for (int i = 0; i < UART_DMA_RX_DESC_NUM; i++) {
+        dma_descriptor_t *desc = &dma->rx_desc[i];
+        desc->buffer = dma->rx_buf + i * dma->rx_desc_buf_size;
+        desc->dw0.size = dma->rx_desc_buf_size;
+        desc->next = &dma->rx_desc[(i + 1) % UART_DMA_RX_DESC_NUM];
+        uart_dma_rx_desc_reset(desc);
+    }
+    dma->rx_desc_idx = 0;
+    uart_hal_rxfifo_rst(&(uart_context[uart_num].hal));
+    gdma_start(dma->rx_chan, (intptr_t)&dma->rx_desc[0]);
+}
+
+static void uart_dma_uninstall(uart_port_t uart_num)
+{
+    uart_dma_t *dma = p_uart_obj[uart_num]->dma;
+    if (dma == NULL) {
+        return;
+    }
+    if (dma->rx_chan) {
+        gdma_stop(dma->rx_chan);
+        gdma_disconnect(dma->rx_chan);
+        gdma_del_channel(dma->rx_chan);
+    }
+    if (dma->tx_chan) {
+        gdma_stop(dma->tx_chan);
+        gdma_disconnect(dma->tx_chan);
+        gdma_del_channel(dma->tx_chan);
+    }
+    if (dma->uhci) {
+        periph_module_disable(PERIPH_UHCI0_MODULE);
+        UART_ENTER_CRITICAL(&s_uart_dma_spinlock);
+        s_uart_dma_port = UART_NUM_MAX;
+        UART_EXIT_CRITICAL(&s_uart_dma_spinlock);
+    }
+    if (dma->tx_idle_sem) {
+        vSemaphoreDeleteWithCaps(dma->tx_idle_sem);
+    }
+    heap_caps_free(dma->rx_desc);
+    heap_caps_free(dma->rx_buf);
+    heap_caps_free(dma->tx_desc);
+    heap_caps_free(dma);
+    p_uart_obj[uart_num]->dma = NULL;
+}
+
+static esp_err_t uart_dma_install(uart_port_t uart_num, const uart_dma_config_t *dma_config)
+{
+    esp_err_t ret = ESP_OK;
+    uart_obj_t *p_uart = p_uart_obj[uart_num];
+    size_t desc_buf_size = (dma_config->rx_dma_buf_size / UART_DMA_RX_DESC_NUM) & ~(sizeof(uint32_t) - 1);
+    ESP_RETURN_ON_FALSE(desc_buf_size >= UART_HW_FIFO_LEN(uart_num) && desc_buf_size <= DMA_DESCRIPTOR_BUFFER_MAX_SIZE_4B_ALIGNED,
+                        ESP_ERR_INVALID_ARG, UART_TAG, "rx_dma_buf_size should be between %d and %d", UART_DMA_RX_DESC_NUM * UART_HW_FIFO_LEN(uart_num),
+                        UART_DMA_RX_DESC_NUM * DMA_DESCRIPTOR_BUFFER_MAX_SIZE_4B_ALIGNED);
+
+    uart_dma_t *dma = heap_caps_calloc(1, sizeof(uart_dma_t), UART_MALLOC_CAPS);
+    ESP_RETURN_ON_FALSE(dma, ESP_ERR_NO_MEM, UART_TAG, "no mem for dma context");
+    p_uart->dma = dma;
+
+    bool uhci_free = false;
+    UART_ENTER_CRITICAL(&s_uart_dma_spinlock);
+    if (s_uart_dma_port == UART_NUM_MAX) {
+        s_uart_dma_port = uart_num;
+        uhci_free = true;
+    }
+    UART_EXIT_CRITICAL(&s_uart_dma_spinlock);
+    ESP_GOTO_ON_FALSE(uhci_free, ESP_ERR_INVALID_STATE, err, UART_TAG, "UHCI is used by uart%d", s_uart_dma_port);
+    dma->uhci = UHCI_LL_GET_HW(0);
+    periph_module_enable(PERIPH_UHCI0_MODULE);
+    periph_module_reset(PERIPH_UHCI0_MODULE);
+
+    dma->rx_desc_buf_size = desc_buf_size;
+    dma->rx_desc = heap_caps_aligned_calloc(4, UART_DMA_RX_DESC_NUM, sizeof(dma_descriptor_t), UART_DMA_MALLOC_CAPS);
+    dma->rx_buf = heap_caps_aligned_calloc(4, UART_DMA_RX_DESC_NUM, desc_buf_size, UART_DMA_MALLOC_CAPS);
+    ESP_GOTO_ON_FALSE(dma->rx_desc && dma->rx_buf, ESP_ERR_NO_MEM, err, UART_TAG, "no mem for rx dma buffer");
+
+    if (p_uart->tx_buf_size > 0) {
+        // The TX DMA sends the items straight from the ring buffer, which has to be DMA capable
+        vRingbufferDeleteWithCaps(p_uart->tx_ring_buf);
+        p_uart->tx_ring_buf = xRingbufferCreateWithCaps(p_uart->tx_buf_size, RINGBUF_TYPE_NOSPLIT, UART_DMA_MALLOC_CAPS);
+        dma->tx_desc = heap_caps_aligned_calloc(4, 1, sizeof(dma_descriptor_t), UART_DMA_MALLOC_CAPS);
+        dma->tx_idle_sem = xSemaphoreCreateBinaryWithCaps(UART_MALLOC_CAPS);
+        ESP_GOTO_ON_FALSE(p_uart->tx_ring_buf && dma->tx_desc && dma->tx_idle_sem, ESP_ERR_NO_MEM, err, UART_TAG, "no mem for tx dma");
+
+        gdma_channel_alloc_config_t tx_alloc_config = {
+            .direction = GDMA_CHANNEL_DIRECTION_TX,
+        };
+        ESP_GOTO_ON_ERROR(gdma_new_ahb_channel(&tx_alloc_config, &dma->tx_chan), err, UART_TAG, "alloc tx dma channel failed");
+    }
+    gdma_channel_alloc_config_t rx_alloc_config = {
+        .direction = GDMA_CHANNEL_DIRECTION_RX,
+        .sibling_chan = dma->tx_chan,
+    };
+    ESP_GOTO_ON_ERROR(gdma_new_ahb_channel(&rx_alloc_config, &dma->rx_chan), err, UART_TAG, "alloc rx dma channel failed");
+
+    gdma_strategy_config_t strategy_config = {
+        .auto_update_desc = false,
+        .owner_check = false,
+    };
+    gdma_connect(dma->rx_chan, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_UHCI, 0));
+    gdma_apply_strategy(dma->rx_chan, &strategy_config);
+    gdma_rx_event_callbacks_t rx_cbs = {
+        .on_recv_eof = uart_dma_rx_cb,
+        .on_recv_done = uart_dma_rx_cb,
+    };
+    ESP_GOTO_ON_ERROR(gdma_register_rx_event_callbacks(dma->rx_chan, &rx_cbs, p_uart), err, UART_TAG, "register rx dma callbacks failed");
+    if (dma->tx_chan) {
+        gdma_connect(dma->tx_chan, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_UHCI, 0));
+        gdma_apply_strategy(dma->tx_chan, &strategy_config);
+        gdma_tx_event_callbacks_t tx_cbs = {
+            .on_trans_eof = uart_dma_tx_eof_cb,
+        };
+        ESP_GOTO_ON_ERROR(gdma_register_tx_event_callbacks(dma->tx_chan, &tx_cbs, p_uart), err, UART_TAG, "register tx dma callbacks failed");
+    }
+
+    uhci_ll_init(dma->uhci);
+    uhci_ll_attach_uart_port(dma->uhci, uart_num);
+    // Close an RX block as soon as the RX line is idle, and transfer the data as is
+    uhci_ll_set_eof_mode(dma->uhci, UHCI_RX_IDLE_EOF);
+    uhci_seper_chr_t seper_chr = {
+        .sub_chr_en = false,
+    };
+    uhci_ll_set_seper_chr(dma->uhci, &seper_chr);
+    uhci_swflow_ctrl_sub_chr_t sub_chr = {
+        .flow_en = 0,
+    };
+    uhci_ll_set_swflow_ctrl_sub_chr(dma->uhci, &sub_chr);
+
+    UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+    p_uart->rx_int_usr_mask &= ~(UART_INTR_RXFIFO_FULL | UART_INTR_RXFIFO_TOUT);
+    uart_hal_disable_intr_mask(&(uart_context[uart_num].hal), UART_INTR_RXFIFO_FULL | UART_INTR_RXFIFO_TOUT);
+    uart_ll_set_rx_idle_thr(uart_context[uart_num].hal.dev, UART_DMA_RX_IDLE_THRESH);
+    UART_EXIT_CRITICAL(&(uart_context[uart_num].spinlock));
+    uart_dma_rx_start(uart_num);
+    return ESP_OK;
+
+err:
+    uart_dma_uninstall(uart_num);
+    return ret;
+}
+#endif // SOC_UART_SUPPORT_UHCI_DMA
+
 /**************************************************************/
 esp_err_t uart_wait_tx_done(uart_port_t uart_num, TickType_t ticks_to_wait)
 {
@@ -1336,6 +1719,23 @@ esp_err_t uart_wait_tx_done(uart_port_t uart_num, TickType_t ticks_to_wait)
     if (res == pdFALSE) {
         return ESP_ERR_TIMEOUT;
     }
+#if SOC_UART_SUPPORT_UHCI_DMA
+    if (UART_IS_DMA_TX(uart_num)) {
+        // Wait for the DMA to move all the items of the TX ring buffer into the TX FIFO
+        uart_dma_t *dma = p_uart_obj[uart_num]->dma;
+        xSemaphoreTake(dma->tx_idle_sem, 0);
+        UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+        bool busy = (dma->tx_item != NULL);
+        UART_EXIT_CRITICAL(&(uart_context[uart_num].spinlock));
+        if (busy) {
+            TickType_t ticks_passed = xTaskGetTickCount() - ticks_start;
+            if (ticks_passed >= ticks_to_wait || xSemaphoreTake(dma->tx_idle_sem, ticks_to_wait - ticks_passed) != pdTRUE) {
+                xSemaphoreGive(p_uart_obj[uart_num]->tx_mux);
+                return ESP_ERR_TIMEOUT;
+            }
+        }
+    }
+#endif
 
     // Check the enable status of TX_DONE: If already enabled, then let the isr handle the status bit;
     // If not enabled, then make sure to clear the status bit before enabling the TX_DONE interrupt bit
@@ -1416,6 +1816,22 @@ static int uart_tx_all(uart_port_t uart_num, const char *src, size_t size, bool
     esp_pm_lock_acquire(p_uart_obj[uart_num]->pm_lock);
 #endif
     p_uart_obj[uart_num]->coll_det_flg = false;
+#if SOC_UART_SUPPORT_UHCI_DMA
+    if (UART_IS_DMA_TX(uart_num)) {
+        // Each item is sent by the DMA with a single descriptor, no data description item is needed
+        size_t max_size = MIN(xRingbufferGetMaxItemSize(p_uart_obj[uart_num]->tx_ring_buf) / 2, DMA_DESCRIPTOR_BUFFER_MAX_SIZE);
+        while (size > 0) {
+            size_t send_size = MIN(size, max_size);
+            xRingbufferSend(p_uart_obj[uart_num]->tx_ring_buf, (void *)src, send_size, portMAX_DELAY);
+            UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+            p_uart_obj[uart_num]->tx_len_tot += send_size;
+            UART_EXIT_CRITICAL(&(uart_context[uart_num].spinlock));
+            uart_dma_tx_kick(uart_num);
+            size -= send_size;
+            src += send_size;
+        }
+    } else
+#endif
     if (p_uart_obj[uart_num]->tx_buf_size > 0) {
         size_t max_size = xRingbufferGetMaxItemSize(p_uart_obj[uart_num]->tx_ring_buf);
         int offset = 0;
@@ -1480,6 +1896,7 @@ int uart_write_bytes_with_break(uart_port_t uart_num, const void *src, size_t si
     ESP_RETURN_ON_FALSE((size > 0), (-1), UART_TAG, "uart size error");
     ESP_RETURN_ON_FALSE((src), (-1), UART_TAG, "uart data null");
     ESP_RETURN_ON_FALSE((brk_len > 0 && brk_len < 256), (-1), UART_TAG, "break_num error");
+    ESP_RETURN_ON_FALSE(!UART_IS_DMA_TX(uart_num), (-1), UART_TAG, "break not supported in DMA TX mode");
     return uart_tx_all(uart_num, src, size, 1, brk_len);
 }
 
@@ -1609,7 +2026,17 @@ esp_err_t uart_flush_input(uart_port_t uart_num)
             }
         }
     }
-    uart_hal_rxfifo_rst(&(uart_context[uart_num].hal));
+#if SOC_UART_SUPPORT_UHCI_DMA
+    if (UART_IS_DMA_RX(uart_num)) {
+        // Also drop the data already written into the DMA buffer
+        gdma_stop(p_uart->dma->rx_chan);
+        gdma_reset(p_uart->dma->rx_chan);
+        uart_dma_rx_start(uart_num);
+    } else
+#endif
+    {
+        uart_hal_rxfifo_rst(&(uart_context[uart_num].hal));
+    }
     /* Only re-enable UART_INTR_RXFIFO_TOUT or UART_INTR_RXFIFO_FULL if they
      * were explicitly enabled by the user. */
     uart_reenable_intr_mask(uart_num, UART_INTR_RXFIFO_TOUT | UART_INTR_RXFIFO_FULL);
@@ -1645,6 +2072,7 @@ static void uart_free_driver_obj(uart_obj_t *uart_obj)
     }
 
     heap_caps_free(uart_obj->rx_data_buf);
+    heap_caps_free(uart_obj->rx_pkt);
 #if PROTECT_APB
     if (uart_obj->pm_lock) {
         esp_pm_lock_delete(uart_obj->pm_lock);
@@ -1779,6 +2207,22 @@ err:
     return ret;
 }
 
+#if SOC_UART_SUPPORT_UHCI_DMA
+esp_err_t uart_driver_install_with_dma(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int event_queue_size, QueueHandle_t *uart_queue,
+                                       int intr_alloc_flags, const uart_dma_config_t *dma_config)
+{
+    ESP_RETURN_ON_FALSE((uart_num < SOC_UART_HP_NUM), ESP_ERR_INVALID_ARG, UART_TAG, "uart_num error");
+    ESP_RETURN_ON_FALSE(dma_config, ESP_ERR_INVALID_ARG, UART_TAG, "dma config null");
+    esp_err_t ret = uart_driver_install(uart_num, rx_buffer_size, tx_buffer_size, event_queue_size, uart_queue, intr_alloc_flags);
+    ESP_RETURN_ON_ERROR(ret, UART_TAG, "install uart driver failed");
+    ret = uart_dma_install(uart_num, dma_config);
+    if (ret != ESP_OK) {
+        uart_driver_delete(uart_num);
+    }
+    return ret;
+}
+#endif
+
 //Make sure no other tasks are still using UART before you call this function
 esp_err_t uart_driver_delete(uart_port_t uart_num)
 {
@@ -1788,6 +2232,9 @@ esp_err_t uart_driver_delete(uart_port_t uart_num)
         return ESP_OK;
     }
     esp_intr_free(p_uart_obj[uart_num]->intr_handle);
+#if SOC_UART_SUPPORT_UHCI_DMA
+    uart_dma_uninstall(uart_num);
+#endif
     uart_disable_rx_intr(uart_num);
     uart_disable_tx_intr(uart_num);
     uart_pattern_link_free(uart_num);
@@ -1845,6 +2292,7 @@ esp_err_t uart_set_mode(uart_port_t uart_num, uart_mode_t mode)
             || (mode == UART_MODE_RS485_HALF_DUPLEX)) {
         ESP_RETURN_ON_FALSE((!uart_hal_is_hw_rts_en(&(uart_context[uart_num].hal))), ESP_ERR_INVALID_ARG, UART_TAG,
                             "disable hw flowctrl before using RS485 mode");
+        ESP_RETURN_ON_FALSE(!UART_IS_DMA_TX(uart_num), ESP_ERR_NOT_SUPPORTED, UART_TAG, "RS485 mode not supported in DMA TX mode");
     }
     if (uart_num >= SOC_UART_HP_NUM) {
         ESP_RETURN_ON_FALSE((mode == UART_MODE_UART), ESP_ERR_INVALID_ARG, UART_TAG, "LP_UART can only be in normal UART mode");
@@ -1974,6 +2422,46 @@ void uart_set_always_rx_timeout(uart_port_t uart_num, bool always_rx_timeout)
     }
 }
 
+esp_err_t uart_enable_packet_mode(uart_port_t uart_num, const uart_packet_config_t *config)
+{
+    ESP_RETURN_ON_FALSE((uart_num < UART_NUM_MAX), ESP_ERR_INVALID_ARG, UART_TAG, "uart_num error");
+    ESP_RETURN_ON_FALSE(config && config->on_packet && config->max_packet_len > 0, ESP_ERR_INVALID_ARG, UART_TAG, "invalid packet config");
+    ESP_RETURN_ON_FALSE(config->end_mode != UART_PACKET_END_LENGTH || config->get_packet_len, ESP_ERR_INVALID_ARG, UART_TAG, "get_packet_len is needed");
+    ESP_RETURN_ON_FALSE((p_uart_obj[uart_num]), ESP_ERR_INVALID_STATE, UART_TAG, "uart driver error");
+    ESP_RETURN_ON_FALSE(!UART_IS_DMA_RX(uart_num), ESP_ERR_NOT_SUPPORTED, UART_TAG, "not supported in DMA mode");
+    ESP_RETURN_ON_FALSE(!p_uart_obj[uart_num]->rx_pkt, ESP_ERR_INVALID_STATE, UART_TAG, "packet mode already enabled");
+    if (config->rx_timeout) {
+        ESP_RETURN_ON_ERROR(uart_set_rx_timeout(uart_num, config->rx_timeout), UART_TAG, "set rx timeout failed");
+    }
+    ESP_RETURN_ON_FALSE(config->end_mode != UART_PACKET_END_IDLE || uart_hal_get_rx_tout_thr(&(uart_context[uart_num].hal)),
+                        ESP_ERR_INVALID_ARG, UART_TAG, "rx timeout is disabled");
+
+    uart_rx_packet_t *pkt = heap_caps_calloc(1, sizeof(uart_rx_packet_t) + config->max_packet_len, UART_MALLOC_CAPS);
+    ESP_RETURN_ON_FALSE(pkt, ESP_ERR_NO_MEM, UART_TAG, "no mem for packet buffer");
+    pkt->config = *config;
+
+    // The data already in the RX ring buffer stays readable by uart_read_bytes
+    UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+    p_uart_obj[uart_num]->rx_pkt = pkt;
+    UART_EXIT_CRITICAL(&(uart_context[uart_num].spinlock));
+    return ESP_OK;
+}
+
+esp_err_t uart_disable_packet_mode(uart_port_t uart_num)
+{
+    ESP_RETURN_ON_FALSE((uart_num < UART_NUM_MAX), ESP_ERR_INVALID_ARG, UART_TAG, "uart_num error");
+    ESP_RETURN_ON_FALSE((p_uart_obj[uart_num]), ESP_ERR_INVALID_STATE, UART_TAG, "uart driver error");
+    // Nothing is read from the RX FIFO while the packet context is released
+    UART_ENTER_CRITICAL(&(uart_context[uart_num].spinlock));
+    uart_hal_disable_intr_mask(&(uart_context[uart_num].hal), UART_INTR_RXFIFO_FULL | UART_INTR_RXFIFO_TOUT);
+    uart_rx_packet_t *pkt = p_uart_obj[uart_num]->rx_pkt;
+    p_uart_obj[uart_num]->rx_pkt = NULL;
+    UART_EXIT_CRITICAL(&(uart_context[uart_num].spinlock));
+    heap_caps_free(pkt);
+    uart_reenable_intr_mask(uart_num, UART_INTR_RXFIFO_TOUT | UART_INTR_RXFIFO_FULL);
+    return ESP_OK;
+}
+
 #if SOC_UART_SUPPORT_SLEEP_RETENTION && CONFIG_PM_POWER_DOWN_PERIPHERAL_IN_LIGHT_SLEEP
 static esp_err_t uart_create_sleep_retention_link_cb(void *arg)
 {
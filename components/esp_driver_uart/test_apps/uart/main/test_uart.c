@@ -536,3 +536,171 @@ TEST_CASE("uart int state restored after flush", "[uart]")
     TEST_ESP_OK(uart_driver_delete(uart_num));
     free(data);
 }
+
+static IRAM_ATTR bool test_uart_on_packet(uart_port_t uart_num, const uint8_t *data, size_t len, void *user_ctx)
+{
+    QueueHandle_t queue = (QueueHandle_t)user_ctx;
+    BaseType_t high_task_wakeup = pdFALSE;
+    xQueueSendFromISR(queue, &len, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+}
+
+static IRAM_ATTR size_t test_uart_get_packet_len(const uint8_t *data, size_t len, void *user_ctx)
+{
+    // The first byte of a packet is its total length
+    return data[0];
+}
+
+static void test_uart_expect_packets(QueueHandle_t queue, const size_t *expected_len, int num)
+{
+    size_t len = 0;
+    for (int i = 0; i < num; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(queue, &len, pdMS_TO_TICKS(1000)));
+        TEST_ASSERT_EQUAL(expected_len[i], len);
+    }
+    TEST_ASSERT_EQUAL(pdFALSE, xQueueReceive(queue, &len, pdMS_TO_TICKS(50)));
+}
+
+TEST_CASE("uart packet mode test", "[uart]")
+{
+    uart_port_param_t port_param = {};
+    TEST_ASSERT(port_select(&port_param));
+
+    uart_port_t uart_num = port_param.port_num;
+    uart_config_t uart_config = {
+        .baud_rate = 115200,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = port_param.default_src_clk,
+    };
+    QueueHandle_t uart_queue;
+    QueueHandle_t packet_queue = xQueueCreate(10, sizeof(size_t));
+    TEST_ASSERT_NOT_NULL(packet_queue);
+    uint8_t *wr_data = (uint8_t *)malloc(256);
+    TEST_ASSERT_NOT_NULL(wr_data);
+    TEST_ESP_OK(uart_driver_install(uart_num, BUF_SIZE * 4, 0, 20, &uart_queue, 0));
+    TEST_ESP_OK(uart_param_config(uart_num, &uart_config));
+    TEST_ESP_OK(uart_set_loop_back(uart_num, true));
+
+    uart_packet_config_t packet_config = {
+        .end_mode = UART_PACKET_END_DELIMITER,
+        .max_packet_len = 64,
+        .delimiter = '\n',
+        .on_packet = test_uart_on_packet,
+        .user_ctx = packet_queue,
+    };
+    TEST_ESP_OK(uart_enable_packet_mode(uart_num, &packet_config));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, uart_enable_packet_mode(uart_num, &packet_config));
+    const char *lines = "hello\nworld!\n";
+    uart_write_bytes(uart_num, lines, strlen(lines));
+    test_uart_expect_packets(packet_queue, (const size_t[]) {6, 7}, 2);
+    // A packet longer than the packet buffer is dropped
+    memset(wr_data, 'a', 100);
+    wr_data[100] = '\n';
+    uart_write_bytes(uart_num, wr_data, 101);
+    test_uart_expect_packets(packet_queue, NULL, 0);
+    uart_event_t event;
+    bool buffer_full = false;
+    while (xQueueReceive(uart_queue, &event, 0) == pdTRUE) {
+        TEST_ASSERT_NOT_EQUAL(UART_DATA, event.type);
+        buffer_full |= (event.type == UART_BUFFER_FULL);
+    }
+    TEST_ASSERT_TRUE(buffer_full);
+    TEST_ESP_OK(uart_disable_packet_mode(uart_num));
+
+    packet_config.end_mode = UART_PACKET_END_LENGTH;
+    packet_config.get_packet_len = test_uart_get_packet_len;
+    TEST_ESP_OK(uart_enable_packet_mode(uart_num, &packet_config));
+    const uint8_t frames[] = {3, 1, 2, 5, 1, 2, 3, 4};
+    uart_write_bytes(uart_num, frames, sizeof(frames));
+    test_uart_expect_packets(packet_queue, (const size_t[]) {3, 5}, 2);
+    TEST_ESP_OK(uart_disable_packet_mode(uart_num));
+
+    packet_config.end_mode = UART_PACKET_END_IDLE;
+    packet_config.max_packet_len = 256;
+    packet_config.rx_timeout = 10;
+    TEST_ESP_OK(uart_enable_packet_mode(uart_num, &packet_config));
+    // Longer than the RX FIFO, the end of the packet is only given by the RX timeout
+    for (int i = 0; i < 200; i++) {
+        wr_data[i] = i;
+    }
+    uart_write_bytes(uart_num, wr_data, 200);
+    TEST_ESP_OK(uart_wait_tx_done(uart_num, portMAX_DELAY));
+    vTaskDelay(pdMS_TO_TICKS(20));
+    uart_write_bytes(uart_num, wr_data, 10);
+    test_uart_expect_packets(packet_queue, (const size_t[]) {200, 10}, 2);
+    TEST_ESP_OK(uart_disable_packet_mode(uart_num));
+
+    // The data goes through the RX ring buffer again
+    uart_write_bytes(uart_num, wr_data, 10);
+    TEST_ASSERT_EQUAL(10, uart_read_bytes(uart_num, wr_data + 10, 10, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(wr_data, wr_data + 10, 10);
+
+    TEST_ESP_OK(uart_driver_delete(uart_num));
+    vQueueDelete(packet_queue);
+    free(wr_data);
+}
+
+#if SOC_UART_SUPPORT_UHCI_DMA
+TEST_CASE("uart read write test in DMA mode", "[uart][hp-uart-only]")
+{
+    const uart_port_t uart_num = UART_NUM_1;
+    const int data_len = 4096;
+    uint8_t *wr_data = (uint8_t *)malloc(data_len);
+    uint8_t *rd_data = (uint8_t *)calloc(1, data_len);
+    TEST_ASSERT_NOT_NULL(wr_data);
+    TEST_ASSERT_NOT_NULL(rd_data);
+    for (int i = 0; i < data_len; i++) {
+        wr_data[i] = i * 7;
+    }
+    uart_config_t uart_config = {
+        .baud_rate = 5000000,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+    uart_dma_config_t dma_config = {
+        .rx_dma_buf_size = 2048,
+    };
+    QueueHandle_t uart_queue;
+    TEST_ESP_OK(uart_driver_install_with_dma(uart_num, data_len * 2, data_len, 20, &uart_queue, 0, &dma_config));
+    TEST_ESP_OK(uart_param_config(uart_num, &uart_config));
+    TEST_ESP_OK(uart_set_loop_back(uart_num, true));
+    // Not supported in DMA mode
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, uart_enable_pattern_det_baud_intr(uart_num, '+', 3, 9, 0, 0));
+    TEST_ASSERT_EQUAL(-1, uart_write_bytes_with_break(uart_num, wr_data, 16, 10));
+
+    TEST_ASSERT_EQUAL(data_len, uart_write_bytes(uart_num, wr_data, data_len));
+    TEST_ESP_OK(uart_wait_tx_done(uart_num, pdMS_TO_TICKS(1000)));
+    int len = uart_read_bytes(uart_num, rd_data, data_len, pdMS_TO_TICKS(1000));
+    TEST_ASSERT_EQUAL(data_len, len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(wr_data, rd_data, data_len);
+
+    // The data is reported by UART_DATA events, the last one is sent when the RX line becomes idle
+    uart_event_t event;
+    size_t event_len = 0;
+    bool idle = false;
+    while (xQueueReceive(uart_queue, &event, 0) == pdTRUE) {
+        TEST_ASSERT_EQUAL(UART_DATA, event.type);
+        event_len += event.size;
+        idle = event.timeout_flag;
+    }
+    TEST_ASSERT_EQUAL(data_len, event_len);
+    TEST_ASSERT_TRUE(idle);
+
+    // Data still in the DMA buffer is dropped by the flush
+    TEST_ASSERT_EQUAL(16, uart_write_bytes(uart_num, wr_data, 16));
+    TEST_ESP_OK(uart_wait_tx_done(uart_num, pdMS_TO_TICKS(1000)));
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ESP_OK(uart_flush_input(uart_num));
+    TEST_ASSERT_EQUAL(0, uart_read_bytes(uart_num, rd_data, 16, pdMS_TO_TICKS(10)));
+
+    TEST_ESP_OK(uart_driver_delete(uart_num));
+    free(wr_data);
+    free(rd_data);
+}
+#endif
@@ -65,12 +65,15 @@ int usb_serial_jtag_read_bytes(void* buf, uint32_t length, TickType_t ticks_to_w
  * Please ensure the `tx_buffer_size is larger than 0`, if the 'tx_buffer_size' > 0, this function will return after copying all the data to tx ring buffer,
  * USB_SERIAL_JTAG ISR will then move data from the ring buffer to TX FIFO gradually.
  *
+ * Data larger than the TX ring buffer is copied in chunks of half of the ring buffer, as the ISR empties it. The ISR
+ * fills the TX FIFO with as many bytes as it can hold before flushing it, so streamed data is sent in full packets.
+ *
  * @param src   data buffer address
  * @param size  data length to send
- * @param ticks_to_wait Maximum timeout in RTOS ticks
+ * @param ticks_to_wait Maximum timeout in RTOS ticks, for the whole data
  *
  * @return
- *     - The number of bytes pushed to the TX FIFO
+ *     - The number of bytes pushed to the TX ring buffer, less than size if the timeout expired
  */
 int usb_serial_jtag_write_bytes(const void* src, size_t size, TickType_t ticks_to_wait);
 
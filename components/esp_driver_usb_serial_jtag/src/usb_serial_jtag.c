@@ -44,6 +44,7 @@ typedef struct {
 
     // TX parameters
     RingbufHandle_t tx_ring_buf;        /*!< TX ring buffer handler */
+    size_t tx_buffer_size;              /*!< TX ring buffer size */
     uint8_t tx_stash_buf[USB_SER_JTAG_ENDP_SIZE];  /*!< Data buffer to stash TX FIFO data */
     size_t tx_stash_cnt;                           /*!< Number of stashed TX FIFO bytes */
 
@@ -74,23 +75,25 @@ static void usb_serial_jtag_isr_handler_default(void *arg)
         // (ROM print routines?) have snuck in a full buffer before we got here. In that case,
         // we simply ignore the interrupt, a new one will come if the buffer is empty again.
         if (usb_serial_jtag_ll_txfifo_writable() == 1) {
-            // Retrieve data from either the stash buffer or, if that's empty, from the ring buffer.
-            size_t queued_size;
-            uint8_t *queued_buf = NULL;
+            size_t sent_total = 0;
+            bool ring_buf_returned = false;
             if (p_usb_serial_jtag_obj->tx_stash_cnt != 0) {
                 // Send stashed tx bytes before reading bytes from ring buffer
-                queued_buf = p_usb_serial_jtag_obj->tx_stash_buf;
-                queued_size = p_usb_serial_jtag_obj->tx_stash_cnt;
-            } else {
-                // Max 64 data payload size in a single EndPoint
-                queued_buf = (uint8_t *)xRingbufferReceiveUpToFromISR(p_usb_serial_jtag_obj->tx_ring_buf, &queued_size, USB_SER_JTAG_ENDP_SIZE);
+                size_t stash_cnt = p_usb_serial_jtag_obj->tx_stash_cnt;
+                uint32_t sent_size = usb_serial_jtag_ll_write_txfifo(p_usb_serial_jtag_obj->tx_stash_buf, stash_cnt);
+                memmove(p_usb_serial_jtag_obj->tx_stash_buf, &p_usb_serial_jtag_obj->tx_stash_buf[sent_size], stash_cnt - sent_size);
+                p_usb_serial_jtag_obj->tx_stash_cnt = stash_cnt - sent_size;
+                sent_total += sent_size;
             }
-
-            if (queued_buf != NULL && queued_size > 0) {
-                // We have some data to send. Send it.
+            // Fill the rest of the FIFO from the ring buffer, so the host picks up full packets. If the data wraps
+            // around the end of the ring buffer, it's received in two parts.
+            for (int i = 0; i < 2 && p_usb_serial_jtag_obj->tx_stash_cnt == 0 && sent_total < USB_SER_JTAG_ENDP_SIZE; i++) {
+                size_t queued_size;
+                uint8_t *queued_buf = (uint8_t *)xRingbufferReceiveUpToFromISR(p_usb_serial_jtag_obj->tx_ring_buf, &queued_size, USB_SER_JTAG_ENDP_SIZE - sent_total);
+                if (queued_buf == NULL) {
+                    break;
+                }
                 uint32_t sent_size = usb_serial_jtag_ll_write_txfifo(queued_buf, queued_size);
-                usb_serial_jtag_ll_txfifo_flush();
-
                 // Check if we were able to send everything.
                 if (sent_size < queued_size) {
                     // Not all bytes could be sent at once; stash the unwritten bytes in a buffer
@@ -100,18 +103,20 @@ static void usb_serial_jtag_isr_handler_default(void *arg)
                     size_t stash_size = queued_size - sent_size;
                     memcpy(p_usb_serial_jtag_obj->tx_stash_buf, &queued_buf[sent_size], stash_size);
                     p_usb_serial_jtag_obj->tx_stash_cnt = stash_size;
-                } else {
-                    p_usb_serial_jtag_obj->tx_stash_cnt = 0;
                 }
-                // Return the buffer if we got it from the ring buffer.
-                if (queued_buf != p_usb_serial_jtag_obj->tx_stash_buf) {
-                    vRingbufferReturnItemFromISR(p_usb_serial_jtag_obj->tx_ring_buf, queued_buf, &xTaskWoken);
-
-                    // We just moved items out of the TX ring buffer, the driver is considered write ready, since
-                    // the TX ring buffer is assured to be not full.
-                    if (p_usb_serial_jtag_obj->usj_select_notif_callback) {
-                        p_usb_serial_jtag_obj->usj_select_notif_callback(USJ_SELECT_WRITE_NOTIF, &xTaskWoken);
-                    }
+                sent_total += sent_size;
+                vRingbufferReturnItemFromISR(p_usb_serial_jtag_obj->tx_ring_buf, queued_buf, &xTaskWoken);
+                ring_buf_returned = true;
+            }
+
+            if (sent_total > 0 || p_usb_serial_jtag_obj->tx_stash_cnt > 0) {
+                // We have sent some data. Flush it once the FIFO has been filled as much as possible.
+                usb_serial_jtag_ll_txfifo_flush();
+
+                // We just moved items out of the TX ring buffer, the driver is considered write ready, since
+                // the TX ring buffer is assured to be not full.
+                if (ring_buf_returned && p_usb_serial_jtag_obj->usj_select_notif_callback) {
+                    p_usb_serial_jtag_obj->usj_select_notif_callback(USJ_SELECT_WRITE_NOTIF, &xTaskWoken);
                 }
             } else {
                 // No data to send.
@@ -183,11 +188,12 @@ esp_err_t usb_serial_jtag_driver_install(usb_serial_jtag_driver_config_t *usb_se
     }
 
     p_usb_serial_jtag_obj->tx_ring_buf = xRingbufferCreate(usb_serial_jtag_config->tx_buffer_size, RINGBUF_TYPE_BYTEBUF);
-    if (p_usb_serial_jtag_obj->rx_ring_buf == NULL) {
+    if (p_usb_serial_jtag_obj->tx_ring_buf == NULL) {
         ESP_LOGE(USB_SERIAL_JTAG_TAG, "ringbuffer create error");
         err = ESP_ERR_NO_MEM;
         goto _exit;
     }
+    p_usb_serial_jtag_obj->tx_buffer_size = usb_serial_jtag_config->tx_buffer_size;
 
     p_usb_serial_jtag_obj->tx_mux = xSemaphoreCreateMutex();
     if (p_usb_serial_jtag_obj->tx_mux == NULL) {
@@ -270,23 +276,42 @@ int usb_serial_jtag_write_bytes(const void* src, size_t size, TickType_t ticks_t
 
     //This will block when something else is waiting in wait_tx_done, making sure we don't add data to the ringbuffer.
     //Note that the ringbuffer itself is thread-safe, so this is only needed to handle wait_tx_done.
+    TimeOut_t timeout;
+    vTaskSetTimeOutState(&timeout);
     BaseType_t result = xSemaphoreTake(p_usb_serial_jtag_obj->tx_mux, ticks_to_wait);
     if (result == pdFALSE) {
         return 0;
     }
+    if (xTaskCheckForTimeOut(&timeout, &ticks_to_wait)) {
+        ticks_to_wait = 0;
+    }
 
     //Mark TX as not idle so flush function knows to wait. Note we don't care if it was already not idle, so no
     //timeout and we don't check if this succeeds; we just want to make sure the semaphore is taken.
     xSemaphoreTake(p_usb_serial_jtag_obj->tx_idle_sem, 0);
 
-    result = xRingbufferSend(p_usb_serial_jtag_obj->tx_ring_buf, (void*)src, size, ticks_to_wait);
-    // Re-enable the TX interrupt. If this was disabled, this will immediately trigger the ISR
-    // and send the things we just put in the ringbuffer. Note that even though this is a
-    // read-modify-write operation on the interrupt enable register that could happen at the
-    // same point the ISR does a read-modify-write to disable the interrupt,
-    usb_serial_jtag_ll_ena_intr_mask(USB_SERIAL_JTAG_INTR_SERIAL_IN_EMPTY);
+    // Data larger than the ring buffer is sent in chunks of half of the ring buffer, so that the ISR keeps sending
+    // the previous chunk while we wait for space for the next one.
+    const uint8_t *data = (const uint8_t *)src;
+    size_t sent = 0;
+    while (sent < size) {
+        size_t chunk = (size - sent <= p_usb_serial_jtag_obj->tx_buffer_size) ? size - sent : p_usb_serial_jtag_obj->tx_buffer_size / 2;
+        result = xRingbufferSend(p_usb_serial_jtag_obj->tx_ring_buf, (void*)&data[sent], chunk, ticks_to_wait);
+        if (result == pdFALSE) {
+            break;
+        }
+        sent += chunk;
+        // Re-enable the TX interrupt. If this was disabled, this will immediately trigger the ISR
+        // and send the things we just put in the ringbuffer. Note that even though this is a
+        // read-modify-write operation on the interrupt enable register that could happen at the
+        // same point the ISR does a read-modify-write to disable the interrupt,
+        usb_serial_jtag_ll_ena_intr_mask(USB_SERIAL_JTAG_INTR_SERIAL_IN_EMPTY);
+        if (xTaskCheckForTimeOut(&timeout, &ticks_to_wait)) {
+            ticks_to_wait = 0;
+        }
+    }
     xSemaphoreGive(p_usb_serial_jtag_obj->tx_mux);
-    return (result == pdFALSE) ? 0 : size;
+    return sent;
 }
 
 esp_err_t usb_serial_jtag_wait_tx_done(TickType_t ticks_to_wait)
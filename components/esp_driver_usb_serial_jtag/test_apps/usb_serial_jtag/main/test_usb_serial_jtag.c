@@ -122,6 +122,31 @@ TEST_CASE("see if fsync appears to work", "[usb_serial_jtag]")
     usb_serial_jtag_driver_uninstall();
 }
 
+#define STREAM_DATA_SZ 4096
+
+TEST_CASE("test write larger than the tx buffer", "[usb_serial_jtag]")
+{
+    usb_serial_jtag_driver_config_t cfg = USB_SERIAL_JTAG_DRIVER_CONFIG_DEFAULT();
+    TEST_ESP_OK(usb_serial_jtag_driver_install(&cfg));
+
+    char *buf = malloc(STREAM_DATA_SZ);
+    TEST_ASSERT_NOT_NULL(buf);
+    //fill with NULL bytes as they won't be printed to the terminal but will be sent over USB
+    memset(buf, 0, STREAM_DATA_SZ);
+
+    //the data is streamed through the tx ring buffer instead of being refused
+    TEST_ASSERT_EQUAL(STREAM_DATA_SZ, usb_serial_jtag_write_bytes(buf, STREAM_DATA_SZ, portMAX_DELAY));
+    TEST_ESP_OK(usb_serial_jtag_wait_tx_done(pdMS_TO_TICKS(1000)));
+
+    //with no time to wait, only what fits in the ring buffer is queued
+    int sent = usb_serial_jtag_write_bytes(buf, STREAM_DATA_SZ, 0);
+    TEST_ASSERT_LESS_THAN_INT(STREAM_DATA_SZ, sent);
+    TEST_ESP_OK(usb_serial_jtag_wait_tx_done(pdMS_TO_TICKS(1000)));
+
+    free(buf);
+    usb_serial_jtag_driver_uninstall();
+}
+
 TEST_CASE("test rom printf work after driver installed", "[usb_serial_jtag]")
 {
     usb_serial_jtag_driver_config_t cfg = USB_SERIAL_JTAG_DRIVER_CONFIG_DEFAULT();
@@ -25,6 +25,9 @@ def test_usb_serial_jtag_dev(dut: Dut) -> None:                # type: ignore
     dut.expect_exact('Enter next test, or \'enter\' to see menu')
     dut.write('\"see if fsync appears to work\"')
     dut.expect('PASS')
+    dut.expect_exact('Enter next test, or \'enter\' to see menu')
+    dut.write('\"test write larger than the tx buffer\"')
+    dut.expect('PASS')
 
 
 @pytest.mark.esp32s3
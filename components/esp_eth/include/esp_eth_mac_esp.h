@@ -191,9 +191,45 @@ typedef struct {
 typedef enum {
     ETH_MAC_ESP_CMD_SET_TDES0_CFG_BITS = ETH_CMD_CUSTOM_MAC_CMDS_OFFSET,    /*!< Set Transmit Descriptor Word 0 control bit mask (debug option)*/
     ETH_MAC_ESP_CMD_CLEAR_TDES0_CFG_BITS,                                   /*!< Clear Transmit Descriptor Word 0 control bit mask (debug option)*/
-    ETH_MAC_ESP_CMD_PTP_ENABLE,                                             /*!< Enable IEEE1588 Time stamping */
+    ETH_MAC_ESP_CMD_PTP_ENABLE,                                             /*!< Enable IEEE1588 Time stamping, data is a pointer to bool */
+    ETH_MAC_ESP_CMD_S_PTP_TIME,                                             /*!< Set IEEE1588 system time, data is a pointer to eth_mac_time_t */
+    ETH_MAC_ESP_CMD_G_PTP_TIME,                                             /*!< Get IEEE1588 system time, data is a pointer to eth_mac_time_t */
+    ETH_MAC_ESP_CMD_ADJ_PTP_TIME,                                           /*!< Add an offset to IEEE1588 system time, data is a pointer to int64_t offset in nanoseconds */
+    ETH_MAC_ESP_CMD_ADJ_PTP_FREQ,                                           /*!< Adjust rate of IEEE1588 system time, data is a pointer to int32_t adjustment in parts per billion */
+    ETH_MAC_ESP_CMD_S_TS_CB,                                                /*!< Set callbacks reporting frame timestamps, data is a pointer to eth_mac_ts_cb_config_t */
 } eth_mac_esp_io_cmd_t;
 
+/**
+ * @brief IEEE1588 time of the EMAC
+ *
+ */
+typedef struct {
+    uint32_t seconds;       /*!< Seconds */
+    uint32_t nanoseconds;   /*!< Nanoseconds, less than 1e9 */
+} eth_mac_time_t;
+
+/**
+ * @brief Callback reporting the IEEE1588 timestamp of a frame
+ *
+ * @param frame         the frame, which is not copied: a received frame is the buffer which is passed to the stack
+ *                      after the callback returns, a transmitted frame is the buffer passed to the transmit function
+ *                      (its first buffer for frames transmitted by `esp_eth_transmit_vargs`)
+ * @param length        length of the frame (of its first buffer for frames transmitted by `esp_eth_transmit_vargs`)
+ * @param timestamp     time at which the frame was received or transmitted
+ * @param user_ctx      user context given in eth_mac_ts_cb_config_t
+ */
+typedef void (*eth_mac_ts_cb_t)(const uint8_t *frame, uint32_t length, const eth_mac_time_t *timestamp, void *user_ctx);
+
+/**
+ * @brief Callbacks reporting frame timestamps
+ *
+ */
+typedef struct {
+    eth_mac_ts_cb_t rx_cb;  /*!< Called from the EMAC receive task for each received frame with a timestamp, can be NULL */
+    eth_mac_ts_cb_t tx_cb;  /*!< Called from the transmitting task once a frame with a timestamp is transmitted, can be NULL */
+    void *user_ctx;         /*!< User context passed to the callbacks */
+} eth_mac_ts_cb_config_t;
+
 /**
  * @brief Default ESP32's EMAC specific configuration
  *
@@ -10,6 +10,7 @@ extern "C" {
 #endif
 
 #include "esp_err.h"
+#include "soc/soc_caps.h"
 
 /**
  * @brief Indicate to ::emac_esp_dma_receive_frame that receive frame buffer was allocated by ::emac_esp_dma_alloc_recv_buf
@@ -119,6 +120,36 @@ void emac_esp_dma_flush_recv_frame(emac_esp_dma_handle_t emac_esp_dma);
  */
 void emac_esp_dma_get_remain_frames(emac_esp_dma_handle_t emac_esp_dma, uint32_t *remain_frames, uint32_t *used_descs);
 
+#if SOC_EMAC_IEEE_1588_SUPPORT
+/**
+ * @brief Get the IEEE 1588 timestamp of the frame last returned by ::emac_esp_dma_alloc_recv_buf or ::emac_esp_dma_receive_frame
+ *
+ * @param[in] emac_esp_dma EMAC DMA handle
+ * @param[out] seconds seconds of the timestamp
+ * @param[out] nanoseconds nanoseconds of the timestamp
+ * @return esp_err_t
+ *          ESP_OK on success
+ *          ESP_ERR_NOT_FOUND when no timestamp was captured for the frame
+ */
+esp_err_t emac_esp_dma_get_rx_timestamp(emac_esp_dma_handle_t emac_esp_dma, uint32_t *seconds, uint32_t *nanoseconds);
+
+/**
+ * @brief Get the IEEE 1588 timestamp of the last transmitted frame
+ *
+ * @note The timestamp is captured only when the frame was transmitted with the @c EMAC_HAL_TDES0_TX_TS_ENABLE
+ *       control bit set, see ::emac_esp_dma_set_tdes0_ctrl_bits. Each timestamp is returned once.
+ *
+ * @param[in] emac_esp_dma EMAC DMA handle
+ * @param[out] seconds seconds of the timestamp
+ * @param[out] nanoseconds nanoseconds of the timestamp
+ * @return esp_err_t
+ *          ESP_OK on success
+ *          ESP_ERR_INVALID_STATE when the frame is not transmitted yet
+ *          ESP_ERR_NOT_FOUND when no timestamp was captured for the frame or it was already returned
+ */
+esp_err_t emac_esp_dma_get_tx_timestamp(emac_esp_dma_handle_t emac_esp_dma, uint32_t *seconds, uint32_t *nanoseconds);
+#endif // SOC_EMAC_IEEE_1588_SUPPORT
+
 /**
  * @brief Set the Transmit Descriptor Word 0 (TDES0) control bits
  *
@@ -46,8 +46,26 @@ static void eth_l2_free(void *h, void* buffer)
     free(buffer);
 }
 
+static esp_err_t eth_transmit_segments(void *h, void **buffers, size_t *lens, size_t count)
+{
+    esp_eth_handle_t eth_handle = (esp_eth_handle_t)h;
+    // the MAC copies the segments directly into its DMA buffers
+    switch (count) {
+    case 1:
+        return esp_eth_transmit(eth_handle, buffers[0], lens[0]);
+    case 2:
+        return esp_eth_transmit_vargs(eth_handle, 2, buffers[0], (uint32_t)lens[0], buffers[1], (uint32_t)lens[1]);
+    case 3:
+        return esp_eth_transmit_vargs(eth_handle, 3, buffers[0], (uint32_t)lens[0], buffers[1], (uint32_t)lens[1],
+                                      buffers[2], (uint32_t)lens[2]);
+    default:
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+}
+
 static esp_err_t esp_eth_post_attach(esp_netif_t *esp_netif, void *args)
 {
+    esp_eth_mac_t *mac = NULL;
     uint8_t eth_mac[6];
     esp_eth_netif_glue_t *netif_glue = (esp_eth_netif_glue_t *)args;
     netif_glue->base.netif = esp_netif;
@@ -61,6 +79,11 @@ static esp_err_t esp_eth_post_attach(esp_netif_t *esp_netif, void *args)
         .driver_free_rx_buffer = eth_l2_free
     };
 
+    // frames split into several buffers are passed through only if the MAC can gather them
+    if (esp_eth_get_mac_instance(netif_glue->eth_driver, &mac) == ESP_OK && mac->transmit_vargs) {
+        driver_ifconfig.transmit_segments = eth_transmit_segments;
+    }
+
     ESP_ERROR_CHECK(esp_netif_set_driver_config(esp_netif, &driver_ifconfig));
     esp_eth_ioctl(netif_glue->eth_driver, ETH_CMD_G_MAC_ADDR, eth_mac);
     ESP_LOGI(TAG, "%02x:%02x:%02x:%02x:%02x:%02x", eth_mac[0], eth_mac[1],
@@ -37,6 +37,7 @@ static const char *TAG = "esp.emac";
 
 #define PHY_OPERATION_TIMEOUT_US        (1000)
 #define MAC_STOP_TIMEOUT_US             (2500) // this is absolute maximum for 10Mbps, it is 10 times faster for 100Mbps
+#define TX_TIMESTAMP_TIMEOUT_US         (2500) // time to transmit the longest frame at 10Mbps, with margin
 #define FLOW_CONTROL_LOW_WATER_MARK     (CONFIG_ETH_DMA_RX_BUFFER_NUM / 3)
 #define FLOW_CONTROL_HIGH_WATER_MARK    (FLOW_CONTROL_LOW_WATER_MARK * 2)
 
@@ -74,6 +75,11 @@ typedef struct {
     esp_pm_lock_handle_t pm_lock;
 #endif
     eth_mac_dma_burst_len_t dma_burst_len;
+#if SOC_EMAC_IEEE_1588_SUPPORT
+    bool ptp_enabled;
+    uint32_t ptp_base_addend; // addend at which the system time runs at the nominal rate
+    eth_mac_ts_cb_config_t ts_cb;
+#endif
 
     // ---- Chip specifics ----
 #ifdef CONFIG_IDF_TARGET_ESP32
@@ -256,13 +262,107 @@ static esp_err_t emac_esp32_set_peer_pause_ability(esp_eth_mac_t *mac, uint32_t
     return ESP_OK;
 }
 
+#if SOC_EMAC_IEEE_1588_SUPPORT
+static esp_err_t emac_esp_ptp_enable(emac_esp32_t *emac, bool enable)
+{
+    if (enable == emac->ptp_enabled) {
+        return ESP_OK;
+    }
+    if (enable) {
+        EMAC_IF_RCC_ATOMIC() {
+            emac_hal_clock_enable_ptp(&emac->hal, true);
+        }
+        emac->ptp_base_addend = emac_hal_ptp_start(&emac->hal, esp_clk_xtal_freq());
+        emac_esp_dma_set_tdes0_ctrl_bits(emac->emac_dma_hndl, EMAC_HAL_TDES0_TX_TS_ENABLE);
+    } else {
+        emac_esp_dma_clear_tdes0_ctrl_bits(emac->emac_dma_hndl, EMAC_HAL_TDES0_TX_TS_ENABLE);
+        emac_hal_ptp_stop(&emac->hal);
+        EMAC_IF_RCC_ATOMIC() {
+            emac_hal_clock_enable_ptp(&emac->hal, false);
+        }
+    }
+    emac->ptp_enabled = enable;
+    return ESP_OK;
+}
+
+static esp_err_t emac_esp_ptp_adj_time(emac_esp32_t *emac, int64_t offset_ns)
+{
+    bool subtract = offset_ns < 0;
+    uint64_t abs_offset = subtract ? -(uint64_t)offset_ns : (uint64_t)offset_ns;
+    ESP_RETURN_ON_FALSE(abs_offset / 1000000000 <= UINT32_MAX, ESP_ERR_INVALID_ARG, TAG, "time offset out of range");
+    return emac_hal_ptp_adj_time(&emac->hal, abs_offset / 1000000000, abs_offset % 1000000000, subtract);
+}
+
+static esp_err_t emac_esp_ptp_adj_freq(emac_esp32_t *emac, int32_t ppb)
+{
+    int64_t addend = (int64_t)emac->ptp_base_addend + (int64_t)emac->ptp_base_addend * ppb / 1000000000;
+    ESP_RETURN_ON_FALSE(addend > 0 && addend <= UINT32_MAX, ESP_ERR_INVALID_ARG, TAG, "frequency adjustment out of range");
+    return emac_hal_ptp_set_addend(&emac->hal, (uint32_t)addend);
+}
+
+static void emac_esp_report_tx_timestamp(emac_esp32_t *emac, const uint8_t *buf, uint32_t length)
+{
+    eth_mac_time_t ts;
+    esp_err_t ret;
+    uint32_t to = 0;
+    /* the frame was just given to DMA, wait until it is transmitted */
+    while ((ret = emac_esp_dma_get_tx_timestamp(emac->emac_dma_hndl, &ts.seconds, &ts.nanoseconds)) == ESP_ERR_INVALID_STATE &&
+            to < TX_TIMESTAMP_TIMEOUT_US) {
+        esp_rom_delay_us(5);
+        to += 5;
+    }
+    if (ret == ESP_OK) {
+        emac->ts_cb.tx_cb(buf, length, &ts, emac->ts_cb.user_ctx);
+    } else {
+        ESP_LOGD(TAG, "no timestamp of transmitted frame");
+    }
+}
+#endif // SOC_EMAC_IEEE_1588_SUPPORT
+
 esp_err_t emac_esp_custom_ioctl(esp_eth_mac_t *mac, int cmd, void *data)
 {
     emac_esp32_t *emac = __containerof(mac, emac_esp32_t, parent);
 
     switch (cmd) {
+#if SOC_EMAC_IEEE_1588_SUPPORT
     case ETH_MAC_ESP_CMD_PTP_ENABLE:
+        ESP_RETURN_ON_FALSE(data != NULL, ESP_ERR_INVALID_ARG, TAG, "PTP enable can't be null");
+        return emac_esp_ptp_enable(emac, *(bool *)data);
+    case ETH_MAC_ESP_CMD_S_PTP_TIME: {
+        ESP_RETURN_ON_FALSE(data != NULL, ESP_ERR_INVALID_ARG, TAG, "can't set PTP time to null");
+        ESP_RETURN_ON_FALSE(emac->ptp_enabled, ESP_ERR_INVALID_STATE, TAG, "PTP is not enabled");
+        eth_mac_time_t *time = (eth_mac_time_t *)data;
+        ESP_RETURN_ON_FALSE(time->nanoseconds < 1000000000, ESP_ERR_INVALID_ARG, TAG, "invalid nanoseconds");
+        return emac_hal_ptp_set_time(&emac->hal, time->seconds, time->nanoseconds);
+    }
+    case ETH_MAC_ESP_CMD_G_PTP_TIME: {
+        ESP_RETURN_ON_FALSE(data != NULL, ESP_ERR_INVALID_ARG, TAG, "can't get PTP time to null");
+        ESP_RETURN_ON_FALSE(emac->ptp_enabled, ESP_ERR_INVALID_STATE, TAG, "PTP is not enabled");
+        eth_mac_time_t *time = (eth_mac_time_t *)data;
+        emac_hal_ptp_get_time(&emac->hal, &time->seconds, &time->nanoseconds);
+        break;
+    }
+    case ETH_MAC_ESP_CMD_ADJ_PTP_TIME:
+        ESP_RETURN_ON_FALSE(data != NULL, ESP_ERR_INVALID_ARG, TAG, "PTP time offset can't be null");
+        ESP_RETURN_ON_FALSE(emac->ptp_enabled, ESP_ERR_INVALID_STATE, TAG, "PTP is not enabled");
+        return emac_esp_ptp_adj_time(emac, *(int64_t *)data);
+    case ETH_MAC_ESP_CMD_ADJ_PTP_FREQ:
+        ESP_RETURN_ON_FALSE(data != NULL, ESP_ERR_INVALID_ARG, TAG, "PTP frequency adjustment can't be null");
+        ESP_RETURN_ON_FALSE(emac->ptp_enabled, ESP_ERR_INVALID_STATE, TAG, "PTP is not enabled");
+        return emac_esp_ptp_adj_freq(emac, *(int32_t *)data);
+    case ETH_MAC_ESP_CMD_S_TS_CB:
+        ESP_RETURN_ON_FALSE(data != NULL, ESP_ERR_INVALID_ARG, TAG, "timestamp callbacks config can't be null");
+        emac->ts_cb = *(eth_mac_ts_cb_config_t *)data;
+        break;
+#else
+    case ETH_MAC_ESP_CMD_PTP_ENABLE:
+    case ETH_MAC_ESP_CMD_S_PTP_TIME:
+    case ETH_MAC_ESP_CMD_G_PTP_TIME:
+    case ETH_MAC_ESP_CMD_ADJ_PTP_TIME:
+    case ETH_MAC_ESP_CMD_ADJ_PTP_FREQ:
+    case ETH_MAC_ESP_CMD_S_TS_CB:
         return ESP_ERR_NOT_SUPPORTED;
+#endif // SOC_EMAC_IEEE_1588_SUPPORT
     case ETH_MAC_ESP_CMD_SET_TDES0_CFG_BITS:
         ESP_RETURN_ON_FALSE(data != NULL, ESP_ERR_INVALID_ARG, TAG, "cannot set DMA tx desc flag to null");
         emac_esp_dma_set_tdes0_ctrl_bits(emac->emac_dma_hndl, *(uint32_t *)data);
@@ -285,6 +385,11 @@ static esp_err_t emac_esp32_transmit(esp_eth_mac_t *mac, uint8_t *buf, uint32_t
         ESP_LOGD(TAG, "insufficient TX buffer size");
         return ESP_ERR_NO_MEM;
     }
+#if SOC_EMAC_IEEE_1588_SUPPORT
+    if (emac->ptp_enabled && emac->ts_cb.tx_cb) {
+        emac_esp_report_tx_timestamp(emac, buf, length);
+    }
+#endif
     return ESP_OK;
 }
 
@@ -302,6 +407,11 @@ static esp_err_t emac_esp32_transmit_multiple_bufs(esp_eth_mac_t *mac, uint32_t
     }
     uint32_t sent_len = emac_esp_dma_transmit_multiple_buf_frame(emac->emac_dma_hndl, bufs, len, argc);
     ESP_GOTO_ON_FALSE(sent_len == exp_len, ESP_ERR_INVALID_SIZE, err, TAG, "insufficient TX buffer size");
+#if SOC_EMAC_IEEE_1588_SUPPORT
+    if (emac->ptp_enabled && emac->ts_cb.tx_cb) {
+        emac_esp_report_tx_timestamp(emac, bufs[0], len[0]);
+    }
+#endif
     return ESP_OK;
 err:
     return ret;
@@ -348,6 +458,13 @@ static void emac_esp32_rx_task(void *arg)
                     free(buffer);
                 } else {
                     ESP_LOGD(TAG, "receive len= %" PRIu32, recv_len);
+#if SOC_EMAC_IEEE_1588_SUPPORT
+                    eth_mac_time_t ts;
+                    if (emac->ptp_enabled && emac->ts_cb.rx_cb &&
+                            emac_esp_dma_get_rx_timestamp(emac->emac_dma_hndl, &ts.seconds, &ts.nanoseconds) == ESP_OK) {
+                        emac->ts_cb.rx_cb(buffer, recv_len, &ts, emac->ts_cb.user_ctx);
+                    }
+#endif
                     emac->eth->stack_input(emac->eth, buffer, recv_len);
                 }
                 /* if allocation failed and there is a waiting frame */
@@ -366,6 +483,9 @@ static void emac_esp32_rx_task(void *arg)
             }
 #endif
         } while (emac->frames_remain);
+        /* all frames were drained, let the next frame raise an interrupt again. A frame received meanwhile has
+         * already set the RX status bit, so the interrupt is raised as soon as it is enabled */
+        emac_hal_enable_corresponding_intr(&emac->hal, EMAC_LL_INTR_RECEIVE_ENABLE);
     }
     vTaskDelete(NULL);
 }
@@ -450,6 +570,9 @@ static esp_err_t emac_esp32_deinit(esp_eth_mac_t *mac)
     esp_eth_mediator_t *eth = emac->eth;
 #ifdef CONFIG_PM_ENABLE
     esp_pm_lock_release(emac->pm_lock);
+#endif
+#if SOC_EMAC_IEEE_1588_SUPPORT
+    emac_esp_ptp_enable(emac, false);
 #endif
     emac_hal_stop(&emac->hal);
     eth->on_state_changed(eth, ETH_STATE_DEINIT, NULL);
@@ -503,6 +626,9 @@ IRAM_ATTR void emac_isr_default_handler(void *args)
     if (intr_stat & EMAC_LL_DMA_RECEIVE_FINISH_INTR) {
         emac_esp32_t *emac = __containerof(hal, emac_esp32_t, hal);
         BaseType_t high_task_wakeup = pdFALSE;
+        /* mask further RX interrupts while the receive task drains the descriptors, so a burst of
+         * frames costs a single interrupt instead of one per frame */
+        emac_hal_disable_corresponding_intr(hal, EMAC_LL_INTR_RECEIVE_ENABLE);
         /* notify receive task */
         vTaskNotifyGiveFromISR(emac->rx_task_hdl, &high_task_wakeup);
         if (high_task_wakeup == pdTRUE) {
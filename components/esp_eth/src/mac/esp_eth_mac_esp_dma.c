@@ -48,6 +48,12 @@ struct emac_esp_dma_t {
     eth_dma_tx_descriptor_t *tx_desc;
     uint8_t *rx_buf[CONFIG_ETH_DMA_RX_BUFFER_NUM];
     uint8_t *tx_buf[CONFIG_ETH_DMA_TX_BUFFER_NUM];
+#if SOC_EMAC_IEEE_1588_SUPPORT
+    eth_dma_tx_descriptor_t *tx_last_desc; // last descriptor of the last transmitted frame, which receives its timestamp
+    bool rx_ts_valid;
+    uint32_t rx_ts_seconds;
+    uint32_t rx_ts_nanoseconds;
+#endif
 };
 
 typedef struct {
@@ -102,6 +108,10 @@ void emac_esp_dma_reset(emac_esp_dma_handle_t emac_esp_dma)
         DMA_CACHE_WB(&emac_esp_dma->tx_desc[i], EMAC_HAL_DMA_DESC_SIZE);
     }
 
+#if SOC_EMAC_IEEE_1588_SUPPORT
+    emac_esp_dma->tx_last_desc = NULL;
+    emac_esp_dma->rx_ts_valid = false;
+#endif
     /* set base address of the first descriptor */
     emac_hal_set_rx_tx_desc_addr(&emac_esp_dma->hal, emac_esp_dma->rx_desc, emac_esp_dma->tx_desc);
 }
@@ -154,6 +164,9 @@ uint32_t emac_esp_dma_transmit_frame(emac_esp_dma_handle_t emac_esp_dma, uint8_t
             /* Setting the last segment bit */
             desc_iter->TDES0.LastSegment = 1;
             desc_iter->TDES0.Value |= emac_esp_dma->tx_desc_flags & EMAC_TDES0_LS_CTRL_FLAGS_MASK;
+#if SOC_EMAC_IEEE_1588_SUPPORT
+            emac_esp_dma->tx_last_desc = desc_iter;
+#endif
             /* Program size */
             desc_iter->TDES1.TransmitBuffer1Size = lastlen;
             /* copy data from uplayer stack buffer */
@@ -255,6 +268,9 @@ uint32_t emac_esp_dma_transmit_multiple_buf_frame(emac_esp_dma_handle_t emac_esp
             /* Setting the last segment bit */
             desc_iter->TDES0.LastSegment = 1;
             desc_iter->TDES0.Value |= emac_esp_dma->tx_desc_flags & EMAC_TDES0_LS_CTRL_FLAGS_MASK;
+#if SOC_EMAC_IEEE_1588_SUPPORT
+            emac_esp_dma->tx_last_desc = desc_iter;
+#endif
             break;
         }
 
@@ -280,6 +296,9 @@ static esp_err_t emac_esp_dma_get_valid_recv_len(emac_esp_dma_handle_t emac_esp_
     eth_dma_rx_descriptor_t *desc_iter = emac_esp_dma->rx_desc;
     uint32_t used_descs = 0;
     DMA_CACHE_INVALIDATE(desc_iter, EMAC_HAL_DMA_DESC_SIZE);
+#if SOC_EMAC_IEEE_1588_SUPPORT
+    emac_esp_dma->rx_ts_valid = false;
+#endif
 
     /* Traverse descriptors owned by CPU */
     while ((desc_iter->RDES0.Own == EMAC_LL_DMADESC_OWNER_CPU) && (used_descs < CONFIG_ETH_DMA_RX_BUFFER_NUM)) {
@@ -295,6 +314,15 @@ static esp_err_t emac_esp_dma_get_valid_recv_len(emac_esp_dma_handle_t emac_esp_
             }
             /* Get the Frame Length of the received packet: substruct 4 bytes of the CRC */
             *ret_len = desc_iter->RDES0.FrameLength - ETH_CRC_LENGTH;
+#if SOC_EMAC_IEEE_1588_SUPPORT
+            /* the timestamp is written to the last descriptor of the frame, all ones indicate a corrupted timestamp */
+            if (desc_iter->RDES0.TSAvailIPChecksumErrGiantFrame &&
+                    (desc_iter->TimeStampLow != UINT32_MAX || desc_iter->TimeStampHigh != UINT32_MAX)) {
+                emac_esp_dma->rx_ts_valid = true;
+                emac_esp_dma->rx_ts_nanoseconds = desc_iter->TimeStampLow;
+                emac_esp_dma->rx_ts_seconds = desc_iter->TimeStampHigh;
+            }
+#endif
             break;
         }
         /* First segment in frame */
@@ -411,6 +439,38 @@ uint32_t emac_esp_dma_receive_frame(emac_esp_dma_handle_t emac_esp_dma, uint8_t
     return ret_len;
 }
 
+#if SOC_EMAC_IEEE_1588_SUPPORT
+esp_err_t emac_esp_dma_get_rx_timestamp(emac_esp_dma_handle_t emac_esp_dma, uint32_t *seconds, uint32_t *nanoseconds)
+{
+    if (!emac_esp_dma->rx_ts_valid) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *seconds = emac_esp_dma->rx_ts_seconds;
+    *nanoseconds = emac_esp_dma->rx_ts_nanoseconds;
+    return ESP_OK;
+}
+
+esp_err_t emac_esp_dma_get_tx_timestamp(emac_esp_dma_handle_t emac_esp_dma, uint32_t *seconds, uint32_t *nanoseconds)
+{
+    eth_dma_tx_descriptor_t *desc = emac_esp_dma->tx_last_desc;
+    if (desc == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    DMA_CACHE_INVALIDATE(desc, EMAC_HAL_DMA_DESC_SIZE);
+    if (desc->TDES0.Own != EMAC_LL_DMADESC_OWNER_CPU) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    /* a descriptor keeps its status until it is reused, so each timestamp is reported once */
+    emac_esp_dma->tx_last_desc = NULL;
+    if (!desc->TDES0.TxTimestampStatus) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *seconds = desc->TimeStampHigh;
+    *nanoseconds = desc->TimeStampLow;
+    return ESP_OK;
+}
+#endif // SOC_EMAC_IEEE_1588_SUPPORT
+
 void emac_esp_dma_flush_recv_frame(emac_esp_dma_handle_t emac_esp_dma)
 {
     eth_dma_rx_descriptor_t *desc_iter = emac_esp_dma->rx_desc;
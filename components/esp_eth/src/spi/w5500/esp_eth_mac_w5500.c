@@ -30,14 +30,9 @@ static const char *TAG = "w5500.mac";
 #define W5500_SPI_LOCK_TIMEOUT_MS (50)
 #define W5500_TX_MEM_SIZE (0x4000)
 #define W5500_RX_MEM_SIZE (0x4000)
-#define W5500_ETH_MAC_RX_BUF_SIZE_AUTO (0)
-
-typedef struct {
-    uint32_t offset;
-    uint32_t copy_len;
-    uint32_t rx_len;
-    uint32_t remain;
-}__attribute__((packed)) emac_w5500_auto_buf_info_t;
+#define W5500_RX_FRAME_HEADER_LEN (2)
+#define W5500_RX_BURST_SIZE_MIN (ETH_MAX_PACKET_SIZE + W5500_RX_FRAME_HEADER_LEN) // a burst must hold at least one frame
+#define W5500_RX_BURST_SIZE_MAX (2 * ETH_MAX_PACKET_SIZE)
 
 typedef struct {
     spi_device_handle_t hdl;
@@ -64,6 +59,7 @@ typedef struct {
     uint8_t addr[6];
     bool packets_remain;
     uint8_t *rx_buffer;
+    uint32_t rx_burst_size;
 } emac_w5500_t;
 
 static void *w5500_spi_init(const void *spi_config)
@@ -605,75 +601,29 @@ err:
     return ret;
 }
 
-static esp_err_t emac_w5500_alloc_recv_buf(emac_w5500_t *emac, uint8_t **buf, uint32_t *length)
+static esp_err_t emac_w5500_receive(esp_eth_mac_t *mac, uint8_t *buf, uint32_t *length)
 {
     esp_err_t ret = ESP_OK;
+    emac_w5500_t *emac = __containerof(mac, emac_w5500_t, parent);
     uint16_t offset = 0;
     uint16_t rx_len = 0;
-    uint32_t copy_len = 0;
+    uint16_t copy_len = 0;
     uint16_t remain_bytes = 0;
-    *buf = NULL;
+    emac->packets_remain = false;
 
     w5500_get_rx_received_size(emac, &remain_bytes);
     if (remain_bytes) {
         // get current read pointer
         ESP_GOTO_ON_ERROR(w5500_read(emac, W5500_REG_SOCK_RX_RD(0), &offset, sizeof(offset)), err, TAG, "read RX RD failed");
         offset = __builtin_bswap16(offset);
-        // read head
+        // read head first
         ESP_GOTO_ON_ERROR(w5500_read_buffer(emac, &rx_len, sizeof(rx_len), offset), err, TAG, "read frame header failed");
         rx_len = __builtin_bswap16(rx_len) - 2; // data size includes 2 bytes of header
         // frames larger than expected will be truncated
         copy_len = rx_len > *length ? *length : rx_len;
-        // runt frames are not forwarded by W5500 (tested on target), but check the length anyway since it could be corrupted at SPI bus
-        ESP_GOTO_ON_FALSE(copy_len >= ETH_MIN_PACKET_SIZE - ETH_CRC_LEN, ESP_ERR_INVALID_SIZE, err, TAG, "invalid frame length %" PRIu32, copy_len);
-        *buf = malloc(copy_len);
-        if (*buf != NULL) {
-            emac_w5500_auto_buf_info_t *buff_info = (emac_w5500_auto_buf_info_t *)*buf;
-            buff_info->offset = offset;
-            buff_info->copy_len = copy_len;
-            buff_info->rx_len = rx_len;
-            buff_info->remain = remain_bytes;
-        } else {
-            ret = ESP_ERR_NO_MEM;
-            goto err;
-        }
-    }
-err:
-    *length = rx_len;
-    return ret;
-}
-
-static esp_err_t emac_w5500_receive(esp_eth_mac_t *mac, uint8_t *buf, uint32_t *length)
-{
-    esp_err_t ret = ESP_OK;
-    emac_w5500_t *emac = __containerof(mac, emac_w5500_t, parent);
-    uint16_t offset = 0;
-    uint16_t rx_len = 0;
-    uint16_t copy_len = 0;
-    uint16_t remain_bytes = 0;
-    emac->packets_remain = false;
-
-    if (*length != W5500_ETH_MAC_RX_BUF_SIZE_AUTO) {
-        w5500_get_rx_received_size(emac, &remain_bytes);
-        if (remain_bytes) {
-            // get current read pointer
-            ESP_GOTO_ON_ERROR(w5500_read(emac, W5500_REG_SOCK_RX_RD(0), &offset, sizeof(offset)), err, TAG, "read RX RD failed");
-            offset = __builtin_bswap16(offset);
-            // read head first
-            ESP_GOTO_ON_ERROR(w5500_read_buffer(emac, &rx_len, sizeof(rx_len), offset), err, TAG, "read frame header failed");
-            rx_len = __builtin_bswap16(rx_len) - 2; // data size includes 2 bytes of header
-            // frames larger than expected will be truncated
-            copy_len = rx_len > *length ? *length : rx_len;
-        } else {
-            // silently return when no frame is waiting
-            goto err;
-        }
     } else {
-        emac_w5500_auto_buf_info_t *buff_info = (emac_w5500_auto_buf_info_t *)buf;
-        offset = buff_info->offset;
-        copy_len = buff_info->copy_len;
-        rx_len = buff_info->rx_len;
-        remain_bytes = buff_info->remain;
+        // silently return when no frame is waiting
+        goto err;
     }
     // 2 bytes of header
     offset += 2;
@@ -697,6 +647,69 @@ err:
     return ret;
 }
 
+/**
+ * @brief Read as many received frames as fit in the RX buffer with a single SPI transaction and pass them to the stack
+ *
+ * Receiving frames one by one takes several SPI transactions per frame (header, payload, read pointer, RECV command),
+ * which dominates the time spent for small frames. Here the read pointer is updated and RECV is issued once per burst.
+ */
+static esp_err_t emac_w5500_receive_burst(emac_w5500_t *emac)
+{
+    esp_err_t ret = ESP_OK;
+    uint16_t offset = 0;
+    uint16_t remain_bytes = 0;
+    uint32_t burst_len = 0;
+    uint32_t pos = 0;
+    emac->packets_remain = false;
+
+    w5500_get_rx_received_size(emac, &remain_bytes);
+    if (remain_bytes == 0) {
+        return ESP_OK;
+    }
+    // get current read pointer
+    ESP_GOTO_ON_ERROR(w5500_read(emac, W5500_REG_SOCK_RX_RD(0), &offset, sizeof(offset)), err, TAG, "read RX RD failed");
+    offset = __builtin_bswap16(offset);
+    burst_len = remain_bytes > emac->rx_burst_size ? emac->rx_burst_size : remain_bytes;
+    ESP_GOTO_ON_ERROR(w5500_read_buffer(emac, emac->rx_buffer, burst_len, offset), err, TAG, "read RX burst failed, len=%" PRIu32, burst_len);
+
+    while (pos + W5500_RX_FRAME_HEADER_LEN <= burst_len) {
+        // data size includes 2 bytes of header
+        uint32_t frame_len = (emac->rx_buffer[pos] << 8) | emac->rx_buffer[pos + 1];
+        if (frame_len < ETH_MIN_PACKET_SIZE - ETH_CRC_LEN + W5500_RX_FRAME_HEADER_LEN ||
+                frame_len > ETH_MAX_PACKET_SIZE + W5500_RX_FRAME_HEADER_LEN || pos + frame_len > remain_bytes) {
+            // the header could be corrupted at SPI bus, the frame boundaries are lost so drop all received data
+            ESP_LOGE(TAG, "invalid frame length %" PRIu32 ", dropping %" PRIu32 " bytes", frame_len, remain_bytes - pos);
+            pos = remain_bytes;
+            break;
+        }
+        if (pos + frame_len > burst_len) {
+            // the frame continues past the burst, it is read by the next one
+            break;
+        }
+        uint32_t data_len = frame_len - W5500_RX_FRAME_HEADER_LEN;
+        uint8_t *buffer = malloc(data_len);
+        if (buffer != NULL) {
+            memcpy(buffer, emac->rx_buffer + pos + W5500_RX_FRAME_HEADER_LEN, data_len);
+            ESP_LOGD(TAG, "receive len=%" PRIu32, data_len);
+            /* pass the buffer to stack (e.g. TCP/IP layer) */
+            emac->eth->stack_input(emac->eth, buffer, data_len);
+        } else {
+            ESP_LOGE(TAG, "no mem for receive buffer");
+        }
+        pos += frame_len;
+    }
+
+    // update read pointer
+    offset = __builtin_bswap16((uint16_t)(offset + pos));
+    ESP_GOTO_ON_ERROR(w5500_write(emac, W5500_REG_SOCK_RX_RD(0), &offset, sizeof(offset)), err, TAG, "write RX RD failed");
+    /* issue RECV command */
+    ESP_GOTO_ON_ERROR(w5500_send_command(emac, W5500_SCR_RECV, 100), err, TAG, "issue RECV command failed");
+    // check if there're more data need to process
+    emac->packets_remain = remain_bytes > pos;
+err:
+    return ret;
+}
+
 static esp_err_t emac_w5500_flush_recv_frame(emac_w5500_t *emac)
 {
     esp_err_t ret = ESP_OK;
@@ -748,9 +761,6 @@ static void emac_w5500_task(void *arg)
 {
     emac_w5500_t *emac = (emac_w5500_t *)arg;
     uint8_t status = 0;
-    uint8_t *buffer = NULL;
-    uint32_t frame_len = 0;
-    uint32_t buf_len = 0;
     esp_err_t ret;
     while (1) {
         /* check if the task receives any notification */
@@ -770,35 +780,9 @@ static void emac_w5500_task(void *arg)
             /* clear interrupt status */
             w5500_write(emac, W5500_REG_SOCK_IR(0), &status, sizeof(status));
             do {
-                /* define max expected frame len */
-                frame_len = ETH_MAX_PACKET_SIZE;
-                if ((ret = emac_w5500_alloc_recv_buf(emac, &buffer, &frame_len)) == ESP_OK) {
-                    if (buffer != NULL) {
-                        /* we have memory to receive the frame of maximal size previously defined */
-                        buf_len = W5500_ETH_MAC_RX_BUF_SIZE_AUTO;
-                        if (emac->parent.receive(&emac->parent, buffer, &buf_len) == ESP_OK) {
-                            if (buf_len == 0) {
-                                free(buffer);
-                            } else if (frame_len > buf_len) {
-                                ESP_LOGE(TAG, "received frame was truncated");
-                                free(buffer);
-                            } else {
-                                ESP_LOGD(TAG, "receive len=%" PRIu32, buf_len);
-                                /* pass the buffer to stack (e.g. TCP/IP layer) */
-                                emac->eth->stack_input(emac->eth, buffer, buf_len);
-                            }
-                        } else {
-                            ESP_LOGE(TAG, "frame read from module failed");
-                            free(buffer);
-                        }
-                    } else if (frame_len) {
-                        ESP_LOGE(TAG, "invalid combination of frame_len(%" PRIu32 ") and buffer pointer(%p)", frame_len, buffer);
-                    }
-                } else if (ret == ESP_ERR_NO_MEM) {
-                    ESP_LOGE(TAG, "no mem for receive buffer");
+                if ((ret = emac_w5500_receive_burst(emac)) != ESP_OK) {
+                    ESP_LOGE(TAG, "frame read from module failed");
                     emac_w5500_flush_recv_frame(emac);
-                } else {
-                    ESP_LOGE(TAG, "unexpected error 0x%x", ret);
                 }
             } while (emac->packets_remain);
         }
@@ -915,6 +899,15 @@ esp_eth_mac_t *esp_eth_mac_new_w5500(const eth_w5500_config_t *w5500_config, con
         ESP_GOTO_ON_FALSE((emac->spi.ctx = emac->spi.init(w5500_config)) != NULL, NULL, err, TAG, "SPI initialization failed");
     }
 
+    /* read RX bursts as large as the SPI bus allows, a custom SPI driver is only known to read a full frame */
+    size_t max_trans_len = 0;
+    emac->rx_burst_size = W5500_RX_BURST_SIZE_MIN;
+    if (emac->spi.read == w5500_spi_read &&
+            spi_bus_get_max_transaction_len(w5500_config->spi_host_id, &max_trans_len) == ESP_OK) {
+        emac->rx_burst_size = max_trans_len > W5500_RX_BURST_SIZE_MAX ? W5500_RX_BURST_SIZE_MAX : max_trans_len;
+        emac->rx_burst_size = emac->rx_burst_size < W5500_RX_BURST_SIZE_MIN ? W5500_RX_BURST_SIZE_MIN : emac->rx_burst_size;
+    }
+
     /* create w5500 task */
     BaseType_t core_num = tskNO_AFFINITY;
     if (mac_config->flags & ETH_MAC_FLAG_PIN_TO_CORE) {
@@ -924,7 +917,7 @@ esp_eth_mac_t *esp_eth_mac_new_w5500(const eth_w5500_config_t *w5500_config, con
                            mac_config->rx_task_prio, &emac->rx_task_hdl, core_num);
     ESP_GOTO_ON_FALSE(xReturned == pdPASS, NULL, err, TAG, "create w5500 task failed");
 
-    emac->rx_buffer = heap_caps_malloc(ETH_MAX_PACKET_SIZE, MALLOC_CAP_DMA);
+    emac->rx_buffer = heap_caps_malloc(emac->rx_burst_size, MALLOC_CAP_DMA);
     ESP_GOTO_ON_FALSE(emac->rx_buffer, NULL, err, TAG, "RX buffer allocation failed");
 
     if (emac->int_gpio_num < 0) {
@@ -515,3 +515,137 @@ TEST_CASE("internal emac erroneous frames", "[esp_emac]")
     vEventGroupDelete(eth_event_group);
     vSemaphoreDelete(mutex);
 }
+
+#if SOC_EMAC_IEEE_1588_SUPPORT
+typedef struct {
+    SemaphoreHandle_t rx_done;
+    eth_mac_time_t rx_ts;
+    eth_mac_time_t tx_ts;
+    const uint8_t *tx_frame;
+    uint32_t tx_cnt;
+} ptp_ts_check_info_t;
+
+static void ptp_rx_ts_cb(const uint8_t *frame, uint32_t length, const eth_mac_time_t *timestamp, void *user_ctx)
+{
+    ptp_ts_check_info_t *ts_info = (ptp_ts_check_info_t *)user_ctx;
+    ts_info->rx_ts = *timestamp;
+}
+
+static void ptp_tx_ts_cb(const uint8_t *frame, uint32_t length, const eth_mac_time_t *timestamp, void *user_ctx)
+{
+    ptp_ts_check_info_t *ts_info = (ptp_ts_check_info_t *)user_ctx;
+    ts_info->tx_frame = frame;
+    ts_info->tx_ts = *timestamp;
+    ts_info->tx_cnt++;
+}
+
+static esp_err_t eth_recv_ptp_check_cb(esp_eth_handle_t hdl, uint8_t *buffer, uint32_t length, void *priv)
+{
+    ptp_ts_check_info_t *ts_info = (ptp_ts_check_info_t *)priv;
+    free(buffer);
+    xSemaphoreGive(ts_info->rx_done);
+    return ESP_OK;
+}
+
+static int64_t ptp_time_to_ns(const eth_mac_time_t *time)
+{
+    return (int64_t)time->seconds * 1000000000 + time->nanoseconds;
+}
+
+TEST_CASE("internal emac ptp timestamps", "[esp_emac]")
+{
+    ptp_ts_check_info_t ts_info = {
+        .rx_done = xSemaphoreCreateBinary(),
+    };
+    TEST_ASSERT_NOT_NULL(ts_info.rx_done);
+
+    EventBits_t bits = 0;
+    EventGroupHandle_t eth_event_group = xEventGroupCreate();
+    TEST_ASSERT(eth_event_group != NULL);
+    TEST_ESP_OK(esp_event_loop_create_default());
+    TEST_ESP_OK(esp_event_handler_register(ETH_EVENT, ESP_EVENT_ANY_ID, &eth_event_handler, eth_event_group));
+
+    esp_eth_mac_t *mac = mac_init(NULL, NULL);
+    TEST_ASSERT_NOT_NULL(mac);
+    esp_eth_phy_t *phy = phy_init(NULL);
+    TEST_ASSERT_NOT_NULL(phy);
+    esp_eth_config_t config = ETH_DEFAULT_CONFIG(mac, phy);
+    esp_eth_handle_t eth_handle = NULL;
+    TEST_ESP_OK(esp_eth_driver_install(&config, &eth_handle));
+    TEST_ASSERT_NOT_NULL(eth_handle);
+    extra_eth_config(eth_handle);
+
+    bool loopback_en = true;
+    esp_eth_ioctl(eth_handle, ETH_CMD_S_PHY_LOOPBACK, &loopback_en);
+    TEST_ESP_OK(esp_eth_update_input_path(eth_handle, eth_recv_ptp_check_cb, &ts_info));
+
+    eth_mac_time_t time;
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_G_PTP_TIME, &time));
+    bool ptp_en = true;
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_PTP_ENABLE, &ptp_en));
+    eth_mac_ts_cb_config_t ts_cb = {
+        .rx_cb = ptp_rx_ts_cb,
+        .tx_cb = ptp_tx_ts_cb,
+        .user_ctx = &ts_info,
+    };
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_S_TS_CB, &ts_cb));
+
+    // the system time runs at the nominal rate
+    eth_mac_time_t start_time = { .seconds = 100, .nanoseconds = 0 };
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_S_PTP_TIME, &start_time));
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_G_PTP_TIME, &time));
+    int64_t elapsed_ns = ptp_time_to_ns(&time) - ptp_time_to_ns(&start_time);
+    ESP_LOGI(TAG, "elapsed %" PRIi64 " ns", elapsed_ns);
+    TEST_ASSERT_INT64_WITHIN(20000000, 100000000, elapsed_ns);
+
+    // a negative offset moves the system time back
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_G_PTP_TIME, &start_time));
+    int64_t offset_ns = -2500000000;
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_ADJ_PTP_TIME, &offset_ns));
+    vTaskDelay(1);
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_G_PTP_TIME, &time));
+    elapsed_ns = ptp_time_to_ns(&time) - ptp_time_to_ns(&start_time);
+    TEST_ASSERT_INT64_WITHIN(50000000, offset_ns, elapsed_ns);
+
+    int32_t ppb = 100000;
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_ADJ_PTP_FREQ, &ppb));
+    ppb = 2000000000;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_eth_ioctl(eth_handle, ETH_MAC_ESP_CMD_ADJ_PTP_FREQ, &ppb));
+
+    TEST_ESP_OK(esp_eth_start(eth_handle));
+    bits = xEventGroupWaitBits(eth_event_group, ETH_START_BIT, true, true, pdMS_TO_TICKS(ETH_START_TIMEOUT_MS));
+    TEST_ASSERT((bits & ETH_START_BIT) == ETH_START_BIT);
+    bits = xEventGroupWaitBits(eth_event_group, ETH_CONNECT_BIT, true, true, pdMS_TO_TICKS(ETH_CONNECT_TIMEOUT_MS));
+    TEST_ASSERT((bits & ETH_CONNECT_BIT) == ETH_CONNECT_BIT);
+
+    emac_frame_t *test_pkt = calloc(1, MINIMUM_TEST_FRAME_SIZE);
+    TEST_ASSERT_NOT_NULL(test_pkt);
+    test_pkt->proto = ETHERTYPE_TX_STD;
+    memset(test_pkt->dest, 0xff, ETH_ADDR_LEN);
+    TEST_ESP_OK(esp_eth_ioctl(eth_handle, ETH_CMD_G_MAC_ADDR, test_pkt->src));
+
+    // the transmitted frame is reported before esp_eth_transmit returns, it is received after it is transmitted
+    TEST_ESP_OK(esp_eth_transmit(eth_handle, test_pkt, MINIMUM_TEST_FRAME_SIZE));
+    TEST_ASSERT_EQUAL_UINT32(1, ts_info.tx_cnt);
+    TEST_ASSERT_EQUAL_PTR(test_pkt, ts_info.tx_frame);
+    TEST_ASSERT(xSemaphoreTake(ts_info.rx_done, pdMS_TO_TICKS(500)));
+    int64_t diff_ns = ptp_time_to_ns(&ts_info.rx_ts) - ptp_time_to_ns(&ts_info.tx_ts);
+    ESP_LOGI(TAG, "tx %" PRIu32 ".%09" PRIu32 " rx %" PRIu32 ".%09" PRIu32, ts_info.tx_ts.seconds, ts_info.tx_ts.nanoseconds,
+             ts_info.rx_ts.seconds, ts_info.rx_ts.nanoseconds);
+    TEST_ASSERT(diff_ns >= 0 && diff_ns < 1000000);
+
+    TEST_ESP_OK(esp_eth_stop(eth_handle));
+    bits = xEventGroupWaitBits(eth_event_group, ETH_STOP_BIT, true, true, pdMS_TO_TICKS(ETH_STOP_TIMEOUT_MS));
+    TEST_ASSERT((bits & ETH_STOP_BIT) == ETH_STOP_BIT);
+    free(test_pkt);
+    TEST_ESP_OK(esp_eth_driver_uninstall(eth_handle));
+    TEST_ESP_OK(phy->del(phy));
+    TEST_ESP_OK(mac->del(mac));
+    TEST_ESP_OK(esp_event_handler_unregister(ETH_EVENT, ESP_EVENT_ANY_ID, eth_event_handler));
+    TEST_ESP_OK(esp_event_loop_delete_default());
+    extra_cleanup();
+    vEventGroupDelete(eth_event_group);
+    vSemaphoreDelete(ts_info.rx_done);
+}
+#endif // SOC_EMAC_IEEE_1588_SUPPORT
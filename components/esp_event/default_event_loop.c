@@ -89,6 +89,59 @@ esp_err_t esp_event_isr_post(esp_event_base_t event_base, int32_t event_id,
 }
 #endif
 
+#if CONFIG_ESP_EVENT_POST_BY_REFERENCE
+esp_err_t esp_event_post_by_ref(esp_event_base_t event_base, int32_t event_id, void* event_data,
+                                esp_event_data_release_t release, void* release_arg, TickType_t ticks_to_wait)
+{
+    if (s_default_loop == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return esp_event_post_by_ref_to(s_default_loop, event_base, event_id,
+                                    event_data, release, release_arg, ticks_to_wait);
+}
+
+#if CONFIG_ESP_EVENT_POST_FROM_ISR
+esp_err_t esp_event_isr_post_by_ref(esp_event_base_t event_base, int32_t event_id, void* event_data,
+                                    esp_event_data_release_t release, void* release_arg, BaseType_t* task_unblocked)
+{
+    if (s_default_loop == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return esp_event_isr_post_by_ref_to(s_default_loop, event_base, event_id,
+                                        event_data, release, release_arg, task_unblocked);
+}
+#endif
+#endif
+
+esp_err_t esp_event_get_stats(esp_event_loop_stats_t* stats)
+{
+    if (s_default_loop == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return esp_event_loop_get_stats(s_default_loop, stats);
+}
+
+esp_err_t esp_event_get_handler_stats(esp_event_handler_stats_t* stats, size_t* count)
+{
+    if (s_default_loop == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return esp_event_loop_get_handler_stats(s_default_loop, stats, count);
+}
+
+esp_err_t esp_event_reset_stats(void)
+{
+    if (s_default_loop == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return esp_event_loop_reset_stats(s_default_loop);
+}
+
 esp_err_t esp_event_loop_create_default(void)
 {
     if (s_default_loop) {
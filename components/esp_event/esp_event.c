@@ -112,6 +112,58 @@ static void esp_event_loop_run_task(void* args)
     vTaskSuspend(NULL);
 }
 
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+static bool handler_is_registered(esp_event_loop_instance_t* loop, esp_event_handler_node_t* handler)
+{
+    esp_event_loop_node_t* loop_node;
+    esp_event_base_node_t* base_node;
+    esp_event_id_node_t* id_node;
+    esp_event_handler_node_t* handler_node;
+
+    SLIST_FOREACH(loop_node, &(loop->loop_nodes), next) {
+        SLIST_FOREACH(handler_node, &(loop_node->handlers), next) {
+            if (handler_node == handler) {
+                return true;
+            }
+        }
+        SLIST_FOREACH(base_node, &(loop_node->base_nodes), next) {
+            SLIST_FOREACH(handler_node, &(base_node->handlers), next) {
+                if (handler_node == handler) {
+                    return true;
+                }
+            }
+            SLIST_FOREACH(id_node, &(base_node->id_nodes), next) {
+                SLIST_FOREACH(handler_node, &(id_node->handlers), next) {
+                    if (handler_node == handler) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+static void queue_wait_record(esp_event_loop_instance_t* loop, const esp_event_post_instance_t* post)
+{
+    int64_t wait = esp_timer_get_time() - post->post_time;
+    // Bucket 0 counts waits under 10 us, each next bucket ten times longer waits
+    int bucket = 0;
+    for (int64_t limit = 10; wait >= limit && bucket < ESP_EVENT_LOOP_QUEUE_WAIT_BUCKETS - 1; limit *= 10) {
+        bucket++;
+    }
+
+    xSemaphoreTake(loop->profiling_mutex, portMAX_DELAY);
+    loop->events_dispatched++;
+    loop->queue_wait_total += wait;
+    if (wait > loop->queue_wait_max) {
+        loop->queue_wait_max = wait;
+    }
+    loop->queue_wait_histogram[bucket]++;
+    xSemaphoreGive(loop->profiling_mutex);
+}
+#endif
+
 static void handler_execute(esp_event_loop_instance_t* loop, esp_event_handler_node_t *handler, esp_event_post_instance_t post)
 {
     ESP_LOGD(TAG, "running post %s:%"PRIu32" with handler %p and context %p on loop %p", post.base, post.id, handler->handler_ctx->handler, &handler->handler_ctx, loop);
@@ -145,14 +197,11 @@ static void handler_execute(esp_event_loop_instance_t* loop, esp_event_handler_n
     // At this point handler may be already unregistered.
     // This happens in "handler instance can unregister itself" test case.
     // To prevent memory corruption error it's necessary to check if pointer is still valid.
-    esp_event_loop_node_t* loop_node;
-    esp_event_handler_node_t* handler_node;
-    SLIST_FOREACH(loop_node, &(loop->loop_nodes), next) {
-        SLIST_FOREACH(handler_node, &(loop_node->handlers), next) {
-            if (handler_node == handler) {
-                handler->invoked++;
-                handler->time += diff;
-            }
+    if (handler_is_registered(loop, handler)) {
+        handler->invoked++;
+        handler->time += diff;
+        if (diff > handler->time_max) {
+            handler->time_max = diff;
         }
     }
 
@@ -316,7 +365,22 @@ static esp_err_t loop_node_add_handler(esp_event_loop_node_t* loop_node,
     }
 }
 
-static esp_err_t handler_instances_remove(esp_event_handler_nodes_t* handlers, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
+static void handler_instance_free(esp_event_loop_instance_t* loop, esp_event_handler_node_t* handler)
+{
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+    if (loop->dispatch_depth > 0) {
+        // The handler may still be referenced by the event being dispatched, free it once dispatching is done.
+        // Its list link is kept intact, so a list walk currently at this handler can still continue.
+        handler->removed = true;
+        SLIST_INSERT_HEAD(&(loop->removed_handlers), handler, removed_next);
+        return;
+    }
+#endif
+    free(handler->handler_ctx);
+    free(handler);
+}
+
+static esp_err_t handler_instances_remove(esp_event_loop_instance_t* loop, esp_event_handler_nodes_t* handlers, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
 {
     esp_event_handler_node_t *it, *temp;
 
@@ -324,15 +388,13 @@ static esp_err_t handler_instances_remove(esp_event_handler_nodes_t* handlers, e
         if (legacy) {
             if (it->handler_ctx->handler == handler_ctx->handler) {
                 SLIST_REMOVE(handlers, it, esp_event_handler_node, next);
-                free(it->handler_ctx);
-                free(it);
+                handler_instance_free(loop, it);
                 return ESP_OK;
             }
         } else {
             if (it->handler_ctx == handler_ctx) {
                 SLIST_REMOVE(handlers, it, esp_event_handler_node, next);
-                free(it->handler_ctx);
-                free(it);
+                handler_instance_free(loop, it);
                 return ESP_OK;
             }
         }
@@ -341,15 +403,15 @@ static esp_err_t handler_instances_remove(esp_event_handler_nodes_t* handlers, e
     return ESP_ERR_NOT_FOUND;
 }
 
-static esp_err_t base_node_remove_handler(esp_event_base_node_t* base_node, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
+static esp_err_t base_node_remove_handler(esp_event_loop_instance_t* loop, esp_event_base_node_t* base_node, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
 {
     if (id == ESP_EVENT_ANY_ID) {
-        return handler_instances_remove(&(base_node->handlers), handler_ctx, legacy);
+        return handler_instances_remove(loop, &(base_node->handlers), handler_ctx, legacy);
     } else {
         esp_event_id_node_t *it, *temp;
         SLIST_FOREACH_SAFE(it, &(base_node->id_nodes), next, temp) {
             if (it->id == id) {
-                esp_err_t res = handler_instances_remove(&(it->handlers), handler_ctx, legacy);
+                esp_err_t res = handler_instances_remove(loop, &(it->handlers), handler_ctx, legacy);
 
                 if (res == ESP_OK) {
                     if (SLIST_EMPTY(&(it->handlers))) {
@@ -365,15 +427,15 @@ static esp_err_t base_node_remove_handler(esp_event_base_node_t* base_node, int3
     return ESP_ERR_NOT_FOUND;
 }
 
-static esp_err_t loop_node_remove_handler(esp_event_loop_node_t* loop_node, esp_event_base_t base, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
+static esp_err_t loop_node_remove_handler(esp_event_loop_instance_t* loop, esp_event_loop_node_t* loop_node, esp_event_base_t base, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
 {
     if (base == esp_event_any_base && id == ESP_EVENT_ANY_ID) {
-        return handler_instances_remove(&(loop_node->handlers), handler_ctx, legacy);
+        return handler_instances_remove(loop, &(loop_node->handlers), handler_ctx, legacy);
     } else {
         esp_event_base_node_t *it, *temp;
         SLIST_FOREACH_SAFE(it, &(loop_node->base_nodes), next, temp) {
             if (it->base == base) {
-                esp_err_t res = base_node_remove_handler(it, id, handler_ctx, legacy);
+                esp_err_t res = base_node_remove_handler(loop, it, id, handler_ctx, legacy);
 
                 if (res == ESP_OK) {
                     if (SLIST_EMPTY(&(it->handlers)) && SLIST_EMPTY(&(it->id_nodes))) {
@@ -423,20 +485,276 @@ static void loop_node_remove_all_handler(esp_event_loop_node_t* loop_node)
     }
 }
 
-static void inline __attribute__((always_inline)) post_instance_delete(esp_event_post_instance_t* post)
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+// The table only caches events which are actually posted, bound its size in case many different ids are posted
+#define DISPATCH_TABLE_MAX_ENTRIES    (4 * CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE_SIZE)
+
+static inline size_t dispatch_table_bucket(esp_event_base_t base, int32_t id)
 {
-#if CONFIG_ESP_EVENT_POST_FROM_ISR
-    if (post->data_allocated && post->data.ptr) {
-        free(post->data.ptr);
+    uint32_t hash = ((uint32_t)(uintptr_t) base >> 2) ^ ((uint32_t) id * 2654435761u);
+    return hash % CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE_SIZE;
+}
+
+static void dispatch_table_clear(esp_event_loop_instance_t* loop)
+{
+    for (size_t i = 0; i < CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE_SIZE; i++) {
+        esp_event_dispatch_entry_t *it, *temp;
+        SLIST_FOREACH_SAFE(it, &(loop->dispatch_table[i]), next, temp) {
+            free(it);
+        }
+        SLIST_INIT(&(loop->dispatch_table[i]));
+    }
+    loop->dispatch_entries = 0;
+    loop->dispatch_table_stale = false;
+}
+
+// Must be called whenever handlers are registered or unregistered
+static void dispatch_table_invalidate(esp_event_loop_instance_t* loop)
+{
+    if (loop->dispatch_depth > 0) {
+        // Entries may be in use by the event being dispatched
+        loop->dispatch_table_stale = true;
+    } else {
+        dispatch_table_clear(loop);
+    }
+}
+
+// Collect the handlers for an event, in the same order as loop_dispatch_lists() executes them
+static size_t dispatch_entry_collect(esp_event_loop_instance_t* loop, esp_event_base_t base, int32_t id, esp_event_handler_node_t** handlers)
+{
+    size_t count = 0;
+    esp_event_handler_node_t *handler;
+    esp_event_loop_node_t *loop_node;
+    esp_event_base_node_t *base_node;
+    esp_event_id_node_t *id_node;
+
+    SLIST_FOREACH(loop_node, &(loop->loop_nodes), next) {
+        SLIST_FOREACH(handler, &(loop_node->handlers), next) {
+            if (handlers) {
+                handlers[count] = handler;
+            }
+            count++;
+        }
+
+        SLIST_FOREACH(base_node, &(loop_node->base_nodes), next) {
+            if (base_node->base == base) {
+                SLIST_FOREACH(handler, &(base_node->handlers), next) {
+                    if (handlers) {
+                        handlers[count] = handler;
+                    }
+                    count++;
+                }
+
+                SLIST_FOREACH(id_node, &(base_node->id_nodes), next) {
+                    if (id_node->id == id) {
+                        SLIST_FOREACH(handler, &(id_node->handlers), next) {
+                            if (handlers) {
+                                handlers[count] = handler;
+                            }
+                            count++;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// Find the dispatch table entry of an event, creating it if necessary. Returns NULL if the table can't be used.
+static esp_event_dispatch_entry_t* dispatch_table_get(esp_event_loop_instance_t* loop, esp_event_base_t base, int32_t id)
+{
+    if (loop->dispatch_table_stale) {
+        return NULL;
     }
+
+    esp_event_dispatch_entries_t* bucket = &(loop->dispatch_table[dispatch_table_bucket(base, id)]);
+    esp_event_dispatch_entry_t* entry;
+    SLIST_FOREACH(entry, bucket, next) {
+        if (entry->base == base && entry->id == id) {
+            return entry;
+        }
+    }
+
+    if (loop->dispatch_depth > 0) {
+        // Don't modify the table while an entry of it might be in use
+        return NULL;
+    }
+
+    if (loop->dispatch_entries >= DISPATCH_TABLE_MAX_ENTRIES) {
+        dispatch_table_clear(loop);
+    }
+
+    size_t count = dispatch_entry_collect(loop, base, id, NULL);
+    entry = malloc(sizeof(*entry) + count * sizeof(entry->handlers[0]));
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    entry->base = base;
+    entry->id = id;
+    entry->handler_count = dispatch_entry_collect(loop, base, id, entry->handlers);
+    SLIST_INSERT_HEAD(bucket, entry, next);
+    loop->dispatch_entries++;
+
+    return entry;
+}
+
+// Called when dispatching an event is done, releases what was kept alive while dispatching
+static void dispatch_done(esp_event_loop_instance_t* loop)
+{
+    if (--loop->dispatch_depth > 0) {
+        return;
+    }
+
+    esp_event_handler_node_t *it, *temp;
+    SLIST_FOREACH_SAFE(it, &(loop->removed_handlers), removed_next, temp) {
+        free(it->handler_ctx);
+        free(it);
+    }
+    SLIST_INIT(&(loop->removed_handlers));
+
+    if (loop->dispatch_table_stale) {
+        dispatch_table_clear(loop);
+    }
+}
+#endif
+
+// Execute the handlers of an event by walking the lists of registered handlers
+static bool loop_dispatch_lists(esp_event_loop_instance_t* loop, esp_event_post_instance_t post)
+{
+    bool exec = false;
+
+    esp_event_handler_node_t *handler, *temp_handler;
+    esp_event_loop_node_t *loop_node, *temp_node;
+    esp_event_base_node_t *base_node, *temp_base;
+    esp_event_id_node_t *id_node, *temp_id_node;
+
+    SLIST_FOREACH_SAFE(loop_node, &(loop->loop_nodes), next, temp_node) {
+        // Execute loop level handlers
+        SLIST_FOREACH_SAFE(handler, &(loop_node->handlers), next, temp_handler) {
+            handler_execute(loop, handler, post);
+            exec |= true;
+        }
+
+        SLIST_FOREACH_SAFE(base_node, &(loop_node->base_nodes), next, temp_base) {
+            if (base_node->base == post.base) {
+                // Execute base level handlers
+                SLIST_FOREACH_SAFE(handler, &(base_node->handlers), next, temp_handler) {
+                    handler_execute(loop, handler, post);
+                    exec |= true;
+                }
+
+                SLIST_FOREACH_SAFE(id_node, &(base_node->id_nodes), next, temp_id_node) {
+                    if (id_node->id == post.id) {
+                        // Execute id level handlers
+                        SLIST_FOREACH_SAFE(handler, &(id_node->handlers), next, temp_handler) {
+                            handler_execute(loop, handler, post);
+                            exec |= true;
+                        }
+                        // Skip to next base node
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return exec;
+}
+
+// Take a free slot of the event data pool of the loop, returns NULL if the loop has no pool, the slots are too
+// small or all of them are in use
+static inline __attribute__((always_inline)) void* data_pool_alloc(esp_event_loop_instance_t* loop, size_t size)
+{
+    if (loop->data_pool == NULL || size > loop->data_pool_slot_size) {
+        return NULL;
+    }
+
+    portENTER_CRITICAL_SAFE(&(loop->data_pool_lock));
+    esp_event_data_slot_t* slot = loop->data_pool_free;
+    if (slot != NULL) {
+        loop->data_pool_free = slot->next;
+    }
+    portEXIT_CRITICAL_SAFE(&(loop->data_pool_lock));
+
+    return slot;
+}
+
+static inline __attribute__((always_inline)) void data_pool_free(esp_event_loop_instance_t* loop, void* data)
+{
+    esp_event_data_slot_t* slot = (esp_event_data_slot_t*) data;
+
+    portENTER_CRITICAL_SAFE(&(loop->data_pool_lock));
+    slot->next = loop->data_pool_free;
+    loop->data_pool_free = slot;
+    portEXIT_CRITICAL_SAFE(&(loop->data_pool_lock));
+}
+
+static void inline __attribute__((always_inline)) post_instance_delete(esp_event_loop_instance_t* loop, esp_event_post_instance_t* post)
+{
+#if CONFIG_ESP_EVENT_POST_FROM_ISR
+    void* data = post->data_allocated ? post->data.ptr : NULL;
 #else
-    if (post->data) {
-        free(post->data);
+    void* data = post->data;
+#endif
+
+#if CONFIG_ESP_EVENT_POST_BY_REFERENCE
+    if (data && post->release) {
+        // The data is owned by the poster, hand it back
+        post->release(data, post->release_arg);
+        data = NULL;
     }
 #endif
+
+    if (data) {
+        if (post->data_pooled) {
+            data_pool_free(loop, data);
+        } else {
+            free(data);
+        }
+    }
     memset(post, 0, sizeof(*post));
 }
 
+// Send a post to the queue of the loop, returns pdTRUE if it was queued
+static BaseType_t loop_queue_post(esp_event_loop_instance_t* loop, esp_event_post_instance_t* post, TickType_t ticks_to_wait)
+{
+    BaseType_t result = pdFALSE;
+
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    post->post_time = esp_timer_get_time();
+#endif
+
+    // Find the task that currently executes the loop. It is safe to query loop->task since it is
+    // not mutated since loop creation. ENSURE THIS REMAINS TRUE.
+    if (loop->task == NULL) {
+        // The loop has no dedicated task. Find out what task is currently running it.
+        result = xSemaphoreTakeRecursive(loop->mutex, ticks_to_wait);
+
+        if (result == pdTRUE) {
+            if (loop->running_task != xTaskGetCurrentTaskHandle()) {
+                xSemaphoreGiveRecursive(loop->mutex);
+                result = xQueueSendToBack(loop->queue, post, ticks_to_wait);
+            } else {
+                xSemaphoreGiveRecursive(loop->mutex);
+                result = xQueueSendToBack(loop->queue, post, 0);
+            }
+        }
+    } else {
+        // The loop has a dedicated task.
+        if (loop->task != xTaskGetCurrentTaskHandle()) {
+            result = xQueueSendToBack(loop->queue, post, ticks_to_wait);
+        } else {
+            result = xQueueSendToBack(loop->queue, post, 0);
+        }
+    }
+
+    return result;
+}
+
 /* ---------------------------- Public API --------------------------------- */
 
 esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, esp_event_loop_handle_t* event_loop)
@@ -454,12 +772,38 @@ esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, es
     esp_event_loop_instance_t* loop;
     esp_err_t err = ESP_ERR_NO_MEM; // most likely error
 
+    if (event_loop_args->data_pool_slot_size != 0 && event_loop_args->data_pool_slot_count == 0) {
+        ESP_LOGE(TAG, "event data pool has no slots");
+        return ESP_ERR_INVALID_ARG;
+    }
+
     loop = calloc(1, sizeof(*loop));
     if (loop == NULL) {
         ESP_LOGE(TAG, "alloc for event loop failed");
         return err;
     }
 
+    portMUX_INITIALIZE(&(loop->data_pool_lock));
+
+    if (event_loop_args->data_pool_slot_size != 0) {
+        // Every slot has to be able to hold the free list link, and stay aligned to it
+        size_t slot_size = (event_loop_args->data_pool_slot_size + sizeof(esp_event_data_slot_t) - 1) &
+                           ~(sizeof(esp_event_data_slot_t) - 1);
+
+        loop->data_pool = calloc(event_loop_args->data_pool_slot_count, slot_size);
+        if (loop->data_pool == NULL) {
+            ESP_LOGE(TAG, "alloc for event data pool failed");
+            goto on_err;
+        }
+
+        loop->data_pool_slot_size = slot_size;
+        for (size_t i = event_loop_args->data_pool_slot_count; i > 0; i--) {
+            esp_event_data_slot_t* slot = (esp_event_data_slot_t*)(loop->data_pool + (i - 1) * slot_size);
+            slot->next = loop->data_pool_free;
+            loop->data_pool_free = slot;
+        }
+    }
+
     loop->queue = xQueueCreate(event_loop_args->queue_size, sizeof(esp_event_post_instance_t));
     if (loop->queue == NULL) {
         ESP_LOGE(TAG, "create event loop queue failed");
@@ -482,6 +826,13 @@ esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, es
 
     SLIST_INIT(&(loop->loop_nodes));
 
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+    for (size_t i = 0; i < CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE_SIZE; i++) {
+        SLIST_INIT(&(loop->dispatch_table[i]));
+    }
+    SLIST_INIT(&(loop->removed_handlers));
+#endif
+
     // Create the loop task if requested
     if (event_loop_args->task_name != NULL) {
         BaseType_t task_created = xTaskCreatePinnedToCore(esp_event_loop_run_task, event_loop_args->task_name,
@@ -531,6 +882,7 @@ on_err:
     }
 #endif
 
+    free(loop->data_pool);
     free(loop);
 
     return err;
@@ -563,47 +915,37 @@ esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t tick
 
         loop->running_task = xTaskGetCurrentTaskHandle();
 
-        bool exec = false;
-
-        esp_event_handler_node_t *handler, *temp_handler;
-        esp_event_loop_node_t *loop_node, *temp_node;
-        esp_event_base_node_t *base_node, *temp_base;
-        esp_event_id_node_t *id_node, *temp_id_node;
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+        queue_wait_record(loop, &post);
+#endif
 
-        SLIST_FOREACH_SAFE(loop_node, &(loop->loop_nodes), next, temp_node) {
-            // Execute loop level handlers
-            SLIST_FOREACH_SAFE(handler, &(loop_node->handlers), next, temp_handler) {
-                handler_execute(loop, handler, post);
-                exec |= true;
-            }
+        bool exec = false;
 
-            SLIST_FOREACH_SAFE(base_node, &(loop_node->base_nodes), next, temp_base) {
-                if (base_node->base == post.base) {
-                    // Execute base level handlers
-                    SLIST_FOREACH_SAFE(handler, &(base_node->handlers), next, temp_handler) {
-                        handler_execute(loop, handler, post);
-                        exec |= true;
-                    }
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+        esp_event_dispatch_entry_t* entry = dispatch_table_get(loop, post.base, post.id);
+        loop->dispatch_depth++;
 
-                    SLIST_FOREACH_SAFE(id_node, &(base_node->id_nodes), next, temp_id_node) {
-                        if (id_node->id == post.id) {
-                            // Execute id level handlers
-                            SLIST_FOREACH_SAFE(handler, &(id_node->handlers), next, temp_handler) {
-                                handler_execute(loop, handler, post);
-                                exec |= true;
-                            }
-                            // Skip to next base node
-                            break;
-                        }
-                    }
+        if (entry) {
+            for (size_t i = 0; i < entry->handler_count; i++) {
+                // Handlers unregistered by previously executed handlers are skipped
+                if (!entry->handlers[i]->removed) {
+                    handler_execute(loop, entry->handlers[i], post);
+                    exec |= true;
                 }
             }
+        } else {
+            exec = loop_dispatch_lists(loop, post);
         }
 
+        dispatch_done(loop);
+#else
+        exec = loop_dispatch_lists(loop, post);
+#endif
+
         esp_event_base_t base = post.base;
         int32_t id = post.id;
 
-        post_instance_delete(&post);
+        post_instance_delete(loop, &post);
 
         if (ticks_to_run != portMAX_DELAY) {
             end = xTaskGetTickCount();
@@ -655,6 +997,10 @@ esp_err_t esp_event_loop_delete(esp_event_loop_handle_t event_loop)
         vTaskDelete(loop->task);
     }
 
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+    dispatch_table_clear(loop);
+#endif
+
     // Remove all registered events and handlers in the loop
     esp_event_loop_node_t *it, *temp;
     SLIST_FOREACH_SAFE(it, &(loop->loop_nodes), next, temp) {
@@ -666,11 +1012,12 @@ esp_err_t esp_event_loop_delete(esp_event_loop_handle_t event_loop)
     // Drop existing posts on the queue
     esp_event_post_instance_t post;
     while (xQueueReceive(loop->queue, &post, 0) == pdTRUE) {
-        post_instance_delete(&post);
+        post_instance_delete(loop, &post);
     }
 
     // Cleanup loop
     vQueueDelete(loop->queue);
+    free(loop->data_pool);
     free(loop);
     // Free loop mutex before deleting
     xSemaphoreGiveRecursive(loop_mutex);
@@ -742,6 +1089,11 @@ esp_err_t esp_event_handler_register_with_internal(esp_event_loop_handle_t event
     }
 
 on_err:
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+    if (err == ESP_OK) {
+        dispatch_table_invalidate(loop);
+    }
+#endif
     xSemaphoreGiveRecursive(loop->mutex);
     return err;
 }
@@ -781,7 +1133,7 @@ esp_err_t esp_event_handler_unregister_with_internal(esp_event_loop_handle_t eve
     esp_event_loop_node_t *it, *temp;
 
     SLIST_FOREACH_SAFE(it, &(loop->loop_nodes), next, temp) {
-        esp_err_t res = loop_node_remove_handler(it, event_base, event_id, handler_ctx, legacy);
+        esp_err_t res = loop_node_remove_handler(loop, it, event_base, event_id, handler_ctx, legacy);
 
         if (res == ESP_OK && SLIST_EMPTY(&(it->base_nodes)) && SLIST_EMPTY(&(it->handlers))) {
             SLIST_REMOVE(&(loop->loop_nodes), it, esp_event_loop_node, next);
@@ -790,6 +1142,10 @@ esp_err_t esp_event_handler_unregister_with_internal(esp_event_loop_handle_t eve
         }
     }
 
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+    dispatch_table_invalidate(loop);
+#endif
+
     xSemaphoreGiveRecursive(loop->mutex);
 
     return ESP_OK;
@@ -830,11 +1186,17 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t
     memset((void*)(&post), 0, sizeof(post));
 
     if (event_data != NULL && event_data_size != 0) {
-        // Make persistent copy of event data on heap.
-        void* event_data_copy = calloc(1, event_data_size);
+        // Make persistent copy of event data, in the data pool of the loop if possible, on heap otherwise.
+        void* event_data_copy = data_pool_alloc(loop, event_data_size);
 
-        if (event_data_copy == NULL) {
-            return ESP_ERR_NO_MEM;
+        if (event_data_copy != NULL) {
+            post.data_pooled = true;
+        } else {
+            event_data_copy = calloc(1, event_data_size);
+
+            if (event_data_copy == NULL) {
+                return ESP_ERR_NO_MEM;
+            }
         }
 
         memcpy(event_data_copy, event_data, event_data_size);
@@ -849,34 +1211,10 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t
     post.base = event_base;
     post.id = event_id;
 
-    BaseType_t result = pdFALSE;
-
-    // Find the task that currently executes the loop. It is safe to query loop->task since it is
-    // not mutated since loop creation. ENSURE THIS REMAINS TRUE.
-    if (loop->task == NULL) {
-        // The loop has no dedicated task. Find out what task is currently running it.
-        result = xSemaphoreTakeRecursive(loop->mutex, ticks_to_wait);
-
-        if (result == pdTRUE) {
-            if (loop->running_task != xTaskGetCurrentTaskHandle()) {
-                xSemaphoreGiveRecursive(loop->mutex);
-                result = xQueueSendToBack(loop->queue, &post, ticks_to_wait);
-            } else {
-                xSemaphoreGiveRecursive(loop->mutex);
-                result = xQueueSendToBack(loop->queue, &post, 0);
-            }
-        }
-    } else {
-        // The loop has a dedicated task.
-        if (loop->task != xTaskGetCurrentTaskHandle()) {
-            result = xQueueSendToBack(loop->queue, &post, ticks_to_wait);
-        } else {
-            result = xQueueSendToBack(loop->queue, &post, 0);
-        }
-    }
+    BaseType_t result = loop_queue_post(loop, &post, ticks_to_wait);
 
     if (result != pdTRUE) {
-        post_instance_delete(&post);
+        post_instance_delete(loop, &post);
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
         atomic_fetch_add(&loop->events_dropped, 1);
@@ -907,10 +1245,26 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop, esp_event_ba
     memset((void*)(&post), 0, sizeof(post));
 
     if (event_data_size > sizeof(post.data.val)) {
-        return ESP_ERR_INVALID_ARG;
-    }
+        // Data which doesn't fit the post itself can only be stored in the data pool of the loop
+        if (event_data == NULL || loop->data_pool == NULL || event_data_size > loop->data_pool_slot_size) {
+            return ESP_ERR_INVALID_ARG;
+        }
 
-    if (event_data != NULL && event_data_size != 0) {
+        void* event_data_copy = data_pool_alloc(loop, event_data_size);
+
+        if (event_data_copy == NULL) {
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+            atomic_fetch_add(&loop->events_dropped, 1);
+#endif
+            return ESP_FAIL;
+        }
+
+        memcpy(event_data_copy, event_data, event_data_size);
+        post.data.ptr = event_data_copy;
+        post.data_allocated = true;
+        post.data_pooled = true;
+        post.data_set = true;
+    } else if (event_data != NULL && event_data_size != 0) {
         memcpy((void*)(&(post.data.val)), event_data, event_data_size);
         post.data_allocated = false;
         post.data_set = true;
@@ -920,11 +1274,15 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop, esp_event_ba
 
     BaseType_t result = pdFALSE;
 
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    post.post_time = esp_timer_get_time();
+#endif
+
     // Post the event from an ISR,
     result = xQueueSendToBackFromISR(loop->queue, &post, task_unblocked);
 
     if (result != pdTRUE) {
-        post_instance_delete(&post);
+        post_instance_delete(loop, &post);
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
         atomic_fetch_add(&loop->events_dropped, 1);
@@ -940,6 +1298,98 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop, esp_event_ba
 }
 #endif
 
+#if CONFIG_ESP_EVENT_POST_BY_REFERENCE
+esp_err_t esp_event_post_by_ref_to(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, int32_t event_id,
+                                   void* event_data, esp_event_data_release_t release, void* release_arg,
+                                   TickType_t ticks_to_wait)
+{
+    assert(event_loop);
+
+    if (event_base == ESP_EVENT_ANY_BASE || event_id == ESP_EVENT_ANY_ID || event_data == NULL || release == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    esp_event_post_instance_t post;
+    memset((void*)(&post), 0, sizeof(post));
+
+#if CONFIG_ESP_EVENT_POST_FROM_ISR
+    post.data.ptr = event_data;
+    post.data_allocated = true;
+    post.data_set = true;
+#else
+    post.data = event_data;
+#endif
+    post.release = release;
+    post.release_arg = release_arg;
+    post.base = event_base;
+    post.id = event_id;
+
+    BaseType_t result = loop_queue_post(loop, &post, ticks_to_wait);
+
+    if (result != pdTRUE) {
+        // The data stays with the caller
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+        atomic_fetch_add(&loop->events_dropped, 1);
+#endif
+        return ESP_ERR_TIMEOUT;
+    }
+
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    atomic_fetch_add(&loop->events_recieved, 1);
+#endif
+
+    return ESP_OK;
+}
+
+#if CONFIG_ESP_EVENT_POST_FROM_ISR
+esp_err_t esp_event_isr_post_by_ref_to(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, int32_t event_id,
+                                       void* event_data, esp_event_data_release_t release, void* release_arg,
+                                       BaseType_t* task_unblocked)
+{
+    assert(event_loop);
+
+    if (event_base == ESP_EVENT_ANY_BASE || event_id == ESP_EVENT_ANY_ID || event_data == NULL || release == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    esp_event_post_instance_t post;
+    memset((void*)(&post), 0, sizeof(post));
+
+    post.data.ptr = event_data;
+    post.data_allocated = true;
+    post.data_set = true;
+    post.release = release;
+    post.release_arg = release_arg;
+    post.base = event_base;
+    post.id = event_id;
+
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    post.post_time = esp_timer_get_time();
+#endif
+
+    BaseType_t result = xQueueSendToBackFromISR(loop->queue, &post, task_unblocked);
+
+    if (result != pdTRUE) {
+        // The data stays with the caller
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+        atomic_fetch_add(&loop->events_dropped, 1);
+#endif
+        return ESP_FAIL;
+    }
+
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    atomic_fetch_add(&loop->events_recieved, 1);
+#endif
+
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_EVENT_POST_FROM_ISR
+#endif // CONFIG_ESP_EVENT_POST_BY_REFERENCE
+
 esp_err_t esp_event_dump(FILE* file)
 {
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
@@ -1012,3 +1462,151 @@ esp_err_t esp_event_dump(FILE* file)
 #endif
     return ESP_OK;
 }
+
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+static void handler_stats_add(esp_event_handler_stats_t* stats, size_t capacity, size_t* count,
+                              esp_event_handler_node_t* handler, esp_event_base_t base, int32_t id)
+{
+    if (*count < capacity) {
+        esp_event_handler_stats_t* entry = &stats[*count];
+        entry->handler = handler->handler_ctx->handler;
+        entry->handler_arg = handler->handler_ctx->arg;
+        entry->event_base = base;
+        entry->event_id = id;
+        entry->invoked = handler->invoked;
+        entry->time_total = handler->time;
+        entry->time_max = handler->time_max;
+    }
+    (*count)++;
+}
+#endif
+
+esp_err_t esp_event_loop_get_stats(esp_event_loop_handle_t event_loop, esp_event_loop_stats_t* stats)
+{
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    assert(event_loop);
+
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    xSemaphoreTake(loop->profiling_mutex, portMAX_DELAY);
+    stats->events_received = atomic_load(&loop->events_recieved);
+    stats->events_dropped = atomic_load(&loop->events_dropped);
+    stats->events_dispatched = loop->events_dispatched;
+    stats->queue_wait_total = loop->queue_wait_total;
+    stats->queue_wait_max = loop->queue_wait_max;
+    memcpy(stats->queue_wait_histogram, loop->queue_wait_histogram, sizeof(stats->queue_wait_histogram));
+    xSemaphoreGive(loop->profiling_mutex);
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t esp_event_loop_get_handler_stats(esp_event_loop_handle_t event_loop, esp_event_handler_stats_t* stats, size_t* count)
+{
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    assert(event_loop);
+
+    if (count == NULL || (stats == NULL && *count != 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+    esp_event_loop_node_t *loop_node_it;
+    esp_event_base_node_t* base_node_it;
+    esp_event_id_node_t* id_node_it;
+    esp_event_handler_node_t* handler_it;
+    size_t capacity = *count;
+    size_t found = 0;
+
+    // The loop mutex keeps the handler lists stable, the profiling mutex the counters of the handlers
+    xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
+    xSemaphoreTake(loop->profiling_mutex, portMAX_DELAY);
+
+    SLIST_FOREACH(loop_node_it, &(loop->loop_nodes), next) {
+        SLIST_FOREACH(handler_it, &(loop_node_it->handlers), next) {
+            handler_stats_add(stats, capacity, &found, handler_it, ESP_EVENT_ANY_BASE, ESP_EVENT_ANY_ID);
+        }
+
+        SLIST_FOREACH(base_node_it, &(loop_node_it->base_nodes), next) {
+            SLIST_FOREACH(handler_it, &(base_node_it->handlers), next) {
+                handler_stats_add(stats, capacity, &found, handler_it, base_node_it->base, ESP_EVENT_ANY_ID);
+            }
+
+            SLIST_FOREACH(id_node_it, &(base_node_it->id_nodes), next) {
+                SLIST_FOREACH(handler_it, &(id_node_it->handlers), next) {
+                    handler_stats_add(stats, capacity, &found, handler_it, base_node_it->base, id_node_it->id);
+                }
+            }
+        }
+    }
+
+    xSemaphoreGive(loop->profiling_mutex);
+    xSemaphoreGiveRecursive(loop->mutex);
+
+    *count = found;
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t esp_event_loop_reset_stats(esp_event_loop_handle_t event_loop)
+{
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    assert(event_loop);
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+    esp_event_loop_node_t *loop_node_it;
+    esp_event_base_node_t* base_node_it;
+    esp_event_id_node_t* id_node_it;
+    esp_event_handler_node_t* handler_it;
+
+    xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
+    xSemaphoreTake(loop->profiling_mutex, portMAX_DELAY);
+
+    atomic_store(&loop->events_recieved, 0);
+    atomic_store(&loop->events_dropped, 0);
+    loop->events_dispatched = 0;
+    loop->queue_wait_total = 0;
+    loop->queue_wait_max = 0;
+    memset(loop->queue_wait_histogram, 0, sizeof(loop->queue_wait_histogram));
+
+    SLIST_FOREACH(loop_node_it, &(loop->loop_nodes), next) {
+        SLIST_FOREACH(handler_it, &(loop_node_it->handlers), next) {
+            handler_it->invoked = 0;
+            handler_it->time = 0;
+            handler_it->time_max = 0;
+        }
+
+        SLIST_FOREACH(base_node_it, &(loop_node_it->base_nodes), next) {
+            SLIST_FOREACH(handler_it, &(base_node_it->handlers), next) {
+                handler_it->invoked = 0;
+                handler_it->time = 0;
+                handler_it->time_max = 0;
+            }
+
+            SLIST_FOREACH(id_node_it, &(base_node_it->id_nodes), next) {
+                SLIST_FOREACH(handler_it, &(id_node_it->handlers), next) {
+                    handler_it->invoked = 0;
+                    handler_it->time = 0;
+                    handler_it->time_max = 0;
+                }
+            }
+        }
+    }
+
+    xSemaphoreGive(loop->profiling_mutex);
+    xSemaphoreGiveRecursive(loop->mutex);
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
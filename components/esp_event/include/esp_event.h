@@ -29,18 +29,29 @@ typedef struct {
     uint32_t task_stack_size;                   /**< stack size of the event loop task, ignored if task name is NULL */
     BaseType_t task_core_id;                    /**< core to which the event loop task is pinned to,
                                                         ignored if task name is NULL */
+    size_t data_pool_slot_size;                 /**< size of the slots of the event data pool; data of posted events
+                                                        which fits a slot is copied to the pool instead of the heap.
+                                                        If 0, the loop has no event data pool */
+    size_t data_pool_slot_count;                /**< number of slots of the event data pool,
+                                                        ignored if data_pool_slot_size is 0 */
 } esp_event_loop_args_t;
 
 /**
  * @brief Create a new event loop.
  *
+ * If the event data pool is configured in event_loop_args, its slots are allocated together with the loop.
+ * Event data posted to the loop which fits a slot is then copied to a free slot, so neither posting nor
+ * dispatching such an event allocates memory from the heap. Data which doesn't fit a slot, or is posted while
+ * all slots are in use, is still copied to the heap. As each event waiting in the queue and the event being
+ * dispatched take one slot, a pool with one slot more than the queue size never runs out of slots.
+ *
  * @param[in] event_loop_args configuration structure for the event loop to create
  * @param[out] event_loop handle to the created event loop
  *
  * @return
  *  - ESP_OK: Success
- *  - ESP_ERR_INVALID_ARG: event_loop_args or event_loop was NULL
- *  - ESP_ERR_NO_MEM: Cannot allocate memory for event loops list
+ *  - ESP_ERR_INVALID_ARG: event_loop_args or event_loop was NULL, or the event data pool has no slots
+ *  - ESP_ERR_NO_MEM: Cannot allocate memory for event loops list or the event data pool
  *  - ESP_FAIL: Failed to create task loop
  *  - Others: Fail
  */
@@ -431,7 +442,8 @@ esp_err_t esp_event_isr_post(esp_event_base_t event_base,
  * @param[in] event_base the event base that identifies the event
  * @param[in] event_id the event ID that identifies the event
  * @param[in] event_data the data, specific to the event occurrence, that gets passed to the handler
- * @param[in] event_data_size the size of the event data
+ * @param[in] event_data_size the size of the event data; max is 4 bytes, or the slot size of the event data pool of
+ *                            the loop
  * @param[out] task_unblocked an optional parameter (can be NULL) which indicates that an event task with
  *                            higher priority than currently running task has been unblocked by the posted event;
  *                            a context switch should be requested before the interrupt is existed.
@@ -442,9 +454,9 @@ esp_err_t esp_event_isr_post(esp_event_base_t event_base,
  *
  * @return
  *  - ESP_OK: Success
- *  - ESP_FAIL: Event queue for the loop full
+ *  - ESP_FAIL: Event queue for the loop full, or no free slot in its event data pool
  *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event ID,
- *                          data size of more than 4 bytes
+ *                          data size of more than 4 bytes which doesn't fit a slot of the event data pool
  *  - Others: Fail
  */
 esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop,
@@ -455,6 +467,141 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop,
                                 BaseType_t *task_unblocked);
 #endif
 
+#if CONFIG_ESP_EVENT_POST_BY_REFERENCE
+/**
+ * @brief Function called to give the data of an event posted by reference back to its owner
+ *
+ * @param[in] event_data the data passed when posting the event
+ * @param[in] release_arg the argument passed when posting the event
+ */
+typedef void (*esp_event_data_release_t)(void *event_data, void *release_arg);
+
+/**
+ * @brief Posts an event to the system default event loop without copying its data.
+ *
+ * The handlers receive event_data itself. The caller must keep the data valid and unchanged until release
+ * is called, which happens after all handlers of the event have been executed, or when the event is dropped
+ * because the loop is deleted. If the event can't be posted, release is not called and the caller keeps the data.
+ *
+ * @param[in] event_base the event base that identifies the event
+ * @param[in] event_id the event ID that identifies the event
+ * @param[in] event_data the data, specific to the event occurrence, that gets passed to the handler, must not be NULL
+ * @param[in] release function called with event_data and release_arg once the data isn't used anymore, must not be NULL
+ * @param[in] release_arg argument passed to release
+ * @param[in] ticks_to_wait number of ticks to block on a full event queue
+ *
+ * @note this function is only available when CONFIG_ESP_EVENT_POST_BY_REFERENCE is enabled
+ * @note release is called from the task running the event loop, or from the task deleting it
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_TIMEOUT: Time to wait for event queue to unblock expired
+ *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event ID, event_data or release is NULL
+ *  - Others: Fail
+ */
+esp_err_t esp_event_post_by_ref(esp_event_base_t event_base,
+                                int32_t event_id,
+                                void *event_data,
+                                esp_event_data_release_t release,
+                                void *release_arg,
+                                TickType_t ticks_to_wait);
+
+/**
+ * @brief Posts an event to the specified event loop without copying its data.
+ *
+ * This function behaves in the same manner as esp_event_post_by_ref, except the additional specification of the
+ * event loop to post the event to.
+ *
+ * @param[in] event_loop the event loop to post to, must not be NULL
+ * @param[in] event_base the event base that identifies the event
+ * @param[in] event_id the event ID that identifies the event
+ * @param[in] event_data the data, specific to the event occurrence, that gets passed to the handler, must not be NULL
+ * @param[in] release function called with event_data and release_arg once the data isn't used anymore, must not be NULL
+ * @param[in] release_arg argument passed to release
+ * @param[in] ticks_to_wait number of ticks to block on a full event queue
+ *
+ * @note this function is only available when CONFIG_ESP_EVENT_POST_BY_REFERENCE is enabled
+ * @note release is called from the task running the event loop, or from the task deleting it
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_TIMEOUT: Time to wait for event queue to unblock expired
+ *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event ID, event_data or release is NULL
+ *  - Others: Fail
+ */
+esp_err_t esp_event_post_by_ref_to(esp_event_loop_handle_t event_loop,
+                                   esp_event_base_t event_base,
+                                   int32_t event_id,
+                                   void *event_data,
+                                   esp_event_data_release_t release,
+                                   void *release_arg,
+                                   TickType_t ticks_to_wait);
+
+#if CONFIG_ESP_EVENT_POST_FROM_ISR
+/**
+ * @brief Special variant of esp_event_post_by_ref for posting events from interrupt handlers.
+ *
+ * @param[in] event_base the event base that identifies the event
+ * @param[in] event_id the event ID that identifies the event
+ * @param[in] event_data the data, specific to the event occurrence, that gets passed to the handler, must not be NULL
+ * @param[in] release function called with event_data and release_arg once the data isn't used anymore, must not be NULL
+ * @param[in] release_arg argument passed to release
+ * @param[out] task_unblocked an optional parameter (can be NULL) which indicates that an event task with
+ *                            higher priority than currently running task has been unblocked by the posted event;
+ *                            a context switch should be requested before the interrupt is existed.
+ *
+ * @note this function is only available when CONFIG_ESP_EVENT_POST_BY_REFERENCE and CONFIG_ESP_EVENT_POST_FROM_ISR
+ *       are enabled
+ * @note when this function is called from an interrupt handler placed in IRAM, this function should
+ *       be placed in IRAM as well by enabling CONFIG_ESP_EVENT_POST_FROM_IRAM_ISR
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_FAIL: Event queue for the default event loop full
+ *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event ID, event_data or release is NULL
+ *  - Others: Fail
+ */
+esp_err_t esp_event_isr_post_by_ref(esp_event_base_t event_base,
+                                    int32_t event_id,
+                                    void *event_data,
+                                    esp_event_data_release_t release,
+                                    void *release_arg,
+                                    BaseType_t *task_unblocked);
+
+/**
+ * @brief Special variant of esp_event_post_by_ref_to for posting events from interrupt handlers
+ *
+ * @param[in] event_loop the event loop to post to, must not be NULL
+ * @param[in] event_base the event base that identifies the event
+ * @param[in] event_id the event ID that identifies the event
+ * @param[in] event_data the data, specific to the event occurrence, that gets passed to the handler, must not be NULL
+ * @param[in] release function called with event_data and release_arg once the data isn't used anymore, must not be NULL
+ * @param[in] release_arg argument passed to release
+ * @param[out] task_unblocked an optional parameter (can be NULL) which indicates that an event task with
+ *                            higher priority than currently running task has been unblocked by the posted event;
+ *                            a context switch should be requested before the interrupt is existed.
+ *
+ * @note this function is only available when CONFIG_ESP_EVENT_POST_BY_REFERENCE and CONFIG_ESP_EVENT_POST_FROM_ISR
+ *       are enabled
+ * @note when this function is called from an interrupt handler placed in IRAM, this function should
+ *       be placed in IRAM as well by enabling CONFIG_ESP_EVENT_POST_FROM_IRAM_ISR
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_FAIL: Event queue for the loop full
+ *  - ESP_ERR_INVALID_ARG: Invalid combination of event base and event ID, event_data or release is NULL
+ *  - Others: Fail
+ */
+esp_err_t esp_event_isr_post_by_ref_to(esp_event_loop_handle_t event_loop,
+                                       esp_event_base_t event_base,
+                                       int32_t event_id,
+                                       void *event_data,
+                                       esp_event_data_release_t release,
+                                       void *release_arg,
+                                       BaseType_t *task_unblocked);
+#endif // CONFIG_ESP_EVENT_POST_FROM_ISR
+#endif // CONFIG_ESP_EVENT_POST_BY_REFERENCE
+
 /**
  * @brief Dumps statistics of all event loops.
  *
@@ -501,6 +648,115 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop,
  */
 esp_err_t esp_event_dump(FILE *file);
 
+/// Number of buckets of the queue wait histogram of an event loop
+#define ESP_EVENT_LOOP_QUEUE_WAIT_BUCKETS   7
+
+/// Statistics of an event loop
+typedef struct {
+    uint32_t events_received;                   /**< number of events successfully posted to the loop */
+    uint32_t events_dropped;                    /**< number of events dropped due to the queue or the event data pool
+                                                        being full */
+    uint32_t events_dispatched;                 /**< number of events taken from the queue and dispatched */
+    int64_t queue_wait_total;                   /**< total time the dispatched events waited in the queue, in us */
+    int64_t queue_wait_max;                     /**< longest time a dispatched event waited in the queue, in us */
+    uint32_t queue_wait_histogram[ESP_EVENT_LOOP_QUEUE_WAIT_BUCKETS]; /**< number of dispatched events by time waited
+                                                        in the queue: bucket 0 counts waits under 10 us, each next
+                                                        bucket ten times longer waits, and the last one waits of 1 s
+                                                        or more */
+} esp_event_loop_stats_t;
+
+/// Statistics of an event handler registered to an event loop
+typedef struct {
+    esp_event_handler_t handler;                /**< the handler function */
+    void *handler_arg;                          /**< argument the handler is registered with */
+    esp_event_base_t event_base;                /**< base the handler is registered for, ESP_EVENT_ANY_BASE for
+                                                        handlers of all events of the loop */
+    int32_t event_id;                           /**< ID the handler is registered for, ESP_EVENT_ANY_ID for
+                                                        handlers of all events of the base */
+    uint32_t invoked;                           /**< number of times the handler has been invoked */
+    int64_t time_total;                         /**< total run time of the handler across all calls, in us */
+    int64_t time_max;                           /**< longest run time of a single call, in us */
+} esp_event_handler_stats_t;
+
+/**
+ * @brief Get the statistics of an event loop
+ *
+ * The average queue wait is queue_wait_total divided by events_dispatched.
+ *
+ * @param[in] event_loop the event loop
+ * @param[out] stats statistics of the loop
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: stats is NULL
+ *  - ESP_ERR_NOT_SUPPORTED: CONFIG_ESP_EVENT_LOOP_PROFILING is disabled
+ */
+esp_err_t esp_event_loop_get_stats(esp_event_loop_handle_t event_loop, esp_event_loop_stats_t *stats);
+
+/**
+ * @brief Get the statistics of the handlers registered to an event loop
+ *
+ * Handlers are reported in the order of esp_event_dump. The average run time of a handler is time_total divided
+ * by invoked.
+ *
+ * @param[in] event_loop the event loop
+ * @param[out] stats array receiving the statistics of the handlers, may be NULL if *count is 0
+ * @param[inout] count on input, the number of elements of stats; on output, the number of handlers registered
+ *                     to the loop, which may be larger than the number of elements filled
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: count is NULL, or stats is NULL while *count is not 0
+ *  - ESP_ERR_NOT_SUPPORTED: CONFIG_ESP_EVENT_LOOP_PROFILING is disabled
+ */
+esp_err_t esp_event_loop_get_handler_stats(esp_event_loop_handle_t event_loop, esp_event_handler_stats_t *stats, size_t *count);
+
+/**
+ * @brief Reset the statistics of an event loop and of its handlers
+ *
+ * @param[in] event_loop the event loop
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_NOT_SUPPORTED: CONFIG_ESP_EVENT_LOOP_PROFILING is disabled
+ */
+esp_err_t esp_event_loop_reset_stats(esp_event_loop_handle_t event_loop);
+
+/**
+ * @brief Get the statistics of the default event loop
+ *
+ * @param[out] stats statistics of the default loop
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_STATE: The default event loop has not been created
+ *  - Others: See esp_event_loop_get_stats
+ */
+esp_err_t esp_event_get_stats(esp_event_loop_stats_t *stats);
+
+/**
+ * @brief Get the statistics of the handlers registered to the default event loop
+ *
+ * @param[out] stats array receiving the statistics of the handlers
+ * @param[inout] count number of elements of stats on input, number of registered handlers on output
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_STATE: The default event loop has not been created
+ *  - Others: See esp_event_loop_get_handler_stats
+ */
+esp_err_t esp_event_get_handler_stats(esp_event_handler_stats_t *stats, size_t *count);
+
+/**
+ * @brief Reset the statistics of the default event loop and of its handlers
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_STATE: The default event loop has not been created
+ *  - Others: See esp_event_loop_reset_stats
+ */
+esp_err_t esp_event_reset_stats(void);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -29,6 +29,12 @@ typedef struct esp_event_handler_node {
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     uint32_t invoked;                                               /**< number of times this handler has been invoked */
     int64_t time;                                                   /**< total runtime of this handler across all calls */
+    int64_t time_max;                                               /**< longest runtime of a single call */
+#endif
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+    bool removed;                                                   /**< handler has been unregistered while the loop
+                                                                            was dispatching an event */
+    SLIST_ENTRY(esp_event_handler_node) removed_next;           /**< next handler unregistered while dispatching */
 #endif
     SLIST_ENTRY(esp_event_handler_node) next;                   /**< next event handler in the list */
 } esp_event_handler_node_t;
@@ -65,6 +71,24 @@ typedef struct esp_event_loop_node {
 
 typedef SLIST_HEAD(esp_event_loop_nodes, esp_event_loop_node) esp_event_loop_nodes_t;
 
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+/// Handlers to execute for one event, in dispatch order
+typedef struct esp_event_dispatch_entry {
+    esp_event_base_t base;                                          /**< base identifier of the event */
+    int32_t id;                                                     /**< id number of the event */
+    size_t handler_count;                                           /**< number of handlers to execute */
+    SLIST_ENTRY(esp_event_dispatch_entry) next;                     /**< next entry in the same bucket */
+    esp_event_handler_node_t* handlers[];                           /**< handlers to execute */
+} esp_event_dispatch_entry_t;
+
+typedef SLIST_HEAD(esp_event_dispatch_entries, esp_event_dispatch_entry) esp_event_dispatch_entries_t;
+#endif
+
+/// Free slot of an event data pool
+typedef struct esp_event_data_slot {
+    struct esp_event_data_slot* next;                               /**< next free slot */
+} esp_event_data_slot_t;
+
 /// Event loop
 typedef struct esp_event_loop_instance {
     const char* name;                                               /**< name of this event loop */
@@ -75,9 +99,28 @@ typedef struct esp_event_loop_instance {
     SemaphoreHandle_t mutex;                                        /**< mutex for updating the events linked list */
     esp_event_loop_nodes_t loop_nodes;                              /**< set of linked lists containing the
                                                                             registered handlers for the loop */
+    uint8_t* data_pool;                                             /**< storage of the event data pool, NULL if the
+                                                                            loop has none */
+    size_t data_pool_slot_size;                                     /**< size of each slot of the event data pool */
+    esp_event_data_slot_t* data_pool_free;                          /**< list of free slots of the event data pool */
+    portMUX_TYPE data_pool_lock;                                    /**< spinlock protecting the list of free slots */
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+    esp_event_dispatch_entries_t dispatch_table[CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE_SIZE]; /**< hash table of
+                                                                            handlers to execute per event */
+    size_t dispatch_entries;                                        /**< number of entries in the dispatch table */
+    uint32_t dispatch_depth;                                        /**< number of events currently being dispatched */
+    bool dispatch_table_stale;                                      /**< handlers changed while dispatching, the table
+                                                                            is cleared once dispatching is done */
+    esp_event_handler_nodes_t removed_handlers;                     /**< handlers unregistered while dispatching,
+                                                                            freed once dispatching is done */
+#endif
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     atomic_uint_least32_t events_recieved;                          /**< number of events successfully posted to the loop */
     atomic_uint_least32_t events_dropped;                           /**< number of events dropped due to queue being full */
+    uint32_t events_dispatched;                                     /**< number of events taken from the queue */
+    int64_t queue_wait_total;                                       /**< total time events waited in the queue */
+    int64_t queue_wait_max;                                         /**< longest time an event waited in the queue */
+    uint32_t queue_wait_histogram[ESP_EVENT_LOOP_QUEUE_WAIT_BUCKETS]; /**< events by time waited in the queue */
     SemaphoreHandle_t profiling_mutex;                              /**< mutex used for profiliing */
     SLIST_ENTRY(esp_event_loop_instance) next;                      /**< next event loop in the list */
 #endif
@@ -95,12 +138,23 @@ typedef void* esp_event_post_data_t;
 /// Event posted to the event queue
 typedef struct esp_event_post_instance {
 #if CONFIG_ESP_EVENT_POST_FROM_ISR
-    bool data_allocated;                                             /**< indicates whether data is allocated from heap */
+    bool data_allocated;                                             /**< indicates whether data is stored outside of
+                                                                            the post, i.e. data.ptr is used */
     bool data_set;                                                   /**< indicates if data is null */
 #endif
+    bool data_pooled;                                                /**< indicates whether data is stored in a slot of
+                                                                            the loop's event data pool */
     esp_event_base_t base;                                           /**< the event base */
     int32_t id;                                                      /**< the event id */
     esp_event_post_data_t data;                                      /**< data associated with the event */
+#if CONFIG_ESP_EVENT_POST_BY_REFERENCE
+    esp_event_data_release_t release;                                /**< function giving data posted by reference back
+                                                                            to its owner, NULL if data is owned by the loop */
+    void* release_arg;                                               /**< argument of the release function */
+#endif
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    int64_t post_time;                                               /**< time the event was posted, in us */
+#endif
 } esp_event_post_instance_t;
 
 #ifdef __cplusplus
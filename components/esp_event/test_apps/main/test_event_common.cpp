@@ -897,6 +897,97 @@ TEST_CASE("handler instance can unregister itself", "[event][linux]")
     TEST_ASSERT_EQUAL(1, test_data.count);
 }
 
+TEST_CASE("handlers registered and unregistered between posts are dispatched correctly", "[event][linux]")
+{
+    EV_LoopFix loop_fix;
+    int base_count = 0;
+    int id_count = 0;
+
+    TEST_ESP_OK(esp_event_handler_register_with(loop_fix.loop,
+                                                s_test_base1,
+                                                TEST_EVENT_BASE1_EV1,
+                                                test_handler_inc,
+                                                &id_count));
+
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, portMAX_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+
+    TEST_ASSERT_EQUAL(0, base_count);
+    TEST_ASSERT_EQUAL(1, id_count);
+
+    TEST_ESP_OK(esp_event_handler_register_with(loop_fix.loop,
+                                                s_test_base1,
+                                                ESP_EVENT_ANY_ID,
+                                                test_handler_inc,
+                                                &base_count));
+
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, portMAX_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV2, NULL, 0, portMAX_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+
+    TEST_ASSERT_EQUAL(2, base_count);
+    TEST_ASSERT_EQUAL(2, id_count);
+
+    TEST_ESP_OK(esp_event_handler_unregister_with(loop_fix.loop,
+                                                  s_test_base1,
+                                                  TEST_EVENT_BASE1_EV1,
+                                                  test_handler_inc));
+
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, portMAX_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+
+    TEST_ASSERT_EQUAL(3, base_count);
+    TEST_ASSERT_EQUAL(2, id_count);
+}
+
+#if CONFIG_ESP_EVENT_LOOP_DISPATCH_TABLE
+static void test_handler_unregister_other(void* event_handler_arg,
+                                          esp_event_base_t event_base,
+                                          int32_t event_id,
+                                          void* event_data)
+{
+    unregister_test_data_t *test_data = (unregister_test_data_t*) event_handler_arg;
+
+    (test_data->count)++;
+
+    // Unregister the handler registered after this one for the same event
+    TEST_ESP_OK(esp_event_handler_unregister_with(test_data->loop,
+                                                  event_base,
+                                                  event_id,
+                                                  test_handler_inc));
+}
+
+TEST_CASE("handler unregistered by previous handler of the same event is not executed", "[event][linux]")
+{
+    EV_LoopFix loop_fix;
+    int count = 0;
+
+    unregister_test_data_t test_data = {
+        .context = NULL,
+        .loop = loop_fix.loop,
+        .count = 0,
+    };
+
+    TEST_ESP_OK(esp_event_handler_register_with(loop_fix.loop,
+                                                s_test_base1,
+                                                TEST_EVENT_BASE1_EV1,
+                                                test_handler_unregister_other, &test_data));
+    TEST_ESP_OK(esp_event_handler_register_with(loop_fix.loop,
+                                                s_test_base1,
+                                                TEST_EVENT_BASE1_EV1,
+                                                test_handler_inc, &count));
+
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, portMAX_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, portMAX_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+
+    TEST_ASSERT_EQUAL(2, test_data.count);
+    TEST_ASSERT_EQUAL(0, count);
+}
+#endif
+
 typedef struct {
     size_t counter;
     size_t test_data[4];
@@ -1116,6 +1207,63 @@ typedef struct {
     int count;
 } posting_handler_data_t;
 
+TEST_CASE("event loop statistics count posted, dropped and dispatched events", "[event][linux]")
+{
+    EV_LoopFix loop_fix(2);
+    int count = 0;
+    esp_event_loop_stats_t stats;
+    esp_event_handler_stats_t handler_stats[2];
+    size_t handler_count = 2;
+
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    TEST_ESP_OK(esp_event_handler_register_with(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, test_handler_inc, &count));
+
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, ZERO_DELAY));
+    // The queue is full
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, ZERO_DELAY));
+    TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+    TEST_ASSERT_EQUAL(2, count);
+
+    TEST_ESP_OK(esp_event_loop_get_stats(loop_fix.loop, &stats));
+    TEST_ASSERT_EQUAL(2, stats.events_received);
+    TEST_ASSERT_EQUAL(1, stats.events_dropped);
+    TEST_ASSERT_EQUAL(2, stats.events_dispatched);
+    TEST_ASSERT_GREATER_OR_EQUAL(stats.queue_wait_max, stats.queue_wait_total);
+    uint32_t histogram_total = 0;
+    for (int i = 0; i < ESP_EVENT_LOOP_QUEUE_WAIT_BUCKETS; i++) {
+        histogram_total += stats.queue_wait_histogram[i];
+    }
+    TEST_ASSERT_EQUAL(2, histogram_total);
+
+    // Query the number of handlers only
+    size_t needed = 0;
+    TEST_ESP_OK(esp_event_loop_get_handler_stats(loop_fix.loop, NULL, &needed));
+    TEST_ASSERT_EQUAL(1, needed);
+
+    TEST_ESP_OK(esp_event_loop_get_handler_stats(loop_fix.loop, handler_stats, &handler_count));
+    TEST_ASSERT_EQUAL(1, handler_count);
+    TEST_ASSERT_EQUAL_PTR(test_handler_inc, handler_stats[0].handler);
+    TEST_ASSERT_EQUAL_PTR(&count, handler_stats[0].handler_arg);
+    TEST_ASSERT_EQUAL_PTR(s_test_base1, handler_stats[0].event_base);
+    TEST_ASSERT_EQUAL(TEST_EVENT_BASE1_EV1, handler_stats[0].event_id);
+    TEST_ASSERT_EQUAL(2, handler_stats[0].invoked);
+    TEST_ASSERT_GREATER_OR_EQUAL(handler_stats[0].time_max, handler_stats[0].time_total);
+
+    TEST_ESP_OK(esp_event_loop_reset_stats(loop_fix.loop));
+    TEST_ESP_OK(esp_event_loop_get_stats(loop_fix.loop, &stats));
+    TEST_ASSERT_EQUAL(0, stats.events_received);
+    TEST_ASSERT_EQUAL(0, stats.events_dropped);
+    TEST_ASSERT_EQUAL(0, stats.events_dispatched);
+    TEST_ESP_OK(esp_event_loop_get_handler_stats(loop_fix.loop, handler_stats, &handler_count));
+    TEST_ASSERT_EQUAL(0, handler_stats[0].invoked);
+#else
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_event_loop_get_stats(loop_fix.loop, &stats));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_event_loop_get_handler_stats(loop_fix.loop, handler_stats, &handler_count));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_event_loop_reset_stats(loop_fix.loop));
+#endif
+}
+
 static void test_handler_post(void* handler_arg, esp_event_base_t base, int32_t id, void* event_arg)
 {
     posting_handler_data_t* data = (posting_handler_data_t*) handler_arg;
@@ -1532,6 +1680,129 @@ TEST_CASE("event data many bytes are copied on post", "[event][linux]")
     TEST_ASSERT_EQUAL_HEX8_ARRAY(ev_data_expected, saved_ev_data.event_data, EventData::MAX_SIZE);
 }
 
+TEST_CASE("event data is copied on post to loop with event data pool", "[event][linux]")
+{
+    esp_event_loop_handle_t loop;
+    esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+    loop_args.task_name = NULL;
+    loop_args.data_pool_slot_size = 8;
+    loop_args.data_pool_slot_count = 2;
+    TEST_ESP_OK(esp_event_loop_create(&loop_args, &loop));
+
+    uint8_t ev_data[EventData::MAX_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    EventData saved_ev_data(8);
+
+    TEST_ESP_OK(esp_event_handler_register_with(loop,
+                                                s_test_base1,
+                                                TEST_EVENT_BASE1_EV1,
+                                                save_ev_data,
+                                                &saved_ev_data));
+
+    // The third post finds no free slot and the last one doesn't fit a slot, both are copied to heap instead
+    for (int i = 0; i < 4; i++) {
+        TEST_ESP_OK(esp_event_post_to(loop,
+                                      s_test_base1,
+                                      TEST_EVENT_BASE1_EV1,
+                                      &ev_data[i],
+                                      i < 3 ? 8 : EventData::MAX_SIZE - i,
+                                      portMAX_DELAY));
+    }
+
+    for (int i = 0; i < 4; i++) {
+        memset(saved_ev_data.event_data, 0, sizeof(saved_ev_data.event_data));
+        TEST_ESP_OK(esp_event_loop_run(loop, ZERO_DELAY));
+        TEST_ASSERT_NOT_EQUAL(NULL, saved_ev_data.event_arg);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(&ev_data[i], saved_ev_data.event_data, 8);
+    }
+
+    TEST_ESP_OK(esp_event_loop_delete(loop));
+}
+
+TEST_CASE("creating loop with empty event data pool fails", "[event][linux]")
+{
+    esp_event_loop_handle_t loop;
+    esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+    loop_args.data_pool_slot_size = 8;
+    loop_args.data_pool_slot_count = 0;
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_event_loop_create(&loop_args, &loop));
+}
+
+#if CONFIG_ESP_EVENT_POST_BY_REFERENCE
+typedef struct {
+    void* data;
+    int count;
+} release_test_data_t;
+
+static void test_release_data(void* event_data, void* release_arg)
+{
+    release_test_data_t* test_data = (release_test_data_t*) release_arg;
+    test_data->data = event_data;
+    (test_data->count)++;
+}
+
+TEST_CASE("event data posted by reference is not copied and released after dispatch", "[event][linux]")
+{
+    EV_LoopFix loop_fix;
+    uint8_t ev_data[EventData::MAX_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    EventData saved_ev_data(EventData::MAX_SIZE);
+    release_test_data_t release_data = { };
+
+    TEST_ESP_OK(esp_event_handler_register_with(loop_fix.loop,
+                                                s_test_base1,
+                                                TEST_EVENT_BASE1_EV1,
+                                                save_ev_data,
+                                                &saved_ev_data));
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_event_post_by_ref_to(loop_fix.loop,
+                                                                    s_test_base1,
+                                                                    TEST_EVENT_BASE1_EV1,
+                                                                    ev_data,
+                                                                    NULL,
+                                                                    NULL,
+                                                                    portMAX_DELAY));
+
+    TEST_ESP_OK(esp_event_post_by_ref_to(loop_fix.loop,
+                                         s_test_base1,
+                                         TEST_EVENT_BASE1_EV1,
+                                         ev_data,
+                                         test_release_data,
+                                         &release_data,
+                                         portMAX_DELAY));
+    TEST_ASSERT_EQUAL(0, release_data.count);
+
+    TEST_ESP_OK(esp_event_loop_run(loop_fix.loop, ZERO_DELAY));
+
+    TEST_ASSERT_EQUAL_PTR(ev_data, saved_ev_data.event_arg);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(ev_data, saved_ev_data.event_data, EventData::MAX_SIZE);
+    TEST_ASSERT_EQUAL(1, release_data.count);
+    TEST_ASSERT_EQUAL_PTR(ev_data, release_data.data);
+}
+
+TEST_CASE("event data posted by reference is released when loop is deleted", "[event][linux]")
+{
+    esp_event_loop_handle_t loop;
+    esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+    loop_args.task_name = NULL;
+    TEST_ESP_OK(esp_event_loop_create(&loop_args, &loop));
+
+    uint8_t ev_data = 47;
+    release_test_data_t release_data = { };
+
+    TEST_ESP_OK(esp_event_post_by_ref_to(loop,
+                                         s_test_base1,
+                                         TEST_EVENT_BASE1_EV1,
+                                         &ev_data,
+                                         test_release_data,
+                                         &release_data,
+                                         portMAX_DELAY));
+    TEST_ESP_OK(esp_event_loop_delete(loop));
+
+    TEST_ASSERT_EQUAL(1, release_data.count);
+    TEST_ASSERT_EQUAL_PTR(&ev_data, release_data.data);
+}
+#endif
+
 TEST_CASE("default loop: registering fails on uninitialized default loop", "[event][default][linux]")
 {
     esp_event_handler_instance_t instance;
@@ -692,6 +692,42 @@ TEST_CASE("data posted from ISR is correctly set internally", "[event][intr]")
     vTaskDelay(pdMS_TO_TICKS(TEST_CONFIG_TEARDOWN_WAIT));
 }
 
+TEST_CASE("data posted to loop with event data pool is stored in the pool", "[event][intr]")
+{
+    esp_event_loop_handle_t loop;
+    esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+
+    loop_args.task_name = NULL;
+    loop_args.data_pool_slot_size = sizeof(uint64_t);
+    loop_args.data_pool_slot_count = 1;
+    TEST_ESP_OK(esp_event_loop_create(&loop_args, &loop));
+
+    esp_event_post_instance_t post;
+    esp_event_loop_instance_t* loop_def = (esp_event_loop_instance_t*) loop;
+    uint64_t sample = 0x0123456789abcdefULL;
+
+    TEST_ESP_OK(esp_event_isr_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV1, &sample, sizeof(sample), NULL));
+    TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(loop_def->queue, &post, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(true, post.data_set);
+    TEST_ASSERT_EQUAL(true, post.data_allocated);
+    TEST_ASSERT_EQUAL(true, post.data_pooled);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&sample, post.data.ptr, sizeof(sample));
+
+    // The only slot is still taken by the received post
+    TEST_ASSERT_EQUAL(ESP_FAIL, esp_event_isr_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV1, &sample, sizeof(sample), NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_event_isr_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV1, &sample, sizeof(sample) + 1, NULL));
+
+    // Posting from a task falls back to heap
+    TEST_ESP_OK(esp_event_post_to(loop, s_test_base1, TEST_EVENT_BASE1_EV1, &sample, sizeof(sample), portMAX_DELAY));
+
+    // Give the slot back by putting the post back into the queue, the loop frees it on deletion
+    TEST_ASSERT_EQUAL(pdTRUE, xQueueSendToBack(loop_def->queue, &post, 0));
+
+    TEST_ESP_OK(esp_event_loop_delete(loop));
+
+    vTaskDelay(pdMS_TO_TICKS(TEST_CONFIG_TEARDOWN_WAIT));
+}
+
 static void test_handler_post_from_isr(void* event_handler_arg, esp_event_base_t event_base, int32_t event_id, void* event_data)
 {
     SemaphoreHandle_t *sem = (SemaphoreHandle_t*) event_handler_arg;
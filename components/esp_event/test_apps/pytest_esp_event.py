@@ -1,4 +1,4 @@
-# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: CC0-1.0
 import pytest
 from pytest_embedded import Dut
@@ -8,6 +8,11 @@ from pytest_embedded import Dut
 @pytest.mark.esp32s2
 @pytest.mark.esp32c3
 @pytest.mark.generic
+@pytest.mark.parametrize('config', [
+    'default',
+    'dispatch_table',
+    'post_by_ref',
+])
 def test_esp_event(dut: Dut) -> None:
     dut.run_all_single_board_cases()
 
@@ -17,6 +17,8 @@
 #include "esp_transport_tcp.h"
 #include "http_utils.h"
 #include "http_auth.h"
+#include "http_pool.h"
+#include "http_decode.h"
 #include "sdkconfig.h"
 #include "esp_http_client.h"
 #include "errno.h"
@@ -64,6 +66,9 @@ typedef struct {
     int64_t             data_process;   /*!< data processed */
     int                 method;         /*!< http method */
     bool                is_chunked;
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+    http_content_encoding_t content_encoding; /*!< Content coding of the response body, if it's decoded */
+#endif
 } esp_http_data_t;
 
 typedef struct {
@@ -142,6 +147,15 @@ struct esp_http_client {
 #ifdef CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
     session_ticket_state_t      session_ticket_state;
 #endif
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    bool                        use_connection_pool;
+    http_pool_key_t             pool_key;
+#endif
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+    bool                        decompress_response;
+    bool                        decode_started;
+    http_decoder_handle_t       decoder;
+#endif
 };
 
 typedef struct esp_http_client esp_http_client_t;
@@ -221,6 +235,10 @@ static int http_on_message_begin(http_parser *parser)
 
     client->response->is_chunked = false;
     client->is_chunk_complete = false;
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+    client->response->content_encoding = HTTP_CONTENT_ENCODING_IDENTITY;
+    client->decode_started = false;
+#endif
     return 0;
 }
 
@@ -239,6 +257,15 @@ static int http_on_header_event(esp_http_client_handle_t client)
 {
     if (client->current_header_key != NULL && client->current_header_value != NULL) {
         ESP_LOGD(TAG, "HEADER=%s:%s", client->current_header_key, client->current_header_value);
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+        if (client->decompress_response && strcasecmp(client->current_header_key, "Content-Encoding") == 0) {
+            if (strcasecmp(client->current_header_value, "gzip") == 0 || strcasecmp(client->current_header_value, "x-gzip") == 0) {
+                client->response->content_encoding = HTTP_CONTENT_ENCODING_GZIP;
+            } else if (strcasecmp(client->current_header_value, "deflate") == 0) {
+                client->response->content_encoding = HTTP_CONTENT_ENCODING_DEFLATE;
+            }
+        }
+#endif
         client->event.header_key = client->current_header_key;
         client->event.header_value = client->current_header_value;
         http_dispatch_event(client, HTTP_EVENT_ON_HEADER, NULL, 0);
@@ -694,6 +721,111 @@ static bool init_common_tcp_transport(esp_http_client_handle_t client, const esp
     return true;
 }
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+static void http_client_pool_init(esp_http_client_handle_t client, const esp_http_client_config_t *config)
+{
+    http_pool_key_t *key = &client->pool_key;
+
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CUSTOM_TRANSPORT
+    if (config->transport) {
+        ESP_LOGW(TAG, "Connection pool is not used with a custom transport");
+        return;
+    }
+#endif
+    client->use_connection_pool = true;
+    memset(key, 0, sizeof(http_pool_key_t));
+    key->cert_pem = config->cert_pem;
+    key->cert_len = config->cert_len;
+    key->client_cert_pem = config->client_cert_pem;
+    key->client_cert_len = config->client_cert_len;
+    key->client_key_pem = config->client_key_pem;
+    key->client_key_len = config->client_key_len;
+    key->client_key_password = config->client_key_password;
+    key->client_key_password_len = config->client_key_password_len;
+    key->common_name = config->common_name;
+    key->crt_bundle_attach = config->crt_bundle_attach;
+    key->tls_version = config->tls_version;
+    key->use_global_ca_store = config->use_global_ca_store;
+    key->skip_cert_common_name_check = config->skip_cert_common_name_check;
+#ifdef CONFIG_MBEDTLS_HARDWARE_ECDSA_SIGN
+    key->use_ecdsa_peripheral = config->use_ecdsa_peripheral;
+    key->ecdsa_key_efuse_blk = config->ecdsa_key_efuse_blk;
+#endif
+#if CONFIG_ESP_TLS_USE_SECURE_ELEMENT
+    key->use_secure_element = config->use_secure_element;
+#endif
+#if CONFIG_ESP_TLS_USE_DS_PERIPHERAL
+    key->ds_data = config->ds_data;
+#endif
+    if (config->if_name) {
+        strlcpy(key->if_name, config->if_name->ifr_name, sizeof(key->if_name));
+    }
+}
+
+/* The transports refer to the keep-alive settings and the interface name of the client they belong to */
+static void http_client_pool_attach_transports(esp_http_client_handle_t client, bool attach)
+{
+    static const char *const schemes[] = { "http", "https" };
+
+    for (int i = 0; i < sizeof(schemes) / sizeof(schemes[0]); i++) {
+        esp_transport_handle_t t = esp_transport_list_get_transport(client->transport_list, schemes[i]);
+        if (t) {
+            esp_transport_tcp_set_keep_alive(t, (attach && client->keep_alive_cfg.keep_alive_enable) ? &client->keep_alive_cfg : NULL);
+            esp_transport_tcp_set_interface_name(t, attach ? client->if_name : NULL);
+        }
+    }
+}
+
+/* Takes over a pooled connection to the server, returns true if it is connected */
+static bool http_client_pool_take(esp_http_client_handle_t client)
+{
+    http_pool_conn_t conn;
+
+    if (http_pool_take(client->connection_info.scheme, client->connection_info.host, client->connection_info.port,
+                       &client->pool_key, &conn) != ESP_OK) {
+        return false;
+    }
+    /* The transports of the client are not connected, they are replaced by the ones of the connection */
+    esp_transport_list_destroy(client->transport_list);
+    client->transport_list = conn.transport_list;
+    client->transport = conn.transport;
+    http_client_pool_attach_transports(client, true);
+    if (conn.connected) {
+        ESP_LOGD(TAG, "Reusing pooled connection to %s:%d", client->connection_info.host, client->connection_info.port);
+        return true;
+    }
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+    ESP_LOGD(TAG, "Resuming pooled TLS session to %s:%d", client->connection_info.host, client->connection_info.port);
+    esp_transport_ssl_session_ticket_operation(client->transport, ESP_TRANSPORT_SESSION_TICKET_USE);
+#endif
+    return false;
+}
+
+/* Parks the connection of the client in the pool if it is idle */
+static void http_client_pool_put(esp_http_client_handle_t client)
+{
+    if (!client->use_connection_pool || client->state != HTTP_STATE_CONNECTED || client->transport == NULL) {
+        return;
+    }
+    http_client_pool_attach_transports(client, false);
+    http_pool_conn_t conn = {
+        .transport_list = client->transport_list,
+        .transport = client->transport,
+        .connected = true,
+    };
+    http_pool_put(client->connection_info.scheme, client->connection_info.host, client->connection_info.port,
+                  &client->pool_key, &conn);
+    client->transport_list = NULL;
+    client->transport = NULL;
+    client->state = HTTP_STATE_UNINIT;
+}
+
+void esp_http_client_pool_flush(void)
+{
+    http_pool_flush();
+}
+#endif // CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+
 esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config)
 {
 
@@ -798,6 +930,12 @@ esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *co
     }
 #endif
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    if (config->use_connection_pool) {
+        http_client_pool_init(client, config);
+    }
+#endif
+
     if (config->client_key_pem) {
         if (!config->client_key_len) {
             esp_transport_ssl_set_client_key_data(ssl, config->client_key_pem, strlen(config->client_key_pem));
@@ -888,6 +1026,16 @@ esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *co
         goto error;
     }
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+    if (config->decompress_response) {
+        client->decompress_response = true;
+        if (esp_http_client_set_header(client, "Accept-Encoding", "gzip, deflate") != ESP_OK) {
+            ESP_LOGE(TAG, "Error while setting default configurations");
+            goto error;
+        }
+    }
+#endif
+
     /* As default behavior, cache data received in fetch header state. This will be
      * used in esp_http_client_read API only. For esp_http_perform we shall disable
      * this as data will be processed by event handler */
@@ -933,6 +1081,10 @@ esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
     if (client == NULL) {
         return ESP_FAIL;
     }
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    /* An idle connection is handed to the pool instead of being closed */
+    http_client_pool_put(client);
+#endif
     esp_http_client_close(client);
     if (client->transport_list) {
         esp_transport_list_destroy(client->transport_list);
@@ -965,6 +1117,9 @@ esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
     free(client->current_header_key);
     free(client->location);
     free(client->auth_header);
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+    http_decoder_destroy(client->decoder);
+#endif
     free(client);
     return ESP_OK;
 }
@@ -1208,7 +1363,7 @@ bool esp_http_client_is_complete_data_received(esp_http_client_handle_t client)
     return true;
 }
 
-int esp_http_client_read(esp_http_client_handle_t client, char *buffer, int len)
+static int http_client_read_raw(esp_http_client_handle_t client, char *buffer, int len)
 {
     esp_http_buffer_t *res_buffer = client->response->buffer;
 
@@ -1292,6 +1447,39 @@ int esp_http_client_read(esp_http_client_handle_t client, char *buffer, int len)
     return ridx;
 }
 
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+static int http_client_decoder_read_cb(void *ctx, char *buffer, int len)
+{
+    return http_client_read_raw((esp_http_client_handle_t)ctx, buffer, len);
+}
+
+static int http_client_read_decoded(esp_http_client_handle_t client, char *buffer, int len)
+{
+    if (!client->decode_started) {
+        if (client->decoder == NULL) {
+            client->decoder = http_decoder_init();
+            if (client->decoder == NULL) {
+                ESP_LOGE(TAG, "Failed to allocate the decoder");
+                return ESP_FAIL;
+            }
+        }
+        http_decoder_reset(client->decoder, client->response->content_encoding);
+        client->decode_started = true;
+    }
+    return http_decoder_read(client->decoder, buffer, len, http_client_decoder_read_cb, client);
+}
+#endif
+
+int esp_http_client_read(esp_http_client_handle_t client, char *buffer, int len)
+{
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+    if (client->response->content_encoding != HTTP_CONTENT_ENCODING_IDENTITY) {
+        return http_client_read_decoded(client, buffer, len);
+    }
+#endif
+    return http_client_read_raw(client, buffer, len);
+}
+
 esp_err_t esp_http_client_perform(esp_http_client_handle_t client)
 {
     esp_err_t err;
@@ -1478,7 +1666,15 @@ static esp_err_t esp_http_client_connect(esp_http_client_handle_t client)
 #endif
             return ESP_ERR_HTTP_INVALID_TRANSPORT;
         }
-        if (!client->is_async) {
+        bool reused = false;
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+        if (client->use_connection_pool) {
+            reused = http_client_pool_take(client);
+        }
+#endif
+        if (reused) {
+            /* The pooled connection is set up already */
+        } else if (!client->is_async) {
             if (esp_transport_connect(client->transport, client->connection_info.host, client->connection_info.port, client->timeout_ms) < 0) {
                 ESP_LOGE(TAG, "Connection failed, sock < 0");
                 return ESP_ERR_HTTP_CONNECT;
@@ -190,6 +190,13 @@ typedef struct {
 #if CONFIG_ESP_HTTP_CLIENT_ENABLE_CUSTOM_TRANSPORT
     struct esp_transport_item_t *transport;
 #endif
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+    bool use_connection_pool;               /*!< Hand the connection to the process-wide connection pool in esp_http_client_cleanup(), and
+                                                 take a pooled connection to the same server instead of connecting, see esp_http_client_pool_flush() */
+#endif
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+    bool decompress_response;               /*!< Send `Accept-Encoding: gzip, deflate` and decode such response bodies in esp_http_client_read() */
+#endif
 } esp_http_client_config_t;
 
 /**
@@ -198,6 +205,7 @@ typedef struct {
 typedef enum {
     /* 2xx - Success */
     HttpStatus_Ok                = 200,
+    HttpStatus_PartialContent    = 206,
 
     /* 3xx - Redirection */
     HttpStatus_MultipleChoices   = 300,
@@ -558,6 +566,11 @@ bool esp_http_client_is_chunked_response(esp_http_client_handle_t client);
  *     - Length of data was read
  *
  * @note  (-ESP_ERR_HTTP_EAGAIN = -0x7007) is returned when call is timed-out before any data was ready
+ *
+ * @note  If `decompress_response` is set in the configuration and the response has a gzip or deflate Content-Encoding,
+ *        the decoded body is returned. The compressed body is read only as far as needed to fill the buffer, so the
+ *        content length and esp_http_client_is_complete_data_received() refer to the compressed body, and decoded
+ *        data may still be returned after all of it is received. Read until 0 is returned.
  */
 int esp_http_client_read(esp_http_client_handle_t client, char *buffer, int len);
 
@@ -608,6 +621,24 @@ esp_err_t esp_http_client_close(esp_http_client_handle_t client);
  */
 esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client);
 
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+/**
+ * @brief      Close all connections in the connection pool
+ *
+ *             Clients created with `use_connection_pool` hand their idle connection to a process-wide pool in
+ *             esp_http_client_cleanup(), instead of closing it. The next client with the same TLS settings which
+ *             connects to the same scheme, host and port takes over the connection and saves the TCP and TLS
+ *             handshakes. HTTP_EVENT_DISCONNECTED is not dispatched for a connection handed to the pool.
+ *
+ *             Idle connections are closed after CONFIG_ESP_HTTP_CLIENT_POOL_IDLE_TIMEOUT seconds. Call this
+ *             function to close them earlier, e.g. when the network interface goes down.
+ *
+ * @note       Connections are only shared between clients whose TLS settings point to the same certificates and
+ *             strings, the contents of these buffers must not change while connections set up with them are pooled.
+ */
+void esp_http_client_pool_flush(void);
+#endif
+
 /**
  * @brief      Get transport type
  *
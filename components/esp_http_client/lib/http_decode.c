@@ -0,0 +1,304 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "sdkconfig.h"
+#include "http_decode.h"
+
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+
+#include "miniz.h"
+
+static const char *TAG = "HTTP_DECODE";
+
+#define HTTP_DECODER_IN_SIZE    512
+
+#define GZIP_ID1                0x1f
+#define GZIP_ID2                0x8b
+#define GZIP_CM_DEFLATE         8
+#define GZIP_HEADER_LEN         10
+#define GZIP_TRAILER_LEN        8
+
+#define GZIP_FLAG_FHCRC         (1 << 1)
+#define GZIP_FLAG_FEXTRA        (1 << 2)
+#define GZIP_FLAG_FNAME         (1 << 3)
+#define GZIP_FLAG_FCOMMENT      (1 << 4)
+
+/* The fields of a gzip stream, in the order they are received */
+typedef enum {
+    DECODER_GZIP_HEADER = 0,
+    DECODER_GZIP_EXTRA_LEN,
+    DECODER_GZIP_EXTRA,
+    DECODER_GZIP_NAME,
+    DECODER_GZIP_COMMENT,
+    DECODER_GZIP_HCRC,
+    DECODER_INFLATE,
+    DECODER_GZIP_TRAILER,
+    DECODER_DONE,
+    DECODER_ERROR,
+} http_decoder_state_t;
+
+struct http_decoder {
+    http_content_encoding_t encoding;
+    http_decoder_state_t state;
+    tinfl_decompressor inflator;
+    uint8_t *dict;              /*!< Output window of the inflater, it's also the dictionary of the stream */
+    size_t dict_pos;
+    const uint8_t *out_ptr;     /*!< Decoded data not returned yet, within dict */
+    size_t out_avail;
+    int inflate_flags;
+    uint8_t in[HTTP_DECODER_IN_SIZE];
+    size_t in_pos;
+    size_t in_len;
+    bool in_started;            /*!< Set once any encoded byte is read */
+    bool in_eof;
+    bool in_more;               /*!< Set when the buffered input is too short to go on */
+    uint8_t field[GZIP_HEADER_LEN];
+    size_t field_len;
+    uint8_t gzip_flags;
+    uint16_t extra_len;
+    uint32_t crc;
+    uint32_t size;
+};
+
+http_decoder_handle_t http_decoder_init(void)
+{
+    http_decoder_handle_t decoder = calloc(1, sizeof(struct http_decoder));
+    if (decoder == NULL) {
+        return NULL;
+    }
+    decoder->dict = malloc(TINFL_LZ_DICT_SIZE);
+    if (decoder->dict == NULL) {
+        free(decoder);
+        return NULL;
+    }
+    return decoder;
+}
+
+void http_decoder_reset(http_decoder_handle_t decoder, http_content_encoding_t encoding)
+{
+    decoder->encoding = encoding;
+    decoder->state = (encoding == HTTP_CONTENT_ENCODING_GZIP) ? DECODER_GZIP_HEADER : DECODER_INFLATE;
+    tinfl_init(&decoder->inflator);
+    decoder->dict_pos = 0;
+    decoder->out_ptr = NULL;
+    decoder->out_avail = 0;
+    /* Whether a deflate body has a zlib header is only known once its first bytes are received */
+    decoder->inflate_flags = -1;
+    decoder->in_pos = 0;
+    decoder->in_len = 0;
+    decoder->in_started = false;
+    decoder->in_eof = false;
+    decoder->in_more = false;
+    decoder->field_len = 0;
+    decoder->gzip_flags = 0;
+    decoder->extra_len = 0;
+    decoder->crc = 0;
+    decoder->size = 0;
+}
+
+void http_decoder_destroy(http_decoder_handle_t decoder)
+{
+    if (decoder) {
+        free(decoder->dict);
+        free(decoder);
+    }
+}
+
+/* Move to the next field of the gzip header which is present in the stream */
+static void gzip_next_field(http_decoder_handle_t decoder)
+{
+    decoder->field_len = 0;
+    do {
+        decoder->state++;
+    } while ((decoder->state == DECODER_GZIP_EXTRA_LEN && !(decoder->gzip_flags & GZIP_FLAG_FEXTRA)) ||
+             (decoder->state == DECODER_GZIP_EXTRA && decoder->extra_len == 0) ||
+             (decoder->state == DECODER_GZIP_NAME && !(decoder->gzip_flags & GZIP_FLAG_FNAME)) ||
+             (decoder->state == DECODER_GZIP_COMMENT && !(decoder->gzip_flags & GZIP_FLAG_FCOMMENT)) ||
+             (decoder->state == DECODER_GZIP_HCRC && !(decoder->gzip_flags & GZIP_FLAG_FHCRC)));
+}
+
+static esp_err_t gzip_parse_header(http_decoder_handle_t decoder)
+{
+    while (decoder->state < DECODER_INFLATE && decoder->in_pos < decoder->in_len) {
+        uint8_t c = decoder->in[decoder->in_pos++];
+        switch (decoder->state) {
+        case DECODER_GZIP_HEADER:
+            decoder->field[decoder->field_len++] = c;
+            if (decoder->field_len == GZIP_HEADER_LEN) {
+                if (decoder->field[0] != GZIP_ID1 || decoder->field[1] != GZIP_ID2 || decoder->field[2] != GZIP_CM_DEFLATE) {
+                    ESP_LOGE(TAG, "Invalid gzip header");
+                    return ESP_FAIL;
+                }
+                decoder->gzip_flags = decoder->field[3];
+                gzip_next_field(decoder);
+            }
+            break;
+        case DECODER_GZIP_EXTRA_LEN:
+            decoder->field[decoder->field_len++] = c;
+            if (decoder->field_len == 2) {
+                decoder->extra_len = decoder->field[0] | (decoder->field[1] << 8);
+                gzip_next_field(decoder);
+            }
+            break;
+        case DECODER_GZIP_EXTRA:
+            if (--decoder->extra_len == 0) {
+                gzip_next_field(decoder);
+            }
+            break;
+        case DECODER_GZIP_NAME:
+        case DECODER_GZIP_COMMENT:
+            if (c == 0) {
+                gzip_next_field(decoder);
+            }
+            break;
+        case DECODER_GZIP_HCRC:
+            if (++decoder->field_len == 2) {
+                gzip_next_field(decoder);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t gzip_parse_trailer(http_decoder_handle_t decoder)
+{
+    size_t len = MIN(GZIP_TRAILER_LEN - decoder->field_len, decoder->in_len - decoder->in_pos);
+    memcpy(decoder->field + decoder->field_len, decoder->in + decoder->in_pos, len);
+    decoder->field_len += len;
+    decoder->in_pos += len;
+    if (decoder->field_len < GZIP_TRAILER_LEN) {
+        return ESP_OK;
+    }
+    uint32_t crc = decoder->field[0] | (decoder->field[1] << 8) | (decoder->field[2] << 16) | ((uint32_t)decoder->field[3] << 24);
+    uint32_t size = decoder->field[4] | (decoder->field[5] << 8) | (decoder->field[6] << 16) | ((uint32_t)decoder->field[7] << 24);
+    if (crc != decoder->crc || size != decoder->size) {
+        ESP_LOGE(TAG, "gzip trailer mismatch, crc 0x%08"PRIx32" != 0x%08"PRIx32" or size %"PRIu32" != %"PRIu32,
+                 crc, decoder->crc, size, decoder->size);
+        return ESP_FAIL;
+    }
+    decoder->state = DECODER_DONE;
+    return ESP_OK;
+}
+
+static esp_err_t decoder_inflate(http_decoder_handle_t decoder)
+{
+    size_t in_bytes = decoder->in_len - decoder->in_pos;
+    if (decoder->inflate_flags < 0) {
+        if (decoder->encoding == HTTP_CONTENT_ENCODING_GZIP) {
+            decoder->inflate_flags = 0;
+        } else if (in_bytes < 2 && !decoder->in_eof) {
+            /* The first two bytes tell whether there is a zlib header */
+            decoder->in_more = true;
+            return ESP_OK;
+        } else {
+            /* A zlib header has the deflate method in its first byte and is a multiple of 31 */
+            const uint8_t *in = decoder->in + decoder->in_pos;
+            bool zlib = in_bytes < 2 || ((in[0] & 0x0f) == GZIP_CM_DEFLATE && ((in[0] << 8) | in[1]) % 31 == 0);
+            decoder->inflate_flags = zlib ? TINFL_FLAG_PARSE_ZLIB_HEADER : 0;
+        }
+    }
+    size_t out_bytes = TINFL_LZ_DICT_SIZE - decoder->dict_pos;
+    /* Without TINFL_FLAG_HAS_MORE_INPUT, the inflater reads zeros past the end of the input instead of failing, so
+     * the end of the body is detected here: the inflater still needs input after all of it is given */
+    int flags = decoder->inflate_flags | TINFL_FLAG_HAS_MORE_INPUT;
+    tinfl_status status = tinfl_decompress(&decoder->inflator, decoder->in + decoder->in_pos, &in_bytes,
+                                           decoder->dict, decoder->dict + decoder->dict_pos, &out_bytes, flags);
+    decoder->in_pos += in_bytes;
+    decoder->out_ptr = decoder->dict + decoder->dict_pos;
+    decoder->out_avail = out_bytes;
+    decoder->dict_pos = (decoder->dict_pos + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+
+    if (status < TINFL_STATUS_DONE) {
+        ESP_LOGE(TAG, "Failed to inflate the body, status %d", status);
+        return ESP_FAIL;
+    }
+    if (status == TINFL_STATUS_NEEDS_MORE_INPUT && decoder->in_eof) {
+        ESP_LOGE(TAG, "Compressed body is truncated");
+        return ESP_FAIL;
+    }
+    if (decoder->encoding == HTTP_CONTENT_ENCODING_GZIP) {
+        decoder->crc = esp_rom_crc32_le(decoder->crc, decoder->out_ptr, out_bytes);
+        decoder->size += out_bytes;
+    }
+    if (status == TINFL_STATUS_DONE) {
+        decoder->field_len = 0;
+        decoder->state = (decoder->encoding == HTTP_CONTENT_ENCODING_GZIP) ? DECODER_GZIP_TRAILER : DECODER_DONE;
+    }
+    return ESP_OK;
+}
+
+int http_decoder_read(http_decoder_handle_t decoder, char *buffer, int len, http_decoder_read_cb_t read_cb, void *ctx)
+{
+    int ridx = 0;
+    while (ridx < len) {
+        if (decoder->out_avail) {
+            size_t copy_len = MIN(decoder->out_avail, len - ridx);
+            memcpy(buffer + ridx, decoder->out_ptr, copy_len);
+            decoder->out_ptr += copy_len;
+            decoder->out_avail -= copy_len;
+            ridx += copy_len;
+            continue;
+        }
+        if (decoder->state == DECODER_DONE) {
+            break;
+        }
+        if (decoder->state == DECODER_ERROR) {
+            return ridx ? ridx : ESP_FAIL;
+        }
+        if ((decoder->in_pos == decoder->in_len || decoder->in_more) && !decoder->in_eof) {
+            /* Keep the input which isn't used yet at the start of the buffer */
+            decoder->in_len -= decoder->in_pos;
+            memmove(decoder->in, decoder->in + decoder->in_pos, decoder->in_len);
+            decoder->in_pos = 0;
+            int rlen = read_cb(ctx, (char *)decoder->in + decoder->in_len, sizeof(decoder->in) - decoder->in_len);
+            if (rlen < 0) {
+                return ridx ? ridx : rlen;
+            }
+            decoder->in_len += rlen;
+            decoder->in_more = false;
+            decoder->in_eof = (rlen == 0);
+            if (decoder->in_eof && !decoder->in_started) {
+                /* A response without a body, e.g. to a HEAD request */
+                decoder->state = DECODER_DONE;
+                break;
+            }
+            decoder->in_started = true;
+        }
+
+        esp_err_t err;
+        if (decoder->state < DECODER_INFLATE) {
+            err = gzip_parse_header(decoder);
+        } else if (decoder->state == DECODER_INFLATE) {
+            err = decoder_inflate(decoder);
+        } else {
+            err = gzip_parse_trailer(decoder);
+        }
+        if (err == ESP_OK && decoder->in_eof && decoder->state != DECODER_INFLATE && decoder->state != DECODER_DONE &&
+                decoder->in_pos == decoder->in_len) {
+            ESP_LOGE(TAG, "Compressed body is truncated");
+            err = ESP_FAIL;
+        }
+        if (err != ESP_OK) {
+            decoder->state = DECODER_ERROR;
+        }
+    }
+    return ridx;
+}
+
+#endif // CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
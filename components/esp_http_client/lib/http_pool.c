@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/lock.h>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+#include "http_pool.h"
+
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_HTTPS
+#include "esp_transport_ssl.h"
+#endif
+
+#ifdef CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+
+static const char *TAG = "HTTP_POOL";
+
+#define HTTP_POOL_IDLE_TIMEOUT_TICKS    pdMS_TO_TICKS(CONFIG_ESP_HTTP_CLIENT_POOL_IDLE_TIMEOUT * 1000)
+
+typedef struct {
+    char *host;                 /*!< Host of the entry, NULL if the entry is free */
+    bool https;
+    int port;
+    http_pool_key_t key;
+    http_pool_conn_t conn;
+    TickType_t idle_since;      /*!< Time the connection was parked */
+} http_pool_entry_t;
+
+static http_pool_entry_t s_pool[CONFIG_ESP_HTTP_CLIENT_POOL_SIZE];
+static _lock_t s_pool_lock;
+
+static void http_pool_release(http_pool_entry_t *entry)
+{
+    esp_transport_close(entry->conn.transport);
+    esp_transport_list_destroy(entry->conn.transport_list);
+    free(entry->host);
+    memset(entry, 0, sizeof(http_pool_entry_t));
+}
+
+static bool http_pool_matches(const http_pool_entry_t *entry, bool https, const char *host, int port,
+                              const http_pool_key_t *key)
+{
+    return entry->host && entry->https == https && entry->port == port && strcasecmp(entry->host, host) == 0 &&
+           memcmp(&entry->key, key, sizeof(http_pool_key_t)) == 0;
+}
+
+/* Closes the connections which have been idle for too long. With session tickets,
+ * the entry of a TLS connection is kept to resume its session on the next connection. */
+static void http_pool_expire(TickType_t now)
+{
+    for (int i = 0; i < CONFIG_ESP_HTTP_CLIENT_POOL_SIZE; i++) {
+        http_pool_entry_t *entry = &s_pool[i];
+        if (!entry->host || !entry->conn.connected || (TickType_t)(now - entry->idle_since) < HTTP_POOL_IDLE_TIMEOUT_TICKS) {
+            continue;
+        }
+        ESP_LOGD(TAG, "Closing idle connection to %s:%d", entry->host, entry->port);
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+        if (entry->https) {
+            esp_transport_close(entry->conn.transport);
+            entry->conn.connected = false;
+            continue;
+        }
+#endif
+        http_pool_release(entry);
+    }
+}
+
+esp_err_t http_pool_take(const char *scheme, const char *host, int port, const http_pool_key_t *key,
+                         http_pool_conn_t *conn)
+{
+    const bool https = strcasecmp(scheme, "https") == 0;
+    http_pool_entry_t *found = NULL;
+    TickType_t now = xTaskGetTickCount();
+
+    _lock_acquire(&s_pool_lock);
+    http_pool_expire(now);
+    for (int i = 0; i < CONFIG_ESP_HTTP_CLIENT_POOL_SIZE; i++) {
+        http_pool_entry_t *entry = &s_pool[i];
+        if (!http_pool_matches(entry, https, host, port, key)) {
+            continue;
+        }
+        /* An idle connection must not have any data to read, otherwise the
+         * server has closed it or sent something unexpected */
+        if (entry->conn.connected && esp_transport_poll_read(entry->conn.transport, 0) != 0) {
+            ESP_LOGD(TAG, "Dropping connection to %s:%d closed by the server", entry->host, entry->port);
+            http_pool_release(entry);
+            continue;
+        }
+        /* Prefer a live connection, then the most recently parked one */
+        if (found == NULL || (entry->conn.connected && !found->conn.connected) ||
+            (entry->conn.connected == found->conn.connected && now - entry->idle_since < now - found->idle_since)) {
+            found = entry;
+        }
+    }
+    if (found) {
+        *conn = found->conn;
+        free(found->host);
+        memset(found, 0, sizeof(http_pool_entry_t));
+    }
+    _lock_release(&s_pool_lock);
+    return found ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+void http_pool_put(const char *scheme, const char *host, int port, const http_pool_key_t *key,
+                   const http_pool_conn_t *conn)
+{
+    const bool https = strcasecmp(scheme, "https") == 0;
+    http_pool_entry_t *slot = NULL;
+    http_pool_entry_t *oldest_for_host = NULL;
+    int count_for_host = 0;
+    TickType_t now = xTaskGetTickCount();
+
+    char *host_copy = strdup(host);
+    if (host_copy == NULL) {
+        http_pool_entry_t entry = { .conn = *conn };
+        http_pool_release(&entry);
+        return;
+    }
+
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+    if (https && conn->connected) {
+        /* Keep the session, so that it can be resumed once the connection is closed */
+        esp_transport_ssl_session_ticket_operation(conn->transport, ESP_TRANSPORT_SESSION_TICKET_SAVE);
+    }
+#endif
+
+    _lock_acquire(&s_pool_lock);
+    http_pool_expire(now);
+    for (int i = 0; i < CONFIG_ESP_HTTP_CLIENT_POOL_SIZE; i++) {
+        http_pool_entry_t *entry = &s_pool[i];
+        if (http_pool_matches(entry, https, host, port, key)) {
+            /* A closed entry only holds a session, which the new connection replaces */
+            if (!entry->conn.connected) {
+                http_pool_release(entry);
+            } else {
+                count_for_host++;
+                if (oldest_for_host == NULL || now - entry->idle_since > now - oldest_for_host->idle_since) {
+                    oldest_for_host = entry;
+                }
+            }
+        }
+    }
+    if (count_for_host >= CONFIG_ESP_HTTP_CLIENT_POOL_MAX_PER_HOST) {
+        slot = oldest_for_host;
+    } else {
+        /* Use a free entry, else replace a closed entry or the connection idle for the longest time */
+        for (int i = 0; i < CONFIG_ESP_HTTP_CLIENT_POOL_SIZE; i++) {
+            http_pool_entry_t *entry = &s_pool[i];
+            if (entry->host == NULL) {
+                slot = entry;
+                break;
+            }
+            if (slot == NULL || (slot->conn.connected && !entry->conn.connected) ||
+                (slot->conn.connected == entry->conn.connected && now - entry->idle_since > now - slot->idle_since)) {
+                slot = entry;
+            }
+        }
+    }
+    if (slot->host) {
+        ESP_LOGD(TAG, "Pool full, closing connection to %s:%d", slot->host, slot->port);
+        http_pool_release(slot);
+    }
+    slot->host = host_copy;
+    slot->https = https;
+    slot->port = port;
+    slot->key = *key;
+    slot->conn = *conn;
+    slot->idle_since = now;
+    _lock_release(&s_pool_lock);
+}
+
+void http_pool_flush(void)
+{
+    _lock_acquire(&s_pool_lock);
+    for (int i = 0; i < CONFIG_ESP_HTTP_CLIENT_POOL_SIZE; i++) {
+        if (s_pool[i].host) {
+            http_pool_release(&s_pool[i]);
+        }
+    }
+    _lock_release(&s_pool_lock);
+}
+
+#endif // CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
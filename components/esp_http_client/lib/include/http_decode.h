@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#ifndef _HTTP_DECODE_H_
+#define _HTTP_DECODE_H_
+
+/**
+ * Content codings of a response body which the decoder handles
+ */
+typedef enum {
+    HTTP_CONTENT_ENCODING_IDENTITY = 0, /*!< Body isn't encoded */
+    HTTP_CONTENT_ENCODING_GZIP,         /*!< Body is a gzip stream */
+    HTTP_CONTENT_ENCODING_DEFLATE,      /*!< Body is a zlib stream, or a raw deflate stream as sent by some servers */
+} http_content_encoding_t;
+
+typedef struct http_decoder *http_decoder_handle_t;
+
+/**
+ * @brief      Read the encoded body
+ *
+ * @param      ctx     The context given to http_decoder_read()
+ * @param      buffer  The buffer
+ * @param[in]  len     The buffer length
+ *
+ * @return
+ *     - (>0) Number of bytes read
+ *     - 0 End of the body
+ *     - (<0) Error, returned by http_decoder_read() unchanged
+ */
+typedef int (*http_decoder_read_cb_t)(void *ctx, char *buffer, int len);
+
+/**
+ * @brief      Create a decoder
+ *
+ * The decoder keeps the 32 KB dictionary of the deflate format and the state of the inflater, about 43 KB of heap.
+ *
+ * @return     The decoder handle, NULL if out of memory
+ */
+http_decoder_handle_t http_decoder_init(void);
+
+/**
+ * @brief      Prepare the decoder for a new body
+ *
+ * @param[in]  decoder   The decoder handle
+ * @param[in]  encoding  Content coding of the body
+ */
+void http_decoder_reset(http_decoder_handle_t decoder, http_content_encoding_t encoding);
+
+/**
+ * @brief      Decode the body
+ *
+ * Encoded data is read with read_cb only when the data read before is decoded and its output is returned.
+ *
+ * @param[in]  decoder  The decoder handle
+ * @param      buffer   The buffer for the decoded data
+ * @param[in]  len      The buffer length
+ * @param[in]  read_cb  The callback reading the encoded body
+ * @param      ctx      The context passed to read_cb
+ *
+ * @return
+ *     - (>0) Number of decoded bytes
+ *     - 0 End of the body
+ *     - ESP_FAIL if the body is invalid or truncated
+ *     - others, the error returned by read_cb if no data was decoded before it
+ */
+int http_decoder_read(http_decoder_handle_t decoder, char *buffer, int len, http_decoder_read_cb_t read_cb, void *ctx);
+
+/**
+ * @brief      Destroy the decoder
+ *
+ * @param[in]  decoder  The decoder handle, can be NULL
+ */
+void http_decoder_destroy(http_decoder_handle_t decoder);
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#ifndef _HTTP_POOL_H_
+#define _HTTP_POOL_H_
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_transport.h"
+
+/**
+ * Settings of a client which affect how its transports set up a connection. A connection is only handed
+ * to a client with identical settings, so that it is never used with a weaker verification of the server
+ * than the one it was set up with. The structure is compared with memcmp(), it must be zeroed before
+ * it is filled in.
+ */
+typedef struct {
+    const char *cert_pem;
+    size_t cert_len;
+    const char *client_cert_pem;
+    size_t client_cert_len;
+    const char *client_key_pem;
+    size_t client_key_len;
+    const char *client_key_password;
+    size_t client_key_password_len;
+    const char *common_name;
+    esp_err_t (*crt_bundle_attach)(void *conf);
+    const void *ds_data;
+    int tls_version;
+    bool use_global_ca_store;
+    bool skip_cert_common_name_check;
+    bool use_secure_element;
+    bool use_ecdsa_peripheral;
+    uint8_t ecdsa_key_efuse_blk;
+    char if_name[16];
+} http_pool_key_t;
+
+/**
+ * A connection parked in the pool, together with the transport list it belongs to
+ */
+typedef struct {
+    esp_transport_list_handle_t transport_list; /*!< Transports of the client the connection was set up by */
+    esp_transport_handle_t transport;           /*!< Transport of the connection */
+    bool connected;                             /*!< False if only the TLS session of the connection is kept */
+} http_pool_conn_t;
+
+/**
+ * @brief      Take a connection to a server out of the pool
+ *
+ * Idle connections which the server has closed in the meantime are not returned.
+ *
+ * @param[in]  scheme  The scheme, "http" or "https"
+ * @param[in]  host    The host
+ * @param[in]  port    The port
+ * @param[in]  key     Connection settings of the client
+ * @param[out] conn    The connection, owned by the caller on success
+ *
+ * @return
+ *  - ESP_OK
+ *  - ESP_ERR_NOT_FOUND if there is no connection to the server with these settings
+ */
+esp_err_t http_pool_take(const char *scheme, const char *host, int port, const http_pool_key_t *key,
+                         http_pool_conn_t *conn);
+
+/**
+ * @brief      Park an idle connection in the pool
+ *
+ * The pool takes ownership of the connection in any case. If the pool is full, the connection which has been idle
+ * for the longest time is closed.
+ *
+ * @param[in]  scheme  The scheme, "http" or "https"
+ * @param[in]  host    The host
+ * @param[in]  port    The port
+ * @param[in]  key     Connection settings of the client which set up the connection
+ * @param[in]  conn    The connection
+ */
+void http_pool_put(const char *scheme, const char *host, int port, const http_pool_key_t *key,
+                   const http_pool_conn_t *conn);
+
+/**
+ * @brief      Close all connections in the pool
+ */
+void http_pool_flush(void);
+
+#endif
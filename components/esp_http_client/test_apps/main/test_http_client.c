@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -146,6 +146,26 @@ TEST_CASE("esp_http_client_init() should return NULL if configured with wrong ur
     esp_http_client_cleanup(client);
 }
 
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_CONNECTION_POOL
+TEST_CASE("Client using the connection pool is cleaned up without connecting", "[ESP HTTP CLIENT]")
+{
+    esp_http_client_config_t config = {
+        .url = "http://httpbin.org/get",
+        .use_connection_pool = true,
+    };
+
+    test_case_uses_tcpip();
+
+    // A client which has not connected has nothing to hand to the pool
+    for (int i = 0; i < 2; i++) {
+        esp_http_client_handle_t client = esp_http_client_init(&config);
+        TEST_ASSERT_NOT_NULL(client);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_http_client_cleanup(client));
+    }
+    esp_http_client_pool_flush();
+}
+#endif
+
 void app_main(void)
 {
     unity_run_menu();
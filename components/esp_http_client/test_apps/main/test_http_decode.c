@@ -0,0 +1,240 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_err.h"
+#include "unity.h"
+#include "sdkconfig.h"
+#include "http_decode.h"
+
+#if CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
+
+static const char test_text[] = "Hello, compressed world! Hello, compressed world!\n";
+
+// test_text in a gzip stream with all the optional header fields: extra, name, comment and header CRC
+static const uint8_t gzip_fields[] = {
+    0x1f, 0x8b, 0x08, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x00,
+    0x78, 0x79, 0x7a, 0x77, 0x61, 0x2e, 0x74, 0x78, 0x74, 0x00, 0x63, 0x00,
+    0x32, 0x02, 0xf3, 0x48, 0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0x48, 0xce, 0xcf,
+    0x2d, 0x28, 0x4a, 0x2d, 0x2e, 0x4e, 0x4d, 0x51, 0x28, 0xcf, 0x2f, 0xca,
+    0x49, 0x51, 0x54, 0xf0, 0xc0, 0x21, 0xc1, 0x05, 0x00, 0xf3, 0x88, 0x77,
+    0x9a, 0x32, 0x00, 0x00, 0x00,
+};
+
+// "0123456789abcdef" repeated 2600 times, more than the 32 KB window, in a gzip stream
+static const uint8_t gzip_long[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0xc7,
+    0xc9, 0x01, 0xc0, 0x10, 0x00, 0x00, 0xb0, 0x95, 0x94, 0xba, 0xc6, 0x41,
+    0xd9, 0x7f, 0x84, 0xce, 0xe0, 0x9f, 0xfc, 0x12, 0x9e, 0x98, 0xde, 0x5c,
+    0x6a, 0xeb, 0x63, 0xae, 0x6f, 0x9f, 0xe0, 0xee, 0xee, 0xee, 0xee, 0xee,
+    0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+    0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+    0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+    0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+    0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+    0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+    0xee, 0xee, 0xee, 0x57, 0xff, 0x01, 0x6f, 0xa7, 0xf1, 0xf8, 0x80, 0xa2,
+    0x00, 0x00,
+};
+
+// test_text in a zlib stream, as sent for the deflate content coding
+static const uint8_t zlib_text[] = {
+    0x78, 0xda, 0xf3, 0x48, 0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0x48, 0xce, 0xcf,
+    0x2d, 0x28, 0x4a, 0x2d, 0x2e, 0x4e, 0x4d, 0x51, 0x28, 0xcf, 0x2f, 0xca,
+    0x49, 0x51, 0x54, 0xf0, 0xc0, 0x21, 0xc1, 0x05, 0x00, 0xd0, 0x27, 0x11,
+    0xe7,
+};
+
+// test_text in a raw deflate stream, as sent by some servers for the deflate content coding
+static const uint8_t raw_text[] = {
+    0xf3, 0x48, 0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0x48, 0xce, 0xcf, 0x2d, 0x28,
+    0x4a, 0x2d, 0x2e, 0x4e, 0x4d, 0x51, 0x28, 0xcf, 0x2f, 0xca, 0x49, 0x51,
+    0x54, 0xf0, 0xc0, 0x21, 0xc1, 0x05, 0x00,
+};
+#define TEST_LONG_PATTERN       "0123456789abcdef"
+#define TEST_LONG_LEN           (16 * 2600)
+
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    size_t chunk;           // Largest read from the encoded body
+} test_body_t;
+
+static int test_body_read(void *ctx, char *buffer, int len)
+{
+    test_body_t *body = ctx;
+    size_t rlen = body->len - body->pos;
+    rlen = rlen < body->chunk ? rlen : body->chunk;
+    rlen = rlen < (size_t)len ? rlen : (size_t)len;
+    memcpy(buffer, body->data + body->pos, rlen);
+    body->pos += rlen;
+    return rlen;
+}
+
+/* Decodes a body read in chunks of chunk bytes, into a buffer of out_len bytes at a time. Returns the decoded length,
+ * or the first error. */
+static int test_decode(http_decoder_handle_t decoder, http_content_encoding_t encoding, const uint8_t *data,
+                       size_t len, size_t chunk, int out_len, char *out, size_t out_size)
+{
+    test_body_t body = { .data = data, .len = len, .chunk = chunk };
+    char buf[out_len];
+    size_t total = 0;
+
+    http_decoder_reset(decoder, encoding);
+    while (true) {
+        int rlen = http_decoder_read(decoder, buf, out_len, test_body_read, &body);
+        if (rlen <= 0) {
+            return rlen < 0 ? rlen : (int)total;
+        }
+        TEST_ASSERT_LESS_OR_EQUAL(out_size, total + rlen);
+        memcpy(out + total, buf, rlen);
+        total += rlen;
+    }
+}
+
+TEST_CASE("decoder inflates gzip and deflate bodies in any chunks", "[ESP HTTP CLIENT][decode]")
+{
+    const struct {
+        http_content_encoding_t encoding;
+        const uint8_t *data;
+        size_t len;
+    } bodies[] = {
+        { HTTP_CONTENT_ENCODING_GZIP, gzip_fields, sizeof(gzip_fields) },
+        { HTTP_CONTENT_ENCODING_DEFLATE, zlib_text, sizeof(zlib_text) },
+        { HTTP_CONTENT_ENCODING_DEFLATE, raw_text, sizeof(raw_text) },
+    };
+    const int out_lens[] = { 1, 7, 512 };
+    char out[sizeof(test_text)];
+    http_decoder_handle_t decoder = http_decoder_init();
+    TEST_ASSERT_NOT_NULL(decoder);
+
+    for (size_t i = 0; i < sizeof(bodies) / sizeof(bodies[0]); i++) {
+        for (size_t chunk = 1; chunk <= bodies[i].len; chunk++) {
+            for (size_t j = 0; j < sizeof(out_lens) / sizeof(out_lens[0]); j++) {
+                memset(out, 0, sizeof(out));
+                int len = test_decode(decoder, bodies[i].encoding, bodies[i].data, bodies[i].len, chunk, out_lens[j],
+                                      out, sizeof(out));
+                TEST_ASSERT_EQUAL(strlen(test_text), len);
+                TEST_ASSERT_EQUAL_STRING(test_text, out);
+                // The end of the body is returned again
+                TEST_ASSERT_EQUAL(0, http_decoder_read(decoder, out, sizeof(out), test_body_read, NULL));
+            }
+        }
+    }
+    http_decoder_destroy(decoder);
+}
+
+TEST_CASE("decoder inflates a gzip body larger than its window", "[ESP HTTP CLIENT][decode]")
+{
+    char *out = malloc(TEST_LONG_LEN);
+    TEST_ASSERT_NOT_NULL(out);
+    http_decoder_handle_t decoder = http_decoder_init();
+    TEST_ASSERT_NOT_NULL(decoder);
+
+    const size_t chunks[] = { 1, 5, sizeof(gzip_long) };
+    for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        memset(out, 0, TEST_LONG_LEN);
+        TEST_ASSERT_EQUAL(TEST_LONG_LEN, test_decode(decoder, HTTP_CONTENT_ENCODING_GZIP, gzip_long, sizeof(gzip_long),
+                                                     chunks[i], 1000, out, TEST_LONG_LEN));
+        for (size_t pos = 0; pos < TEST_LONG_LEN; pos += strlen(TEST_LONG_PATTERN)) {
+            TEST_ASSERT_EQUAL_MEMORY(TEST_LONG_PATTERN, out + pos, strlen(TEST_LONG_PATTERN));
+        }
+    }
+    http_decoder_destroy(decoder);
+    free(out);
+}
+
+TEST_CASE("decoder rejects corrupted gzip and deflate bodies", "[ESP HTTP CLIENT][decode]")
+{
+    uint8_t data[sizeof(gzip_fields)];
+    char out[sizeof(test_text)];
+    http_decoder_handle_t decoder = http_decoder_init();
+    TEST_ASSERT_NOT_NULL(decoder);
+
+    // Every byte of the trailer is checked: CRC32, then the size of the decoded data
+    for (size_t pos = sizeof(gzip_fields) - 8; pos < sizeof(gzip_fields); pos++) {
+        memcpy(data, gzip_fields, sizeof(gzip_fields));
+        data[pos] ^= 0x01;
+        TEST_ASSERT_EQUAL(ESP_FAIL, test_decode(decoder, HTTP_CONTENT_ENCODING_GZIP, data, sizeof(gzip_fields),
+                                                sizeof(gzip_fields), sizeof(out), out, sizeof(out)));
+    }
+
+    // Invalid magic number and compression method
+    const size_t header_pos[] = { 0, 1, 2 };
+    for (size_t i = 0; i < sizeof(header_pos) / sizeof(header_pos[0]); i++) {
+        memcpy(data, gzip_fields, sizeof(gzip_fields));
+        data[header_pos[i]] ^= 0x01;
+        TEST_ASSERT_EQUAL(ESP_FAIL, test_decode(decoder, HTTP_CONTENT_ENCODING_GZIP, data, sizeof(gzip_fields),
+                                                sizeof(gzip_fields), sizeof(out), out, sizeof(out)));
+    }
+
+    // Adler32 of a zlib stream
+    memcpy(data, zlib_text, sizeof(zlib_text));
+    data[sizeof(zlib_text) - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL(ESP_FAIL, test_decode(decoder, HTTP_CONTENT_ENCODING_DEFLATE, data, sizeof(zlib_text),
+                                            sizeof(zlib_text), sizeof(out), out, sizeof(out)));
+
+    // A final block of the reserved type
+    const uint8_t invalid_block[] = { 0x07, 0x00 };
+    TEST_ASSERT_EQUAL(ESP_FAIL, test_decode(decoder, HTTP_CONTENT_ENCODING_DEFLATE, invalid_block,
+                                            sizeof(invalid_block), sizeof(invalid_block), sizeof(out), out, sizeof(out)));
+
+    // The error is reported again, and the decoder can be reused
+    TEST_ASSERT_EQUAL(ESP_FAIL, http_decoder_read(decoder, out, sizeof(out), test_body_read, NULL));
+    TEST_ASSERT_EQUAL(strlen(test_text), test_decode(decoder, HTTP_CONTENT_ENCODING_DEFLATE, raw_text,
+                                                     sizeof(raw_text), 1, sizeof(out), out, sizeof(out)));
+    http_decoder_destroy(decoder);
+}
+
+TEST_CASE("decoder rejects truncated gzip and deflate bodies", "[ESP HTTP CLIENT][decode]")
+{
+    const struct {
+        http_content_encoding_t encoding;
+        const uint8_t *data;
+        size_t len;
+    } bodies[] = {
+        { HTTP_CONTENT_ENCODING_GZIP, gzip_fields, sizeof(gzip_fields) },
+        { HTTP_CONTENT_ENCODING_GZIP, gzip_long, sizeof(gzip_long) },
+        { HTTP_CONTENT_ENCODING_DEFLATE, zlib_text, sizeof(zlib_text) },
+        { HTTP_CONTENT_ENCODING_DEFLATE, raw_text, sizeof(raw_text) },
+    };
+    char *out = malloc(TEST_LONG_LEN);
+    TEST_ASSERT_NOT_NULL(out);
+    http_decoder_handle_t decoder = http_decoder_init();
+    TEST_ASSERT_NOT_NULL(decoder);
+
+    for (size_t i = 0; i < sizeof(bodies) / sizeof(bodies[0]); i++) {
+        // An empty body, e.g. the response to a HEAD request, isn't an error
+        TEST_ASSERT_EQUAL(0, test_decode(decoder, bodies[i].encoding, bodies[i].data, 0, 1, 512, out, TEST_LONG_LEN));
+        for (size_t len = 1; len < bodies[i].len; len++) {
+            TEST_ASSERT_EQUAL(ESP_FAIL, test_decode(decoder, bodies[i].encoding, bodies[i].data, len, 3, 512,
+                                                    out, TEST_LONG_LEN));
+        }
+    }
+    http_decoder_destroy(decoder);
+    free(out);
+}
+
+static int test_body_read_error(void *ctx, char *buffer, int len)
+{
+    return -1;
+}
+
+TEST_CASE("decoder returns the errors of the body reads", "[ESP HTTP CLIENT][decode]")
+{
+    char out[16];
+    http_decoder_handle_t decoder = http_decoder_init();
+    TEST_ASSERT_NOT_NULL(decoder);
+
+    http_decoder_reset(decoder, HTTP_CONTENT_ENCODING_GZIP);
+    TEST_ASSERT_EQUAL(-1, http_decoder_read(decoder, out, sizeof(out), test_body_read_error, NULL));
+    http_decoder_destroy(decoder);
+}
+#endif // CONFIG_ESP_HTTP_CLIENT_ENABLE_DECOMPRESSION
@@ -16,6 +16,7 @@
 #include <esp_err.h>
 #include <esp_event.h>
 #include <esp_event_base.h>
+#include <esp_partition.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +56,9 @@ initializer that should be kept in sync
         .stack_size         = 4096,                     \
         .core_id            = tskNO_AFFINITY,           \
         .task_caps          = (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT),       \
+        .worker_count       = 0,                        \
+        .worker_stack_size  = 4096,                     \
+        .worker_core_id     = tskNO_AFFINITY,           \
         .server_port        = 80,                       \
         .ctrl_port          = ESP_HTTPD_DEF_CTRL_PORT,  \
         .max_open_sockets   = 7,                        \
@@ -173,6 +177,22 @@ typedef struct httpd_config {
     BaseType_t  core_id;            /*!< The core the HTTP server task will run on */
     uint32_t    task_caps;          /*!< The memory capabilities to use when allocating the HTTP server task's stack */
 
+    /**
+     * Number of worker tasks which process the requests.
+     *
+     * If 0, requests are received and handled by the server task itself, one at a time.
+     * Otherwise the server task only waits for activity on the sockets and hands each
+     * session with a pending request to one of the workers, so that the requests of
+     * several sessions are handled in parallel. URI handlers may then run concurrently
+     * and must protect any state they share.
+     *
+     * The workers have the same priority and stack memory capabilities as the server task.
+     * Not supported on the linux target, where requests are always handled by the server task.
+     */
+    uint8_t     worker_count;
+    size_t      worker_stack_size;  /*!< The maximum stack size allowed for each worker task */
+    BaseType_t  worker_core_id;     /*!< The core the worker tasks will run on. With tskNO_AFFINITY, the workers are pinned to the cores in turn */
+
     /**
      * TCP Port number for receiving and transmitting HTTP traffic
      */
@@ -275,6 +295,11 @@ typedef struct httpd_config {
      *
      * Users can implement their own matching functions (See description
      * of the `httpd_uri_match_func_t` function prototype)
+     *
+     * With the two built-in options, the registered URIs are indexed in a
+     * tree, so finding the handler of a request takes a time proportional
+     * to the length of the URI, not to the number of handlers. A custom
+     * matching function is called for each handler in turn.
      */
     httpd_uri_match_func_t uri_match_fn;
 } httpd_config_t;
@@ -1186,10 +1211,95 @@ static inline esp_err_t httpd_resp_sendstr_chunk(httpd_req_t *r, const char *str
     return httpd_resp_send_chunk(r, str, (str == NULL) ? 0 : HTTPD_RESP_USE_STRLEN);
 }
 
+/**
+ * @brief   Properties of static content sent with httpd_resp_send_mmap()
+ *          or httpd_resp_send_partition()
+ */
+typedef struct {
+    /**
+     * Entity tag of the content including the quotes, e.g. "\"v1.2\"", or NULL.
+     *
+     * It is sent in the ETag header. If the request has an If-None-Match header
+     * matching it, only a 304 Not Modified response is sent, without the content.
+     */
+    const char *etag;
+
+    /**
+     * The content is gzip compressed.
+     *
+     * The response is sent with the Content-Encoding: gzip header. If the client
+     * does not accept gzip, nothing is sent and ESP_ERR_NOT_SUPPORTED is returned,
+     * so that the handler can fall back to uncompressed content.
+     */
+    bool gzip;
+} httpd_resp_content_t;
+
+/**
+ * @brief   API to send a complete HTTP response directly from memory that
+ *          stays valid while sending, e.g. a memory-mapped flash region
+ *
+ * Works like httpd_resp_send(), but the content is passed to the socket
+ * straight from buf, without staging it in a RAM buffer first. It also
+ * handles the conditional request and compression headers described in
+ * httpd_resp_content_t.
+ *
+ * @note
+ *  - This API is supposed to be called only from the context of
+ *    a URI handler where httpd_req_t* request pointer is valid.
+ *  - Each of the ETag, Content-Encoding and Vary headers which are sent
+ *    uses one of the max_resp_headers additional header slots.
+ *  - Once this API is called, the request has been responded to and all
+ *    request headers are purged.
+ *
+ * @param[in] r         The request being responded to
+ * @param[in] buf       Content to send
+ * @param[in] buf_len   Length of the content
+ * @param[in] content   Properties of the content, NULL if none apply
+ *
+ * @return
+ *  - ESP_OK : On successfully sending the response, or a 304 Not Modified response
+ *  - ESP_ERR_INVALID_ARG : Null arguments
+ *  - ESP_ERR_NOT_SUPPORTED     : The content is compressed, and the client does not accept it
+ *  - ESP_ERR_HTTPD_RESP_HDR    : Headers are too large for internal buffer, or too many headers
+ *  - ESP_ERR_HTTPD_RESP_SEND   : Error in raw send
+ *  - ESP_ERR_HTTPD_INVALID_REQ : Invalid request
+ */
+esp_err_t httpd_resp_send_mmap(httpd_req_t *r, const void *buf, size_t buf_len, const httpd_resp_content_t *content);
+
+/**
+ * @brief   API to send a complete HTTP response from a flash partition
+ *
+ * The region of the partition is memory-mapped piece by piece and sent
+ * with httpd_resp_send_mmap() semantics, so static assets such as web
+ * pages can be served from a data partition without reading them into
+ * RAM first.
+ *
+ * @note
+ *  - This API is supposed to be called only from the context of
+ *    a URI handler where httpd_req_t* request pointer is valid.
+ *
+ * @param[in] r         The request being responded to
+ * @param[in] partition Partition holding the content
+ * @param[in] offset    Offset of the content in the partition
+ * @param[in] len       Length of the content
+ * @param[in] content   Properties of the content, NULL if none apply
+ *
+ * @return
+ *  - ESP_OK : On successfully sending the response, or a 304 Not Modified response
+ *  - ESP_ERR_INVALID_ARG : Null arguments, or the region is outside of the partition
+ *  - ESP_ERR_NOT_SUPPORTED     : The content is compressed, and the client does not accept it
+ *  - ESP_ERR_HTTPD_RESP_HDR    : Headers are too large for internal buffer, or too many headers
+ *  - ESP_ERR_HTTPD_RESP_SEND   : Error in raw send, or the partition could not be mapped
+ *  - ESP_ERR_HTTPD_INVALID_REQ : Invalid request
+ */
+esp_err_t httpd_resp_send_partition(httpd_req_t *r, const esp_partition_t *partition, size_t offset, size_t len,
+                                    const httpd_resp_content_t *content);
+
 /* Some commonly used status codes */
 #define HTTPD_200      "200 OK"                     /*!< HTTP Response 200 */
 #define HTTPD_204      "204 No Content"             /*!< HTTP Response 204 */
 #define HTTPD_207      "207 Multi-Status"           /*!< HTTP Response 207 */
+#define HTTPD_304      "304 Not Modified"           /*!< HTTP Response 304 */
 #define HTTPD_400      "400 Bad Request"            /*!< HTTP Response 400 */
 #define HTTPD_404      "404 Not Found"              /*!< HTTP Response 404 */
 #define HTTPD_408      "408 Request Timeout"        /*!< HTTP Response 408 */
@@ -1804,6 +1914,39 @@ esp_err_t httpd_ws_send_data(httpd_handle_t handle, int socket, httpd_ws_frame_t
 esp_err_t httpd_ws_send_data_async(httpd_handle_t handle, int socket, httpd_ws_frame_t *frame,
                                    transfer_complete_cb callback, void *arg);
 
+/**
+ * @brief Sends a WebSocket frame to all WebSocket clients of a server
+ *
+ * The frame is encoded once into a buffer which is shared by all clients,
+ * and handed to the server task with a single httpd_queue_work() call.
+ * The server task queues it for every client which has completed the
+ * handshake and sends it whenever the socket of a client can take more
+ * data, so a slow client does not stall the server task or the other
+ * clients. If CONFIG_HTTPD_WS_BROADCAST_QUEUE_LEN frames are queued for
+ * a client already, its oldest queued frame is dropped. The frame after it
+ * is dropped instead if the oldest one is partially sent, or while a
+ * request of the client is processed by a worker task or an async handler.
+ *
+ * @note
+ *  - The payload is copied, the frame can be reused as soon as this
+ *    function returns.
+ *  - Broadcast frames, and frames sent with the other send functions of
+ *    this server, are never interleaved within a frame. Fragmented
+ *    messages should therefore not be broadcast while other messages
+ *    are sent to the same clients.
+ *  - With a send function which blocks, like the one of esp_https_server,
+ *    sending to a slow client still blocks the server task.
+ *
+ * @param[in] handle  Server instance data
+ * @param[in] frame   WebSocket frame
+ * @return
+ *  - ESP_OK                    : The frame is queued for sending
+ *  - ESP_ERR_INVALID_ARG       : Argument is invalid
+ *  - ESP_ERR_NO_MEM            : Unable to allocate memory
+ *  - ESP_FAIL                  : The frame could not be handed to the server task
+ */
+esp_err_t httpd_ws_broadcast(httpd_handle_t handle, const httpd_ws_frame_t *frame);
+
 #endif /* CONFIG_HTTPD_WS_SUPPORT */
 /** End of WebSocket related stuff
  * @}
@@ -16,6 +16,8 @@
 #include <esp_err.h>
 
 #include <esp_http_server.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
 #include "osal.h"
 
 #ifdef __cplusplus
@@ -33,11 +35,16 @@ extern "C" {
 /* Size of request data block/chunk (not to be confused with chunked encoded data)
  * that is received and parsed in one turn of the parsing process. This should not
  * exceed the scratch buffer size and should at least be 8 bytes */
-#define PARSER_BLOCK_SIZE  128
+#define PARSER_BLOCK_SIZE  MIN(CONFIG_HTTPD_RECV_BLOCK_SIZE, HTTPD_SCRATCH_BUF)
 
 /* Calculate the maximum size needed for the scratch buffer */
 #define HTTPD_SCRATCH_BUF  MAX(HTTPD_MAX_REQ_HDR_LEN, HTTPD_MAX_URI_LEN)
 
+#if CONFIG_HTTPD_REQ_HDR_INDEX
+/* Number of slots of the request header hash table, at least twice the number of entries */
+#define HTTPD_REQ_HDR_INDEX_SLOTS  64
+#endif
+
 /* Formats a log string to prepend context function name */
 #define LOG_FMT(x)      "%s: " x, __func__
 
@@ -73,12 +80,19 @@ struct sock_db {
     char pending_data[PARSER_BLOCK_SIZE];   /*!< Buffer for pending data to be received */
     size_t pending_len;                     /*!< Length of pending data to be received */
     bool for_async_req;                     /*!< If true, the socket will not be LRU purged */
+    bool in_worker;                         /*!< If true, a request of the socket is being processed by a worker task */
+    bool close_after_worker;                /*!< Set to true to close the socket once the worker task is done with it */
+    esp_err_t worker_ret;                   /*!< Result of the processing of the last request by a worker task */
 #ifdef CONFIG_HTTPD_WS_SUPPORT
     bool ws_handshake_done;                 /*!< True if it has done WebSocket handshake (if this socket is a valid WS) */
     bool ws_close;                          /*!< Set to true to close the socket later (when WS Close frame received) */
     esp_err_t (*ws_handler)(httpd_req_t *r);   /*!< WebSocket handler, leave to null if it's not WebSocket */
     bool ws_control_frames;                         /*!< WebSocket flag indicating that control frames should be passed to user handlers */
     void *ws_user_ctx;                         /*!< Pointer to user context data which will be available to handler for websocket*/
+    struct httpd_ws_bcast_frame *ws_bcast_queue[CONFIG_HTTPD_WS_BROADCAST_QUEUE_LEN]; /*!< Broadcast frames waiting to be sent */
+    uint8_t ws_bcast_head;                  /*!< Index of the oldest frame in ws_bcast_queue */
+    uint8_t ws_bcast_count;                 /*!< Number of frames in ws_bcast_queue */
+    size_t ws_bcast_offset;                 /*!< Length of the oldest frame which has been sent already */
 #endif
 };
 
@@ -100,6 +114,16 @@ struct httpd_req_aux {
         const char *value;
     } *resp_hdrs;                                   /*!< Additional headers in response packet */
     struct http_parser_url url_parse_res;           /*!< URL parsing result, used for retrieving URL elements */
+#if CONFIG_HTTPD_REQ_HDR_INDEX
+    unsigned        req_hdrs_indexed;               /*!< Count of the first request headers which are covered by the index */
+    uint8_t         req_hdr_entries;                /*!< Count of used entries of req_hdr_index */
+    struct req_hdr_entry {
+        uint16_t field;                             /*!< Offset of the field name in scratch */
+        uint16_t field_len;                         /*!< Length of the field name */
+        uint16_t hash;                              /*!< Case insensitive hash of the field name */
+    } req_hdr_index[CONFIG_HTTPD_REQ_HDR_INDEX_SIZE]; /*!< First header of each indexed field name */
+    uint8_t         req_hdr_slots[HTTPD_REQ_HDR_INDEX_SLOTS]; /*!< Hash table of req_hdr_index positions + 1, 0 if empty */
+#endif
 #ifdef CONFIG_HTTPD_WS_SUPPORT
     bool ws_handshake_detect;                       /*!< WebSocket handshake detection flag */
     httpd_ws_type_t ws_type;                        /*!< WebSocket frame type */
@@ -108,6 +132,16 @@ struct httpd_req_aux {
 #endif
 };
 
+/**
+ * @brief   Worker task which processes requests in parallel with the server task
+ */
+struct httpd_worker {
+    struct httpd_data *hd;                  /*!< Server instance data */
+    struct thread_data td;                  /*!< Information for the worker thread */
+    struct httpd_req req;                   /*!< The request processed by the worker */
+    struct httpd_req_aux req_aux;           /*!< Additional data about the request kept unexposed */
+};
+
 /**
  * @brief   Server data for each instance. This is exposed publicly as
  *          httpd_handle_t but internal structure/members are kept private.
@@ -124,8 +158,13 @@ struct httpd_data {
     struct sock_db *hd_sd;                  /*!< The socket database */
     int hd_sd_active_count;                 /*!< The number of the active sockets */
     httpd_uri_t **hd_calls;                 /*!< Registered URI handlers */
+    struct httpd_uri_router *hd_router;     /*!< Index of hd_calls for fast lookup, NULL if not available */
+    SemaphoreHandle_t hd_uri_lock;          /*!< Protects hd_calls and hd_router against concurrent lookups and updates */
     struct httpd_req hd_req;                /*!< The current HTTPD request */
     struct httpd_req_aux hd_req_aux;        /*!< Additional data about the HTTPD request kept unexposed */
+    struct httpd_worker *hd_workers;        /*!< Worker tasks, NULL if requests are processed by the server task */
+    QueueHandle_t hd_work_queue;            /*!< Sessions waiting to be processed by a worker task */
+    QueueHandle_t hd_done_queue;            /*!< Sessions handed back to the server task by the worker tasks */
     uint64_t lru_counter;                   /*!< LRU counter */
 
     /* Array of registered error handler functions */
@@ -199,7 +238,7 @@ void httpd_sess_init(struct httpd_data *hd);
 esp_err_t httpd_sess_new(struct httpd_data *hd, int newfd);
 
 /**
- * @brief   Processes incoming HTTP requests
+ * @brief   Processes incoming HTTP requests in the server task
  *
  * @param[in] hd      Server instance data
  * @param[in] session Session
@@ -210,6 +249,26 @@ esp_err_t httpd_sess_new(struct httpd_data *hd, int newfd);
  */
 esp_err_t httpd_sess_process(struct httpd_data *hd, struct sock_db *session);
 
+/**
+ * @brief   Receives, parses and responds to the requests of a session
+ *
+ * Processes one request. After that, requests which have already been
+ * received, because the client pipelines them, are processed back-to-back
+ * up to CONFIG_HTTPD_MAX_PIPELINED_REQS requests in total, without going
+ * through select() for each of them.
+ *
+ * @param[in] hd      Server instance data
+ * @param[in] session Session
+ * @param[in] r       Request storage to be used
+ * @param[in] ra      Auxiliary request storage to be used
+ *
+ * @return
+ *  - ESP_OK    : on successfully processing the requests
+ *  - ESP_FAIL  : in case of failure in any of the stages of processing
+ */
+esp_err_t httpd_sess_process_reqs(struct httpd_data *hd, struct sock_db *session,
+                                  httpd_req_t *r, struct httpd_req_aux *ra);
+
 /**
  * @brief   Remove client descriptor from the session / socket database
  *          and close the connection for this client.
@@ -307,12 +366,13 @@ void httpd_sess_close_all(struct httpd_data *hd);
  *          and invokes the appropriate one if found
  *
  * @param[in] hd  Server instance data for which handler needs to be invoked
+ * @param[in] req The parsed request
  *
  * @return
  *  - ESP_OK    : if handler found and executed successfully
  *  - ESP_FAIL  : otherwise
  */
-esp_err_t httpd_uri(struct httpd_data *hd);
+esp_err_t httpd_uri(struct httpd_data *hd, httpd_req_t *req);
 
 /**
  * @brief   Unregister all URI handlers
@@ -361,25 +421,27 @@ bool httpd_validate_req_ptr(httpd_req_t *r);
  * http_recv() after this reads the body of the request.
  *
  * @param[in] hd  Server instance data
+ * @param[in] r   Request to be filled, either the one of the server task or of a worker task
+ * @param[in] ra  Auxiliary data of the request
  * @param[in] sd  Pointer to socket which is needed for receiving TCP packets.
  *
  * @return
  *  - ESP_OK    : if request packet is valid
  *  - ESP_FAIL  : otherwise
  */
-esp_err_t httpd_req_new(struct httpd_data *hd, struct sock_db *sd);
+esp_err_t httpd_req_new(struct httpd_data *hd, httpd_req_t *r, struct httpd_req_aux *ra, struct sock_db *sd);
 
 /**
  * @brief   For an HTTP request, resets the resources allocated for it and
  *          purges any data left to be received
  *
- * @param[in] hd  Server instance data
+ * @param[in] r   The request, as filled by httpd_req_new()
  *
  * @return
  *  - ESP_OK    : if request packet deleted and resources cleaned.
  *  - ESP_FAIL  : otherwise.
  */
-esp_err_t httpd_req_delete(struct httpd_data *hd);
+esp_err_t httpd_req_delete(httpd_req_t *r);
 
 /**
  * @brief   For handling HTTP errors by invoking registered
@@ -532,6 +594,31 @@ esp_err_t httpd_ws_respond_server_handshake(httpd_req_t *req, const char *suppor
  */
 esp_err_t httpd_ws_get_frame_type(httpd_req_t *req);
 
+/**
+ * @brief   Adds the sockets with queued broadcast frames to a select() write set
+ *
+ * @param[in]  hd       Server instance data
+ * @param[out] fdset    Write set, cleared first
+ * @param[out] maxfd    Highest socket added, -1 if none
+ */
+void httpd_ws_bcast_set_descriptors(struct httpd_data *hd, fd_set *fdset, int *maxfd);
+
+/**
+ * @brief   Sends the queued broadcast frames of the sockets which select()
+ *          reported as writable, closing sockets on which sending fails
+ *
+ * @param[in] hd        Server instance data
+ * @param[in] fdset     Write set returned by select()
+ */
+void httpd_ws_bcast_flush_ready(struct httpd_data *hd, fd_set *fdset);
+
+/**
+ * @brief   Releases the queued broadcast frames of a session
+ *
+ * @param[in] session   Session being closed
+ */
+void httpd_ws_bcast_clear(struct sock_db *session);
+
 /**
  * @brief   Trigger an httpd session close externally
  *
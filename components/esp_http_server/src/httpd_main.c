@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -36,6 +36,11 @@ typedef struct {
     struct httpd_data *hd;
 } process_session_context_t;
 
+typedef struct {
+    struct httpd_data *hd;
+    bool pending;
+} pending_session_context_t;
+
 static const char *TAG = "httpd";
 
 ESP_EVENT_DEFINE_BASE(ESP_HTTP_SERVER_EVENT);
@@ -137,6 +142,7 @@ struct httpd_ctrl_data {
     enum httpd_ctrl_msg {
         HTTPD_CTRL_SHUTDOWN,
         HTTPD_CTRL_WORK,
+        HTTPD_CTRL_WORKER_DONE,
     } hc_msg;
     httpd_work_fn_t hc_work;
     void *hc_work_arg;
@@ -205,6 +211,10 @@ void *httpd_get_global_transport_ctx(httpd_handle_t handle)
 }
 
 
+#if !CONFIG_IDF_TARGET_LINUX
+static void httpd_workers_collect(struct httpd_data *hd);
+#endif
+
 static void httpd_process_ctrl_msg(struct httpd_data *hd)
 {
     struct httpd_ctrl_data msg;
@@ -235,6 +245,12 @@ static void httpd_process_ctrl_msg(struct httpd_data *hd)
         ESP_LOGD(TAG, LOG_FMT("shutdown"));
         hd->hd_td.status = THREAD_STOPPING;
         break;
+#if !CONFIG_IDF_TARGET_LINUX
+    case HTTPD_CTRL_WORKER_DONE:
+        /* Only a wakeup, sent without taking the semaphore */
+        httpd_workers_collect(hd);
+        return;
+#endif
     default:
         break;
     }
@@ -243,6 +259,161 @@ static void httpd_process_ctrl_msg(struct httpd_data *hd)
 #endif
 }
 
+#if !CONFIG_IDF_TARGET_LINUX
+/* Runs in the server task once a worker task is done with a session */
+static void httpd_worker_done(void *arg)
+{
+    struct sock_db *session = (struct sock_db *) arg;
+    struct httpd_data *hd = (struct httpd_data *) session->handle;
+
+    session->in_worker = false;
+    if (session->worker_ret != ESP_OK || session->close_after_worker) {
+        session->close_after_worker = false;
+        httpd_sess_delete(hd, session);
+        return;
+    }
+    session->lru_counter = ++hd->lru_counter;
+}
+
+#define HTTPD_WORKER_WAKEUP_RETRIES     10
+#define HTTPD_WORKER_WAKEUP_RETRY_MS    10
+
+/* Wakes up the server task to collect the sessions handed back. The control socket
+ * semaphore isn't taken, so that a worker never waits for a server task which may be
+ * waiting for the workers to exit. */
+static void httpd_worker_wakeup(struct httpd_data *hd)
+{
+    struct httpd_ctrl_data msg = {
+        .hc_msg = HTTPD_CTRL_WORKER_DONE,
+    };
+    for (int i = 0; i < HTTPD_WORKER_WAKEUP_RETRIES; i++) {
+        if (cs_send_to_ctrl_sock(hd->msg_fd, hd->config.ctrl_port, &msg, sizeof(msg)) >= 0) {
+            return;
+        }
+        httpd_os_thread_sleep(HTTPD_WORKER_WAKEUP_RETRY_MS);
+    }
+    /* The session is collected at the next activity of the server task */
+    ESP_LOGW(TAG, LOG_FMT("failed to wake up the server task"));
+}
+
+/* Runs in the server task, takes back the sessions the worker tasks are done with */
+static void httpd_workers_collect(struct httpd_data *hd)
+{
+    struct sock_db *session;
+    if (hd->hd_done_queue == NULL) {
+        return;
+    }
+    while (xQueueReceive(hd->hd_done_queue, &session, 0) == pdTRUE) {
+        httpd_worker_done(session);
+    }
+}
+
+/* A worker task, processes the sessions handed over by the server task */
+static void httpd_worker_thread(void *arg)
+{
+    struct httpd_worker *worker = (struct httpd_worker *) arg;
+    struct httpd_data *hd = worker->hd;
+    struct sock_db *session;
+
+    worker->td.status = THREAD_RUNNING;
+    while (xQueueReceive(hd->hd_work_queue, &session, portMAX_DELAY) == pdTRUE) {
+        /* A NULL session asks the worker to exit */
+        if (session == NULL) {
+            break;
+        }
+        ESP_LOGD(TAG, LOG_FMT("processing socket %d"), session->fd);
+        session->worker_ret = httpd_sess_process_reqs(hd, session, &worker->req, &worker->req_aux);
+        /* Give the session back to the server task, which adds it to the select() set
+         * again or deletes it on failure. The queue has room for every session. */
+        xQueueSend(hd->hd_done_queue, &session, portMAX_DELAY);
+        httpd_worker_wakeup(hd);
+    }
+    worker->td.status = THREAD_STOPPED;
+    httpd_os_thread_delete();
+}
+
+static esp_err_t httpd_workers_start(struct httpd_data *hd)
+{
+    /* Each session is queued at most once, and each worker gets one exit message */
+    hd->hd_work_queue = xQueueCreate(hd->config.max_open_sockets + hd->config.worker_count, sizeof(struct sock_db *));
+    hd->hd_done_queue = xQueueCreate(hd->config.max_open_sockets, sizeof(struct sock_db *));
+    if (hd->hd_work_queue == NULL || hd->hd_done_queue == NULL) {
+        ESP_LOGE(TAG, LOG_FMT("Failed to create work queue"));
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+
+    for (int i = 0; i < hd->config.worker_count; i++) {
+        struct httpd_worker *worker = &hd->hd_workers[i];
+        BaseType_t core_id = hd->config.worker_core_id;
+        if (core_id == tskNO_AFFINITY) {
+            core_id = i % portNUM_PROCESSORS;
+        }
+        worker->hd = hd;
+        if (httpd_os_thread_create(&worker->td.handle, "httpd_worker",
+                                   hd->config.worker_stack_size,
+                                   hd->config.task_priority,
+                                   httpd_worker_thread, worker,
+                                   core_id,
+                                   hd->config.task_caps) != ESP_OK) {
+            ESP_LOGE(TAG, LOG_FMT("Failed to launch worker task %d"), i);
+            worker->td.handle = NULL;
+            return ESP_ERR_HTTPD_TASK;
+        }
+    }
+    return ESP_OK;
+}
+
+/* Runs the control messages which are already received, without waiting for more */
+static void httpd_drain_ctrl_msgs(struct httpd_data *hd)
+{
+    while (1) {
+        fd_set ctrl_set;
+        struct timeval no_wait = {};
+        FD_ZERO(&ctrl_set);
+        FD_SET(hd->ctrl_fd, &ctrl_set);
+        if (select(hd->ctrl_fd + 1, &ctrl_set, NULL, NULL, &no_wait) <= 0) {
+            break;
+        }
+        httpd_process_ctrl_msg(hd);
+    }
+}
+
+/* Asks the worker tasks to exit and waits for them. A worker finishes the
+ * request it is processing first, so this can take up to the socket timeouts. */
+static void httpd_workers_stop(struct httpd_data *hd)
+{
+    /* Without both queues, no worker task has been started */
+    if (hd->hd_work_queue && hd->hd_done_queue) {
+        struct sock_db *stop = NULL;
+        for (int i = 0; i < hd->config.worker_count; i++) {
+            if (hd->hd_workers[i].td.handle) {
+                xQueueSend(hd->hd_work_queue, &stop, portMAX_DELAY);
+            }
+        }
+        for (int i = 0; i < hd->config.worker_count; i++) {
+            while (hd->hd_workers[i].td.handle && hd->hd_workers[i].td.status != THREAD_STOPPED) {
+                /* A handler of a worker may be waiting to queue work to this task, e.g. with
+                 * CONFIG_HTTPD_QUEUE_WORK_BLOCKING, so keep receiving the control messages */
+                httpd_drain_ctrl_msgs(hd);
+                httpd_workers_collect(hd);
+                httpd_os_thread_sleep(10);
+            }
+        }
+        httpd_drain_ctrl_msgs(hd);
+        httpd_workers_collect(hd);
+    }
+
+    if (hd->hd_work_queue) {
+        vQueueDelete(hd->hd_work_queue);
+        hd->hd_work_queue = NULL;
+    }
+    if (hd->hd_done_queue) {
+        vQueueDelete(hd->hd_done_queue);
+        hd->hd_done_queue = NULL;
+    }
+}
+#endif // !CONFIG_IDF_TARGET_LINUX
+
 // Called for each session from httpd_server
 static int httpd_process_session(struct sock_db *session, void *context)
 {
@@ -254,8 +425,8 @@ static int httpd_process_session(struct sock_db *session, void *context)
         return 1;
     }
 
-    // session is busy in an async task, do not process here.
-    if (session->for_async_req) {
+    // session is busy in an async task or a worker, do not process here.
+    if (session->for_async_req || session->in_worker) {
         return 1;
     }
 
@@ -263,6 +434,18 @@ static int httpd_process_session(struct sock_db *session, void *context)
     int fd = session->fd;
 
     if (FD_ISSET(fd, ctx->fdset) || httpd_sess_pending(ctx->hd, session)) {
+#if !CONFIG_IDF_TARGET_LINUX
+        if (ctx->hd->hd_work_queue) {
+            ESP_LOGD(TAG, LOG_FMT("handing socket %d to a worker"), fd);
+            session->in_worker = true;
+            if (xQueueSend(ctx->hd->hd_work_queue, &session, 0) == pdTRUE) {
+                return 1;
+            }
+            /* Cannot happen as the queue has room for every session, but
+             * processing the request here is always safe */
+            session->in_worker = false;
+        }
+#endif
         ESP_LOGD(TAG, LOG_FMT("processing socket %d"), fd);
         if (httpd_sess_process(ctx->hd, session) != ESP_OK) {
             httpd_sess_delete(ctx->hd, session); // Delete session
@@ -271,9 +454,26 @@ static int httpd_process_session(struct sock_db *session, void *context)
     return 1;
 }
 
+// Called for each session from httpd_server, stops the enumeration at a session with received data to process
+static int httpd_find_pending_session(struct sock_db *session, void *context)
+{
+    pending_session_context_t *ctx = (pending_session_context_t *)context;
+
+    if (session->fd < 0 || session->for_async_req || session->in_worker) {
+        return 1;
+    }
+    ctx->pending = httpd_sess_pending(ctx->hd, session);
+    return !ctx->pending;
+}
+
 /* Manage in-coming connection or data requests */
 static esp_err_t httpd_server(struct httpd_data *hd)
 {
+#if !CONFIG_IDF_TARGET_LINUX
+    /* Sessions handed back by the workers whose wakeup got lost */
+    httpd_workers_collect(hd);
+#endif
+
     fd_set read_set;
     FD_ZERO(&read_set);
     if (hd->config.lru_purge_enable || httpd_is_sess_available(hd)) {
@@ -290,8 +490,28 @@ static esp_err_t httpd_server(struct httpd_data *hd)
     tmp_max_fd = maxfd;
     maxfd = MAX(hd->ctrl_fd, tmp_max_fd);
 
+    /* Data of a session may already be received, e.g. pipelined requests which were
+     * left over after the last round. Only poll the sockets then, and process it. */
+    struct timeval no_wait = {};
+    pending_session_context_t pending_ctx = {
+        .hd = hd,
+        .pending = false
+    };
+    httpd_sess_enum(hd, httpd_find_pending_session, &pending_ctx);
+
+    fd_set *write_set_ptr = NULL;
+#ifdef CONFIG_HTTPD_WS_SUPPORT
+    /* Wait for sockets with queued broadcast frames to take more data as well */
+    fd_set write_set;
+    httpd_ws_bcast_set_descriptors(hd, &write_set, &tmp_max_fd);
+    if (tmp_max_fd >= 0) {
+        write_set_ptr = &write_set;
+        maxfd = MAX(maxfd, tmp_max_fd);
+    }
+#endif
+
     ESP_LOGD(TAG, LOG_FMT("doing select maxfd+1 = %d"), maxfd + 1);
-    int active_cnt = select(maxfd + 1, &read_set, NULL, NULL, NULL);
+    int active_cnt = select(maxfd + 1, &read_set, write_set_ptr, NULL, pending_ctx.pending ? &no_wait : NULL);
     if (active_cnt < 0) {
         ESP_LOGE(TAG, LOG_FMT("error in select (%d)"), errno);
         httpd_sess_delete_invalid(hd);
@@ -308,6 +528,12 @@ static esp_err_t httpd_server(struct httpd_data *hd)
         }
     }
 
+#ifdef CONFIG_HTTPD_WS_SUPPORT
+    if (write_set_ptr) {
+        httpd_ws_bcast_flush_ready(hd, write_set_ptr);
+    }
+#endif
+
     /* Case1: Do we have any activity on the current data
      * sessions? */
     process_session_context_t context = {
@@ -343,6 +569,10 @@ static void httpd_thread(void *arg)
     }
 
     ESP_LOGD(TAG, LOG_FMT("web server exiting"));
+#if !CONFIG_IDF_TARGET_LINUX
+    /* The workers use the control socket, stop them before closing it */
+    httpd_workers_stop(hd);
+#endif
     close(hd->msg_fd);
     cs_free_ctrl_sock(hd->ctrl_fd);
     httpd_sess_close_all(hd);
@@ -422,6 +652,26 @@ static esp_err_t httpd_server_init(struct httpd_data *hd)
     return ESP_OK;
 }
 
+static void httpd_delete(struct httpd_data *hd);
+
+#if !CONFIG_IDF_TARGET_LINUX
+static esp_err_t httpd_create_workers(struct httpd_data *hd)
+{
+    hd->hd_workers = calloc(hd->config.worker_count, sizeof(struct httpd_worker));
+    if (!hd->hd_workers) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (int i = 0; i < hd->config.worker_count; i++) {
+        struct httpd_req_aux *ra = &hd->hd_workers[i].req_aux;
+        ra->resp_hdrs = calloc(hd->config.max_resp_headers, sizeof(struct resp_hdr));
+        if (!ra->resp_hdrs) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    return ESP_OK;
+}
+#endif
+
 static struct httpd_data *httpd_create(const httpd_config_t *config)
 {
     /* Allocate memory for httpd instance data */
@@ -463,6 +713,26 @@ static struct httpd_data *httpd_create(const httpd_config_t *config)
     }
     /* Save the configuration for this instance */
     hd->config = *config;
+    /* URI handlers may be (un)registered by any task, while requests are being
+     * matched by the server task or the worker tasks */
+    hd->hd_uri_lock = xSemaphoreCreateMutex();
+    if (!hd->hd_uri_lock) {
+        ESP_LOGE(TAG, LOG_FMT("Failed to create URI handlers lock"));
+        httpd_delete(hd);
+        return NULL;
+    }
+    if (config->worker_count) {
+#if CONFIG_IDF_TARGET_LINUX
+        ESP_LOGW(TAG, LOG_FMT("Worker tasks are not supported on linux, requests are processed by the server task"));
+        hd->config.worker_count = 0;
+#else
+        if (httpd_create_workers(hd) != ESP_OK) {
+            ESP_LOGE(TAG, LOG_FMT("Failed to allocate memory for HTTP worker tasks"));
+            httpd_delete(hd);
+            return NULL;
+        }
+#endif
+    }
     return hd;
 }
 
@@ -470,6 +740,12 @@ static void httpd_delete(struct httpd_data *hd)
 {
     struct httpd_req_aux *ra = &hd->hd_req_aux;
     /* Free memory of httpd instance data */
+    if (hd->hd_workers) {
+        for (int i = 0; i < hd->config.worker_count; i++) {
+            free(hd->hd_workers[i].req_aux.resp_hdrs);
+        }
+        free(hd->hd_workers);
+    }
     free(hd->err_handler_fns);
     free(ra->resp_hdrs);
     free(hd->hd_sd);
@@ -477,6 +753,9 @@ static void httpd_delete(struct httpd_data *hd)
     /* Free registered URI handlers */
     httpd_unregister_all_uri_handlers(hd);
     free(hd->hd_calls);
+    if (hd->hd_uri_lock) {
+        vSemaphoreDelete(hd->hd_uri_lock);
+    }
     free(hd);
 }
 
@@ -527,6 +806,13 @@ esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
     }
 
     httpd_sess_init(hd);
+#if !CONFIG_IDF_TARGET_LINUX
+    if (hd->hd_workers && httpd_workers_start(hd) != ESP_OK) {
+        httpd_workers_stop(hd);
+        httpd_delete(hd);
+        return ESP_ERR_HTTPD_TASK;
+    }
+#endif
     if (httpd_os_thread_create(&hd->hd_td.handle, "httpd",
                                hd->config.stack_size,
                                hd->config.task_priority,
@@ -534,6 +820,9 @@ esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
                                hd->config.core_id,
                                hd->config.task_caps) != ESP_OK) {
         /* Failed to launch task */
+#if !CONFIG_IDF_TARGET_LINUX
+        httpd_workers_stop(hd);
+#endif
         httpd_delete(hd);
         return ESP_ERR_HTTPD_TASK;
     }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,6 +7,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <sys/param.h>
 #include <esp_log.h>
 #include <esp_err.h>
@@ -54,6 +55,60 @@ typedef struct {
     size_t raw_datalen;     /*!< Full length of the raw data in scratch buffer */
 } parser_data_t;
 
+#if CONFIG_HTTPD_REQ_HDR_INDEX
+_Static_assert(HTTPD_SCRATCH_BUF <= UINT16_MAX, "Header offsets of the index must fit the scratch buffer");
+_Static_assert(HTTPD_REQ_HDR_INDEX_SLOTS >= 2 * CONFIG_HTTPD_REQ_HDR_INDEX_SIZE, "Header hash table is too small");
+
+/* Case insensitive FNV-1a hash of a header field name, folded to 16 bits */
+static uint16_t hdr_field_hash(const char *field, size_t len)
+{
+    uint32_t hash = 2166136261U;
+    while (len--) {
+        hash = (hash ^ (uint8_t)tolower((unsigned char)*field++)) * 16777619U;
+    }
+    return (uint16_t)(hash ^ (hash >> 16));
+}
+
+/* Looks up the hash table slot of a field name, returns the slot holding
+ * the field, or the empty slot where it would be added */
+static unsigned hdr_index_slot(const struct httpd_req_aux *ra, const char *field, size_t len, uint16_t hash)
+{
+    unsigned slot = hash & (HTTPD_REQ_HDR_INDEX_SLOTS - 1);
+    while (ra->req_hdr_slots[slot]) {
+        const struct req_hdr_entry *entry = &ra->req_hdr_index[ra->req_hdr_slots[slot] - 1];
+        if (entry->hash == hash && entry->field_len == len &&
+                !strncasecmp(ra->scratch + entry->field, field, len)) {
+            break;
+        }
+        slot = (slot + 1) & (HTTPD_REQ_HDR_INDEX_SLOTS - 1);
+    }
+    return slot;
+}
+
+/* Adds the header being parsed to the index. Only the first header of each
+ * field name is kept, as it is the one found by the lookup functions. Once
+ * the index is full, the following headers aren't covered anymore. */
+static void hdr_index_add(struct httpd_req_aux *ra, const char *field, size_t len)
+{
+    if (ra->req_hdrs_indexed != ra->req_hdrs_count) {
+        return;
+    }
+    uint16_t hash = hdr_field_hash(field, len);
+    unsigned slot = hdr_index_slot(ra, field, len, hash);
+    if (!ra->req_hdr_slots[slot]) {
+        if (ra->req_hdr_entries == CONFIG_HTTPD_REQ_HDR_INDEX_SIZE) {
+            return;
+        }
+        struct req_hdr_entry *entry = &ra->req_hdr_index[ra->req_hdr_entries++];
+        entry->field = field - ra->scratch;
+        entry->field_len = len;
+        entry->hash = hash;
+        ra->req_hdr_slots[slot] = ra->req_hdr_entries;
+    }
+    ra->req_hdrs_indexed++;
+}
+#endif /* CONFIG_HTTPD_REQ_HDR_INDEX */
+
 static esp_err_t verify_url (http_parser *parser)
 {
     parser_data_t *parser_data  = (parser_data_t *) parser->data;
@@ -258,6 +313,10 @@ static esp_err_t cb_header_value(http_parser *parser, const char *at, size_t len
 
     /* Check previous status */
     if (parser_data->status == PARSING_HDR_FIELD) {
+#if CONFIG_HTTPD_REQ_HDR_INDEX
+        /* The field name is complete, it is followed by ':' in scratch */
+        hdr_index_add(parser_data->req->aux, parser_data->last.at, parser_data->last.length);
+#endif
         /* Store current values of the parser callback arguments */
         parser_data->last.at     = at;
         parser_data->last.length = 0;
@@ -618,9 +677,8 @@ static void parse_init(httpd_req_t *r, http_parser *parser, parser_data_t *data)
 
 /* Function that receives TCP data and runs parser on it
  */
-static esp_err_t httpd_parse_req(struct httpd_data *hd)
+static esp_err_t httpd_parse_req(struct httpd_data *hd, httpd_req_t *r)
 {
-    httpd_req_t *r = &hd->hd_req;
     int blk_len,  offset;
     http_parser   parser = {};
     parser_data_t parser_data = {};
@@ -660,7 +718,7 @@ static esp_err_t httpd_parse_req(struct httpd_data *hd)
     } while (parser_data.status != PARSING_COMPLETE);
 
     ESP_LOGD(TAG, LOG_FMT("parsing complete"));
-    return httpd_uri(hd);
+    return httpd_uri(hd, r);
 }
 
 static void init_req(httpd_req_t *r, httpd_config_t *config)
@@ -686,6 +744,11 @@ static void init_req_aux(struct httpd_req_aux *ra, httpd_config_t *config)
     ra->first_chunk_sent = 0;
     ra->req_hdrs_count = 0;
     ra->resp_hdrs_count = 0;
+#if CONFIG_HTTPD_REQ_HDR_INDEX
+    ra->req_hdrs_indexed = 0;
+    ra->req_hdr_entries = 0;
+    memset(ra->req_hdr_slots, 0, sizeof(ra->req_hdr_slots));
+#endif
 #if CONFIG_HTTPD_WS_SUPPORT
     ra->ws_handshake_detect = false;
 #endif
@@ -724,16 +787,14 @@ static void httpd_req_cleanup(httpd_req_t *r)
 /* Function that processes incoming TCP data and
  * updates the http request data httpd_req_t
  */
-esp_err_t httpd_req_new(struct httpd_data *hd, struct sock_db *sd)
+esp_err_t httpd_req_new(struct httpd_data *hd, httpd_req_t *r, struct httpd_req_aux *ra, struct sock_db *sd)
 {
-    httpd_req_t *r = &hd->hd_req;
     init_req(r, &hd->config);
-    init_req_aux(&hd->hd_req_aux, &hd->config);
+    init_req_aux(ra, &hd->config);
     r->handle = hd;
-    r->aux = &hd->hd_req_aux;
+    r->aux = ra;
 
     /* Associate the request to the socket */
-    struct httpd_req_aux *ra = r->aux;
     ra->sd = sd;
 
     /* Set defaults */
@@ -788,7 +849,7 @@ esp_err_t httpd_req_new(struct httpd_data *hd, struct sock_db *sd)
 #endif
 
     /* Parse request */
-    ret = httpd_parse_req(hd);
+    ret = httpd_parse_req(hd, r);
     if (ret != ESP_OK) {
         httpd_req_cleanup(r);
     }
@@ -797,9 +858,8 @@ esp_err_t httpd_req_new(struct httpd_data *hd, struct sock_db *sd)
 
 /* Function that resets the http request data
  */
-esp_err_t httpd_req_delete(struct httpd_data *hd)
+esp_err_t httpd_req_delete(httpd_req_t *r)
 {
-    httpd_req_t *r = &hd->hd_req;
     struct httpd_req_aux *ra = r->aux;
 
     /* Finish off reading any pending/leftover data */
@@ -839,10 +899,16 @@ bool httpd_validate_req_ptr(httpd_req_t *r)
         struct httpd_data *hd = (struct httpd_data *) r->handle;
         if (hd) {
             /* Check if this function is running in the context of
-             * the correct httpd server thread */
-            if (httpd_os_thread_handle() == hd->hd_td.handle) {
+             * the correct httpd server thread, or of one of its workers */
+            othread_t current = httpd_os_thread_handle();
+            if (current == hd->hd_td.handle) {
                 return true;
             }
+            for (int i = 0; hd->hd_workers && i < hd->config.worker_count; i++) {
+                if (current == hd->hd_workers[i].td.handle) {
+                    return true;
+                }
+            }
         }
     }
     return false;
@@ -956,36 +1022,45 @@ esp_err_t httpd_req_get_url_query_str(httpd_req_t *r, char *buf, size_t buf_len)
     return ESP_ERR_NOT_FOUND;
 }
 
-/* Get the length of the value string of a header request field */
-size_t httpd_req_get_hdr_value_len(httpd_req_t *r, const char *field)
+/* Find the first request header with the given field name and return
+ * its value, without the preceding spaces, or NULL if there is none */
+static const char *httpd_req_find_hdr_value(struct httpd_req_aux *ra, const char *field)
 {
-    if (r == NULL || field == NULL) {
-        return 0;
-    }
+    const char   *hdr_ptr   = ra->scratch;         /*!< Request headers are kept in scratch buffer */
+    unsigned      count     = ra->req_hdrs_count;  /*!< Count set during parsing  */
+    const size_t  field_len = strlen(field);
+    const char   *val_ptr   = NULL;
 
-    if (!httpd_valid_req(r)) {
-        return 0;
+    if (count == 0) {
+        return NULL;
     }
 
-    struct httpd_req_aux *ra = r->aux;
-    const char   *hdr_ptr = ra->scratch;         /*!< Request headers are kept in scratch buffer */
-    unsigned      count   = ra->req_hdrs_count;  /*!< Count set during parsing  */
+#if CONFIG_HTTPD_REQ_HDR_INDEX
+    unsigned slot = hdr_index_slot(ra, field, field_len, hdr_field_hash(field, field_len));
+    if (ra->req_hdr_slots[slot]) {
+        val_ptr = ra->scratch + ra->req_hdr_index[ra->req_hdr_slots[slot] - 1].field + field_len;
+    } else if (ra->req_hdrs_indexed == count) {
+        /* All the headers are covered by the index */
+        return NULL;
+    }
+#endif
 
-    while (count--) {
+    while (!val_ptr && count--) {
         /* Search for the ':' character. Else, it would mean
          * that the field is invalid
          */
-        const char *val_ptr = strchr(hdr_ptr, ':');
+        val_ptr = strchr(hdr_ptr, ':');
         if (!val_ptr) {
-            break;
+            return NULL;
         }
 
         /* If the field, does not match, continue searching.
          * Compare lengths first as field from header is not
          * null terminated (has ':' in the end).
          */
-        if ((val_ptr - hdr_ptr != strlen(field)) ||
-            (strncasecmp(hdr_ptr, field, strlen(field)))) {
+        if ((val_ptr - hdr_ptr != field_len) ||
+            (strncasecmp(hdr_ptr, field, field_len))) {
+            val_ptr = NULL;
             if (count) {
                 /* Jump to end of header field-value string */
                 hdr_ptr = 1 + strchr(hdr_ptr, '\0');
@@ -996,19 +1071,35 @@ size_t httpd_req_get_hdr_value_len(httpd_req_t *r, const char *field)
                     hdr_ptr++;
                 }
             }
-            continue;
         }
+    }
+    if (!val_ptr) {
+        return NULL;
+    }
+
+    /* Skip ':' */
+    val_ptr++;
 
-        /* Skip ':' */
+    /* Skip preceding space */
+    while ((*val_ptr != '\0') && (*val_ptr == ' ')) {
         val_ptr++;
+    }
+    return val_ptr;
+}
 
-        /* Skip preceding space */
-        while ((*val_ptr != '\0') && (*val_ptr == ' ')) {
-            val_ptr++;
-        }
-        return strlen(val_ptr);
+/* Get the length of the value string of a header request field */
+size_t httpd_req_get_hdr_value_len(httpd_req_t *r, const char *field)
+{
+    if (r == NULL || field == NULL) {
+        return 0;
     }
-    return 0;
+
+    if (!httpd_valid_req(r)) {
+        return 0;
+    }
+
+    const char *val_ptr = httpd_req_find_hdr_value(r->aux, field);
+    return val_ptr ? strlen(val_ptr) : 0;
 }
 
 /* Get the value of a field from the request headers */
@@ -1022,60 +1113,23 @@ esp_err_t httpd_req_get_hdr_value_str(httpd_req_t *r, const char *field, char *v
         return ESP_ERR_HTTPD_INVALID_REQ;
     }
 
-    struct httpd_req_aux *ra = r->aux;
-    const char   *hdr_ptr = ra->scratch;         /*!< Request headers are kept in scratch buffer */
-    unsigned     count    = ra->req_hdrs_count;  /*!< Count set during parsing  */
-    const size_t buf_len  = val_size;
-
-    while (count--) {
-        /* Search for the ':' character. Else, it would mean
-         * that the field is invalid
-         */
-        const char *val_ptr = strchr(hdr_ptr, ':');
-        if (!val_ptr) {
-            break;
-        }
-
-        /* If the field, does not match, continue searching.
-         * Compare lengths first as field from header is not
-         * null terminated (has ':' in the end).
-         */
-        if ((val_ptr - hdr_ptr != strlen(field)) ||
-            (strncasecmp(hdr_ptr, field, strlen(field)))) {
-            if (count) {
-                /* Jump to end of header field-value string */
-                hdr_ptr = 1 + strchr(hdr_ptr, '\0');
-
-                /* Skip all null characters (with which the line
-                 * terminators had been overwritten) */
-                while (*hdr_ptr == '\0') {
-                    hdr_ptr++;
-                }
-            }
-            continue;
-        }
-
-        /* Skip ':' */
-        val_ptr++;
-
-        /* Skip preceding space */
-        while ((*val_ptr != '\0') && (*val_ptr == ' ')) {
-            val_ptr++;
-        }
+    const size_t buf_len = val_size;
+    const char *val_ptr = httpd_req_find_hdr_value(r->aux, field);
+    if (!val_ptr) {
+        return ESP_ERR_NOT_FOUND;
+    }
 
-        /* Get the NULL terminated value and copy it to the caller's buffer. */
-        strlcpy(val, val_ptr, buf_len);
+    /* Get the NULL terminated value and copy it to the caller's buffer. */
+    strlcpy(val, val_ptr, buf_len);
 
-        /* Update value length, including one byte for null */
-        val_size = strlen(val_ptr) + 1;
+    /* Update value length, including one byte for null */
+    val_size = strlen(val_ptr) + 1;
 
-        /* If buffer length is smaller than needed, return truncation error */
-        if (buf_len < val_size) {
-            return ESP_ERR_HTTPD_RESULT_TRUNC;
-        }
-        return ESP_OK;
+    /* If buffer length is smaller than needed, return truncation error */
+    if (buf_len < val_size) {
+        return ESP_ERR_HTTPD_RESULT_TRUNC;
     }
-    return ESP_ERR_NOT_FOUND;
+    return ESP_OK;
 }
 
 /* Helper function to get a cookie value from a cookie string of the type "cookie1=val1; cookie2=val2" */
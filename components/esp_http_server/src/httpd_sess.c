@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -88,7 +88,7 @@ static int enum_function(struct sock_db *session, void *context)
         break;
     // Set descriptor
     case HTTPD_TASK_SET_DESCRIPTOR:
-        if (session->fd != -1 && !session->for_async_req) {
+        if (session->fd != -1 && !session->for_async_req && !session->in_worker) {
             FD_SET(session->fd, ctx->fdset);
             if (session->fd > ctx->max_fd) {
                 ctx->max_fd = session->fd;
@@ -97,7 +97,7 @@ static int enum_function(struct sock_db *session, void *context)
         break;
     // Delete invalid session
     case HTTPD_TASK_DELETE_INVALID:
-        if (!fd_is_valid(session->fd)) {
+        if (!session->in_worker && !fd_is_valid(session->fd)) {
             ESP_LOGW(TAG, LOG_FMT("Closing invalid socket %d"), session->fd);
             httpd_sess_delete(ctx->hd, session);
         }
@@ -109,7 +109,7 @@ static int enum_function(struct sock_db *session, void *context)
             return 0;
         }
         // Only close sockets that are not in use
-        if (session->for_async_req == false) {
+        if (session->for_async_req == false && session->in_worker == false) {
             // Check/update lowest lru
             if (session->lru_counter < ctx->lru_counter) {
                 ctx->lru_counter = session->lru_counter;
@@ -140,6 +140,11 @@ static void httpd_sess_close(void *arg)
         return;
     }
 
+    if (sock_db->in_worker) {
+        // The worker task may still use the session, it is closed when the worker is done
+        sock_db->close_after_worker = true;
+        return;
+    }
     if (!sock_db->lru_counter && !sock_db->lru_socket) {
         ESP_LOGD(TAG, "Skipping session close for %d as it seems to be a race condition", sock_db->fd);
         return;
@@ -149,6 +154,20 @@ static void httpd_sess_close(void *arg)
     httpd_sess_delete(hd, sock_db);
 }
 
+// Returns the request being processed on the session, or NULL if there is none
+static httpd_req_t *httpd_sess_get_req(struct httpd_data *hd, struct sock_db *session)
+{
+    if (hd->hd_req_aux.sd == session) {
+        return &hd->hd_req;
+    }
+    for (int i = 0; hd->hd_workers && i < hd->config.worker_count; i++) {
+        if (hd->hd_workers[i].req_aux.sd == session) {
+            return &hd->hd_workers[i].req;
+        }
+    }
+    return NULL;
+}
+
 struct sock_db *httpd_sess_get_free(struct httpd_data *hd)
 {
     if ((!hd) || (hd->hd_sd_active_count == hd->config.max_open_sockets)) {
@@ -174,8 +193,9 @@ struct sock_db *httpd_sess_get(struct httpd_data *hd, int sockfd)
 
     // Check if called inside a request handler, and the session sockfd in use is same as the parameter
     // => Just return the pointer to the sock_db corresponding to the request
-    if ((hd->hd_req_aux.sd) && (hd->hd_req_aux.sd->fd == sockfd)) {
-        return hd->hd_req_aux.sd;
+    struct sock_db *req_sd = hd->hd_req_aux.sd;
+    if ((req_sd) && (req_sd->fd == sockfd)) {
+        return req_sd;
     }
 
     enum_context_t context = {
@@ -268,9 +288,9 @@ void *httpd_sess_get_ctx(httpd_handle_t handle, int sockfd)
     // Check if the function has been called from inside a
     // request handler, in which case fetch the context from
     // the httpd_req_t structure
-    struct httpd_data *hd = (struct httpd_data *) handle;
-    if (hd->hd_req_aux.sd == session) {
-        return hd->hd_req.sess_ctx;
+    httpd_req_t *req = httpd_sess_get_req((struct httpd_data *) handle, session);
+    if (req) {
+        return req->sess_ctx;
     }
     return session->ctx;
 }
@@ -285,17 +305,17 @@ void httpd_sess_set_ctx(httpd_handle_t handle, int sockfd, void *ctx, httpd_free
     // Check if the function has been called from inside a
     // request handler, in which case set the context inside
     // the httpd_req_t structure
-    struct httpd_data *hd = (struct httpd_data *) handle;
-    if (hd->hd_req_aux.sd == session) {
-        if (hd->hd_req.sess_ctx != ctx) {
+    httpd_req_t *req = httpd_sess_get_req((struct httpd_data *) handle, session);
+    if (req) {
+        if (req->sess_ctx != ctx) {
             // Don't free previous context if it is in sockdb
             // as it will be freed inside httpd_req_cleanup()
-            if (session->ctx != hd->hd_req.sess_ctx) {
-                httpd_sess_free_ctx(&hd->hd_req.sess_ctx, hd->hd_req.free_ctx); // Free previous context
+            if (session->ctx != req->sess_ctx) {
+                httpd_sess_free_ctx(&req->sess_ctx, req->free_ctx); // Free previous context
             }
-            hd->hd_req.sess_ctx = ctx;
+            req->sess_ctx = ctx;
         }
-        hd->hd_req.free_ctx = free_fn;
+        req->free_ctx = free_fn;
         return;
     }
 
@@ -378,6 +398,9 @@ void httpd_sess_delete(struct httpd_data *hd, struct sock_db *session)
 
     // clear all contexts
     httpd_sess_clear_ctx(session);
+#ifdef CONFIG_HTTPD_WS_SUPPORT
+    httpd_ws_bcast_clear(session);
+#endif
 
     // mark session slot as available
     session->fd = -1;
@@ -417,21 +440,39 @@ bool httpd_sess_pending(struct httpd_data *hd, struct sock_db *session)
  * value is returned, everything related to this socket will be
  * cleaned up and the socket will be closed.
  */
+esp_err_t httpd_sess_process_reqs(struct httpd_data *hd, struct sock_db *session,
+                                  httpd_req_t *r, struct httpd_req_aux *ra)
+{
+    for (int i = 0; i < CONFIG_HTTPD_MAX_PIPELINED_REQS; i++) {
+        ESP_LOGD(TAG, LOG_FMT("httpd_req_new"));
+        if (httpd_req_new(hd, r, ra, session) != ESP_OK) {
+            return ESP_FAIL;
+        }
+        ESP_LOGD(TAG, LOG_FMT("httpd_req_delete"));
+        if (httpd_req_delete(r) != ESP_OK) {
+            return ESP_FAIL;
+        }
+        ESP_LOGD(TAG, LOG_FMT("success"));
+
+        /* Stop if the next request is not received yet, or if the
+         * session has been handed over to an async handler */
+        if (session->for_async_req || session->fd < 0 || !httpd_sess_pending(hd, session)) {
+            break;
+        }
+        ESP_LOGD(TAG, LOG_FMT("processing pipelined request on socket %d"), session->fd);
+    }
+    return ESP_OK;
+}
+
 esp_err_t httpd_sess_process(struct httpd_data *hd, struct sock_db *session)
 {
     if ((!hd) || (!session)) {
         return ESP_FAIL;
     }
 
-    ESP_LOGD(TAG, LOG_FMT("httpd_req_new"));
-    if (httpd_req_new(hd, session) != ESP_OK) {
-        return ESP_FAIL;
-    }
-    ESP_LOGD(TAG, LOG_FMT("httpd_req_delete"));
-    if (httpd_req_delete(hd) != ESP_OK) {
+    if (httpd_sess_process_reqs(hd, session, &hd->hd_req, &hd->hd_req_aux) != ESP_OK) {
         return ESP_FAIL;
     }
-    ESP_LOGD(TAG, LOG_FMT("success"));
     session->lru_counter = ++hd->lru_counter;
     return ESP_OK;
 }
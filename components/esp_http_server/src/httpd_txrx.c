@@ -6,6 +6,8 @@
 
 
 #include <errno.h>
+#include <stdlib.h>
+#include <strings.h>
 #include <esp_log.h>
 #include <esp_err.h>
 
@@ -15,6 +17,9 @@
 
 static const char *TAG = "httpd_txrx";
 
+/* Size of the flash regions mapped at once by httpd_resp_send_partition() */
+#define HTTPD_PARTITION_MAP_SIZE (64 * 1024)
+
 esp_err_t httpd_sess_set_send_override(httpd_handle_t hd, int sockfd, httpd_send_func_t send_func)
 {
     struct sock_db *sess = httpd_sess_get(hd, sockfd);
@@ -225,31 +230,20 @@ esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type)
     return ESP_OK;
 }
 
-esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len)
+/* Sends the status line and the headers of a response with a Content-Length */
+static esp_err_t httpd_resp_send_hdrs(httpd_req_t *r, size_t content_len)
 {
-    if (r == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    if (!httpd_valid_req(r)) {
-        return ESP_ERR_HTTPD_INVALID_REQ;
-    }
-
     struct httpd_req_aux *ra = r->aux;
     const char *httpd_hdr_str = "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %d\r\n";
     const char *colon_separator = ": ";
     const char *cr_lf_seperator = "\r\n";
 
-    if (buf_len == HTTPD_RESP_USE_STRLEN) {
-        buf_len = strlen(buf);
-    }
-
     /* Request headers are no longer available */
     ra->req_hdrs_count = 0;
 
     /* Size of essential headers is limited by scratch buffer size */
     if (snprintf(ra->scratch, sizeof(ra->scratch), httpd_hdr_str,
-                 ra->status, ra->content_type, buf_len) >= sizeof(ra->scratch)) {
+                 ra->status, ra->content_type, content_len) >= sizeof(ra->scratch)) {
         return ESP_ERR_HTTPD_RESP_HDR;
     }
 
@@ -283,6 +277,29 @@ esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len)
         return ESP_ERR_HTTPD_RESP_SEND;
     }
     esp_http_server_dispatch_event(HTTP_SERVER_EVENT_HEADERS_SENT, &(ra->sd->fd), sizeof(int));
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len)
+{
+    if (r == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!httpd_valid_req(r)) {
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+
+    struct httpd_req_aux *ra = r->aux;
+
+    if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = strlen(buf);
+    }
+
+    esp_err_t ret = httpd_resp_send_hdrs(r, buf_len);
+    if (ret != ESP_OK) {
+        return ret;
+    }
 
     /* Sending content */
     if (buf && buf_len) {
@@ -298,6 +315,228 @@ esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len)
     return ESP_OK;
 }
 
+/* Returns the value of a request header in a newly allocated buffer, NULL if the header is not present */
+static char *httpd_req_dup_hdr_value(httpd_req_t *r, const char *field)
+{
+    size_t len = httpd_req_get_hdr_value_len(r, field);
+    if (len == 0) {
+        return NULL;
+    }
+    char *value = malloc(len + 1);
+    if (value && httpd_req_get_hdr_value_str(r, field, value, len + 1) != ESP_OK) {
+        free(value);
+        return NULL;
+    }
+    return value;
+}
+
+/* Returns the next element of a comma separated header value, without the surrounding spaces */
+static const char *httpd_hdr_list_next(const char **list, size_t *len)
+{
+    const char *item = *list;
+    while (*item == ' ' || *item == '\t' || *item == ',') {
+        item++;
+    }
+    const char *end = strchr(item, ',');
+    if (end == NULL) {
+        end = item + strlen(item);
+    }
+    *list = end;
+    while (end > item && (end[-1] == ' ' || end[-1] == '\t')) {
+        end--;
+    }
+    *len = end - item;
+    return *len ? item : NULL;
+}
+
+/* Checks an If-None-Match header value against an entity tag, using the weak comparison */
+static bool httpd_etag_list_matches(const char *list, const char *etag)
+{
+    size_t len;
+    const char *item;
+
+    if (strncmp(etag, "W/", 2) == 0) {
+        etag += 2;
+    }
+    const size_t etag_len = strlen(etag);
+    while ((item = httpd_hdr_list_next(&list, &len)) != NULL) {
+        if (len == 1 && item[0] == '*') {
+            return true;
+        }
+        if (len > 2 && strncmp(item, "W/", 2) == 0) {
+            item += 2;
+            len -= 2;
+        }
+        if (len == etag_len && strncmp(item, etag, len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Checks if an Accept-Encoding header value accepts a content coding, which is not the case with q=0 */
+static bool httpd_encoding_list_accepts(const char *list, const char *coding)
+{
+    size_t len;
+    const char *item;
+    const size_t coding_len = strlen(coding);
+
+    while ((item = httpd_hdr_list_next(&list, &len)) != NULL) {
+        const char *params = memchr(item, ';', len);
+        size_t name_len = params ? (size_t) (params - item) : len;
+        while (name_len > 0 && (item[name_len - 1] == ' ' || item[name_len - 1] == '\t')) {
+            name_len--;
+        }
+        if ((name_len != coding_len || strncasecmp(item, coding, name_len) != 0) &&
+            (name_len != 1 || item[0] != '*')) {
+            continue;
+        }
+        if (params) {
+            const char *q = params + 1;
+            while (*q == ' ' || *q == '\t') {
+                q++;
+            }
+            if ((q[0] == 'q' || q[0] == 'Q') && q[1] == '=' && strtod(q + 2, NULL) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+/* Sets the headers for static content and checks the request for them.
+ * not_modified is set if only a 304 response has to be sent. */
+static esp_err_t httpd_resp_prepare_content(httpd_req_t *r, const httpd_resp_content_t *content, bool *not_modified)
+{
+    esp_err_t ret;
+
+    *not_modified = false;
+    if (content == NULL) {
+        return ESP_OK;
+    }
+
+    if (content->gzip) {
+        char *accept = httpd_req_dup_hdr_value(r, "Accept-Encoding");
+        bool accepted = accept && httpd_encoding_list_accepts(accept, "gzip");
+        free(accept);
+        if (!accepted) {
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+    }
+
+    if (content->etag) {
+        char *if_none_match = httpd_req_dup_hdr_value(r, "If-None-Match");
+        *not_modified = if_none_match && httpd_etag_list_matches(if_none_match, content->etag);
+        free(if_none_match);
+        if ((ret = httpd_resp_set_hdr(r, "ETag", content->etag)) != ESP_OK) {
+            return ret;
+        }
+    }
+
+    if (content->gzip) {
+        if ((ret = httpd_resp_set_hdr(r, "Vary", "Accept-Encoding")) != ESP_OK) {
+            return ret;
+        }
+        /* A 304 response describes the content, but does not encode any */
+        if (!*not_modified && (ret = httpd_resp_set_hdr(r, "Content-Encoding", "gzip")) != ESP_OK) {
+            return ret;
+        }
+    }
+
+    if (*not_modified) {
+        httpd_resp_set_status(r, HTTPD_304);
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_mmap(httpd_req_t *r, const void *buf, size_t buf_len, const httpd_resp_content_t *content)
+{
+    if (r == NULL || (buf == NULL && buf_len != 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!httpd_valid_req(r)) {
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+
+    bool not_modified;
+    esp_err_t ret = httpd_resp_prepare_content(r, content, &not_modified);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    /* The Content-Length of a 304 response is the one of the content it stands for */
+    if ((ret = httpd_resp_send_hdrs(r, buf_len)) != ESP_OK) {
+        return ret;
+    }
+    if (not_modified) {
+        return ESP_OK;
+    }
+
+    /* The stack takes the content directly from buf, there is no intermediate copy */
+    struct httpd_req_aux *ra = r->aux;
+    if (buf_len && httpd_send_all(r, buf, buf_len) != ESP_OK) {
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+    esp_http_server_event_data evt_data = {
+        .fd = ra->sd->fd,
+        .data_len = buf_len,
+    };
+    esp_http_server_dispatch_event(HTTP_SERVER_EVENT_SENT_DATA, &evt_data, sizeof(esp_http_server_event_data));
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_partition(httpd_req_t *r, const esp_partition_t *partition, size_t offset, size_t len,
+                                    const httpd_resp_content_t *content)
+{
+    if (r == NULL || partition == NULL || offset > partition->size || len > partition->size - offset) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!httpd_valid_req(r)) {
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+
+    bool not_modified;
+    esp_err_t ret = httpd_resp_prepare_content(r, content, &not_modified);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    if ((ret = httpd_resp_send_hdrs(r, len)) != ESP_OK) {
+        return ret;
+    }
+    if (not_modified) {
+        return ESP_OK;
+    }
+
+    /* Map the content piece by piece, a large asset could use up all free MMU pages */
+    for (size_t sent = 0; sent < len; ) {
+        size_t map_len = MIN(len - sent, HTTPD_PARTITION_MAP_SIZE);
+        const void *ptr;
+        esp_partition_mmap_handle_t handle;
+        if (esp_partition_mmap(partition, offset + sent, map_len, ESP_PARTITION_MMAP_DATA, &ptr, &handle) != ESP_OK) {
+            ESP_LOGE(TAG, LOG_FMT("failed to map partition %s at 0x%x"), partition->label, (unsigned) (offset + sent));
+            return ESP_ERR_HTTPD_RESP_SEND;
+        }
+        ret = httpd_send_all(r, ptr, map_len);
+        esp_partition_munmap(handle);
+        if (ret != ESP_OK) {
+            return ESP_ERR_HTTPD_RESP_SEND;
+        }
+        sent += map_len;
+    }
+
+    struct httpd_req_aux *ra = r->aux;
+    esp_http_server_event_data evt_data = {
+        .fd = ra->sd->fd,
+        .data_len = len,
+    };
+    esp_http_server_dispatch_event(HTTP_SERVER_EVENT_SENT_DATA, &evt_data, sizeof(esp_http_server_event_data));
+    return ESP_OK;
+}
+
 esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len)
 {
     if (r == NULL) {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -80,6 +80,230 @@ bool httpd_uri_match_wildcard(const char *template, const char *uri, size_t len)
     }
 }
 
+/* The router is a radix tree over the URI templates of the registered handlers.
+ * It is only used with the built-in matchers, whose templates can be reduced to
+ * one or two keys each (see httpd_router_add_template()). A route on a node
+ * matches either a URI equal to the key of the node, or any URI starting with
+ * it. The lookup walks the tree along the URI and keeps the matching route of
+ * the smallest handler index, which gives the same result as trying the
+ * handlers in order of registration.
+ *
+ * The router is rebuilt from hd_calls each time the handlers change. All its
+ * nodes and routes are allocated in one block, and the labels of the nodes point
+ * into the URI strings of the handlers. Both the router and hd_calls are only
+ * accessed with hd_uri_lock taken, so that a lookup in the server task or in a
+ * worker task never walks a router which is being freed. */
+
+#define HTTPD_ROUTER_NONE UINT16_MAX
+
+struct httpd_router_node {
+    const char *label;          /*!< Part of the key added by this node, not null-terminated */
+    uint16_t label_len;         /*!< Length of the label */
+    uint16_t child;             /*!< First child, children have labels starting with different characters */
+    uint16_t next;              /*!< Next sibling */
+    uint16_t route;             /*!< First route ending on this node */
+};
+
+struct httpd_router_route {
+    uint16_t handler;           /*!< Index of the handler in hd_calls */
+    uint16_t next;              /*!< Next route of the same node */
+    bool prefix;                /*!< Matches any URI starting with the key of the node */
+};
+
+struct httpd_uri_router {
+    struct httpd_router_node *nodes;
+    struct httpd_router_route *routes;
+    uint16_t node_count;
+    uint16_t route_count;
+};
+
+static uint16_t httpd_router_new_node(struct httpd_uri_router *router, const char *label, size_t label_len)
+{
+    struct httpd_router_node *node = &router->nodes[router->node_count];
+    node->label = label;
+    node->label_len = label_len;
+    node->child = HTTPD_ROUTER_NONE;
+    node->next = HTTPD_ROUTER_NONE;
+    node->route = HTTPD_ROUTER_NONE;
+    return router->node_count++;
+}
+
+/* Adds a route for the first key_len characters of key. Every call adds at most two nodes. */
+static void httpd_router_add(struct httpd_uri_router *router, const char *key, size_t key_len,
+                             uint16_t handler, bool prefix)
+{
+    struct httpd_router_node *nodes = router->nodes;
+    uint16_t node = 0;
+    size_t pos = 0;
+
+    while (pos < key_len) {
+        /* Look for the child continuing with the next character of the key */
+        uint16_t *link = &nodes[node].child;
+        while (*link != HTTPD_ROUTER_NONE && nodes[*link].label[0] != key[pos]) {
+            link = &nodes[*link].next;
+        }
+        if (*link == HTTPD_ROUTER_NONE) {
+            *link = httpd_router_new_node(router, key + pos, key_len - pos);
+            node = *link;
+            break;
+        }
+
+        uint16_t child = *link;
+        size_t common = 1;
+        while (common < nodes[child].label_len && pos + common < key_len &&
+               nodes[child].label[common] == key[pos + common]) {
+            common++;
+        }
+        if (common < nodes[child].label_len) {
+            /* The key leaves the label of the child, split the child */
+            uint16_t mid = httpd_router_new_node(router, nodes[child].label, common);
+            nodes[mid].next = nodes[child].next;
+            nodes[mid].child = child;
+            nodes[child].next = HTTPD_ROUTER_NONE;
+            nodes[child].label += common;
+            nodes[child].label_len -= common;
+            *link = mid;
+            child = mid;
+        }
+        node = child;
+        pos += common;
+    }
+
+    struct httpd_router_route *route = &router->routes[router->route_count];
+    route->handler = handler;
+    route->prefix = prefix;
+    route->next = nodes[node].route;
+    nodes[node].route = router->route_count++;
+}
+
+/* Adds the keys matched by a template of httpd_uri_match_wildcard() or of the
+ * simple matcher. Keep in sync with httpd_uri_match_wildcard(). */
+static void httpd_router_add_template(struct httpd_uri_router *router, const char *template,
+                                      uint16_t handler, bool wildcard)
+{
+    const size_t tpl_len = strlen(template);
+
+    if (!wildcard) {
+        httpd_router_add(router, template, tpl_len, handler, false);
+        return;
+    }
+
+    const char last = (const char) (tpl_len > 0 ? template[tpl_len - 1] : 0);
+    const char prevlast = (const char) (tpl_len > 1 ? template[tpl_len - 2] : 0);
+    const bool asterisk = last == '*' || (prevlast == '*' && last == '?');
+    const bool quest = last == '?' || (prevlast == '?' && last == '*');
+
+    if (tpl_len < asterisk + quest*2) {
+        /* Invalid template, never matches */
+        return;
+    }
+    const size_t exact_match_chars = tpl_len - (asterisk + quest*2);
+
+    if (!quest) {
+        httpd_router_add(router, template, exact_match_chars, handler, asterisk);
+    } else {
+        /* The character before the question mark is optional */
+        httpd_router_add(router, template, exact_match_chars, handler, false);
+        httpd_router_add(router, template, exact_match_chars + 1, handler, asterisk);
+    }
+}
+
+static void httpd_router_update(struct httpd_data *hd)
+{
+    const bool wildcard = hd->config.uri_match_fn == httpd_uri_match_wildcard;
+    struct httpd_uri_router *old_router = hd->hd_router;
+
+    /* Any other matching function has to be called for every handler */
+    if (hd->config.uri_match_fn && !wildcard) {
+        return;
+    }
+
+    size_t handler_count = 0;
+    while (handler_count < hd->config.max_uri_handlers && hd->hd_calls[handler_count]) {
+        handler_count++;
+    }
+
+    /* Each template adds up to two routes, and each route up to two nodes */
+    const size_t max_routes = handler_count * 2;
+    const size_t max_nodes = 1 + max_routes * 2;
+    struct httpd_uri_router *router = NULL;
+    if (max_nodes < HTTPD_ROUTER_NONE) {
+        router = malloc(sizeof(struct httpd_uri_router) +
+                        max_nodes * sizeof(struct httpd_router_node) +
+                        max_routes * sizeof(struct httpd_router_route));
+    }
+    if (router) {
+        router->nodes = (struct httpd_router_node *) (router + 1);
+        router->routes = (struct httpd_router_route *) (router->nodes + max_nodes);
+        router->node_count = 0;
+        router->route_count = 0;
+        httpd_router_new_node(router, "", 0);
+        for (size_t i = 0; i < handler_count; i++) {
+            httpd_router_add_template(router, hd->hd_calls[i]->uri, i, wildcard);
+        }
+        ESP_LOGD(TAG, LOG_FMT("%d nodes, %d routes"), router->node_count, router->route_count);
+    } else {
+        /* Not fatal, the handlers are searched one by one instead */
+        ESP_LOGW(TAG, LOG_FMT("failed to allocate URI router"));
+    }
+
+    hd->hd_router = router;
+    free(old_router);
+}
+
+static httpd_uri_t *httpd_router_find(struct httpd_data *hd,
+                                      const char *uri, size_t uri_len,
+                                      httpd_method_t method,
+                                      httpd_err_code_t *err)
+{
+    const struct httpd_uri_router *router = hd->hd_router;
+    const struct httpd_router_node *nodes = router->nodes;
+    uint16_t best = HTTPD_ROUTER_NONE;
+    bool uri_found = false;
+    uint16_t node = 0;
+    size_t pos = 0;
+
+    while (true) {
+        for (uint16_t r = nodes[node].route; r != HTTPD_ROUTER_NONE; r = router->routes[r].next) {
+            const struct httpd_router_route *route = &router->routes[r];
+            if (!route->prefix && pos != uri_len) {
+                continue;
+            }
+            uri_found = true;
+            httpd_method_t handler_method = hd->hd_calls[route->handler]->method;
+            if ((handler_method == method || handler_method == HTTP_ANY) && route->handler < best) {
+                best = route->handler;
+            }
+        }
+        if (pos == uri_len) {
+            break;
+        }
+
+        uint16_t child = nodes[node].child;
+        while (child != HTTPD_ROUTER_NONE && nodes[child].label[0] != uri[pos]) {
+            child = nodes[child].next;
+        }
+        if (child == HTTPD_ROUTER_NONE || nodes[child].label_len > uri_len - pos ||
+            memcmp(nodes[child].label, uri + pos, nodes[child].label_len) != 0) {
+            break;
+        }
+        node = child;
+        pos += nodes[child].label_len;
+    }
+
+    if (best != HTTPD_ROUTER_NONE) {
+        ESP_LOGD(TAG, LOG_FMT("[%d] = %s"), best, hd->hd_calls[best]->uri);
+        if (err) {
+            *err = 0;
+        }
+        return hd->hd_calls[best];
+    }
+    if (err && uri_found) {
+        *err = HTTPD_405_METHOD_NOT_ALLOWED;
+    }
+    return NULL;
+}
+
 /* Find handler with matching URI and method, and set
  * appropriate error code if URI or method not found */
 static httpd_uri_t* httpd_find_uri_handler(struct httpd_data *hd,
@@ -91,6 +315,10 @@ static httpd_uri_t* httpd_find_uri_handler(struct httpd_data *hd,
         *err = HTTPD_404_NOT_FOUND;
     }
 
+    if (hd->hd_router) {
+        return httpd_router_find(hd, uri, uri_len, method, err);
+    }
+
     for (int i = 0; i < hd->config.max_uri_handlers; i++) {
         if (!hd->hd_calls[i]) {
             break;
@@ -123,20 +351,15 @@ static httpd_uri_t* httpd_find_uri_handler(struct httpd_data *hd,
     return NULL;
 }
 
-esp_err_t httpd_register_uri_handler(httpd_handle_t handle,
-                                     const httpd_uri_t *uri_handler)
+/* The httpd_*_locked() functions are called with hd_uri_lock taken */
+static esp_err_t httpd_register_uri_handler_locked(struct httpd_data *hd,
+                                                   const httpd_uri_t *uri_handler)
 {
-    if (handle == NULL || uri_handler == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    struct httpd_data *hd = (struct httpd_data *) handle;
-
     /* Make sure another handler with matching URI and method
      * is not already registered. This will also catch cases
      * when a registered URI wildcard pattern already accounts
      * for the new URI being registered */
-    if (httpd_find_uri_handler(handle, uri_handler->uri,
+    if (httpd_find_uri_handler(hd, uri_handler->uri,
                                strlen(uri_handler->uri),
                                uri_handler->method, NULL) != NULL) {
         ESP_LOGW(TAG, LOG_FMT("handler %s with method %d already registered"),
@@ -176,6 +399,7 @@ esp_err_t httpd_register_uri_handler(httpd_handle_t handle,
             }
 #endif
             ESP_LOGD(TAG, LOG_FMT("[%d] installed %s"), i, uri_handler->uri);
+            httpd_router_update(hd);
             return ESP_OK;
         }
         ESP_LOGD(TAG, LOG_FMT("[%d] exists %s"), i, hd->hd_calls[i]->uri);
@@ -184,14 +408,23 @@ esp_err_t httpd_register_uri_handler(httpd_handle_t handle,
     return ESP_ERR_HTTPD_HANDLERS_FULL;
 }
 
-esp_err_t httpd_unregister_uri_handler(httpd_handle_t handle,
-                                       const char *uri, httpd_method_t method)
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle,
+                                     const httpd_uri_t *uri_handler)
 {
-    if (handle == NULL || uri == NULL) {
+    if (handle == NULL || uri_handler == NULL) {
         return ESP_ERR_INVALID_ARG;
     }
 
     struct httpd_data *hd = (struct httpd_data *) handle;
+    xSemaphoreTake(hd->hd_uri_lock, portMAX_DELAY);
+    esp_err_t ret = httpd_register_uri_handler_locked(hd, uri_handler);
+    xSemaphoreGive(hd->hd_uri_lock);
+    return ret;
+}
+
+static esp_err_t httpd_unregister_uri_handler_locked(struct httpd_data *hd,
+                                                     const char *uri, httpd_method_t method)
+{
     for (int i = 0; i < hd->config.max_uri_handlers; i++) {
         if (!hd->hd_calls[i]) {
             break;
@@ -214,6 +447,7 @@ esp_err_t httpd_unregister_uri_handler(httpd_handle_t handle,
             }
             /* Nullify the following non null entry */
             hd->hd_calls[i-1] = NULL;
+            httpd_router_update(hd);
             return ESP_OK;
         }
     }
@@ -221,13 +455,22 @@ esp_err_t httpd_unregister_uri_handler(httpd_handle_t handle,
     return ESP_ERR_NOT_FOUND;
 }
 
-esp_err_t httpd_unregister_uri(httpd_handle_t handle, const char *uri)
+esp_err_t httpd_unregister_uri_handler(httpd_handle_t handle,
+                                       const char *uri, httpd_method_t method)
 {
     if (handle == NULL || uri == NULL) {
         return ESP_ERR_INVALID_ARG;
     }
 
     struct httpd_data *hd = (struct httpd_data *) handle;
+    xSemaphoreTake(hd->hd_uri_lock, portMAX_DELAY);
+    esp_err_t ret = httpd_unregister_uri_handler_locked(hd, uri, method);
+    xSemaphoreGive(hd->hd_uri_lock);
+    return ret;
+}
+
+static esp_err_t httpd_unregister_uri_locked(struct httpd_data *hd, const char *uri)
+{
     bool found = false;
 
     int i = 0, j = 0; // For keeping count of removed entries
@@ -257,10 +500,25 @@ esp_err_t httpd_unregister_uri(httpd_handle_t handle, const char *uri)
 
     if (!found) {
         ESP_LOGW(TAG, LOG_FMT("no handler found for URI %s"), uri);
+    } else {
+        httpd_router_update(hd);
     }
     return (found ? ESP_OK : ESP_ERR_NOT_FOUND);
 }
 
+esp_err_t httpd_unregister_uri(httpd_handle_t handle, const char *uri)
+{
+    if (handle == NULL || uri == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct httpd_data *hd = (struct httpd_data *) handle;
+    xSemaphoreTake(hd->hd_uri_lock, portMAX_DELAY);
+    esp_err_t ret = httpd_unregister_uri_locked(hd, uri);
+    xSemaphoreGive(hd->hd_uri_lock);
+    return ret;
+}
+
 void httpd_unregister_all_uri_handlers(struct httpd_data *hd)
 {
     for (unsigned i = 0; i < hd->config.max_uri_handlers; i++) {
@@ -273,13 +531,15 @@ void httpd_unregister_all_uri_handlers(struct httpd_data *hd)
         free(hd->hd_calls[i]);
         hd->hd_calls[i] = NULL;
     }
+    free(hd->hd_router);
+    hd->hd_router = NULL;
 }
 
-esp_err_t httpd_uri(struct httpd_data *hd)
+esp_err_t httpd_uri(struct httpd_data *hd, httpd_req_t *req)
 {
+    httpd_uri_t             uri_copy;
     httpd_uri_t            *uri = NULL;
-    httpd_req_t            *req = &hd->hd_req;
-    struct http_parser_url *res = &hd->hd_req_aux.url_parse_res;
+    struct http_parser_url *res = &((struct httpd_req_aux *)req->aux)->url_parse_res;
 
     /* For conveying URI not found/method not allowed */
     httpd_err_code_t err = 0;
@@ -288,8 +548,16 @@ esp_err_t httpd_uri(struct httpd_data *hd)
 
     /* URL parser result contains offset and length of path string */
     if (res->field_set & (1 << UF_PATH)) {
+        /* The handler is copied so that it stays valid if it gets
+         * unregistered by another task while it is being invoked */
+        xSemaphoreTake(hd->hd_uri_lock, portMAX_DELAY);
         uri = httpd_find_uri_handler(hd, req->uri + res->field_data[UF_PATH].off,
                                      res->field_data[UF_PATH].len, req->method, &err);
+        if (uri) {
+            uri_copy = *uri;
+            uri = &uri_copy;
+        }
+        xSemaphoreGive(hd->hd_uri_lock);
     }
 
     /* If URI with method not found, respond with error code */
@@ -315,7 +583,7 @@ esp_err_t httpd_uri(struct httpd_data *hd)
     struct httpd_req_aux   *aux = req->aux;
     if (uri->is_websocket && aux->ws_handshake_detect && uri->method == HTTP_GET) {
         ESP_LOGD(TAG, LOG_FMT("Responding WS handshake to sock %d"), aux->sd->fd);
-        esp_err_t ret = httpd_ws_respond_server_handshake(&hd->hd_req, uri->supported_subprotocol);
+        esp_err_t ret = httpd_ws_respond_server_handshake(req, uri->supported_subprotocol);
         if (ret != ESP_OK) {
             return ret;
         }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <sys/param.h>
 #include <sys/random.h>
 #include <esp_log.h>
 #include <esp_err.h>
@@ -45,6 +46,20 @@ static const char *TAG="httpd_ws";
 #define HTTPD_WS_MASK_BIT       0x80U
 #define HTTPD_WS_LENGTH_BITS    0x7fU
 
+/* Maximum length of the header of a frame sent by the server, which does not mask frames */
+#define HTTPD_WS_MAX_HEADER_LEN 10
+
+/*
+ * An encoded frame sent to several clients by httpd_ws_broadcast(). It is
+ * only accessed from the server task, so the reference count is not atomic.
+ */
+struct httpd_ws_bcast_frame {
+    struct httpd_data *hd;  /*!< Server the frame is broadcast by */
+    uint32_t refcount;      /*!< Number of session queues (and the broadcast itself) holding the frame */
+    size_t len;             /*!< Length of the encoded frame */
+    uint8_t data[];         /*!< Header and payload */
+};
+
 /*
  * The magic GUID string used for handshake
  * Please refer to RFC6455 Section 1.3 for more details.
@@ -372,16 +387,12 @@ esp_err_t httpd_ws_send_frame(httpd_req_t *req, httpd_ws_frame_t *frame)
     return httpd_ws_send_frame_async(req->handle, httpd_req_to_sockfd(req), frame);
 }
 
-esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame)
+/* Encodes the header of a frame sent by the server, returns its length */
+static size_t httpd_ws_encode_header(const httpd_ws_frame_t *frame, uint8_t header_buf[HTTPD_WS_MAX_HEADER_LEN])
 {
-    if (!frame) {
-        ESP_LOGW(TAG, LOG_FMT("Argument is invalid"));
-        return ESP_ERR_INVALID_ARG;
-    }
+    size_t tx_len = 0;
 
-    /* Prepare Tx buffer - maximum length is 14, which includes 2 bytes header, 8 bytes length, 4 bytes mask key */
-    uint8_t tx_len = 0;
-    uint8_t header_buf[10] = {0 };
+    memset(header_buf, 0, HTTPD_WS_MAX_HEADER_LEN);
     /* Set the `FIN` bit by default if message is not fragmented. Else, set it as per the `final` field */
     header_buf[0] |= (!frame->fragmented) ? HTTPD_WS_FIN_BIT : (frame->final? HTTPD_WS_FIN_BIT: HTTPD_WS_CONTINUE);
     header_buf[0] |= frame->type; /* Type (opcode): 4 bits */
@@ -409,12 +420,54 @@ esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t
 
     /* WebSocket server does not required to mask response payload, so leave the MASK bit as 0. */
     header_buf[1] &= (~HTTPD_WS_MASK_BIT);
+    return tx_len;
+}
+
+/* Sends the rest of a partially sent broadcast frame, so that the next frame starts at a frame boundary.
+ * The frame stays queued, it is released by the server task on the next flush.
+ *
+ * This may run in a worker task or an async handler while the server task queues more broadcast frames.
+ * While the session is busy, the server task neither sends from the queue nor touches its oldest frame
+ * and ws_bcast_offset (see httpd_ws_bcast_push()), so these belong to the task sending on the session. */
+static esp_err_t httpd_ws_bcast_complete(httpd_handle_t hd, struct sock_db *sess)
+{
+    if (sess->ws_bcast_offset == 0) {
+        return ESP_OK;
+    }
+
+    const struct httpd_ws_bcast_frame *frame = sess->ws_bcast_queue[sess->ws_bcast_head];
+    while (sess->ws_bcast_offset < frame->len) {
+        int ret = sess->send_fn(hd, sess->fd, (const char *)frame->data + sess->ws_bcast_offset,
+                                frame->len - sess->ws_bcast_offset, 0);
+        if (ret < 0) {
+            return ESP_FAIL;
+        }
+        sess->ws_bcast_offset += ret;
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t *frame)
+{
+    if (!frame) {
+        ESP_LOGW(TAG, LOG_FMT("Argument is invalid"));
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Prepare Tx buffer - maximum length is 14, which includes 2 bytes header, 8 bytes length, 4 bytes mask key */
+    uint8_t header_buf[HTTPD_WS_MAX_HEADER_LEN];
+    size_t tx_len = httpd_ws_encode_header(frame, header_buf);
 
     struct sock_db *sess = httpd_sess_get(hd, fd);
     if (!sess) {
         return ESP_ERR_INVALID_ARG;
     }
 
+    if (httpd_ws_bcast_complete(hd, sess) != ESP_OK) {
+        ESP_LOGW(TAG, LOG_FMT("Failed to send WS broadcast frame"));
+        return ESP_FAIL;
+    }
+
     /* Send off header */
     if (sess->send_fn(hd, fd, (const char *)header_buf, tx_len, 0) < 0) {
         ESP_LOGW(TAG, LOG_FMT("Failed to send WS header"));
@@ -600,4 +653,194 @@ esp_err_t httpd_ws_send_data_async(httpd_handle_t handle, int socket, httpd_ws_f
     return ESP_OK;
 }
 
+static void httpd_ws_bcast_unref(struct httpd_ws_bcast_frame *frame)
+{
+    if (--frame->refcount == 0) {
+        free(frame);
+    }
+}
+
+/* Removes the oldest frame from the broadcast queue of a session */
+static void httpd_ws_bcast_pop(struct sock_db *sess)
+{
+    httpd_ws_bcast_unref(sess->ws_bcast_queue[sess->ws_bcast_head]);
+    sess->ws_bcast_head = (sess->ws_bcast_head + 1) % CONFIG_HTTPD_WS_BROADCAST_QUEUE_LEN;
+    sess->ws_bcast_count--;
+    sess->ws_bcast_offset = 0;
+}
+
+/* A session busy in a worker or an async handler may send frames itself, and completes a partially
+ * sent broadcast frame first (see httpd_ws_bcast_complete()) */
+static bool httpd_ws_bcast_busy(const struct sock_db *sess)
+{
+    return sess->in_worker || sess->for_async_req;
+}
+
+/* Appends a frame to the broadcast queue of a session. If the queue is full the oldest frame is dropped,
+ * unless it is partially sent already or the session is busy, then the one after it is dropped instead. */
+static void httpd_ws_bcast_push(struct sock_db *sess, struct httpd_ws_bcast_frame *frame)
+{
+    if (sess->ws_bcast_count == CONFIG_HTTPD_WS_BROADCAST_QUEUE_LEN) {
+        if (!httpd_ws_bcast_busy(sess) && sess->ws_bcast_offset == 0) {
+            httpd_ws_bcast_pop(sess);
+        } else if (sess->ws_bcast_count > 1) {
+            /* Shift the newer frames over the dropped one, the oldest frame stays where it is */
+            uint8_t slot = (sess->ws_bcast_head + 1) % CONFIG_HTTPD_WS_BROADCAST_QUEUE_LEN;
+            httpd_ws_bcast_unref(sess->ws_bcast_queue[slot]);
+            for (uint8_t i = 2; i < sess->ws_bcast_count; i++) {
+                uint8_t next = (slot + 1) % CONFIG_HTTPD_WS_BROADCAST_QUEUE_LEN;
+                sess->ws_bcast_queue[slot] = sess->ws_bcast_queue[next];
+                slot = next;
+            }
+            sess->ws_bcast_count--;
+        } else {
+            ESP_LOGD(TAG, LOG_FMT("dropping broadcast frame for socket %d"), sess->fd);
+            return;
+        }
+        ESP_LOGD(TAG, LOG_FMT("dropped oldest broadcast frame for socket %d"), sess->fd);
+    }
+
+    frame->refcount++;
+    sess->ws_bcast_queue[(sess->ws_bcast_head + sess->ws_bcast_count) % CONFIG_HTTPD_WS_BROADCAST_QUEUE_LEN] = frame;
+    sess->ws_bcast_count++;
+}
+
+/* Sends as much of the queued broadcast frames of a session as the socket takes without blocking */
+static esp_err_t httpd_ws_bcast_flush(struct httpd_data *hd, struct sock_db *sess)
+{
+    while (sess->ws_bcast_count) {
+        const struct httpd_ws_bcast_frame *frame = sess->ws_bcast_queue[sess->ws_bcast_head];
+        if (sess->ws_bcast_offset < frame->len) {
+            int ret = sess->send_fn(hd, sess->fd, (const char *)frame->data + sess->ws_bcast_offset,
+                                    frame->len - sess->ws_bcast_offset, MSG_DONTWAIT);
+            if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
+                return ESP_OK;
+            }
+            if (ret < 0) {
+                return ESP_FAIL;
+            }
+            sess->ws_bcast_offset += ret;
+            if (sess->ws_bcast_offset < frame->len) {
+                return ESP_OK;
+            }
+        }
+        httpd_ws_bcast_pop(sess);
+    }
+    return ESP_OK;
+}
+
+/* A busy session is flushed once it is back */
+static bool httpd_ws_bcast_can_flush(const struct sock_db *sess)
+{
+    return sess->fd >= 0 && sess->ws_bcast_count && !httpd_ws_bcast_busy(sess);
+}
+
+static int httpd_ws_bcast_enqueue(struct sock_db *sess, void *context)
+{
+    struct httpd_ws_bcast_frame *frame = context;
+
+    if (sess->fd >= 0 && sess->ws_handshake_done && !sess->ws_close) {
+        httpd_ws_bcast_push(sess, frame);
+        if (httpd_ws_bcast_can_flush(sess) && httpd_ws_bcast_flush(frame->hd, sess) != ESP_OK) {
+            ESP_LOGW(TAG, LOG_FMT("Failed to send WS broadcast frame to socket %d"), sess->fd);
+            httpd_sess_delete(frame->hd, sess);
+        }
+    }
+    return 1;
+}
+
+static void httpd_ws_bcast_cb(void *arg)
+{
+    struct httpd_ws_bcast_frame *frame = arg;
+    httpd_sess_enum(frame->hd, httpd_ws_bcast_enqueue, frame);
+    /* Drop the reference of the broadcast itself */
+    httpd_ws_bcast_unref(frame);
+}
+
+esp_err_t httpd_ws_broadcast(httpd_handle_t handle, const httpd_ws_frame_t *frame)
+{
+    if (handle == NULL || frame == NULL || (frame->len > 0 && frame->payload == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t header_buf[HTTPD_WS_MAX_HEADER_LEN];
+    size_t header_len = httpd_ws_encode_header(frame, header_buf);
+
+    /* Header and payload are encoded once, the frame is shared by the queues of all sessions */
+    struct httpd_ws_bcast_frame *bcast = malloc(sizeof(struct httpd_ws_bcast_frame) + header_len + frame->len);
+    if (bcast == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    bcast->hd = handle;
+    bcast->refcount = 1;
+    bcast->len = header_len + frame->len;
+    memcpy(bcast->data, header_buf, header_len);
+    if (frame->len > 0) {
+        memcpy(bcast->data + header_len, frame->payload, frame->len);
+    }
+
+    esp_err_t err = httpd_queue_work(handle, httpd_ws_bcast_cb, bcast);
+    if (err != ESP_OK) {
+        free(bcast);
+    }
+    return err;
+}
+
+typedef struct {
+    struct httpd_data *hd;
+    fd_set *fdset;
+    int max_fd;
+} bcast_enum_context_t;
+
+static int httpd_ws_bcast_set_descriptor(struct sock_db *sess, void *context)
+{
+    bcast_enum_context_t *ctx = context;
+
+    if (httpd_ws_bcast_can_flush(sess)) {
+        FD_SET(sess->fd, ctx->fdset);
+        ctx->max_fd = MAX(ctx->max_fd, sess->fd);
+    }
+    return 1;
+}
+
+void httpd_ws_bcast_set_descriptors(struct httpd_data *hd, fd_set *fdset, int *maxfd)
+{
+    bcast_enum_context_t context = {
+        .hd = hd,
+        .fdset = fdset,
+        .max_fd = -1
+    };
+    FD_ZERO(fdset);
+    httpd_sess_enum(hd, httpd_ws_bcast_set_descriptor, &context);
+    *maxfd = context.max_fd;
+}
+
+static int httpd_ws_bcast_flush_ready_session(struct sock_db *sess, void *context)
+{
+    bcast_enum_context_t *ctx = context;
+
+    if (httpd_ws_bcast_can_flush(sess) && FD_ISSET(sess->fd, ctx->fdset) &&
+        httpd_ws_bcast_flush(ctx->hd, sess) != ESP_OK) {
+        ESP_LOGW(TAG, LOG_FMT("Failed to send WS broadcast frame to socket %d"), sess->fd);
+        httpd_sess_delete(ctx->hd, sess);
+    }
+    return 1;
+}
+
+void httpd_ws_bcast_flush_ready(struct httpd_data *hd, fd_set *fdset)
+{
+    bcast_enum_context_t context = {
+        .hd = hd,
+        .fdset = fdset
+    };
+    httpd_sess_enum(hd, httpd_ws_bcast_flush_ready_session, &context);
+}
+
+void httpd_ws_bcast_clear(struct sock_db *session)
+{
+    while (session->ws_bcast_count) {
+        httpd_ws_bcast_pop(session);
+    }
+}
+
 #endif /* CONFIG_HTTPD_WS_SUPPORT */
@@ -1,13 +1,19 @@
 /*
- * SPDX-FileCopyrightText: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
 #include <esp_system.h>
 #include <esp_http_server.h>
+#include "freertos/semphr.h"
 
 #include "unity.h"
 #include "test_utils.h"
@@ -225,6 +231,567 @@ TEST_CASE("URI Wildcard Matcher Tests", "[HTTP SERVER]")
     }
 }
 
+#define WORKER_TEST_PORT 8080
+#define WORKER_TEST_ID   4
+
+static esp_err_t wait_handler(httpd_req_t *req)
+{
+    SemaphoreHandle_t sem = (SemaphoreHandle_t) req->user_ctx;
+    /* Only completes in time if another request is handled in parallel */
+    bool given = xSemaphoreTake(sem, pdMS_TO_TICKS(2000)) == pdTRUE;
+    return httpd_resp_sendstr(req, given ? "given" : "timeout");
+}
+
+static esp_err_t give_handler(httpd_req_t *req)
+{
+    xSemaphoreGive((SemaphoreHandle_t) req->user_ctx);
+    return httpd_resp_sendstr(req, "done");
+}
+
+static int test_send_request_hdrs(uint16_t port, const char *path, const char *hdrs)
+{
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    char req[256];
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT(connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    int len = snprintf(req, sizeof(req), "GET %s HTTP/1.1\r\nHost: localhost\r\n%s\r\n", path, hdrs);
+    TEST_ASSERT(len < sizeof(req));
+    TEST_ASSERT(send(fd, req, len, 0) == len);
+    return fd;
+}
+
+static int test_send_request(uint16_t port, const char *path)
+{
+    return test_send_request_hdrs(port, path, "");
+}
+
+static void test_check_response(int fd, const char *expected)
+{
+    char resp[256] = {};
+    size_t len = 0;
+    struct timeval tv = { .tv_sec = 5 };
+    TEST_ASSERT(setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0);
+    /* The body is the last part of the response */
+    while (strstr(resp, expected) == NULL && len < sizeof(resp) - 1) {
+        int ret = recv(fd, resp + len, sizeof(resp) - 1 - len, 0);
+        if (ret <= 0) {
+            break;
+        }
+        len += ret;
+    }
+    close(fd);
+    TEST_ASSERT_NOT_NULL(strstr(resp, expected));
+}
+
+TEST_CASE("Worker Tasks Test", "[HTTP SERVER]")
+{
+    httpd_handle_t hd;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(sem);
+
+    test_case_uses_tcpip();
+
+    config.server_port = WORKER_TEST_PORT;
+    config.ctrl_port += WORKER_TEST_ID;
+    config.worker_count = 2;
+
+    unsigned task_count = uxTaskGetNumberOfTasks();
+    TEST_ASSERT(httpd_start(&hd, &config) == ESP_OK);
+    vTaskDelay(10);
+    TEST_ASSERT_EQUAL(task_count + 1 + config.worker_count, uxTaskGetNumberOfTasks());
+
+    httpd_uri_t wait_uri = {
+        .uri      = "/wait",
+        .method   = HTTP_GET,
+        .handler  = wait_handler,
+        .user_ctx = sem,
+    };
+    httpd_uri_t give_uri = {
+        .uri      = "/give",
+        .method   = HTTP_GET,
+        .handler  = give_handler,
+        .user_ctx = sem,
+    };
+    TEST_ASSERT(httpd_register_uri_handler(hd, &wait_uri) == ESP_OK);
+    TEST_ASSERT(httpd_register_uri_handler(hd, &give_uri) == ESP_OK);
+
+    /* The second request is handled by another worker while the first one waits */
+    int wait_fd = test_send_request(WORKER_TEST_PORT, "/wait");
+    vTaskDelay(pdMS_TO_TICKS(100));
+    int give_fd = test_send_request(WORKER_TEST_PORT, "/give");
+    test_check_response(give_fd, "done");
+    test_check_response(wait_fd, "given");
+
+    TEST_ASSERT(httpd_stop(hd) == ESP_OK);
+    vTaskDelay(10);
+    TEST_ASSERT_EQUAL(task_count, uxTaskGetNumberOfTasks());
+    vSemaphoreDelete(sem);
+}
+
+#define ROUTER_TEST_PORT 8081
+#define ROUTER_TEST_ID   5
+
+static esp_err_t router_handler(httpd_req_t *req)
+{
+    return httpd_resp_sendstr(req, (const char *) req->user_ctx);
+}
+
+static void router_test_get(const char *path, const char *expected)
+{
+    test_check_response(test_send_request(ROUTER_TEST_PORT, path), expected);
+}
+
+TEST_CASE("URI Router Tests", "[HTTP SERVER]")
+{
+    httpd_handle_t hd;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+
+    test_case_uses_tcpip();
+
+    config.server_port = ROUTER_TEST_PORT;
+    config.ctrl_port += ROUTER_TEST_ID;
+    config.uri_match_fn = httpd_uri_match_wildcard;
+    TEST_ASSERT(httpd_start(&hd, &config) == ESP_OK);
+
+    const struct {
+        const char *uri;
+        httpd_method_t method;
+        const char *body;
+    } uris[] = {
+        {"/api/items",   HTTP_GET,  "<items>"},
+        {"/api/items/*", HTTP_GET,  "<item>"},
+        {"/api/*",       HTTP_GET,  "<api>"},
+        {"/ab?",         HTTP_GET,  "<ab>"},
+        {"/static/*",    HTTP_POST, "<static>"},
+    };
+    for (size_t i = 0; i < sizeof(uris) / sizeof(uris[0]); i++) {
+        httpd_uri_t uri = {
+            .uri      = uris[i].uri,
+            .method   = uris[i].method,
+            .handler  = router_handler,
+            .user_ctx = (void *) uris[i].body,
+        };
+        TEST_ASSERT(httpd_register_uri_handler(hd, &uri) == ESP_OK);
+    }
+
+    /* Already covered by the "/api/*" template */
+    httpd_uri_t covered = {
+        .uri      = "/api/other",
+        .method   = HTTP_GET,
+        .handler  = router_handler,
+        .user_ctx = (void *) "<other>",
+    };
+    TEST_ASSERT(httpd_register_uri_handler(hd, &covered) == ESP_ERR_HTTPD_HANDLER_EXISTS);
+
+    /* The handler registered first wins */
+    router_test_get("/api/items", "<items>");
+    router_test_get("/api/items?id=1", "<items>");
+    router_test_get("/api/items/42", "<item>");
+    router_test_get("/api/other", "<api>");
+    router_test_get("/a", "<ab>");
+    router_test_get("/ab", "<ab>");
+    router_test_get("/abc", "404 Not Found");
+    router_test_get("/static/logo.png", "405 Method Not Allowed");
+
+    TEST_ASSERT(httpd_unregister_uri(hd, "/api/*") == ESP_OK);
+    router_test_get("/api/other", "404 Not Found");
+    TEST_ASSERT(httpd_register_uri_handler(hd, &covered) == ESP_OK);
+    router_test_get("/api/other", "<other>");
+
+    TEST_ASSERT(httpd_stop(hd) == ESP_OK);
+}
+
+#define CONTENT_TEST_PORT 8082
+#define CONTENT_TEST_ID   6
+
+static const char content_test_asset[] = "<asset>";
+
+static esp_err_t content_handler(httpd_req_t *req)
+{
+    httpd_resp_content_t content = {
+        .etag = "\"v1\"",
+        .gzip = (bool) req->user_ctx,
+    };
+    esp_err_t ret = httpd_resp_send_mmap(req, content_test_asset, strlen(content_test_asset), &content);
+    if (ret == ESP_ERR_NOT_SUPPORTED) {
+        /* Fallback for clients which do not accept gzip */
+        return httpd_resp_sendstr(req, "<identity>");
+    }
+    return ret;
+}
+
+TEST_CASE("Static Content Tests", "[HTTP SERVER]")
+{
+    httpd_handle_t hd;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+
+    test_case_uses_tcpip();
+
+    config.server_port = CONTENT_TEST_PORT;
+    config.ctrl_port += CONTENT_TEST_ID;
+    TEST_ASSERT(httpd_start(&hd, &config) == ESP_OK);
+
+    httpd_uri_t plain_uri = {
+        .uri      = "/plain",
+        .method   = HTTP_GET,
+        .handler  = content_handler,
+        .user_ctx = (void *) false,
+    };
+    httpd_uri_t gzip_uri = {
+        .uri      = "/gzip",
+        .method   = HTTP_GET,
+        .handler  = content_handler,
+        .user_ctx = (void *) true,
+    };
+    TEST_ASSERT(httpd_register_uri_handler(hd, &plain_uri) == ESP_OK);
+    TEST_ASSERT(httpd_register_uri_handler(hd, &gzip_uri) == ESP_OK);
+
+    test_check_response(test_send_request(CONTENT_TEST_PORT, "/plain"), "<asset>");
+    test_check_response(test_send_request(CONTENT_TEST_PORT, "/plain"), "ETag: \"v1\"");
+    test_check_response(test_send_request_hdrs(CONTENT_TEST_PORT, "/plain", "If-None-Match: \"v0\", W/\"v1\"\r\n"),
+                        "304 Not Modified");
+    test_check_response(test_send_request_hdrs(CONTENT_TEST_PORT, "/plain", "If-None-Match: \"v0\"\r\n"), "<asset>");
+
+    test_check_response(test_send_request(CONTENT_TEST_PORT, "/gzip"), "<identity>");
+    test_check_response(test_send_request_hdrs(CONTENT_TEST_PORT, "/gzip", "Accept-Encoding: gzip;q=0\r\n"),
+                        "<identity>");
+    test_check_response(test_send_request_hdrs(CONTENT_TEST_PORT, "/gzip", "Accept-Encoding: deflate, gzip\r\n"),
+                        "Content-Encoding: gzip");
+    test_check_response(test_send_request_hdrs(CONTENT_TEST_PORT, "/gzip",
+                                               "Accept-Encoding: gzip\r\nIf-None-Match: *\r\n"),
+                        "304 Not Modified");
+
+    TEST_ASSERT(httpd_stop(hd) == ESP_OK);
+}
+
+#define PIPELINE_TEST_PORT 8083
+#define PIPELINE_TEST_ID   7
+
+TEST_CASE("Pipelined Requests Test", "[HTTP SERVER]")
+{
+    httpd_handle_t hd;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+
+    test_case_uses_tcpip();
+
+    config.server_port = PIPELINE_TEST_PORT;
+    config.ctrl_port += PIPELINE_TEST_ID;
+    TEST_ASSERT(httpd_start(&hd, &config) == ESP_OK);
+
+    httpd_uri_t first_uri = {
+        .uri      = "/first",
+        .method   = HTTP_GET,
+        .handler  = router_handler,
+        .user_ctx = (void *) "<first>",
+    };
+    httpd_uri_t second_uri = {
+        .uri      = "/second",
+        .method   = HTTP_GET,
+        .handler  = router_handler,
+        .user_ctx = (void *) "<second>",
+    };
+    TEST_ASSERT(httpd_register_uri_handler(hd, &first_uri) == ESP_OK);
+    TEST_ASSERT(httpd_register_uri_handler(hd, &second_uri) == ESP_OK);
+
+    /* Both requests arrive in one segment, the second one must be answered
+     * without any further data from the client */
+    int fd = test_send_request_hdrs(PIPELINE_TEST_PORT, "/first", "\r\nGET /second HTTP/1.1\r\nHost: localhost\r\n");
+    test_check_response(fd, "<second>");
+
+    TEST_ASSERT(httpd_stop(hd) == ESP_OK);
+}
+
+#define HDR_LOOKUP_TEST_PORT 8084
+#define HDR_LOOKUP_TEST_ID   8
+
+static esp_err_t hdr_lookup_handler(httpd_req_t *req)
+{
+    char a[8] = "", b[8] = "", last[8] = "", none[8];
+    char resp[48];
+
+    TEST_ASSERT(httpd_req_get_hdr_value_str(req, "x-a", a, sizeof(a)) == ESP_OK);
+    TEST_ASSERT(httpd_req_get_hdr_value_str(req, "X-B", b, sizeof(b)) == ESP_OK);
+    TEST_ASSERT(httpd_req_get_hdr_value_str(req, "X-Last", last, sizeof(last)) == ESP_OK);
+    esp_err_t none_ret = httpd_req_get_hdr_value_str(req, "X-None", none, sizeof(none));
+    snprintf(resp, sizeof(resp), "<%s|%s|%s|%d|%d|%s>", a, b, last,
+             (int)httpd_req_get_hdr_value_len(req, "X-Empty"), (int)httpd_req_get_hdr_value_len(req, "host"),
+             none_ret == ESP_ERR_NOT_FOUND ? "none" : "found");
+    return httpd_resp_sendstr(req, resp);
+}
+
+TEST_CASE("Request Header Lookup Test", "[HTTP SERVER]")
+{
+    httpd_handle_t hd;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+
+    test_case_uses_tcpip();
+
+    config.server_port = HDR_LOOKUP_TEST_PORT;
+    config.ctrl_port += HDR_LOOKUP_TEST_ID;
+    TEST_ASSERT(httpd_start(&hd, &config) == ESP_OK);
+
+    httpd_uri_t uri = {
+        .uri      = "/hdrs",
+        .method   = HTTP_GET,
+        .handler  = hdr_lookup_handler,
+        .user_ctx = NULL,
+    };
+    TEST_ASSERT(httpd_register_uri_handler(hd, &uri) == ESP_OK);
+
+    /* Names are matched regardless of case, the first of duplicate headers is
+     * found, and with the header index the headers beyond its size are too */
+    int fd = test_send_request_hdrs(HDR_LOOKUP_TEST_PORT, "/hdrs",
+                                    "X-A: first\r\nx-b:  two\r\nX-A: second\r\nX-Empty:\r\nX-Last: end\r\n");
+    test_check_response(fd, "<first|two|end|0|9|none>");
+
+    TEST_ASSERT(httpd_stop(hd) == ESP_OK);
+}
+
+#define ROUTER_UPDATE_TEST_PORT 8085
+#define ROUTER_UPDATE_TEST_ID   9
+
+struct router_update_ctx {
+    httpd_handle_t hd;
+    volatile bool stop;
+    int failures;
+    SemaphoreHandle_t done;
+};
+
+/* Keeps rebuilding the router while the workers look up requests */
+static void router_update_task(void *arg)
+{
+    struct router_update_ctx *ctx = (struct router_update_ctx *) arg;
+    httpd_uri_t uri = {
+        .uri      = "/tmp/*",
+        .method   = HTTP_GET,
+        .handler  = router_handler,
+        .user_ctx = (void *) "<tmp>",
+    };
+    while (!ctx->stop) {
+        if (httpd_register_uri_handler(ctx->hd, &uri) != ESP_OK ||
+            httpd_unregister_uri(ctx->hd, uri.uri) != ESP_OK) {
+            ctx->failures++;
+        }
+    }
+    xSemaphoreGive(ctx->done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("URI Router Update Test", "[HTTP SERVER]")
+{
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    struct router_update_ctx ctx = {
+        .done = xSemaphoreCreateBinary(),
+    };
+    TEST_ASSERT_NOT_NULL(ctx.done);
+
+    test_case_uses_tcpip();
+
+    config.server_port = ROUTER_UPDATE_TEST_PORT;
+    config.ctrl_port += ROUTER_UPDATE_TEST_ID;
+    config.uri_match_fn = httpd_uri_match_wildcard;
+    config.worker_count = 2;
+    TEST_ASSERT(httpd_start(&ctx.hd, &config) == ESP_OK);
+
+    httpd_uri_t items_uri = {
+        .uri      = "/items/*",
+        .method   = HTTP_GET,
+        .handler  = router_handler,
+        .user_ctx = (void *) "<items>",
+    };
+    TEST_ASSERT(httpd_register_uri_handler(ctx.hd, &items_uri) == ESP_OK);
+
+    /* Handlers are (un)registered by another task while the requests are matched */
+    TEST_ASSERT(xTaskCreate(router_update_task, "router_update", 4096, &ctx, tskIDLE_PRIORITY + 1, NULL) == pdPASS);
+    for (int i = 0; i < 50; i++) {
+        test_check_response(test_send_request(ROUTER_UPDATE_TEST_PORT, "/items/1"), "<items>");
+    }
+    ctx.stop = true;
+    TEST_ASSERT(xSemaphoreTake(ctx.done, pdMS_TO_TICKS(1000)) == pdTRUE);
+    TEST_ASSERT_EQUAL(0, ctx.failures);
+
+    TEST_ASSERT(httpd_stop(ctx.hd) == ESP_OK);
+    vSemaphoreDelete(ctx.done);
+}
+
+#if CONFIG_HTTPD_WS_SUPPORT
+
+#define WS_BCAST_TEST_PORT 8086
+#define WS_BCAST_TEST_ID   10
+#define WS_BCAST_FRAME_LEN 2000
+
+/* Lets a frame of the client wait in a worker while frames are broadcast */
+static esp_err_t ws_bcast_handler(httpd_req_t *req)
+{
+    if (req->method == HTTP_GET) {
+        /* Handshake */
+        return ESP_OK;
+    }
+    uint8_t buf[8];
+    httpd_ws_frame_t pkt = {
+        .payload = buf,
+    };
+    esp_err_t ret = httpd_ws_recv_frame(req, &pkt, sizeof(buf));
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    xSemaphoreTake((SemaphoreHandle_t) req->user_ctx, pdMS_TO_TICKS(5000));
+    httpd_ws_frame_t reply = {
+        .type    = HTTPD_WS_TYPE_TEXT,
+        .payload = (uint8_t *) "echo",
+        .len     = 4,
+    };
+    return httpd_ws_send_frame(req, &reply);
+}
+
+static int ws_test_connect(uint16_t port)
+{
+    char resp[256] = {};
+    int fd = test_send_request_hdrs(port, "/ws", "Upgrade: websocket\r\nConnection: Upgrade\r\n"
+                                    "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n");
+    struct timeval tv = { .tv_sec = 1 };
+    TEST_ASSERT(setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0);
+    /* Read the response byte by byte, the frames follow right after it */
+    for (size_t len = 0; len < sizeof(resp) - 1 && strstr(resp, "\r\n\r\n") == NULL; len++) {
+        TEST_ASSERT_EQUAL(1, recv(fd, resp + len, 1, 0));
+    }
+    TEST_ASSERT_NOT_NULL(strstr(resp, "101 Switching Protocols"));
+    return fd;
+}
+
+static bool ws_test_recv_all(int fd, uint8_t *buf, size_t len)
+{
+    while (len) {
+        int ret = recv(fd, buf, len, 0);
+        if (ret <= 0) {
+            return false;
+        }
+        buf += ret;
+        len -= ret;
+    }
+    return true;
+}
+
+/* Receives an unmasked frame from the server, returns the length of its payload or -1 on timeout */
+static int ws_test_recv_frame(int fd, uint8_t *payload, size_t max_len)
+{
+    uint8_t hdr[4];
+    if (!ws_test_recv_all(fd, hdr, 2)) {
+        return -1;
+    }
+    TEST_ASSERT_EQUAL_HEX8(0x80 | HTTPD_WS_TYPE_TEXT, hdr[0]);
+    size_t len = hdr[1];
+    if (len == 126) {
+        TEST_ASSERT(ws_test_recv_all(fd, hdr + 2, 2));
+        len = (hdr[2] << 8) | hdr[3];
+    }
+    TEST_ASSERT(len <= max_len);
+    TEST_ASSERT(ws_test_recv_all(fd, payload, len));
+    return len;
+}
+
+static void ws_test_broadcast(httpd_handle_t hd, const uint8_t *payload, size_t len)
+{
+    httpd_ws_frame_t frame = {
+        .type    = HTTPD_WS_TYPE_TEXT,
+        .payload = (uint8_t *) payload,
+        .len     = len,
+    };
+    TEST_ASSERT(httpd_ws_broadcast(hd, &frame) == ESP_OK);
+    /* Leave the server task time to take the frame from the control socket */
+    vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+TEST_CASE("WebSocket Broadcast Test", "[HTTP SERVER]")
+{
+    httpd_handle_t hd;
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    uint8_t *buf = malloc(WS_BCAST_FRAME_LEN);
+    TEST_ASSERT_NOT_NULL(sem);
+    TEST_ASSERT_NOT_NULL(buf);
+
+    test_case_uses_tcpip();
+
+    config.server_port = WS_BCAST_TEST_PORT;
+    config.ctrl_port += WS_BCAST_TEST_ID;
+    config.worker_count = 1;
+    TEST_ASSERT(httpd_start(&hd, &config) == ESP_OK);
+
+    httpd_uri_t ws_uri = {
+        .uri          = "/ws",
+        .method       = HTTP_GET,
+        .handler      = ws_bcast_handler,
+        .user_ctx     = sem,
+        .is_websocket = true,
+    };
+    TEST_ASSERT(httpd_register_uri_handler(hd, &ws_uri) == ESP_OK);
+    int fd = ws_test_connect(WS_BCAST_TEST_PORT);
+
+    /* A client which keeps up receives every frame, in order */
+    ws_test_broadcast(hd, (const uint8_t *) "b0", 2);
+    ws_test_broadcast(hd, (const uint8_t *) "b1", 2);
+    ws_test_broadcast(hd, (const uint8_t *) "b2", 2);
+    for (char i = '0'; i <= '2'; i++) {
+        TEST_ASSERT_EQUAL(2, ws_test_recv_frame(fd, buf, WS_BCAST_FRAME_LEN));
+        TEST_ASSERT_EQUAL('b', buf[0]);
+        TEST_ASSERT_EQUAL(i, buf[1]);
+    }
+
+    /* A slow client fills its socket and its broadcast queue. Then one of its frames
+     * keeps its session in the worker while the queue overflows again, and the reply
+     * of the worker has to complete the partially sent broadcast frame first. */
+    const int first_count = 4 * CONFIG_HTTPD_WS_BROADCAST_QUEUE_LEN;
+    const int total_count = first_count + CONFIG_HTTPD_WS_BROADCAST_QUEUE_LEN + 2;
+    for (int i = 0; i < first_count; i++) {
+        memset(buf, 'A' + i, WS_BCAST_FRAME_LEN);
+        ws_test_broadcast(hd, buf, WS_BCAST_FRAME_LEN);
+    }
+    const uint8_t ping[] = { 0x80 | HTTPD_WS_TYPE_TEXT, 0x80 | 4, 0, 0, 0, 0, 'p', 'i', 'n', 'g' };
+    TEST_ASSERT_EQUAL(sizeof(ping), send(fd, ping, sizeof(ping), 0));
+    vTaskDelay(pdMS_TO_TICKS(100));
+    for (int i = first_count; i < total_count; i++) {
+        memset(buf, 'A' + i, WS_BCAST_FRAME_LEN);
+        ws_test_broadcast(hd, buf, WS_BCAST_FRAME_LEN);
+    }
+    xSemaphoreGive(sem);
+
+    /* Every frame received is complete, some broadcast frames are dropped,
+     * the others arrive in order and the newest one is never dropped */
+    int received = 0, last = -1;
+    bool echo = false;
+    int len;
+    while ((len = ws_test_recv_frame(fd, buf, WS_BCAST_FRAME_LEN)) >= 0) {
+        if (len == 4 && memcmp(buf, "echo", 4) == 0) {
+            echo = true;
+            continue;
+        }
+        TEST_ASSERT_EQUAL(WS_BCAST_FRAME_LEN, len);
+        for (int i = 1; i < len; i++) {
+            TEST_ASSERT_EQUAL(buf[0], buf[i]);
+        }
+        TEST_ASSERT_GREATER_THAN(last, buf[0] - 'A');
+        last = buf[0] - 'A';
+        received++;
+    }
+    close(fd);
+    TEST_ASSERT_TRUE(echo);
+    TEST_ASSERT_EQUAL(total_count - 1, last);
+    TEST_ASSERT_LESS_THAN(total_count, received);
+
+    TEST_ASSERT(httpd_stop(hd) == ESP_OK);
+    vSemaphoreDelete(sem);
+    free(buf);
+}
+
+#endif /* CONFIG_HTTPD_WS_SUPPORT */
+
 TEST_CASE("Max Allowed Sockets Test", "[HTTP SERVER]")
 {
     test_case_uses_tcpip();
@@ -63,6 +63,9 @@ typedef struct {
     bool partial_http_download;                    /*!< Enable Firmware image to be downloaded over multiple HTTP requests */
     int max_http_request_size;                     /*!< Maximum request size for partial HTTP download */
     uint32_t buffer_caps;                          /*!< The memory capability to use when allocating the buffer for OTA update. Default capability is MALLOC_CAP_DEFAULT */
+    uint8_t write_queue_depth;                     /*!< Number of downloaded buffers which can wait to be written to flash by a separate task, so that the download continues during the flash erases and writes. Set to 0 to write the flash from the task calling `esp_https_ota_perform` */
+    uint8_t max_resume_attempts;                   /*!< Number of times an interrupted download is continued with a HTTP Range request from the data already received. The image size must be known and the server must support Range requests. Set to 0 to fail on the first interruption */
+    bool patch_image;                              /*!< The downloaded file is an OTA patch (see esp_ota_patch.h), a compressed image or a delta against the running app, instead of an app image */
 #if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB || __DOXYGEN__
     decrypt_cb_t decrypt_cb;                       /*!< Callback for external decryption layer */
     void *decrypt_user_ctx;                        /*!< User context for external decryption layer */
@@ -10,9 +10,14 @@
 #include <esp_https_ota.h>
 #include <esp_log.h>
 #include <esp_ota_ops.h>
+#include <esp_ota_patch.h>
 #include <errno.h>
 #include <sys/param.h>
 #include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 
 ESP_EVENT_DEFINE_BASE(ESP_HTTPS_OTA_EVENT);
 
@@ -37,19 +42,38 @@ typedef enum {
     ESP_HTTPS_OTA_SUCCESS,
 } esp_https_ota_state;
 
+/* Chunk of image data queued to the flash write task */
+typedef struct {
+    char *buf;          /* Copy of the downloaded data, not used with the decryption callback */
+    const void *data;   /* Data to write, the copy or the output of the decryption callback */
+    size_t len;
+} ota_write_chunk_t;
+
 struct esp_https_ota_handle {
     esp_ota_handle_t update_handle;
+    esp_ota_patch_handle_t patch_handle;
     const esp_partition_t *update_partition;
     esp_http_client_handle_t http_client;
     char *ota_upgrade_buf;
     size_t ota_upgrade_buf_size;
     int binary_file_len;
+    int received_len;
+    int http_read_len;
     int image_length;
     int max_http_request_size;
     esp_https_ota_state state;
     bool bulk_flash_erase;
     bool partial_http_download;
+    bool patch_image;
     int max_authorization_retries;
+    int resume_attempts;
+    int write_queue_depth;
+    ota_write_chunk_t *write_chunks;
+    QueueHandle_t free_queue;
+    QueueHandle_t write_queue;
+    SemaphoreHandle_t write_done;
+    TaskHandle_t write_task;
+    esp_err_t write_err;
 #if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
     decrypt_cb_t decrypt_cb;
     void *decrypt_user_ctx;
@@ -235,9 +259,14 @@ static esp_err_t _ota_write(esp_https_ota_t *https_ota_handle, const void *buffe
     if (buffer == NULL || https_ota_handle == NULL) {
         return ESP_FAIL;
     }
-    esp_err_t err = esp_ota_write(https_ota_handle->update_handle, buffer, buf_len);
+    esp_err_t err;
+    if (https_ota_handle->patch_handle) {
+        err = esp_ota_patch_write(https_ota_handle->patch_handle, buffer, buf_len);
+    } else {
+        err = esp_ota_write(https_ota_handle->update_handle, buffer, buf_len);
+    }
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Error: esp_ota_write failed! err=0x%x", err);
+        ESP_LOGE(TAG, "Error: %s failed! err=0x%x", https_ota_handle->patch_handle ? "esp_ota_patch_write" : "esp_ota_write", err);
     } else {
         https_ota_handle->binary_file_len += buf_len;
         ESP_LOGD(TAG, "Written image length %d", https_ota_handle->binary_file_len);
@@ -251,6 +280,165 @@ static esp_err_t _ota_write(esp_https_ota_t *https_ota_handle, const void *buffe
     return err;
 }
 
+/*
+ * The flash write task writes the downloaded chunks while the HTTP client receives the next ones, so the download doesn't
+ * stall during the flash erases. The chunks go round from the free queue to the write queue and back, a NULL chunk asks
+ * the task to exit once the queued chunks are written.
+ */
+static void _ota_write_task(void *arg)
+{
+    esp_https_ota_t *handle = (esp_https_ota_t *)arg;
+    ota_write_chunk_t *chunk = NULL;
+
+    while (xQueueReceive(handle->write_queue, &chunk, portMAX_DELAY) == pdTRUE && chunk != NULL) {
+        if (handle->write_err == ESP_OK) {
+            esp_err_t err = _ota_write(handle, chunk->data, chunk->len);
+            if (err != ESP_ERR_HTTPS_OTA_IN_PROGRESS) {
+                handle->write_err = err;
+            }
+        } else {
+#if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
+            esp_https_ota_decrypt_cb_free_buf((void *)chunk->data);
+#endif
+        }
+        xQueueSend(handle->free_queue, &chunk, portMAX_DELAY);
+    }
+    xSemaphoreGive(handle->write_done);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t _ota_write_pipeline_init(esp_https_ota_t *handle, size_t buf_size, uint32_t buffer_caps)
+{
+    const int depth = handle->write_queue_depth;
+    handle->write_chunks = calloc(depth, sizeof(ota_write_chunk_t));
+    handle->free_queue = xQueueCreate(depth, sizeof(ota_write_chunk_t *));
+    // One more entry for the NULL chunk ending the task
+    handle->write_queue = xQueueCreate(depth + 1, sizeof(ota_write_chunk_t *));
+    handle->write_done = xSemaphoreCreateBinary();
+    if (!handle->write_chunks || !handle->free_queue || !handle->write_queue || !handle->write_done) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (int i = 0; i < depth; i++) {
+        ota_write_chunk_t *chunk = &handle->write_chunks[i];
+#if !CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
+        chunk->buf = buffer_caps ? heap_caps_malloc(buf_size, buffer_caps) : malloc(buf_size);
+        if (!chunk->buf) {
+            return ESP_ERR_NO_MEM;
+        }
+#endif
+        xQueueSend(handle->free_queue, &chunk, 0);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t _ota_write_pipeline_deinit(esp_https_ota_t *handle)
+{
+    if (handle->write_task) {
+        ota_write_chunk_t *end = NULL;
+        xQueueSend(handle->write_queue, &end, portMAX_DELAY);
+        xSemaphoreTake(handle->write_done, portMAX_DELAY);
+        handle->write_task = NULL;
+    }
+    if (handle->write_chunks) {
+        for (int i = 0; i < handle->write_queue_depth; i++) {
+            free(handle->write_chunks[i].buf);
+        }
+        free(handle->write_chunks);
+        handle->write_chunks = NULL;
+    }
+    if (handle->free_queue) {
+        vQueueDelete(handle->free_queue);
+        handle->free_queue = NULL;
+    }
+    if (handle->write_queue) {
+        vQueueDelete(handle->write_queue);
+        handle->write_queue = NULL;
+    }
+    if (handle->write_done) {
+        vSemaphoreDelete(handle->write_done);
+        handle->write_done = NULL;
+    }
+    return handle->write_err;
+}
+
+static esp_err_t _ota_queue_write(esp_https_ota_t *https_ota_handle, const void *buffer, size_t buf_len)
+{
+    https_ota_handle->received_len += buf_len;
+    if (https_ota_handle->write_task == NULL) {
+        return _ota_write(https_ota_handle, buffer, buf_len);
+    }
+
+    ota_write_chunk_t *chunk = NULL;
+    // Waits while all the chunks are queued to the flash write task
+    xQueueReceive(https_ota_handle->free_queue, &chunk, portMAX_DELAY);
+    if (https_ota_handle->write_err != ESP_OK) {
+        xQueueSend(https_ota_handle->free_queue, &chunk, 0);
+#if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
+        esp_https_ota_decrypt_cb_free_buf((void *)buffer);
+#endif
+        return https_ota_handle->write_err;
+    }
+#if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
+    // The output of the decryption callback is freed by the flash write task once written
+    chunk->data = buffer;
+#else
+    memcpy(chunk->buf, buffer, buf_len);
+    chunk->data = chunk->buf;
+#endif
+    chunk->len = buf_len;
+    xQueueSend(https_ota_handle->write_queue, &chunk, portMAX_DELAY);
+    return ESP_ERR_HTTPS_OTA_IN_PROGRESS;
+}
+
+/* Request the image data from `offset` on a new connection */
+static esp_err_t _http_request_range(esp_https_ota_t *handle, int offset)
+{
+    char *header_val = NULL;
+    int header_size = 0;
+#if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
+    header_size = handle->enc_img_header_size;
+#endif
+    esp_http_client_close(handle->http_client);
+    if (handle->partial_http_download && (handle->image_length + header_size - offset) > handle->max_http_request_size) {
+        asprintf(&header_val, "bytes=%d-%d", offset, offset + handle->max_http_request_size - 1);
+    } else {
+        asprintf(&header_val, "bytes=%d-", offset);
+    }
+    if (header_val == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate memory for HTTP header");
+        return ESP_ERR_NO_MEM;
+    }
+    esp_http_client_set_header(handle->http_client, "Range", header_val);
+    free(header_val);
+    esp_err_t err = _http_connect(handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to establish HTTP connection");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/* Continue an interrupted download with a HTTP Range request from the data read so far */
+static esp_err_t _http_resume(esp_https_ota_t *handle)
+{
+    if (handle->image_length <= 0) {
+        return ESP_FAIL;
+    }
+    while (handle->resume_attempts > 0) {
+        handle->resume_attempts--;
+        ESP_LOGW(TAG, "Download interrupted after %d bytes, resuming", handle->http_read_len);
+        if (_http_request_range(handle, handle->http_read_len) != ESP_OK) {
+            continue;
+        }
+        if (esp_http_client_get_status_code(handle->http_client) != HttpStatus_PartialContent) {
+            ESP_LOGE(TAG, "Server doesn't support HTTP Range requests");
+            return ESP_FAIL;
+        }
+        return ESP_ERR_HTTPS_OTA_IN_PROGRESS;
+    }
+    return ESP_FAIL;
+}
+
 static bool is_server_verification_enabled(const esp_https_ota_config_t *ota_config) {
     return  (ota_config->http_config->cert_pem
             || ota_config->http_config->use_global_ca_store
@@ -289,8 +477,11 @@ esp_err_t esp_https_ota_begin(const esp_https_ota_config_t *ota_config, esp_http
     }
 
     https_ota_handle->partial_http_download = ota_config->partial_http_download;
+    https_ota_handle->patch_image = ota_config->patch_image;
     https_ota_handle->max_http_request_size = (ota_config->max_http_request_size == 0) ? DEFAULT_REQUEST_SIZE : ota_config->max_http_request_size;
     https_ota_handle->max_authorization_retries = ota_config->http_config->max_authorization_retries;
+    https_ota_handle->resume_attempts = ota_config->max_resume_attempts;
+    https_ota_handle->write_queue_depth = ota_config->write_queue_depth;
 
     if (https_ota_handle->max_authorization_retries == 0) {
         https_ota_handle->max_authorization_retries = DEFAULT_MAX_AUTH_RETRIES;
@@ -399,6 +590,15 @@ esp_err_t esp_https_ota_begin(const esp_https_ota_config_t *ota_config, esp_http
     https_ota_handle->decrypt_user_ctx = ota_config->decrypt_user_ctx;
     https_ota_handle->enc_img_header_size = ota_config->enc_img_header_size;
 #endif
+    if (https_ota_handle->write_queue_depth > 0) {
+        err = _ota_write_pipeline_init(https_ota_handle, alloc_size, ota_config->buffer_caps);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Couldn't allocate memory to pipeline the flash writes");
+            _ota_write_pipeline_deinit(https_ota_handle);
+            free(https_ota_handle->ota_upgrade_buf);
+            goto http_cleanup;
+        }
+    }
     https_ota_handle->ota_upgrade_buf_size = alloc_size;
     https_ota_handle->bulk_flash_erase = ota_config->bulk_flash_erase;
     https_ota_handle->binary_file_len = 0;
@@ -446,6 +646,7 @@ static esp_err_t read_header(esp_https_ota_t *handle)
         return ESP_FAIL;
     }
     handle->binary_file_len = bytes_read;
+    handle->http_read_len += bytes_read;
     return ESP_OK;
 }
 
@@ -464,6 +665,10 @@ esp_err_t esp_https_ota_get_img_desc(esp_https_ota_handle_t https_ota_handle, es
         ESP_LOGE(TAG, "esp_https_ota_get_img_desc: Invalid argument");
         return ESP_ERR_INVALID_ARG;
     }
+    if (handle->patch_image) {
+        // The app descriptor of a patch is only known once the patch is applied
+        return ESP_ERR_NOT_SUPPORTED;
+    }
     if (handle->state < ESP_HTTPS_OTA_BEGIN) {
         ESP_LOGE(TAG, "esp_https_ota_get_img_desc: Invalid state");
         return ESP_ERR_INVALID_STATE;
@@ -509,7 +714,9 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
 
     esp_err_t err;
     int data_read;
-    const int erase_size = handle->bulk_flash_erase ? (handle->image_length > 0 ? handle->image_length : OTA_SIZE_UNKNOWN) : OTA_WITH_SEQUENTIAL_WRITES;
+    // The size of a patch isn't the size of the resulting image
+    const int image_size = handle->patch_image ? 0 : handle->image_length;
+    const int erase_size = handle->bulk_flash_erase ? (image_size > 0 ? image_size : OTA_SIZE_UNKNOWN) : OTA_WITH_SEQUENTIAL_WRITES;
     switch (handle->state) {
         case ESP_HTTPS_OTA_BEGIN:
             err = esp_ota_begin(handle->update_partition, erase_size, &handle->update_handle);
@@ -518,6 +725,20 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
                 return err;
             }
             handle->state = ESP_HTTPS_OTA_IN_PROGRESS;
+            if (handle->patch_image) {
+                err = esp_ota_patch_begin(handle->update_handle, &handle->patch_handle);
+                if (err != ESP_OK) {
+                    ESP_LOGE(TAG, "esp_ota_patch_begin failed (%s)", esp_err_to_name(err));
+                    return err;
+                }
+            }
+            if (handle->write_queue_depth > 0) {
+                if (xTaskCreate(_ota_write_task, "ota_write", CONFIG_ESP_HTTPS_OTA_WRITE_TASK_STACK_SIZE, handle,
+                                CONFIG_ESP_HTTPS_OTA_WRITE_TASK_PRIORITY, &handle->write_task) != pdPASS) {
+                    ESP_LOGE(TAG, "Failed to create the flash write task");
+                    return ESP_ERR_NO_MEM;
+                }
+            }
             /* In case `esp_https_ota_get_img_desc` was invoked first,
                then the image data read there should be written to OTA partition
                */
@@ -550,11 +771,14 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
                 return ESP_FAIL;
             }
 #endif // CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
-            err = esp_ota_verify_chip_id(data_buf);
-            if (err != ESP_OK) {
-                return err;
+            if (!handle->patch_image) {
+                // The chip ID of a patch is verified by esp_ota_end() once the image is produced
+                err = esp_ota_verify_chip_id(data_buf);
+                if (err != ESP_OK) {
+                    return err;
+                }
             }
-            return _ota_write(handle, data_buf, binary_file_len);
+            return _ota_queue_write(handle, data_buf, binary_file_len);
         case ESP_HTTPS_OTA_IN_PROGRESS:
             data_read = esp_http_client_read(handle->http_client,
                                              handle->ota_upgrade_buf,
@@ -565,11 +789,15 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
                  *  complete image is received.
                  */
                 if (!esp_http_client_is_complete_data_received(handle->http_client)) {
+                    if (handle->resume_attempts > 0) {
+                        return _http_resume(handle);
+                    }
                     ESP_LOGE(TAG, "Connection closed before complete data was received!");
                     return ESP_FAIL;
                 }
                 ESP_LOGD(TAG, "Connection closed");
             } else if (data_read > 0) {
+                handle->http_read_len += data_read;
                 const void *data_buf = (const void *) handle->ota_upgrade_buf;
                 int data_len = data_read;
 #if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
@@ -584,16 +812,19 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
                     return err;
                 }
 #endif // CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
-                return _ota_write(handle, data_buf, data_len);
+                return _ota_queue_write(handle, data_buf, data_len);
             } else {
                 if (data_read == -ESP_ERR_HTTP_EAGAIN) {
                     ESP_LOGD(TAG, "ESP_ERR_HTTP_EAGAIN invoked: Call timed out before data was ready");
                     return ESP_ERR_HTTPS_OTA_IN_PROGRESS;
                 }
+                if (handle->resume_attempts > 0) {
+                    return _http_resume(handle);
+                }
                 ESP_LOGE(TAG, "data read %d, errno %d", data_read, errno);
                 return ESP_FAIL;
             }
-            if (!handle->partial_http_download || (handle->partial_http_download && handle->image_length == handle->binary_file_len)) {
+            if (!handle->partial_http_download || (handle->partial_http_download && handle->image_length == handle->received_len)) {
                 handle->state = ESP_HTTPS_OTA_SUCCESS;
             }
             break;
@@ -603,28 +834,14 @@ esp_err_t esp_https_ota_perform(esp_https_ota_handle_t https_ota_handle)
             break;
     }
     if (handle->partial_http_download) {
-        if (handle->state == ESP_HTTPS_OTA_IN_PROGRESS && handle->image_length > handle->binary_file_len) {
-            esp_http_client_close(handle->http_client);
-            char *header_val = NULL;
+        if (handle->state == ESP_HTTPS_OTA_IN_PROGRESS && handle->image_length > handle->received_len) {
             int header_size = 0;
 #if CONFIG_ESP_HTTPS_OTA_DECRYPT_CB
             header_size = handle->enc_img_header_size;
 #endif
-            if ((handle->image_length - handle->binary_file_len) > handle->max_http_request_size) {
-                asprintf(&header_val, "bytes=%d-%d", handle->binary_file_len + header_size, (handle->binary_file_len + header_size + handle->max_http_request_size - 1));
-            } else {
-                asprintf(&header_val, "bytes=%d-", handle->binary_file_len + header_size);
-            }
-            if (header_val == NULL) {
-                ESP_LOGE(TAG, "Failed to allocate memory for HTTP header");
-                return ESP_ERR_NO_MEM;
-            }
-            esp_http_client_set_header(handle->http_client, "Range", header_val);
-            free(header_val);
-            err = _http_connect(handle);
+            err = _http_request_range(handle, handle->received_len + header_size);
             if (err != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to establish HTTP connection");
-                return ESP_FAIL;
+                return err;
             }
             ESP_LOGD(TAG, "Connection start");
             return ESP_ERR_HTTPS_OTA_IN_PROGRESS;
@@ -638,7 +855,7 @@ bool esp_https_ota_is_complete_data_received(esp_https_ota_handle_t https_ota_ha
     bool ret = false;
     esp_https_ota_t *handle = (esp_https_ota_t *)https_ota_handle;
     if (handle->partial_http_download) {
-        ret = (handle->image_length == handle->binary_file_len);
+        ret = (handle->image_length == handle->received_len);
     } else {
         ret = esp_http_client_is_complete_data_received(handle->http_client);
     }
@@ -659,9 +876,24 @@ esp_err_t esp_https_ota_finish(esp_https_ota_handle_t https_ota_handle)
     switch (handle->state) {
         case ESP_HTTPS_OTA_SUCCESS:
         case ESP_HTTPS_OTA_IN_PROGRESS:
-            err = esp_ota_end(handle->update_handle);
+            // Wait for the queued chunks to be written
+            err = _ota_write_pipeline_deinit(handle);
+            if (handle->patch_handle) {
+                if (err == ESP_OK) {
+                    err = esp_ota_patch_end(handle->patch_handle);
+                } else {
+                    esp_ota_patch_abort(handle->patch_handle);
+                }
+                handle->patch_handle = NULL;
+            }
+            if (err == ESP_OK) {
+                err = esp_ota_end(handle->update_handle);
+            } else {
+                esp_ota_abort(handle->update_handle);
+            }
             /* falls through */
         case ESP_HTTPS_OTA_BEGIN:
+            _ota_write_pipeline_deinit(handle);
             if (handle->ota_upgrade_buf) {
                 free(handle->ota_upgrade_buf);
             }
@@ -705,9 +937,15 @@ esp_err_t esp_https_ota_abort(esp_https_ota_handle_t https_ota_handle)
     switch (handle->state) {
         case ESP_HTTPS_OTA_SUCCESS:
         case ESP_HTTPS_OTA_IN_PROGRESS:
+            _ota_write_pipeline_deinit(handle);
+            if (handle->patch_handle) {
+                esp_ota_patch_abort(handle->patch_handle);
+                handle->patch_handle = NULL;
+            }
             err = esp_ota_abort(handle->update_handle);
             /* falls through */
         case ESP_HTTPS_OTA_BEGIN:
+            _ota_write_pipeline_deinit(handle);
             if (handle->ota_upgrade_buf) {
                 free(handle->ota_upgrade_buf);
             }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -113,6 +113,11 @@ struct httpd_ssl_config {
     /** Enable tls session tickets */
     bool session_tickets;
 
+    /** Number of tls sessions kept in the session cache shared by all connections, so that clients can
+     *  resume a session by its ID without a full handshake. 0 disables the cache, which needs
+     *  CONFIG_ESP_TLS_SERVER_SESSION_CACHE */
+    size_t session_cache_size;
+
     /** Enable secure element for server session */
     bool use_secure_element;
 
@@ -148,6 +153,9 @@ typedef struct httpd_ssl_config httpd_ssl_config_t;
         .stack_size         = 10240,              \
         .core_id            = tskNO_AFFINITY,     \
         .task_caps          = (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT),       \
+        .worker_count       = 0,                  \
+        .worker_stack_size  = 10240,              \
+        .worker_core_id     = tskNO_AFFINITY,     \
         .server_port        = 0,                  \
         .ctrl_port   = ESP_HTTPD_DEF_CTRL_PORT+1, \
         .max_open_sockets   = 4,                  \
@@ -183,6 +191,7 @@ typedef struct httpd_ssl_config httpd_ssl_config_t;
     .port_secure = 443,                           \
     .port_insecure = 80,                          \
     .session_tickets = false,                     \
+    .session_cache_size = 0,                      \
     .use_secure_element = false,                  \
     .user_cb = NULL,                              \
     .ssl_userdata = NULL,                         \
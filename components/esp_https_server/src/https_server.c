@@ -251,6 +251,7 @@ static void free_secure_context(void *ctx)
         free((void *)cfg->serverkey_buf);
     }
     esp_tls_cfg_server_session_tickets_free(cfg);
+    esp_tls_cfg_server_session_cache_free(cfg);
     free(cfg);
     free(ssl_ctx);
 }
@@ -275,6 +276,14 @@ static esp_err_t create_secure_context(const struct httpd_ssl_config *config, ht
         }
     }
 
+    if (config->session_cache_size > 0) {
+        ret = esp_tls_cfg_server_session_cache_init(cfg, config->session_cache_size);
+        if ( ret != ESP_OK ) {
+            ESP_LOGE(TAG, "Failed to init session cache. error: %s", esp_err_to_name(ret));
+            goto exit;
+        }
+    }
+
     cfg->userdata = config->ssl_userdata;
     cfg->alpn_protos = config->alpn_protos;
 
@@ -371,6 +380,7 @@ exit:
     if (cfg) {
         free((void *) cfg->servercert_buf);
         free((void *) cfg->cacert_buf);
+        esp_tls_cfg_server_session_cache_free(cfg);
     }
     free(cfg);
     return ret;
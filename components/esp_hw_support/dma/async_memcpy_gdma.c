@@ -54,8 +54,10 @@ typedef struct async_memcpy_transaction_t {
     mcp_dma_descriptor_t *rx_desc_nc;   // non-cacheable version of rx_desc_link
     intptr_t tx_start_desc_addr; // TX start descriptor address
     intptr_t rx_start_desc_addr; // RX start descriptor address
-    void *memcpy_dst_addr;       // memcpy destination address
-    size_t memcpy_size;          // memcpy size
+    async_memcpy_segment_t *segments;      // copy segments, the destination buffers may need data cache invalidate later
+    size_t num_segments;                   // number of copy segments
+    async_memcpy_segment_t single_segment; // storage for the segment of a single-buffer transaction
+    uint8_t *pattern_buf;                  // source pattern of the memset transaction, NULL for memcpy
     async_memcpy_isr_cb_t cb;    // user callback
     void *cb_args;               // user callback args
     STAILQ_ENTRY(async_memcpy_transaction_t) idle_queue_entry;  // Entry for the idle queue
@@ -86,6 +88,9 @@ typedef struct {
 static bool mcp_gdma_rx_eof_callback(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data);
 static esp_err_t mcp_gdma_del(async_memcpy_context_t *ctx);
 static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args);
+static esp_err_t mcp_gdma_memcpy_batch(async_memcpy_context_t *ctx, const async_memcpy_segment_t *segments, size_t num_segments,
+                                       async_memcpy_isr_cb_t cb_isr, void *cb_args);
+static esp_err_t mcp_gdma_memset(async_memcpy_context_t *ctx, void *dst, uint8_t value, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args);
 #if SOC_GDMA_SUPPORT_ETM
 static esp_err_t mcp_new_etm_event(async_memcpy_context_t *ctx, async_memcpy_etm_event_t event_type, esp_etm_event_handle_t *out_event);
 #endif // SOC_GDMA_SUPPORT_ETM
@@ -179,6 +184,8 @@ static esp_err_t esp_async_memcpy_install_gdma_template(const async_memcpy_confi
     mcp_gdma->max_single_dma_buffer = ALIGN_DOWN(DMA_DESCRIPTOR_BUFFER_MAX_SIZE, buf_align);
     mcp_gdma->parent.del = mcp_gdma_del;
     mcp_gdma->parent.memcpy = mcp_gdma_memcpy;
+    mcp_gdma->parent.memcpy_batch = mcp_gdma_memcpy_batch;
+    mcp_gdma->parent.memset = mcp_gdma_memset;
 #if SOC_GDMA_SUPPORT_ETM
     mcp_gdma->parent.new_etm_event = mcp_new_etm_event;
 #endif
@@ -227,59 +234,62 @@ static esp_err_t mcp_gdma_del(async_memcpy_context_t *ctx)
     return mcp_gdma_destroy(mcp_gdma);
 }
 
-static void mount_tx_buffer_to_dma(async_memcpy_transaction_t *trans, int num_desc,
-                                   uint8_t *buf, size_t buf_sz, size_t max_single_dma_buffer)
+static void mount_tx_segments_to_dma(async_memcpy_transaction_t *trans, const async_memcpy_segment_t *segments,
+                                     size_t num_segments, size_t max_single_dma_buffer)
 {
     mcp_dma_descriptor_t *desc_array = trans->tx_desc_link;
     mcp_dma_descriptor_t *desc_nc = trans->tx_desc_nc;
-    uint32_t prepared_length = 0;
-    size_t len = buf_sz;
-    for (int i = 0; i < num_desc - 1; i++) {
-        desc_nc[i].buffer = &buf[prepared_length];
-        desc_nc[i].dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
-        desc_nc[i].dw0.suc_eof = 0;
-        desc_nc[i].dw0.size = max_single_dma_buffer;
-        desc_nc[i].dw0.length = max_single_dma_buffer;
-        desc_nc[i].next = &desc_array[i + 1];
-        prepared_length += max_single_dma_buffer;
-        len -= max_single_dma_buffer;
+    int i = 0;
+    for (size_t s = 0; s < num_segments; s++) {
+        // memset reads the pattern buffer for every descriptor
+        uint8_t *buf = trans->pattern_buf ? trans->pattern_buf : segments[s].src;
+        uint32_t prepared_length = 0;
+        size_t len = segments[s].size;
+        while (len) {
+            size_t chunk = MIN(len, max_single_dma_buffer);
+            desc_nc[i].buffer = trans->pattern_buf ? buf : &buf[prepared_length];
+            desc_nc[i].dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+            desc_nc[i].dw0.suc_eof = 0;
+            desc_nc[i].dw0.size = chunk;
+            desc_nc[i].dw0.length = chunk;
+            desc_nc[i].next = &desc_array[i + 1];
+            prepared_length += chunk;
+            len -= chunk;
+            i++;
+        }
     }
     // take special care to the EOF descriptor
-    desc_nc[num_desc - 1].buffer = &buf[prepared_length];
-    desc_nc[num_desc - 1].next = NULL;
-    desc_nc[num_desc - 1].dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
-    desc_nc[num_desc - 1].dw0.suc_eof = 1;
-    desc_nc[num_desc - 1].dw0.size = len;
-    desc_nc[num_desc - 1].dw0.length = len;
+    desc_nc[i - 1].next = NULL;
+    desc_nc[i - 1].dw0.suc_eof = 1;
 }
 
-static void mount_rx_buffer_to_dma(async_memcpy_transaction_t *trans, int num_desc,
-                                   uint8_t *buf, size_t buf_sz, size_t max_single_dma_buffer)
+static void mount_rx_segments_to_dma(async_memcpy_transaction_t *trans, int num_desc, const async_memcpy_segment_t *segments,
+                                     size_t num_segments, size_t max_single_dma_buffer)
 {
     mcp_dma_descriptor_t *desc_array = trans->rx_desc_link;
     mcp_dma_descriptor_t *desc_nc = trans->rx_desc_nc;
     mcp_dma_descriptor_t *eof_desc = &trans->eof_node;
     mcp_dma_descriptor_t *eof_nc = (mcp_dma_descriptor_t *)MCP_GET_NON_CACHE_ADDR(eof_desc);
-    uint32_t prepared_length = 0;
-    size_t len = buf_sz;
-    if (desc_array) {
-        assert(num_desc > 0);
-        for (int i = 0; i < num_desc; i++) {
-            desc_nc[i].buffer = &buf[prepared_length];
-            desc_nc[i].dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
-            desc_nc[i].dw0.size = max_single_dma_buffer;
-            desc_nc[i].dw0.length = max_single_dma_buffer;
-            desc_nc[i].next = &desc_array[i + 1];
-            prepared_length += max_single_dma_buffer;
-            len -= max_single_dma_buffer;
+    int i = 0;
+    for (size_t s = 0; s < num_segments; s++) {
+        uint8_t *buf = segments[s].dst;
+        uint32_t prepared_length = 0;
+        size_t len = segments[s].size;
+        while (len) {
+            size_t chunk = MIN(len, max_single_dma_buffer);
+            // the last piece goes to the EOF descriptor
+            mcp_dma_descriptor_t *d = (i < num_desc) ? &desc_nc[i] : eof_nc;
+            d->buffer = &buf[prepared_length];
+            d->dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+            d->dw0.size = chunk;
+            d->dw0.length = chunk;
+            d->next = (i < num_desc - 1) ? &desc_array[i + 1] : eof_desc;
+            prepared_length += chunk;
+            len -= chunk;
+            i++;
         }
-        desc_nc[num_desc - 1].next = eof_desc;
     }
-    eof_nc->buffer = &buf[prepared_length];
     eof_nc->next = NULL;
-    eof_nc->dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
-    eof_nc->dw0.size = len;
-    eof_nc->dw0.length = len;
 }
 
 /// @brief help function to get one transaction from the ready queue
@@ -351,11 +361,8 @@ static bool check_buffer_alignment(async_memcpy_gdma_context_t *mcp_gdma, void *
     return valid;
 }
 
-static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args)
+static esp_err_t check_buffer_location(async_memcpy_gdma_context_t *mcp_gdma, void *src, void *dst)
 {
-    esp_err_t ret = ESP_OK;
-    async_memcpy_gdma_context_t *mcp_gdma = __containerof(ctx, async_memcpy_gdma_context_t, parent);
-    // buffer location check
 #if SOC_AHB_GDMA_SUPPORTED && !SOC_AHB_GDMA_SUPPORT_PSRAM
     if (mcp_gdma->gdma_bus_id == SOC_GDMA_BUS_AHB) {
         ESP_RETURN_ON_FALSE(esp_ptr_internal(src) && esp_ptr_internal(dst), ESP_ERR_INVALID_ARG, TAG, "AHB GDMA can only access SRAM");
@@ -366,8 +373,63 @@ static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *s
         ESP_RETURN_ON_FALSE(esp_ptr_internal(src) && esp_ptr_internal(dst), ESP_ERR_INVALID_ARG, TAG, "AXI DMA can only access SRAM");
     }
 #endif // SOC_AXI_GDMA_SUPPORTED && !SOC_AXI_GDMA_SUPPORT_PSRAM
-    // alignment check
-    ESP_RETURN_ON_FALSE(check_buffer_alignment(mcp_gdma, src, dst, n), ESP_ERR_INVALID_ARG, TAG, "buffer not aligned: %p -> %p, sz=%zu", src, dst, n);
+    return ESP_OK;
+}
+
+static bool buffer_need_cache_sync(const void *buf)
+{
+    if (esp_ptr_external_ram(buf)) {
+        return true;
+    } else if (esp_ptr_internal(buf)) {
+#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
+        return true;
+#endif
+    }
+    return false;
+}
+
+static void free_trans_resources(async_memcpy_transaction_t *trans)
+{
+    if (trans->tx_desc_link) {
+        free(trans->tx_desc_link);
+        trans->tx_desc_link = NULL;
+    }
+    if (trans->rx_desc_link) {
+        free(trans->rx_desc_link);
+        trans->rx_desc_link = NULL;
+    }
+    if (trans->segments != &trans->single_segment) {
+        free(trans->segments);
+    }
+    trans->segments = NULL;
+    if (trans->pattern_buf) {
+        free(trans->pattern_buf);
+        trans->pattern_buf = NULL;
+    }
+}
+
+/// @brief help function to submit a transaction, which is made up of one or more memory segments
+/// @note all the segments are carried by one DMA descriptor link, so there's only one EOF interrupt for the whole transaction
+/// @note if the memset_value is not negative, the source of the segments is ignored, the destination is filled with the value instead
+static esp_err_t mcp_gdma_submit(async_memcpy_gdma_context_t *mcp_gdma, const async_memcpy_segment_t *segments, size_t num_segments,
+                                 int memset_value, async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    esp_err_t ret = ESP_OK;
+    size_t max_single_dma_buffer = mcp_gdma->max_single_dma_buffer;
+    uint32_t num_desc_per_path = 0;
+    for (size_t i = 0; i < num_segments; i++) {
+        void *src = segments[i].src;
+        size_t n = segments[i].size;
+        ESP_RETURN_ON_FALSE(segments[i].dst && n && (src || memset_value >= 0), ESP_ERR_INVALID_ARG, TAG, "invalid segment %zu", i);
+        // buffer location check
+        ESP_RETURN_ON_ERROR(check_buffer_location(mcp_gdma, memset_value >= 0 ? segments[i].dst : src, segments[i].dst), TAG,
+                            "invalid buffer location");
+        // alignment check, the pattern buffer of memset is always aligned
+        ESP_RETURN_ON_FALSE(check_buffer_alignment(mcp_gdma, memset_value >= 0 ? NULL : src, segments[i].dst, n),
+                            ESP_ERR_INVALID_ARG, TAG, "buffer not aligned: %p -> %p, sz=%zu", src, segments[i].dst, n);
+        // calculate how many descriptors we want
+        num_desc_per_path += (n + max_single_dma_buffer - 1) / max_single_dma_buffer;
+    }
 
     async_memcpy_transaction_t *trans = NULL;
     // pick one transaction node from idle queue
@@ -375,9 +437,29 @@ static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *s
     // check if we get the transaction object successfully
     ESP_RETURN_ON_FALSE(trans, ESP_ERR_INVALID_STATE, TAG, "no free node in the idle queue");
 
-    // calculate how many descriptors we want
-    size_t max_single_dma_buffer = mcp_gdma->max_single_dma_buffer;
-    uint32_t num_desc_per_path = (n + max_single_dma_buffer - 1) / max_single_dma_buffer;
+    // save the segments, the destination buffers are needed by the cache invalidation when the transaction is done
+    if (num_segments == 1) {
+        trans->segments = &trans->single_segment;
+    } else {
+        trans->segments = heap_caps_malloc(num_segments * sizeof(async_memcpy_segment_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        ESP_GOTO_ON_FALSE(trans->segments, ESP_ERR_NO_MEM, err, TAG, "no mem for segments");
+    }
+    memcpy(trans->segments, segments, num_segments * sizeof(async_memcpy_segment_t));
+    trans->num_segments = num_segments;
+
+    if (memset_value >= 0) {
+        // the DMA reads the same pattern buffer repeatedly, which is as big as a single DMA descriptor can carry
+        size_t pattern_size = MIN(segments[0].size, max_single_dma_buffer);
+        size_t pattern_align = MAX(MAX(mcp_gdma->tx_int_mem_alignment, cache_hal_get_cache_line_size(CACHE_LL_LEVEL_INT_MEM, CACHE_TYPE_DATA)), 4);
+        trans->pattern_buf = heap_caps_aligned_alloc(pattern_align, (pattern_size + pattern_align - 1) & ~(pattern_align - 1),
+                                                     MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(trans->pattern_buf, ESP_ERR_NO_MEM, err, TAG, "no mem for memset pattern");
+        memset(trans->pattern_buf, memset_value, pattern_size);
+        if (buffer_need_cache_sync(trans->pattern_buf)) {
+            esp_cache_msync(trans->pattern_buf, (pattern_size + pattern_align - 1) & ~(pattern_align - 1), ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+        }
+    }
+
     // allocate DMA descriptors from internal memory
     trans->tx_desc_link = heap_caps_aligned_calloc(MCP_DMA_DESC_ALIGN, num_desc_per_path, sizeof(mcp_dma_descriptor_t),
                                                    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
@@ -396,28 +478,22 @@ static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *s
     }
 
     // (preload) mount src data to the TX descriptor
-    mount_tx_buffer_to_dma(trans, num_desc_per_path, src, n, max_single_dma_buffer);
+    mount_tx_segments_to_dma(trans, segments, num_segments, max_single_dma_buffer);
     // (preload) mount dst data to the RX descriptor
-    mount_rx_buffer_to_dma(trans, num_desc_per_path - 1, dst, n, max_single_dma_buffer);
+    mount_rx_segments_to_dma(trans, num_desc_per_path - 1, segments, num_segments, max_single_dma_buffer);
 
     // if the data is in the cache, write back, then DMA can see the latest data
-    bool need_write_back = false;
-    if (esp_ptr_external_ram(src)) {
-        need_write_back = true;
-    } else if (esp_ptr_internal(src)) {
-#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
-        need_write_back = true;
-#endif
-    }
-    if (need_write_back) {
-        esp_cache_msync(src, n, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+    if (memset_value < 0) {
+        for (size_t i = 0; i < num_segments; i++) {
+            if (buffer_need_cache_sync(segments[i].src)) {
+                esp_cache_msync(segments[i].src, segments[i].size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+            }
+        }
     }
 
     // save other transaction context
     trans->cb = cb_isr;
     trans->cb_args = cb_args;
-    trans->memcpy_size = n;
-    trans->memcpy_dst_addr = dst; // save the destination buffer address, because we may need to do data cache invalidate later
     trans->tx_start_desc_addr = (intptr_t)trans->tx_desc_link;
     trans->rx_start_desc_addr = trans->rx_desc_link ? (intptr_t)trans->rx_desc_link : (intptr_t)&trans->eof_node;
 
@@ -433,14 +509,7 @@ static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *s
 
 err:
     if (trans) {
-        if (trans->tx_desc_link) {
-            free(trans->tx_desc_link);
-            trans->tx_desc_link = NULL;
-        }
-        if (trans->rx_desc_link) {
-            free(trans->rx_desc_link);
-            trans->rx_desc_link = NULL;
-        }
+        free_trans_resources(trans);
         // return back the trans to idle queue
         portENTER_CRITICAL(&mcp_gdma->spin_lock);
         STAILQ_INSERT_TAIL(&mcp_gdma->idle_queue_head, trans, idle_queue_entry);
@@ -449,6 +518,35 @@ err:
     return ret;
 }
 
+static esp_err_t mcp_gdma_memcpy(async_memcpy_context_t *ctx, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    async_memcpy_gdma_context_t *mcp_gdma = __containerof(ctx, async_memcpy_gdma_context_t, parent);
+    async_memcpy_segment_t segment = {
+        .dst = dst,
+        .src = src,
+        .size = n,
+    };
+    return mcp_gdma_submit(mcp_gdma, &segment, 1, -1, cb_isr, cb_args);
+}
+
+static esp_err_t mcp_gdma_memcpy_batch(async_memcpy_context_t *ctx, const async_memcpy_segment_t *segments, size_t num_segments,
+                                       async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    async_memcpy_gdma_context_t *mcp_gdma = __containerof(ctx, async_memcpy_gdma_context_t, parent);
+    return mcp_gdma_submit(mcp_gdma, segments, num_segments, -1, cb_isr, cb_args);
+}
+
+static esp_err_t mcp_gdma_memset(async_memcpy_context_t *ctx, void *dst, uint8_t value, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    async_memcpy_gdma_context_t *mcp_gdma = __containerof(ctx, async_memcpy_gdma_context_t, parent);
+    async_memcpy_segment_t segment = {
+        .dst = dst,
+        .src = NULL,
+        .size = n,
+    };
+    return mcp_gdma_submit(mcp_gdma, &segment, 1, value, cb_isr, cb_args);
+}
+
 static bool mcp_gdma_rx_eof_callback(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data)
 {
     bool need_yield = false;
@@ -460,18 +558,11 @@ static bool mcp_gdma_rx_eof_callback(gdma_channel_handle_t dma_chan, gdma_event_
     // switch driver state from RUN to IDLE
     async_memcpy_fsm_t expected_fsm = MCP_FSM_RUN;
     if (atomic_compare_exchange_strong(&mcp_gdma->fsm, &expected_fsm, MCP_FSM_IDLE_WAIT)) {
-        void *dst = trans->memcpy_dst_addr;
         // if the data is in the cache, invalidate, then CPU can see the latest data
-        bool need_invalidate = false;
-        if (esp_ptr_external_ram(dst)) {
-            need_invalidate = true;
-        } else if (esp_ptr_internal(dst)) {
-#if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
-            need_invalidate = true;
-#endif
-        }
-        if (need_invalidate) {
-            esp_cache_msync(dst, trans->memcpy_size, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+        for (size_t i = 0; i < trans->num_segments; i++) {
+            if (buffer_need_cache_sync(trans->segments[i].dst)) {
+                esp_cache_msync(trans->segments[i].dst, trans->segments[i].size, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+            }
         }
 
         // invoked callback registered by user
@@ -483,14 +574,7 @@ static bool mcp_gdma_rx_eof_callback(gdma_channel_handle_t dma_chan, gdma_event_
             need_yield = cb(&mcp_gdma->parent, &e, trans->cb_args);
         }
         // recycle descriptor memory
-        if (trans->tx_desc_link) {
-            free(trans->tx_desc_link);
-            trans->tx_desc_link = NULL;
-        }
-        if (trans->rx_desc_link) {
-            free(trans->rx_desc_link);
-            trans->rx_desc_link = NULL;
-        }
+        free_trans_resources(trans);
         trans->cb = NULL;
 
         portENTER_CRITICAL_ISR(&mcp_gdma->spin_lock);
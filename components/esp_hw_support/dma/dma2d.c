@@ -5,6 +5,8 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
 #include <sys/queue.h>
 #include <sys/lock.h>
 #include "esp_check.h"
@@ -16,6 +18,7 @@
 #include "esp_memory_utils.h"
 #include "esp_attr.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_private/periph_ctrl.h"
 #include "dma2d_priv.h"
 #include "esp_private/dma2d.h"
@@ -37,6 +40,10 @@
  * The upper modules should register themselves as the clients to a 2D-DMA pool. And then they should push the
  * 2D-DMA transactions into the pool queue. The driver will continuously look for the desired resources from the pool to
  * complete the transactions.
+ *
+ * The queue is sorted by transaction priority, then by deadline. Whenever channels are freed, the first transaction in
+ * the queue whose channels can be acquired is picked, so a transaction waiting for busy channels doesn't block the ones
+ * behind it, unless it has missed its deadline.
  */
 
 static const char *TAG = "dma2d";
@@ -165,6 +172,88 @@ revert:
     return found;
 }
 
+/* This static function is not thread-safe, group's spinlock protection should be added in its caller */
+static void insert_pending_trans(dma2d_group_t *group, dma2d_trans_t *trans)
+{
+    // Transactions on reserved channels don't compete with the others, they are always at the head of the queue
+    if (trans->desc->specified_tx_channel_mask || trans->desc->specified_rx_channel_mask) {
+        TAILQ_INSERT_HEAD(&group->pending_trans_tailq, trans, entry);
+        return;
+    }
+    // Otherwise, sort by priority, then by deadline. Transactions comparing equal stay in enqueue order
+    dma2d_trans_t *elm = NULL;
+    TAILQ_FOREACH(elm, &group->pending_trans_tailq, entry) {
+        if (elm->desc->specified_tx_channel_mask || elm->desc->specified_rx_channel_mask) {
+            continue;
+        }
+        if (trans->priority > elm->priority || (trans->priority == elm->priority && trans->deadline < elm->deadline)) {
+            TAILQ_INSERT_BEFORE(elm, trans, entry);
+            return;
+        }
+    }
+    TAILQ_INSERT_TAIL(&group->pending_trans_tailq, trans, entry);
+}
+
+/* This static function is not thread-safe, group's spinlock protection should be added in its caller */
+static dma2d_trans_t *pick_pending_trans(dma2d_group_t *group, int64_t now, dma2d_trans_channel_info_t *channel_handle_array)
+{
+    dma2d_trans_t *elm = NULL;
+    TAILQ_FOREACH(elm, &group->pending_trans_tailq, entry) {
+        if (acquire_free_channels_for_trans(group, elm->desc, channel_handle_array)) {
+            TAILQ_REMOVE(&group->pending_trans_tailq, elm, entry);
+            dma2d_client_stats_t *stats = &group->client_stats[elm->client];
+            uint32_t wait_time = now - elm->enqueue_time;
+            stats->wait_time_us += wait_time;
+            stats->max_wait_time_us = MAX(stats->max_wait_time_us, wait_time);
+            if (now > elm->deadline) {
+                stats->deadline_miss_count++;
+            }
+            return elm;
+        }
+        // The transactions behind may take the channels it is waiting for, unless its deadline is missed.
+        // Then, the freed channels are kept for it, so that it can't starve.
+        if (now > elm->deadline) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/* This function picks up the pending transactions whose channels can be acquired, and lets the consumers handle them */
+static bool start_pending_trans(dma2d_group_t *group)
+{
+    bool need_yield = false;
+    dma2d_trans_channel_info_t channel_handle_array[DMA2D_MAX_CHANNEL_NUM_PER_TRANSACTION];
+
+    while (1) {
+        int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL_SAFE(&group->spinlock);
+        dma2d_trans_t *next_trans_elm = pick_pending_trans(group, now, channel_handle_array);
+        portEXIT_CRITICAL_SAFE(&group->spinlock);
+        if (!next_trans_elm) {
+            break;
+        }
+
+        const dma2d_trans_config_t *next_trans = next_trans_elm->desc;
+        uint32_t total_channel_num = next_trans->tx_channel_num + next_trans->rx_channel_num;
+        // Store the acquired rx_chan into trans_elm (dma2d_trans_t) in case upper driver later need it to call `dma2d_force_end`
+        // Upper driver controls the life cycle of trans_elm
+        for (int i = 0; i < total_channel_num; i++) {
+            if (channel_handle_array[i].dir == DMA2D_CHANNEL_DIRECTION_RX) {
+                next_trans_elm->rx_chan = channel_handle_array[i].chan;
+                // trans_elm may be freed once picked, keep what is needed for the statistics in the channel
+                dma2d_rx_channel_t *rx_chan = group->rx_chans[channel_handle_array[i].chan->channel_id];
+                rx_chan->trans_start_time = now;
+                rx_chan->trans_client = next_trans_elm->client;
+            }
+            // Also save the transaction pointer
+            channel_handle_array[i].chan->status.transaction = next_trans_elm;
+        }
+        need_yield |= next_trans->on_job_picked(total_channel_num, channel_handle_array, next_trans->user_config);
+    }
+    return need_yield;
+}
+
 /* This function will free up the RX channel and its bundled TX channels, then check for whether there is next transaction to be picked up */
 static bool free_up_channels(dma2d_group_t *group, dma2d_rx_channel_t *rx_chan)
 {
@@ -210,45 +299,22 @@ static bool free_up_channels(dma2d_group_t *group, dma2d_rx_channel_t *rx_chan)
     // Channel functionality flags will be reset and assigned new values inside `acquire_free_channels_for_trans`
     // Channel reset will always be done at `dma2d_connect` (i.e. when the channel is selected for a new transaction)
 
-    // 2. Check if next pending transaction in the tailq can start
-    bool channels_found = false;
-    const dma2d_trans_config_t *next_trans = NULL;
-    dma2d_trans_channel_info_t channel_handle_array[DMA2D_MAX_CHANNEL_NUM_PER_TRANSACTION];
-
+    // 2. Account the finished transaction and release the resources
+    int64_t now = esp_timer_get_time();
     portENTER_CRITICAL_SAFE(&group->spinlock);
+    dma2d_client_stats_t *stats = &group->client_stats[rx_chan->trans_client];
+    stats->trans_count++;
+    stats->busy_time_us += now - rx_chan->trans_start_time;
     // Release channels
     group->tx_channel_free_mask |= bundled_tx_channel_mask;
     group->rx_channel_free_mask |= (1 << channel_id);
     // Release M2M periph_sel_id
     group->tx_periph_m2m_free_id_mask |= (tx_periph_sel_id_mask & DMA2D_LL_TX_CHANNEL_PERIPH_M2M_AVAILABLE_ID_MASK);
     group->rx_periph_m2m_free_id_mask |= (rx_periph_sel_id_mask & DMA2D_LL_RX_CHANNEL_PERIPH_M2M_AVAILABLE_ID_MASK);
-
-    dma2d_trans_t *next_trans_elm = TAILQ_FIRST(&group->pending_trans_tailq);
-    if (next_trans_elm) {
-        // There is a pending transaction
-        next_trans = next_trans_elm->desc;
-        channels_found = acquire_free_channels_for_trans(group, next_trans, channel_handle_array);
-    }
-
-    if (channels_found) {
-        TAILQ_REMOVE(&group->pending_trans_tailq, next_trans_elm, entry);
-    }
     portEXIT_CRITICAL_SAFE(&group->spinlock);
 
-    if (channels_found) {
-        // If the transaction can be processed, let consumer handle the transaction
-        uint32_t total_channel_num = next_trans->tx_channel_num + next_trans->rx_channel_num;
-        // Store the acquired rx_chan into trans_elm (dma2d_trans_t) in case upper driver later need it to call `dma2d_force_end`
-        // Upper driver controls the life cycle of trans_elm
-        for (int i = 0; i < total_channel_num; i++) {
-            if (channel_handle_array[i].dir == DMA2D_CHANNEL_DIRECTION_RX) {
-                next_trans_elm->rx_chan = channel_handle_array[i].chan;
-            }
-            // Also save the transaction pointer
-            channel_handle_array[i].chan->status.transaction = next_trans_elm;
-        }
-        need_yield |= next_trans->on_job_picked(total_channel_num, channel_handle_array, next_trans->user_config);
-    }
+    // 3. Check if pending transactions in the tailq can start
+    need_yield |= start_pending_trans(group);
     return need_yield;
 }
 
@@ -896,6 +962,9 @@ esp_err_t dma2d_enqueue(dma2d_pool_handle_t dma2d_pool, const dma2d_trans_config
     ESP_GOTO_ON_FALSE_ISR(trans_desc->rx_channel_num <= 1, ESP_ERR_INVALID_ARG, err, TAG, "one trans at most has one rx channel");
     uint32_t total_channel_num = trans_desc->tx_channel_num + trans_desc->rx_channel_num;
     ESP_GOTO_ON_FALSE_ISR(total_channel_num <= DMA2D_MAX_CHANNEL_NUM_PER_TRANSACTION, ESP_ERR_INVALID_ARG, err, TAG, "too many channels acquiring for a trans");
+    ESP_GOTO_ON_FALSE_ISR(trans_desc->priority >= DMA2D_TRANS_PRIORITY_LOW && trans_desc->priority <= DMA2D_TRANS_PRIORITY_HIGH,
+                          ESP_ERR_INVALID_ARG, err, TAG, "invalid priority");
+    ESP_GOTO_ON_FALSE_ISR(trans_desc->client < DMA2D_CLIENT_MAX, ESP_ERR_INVALID_ARG, err, TAG, "invalid client");
     dma2d_group_t *dma2d_group = dma2d_pool;
     if (trans_desc->specified_tx_channel_mask || trans_desc->specified_rx_channel_mask) {
         ESP_GOTO_ON_FALSE_ISR(
@@ -919,31 +988,17 @@ esp_err_t dma2d_enqueue(dma2d_pool_handle_t dma2d_pool, const dma2d_trans_config
 #endif
 
     trans_placeholder->desc = trans_desc;
-    dma2d_trans_channel_info_t channel_handle_array[DMA2D_MAX_CHANNEL_NUM_PER_TRANSACTION];
+    trans_placeholder->enqueue_time = esp_timer_get_time();
+    trans_placeholder->deadline = trans_desc->deadline_us ? trans_placeholder->enqueue_time + trans_desc->deadline_us : INT64_MAX;
+    trans_placeholder->priority = trans_desc->priority;
+    trans_placeholder->client = trans_desc->client;
 
+    // Queue the transaction first, so that it doesn't take the free channels from a pending transaction with higher priority
     portENTER_CRITICAL_SAFE(&dma2d_group->spinlock);
-    bool enqueue = !acquire_free_channels_for_trans(dma2d_group, trans_desc, channel_handle_array);
-    if (enqueue) {
-        if (!trans_desc->specified_tx_channel_mask && !trans_desc->specified_rx_channel_mask) {
-            TAILQ_INSERT_TAIL(&dma2d_group->pending_trans_tailq, trans_placeholder, entry);
-        } else {
-            TAILQ_INSERT_HEAD(&dma2d_group->pending_trans_tailq, trans_placeholder, entry);
-        }
-    }
+    insert_pending_trans(dma2d_group, trans_placeholder);
     portEXIT_CRITICAL_SAFE(&dma2d_group->spinlock);
-    if (!enqueue) {
-        // Free channels available, start transaction immediately
-        // Store the acquired rx_chan into trans_placeholder (dma2d_trans_t) in case upper driver later need it to call `dma2d_force_end`
-        // Upper driver controls the life cycle of trans_placeholder
-        for (int i = 0; i < total_channel_num; i++) {
-            if (channel_handle_array[i].dir == DMA2D_CHANNEL_DIRECTION_RX) {
-                trans_placeholder->rx_chan = channel_handle_array[i].chan;
-            }
-            // Also save the transaction pointer
-            channel_handle_array[i].chan->status.transaction = trans_placeholder;
-        }
-        trans_desc->on_job_picked(total_channel_num, channel_handle_array, trans_desc->user_config);
-    }
+    // Start the transaction immediately if free channels are available
+    start_pending_trans(dma2d_group);
 
 err:
     return ret;
@@ -982,6 +1037,20 @@ esp_err_t dma2d_force_end(dma2d_trans_t *trans, bool *need_yield)
     return ESP_OK;
 }
 
+esp_err_t dma2d_get_client_stats(dma2d_pool_handle_t dma2d_pool, dma2d_client_t client, dma2d_client_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(dma2d_pool && client < DMA2D_CLIENT_MAX && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    dma2d_group_t *group = dma2d_pool;
+
+    portENTER_CRITICAL(&group->spinlock);
+    *stats = group->client_stats[client];
+    if (reset) {
+        memset(&group->client_stats[client], 0, sizeof(dma2d_client_stats_t));
+    }
+    portEXIT_CRITICAL(&group->spinlock);
+    return ESP_OK;
+}
+
 size_t dma2d_get_trans_elm_size(void)
 {
     return sizeof(dma2d_trans_t);
@@ -44,6 +44,10 @@ struct dma2d_trans_s {
     TAILQ_ENTRY(dma2d_trans_s) entry;     // Link entry
     const dma2d_trans_config_t *desc;     // Pointer to the structure containing all configuration items of a transaction
     dma2d_channel_handle_t rx_chan;       // Pointer to the RX channel handle that will be used to do the transaction
+    int64_t enqueue_time;                 // Time when the transaction was enqueued, in microseconds
+    int64_t deadline;                     // Time before which the transaction should be picked, INT64_MAX for no deadline
+    int priority;                         // Copy of the priority of the transaction, to order the pending queue
+    dma2d_client_t client;                // Client issuing the transaction
 };
 
 struct dma2d_group_t {
@@ -60,6 +64,7 @@ struct dma2d_group_t {
     dma2d_tx_channel_t *tx_chans[SOC_DMA2D_TX_CHANNELS_PER_GROUP];  // Handles of 2D-DMA TX channels
     dma2d_rx_channel_t *rx_chans[SOC_DMA2D_RX_CHANNELS_PER_GROUP];  // Handles of 2D-DMA RX channels
     int intr_priority;                                              // All channels in the same group should share the same interrupt priority
+    dma2d_client_stats_t client_stats[DMA2D_CLIENT_MAX];            // Statistics of the transactions of each client
 };
 
 struct dma2d_channel_t {
@@ -87,6 +92,8 @@ struct dma2d_rx_channel_t {
     dma2d_event_callback_t on_recv_eof;        // RX EOF event callback
     dma2d_event_callback_t on_desc_done;       // RX DONE event callback
     uint32_t bundled_tx_channel_mask;          // Bit mask indicating the TX channels together with the RX channel to do the transaction
+    int64_t trans_start_time;                  // Time when the transaction on the channel was picked, in microseconds
+    dma2d_client_t trans_client;               // Client of the transaction on the channel
 };
 
 #ifdef __cplusplus
@@ -1,10 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2020-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include "esp_check.h"
+#include "esp_heap_caps.h"
 #include "esp_async_memcpy.h"
 #include "esp_async_memcpy_priv.h"
 
@@ -22,6 +24,44 @@ esp_err_t esp_async_memcpy(async_memcpy_handle_t asmcp, void *dst, void *src, si
     return asmcp->memcpy(asmcp, dst, src, n, cb_isr, cb_args);
 }
 
+esp_err_t esp_async_memcpy_batch(async_memcpy_handle_t asmcp, const async_memcpy_segment_t *segments, size_t num_segments,
+                                 async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    ESP_RETURN_ON_FALSE(asmcp && segments && num_segments, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(asmcp->memcpy_batch, ESP_ERR_NOT_SUPPORTED, TAG, "batch copy is not supported");
+    return asmcp->memcpy_batch(asmcp, segments, num_segments, cb_isr, cb_args);
+}
+
+esp_err_t esp_async_memcpy_2d(async_memcpy_handle_t asmcp, void *dst, size_t dst_stride, void *src, size_t src_stride,
+                              size_t width, size_t height, async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    ESP_RETURN_ON_FALSE(asmcp && dst && src && width && height, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(dst_stride >= width && src_stride >= width, ESP_ERR_INVALID_ARG, TAG, "stride smaller than width");
+    ESP_RETURN_ON_FALSE(asmcp->memcpy_batch, ESP_ERR_NOT_SUPPORTED, TAG, "2D copy is not supported");
+    // contiguous rows are copied as one buffer
+    if (dst_stride == width && src_stride == width) {
+        return asmcp->memcpy(asmcp, dst, src, width * height, cb_isr, cb_args);
+    }
+    // the driver keeps its own copy of the segments, the array is only needed during the call
+    async_memcpy_segment_t *rows = heap_caps_malloc(height * sizeof(async_memcpy_segment_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(rows, ESP_ERR_NO_MEM, TAG, "no mem for row segments");
+    for (size_t y = 0; y < height; y++) {
+        rows[y].dst = (uint8_t *)dst + y * dst_stride;
+        rows[y].src = (uint8_t *)src + y * src_stride;
+        rows[y].size = width;
+    }
+    esp_err_t ret = asmcp->memcpy_batch(asmcp, rows, height, cb_isr, cb_args);
+    free(rows);
+    return ret;
+}
+
+esp_err_t esp_async_memset(async_memcpy_handle_t asmcp, void *dst, uint8_t value, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args)
+{
+    ESP_RETURN_ON_FALSE(asmcp && dst && n, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(asmcp->memset, ESP_ERR_NOT_SUPPORTED, TAG, "memset is not supported");
+    return asmcp->memset(asmcp, dst, value, n, cb_isr, cb_args);
+}
+
 #if SOC_ETM_SUPPORTED
 esp_err_t esp_async_memcpy_new_etm_event(async_memcpy_handle_t asmcp, async_memcpy_etm_event_t event_type, esp_etm_event_handle_t *out_event)
 {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -33,6 +33,11 @@ typedef struct async_memcpy_context_t async_memcpy_context_t;
 struct async_memcpy_context_t {
     /// @brief Start a new async memcpy transaction
     esp_err_t (*memcpy)(async_memcpy_context_t *ctx, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args);
+    /// @brief Start a new async memcpy transaction made up of multiple segments, optional
+    esp_err_t (*memcpy_batch)(async_memcpy_context_t *ctx, const async_memcpy_segment_t *segments, size_t num_segments,
+                              async_memcpy_isr_cb_t cb_isr, void *cb_args);
+    /// @brief Start a new async memset transaction, optional
+    esp_err_t (*memset)(async_memcpy_context_t *ctx, void *dst, uint8_t value, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args);
 #if SOC_ETM_SUPPORTED
     /// @brief Create ETM event handle of specific event type
     esp_err_t (*new_etm_event)(async_memcpy_context_t *ctx, async_memcpy_etm_event_t event_type, esp_etm_event_handle_t *out_event);
@@ -465,6 +465,10 @@ esp_err_t gdma_register_tx_event_callbacks(gdma_channel_handle_t dma_chan, gdma_
         ESP_RETURN_ON_FALSE(esp_ptr_in_iram(cbs->on_descr_err), ESP_ERR_INVALID_ARG,
                             TAG, "on_descr_err not in IRAM");
     }
+    if (cbs->on_send_done) {
+        ESP_RETURN_ON_FALSE(esp_ptr_in_iram(cbs->on_send_done), ESP_ERR_INVALID_ARG,
+                            TAG, "on_send_done not in IRAM");
+    }
     if (user_data) {
         ESP_RETURN_ON_FALSE(esp_ptr_internal(user_data), ESP_ERR_INVALID_ARG,
                             TAG, "user context not in internal RAM");
@@ -478,6 +482,7 @@ esp_err_t gdma_register_tx_event_callbacks(gdma_channel_handle_t dma_chan, gdma_
     portENTER_CRITICAL(&pair->spinlock);
     gdma_hal_enable_intr(hal, pair->pair_id, GDMA_CHANNEL_DIRECTION_TX, GDMA_LL_EVENT_TX_EOF, cbs->on_trans_eof != NULL);
     gdma_hal_enable_intr(hal, pair->pair_id, GDMA_CHANNEL_DIRECTION_TX, GDMA_LL_EVENT_TX_DESC_ERROR, cbs->on_descr_err != NULL);
+    gdma_hal_enable_intr(hal, pair->pair_id, GDMA_CHANNEL_DIRECTION_TX, GDMA_LL_EVENT_TX_DONE, cbs->on_send_done != NULL);
     portEXIT_CRITICAL(&pair->spinlock);
 
     memcpy(&tx_chan->cbs, cbs, sizeof(gdma_tx_event_callbacks_t));
@@ -858,6 +863,10 @@ void gdma_default_tx_isr(void *args)
     if ((intr_status & GDMA_LL_EVENT_TX_DESC_ERROR) && tx_chan->cbs.on_descr_err) {
         need_yield |= tx_chan->cbs.on_descr_err(&tx_chan->base, NULL, tx_chan->user_data);
     }
+    if ((intr_status & GDMA_LL_EVENT_TX_DONE) && tx_chan->cbs.on_send_done) {
+        gdma_event_data_t edata = {};
+        need_yield |= tx_chan->cbs.on_send_done(&tx_chan->base, &edata, tx_chan->user_data);
+    }
     if (need_yield) {
         portYIELD_FROM_ISR();
     }
@@ -9,6 +9,7 @@
 #include <stdatomic.h>
 #include <sys/cdefs.h>
 #include <sys/lock.h>
+#include <sys/param.h>
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -92,16 +93,19 @@ esp_err_t gdma_new_link_list(const gdma_link_list_config_t *config, gdma_link_li
     } else {
         list_items_mem_caps |= MALLOC_CAP_INTERNAL;
     }
-    items = heap_caps_aligned_calloc(item_alignment, num_items, item_size, list_items_mem_caps);
-    ESP_GOTO_ON_FALSE(items, ESP_ERR_NO_MEM, err, TAG, "no mem for link list items");
-
-    // do memory sync if the list items are in the cache
     uint32_t data_cache_line_size = 0;
     if (config->flags.items_in_ext_mem) {
         data_cache_line_size = cache_hal_get_cache_line_size(CACHE_LL_LEVEL_EXT_MEM, CACHE_TYPE_DATA);
     } else {
         data_cache_line_size = cache_hal_get_cache_line_size(CACHE_LL_LEVEL_INT_MEM, CACHE_TYPE_DATA);
     }
+    // if the list items are in the cache, the item array should occupy whole cache lines,
+    // so that the cache sync below won't touch the memory of others
+    size_t items_mem_alignment = MAX(item_alignment, data_cache_line_size);
+    items = heap_caps_aligned_calloc(items_mem_alignment, 1, ALIGN_UP(num_items * item_size, items_mem_alignment), list_items_mem_caps);
+    ESP_GOTO_ON_FALSE(items, ESP_ERR_NO_MEM, err, TAG, "no mem for link list items");
+
+    // do memory sync if the list items are in the cache
     if (data_cache_line_size) {
         // write back and then invalidate the cache, because later we will read/write the link list items by non-cached address
         ESP_GOTO_ON_ERROR(esp_cache_msync(items, ALIGN_UP(num_items * item_size, data_cache_line_size),
@@ -154,7 +158,12 @@ esp_err_t gdma_link_mount_buffers(gdma_link_list_handle_t list, uint32_t start_i
     uint32_t num_items_avail = 0;
     // if the link list is responsible for checking the ownership, we need to skip the items that are owned by the DMA
     if (list->flags.check_owner) {
-        for (uint32_t i = 0; i < list_item_capacity; i++) {
+        uint32_t num_items_need = 0;
+        for (size_t i = 0; i < num_buf; i++) {
+            num_items_need += (buf_config_array[i].length + max_buffer_mount_length - 1) / max_buffer_mount_length;
+        }
+        // no need to go through the whole list, stop as soon as there are enough free items
+        for (uint32_t i = 0; i < list_item_capacity && num_items_avail < num_items_need; i++) {
             lli_nc = (gdma_link_list_item_t *)(list->items_nc + (i + start_item_index) % list_item_capacity * item_size);
             if (lli_nc->dw0.owner == GDMA_LLI_OWNER_CPU) {
                 num_items_avail++;
@@ -221,6 +230,48 @@ esp_err_t gdma_link_mount_buffers(gdma_link_list_handle_t list, uint32_t start_i
     return ESP_OK;
 }
 
+esp_err_t gdma_link_remount_buffer(gdma_link_list_handle_t list, uint32_t start_item_index, void *buffer, size_t length, uint32_t *end_item_index)
+{
+    ESP_RETURN_ON_FALSE_ISR(list && buffer && length, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE_ISR(start_item_index < list->num_items, ESP_ERR_INVALID_ARG, TAG, "invalid start item index");
+    ESP_RETURN_ON_FALSE_ISR(((uintptr_t)buffer & (list->buffer_alignment - 1)) == 0, ESP_ERR_INVALID_ARG, TAG, "buffer not aligned");
+    size_t item_size = list->item_size;
+    uint32_t list_item_capacity = list->num_items;
+    uint8_t *buf = (uint8_t *)buffer;
+    uint32_t item_idx = start_item_index;
+    gdma_link_list_item_t *lli_nc = NULL;
+
+    // the items keep the length, the EOF flag and the link from the previous mount, only the buffer address is replaced
+    for (uint32_t i = 0; i < list_item_capacity && length; i++) {
+        item_idx = (start_item_index + i) % list_item_capacity;
+        lli_nc = (gdma_link_list_item_t *)(list->items_nc + item_idx * item_size);
+        ESP_RETURN_ON_FALSE_ISR(lli_nc->dw0.length && lli_nc->dw0.length <= length, ESP_ERR_INVALID_SIZE, TAG, "buffer length mismatch");
+        lli_nc->buffer = buf;
+        lli_nc->dw0.owner = GDMA_LLI_OWNER_DMA;
+        buf += lli_nc->dw0.length;
+        length -= lli_nc->dw0.length;
+    }
+    ESP_RETURN_ON_FALSE_ISR(length == 0, ESP_ERR_INVALID_SIZE, TAG, "buffer length mismatch");
+
+    if (end_item_index) {
+        *end_item_index = item_idx;
+    }
+    return ESP_OK;
+}
+
+esp_err_t gdma_link_concat(gdma_link_list_handle_t first_link, uint32_t first_link_item_index, gdma_link_list_handle_t second_link, uint32_t second_link_item_index)
+{
+    ESP_RETURN_ON_FALSE_ISR(first_link && first_link_item_index < first_link->num_items, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE_ISR(!second_link || second_link_item_index < second_link->num_items, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    gdma_link_list_item_t *lli_nc = (gdma_link_list_item_t *)(first_link->items_nc + first_link_item_index * first_link->item_size);
+    if (second_link) {
+        lli_nc->next = (gdma_link_list_item_t *)(second_link->items + second_link_item_index * second_link->item_size);
+    } else {
+        lli_nc->next = NULL;
+    }
+    return ESP_OK;
+}
+
 uintptr_t gdma_link_get_head_addr(gdma_link_list_handle_t list)
 {
     ESP_RETURN_ON_FALSE(list, 0, TAG, "invalid argument");
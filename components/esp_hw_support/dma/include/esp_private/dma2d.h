@@ -10,6 +10,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "esp_err.h"
 #include "hal/dma2d_types.h"
 
@@ -117,6 +118,28 @@ typedef bool (*dma2d_trans_on_picked_callback_t)(uint32_t num_chans, const dma2d
 #define DMA2D_CHANNEL_FUNCTION_FLAG_RX_CSC       (1 << 3)       /*!< RX channel that has color space conversion functionality */
 #define DMA2D_CHANNEL_FUNCTION_FLAG_SIBLING      (1 << 4)       /*!< TX and RX channel with same channel ID */
 
+/**
+ * @brief 2D-DMA transaction priority
+ *
+ * Pending transactions are picked in the order of priority, then of deadline, then of enqueue.
+ */
+typedef enum {
+    DMA2D_TRANS_PRIORITY_LOW = -1,          /*!< Background transactions, picked when no other transaction is waiting */
+    DMA2D_TRANS_PRIORITY_NORMAL = 0,        /*!< Default priority */
+    DMA2D_TRANS_PRIORITY_HIGH = 1,          /*!< Latency critical transactions, e.g. the ones feeding a display */
+} dma2d_trans_priority_t;
+
+/**
+ * @brief 2D-DMA clients, used to account the transactions in the statistics
+ */
+typedef enum {
+    DMA2D_CLIENT_UNKNOWN,                   /*!< Client not specified */
+    DMA2D_CLIENT_PPA,                       /*!< Pixel-Processing Accelerator */
+    DMA2D_CLIENT_JPEG,                      /*!< JPEG encoder and decoder */
+    DMA2D_CLIENT_LCD,                       /*!< LCD frame buffer copy */
+    DMA2D_CLIENT_MAX,                       /*!< Number of clients */
+} dma2d_client_t;
+
 /**
  * @brief A collection of configuration items for a 2D-DMA transaction
  */
@@ -133,6 +156,13 @@ typedef struct {
 
     dma2d_trans_on_picked_callback_t on_job_picked;   /*!< Callback function to be called when all necessary channels to do the transaction have been acquired */
     void *user_config;                      /*!< User registered data to be passed into `on_job_picked` callback */
+
+    // Scheduling of the transaction
+    dma2d_trans_priority_t priority;        /*!< Priority of the transaction. Pending transactions with higher priority are picked first */
+    uint32_t deadline_us;                   /*!< Time within which the transaction should be picked after being enqueued, in microseconds.
+                                                 Among pending transactions of the same priority, the one with the earliest deadline is picked first.
+                                                 Once it is missed, channels are kept for the transaction as they are freed. Set to 0 for no deadline */
+    dma2d_client_t client;                  /*!< Client issuing the transaction, to be accounted in its statistics */
 } dma2d_trans_config_t;
 
 /**
@@ -173,6 +203,32 @@ esp_err_t dma2d_enqueue(dma2d_pool_handle_t dma2d_pool, const dma2d_trans_config
  */
 esp_err_t dma2d_force_end(dma2d_trans_t *trans, bool *need_yield);
 
+/**
+ * @brief Statistics of the 2D-DMA transactions of one client
+ */
+typedef struct {
+    uint32_t trans_count;                   /*!< Number of transactions completed (or force ended) */
+    uint32_t deadline_miss_count;           /*!< Number of transactions picked after their deadline */
+    uint64_t busy_time_us;                  /*!< Total time the channels were occupied by the transactions, in microseconds */
+    uint64_t wait_time_us;                  /*!< Total time the transactions waited in the pending queue, in microseconds */
+    uint32_t max_wait_time_us;              /*!< Longest time a transaction waited in the pending queue, in microseconds */
+} dma2d_client_stats_t;
+
+/**
+ * @brief Get the statistics of the transactions of a client in a 2D-DMA pool
+ *
+ * The share of the 2D-DMA bandwidth used by a client is its `busy_time_us` over the time elapsed between two calls.
+ *
+ * @param[in] dma2d_pool 2D-DMA pool handle, allocated by `dma2d_acquire_pool`
+ * @param[in] client Client whose statistics to get
+ * @param[out] stats Returned statistics
+ * @param[in] reset Whether to reset the statistics of the client after getting them
+ * @return
+ *      - ESP_OK: Get the statistics successfully
+ *      - ESP_ERR_INVALID_ARG: Get the statistics failed because of invalid argument
+ */
+esp_err_t dma2d_get_client_stats(dma2d_pool_handle_t dma2d_pool, dma2d_client_t client, dma2d_client_stats_t *stats, bool reset);
+
 
 /*********************************************** DMA CHANNEL OPERATIONS ***********************************************/
 
@@ -93,6 +93,41 @@ typedef struct {
  */
 esp_err_t gdma_link_mount_buffers(gdma_link_list_handle_t list, uint32_t start_item_index, const gdma_buffer_mount_config_t *buf_config_array, size_t num_buf, uint32_t *end_item_index);
 
+/**
+ * @brief Mount a new buffer to the link list items that have been mounted by `gdma_link_mount_buffers` before
+ *
+ * @note Only the buffer addresses of the items are replaced, the length, the EOF mark and the link of each item are kept.
+ *       So the link list works like a template, which is much cheaper to re-mount than `gdma_link_mount_buffers`,
+ *       e.g. in the interrupt context when the same sized buffers are transferred repeatedly.
+ * @note The length must be the same as the one mounted to the items before
+ *
+ * @param[in] list Link list handle, allocated by `gdma_new_link_list`
+ * @param[in] start_item_index Index of the first item that the buffer was mounted to
+ * @param[in] buffer Buffer to be mounted, must meet the buffer alignment of the link list
+ * @param[in] length Number of bytes to be transferred
+ * @param[out] end_item_index Index of the last item in the link list that has been mounted
+ * @return
+ *      - ESP_OK: Re-mount the buffer successfully
+ *      - ESP_ERR_INVALID_ARG: Re-mount the buffer failed because of invalid argument
+ *      - ESP_ERR_INVALID_SIZE: Re-mount the buffer failed because the length mismatches the previous mount
+ */
+esp_err_t gdma_link_remount_buffer(gdma_link_list_handle_t list, uint32_t start_item_index, void *buffer, size_t length, uint32_t *end_item_index);
+
+/**
+ * @brief Link an item of one link list to an item of another (or the same) link list
+ *
+ * @note This can be used to link the last mounted item back to the head item, which makes a ring that the DMA loops forever
+ *
+ * @param[in] first_link Link list that the item to be linked belongs to
+ * @param[in] first_link_item_index Index of the item in `first_link`, whose next item will be changed
+ * @param[in] second_link Link list that the next item belongs to, set to NULL to terminate `first_link` at the item
+ * @param[in] second_link_item_index Index of the next item in `second_link`
+ * @return
+ *      - ESP_OK: Link the items successfully
+ *      - ESP_ERR_INVALID_ARG: Link the items failed because of invalid argument
+ */
+esp_err_t gdma_link_concat(gdma_link_list_handle_t first_link, uint32_t first_link_item_index, gdma_link_list_handle_t second_link, uint32_t second_link_item_index);
+
 /**
  * @brief Get the address of the head item in the link list
  *
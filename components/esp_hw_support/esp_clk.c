@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -205,6 +205,20 @@ uint32_t esp_clk_slowclk_cal_get(void)
     return clk_ll_rtc_slow_load_cal();
 }
 
+bool esp_clk_slowclk_cal_retained(soc_rtc_slow_clk_src_t slow_clk_src)
+{
+    if (esp_rom_get_reset_reason(0) != RESET_REASON_CORE_DEEP_SLEEP) {
+        return false;
+    }
+#if SOC_RTC_SLOW_CLK_SUPPORT_RC_FAST_D256
+    // RC_FAST is powered down in deep sleep by default, it has to be enabled again
+    if (slow_clk_src == SOC_RTC_SLOW_CLK_SRC_RC_FAST_D256) {
+        return false;
+    }
+#endif
+    return rtc_clk_slow_src_get() == slow_clk_src && clk_ll_rtc_slow_load_cal() != 0;
+}
+
 uint64_t esp_clk_rtc_time(void)
 {
 #ifdef CONFIG_ESP_TIME_FUNCS_USE_RTC_TIMER
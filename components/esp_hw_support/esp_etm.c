@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -40,6 +40,7 @@ static const char *TAG = "etm";
 typedef struct etm_platform_t etm_platform_t;
 typedef struct etm_group_t etm_group_t;
 typedef struct esp_etm_channel_t esp_etm_channel_t;
+typedef struct esp_etm_graph_t esp_etm_graph_t;
 
 struct etm_platform_t {
     _lock_t mutex;                        // platform level mutex lock
@@ -67,8 +68,16 @@ struct esp_etm_channel_t {
     esp_etm_task_handle_t task;   // which task is connect to the channel
 };
 
+struct esp_etm_graph_t {
+    etm_chan_fsm_t fsm;                // record ETM graph's driver state
+    size_t num_edges;                  // number of edges, one channel each
+    esp_etm_channel_handle_t chans[];  // channel of each edge, in the order of the configuration
+};
+
 // ETM driver platform, it's always a singleton
 static etm_platform_t s_platform;
+// to enable or disable all the channels of a graph without interruption
+static portMUX_TYPE s_graph_spinlock = portMUX_INITIALIZER_UNLOCKED;
 
 static etm_group_t *etm_acquire_group_handle(int group_id)
 {
@@ -331,3 +340,108 @@ esp_err_t esp_etm_dump(FILE *out_stream)
     fprintf(out_stream, "===========ETM Dump End============\r\n");
     return ESP_OK;
 }
+
+static esp_err_t etm_graph_destroy(esp_etm_graph_t *graph)
+{
+    for (size_t i = 0; i < graph->num_edges; i++) {
+        if (graph->chans[i]) {
+            ESP_RETURN_ON_ERROR(esp_etm_del_channel(graph->chans[i]), TAG, "delete channel %zu failed", i);
+            graph->chans[i] = NULL;
+        }
+    }
+    free(graph);
+    return ESP_OK;
+}
+
+esp_err_t esp_etm_new_graph(const esp_etm_graph_config_t *config, esp_etm_graph_handle_t *ret_graph)
+{
+    esp_err_t ret = ESP_OK;
+    esp_etm_graph_t *graph = NULL;
+    ESP_GOTO_ON_FALSE(config && ret_graph && config->edges && config->num_edges, ESP_ERR_INVALID_ARG, err, TAG, "invalid args");
+    // validate all the edges before allocating any channel
+    for (size_t i = 0; i < config->num_edges; i++) {
+        const esp_etm_graph_edge_t *edge = &config->edges[i];
+        ESP_GOTO_ON_FALSE(edge->event && edge->task, ESP_ERR_INVALID_ARG, err, TAG, "edge %zu has no event or task", i);
+        for (size_t j = 0; j < i; j++) {
+            ESP_GOTO_ON_FALSE(config->edges[j].event != edge->event || config->edges[j].task != edge->task,
+                              ESP_ERR_INVALID_ARG, err, TAG, "edge %zu duplicates edge %zu", i, j);
+        }
+    }
+
+    graph = heap_caps_calloc(1, sizeof(esp_etm_graph_t) + config->num_edges * sizeof(esp_etm_channel_handle_t), ETM_MEM_ALLOC_CAPS);
+    ESP_GOTO_ON_FALSE(graph, ESP_ERR_NO_MEM, err, TAG, "no mem for graph");
+    graph->num_edges = config->num_edges;
+    graph->fsm = ETM_CHAN_FSM_INIT;
+
+    esp_etm_channel_config_t chan_config = {};
+    for (size_t i = 0; i < config->num_edges; i++) {
+        ESP_GOTO_ON_ERROR(esp_etm_new_channel(&chan_config, &graph->chans[i]), err, TAG, "no channel for edge %zu", i);
+        ESP_GOTO_ON_ERROR(esp_etm_channel_connect(graph->chans[i], config->edges[i].event, config->edges[i].task),
+                          err, TAG, "connect edge %zu failed", i);
+    }
+
+    ESP_LOGD(TAG, "new etm graph with %zu edges at %p", graph->num_edges, graph);
+    *ret_graph = graph;
+    return ESP_OK;
+
+err:
+    if (graph) {
+        etm_graph_destroy(graph);
+    }
+    return ret;
+}
+
+esp_err_t esp_etm_del_graph(esp_etm_graph_handle_t graph)
+{
+    ESP_RETURN_ON_FALSE(graph, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(graph->fsm == ETM_CHAN_FSM_INIT, ESP_ERR_INVALID_STATE, TAG, "graph is not in init state");
+    ESP_LOGD(TAG, "del etm graph at %p", graph);
+    return etm_graph_destroy(graph);
+}
+
+esp_err_t esp_etm_graph_enable(esp_etm_graph_handle_t graph)
+{
+    ESP_RETURN_ON_FALSE(graph, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(graph->fsm == ETM_CHAN_FSM_INIT, ESP_ERR_INVALID_STATE, TAG, "graph is not in init state");
+    portENTER_CRITICAL(&s_graph_spinlock);
+    // enable the last stages first, so that the pipeline is complete once its first event can fire
+    for (size_t i = graph->num_edges; i > 0; i--) {
+        esp_etm_channel_t *chan = graph->chans[i - 1];
+        etm_ll_enable_channel(chan->group->hal.regs, chan->chan_id);
+        chan->fsm = ETM_CHAN_FSM_ENABLE;
+    }
+    graph->fsm = ETM_CHAN_FSM_ENABLE;
+    portEXIT_CRITICAL(&s_graph_spinlock);
+    return ESP_OK;
+}
+
+esp_err_t esp_etm_graph_disable(esp_etm_graph_handle_t graph)
+{
+    ESP_RETURN_ON_FALSE(graph, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(graph->fsm == ETM_CHAN_FSM_ENABLE, ESP_ERR_INVALID_STATE, TAG, "graph not in enable state");
+    portENTER_CRITICAL(&s_graph_spinlock);
+    // disable the first stages first, so that no new event enters the pipeline
+    for (size_t i = 0; i < graph->num_edges; i++) {
+        esp_etm_channel_t *chan = graph->chans[i];
+        etm_ll_disable_channel(chan->group->hal.regs, chan->chan_id);
+        chan->fsm = ETM_CHAN_FSM_INIT;
+    }
+    graph->fsm = ETM_CHAN_FSM_INIT;
+    portEXIT_CRITICAL(&s_graph_spinlock);
+    return ESP_OK;
+}
+
+esp_err_t esp_etm_graph_dump(esp_etm_graph_handle_t graph, FILE *out_stream)
+{
+    ESP_RETURN_ON_FALSE(graph && out_stream, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    fprintf(out_stream, "===========ETM Graph Dump Start==========\r\n");
+    fprintf(out_stream, "graph %p: %zu edges, %s\r\n", graph, graph->num_edges,
+            graph->fsm == ETM_CHAN_FSM_ENABLE ? "enabled" : "disabled");
+    for (size_t i = 0; i < graph->num_edges; i++) {
+        esp_etm_channel_t *chan = graph->chans[i];
+        fprintf(out_stream, "edge %zu: event %"PRIu32" ==> channel (%d,%d) ==> task %"PRIu32"\r\n", i,
+                chan->event->event_id, chan->group->group_id, chan->chan_id, chan->task->task_id);
+    }
+    fprintf(out_stream, "===========ETM Graph Dump End============\r\n");
+    return ESP_OK;
+}
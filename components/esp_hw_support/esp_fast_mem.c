@@ -0,0 +1,268 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "esp_fast_mem.h"
+#include "soc/soc_caps.h"
+#if SOC_ASYNC_MEMCPY_SUPPORTED
+#include "esp_async_memcpy.h"
+#include "esp_private/esp_cache_private.h"
+#endif
+#if CONFIG_ESP_FAST_MEM_FUNC_IN_IRAM
+#include "esp_private/cache_utils.h"
+#endif
+
+#define FAST_MEM_SIMD_ALIGN     16  // the vector loads and stores ignore the lowest 4 bits of the address
+#define FAST_MEM_DMA_MIN_ALIGN  64  // covers the largest DMA burst size on external memory
+
+// word accesses to buffers of any type
+typedef uint32_t __attribute__((may_alias)) fast_mem_word_t;
+
+#if SOC_ASYNC_MEMCPY_SUPPORTED
+static const char *TAG = "fast_mem";
+static async_memcpy_handle_t s_mcp;
+static size_t s_dma_align;
+static uint32_t s_dma_users;    // copies which may use s_mcp, the driver is only uninstalled once there is none
+#endif
+
+// the vector registers and the blocking DMA wait are only available to tasks
+static inline bool fast_mem_in_task(void)
+{
+    return !xPortInIsrContext() && xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
+}
+
+#if CONFIG_ESP_FAST_MEM_SIMD
+void esp_fast_mem_copy_simd(void *dst, const void *src, size_t n);
+void esp_fast_mem_set_simd(void *dst, const void *pattern, size_t n);
+
+static bool fast_mem_copy_simd(uint8_t *dst, const uint8_t *src, size_t n)
+{
+    if (((uintptr_t)dst ^ (uintptr_t)src) & (FAST_MEM_SIMD_ALIGN - 1)) {
+        return false;
+    }
+    size_t head = -(uintptr_t)dst & (FAST_MEM_SIMD_ALIGN - 1);
+    size_t body = (n - head) & ~(size_t)(FAST_MEM_SIMD_ALIGN - 1);
+    memcpy(dst, src, head);
+    esp_fast_mem_copy_simd(dst + head, src + head, body);
+    memcpy(dst + head + body, src + head + body, n - head - body);
+    return true;
+}
+
+static void fast_mem_set_simd(uint8_t *dst, int c, size_t n)
+{
+    uint32_t pattern[4] __attribute__((aligned(FAST_MEM_SIMD_ALIGN)));
+    memset(pattern, c, sizeof(pattern));
+
+    size_t head = -(uintptr_t)dst & (FAST_MEM_SIMD_ALIGN - 1);
+    size_t body = (n - head) & ~(size_t)(FAST_MEM_SIMD_ALIGN - 1);
+    memset(dst, c, head);
+    esp_fast_mem_set_simd(dst + head, pattern, body);
+    memset(dst + head + body, c, n - head - body);
+}
+#endif // CONFIG_ESP_FAST_MEM_SIMD
+
+#if SOC_ASYNC_MEMCPY_SUPPORTED
+static bool IRAM_ATTR fast_mem_dma_done_cb(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *cb_args)
+{
+    BaseType_t high_task_wakeup = pdFALSE;
+    xSemaphoreGiveFromISR((SemaphoreHandle_t)cb_args, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+}
+
+static inline bool fast_mem_dma_capable(const void *p)
+{
+    return esp_ptr_dma_capable(p) || esp_ptr_dma_ext_capable(p);
+}
+
+/**
+ * The DMA copies the part of the buffer which is aligned to whole cache lines, while the CPU copies the head and
+ * the tail. They don't share a cache line with the DMA part, so the cache invalidation done by the driver at the
+ * end of the transfer doesn't drop them. src is NULL for a memset.
+ */
+static bool fast_mem_dma_run(async_memcpy_handle_t mcp, uint8_t *dst, const uint8_t *src, int c, size_t n)
+{
+#if CONFIG_ESP_FAST_MEM_FUNC_IN_IRAM
+    if (!spi_flash_cache_enabled()) {
+        return false;
+    }
+#endif
+    size_t align = s_dma_align;
+    if (!fast_mem_dma_capable(dst)) {
+        return false;
+    }
+    if (src && (!fast_mem_dma_capable(src) || (((uintptr_t)dst ^ (uintptr_t)src) & (align - 1)))) {
+        return false;
+    }
+    size_t head = -(uintptr_t)dst & (align - 1);
+    size_t body = (n - head) & ~(align - 1);
+    size_t tail = n - head - body;
+    if (body == 0) {
+        return false;
+    }
+
+    StaticSemaphore_t done_buf;
+    SemaphoreHandle_t done = xSemaphoreCreateBinaryStatic(&done_buf);
+    esp_err_t err;
+#if SOC_CP_DMA_SUPPORTED
+    // the CP DMA backend has no memset
+    if (!src) {
+        vSemaphoreDelete(done);
+        return false;
+    }
+    err = esp_async_memcpy(mcp, dst + head, (void *)(src + head), body, fast_mem_dma_done_cb, done);
+#else
+    if (src) {
+        err = esp_async_memcpy(mcp, dst + head, (void *)(src + head), body, fast_mem_dma_done_cb, done);
+    } else {
+        err = esp_async_memset(mcp, dst + head, (uint8_t)c, body, fast_mem_dma_done_cb, done);
+    }
+#endif
+    if (err != ESP_OK) {
+        // e.g. the backlog of the driver is full, the CPU does the job
+        vSemaphoreDelete(done);
+        return false;
+    }
+
+    // the CPU handles the edges while the DMA runs
+    if (src) {
+        memcpy(dst, src, head);
+        memcpy(dst + head + body, src + head + body, tail);
+    } else {
+        memset(dst, c, head);
+        memset(dst + head + body, c, tail);
+    }
+    xSemaphoreTake(done, portMAX_DELAY);
+    vSemaphoreDelete(done);
+    return true;
+}
+
+static bool fast_mem_dma(uint8_t *dst, const uint8_t *src, int c, size_t n)
+{
+    if (n < CONFIG_ESP_FAST_MEM_DMA_THRESHOLD || !__atomic_load_n(&s_mcp, __ATOMIC_RELAXED)) {
+        return false;
+    }
+    // announce the copy before loading the driver handle, esp_fast_mem_disable_dma() does it the other way round
+    __atomic_fetch_add(&s_dma_users, 1, __ATOMIC_SEQ_CST);
+    async_memcpy_handle_t mcp = __atomic_load_n(&s_mcp, __ATOMIC_SEQ_CST);
+    bool done = mcp && fast_mem_dma_run(mcp, dst, src, c, n);
+    __atomic_fetch_sub(&s_dma_users, 1, __ATOMIC_RELEASE);
+    return done;
+}
+#endif // SOC_ASYNC_MEMCPY_SUPPORTED
+
+void *esp_fast_memcpy_dispatch(void *dst, const void *src, size_t n)
+{
+    if (n < ESP_FAST_MEM_INLINE_THRESHOLD || !fast_mem_in_task()) {
+        return memcpy(dst, src, n);
+    }
+#if SOC_ASYNC_MEMCPY_SUPPORTED
+    if (fast_mem_dma(dst, src, 0, n)) {
+        return dst;
+    }
+#endif
+#if CONFIG_ESP_FAST_MEM_SIMD
+    if (fast_mem_copy_simd(dst, src, n)) {
+        return dst;
+    }
+#endif
+    return memcpy(dst, src, n);
+}
+
+void *esp_fast_memset_dispatch(void *dst, int c, size_t n)
+{
+    if (n < ESP_FAST_MEM_INLINE_THRESHOLD || !fast_mem_in_task()) {
+        return memset(dst, c, n);
+    }
+#if SOC_ASYNC_MEMCPY_SUPPORTED
+    if (fast_mem_dma(dst, NULL, c, n)) {
+        return dst;
+    }
+#endif
+#if CONFIG_ESP_FAST_MEM_SIMD
+    fast_mem_set_simd(dst, c, n);
+    return dst;
+#else
+    return memset(dst, c, n);
+#endif
+}
+
+int esp_fast_memcmp(const void *a, const void *b, size_t n)
+{
+    const uint8_t *pa = a;
+    const uint8_t *pb = b;
+
+    if ((((uintptr_t)pa ^ (uintptr_t)pb) & 3) == 0) {
+        while (n && ((uintptr_t)pa & 3)) {
+            if (*pa != *pb) {
+                return *pa - *pb;
+            }
+            pa++;
+            pb++;
+            n--;
+        }
+        // skip the equal words, the first different word is compared byte by byte below
+        while (n >= 4 && *(const fast_mem_word_t *)pa == *(const fast_mem_word_t *)pb) {
+            pa += 4;
+            pb += 4;
+            n -= 4;
+        }
+    }
+    while (n) {
+        if (*pa != *pb) {
+            return *pa - *pb;
+        }
+        pa++;
+        pb++;
+        n--;
+    }
+    return 0;
+}
+
+esp_err_t esp_fast_mem_enable_dma(void)
+{
+#if SOC_ASYNC_MEMCPY_SUPPORTED
+    ESP_RETURN_ON_FALSE(!s_mcp, ESP_ERR_INVALID_STATE, TAG, "DMA already enabled");
+
+    size_t int_align = 0;
+    size_t ext_align = 0;
+    esp_cache_get_alignment(MALLOC_CAP_DMA, &int_align);
+    esp_cache_get_alignment(MALLOC_CAP_SPIRAM, &ext_align);
+
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    async_memcpy_handle_t mcp = NULL;
+    ESP_RETURN_ON_ERROR(esp_async_memcpy_install(&config, &mcp), TAG, "install async memcpy failed");
+    s_dma_align = MAX(MAX(int_align, ext_align), FAST_MEM_DMA_MIN_ALIGN);
+    __atomic_store_n(&s_mcp, mcp, __ATOMIC_RELEASE);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t esp_fast_mem_disable_dma(void)
+{
+#if SOC_ASYNC_MEMCPY_SUPPORTED
+    async_memcpy_handle_t mcp = __atomic_exchange_n(&s_mcp, NULL, __ATOMIC_SEQ_CST);
+    ESP_RETURN_ON_FALSE(mcp, ESP_ERR_INVALID_STATE, TAG, "DMA not enabled");
+    // new copies find no driver now, wait for the ones which already use it
+    while (__atomic_load_n(&s_dma_users, __ATOMIC_ACQUIRE) != 0) {
+        vTaskDelay(1);
+    }
+    return esp_async_memcpy_uninstall(mcp);
+#else
+    return ESP_ERR_INVALID_STATE;
+#endif
+}
@@ -161,6 +161,84 @@ esp_err_t esp_async_memcpy_uninstall(async_memcpy_handle_t mcp);
  */
 esp_err_t esp_async_memcpy(async_memcpy_handle_t mcp, void *dst, void *src, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args);
 
+/**
+ * @brief Type of async memcpy segment, a pair of buffers to copy between
+ */
+typedef struct {
+    void *dst;   /*!< Destination address (copy to) */
+    void *src;   /*!< Source address (copy from) */
+    size_t size; /*!< Number of bytes to copy */
+} async_memcpy_segment_t;
+
+/**
+ * @brief Send an asynchronous memory copy request that consists of multiple segments
+ *
+ * @note All the segments are chained into one DMA transaction, so the callback function is invoked only once,
+ *       after the last segment is copied. This is cheaper than sending a request for each segment.
+ * @note Each segment has to meet the same alignment requirement as the buffers of `esp_async_memcpy`.
+ *
+ * @param[in] mcp Handle of async memcpy driver that returned from `esp_async_memcpy_install`
+ * @param[in] segments Array of segments to copy, the array itself can be released once the function returns
+ * @param[in] num_segments Number of segments in the array
+ * @param[in] cb_isr Callback function, which got invoked in interrupt context. Set to NULL can bypass the callback.
+ * @param[in] cb_args User defined argument to be passed to the callback function
+ * @return
+ *      - ESP_OK: Send memory copy request successfully
+ *      - ESP_ERR_INVALID_ARG: Send memory copy request failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: Send memory copy request failed because the DMA backend doesn't support it
+ *      - ESP_ERR_NO_MEM: Send memory copy request failed because out of memory
+ *      - ESP_FAIL: Send memory copy request failed because of other error
+ */
+esp_err_t esp_async_memcpy_batch(async_memcpy_handle_t mcp, const async_memcpy_segment_t *segments, size_t num_segments,
+                                 async_memcpy_isr_cb_t cb_isr, void *cb_args);
+
+/**
+ * @brief Send an asynchronous memory copy request of a 2D block, e.g. a rectangle of a frame buffer
+ *
+ * @note Each row is copied as a segment of `esp_async_memcpy_batch`, so the row start addresses and the width
+ *       have to meet the alignment requirement of the DMA backend.
+ * @note This function allocates a temporary segment array, don't call it from the ISR context.
+ *
+ * @param[in] mcp Handle of async memcpy driver that returned from `esp_async_memcpy_install`
+ * @param[in] dst Destination address of the first row
+ * @param[in] dst_stride Distance between the start addresses of two adjacent destination rows, in bytes
+ * @param[in] src Source address of the first row
+ * @param[in] src_stride Distance between the start addresses of two adjacent source rows, in bytes
+ * @param[in] width Number of bytes to copy per row
+ * @param[in] height Number of rows
+ * @param[in] cb_isr Callback function, which got invoked in interrupt context. Set to NULL can bypass the callback.
+ * @param[in] cb_args User defined argument to be passed to the callback function
+ * @return
+ *      - ESP_OK: Send memory copy request successfully
+ *      - ESP_ERR_INVALID_ARG: Send memory copy request failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: Send memory copy request failed because the DMA backend doesn't support it
+ *      - ESP_ERR_NO_MEM: Send memory copy request failed because out of memory
+ *      - ESP_FAIL: Send memory copy request failed because of other error
+ */
+esp_err_t esp_async_memcpy_2d(async_memcpy_handle_t mcp, void *dst, size_t dst_stride, void *src, size_t src_stride,
+                              size_t width, size_t height, async_memcpy_isr_cb_t cb_isr, void *cb_args);
+
+/**
+ * @brief Send an asynchronous memory set request
+ *
+ * @note The DMA reads the value from a small internal pattern buffer, the destination buffer has to meet
+ *       the same alignment requirement as the destination buffer of `esp_async_memcpy`.
+ *
+ * @param[in] mcp Handle of async memcpy driver that returned from `esp_async_memcpy_install`
+ * @param[in] dst Destination address
+ * @param[in] value Value to fill the destination buffer with
+ * @param[in] n Number of bytes to set
+ * @param[in] cb_isr Callback function, which got invoked in interrupt context. Set to NULL can bypass the callback.
+ * @param[in] cb_args User defined argument to be passed to the callback function
+ * @return
+ *      - ESP_OK: Send memory set request successfully
+ *      - ESP_ERR_INVALID_ARG: Send memory set request failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: Send memory set request failed because the DMA backend doesn't support it
+ *      - ESP_ERR_NO_MEM: Send memory set request failed because out of memory
+ *      - ESP_FAIL: Send memory set request failed because of other error
+ */
+esp_err_t esp_async_memset(async_memcpy_handle_t mcp, void *dst, uint8_t value, size_t n, async_memcpy_isr_cb_t cb_isr, void *cb_args);
+
 #if SOC_ETM_SUPPORTED
 /**
  * @brief Async memory copy specific events that supported by the ETM module
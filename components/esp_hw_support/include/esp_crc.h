@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -11,7 +11,7 @@ extern "C" {
 
 #include <stdint.h>
 
-// This header is only a wrapper on ROM CRC API
+// This header wraps the ROM CRC API, CRC32 LE and CRC16 BE of long buffers are computed with table slicing
 #include "esp_rom_crc.h"
 
 /**
@@ -20,12 +20,12 @@ extern "C" {
 * @param crc: Initial CRC value (result of last calculation or 0 for the first time)
 * @param buf: Data buffer that used to calculate the CRC value
 * @param len: Length of the data buffer
+* @note The result is the same as esp_rom_crc32_le(). When CONFIG_ESP_CRC_SLICING is enabled, buffers of at least
+*       CONFIG_ESP_CRC_SLICING_THRESHOLD bytes are processed 8 bytes at a time while the flash cache is enabled.
+*
 * @return CRC32 value
 */
-static inline uint32_t esp_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len)
-{
-    return esp_rom_crc32_le(crc, buf, len);
-}
+uint32_t esp_crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len);
 
 /**
 * @brief CRC32 value in big endian.
@@ -59,12 +59,12 @@ static inline uint16_t esp_crc16_le(uint16_t crc, uint8_t const *buf, uint32_t l
 * @param crc: Initial CRC value (result of last calculation or 0 for the first time)
 * @param buf: Data buffer that used to calculate the CRC value
 * @param len: Length of the data buffer
+* @note The result is the same as esp_rom_crc16_be(). When CONFIG_ESP_CRC_SLICING is enabled, buffers of at least
+*       CONFIG_ESP_CRC_SLICING_THRESHOLD bytes are processed 4 bytes at a time while the flash cache is enabled.
+*
 * @return CRC16 value
 */
-static inline uint16_t esp_crc16_be(uint16_t crc, uint8_t const *buf, uint32_t len)
-{
-    return esp_rom_crc16_be(crc, buf, len);
-}
+uint16_t esp_crc16_be(uint16_t crc, uint8_t const *buf, uint32_t len);
 
 /**
 * @brief CRC8 value in little endian.
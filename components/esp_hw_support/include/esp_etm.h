@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -142,6 +142,96 @@ esp_err_t esp_etm_del_task(esp_etm_task_handle_t task);
  */
 esp_err_t esp_etm_dump(FILE *out_stream);
 
+/**
+ * @brief ETM graph handle
+ */
+typedef struct esp_etm_graph_t *esp_etm_graph_handle_t;
+
+/**
+ * @brief Edge of an ETM graph, an event which triggers a task
+ */
+typedef struct {
+    esp_etm_event_handle_t event; /*!< ETM event handle obtained from a driver/peripheral, e.g. `xxx_new_etm_event` */
+    esp_etm_task_handle_t task;   /*!< ETM task handle obtained from a driver/peripheral, e.g. `xxx_new_etm_task` */
+} esp_etm_graph_edge_t;
+
+/**
+ * @brief ETM graph configuration
+ */
+typedef struct {
+    const esp_etm_graph_edge_t *edges; /*!< Edges of the graph, listed from the first stage of the pipeline to the last.
+                                            An event can trigger several tasks, and a task can be triggered by several
+                                            events, each pair being one edge */
+    size_t num_edges;                  /*!< Number of edges */
+} esp_etm_graph_config_t;
+
+/**
+ * @brief Create an ETM graph, allocating and connecting one ETM channel per edge
+ *
+ * @note Either all the channels of the graph are allocated, or none. The graph is created disabled.
+ * @note The events and tasks still belong to the caller, and must be deleted after the graph
+ *
+ * @param[in] config ETM graph configuration
+ * @param[out] ret_graph Returned ETM graph handle
+ * @return
+ *      - ESP_OK: Create ETM graph successfully
+ *      - ESP_ERR_INVALID_ARG: Create ETM graph failed because of invalid argument, e.g. an edge without event or task,
+ *                             or the same edge listed twice
+ *      - ESP_ERR_NO_MEM: Create ETM graph failed because of out of memory
+ *      - ESP_ERR_NOT_FOUND: Create ETM graph failed because there are not enough free channels for all the edges
+ *      - ESP_FAIL: Create ETM graph failed because of other reasons
+ */
+esp_err_t esp_etm_new_graph(const esp_etm_graph_config_t *config, esp_etm_graph_handle_t *ret_graph);
+
+/**
+ * @brief Delete an ETM graph and free its channels
+ *
+ * @param[in] graph ETM graph handle created by `esp_etm_new_graph`
+ * @return
+ *      - ESP_OK: Delete ETM graph successfully
+ *      - ESP_ERR_INVALID_ARG: Delete ETM graph failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Delete ETM graph failed because the graph is still enabled
+ */
+esp_err_t esp_etm_del_graph(esp_etm_graph_handle_t graph);
+
+/**
+ * @brief Enable all the channels of an ETM graph
+ *
+ * @note The channels are enabled in a critical section, from the last edge to the first one, so that
+ *       an event of an early stage of the pipeline never triggers a later stage which isn't enabled yet.
+ *
+ * @param[in] graph ETM graph handle created by `esp_etm_new_graph`
+ * @return
+ *      - ESP_OK: Enable ETM graph successfully
+ *      - ESP_ERR_INVALID_ARG: Enable ETM graph failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Enable ETM graph failed because the graph is enabled already
+ */
+esp_err_t esp_etm_graph_enable(esp_etm_graph_handle_t graph);
+
+/**
+ * @brief Disable all the channels of an ETM graph
+ *
+ * @note The channels are disabled in a critical section, from the first edge to the last one.
+ *
+ * @param[in] graph ETM graph handle created by `esp_etm_new_graph`
+ * @return
+ *      - ESP_OK: Disable ETM graph successfully
+ *      - ESP_ERR_INVALID_ARG: Disable ETM graph failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Disable ETM graph failed because the graph is not enabled yet
+ */
+esp_err_t esp_etm_graph_disable(esp_etm_graph_handle_t graph);
+
+/**
+ * @brief Dump the edges of an ETM graph and the channels connecting them to the given IO stream
+ *
+ * @param[in] graph ETM graph handle created by `esp_etm_new_graph`
+ * @param[in] out_stream IO stream (e.g. stdout)
+ * @return
+ *      - ESP_OK: Dump ETM graph successfully
+ *      - ESP_ERR_INVALID_ARG: Dump ETM graph failed because of invalid argument
+ */
+esp_err_t esp_etm_graph_dump(esp_etm_graph_handle_t graph, FILE *out_stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond */
+void *esp_fast_memcpy_dispatch(void *dst, const void *src, size_t n);
+void *esp_fast_memset_dispatch(void *dst, int c, size_t n);
+
+#if CONFIG_ESP_FAST_MEM_SIMD
+#define ESP_FAST_MEM_INLINE_THRESHOLD   CONFIG_ESP_FAST_MEM_SIMD_THRESHOLD
+#else
+#define ESP_FAST_MEM_INLINE_THRESHOLD   64
+#endif
+/** @endcond */
+
+/**
+ * @brief Copy memory, picking the fastest method for the size of the copy
+ *
+ * - Short copies are done by memcpy(), and inlined by the compiler when n is a constant.
+ * - Medium copies are done with the vector instructions of the CPU, if CONFIG_ESP_FAST_MEM_SIMD is enabled.
+ * - Copies of at least CONFIG_ESP_FAST_MEM_DMA_THRESHOLD bytes are done by the DMA, once esp_fast_mem_enable_dma()
+ *   has been called. The calling task blocks until the DMA is done.
+ *
+ * The vector instructions and the DMA are only used from the task context, and only when the alignment of
+ * the buffers allows it. Otherwise this behaves like memcpy().
+ *
+ * @param dst Destination, must not overlap with src
+ * @param src Source
+ * @param n   Number of bytes to copy
+ *
+ * @return dst
+ */
+static inline void *esp_fast_memcpy(void *dst, const void *src, size_t n)
+{
+    if (__builtin_constant_p(n) && n < ESP_FAST_MEM_INLINE_THRESHOLD) {
+        return memcpy(dst, src, n);
+    }
+    return esp_fast_memcpy_dispatch(dst, src, n);
+}
+
+/**
+ * @brief Fill memory with a byte value, picking the fastest method for the size of the buffer
+ *
+ * The methods are the same as for esp_fast_memcpy().
+ *
+ * @param dst Buffer to fill
+ * @param c   Value, converted to unsigned char
+ * @param n   Number of bytes to fill
+ *
+ * @return dst
+ */
+static inline void *esp_fast_memset(void *dst, int c, size_t n)
+{
+    if (__builtin_constant_p(n) && n < ESP_FAST_MEM_INLINE_THRESHOLD) {
+        return memset(dst, c, n);
+    }
+    return esp_fast_memset_dispatch(dst, c, n);
+}
+
+/**
+ * @brief Compare memory, a word at a time when the buffers have the same alignment
+ *
+ * @param a First buffer
+ * @param b Second buffer
+ * @param n Number of bytes to compare
+ *
+ * @return Same as memcmp()
+ */
+int esp_fast_memcmp(const void *a, const void *b, size_t n);
+
+/**
+ * @brief Let esp_fast_memcpy() and esp_fast_memset() use the DMA for large buffers
+ *
+ * Installs the async memcpy driver with its default DMA backend and configuration. The DMA is used for buffers
+ * of at least CONFIG_ESP_FAST_MEM_DMA_THRESHOLD bytes which can be accessed by the DMA, and whose start addresses
+ * have the same offset from the cache line alignment. The unaligned head and tail are copied by the CPU.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the DMA is already enabled
+ *      - ESP_ERR_NOT_SUPPORTED if the chip doesn't support async memcpy
+ *      - Other errors from esp_async_memcpy_install()
+ */
+esp_err_t esp_fast_mem_enable_dma(void);
+
+/**
+ * @brief Stop using the DMA and uninstall the async memcpy driver installed by esp_fast_mem_enable_dma()
+ *
+ * Copies started afterwards are done by the CPU. Waits until the copies which are already using the DMA in
+ * other tasks are finished, so it must be called from a task. It must not be called concurrently with
+ * esp_fast_mem_enable_dma().
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the DMA is not enabled
+ */
+esp_err_t esp_fast_mem_disable_dma(void);
+
+#ifdef __cplusplus
+}
+#endif
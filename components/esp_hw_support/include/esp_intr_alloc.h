@@ -75,6 +75,22 @@ extern "C" {
  */
 #define ETS_INTERNAL_INTR_SOURCE_OFF        (-ETS_INTERNAL_PROFILING_INTR_SOURCE)
 
+/** Number of buckets of the duration histogram of esp_intr_stats_t */
+#define ESP_INTR_STATS_HISTOGRAM_BUCKETS    6
+
+/**
+ * @brief Execution statistics of an interrupt handler, recorded if CONFIG_ESP_INTR_STATS is enabled
+ *
+ * The bucket i of the histogram counts the calls which took less than 256 * 4^i CPU cycles, and at least
+ * the upper bound of bucket i - 1. The last bucket counts all longer calls.
+ */
+typedef struct {
+    uint32_t count;             /*!< Number of times the handler was called */
+    uint32_t max_cycles;        /*!< Longest execution of the handler, in CPU cycles */
+    uint64_t total_cycles;      /*!< Total execution time of the handler, in CPU cycles */
+    uint32_t histogram[ESP_INTR_STATS_HISTOGRAM_BUCKETS];  /*!< Number of calls per range of execution time */
+} esp_intr_stats_t;
+
 /** Enable interrupt by interrupt number */
 #define ESP_INTR_ENABLE(inum)  esp_intr_enable_source(inum)
 
@@ -317,6 +333,32 @@ static inline int esp_intr_level_to_flags(int level)
  */
 esp_err_t esp_intr_dump(FILE *stream);
 
+/**
+ * @brief Get the execution statistics of an interrupt handler
+ *
+ * @param handle The handle, as obtained by esp_intr_alloc or esp_intr_alloc_intrstatus
+ * @param[out] stats Statistics of the handler
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is NULL or the interrupt has no C handler
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_INTR_STATS is disabled
+ */
+esp_err_t esp_intr_get_stats(intr_handle_t handle, esp_intr_stats_t *stats);
+
+/**
+ * @brief Dump the execution statistics of all interrupt handlers
+ *
+ * For each handler, print its interrupt, its source, the number of calls, the average and longest execution time
+ * and the duration histogram. The handlers of a shared interrupt are printed in the order they are called.
+ *
+ * @param stream  The stream to dump to, if NULL then stdout is used
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if the temporary buffer for the output could not be allocated
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_INTR_STATS is disabled
+ */
+esp_err_t esp_intr_dump_stats(FILE *stream);
+
 
 /**
  * @brief Check if the given pointer is in the safe ISR area.
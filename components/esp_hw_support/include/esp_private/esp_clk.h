@@ -1,11 +1,13 @@
 /*
- * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #pragma once
 #include <stdint.h>
+#include <stdbool.h>
+#include "soc/clk_tree_defs.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,6 +40,18 @@ uint32_t esp_clk_slowclk_cal_get(void);
  */
 void esp_clk_slowclk_cal_set(uint32_t value);
 
+/**
+ * @brief Check whether the calibration value of RTC slow clock is still valid after a deep sleep
+ *
+ * When waking up from deep sleep, the RTC slow clock source kept running and the calibration value
+ * stored before the sleep is retained, so the slow clock doesn't have to be calibrated again.
+ *
+ * @param slow_clk_src RTC slow clock source about to be selected
+ *
+ * @return true if the chip woke up from deep sleep with slow_clk_src already selected and calibrated
+ */
+bool esp_clk_slowclk_cal_retained(soc_rtc_slow_clk_src_t slow_clk_src);
+
 /**
  * @brief Return current CPU clock frequency
  * When frequency switching is performed, this frequency may change.
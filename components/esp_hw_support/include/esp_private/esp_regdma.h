@@ -396,6 +396,44 @@ void *regdma_find_prev_module_link_tail(void *link, void *tail, int entry, uint3
  */
 void *regdma_find_next_module_link_head(void *link, void *tail, int entry, uint32_t module);
 
+/**
+ * @brief Defer the restore of the nodes of the specified module in the REGDMA linked list indicated by the
+ * entry argument, starting from the link argument to the end of the tail argument, from REGDMA to the CPU
+ *
+ * Only the nodes referenced by the entry alone are deferred, the statistics of the linked list must be up to
+ * date (see regdma_link_stats). The nodes are still backed up by REGDMA.
+ *
+ * @param  link   The REGDMA linkded list head pointer
+ * @param  tail   The REGDMA linkded list tail pointer
+ * @param  entry  For nodes that support branching, use the branch specified by entry argument recursively
+ * @param  module Module bitmap Identification
+ * @param  lazy   true to let REGDMA skip the restore of the nodes, false to give their restore back to REGDMA
+ */
+void regdma_link_set_module_lazy_restore(void *link, void *tail, int entry, uint32_t module, bool lazy);
+
+/**
+ * @brief Restore the deferred nodes of the specified module in the REGDMA linked list indicated by the
+ * entry argument starting from the link argument to the end of the tail argument, by the CPU
+ * @param  link   The REGDMA linkded list head pointer
+ * @param  tail   The REGDMA linkded list tail pointer
+ * @param  entry  For nodes that support branching, use the branch specified by entry argument recursively
+ * @param  module Module bitmap Identification
+ * @return        The number of register words restored
+ */
+uint32_t regdma_link_restore_by_cpu(void *link, void *tail, int entry, uint32_t module);
+
+/**
+ * @brief Get the number of register words restored for the specified module in the REGDMA linked list
+ * indicated by the entry argument starting from the link argument to the end of the tail argument,
+ * including the ones deferred to the CPU
+ * @param  link   The REGDMA linkded list head pointer
+ * @param  tail   The REGDMA linkded list tail pointer
+ * @param  entry  For nodes that support branching, use the branch specified by entry argument recursively
+ * @param  module Module bitmap Identification
+ * @return        The number of register words
+ */
+uint32_t regdma_link_get_module_restore_length(void *link, void *tail, int entry, uint32_t module);
+
 #define regdma_link_init_safe(pcfg, branch, module, ...)    regdma_link_init((pcfg), (branch), (module), __VA_NARG__(__VA_ARGS__), ##__VA_ARGS__)
 
 #define regdma_link_update_next_safe(link, ...)             regdma_link_update_next((link), __VA_NARG__(__VA_ARGS__), ##__VA_ARGS__)
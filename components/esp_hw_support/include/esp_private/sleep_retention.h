@@ -43,6 +43,23 @@ typedef enum {
     SLEEP_RETENTION_MODULE_ATTR_PASSIVE = 0x1
 } sleep_retention_module_attribute_t;
 
+typedef enum {
+    SLEEP_RETENTION_RESTORE_BY_REGDMA = 0,  /*!< The module context is restored by REGDMA before the CPU resumes, this is the default */
+    SLEEP_RETENTION_RESTORE_DEFERRED,       /*!< The module context is restored by the CPU at the end of the wakeup, after the SLEEP_EVENT_SW_EXIT_SLEEP callbacks,
+                                                 in the order of the REGDMA link priority */
+    SLEEP_RETENTION_RESTORE_ON_DEMAND,      /*!< The module context is restored by the CPU when sleep_retention_module_restore is called before the module is accessed,
+                                                 or before the next sleep if the module is not accessed */
+} sleep_retention_restore_mode_t;
+
+typedef struct {
+    uint32_t context_words;     /*!< The number of register words restored for the module on each wakeup */
+    uint32_t lazy_words;        /*!< The number of register words restored by the CPU in the last lazy restore */
+    uint32_t restore_count;     /*!< The number of lazy restores done by the CPU */
+    uint32_t last_restore_us;   /*!< The duration of the last lazy restore, in microseconds */
+    uint32_t max_restore_us;    /*!< The longest lazy restore, in microseconds */
+    uint64_t total_restore_us;  /*!< The total duration of all lazy restores, in microseconds */
+} sleep_retention_module_stats_t;
+
 /**
  * @brief Create a runtime sleep retention linked list
  *
@@ -139,6 +156,63 @@ esp_err_t sleep_retention_module_allocate(sleep_retention_module_t module);
  */
 esp_err_t sleep_retention_module_free(sleep_retention_module_t module);
 
+/**
+ * @brief Set how the sleep retention context of the module is restored on wakeup
+ *
+ * A lazy module (SLEEP_RETENTION_RESTORE_DEFERRED or SLEEP_RETENTION_RESTORE_ON_DEMAND) is still
+ * backed up by REGDMA before sleep, but REGDMA skips its restore on wakeup, so that the wakeup
+ * latency doesn't grow with the size of its context. The module must not be accessed by anything
+ * (including its interrupts) during the wakeup until its context is restored by the CPU.
+ *
+ * @note Only the part of the context restored on the wakeup from PMU_HP_SLEEP to PMU_HP_ACTIVE is
+ *       deferred, the context shared with the modem state switching is always restored by REGDMA.
+ *
+ * @param module   the module number
+ * @param mode     restore mode of the module
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if either of the arguments is out of range
+ *      - ESP_ERR_INVALID_STATE if the module is de-initialized
+ *      - ESP_ERR_NOT_ALLOWED if the attribute of module is set to SLEEP_RETENTION_MODULE_ATTR_PASSIVE,
+ *        the modules depended on by others are always restored by REGDMA
+ */
+esp_err_t sleep_retention_module_set_restore_mode(sleep_retention_module_t module, sleep_retention_restore_mode_t mode);
+
+/**
+ * @brief Restore the sleep retention context of a lazy module by the CPU, if it has not been restored since the last wakeup
+ *
+ * Drivers of SLEEP_RETENTION_RESTORE_ON_DEMAND modules call this before their first access to the
+ * hardware after the wakeup; it does nothing if the context is already restored.
+ *
+ * @note It can only be called from task context.
+ *
+ * @param module   the module number
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the module number is out of range
+ */
+esp_err_t sleep_retention_module_restore(sleep_retention_module_t module);
+
+/**
+ * @brief Get the restore statistics of the module
+ *
+ * @param module   the module number
+ * @param stats    returned statistics
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if either of the arguments is out of range
+ *      - ESP_ERR_INVALID_STATE if the module is de-initialized
+ */
+esp_err_t sleep_retention_module_get_stats(sleep_retention_module_t module, sleep_retention_module_stats_t *stats);
+
+/**
+ * @brief Dump the restore mode and statistics of all created modules
+ */
+void sleep_retention_dump_modules(FILE *out);
+
 /**
  * @brief Get all initialized modules that require sleep retention
  *
@@ -172,6 +246,23 @@ uint32_t sleep_retention_get_created_modules(void);
  */
 void sleep_retention_do_extra_retention(bool backup_or_restore);
 
+/**
+ * @brief Mark the contexts of all created lazy modules as not restored
+ *
+ * It can only be called by the sleep procedure, on the wakeup from a sleep with the TOP domain powered down.
+ */
+void sleep_retention_set_lazy_modules_pending(void);
+
+/**
+ * @brief Restore the contexts of the lazy modules which are not restored since the last wakeup
+ *
+ * It can only be called by the sleep procedure.
+ *
+ * @param on_demand false to restore the SLEEP_RETENTION_RESTORE_DEFERRED modules at the end of the wakeup,
+ *                  true to also restore the SLEEP_RETENTION_RESTORE_ON_DEMAND modules before going to sleep
+ */
+void sleep_retention_do_lazy_restore(bool on_demand);
+
 #if SOC_PM_RETENTION_SW_TRIGGER_REGDMA
 /**
  * @brief Software trigger REGDMA to do system linked list retention
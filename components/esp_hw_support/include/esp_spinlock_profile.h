@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Statistics of a spinlock, recorded if CONFIG_ESP_SPINLOCK_PROFILING is enabled
+ */
+typedef struct {
+    const void *lock;           /*!< Address of the spinlock (portMUX_TYPE) */
+    uint32_t acquire_count;     /*!< Number of times the lock was taken, nested acquisitions excluded */
+    uint32_t contended_count;   /*!< Number of times the lock was held by the other core when it was requested */
+    uint64_t spin_cycles;       /*!< Total number of CPU cycles spent waiting for the lock */
+    uint32_t max_spin_cycles;   /*!< Longest wait for the lock, in CPU cycles */
+    uint32_t max_hold_cycles;   /*!< Longest time the lock was held, in CPU cycles */
+    const void *max_hold_caller;/*!< Return address of the critical section function which held the lock the longest */
+} esp_spinlock_profile_entry_t;
+
+/**
+ * @brief Get the statistics of the profiled spinlocks
+ *
+ * The entries are sorted by decreasing spin_cycles, so the most contended locks come first.
+ *
+ * @note A lock is identified by its address. If a lock is freed and another one is created at the same address,
+ *       their statistics are merged.
+ *
+ * @param[out] entries     Array filled with the statistics
+ * @param[in]  max_entries Size of the array
+ * @param[out] num_entries Number of entries written
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if entries or num_entries is NULL
+ *      - ESP_ERR_NO_MEM if the temporary buffer used for sorting could not be allocated
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_SPINLOCK_PROFILING is disabled
+ */
+esp_err_t esp_spinlock_profile_get(esp_spinlock_profile_entry_t *entries, size_t max_entries, size_t *num_entries);
+
+/**
+ * @brief Print the statistics of the profiled spinlocks, most contended first
+ *
+ * The caller addresses can be translated to function names with addr2line or ``idf.py monitor``.
+ *
+ * @param stream Stream (such as stdout) to print to
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if the temporary buffer for the output could not be allocated
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_SPINLOCK_PROFILING is disabled
+ */
+esp_err_t esp_spinlock_profile_dump(FILE *stream);
+
+/**
+ * @brief Clear the statistics of all spinlocks
+ *
+ * @note The locks taken by the other core while the statistics are cleared may keep some of their old values.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_SPINLOCK_PROFILING is disabled
+ */
+esp_err_t esp_spinlock_profile_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
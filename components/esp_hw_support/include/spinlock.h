@@ -44,6 +44,14 @@ typedef struct {
     NEED_VOLATILE_MUX uint32_t count;
 } spinlock_t;
 
+#if CONFIG_ESP_SPINLOCK_PROFILING && !BOOTLOADER_BUILD
+/** @cond */
+// Called with interrupts disabled, after a lock is taken and before it is given back (see esp_spinlock_profile.h)
+void spinlock_profile_acquired(spinlock_t *lock, uint32_t spin_cycles, void *caller);
+void spinlock_profile_released(spinlock_t *lock);
+/** @endcond */
+#endif
+
 /**
  * @brief Initialize a lock to its default state - unlocked
  * @param lock - spinlock object to initialize
@@ -80,6 +88,9 @@ static inline bool __attribute__((always_inline)) spinlock_acquire(spinlock_t *l
     uint32_t __attribute__((unused)) other_core_owner_id;
     bool lock_set;
     esp_cpu_cycle_count_t start_count;
+#if CONFIG_ESP_SPINLOCK_PROFILING
+    uint32_t spin_cycles = 0;
+#endif
 
     assert(lock);
 #if __XTENSA__
@@ -135,12 +146,19 @@ static inline bool __attribute__((always_inline)) spinlock_acquire(spinlock_t *l
         }
         // Keep looping if we are waiting forever, or check if we have timed out
     } while ((timeout == SPINLOCK_WAIT_FOREVER) || (esp_cpu_get_cycle_count() - start_count) <= (esp_cpu_cycle_count_t)timeout);
+#if CONFIG_ESP_SPINLOCK_PROFILING
+    spin_cycles = esp_cpu_get_cycle_count() - start_count;
+#endif
 
 exit:
     if (lock_set) {
         assert(lock->owner == core_owner_id);
         assert(lock->count == 0);   // This is the first time the lock is set, so count should still be 0
         lock->count++;  // Finally, we increment the lock count
+#if CONFIG_ESP_SPINLOCK_PROFILING
+        // This function is always inlined, so the caller is the one of the critical section function
+        spinlock_profile_acquired(lock, spin_cycles, __builtin_return_address(0));
+#endif
     } else {    // We timed out waiting for lock
         assert(lock->owner == SPINLOCK_FREE || lock->owner == other_core_owner_id);
         assert(lock->count < 0xFF); // Bad count value implies memory corruption
@@ -191,6 +209,9 @@ static inline void __attribute__((always_inline)) spinlock_release(spinlock_t *l
     lock->count--;
 
     if (!lock->count) { // If this is the last recursive release of the lock, mark the lock as free
+#if CONFIG_ESP_SPINLOCK_PROFILING
+        spinlock_profile_released(lock);
+#endif
         lock->owner = SPINLOCK_FREE;
     } else {
         assert(lock->count < 0x100); // Indicates memory corruption
@@ -12,6 +12,7 @@
 #include <esp_types.h>
 #include <limits.h>
 #include <assert.h>
+#include <sys/param.h>
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -55,8 +56,25 @@ being triggered, that is why it is separate from the normal LOG* scheme.
 # define ALCHLOG(...) do {} while (0)
 #endif
 
+// The handlers of non-shared interrupts are called through a wrapper if something has to be done around them
+#define INTR_NON_SHARED_WRAPPER     (CONFIG_APPTRACE_SV_ENABLE || CONFIG_ESP_INTR_STATS)
+// The shared handlers are sorted by the number of times they handled their interrupt
+#define INTR_COUNT_CALLS            (CONFIG_ESP_INTR_STATS || CONFIG_ESP_INTR_SHARED_SORT_BY_FREQUENCY)
+
 typedef struct shared_vector_desc_t shared_vector_desc_t;
 typedef struct vector_desc_t vector_desc_t;
+typedef struct non_shared_isr_arg_t non_shared_isr_arg_t;
+
+#if INTR_COUNT_CALLS
+typedef struct {
+    uint32_t count;
+#if CONFIG_ESP_INTR_STATS
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t histogram[ESP_INTR_STATS_HISTOGRAM_BUCKETS];
+#endif
+} intr_stats_t;
+#endif
 
 struct shared_vector_desc_t {
     int disabled: 1;
@@ -66,6 +84,9 @@ struct shared_vector_desc_t {
     intr_handler_t isr;
     void *arg;
     shared_vector_desc_t *next;
+#if INTR_COUNT_CALLS
+    intr_stats_t stats;
+#endif
 };
 
 #define VECDESC_FL_RESERVED     (1<<0)
@@ -80,6 +101,9 @@ struct vector_desc_t {
     unsigned int intno: 5;
     int source: 8;                          //Interrupt mux flags, used when not shared
     shared_vector_desc_t *shared_vec_info;  //used when VECDESC_FL_SHARED
+#if INTR_NON_SHARED_WRAPPER
+    non_shared_isr_arg_t *non_shared_isr_arg;  //used when VECDESC_FL_NONSHARED and a handler is set
+#endif
     vector_desc_t *next;
 };
 
@@ -89,12 +113,13 @@ typedef struct intr_handle_data_t {
     shared_vector_desc_t *shared_vector_desc;
 } intr_handle_data_t;
 
-typedef struct non_shared_isr_arg_t non_shared_isr_arg_t;
-
 struct non_shared_isr_arg_t {
     intr_handler_t isr;
     void *isr_arg;
     int source;
+#if CONFIG_ESP_INTR_STATS
+    intr_stats_t stats;
+#endif
 };
 
 static esp_err_t intr_free_for_current_cpu(intr_handle_t handle);
@@ -432,43 +457,101 @@ static int get_available_int(int flags, int cpu, int force, int source)
     return best;
 }
 
+#if CONFIG_ESP_INTR_STATS
+FORCE_INLINE_ATTR void intr_stats_record(intr_stats_t *stats, uint32_t cycles)
+{
+    // Buckets of a factor 4 each, the first one ends at 256 cycles
+    int bucket = (31 - __builtin_clz(cycles | 1) - 6) / 2;
+    bucket = (bucket < 0) ? 0 : (bucket >= ESP_INTR_STATS_HISTOGRAM_BUCKETS) ? ESP_INTR_STATS_HISTOGRAM_BUCKETS - 1 : bucket;
+
+    stats->count++;
+    stats->total_cycles += cycles;
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    stats->histogram[bucket]++;
+}
+#endif
+
 //Common shared isr handler. Chain-call all ISRs.
 static void IRAM_ATTR shared_intr_isr(void *arg)
 {
     vector_desc_t *vd = (vector_desc_t*)arg;
-    shared_vector_desc_t *sh_vec = vd->shared_vec_info;
     portENTER_CRITICAL_ISR(&spinlock);
-    while(sh_vec) {
+    shared_vector_desc_t **link = &vd->shared_vec_info;
+#if CONFIG_ESP_INTR_SHARED_SORT_BY_FREQUENCY
+    shared_vector_desc_t **prev_link = NULL;
+#endif
+    shared_vector_desc_t *sh_vec;
+    while ((sh_vec = *link) != NULL) {
         if (!sh_vec->disabled) {
             if ((sh_vec->statusreg == NULL) || (*sh_vec->statusreg & sh_vec->statusmask)) {
                 traceISR_ENTER(sh_vec->source + ETS_INTERNAL_INTR_SOURCE_OFF);
+#if CONFIG_ESP_INTR_STATS
+                esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+                sh_vec->isr(sh_vec->arg);
+                intr_stats_record(&sh_vec->stats, esp_cpu_get_cycle_count() - start);
+#else
                 sh_vec->isr(sh_vec->arg);
+#if INTR_COUNT_CALLS
+                sh_vec->stats.count++;
+#endif
+#endif
                 // check if we will return to scheduler or to interrupted task after ISR
                 if (!os_task_switch_is_pended(esp_cpu_get_core_id())) {
                     traceISR_EXIT();
                 }
+#if CONFIG_ESP_INTR_SHARED_SORT_BY_FREQUENCY
+                if (sh_vec->statusreg != NULL) {
+                    // Move the handler ahead of the previous one if it handles its interrupt more often. Over
+                    // time, this sorts the chain by frequency.
+                    if (prev_link && sh_vec->stats.count > (*prev_link)->stats.count) {
+                        shared_vector_desc_t *prev = *prev_link;
+                        prev->next = sh_vec->next;
+                        sh_vec->next = prev;
+                        *prev_link = sh_vec;
+                    }
+                    // The interrupt is level-triggered, so if another source of the chain is also active,
+                    // it will be raised again right after returning.
+                    break;
+                }
+#endif
             }
         }
-        sh_vec = sh_vec->next;
+#if CONFIG_ESP_INTR_SHARED_SORT_BY_FREQUENCY
+        prev_link = link;
+#endif
+        link = &sh_vec->next;
     }
     portEXIT_CRITICAL_ISR(&spinlock);
 }
 
-#if CONFIG_APPTRACE_SV_ENABLE
+#if INTR_NON_SHARED_WRAPPER
 //Common non-shared isr handler wrapper.
 static void IRAM_ATTR non_shared_intr_isr(void *arg)
 {
     non_shared_isr_arg_t *ns_isr_arg = (non_shared_isr_arg_t*)arg;
+#if CONFIG_APPTRACE_SV_ENABLE
     portENTER_CRITICAL_ISR(&spinlock);
     traceISR_ENTER(ns_isr_arg->source + ETS_INTERNAL_INTR_SOURCE_OFF);
+#endif
+#if CONFIG_ESP_INTR_STATS
+    esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+#endif
     // FIXME: can we call ISR and check os_task_switch_is_pended() after releasing spinlock?
     // when CONFIG_APPTRACE_SV_ENABLE = 0 ISRs for non-shared IRQs are called without spinlock
     ns_isr_arg->isr(ns_isr_arg->isr_arg);
+#if CONFIG_ESP_INTR_STATS
+    // Only the core the interrupt is allocated on writes the statistics
+    intr_stats_record(&ns_isr_arg->stats, esp_cpu_get_cycle_count() - start);
+#endif
+#if CONFIG_APPTRACE_SV_ENABLE
     // check if we will return to scheduler or to interrupted task after ISR
     if (!os_task_switch_is_pended(esp_cpu_get_core_id())) {
         traceISR_EXIT();
     }
     portEXIT_CRITICAL_ISR(&spinlock);
+#endif
 }
 #endif
 
@@ -591,8 +674,8 @@ esp_err_t esp_intr_alloc_intrstatus(int source, int flags, uint32_t intrstatusre
         //Mark as unusable for other interrupt sources. This is ours now!
         vd->flags = VECDESC_FL_NONSHARED;
         if (handler) {
-#if CONFIG_APPTRACE_SV_ENABLE
-            non_shared_isr_arg_t *ns_isr_arg = heap_caps_malloc(sizeof(non_shared_isr_arg_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#if INTR_NON_SHARED_WRAPPER
+            non_shared_isr_arg_t *ns_isr_arg = heap_caps_calloc(1, sizeof(non_shared_isr_arg_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
             if (!ns_isr_arg) {
                 portEXIT_CRITICAL(&spinlock);
                 free(ret);
@@ -601,6 +684,7 @@ esp_err_t esp_intr_alloc_intrstatus(int source, int flags, uint32_t intrstatusre
             ns_isr_arg->isr = handler;
             ns_isr_arg->isr_arg = arg;
             ns_isr_arg->source = source;
+            vd->non_shared_isr_arg = ns_isr_arg;
             esp_cpu_intr_set_handler(intr, (esp_cpu_intr_handler_t)non_shared_intr_isr, ns_isr_arg);
 #else
             esp_cpu_intr_set_handler(intr, (esp_cpu_intr_handler_t)handler, arg);
@@ -772,12 +856,10 @@ static esp_err_t intr_free_for_current_cpu(intr_handle_t handle)
 
     if ((handle->vector_desc->flags & VECDESC_FL_NONSHARED) || free_shared_vector) {
         ESP_EARLY_LOGV(TAG, "esp_intr_free: Disabling int, killing handler");
-#if CONFIG_APPTRACE_SV_ENABLE
+#if INTR_NON_SHARED_WRAPPER
         if (!free_shared_vector) {
-            void *isr_arg = esp_cpu_intr_get_handler_arg(handle->vector_desc->intno);
-            if (isr_arg) {
-                free(isr_arg);
-            }
+            free(handle->vector_desc->non_shared_isr_arg);
+            handle->vector_desc->non_shared_isr_arg = NULL;
         }
 #endif
         //Reset to normal handler:
@@ -1025,3 +1107,114 @@ esp_err_t esp_intr_dump(FILE *stream)
     fprintf(stream, "Shared interrupts: %d\n", shared_ints);
     return ESP_OK;
 }
+
+#if CONFIG_ESP_INTR_STATS
+typedef struct {
+    uint8_t cpu;
+    uint8_t intno;
+    bool shared;
+    int source;
+    esp_intr_stats_t stats;
+} intr_stats_dump_entry_t;
+
+static void intr_stats_copy(esp_intr_stats_t *dst, const intr_stats_t *src)
+{
+    dst->count = src->count;
+    dst->max_cycles = src->max_cycles;
+    dst->total_cycles = src->total_cycles;
+    memcpy(dst->histogram, src->histogram, sizeof(dst->histogram));
+}
+
+// Fill the entries with the statistics of all the handlers, return the total number of handlers
+static size_t intr_stats_collect(intr_stats_dump_entry_t *entries, size_t max_entries)
+{
+    size_t count = 0;
+    for (vector_desc_t *vd = vector_desc_head; vd != NULL; vd = vd->next) {
+        if (vd->flags & VECDESC_FL_SHARED) {
+            for (shared_vector_desc_t *svd = vd->shared_vec_info; svd != NULL; svd = svd->next) {
+                if (count < max_entries) {
+                    entries[count] = (intr_stats_dump_entry_t) {
+                        .cpu = vd->cpu, .intno = vd->intno, .shared = true, .source = svd->source,
+                    };
+                    intr_stats_copy(&entries[count].stats, &svd->stats);
+                }
+                count++;
+            }
+        } else if ((vd->flags & VECDESC_FL_NONSHARED) && vd->non_shared_isr_arg) {
+            if (count < max_entries) {
+                entries[count] = (intr_stats_dump_entry_t) {
+                    .cpu = vd->cpu, .intno = vd->intno, .shared = false, .source = vd->non_shared_isr_arg->source,
+                };
+                intr_stats_copy(&entries[count].stats, &vd->non_shared_isr_arg->stats);
+            }
+            count++;
+        }
+    }
+    return count;
+}
+#endif // CONFIG_ESP_INTR_STATS
+
+esp_err_t esp_intr_get_stats(intr_handle_t handle, esp_intr_stats_t *stats)
+{
+#if CONFIG_ESP_INTR_STATS
+    if (handle == NULL || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL_SAFE(&spinlock);
+    if (handle->shared_vector_desc) {
+        intr_stats_copy(stats, &handle->shared_vector_desc->stats);
+    } else if (handle->vector_desc->non_shared_isr_arg) {
+        intr_stats_copy(stats, &handle->vector_desc->non_shared_isr_arg->stats);
+    } else {
+        ret = ESP_ERR_INVALID_ARG;
+    }
+    portEXIT_CRITICAL_SAFE(&spinlock);
+    return ret;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t esp_intr_dump_stats(FILE *stream)
+{
+#if CONFIG_ESP_INTR_STATS
+    if (stream == NULL) {
+        stream = stdout;
+    }
+
+    // Count the handlers first, as the buffer can't be allocated in the critical section
+    portENTER_CRITICAL(&spinlock);
+    size_t count = intr_stats_collect(NULL, 0);
+    portEXIT_CRITICAL(&spinlock);
+
+    // Leave some room for handlers allocated in the meantime
+    const size_t max_entries = count + 4;
+    intr_stats_dump_entry_t *entries = heap_caps_calloc(max_entries, sizeof(intr_stats_dump_entry_t), MALLOC_CAP_DEFAULT);
+    if (entries == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    portENTER_CRITICAL(&spinlock);
+    count = intr_stats_collect(entries, max_entries);
+    portEXIT_CRITICAL(&spinlock);
+    count = MIN(count, max_entries);
+
+    fprintf(stream, "CPU Int  Source               Count       Avg cycles  Max cycles  <256     <1K      <4K      <16K     <64K     More\n");
+    for (size_t i = 0; i < count; i++) {
+        const intr_stats_dump_entry_t *e = &entries[i];
+        const char *name = (e->source >= 0) ? esp_isr_names[e->source] : "CPU-internal";
+        fprintf(stream, "%2d  %2d%c  %-20s %-11"PRIu32" %-11"PRIu32" %-11"PRIu32,
+                e->cpu, e->intno, e->shared ? '*' : ' ', name, e->stats.count,
+                e->stats.count ? (uint32_t)(e->stats.total_cycles / e->stats.count) : 0, e->stats.max_cycles);
+        for (int b = 0; b < ESP_INTR_STATS_HISTOGRAM_BUCKETS; b++) {
+            fprintf(stream, " %-8"PRIu32, e->stats.histogram[b]);
+        }
+        fprintf(stream, "\n");
+    }
+    fprintf(stream, "* shared interrupt, its handlers are listed in the order they are called\n");
+    free(entries);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
@@ -714,6 +714,126 @@ void * regdma_find_prev_module_link_tail(void *link, void *tail, int entry, uint
     return NULL;
 }
 
+void regdma_link_set_module_lazy_restore(void *link, void *tail, int entry, uint32_t module, bool lazy)
+{
+    assert(entry < REGDMA_LINK_ENTRY_NUM);
+
+    void *next = link;
+    if (link) {
+        do {
+            regdma_link_stats_t *stat = regdma_link_get_stats(next);
+            regdma_link_head_t *head = (regdma_link_head_t *)next;
+            /* Only the nodes that are exclusively used by this entry are deferred, the
+             * nodes skipped by REGDMA at restore time are left untouched */
+            if ((stat->module & module) && (stat->ref == BIT(entry))) {
+                if (lazy && !head->skip_r) {
+                    head->skip_r = 1;
+                    stat->lazy = 1;
+                } else if (!lazy && stat->lazy) {
+                    head->skip_r = 0;
+                    stat->lazy = 0;
+                }
+            }
+            if (next == tail) {
+                break;
+            }
+        } while ((next = regdma_link_get_next(next, entry)) != NULL);
+    }
+}
+
+#define REGDMA_LINK_CPU_WAIT_RETRY_COUNT    (1000)
+
+static uint32_t regdma_link_restore_by_cpu_wrapper(void *link)
+{
+    regdma_link_head_t head = REGDMA_LINK_HEAD(link);
+    void *instance = regdma_link_get_instance(link);
+    volatile uint32_t *restore = NULL, *mem = NULL, *map = NULL, *reg = NULL;
+    uint32_t value = 0, mask = 0;
+
+    switch (head.mode) {
+    case REGDMA_LINK_MODE_CONTINUOUS:
+        restore = head.branch ? (volatile uint32_t *)((regdma_link_branch_continuous_t *)instance)->body.restore
+                              : (volatile uint32_t *)((regdma_link_continuous_t *)instance)->body.restore;
+        mem     = head.branch ? (volatile uint32_t *)((regdma_link_branch_continuous_t *)instance)->body.mem
+                              : (volatile uint32_t *)((regdma_link_continuous_t *)instance)->body.mem;
+        for (int i = 0; i < head.length; i++) {
+            restore[i] = mem[i];
+        }
+        return head.length;
+    case REGDMA_LINK_MODE_ADDR_MAP:
+        restore = head.branch ? (volatile uint32_t *)((regdma_link_branch_addr_map_t *)instance)->body.restore
+                              : (volatile uint32_t *)((regdma_link_addr_map_t *)instance)->body.restore;
+        mem     = head.branch ? (volatile uint32_t *)((regdma_link_branch_addr_map_t *)instance)->body.mem
+                              : (volatile uint32_t *)((regdma_link_addr_map_t *)instance)->body.mem;
+        map     = head.branch ? ((regdma_link_branch_addr_map_t *)instance)->body.map
+                              : ((regdma_link_addr_map_t *)instance)->body.map;
+        for (int i = 0, n = 0; (i < 128) && (n < head.length); i++) {
+            if (map[i >> 5] & BIT(i & 0x1f)) {
+                restore[i] = mem[n++];
+            }
+        }
+        return head.length;
+    case REGDMA_LINK_MODE_WRITE:
+    case REGDMA_LINK_MODE_WAIT:
+        reg   = head.branch ? (volatile uint32_t *)((regdma_link_branch_write_wait_t *)instance)->body.backup
+                            : (volatile uint32_t *)((regdma_link_write_wait_t *)instance)->body.backup;
+        value = head.branch ? ((regdma_link_branch_write_wait_t *)instance)->body.value
+                            : ((regdma_link_write_wait_t *)instance)->body.value;
+        mask  = head.branch ? ((regdma_link_branch_write_wait_t *)instance)->body.mask
+                            : ((regdma_link_write_wait_t *)instance)->body.mask;
+        if (head.mode == REGDMA_LINK_MODE_WRITE) {
+            *reg = (*reg & ~mask) | (value & mask);
+        } else {
+            /* Same retry limit as the one REGDMA is configured with */
+            for (int retry = 0; (retry < REGDMA_LINK_CPU_WAIT_RETRY_COUNT) && ((*reg & mask) != (value & mask)); retry++);
+        }
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+uint32_t regdma_link_restore_by_cpu(void *link, void *tail, int entry, uint32_t module)
+{
+    assert(entry < REGDMA_LINK_ENTRY_NUM);
+
+    uint32_t words = 0;
+    void *next = link;
+    if (link) {
+        do {
+            regdma_link_stats_t *stat = regdma_link_get_stats(next);
+            if ((stat->module & module) && stat->lazy) {
+                words += regdma_link_restore_by_cpu_wrapper(next);
+            }
+            if (next == tail) {
+                break;
+            }
+        } while ((next = regdma_link_get_next(next, entry)) != NULL);
+    }
+    return words;
+}
+
+uint32_t regdma_link_get_module_restore_length(void *link, void *tail, int entry, uint32_t module)
+{
+    assert(entry < REGDMA_LINK_ENTRY_NUM);
+
+    uint32_t words = 0;
+    void *next = link;
+    if (link) {
+        do {
+            regdma_link_head_t head = REGDMA_LINK_HEAD(next);
+            regdma_link_stats_t *stat = regdma_link_get_stats(next);
+            if ((stat->module & module) && (!head.skip_r || stat->lazy)) {
+                words += (head.mode == REGDMA_LINK_MODE_WRITE || head.mode == REGDMA_LINK_MODE_WAIT) ? 1 : head.length;
+            }
+            if (next == tail) {
+                break;
+            }
+        } while ((next = regdma_link_get_next(next, entry)) != NULL);
+    }
+    return words;
+}
+
 static __attribute__((unused)) const char *TAG = "regdma_link";
 static const char* s_link_mode_str[] = { "CONTINUOUS", "ADDR_MAP", "WRITE", "WAIT" };
 static const char* s_boolean_str[] = { "false", "true" };
@@ -121,7 +121,7 @@
 #include "esp_private/sleep_clock.h"
 #endif
 
-#if SOC_PM_RETENTION_SW_TRIGGER_REGDMA
+#if SOC_PAU_SUPPORTED
 #include "esp_private/sleep_retention.h"
 #endif
 
@@ -1111,6 +1111,12 @@ static esp_err_t IRAM_ATTR esp_sleep_start(uint32_t pd_flags, esp_sleep_mode_t m
         if (pd_flags & PMU_SLEEP_PD_TOP) {
             sleep_retention_do_system_retention(false);
         }
+#endif
+#if SOC_PAU_SUPPORTED && CONFIG_PM_POWER_DOWN_PERIPHERAL_IN_LIGHT_SLEEP
+        if (pd_flags & PMU_SLEEP_PD_TOP) {
+            // The lazy modules were skipped by the REGDMA restore, they are restored later by the CPU
+            sleep_retention_set_lazy_modules_pending();
+        }
 #endif
         misc_modules_wake_prepare(pd_flags);
     }
@@ -1320,6 +1326,12 @@ esp_err_t esp_light_sleep_start(void)
     timerret = esp_task_wdt_stop();
 #endif // CONFIG_ESP_TASK_WDT_USE_ESP_TIMER
 
+#if SOC_PAU_SUPPORTED && CONFIG_PM_POWER_DOWN_PERIPHERAL_IN_LIGHT_SLEEP
+    /* The on-demand modules not accessed since the last wakeup must be restored before REGDMA
+     * backs up their context again */
+    sleep_retention_do_lazy_restore(true);
+#endif
+
     portENTER_CRITICAL(&s_config.lock);
     /*
     Note: We are about to stall the other CPU via the esp_ipc_isr_stall_other_cpu(). However, there is a chance of
@@ -1555,6 +1567,11 @@ esp_err_t esp_light_sleep_start(void)
     esp_sleep_execute_event_callbacks(SLEEP_EVENT_SW_EXIT_SLEEP, (void *)0);
     s_config.sleep_time_overhead_out = (esp_cpu_get_cycle_count() - s_config.ccount_ticks_record) / (esp_clk_cpu_freq() / 1000000ULL);
 
+#if SOC_PAU_SUPPORTED && CONFIG_PM_POWER_DOWN_PERIPHERAL_IN_LIGHT_SLEEP
+    // Restore the deferred modules once the critical wakeup work is done, it is not counted in the wakeup overhead
+    sleep_retention_do_lazy_restore(false);
+#endif
+
 #if CONFIG_ESP_SLEEP_DEBUG
     if (s_sleep_ctx != NULL) {
         s_sleep_ctx->sleep_request_result = err;
@@ -5,6 +5,7 @@
  */
 
 #include <stddef.h>
+#include <inttypes.h>
 #include <string.h>
 #include <sys/lock.h>
 #include <sys/param.h>
@@ -14,6 +15,9 @@
 #include "esp_log.h"
 #include "esp_heap_caps.h"
 #include "esp_sleep.h"
+#include "esp_cpu.h"
+#include "esp_private/esp_clk.h"
+#include "freertos/FreeRTOS.h"
 #include "soc/soc_caps.h"
 #include "esp_private/esp_regdma.h"
 #include "esp_private/esp_pau.h"
@@ -36,6 +40,8 @@ struct sleep_retention_module_object {
     sleep_retention_module_bitmap_t    references;  /* A bitmap indicating all other modules that depend on (or reference) the current module,
                                                      * It will update at runtime based on whether the module is referenced by other modules */
     sleep_retention_module_attribute_t attributes;  /* A bitmap indicating attribute of the current module */
+    regdma_link_priority_t             priority;    /* The highest REGDMA link priority that the module context is created with */
+    sleep_retention_module_stats_t     stats;       /* The restore statistics of the current module */
 };
 
 static inline void sleep_retention_module_object_ctor(struct sleep_retention_module_object * const self, sleep_retention_module_callbacks_t *cbs)
@@ -44,6 +50,8 @@ static inline void sleep_retention_module_object_ctor(struct sleep_retention_mod
     self->dependents = 0;
     self->references = 0;
     self->attributes = 0;
+    self->priority = 0;
+    memset(&self->stats, 0, sizeof(self->stats));
 }
 
 static inline void sleep_retention_module_object_dtor(struct sleep_retention_module_object * const self)
@@ -189,6 +197,9 @@ typedef struct {
     regdma_link_priority_t highpri;
     uint32_t inited_modules;
     uint32_t created_modules;
+    uint32_t lazy_modules;      /* modules whose context is restored by the CPU instead of REGDMA on wakeup */
+    uint32_t on_demand_modules; /* lazy modules which are only restored when they are accessed first */
+    uint32_t pending_modules;   /* lazy modules whose context has not been restored since the last wakeup */
 
     struct sleep_retention_module_object instance[32];
 
@@ -196,14 +207,23 @@ typedef struct {
 } sleep_retention_t;
 
 static DRAM_ATTR __attribute__((unused)) sleep_retention_t s_retention = {
-    .highpri = (uint8_t)-1, .inited_modules = 0, .created_modules = 0
+    .highpri = (uint8_t)-1, .inited_modules = 0, .created_modules = 0, .lazy_modules = 0, .on_demand_modules = 0, .pending_modules = 0
 };
 
+/* Protects the pending_modules bitmap, which is updated by the sleep procedure and by the drivers */
+static portMUX_TYPE s_lazy_restore_lock = portMUX_INITIALIZER_UNLOCKED;
+
 #define SLEEP_RETENTION_ENTRY_BITMAP_MASK       (BIT(REGDMA_LINK_ENTRY_NUM) - 1)
 #define SLEEP_RETENTION_ENTRY_BITMAP(bitmap)    ((bitmap) & SLEEP_RETENTION_ENTRY_BITMAP_MASK)
 
 static esp_err_t sleep_retention_entries_create_impl(const sleep_retention_entries_config_t retent[], int num, regdma_link_priority_t priority, sleep_retention_module_t module);
 static void sleep_retention_entries_join(void);
+static void sleep_retention_entries_set_lazy_restore(sleep_retention_module_t module, bool lazy);
+
+static inline bool module_is_lazy(sleep_retention_module_t module)
+{
+    return (s_retention.lazy_modules & BIT(module)) ? true : false;
+}
 
 static inline sleep_retention_module_bitmap_t module_num2map(sleep_retention_module_t module)
 {
@@ -467,6 +487,9 @@ static void sleep_retention_entries_all_destroy_wrapper(sleep_retention_module_t
         }
     } while (priority < SLEEP_RETENTION_REGDMA_LINK_NR_PRIORITIES);
     s_retention.created_modules &= ~module_num2map(module);
+    portENTER_CRITICAL(&s_lazy_restore_lock);
+    s_retention.pending_modules &= ~module_num2map(module);
+    portEXIT_CRITICAL(&s_lazy_restore_lock);
     _lock_release_recursive(&s_retention.lock);
 }
 
@@ -591,8 +614,12 @@ static esp_err_t sleep_retention_entries_create_wrapper(const sleep_retention_en
     if(err) goto error;
     err = sleep_retention_entries_create_bonding(priority, module);
     if(err) goto error;
+    s_retention.instance[module].priority = module_is_created(module) ? MIN(s_retention.instance[module].priority, priority) : priority;
     s_retention.created_modules |= module_num2map(module);
     sleep_retention_entries_join();
+    if (module_is_lazy(module)) {
+        sleep_retention_entries_set_lazy_restore(module, true);
+    }
 
 error:
     _lock_release_recursive(&s_retention.lock);
@@ -642,6 +669,159 @@ uint32_t IRAM_ATTR sleep_retention_get_created_modules(void)
     return s_retention.created_modules;
 }
 
+static void sleep_retention_entries_set_lazy_restore(sleep_retention_module_t module, bool lazy)
+{
+    _lock_acquire_recursive(&s_retention.lock);
+    if (s_retention.highpri >= SLEEP_RETENTION_REGDMA_LINK_HIGHEST_PRIORITY &&
+        s_retention.highpri <= SLEEP_RETENTION_REGDMA_LINK_LOWEST_PRIORITY) {
+        /* The node references are used to find out the nodes only used by the wakeup restore of entry 0 */
+        sleep_retention_entries_stats();
+        regdma_link_set_module_lazy_restore(s_retention.lists[s_retention.highpri].entries[0], NULL, 0, module_num2map(module), lazy);
+    }
+    _lock_release_recursive(&s_retention.lock);
+}
+
+static void sleep_retention_module_do_restore(sleep_retention_module_t module)
+{
+    uint32_t start = esp_cpu_get_cycle_count();
+    uint32_t words = regdma_link_restore_by_cpu(s_retention.lists[s_retention.highpri].entries[0], NULL, 0, module_num2map(module));
+    uint32_t restore_us = (esp_cpu_get_cycle_count() - start) / (esp_clk_cpu_freq() / 1000000);
+
+    sleep_retention_module_stats_t *stats = &s_retention.instance[module].stats;
+    stats->lazy_words = words;
+    stats->restore_count++;
+    stats->last_restore_us = restore_us;
+    stats->max_restore_us = MAX(stats->max_restore_us, restore_us);
+    stats->total_restore_us += restore_us;
+}
+
+static bool sleep_retention_module_take_pending(sleep_retention_module_t module)
+{
+    portENTER_CRITICAL_SAFE(&s_lazy_restore_lock);
+    bool pending = (s_retention.pending_modules & BIT(module)) ? true : false;
+    s_retention.pending_modules &= ~BIT(module);
+    portEXIT_CRITICAL_SAFE(&s_lazy_restore_lock);
+    return pending;
+}
+
+esp_err_t sleep_retention_module_set_restore_mode(sleep_retention_module_t module, sleep_retention_restore_mode_t mode)
+{
+    if (module < SLEEP_RETENTION_MODULE_MIN || module > SLEEP_RETENTION_MODULE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (mode > SLEEP_RETENTION_RESTORE_ON_DEMAND) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = ESP_OK;
+    bool lazy = (mode != SLEEP_RETENTION_RESTORE_BY_REGDMA);
+    _lock_acquire_recursive(&s_retention.lock);
+    if (!module_is_inited(module)) {
+        err = ESP_ERR_INVALID_STATE;
+    } else if (module_is_passive(&s_retention.instance[module])) {
+        /* Other modules depend on the passive modules, they must be restored before anything else */
+        err = ESP_ERR_NOT_ALLOWED;
+    } else {
+        if (module_is_created(module) && (lazy != module_is_lazy(module))) {
+            if (!lazy && sleep_retention_module_take_pending(module)) {
+                sleep_retention_module_do_restore(module);
+            }
+            sleep_retention_entries_set_lazy_restore(module, lazy);
+        }
+        if (lazy) {
+            s_retention.lazy_modules |= module_num2map(module);
+        } else {
+            s_retention.lazy_modules &= ~module_num2map(module);
+        }
+        if (mode == SLEEP_RETENTION_RESTORE_ON_DEMAND) {
+            s_retention.on_demand_modules |= module_num2map(module);
+        } else {
+            s_retention.on_demand_modules &= ~module_num2map(module);
+        }
+    }
+    _lock_release_recursive(&s_retention.lock);
+    return err;
+}
+
+esp_err_t sleep_retention_module_restore(sleep_retention_module_t module)
+{
+    if (module < SLEEP_RETENTION_MODULE_MIN || module > SLEEP_RETENTION_MODULE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    _lock_acquire_recursive(&s_retention.lock);
+    if (sleep_retention_module_take_pending(module)) {
+        sleep_retention_module_do_restore(module);
+    }
+    _lock_release_recursive(&s_retention.lock);
+    return ESP_OK;
+}
+
+void IRAM_ATTR sleep_retention_set_lazy_modules_pending(void)
+{
+    portENTER_CRITICAL_SAFE(&s_lazy_restore_lock);
+    s_retention.pending_modules = s_retention.lazy_modules & s_retention.created_modules;
+    portEXIT_CRITICAL_SAFE(&s_lazy_restore_lock);
+}
+
+void sleep_retention_do_lazy_restore(bool on_demand)
+{
+    /* Called by the sleep procedure, maybe in a critical section, the retention lock can't be taken here */
+    uint32_t deferred_modules = s_retention.pending_modules & (on_demand ? UINT32_MAX : ~s_retention.on_demand_modules);
+    if (deferred_modules == 0) {
+        return;
+    }
+    /* Modules of higher REGDMA link priority are restored first, the same order as REGDMA does */
+    for (regdma_link_priority_t priority = 0; priority < SLEEP_RETENTION_REGDMA_LINK_NR_PRIORITIES; priority++) {
+        for (sleep_retention_module_t module = SLEEP_RETENTION_MODULE_MIN; module <= SLEEP_RETENTION_MODULE_MAX; module++) {
+            if ((deferred_modules & BIT(module)) && (s_retention.instance[module].priority == priority)) {
+                if (sleep_retention_module_take_pending(module)) {
+                    sleep_retention_module_do_restore(module);
+                }
+            }
+        }
+    }
+}
+
+esp_err_t sleep_retention_module_get_stats(sleep_retention_module_t module, sleep_retention_module_stats_t *stats)
+{
+    if (module < SLEEP_RETENTION_MODULE_MIN || module > SLEEP_RETENTION_MODULE_MAX || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = ESP_OK;
+    _lock_acquire_recursive(&s_retention.lock);
+    if (module_is_inited(module)) {
+        *stats = s_retention.instance[module].stats;
+        stats->context_words = 0;
+        if (module_is_created(module)) {
+            stats->context_words = regdma_link_get_module_restore_length(s_retention.lists[s_retention.highpri].entries[0], NULL, 0, module_num2map(module));
+        }
+    } else {
+        err = ESP_ERR_INVALID_STATE;
+    }
+    _lock_release_recursive(&s_retention.lock);
+    return err;
+}
+
+void sleep_retention_dump_modules(FILE *out)
+{
+    _lock_acquire_recursive(&s_retention.lock);
+    fprintf(out, "\n%-8s %-6s %-4s %-8s %-8s %-8s %-8s %-8s %-8s\n", "module", "state", "pri", "words", "cpu", "count", "last/us", "max/us", "avg/us");
+    for (sleep_retention_module_t module = SLEEP_RETENTION_MODULE_MIN; module <= SLEEP_RETENTION_MODULE_MAX; module++) {
+        sleep_retention_module_stats_t stats;
+        if (!module_is_created(module) || sleep_retention_module_get_stats(module, &stats) != ESP_OK) {
+            continue;
+        }
+        fprintf(out, "%-8d %-6s %-4d %-8"PRIu32" %-8"PRIu32" %-8"PRIu32" %-8"PRIu32" %-8"PRIu32" %-8"PRIu32"\n",
+                module, !module_is_lazy(module) ? "regdma" : (s_retention.on_demand_modules & BIT(module)) ? "demand" : "defer", s_retention.instance[module].priority, stats.context_words,
+                stats.lazy_words, stats.restore_count, stats.last_restore_us, stats.max_restore_us,
+                stats.restore_count ? (uint32_t)(stats.total_restore_us / stats.restore_count) : 0);
+    }
+    fflush(out);
+    _lock_release_recursive(&s_retention.lock);
+}
+
 esp_err_t sleep_retention_module_init(sleep_retention_module_t module, sleep_retention_module_init_param_t *param)
 {
     if (module < SLEEP_RETENTION_MODULE_MIN || module > SLEEP_RETENTION_MODULE_MAX) {
@@ -689,6 +869,8 @@ esp_err_t sleep_retention_module_deinit(sleep_retention_module_t module)
     } else {
         clr_attributes(&s_retention.instance[module]);
         clr_dependencies(&s_retention.instance[module]);
+        s_retention.lazy_modules &= ~module_num2map(module);
+        s_retention.on_demand_modules &= ~module_num2map(module);
         sleep_retention_module_object_dtor(&s_retention.instance[module]);
         s_retention.inited_modules &= ~module_num2map(module);
         do_lock_release = (sleep_retention_get_inited_modules() == 0);
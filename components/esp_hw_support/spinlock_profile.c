@@ -0,0 +1,224 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_spinlock_profile.h"
+#include "spinlock.h"
+#if __XTENSA__
+#include "esp_cpu_utils.h"
+#endif
+
+#if CONFIG_ESP_SPINLOCK_PROFILING
+
+/*
+ * The statistics are kept in a table indexed by the address of the lock, rather than in spinlock_t, so that
+ * the size of portMUX_TYPE, which is also used by the precompiled libraries, doesn't change. A lock claims its
+ * entry the first time it is taken, with a compare-and-set on the key. After that, the entry is only written
+ * by the core holding the lock, so the statistics need no lock of their own.
+ */
+
+#define SPINLOCK_PROFILE_MAX_LOCKS  CONFIG_ESP_SPINLOCK_PROFILING_MAX_LOCKS
+
+typedef struct {
+    uint32_t lock;              // address of the lock, 0 if the entry is free
+    uint32_t acquire_count;
+    uint32_t contended_count;
+    uint32_t max_spin_cycles;
+    uint64_t spin_cycles;
+    uint32_t max_hold_cycles;
+    uint32_t hold_start;
+    void *caller;               // caller of the current owner
+    void *max_hold_caller;
+} spinlock_profile_slot_t;
+
+static spinlock_profile_slot_t s_slots[SPINLOCK_PROFILE_MAX_LOCKS];
+static uint32_t s_dropped;      // acquisitions of the locks which didn't get an entry
+
+FORCE_INLINE_ATTR spinlock_profile_slot_t *find_slot(spinlock_t *lock, bool claim)
+{
+    const uint32_t key = (uint32_t)lock;
+    uint32_t index = ((key >> 2) * 2654435761U) % SPINLOCK_PROFILE_MAX_LOCKS;
+
+    for (int i = 0; i < SPINLOCK_PROFILE_MAX_LOCKS; i++) {
+        spinlock_profile_slot_t *slot = &s_slots[index];
+        uint32_t slot_key = slot->lock;
+        if (slot_key == key) {
+            return slot;
+        }
+        if (slot_key == 0) {
+            if (!claim) {
+                return NULL;
+            }
+            // the other core may claim the same entry for another lock at the same time
+            if (esp_cpu_compare_and_set(&slot->lock, 0, key) || slot->lock == key) {
+                return slot;
+            }
+        }
+        index = (index + 1 == SPINLOCK_PROFILE_MAX_LOCKS) ? 0 : index + 1;
+    }
+    return NULL;
+}
+
+void IRAM_ATTR spinlock_profile_acquired(spinlock_t *lock, uint32_t spin_cycles, void *caller)
+{
+    spinlock_profile_slot_t *slot = find_slot(lock, true);
+    if (!slot) {
+        uint32_t dropped;
+        do {
+            dropped = s_dropped;
+        } while (!esp_cpu_compare_and_set(&s_dropped, dropped, dropped + 1));
+        return;
+    }
+
+    slot->acquire_count++;
+    if (spin_cycles) {
+        slot->contended_count++;
+        slot->spin_cycles += spin_cycles;
+        if (spin_cycles > slot->max_spin_cycles) {
+            slot->max_spin_cycles = spin_cycles;
+        }
+    }
+    slot->caller = caller;
+    slot->hold_start = esp_cpu_get_cycle_count();
+}
+
+void IRAM_ATTR spinlock_profile_released(spinlock_t *lock)
+{
+    spinlock_profile_slot_t *slot = find_slot(lock, false);
+    if (!slot) {
+        return;
+    }
+
+    uint32_t hold_cycles = esp_cpu_get_cycle_count() - slot->hold_start;
+    if (hold_cycles > slot->max_hold_cycles) {
+        slot->max_hold_cycles = hold_cycles;
+        slot->max_hold_caller = slot->caller;
+    }
+}
+
+static const void *caller_pc(const void *caller)
+{
+#if __XTENSA__
+    return caller ? (const void *)esp_cpu_process_stack_pc((uint32_t)caller) : NULL;
+#else
+    return caller;
+#endif
+}
+
+static int compare_spin_cycles(const void *a, const void *b)
+{
+    const esp_spinlock_profile_entry_t *ea = a;
+    const esp_spinlock_profile_entry_t *eb = b;
+    if (ea->spin_cycles != eb->spin_cycles) {
+        return (ea->spin_cycles < eb->spin_cycles) ? 1 : -1;
+    }
+    return (ea->acquire_count < eb->acquire_count) ? 1 : (ea->acquire_count > eb->acquire_count) ? -1 : 0;
+}
+
+esp_err_t esp_spinlock_profile_get(esp_spinlock_profile_entry_t *entries, size_t max_entries, size_t *num_entries)
+{
+    if (!entries || !num_entries) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_spinlock_profile_entry_t *all = heap_caps_malloc(sizeof(esp_spinlock_profile_entry_t) * SPINLOCK_PROFILE_MAX_LOCKS, MALLOC_CAP_DEFAULT);
+    if (!all) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // the entries are read while the other core may update them, each one is consistent enough for a report
+    size_t count = 0;
+    for (int i = 0; i < SPINLOCK_PROFILE_MAX_LOCKS; i++) {
+        const spinlock_profile_slot_t *slot = &s_slots[i];
+        if (slot->lock == 0 || slot->acquire_count == 0) {
+            continue;
+        }
+        all[count++] = (esp_spinlock_profile_entry_t) {
+            .lock = (const void *)slot->lock,
+            .acquire_count = slot->acquire_count,
+            .contended_count = slot->contended_count,
+            .spin_cycles = slot->spin_cycles,
+            .max_spin_cycles = slot->max_spin_cycles,
+            .max_hold_cycles = slot->max_hold_cycles,
+            .max_hold_caller = caller_pc(slot->max_hold_caller),
+        };
+    }
+    qsort(all, count, sizeof(esp_spinlock_profile_entry_t), compare_spin_cycles);
+
+    *num_entries = (count < max_entries) ? count : max_entries;
+    memcpy(entries, all, *num_entries * sizeof(esp_spinlock_profile_entry_t));
+    free(all);
+    return ESP_OK;
+}
+
+esp_err_t esp_spinlock_profile_dump(FILE *stream)
+{
+    esp_spinlock_profile_entry_t *entries = heap_caps_malloc(sizeof(esp_spinlock_profile_entry_t) * SPINLOCK_PROFILE_MAX_LOCKS, MALLOC_CAP_DEFAULT);
+    if (!entries) {
+        return ESP_ERR_NO_MEM;
+    }
+    size_t count = 0;
+    esp_err_t err = esp_spinlock_profile_get(entries, SPINLOCK_PROFILE_MAX_LOCKS, &count);
+    if (err != ESP_OK) {
+        free(entries);
+        return err;
+    }
+
+    fprintf(stream, "Lock        Acquired    Contended   Spin cycles     Max spin    Max hold    Max hold caller\n");
+    for (size_t i = 0; i < count; i++) {
+        const esp_spinlock_profile_entry_t *e = &entries[i];
+        fprintf(stream, "%p  %-10" PRIu32 "  %-10" PRIu32 "  %-14" PRIu64 "  %-10" PRIu32 "  %-10" PRIu32 "  %p\n",
+                e->lock, e->acquire_count, e->contended_count, e->spin_cycles,
+                e->max_spin_cycles, e->max_hold_cycles, e->max_hold_caller);
+    }
+    if (s_dropped) {
+        fprintf(stream, "%" PRIu32 " acquisitions not profiled, increase CONFIG_ESP_SPINLOCK_PROFILING_MAX_LOCKS\n", s_dropped);
+    }
+    free(entries);
+    return ESP_OK;
+}
+
+esp_err_t esp_spinlock_profile_reset(void)
+{
+    for (int i = 0; i < SPINLOCK_PROFILE_MAX_LOCKS; i++) {
+        spinlock_profile_slot_t *slot = &s_slots[i];
+        // keep the key, the lock may be held right now
+        slot->acquire_count = 0;
+        slot->contended_count = 0;
+        slot->max_spin_cycles = 0;
+        slot->spin_cycles = 0;
+        slot->max_hold_cycles = 0;
+        slot->max_hold_caller = NULL;
+    }
+    s_dropped = 0;
+    return ESP_OK;
+}
+
+#else // CONFIG_ESP_SPINLOCK_PROFILING
+
+esp_err_t esp_spinlock_profile_get(esp_spinlock_profile_entry_t *entries, size_t max_entries, size_t *num_entries)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_spinlock_profile_dump(FILE *stream)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_spinlock_profile_reset(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // CONFIG_ESP_SPINLOCK_PROFILING
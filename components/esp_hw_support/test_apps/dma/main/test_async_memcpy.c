@@ -222,6 +222,108 @@ TEST_CASE("memory copy done callback", "[async mcp]")
     vSemaphoreDelete(sem);
 }
 
+#if SOC_AHB_GDMA_SUPPORTED
+TEST_CASE("memory copy batch of segments", "[async mcp]")
+{
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    async_memcpy_handle_t driver = NULL;
+    TEST_ESP_OK(esp_async_memcpy_install_gdma_ahb(&config, &driver));
+
+    const size_t seg_size = 1024;
+    const size_t num_segs = 4;
+    uint8_t *src_buf = heap_caps_aligned_calloc(64, 1, seg_size * num_segs, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    uint8_t *dst_buf = heap_caps_aligned_calloc(64, 1, seg_size * num_segs, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(src_buf);
+    TEST_ASSERT_NOT_NULL(dst_buf);
+    for (size_t i = 0; i < seg_size * num_segs; i++) {
+        src_buf[i] = i % 251;
+    }
+
+    // copy the segments in the reverse order, to check each one lands in the right place
+    async_memcpy_segment_t segments[4];
+    for (size_t i = 0; i < num_segs; i++) {
+        segments[i].dst = dst_buf + (num_segs - 1 - i) * seg_size;
+        segments[i].src = src_buf + i * seg_size;
+        segments[i].size = seg_size;
+    }
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    TEST_ESP_OK(esp_async_memcpy_batch(driver, segments, num_segs, test_async_memcpy_cb_v1, sem));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(sem, pdMS_TO_TICKS(1000)));
+    // only one callback for the whole batch
+    TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(sem, pdMS_TO_TICKS(10)));
+    for (size_t i = 0; i < num_segs; i++) {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(src_buf + i * seg_size, dst_buf + (num_segs - 1 - i) * seg_size, seg_size);
+    }
+
+    TEST_ESP_OK(esp_async_memcpy_uninstall(driver));
+    free(src_buf);
+    free(dst_buf);
+    vSemaphoreDelete(sem);
+}
+
+TEST_CASE("memory copy 2D block", "[async mcp]")
+{
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    async_memcpy_handle_t driver = NULL;
+    TEST_ESP_OK(esp_async_memcpy_install_gdma_ahb(&config, &driver));
+
+    // copy a 128x16 block out of a 256 bytes wide source into a 192 bytes wide destination
+    const size_t src_stride = 256;
+    const size_t dst_stride = 192;
+    const size_t width = 128;
+    const size_t height = 16;
+    uint8_t *src_buf = heap_caps_aligned_calloc(64, 1, src_stride * height, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    uint8_t *dst_buf = heap_caps_aligned_calloc(64, 1, dst_stride * height, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(src_buf);
+    TEST_ASSERT_NOT_NULL(dst_buf);
+    for (size_t i = 0; i < src_stride * height; i++) {
+        src_buf[i] = i % 253;
+    }
+    memset(dst_buf, 0xA5, dst_stride * height);
+
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    TEST_ESP_OK(esp_async_memcpy_2d(driver, dst_buf, dst_stride, src_buf + 64, src_stride, width, height, test_async_memcpy_cb_v1, sem));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(sem, pdMS_TO_TICKS(1000)));
+    for (size_t y = 0; y < height; y++) {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(src_buf + y * src_stride + 64, dst_buf + y * dst_stride, width);
+        // the gap between the destination rows stays untouched
+        for (size_t x = width; x < dst_stride; x++) {
+            TEST_ASSERT_EQUAL_HEX8(0xA5, dst_buf[y * dst_stride + x]);
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_async_memcpy_2d(driver, dst_buf, width - 4, src_buf, src_stride, width, height, NULL, NULL));
+
+    TEST_ESP_OK(esp_async_memcpy_uninstall(driver));
+    free(src_buf);
+    free(dst_buf);
+    vSemaphoreDelete(sem);
+}
+
+TEST_CASE("memory set by DMA", "[async mcp]")
+{
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    async_memcpy_handle_t driver = NULL;
+    TEST_ESP_OK(esp_async_memcpy_install_gdma_ahb(&config, &driver));
+
+    // bigger than a single DMA descriptor can carry, so the pattern buffer is reused
+    const size_t buffer_size = 8192;
+    uint8_t *dst_buf = heap_caps_aligned_calloc(64, 1, buffer_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(dst_buf);
+
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    const uint8_t values[] = {0x00, 0x5A, 0xFF};
+    for (int i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        TEST_ESP_OK(esp_async_memset(driver, dst_buf, values[i], buffer_size, test_async_memcpy_cb_v1, sem));
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(sem, pdMS_TO_TICKS(1000)));
+        TEST_ASSERT_EACH_EQUAL_HEX8(values[i], dst_buf, buffer_size);
+    }
+
+    TEST_ESP_OK(esp_async_memcpy_uninstall(driver));
+    free(dst_buf);
+    vSemaphoreDelete(sem);
+}
+#endif // SOC_AHB_GDMA_SUPPORTED
+
 TEST_CASE("memory copy by DMA on the fly", "[async mcp]")
 {
     async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
@@ -514,3 +514,57 @@ TEST_CASE("GDMA M2M Unaligned RX Buffer Test", "[GDMA][M2M]")
     free(sbuf);
     free(dbuf);
 }
+
+TEST_CASE("GDMA link list remount", "[GDMA]")
+{
+    gdma_link_list_handle_t link_list = NULL;
+    gdma_link_list_config_t link_list_config = {
+        .buffer_alignment = 4,
+        .item_alignment = 8, // 8-byte alignment required by the AXI-GDMA
+        .num_items = 4,
+        .flags = {
+            .check_owner = true,
+        },
+    };
+    TEST_ESP_OK(gdma_new_link_list(&link_list_config, &link_list));
+
+    // a buffer that spans 2 list items
+    const size_t buf_size = 6000;
+    uint8_t *buf0 = heap_caps_aligned_calloc(4, 1, buf_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    uint8_t *buf1 = heap_caps_aligned_calloc(4, 1, buf_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(buf0);
+    TEST_ASSERT_NOT_NULL(buf1);
+    gdma_buffer_mount_config_t mount_config = {
+        .buffer = buf0,
+        .length = buf_size,
+        .flags = {
+            .mark_eof = true,
+            .mark_final = true,
+        },
+    };
+    uint32_t end_item_index = 0;
+    TEST_ESP_OK(gdma_link_mount_buffers(link_list, 0, &mount_config, 1, &end_item_index));
+    TEST_ASSERT_EQUAL(1, end_item_index);
+
+    // pretend the DMA has consumed the items
+    TEST_ESP_OK(gdma_link_set_owner(link_list, 0, GDMA_LLI_OWNER_CPU));
+    TEST_ESP_OK(gdma_link_set_owner(link_list, 1, GDMA_LLI_OWNER_CPU));
+
+    // re-mount another buffer with the same length, the items are given back to the DMA
+    end_item_index = 0;
+    TEST_ESP_OK(gdma_link_remount_buffer(link_list, 0, buf1, buf_size, &end_item_index));
+    TEST_ASSERT_EQUAL(1, end_item_index);
+    gdma_lli_owner_t owner = GDMA_LLI_OWNER_CPU;
+    TEST_ESP_OK(gdma_link_get_owner(link_list, 0, &owner));
+    TEST_ASSERT_EQUAL(GDMA_LLI_OWNER_DMA, owner);
+    TEST_ESP_OK(gdma_link_get_owner(link_list, 1, &owner));
+    TEST_ASSERT_EQUAL(GDMA_LLI_OWNER_DMA, owner);
+
+    // the length must match the previous mount
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, gdma_link_remount_buffer(link_list, 0, buf1, 100, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, gdma_link_remount_buffer(link_list, 0, buf1 + 1, buf_size, NULL));
+
+    TEST_ESP_OK(gdma_del_link_list(link_list));
+    free(buf0);
+    free(buf1);
+}
@@ -53,6 +53,11 @@ esp_err_t dma2d_m2m_deinit(void)
     return dma2d_release_pool(dma2d_pool_handle);
 }
 
+esp_err_t dma2d_m2m_get_stats(dma2d_client_stats_t *stats)
+{
+    return dma2d_get_client_stats(dma2d_pool_handle, DMA2D_CLIENT_UNKNOWN, stats, true);
+}
+
 static bool DMA2D_M2M_ATTR dma2d_m2m_transaction_done_cb(dma2d_channel_handle_t dma2d_chan, dma2d_event_data_t *event_data, void *user_data)
 {
     bool need_yield = false;
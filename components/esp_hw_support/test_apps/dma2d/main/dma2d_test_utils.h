@@ -23,6 +23,13 @@ esp_err_t dma2d_m2m_init(void);
  */
 esp_err_t dma2d_m2m_deinit(void);
 
+/**
+ * @brief Get the statistics of the memcopy transactions since the previous call
+ *
+ * @param stats Returned statistics
+ */
+esp_err_t dma2d_m2m_get_stats(dma2d_client_stats_t *stats);
+
 /**
  * @brief Callback function when a memcopy operation is done
  *
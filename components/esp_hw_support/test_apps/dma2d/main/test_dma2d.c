@@ -5,6 +5,7 @@
  */
 
 #include <string.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <sys/param.h>
 #include "unity.h"
@@ -94,6 +95,8 @@ TEST_CASE("DMA2D_M2M_1D_basic", "[DMA2D]")
     };
 
     SemaphoreHandle_t counting_sem = xSemaphoreCreateCounting(M2M_TRANS_TIMES, 0);
+    dma2d_client_stats_t stats;
+    TEST_ESP_OK(dma2d_m2m_get_stats(&stats)); // discard the statistics of previous tests
 
     // Preparation
     for (int i = 0; i < M2M_TRANS_TIMES; i++) {
@@ -142,6 +145,13 @@ TEST_CASE("DMA2D_M2M_1D_basic", "[DMA2D]")
     }
     printf("All transactions done!\n");
 
+    // Channels are freed before the EOF callback, so all transactions are accounted at this point
+    TEST_ESP_OK(dma2d_m2m_get_stats(&stats));
+    printf("busy %" PRIu64 " us, wait %" PRIu64 " us (max %" PRIu32 " us)\n", stats.busy_time_us, stats.wait_time_us, stats.max_wait_time_us);
+    TEST_ASSERT_EQUAL_UINT32(M2M_TRANS_TIMES, stats.trans_count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.deadline_miss_count);
+    TEST_ASSERT_GREATER_THAN(0, stats.busy_time_us);
+
     // Check result
     for (int i = 0; i < M2M_TRANS_TIMES; i++) {
         prtx = tx_buf + i * data_size;
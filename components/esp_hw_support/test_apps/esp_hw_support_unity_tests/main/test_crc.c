@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_random.h"
+#include "esp_crc.h"
+
+TEST_CASE("esp_crc matches the ROM CRC for any length and alignment", "[crc]")
+{
+    static uint8_t buf[2048 + 8];
+    esp_fill_random(buf, sizeof(buf));
+
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, esp_crc32_le(0, (const uint8_t *)"123456789", 9));
+
+    const uint32_t lengths[] = {0, 1, 7, 8, 63, 64, 65, 100, 512, 1023, 2048};
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        for (size_t off = 0; off < 8; off++) {
+            uint32_t len = lengths[i];
+            TEST_ASSERT_EQUAL_HEX32(esp_rom_crc32_le(0, buf + off, len), esp_crc32_le(0, buf + off, len));
+            TEST_ASSERT_EQUAL_HEX32(esp_rom_crc32_le(0x12345678, buf + off, len), esp_crc32_le(0x12345678, buf + off, len));
+            TEST_ASSERT_EQUAL_HEX16(esp_rom_crc16_be(UINT16_MAX, buf + off, len), esp_crc16_be(UINT16_MAX, buf + off, len));
+            TEST_ASSERT_EQUAL_HEX16(esp_rom_crc16_be(0, buf + off, len), esp_crc16_be(0, buf + off, len));
+        }
+    }
+
+    // a CRC calculated in pieces matches the CRC of the whole buffer
+    uint32_t crc = esp_crc32_le(0, buf, 700);
+    crc = esp_crc32_le(crc, buf + 700, 1348);
+    TEST_ASSERT_EQUAL_HEX32(esp_rom_crc32_le(0, buf, 2048), crc);
+}
@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_random.h"
+#include "esp_fast_mem.h"
+#include "soc/soc_caps.h"
+
+#define TEST_FAST_MEM_BUF_SIZE  (16 * 1024)
+
+static void test_fast_mem_sizes(void)
+{
+    // the guard bytes around the destination are checked to catch overruns of the aligned body
+    uint8_t *src = heap_caps_malloc(TEST_FAST_MEM_BUF_SIZE, MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+    uint8_t *dst = heap_caps_malloc(TEST_FAST_MEM_BUF_SIZE + 64, MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+    uint8_t *ref = heap_caps_malloc(TEST_FAST_MEM_BUF_SIZE + 64, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(dst);
+    TEST_ASSERT_NOT_NULL(ref);
+    esp_fill_random(src, TEST_FAST_MEM_BUF_SIZE);
+
+    const size_t sizes[] = {1, 15, 31, 64, 65, 127, 200, 1000, 4096, 4097, TEST_FAST_MEM_BUF_SIZE - 96};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (size_t dst_off = 0; dst_off < 32; dst_off += 7) {
+            for (size_t src_off = 0; src_off < 32; src_off += 5) {
+                size_t n = sizes[i];
+                memset(dst, 0xA5, TEST_FAST_MEM_BUF_SIZE + 64);
+                memset(ref, 0xA5, TEST_FAST_MEM_BUF_SIZE + 64);
+                memcpy(ref + 16 + dst_off, src + src_off, n);
+                TEST_ASSERT_EQUAL_PTR(dst + 16 + dst_off, esp_fast_memcpy(dst + 16 + dst_off, src + src_off, n));
+                TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, dst, TEST_FAST_MEM_BUF_SIZE + 64);
+                TEST_ASSERT_EQUAL_INT(0, esp_fast_memcmp(dst + 16 + dst_off, src + src_off, n));
+
+                memset(ref + 16 + dst_off, 0x3C, n);
+                TEST_ASSERT_EQUAL_PTR(dst + 16 + dst_off, esp_fast_memset(dst + 16 + dst_off, 0x3C, n));
+                TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, dst, TEST_FAST_MEM_BUF_SIZE + 64);
+            }
+        }
+    }
+
+    // a difference in the last byte
+    memcpy(dst, src, 1000);
+    dst[999] ^= 0x80;
+    TEST_ASSERT_EQUAL_INT(memcmp(dst, src, 1000) > 0, esp_fast_memcmp(dst, src, 1000) > 0);
+    TEST_ASSERT_NOT_EQUAL(0, esp_fast_memcmp(dst + 3, src + 3, 997));
+
+    free(src);
+    free(dst);
+    free(ref);
+}
+
+TEST_CASE("fast memory routines copy and fill any size and alignment", "[fast_mem]")
+{
+    test_fast_mem_sizes();
+}
+
+#if SOC_ASYNC_MEMCPY_SUPPORTED
+TEST_CASE("fast memory routines with the DMA enabled", "[fast_mem]")
+{
+    TEST_ESP_OK(esp_fast_mem_enable_dma());
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_fast_mem_enable_dma());
+    test_fast_mem_sizes();
+    TEST_ESP_OK(esp_fast_mem_disable_dma());
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_fast_mem_disable_dma());
+}
+
+typedef struct {
+    volatile bool stop;
+    int errors;
+    SemaphoreHandle_t done;
+} test_fast_mem_copier_t;
+
+static void test_fast_mem_copy_task(void *arg)
+{
+    test_fast_mem_copier_t *copier = arg;
+    uint8_t *src = heap_caps_malloc(TEST_FAST_MEM_BUF_SIZE, MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+    uint8_t *dst = heap_caps_malloc(TEST_FAST_MEM_BUF_SIZE, MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+    if (src && dst) {
+        esp_fill_random(src, TEST_FAST_MEM_BUF_SIZE);
+        while (!copier->stop) {
+            memset(dst, 0, TEST_FAST_MEM_BUF_SIZE);
+            esp_fast_memcpy(dst, src, TEST_FAST_MEM_BUF_SIZE);
+            copier->errors += memcmp(dst, src, TEST_FAST_MEM_BUF_SIZE) != 0;
+        }
+    } else {
+        copier->errors++;
+    }
+    free(src);
+    free(dst);
+    xSemaphoreGive(copier->done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("fast memory DMA can be disabled while another task copies", "[fast_mem]")
+{
+    test_fast_mem_copier_t copier = {
+        .done = xSemaphoreCreateBinary(),
+    };
+    TEST_ASSERT_NOT_NULL(copier.done);
+    for (int i = 0; i < 10; i++) {
+        TEST_ESP_OK(esp_fast_mem_enable_dma());
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(test_fast_mem_copy_task, "copier", 4096, &copier,
+                                                          uxTaskPriorityGet(NULL), NULL, portNUM_PROCESSORS - 1));
+        vTaskDelay(pdMS_TO_TICKS(10));
+        // the driver is only uninstalled once the copy which is using it is done
+        TEST_ESP_OK(esp_fast_mem_disable_dma());
+        vTaskDelay(pdMS_TO_TICKS(10));
+        copier.stop = true;
+        TEST_ASSERT_TRUE(xSemaphoreTake(copier.done, pdMS_TO_TICKS(1000)));
+        copier.stop = false;
+    }
+    vSemaphoreDelete(copier.done);
+    TEST_ASSERT_EQUAL(0, copier.errors);
+}
+#endif
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_rom_sys.h"
+#include "esp_intr_alloc.h"
+#include "soc/spi_periph.h"
+#include "hal/spi_ll.h"
+#include "esp_private/periph_ctrl.h"
+
+#if CONFIG_ESP_INTR_STATS
+
+#ifdef CONFIG_IDF_TARGET_ESP32
+#define TEST_SPI_DEV    (&SPI2)
+#else
+#define TEST_SPI_DEV    (&GPSPI2)
+#endif
+
+#if !SOC_RCC_IS_INDEPENDENT
+#define TEST_BUS_RCC_CLOCK_ATOMIC() PERIPH_RCC_ATOMIC()
+#else
+#define TEST_BUS_RCC_CLOCK_ATOMIC()
+#endif
+
+#define TEST_INTR_COUNT     10
+
+static IRAM_ATTR void test_stats_handler(void *arg)
+{
+    volatile int *calls = (volatile int *)arg;
+    // the first call is long enough to land in a later bucket of the histogram
+    esp_rom_delay_us(*calls == 0 ? 100 : 1);
+    (*calls)++;
+    spi_ll_clear_int_stat(TEST_SPI_DEV);
+}
+
+static void test_intr_stats(int flags)
+{
+    volatile int calls = 0;
+    intr_handle_t handle;
+
+    TEST_BUS_RCC_CLOCK_ATOMIC() {
+        spi_ll_enable_bus_clock(1, true);
+        spi_ll_reset_register(1);
+    }
+    TEST_ESP_OK(esp_intr_alloc(spi_periph_signal[1].irq, flags, test_stats_handler, (void *)&calls, &handle));
+    spi_ll_enable_int(TEST_SPI_DEV);
+
+    for (int i = 0; i < TEST_INTR_COUNT; i++) {
+        spi_ll_set_int_stat(TEST_SPI_DEV);
+        vTaskDelay(1);
+    }
+    TEST_ASSERT_EQUAL(TEST_INTR_COUNT, calls);
+
+    esp_intr_stats_t stats;
+    TEST_ESP_OK(esp_intr_get_stats(handle, &stats));
+    TEST_ASSERT_EQUAL(TEST_INTR_COUNT, stats.count);
+    // at least 100 us at 1 MHz
+    TEST_ASSERT_GREATER_OR_EQUAL(100, stats.max_cycles);
+    TEST_ASSERT_TRUE(stats.total_cycles >= stats.max_cycles);
+    uint32_t histogram_sum = 0;
+    for (int i = 0; i < ESP_INTR_STATS_HISTOGRAM_BUCKETS; i++) {
+        histogram_sum += stats.histogram[i];
+    }
+    TEST_ASSERT_EQUAL(TEST_INTR_COUNT, histogram_sum);
+
+    TEST_ESP_OK(esp_intr_dump_stats(stdout));
+
+    spi_ll_disable_int(TEST_SPI_DEV);
+    TEST_ESP_OK(esp_intr_free(handle));
+    TEST_BUS_RCC_CLOCK_ATOMIC() {
+        spi_ll_enable_bus_clock(1, false);
+    }
+}
+
+TEST_CASE("Intr_alloc stats, non-shared int", "[intr_alloc]")
+{
+    test_intr_stats(0);
+}
+
+TEST_CASE("Intr_alloc stats, shared int", "[intr_alloc]")
+{
+    test_intr_stats(ESP_INTR_FLAG_SHARED);
+}
+
+#else // CONFIG_ESP_INTR_STATS
+
+TEST_CASE("Intr_alloc stats are not supported when disabled", "[intr_alloc]")
+{
+    esp_intr_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_intr_get_stats(NULL, &stats));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_intr_dump_stats(stdout));
+}
+
+#endif // CONFIG_ESP_INTR_STATS
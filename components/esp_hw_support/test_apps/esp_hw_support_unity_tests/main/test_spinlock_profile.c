@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_rom_sys.h"
+#include "esp_spinlock_profile.h"
+
+#if CONFIG_ESP_SPINLOCK_PROFILING
+
+static portMUX_TYPE s_test_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const esp_spinlock_profile_entry_t *find_entry(const esp_spinlock_profile_entry_t *entries, size_t num, const void *lock)
+{
+    for (size_t i = 0; i < num; i++) {
+        if (entries[i].lock == lock) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+TEST_CASE("spinlock profiling records acquisitions and hold time", "[spinlock_profile]")
+{
+    const size_t max_entries = CONFIG_ESP_SPINLOCK_PROFILING_MAX_LOCKS;
+    esp_spinlock_profile_entry_t *entries = calloc(max_entries, sizeof(esp_spinlock_profile_entry_t));
+    TEST_ASSERT_NOT_NULL(entries);
+    TEST_ESP_OK(esp_spinlock_profile_reset());
+
+    for (int i = 0; i < 10; i++) {
+        taskENTER_CRITICAL(&s_test_lock);
+        // nested acquisitions are not counted
+        taskENTER_CRITICAL(&s_test_lock);
+        esp_rom_delay_us(i == 5 ? 100 : 1);
+        taskEXIT_CRITICAL(&s_test_lock);
+        taskEXIT_CRITICAL(&s_test_lock);
+    }
+
+    size_t num = 0;
+    TEST_ESP_OK(esp_spinlock_profile_get(entries, max_entries, &num));
+    const esp_spinlock_profile_entry_t *entry = find_entry(entries, num, &s_test_lock);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL(10, entry->acquire_count);
+    TEST_ASSERT_EQUAL(0, entry->contended_count);
+    // at least 100 us at 1 MHz
+    TEST_ASSERT_GREATER_OR_EQUAL(100, entry->max_hold_cycles);
+    TEST_ASSERT_NOT_NULL(entry->max_hold_caller);
+
+    // sorted by decreasing spin cycles
+    for (size_t i = 1; i < num; i++) {
+        TEST_ASSERT_TRUE(entries[i - 1].spin_cycles >= entries[i].spin_cycles);
+    }
+
+    TEST_ESP_OK(esp_spinlock_profile_dump(stdout));
+    free(entries);
+}
+
+#if !CONFIG_FREERTOS_UNICORE
+static volatile bool s_stop;
+
+static void contending_task(void *arg)
+{
+    while (!s_stop) {
+        taskENTER_CRITICAL(&s_test_lock);
+        esp_rom_delay_us(10);
+        taskEXIT_CRITICAL(&s_test_lock);
+    }
+    xTaskNotifyGive((TaskHandle_t)arg);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("spinlock profiling records contention between cores", "[spinlock_profile]")
+{
+    esp_spinlock_profile_entry_t *entries = calloc(CONFIG_ESP_SPINLOCK_PROFILING_MAX_LOCKS, sizeof(esp_spinlock_profile_entry_t));
+    TEST_ASSERT_NOT_NULL(entries);
+    TEST_ESP_OK(esp_spinlock_profile_reset());
+
+    s_stop = false;
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(contending_task, "contend", 2048, xTaskGetCurrentTaskHandle(), UNITY_FREERTOS_PRIORITY, NULL, !xPortGetCoreID()));
+    for (int i = 0; i < 1000; i++) {
+        taskENTER_CRITICAL(&s_test_lock);
+        esp_rom_delay_us(10);
+        taskEXIT_CRITICAL(&s_test_lock);
+    }
+    s_stop = true;
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    size_t num = 0;
+    TEST_ESP_OK(esp_spinlock_profile_get(entries, CONFIG_ESP_SPINLOCK_PROFILING_MAX_LOCKS, &num));
+    const esp_spinlock_profile_entry_t *entry = find_entry(entries, num, &s_test_lock);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_GREATER_OR_EQUAL(1000, entry->acquire_count);
+    TEST_ASSERT_GREATER_THAN(0, entry->contended_count);
+    TEST_ASSERT_TRUE(entry->spin_cycles >= entry->max_spin_cycles);
+    TEST_ASSERT_GREATER_THAN(0, entry->max_spin_cycles);
+    free(entries);
+}
+#endif // !CONFIG_FREERTOS_UNICORE
+
+#else // CONFIG_ESP_SPINLOCK_PROFILING
+
+TEST_CASE("spinlock profiling is not supported when disabled", "[spinlock_profile]")
+{
+    size_t num = 0;
+    esp_spinlock_profile_entry_t entry;
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_spinlock_profile_get(&entry, 1, &num));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_spinlock_profile_dump(stdout));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_spinlock_profile_reset());
+}
+
+#endif // CONFIG_ESP_SPINLOCK_PROFILING
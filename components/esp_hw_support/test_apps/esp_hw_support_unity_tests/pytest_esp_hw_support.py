@@ -1,4 +1,4 @@
-# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: CC0-1.0
 import pytest
 from pytest_embedded import Dut
@@ -11,6 +11,8 @@ from pytest_embedded import Dut
         pytest.param('single_core_esp32', marks=[pytest.mark.esp32]),
         pytest.param('default', marks=[pytest.mark.supported_targets]),
         pytest.param('release', marks=[pytest.mark.supported_targets]),
+        pytest.param('spinlock_profiling', marks=[pytest.mark.supported_targets]),
+        pytest.param('intr_stats', marks=[pytest.mark.supported_targets]),
     ],
     indirect=True,
 )
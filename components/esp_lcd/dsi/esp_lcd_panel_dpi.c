@@ -34,6 +34,8 @@ struct esp_lcd_dpi_panel_t {
     esp_lcd_dsi_bus_handle_t bus; // DSI bus handle
     uint8_t virtual_channel;      // Virtual channel ID, index from 0
     uint8_t cur_fb_index;         // Current frame buffer index
+    uint8_t back_fb_index;        // Index of the frame buffer drawn by `esp_lcd_dpi_panel_draw_regions`, shown at the next swap
+    volatile bool fb_swap_pending; // Whether a frame buffer swap is scheduled at the end of the current frame
     uint8_t num_fbs;              // Number of frame buffers
     uint8_t *fbs[DPI_PANEL_MAX_FB_NUM]; // Frame buffers
     uint32_t h_pixels;            // Horizontal pixels
@@ -45,6 +47,13 @@ struct esp_lcd_dpi_panel_t {
     dw_gdma_link_list_handle_t link_lists[DPI_PANEL_MAX_FB_NUM]; // DMA link list
     esp_async_fbcpy_handle_t fbcpy_handle; // Use DMA2D to do frame buffer copy
     SemaphoreHandle_t draw_sem;            // A semaphore used to synchronize the draw operations when DMA2D is used
+    SemaphoreHandle_t swap_sem;            // A semaphore given when a scheduled frame buffer swap is done
+    uint32_t max_dirty_regions;            // Maximum number of regions drawn by one `esp_lcd_dpi_panel_draw_regions` call
+    esp_lcd_dpi_panel_region_t *drawn_regions; // Regions drawn into the back frame buffer since the last swap
+    size_t num_drawn_regions;              // Number of regions in `drawn_regions`
+    esp_lcd_dpi_panel_region_t *sync_regions; // Regions drawn into the front frame buffer before the last swap, missing from the back one
+    size_t num_sync_regions;               // Number of regions in `sync_regions`
+    esp_async_fbcpy_trans_desc_t *copies;  // Copies done by one `esp_lcd_dpi_panel_draw_regions` call
     esp_pm_lock_handle_t pm_lock;          // Power management lock
     esp_lcd_dpi_panel_color_trans_done_cb_t on_color_trans_done; // Callback invoked when color data transfer has finished
     esp_lcd_dpi_panel_refresh_done_cb_t on_refresh_done; // Callback invoked when one refresh operation finished (kinda like a vsync end)
@@ -78,6 +87,20 @@ static bool dma_trans_done_cb(dw_gdma_channel_handle_t chan, const dw_gdma_trans
 {
     bool yield_needed = false;
     esp_lcd_dpi_panel_t *dpi_panel = (esp_lcd_dpi_panel_t *)user_data;
+
+    // the frame ends here, a scheduled swap can be done without tearing
+    if (dpi_panel->fb_swap_pending) {
+        uint8_t back_fb_index = dpi_panel->back_fb_index;
+        dpi_panel->back_fb_index = dpi_panel->cur_fb_index;
+        dpi_panel->cur_fb_index = back_fb_index;
+        dpi_panel->fb_swap_pending = false;
+        BaseType_t task_woken = pdFALSE;
+        xSemaphoreGiveFromISR(dpi_panel->swap_sem, &task_woken);
+        if (task_woken == pdTRUE) {
+            yield_needed = true;
+        }
+    }
+
     uint8_t fb_index = dpi_panel->cur_fb_index;
     dw_gdma_link_list_handle_t link_list = dpi_panel->link_lists[fb_index];
 
@@ -211,9 +234,26 @@ esp_err_t esp_lcd_new_panel_dpi(esp_lcd_dsi_bus_handle_t bus, const esp_lcd_dpi_
     dpi_panel->h_pixels = panel_config->video_timing.h_size;
     dpi_panel->v_pixels = panel_config->video_timing.v_size;
 
+    // dirty regions are drawn into the second frame buffer, while the first one is scanned out
+    dpi_panel->back_fb_index = (num_fbs > 1) ? 1 : 0;
+    dpi_panel->max_dirty_regions = panel_config->max_dirty_regions;
+    if (panel_config->max_dirty_regions) {
+        dpi_panel->drawn_regions = heap_caps_calloc(panel_config->max_dirty_regions, sizeof(esp_lcd_dpi_panel_region_t), DSI_MEM_ALLOC_CAPS);
+        dpi_panel->sync_regions = heap_caps_calloc(panel_config->max_dirty_regions, sizeof(esp_lcd_dpi_panel_region_t), DSI_MEM_ALLOC_CAPS);
+        // each draw copies the regions missing from the back frame buffer, then the new ones
+        dpi_panel->copies = heap_caps_calloc(panel_config->max_dirty_regions * 2, sizeof(esp_async_fbcpy_trans_desc_t), DSI_MEM_ALLOC_CAPS);
+        ESP_GOTO_ON_FALSE(dpi_panel->drawn_regions && dpi_panel->sync_regions && dpi_panel->copies, ESP_ERR_NO_MEM, err, TAG, "no memory for dirty regions");
+        if (num_fbs > 1) {
+            dpi_panel->swap_sem = xSemaphoreCreateBinaryWithCaps(DSI_MEM_ALLOC_CAPS);
+            ESP_GOTO_ON_FALSE(dpi_panel->swap_sem, ESP_ERR_NO_MEM, err, TAG, "no memory for swap semaphore");
+        }
+    }
+
 #if SOC_DMA2D_SUPPORTED
     if (panel_config->flags.use_dma2d) {
-        esp_async_fbcpy_config_t fbcpy_config = {};
+        esp_async_fbcpy_config_t fbcpy_config = {
+            .max_batch_size = panel_config->max_dirty_regions * 2,
+        };
         ESP_GOTO_ON_ERROR(esp_async_fbcpy_install(&fbcpy_config, &fbcpy_ctx), err, TAG, "install async memcpy 2d failed");
         dpi_panel->fbcpy_handle = fbcpy_ctx;
         dpi_panel->draw_sem = xSemaphoreCreateBinaryWithCaps(DSI_MEM_ALLOC_CAPS);
@@ -336,6 +376,12 @@ static esp_err_t dpi_panel_del(esp_lcd_panel_t *panel)
     if (dpi_panel->draw_sem) {
         vSemaphoreDelete(dpi_panel->draw_sem);
     }
+    if (dpi_panel->swap_sem) {
+        vSemaphoreDelete(dpi_panel->swap_sem);
+    }
+    free(dpi_panel->drawn_regions);
+    free(dpi_panel->sync_regions);
+    free(dpi_panel->copies);
     if (dpi_panel->pm_lock) {
         esp_pm_lock_release(dpi_panel->pm_lock);
         esp_pm_lock_delete(dpi_panel->pm_lock);
@@ -516,6 +562,194 @@ static esp_err_t dpi_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int
     return ESP_OK;
 }
 
+static void dpi_panel_copy_by_cpu(esp_lcd_dpi_panel_t *dpi_panel, const esp_async_fbcpy_trans_desc_t *copy)
+{
+    size_t bits_per_pixel = dpi_panel->bits_per_pixel;
+    size_t src_bytes_per_line = copy->src_buffer_size_x * bits_per_pixel / 8;
+    size_t dst_bytes_per_line = copy->dst_buffer_size_x * bits_per_pixel / 8;
+    size_t copy_bytes_per_line = copy->copy_size_x * bits_per_pixel / 8;
+    const uint8_t *from = (const uint8_t *)copy->src_buffer + (copy->src_offset_y * copy->src_buffer_size_x + copy->src_offset_x) * bits_per_pixel / 8;
+    uint8_t *to = (uint8_t *)copy->dst_buffer + (copy->dst_offset_y * copy->dst_buffer_size_x + copy->dst_offset_x) * bits_per_pixel / 8;
+    for (size_t y = 0; y < copy->copy_size_y; y++) {
+        memcpy(to, from, copy_bytes_per_line);
+        to += dst_bytes_per_line;
+        from += src_bytes_per_line;
+    }
+    uint8_t *cache_sync_start = (uint8_t *)copy->dst_buffer + copy->dst_offset_y * dst_bytes_per_line;
+    // the buffer to be flushed is still within the frame buffer, so even an unaligned address is OK
+    esp_cache_msync(cache_sync_start, copy->copy_size_y * dst_bytes_per_line, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+}
+
+static bool dpi_panel_region_is_covered(const esp_lcd_dpi_panel_region_t *region, const esp_lcd_dpi_panel_region_t *regions, size_t num_regions)
+{
+    for (size_t i = 0; i < num_regions; i++) {
+        if (regions[i].x_start <= region->x_start && regions[i].y_start <= region->y_start &&
+                regions[i].x_end >= region->x_end && regions[i].y_end >= region->y_end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void dpi_panel_add_drawn_region(esp_lcd_dpi_panel_t *dpi_panel, const esp_lcd_dpi_panel_region_t *region)
+{
+    esp_lcd_dpi_panel_region_t *drawn = dpi_panel->drawn_regions;
+    if (dpi_panel_region_is_covered(region, drawn, dpi_panel->num_drawn_regions)) {
+        return;
+    }
+    if (dpi_panel->num_drawn_regions < dpi_panel->max_dirty_regions) {
+        drawn[dpi_panel->num_drawn_regions++] = *region;
+    } else {
+        // too many regions to track, the whole frame will be copied to the other frame buffer
+        drawn[0] = (esp_lcd_dpi_panel_region_t) {
+            .x_start = 0,
+            .y_start = 0,
+            .x_end = dpi_panel->h_pixels,
+            .y_end = dpi_panel->v_pixels,
+        };
+        dpi_panel->num_drawn_regions = 1;
+    }
+}
+
+esp_err_t esp_lcd_dpi_panel_draw_regions(esp_lcd_panel_handle_t panel, const esp_lcd_dpi_panel_region_t *regions, size_t num_regions)
+{
+    ESP_RETURN_ON_FALSE(panel && regions && num_regions, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_lcd_dpi_panel_t *dpi_panel = __containerof(panel, esp_lcd_dpi_panel_t, base);
+    ESP_RETURN_ON_FALSE(num_regions <= dpi_panel->max_dirty_regions, ESP_ERR_INVALID_ARG, TAG,
+                        "too many regions, max %"PRIu32, dpi_panel->max_dirty_regions);
+    int h_res = dpi_panel->h_pixels;
+    int v_res = dpi_panel->v_pixels;
+    for (size_t i = 0; i < num_regions; i++) {
+        const esp_lcd_dpi_panel_region_t *region = &regions[i];
+        // the color data is compact, so the regions can't be clipped
+        ESP_RETURN_ON_FALSE(region->color_data && region->x_start >= 0 && region->y_start >= 0 &&
+                            region->x_start < region->x_end && region->x_end <= h_res &&
+                            region->y_start < region->y_end && region->y_end <= v_res,
+                            ESP_ERR_INVALID_ARG, TAG, "invalid region %zu", i);
+    }
+    ESP_RETURN_ON_FALSE(!dpi_panel->fb_swap_pending, ESP_ERR_INVALID_STATE, TAG, "previous swap is not done");
+    if (dpi_panel->fbcpy_handle) {
+        ESP_RETURN_ON_FALSE(xSemaphoreTake(dpi_panel->draw_sem, 0) == pdTRUE, ESP_ERR_INVALID_STATE,
+                            TAG, "previous draw operation is not finished");
+    }
+
+    uint8_t *front_fb = dpi_panel->fbs[dpi_panel->cur_fb_index];
+    uint8_t *back_fb = dpi_panel->fbs[dpi_panel->back_fb_index];
+    color_space_pixel_format_t pixel_format_unique_id = {
+        .color_space = COLOR_SPACE_RGB,
+        .pixel_format = dpi_panel->pixel_format,
+    };
+    esp_async_fbcpy_trans_desc_t *copies = dpi_panel->copies;
+    size_t num_copies = 0;
+
+    // first bring the back frame buffer up to date with the frame being scanned out,
+    // except for the regions which are about to be overwritten
+    if (back_fb != front_fb) {
+        for (size_t i = 0; i < dpi_panel->num_sync_regions; i++) {
+            const esp_lcd_dpi_panel_region_t *region = &dpi_panel->sync_regions[i];
+            if (dpi_panel_region_is_covered(region, regions, num_regions)) {
+                continue;
+            }
+            copies[num_copies++] = (esp_async_fbcpy_trans_desc_t) {
+                .src_buffer = front_fb,
+                .dst_buffer = back_fb,
+                .src_buffer_size_x = h_res,
+                .src_buffer_size_y = v_res,
+                .dst_buffer_size_x = h_res,
+                .dst_buffer_size_y = v_res,
+                .src_offset_x = region->x_start,
+                .src_offset_y = region->y_start,
+                .dst_offset_x = region->x_start,
+                .dst_offset_y = region->y_start,
+                .copy_size_x = region->x_end - region->x_start,
+                .copy_size_y = region->y_end - region->y_start,
+                .pixel_format_unique_id = pixel_format_unique_id,
+            };
+        }
+    }
+    dpi_panel->num_sync_regions = 0;
+
+    for (size_t i = 0; i < num_regions; i++) {
+        const esp_lcd_dpi_panel_region_t *region = &regions[i];
+        size_t size_x = region->x_end - region->x_start;
+        size_t size_y = region->y_end - region->y_start;
+        copies[num_copies++] = (esp_async_fbcpy_trans_desc_t) {
+            .src_buffer = region->color_data,
+            .dst_buffer = back_fb,
+            .src_buffer_size_x = size_x,
+            .src_buffer_size_y = size_y,
+            .dst_buffer_size_x = h_res,
+            .dst_buffer_size_y = v_res,
+            .dst_offset_x = region->x_start,
+            .dst_offset_y = region->y_start,
+            .copy_size_x = size_x,
+            .copy_size_y = size_y,
+            .pixel_format_unique_id = pixel_format_unique_id,
+        };
+        dpi_panel_add_drawn_region(dpi_panel, region);
+    }
+
+    if (dpi_panel->fbcpy_handle) {
+        ESP_LOGV(TAG, "copy %zu regions by DMA2D", num_copies);
+        // write back the user's draw buffers, so that the DMA can see the correct data
+        for (size_t i = 0; i < num_regions; i++) {
+            size_t color_data_size = (regions[i].x_end - regions[i].x_start) * (regions[i].y_end - regions[i].y_start) * dpi_panel->bits_per_pixel / 8;
+            esp_cache_msync((void *)regions[i].color_data, color_data_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+        }
+        esp_err_t ret = esp_async_fbcpy_batch(dpi_panel->fbcpy_handle, copies, num_copies, async_fbcpy_done_cb, dpi_panel);
+        if (ret != ESP_OK) {
+            xSemaphoreGive(dpi_panel->draw_sem);
+            ESP_LOGE(TAG, "async memcpy failed");
+            return ret;
+        }
+    } else {
+        ESP_LOGV(TAG, "copy %zu regions by CPU", num_copies);
+        for (size_t i = 0; i < num_copies; i++) {
+            dpi_panel_copy_by_cpu(dpi_panel, &copies[i]);
+        }
+        // invoke the trans done callback
+        if (dpi_panel->on_color_trans_done) {
+            dpi_panel->on_color_trans_done(&dpi_panel->base, NULL, dpi_panel->user_ctx);
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_dpi_panel_swap_frame_buffer(esp_lcd_panel_handle_t panel, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_lcd_dpi_panel_t *dpi_panel = __containerof(panel, esp_lcd_dpi_panel_t, base);
+    ESP_RETURN_ON_FALSE(dpi_panel->swap_sem, ESP_ERR_INVALID_STATE, TAG, "two frame buffers and dirty regions are required");
+    ESP_RETURN_ON_FALSE(!dpi_panel->fb_swap_pending, ESP_ERR_INVALID_STATE, TAG, "previous swap is not done");
+    TickType_t ticks = timeout_ms < 0 ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+
+    // nothing drawn since the previous swap, the back frame buffer is not ready to be shown
+    if (dpi_panel->num_drawn_regions == 0) {
+        return ESP_OK;
+    }
+    // the back frame buffer can't be shown before the copies to it are finished
+    if (dpi_panel->fbcpy_handle) {
+        ESP_RETURN_ON_FALSE(xSemaphoreTake(dpi_panel->draw_sem, ticks) == pdTRUE, ESP_ERR_TIMEOUT,
+                            TAG, "wait for draw operation timeout");
+        xSemaphoreGive(dpi_panel->draw_sem);
+    }
+
+    // after the swap, the regions drawn into the back frame buffer will be missing from the new back frame buffer
+    memcpy(dpi_panel->sync_regions, dpi_panel->drawn_regions, dpi_panel->num_drawn_regions * sizeof(esp_lcd_dpi_panel_region_t));
+    dpi_panel->num_sync_regions = dpi_panel->num_drawn_regions;
+    dpi_panel->num_drawn_regions = 0;
+
+    // drop the notification of a previous swap which wasn't waited for
+    xSemaphoreTake(dpi_panel->swap_sem, 0);
+    dpi_panel->fb_swap_pending = true;
+    if (ticks) {
+        ESP_RETURN_ON_FALSE(xSemaphoreTake(dpi_panel->swap_sem, ticks) == pdTRUE, ESP_ERR_TIMEOUT,
+                            TAG, "wait for frame buffer swap timeout");
+    }
+    return ESP_OK;
+}
+
 esp_err_t esp_lcd_dpi_panel_set_pattern(esp_lcd_panel_handle_t panel, mipi_dsi_pattern_type_t pattern)
 {
     ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
@@ -87,6 +87,8 @@ typedef struct {
     uint8_t num_fbs;                           /*!< Number of screen-sized frame buffers that allocated by the driver
                                                     By default (set to either 0 or 1) only one frame buffer will be created */
     esp_lcd_video_timing_t video_timing;       /*!< Video timing */
+    uint32_t max_dirty_regions;                /*!< Maximum number of regions drawn by one call of `esp_lcd_dpi_panel_draw_regions`,
+                                                    set to 0 if that function is not used */
     /// Extra configuration flags for MIPI DSI DPI panel
     struct extra_dpi_panel_flags {
         uint32_t use_dma2d: 1; /*!< Use DMA2D to copy user buffer to the frame buffer when necessary */
@@ -121,6 +123,58 @@ esp_err_t esp_lcd_new_panel_dpi(esp_lcd_dsi_bus_handle_t bus, const esp_lcd_dpi_
  */
 esp_err_t esp_lcd_dpi_panel_get_frame_buffer(esp_lcd_panel_handle_t dpi_panel, uint32_t fb_num, void **fb0, ...);
 
+/**
+ * @brief Region of the screen updated by `esp_lcd_dpi_panel_draw_regions`
+ */
+typedef struct {
+    int x_start;            /*!< Start column index of the region, included */
+    int y_start;            /*!< Start row index of the region, included */
+    int x_end;              /*!< End column index of the region, not included */
+    int y_end;              /*!< End row index of the region, not included */
+    const void *color_data; /*!< Color data of the region, a compact array of (x_end - x_start) * (y_end - y_start) pixels */
+} esp_lcd_dpi_panel_region_t;
+
+/**
+ * @brief Draw the dirty regions of a frame into the back frame buffer
+ *
+ * With two or more frame buffers, the regions are drawn into the frame buffer which is not being scanned out, which is
+ * shown by `esp_lcd_dpi_panel_swap_frame_buffer`. The regions drawn in the previous frame are first copied from the
+ * frame being scanned out, so that the back frame buffer holds the complete frame. Only the first two frame buffers
+ * are used this way. With one frame buffer, the regions are drawn into it directly.
+ *
+ * When the panel uses DMA2D, all the copies are done in one batch, and `on_color_trans_done` is invoked once they
+ * finish. Otherwise, the copies are done by the CPU before the function returns.
+ *
+ * @note Don't mix this function with `esp_lcd_panel_draw_bitmap` on the same panel.
+ *
+ * @param[in] dpi_panel MIPI DPI panel handle, returned from esp_lcd_new_panel_dpi()
+ * @param[in] regions Regions to draw, the color data must stay valid until `on_color_trans_done` is invoked
+ * @param[in] num_regions Number of regions, at most `esp_lcd_dpi_panel_config_t::max_dirty_regions`
+ * @return
+ *      - ESP_OK: Draw the regions successfully
+ *      - ESP_ERR_INVALID_ARG: Draw the regions failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Draw the regions failed because the previous draw operation or frame buffer swap is not finished
+ *      - ESP_FAIL: Draw the regions failed because of other error
+ */
+esp_err_t esp_lcd_dpi_panel_draw_regions(esp_lcd_panel_handle_t dpi_panel, const esp_lcd_dpi_panel_region_t *regions, size_t num_regions);
+
+/**
+ * @brief Show the back frame buffer, drawn by `esp_lcd_dpi_panel_draw_regions`
+ *
+ * The frame buffers are swapped when the frame being scanned out ends, so the screen doesn't tear. Rendering of the
+ * next frame can continue meanwhile, but it can't be drawn until the swap is done.
+ *
+ * @param[in] dpi_panel MIPI DPI panel handle, returned from esp_lcd_new_panel_dpi()
+ * @param[in] timeout_ms Time to wait for the copies to the back frame buffer and for the swap to finish, -1 to wait forever.
+ *                       With 0, the swap is only scheduled, `on_refresh_done` tells when it is done.
+ * @return
+ *      - ESP_OK: Swap the frame buffers successfully (or scheduled, with 0 timeout)
+ *      - ESP_ERR_INVALID_ARG: Swap the frame buffers failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Swap the frame buffers failed because the panel has only one frame buffer, or the previous swap is not done
+ *      - ESP_ERR_TIMEOUT: The copies or the swap didn't finish within the timeout. If the copies did, the swap is still scheduled
+ */
+esp_err_t esp_lcd_dpi_panel_swap_frame_buffer(esp_lcd_panel_handle_t dpi_panel, int timeout_ms);
+
 /**
  * @brief Set pre-defined pattern to the screen for testing or debugging purpose
  *
@@ -40,6 +40,9 @@ typedef struct {
         unsigned int sio_mode: 1;        /*!< Read and write through a single data line (MOSI) */
         unsigned int lsb_first: 1;       /*!< transmit LSB bit first */
         unsigned int cs_high_active: 1;  /*!< CS line is high active */
+        unsigned int queue_param: 1;     /*!< Queue the commands and the parameters of no more than 4 bytes behind the pending color transactions,
+                                              instead of waiting for them to finish and sending by polling.
+                                              So drawing many small bitmaps doesn't block on the previous ones */
     } flags; /*!< Extra flags to fine-tune the SPI device */
 } esp_lcd_panel_io_spi_config_t;
 
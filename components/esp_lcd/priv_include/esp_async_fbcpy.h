@@ -18,6 +18,7 @@ typedef struct esp_async_fbcpy_context_t *esp_async_fbcpy_handle_t;
  * @brief Async FrameBuffer copy configuration
  */
 typedef struct {
+    size_t max_batch_size; /*!< Maximum number of copies in a batch submitted by `esp_async_fbcpy_batch`, 0 means 1 */
 } esp_async_fbcpy_config_t;
 
 /**
@@ -88,3 +89,21 @@ typedef bool (*esp_async_fbcpy_event_callback_t)(esp_async_fbcpy_handle_t mcp, e
  */
 esp_err_t esp_async_fbcpy(esp_async_fbcpy_handle_t mcp, esp_async_fbcpy_trans_desc_t* transaction,
                           esp_async_fbcpy_event_callback_t memcpy_done_cb, void *cb_args);
+
+/**
+ * @brief Start a batch of Async FrameBuffer copies
+ *
+ * All the copies are done in one DMA2D transaction, one 2D block after another.
+ *
+ * @param mcp Async FrameBuffer copy handle
+ * @param transactions Array of Async FrameBuffer copy transaction descriptors
+ * @param num_trans Number of transactions in the array, at most `esp_async_fbcpy_config_t::max_batch_size`
+ * @param memcpy_done_cb Callback function that will be invoked when all the copies finish
+ * @param cb_args User data
+ * @return
+ *      - ESP_OK: Start Async FrameBuffer copy batch successfully
+ *      - ESP_ERR_INVALID_ARG: Start Async FrameBuffer copy batch failed because of invalid argument
+ *      - ESP_FAIL: Start Async FrameBuffer copy batch failed because of other error
+ */
+esp_err_t esp_async_fbcpy_batch(esp_async_fbcpy_handle_t mcp, const esp_async_fbcpy_trans_desc_t *transactions, size_t num_trans,
+                                esp_async_fbcpy_event_callback_t memcpy_done_cb, void *cb_args);
@@ -84,6 +84,7 @@ static esp_err_t lcd_rgb_create_dma_channel(esp_rgb_panel_t *panel);
 static void lcd_rgb_panel_init_trans_link(esp_rgb_panel_t *panel);
 static esp_err_t lcd_rgb_panel_configure_gpio(esp_rgb_panel_t *panel, const esp_lcd_rgb_panel_config_t *panel_config);
 static void lcd_rgb_panel_start_transmission(esp_rgb_panel_t *rgb_panel);
+static esp_err_t lcd_rgb_create_bb_copy_channel(esp_rgb_panel_t *panel);
 static void rgb_lcd_default_isr_handler(void *args);
 
 struct esp_rgb_panel_t {
@@ -112,6 +113,11 @@ struct esp_rgb_panel_t {
     size_t bb_eof_count;            // record the number we received the DMA EOF event, compare with `expect_eof_count` in the VSYNC_END ISR
     size_t expect_eof_count;        // record the number of DMA EOF event we expected to receive
     gdma_channel_handle_t dma_chan; // DMA channel handle
+    gdma_channel_handle_t bb_copy_tx_chan; // DMA channel that reads the frame buffer, used to refill the bounce buffer
+    gdma_channel_handle_t bb_copy_rx_chan; // DMA channel that writes the bounce buffer
+    size_t bb_copy_node_size;              // Buffer size of each DMA descriptor of the bounce buffer copy, aligned to the DMA requirement
+    dma_descriptor_t *bb_copy_tx_nodes;    // DMA descriptors of the copy source, re-mounted to the frame buffer for each copy
+    dma_descriptor_t *bb_copy_rx_nodes[RGB_LCD_PANEL_BOUNCE_BUF_NUM]; // DMA descriptors of the copy destination, mounted to the bounce buffers
     esp_lcd_rgb_panel_vsync_cb_t on_vsync; // VSYNC event callback
     esp_lcd_rgb_panel_bounce_buf_fill_cb_t on_bounce_empty; // callback used to fill a bounce buffer rather than copying from the frame buffer
     esp_lcd_rgb_panel_bounce_buf_finish_cb_t on_bounce_frame_finish; // callback used to notify when the bounce buffer finish copying the entire frame
@@ -128,6 +134,8 @@ struct esp_rgb_panel_t {
         uint32_t need_update_pclk: 1;    // Whether to update the PCLK before start a new transaction
         uint32_t need_restart: 1;        // Whether to restart the LCD controller and the DMA
         uint32_t bb_invalidate_cache: 1; // Whether to do cache invalidation in bounce buffer mode
+        uint32_t bb_dma_copy: 1;         // Whether to refill the bounce buffer by DMA memory copy
+        uint32_t bb_copy_busy: 1;        // Whether a DMA memory copy to the bounce buffer is in progress
     } flags;
     dma_descriptor_t *dma_links[RGB_LCD_PANEL_DMA_LINKS_REPLICA]; // fbs[0] <-> dma_links[0], fbs[1] <-> dma_links[1], etc
     dma_descriptor_t dma_restart_node; // DMA descriptor used to restart the transfer
@@ -220,6 +228,17 @@ static esp_err_t lcd_rgb_panel_destroy(esp_rgb_panel_t *rgb_panel)
         gdma_disconnect(rgb_panel->dma_chan);
         gdma_del_channel(rgb_panel->dma_chan);
     }
+    if (rgb_panel->bb_copy_rx_chan) {
+        gdma_disconnect(rgb_panel->bb_copy_rx_chan);
+        gdma_del_channel(rgb_panel->bb_copy_rx_chan);
+    }
+    if (rgb_panel->bb_copy_tx_chan) {
+        gdma_disconnect(rgb_panel->bb_copy_tx_chan);
+        gdma_del_channel(rgb_panel->bb_copy_tx_chan);
+    }
+    if (rgb_panel->bb_copy_tx_nodes) {
+        free(rgb_panel->bb_copy_tx_nodes);
+    }
     if (rgb_panel->intr) {
         esp_intr_free(rgb_panel->intr);
     }
@@ -252,6 +271,11 @@ esp_err_t esp_lcd_new_rgb_panel(const esp_lcd_rgb_panel_config_t *rgb_panel_conf
                         ESP_ERR_INVALID_ARG, TAG, "must set bounce buffer if there's no frame buffer");
     ESP_RETURN_ON_FALSE(!(rgb_panel_config->flags.refresh_on_demand && rgb_panel_config->bounce_buffer_size_px),
                         ESP_ERR_INVALID_ARG, TAG, "refresh on demand is not supported under bounce buffer mode");
+    ESP_RETURN_ON_FALSE(!rgb_panel_config->flags.bb_dma_copy || (rgb_panel_config->bounce_buffer_size_px && !rgb_panel_config->flags.no_fb),
+                        ESP_ERR_INVALID_ARG, TAG, "DMA copy needs both the bounce buffer and the frame buffer");
+#if SOC_GDMA_TRIG_PERIPH_LCD0_BUS != SOC_GDMA_BUS_AHB
+    ESP_RETURN_ON_FALSE(!rgb_panel_config->flags.bb_dma_copy, ESP_ERR_NOT_SUPPORTED, TAG, "DMA copy of the bounce buffer is not supported");
+#endif
 
     // determine number of framebuffers
     size_t num_fbs = 1;
@@ -350,6 +374,9 @@ esp_err_t esp_lcd_new_rgb_panel(const esp_lcd_rgb_panel_config_t *rgb_panel_conf
     ESP_GOTO_ON_ERROR(lcd_rgb_panel_alloc_frame_buffers(rgb_panel_config, rgb_panel), err, TAG, "alloc frame buffers failed");
     // initialize DMA descriptor link
     lcd_rgb_panel_init_trans_link(rgb_panel);
+    if (rgb_panel_config->flags.bb_dma_copy) {
+        ESP_GOTO_ON_ERROR(lcd_rgb_create_bb_copy_channel(rgb_panel), err, TAG, "install bounce buffer copy DMA failed");
+    }
 
     // configure GPIO
     ret = lcd_rgb_panel_configure_gpio(rgb_panel, rgb_panel_config);
@@ -778,8 +805,8 @@ static esp_err_t rgb_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int
         }
     }
 
-    // Note that if we use a bounce buffer, the data gets read by the CPU as well so no need to write back
-    if (rgb_panel->flags.fb_in_psram && !rgb_panel->bb_size) {
+    // Note that if we use a bounce buffer, the data gets read by the CPU as well so no need to write back, unless it's copied by DMA
+    if (rgb_panel->flags.fb_in_psram && (!rgb_panel->bb_size || rgb_panel->flags.bb_dma_copy)) {
         // CPU writes data to PSRAM through DCache, data in PSRAM might not get updated, so write back
         ESP_RETURN_ON_ERROR(esp_cache_msync(flush_ptr, bytes_to_flush, 0), TAG, "flush cache buffer failed");
     }
@@ -915,7 +942,43 @@ static esp_err_t lcd_rgb_panel_select_clock_src(esp_rgb_panel_t *panel, lcd_cloc
     return ESP_OK;
 }
 
-static IRAM_ATTR bool lcd_rgb_panel_fill_bounce_buffer(esp_rgb_panel_t *panel, uint8_t *buffer)
+static IRAM_ATTR void lcd_rgb_panel_mount_copy_nodes(dma_descriptor_t *desc, uint8_t *buffer, size_t len, size_t node_size)
+{
+    while (desc) {
+        size_t mount_len = MIN(len, node_size);
+        desc->dw0.suc_eof = (mount_len == len); // only the last node marks the end of the copy
+        desc->dw0.size = mount_len;
+        desc->dw0.length = mount_len;
+        desc->dw0.owner = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+        desc->buffer = buffer;
+        buffer += mount_len;
+        len -= mount_len;
+        desc = desc->next;
+    }
+}
+
+// start a DMA memory copy from the frame buffer to the bounce buffer, return false if the copy DMA is still busy with the previous one
+static IRAM_ATTR bool lcd_rgb_panel_try_start_bb_copy(esp_rgb_panel_t *panel, uint8_t *buffer, uint8_t *src)
+{
+    bool start = false;
+    portENTER_CRITICAL_ISR(&panel->spinlock);
+    if (!panel->flags.bb_copy_busy) {
+        panel->flags.bb_copy_busy = true;
+        start = true;
+    }
+    portEXIT_CRITICAL_ISR(&panel->spinlock);
+    if (!start) {
+        return false;
+    }
+    int bb = (buffer == panel->bounce_buffer[0]) ? 0 : 1;
+    // the destination descriptors are fixed, only the source position moves on along with the frame buffer
+    lcd_rgb_panel_mount_copy_nodes(panel->bb_copy_tx_nodes, src, panel->bb_size, panel->bb_copy_node_size);
+    gdma_start(panel->bb_copy_rx_chan, (intptr_t)panel->bb_copy_rx_nodes[bb]);
+    gdma_start(panel->bb_copy_tx_chan, (intptr_t)panel->bb_copy_tx_nodes);
+    return true;
+}
+
+static IRAM_ATTR bool lcd_rgb_panel_fill_bounce_buffer(esp_rgb_panel_t *panel, uint8_t *buffer, bool dma_copy)
 {
     bool need_yield = false;
     int bytes_per_pixel = panel->fb_bits_per_pixel / 8;
@@ -926,6 +989,8 @@ static IRAM_ATTR bool lcd_rgb_panel_fill_bounce_buffer(esp_rgb_panel_t *panel, u
                 need_yield = true;
             }
         }
+    } else if (dma_copy && lcd_rgb_panel_try_start_bb_copy(panel, buffer, &panel->fbs[panel->bb_fb_index][panel->bounce_pos_px * bytes_per_pixel])) {
+        // the DMA copies the data in the background, we have a whole bounce buffer transmission time to get it done
     } else {
         // We do have frame buffer; copy from there.
         // Note: if the cache is disabled, and accessing the PSRAM by DCACHE will crash.
@@ -947,7 +1012,7 @@ static IRAM_ATTR bool lcd_rgb_panel_fill_bounce_buffer(esp_rgb_panel_t *panel, u
             }
         }
     }
-    if (panel->num_fbs > 0) {
+    if (panel->num_fbs > 0 && !dma_copy) {
         // Preload the next bit of buffer from psram
         Cache_Start_DCache_Preload((uint32_t)&panel->fbs[panel->bb_fb_index][panel->bounce_pos_px * bytes_per_pixel],
                                    panel->bb_size, 0);
@@ -966,7 +1031,83 @@ static IRAM_ATTR bool lcd_rgb_panel_eof_handler(gdma_channel_handle_t dma_chan,
     portENTER_CRITICAL_ISR(&panel->spinlock);
     panel->bb_eof_count++;
     portEXIT_CRITICAL_ISR(&panel->spinlock);
-    return lcd_rgb_panel_fill_bounce_buffer(panel, panel->bounce_buffer[bb]);
+    return lcd_rgb_panel_fill_bounce_buffer(panel, panel->bounce_buffer[bb], panel->flags.bb_dma_copy);
+}
+
+static IRAM_ATTR bool lcd_rgb_panel_bb_copy_done_handler(gdma_channel_handle_t dma_chan, gdma_event_data_t *event_data, void *user_data)
+{
+    esp_rgb_panel_t *panel = (esp_rgb_panel_t *)user_data;
+    portENTER_CRITICAL_ISR(&panel->spinlock);
+    panel->flags.bb_copy_busy = false;
+    portEXIT_CRITICAL_ISR(&panel->spinlock);
+    return false;
+}
+
+static esp_err_t lcd_rgb_create_bb_copy_channel(esp_rgb_panel_t *panel)
+{
+    // TX and RX channels should reside in the same DMA pair, to do the memory copy
+    gdma_channel_alloc_config_t tx_alloc_config = {
+        .flags.reserve_sibling = 1,
+        .direction = GDMA_CHANNEL_DIRECTION_TX,
+    };
+    ESP_RETURN_ON_ERROR(gdma_new_ahb_channel(&tx_alloc_config, &panel->bb_copy_tx_chan), TAG, "alloc copy TX channel failed");
+    gdma_channel_alloc_config_t rx_alloc_config = {
+        .direction = GDMA_CHANNEL_DIRECTION_RX,
+        .sibling_chan = panel->bb_copy_tx_chan,
+    };
+    ESP_RETURN_ON_ERROR(gdma_new_ahb_channel(&rx_alloc_config, &panel->bb_copy_rx_chan), TAG, "alloc copy RX channel failed");
+
+    // get a free DMA trigger ID for memory copy
+    uint32_t free_m2m_id_mask = 0;
+    gdma_get_free_m2m_trig_id_mask(panel->bb_copy_tx_chan, &free_m2m_id_mask);
+    ESP_RETURN_ON_FALSE(free_m2m_id_mask, ESP_ERR_NOT_FOUND, TAG, "no free M2M trigger");
+    gdma_trigger_t m2m_trigger = GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_M2M, 0);
+    m2m_trigger.instance_id = __builtin_ctz(free_m2m_id_mask);
+    ESP_RETURN_ON_ERROR(gdma_connect(panel->bb_copy_rx_chan, m2m_trigger), TAG, "connect copy RX channel failed");
+    ESP_RETURN_ON_ERROR(gdma_connect(panel->bb_copy_tx_chan, m2m_trigger), TAG, "connect copy TX channel failed");
+
+    gdma_transfer_config_t trans_cfg = {
+        .max_data_burst_size = panel->dma_burst_size,
+        .access_ext_mem = true, // frame buffer was allocated from external memory
+    };
+    ESP_RETURN_ON_ERROR(gdma_config_transfer(panel->bb_copy_tx_chan, &trans_cfg), TAG, "config copy TX channel failed");
+    ESP_RETURN_ON_ERROR(gdma_config_transfer(panel->bb_copy_rx_chan, &trans_cfg), TAG, "config copy RX channel failed");
+
+    // the source offset in the frame buffer moves by the bounce buffer size, so the same alignment applies to the bounce buffer size
+    size_t tx_int_align = 0, tx_ext_align = 0, rx_int_align = 0, rx_ext_align = 0;
+    gdma_get_alignment_constraints(panel->bb_copy_tx_chan, &tx_int_align, &tx_ext_align);
+    gdma_get_alignment_constraints(panel->bb_copy_rx_chan, &rx_int_align, &rx_ext_align);
+    size_t align = MAX(MAX(tx_int_align, tx_ext_align), MAX(rx_int_align, rx_ext_align));
+    align = MAX(align, 4);
+    ESP_RETURN_ON_FALSE((panel->bb_size & (align - 1)) == 0, ESP_ERR_INVALID_ARG, TAG,
+                        "bounce buffer size must be aligned to %zu bytes for DMA copy", align);
+    panel->bb_copy_node_size = DMA_DESCRIPTOR_BUFFER_MAX_SIZE & ~(align - 1);
+
+    // one descriptor list for the source, and one for each bounce buffer
+    size_t num_nodes = (panel->bb_size + panel->bb_copy_node_size - 1) / panel->bb_copy_node_size;
+    panel->bb_copy_tx_nodes = heap_caps_calloc(num_nodes * (RGB_LCD_PANEL_BOUNCE_BUF_NUM + 1), sizeof(dma_descriptor_t),
+                                               MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    ESP_RETURN_ON_FALSE(panel->bb_copy_tx_nodes, ESP_ERR_NO_MEM, TAG, "no mem for copy DMA descriptors");
+    for (int i = 0; i < RGB_LCD_PANEL_BOUNCE_BUF_NUM; i++) {
+        panel->bb_copy_rx_nodes[i] = &panel->bb_copy_tx_nodes[num_nodes * (i + 1)];
+    }
+    for (int i = 0; i < RGB_LCD_PANEL_BOUNCE_BUF_NUM + 1; i++) {
+        dma_descriptor_t *nodes = &panel->bb_copy_tx_nodes[num_nodes * i];
+        for (size_t j = 0; j < num_nodes - 1; j++) {
+            nodes[j].next = &nodes[j + 1];
+        }
+        nodes[num_nodes - 1].next = NULL;
+    }
+    for (int i = 0; i < RGB_LCD_PANEL_BOUNCE_BUF_NUM; i++) {
+        lcd_rgb_panel_mount_copy_nodes(panel->bb_copy_rx_nodes[i], panel->bounce_buffer[i], panel->bb_size, panel->bb_copy_node_size);
+    }
+
+    gdma_rx_event_callbacks_t cbs = {
+        .on_recv_eof = lcd_rgb_panel_bb_copy_done_handler,
+    };
+    ESP_RETURN_ON_ERROR(gdma_register_rx_event_callbacks(panel->bb_copy_rx_chan, &cbs, panel), TAG, "register copy callback failed");
+    panel->flags.bb_dma_copy = true;
+    return ESP_OK;
 }
 
 static esp_err_t lcd_rgb_create_dma_channel(esp_rgb_panel_t *panel)
@@ -1081,13 +1222,21 @@ static IRAM_ATTR void lcd_rgb_panel_try_restart_transmission(esp_rgb_panel_t *pa
     }
 
     if (panel->bb_size) {
+        if (panel->flags.bb_dma_copy) {
+            // abort the pending copy, the bounce buffers are about to be filled by the CPU
+            gdma_reset(panel->bb_copy_tx_chan);
+            gdma_reset(panel->bb_copy_rx_chan);
+            portENTER_CRITICAL_ISR(&panel->spinlock);
+            panel->flags.bb_copy_busy = false;
+            portEXIT_CRITICAL_ISR(&panel->spinlock);
+        }
         // Catch de-synced frame buffer and reset if needed.
         if (panel->bounce_pos_px > bb_size_px * 2) {
             panel->bounce_pos_px = 0;
         }
         // Pre-fill bounce buffer 0, if the EOF ISR didn't do that already
         if (panel->bounce_pos_px < bb_size_px) {
-            lcd_rgb_panel_fill_bounce_buffer(panel, panel->bounce_buffer[0]);
+            lcd_rgb_panel_fill_bounce_buffer(panel, panel->bounce_buffer[0], false);
         }
     }
 
@@ -1098,7 +1247,7 @@ static IRAM_ATTR void lcd_rgb_panel_try_restart_transmission(esp_rgb_panel_t *pa
     if (panel->bb_size) {
         // Fill 2nd bounce buffer while 1st is being sent out, if needed.
         if (panel->bounce_pos_px < bb_size_px * 2) {
-            lcd_rgb_panel_fill_bounce_buffer(panel, panel->bounce_buffer[1]);
+            lcd_rgb_panel_fill_bounce_buffer(panel, panel->bounce_buffer[1], false);
         }
     }
 
@@ -1114,8 +1263,9 @@ static void lcd_rgb_panel_start_transmission(esp_rgb_panel_t *rgb_panel)
     // pre-fill bounce buffers if needed
     if (rgb_panel->bb_size) {
         rgb_panel->bounce_pos_px = 0;
-        lcd_rgb_panel_fill_bounce_buffer(rgb_panel, rgb_panel->bounce_buffer[0]);
-        lcd_rgb_panel_fill_bounce_buffer(rgb_panel, rgb_panel->bounce_buffer[1]);
+        // the first two bounce buffers must be ready before the LCD starts, so they're always copied by the CPU
+        lcd_rgb_panel_fill_bounce_buffer(rgb_panel, rgb_panel->bounce_buffer[0], false);
+        lcd_rgb_panel_fill_bounce_buffer(rgb_panel, rgb_panel->bounce_buffer[1], false);
     }
 
     // the start of DMA should be prior to the start of LCD engine
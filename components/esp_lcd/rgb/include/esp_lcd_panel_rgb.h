@@ -153,6 +153,10 @@ typedef struct {
                                               Instead, user should fill in the bounce buffer manually in the `on_bounce_empty` callback */
         uint32_t bb_invalidate_cache: 1; /*!< If this flag is enabled, in bounce back mode we'll do a cache invalidate on the read data, freeing the cache.
                                               Can be dangerous if data is written from other core(s). */
+        uint32_t bb_dma_copy: 1;         /*!< If this flag is enabled, in bounce buffer mode the frame buffer is copied to the bounce buffers by a GDMA memory copy channel,
+                                              instead of the CPU in the interrupt context. This frees the CPU, and allows a higher pixel clock.
+                                              The bounce buffer size must be aligned to the DMA alignment constraints.
+                                              If the frame buffer is modified directly (by `esp_lcd_rgb_panel_get_frame_buffer`), the cache must be written back by the user */
     } flags;                             /*!< LCD RGB panel configuration flags */
 } esp_lcd_rgb_panel_config_t;
 
@@ -58,6 +58,7 @@ typedef struct {
         unsigned int dc_param_level: 1;  // Indicates the level of DC line when transferring parameters
         unsigned int octal_mode: 1;      // Indicates whether the transmitting is enabled with octal mode (8 data lines)
         unsigned int quad_mode: 1;       // Indicates whether the transmitting is enabled with quad mode (4 data lines)
+        unsigned int queue_param: 1;     // Indicates whether the short commands and parameters are queued behind the color transactions
     } flags;
     lcd_spi_trans_descriptor_t trans_pool[]; // Transaction pool
 } esp_lcd_panel_io_spi_t;
@@ -104,6 +105,7 @@ esp_err_t esp_lcd_new_panel_io_spi(esp_lcd_spi_bus_handle_t bus, const esp_lcd_p
     spi_panel_io->flags.dc_param_level = !io_config->flags.dc_low_on_param;
     spi_panel_io->flags.octal_mode = io_config->flags.octal_mode;
     spi_panel_io->flags.quad_mode = io_config->flags.quad_mode;
+    spi_panel_io->flags.queue_param = io_config->flags.queue_param;
     spi_panel_io->on_color_trans_done = io_config->on_color_trans_done;
     spi_panel_io->user_ctx = io_config->user_ctx;
     spi_panel_io->lcd_cmd_bits = io_config->lcd_cmd_bits;
@@ -201,6 +203,64 @@ static void spi_lcd_prepare_param_buffer(esp_lcd_panel_io_spi_t *panel_io, const
     }
 }
 
+// get a transaction descriptor for the queue mode, recycle one from the done queue if the pool has used up
+static esp_err_t spi_lcd_get_queue_trans(esp_lcd_panel_io_spi_t *spi_panel_io, lcd_spi_trans_descriptor_t **ret_trans)
+{
+    spi_transaction_t *spi_trans = NULL;
+    lcd_spi_trans_descriptor_t *lcd_trans = NULL;
+    if (spi_panel_io->num_trans_inflight < spi_panel_io->queue_size) {
+        // get the next available transaction
+        lcd_trans = &spi_panel_io->trans_pool[spi_panel_io->num_trans_inflight];
+    } else {
+        // transaction pool has used up, recycle one transaction
+        ESP_RETURN_ON_ERROR(spi_device_get_trans_result(spi_panel_io->spi_dev, &spi_trans, portMAX_DELAY), TAG, "recycle spi transactions failed");
+        lcd_trans = __containerof(spi_trans, lcd_spi_trans_descriptor_t, base);
+        spi_panel_io->num_trans_inflight--;
+    }
+    memset(lcd_trans, 0, sizeof(lcd_spi_trans_descriptor_t));
+    *ret_trans = lcd_trans;
+    return ESP_OK;
+}
+
+// queue a command or parameter transaction, the data is copied into the descriptor, so the caller's buffer can be reused right away
+static esp_err_t spi_lcd_queue_short_trans(esp_lcd_panel_io_spi_t *spi_panel_io, const void *data, size_t data_bits,
+                                           unsigned int dc_level, bool keep_cs_active)
+{
+    lcd_spi_trans_descriptor_t *lcd_trans = NULL;
+    ESP_RETURN_ON_ERROR(spi_lcd_get_queue_trans(spi_panel_io, &lcd_trans), TAG, "get spi transaction failed");
+    lcd_trans->base.user = spi_panel_io;
+    lcd_trans->base.flags = SPI_TRANS_USE_TXDATA;
+    if (keep_cs_active) {
+        lcd_trans->base.flags |= SPI_TRANS_CS_KEEP_ACTIVE;
+    }
+    if (spi_panel_io->flags.octal_mode) {
+        // use 8 lines for transmitting command, address and data
+        lcd_trans->base.flags |= (SPI_TRANS_MULTILINE_CMD | SPI_TRANS_MULTILINE_ADDR | SPI_TRANS_MODE_OCT);
+    }
+    lcd_trans->flags.dc_gpio_level = dc_level;
+    lcd_trans->base.length = data_bits;
+    memcpy(lcd_trans->base.tx_data, data, (data_bits + 7) / 8);
+    ESP_RETURN_ON_ERROR(spi_device_queue_trans(spi_panel_io->spi_dev, &lcd_trans->base, portMAX_DELAY), TAG, "spi transmit (queue) failed");
+    spi_panel_io->num_trans_inflight++;
+    return ESP_OK;
+}
+
+static esp_err_t panel_io_spi_queue_param(esp_lcd_panel_io_spi_t *spi_panel_io, int lcd_cmd, const void *param, size_t param_size)
+{
+    bool send_param = (param && param_size);
+    if (lcd_cmd >= 0) {
+        spi_lcd_prepare_cmd_buffer(spi_panel_io, &lcd_cmd);
+        ESP_RETURN_ON_ERROR(spi_lcd_queue_short_trans(spi_panel_io, &lcd_cmd, spi_panel_io->lcd_cmd_bits,
+                                                      spi_panel_io->flags.dc_cmd_level, send_param), TAG, "queue command failed");
+    }
+    if (send_param) {
+        spi_lcd_prepare_param_buffer(spi_panel_io, param, param_size);
+        ESP_RETURN_ON_ERROR(spi_lcd_queue_short_trans(spi_panel_io, param, param_size * 8,
+                                                      spi_panel_io->flags.dc_param_level, false), TAG, "queue param failed");
+    }
+    return ESP_OK;
+}
+
 static esp_err_t panel_io_spi_tx_param(esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size)
 {
     esp_err_t ret = ESP_OK;
@@ -211,6 +271,11 @@ static esp_err_t panel_io_spi_tx_param(esp_lcd_panel_io_t *io, int lcd_cmd, cons
 
     ESP_RETURN_ON_ERROR(spi_device_acquire_bus(spi_panel_io->spi_dev, portMAX_DELAY), TAG, "acquire spi bus failed");
 
+    if (spi_panel_io->flags.queue_param && param_size <= sizeof(lcd_trans->base.tx_data)) {
+        ret = panel_io_spi_queue_param(spi_panel_io, lcd_cmd, param, param_size);
+        goto err;
+    }
+
     // before issue a polling transaction, need to wait queued transactions finished
     size_t num_trans_inflight = spi_panel_io->num_trans_inflight;
     for (size_t i = 0; i < num_trans_inflight; i++) {
@@ -322,7 +387,11 @@ static esp_err_t panel_io_spi_tx_color(esp_lcd_panel_io_t *io, int lcd_cmd, cons
     ESP_RETURN_ON_ERROR(spi_device_acquire_bus(spi_panel_io->spi_dev, portMAX_DELAY), TAG, "acquire spi bus failed");
 
     bool send_cmd = (lcd_cmd >= 0);
-    if (send_cmd) {
+    if (send_cmd && spi_panel_io->flags.queue_param) {
+        spi_lcd_prepare_cmd_buffer(spi_panel_io, &lcd_cmd);
+        ret = spi_lcd_queue_short_trans(spi_panel_io, &lcd_cmd, spi_panel_io->lcd_cmd_bits, spi_panel_io->flags.dc_cmd_level, color && color_size);
+        ESP_GOTO_ON_ERROR(ret, err, TAG, "queue command failed");
+    } else if (send_cmd) {
         // before issue a polling transaction, need to wait queued transactions finished
         size_t num_trans_inflight = spi_panel_io->num_trans_inflight;
         for (size_t i = 0; i < num_trans_inflight; i++) {
@@ -354,17 +423,8 @@ static esp_err_t panel_io_spi_tx_color(esp_lcd_panel_io_t *io, int lcd_cmd, cons
     do {
         size_t chunk_size = color_size;
 
-        if (spi_panel_io->num_trans_inflight < spi_panel_io->queue_size) {
-            // get the next available transaction
-            lcd_trans = &spi_panel_io->trans_pool[spi_panel_io->num_trans_inflight];
-        } else {
-            // transaction pool has used up, recycle one transaction
-            ret = spi_device_get_trans_result(spi_panel_io->spi_dev, &spi_trans, portMAX_DELAY);
-            ESP_GOTO_ON_ERROR(ret, err, TAG, "recycle spi transactions failed");
-            lcd_trans = __containerof(spi_trans, lcd_spi_trans_descriptor_t, base);
-            spi_panel_io->num_trans_inflight--;
-        }
-        memset(lcd_trans, 0, sizeof(lcd_spi_trans_descriptor_t));
+        ret = spi_lcd_get_queue_trans(spi_panel_io, &lcd_trans);
+        ESP_GOTO_ON_ERROR(ret, err, TAG, "get spi transaction failed");
 
         // SPI per-transfer size has its limitation, if the color buffer is too big, we need to split it into multiple chunks
         if (chunk_size > spi_panel_io->spi_trans_max_bytes) {
@@ -21,10 +21,11 @@ static const char *TAG = "async_fbcpy";
 
 typedef struct esp_async_fbcpy_context_t {
     dma2d_pool_handle_t client;  // DMA2D client
-    dma2d_descriptor_t* tx_desc; // DMA2D TX descriptor
-    dma2d_descriptor_t* rx_desc; // DMA2D RX descriptor
+    dma2d_descriptor_t* tx_desc; // DMA2D TX descriptors, one per copy in a batch
+    dma2d_descriptor_t* rx_desc; // DMA2D RX descriptors, one per copy in a batch
     dma2d_trans_t* trans_desc;   // DMA2D transaction descriptor
     size_t dma_desc_size;        // DMA2D descriptor size
+    size_t max_batch_size;       // Number of the allocated TX and RX descriptors
     esp_async_fbcpy_event_callback_t memcpy_done_cb; // memory copy done callback
     void *cb_args;                       // callback arguments
 } esp_async_fbcpy_context_t;
@@ -68,12 +69,14 @@ esp_err_t esp_async_fbcpy_install(const esp_async_fbcpy_config_t *config, esp_as
     uint32_t data_cache_line_size = cache_hal_get_cache_line_size(CACHE_LL_LEVEL_INT_MEM, CACHE_TYPE_DATA);
     size_t alignment = MAX(DMA2D_LL_DESC_ALIGNMENT, data_cache_line_size);
     size_t dma_desc_mem_size = ALIGN_UP(sizeof(dma2d_descriptor_align8_t), alignment);
-    dma_tx_desc = heap_caps_aligned_calloc(alignment, 1, dma_desc_mem_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
-    dma_rx_desc = heap_caps_aligned_calloc(alignment, 1, dma_desc_mem_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    size_t max_batch_size = MAX(config->max_batch_size, 1);
+    dma_tx_desc = heap_caps_aligned_calloc(alignment, max_batch_size, dma_desc_mem_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    dma_rx_desc = heap_caps_aligned_calloc(alignment, max_batch_size, dma_desc_mem_size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
     ESP_GOTO_ON_FALSE(dma_tx_desc && dma_rx_desc, ESP_ERR_NO_MEM, err, TAG, "no memory for DMA2D descriptors");
     ctx->tx_desc = dma_tx_desc;
     ctx->rx_desc = dma_rx_desc;
     ctx->dma_desc_size = dma_desc_mem_size;
+    ctx->max_batch_size = max_batch_size;
 
     // initialize DMA2D client
     dma2d_pool_config_t dma2d_client_config = {}; // all follow default configurations
@@ -96,43 +99,49 @@ esp_err_t esp_async_fbcpy_uninstall(esp_async_fbcpy_handle_t mcp)
     return async_fbcpy_del_context(mcp);
 }
 
-static void async_memcpy_setup_dma2d_descriptor(esp_async_fbcpy_context_t* mcp_ctx, esp_async_fbcpy_trans_desc_t* transaction)
+static void async_memcpy_setup_dma2d_descriptor(esp_async_fbcpy_context_t* mcp_ctx, const esp_async_fbcpy_trans_desc_t* transactions, size_t num_trans)
 {
-    dma2d_descriptor_t* tx_desc = mcp_ctx->tx_desc;
-    dma2d_descriptor_t* rx_desc = mcp_ctx->rx_desc;
     size_t dma_desc_size = mcp_ctx->dma_desc_size;
-    uint8_t dma2d_pbyte = dma2d_desc_pixel_format_to_pbyte_value(transaction->pixel_format_unique_id);
-
-    tx_desc->buffer = (void*)transaction->src_buffer;
-    tx_desc->next = NULL;
-    tx_desc->dma2d_en = 1;
-    tx_desc->suc_eof = 1;
-    tx_desc->ha_length = transaction->src_buffer_size_x;
-    tx_desc->va_size = transaction->src_buffer_size_y;
-    tx_desc->hb_length = transaction->copy_size_x;
-    tx_desc->vb_size = transaction->copy_size_y;
-    tx_desc->x = transaction->src_offset_x;
-    tx_desc->y = transaction->src_offset_y;
-    tx_desc->pbyte = dma2d_pbyte;
-    tx_desc->mode = DMA2D_DESCRIPTOR_BLOCK_RW_MODE_SINGLE;
-    tx_desc->owner = DMA2D_DESCRIPTOR_BUFFER_OWNER_DMA;
-
-    rx_desc->buffer = transaction->dst_buffer;
-    rx_desc->next = NULL;
-    rx_desc->dma2d_en = 1;
-    rx_desc->suc_eof = 1;
-    rx_desc->ha_length = transaction->dst_buffer_size_x;
-    rx_desc->va_size = transaction->dst_buffer_size_y;
-    rx_desc->hb_length = transaction->copy_size_x;
-    rx_desc->vb_size = transaction->copy_size_y;
-    rx_desc->x = transaction->dst_offset_x;
-    rx_desc->y = transaction->dst_offset_y;
-    rx_desc->pbyte = dma2d_pbyte;
-    rx_desc->mode = DMA2D_DESCRIPTOR_BLOCK_RW_MODE_SINGLE;
-    rx_desc->owner = DMA2D_DESCRIPTOR_BUFFER_OWNER_DMA;
-
-    esp_cache_msync(tx_desc, dma_desc_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE);
-    esp_cache_msync(rx_desc, dma_desc_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE);
+
+    // the copies are chained as successive 2D blocks, only the last one ends the transaction
+    for (size_t i = 0; i < num_trans; i++) {
+        const esp_async_fbcpy_trans_desc_t *transaction = &transactions[i];
+        dma2d_descriptor_t* tx_desc = (dma2d_descriptor_t *)((uint8_t *)mcp_ctx->tx_desc + i * dma_desc_size);
+        dma2d_descriptor_t* rx_desc = (dma2d_descriptor_t *)((uint8_t *)mcp_ctx->rx_desc + i * dma_desc_size);
+        bool is_last = (i == num_trans - 1);
+        uint8_t dma2d_pbyte = dma2d_desc_pixel_format_to_pbyte_value(transaction->pixel_format_unique_id);
+
+        tx_desc->buffer = (void*)transaction->src_buffer;
+        tx_desc->next = is_last ? NULL : (dma2d_descriptor_t *)((uint8_t *)tx_desc + dma_desc_size);
+        tx_desc->dma2d_en = 1;
+        tx_desc->suc_eof = is_last;
+        tx_desc->ha_length = transaction->src_buffer_size_x;
+        tx_desc->va_size = transaction->src_buffer_size_y;
+        tx_desc->hb_length = transaction->copy_size_x;
+        tx_desc->vb_size = transaction->copy_size_y;
+        tx_desc->x = transaction->src_offset_x;
+        tx_desc->y = transaction->src_offset_y;
+        tx_desc->pbyte = dma2d_pbyte;
+        tx_desc->mode = DMA2D_DESCRIPTOR_BLOCK_RW_MODE_SINGLE;
+        tx_desc->owner = DMA2D_DESCRIPTOR_BUFFER_OWNER_DMA;
+
+        rx_desc->buffer = transaction->dst_buffer;
+        rx_desc->next = is_last ? NULL : (dma2d_descriptor_t *)((uint8_t *)rx_desc + dma_desc_size);
+        rx_desc->dma2d_en = 1;
+        rx_desc->suc_eof = is_last;
+        rx_desc->ha_length = transaction->dst_buffer_size_x;
+        rx_desc->va_size = transaction->dst_buffer_size_y;
+        rx_desc->hb_length = transaction->copy_size_x;
+        rx_desc->vb_size = transaction->copy_size_y;
+        rx_desc->x = transaction->dst_offset_x;
+        rx_desc->y = transaction->dst_offset_y;
+        rx_desc->pbyte = dma2d_pbyte;
+        rx_desc->mode = DMA2D_DESCRIPTOR_BLOCK_RW_MODE_SINGLE;
+        rx_desc->owner = DMA2D_DESCRIPTOR_BUFFER_OWNER_DMA;
+    }
+
+    esp_cache_msync(mcp_ctx->tx_desc, num_trans * dma_desc_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE);
+    esp_cache_msync(mcp_ctx->rx_desc, num_trans * dma_desc_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE);
 }
 
 static bool dma2d_memcpy_done_cb(dma2d_channel_handle_t dma2d_chan, dma2d_event_data_t *event_data, void *user_data)
@@ -182,14 +191,16 @@ static bool dma2d_job_picked_cb(uint32_t num_chans, const dma2d_trans_channel_in
     return false;
 }
 
-esp_err_t esp_async_fbcpy(esp_async_fbcpy_handle_t mcp, esp_async_fbcpy_trans_desc_t* transaction, esp_async_fbcpy_event_callback_t memcpy_done_cb, void *cb_args)
+esp_err_t esp_async_fbcpy_batch(esp_async_fbcpy_handle_t mcp, const esp_async_fbcpy_trans_desc_t *transactions, size_t num_trans,
+                                esp_async_fbcpy_event_callback_t memcpy_done_cb, void *cb_args)
 {
-    ESP_RETURN_ON_FALSE(mcp && transaction, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(mcp && transactions && num_trans, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(num_trans <= mcp->max_batch_size, ESP_ERR_INVALID_ARG, TAG, "batch size exceeds %zu", mcp->max_batch_size);
     mcp->memcpy_done_cb = memcpy_done_cb;
     mcp->cb_args = cb_args;
 
-    // mount the data to the DMA descriptor
-    async_memcpy_setup_dma2d_descriptor(mcp, transaction);
+    // mount the data to the DMA descriptors
+    async_memcpy_setup_dma2d_descriptor(mcp, transactions, num_trans);
 
     // submit the DMA2D request
     static dma2d_trans_config_t dma2d_trans_conf = {
@@ -197,8 +208,16 @@ esp_err_t esp_async_fbcpy(esp_async_fbcpy_handle_t mcp, esp_async_fbcpy_trans_de
         .rx_channel_num = 1,
         .channel_flags = DMA2D_CHANNEL_FUNCTION_FLAG_SIBLING,
         .on_job_picked = dma2d_job_picked_cb,
+        // frame buffer copies feed the display refresh, don't let them wait behind PPA or JPEG jobs
+        .priority = DMA2D_TRANS_PRIORITY_HIGH,
+        .client = DMA2D_CLIENT_LCD,
     };
     dma2d_trans_conf.user_config = mcp;
     ESP_RETURN_ON_ERROR(dma2d_enqueue(mcp->client, &dma2d_trans_conf, mcp->trans_desc), TAG, "DMA2D enqueue failed");
     return ESP_OK;
 }
+
+esp_err_t esp_async_fbcpy(esp_async_fbcpy_handle_t mcp, esp_async_fbcpy_trans_desc_t* transaction, esp_async_fbcpy_event_callback_t memcpy_done_cb, void *cb_args)
+{
+    return esp_async_fbcpy_batch(mcp, transaction, 1, memcpy_done_cb, cb_args);
+}
@@ -242,3 +242,108 @@ TEST_CASE("MIPI DSI with multiple frame buffers (ILI9881C)", "[mipi_dsi]")
 
     test_bsp_disable_dsi_phy_power();
 }
+
+#define TEST_DIRTY_REGIONS   4
+#define TEST_REGION_SIZE     64
+
+TEST_CASE("MIPI DSI draw dirty regions with frame buffer swap (ILI9881C)", "[mipi_dsi]")
+{
+    esp_lcd_dsi_bus_handle_t mipi_dsi_bus;
+    esp_lcd_panel_io_handle_t mipi_dbi_io;
+    esp_lcd_panel_handle_t mipi_dpi_panel;
+    esp_lcd_panel_handle_t ili9881c_ctrl_panel;
+
+    test_bsp_enable_dsi_phy_power();
+
+    uint16_t *region_bufs[TEST_DIRTY_REGIONS];
+    for (int i = 0; i < TEST_DIRTY_REGIONS; i++) {
+        region_bufs[i] = malloc(TEST_REGION_SIZE * TEST_REGION_SIZE * sizeof(uint16_t));
+        TEST_ASSERT_NOT_NULL(region_bufs[i]);
+    }
+
+    esp_lcd_dsi_bus_config_t bus_config = {
+        .bus_id = 0,
+        .num_data_lanes = 2,
+        .phy_clk_src = MIPI_DSI_PHY_CLK_SRC_DEFAULT,
+        .lane_bit_rate_mbps = 1000, // 1000 Mbps
+    };
+    TEST_ESP_OK(esp_lcd_new_dsi_bus(&bus_config, &mipi_dsi_bus));
+
+    esp_lcd_dbi_io_config_t dbi_config = {
+        .virtual_channel = 0,
+        .lcd_cmd_bits = 8,
+        .lcd_param_bits = 8,
+    };
+    TEST_ESP_OK(esp_lcd_new_panel_io_dbi(mipi_dsi_bus, &dbi_config, &mipi_dbi_io));
+
+    esp_lcd_panel_dev_config_t lcd_dev_config = {
+        .bits_per_pixel = 16,
+        .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
+        .reset_gpio_num = -1,
+    };
+    TEST_ESP_OK(esp_lcd_new_panel_ili9881c(mipi_dbi_io, &lcd_dev_config, &ili9881c_ctrl_panel));
+    TEST_ESP_OK(esp_lcd_panel_reset(ili9881c_ctrl_panel));
+    TEST_ESP_OK(esp_lcd_panel_init(ili9881c_ctrl_panel));
+    // turn on display
+    TEST_ESP_OK(esp_lcd_panel_disp_on_off(ili9881c_ctrl_panel, true));
+
+    esp_lcd_dpi_panel_config_t dpi_config = {
+        .dpi_clk_src = MIPI_DSI_DPI_CLK_SRC_DEFAULT,
+        .dpi_clock_freq_mhz = MIPI_DSI_DPI_CLK_MHZ,
+        .virtual_channel = 0,
+        .pixel_format = LCD_COLOR_PIXEL_FORMAT_RGB565,
+        .num_fbs = 2,
+        .max_dirty_regions = TEST_DIRTY_REGIONS,
+        .video_timing = {
+            .h_size = MIPI_DSI_LCD_H_RES,
+            .v_size = MIPI_DSI_LCD_V_RES,
+            .hsync_back_porch = MIPI_DSI_LCD_HBP,
+            .hsync_pulse_width = MIPI_DSI_LCD_HSYNC,
+            .hsync_front_porch = MIPI_DSI_LCD_HFP,
+            .vsync_back_porch = MIPI_DSI_LCD_VBP,
+            .vsync_pulse_width = MIPI_DSI_LCD_VSYNC,
+            .vsync_front_porch = MIPI_DSI_LCD_VFP,
+        },
+        .flags.use_dma2d = true,
+    };
+    TEST_ESP_OK(esp_lcd_new_panel_dpi(mipi_dsi_bus, &dpi_config, &mipi_dpi_panel));
+    TEST_ESP_OK(esp_lcd_panel_init(mipi_dpi_panel));
+
+    esp_lcd_dpi_panel_region_t regions[TEST_DIRTY_REGIONS + 1];
+    // nothing drawn yet, the swap is a no-op
+    TEST_ESP_OK(esp_lcd_dpi_panel_swap_frame_buffer(mipi_dpi_panel, 100));
+
+    for (int frame = 0; frame < 100; frame++) {
+        for (int i = 0; i < TEST_DIRTY_REGIONS; i++) {
+            uint16_t color = rand() & 0xFFFF;
+            for (int j = 0; j < TEST_REGION_SIZE * TEST_REGION_SIZE; j++) {
+                region_bufs[i][j] = color;
+            }
+            regions[i] = (esp_lcd_dpi_panel_region_t) {
+                .x_start = rand() % (MIPI_DSI_LCD_H_RES - TEST_REGION_SIZE),
+                .y_start = rand() % (MIPI_DSI_LCD_V_RES - TEST_REGION_SIZE),
+                .color_data = region_bufs[i],
+            };
+            regions[i].x_end = regions[i].x_start + TEST_REGION_SIZE;
+            regions[i].y_end = regions[i].y_start + TEST_REGION_SIZE;
+        }
+        TEST_ESP_OK(esp_lcd_dpi_panel_draw_regions(mipi_dpi_panel, regions, TEST_DIRTY_REGIONS));
+        // waits for the copies, then for the end of the frame being scanned out
+        TEST_ESP_OK(esp_lcd_dpi_panel_swap_frame_buffer(mipi_dpi_panel, 100));
+    }
+
+    // regions must fit in the screen, and not exceed the configured number
+    regions[0].x_end = MIPI_DSI_LCD_H_RES + 1;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_lcd_dpi_panel_draw_regions(mipi_dpi_panel, regions, 1));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_lcd_dpi_panel_draw_regions(mipi_dpi_panel, regions, TEST_DIRTY_REGIONS + 1));
+
+    TEST_ESP_OK(esp_lcd_panel_del(mipi_dpi_panel));
+    TEST_ESP_OK(esp_lcd_panel_del(ili9881c_ctrl_panel));
+    TEST_ESP_OK(esp_lcd_panel_io_del(mipi_dbi_io));
+    TEST_ESP_OK(esp_lcd_del_dsi_bus(mipi_dsi_bus));
+    for (int i = 0; i < TEST_DIRTY_REGIONS; i++) {
+        free(region_bufs[i]);
+    }
+
+    test_bsp_disable_dsi_phy_power();
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -21,7 +21,7 @@
 #define TEST_SPI_HOST_ID  SPI2_HOST
 
 void test_spi_lcd_common_initialize(esp_lcd_panel_io_handle_t *io_handle, esp_lcd_panel_io_color_trans_done_cb_t on_color_trans_done,
-                                    void *user_data, int cmd_bits, int param_bits, bool oct_mode)
+                                    void *user_data, int cmd_bits, int param_bits, bool oct_mode, bool queue_param)
 {
     // turn off backlight
     gpio_config_t bk_gpio_config = {
@@ -63,6 +63,7 @@ void test_spi_lcd_common_initialize(esp_lcd_panel_io_handle_t *io_handle, esp_lc
         .lcd_param_bits = param_bits,
         .on_color_trans_done = on_color_trans_done,
         .user_ctx = user_data,
+        .flags.queue_param = queue_param,
     };
 #if SOC_SPI_SUPPORT_OCT
     if (oct_mode) {
@@ -124,7 +125,7 @@ static void lcd_panel_test(esp_lcd_panel_io_handle_t io_handle, esp_lcd_panel_ha
 TEST_CASE("lcd_panel_spi_io_test", "[lcd]")
 {
     esp_lcd_panel_io_handle_t io_handle = NULL;
-    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, false);
+    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, false, false);
     esp_lcd_panel_io_tx_param(io_handle, 0x1A, NULL, 0);
     esp_lcd_panel_io_tx_param(io_handle, 0x1B, (uint8_t[]) {
         0x11, 0x22, 0x33
@@ -133,7 +134,7 @@ TEST_CASE("lcd_panel_spi_io_test", "[lcd]")
     TEST_ESP_OK(esp_lcd_panel_io_del(io_handle));
     TEST_ESP_OK(spi_bus_free(TEST_SPI_HOST_ID));
 
-    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 16, 16, false);
+    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 16, 16, false, false);
     esp_lcd_panel_io_tx_param(io_handle, 0x1A01, NULL, 0);
     esp_lcd_panel_io_tx_param(io_handle, 0x1B02, (uint16_t[]) {
         0x11, 0x22, 0x33
@@ -143,7 +144,7 @@ TEST_CASE("lcd_panel_spi_io_test", "[lcd]")
     TEST_ESP_OK(spi_bus_free(TEST_SPI_HOST_ID));
 
 #if SOC_SPI_SUPPORT_OCT
-    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, true);
+    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, true, false);
     esp_lcd_panel_io_tx_param(io_handle, 0x1A, NULL, 0);
     esp_lcd_panel_io_tx_param(io_handle, 0x1B, (uint8_t[]) {
         0x11, 0x22, 0x33
@@ -152,7 +153,7 @@ TEST_CASE("lcd_panel_spi_io_test", "[lcd]")
     TEST_ESP_OK(esp_lcd_panel_io_del(io_handle));
     TEST_ESP_OK(spi_bus_free(TEST_SPI_HOST_ID));
 
-    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 16, 16, true);
+    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 16, 16, true, false);
     esp_lcd_panel_io_tx_param(io_handle, 0x1A01, NULL, 0);
     esp_lcd_panel_io_tx_param(io_handle, 0x1B02, (uint16_t[]) {
         0x11, 0x22, 0x33
@@ -168,7 +169,7 @@ TEST_CASE("lcd_panel_with_8-line_spi_interface_(st7789)", "[lcd]")
 {
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
-    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, true);
+    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, true, false);
     esp_lcd_panel_dev_config_t panel_config = {
         .reset_gpio_num = TEST_LCD_RST_GPIO,
         .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
@@ -182,7 +183,7 @@ TEST_CASE("lcd_panel_with_8-line_spi_interface_(nt35510)", "[lcd]")
 {
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
-    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 16, 16, true);
+    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 16, 16, true, false);
     esp_lcd_panel_dev_config_t panel_config = {
         .reset_gpio_num = TEST_LCD_RST_GPIO,
         .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
@@ -197,7 +198,7 @@ TEST_CASE("lcd_panel_with_1-line_spi_interface_(st7789)", "[lcd]")
 {
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
-    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, false);
+    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, false, false);
     esp_lcd_panel_dev_config_t panel_config = {
         .reset_gpio_num = TEST_LCD_RST_GPIO,
         .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
@@ -221,7 +222,7 @@ TEST_CASE("spi_lcd_send_colors_to_fixed_region", "[lcd]")
 
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
-    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, false);
+    test_spi_lcd_common_initialize(&io_handle, NULL, NULL, 8, 8, false, false);
 
     // we don't use the panel handle in this test, creating the panel just for a quick initialization
     esp_lcd_panel_dev_config_t panel_config = {
@@ -276,3 +277,62 @@ TEST_CASE("spi_lcd_send_colors_to_fixed_region", "[lcd]")
     TEST_ESP_OK(spi_bus_free(TEST_SPI_HOST_ID));
     free(color_data);
 }
+
+#define TEST_TILE_SIZE   20
+#define TEST_TILE_NUM    100
+
+static bool test_spi_lcd_tile_done(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+    uint32_t *done_count = (uint32_t *)user_ctx;
+    (*done_count)++;
+    return false;
+}
+
+TEST_CASE("lcd_panel_spi_queue_param_small_tiles_(st7789)", "[lcd]")
+{
+    // each tile has its own buffer, so the tiles can be queued back to back without waiting
+    size_t tile_bytes = TEST_TILE_SIZE * TEST_TILE_SIZE * sizeof(uint16_t);
+    uint8_t *tiles = heap_caps_malloc(tile_bytes * TEST_TILE_NUM, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(tiles);
+    for (int i = 0; i < TEST_TILE_NUM; i++) {
+        memset(tiles + i * tile_bytes, rand() & 0xFF, tile_bytes);
+    }
+
+    volatile uint32_t done_count = 0;
+    esp_lcd_panel_io_handle_t io_handle = NULL;
+    esp_lcd_panel_handle_t panel_handle = NULL;
+    test_spi_lcd_common_initialize(&io_handle, test_spi_lcd_tile_done, (void *)&done_count, 8, 8, false, true);
+    esp_lcd_panel_dev_config_t panel_config = {
+        .reset_gpio_num = TEST_LCD_RST_GPIO,
+        .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
+        .bits_per_pixel = 16,
+    };
+    TEST_ESP_OK(esp_lcd_new_panel_st7789(io_handle, &panel_config, &panel_handle));
+    esp_lcd_panel_reset(panel_handle);
+    esp_lcd_panel_init(panel_handle);
+    esp_lcd_panel_invert_color(panel_handle, true);
+    esp_lcd_panel_set_gap(panel_handle, 0, 20);
+    esp_lcd_panel_disp_on_off(panel_handle, true);
+    gpio_set_level(TEST_LCD_BK_LIGHT_GPIO, 1);
+
+    for (int round = 0; round < 5; round++) {
+        done_count = 0;
+        for (int i = 0; i < TEST_TILE_NUM; i++) {
+            int x_start = (i % 10) * TEST_TILE_SIZE;
+            int y_start = (i / 10) * TEST_TILE_SIZE;
+            TEST_ESP_OK(esp_lcd_panel_draw_bitmap(panel_handle, x_start, y_start, x_start + TEST_TILE_SIZE,
+                                                  y_start + TEST_TILE_SIZE, tiles + i * tile_bytes));
+        }
+        // the tiles are still in flight, wait for the last one to be flushed
+        for (int i = 0; i < 100 && done_count < TEST_TILE_NUM; i++) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+        TEST_ASSERT_EQUAL(TEST_TILE_NUM, done_count);
+    }
+
+    TEST_ESP_OK(esp_lcd_panel_del(panel_handle));
+    TEST_ESP_OK(esp_lcd_panel_io_del(io_handle));
+    TEST_ESP_OK(spi_bus_free(TEST_SPI_HOST_ID));
+    TEST_ESP_OK(gpio_reset_pin(TEST_LCD_BK_LIGHT_GPIO));
+    free(tiles);
+}
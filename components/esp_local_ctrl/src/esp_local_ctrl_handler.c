@@ -12,6 +12,7 @@
 #include "esp_compiler.h"
 #include "esp_local_ctrl.h"
 #include "esp_local_ctrl_priv.h"
+#include "protocomm_arena.h"
 #include "esp_local_ctrl.pb-c.h"
 
 #define SAFE_ALLOCATION(type, var)                  \
@@ -251,7 +252,8 @@ esp_err_t esp_local_ctrl_data_handler(uint32_t session_id, const uint8_t *inbuf,
                                       uint8_t **outbuf, ssize_t *outlen, void *priv_data)
 {
     void *temp_ctx = NULL;
-    LocalCtrlMessage *req = local_ctrl_message__unpack(NULL, inlen, inbuf);
+    PROTOCOMM_ARENA_DECLARE(arena);
+    LocalCtrlMessage *req = local_ctrl_message__unpack(&arena.allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack payload data");
         return ESP_ERR_INVALID_ARG;
@@ -265,11 +267,11 @@ esp_err_t esp_local_ctrl_data_handler(uint32_t session_id, const uint8_t *inbuf,
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "command dispatcher failed");
         esp_local_ctrl_command_cleanup(&resp, &temp_ctx);
-        local_ctrl_message__free_unpacked(req, NULL);
+        local_ctrl_message__free_unpacked(req, &arena.allocator);
         return ESP_FAIL;
     }
 
-    local_ctrl_message__free_unpacked(req, NULL);
+    local_ctrl_message__free_unpacked(req, &arena.allocator);
 
     *outlen = local_ctrl_message__get_packed_size(&resp);
     if (*outlen <= 0) {
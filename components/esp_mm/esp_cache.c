@@ -27,6 +27,18 @@ static const char *TAG = "cache";
 
 #define ALIGN_UP_BY(num, align) (((num) + ((align) - 1)) & ~((align) - 1))
 
+#if SOC_CACHE_PRELOAD_SUPPORTED
+//interrupts are only disabled during the preload of one chunk
+#define CACHE_PRELOAD_CHUNK_LEN    0x1000
+#if CONFIG_IDF_TARGET_ESP32S2
+#define CACHE_PRELOAD_MAX_LEN      CONFIG_ESP32S2_DATA_CACHE_SIZE
+#elif CONFIG_IDF_TARGET_ESP32S3
+#define CACHE_PRELOAD_MAX_LEN      CONFIG_ESP32S3_DATA_CACHE_SIZE
+#elif CONFIG_IDF_TARGET_ESP32P4
+#define CACHE_PRELOAD_MAX_LEN      0x10000     //L1 DCache size
+#endif
+#endif
+
 DEFINE_CRIT_SECTION_LOCK_STATIC(s_spinlock);
 #if CONFIG_ESP_MM_CACHE_MSYNC_C2M_CHUNKED_OPS
 static _lock_t s_mutex;
@@ -147,6 +159,72 @@ esp_err_t esp_cache_msync(void *addr, size_t size, int flags)
     return ESP_OK;
 }
 
+esp_err_t esp_cache_prefetch(const void *addr, size_t size)
+{
+    ESP_RETURN_ON_FALSE_ISR(addr, ESP_ERR_INVALID_ARG, TAG, "null pointer");
+
+    uint32_t addr_end = 0;
+    bool ovf = __builtin_add_overflow((uint32_t)addr, size, &addr_end);
+    ESP_RETURN_ON_FALSE_ISR(!ovf, ESP_ERR_INVALID_ARG, TAG, "wrong size, total size overflow");
+
+    uint32_t vaddr = (uint32_t)addr;
+    uint32_t cache_level = 0;
+    uint32_t cache_id = 0;
+    bool valid = cache_hal_vaddr_to_cache_level_id(vaddr, size, &cache_level, &cache_id);
+    ESP_RETURN_ON_FALSE_ISR(valid, ESP_ERR_INVALID_ARG, TAG, "invalid addr or null pointer");
+
+#if SOC_CACHE_PRELOAD_SUPPORTED
+    uint32_t cache_line_size = cache_hal_get_cache_line_size(cache_level, CACHE_TYPE_DATA);
+    uint32_t start = vaddr & ~(cache_line_size - 1);
+    uint32_t len = MIN(ALIGN_UP_BY(addr_end, cache_line_size) - start, CACHE_PRELOAD_MAX_LEN);
+
+    s_acquire_mutex_from_task_context();
+    for (uint32_t offset = 0; offset < len; offset += CACHE_PRELOAD_CHUNK_LEN) {
+        uint32_t chunk_len = MIN(len - offset, CACHE_PRELOAD_CHUNK_LEN);
+        esp_os_enter_critical_safe(&s_spinlock);
+        valid &= cache_hal_preload_addr(start + offset, chunk_len);
+        esp_os_exit_critical_safe(&s_spinlock);
+    }
+    s_release_mutex_from_task_context();
+    assert(valid);
+#endif  //#if SOC_CACHE_PRELOAD_SUPPORTED
+
+    return ESP_OK;
+}
+
+esp_err_t esp_cache_sample_counters(esp_cache_counters_t *counters)
+{
+    ESP_RETURN_ON_FALSE_ISR(counters, ESP_ERR_INVALID_ARG, TAG, "null pointer");
+
+#if SOC_CACHE_ACCESS_COUNTER_SUPPORTED
+    static bool s_counters_started;
+    cache_access_counters_t hw_counters = {};
+
+    esp_os_enter_critical_safe(&s_spinlock);
+    if (s_counters_started) {
+        cache_ll_l1_get_access_counters(&hw_counters);
+        cache_ll_l1_clear_access_counters();
+    } else {
+        //the counted address ranges aren't set up by default
+        cache_ll_l1_init_access_counters();
+        s_counters_started = true;
+    }
+    esp_os_exit_critical_safe(&s_spinlock);
+
+    *counters = (esp_cache_counters_t) {
+        .inst_access = hw_counters.ibus_access,
+        .inst_miss = hw_counters.ibus_miss,
+        .data_access = hw_counters.dbus_access,
+        .data_flash_miss = hw_counters.dbus_flash_miss,
+        .data_psram_miss = hw_counters.dbus_psram_miss,
+        .psram_fill_bytes = hw_counters.dbus_psram_miss * cache_hal_get_cache_line_size(CACHE_LL_LEVEL_EXT_MEM, CACHE_TYPE_DATA),
+    };
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif  //#if SOC_CACHE_ACCESS_COUNTER_SUPPORTED
+}
+
 //The esp_cache_aligned_malloc function is marked deprecated but also called by other
 //(also deprecated) functions in this file. In order to work around that generating warnings, it's
 //split into a non-deprecated internal function and the stubbed external deprecated function.
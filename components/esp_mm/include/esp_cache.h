@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -79,6 +79,74 @@ extern "C" {
  */
 esp_err_t esp_cache_msync(void *addr, size_t size, int flags);
 
+/**
+ * @brief Prefetch a memory region into the data cache
+ *
+ * Fill the data cache with the content of the region in one burst, so that the following accesses to the region hit
+ * the cache instead of stalling the CPU on every cache line. This is useful before processing a buffer in PSRAM,
+ * e.g. a tile of an image.
+ *
+ * - For cache preload supported chips (you can refer to SOC_CACHE_PRELOAD_SUPPORTED in soc_caps.h), this API returns
+ *   after the region is in the cache. At most the size of the data cache is prefetched, from the start of the region
+ * - For other chips, this API will do nothing, the region is fetched on demand
+ *
+ * This API is cache-safe and thread-safe
+ *
+ * @note The region is extended to whole cache lines, there is no alignment requirement
+ * @note To keep a streamed buffer from evicting other data, write it back and invalidate it after use, by
+ *       `esp_cache_msync` with `ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE`
+ * @note You should not call this during any Flash operations (e.g. esp_flash APIs, nvs and some other APIs that are based on esp_flash APIs)
+ *
+ * @param[in] addr  Starting address to prefetch
+ * @param[in] size  Size to prefetch
+ *
+ * @return
+ *        - ESP_OK:                Successful prefetch, or prefetch isn't supported by this chip
+ *        - ESP_ERR_INVALID_ARG:   Invalid argument, not cache supported addr, see printed logs
+ */
+esp_err_t esp_cache_prefetch(const void *addr, size_t size);
+
+/**
+ * @brief Cache access statistics, see `esp_cache_sample_counters`
+ */
+typedef struct {
+    uint32_t inst_access;       /*!< Number of instruction fetches through the cache */
+    uint32_t inst_miss;         /*!< Number of instruction fetches which missed the cache, from flash or PSRAM */
+    uint32_t data_access;       /*!< Number of data accesses through the cache */
+    uint32_t data_flash_miss;   /*!< Number of data accesses to flash which missed the cache */
+    uint32_t data_psram_miss;   /*!< Number of data accesses to PSRAM which missed the cache */
+    uint32_t psram_fill_bytes;  /*!< Number of bytes read from PSRAM to fill the data cache lines which missed */
+} esp_cache_counters_t;
+
+/**
+ * @brief Sample the cache access counters
+ *
+ * Get the number of cache accesses and misses since the previous call, and restart the counting. Calling this API
+ * at a fixed interval, e.g. from a periodic esp_timer, gives the cache hit rates and the PSRAM read bandwidth used
+ * to refill the cache over each interval. Comparing them before and after a firmware change shows whether a
+ * performance drop comes from cache thrashing.
+ *
+ * The first call starts the counting and returns zeros.
+ *
+ * - For chips with cache access counters (you can refer to SOC_CACHE_ACCESS_COUNTER_SUPPORTED in soc_caps.h), the
+ *   accesses of all the CPUs are counted together
+ * - For other chips, this API returns ESP_ERR_NOT_SUPPORTED
+ *
+ * This API is cache-safe and thread-safe
+ *
+ * @note The hardware counters are 32 bits wide, so the interval should be short enough not to overflow them: at
+ *       most a few seconds when the CPU runs from the cache all the time
+ * @note The write-backs of dirty cache lines to PSRAM are not counted
+ *
+ * @param[out] counters  Cache accesses and misses since the previous call
+ *
+ * @return
+ *        - ESP_OK:                Successful sample
+ *        - ESP_ERR_INVALID_ARG:   Null pointer
+ *        - ESP_ERR_NOT_SUPPORTED: The chip has no cache access counters
+ */
+esp_err_t esp_cache_sample_counters(esp_cache_counters_t *counters);
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,7 @@
 #include "esp_flash.h"
 #include "test_mm_utils.h"
 #include "soc/ext_mem_defs.h"
+#include "soc/soc_caps.h"
 
 const static char *TAG = "CACHE_TEST";
 
@@ -215,3 +216,98 @@ TEST_CASE("test cache msync unaligned flag not work with M2C direction", "[cache
 {
     TEST_ASSERT(esp_cache_msync((void *)TEST_SYNC_START, 0x8000, ESP_CACHE_MSYNC_FLAG_UNALIGNED | ESP_CACHE_MSYNC_FLAG_DIR_M2C) == ESP_ERR_INVALID_ARG);
 }
+
+#if CONFIG_SPIRAM
+TEST_CASE("test cache prefetch makes the following reads hit the cache", "[cache]")
+{
+    const size_t buf_size = 0x2000;
+    uint8_t *buf = heap_caps_aligned_alloc(0x80, buf_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(buf);
+    memset(buf, 0x5a, buf_size);
+    TEST_ESP_OK(esp_cache_msync(buf, buf_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE));
+
+    uint32_t sum = 0;
+    uint32_t miss_time = 0;
+    uint32_t hit_time = 0;
+    RECORD_TIME_PREPARE();
+
+    RECORD_TIME_START();
+    for (size_t i = 0; i < buf_size; i += 4) {
+        sum += *(volatile uint32_t *)&buf[i];
+    }
+    RECORD_TIME_END(miss_time);
+
+    TEST_ESP_OK(esp_cache_msync(buf, buf_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE));
+    //unaligned regions are extended to whole cache lines
+    TEST_ESP_OK(esp_cache_prefetch(buf + 1, buf_size - 1));
+    RECORD_TIME_START();
+    for (size_t i = 0; i < buf_size; i += 4) {
+        sum += *(volatile uint32_t *)&buf[i];
+    }
+    RECORD_TIME_END(hit_time);
+    printf("read time without prefetch: %"PRIu32", with prefetch: %"PRIu32" cycles\n", miss_time, hit_time);
+    TEST_ASSERT_EQUAL_UINT32(0x5a5a5a5aU * 2 * (buf_size / 4), sum);
+#if SOC_CACHE_PRELOAD_SUPPORTED
+    TEST_ASSERT_LESS_THAN_UINT32(miss_time, hit_time);
+#endif
+
+    free(buf);
+}
+#endif  //#if CONFIG_SPIRAM
+
+TEST_CASE("test cache prefetch with invalid arguments", "[cache]")
+{
+    TEST_ASSERT(esp_cache_prefetch(NULL, 0x100) == ESP_ERR_INVALID_ARG);
+    uint32_t internal_var = 0;
+    TEST_ASSERT(esp_cache_prefetch(&internal_var, 0xffffffff) == ESP_ERR_INVALID_ARG);
+}
+
+#if SOC_CACHE_ACCESS_COUNTER_SUPPORTED
+static const uint32_t s_test_rodata[0x400] = {[0 ... 0x3ff] = 0x5a5a5a5a};
+
+TEST_CASE("test cache access counters count the accesses through the cache", "[cache]")
+{
+    esp_cache_counters_t counters = {};
+    //start the counting
+    TEST_ESP_OK(esp_cache_sample_counters(&counters));
+
+    uint32_t sum = 0;
+    for (int i = 0; i < sizeof(s_test_rodata) / sizeof(s_test_rodata[0]); i++) {
+        sum += ((volatile const uint32_t *)s_test_rodata)[i];
+    }
+    TEST_ASSERT_EQUAL_UINT32(0x5a5a5a5aU * 0x400, sum);
+
+    TEST_ESP_OK(esp_cache_sample_counters(&counters));
+    printf("inst: %"PRIu32" accesses, %"PRIu32" misses, data: %"PRIu32" accesses, %"PRIu32" flash misses, %"PRIu32" PSRAM misses\n",
+           counters.inst_access, counters.inst_miss, counters.data_access, counters.data_flash_miss, counters.data_psram_miss);
+    //the test runs from flash
+    TEST_ASSERT_GREATER_THAN_UINT32(0, counters.inst_access);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(counters.inst_access, counters.inst_miss);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(0x400, counters.data_access);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(counters.data_access, counters.data_flash_miss + counters.data_psram_miss);
+
+#if CONFIG_SPIRAM
+    const size_t buf_size = 0x2000;
+    uint8_t *buf = heap_caps_aligned_alloc(0x80, buf_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(buf);
+    memset(buf, 0x5a, buf_size);
+    TEST_ESP_OK(esp_cache_msync(buf, buf_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE));
+
+    TEST_ESP_OK(esp_cache_sample_counters(&counters));
+    for (size_t i = 0; i < buf_size; i += 4) {
+        sum += *(volatile uint32_t *)&buf[i];
+    }
+    TEST_ESP_OK(esp_cache_sample_counters(&counters));
+    printf("PSRAM: %"PRIu32" misses, %"PRIu32" bytes\n", counters.data_psram_miss, counters.psram_fill_bytes);
+    //every line of the buffer was invalidated
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(buf_size, counters.psram_fill_bytes);
+    free(buf);
+#endif  //#if CONFIG_SPIRAM
+}
+#else
+TEST_CASE("test cache access counters are not supported", "[cache]")
+{
+    esp_cache_counters_t counters;
+    TEST_ASSERT(esp_cache_sample_counters(&counters) == ESP_ERR_NOT_SUPPORTED);
+}
+#endif  //#if SOC_CACHE_ACCESS_COUNTER_SUPPORTED
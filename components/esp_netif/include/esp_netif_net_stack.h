@@ -80,6 +80,31 @@ esp_err_t esp_netif_transmit(esp_netif_t *esp_netif, void* data, size_t len);
   */
 esp_err_t esp_netif_transmit_wrap(esp_netif_t *esp_netif, void *data, size_t len, void *netstack_buf);
 
+/**
+ * @brief Maximum number of buffers passed to esp_netif_transmit_segments()
+ */
+#define ESP_NETIF_TX_SEGMENTS_MAX   3
+
+/**
+  * @brief  Outputs a frame split into several buffers to the IO driver
+  *
+  * This function gets called from network stack for frames which are stored in a chain of buffers,
+  * e.g. protocol headers and application data. The buffers are handed to the IO driver as they are,
+  * so the frame doesn't have to be copied into a contiguous buffer first.
+  *
+  * @param[in]  esp_netif Handle to esp-netif instance
+  * @param[in]  buffers Array of the buffers of the frame, in order
+  * @param[in]  lens Array of the lengths of the buffers
+  * @param[in]  count Number of buffers, at most ESP_NETIF_TX_SEGMENTS_MAX
+  *
+  * @return
+  *         - ESP_OK on success
+  *         - ESP_ERR_NOT_SUPPORTED if the IO driver does not support it or count is too large,
+  *           the frame has to be transmitted by esp_netif_transmit() then
+  *         - an error passed from the I/O driver otherwise
+  */
+esp_err_t esp_netif_transmit_segments(esp_netif_t *esp_netif, void **buffers, size_t *lens, size_t count);
+
 /**
   * @brief  Free the rx buffer allocated by the media driver
   *
@@ -243,6 +243,8 @@ struct esp_netif_driver_ifconfig {
     esp_netif_iodriver_handle handle; /*!< io-driver handle */
     esp_err_t (*transmit)(void *h, void *buffer, size_t len); /*!< transmit function pointer */
     esp_err_t (*transmit_wrap)(void *h, void *buffer, size_t len, void *netstack_buffer); /*!< transmit wrap function pointer */
+    esp_err_t (*transmit_segments)(void *h, void **buffers, size_t *lens, size_t count); /*!< optional function pointer to transmit a frame
+                                                                                             split into several buffers without copying it first */
     void (*driver_free_rx_buffer)(void *h, void* buffer); /*!< free rx buffer function pointer */
 };
 
@@ -1,11 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #pragma once
 
+#include <stddef.h>
 #include "esp_err.h"
 
 #define L2TAP_VFS_DEFAULT_PATH "/dev/net/tap"
@@ -34,9 +35,30 @@ typedef enum {
     L2TAP_S_INTF_DEVICE,
     L2TAP_G_INTF_DEVICE,
     L2TAP_S_DEVICE_DRV_HNDL,
-    L2TAP_G_DEVICE_DRV_HNDL
+    L2TAP_G_DEVICE_DRV_HNDL,
+    L2TAP_G_RX_FRAMES,          /*!< Take the received frames without copying them, argument is l2tap_frames_t * */
+    L2TAP_S_RX_FRAMES_FREE,     /*!< Release frames taken by L2TAP_G_RX_FRAMES, argument is l2tap_frames_t * */
+    L2TAP_S_TX_FRAMES           /*!< Transmit several frames with one call, argument is l2tap_frames_t * */
 } l2tap_ioctl_opt_t;
 
+/**
+ * @brief L2 frame passed by reference
+ *
+ */
+typedef struct {
+    void *buff;     /*!< L2 frame */
+    size_t len;     /*!< Length of the L2 frame */
+} l2tap_frame_t;
+
+/**
+ * @brief Array of L2 frames for the L2TAP_G_RX_FRAMES, L2TAP_S_RX_FRAMES_FREE and L2TAP_S_TX_FRAMES ioctl options
+ *
+ */
+typedef struct {
+    l2tap_frame_t *frames;  /*!< Array of frames */
+    size_t count;           /*!< Number of frames in the array, updated to the number of frames taken or transmitted */
+} l2tap_frames_t;
+
 /**
  * @brief Add L2 TAP virtual filesystem driver
  *
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -14,6 +14,17 @@
 
 #if CONFIG_ESP_NETIF_BRIDGE_EN
 
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_netif_net_stack.h"
+#include "esp_netif_lwip_internal.h"
+
+#define BR_FAST_PATH_FDB_SIZE       CONFIG_ESP_NETIF_BRIDGE_FAST_PATH_FDB_SIZE
+#define BR_FAST_PATH_AGEING_MS      (300 * 1000) // IEEE 802.1D default ageing time
+#define BR_ETH_HDR_LEN              14
+#endif // CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+
 const static char *TAG = "esp_netif_br_glue";
 
 typedef struct esp_netif_br_glue_t esp_netif_br_glue_t;
@@ -26,6 +37,14 @@ typedef enum {
     CTX_HANDLERS_END_LIST
 } ctx_handl_type_t;
 
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+typedef struct {
+    uint8_t addr[6];
+    esp_netif_t *port;
+    TickType_t last_seen;
+} br_fdb_entry_t;
+#endif // CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+
 struct esp_netif_br_glue_t {
     esp_netif_driver_base_t base;
     bool br_started;
@@ -35,8 +54,71 @@ struct esp_netif_br_glue_t {
     esp_event_handler_instance_t *eth_ctx_handlers;
     esp_event_handler_instance_t get_ip_ctx_handler;
     esp_event_handler_instance_t *wifi_ctx_handlers;
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+    uint8_t br_mac[6];
+    portMUX_TYPE fdb_lock;
+    br_fdb_entry_t fdb[BR_FAST_PATH_FDB_SIZE];
+#endif // CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
 };
 
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+static inline uint32_t br_fdb_hash(const uint8_t *addr)
+{
+    // the OUI is shared by many stations, the NIC specific part distinguishes them
+    uint32_t hash = ((uint32_t)addr[3] << 16) | ((uint32_t)addr[4] << 8) | addr[5];
+    hash ^= ((uint32_t)addr[1] << 8) | addr[2];
+    return hash % BR_FAST_PATH_FDB_SIZE;
+}
+
+static void br_fdb_flush(esp_netif_br_glue_t *netif_glue)
+{
+    portENTER_CRITICAL(&netif_glue->fdb_lock);
+    memset(netif_glue->fdb, 0, sizeof(netif_glue->fdb));
+    portEXIT_CRITICAL(&netif_glue->fdb_lock);
+}
+
+static bool br_fast_path_input(void *ctx, esp_netif_t *esp_netif, void *buffer, size_t len, void *eb)
+{
+    esp_netif_br_glue_t *netif_glue = ctx;
+    const uint8_t *dest = buffer;
+    const uint8_t *src = (const uint8_t *)buffer + 6;
+
+    if (buffer == NULL || len < BR_ETH_HDR_LEN || netif_glue->br_started == false) {
+        return false;
+    }
+
+    TickType_t now = xTaskGetTickCount();
+    esp_netif_t *out_port = NULL;
+    portENTER_CRITICAL(&netif_glue->fdb_lock);
+    // learn the station sending the frame, group addresses are never a source
+    if ((src[0] & 0x01) == 0 && memcmp(src, netif_glue->br_mac, 6) != 0) {
+        br_fdb_entry_t *entry = &netif_glue->fdb[br_fdb_hash(src)];
+        memcpy(entry->addr, src, 6);
+        entry->port = esp_netif;
+        entry->last_seen = now;
+    }
+    if ((dest[0] & 0x01) == 0) {
+        br_fdb_entry_t *entry = &netif_glue->fdb[br_fdb_hash(dest)];
+        if (entry->port != NULL && memcmp(entry->addr, dest, 6) == 0 &&
+                now - entry->last_seen < pdMS_TO_TICKS(BR_FAST_PATH_AGEING_MS)) {
+            out_port = entry->port;
+        }
+    }
+    portEXIT_CRITICAL(&netif_glue->fdb_lock);
+
+    // frames for the bridge itself are never learned, frames for the station's own port are left for lwip to filter
+    if (out_port == NULL || out_port == esp_netif || esp_netif_is_netif_up(out_port) == false) {
+        return false;
+    }
+    if (esp_netif_transmit(out_port, buffer, len) != ESP_OK) {
+        return false;
+    }
+    // the drivers copy the frame on transmit, the receive buffer can be returned right away
+    esp_netif_free_rx_buffer(esp_netif, eb ? eb : buffer);
+    return true;
+}
+#endif // CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+
 static esp_err_t esp_eth_post_attach_br(esp_netif_t *esp_netif, void *args)
 {
     uint8_t eth_mac[6];
@@ -46,6 +128,9 @@ static esp_err_t esp_eth_post_attach_br(esp_netif_t *esp_netif, void *args)
     esp_netif_get_mac(esp_netif, eth_mac);
     ESP_LOGI(TAG, "%02x:%02x:%02x:%02x:%02x:%02x", eth_mac[0], eth_mac[1],
              eth_mac[2], eth_mac[3], eth_mac[4], eth_mac[5]);
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+    memcpy(netif_glue->br_mac, eth_mac, sizeof(netif_glue->br_mac));
+#endif
 
     ESP_LOGI(TAG, "bridge netif glue attached");
 
@@ -66,6 +151,9 @@ static void stop_br_if_started(esp_netif_br_glue_t *netif_glue)
     if (netif_glue->br_started == true) {
         esp_netif_action_stop(netif_glue->base.netif, 0, 0, NULL); // basically removes lwip_netif br
         netif_glue->br_started = false;
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+        br_fdb_flush(netif_glue);
+#endif
         ESP_LOGD(TAG, "bridge netif %p is stopped", netif_glue->base.netif);
     }
 }
@@ -167,6 +255,10 @@ static void port_action_disconnected(void *handler_args, esp_event_base_t base,
 {
     esp_netif_br_glue_t *netif_glue = handler_args;
     ESP_LOGD(TAG, "action_disconnected: %p, %p, %" PRId32 ", %p", netif_glue, base, event_id, event_data);
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+    // stations may have moved, let them be learned again
+    br_fdb_flush(netif_glue);
+#endif
     // if all ports are disconnected, set bridge as disconnected too
     if (are_ports_disconnected(netif_glue)) {
         esp_netif_action_disconnected(netif_glue->base.netif, base, event_id, event_data);
@@ -328,6 +420,9 @@ esp_err_t esp_netif_br_glue_add_port(esp_netif_br_glue_handle_t netif_br_glue, e
 
     netif_br_glue->ports_esp_netifs[netif_br_glue->port_cnt] = esp_netif_port;
     netif_br_glue->port_cnt++;
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+    esp_netif_set_br_fast_path(esp_netif_port, br_fast_path_input, netif_br_glue);
+#endif
 
     return ESP_OK;
 }
@@ -341,6 +436,9 @@ esp_err_t esp_netif_br_glue_add_wifi_port(esp_netif_br_glue_handle_t netif_br_gl
 
     netif_br_glue->wifi_esp_netif = esp_netif_port;
     ESP_GOTO_ON_ERROR(esp_netif_br_glue_set_instance_handlers_wifi(netif_br_glue), fail, TAG, "failed to create WiFi event handlers");
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+    esp_netif_set_br_fast_path(esp_netif_port, br_fast_path_input, netif_br_glue);
+#endif
 
     return ESP_OK;
 fail:
@@ -359,6 +457,9 @@ esp_netif_br_glue_handle_t esp_netif_br_glue_new(void)
     }
 
     netif_glue->base.post_attach = esp_eth_post_attach_br;
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+    portMUX_INITIALIZE(&netif_glue->fdb_lock);
+#endif
 
     if (esp_netif_br_glue_set_instance_handlers(netif_glue) != ESP_OK) {
         esp_netif_br_glue_del(netif_glue);
@@ -370,6 +471,14 @@ esp_netif_br_glue_handle_t esp_netif_br_glue_new(void)
 
 esp_err_t esp_netif_br_glue_del(esp_netif_br_glue_handle_t netif_br_glue)
 {
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+    for (int i = 0; i < netif_br_glue->port_cnt; i++) {
+        esp_netif_set_br_fast_path(netif_br_glue->ports_esp_netifs[i], NULL, NULL);
+    }
+    if (netif_br_glue->wifi_esp_netif != NULL) {
+        esp_netif_set_br_fast_path(netif_br_glue->wifi_esp_netif, NULL, NULL);
+    }
+#endif
     stop_br_if_started(netif_br_glue);
     esp_netif_br_glue_clear_instance_handlers(netif_br_glue);
     if (netif_br_glue->wifi_esp_netif != NULL) {
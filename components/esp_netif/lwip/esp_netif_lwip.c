@@ -442,6 +442,16 @@ esp_err_t esp_netif_bridge_fdb_remove(esp_netif_t *esp_netif_br, uint8_t *addr)
     }
     return ESP_OK;
 }
+
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+void esp_netif_set_br_fast_path(esp_netif_t *esp_netif, esp_netif_br_fast_path_fn_t fn, void *ctx)
+{
+    // the hook is cleared while its context changes, so the receive path never sees a mismatched pair
+    esp_netif->br_fast_path = NULL;
+    esp_netif->br_fast_path_ctx = ctx;
+    esp_netif->br_fast_path = fn;
+}
+#endif // CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
 #endif // CONFIG_ESP_NETIF_BRIDGE_EN
 
 #if CONFIG_LWIP_IPV4
@@ -691,6 +701,9 @@ static esp_err_t esp_netif_init_configuration(esp_netif_t *esp_netif, const esp_
         if (esp_netif_driver_config->transmit_wrap) {
             esp_netif->driver_transmit_wrap = esp_netif_driver_config->transmit_wrap;
         }
+        if (esp_netif_driver_config->transmit_segments) {
+            esp_netif->driver_transmit_segments = esp_netif_driver_config->transmit_segments;
+        }
         if (esp_netif_driver_config->driver_free_rx_buffer) {
             esp_netif->driver_free_rx_buffer = esp_netif_driver_config->driver_free_rx_buffer;
         }
@@ -1000,6 +1013,7 @@ esp_err_t esp_netif_set_driver_config(esp_netif_t *esp_netif,
     esp_netif->driver_handle = driver_config->handle;
     esp_netif->driver_transmit = driver_config->transmit;
     esp_netif->driver_transmit_wrap = driver_config->transmit_wrap;
+    esp_netif->driver_transmit_segments = driver_config->transmit_segments;
     esp_netif->driver_free_rx_buffer = driver_config->driver_free_rx_buffer;
     return ESP_OK;
 }
@@ -1317,6 +1331,27 @@ esp_err_t esp_netif_transmit_wrap(esp_netif_t *esp_netif, void *data, size_t len
     return (esp_netif->driver_transmit_wrap)(esp_netif->driver_handle, data, len, pbuf);
 }
 
+esp_err_t esp_netif_transmit_segments(esp_netif_t *esp_netif, void **buffers, size_t *lens, size_t count)
+{
+    if (esp_netif->driver_transmit_segments == NULL || count > ESP_NETIF_TX_SEGMENTS_MAX) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+#ifdef CONFIG_ESP_NETIF_REPORT_DATA_TRAFFIC
+    if (unlikely(esp_netif->tx_rx_events_enabled)) {
+        ip_event_tx_rx_t evt = {
+            .esp_netif = esp_netif,
+            .len = 0,
+            .dir = ESP_NETIF_TX,
+        };
+        for (size_t i = 0; i < count; i++) {
+            evt.len += lens[i];
+        }
+        esp_event_post(IP_EVENT, IP_EVENT_TX_RX, &evt, sizeof(evt), 0);
+    }
+#endif
+    return (esp_netif->driver_transmit_segments)(esp_netif->driver_handle, buffers, lens, count);
+}
+
 esp_err_t esp_netif_receive(esp_netif_t *esp_netif, void *buffer, size_t len, void *eb)
 {
 #ifdef CONFIG_ESP_NETIF_REPORT_DATA_TRAFFIC
@@ -1329,6 +1364,12 @@ esp_err_t esp_netif_receive(esp_netif_t *esp_netif, void *buffer, size_t len, vo
         esp_event_post(IP_EVENT, IP_EVENT_TX_RX, &evt, sizeof(evt), 0);
     }
 #endif
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+    esp_netif_br_fast_path_fn_t br_fast_path = esp_netif->br_fast_path;
+    if (br_fast_path && br_fast_path(esp_netif->br_fast_path_ctx, esp_netif, buffer, len, eb)) {
+        return ESP_OK;
+    }
+#endif
 #ifdef CONFIG_ESP_NETIF_RECEIVE_REPORT_ERRORS
     return esp_netif->lwip_input_fn(esp_netif->netif_handle, buffer, len, eb);
 #else
@@ -66,6 +66,18 @@ typedef struct netif_related_data {
     enum netif_types netif_type;
 } netif_related_data_t;
 
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+/**
+ * @brief Hook of the bridge fast path, returns true if it took the ownership of the received frame
+ */
+typedef bool (*esp_netif_br_fast_path_fn_t)(void *ctx, esp_netif_t *esp_netif, void *buffer, size_t len, void *eb);
+
+/**
+ * @brief Set the bridge fast path hook of a bridge port, NULL fn removes it
+ */
+void esp_netif_set_br_fast_path(esp_netif_t *esp_netif, esp_netif_br_fast_path_fn_t fn, void *ctx);
+#endif // CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+
 /**
  * @brief Main esp-netif container with interface related information
  */
@@ -88,6 +100,7 @@ struct esp_netif_obj {
     void* driver_handle;
     esp_err_t (*driver_transmit)(void *h, void *buffer, size_t len);
     esp_err_t (*driver_transmit_wrap)(void *h, void *buffer, size_t len, void *pbuf);
+    esp_err_t (*driver_transmit_segments)(void *h, void **buffers, size_t *lens, size_t count);
     void (*driver_free_rx_buffer)(void *h, void* buffer);
 
     // dhcp related
@@ -115,6 +128,11 @@ struct esp_netif_obj {
     uint16_t max_fdb_sta_entries;
     uint8_t max_ports;
 #endif // CONFIG_ESP_NETIF_BRIDGE_EN
+#if CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
+    // frames received by a bridge port are offered to this hook before passing them to lwip
+    esp_netif_br_fast_path_fn_t br_fast_path;
+    void *br_fast_path_ctx;
+#endif // CONFIG_ESP_NETIF_BRIDGE_FAST_PATH
     // mldv6 timer
     bool mldv6_report_timer_started;
 
@@ -17,6 +17,20 @@
 #include <string.h>
 #include "lwip/ip6_addr.h"
 #include "netif/pppif.h"
+#if CONFIG_ESP_NETIF_PPP_FAST_PATH
+#include "esp_heap_caps.h"
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
+#include "lwip/stats.h"
+#include "lwip/snmp.h"
+#include "netif/ppp/ppp_impl.h"
+#include "netif/ppp_hdlc.h"
+
+// Unescaped received frame: address, control and protocol fields, information field of up to MRU bytes and FCS
+#define PPP_FAST_PATH_RX_BUF_SIZE   (PPP_HDRLEN + PPP_MRU + PPP_HDLC_FCS_LEN)
+// Escaped transmitted frame of up to MTU bytes with its flags, passed to the driver in one transmit call
+#define PPP_FAST_PATH_TX_BUF_SIZE   (PPP_HDLC_ESCAPED_MAX_LEN(PPP_HDRLEN + PPP_MTU + PPP_HDLC_FCS_LEN) + 2)
+#endif
 
 ESP_EVENT_DEFINE_BASE(NETIF_PPP_STATUS);
 
@@ -39,6 +53,14 @@ typedef struct lwip_peer2peer_ctx {
     esp_ip4_addr_t ppp_their_ip4_addr;    // their desired IP (IPADDR_ANY if no preference)
 #endif
     ppp_pcb *ppp;
+#if CONFIG_ESP_NETIF_PPP_FAST_PATH
+    struct link_callbacks link_cb;  // pppos link callbacks, with the fast output functions
+    ppp_hdlc_decoder_t decoder;     // fed by the task calling esp_netif_receive()
+    err_t rx_err;                   // error of the frames passed to lwIP by the last input call
+    uint8_t *rx_buf;
+    uint8_t *tx_buf;
+    size_t tx_len;
+#endif
 } lwip_peer2peer_ctx_t;
 
 /**
@@ -184,6 +206,195 @@ static uint32_t pppos_low_level_output(ppp_pcb *pcb, const void *data, uint32_t
     return 0;
 }
 
+#if CONFIG_ESP_NETIF_PPP_FAST_PATH
+/*
+ * PPPoS fast path: the HDLC-like framing is done by ppp_hdlc, which handles clean runs of data a word
+ * at a time and with a table driven FCS, instead of lwIP's pppos which processes every byte through its
+ * state machine. Received frames are unescaped in the task calling esp_netif_receive() and only complete
+ * frames are passed to the TCP/IP task, in pbufs of their exact size. Transmitted frames are escaped into
+ * a single buffer and written to the driver in one call. lwIP's pppos still handles the link state and
+ * the negotiated ACCM and compression options, which are read from its control block.
+ */
+
+/**
+ * @brief Passes a received frame, starting with its protocol field, to PPP (runs in the TCP/IP task)
+ */
+static err_t ppp_fast_path_input_sys(struct pbuf *p, struct netif *inp)
+{
+    ppp_pcb *ppp = (ppp_pcb *)inp->state;
+    pppos_pcb *pppos = (pppos_pcb *)ppp->link_ctx_cb;
+    if (!pppos->open) {
+        pbuf_free(p);
+        return ERR_OK;
+    }
+    LINK_STATS_INC(link.recv);
+    MIB2_STATS_NETIF_ADD(ppp->netif, ifinoctets, p->tot_len);
+    ppp_input(ppp, p);
+    return ERR_OK;
+}
+
+static void ppp_fast_path_on_frame(void *ctx, const uint8_t *frame, size_t len)
+{
+    lwip_peer2peer_ctx_t *obj = ctx;
+    uint16_t protocol;
+
+    // Address and control fields are omitted with ACFC, the protocol field is compressed to a byte with PFC
+    if (len >= 2 && frame[0] == PPP_ALLSTATIONS && frame[1] == PPP_UI) {
+        frame += 2;
+        len -= 2;
+    }
+    if (len >= 1 && (frame[0] & 1)) {
+        protocol = frame[0];
+        frame += 1;
+        len -= 1;
+    } else if (len >= 2) {
+        protocol = (frame[0] << 8) | frame[1];
+        frame += 2;
+        len -= 2;
+    } else {
+        ESP_LOGD(TAG, "%s: dropped a frame without protocol field", __func__);
+        return;
+    }
+
+    struct pbuf *p = pbuf_alloc(PBUF_RAW, len + sizeof(protocol), PBUF_RAM);
+    if (!p) {
+        obj->rx_err = ERR_MEM;
+        return;
+    }
+    uint8_t *payload = p->payload;
+    payload[0] = protocol >> 8;
+    payload[1] = protocol & 0xFF;
+    memcpy(payload + sizeof(protocol), frame, len);
+    err_t err = tcpip_inpkt(p, ppp_netif(obj->ppp), ppp_fast_path_input_sys);
+    if (err != ERR_OK) {
+        pbuf_free(p);
+        obj->rx_err = err;
+    }
+}
+
+static err_t ppp_fast_path_flush(lwip_peer2peer_ctx_t *obj, pppos_pcb *pppos)
+{
+    uint32_t len = obj->tx_len;
+    obj->tx_len = 0;
+    if (len && pppos->output_cb(obj->ppp, obj->tx_buf, len, obj->ppp->ctx_cb) != len) {
+        return ERR_IF;
+    }
+    return ERR_OK;
+}
+
+static err_t ppp_fast_path_append(lwip_peer2peer_ctx_t *obj, pppos_pcb *pppos, const uint8_t *data, size_t len, uint16_t *fcs)
+{
+    while (len > 0) {
+        size_t chunk = (PPP_FAST_PATH_TX_BUF_SIZE - obj->tx_len) / 2;
+        if (chunk == 0) {
+            err_t err = ppp_fast_path_flush(obj, pppos);
+            if (err != ERR_OK) {
+                return err;
+            }
+            continue;
+        }
+        chunk = LWIP_MIN(chunk, len);
+        obj->tx_len += ppp_hdlc_escape(pppos->out_accm, data, chunk, obj->tx_buf + obj->tx_len, fcs);
+        data += chunk;
+        len -= chunk;
+    }
+    return ERR_OK;
+}
+
+/**
+ * @brief Escapes and transmits a frame made of a header and a pbuf chain (runs in the TCP/IP task)
+ */
+static err_t ppp_fast_path_output(ppp_pcb *ppp, pppos_pcb *pppos, const uint8_t *header, size_t header_len, struct pbuf *pb)
+{
+    lwip_peer2peer_ctx_t *obj = (lwip_peer2peer_ctx_t *)((esp_netif_t *)ppp->ctx_cb)->related_data;
+    uint16_t fcs = PPP_HDLC_INITFCS;
+    u32_t tot_len = 0;
+    err_t err;
+
+    // If the link has been idle, a fresh flag flushes any noise
+    obj->tx_len = 0;
+    if ((sys_now() - pppos->last_xmit) >= PPP_MAXIDLEFLAG) {
+        obj->tx_buf[obj->tx_len++] = PPP_HDLC_FLAG;
+    }
+    err = ppp_fast_path_append(obj, pppos, header, header_len, &fcs);
+    for (struct pbuf *p = pb; p && err == ERR_OK; p = p->next) {
+        err = ppp_fast_path_append(obj, pppos, p->payload, p->len, &fcs);
+    }
+    if (err == ERR_OK) {
+        fcs = ~fcs;
+        uint8_t trailer[PPP_HDLC_FCS_LEN] = { fcs & 0xFF, fcs >> 8 };
+        err = ppp_fast_path_append(obj, pppos, trailer, sizeof(trailer), NULL);
+    }
+    if (err == ERR_OK && obj->tx_len == PPP_FAST_PATH_TX_BUF_SIZE) {
+        err = ppp_fast_path_flush(obj, pppos);
+    }
+    if (err == ERR_OK) {
+        obj->tx_buf[obj->tx_len++] = PPP_HDLC_FLAG;
+        tot_len = obj->tx_len;
+        err = ppp_fast_path_flush(obj, pppos);
+    }
+    obj->tx_len = 0;
+    if (err != ERR_OK) {
+        LINK_STATS_INC(link.err);
+        LINK_STATS_INC(link.drop);
+        MIB2_STATS_NETIF_INC(ppp->netif, ifoutdiscards);
+        return err;
+    }
+    pppos->last_xmit = sys_now();
+    MIB2_STATS_NETIF_ADD(ppp->netif, ifoutoctets, tot_len);
+    MIB2_STATS_NETIF_INC(ppp->netif, ifoutucastpkts);
+    LINK_STATS_INC(link.xmit);
+    return ERR_OK;
+}
+
+/**
+ * @brief Link write callback, the pbuf is a complete frame including its address and control fields
+ */
+static err_t ppp_fast_path_write(ppp_pcb *ppp, void *ctx, struct pbuf *p)
+{
+    err_t err = ppp_fast_path_output(ppp, (pppos_pcb *)ctx, NULL, 0, p);
+    pbuf_free(p);
+    return err;
+}
+
+/**
+ * @brief Link netif output callback, the header is built from the negotiated compression options
+ */
+static err_t ppp_fast_path_netif_output(ppp_pcb *ppp, void *ctx, struct pbuf *pb, u16_t protocol)
+{
+    pppos_pcb *pppos = (pppos_pcb *)ctx;
+    uint8_t header[PPP_HDRLEN];
+    size_t header_len = 0;
+
+    if (!pppos->accomp) {
+        header[header_len++] = PPP_ALLSTATIONS;
+        header[header_len++] = PPP_UI;
+    }
+    if (!pppos->pcomp || protocol > 0xFF) {
+        header[header_len++] = (protocol >> 8) & 0xFF;
+    }
+    header[header_len++] = protocol & 0xFF;
+    return ppp_fast_path_output(ppp, pppos, header, header_len, pb);
+}
+
+static esp_err_t ppp_fast_path_init(lwip_peer2peer_ctx_t *ppp_obj)
+{
+    // Both buffers are accessed for every byte of the link, keep them in internal RAM
+    ppp_obj->rx_buf = heap_caps_malloc(PPP_FAST_PATH_RX_BUF_SIZE + PPP_FAST_PATH_TX_BUF_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (ppp_obj->rx_buf == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    ppp_obj->tx_buf = ppp_obj->rx_buf + PPP_FAST_PATH_RX_BUF_SIZE;
+    ppp_hdlc_decoder_init(&ppp_obj->decoder, ppp_obj->rx_buf, PPP_FAST_PATH_RX_BUF_SIZE);
+    // pppos keeps handling the link state, only its frame output functions are replaced
+    ppp_obj->link_cb = *ppp_obj->ppp->link_cb;
+    ppp_obj->link_cb.write = ppp_fast_path_write;
+    ppp_obj->link_cb.netif_output = ppp_fast_path_netif_output;
+    ppp_obj->ppp->link_cb = &ppp_obj->link_cb;
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_NETIF_PPP_FAST_PATH
+
 esp_err_t esp_netif_ppp_set_auth_internal(esp_netif_t *netif, esp_netif_auth_type_t authtype, const char *user, const char *passwd)
 {
     if (!ESP_NETIF_IS_POINT2POINT_TYPE(netif, PPP_LWIP_NETIF)) {
@@ -225,6 +436,14 @@ netif_related_data_t * esp_netif_new_ppp(esp_netif_t *esp_netif, const esp_netif
         ESP_LOGE(TAG, "%s: lwIP PPP connection cannot be created", __func__);
         return NULL;
     }
+#if CONFIG_ESP_NETIF_PPP_FAST_PATH
+    if (ppp_fast_path_init(ppp_obj) != ESP_OK) {
+        ESP_LOGE(TAG, "%s: cannot allocate PPPoS fast path buffers", __func__);
+        ppp_free(ppp_obj->ppp);
+        free(ppp_obj);
+        return NULL;
+    }
+#endif
 
     // Set the related data here, since the phase callback could be triggered before this function exits
     esp_netif->related_data = (netif_related_data_t *)ppp_obj;
@@ -293,7 +512,14 @@ esp_err_t esp_netif_start_ppp(esp_netif_t *esp_netif)
 esp_netif_recv_ret_t esp_netif_lwip_ppp_input(void *ppp_ctx, void *buffer, size_t len, void *eb)
 {
     struct lwip_peer2peer_ctx * obj = ppp_ctx;
+#if CONFIG_ESP_NETIF_PPP_FAST_PATH
+    pppos_pcb *pppos = (pppos_pcb *)obj->ppp->link_ctx_cb;
+    obj->rx_err = ERR_OK;
+    ppp_hdlc_decode(&obj->decoder, pppos->in_accm, buffer, len, ppp_fast_path_on_frame, obj);
+    err_t ret = obj->rx_err;
+#else
     err_t ret = pppos_input_tcpip_as_ram_pbuf(obj->ppp, buffer, len);
+#endif
     if (ret != ERR_OK) {
         ESP_LOGE(TAG, "pppos_input_tcpip failed with %d", ret);
         return ESP_NETIF_OPTIONAL_RETURN_CODE(ESP_FAIL);
@@ -320,6 +546,9 @@ void esp_netif_destroy_ppp(netif_related_data_t *netif_related)
     assert(ppp_ctx->base.netif_type == PPP_LWIP_NETIF);
 
     ppp_free(ppp_ctx->ppp);
+#if CONFIG_ESP_NETIF_PPP_FAST_PATH
+    heap_caps_free(ppp_ctx->rx_buf);
+#endif
     free(netif_related);
 }
 
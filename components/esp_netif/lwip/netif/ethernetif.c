@@ -3,7 +3,7 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
- * SPDX-FileContributor: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2015-2024 Espressif Systems (Shanghai) CO LTD
  */
 /**
  * @file
@@ -59,6 +59,34 @@ static void ethernet_low_level_init(struct netif *netif)
 #endif
 }
 
+/**
+ * @brief Passes the pbufs of a chained packet to the driver as separate buffers
+ *
+ * @param esp_netif esp-netif of the ethernetif
+ * @param p chained MAC packet to send
+ * @return ESP_ERR_NOT_SUPPORTED if the driver can't transmit a frame in segments or the chain is too long,
+ *         the result of the driver otherwise
+ */
+static inline esp_err_t ethernet_output_segments(esp_netif_t *esp_netif, struct pbuf *p)
+{
+    void *buffers[ESP_NETIF_TX_SEGMENTS_MAX];
+    size_t lens[ESP_NETIF_TX_SEGMENTS_MAX];
+    size_t count = 0;
+
+    for (struct pbuf *q = p; q != NULL; q = q->next) {
+        if (q->len == 0) {
+            continue;
+        }
+        if (count == ESP_NETIF_TX_SEGMENTS_MAX) {
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+        buffers[count] = q->payload;
+        lens[count] = q->len;
+        count++;
+    }
+    return esp_netif_transmit_segments(esp_netif, buffers, lens, count);
+}
+
 /**
  * @brief This function should do the actual transmission of the packet. The packet is
  * contained in the pbuf that is passed to the function. This pbuf might be chained.
@@ -82,7 +110,8 @@ static err_t ethernet_low_level_output(struct netif *netif, struct pbuf *p)
 
     if (q->next == NULL) {
         ret = esp_netif_transmit(esp_netif, q->payload, q->len);
-    } else {
+    } else if ((ret = ethernet_output_segments(esp_netif, p)) == ESP_ERR_NOT_SUPPORTED) {
+        /* the driver can't take the chain as it is, copy it into a contiguous buffer */
         LWIP_DEBUGF(PBUF_DEBUG, ("low_level_output: pbuf is a list, application may has bug"));
         q = pbuf_alloc(PBUF_RAW_TX, p->tot_len, PBUF_RAM);
         if (q != NULL) {
@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * HDLC-like framing of PPP over serial links (RFC 1662), used by the esp-netif PPPoS fast path.
+ *
+ * The async control character maps (ACCM) are the 32 byte bitmaps of lwIP's pppos (ext_accm): a set bit
+ * means the character is escaped on output and dropped on input. The flag and escape characters are
+ * always handled as such, whatever the map says.
+ */
+
+#define PPP_HDLC_FLAG       0x7E    // Frame delimiter
+#define PPP_HDLC_ESCAPE     0x7D    // Escape of the next character
+#define PPP_HDLC_TRANS      0x20    // Escaped characters are XORed with this value
+#define PPP_HDLC_INITFCS    0xFFFF  // Initial FCS value
+#define PPP_HDLC_GOODFCS    0xF0B8  // FCS of a valid frame, including its FCS field
+#define PPP_HDLC_FCS_LEN    2
+
+/**
+ * @brief Maximum length of the escaped form of len bytes
+ */
+#define PPP_HDLC_ESCAPED_MAX_LEN(len) (2 * (len))
+
+/**
+ * @brief Callback of a received frame, without its FCS field, valid until the callback returns
+ */
+typedef void (*ppp_hdlc_frame_fn_t)(void *ctx, const uint8_t *frame, size_t len);
+
+/**
+ * @brief State of the receive side, fed by a single task
+ */
+typedef struct {
+    uint8_t *buf;           // unescaped frame being received
+    size_t size;            // size of buf, longer frames are dropped
+    size_t len;
+    uint16_t fcs;
+    bool escaped;           // the last character was the escape character
+    bool overrun;           // the current frame doesn't fit in buf
+    uint32_t frames;        // frames passed to the callback
+    uint32_t fcs_errors;    // frames dropped because of a wrong FCS
+    uint32_t dropped;       // frames dropped because they were too short, too long or aborted
+} ppp_hdlc_decoder_t;
+
+/**
+ * @brief Update a PPP FCS-16 with a buffer
+ */
+uint16_t ppp_hdlc_fcs(uint16_t fcs, const uint8_t *data, size_t len);
+
+/**
+ * @brief Escape a buffer
+ *
+ * @param accm transmit ACCM
+ * @param data data to escape
+ * @param len length of data
+ * @param out output buffer of at least PPP_HDLC_ESCAPED_MAX_LEN(len) bytes
+ * @param fcs FCS updated with the unescaped data, NULL not to compute it
+ *
+ * @return number of bytes written to out
+ */
+size_t ppp_hdlc_escape(const uint8_t *accm, const uint8_t *data, size_t len, uint8_t *out, uint16_t *fcs);
+
+/**
+ * @brief Initialize the receive side with the buffer a frame is unescaped into
+ */
+void ppp_hdlc_decoder_init(ppp_hdlc_decoder_t *dec, uint8_t *buf, size_t size);
+
+/**
+ * @brief Drop the frame being received
+ */
+void ppp_hdlc_decoder_reset(ppp_hdlc_decoder_t *dec);
+
+/**
+ * @brief Unescape received data and pass each complete frame with a valid FCS to fn
+ *
+ * @param dec receive side
+ * @param accm receive ACCM
+ * @param data received data, might contain any part of one or more frames
+ * @param len length of data
+ * @param fn called for each frame
+ * @param ctx argument of fn
+ */
+void ppp_hdlc_decode(ppp_hdlc_decoder_t *dec, const uint8_t *accm, const uint8_t *data, size_t len,
+                     ppp_hdlc_frame_fn_t fn, void *ctx);
@@ -18,6 +18,9 @@
 #include "memory_checks.h"
 #include "lwip/netif.h"
 #include "esp_netif_test.h"
+#if CONFIG_ESP_NETIF_PPP_FAST_PATH
+#include "netif/ppp_hdlc.h"
+#endif
 
 TEST_GROUP(esp_netif);
 
@@ -580,6 +583,80 @@ TEST(esp_netif, set_get_dnsserver)
     }
 }
 
+#if CONFIG_ESP_NETIF_PPP_FAST_PATH
+static uint8_t s_hdlc_frame[32];
+static size_t s_hdlc_frame_len;
+
+static void hdlc_on_frame(void *ctx, const uint8_t *frame, size_t len)
+{
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(s_hdlc_frame), len);
+    memcpy(s_hdlc_frame, frame, len);
+    s_hdlc_frame_len = len;
+    (*(int *)ctx)++;
+}
+
+TEST(esp_netif, ppp_hdlc_framing)
+{
+    uint8_t accm[32] = { 0 };
+    accm[0] = 0x02 | 0x08;      // 0x01 and 0x03 are escaped, and dropped when received as such
+    accm[15] = 0x60;            // flag and escape
+    const uint8_t frame[] = { 0xFF, 0x03, 0xC0, 0x21, 0x7E, 0x7D, 0x01, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+    const uint8_t escaped[] = { 0xFF, 0x7D, 0x23, 0xC0, 0x21, 0x7D, 0x5E, 0x7D, 0x5D, 0x7D, 0x21, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+    uint8_t stream[2 + PPP_HDLC_ESCAPED_MAX_LEN(sizeof(frame) + PPP_HDLC_FCS_LEN)];
+    uint8_t buf[sizeof(frame) + PPP_HDLC_FCS_LEN];
+    ppp_hdlc_decoder_t dec;
+    int frames = 0;
+
+    // check value of the FCS-16 of RFC 1662
+    TEST_ASSERT_EQUAL_HEX16(0x906E, (uint16_t)~ppp_hdlc_fcs(PPP_HDLC_INITFCS, (const uint8_t *)"123456789", 9));
+
+    uint16_t fcs = PPP_HDLC_INITFCS;
+    size_t len = 0;
+    stream[len++] = PPP_HDLC_FLAG;
+    len += ppp_hdlc_escape(accm, frame, sizeof(frame), stream + len, &fcs);
+    TEST_ASSERT_EQUAL(sizeof(escaped) + 1, len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(escaped, stream + 1, sizeof(escaped));
+    fcs = ~fcs;
+    uint8_t trailer[PPP_HDLC_FCS_LEN] = { fcs & 0xFF, fcs >> 8 };
+    len += ppp_hdlc_escape(accm, trailer, sizeof(trailer), stream + len, NULL);
+    stream[len++] = PPP_HDLC_FLAG;
+
+    // a frame split between calls at any position
+    ppp_hdlc_decoder_init(&dec, buf, sizeof(buf));
+    for (size_t split = 0; split <= len; split++) {
+        memset(s_hdlc_frame, 0, sizeof(s_hdlc_frame));
+        ppp_hdlc_decode(&dec, accm, stream, split, hdlc_on_frame, &frames);
+        ppp_hdlc_decode(&dec, accm, stream + split, len - split, hdlc_on_frame, &frames);
+        TEST_ASSERT_EQUAL(split + 1, frames);
+        TEST_ASSERT_EQUAL(sizeof(frame), s_hdlc_frame_len);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(frame, s_hdlc_frame, sizeof(frame));
+    }
+    TEST_ASSERT_EQUAL(0, dec.fcs_errors);
+    TEST_ASSERT_EQUAL(0, dec.dropped);
+
+    // a control character of the map inserted by the link is dropped
+    uint8_t noisy[sizeof(stream) + 1];
+    memcpy(noisy, stream, 5);
+    noisy[5] = 0x01;
+    memcpy(noisy + 6, stream + 5, len - 5);
+    ppp_hdlc_decode(&dec, accm, noisy, len + 1, hdlc_on_frame, &frames);
+    TEST_ASSERT_EQUAL(len + 2, frames);
+
+    // a corrupted frame, an aborted frame and a frame which doesn't fit in the buffer are dropped
+    stream[12] ^= 0x40;
+    ppp_hdlc_decode(&dec, accm, stream, len, hdlc_on_frame, &frames);
+    TEST_ASSERT_EQUAL(1, dec.fcs_errors);
+    const uint8_t aborted[] = { PPP_HDLC_FLAG, 0xC0, 0x21, 0x01, PPP_HDLC_ESCAPE, PPP_HDLC_FLAG };
+    ppp_hdlc_decode(&dec, accm, aborted, sizeof(aborted), hdlc_on_frame, &frames);
+    TEST_ASSERT_EQUAL(1, dec.dropped);
+    ppp_hdlc_decoder_init(&dec, buf, sizeof(frame));
+    stream[12] ^= 0x40;
+    ppp_hdlc_decode(&dec, accm, stream, len, hdlc_on_frame, &frames);
+    TEST_ASSERT_EQUAL(1, dec.dropped);
+    TEST_ASSERT_EQUAL(len + 2, frames);
+}
+#endif // CONFIG_ESP_NETIF_PPP_FAST_PATH
+
 TEST_GROUP_RUNNER(esp_netif)
 {
     /**
@@ -592,6 +669,9 @@ TEST_GROUP_RUNNER(esp_netif)
     RUN_TEST_CASE(esp_netif, get_from_if_key)
     RUN_TEST_CASE(esp_netif, create_delete_multiple_netifs)
     RUN_TEST_CASE(esp_netif, find_netifs)
+#if CONFIG_ESP_NETIF_PPP_FAST_PATH
+    RUN_TEST_CASE(esp_netif, ppp_hdlc_framing)
+#endif
 #ifdef CONFIG_ESP_WIFI_ENABLED
     RUN_TEST_CASE(esp_netif, wifi_netif_api_null_deref)
     RUN_TEST_CASE(esp_netif, create_custom_wifi_interfaces)
@@ -10,6 +10,7 @@ from pytest_embedded import Dut
 @pytest.mark.parametrize('config', [
     'global_dns',
     'dns_per_netif',
+    'ppp_fast_path',
     'loopback',             # test config without LWIP
 ], indirect=True)
 def test_esp_netif(dut: Dut) -> None:
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -944,6 +944,90 @@ TEST_CASE("esp32 l2tap - ioctl - INTF_DEVICE/DEVICE_DRV_HNDL", "[ethernet]")
     ethernet_deinit(&eth_network_hndls);
 }
 
+/* ============================================================================= */
+/**
+ * @brief Verifies proper functionality of ioctl RX_FRAMES/RX_FRAMES_FREE/TX_FRAMES options
+ *
+ */
+TEST_CASE("esp32 l2tap - ioctl - RX_FRAMES/TX_FRAMES", "[ethernet]")
+{
+    test_vfs_eth_network_t eth_network_hndls;
+    int eth_tap_fd;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_vfs_l2tap_intf_register(NULL));
+    ethernet_init(&eth_network_hndls);
+
+    eth_tap_fd = open("/dev/net/tap", 0);
+    TEST_ASSERT_NOT_EQUAL(-1, eth_tap_fd);
+
+    TEST_ASSERT_NOT_EQUAL(-1, ioctl(eth_tap_fd, L2TAP_S_INTF_DEVICE, "ETH_DEF"));
+    uint16_t eth_type_filter = ETH_FILTER_LE;
+    TEST_ASSERT_NOT_EQUAL(-1, ioctl(eth_tap_fd, L2TAP_S_RCV_FILTER, &eth_type_filter));
+
+    ESP_LOGI(TAG, "Verify the frames are taken without copying, blocking until the first one arrives...");
+    send_task_control_t send_task_ctrl = {
+        .eth_network_hndls_p = &eth_network_hndls,
+        .eth_type = -1,
+        .send_delay_ms = DEFAULT_SEND_DELAY_MS,
+    };
+    xTaskCreate(send_task, "raw_eth_send_task", 1024, &send_task_ctrl, tskIDLE_PRIORITY + 2, NULL);
+
+    l2tap_frame_t frames[4] = {0};
+    l2tap_frames_t rx_frames = {
+        .frames = frames,
+        .count = sizeof(frames) / sizeof(frames[0]),
+    };
+    TEST_ASSERT_EQUAL(0, ioctl(eth_tap_fd, L2TAP_G_RX_FRAMES, &rx_frames));
+    TEST_ASSERT_EQUAL(1, rx_frames.count);
+    TEST_ASSERT_NOT_NULL(frames[0].buff);
+    TEST_ASSERT_GREATER_OR_EQUAL(sizeof(s_test_msg), frames[0].len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&s_test_msg, frames[0].buff, sizeof(s_test_msg));
+    TEST_ASSERT_EQUAL(0, ioctl(eth_tap_fd, L2TAP_S_RX_FRAMES_FREE, &rx_frames));
+    TEST_ASSERT_NULL(frames[0].buff);
+
+    ESP_LOGI(TAG, "Verify non-blocking RX_FRAMES returns EAGAIN when no frame is queued...");
+    TEST_ASSERT_EQUAL(0, fcntl(eth_tap_fd, F_SETFL, O_NONBLOCK));
+    rx_frames.count = sizeof(frames) / sizeof(frames[0]);
+    TEST_ASSERT_EQUAL(-1, ioctl(eth_tap_fd, L2TAP_G_RX_FRAMES, &rx_frames));
+    TEST_ASSERT_EQUAL(EAGAIN, errno);
+
+    ESP_LOGI(TAG, "Verify TX_FRAMES stops at the frame with different Ethernet type than the fd is configured to...");
+    test_vfs_eth_tap_msg_t test_msgs[2] = {
+        [0] = {
+            .header = {
+                .dest.addr = { 0x01, 0x00, 0x00, 0x00, 0xBE, 0xEF },
+                .type = htons(ETH_FILTER_LE),
+            }
+        },
+        [1] = {
+            .header = {
+                .dest.addr = { 0x01, 0x00, 0x00, 0x00, 0xBE, 0xEF },
+                .type = htons(ETH_FILTER_LE + 10),
+            }
+        },
+    };
+    esp_eth_ioctl(eth_network_hndls.eth_handle, ETH_CMD_G_MAC_ADDR, &test_msgs[0].header.src.addr);
+    l2tap_frame_t tx_frame_list[] = {
+        { .buff = &test_msgs[0], .len = sizeof(test_msgs[0]) },
+        { .buff = &test_msgs[1], .len = sizeof(test_msgs[1]) },
+    };
+    l2tap_frames_t tx_frames = {
+        .frames = tx_frame_list,
+        .count = 1,
+    };
+    TEST_ASSERT_EQUAL(0, ioctl(eth_tap_fd, L2TAP_S_TX_FRAMES, &tx_frames));
+    TEST_ASSERT_EQUAL(1, tx_frames.count);
+    tx_frames.count = 2;
+    TEST_ASSERT_EQUAL(-1, ioctl(eth_tap_fd, L2TAP_S_TX_FRAMES, &tx_frames));
+    TEST_ASSERT_EQUAL(EBADMSG, errno);
+    TEST_ASSERT_EQUAL(1, tx_frames.count);
+
+    TEST_ASSERT_EQUAL(0, close(eth_tap_fd));
+    vTaskDelay(pdMS_TO_TICKS(50)); // just for sure to give some time to send task close fd
+    TEST_ASSERT_EQUAL(ESP_OK, esp_vfs_l2tap_intf_unregister(NULL));
+    ethernet_deinit(&eth_network_hndls);
+}
+
 /* ============================================================================= */
 /**
  * @brief Verifies proper functionality of ioctl unknown option
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -104,6 +104,20 @@ static esp_err_t push_rx_queue(l2tap_context_t *l2tap_socket, void *buff, size_t
     return ESP_OK;
 }
 
+static esp_err_t pop_rx_queue_frame(l2tap_context_t *l2tap_socket, frame_queue_entry_t *frame_info, TickType_t timeout)
+{
+    if (xQueueReceive(l2tap_socket->rx_queue, frame_info, timeout) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    // empty queue was issued indicating the fd is going to be closed
+    if (frame_info->len == 0) {
+        // indicate to "clean_task" that task waiting for queue was unblocked
+        push_rx_queue(l2tap_socket, NULL, 0);
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
+
 static ssize_t pop_rx_queue(l2tap_context_t *l2tap_socket, void *buff, size_t len)
 {
     TickType_t timeout = portMAX_DELAY;
@@ -112,26 +126,36 @@ static ssize_t pop_rx_queue(l2tap_context_t *l2tap_socket, void *buff, size_t le
     }
 
     frame_queue_entry_t frame_info;
-    if (xQueueReceive(l2tap_socket->rx_queue, &frame_info, timeout) == pdTRUE) {
-        // empty queue was issued indicating the fd is going to be closed
-        if (frame_info.len == 0) {
-            // indicate to "clean_task" that task waiting for queue was unblocked
-            push_rx_queue(l2tap_socket, NULL, 0);
-            goto err;
-        }
+    if (pop_rx_queue_frame(l2tap_socket, &frame_info, timeout) != ESP_OK) {
+        return -1;
+    }
 
-        if (len > frame_info.len) {
-            len = frame_info.len;
-        }
-        memcpy(buff, frame_info.buff, len);
-        l2tap_socket->driver_free_rx_buffer(l2tap_socket->driver_handle, frame_info.buff);
-    } else {
-        goto err;
+    if (len > frame_info.len) {
+        len = frame_info.len;
     }
+    memcpy(buff, frame_info.buff, len);
+    l2tap_socket->driver_free_rx_buffer(l2tap_socket->driver_handle, frame_info.buff);
 
     return len;
-err:
-    return -1;
+}
+
+// moves the ownership of the queued frames to the caller, waits only for the first one
+static size_t pop_rx_queue_frames(l2tap_context_t *l2tap_socket, l2tap_frame_t *frames, size_t count)
+{
+    TickType_t timeout = portMAX_DELAY;
+    if (l2tap_socket->non_blocking) {
+        timeout = 0;
+    }
+
+    size_t popped = 0;
+    frame_queue_entry_t frame_info;
+    while (popped < count && pop_rx_queue_frame(l2tap_socket, &frame_info, timeout) == ESP_OK) {
+        frames[popped].buff = frame_info.buff;
+        frames[popped].len = frame_info.len;
+        popped++;
+        timeout = 0;
+    }
+    return popped;
 }
 
 static bool rx_queue_empty(l2tap_context_t *l2tap_socket)
@@ -229,34 +253,35 @@ err:
     return INVALID_FD;
 }
 
-static ssize_t l2tap_write(int fd, const void *data, size_t size)
+static ssize_t l2tap_transmit(int fd, const void *data, size_t size)
 {
-    ssize_t ret = -1;
+    if (s_l2tap_sockets[fd].ethtype_filter > ETH_IEEE802_3_MAX_LEN &&
+            ((struct eth_hdr *)data)->type != htons(s_l2tap_sockets[fd].ethtype_filter)) {
+        // bad message
+        errno = EBADMSG;
+        return -1;
+    }
+
+    if (s_l2tap_sockets[fd].driver_transmit(s_l2tap_sockets[fd].driver_handle, (void *)data, size) != ESP_OK) {
+        // I/O error
+        errno = EIO;
+        return -1;
+    }
+    return size;
+}
 
+static ssize_t l2tap_write(int fd, const void *data, size_t size)
+{
     if (size == 0) {
         return 0;
     }
 
-    if (atomic_load(&s_l2tap_sockets[fd].state) == L2TAP_SOCK_STATE_OPENED) {
-        if (s_l2tap_sockets[fd].ethtype_filter > ETH_IEEE802_3_MAX_LEN &&
-                ((struct eth_hdr *)data)->type != htons(s_l2tap_sockets[fd].ethtype_filter)) {
-            // bad message
-            errno = EBADMSG;
-            goto err;
-        }
-
-        if (s_l2tap_sockets[fd].driver_transmit(s_l2tap_sockets[fd].driver_handle, (void *)data, size) == ESP_OK) {
-            ret = size;
-        } else {
-            // I/O error
-            errno = EIO;
-        }
-    } else {
+    if (atomic_load(&s_l2tap_sockets[fd].state) != L2TAP_SOCK_STATE_OPENED) {
         // bad file desc
         errno = EBADF;
+        return -1;
     }
-err:
-    return ret;
+    return l2tap_transmit(fd, data, size);
 }
 
 static ssize_t l2tap_read(int fd, void *data, size_t size)
@@ -408,6 +433,52 @@ static int l2tap_ioctl(int fd, int cmd, va_list args)
         l2tap_iodriver_handle *get_driver_hdl = va_arg(args, l2tap_iodriver_handle*);
         *get_driver_hdl = s_l2tap_sockets[fd].driver_handle;
         break;
+    case L2TAP_G_RX_FRAMES: ;
+        l2tap_frames_t *rx_frames = va_arg(args, l2tap_frames_t *);
+        if (atomic_load(&s_l2tap_sockets[fd].state) != L2TAP_SOCK_STATE_OPENED) {
+            errno = EBADF;
+            goto err;
+        }
+        if (rx_frames == NULL || (rx_frames->frames == NULL && rx_frames->count > 0)) {
+            errno = EINVAL;
+            goto err;
+        }
+        if (rx_frames->count > 0 &&
+                (rx_frames->count = pop_rx_queue_frames(&s_l2tap_sockets[fd], rx_frames->frames, rx_frames->count)) == 0) {
+            errno = EAGAIN;
+            goto err;
+        }
+        break;
+    case L2TAP_S_RX_FRAMES_FREE: ;
+        l2tap_frames_t *free_frames = va_arg(args, l2tap_frames_t *);
+        if (free_frames == NULL || (free_frames->frames == NULL && free_frames->count > 0)) {
+            errno = EINVAL;
+            goto err;
+        }
+        for (size_t i = 0; i < free_frames->count; i++) {
+            s_l2tap_sockets[fd].driver_free_rx_buffer(s_l2tap_sockets[fd].driver_handle, free_frames->frames[i].buff);
+            free_frames->frames[i].buff = NULL;
+        }
+        break;
+    case L2TAP_S_TX_FRAMES: ;
+        l2tap_frames_t *tx_frames = va_arg(args, l2tap_frames_t *);
+        if (atomic_load(&s_l2tap_sockets[fd].state) != L2TAP_SOCK_STATE_OPENED) {
+            errno = EBADF;
+            goto err;
+        }
+        if (tx_frames == NULL || (tx_frames->frames == NULL && tx_frames->count > 0)) {
+            errno = EINVAL;
+            goto err;
+        }
+        for (size_t i = 0; i < tx_frames->count; i++) {
+            if (tx_frames->frames[i].len > 0 &&
+                    l2tap_transmit(fd, tx_frames->frames[i].buff, tx_frames->frames[i].len) < 0) {
+                // report how many frames were sent before the failing one, errno is already set
+                tx_frames->count = i;
+                goto err;
+            }
+        }
+        break;
     default:
         // unsupported operation
         errno = ENOSYS;
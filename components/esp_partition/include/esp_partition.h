@@ -399,6 +399,106 @@ esp_err_t esp_partition_mmap(const esp_partition_t* partition, size_t offset, si
  */
 void esp_partition_munmap(esp_partition_mmap_handle_t handle);
 
+/**
+ * @brief Opaque handle of a memory-mapped read cursor, see esp_partition_mmap_cursor_create
+ */
+typedef struct esp_partition_mmap_cursor *esp_partition_mmap_cursor_handle_t;
+
+/**
+ * @brief Configuration of a memory-mapped read cursor
+ */
+typedef struct {
+    size_t window_size;     /*!< Size of one mapped window, rounded up to a multiple of the MMU page size.
+                                 0 to use one MMU page. */
+    size_t max_windows;     /*!< Number of windows which can stay mapped at the same time. 0 to use 2. */
+} esp_partition_mmap_cursor_config_t;
+
+/**
+ * @brief Create a cursor to read a partition through a set of memory-mapped windows
+ *
+ * The cursor keeps up to max_windows regions of the partition mapped. An access to a region which is
+ * not mapped yet unmaps the least recently used window and maps a new one, so random accesses to a
+ * large partition do not need one esp_partition_mmap call per access, and the number of MMU pages
+ * used stays bounded.
+ *
+ * @note The cursor is not thread-safe. Use one cursor per task, or protect the accesses with a lock.
+ *
+ * @param partition  Partition to read, must be located on the main flash chip
+ * @param config     Configuration of the cursor, NULL to use the defaults
+ * @param[out] out_cursor  Created cursor
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if partition or out_cursor is NULL
+ *      - ESP_ERR_NOT_SUPPORTED if the partition is not on the main flash chip
+ *      - ESP_ERR_NO_MEM if the cursor could not be allocated
+ */
+esp_err_t esp_partition_mmap_cursor_create(const esp_partition_t *partition, const esp_partition_mmap_cursor_config_t *config,
+                                           esp_partition_mmap_cursor_handle_t *out_cursor);
+
+/**
+ * @brief Delete a cursor and unmap all its windows
+ *
+ * @param cursor  Cursor created by esp_partition_mmap_cursor_create, may be NULL
+ */
+void esp_partition_mmap_cursor_delete(esp_partition_mmap_cursor_handle_t cursor);
+
+/**
+ * @brief Get a pointer to a region of the partition
+ *
+ * The region is mapped if needed. A region larger than window_size is mapped in a single, larger window.
+ *
+ * @param cursor   Cursor
+ * @param offset   Offset of the region in the partition
+ * @param size     Size of the region
+ * @param[out] out_ptr  Pointer to the data of the region. It stays valid until the next call on the cursor.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the offset is outside of the partition
+ *      - ESP_ERR_INVALID_SIZE if the region goes past the end of the partition
+ *      - ESP_ERR_NO_MEM if no free MMU pages are left for the window
+ */
+esp_err_t esp_partition_mmap_cursor_get_ptr(esp_partition_mmap_cursor_handle_t cursor, size_t offset, size_t size, const void **out_ptr);
+
+/**
+ * @brief Copy data of the partition to a buffer
+ *
+ * The copy goes through the windows of the cursor and may map several windows.
+ *
+ * @param cursor   Cursor
+ * @param offset   Offset of the data in the partition
+ * @param[out] dst Buffer to copy the data to
+ * @param size     Number of bytes to copy
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the offset is outside of the partition
+ *      - ESP_ERR_INVALID_SIZE if the data goes past the end of the partition
+ *      - ESP_ERR_NO_MEM if no free MMU pages are left for a window
+ */
+esp_err_t esp_partition_mmap_cursor_read(esp_partition_mmap_cursor_handle_t cursor, size_t offset, void *dst, size_t size);
+
+/**
+ * @brief Hint that a region of the partition will be read soon
+ *
+ * Maps the windows covering the region and reads one byte of each cache line, so that the data is in the cache
+ * when it is used. Call it from a point where the caller would otherwise wait, e.g. before processing the
+ * current data. Prefetching more than the size of the cache, or more than the windows of the cursor can hold,
+ * evicts the start of the region again.
+ *
+ * @param cursor   Cursor
+ * @param offset   Offset of the region in the partition
+ * @param size     Size of the region
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the offset is outside of the partition
+ *      - ESP_ERR_INVALID_SIZE if the region goes past the end of the partition
+ *      - ESP_ERR_NO_MEM if no free MMU pages are left for a window
+ */
+esp_err_t esp_partition_mmap_cursor_prefetch(esp_partition_mmap_cursor_handle_t cursor, size_t offset, size_t size);
+
 /**
  * @brief Get SHA-256 digest for required partition.
  *
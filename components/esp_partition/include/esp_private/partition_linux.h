@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -167,10 +167,65 @@ size_t esp_partition_get_write_bytes(void);
  * esp_partition_write and esp_partition_erase_range operations.
  *
  * @return
- *      - estimated total time spent in read/write/erase operations in milliseconds
+ *      - estimated total time spent in read/write/erase operations in microseconds
  */
 size_t esp_partition_get_total_time(void);
 
+/** @brief Statistics of the emulated partition operations since recent esp_partition_clear_stats */
+typedef struct {
+    size_t read_ops;            /*!< Number of calls to esp_partition_read */
+    size_t write_ops;           /*!< Number of calls to esp_partition_write */
+    size_t erase_ops;           /*!< Number of emulated sectors erased */
+    size_t read_bytes;          /*!< Number of bytes read */
+    size_t write_bytes;         /*!< Number of bytes written */
+    uint64_t read_time_us;      /*!< Estimated time spent in read operations, in microseconds */
+    uint64_t write_time_us;     /*!< Estimated time spent in write operations, in microseconds */
+    uint64_t erase_time_us;     /*!< Estimated time spent in erase operations, in microseconds */
+} esp_partition_stats_t;
+
+/**
+ * @brief Returns all statistics of the emulated partition operations
+ *
+ * @param[out] stats Statistics since recent esp_partition_clear_stats
+ */
+void esp_partition_get_stats(esp_partition_stats_t *stats);
+
+/**
+ * @brief Timing model of the emulated SPI FLASH device
+ *
+ * Times are in nanoseconds. A write is split in the program pages it touches, like a real SPI NOR flash does.
+ */
+typedef struct {
+    uint32_t read_setup_ns;     /*!< Fixed time of a read operation: command, address and dummy cycles */
+    uint32_t read_ns_per_byte;  /*!< Time to transfer one byte read */
+    uint32_t write_setup_ns;    /*!< Fixed time of a write operation: write enable, command and address */
+    uint32_t page_program_ns;   /*!< Time to program one page, including the transfer of the data */
+    uint32_t page_size;         /*!< Size of a program page in bytes, a power of 2 */
+    uint32_t sector_erase_ns;   /*!< Time to erase one emulated sector */
+} esp_partition_timing_model_t;
+
+/**
+ * @brief Timing model of a typical quad SPI NOR flash at 80 MHz
+ */
+#define ESP_PARTITION_TIMING_MODEL_SPI_NOR_DEFAULT() { \
+    .read_setup_ns = 1000, \
+    .read_ns_per_byte = 25, \
+    .write_setup_ns = 2000, \
+    .page_program_ns = 600000, \
+    .page_size = 256, \
+    .sector_erase_ns = 45000000, \
+}
+
+/**
+ * @brief Sets the timing model used to estimate the time of partition operations
+ *
+ * By default, the time is interpolated from measurements of an ESP8266 at 160MHz with an 80MHz flash.
+ * The statistics gathered so far are kept, call esp_partition_clear_stats to start a new measurement.
+ *
+ * @param[in] model Timing model to use, NULL to restore the default one. The structure is copied.
+ */
+void esp_partition_set_timing_model(const esp_partition_timing_model_t *model);
+
 /**
  * @brief Initializes emulation of lost power failure in write/erase operations
  *
@@ -39,7 +39,9 @@ static size_t s_esp_partition_stat_write_ops = 0;
 static size_t s_esp_partition_stat_read_bytes = 0;
 static size_t s_esp_partition_stat_write_bytes = 0;
 static size_t s_esp_partition_stat_erase_ops = 0;
-static size_t s_esp_partition_stat_total_time = 0;
+static uint64_t s_esp_partition_stat_read_time_ns = 0;
+static uint64_t s_esp_partition_stat_write_time_ns = 0;
+static uint64_t s_esp_partition_stat_erase_time_ns = 0;
 static size_t s_esp_partition_emulated_power_off_counter = SIZE_MAX;
 static uint8_t s_esp_partition_emulated_power_off_mode = 0;
 
@@ -574,6 +576,10 @@ static size_t s_esp_partition_stat_read_times[] = {7, 5, 6, 7, 11, 18, 32, 60, 1
 static size_t s_esp_partition_stat_write_times[] = {19, 23, 35, 57, 106, 205, 417, 814, 1622, 3200, 6367};
 static size_t s_esp_partition_stat_block_erase_time = 37142;
 
+// timing model set by esp_partition_set_timing_model, used instead of the tables above
+static esp_partition_timing_model_t s_esp_partition_timing_model;
+static bool s_esp_partition_timing_model_set = false;
+
 static size_t esp_partition_stat_time_interpolate(uint32_t bytes, size_t *lut)
 {
     const int lut_size = sizeof(s_esp_partition_stat_read_times) / sizeof(s_esp_partition_stat_read_times[0]);
@@ -587,6 +593,37 @@ static size_t esp_partition_stat_time_interpolate(uint32_t bytes, size_t *lut)
     return (bytes - x1) * (y2 - y1) / (x2 - x1) + y1;
 }
 
+static uint64_t esp_partition_stat_read_time_ns(size_t size)
+{
+    if (!s_esp_partition_timing_model_set) {
+        return (uint64_t) esp_partition_stat_time_interpolate((uint32_t) size, s_esp_partition_stat_read_times) * 1000;
+    }
+    return s_esp_partition_timing_model.read_setup_ns + (uint64_t) size * s_esp_partition_timing_model.read_ns_per_byte;
+}
+
+static uint64_t esp_partition_stat_write_time_ns(const void *dstAddr, size_t size)
+{
+    if (!s_esp_partition_timing_model_set) {
+        return (uint64_t) esp_partition_stat_time_interpolate((uint32_t) size, s_esp_partition_stat_write_times) * 1000;
+    }
+    if (size == 0) {
+        return 0;
+    }
+    // count the program pages touched by the write
+    size_t page_size = s_esp_partition_timing_model.page_size;
+    size_t offset = (const uint8_t *) dstAddr - (const uint8_t *) s_spiflash_mem_file_buf;
+    size_t pages = (offset + size - 1) / page_size - offset / page_size + 1;
+    return s_esp_partition_timing_model.write_setup_ns + (uint64_t) pages * s_esp_partition_timing_model.page_program_ns;
+}
+
+static uint64_t esp_partition_stat_erase_time_ns(void)
+{
+    if (!s_esp_partition_timing_model_set) {
+        return (uint64_t) s_esp_partition_stat_block_erase_time * 1000;
+    }
+    return s_esp_partition_timing_model.sector_erase_ns;
+}
+
 // Registers read access statistics of emulated SPI FLASH device (Linux host)
 // Function increases nmuber of read operations, accumulates number of read bytes
 // and accumulates emulated read operation time (size dependent)
@@ -597,7 +634,7 @@ static void esp_partition_hook_read(const void *srcAddr, const size_t size)
     // stats
     ++s_esp_partition_stat_read_ops;
     s_esp_partition_stat_read_bytes += size;
-    s_esp_partition_stat_total_time += esp_partition_stat_time_interpolate((uint32_t) size, s_esp_partition_stat_read_times);
+    s_esp_partition_stat_read_time_ns += esp_partition_stat_read_time_ns(size);
 }
 
 // Registers write access statistics of emulated SPI FLASH device (Linux host)
@@ -640,7 +677,7 @@ static bool esp_partition_hook_write(const void *dstAddr, size_t *size)
         // stats
         ++s_esp_partition_stat_write_ops;
         s_esp_partition_stat_write_bytes += write_cycles * 4;
-        s_esp_partition_stat_total_time += esp_partition_stat_time_interpolate((uint32_t) (*size), s_esp_partition_stat_write_times);
+        s_esp_partition_stat_write_time_ns += esp_partition_stat_write_time_ns(dstAddr, *size);
     }
 
     return ret_val;
@@ -693,7 +730,7 @@ static bool esp_partition_hook_erase(const void *dstAddr, size_t *size)
     for (size_t sector_index = first_sector_idx; sector_index < first_sector_idx + sector_count; sector_index++) {
         ++s_esp_partition_stat_erase_ops;
         s_esp_partition_stat_sector_erase_count[sector_index]++;
-        s_esp_partition_stat_total_time += s_esp_partition_stat_block_erase_time;
+        s_esp_partition_stat_erase_time_ns += esp_partition_stat_erase_time_ns();
     }
 
     return ret_val;
@@ -706,7 +743,9 @@ void esp_partition_clear_stats(void)
     s_esp_partition_stat_erase_ops = 0;
     s_esp_partition_stat_read_ops = 0;
     s_esp_partition_stat_write_ops = 0;
-    s_esp_partition_stat_total_time = 0;
+    s_esp_partition_stat_read_time_ns = 0;
+    s_esp_partition_stat_write_time_ns = 0;
+    s_esp_partition_stat_erase_time_ns = 0;
 
     memset(s_esp_partition_stat_sector_erase_count, 0, sizeof(size_t) * s_esp_partition_file_mmap_ctrl_act.flash_file_size / ESP_PARTITION_EMULATED_SECTOR_SIZE);
 }
@@ -738,7 +777,31 @@ size_t esp_partition_get_write_bytes(void)
 
 size_t esp_partition_get_total_time(void)
 {
-    return s_esp_partition_stat_total_time;
+    return (s_esp_partition_stat_read_time_ns + s_esp_partition_stat_write_time_ns + s_esp_partition_stat_erase_time_ns) / 1000;
+}
+
+void esp_partition_get_stats(esp_partition_stats_t *stats)
+{
+    assert(stats != NULL);
+    stats->read_ops = s_esp_partition_stat_read_ops;
+    stats->write_ops = s_esp_partition_stat_write_ops;
+    stats->erase_ops = s_esp_partition_stat_erase_ops;
+    stats->read_bytes = s_esp_partition_stat_read_bytes;
+    stats->write_bytes = s_esp_partition_stat_write_bytes;
+    stats->read_time_us = s_esp_partition_stat_read_time_ns / 1000;
+    stats->write_time_us = s_esp_partition_stat_write_time_ns / 1000;
+    stats->erase_time_us = s_esp_partition_stat_erase_time_ns / 1000;
+}
+
+void esp_partition_set_timing_model(const esp_partition_timing_model_t *model)
+{
+    if (model == NULL) {
+        s_esp_partition_timing_model_set = false;
+        return;
+    }
+    assert(model->page_size > 0 && (model->page_size & (model->page_size - 1)) == 0);
+    s_esp_partition_timing_model = *model;
+    s_esp_partition_timing_model_set = true;
 }
 
 void esp_partition_fail_after(size_t count, uint8_t mode)
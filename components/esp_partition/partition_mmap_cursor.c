@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include "esp_flash.h"
+#include "esp_partition.h"
+
+#define MMAP_CURSOR_DEFAULT_WINDOWS     2
+/* Smallest cache line size of the supported chips */
+#define MMAP_CURSOR_PREFETCH_STRIDE     32
+
+typedef struct {
+    size_t start;                       /* Offset in the partition of the first mapped byte */
+    size_t size;                        /* Number of mapped bytes, 0 if the window is not used */
+    const uint8_t *ptr;
+    esp_partition_mmap_handle_t handle;
+    uint32_t last_use;
+} mmap_window_t;
+
+struct esp_partition_mmap_cursor {
+    const esp_partition_t *partition;
+    size_t window_size;
+    size_t window_count;
+    uint32_t use_counter;
+    mmap_window_t windows[];
+};
+
+static esp_err_t check_range(const esp_partition_mmap_cursor_handle_t cursor, size_t offset, size_t size)
+{
+    if (offset > cursor->partition->size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (size > cursor->partition->size - offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
+
+/* Returns a window containing [offset, offset + size), mapping it in place of the least recently used one if needed */
+static esp_err_t get_window(esp_partition_mmap_cursor_handle_t cursor, size_t offset, size_t size, mmap_window_t **out_window)
+{
+    mmap_window_t *victim = &cursor->windows[0];
+
+    for (size_t i = 0; i < cursor->window_count; i++) {
+        mmap_window_t *window = &cursor->windows[i];
+        if (window->size != 0 && offset >= window->start && offset + size <= window->start + window->size) {
+            window->last_use = ++cursor->use_counter;
+            *out_window = window;
+            return ESP_OK;
+        }
+        if (victim->size != 0 && (window->size == 0 || window->last_use < victim->last_use)) {
+            victim = window;
+        }
+    }
+
+    if (victim->size != 0) {
+        esp_partition_munmap(victim->handle);
+        victim->size = 0;
+    }
+
+    // Windows are aligned to the window size, larger regions get a larger window
+    const size_t start = offset - offset % cursor->window_size;
+    size_t end = offset + size + cursor->window_size - 1;
+    end -= end % cursor->window_size;
+    end = MAX(end, start + cursor->window_size);
+    end = MIN(end, cursor->partition->size);
+
+    const void *ptr;
+    esp_err_t err = esp_partition_mmap(cursor->partition, start, end - start, ESP_PARTITION_MMAP_DATA, &ptr, &victim->handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    victim->start = start;
+    victim->size = end - start;
+    victim->ptr = ptr;
+    victim->last_use = ++cursor->use_counter;
+    *out_window = victim;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap_cursor_create(const esp_partition_t *partition, const esp_partition_mmap_cursor_config_t *config,
+                                           esp_partition_mmap_cursor_handle_t *out_cursor)
+{
+    if (partition == NULL || out_cursor == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (partition->flash_chip != esp_flash_default_chip) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    size_t window_size = (config && config->window_size) ? config->window_size : CONFIG_MMU_PAGE_SIZE;
+    window_size = (window_size + CONFIG_MMU_PAGE_SIZE - 1) & ~(CONFIG_MMU_PAGE_SIZE - 1);
+    const size_t window_count = (config && config->max_windows) ? config->max_windows : MMAP_CURSOR_DEFAULT_WINDOWS;
+
+    esp_partition_mmap_cursor_handle_t cursor = calloc(1, sizeof(*cursor) + window_count * sizeof(mmap_window_t));
+    if (cursor == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    cursor->partition = partition;
+    cursor->window_size = window_size;
+    cursor->window_count = window_count;
+    *out_cursor = cursor;
+    return ESP_OK;
+}
+
+void esp_partition_mmap_cursor_delete(esp_partition_mmap_cursor_handle_t cursor)
+{
+    if (cursor == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < cursor->window_count; i++) {
+        if (cursor->windows[i].size != 0) {
+            esp_partition_munmap(cursor->windows[i].handle);
+        }
+    }
+    free(cursor);
+}
+
+esp_err_t esp_partition_mmap_cursor_get_ptr(esp_partition_mmap_cursor_handle_t cursor, size_t offset, size_t size, const void **out_ptr)
+{
+    // An empty region still needs a mapped byte to point to
+    size = MAX(size, 1);
+    esp_err_t err = check_range(cursor, offset, size);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    mmap_window_t *window;
+    err = get_window(cursor, offset, size, &window);
+    if (err == ESP_OK) {
+        *out_ptr = window->ptr + (offset - window->start);
+    }
+    return err;
+}
+
+esp_err_t esp_partition_mmap_cursor_read(esp_partition_mmap_cursor_handle_t cursor, size_t offset, void *dst, size_t size)
+{
+    esp_err_t err = check_range(cursor, offset, size);
+
+    while (err == ESP_OK && size > 0) {
+        mmap_window_t *window;
+        err = get_window(cursor, offset, 1, &window);
+        if (err != ESP_OK) {
+            break;
+        }
+        const size_t len = MIN(size, window->start + window->size - offset);
+        memcpy(dst, window->ptr + (offset - window->start), len);
+        dst = (uint8_t *)dst + len;
+        offset += len;
+        size -= len;
+    }
+    return err;
+}
+
+esp_err_t esp_partition_mmap_cursor_prefetch(esp_partition_mmap_cursor_handle_t cursor, size_t offset, size_t size)
+{
+    esp_err_t err = check_range(cursor, offset, size);
+
+    while (err == ESP_OK && size > 0) {
+        mmap_window_t *window;
+        err = get_window(cursor, offset, 1, &window);
+        if (err != ESP_OK) {
+            break;
+        }
+        const size_t len = MIN(size, window->start + window->size - offset);
+        const volatile uint8_t *ptr = window->ptr + (offset - window->start);
+        for (size_t i = 0; i < len; i += MMAP_CURSOR_PREFETCH_STRIDE) {
+            (void)ptr[i];
+        }
+        offset += len;
+        size -= len;
+    }
+    return err;
+}
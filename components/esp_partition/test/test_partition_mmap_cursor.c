@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "test_utils.h"
+#include "esp_partition.h"
+#include "spi_flash_mmap.h"
+
+#define TEST_READ_LEN   256
+
+TEST_CASE("mmap cursor reads the same data as esp_partition_read", "[partition]")
+{
+    const esp_partition_t *part = get_test_data_partition();
+    uint8_t *expected = malloc(TEST_READ_LEN);
+    uint8_t *actual = malloc(TEST_READ_LEN);
+    TEST_ASSERT_NOT_NULL(expected);
+    TEST_ASSERT_NOT_NULL(actual);
+
+    esp_partition_mmap_cursor_handle_t cursor;
+    TEST_ESP_OK(esp_partition_mmap_cursor_create(part, NULL, &cursor));
+
+    const uint32_t free_pages = spi_flash_mmap_get_free_pages(SPI_FLASH_MMAP_DATA);
+    srand(42);
+    for (int i = 0; i < 64; i++) {
+        const size_t offset = rand() % (part->size - TEST_READ_LEN);
+        TEST_ESP_OK(esp_partition_read(part, offset, expected, TEST_READ_LEN));
+        TEST_ESP_OK(esp_partition_mmap_cursor_read(cursor, offset, actual, TEST_READ_LEN));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, TEST_READ_LEN);
+
+        const void *ptr;
+        TEST_ESP_OK(esp_partition_mmap_cursor_get_ptr(cursor, offset, TEST_READ_LEN, &ptr));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, ptr, TEST_READ_LEN);
+    }
+    // Two windows of one page, each may span two pages if the partition is not page aligned
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(4, free_pages - spi_flash_mmap_get_free_pages(SPI_FLASH_MMAP_DATA));
+
+    TEST_ESP_OK(esp_partition_mmap_cursor_prefetch(cursor, 0, part->size));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_partition_mmap_cursor_read(cursor, part->size + 1, actual, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_partition_mmap_cursor_read(cursor, part->size - 1, actual, 2));
+
+    esp_partition_mmap_cursor_delete(cursor);
+    TEST_ASSERT_EQUAL(free_pages, spi_flash_mmap_get_free_pages(SPI_FLASH_MMAP_DATA));
+
+    free(expected);
+    free(actual);
+}
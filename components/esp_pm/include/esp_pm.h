@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2016-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2016-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -42,7 +42,10 @@ typedef esp_pm_config_t esp_pm_config_esp32c6_t __attribute__((deprecated("pleas
 typedef enum {
     /**
      * Require CPU frequency to be at the maximum value set via esp_pm_configure.
-     * Argument is unused and should be set to 0.
+     * Argument is unused and should be set to 0, unless CONFIG_PM_DFS_LOAD_POLICY is enabled.
+     * In that case, argument is the lowest CPU frequency, in MHz, at which the lock holder still
+     * meets its latency target. The load policy may run the CPU at any frequency between the
+     * highest argument of the taken locks and the maximum value. 0 requires the maximum value.
      */
     ESP_PM_CPU_FREQ_MAX,
     /**
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2016-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2016-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -79,6 +79,26 @@ typedef enum {
  */
 void esp_pm_impl_switch_mode(pm_mode_t mode, pm_mode_switch_t lock_or_unlock, pm_time_t now);
 
+#if CONFIG_PM_DFS_LOAD_POLICY
+/**
+ * @brief Take the CPU frequency floor of an ESP_PM_CPU_FREQ_MAX lock
+ *
+ * The load policy doesn't choose a CPU frequency below the floor in PM_MODE_CPU_MAX
+ * until \ref esp_pm_impl_unlock_freq_floor is called.
+ *
+ * @param floor_mhz lowest CPU frequency required by the lock (argument passed to esp_pm_lock_create),
+ *                  0 to require the maximum CPU frequency
+ * @return frequency level resolved from floor_mhz, to be passed to \ref esp_pm_impl_unlock_freq_floor
+ */
+int esp_pm_impl_lock_freq_floor(int floor_mhz);
+
+/**
+ * @brief Release the CPU frequency floor of an ESP_PM_CPU_FREQ_MAX lock
+ * @param level frequency level returned by \ref esp_pm_impl_lock_freq_floor when the lock was taken
+ */
+void esp_pm_impl_unlock_freq_floor(int level);
+#endif // CONFIG_PM_DFS_LOAD_POLICY
+
 /**
  * @brief Call once at startup to initialize pm implementation
  */
@@ -102,6 +122,8 @@ void esp_pm_impl_isr_hook(void);
  * Prints three columns:
  * mode name, total time in mode (in microseconds), percentage of time in mode
  *
+ * Then prints a histogram of the time spent at each CPU frequency.
+ *
  * @param out stream to dump the information to
  */
 void esp_pm_impl_dump_stats(FILE* out);
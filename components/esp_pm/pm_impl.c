@@ -108,6 +108,21 @@
 #define WITH_PROFILING
 #endif
 
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+/* Frequency floor of the locks held while RTOS tasks are running, leaves the frequency to the load policy */
+#define PM_RTOS_LOCK_FREQ_FLOOR 1
+/* Maximum number of CPU frequencies the load policy can choose from in CPU_MAX mode */
+#define PM_DFS_LEVEL_NUM_MAX    8
+/* Load, in percent, above which the core is considered saturated. The real demand can't be
+ * measured then, so the policy goes straight to the maximum frequency.
+ */
+#define PM_DFS_SATURATED_LOAD   95
+/* Weight of the previous prediction when the demand decreases */
+#define PM_DFS_DEMAND_DECAY     4
+#else
+#define PM_RTOS_LOCK_FREQ_FLOOR 0
+#endif // CONFIG_PM_DFS_LOAD_POLICY
+
 static portMUX_TYPE s_switch_lock = portMUX_INITIALIZER_UNLOCKED;
 /* The following state variables are protected using s_switch_lock: */
 /* Current sleep mode; When switching, contains old mode until switch is complete */
@@ -162,6 +177,27 @@ static rtc_cpu_freq_config_t s_cpu_freq_by_mode[PM_MODE_COUNT];
 /* Whether automatic light sleep is enabled */
 static bool s_light_sleep_en = false;
 
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+/* CPU frequency configs the load policy chooses from in CPU_MAX mode, from the highest
+ * to the lowest one. Level 0 is the maximum frequency set via esp_pm_configure, the last
+ * level is the frequency of APB_MAX mode. The config of the chosen level is copied to
+ * s_cpu_freq_by_mode[PM_MODE_CPU_MAX]. Protected by s_switch_lock.
+ */
+static rtc_cpu_freq_config_t s_dfs_levels[PM_DFS_LEVEL_NUM_MAX];
+static int s_dfs_level_num = 1;
+/* Level currently used in CPU_MAX mode */
+static int s_dfs_level;
+/* Number of taken CPU_FREQ_MAX locks requiring each level, the policy doesn't go below the highest one */
+static size_t s_dfs_floor_counts[PM_DFS_LEVEL_NUM_MAX];
+/* Idle time of each CPU accumulated in the current window, and timestamp of the last idle entry */
+static int64_t s_dfs_idle_time[CONFIG_FREERTOS_NUMBER_OF_CORES];
+static int64_t s_dfs_idle_since[CONFIG_FREERTOS_NUMBER_OF_CORES];
+/* Timestamp when the current load measurement window started */
+static int64_t s_dfs_window_start;
+/* Predicted CPU demand of the busiest core, in MHz */
+static uint32_t s_dfs_demand_mhz;
+#endif // CONFIG_PM_DFS_LOAD_POLICY
+
 /* When configuration is changed, current frequency may not match the
  * newly configured frequency for the current mode. This is an indicator
  * to the mode switch code to get the actual current frequency instead of
@@ -182,6 +218,16 @@ static const char* s_mode_names[] = {
         "CPU_MAX"
 };
 static uint32_t s_light_sleep_counts, s_light_sleep_reject_counts;
+/* Maximum number of distinct CPU frequencies tracked by the time-in-frequency statistics */
+#define PM_FREQ_STATS_NUM 16
+/* Time, in microseconds, spent so far at each CPU frequency, in the order the frequencies were first used */
+static struct {
+    uint32_t freq_mhz;
+    pm_time_t time;
+} s_time_in_freq[PM_FREQ_STATS_NUM];
+/* CPU frequency currently used, and timestamp when the CPU frequency last changed */
+static uint32_t s_cur_freq_mhz;
+static pm_time_t s_last_freq_change_time;
 #endif // WITH_PROFILING
 
 #ifdef CONFIG_FREERTOS_SYSTICK_USES_CCOUNT
@@ -204,6 +250,12 @@ static const char* TAG = "pm";
 static void do_switch(pm_mode_t new_mode);
 static void leave_idle(void);
 static void on_freq_update(uint32_t old_ticks_per_us, uint32_t ticks_per_us);
+#ifdef WITH_PROFILING
+static void update_time_in_freq(uint32_t new_freq_mhz, pm_time_t now);
+#endif
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+static int dfs_build_levels(int max_freq_mhz, int apb_max_freq, rtc_cpu_freq_config_t *levels);
+#endif
 
 pm_mode_t esp_pm_impl_get_mode(esp_pm_lock_type_t type, int arg)
 {
@@ -447,6 +499,11 @@ esp_err_t esp_pm_configure(const void* vconfig)
 
     apb_max_freq = MAX(apb_max_freq, min_freq_mhz);
 
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+    rtc_cpu_freq_config_t dfs_levels[PM_DFS_LEVEL_NUM_MAX];
+    int dfs_level_num = dfs_build_levels(max_freq_mhz, apb_max_freq, dfs_levels);
+#endif
+
     ESP_LOGI(TAG, "Frequency switching config: "
                   "CPU_MAX: %d, APB_MAX: %d, APB_MIN: %d, Light sleep: %s",
                   max_freq_mhz,
@@ -467,6 +524,13 @@ esp_err_t esp_pm_configure(const void* vconfig)
     res = rtc_clk_cpu_freq_mhz_to_config(min_freq_mhz, &s_cpu_freq_by_mode[PM_MODE_APB_MIN]);
     assert(res);
     s_cpu_freq_by_mode[PM_MODE_LIGHT_SLEEP] = s_cpu_freq_by_mode[PM_MODE_APB_MIN];
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+    /* Start from the maximum frequency, the policy lowers it once the load is measured */
+    memcpy(s_dfs_levels, dfs_levels, sizeof(dfs_levels));
+    s_dfs_level_num = dfs_level_num;
+    s_dfs_level = 0;
+    s_dfs_demand_mhz = max_freq_mhz;
+#endif
 
     if (config->light_sleep_enable) {
         // Enable the wakeup source here because the `esp_sleep_disable_wakeup_source` in the `else`
@@ -495,7 +559,11 @@ esp_err_t esp_pm_get_configuration(void* vconfig)
 
     portENTER_CRITICAL(&s_switch_lock);
     config->light_sleep_enable = s_light_sleep_en;
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+    config->max_freq_mhz = s_dfs_levels[0].freq_mhz;
+#else
     config->max_freq_mhz = s_cpu_freq_by_mode[PM_MODE_CPU_MAX].freq_mhz;
+#endif
     config->min_freq_mhz = s_cpu_freq_by_mode[PM_MODE_APB_MIN].freq_mhz;
     portEXIT_CRITICAL(&s_switch_lock);
 
@@ -679,6 +747,11 @@ static void IRAM_ATTR do_switch(pm_mode_t new_mode)
     portENTER_CRITICAL_ISR(&s_switch_lock);
     s_mode = new_mode;
     s_is_switching = false;
+#ifdef WITH_PROFILING
+    if (new_config.freq_mhz != old_config.freq_mhz) {
+        update_time_in_freq(new_config.freq_mhz, pm_get_time());
+    }
+#endif // WITH_PROFILING
     portEXIT_CRITICAL_ISR(&s_switch_lock);
 }
 
@@ -714,9 +787,197 @@ static __attribute__((optimize("-O2"))) void IRAM_ATTR update_ccompare(void)
 }
 #endif // CONFIG_FREERTOS_SYSTICK_USES_CCOUNT
 
+#ifdef WITH_PROFILING
+/**
+ * @brief Account the time spent at the current CPU frequency, must be called with s_switch_lock held
+ * @param new_freq_mhz CPU frequency used from now on
+ * @param now current timestamp
+ */
+static void IRAM_ATTR update_time_in_freq(uint32_t new_freq_mhz, pm_time_t now)
+{
+    for (int i = 0; i < PM_FREQ_STATS_NUM; ++i) {
+        if (s_time_in_freq[i].freq_mhz == s_cur_freq_mhz || s_time_in_freq[i].freq_mhz == 0) {
+            s_time_in_freq[i].freq_mhz = s_cur_freq_mhz;
+            s_time_in_freq[i].time += now - s_last_freq_change_time;
+            break;
+        }
+    }
+    s_cur_freq_mhz = new_freq_mhz;
+    s_last_freq_change_time = now;
+}
+#endif // WITH_PROFILING
+
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+/**
+ * @brief Fill the CPU frequency levels the load policy chooses from in CPU_MAX mode
+ *
+ * Intermediate levels are derived from the same clock source as the maximum frequency,
+ * so that switching between them doesn't reconfigure the PLL.
+ *
+ * @param max_freq_mhz CPU frequency of CPU_MAX mode
+ * @param apb_max_freq CPU frequency of APB_MAX mode, used as the lowest level
+ * @param[out] levels levels from the highest to the lowest frequency
+ * @return number of levels
+ */
+static int dfs_build_levels(int max_freq_mhz, int apb_max_freq, rtc_cpu_freq_config_t *levels)
+{
+    int num = 0;
+    bool res __attribute__((unused));
+    res = rtc_clk_cpu_freq_mhz_to_config(max_freq_mhz, &levels[num++]);
+    assert(res);
+    rtc_cpu_freq_config_t config;
+    uint32_t source_freq_mhz = levels[0].source_freq_mhz;
+    for (uint32_t div = levels[0].div + 1; num < PM_DFS_LEVEL_NUM_MAX - 1; ++div) {
+        uint32_t freq_mhz = source_freq_mhz / div;
+        if (freq_mhz <= (uint32_t) apb_max_freq) {
+            break;
+        }
+        if (source_freq_mhz % div == 0 && rtc_clk_cpu_freq_mhz_to_config(freq_mhz, &config) &&
+                config.source == levels[0].source && config.source_freq_mhz == source_freq_mhz) {
+            levels[num++] = config;
+        }
+    }
+    if (apb_max_freq < max_freq_mhz) {
+        res = rtc_clk_cpu_freq_mhz_to_config(apb_max_freq, &levels[num++]);
+        assert(res);
+    }
+    return num;
+}
+
+/* Lowest level whose frequency is not below freq_mhz, must be called with s_switch_lock held */
+static int IRAM_ATTR dfs_lowest_level(uint32_t freq_mhz)
+{
+    for (int level = s_dfs_level_num - 1; level > 0; --level) {
+        if (s_dfs_levels[level].freq_mhz >= freq_mhz) {
+            return level;
+        }
+    }
+    return 0;
+}
+
+/* Highest level required by the taken CPU_FREQ_MAX locks, must be called with s_switch_lock held */
+static int IRAM_ATTR dfs_floor_level(void)
+{
+    for (int level = 0; level < s_dfs_level_num; ++level) {
+        if (s_dfs_floor_counts[level] > 0) {
+            return level;
+        }
+    }
+    return s_dfs_level_num - 1;
+}
+
+/**
+ * @brief Change the level used in CPU_MAX mode, must be called with s_switch_lock held
+ * @return true if CPU_MAX mode is active, and do_switch needs to be called to apply the new frequency
+ */
+static bool IRAM_ATTR dfs_set_level(int level)
+{
+    if (level == s_dfs_level) {
+        return false;
+    }
+    s_dfs_level = level;
+    s_cpu_freq_by_mode[PM_MODE_CPU_MAX] = s_dfs_levels[level];
+    /* The current frequency no longer matches the config of CPU_MAX mode */
+    s_config_changed = true;
+    return s_mode == PM_MODE_CPU_MAX;
+}
+
+/**
+ * @brief Pick the level for the next window from the load measured in the current one
+ *
+ * The demand of the busiest core, i.e. its load scaled by the frequency used in the window,
+ * is predicted with a moving average which follows increases immediately and decays slowly.
+ * The lowest level which serves the predicted demand at CONFIG_PM_DFS_LOAD_POLICY_TARGET_LOAD
+ * and meets the floors of the taken locks is chosen.
+ */
+static void IRAM_ATTR dfs_update_level(int64_t now)
+{
+    bool need_switch = false;
+    portENTER_CRITICAL_SAFE(&s_switch_lock);
+    int64_t window = now - s_dfs_window_start;
+    if (window >= CONFIG_PM_DFS_LOAD_POLICY_WINDOW_MS * 1000LL) {
+        uint32_t load = 0;
+        for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; ++i) {
+            int64_t idle_time = s_dfs_idle_time[i];
+            if (s_core_idle[i]) {
+                idle_time += now - s_dfs_idle_since[i];
+                s_dfs_idle_since[i] = now;
+            }
+            s_dfs_idle_time[i] = 0;
+            load = MAX(load, 100 - (uint32_t) MIN(idle_time * 100 / window, 100));
+        }
+        uint32_t demand_mhz = s_dfs_levels[0].freq_mhz;
+        if (load < PM_DFS_SATURATED_LOAD) {
+            demand_mhz = s_dfs_levels[s_dfs_level].freq_mhz * load / 100;
+        }
+        if (demand_mhz >= s_dfs_demand_mhz) {
+            s_dfs_demand_mhz = demand_mhz;
+        } else {
+            s_dfs_demand_mhz = (s_dfs_demand_mhz * (PM_DFS_DEMAND_DECAY - 1) + demand_mhz) / PM_DFS_DEMAND_DECAY;
+        }
+        int level = dfs_lowest_level(s_dfs_demand_mhz * 100 / CONFIG_PM_DFS_LOAD_POLICY_TARGET_LOAD);
+        need_switch = dfs_set_level(MIN(level, dfs_floor_level()));
+        s_dfs_window_start = now;
+    }
+    portEXIT_CRITICAL_SAFE(&s_switch_lock);
+    if (need_switch) {
+        do_switch(PM_MODE_CPU_MAX);
+    }
+}
+
+static void IRAM_ATTR dfs_enter_idle(int core_id, int64_t now)
+{
+    portENTER_CRITICAL_SAFE(&s_switch_lock);
+    s_dfs_idle_since[core_id] = now;
+    portEXIT_CRITICAL_SAFE(&s_switch_lock);
+    dfs_update_level(now);
+}
+
+static void IRAM_ATTR dfs_leave_idle(int core_id, int64_t now)
+{
+    portENTER_CRITICAL_SAFE(&s_switch_lock);
+    s_dfs_idle_time[core_id] += now - s_dfs_idle_since[core_id];
+    portEXIT_CRITICAL_SAFE(&s_switch_lock);
+}
+
+int IRAM_ATTR esp_pm_impl_lock_freq_floor(int floor_mhz)
+{
+    bool need_switch = false;
+    portENTER_CRITICAL_SAFE(&s_switch_lock);
+    int level = (floor_mhz > 0) ? dfs_lowest_level(floor_mhz) : 0;
+    s_dfs_floor_counts[level]++;
+    if (level < s_dfs_level) {
+        need_switch = dfs_set_level(level);
+    }
+    portEXIT_CRITICAL_SAFE(&s_switch_lock);
+    if (need_switch) {
+        do_switch(PM_MODE_CPU_MAX);
+    }
+    return level;
+}
+
+void IRAM_ATTR esp_pm_impl_unlock_freq_floor(int level)
+{
+    /* The frequency is lowered by the policy at the end of the current window */
+    portENTER_CRITICAL_SAFE(&s_switch_lock);
+    s_dfs_floor_counts[level]--;
+    portEXIT_CRITICAL_SAFE(&s_switch_lock);
+}
+#endif // CONFIG_PM_DFS_LOAD_POLICY
+
 static void IRAM_ATTR leave_idle(void)
 {
     int core_id = xPortGetCoreID();
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+    int64_t now = esp_timer_get_time();
+    if (s_core_idle[core_id]) {
+        dfs_leave_idle(core_id, now);
+    }
+    /* A busy core doesn't run the idle hook, so the window is also checked on interrupts */
+    if (now - s_dfs_window_start >= CONFIG_PM_DFS_LOAD_POLICY_WINDOW_MS * 1000LL) {
+        dfs_update_level(now);
+    }
+#endif // CONFIG_PM_DFS_LOAD_POLICY
     if (s_core_idle[core_id]) {
         // TODO: possible optimization: raise frequency here first
         esp_pm_lock_acquire(s_rtos_lock_handle[core_id]);
@@ -865,6 +1126,7 @@ void IRAM_ATTR vApplicationSleep( TickType_t xExpectedIdleTime )
 void esp_pm_impl_dump_stats(FILE* out)
 {
     pm_time_t time_in_mode[PM_MODE_COUNT];
+    __typeof__(s_time_in_freq) time_in_freq;
 
     portENTER_CRITICAL_ISR(&s_switch_lock);
     memcpy(time_in_mode, s_time_in_mode, sizeof(time_in_mode));
@@ -874,9 +1136,24 @@ void esp_pm_impl_dump_stats(FILE* out)
     bool light_sleep_en = s_light_sleep_en;
     uint32_t light_sleep_counts = s_light_sleep_counts;
     uint32_t light_sleep_reject_counts = s_light_sleep_reject_counts;
+    memcpy(time_in_freq, s_time_in_freq, sizeof(time_in_freq));
+    uint32_t cur_freq_mhz = s_cur_freq_mhz;
+    pm_time_t last_freq_change_time = s_last_freq_change_time;
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+    int dfs_level = s_dfs_level;
+    int dfs_level_num = s_dfs_level_num;
+    uint32_t dfs_demand_mhz = s_dfs_demand_mhz;
+#endif
     portEXIT_CRITICAL_ISR(&s_switch_lock);
 
     time_in_mode[cur_mode] += now - last_mode_change_time;
+    for (int i = 0; i < PM_FREQ_STATS_NUM; ++i) {
+        if (time_in_freq[i].freq_mhz == cur_freq_mhz || time_in_freq[i].freq_mhz == 0) {
+            time_in_freq[i].freq_mhz = cur_freq_mhz;
+            time_in_freq[i].time += now - last_freq_change_time;
+            break;
+        }
+    }
 
     fprintf(out, "\nMode stats:\n");
     fprintf(out, "%-8s  %-10s  %-10s  %-10s\n", "Mode", "CPU_freq", "Time(us)", "Time(%)");
@@ -896,6 +1173,31 @@ void esp_pm_impl_dump_stats(FILE* out)
         fprintf(out, "\nSleep stats:\n");
         fprintf(out, "light_sleep_counts:%ld  light_sleep_reject_counts:%ld\n", light_sleep_counts, light_sleep_reject_counts);
     }
+
+    /* Sort by frequency, from the highest to the lowest one */
+    for (int i = 1; i < PM_FREQ_STATS_NUM; ++i) {
+        for (int j = i; j > 0 && time_in_freq[j].freq_mhz > time_in_freq[j - 1].freq_mhz; --j) {
+            __typeof__(time_in_freq[0]) tmp = time_in_freq[j];
+            time_in_freq[j] = time_in_freq[j - 1];
+            time_in_freq[j - 1] = tmp;
+        }
+    }
+    static const char bar[] = "##################################################";
+    fprintf(out, "\nFrequency stats:\n");
+    fprintf(out, "%-8s  %-14s  %-7s  %s\n", "CPU_freq", "Time(us)", "Time(%)", "Histogram");
+    for (int i = 0; i < PM_FREQ_STATS_NUM && time_in_freq[i].freq_mhz != 0; ++i) {
+        int percent = (int) (time_in_freq[i].time * 100 / now);
+        fprintf(out, "%-3"PRIu32"M%-4s  %-14lld  %-3d%%     %.*s\n",
+                time_in_freq[i].freq_mhz,
+                "",                                     //Empty space to align columns
+                time_in_freq[i].time,
+                percent,
+                percent * (int) (sizeof(bar) - 1) / 100, bar);
+    }
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+    fprintf(out, "\nLoad policy: CPU_MAX level %d of %d, predicted demand %"PRIu32"M\n",
+            dfs_level, dfs_level_num, dfs_demand_mhz);
+#endif
 }
 #endif // WITH_PROFILING
 
@@ -904,7 +1206,15 @@ int esp_pm_impl_get_cpu_freq(pm_mode_t mode)
     int freq_mhz;
     if (mode >= PM_MODE_LIGHT_SLEEP && mode < PM_MODE_COUNT) {
         portENTER_CRITICAL(&s_switch_lock);
-        freq_mhz = s_cpu_freq_by_mode[mode].freq_mhz;
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+        /* Report the configured maximum, not the level currently chosen by the load policy */
+        if (mode == PM_MODE_CPU_MAX) {
+            freq_mhz = s_dfs_levels[0].freq_mhz;
+        } else
+#endif
+        {
+            freq_mhz = s_cpu_freq_by_mode[mode].freq_mhz;
+        }
         portEXIT_CRITICAL(&s_switch_lock);
     } else {
         abort();
@@ -947,12 +1257,12 @@ void esp_pm_impl_init(void)
     esp_pm_trace_init();
 #endif
 
-    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "rtos0",
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, PM_RTOS_LOCK_FREQ_FLOOR, "rtos0",
             &s_rtos_lock_handle[0]));
     ESP_ERROR_CHECK(esp_pm_lock_acquire(s_rtos_lock_handle[0]));
 
 #if CONFIG_FREERTOS_NUMBER_OF_CORES == 2
-    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "rtos1",
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, PM_RTOS_LOCK_FREQ_FLOOR, "rtos1",
             &s_rtos_lock_handle[1]));
     ESP_ERROR_CHECK(esp_pm_lock_acquire(s_rtos_lock_handle[1]));
 #endif // CONFIG_FREERTOS_NUMBER_OF_CORES == 2
@@ -967,6 +1277,12 @@ void esp_pm_impl_init(void)
     for (size_t i = 0; i < PM_MODE_COUNT; ++i) {
         s_cpu_freq_by_mode[i] = default_config;
     }
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+    s_dfs_levels[0] = default_config;
+#endif
+#ifdef WITH_PROFILING
+    s_cur_freq_mhz = default_config.freq_mhz;
+#endif
 
 #ifdef CONFIG_PM_DFS_INIT_AUTO
     int xtal_freq_mhz = esp_clk_xtal_freq() / MHZ;
@@ -992,6 +1308,9 @@ void esp_pm_impl_idle_hook(void)
     && !periph_should_skip_light_sleep()
 #endif
     ) {
+#ifdef CONFIG_PM_DFS_LOAD_POLICY
+        dfs_enter_idle(core_id, esp_timer_get_time());
+#endif
         esp_pm_lock_release(s_rtos_lock_handle[core_id]);
         s_core_idle[core_id] = true;
     }
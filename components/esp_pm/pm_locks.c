@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2016-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2016-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -24,6 +24,9 @@ typedef struct esp_pm_lock {
     SLIST_ENTRY(esp_pm_lock) next;  /*!< linked list pointer */
     size_t count;                   /*!< lock count */
     portMUX_TYPE spinlock;          /*!< spinlock used when operating on 'count' */
+#if CONFIG_PM_DFS_LOAD_POLICY
+    int freq_level;                 /*!< CPU frequency level resolved from 'arg' when the lock was taken */
+#endif
 #ifdef WITH_PROFILING
     pm_time_t last_taken;           /*!< time what the lock was taken (valid if count > 0) */
     pm_time_t time_held;            /*!< total time the lock was taken.
@@ -108,6 +111,11 @@ esp_err_t IRAM_ATTR esp_pm_lock_acquire(esp_pm_lock_handle_t handle)
         pm_time_t now = 0;
 #ifdef WITH_PROFILING
         now = pm_get_time();
+#endif
+#if CONFIG_PM_DFS_LOAD_POLICY
+        if (handle->type == ESP_PM_CPU_FREQ_MAX) {
+            handle->freq_level = esp_pm_impl_lock_freq_floor(handle->arg);
+        }
 #endif
         esp_pm_impl_switch_mode(handle->mode, MODE_LOCK, now);
 #ifdef WITH_PROFILING
@@ -141,6 +149,11 @@ esp_err_t IRAM_ATTR esp_pm_lock_release(esp_pm_lock_handle_t handle)
         handle->time_held += now - handle->last_taken;
 #endif
         esp_pm_impl_switch_mode(handle->mode, MODE_UNLOCK, now);
+#if CONFIG_PM_DFS_LOAD_POLICY
+        if (handle->type == ESP_PM_CPU_FREQ_MAX) {
+            esp_pm_impl_unlock_freq_floor(handle->freq_level);
+        }
+#endif
     }
 out:
     portEXIT_CRITICAL_SAFE(&handle->spinlock);
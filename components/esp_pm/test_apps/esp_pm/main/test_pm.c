@@ -85,6 +85,53 @@ TEST_CASE("Can switch frequency using esp_pm_configure", "[pm]")
     switch_freq(orig_freq_mhz);
 }
 
+#if CONFIG_PM_DFS_LOAD_POLICY
+TEST_CASE("Load policy scales CPU frequency by the CPU load", "[pm]")
+{
+    int orig_freq_mhz = esp_clk_cpu_freq() / MHZ;
+    int max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = max_freq_mhz,
+        .min_freq_mhz = esp_clk_xtal_freq() / MHZ,
+    };
+    TEST_ESP_OK(esp_pm_configure(&pm_config));
+
+    // the lock only keeps the CPU_MAX mode, the frequency is left to the load policy
+    esp_pm_lock_handle_t any_freq_lock;
+    TEST_ESP_OK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 1, "any_freq", &any_freq_lock));
+    TEST_ESP_OK(esp_pm_lock_acquire(any_freq_lock));
+
+    // low load, the frequency is lowered
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_PM_DFS_LOAD_POLICY_WINDOW_MS * 20));
+    int low_load_freq_mhz = esp_clk_cpu_freq() / MHZ;
+    printf("Frequency at low load is %d MHz\n", low_load_freq_mhz);
+    TEST_ASSERT_LESS_THAN(max_freq_mhz, low_load_freq_mhz);
+
+    // saturated load, the frequency is raised back to the maximum
+    int64_t start = esp_timer_get_time();
+    while (esp_timer_get_time() - start < CONFIG_PM_DFS_LOAD_POLICY_WINDOW_MS * 5 * 1000) {
+        esp_rom_delay_us(100);
+    }
+    TEST_ASSERT_EQUAL(max_freq_mhz, esp_clk_cpu_freq() / MHZ);
+
+    // a lock without frequency floor requires the maximum frequency whatever the load
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_PM_DFS_LOAD_POLICY_WINDOW_MS * 20));
+    esp_pm_lock_handle_t max_freq_lock;
+    TEST_ESP_OK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "max_freq", &max_freq_lock));
+    TEST_ESP_OK(esp_pm_lock_acquire(max_freq_lock));
+    TEST_ASSERT_EQUAL(max_freq_mhz, esp_clk_cpu_freq() / MHZ);
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_PM_DFS_LOAD_POLICY_WINDOW_MS * 20));
+    TEST_ASSERT_EQUAL(max_freq_mhz, esp_clk_cpu_freq() / MHZ);
+    esp_pm_dump_locks(stdout);
+
+    TEST_ESP_OK(esp_pm_lock_release(max_freq_lock));
+    TEST_ESP_OK(esp_pm_lock_delete(max_freq_lock));
+    TEST_ESP_OK(esp_pm_lock_release(any_freq_lock));
+    TEST_ESP_OK(esp_pm_lock_delete(any_freq_lock));
+    switch_freq(orig_freq_mhz);
+}
+#endif // CONFIG_PM_DFS_LOAD_POLICY
+
 #if CONFIG_FREERTOS_USE_TICKLESS_IDLE
 
 static void light_sleep_enable(void)
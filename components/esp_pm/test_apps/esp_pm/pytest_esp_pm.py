@@ -12,6 +12,7 @@ from pytest_embedded import Dut
     'slp_iram_opt',
     'limits',
     'options',
+    'dfs_load_policy',
 ], indirect=True)
 def test_esp_pm(dut: Dut) -> None:
     dut.run_all_single_board_cases()
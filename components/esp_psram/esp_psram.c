@@ -17,6 +17,7 @@
 #include "esp_err.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_heap_caps_init.h"
 #include "hal/mmu_hal.h"
 #include "hal/mmu_ll.h"
@@ -51,6 +52,14 @@
 #define PSRAM_EARLY_LOGI   ESP_EARLY_LOGI
 #endif
 
+#if CONFIG_SPIRAM_MEMTEST_DEFERRED
+#define PSRAM_MEMTEST_BOOT_SIZE     (CONFIG_SPIRAM_MEMTEST_BOOT_SIZE * 1024)
+#define PSRAM_MEMTEST_STEP_SIZE     (CONFIG_SPIRAM_MEMTEST_DEFERRED_STEP_SIZE * 1024)
+// the background task sleeps for a tick after testing each chunk, to let the idle task run
+#define PSRAM_MEMTEST_CHUNK_SIZE    (64 * 1024)
+#define PSRAM_MEMTEST_TASK_STACK    2048
+#endif
+
 #if CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY
 extern uint8_t _ext_ram_bss_start;
 extern uint8_t _ext_ram_bss_end;
@@ -85,6 +94,9 @@ typedef struct {
      */
     psram_mem_t regions_to_heap[PSRAM_MEM_TYPE_NUM];     //memory regions that are available to be added to the heap allocator
     psram_mem_t mapped_regions[PSRAM_MEM_TYPE_NUM];      //mapped memory regions
+#if CONFIG_SPIRAM_MEMTEST_DEFERRED
+    intptr_t untested_vaddr_start;                       //start of the 8bit-aligned heap memory left to the background test, 0 if none
+#endif
 } psram_ctx_t;
 
 static psram_ctx_t s_psram_ctx;
@@ -367,11 +379,20 @@ esp_err_t esp_psram_init(void)
 esp_err_t esp_psram_extram_add_to_heap_allocator(void)
 {
     esp_err_t ret = ESP_FAIL;
+    intptr_t vaddr_end_8bit = s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_end;
+    size_t untested_size = 0;
+#if CONFIG_SPIRAM_MEMTEST_DEFERRED
+    if (s_psram_ctx.untested_vaddr_start) {
+        // the rest is added by the background memory test
+        untested_size = vaddr_end_8bit - s_psram_ctx.untested_vaddr_start;
+        vaddr_end_8bit = s_psram_ctx.untested_vaddr_start;
+    }
+#endif
 
     uint32_t byte_aligned_caps[] = {MALLOC_CAP_SPIRAM | MALLOC_CAP_DEFAULT, 0, MALLOC_CAP_8BIT | MALLOC_CAP_32BIT};
     ret = heap_caps_add_region_with_caps(byte_aligned_caps,
                                          s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_start,
-                                         s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_end);
+                                         vaddr_end_8bit);
     if (ret != ESP_OK) {
         return ret;
     }
@@ -388,7 +409,10 @@ esp_err_t esp_psram_extram_add_to_heap_allocator(void)
     }
 
     ESP_EARLY_LOGI(TAG, "Adding pool of %dK of PSRAM memory to heap allocator",
-                   (s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].size + s_psram_ctx.regions_to_heap[PSRAM_MEM_32BIT_ALIGNED].size) / 1024);
+                   (s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].size + s_psram_ctx.regions_to_heap[PSRAM_MEM_32BIT_ALIGNED].size - untested_size) / 1024);
+    if (untested_size) {
+        ESP_EARLY_LOGI(TAG, "%dK of PSRAM memory will be added once tested", untested_size / 1024);
+    }
 
     return ESP_OK;
 }
@@ -485,11 +509,8 @@ static bool s_test_psram(intptr_t v_start, size_t size, intptr_t reserved_start,
     if (errct) {
         ESP_EARLY_LOGE(TAG, "SPI SRAM memory test fail. %d/%d writes failed, first @ %X", errct, size / 32, initial_err + v_start);
         return false;
-    } else {
-        ESP_EARLY_LOGI(TAG, "SPI SRAM memory test OK");
-        return true;
     }
-
+    return true;
 }
 
 bool esp_psram_extram_test(void)
@@ -502,10 +523,29 @@ bool esp_psram_extram_test(void)
     intptr_t noinit_vstart = 0;
     intptr_t noinit_vend = 0;
 #endif
+#if CONFIG_SPIRAM_MEMTEST_DEFERRED
+    /* Test the reserved memory and the start of the heap memory now, leave the rest of the heap memory to the
+     * background task. The memory mapped after the heap memory, if any, is tested now as well.
+     */
+    const intptr_t mapped_start = s_psram_ctx.mapped_regions[PSRAM_MEM_8BIT_ALIGNED].vaddr_start;
+    const intptr_t mapped_end = s_psram_ctx.mapped_regions[PSRAM_MEM_8BIT_ALIGNED].vaddr_end;
+    const intptr_t heap_end = s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_end;
+    intptr_t boot_end = s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_start + PSRAM_MEMTEST_BOOT_SIZE;
+    s_psram_ctx.untested_vaddr_start = 0;
+    if (boot_end + PSRAM_MEMTEST_CHUNK_SIZE >= heap_end) {
+        boot_end = mapped_end;
+    }
+    test_success = s_test_psram(mapped_start, boot_end - mapped_start, noinit_vstart, noinit_vend);
+    if (test_success && boot_end < mapped_end) {
+        test_success = s_test_psram(heap_end, mapped_end - heap_end, 0, 0);
+        s_psram_ctx.untested_vaddr_start = boot_end;
+    }
+#else
     test_success = s_test_psram(s_psram_ctx.mapped_regions[PSRAM_MEM_8BIT_ALIGNED].vaddr_start,
                                 s_psram_ctx.mapped_regions[PSRAM_MEM_8BIT_ALIGNED].size,
                                 noinit_vstart,
                                 noinit_vend);
+#endif
     if (!test_success) {
         return false;
     }
@@ -520,9 +560,56 @@ bool esp_psram_extram_test(void)
         return false;
     }
 
+    ESP_EARLY_LOGI(TAG, "SPI SRAM memory test OK");
     return true;
 }
 
+#if CONFIG_SPIRAM_MEMTEST_DEFERRED
+static void s_psram_memtest_task(void *arg)
+{
+    uint32_t byte_aligned_caps[] = {MALLOC_CAP_SPIRAM | MALLOC_CAP_DEFAULT, 0, MALLOC_CAP_8BIT | MALLOC_CAP_32BIT};
+    const intptr_t heap_end = s_psram_ctx.regions_to_heap[PSRAM_MEM_8BIT_ALIGNED].vaddr_end;
+    intptr_t step_start = s_psram_ctx.untested_vaddr_start;
+
+    while (step_start < heap_end) {
+        intptr_t step_end = step_start + PSRAM_MEMTEST_STEP_SIZE;
+        // don't leave a remainder too small to be a heap region
+        if (step_end + PSRAM_MEMTEST_CHUNK_SIZE >= heap_end) {
+            step_end = heap_end;
+        }
+        for (intptr_t chunk = step_start; chunk < step_end; chunk += PSRAM_MEMTEST_CHUNK_SIZE) {
+            if (!s_test_psram(chunk, MIN(PSRAM_MEMTEST_CHUNK_SIZE, step_end - chunk), 0, 0)) {
+                ESP_LOGE(TAG, "External RAM failed memory test, %dK of PSRAM memory won't be used", (heap_end - step_start) / 1024);
+                vTaskDelete(NULL);
+            }
+            vTaskDelay(1);
+        }
+        esp_err_t ret = heap_caps_add_region_with_caps(byte_aligned_caps, step_start, step_end);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Tested PSRAM memory could not be added to heap: %s", esp_err_to_name(ret));
+            break;
+        }
+        ESP_LOGD(TAG, "Added %dK of tested PSRAM memory to heap allocator", (step_end - step_start) / 1024);
+        step_start = step_end;
+    }
+    if (step_start >= heap_end) {
+        ESP_LOGI(TAG, "SPI SRAM background memory test OK");
+    }
+    s_psram_ctx.untested_vaddr_start = 0;
+    vTaskDelete(NULL);
+}
+
+ESP_SYSTEM_INIT_FN(start_psram_memtest_task, SECONDARY, BIT(0), 241)
+{
+    if (s_psram_ctx.untested_vaddr_start == 0) {
+        return ESP_OK;
+    }
+    BaseType_t ret = xTaskCreatePinnedToCore(s_psram_memtest_task, "psram_memtest", PSRAM_MEMTEST_TASK_STACK, NULL,
+                                             tskIDLE_PRIORITY + 1, NULL, tskNO_AFFINITY);
+    return ret == pdPASS ? ESP_OK : ESP_ERR_NO_MEM;
+}
+#endif  // CONFIG_SPIRAM_MEMTEST_DEFERRED
+
 void esp_psram_bss_init(void)
 {
 #if CONFIG_SPIRAM_ALLOW_BSS_SEG_EXTERNAL_MEMORY
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -55,7 +55,7 @@ typedef enum {
  */
 typedef struct xSTATIC_RINGBUFFER {
     /** @cond */    //Doxygen command to hide this structure from API Reference
-    size_t xDummy1[2];
+    size_t xDummy1[3];
     UBaseType_t uxDummy2;
     void *pvDummy3[11];
     BaseType_t xDummy4;
@@ -91,6 +91,27 @@ RingbufHandle_t xRingbufferCreate(size_t xBufferSize, RingbufferType_t xBufferTy
  */
 RingbufHandle_t xRingbufferCreateNoSplit(size_t xItemSize, size_t xItemNum);
 
+/**
+ * @brief Create a byte buffer which returns data wrapping around the end of the buffer in one piece
+ *
+ * This API is similar to xRingbufferCreate() with RINGBUF_TYPE_BYTEBUF, but it
+ * additionally allocates a mirror of the first xMirrorSize bytes of the storage
+ * area right after its end. Any data written to the start of the storage area is
+ * also written to the mirror, so retrieving data which wraps around the end of the
+ * buffer returns a single contiguous piece of up to xMirrorSize bytes past the
+ * end, instead of two separate pieces.
+ *
+ * @param[in]   xBufferSize Size of the buffer in bytes
+ * @param[in]   xMirrorSize Size of the mirror in bytes, at most xBufferSize. Data is
+ *                          always retrieved in one piece if it is no larger than this.
+ *
+ * @note    Every send which writes to the start of the storage area copies the
+ *          written data a second time, up to xMirrorSize bytes.
+ *
+ * @return  A handle to the created ring buffer, or NULL in case of error.
+ */
+RingbufHandle_t xRingbufferCreateMirrored(size_t xBufferSize, size_t xMirrorSize);
+
 /**
  * @brief       Create a ring buffer but manually provide the required memory
  *
@@ -245,7 +266,8 @@ void *xRingbufferReceive(RingbufHandle_t xRingbuffer, size_t *pxItemSize, TickTy
  *
  * @note    A call to vRingbufferReturnItemFromISR() is required after this to free the item retrieved.
  * @note    Byte buffers do not allow multiple retrievals before returning an item
- * @note    Two calls to RingbufferReceiveFromISR() are required if the bytes wrap around the end of the ring buffer.
+ * @note    Two calls to RingbufferReceiveFromISR() are required if the bytes wrap around the end of the ring buffer,
+ *          unless the ring buffer was created with xRingbufferCreateMirrored().
  * @note    It is possible to receive items with a pxItemSize of 0 on no-split/allow split buffers.
  *
  * @return
@@ -327,7 +349,8 @@ BaseType_t xRingbufferReceiveSplitFromISR(RingbufHandle_t xRingbuffer,
  * @note    A call to vRingbufferReturnItem() is required after this to free up the data retrieved.
  * @note    This function should only be called on byte buffers
  * @note    Byte buffers do not allow multiple retrievals before returning an item
- * @note    Two calls to RingbufferReceiveUpTo() are required if the bytes wrap around the end of the ring buffer.
+ * @note    Two calls to RingbufferReceiveUpTo() are required if the bytes wrap around the end of the ring buffer,
+ *          unless the ring buffer was created with xRingbufferCreateMirrored().
  *
  * @return
  *      - Pointer to the retrieved item on success; *pxItemSize filled with
@@ -545,6 +568,112 @@ RingbufHandle_t xRingbufferCreateWithCaps(size_t xBufferSize, RingbufferType_t x
  */
 void vRingbufferDeleteWithCaps(RingbufHandle_t xRingbuffer);
 
+/* ------------------------------------ Single-Producer/Single-Consumer Byte Buffers ------------------------------------ */
+
+/**
+ * Type by which single-producer/single-consumer byte buffers are referenced.
+ *
+ * These buffers are a lightweight alternative to RINGBUF_TYPE_BYTEBUF ring buffers for the case where exactly one
+ * producer (a task or an ISR) and exactly one consumer (a task or an ISR) access the buffer. Sending and receiving
+ * don't enter a critical section, the read and write positions are only ever modified by one side each. The
+ * consumer task is only notified when it is blocked waiting for data.
+ */
+typedef struct RingbufSpsc *RingbufSpscHandle_t;
+
+/**
+ * @brief       Create a single-producer/single-consumer byte buffer
+ *
+ * @param[in]   xBufferSize Size of the buffer in bytes, must be a power of two. All of it can be used for data.
+ *
+ * @return  A handle to the created buffer, or NULL if xBufferSize is not a power of two or memory could not be allocated.
+ */
+RingbufSpscHandle_t xRingbufferSpscCreate(size_t xBufferSize);
+
+/**
+ * @brief       Delete a single-producer/single-consumer byte buffer
+ *
+ * @param[in]   xRingbuffer Buffer to delete
+ *
+ * @note    Neither the producer nor the consumer may access the buffer anymore when it is deleted.
+ */
+void vRingbufferSpscDelete(RingbufSpscHandle_t xRingbuffer);
+
+/**
+ * @brief       Copy data into a single-producer/single-consumer byte buffer
+ *
+ * Copies as many bytes as currently fit and wakes the consumer task if it is blocked in xRingbufferSpscReceive().
+ * This function never blocks. It must only be called by the producer, from task context.
+ *
+ * @param[in]   xRingbuffer Buffer to send to
+ * @param[in]   pvData      Data to send
+ * @param[in]   xDataSize   Number of bytes to send
+ *
+ * @return  Number of bytes copied into the buffer
+ */
+size_t xRingbufferSpscSend(RingbufSpscHandle_t xRingbuffer, const void *pvData, size_t xDataSize);
+
+/**
+ * @brief       Copy data into a single-producer/single-consumer byte buffer from an ISR
+ *
+ * Same as xRingbufferSpscSend() but for a producer running in an ISR.
+ *
+ * @param[in]   xRingbuffer Buffer to send to
+ * @param[in]   pvData      Data to send
+ * @param[in]   xDataSize   Number of bytes to send
+ * @param[out]  pxHigherPriorityTaskWoken Value pointed to will be set to pdTRUE if the function woke up a higher
+ *              priority task.
+ *
+ * @return  Number of bytes copied into the buffer
+ */
+size_t xRingbufferSpscSendFromISR(RingbufSpscHandle_t xRingbuffer, const void *pvData, size_t xDataSize, BaseType_t *pxHigherPriorityTaskWoken);
+
+/**
+ * @brief       Copy data out of a single-producer/single-consumer byte buffer
+ *
+ * Waits until at least one byte is available or the timeout expires, then copies up to xMaxSize bytes.
+ * This function must only be called by the consumer, from task context. While waiting, the function uses the
+ * default notification of the calling task, which must not be used for other purposes at the same time.
+ *
+ * @param[in]   xRingbuffer     Buffer to receive from
+ * @param[out]  pvBuffer        Buffer to copy the data to
+ * @param[in]   xMaxSize        Maximum number of bytes to receive
+ * @param[in]   xTicksToWait    Ticks to wait for data
+ *
+ * @return  Number of bytes received, 0 on timeout
+ */
+size_t xRingbufferSpscReceive(RingbufSpscHandle_t xRingbuffer, void *pvBuffer, size_t xMaxSize, TickType_t xTicksToWait);
+
+/**
+ * @brief       Copy data out of a single-producer/single-consumer byte buffer from an ISR
+ *
+ * Same as xRingbufferSpscReceive() but for a consumer running in an ISR, never blocks.
+ *
+ * @param[in]   xRingbuffer     Buffer to receive from
+ * @param[out]  pvBuffer        Buffer to copy the data to
+ * @param[in]   xMaxSize        Maximum number of bytes to receive
+ *
+ * @return  Number of bytes received
+ */
+size_t xRingbufferSpscReceiveFromISR(RingbufSpscHandle_t xRingbuffer, void *pvBuffer, size_t xMaxSize);
+
+/**
+ * @brief       Get the number of bytes which can currently be received
+ *
+ * @param[in]   xRingbuffer Buffer
+ *
+ * @return  Number of bytes stored in the buffer
+ */
+size_t xRingbufferSpscGetDataSize(RingbufSpscHandle_t xRingbuffer);
+
+/**
+ * @brief       Get the number of bytes which can currently be sent
+ *
+ * @param[in]   xRingbuffer Buffer
+ *
+ * @return  Number of free bytes in the buffer
+ */
+size_t xRingbufferSpscGetFreeSize(RingbufSpscHandle_t xRingbuffer);
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,6 +52,7 @@ typedef size_t (*GetCurMaxSizeFunction_t)(Ringbuffer_t *pxRingbuffer);
 typedef struct RingbufferDefinition {
     size_t xSize;                               //Size of the data storage
     size_t xMaxItemSize;                        //Maximum item size
+    size_t xMirrorSize;                         //Size of the mirror of the start of the storage area placed after pucTail (byte buffers only)
     UBaseType_t uxRingbufferFlags;              //Flags to indicate the type and status of ring buffer
 
     CheckItemFitsFunction_t xCheckItemFits;     //Function to check if item can currently fit in ring buffer
@@ -128,6 +129,9 @@ static void prvCopyItemAllowSplit(Ringbuffer_t *pxRingbuffer, const uint8_t *puc
 //Copies an item to a byte buffer. Only call this function  after calling prvCheckItemFitsByteBuffer()
 static void prvCopyItemByteBuf(Ringbuffer_t *pxRingbuffer, const uint8_t *pucItem, size_t xItemSize);
 
+//Copies data written to the start of a mirrored byte buffer's storage area to the mirror after pucTail
+static void prvCopyToMirrorByteBuf(Ringbuffer_t *pxRingbuffer, const uint8_t *pucDest, const uint8_t *pucData, size_t xDataSize);
+
 //Retrieve item from no-split/allow-split ring buffer. *pxIsSplit is set to pdTRUE if the retrieved item is split
 /*
 Entry:
@@ -219,6 +223,7 @@ static void prvInitializeNewRingbuffer(size_t xBufferSize,
     pxNewRingbuffer->pucAcquire = pucRingbufferStorage;
     pxNewRingbuffer->xItemsWaiting = 0;
     pxNewRingbuffer->uxRingbufferFlags = 0;
+    pxNewRingbuffer->xMirrorSize = 0;
 
     //Initialize type dependent values and function pointers
     if (xBufferType == RINGBUF_TYPE_NOSPLIT) {
@@ -476,6 +481,7 @@ static void prvCopyItemByteBuf(Ringbuffer_t *pxRingbuffer, const uint8_t *pucIte
     if (xRemLen < xItemSize) {
         //Copy as much as possible into remaining length
         memcpy(pxRingbuffer->pucAcquire, pucItem, xRemLen);
+        prvCopyToMirrorByteBuf(pxRingbuffer, pxRingbuffer->pucAcquire, pucItem, xRemLen);
         pxRingbuffer->xItemsWaiting += xRemLen;
         //Update item arguments to account for data already written
         pucItem += xRemLen;
@@ -484,6 +490,7 @@ static void prvCopyItemByteBuf(Ringbuffer_t *pxRingbuffer, const uint8_t *pucIte
     }
     //Copy all or remaining portion of the item
     memcpy(pxRingbuffer->pucAcquire, pucItem, xItemSize);
+    prvCopyToMirrorByteBuf(pxRingbuffer, pxRingbuffer->pucAcquire, pucItem, xItemSize);
     pxRingbuffer->xItemsWaiting += xItemSize;
     pxRingbuffer->pucAcquire += xItemSize;
 
@@ -500,6 +507,18 @@ static void prvCopyItemByteBuf(Ringbuffer_t *pxRingbuffer, const uint8_t *pucIte
     pxRingbuffer->pucWrite = pxRingbuffer->pucAcquire;
 }
 
+static void prvCopyToMirrorByteBuf(Ringbuffer_t *pxRingbuffer, const uint8_t *pucDest, const uint8_t *pucData, size_t xDataSize)
+{
+    size_t xOffset = pucDest - pxRingbuffer->pucHead;
+    if (xOffset >= pxRingbuffer->xMirrorSize) {
+        return;     //Data is not written to the mirrored part of the storage area (or the buffer is not mirrored)
+    }
+    if (xDataSize > pxRingbuffer->xMirrorSize - xOffset) {
+        xDataSize = pxRingbuffer->xMirrorSize - xOffset;
+    }
+    memcpy(pxRingbuffer->pucTail + xOffset, pucData, xDataSize);
+}
+
 static BaseType_t prvCheckItemAvail(Ringbuffer_t *pxRingbuffer)
 {
     if ((pxRingbuffer->uxRingbufferFlags & rbBYTE_BUFFER_FLAG) && pxRingbuffer->pucRead != pxRingbuffer->pucFree) {
@@ -571,7 +590,24 @@ static void *prvGetItemByteBuf(Ringbuffer_t *pxRingbuffer,
     configASSERT(pxRingbuffer->pucRead == pxRingbuffer->pucFree);
 
     uint8_t *ret = pxRingbuffer->pucRead;
-    if ((pxRingbuffer->pucRead > pxRingbuffer->pucWrite) || (pxRingbuffer->uxRingbufferFlags & rbBUFFER_FULL_FLAG)) {     //Available data wraps around
+    if (((pxRingbuffer->pucRead > pxRingbuffer->pucWrite) || (pxRingbuffer->uxRingbufferFlags & rbBUFFER_FULL_FLAG)) && pxRingbuffer->xMirrorSize > 0) {
+        //Available data wraps around, but the mirror after the tail holds a copy of the data at the head.
+        //Return contiguous piece from read pointer up to the end of the mirror, or xMaxSize
+        size_t xWrappedSize = pxRingbuffer->pucWrite - pxRingbuffer->pucHead;
+        if (xWrappedSize > pxRingbuffer->xMirrorSize) {
+            xWrappedSize = pxRingbuffer->xMirrorSize;
+        }
+        size_t xSize = (pxRingbuffer->pucTail - pxRingbuffer->pucRead) + xWrappedSize;
+        if (xMaxSize != 0 && xSize > xMaxSize) {
+            xSize = xMaxSize;
+        }
+        *pxItemSize = xSize;
+        pxRingbuffer->xItemsWaiting -= xSize;
+        pxRingbuffer->pucRead += xSize;
+        if (pxRingbuffer->pucRead >= pxRingbuffer->pucTail) {
+            pxRingbuffer->pucRead -= pxRingbuffer->xSize;   //Wrap around read pointer
+        }
+    } else if ((pxRingbuffer->pucRead > pxRingbuffer->pucWrite) || (pxRingbuffer->uxRingbufferFlags & rbBUFFER_FULL_FLAG)) {     //Available data wraps around
         //Return contiguous piece from read pointer until buffer tail, or xMaxSize
         if (xMaxSize == 0 || pxRingbuffer->pucTail - pxRingbuffer->pucRead <= xMaxSize) {
             //All contiguous data from read pointer to tail
@@ -953,6 +989,25 @@ RingbufHandle_t xRingbufferCreateNoSplit(size_t xItemSize, size_t xItemNum)
     return xRingbufferCreate((rbALIGN_SIZE(xItemSize) + rbHEADER_SIZE) * xItemNum, RINGBUF_TYPE_NOSPLIT);
 }
 
+RingbufHandle_t xRingbufferCreateMirrored(size_t xBufferSize, size_t xMirrorSize)
+{
+    configASSERT(xBufferSize > 0);
+    configASSERT(xMirrorSize <= xBufferSize);
+
+    //Allocate memory, the mirror is placed right after the storage area
+    Ringbuffer_t *pxNewRingbuffer = calloc(1, sizeof(Ringbuffer_t));
+    uint8_t *pucRingbufferStorage = malloc(xBufferSize + xMirrorSize);
+    if (pxNewRingbuffer == NULL || pucRingbufferStorage == NULL) {
+        free(pxNewRingbuffer);
+        free(pucRingbufferStorage);
+        return NULL;
+    }
+
+    prvInitializeNewRingbuffer(xBufferSize, RINGBUF_TYPE_BYTEBUF, pxNewRingbuffer, pucRingbufferStorage);
+    pxNewRingbuffer->xMirrorSize = xMirrorSize;
+    return (RingbufHandle_t)pxNewRingbuffer;
+}
+
 RingbufHandle_t xRingbufferCreateStatic(size_t xBufferSize,
                                         RingbufferType_t xBufferType,
                                         uint8_t *pucRingbufferStorage,
@@ -0,0 +1,221 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/ringbuf.h"
+
+/*
+A single-producer/single-consumer byte buffer only uses two free running indices: uxHead is only ever written by the
+producer and uxTail is only ever written by the consumer. Each side reads the index of the other side with acquire
+semantics and publishes its own index with release semantics, so the data copied before publishing an index is
+visible to the other side once it sees the new index. As the buffer size is a power of two, the indices can wrap
+around at 2^32 and the number of stored bytes is always (uxHead - uxTail).
+
+A consumer task which finds the buffer empty stores its handle in xWaitingTask before blocking on its task
+notification. The producer only notifies the consumer when it finds a handle there after publishing new data, i.e.
+when the buffer went from empty to non-empty while the consumer was waiting. Both sides issue a full barrier
+between publishing their part (the handle or the new head) and checking the other part, so at least one of them
+sees the other's update and a wake-up can't be lost.
+*/
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+typedef struct RingbufSpsc {
+    uint32_t uxHead;                    //Write index, only modified by the producer
+    uint32_t uxTail;                    //Read index, only modified by the consumer
+    uint32_t uxMask;                    //Buffer size - 1
+    TaskHandle_t xWaitingTask;          //Consumer task blocked waiting for data, if any
+    uint8_t *pucStorage;
+} RingbufSpsc_t;
+
+// ------------------------------------------------ Static Declarations ------------------------------------------------
+
+/*
+ * Copy data into the buffer and publish it. Returns the number of bytes copied, and the consumer task which needs to
+ * be notified (if any) in pxTaskToNotify.
+ */
+static size_t prvSpscSendGeneric(RingbufSpsc_t *pxRingbuffer, const void *pvData, size_t xDataSize, TaskHandle_t *pxTaskToNotify);
+
+/*
+ * Copy data out of the buffer and release the space. Returns the number of bytes copied.
+ */
+static size_t prvSpscReceiveGeneric(RingbufSpsc_t *pxRingbuffer, void *pvBuffer, size_t xMaxSize);
+
+// ------------------------------------------------ Static Definitions -------------------------------------------------
+
+static size_t prvSpscSendGeneric(RingbufSpsc_t *pxRingbuffer, const void *pvData, size_t xDataSize, TaskHandle_t *pxTaskToNotify)
+{
+    *pxTaskToNotify = NULL;
+
+    uint32_t uxHead = pxRingbuffer->uxHead;
+    uint32_t uxTail = __atomic_load_n(&pxRingbuffer->uxTail, __ATOMIC_ACQUIRE);
+    size_t xFree = (pxRingbuffer->uxMask + 1) - (uxHead - uxTail);
+    if (xDataSize > xFree) {
+        xDataSize = xFree;
+    }
+    if (xDataSize == 0) {
+        return 0;
+    }
+
+    //Copy in up to two parts if the data wraps around the end of the storage
+    uint32_t uxOffset = uxHead & pxRingbuffer->uxMask;
+    size_t xFirst = (pxRingbuffer->uxMask + 1) - uxOffset;
+    if (xFirst > xDataSize) {
+        xFirst = xDataSize;
+    }
+    memcpy(pxRingbuffer->pucStorage + uxOffset, pvData, xFirst);
+    memcpy(pxRingbuffer->pucStorage, (const uint8_t *)pvData + xFirst, xDataSize - xFirst);
+
+    __atomic_store_n(&pxRingbuffer->uxHead, uxHead + xDataSize, __ATOMIC_RELEASE);
+
+    //Pairs with the barrier in xRingbufferSpscReceive() between registering the consumer and checking uxHead
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pxRingbuffer->xWaitingTask, __ATOMIC_RELAXED) != NULL) {
+        *pxTaskToNotify = __atomic_exchange_n(&pxRingbuffer->xWaitingTask, NULL, __ATOMIC_ACQ_REL);
+    }
+    return xDataSize;
+}
+
+static size_t prvSpscReceiveGeneric(RingbufSpsc_t *pxRingbuffer, void *pvBuffer, size_t xMaxSize)
+{
+    uint32_t uxTail = pxRingbuffer->uxTail;
+    uint32_t uxHead = __atomic_load_n(&pxRingbuffer->uxHead, __ATOMIC_ACQUIRE);
+    size_t xAvailable = uxHead - uxTail;
+    if (xMaxSize > xAvailable) {
+        xMaxSize = xAvailable;
+    }
+    if (xMaxSize == 0) {
+        return 0;
+    }
+
+    //Copy out in up to two parts if the data wraps around the end of the storage
+    uint32_t uxOffset = uxTail & pxRingbuffer->uxMask;
+    size_t xFirst = (pxRingbuffer->uxMask + 1) - uxOffset;
+    if (xFirst > xMaxSize) {
+        xFirst = xMaxSize;
+    }
+    memcpy(pvBuffer, pxRingbuffer->pucStorage + uxOffset, xFirst);
+    memcpy((uint8_t *)pvBuffer + xFirst, pxRingbuffer->pucStorage, xMaxSize - xFirst);
+
+    __atomic_store_n(&pxRingbuffer->uxTail, uxTail + xMaxSize, __ATOMIC_RELEASE);
+    return xMaxSize;
+}
+
+// ------------------------------------------------ Public Definitions -------------------------------------------------
+
+RingbufSpscHandle_t xRingbufferSpscCreate(size_t xBufferSize)
+{
+    //The buffer size must be a power of two which the free running 32-bit indices can represent
+    if (xBufferSize == 0 || (xBufferSize & (xBufferSize - 1)) != 0 || xBufferSize > (UINT32_MAX / 2 + 1)) {
+        return NULL;
+    }
+
+    RingbufSpsc_t *pxRingbuffer = calloc(1, sizeof(RingbufSpsc_t));
+    uint8_t *pucStorage = malloc(xBufferSize);
+    if (pxRingbuffer == NULL || pucStorage == NULL) {
+        free(pxRingbuffer);
+        free(pucStorage);
+        return NULL;
+    }
+
+    pxRingbuffer->uxMask = xBufferSize - 1;
+    pxRingbuffer->pucStorage = pucStorage;
+    return pxRingbuffer;
+}
+
+void vRingbufferSpscDelete(RingbufSpscHandle_t xRingbuffer)
+{
+    configASSERT(xRingbuffer);
+    configASSERT(xRingbuffer->xWaitingTask == NULL);
+
+    free(xRingbuffer->pucStorage);
+    free(xRingbuffer);
+}
+
+size_t xRingbufferSpscSend(RingbufSpscHandle_t xRingbuffer, const void *pvData, size_t xDataSize)
+{
+    configASSERT(xRingbuffer);
+    configASSERT(pvData != NULL || xDataSize == 0);
+
+    TaskHandle_t xTaskToNotify;
+    size_t xSent = prvSpscSendGeneric(xRingbuffer, pvData, xDataSize, &xTaskToNotify);
+    if (xTaskToNotify != NULL) {
+        xTaskNotifyGive(xTaskToNotify);
+    }
+    return xSent;
+}
+
+size_t xRingbufferSpscSendFromISR(RingbufSpscHandle_t xRingbuffer, const void *pvData, size_t xDataSize, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    configASSERT(xRingbuffer);
+    configASSERT(pvData != NULL || xDataSize == 0);
+
+    TaskHandle_t xTaskToNotify;
+    size_t xSent = prvSpscSendGeneric(xRingbuffer, pvData, xDataSize, &xTaskToNotify);
+    if (xTaskToNotify != NULL) {
+        vTaskNotifyGiveFromISR(xTaskToNotify, pxHigherPriorityTaskWoken);
+    }
+    return xSent;
+}
+
+size_t xRingbufferSpscReceive(RingbufSpscHandle_t xRingbuffer, void *pvBuffer, size_t xMaxSize, TickType_t xTicksToWait)
+{
+    configASSERT(xRingbuffer);
+    configASSERT(pvBuffer != NULL || xMaxSize == 0);
+
+    size_t xReceived = prvSpscReceiveGeneric(xRingbuffer, pvBuffer, xMaxSize);
+    if (xReceived != 0 || xMaxSize == 0 || xTicksToWait == 0) {
+        return xReceived;
+    }
+
+    TimeOut_t xTimeOut;
+    vTaskSetTimeOutState(&xTimeOut);
+    //Drop a notification left over from a previous wait which timed out just as data arrived
+    (void) ulTaskNotifyTake(pdTRUE, 0);
+    while (1) {
+        __atomic_store_n(&xRingbuffer->xWaitingTask, xTaskGetCurrentTaskHandle(), __ATOMIC_RELAXED);
+        //Pairs with the barrier in prvSpscSendGeneric() between publishing uxHead and checking xWaitingTask
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&xRingbuffer->uxHead, __ATOMIC_RELAXED) == xRingbuffer->uxTail) {
+            (void) ulTaskNotifyTake(pdTRUE, xTicksToWait);
+        }
+        __atomic_store_n(&xRingbuffer->xWaitingTask, NULL, __ATOMIC_RELAXED);
+
+        xReceived = prvSpscReceiveGeneric(xRingbuffer, pvBuffer, xMaxSize);
+        if (xReceived != 0 || xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) != pdFALSE) {
+            break;
+        }
+    }
+    return xReceived;
+}
+
+size_t xRingbufferSpscReceiveFromISR(RingbufSpscHandle_t xRingbuffer, void *pvBuffer, size_t xMaxSize)
+{
+    configASSERT(xRingbuffer);
+    configASSERT(pvBuffer != NULL || xMaxSize == 0);
+
+    return prvSpscReceiveGeneric(xRingbuffer, pvBuffer, xMaxSize);
+}
+
+size_t xRingbufferSpscGetDataSize(RingbufSpscHandle_t xRingbuffer)
+{
+    configASSERT(xRingbuffer);
+
+    uint32_t uxTail = __atomic_load_n(&xRingbuffer->uxTail, __ATOMIC_ACQUIRE);
+    uint32_t uxHead = __atomic_load_n(&xRingbuffer->uxHead, __ATOMIC_ACQUIRE);
+    return uxHead - uxTail;
+}
+
+size_t xRingbufferSpscGetFreeSize(RingbufSpscHandle_t xRingbuffer)
+{
+    configASSERT(xRingbuffer);
+
+    return (xRingbuffer->uxMask + 1) - xRingbufferSpscGetDataSize(xRingbuffer);
+}
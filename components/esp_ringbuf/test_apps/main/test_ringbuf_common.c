@@ -1042,3 +1042,162 @@ TEST_CASE("Test no-split buffers always receive items in order", "[esp_ringbuf][
     // Cleanup
     vRingbufferDelete(buffer_handle);
 }
+
+/* ------------------------ Test single-producer/single-consumer byte buffers ------------------------
+ * The following test cases test the single-producer/single-consumer byte buffers. The first test case
+ * checks partial sends and receives as well as data which wraps around the end of the buffer.
+ * The second test case sends a continuous stream of data from a producer task to a consumer task,
+ * which blocks whenever the buffer is empty.
+ */
+
+#define SPSC_BUFFER_SIZE                64
+#define SPSC_STREAM_SIZE                4096
+
+TEST_CASE("Test SPSC byte buffer", "[esp_ringbuf][linux]")
+{
+    TEST_ASSERT_NULL(xRingbufferSpscCreate(0));
+    TEST_ASSERT_NULL(xRingbufferSpscCreate(SPSC_BUFFER_SIZE + 1));
+
+    RingbufSpscHandle_t handle = xRingbufferSpscCreate(SPSC_BUFFER_SIZE);
+    TEST_ASSERT_NOT_NULL(handle);
+    TEST_ASSERT_EQUAL(0, xRingbufferSpscGetDataSize(handle));
+    TEST_ASSERT_EQUAL(SPSC_BUFFER_SIZE, xRingbufferSpscGetFreeSize(handle));
+
+    uint8_t tx[SPSC_BUFFER_SIZE + 8];
+    uint8_t rx[SPSC_BUFFER_SIZE + 8];
+    for (int i = 0; i < sizeof(tx); i++) {
+        tx[i] = i;
+    }
+
+    //Nothing to receive, with and without timeout
+    TEST_ASSERT_EQUAL(0, xRingbufferSpscReceive(handle, rx, sizeof(rx), 0));
+    TEST_ASSERT_EQUAL(0, xRingbufferSpscReceive(handle, rx, sizeof(rx), 2));
+
+    //Only as much data as fits is sent
+    TEST_ASSERT_EQUAL(SPSC_BUFFER_SIZE, xRingbufferSpscSend(handle, tx, sizeof(tx)));
+    TEST_ASSERT_EQUAL(0, xRingbufferSpscGetFreeSize(handle));
+    TEST_ASSERT_EQUAL(0, xRingbufferSpscSend(handle, tx, 1));
+
+    //Partially drain the buffer, then send data which wraps around the end of the buffer
+    TEST_ASSERT_EQUAL(40, xRingbufferSpscReceive(handle, rx, 40, 0));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(tx, rx, 40);
+    TEST_ASSERT_EQUAL(40, xRingbufferSpscSend(handle, tx + 8, 40));
+    TEST_ASSERT_EQUAL(SPSC_BUFFER_SIZE, xRingbufferSpscGetDataSize(handle));
+
+    TEST_ASSERT_EQUAL(SPSC_BUFFER_SIZE - 40, xRingbufferSpscReceive(handle, rx, SPSC_BUFFER_SIZE - 40, 0));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(tx + 40, rx, SPSC_BUFFER_SIZE - 40);
+    TEST_ASSERT_EQUAL(40, xRingbufferSpscReceive(handle, rx, sizeof(rx), 0));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(tx + 8, rx, 40);
+    TEST_ASSERT_EQUAL(0, xRingbufferSpscGetDataSize(handle));
+
+    vRingbufferSpscDelete(handle);
+}
+
+static void spsc_producer_task(void *arg)
+{
+    RingbufSpscHandle_t handle = (RingbufSpscHandle_t)arg;
+    size_t sent = 0;
+    uint8_t chunk[13];
+    while (sent < SPSC_STREAM_SIZE) {
+        size_t len = rand() % sizeof(chunk) + 1;
+        if (len > SPSC_STREAM_SIZE - sent) {
+            len = SPSC_STREAM_SIZE - sent;
+        }
+        for (int i = 0; i < len; i++) {
+            chunk[i] = (uint8_t)((sent + i) * 7);
+        }
+        size_t done = xRingbufferSpscSend(handle, chunk, len);
+        sent += done;
+        if (done < len) {
+            //Buffer is full, give the consumer time to drain it. Partial data is sent again
+            vTaskDelay(1);
+        }
+    }
+    xSemaphoreGive(tx_done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("Test SPSC byte buffer with blocking consumer", "[esp_ringbuf][linux]")
+{
+    RingbufSpscHandle_t handle = xRingbufferSpscCreate(SPSC_BUFFER_SIZE);
+    TEST_ASSERT_NOT_NULL(handle);
+    tx_done = xSemaphoreCreateBinary();
+    srand(SRAND_SEED);
+
+    xTaskCreatePinnedToCore(spsc_producer_task, "spsc tx", 2048, handle, 10, NULL, 0);
+
+    size_t received = 0;
+    uint8_t rx[SPSC_BUFFER_SIZE];
+    while (received < SPSC_STREAM_SIZE) {
+        size_t len = xRingbufferSpscReceive(handle, rx, sizeof(rx), TIMEOUT_TICKS);
+        TEST_ASSERT_MESSAGE(len > 0, "Timed out waiting for data");
+        for (int i = 0; i < len; i++) {
+            TEST_ASSERT_EQUAL_HEX8((uint8_t)((received + i) * 7), rx[i]);
+        }
+        received += len;
+    }
+    TEST_ASSERT_EQUAL(SPSC_STREAM_SIZE, received);
+
+    TEST_ASSERT(xSemaphoreTake(tx_done, TIMEOUT_TICKS) == pdTRUE);
+    vSemaphoreDelete(tx_done);
+    vRingbufferSpscDelete(handle);
+    vTaskDelay(1);
+}
+
+/* ------------------------------ Test mirrored byte buffers ------------------------------
+ * The following test case checks that data wrapping around the end of a mirrored byte
+ * buffer is retrieved in one piece, up to the mirror size past the end of the buffer.
+ */
+
+#define MIRROR_BUFFER_SIZE              64
+#define MIRROR_SIZE                     16
+
+TEST_CASE("Test mirrored byte buffer", "[esp_ringbuf][linux]")
+{
+    RingbufHandle_t buffer_handle = xRingbufferCreateMirrored(MIRROR_BUFFER_SIZE, MIRROR_SIZE);
+    TEST_ASSERT_MESSAGE(buffer_handle != NULL, "Failed to create ring buffer");
+
+    uint8_t data[MIRROR_BUFFER_SIZE];
+    for (int i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+
+    //Move the read/write position away from the start of the buffer. The first item starts at the buffer's start.
+    size_t item_size;
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferSend(buffer_handle, data, 40, TIMEOUT_TICKS));
+    uint8_t *start = xRingbufferReceive(buffer_handle, &item_size, TIMEOUT_TICKS);
+    TEST_ASSERT_NOT_NULL(start);
+    TEST_ASSERT_EQUAL(40, item_size);
+    vRingbufferReturnItem(buffer_handle, start);
+
+    //Data wrapping around the end by less than the mirror size is received in one piece
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferSend(buffer_handle, data, 30, TIMEOUT_TICKS));
+    uint8_t *item = xRingbufferReceive(buffer_handle, &item_size, TIMEOUT_TICKS);
+    TEST_ASSERT_EQUAL_PTR(start + 40, item);
+    TEST_ASSERT_EQUAL(30, item_size);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, item, item_size);
+    vRingbufferReturnItem(buffer_handle, item);
+
+    //Move the read/write position back to offset 40
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferSend(buffer_handle, data, 34, TIMEOUT_TICKS));
+    item = xRingbufferReceive(buffer_handle, &item_size, TIMEOUT_TICKS);
+    TEST_ASSERT_EQUAL_PTR(start + 6, item);
+    TEST_ASSERT_EQUAL(34, item_size);
+    vRingbufferReturnItem(buffer_handle, item);
+
+    //Data wrapping around the end by more than the mirror size is received in two pieces, the first one
+    //extending MIRROR_SIZE bytes past the end of the buffer
+    TEST_ASSERT_EQUAL(pdTRUE, xRingbufferSend(buffer_handle, data, 60, TIMEOUT_TICKS));
+    item = xRingbufferReceive(buffer_handle, &item_size, TIMEOUT_TICKS);
+    TEST_ASSERT_EQUAL_PTR(start + 40, item);
+    TEST_ASSERT_EQUAL(MIRROR_BUFFER_SIZE - 40 + MIRROR_SIZE, item_size);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, item, item_size);
+    vRingbufferReturnItem(buffer_handle, item);
+    item = xRingbufferReceive(buffer_handle, &item_size, TIMEOUT_TICKS);
+    TEST_ASSERT_EQUAL_PTR(start + MIRROR_SIZE, item);
+    TEST_ASSERT_EQUAL(60 - (MIRROR_BUFFER_SIZE - 40 + MIRROR_SIZE), item_size);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data + 60 - item_size, item, item_size);
+    vRingbufferReturnItem(buffer_handle, item);
+
+    vRingbufferDelete(buffer_handle);
+}
@@ -49,6 +49,44 @@ static volatile esp_ipc_func_t s_no_block_func[portNUM_PROCESSORS] = { 0 };
 static volatile bool s_no_block_func_and_arg_are_ready[portNUM_PROCESSORS] = { 0 };
 static void * volatile s_no_block_func_arg[portNUM_PROCESSORS];
 
+typedef struct {
+    esp_ipc_func_t func;
+    void *arg;
+    esp_ipc_completion_t *completion;
+} ipc_queue_entry_t;
+
+// Calls queued by esp_ipc_call_async() and esp_ipc_call_batch(), executed in order by the IPC task
+typedef struct {
+    portMUX_TYPE lock;
+    uint32_t head;      // index of the next entry to execute
+    uint32_t count;     // number of queued entries
+    ipc_queue_entry_t entries[CONFIG_ESP_IPC_QUEUE_SIZE];
+} ipc_queue_t;
+
+static DRAM_ATTR ipc_queue_t s_ipc_queue[CONFIG_FREERTOS_NUMBER_OF_CORES];
+
+static void IRAM_ATTR ipc_queue_run(ipc_queue_t *queue)
+{
+    while (true) {
+        ipc_queue_entry_t entry;
+
+        portENTER_CRITICAL(&queue->lock);
+        if (queue->count == 0) {
+            portEXIT_CRITICAL(&queue->lock);
+            break;
+        }
+        entry = queue->entries[queue->head];
+        queue->head = (queue->head + 1) % CONFIG_ESP_IPC_QUEUE_SIZE;
+        queue->count--;
+        portEXIT_CRITICAL(&queue->lock);
+
+        (*entry.func)(entry.arg);
+        if (entry.completion) {
+            xSemaphoreGive(entry.completion->done);
+        }
+    }
+}
+
 static void IRAM_ATTR ipc_task(void* arg)
 {
     const int cpuid = (int) arg;
@@ -88,6 +126,8 @@ static void IRAM_ATTR ipc_task(void* arg)
             }
         }
 #endif // !CONFIG_FREERTOS_UNICORE
+
+        ipc_queue_run(&s_ipc_queue[cpuid]);
     }
     // TODO: currently this is unreachable code. Introduce esp_ipc_uninit
     // function which will signal to both tasks that they can shut down.
@@ -117,6 +157,7 @@ static void esp_ipc_init(void)
         task_name[3] = i + (char)'0';
         s_ipc_mutex[i] = xSemaphoreCreateMutexStatic(&s_ipc_mutex_buffer[i]);
         s_ipc_ack[i] = xSemaphoreCreateBinaryStatic(&s_ipc_ack_buffer[i]);
+        portMUX_INITIALIZE(&s_ipc_queue[i].lock);
         BaseType_t res = xTaskCreatePinnedToCore(ipc_task, task_name, IPC_STACK_SIZE, (void*) i,
                                                  IPC_MAX_PRIORITY, &s_ipc_task_handle[i], i);
         assert(res == pdTRUE);
@@ -204,4 +245,96 @@ esp_err_t esp_ipc_call_nonblocking(uint32_t cpu_id, esp_ipc_func_t func, void* a
     return ESP_FAIL;
 }
 
+void esp_ipc_completion_init(esp_ipc_completion_t *completion)
+{
+    assert(completion);
+    completion->pending = 0;
+    completion->done = xSemaphoreCreateCountingStatic(UINT32_MAX, 0, &completion->done_buffer);
+}
+
+esp_err_t esp_ipc_call_batch(uint32_t cpu_id, const esp_ipc_call_desc_t *calls, size_t count, esp_ipc_completion_t *completion)
+{
+    if (cpu_id >= CONFIG_FREERTOS_NUMBER_OF_CORES || calls == NULL || count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (calls[i].func == NULL) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    if (s_ipc_task_handle[cpu_id] == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (cpu_id == xPortGetCoreID() && xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ipc_queue_t *queue = &s_ipc_queue[cpu_id];
+    bool was_empty;
+
+    portENTER_CRITICAL_SAFE(&queue->lock);
+    if (count > CONFIG_ESP_IPC_QUEUE_SIZE - queue->count) {
+        portEXIT_CRITICAL_SAFE(&queue->lock);
+        return ESP_ERR_NO_MEM;
+    }
+    was_empty = (queue->count == 0);
+    for (size_t i = 0; i < count; i++) {
+        queue->entries[(queue->head + queue->count) % CONFIG_ESP_IPC_QUEUE_SIZE] = (ipc_queue_entry_t) {
+            .func = calls[i].func,
+            .arg = calls[i].arg,
+            .completion = completion,
+        };
+        queue->count++;
+    }
+    portEXIT_CRITICAL_SAFE(&queue->lock);
+
+    if (completion) {
+        __atomic_fetch_add(&completion->pending, count, __ATOMIC_RELAXED);
+    }
+
+    // The IPC task drains the whole queue each time it wakes up, so it only needs a notification
+    // if it may have found the queue empty before. This saves a cross-core interrupt per call.
+    if (was_empty) {
+        if (xPortInIsrContext()) {
+            vTaskNotifyGiveFromISR(s_ipc_task_handle[cpu_id], NULL);
+        } else {
+#ifdef CONFIG_ESP_IPC_USES_CALLERS_PRIORITY
+            UBaseType_t priority_of_current_task = uxTaskPriorityGet(NULL);
+            if (uxTaskPriorityGet(s_ipc_task_handle[cpu_id]) < priority_of_current_task) {
+                vTaskPrioritySet(s_ipc_task_handle[cpu_id], priority_of_current_task);
+            }
+#endif
+            xTaskNotifyGive(s_ipc_task_handle[cpu_id]);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_ipc_call_async(uint32_t cpu_id, esp_ipc_func_t func, void* arg, esp_ipc_completion_t *completion)
+{
+    const esp_ipc_call_desc_t call = {
+        .func = func,
+        .arg = arg,
+    };
+    return esp_ipc_call_batch(cpu_id, &call, 1, completion);
+}
+
+esp_err_t esp_ipc_completion_wait(esp_ipc_completion_t *completion, TickType_t ticks_to_wait)
+{
+    assert(completion);
+
+    TimeOut_t timeout;
+    vTaskSetTimeOutState(&timeout);
+    while (__atomic_load_n(&completion->pending, __ATOMIC_RELAXED) > 0) {
+        if (xSemaphoreTake(completion->done, ticks_to_wait) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+        if (__atomic_sub_fetch(&completion->pending, 1, __ATOMIC_RELAXED) > 0 && xTaskCheckForTimeOut(&timeout, &ticks_to_wait) != pdFALSE) {
+            // Finish without blocking if the remaining calls are already done
+            ticks_to_wait = 0;
+        }
+    }
+    return ESP_OK;
+}
+
 #endif // !defined(CONFIG_FREERTOS_UNICORE) || defined(CONFIG_APPTRACE_GCOV_ENABLE)
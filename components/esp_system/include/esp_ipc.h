@@ -6,7 +6,12 @@
 
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
 #include <esp_err.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -71,6 +76,91 @@ esp_err_t esp_ipc_call(uint32_t cpu_id, esp_ipc_func_t func, void* arg);
  */
 esp_err_t esp_ipc_call_blocking(uint32_t cpu_id, esp_ipc_func_t func, void* arg);
 
+/**
+ * @brief Completion handle of queued IPC calls
+ *
+ * A completion tracks the calls submitted with esp_ipc_call_async() or esp_ipc_call_batch() until they are waited
+ * for with esp_ipc_completion_wait(). The members are private and must not be accessed directly.
+ *
+ * A completion must be initialized with esp_ipc_completion_init() and must stay valid until all calls submitted
+ * with it have been waited for. It can then be reused for further calls.
+ */
+typedef struct {
+    uint32_t pending;               /*!< Number of submitted calls which were not waited for yet */
+    SemaphoreHandle_t done;         /*!< Given once by the IPC task for each finished call */
+    StaticSemaphore_t done_buffer;  /*!< Storage of the done semaphore */
+} esp_ipc_completion_t;
+
+/**
+ * @brief Description of one call submitted with esp_ipc_call_batch()
+ */
+typedef struct {
+    esp_ipc_func_t func;            /*!< Function to be executed */
+    void *arg;                      /*!< Argument to pass into the function */
+} esp_ipc_call_desc_t;
+
+/**
+ * @brief Initialize a completion handle
+ *
+ * @param[out] completion Completion to initialize
+ */
+void esp_ipc_completion_init(esp_ipc_completion_t *completion);
+
+/**
+ * @brief Queue a callback for execution on a given CPU without waiting for it
+ *
+ * Unlike esp_ipc_call(), this function does not wait for the IPC task and does not take the IPC lock. The callback
+ * is added to a queue of the target CPU (of CONFIG_ESP_IPC_QUEUE_SIZE entries), and the IPC task of that CPU
+ * executes the queued callbacks in order. The IPC task is only notified if its queue was empty, so callers
+ * submitting several callbacks in a row do not interrupt the target CPU for each of them.
+ *
+ * This function can be called from an ISR.
+ *
+ * @param[in]   cpu_id      CPU where the given function should be executed
+ * @param[in]   func        Pointer to a function of type void func(void* arg) to be executed
+ * @param[in]   arg         Arbitrary argument of type void* to be passed into the function
+ * @param[in]   completion  Completion to signal when the callback has finished, or NULL
+ *
+ * @return
+ *      - ESP_ERR_INVALID_ARG if cpu_id or func is invalid
+ *      - ESP_ERR_INVALID_STATE if the IPC task or the FreeRTOS scheduler is not running
+ *      - ESP_ERR_NO_MEM if the queue of the target CPU is full
+ *      - ESP_OK otherwise
+ */
+esp_err_t esp_ipc_call_async(uint32_t cpu_id, esp_ipc_func_t func, void* arg, esp_ipc_completion_t *completion);
+
+/**
+ * @brief Queue several callbacks for execution on a given CPU without waiting for them
+ *
+ * This function is identical to esp_ipc_call_async() except that all the given callbacks are added to the queue
+ * at once, and the IPC task is notified at most once for the whole batch. Either all or none of the callbacks are
+ * queued.
+ *
+ * @param[in]   cpu_id      CPU where the given functions should be executed
+ * @param[in]   calls       Array of callbacks to execute in order
+ * @param[in]   count       Number of elements in calls
+ * @param[in]   completion  Completion to signal when each of the callbacks has finished, or NULL
+ *
+ * @return
+ *      - ESP_ERR_INVALID_ARG if cpu_id, calls or count is invalid
+ *      - ESP_ERR_INVALID_STATE if the IPC task or the FreeRTOS scheduler is not running
+ *      - ESP_ERR_NO_MEM if the queue of the target CPU does not have room for count callbacks
+ *      - ESP_OK otherwise
+ */
+esp_err_t esp_ipc_call_batch(uint32_t cpu_id, const esp_ipc_call_desc_t *calls, size_t count, esp_ipc_completion_t *completion);
+
+/**
+ * @brief Wait until all calls submitted with a completion have finished
+ *
+ * @param[in]   completion      Completion passed to esp_ipc_call_async() or esp_ipc_call_batch()
+ * @param[in]   ticks_to_wait   Maximum time to wait. Set to 0 to only check whether the calls have finished.
+ *
+ * @return
+ *      - ESP_OK if all calls have finished
+ *      - ESP_ERR_TIMEOUT if some calls have not finished in time. They can be waited for again later.
+ */
+esp_err_t esp_ipc_completion_wait(esp_ipc_completion_t *completion, TickType_t ticks_to_wait);
+
 #endif // !defined(CONFIG_FREERTOS_UNICORE) || defined(CONFIG_APPTRACE_GCOV_ENABLE)
 
 #ifdef __cplusplus
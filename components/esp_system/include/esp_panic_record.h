@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum length of the panic reason kept in the record, including the terminating null */
+#define ESP_PANIC_RECORD_REASON_LEN     64
+
+/** Maximum number of backtrace addresses kept in the record */
+#if CONFIG_ESP_SYSTEM_PANIC_RECORD
+#define ESP_PANIC_RECORD_BACKTRACE_DEPTH    CONFIG_ESP_SYSTEM_PANIC_RECORD_DEPTH
+#else
+#define ESP_PANIC_RECORD_BACKTRACE_DEPTH    16
+#endif
+
+/** Maximum number of words of the exception frame kept in the record */
+#define ESP_PANIC_RECORD_FRAME_WORDS    40
+
+/**
+ * @brief Panic information recorded before the reboot
+ */
+typedef struct {
+    uint32_t core;                                          /*!< Core which triggered the panic */
+    uint32_t pc;                                            /*!< Address of the instruction which triggered the panic */
+    uint32_t cause;                                         /*!< Exception cause register (EXCCAUSE or MCAUSE) */
+    bool abort;                                             /*!< The panic was triggered by abort() */
+    bool backtrace_corrupted;                               /*!< The backtrace stopped on a corrupted frame */
+    uint16_t backtrace_len;                                 /*!< Number of addresses in backtrace */
+    uint32_t backtrace[ESP_PANIC_RECORD_BACKTRACE_DEPTH];   /*!< Backtrace addresses, starting with the panic PC */
+    uint32_t frame_words;                                   /*!< Number of words in frame */
+    uint32_t frame[ESP_PANIC_RECORD_FRAME_WORDS];           /*!< Exception frame, XtExcFrame on Xtensa, RvExcFrame on RISC-V */
+    char reason[ESP_PANIC_RECORD_REASON_LEN];               /*!< Panic reason, or the abort() details */
+} esp_panic_record_t;
+
+/**
+ * @brief Get the panic record saved before the last reboot
+ *
+ * The record is kept until esp_panic_record_clear() is called, so it can be
+ * processed later, for example once the network is up.
+ *
+ * @note Only available if CONFIG_ESP_SYSTEM_PANIC_RECORD is enabled.
+ *
+ * @param[out] record Copy of the panic record
+ *
+ * @return
+ *    - ESP_OK if a valid record is found
+ *    - ESP_ERR_INVALID_ARG if record is NULL
+ *    - ESP_ERR_NOT_FOUND if no panic was recorded, or the record is corrupted
+ */
+esp_err_t esp_panic_record_get(esp_panic_record_t *record);
+
+/**
+ * @brief Clear the panic record
+ */
+void esp_panic_record_clear(void);
+
+/**
+ * @brief Print a panic record to the console
+ *
+ * The addresses are printed in hexadecimal, so IDF Monitor decodes them when
+ * the application running on the chip is the one which panicked.
+ *
+ * @param record Panic record to print
+ */
+void esp_panic_record_print(const esp_panic_record_t *record);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -80,6 +80,11 @@ void panic_print_registers(const void *frame, int core);
 
 void panic_print_backtrace(const void *frame, int core);
 
+// Fill |pcs| with up to |depth| backtrace addresses starting from the exception
+// frame, without printing anything. Returns the number of addresses filled,
+// |corrupted| is set if the backtrace stopped on a corrupted frame.
+int panic_get_backtrace(const void *frame, uint32_t *pcs, int depth, bool *corrupted);
+
 uint32_t panic_get_address(const void* frame);
 
 void panic_set_address(void *frame, uint32_t addr);
@@ -88,6 +93,11 @@ uint32_t panic_get_cause(const void* frame);
 
 void panic_prepare_frame_from_ctx(void* frame);
 
+#if CONFIG_ESP_SYSTEM_PANIC_RECORD
+// Save the panic information to the record kept over the reboot, see esp_panic_record.h
+void esp_panic_record_save(const panic_info_t *info);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
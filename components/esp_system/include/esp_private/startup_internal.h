@@ -44,13 +44,23 @@ void startup_resume_other_cores(void);
  */
 typedef struct {
     esp_err_t (*fn)(void);   /*!< Pointer to the startup function */
-    uint16_t cores;          /*!< Bit mask of cores where the function has to be called */
+    uint16_t cores;          /*!< Bit mask of cores where the function has to be called, or ESP_SYSTEM_INIT_ANY_CORE */
     uint16_t stage;          /*!< Init stage number (0 or 1) */
+    uint16_t priority;       /*!< Init priority, orders the functions which can run on any core */
+#if CONFIG_ESP_SYSTEM_INIT_FN_TIMING
+    const char *name;        /*!< Function name, for the timing log */
+#endif
 } esp_system_init_fn_t;
 
 #define ESP_SYSTEM_INIT_STAGE_CORE          0
 #define ESP_SYSTEM_INIT_STAGE_SECONDARY     1
 
+#if CONFIG_ESP_SYSTEM_INIT_FN_TIMING
+#define ESP_SYSTEM_INIT_FN_NAME(f) .name = #f,
+#else
+#define ESP_SYSTEM_INIT_FN_NAME(f)
+#endif
+
 /**
  * @brief Define a system initialization function which will be executed on the specified cores
  *
@@ -65,6 +75,14 @@ typedef struct {
  * The function defined using this macro must return ESP_OK on success. Any other value will be
  * logged and the startup process will abort.
  *
+ * With ESP_SYSTEM_INIT_ANY_CORE as the core mask, the function is executed once, on the first core
+ * which reaches it. It then runs concurrently with the functions of the same stage which are assigned
+ * to the other cores, and with the other ESP_SYSTEM_INIT_ANY_CORE functions of the same priority.
+ * It only starts after all the ESP_SYSTEM_INIT_ANY_CORE functions with a lower priority have finished,
+ * so a function which depends on another one should use a higher priority. It must not depend on the
+ * functions which are assigned to specific cores in the same stage, and must not do flash operations,
+ * since the other cores may be executing from flash.
+ *
  * Initialization functions should be placed in a compilation unit where at least one other
  * symbol is referenced in another compilation unit. This means that the reference should not itself
  * get optimized out by the compiler or discarded by the linker if the related feature is used.
@@ -77,10 +95,15 @@ typedef struct {
         esp_system_init_fn_t esp_system_init_fn_##f = { \
             .fn = ( __esp_system_init_fn_##f), \
             .cores = (c), \
-            .stage = ESP_SYSTEM_INIT_STAGE_##stage_ \
+            .stage = ESP_SYSTEM_INIT_STAGE_##stage_, \
+            .priority = (priority), \
+            ESP_SYSTEM_INIT_FN_NAME(f) \
         }; \
     static esp_err_t __esp_system_init_fn_##f(void)
 
+/* Core mask of the init functions which are executed once, on any core */
+#define ESP_SYSTEM_INIT_ANY_CORE BIT(15)
+
 #ifdef CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
 #define ESP_SYSTEM_INIT_ALL_CORES BIT(0)
 #else
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -82,9 +82,13 @@ esp_err_t esp_task_wdt_deinit(void);
  * This function subscribes a task to the TWDT. Each subscribed task must periodically call esp_task_wdt_reset() to
  * prevent the TWDT from elapsing its timeout period. Failure to do so will result in a TWDT timeout.
  *
+ * @note The first 32 tasks and users subscribed, including the idle tasks, reset the TWDT without taking a lock. The
+ *       ones subscribed beyond them take a lock on each reset.
+ *
  * @param task_handle Handle of the task. Input NULL to subscribe the current running task to the TWDT
  * @return
  *  - ESP_OK: Successfully subscribed the task to the TWDT
+ *  - ESP_ERR_NO_MEM: Insufficient memory
  *  - Other: Failed to subscribe task
  */
 esp_err_t esp_task_wdt_add(TaskHandle_t task_handle);
@@ -96,10 +100,14 @@ esp_err_t esp_task_wdt_add(TaskHandle_t task_handle);
  * periodically. Each subscribed user must periodically call esp_task_wdt_reset_user() to prevent the TWDT from elapsing
  * its timeout period. Failure to do so will result in a TWDT timeout.
  *
+ * @note The first 32 tasks and users subscribed, including the idle tasks, reset the TWDT without taking a lock. The
+ *       ones subscribed beyond them take a lock on each reset.
+ *
  * @param[in] user_name String to identify the user
  * @param[out] user_handle_ret Handle of the user
  * @return
  *  - ESP_OK: Successfully subscribed the user to the TWDT
+ *  - ESP_ERR_NO_MEM: Insufficient memory
  *  - Other: Failed to subscribe user
  */
 esp_err_t esp_task_wdt_add_user(const char *user_name, esp_task_wdt_user_handle_t *user_handle_ret);
@@ -111,6 +119,9 @@ esp_err_t esp_task_wdt_add_user(const char *user_name, esp_task_wdt_user_handle_
  * call this function to prevent the TWDT from timing out. If one or more subscribed tasks fail to reset the TWDT on
  * their own behalf, a TWDT timeout will occur.
  *
+ * @note This function doesn't take a lock, only the call which completes the set of resets since the last feed of the
+ *       timer does, or a call from a task subscribed beyond the first 32 entries. It is cheap enough to be called on every iteration of a busy loop.
+ *
  * @return
  *  - ESP_OK: Successfully reset the TWDT on behalf of the currently running task
  *  - Other: Failed to reset
@@ -252,6 +252,11 @@ void esp_panic_handler(panic_info_t *info)
         info->exception = PANIC_EXCEPTION_ABORT;
     }
 
+#if CONFIG_ESP_SYSTEM_PANIC_RECORD
+    // Recorded before anything is printed, so the record is there even if the handler hangs or panics again
+    esp_panic_record_save(info);
+#endif
+
     /*
       * For any supported chip, the panic handler prints the contents of panic_info_t in the following format:
       *
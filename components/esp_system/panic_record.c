@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+
+#include "esp_attr.h"
+#include "esp_rom_crc.h"
+#include "esp_panic_record.h"
+#include "esp_private/panic_internal.h"
+
+#ifdef __XTENSA__
+#include "xtensa_context.h"
+#define PANIC_FRAME_SIZE    sizeof(XtExcFrame)
+#else
+#include "riscv/rvruntime-frames.h"
+#define PANIC_FRAME_SIZE    sizeof(RvExcFrame)
+#endif
+
+/* Printing the registers and the backtrace at the console baud rate takes longer than the reboot itself. The panic
+ * handler only copies them to memory which isn't initialized at startup, the application decodes them after the
+ * reboot. The record is only trusted if its CRC matches, as the memory holds garbage after a power-on reset. */
+
+#if CONFIG_SOC_RTC_FAST_MEM_SUPPORTED || CONFIG_SOC_RTC_SLOW_MEM_SUPPORTED
+#define PANIC_RECORD_ATTR   RTC_NOINIT_ATTR
+#else
+#define PANIC_RECORD_ATTR   __NOINIT_ATTR
+#endif
+
+#define PANIC_RECORD_MAGIC  0x50414e43  // "PANC"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t crc;
+    esp_panic_record_t record;
+} panic_record_store_t;
+
+static PANIC_RECORD_ATTR panic_record_store_t s_panic_record;
+
+static void copy_str(char *dst, const char *src, size_t size)
+{
+    size_t i = 0;
+
+    // strlcpy might be in flash, which isn't accessible if the panic happened with the flash cache disabled
+    while (src && src[i] != '\0' && i < size - 1) {
+        dst[i] = src[i];
+        i++;
+    }
+    dst[i] = '\0';
+}
+
+static uint32_t record_crc(const esp_panic_record_t *record)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)record, sizeof(esp_panic_record_t));
+}
+
+void esp_panic_record_save(const panic_info_t *info)
+{
+    esp_panic_record_t *record = &s_panic_record.record;
+    bool corrupted = false;
+
+    s_panic_record.magic = 0;
+    memset(record, 0, sizeof(esp_panic_record_t));
+
+    record->core = info->core;
+    record->pc = (uint32_t)info->addr;
+    record->cause = panic_get_cause(info->frame);
+    record->abort = (info->exception == PANIC_EXCEPTION_ABORT);
+    copy_str(record->reason, record->abort ? g_panic_abort_details : info->reason, sizeof(record->reason));
+
+    record->frame_words = MIN(PANIC_FRAME_SIZE / sizeof(uint32_t), ESP_PANIC_RECORD_FRAME_WORDS);
+    memcpy(record->frame, info->frame, record->frame_words * sizeof(uint32_t));
+
+    record->backtrace_len = panic_get_backtrace(info->frame, record->backtrace,
+                                                ESP_PANIC_RECORD_BACKTRACE_DEPTH, &corrupted);
+    record->backtrace_corrupted = corrupted;
+
+    s_panic_record.crc = record_crc(record);
+    s_panic_record.magic = PANIC_RECORD_MAGIC;
+}
+
+esp_err_t esp_panic_record_get(esp_panic_record_t *record)
+{
+    if (record == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_panic_record.magic != PANIC_RECORD_MAGIC || s_panic_record.crc != record_crc(&s_panic_record.record)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    *record = s_panic_record.record;
+    record->reason[ESP_PANIC_RECORD_REASON_LEN - 1] = '\0';
+    record->backtrace_len = MIN(record->backtrace_len, ESP_PANIC_RECORD_BACKTRACE_DEPTH);
+    record->frame_words = MIN(record->frame_words, ESP_PANIC_RECORD_FRAME_WORDS);
+    return ESP_OK;
+}
+
+void esp_panic_record_clear(void)
+{
+    s_panic_record.magic = 0;
+}
+
+void esp_panic_record_print(const esp_panic_record_t *record)
+{
+    printf("Recorded panic on core %" PRIu32 " (%s)\n", record->core,
+           record->reason[0] ? record->reason : (record->abort ? "abort() was called" : "unknown"));
+    printf("PC: 0x%08" PRIx32 "  cause: 0x%08" PRIx32 "\n", record->pc, record->cause);
+
+    printf("Exception frame:");
+    for (uint32_t i = 0; i < record->frame_words; i++) {
+        printf("%s0x%08" PRIx32, (i % 8 == 0) ? "\n" : " ", record->frame[i]);
+    }
+
+    printf("\n\nBacktrace:");
+    for (int i = 0; i < record->backtrace_len; i++) {
+        printf(" 0x%08" PRIx32, record->backtrace[i]);
+    }
+    printf("%s\n", record->backtrace_corrupted ? " |<-CORRUPTED" : "");
+}
@@ -28,6 +28,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_cpu.h"
+#include "esp_memory_utils.h"
 #include "esp_private/hw_stack_guard.h"
 #endif
 
@@ -336,6 +337,30 @@ void panic_print_backtrace(const void *frame, int core)
 #endif
 }
 
+int panic_get_backtrace(const void *frame, uint32_t *pcs, int depth, bool *corrupted)
+{
+    /* The stack can't be unwound without the eh_frame information, which needs the flash cache. Record the PC,
+     * the return address and the words of the stack memory printed by the basic backtrace which point to code. */
+    const RvExcFrame *regs = (const RvExcFrame *)frame;
+    uint32_t sp = regs->sp;
+    int n = 0;
+
+    *corrupted = !esp_stack_ptr_is_sane(sp);
+    if (n < depth) {
+        pcs[n++] = regs->mepc;
+    }
+    if (n < depth) {
+        pcs[n++] = regs->ra;
+    }
+    for (int x = 0; x < 1024 && n < depth && !*corrupted; x += sizeof(uint32_t)) {
+        uint32_t val = *(uint32_t *)(sp + x);
+        if (esp_ptr_executable((void *)val)) {
+            pcs[n++] = val;
+        }
+    }
+    return n;
+}
+
 uint32_t panic_get_address(const void *f)
 {
     return ((RvExcFrame *)f)->mepc;
@@ -9,6 +9,7 @@
 #include "freertos/task.h"
 
 #include "esp_debug_helpers.h"
+#include "esp_memory_utils.h"
 
 #include "esp_private/panic_internal.h"
 #include "esp_private/panic_reason.h"
@@ -480,6 +481,30 @@ void panic_print_backtrace(const void *f, int core)
     esp_backtrace_print_from_frame(100, &frame, true);
 }
 
+int panic_get_backtrace(const void *f, uint32_t *pcs, int depth, bool *corrupted)
+{
+    XtExcFrame *xt_frame = (XtExcFrame *) f;
+    esp_backtrace_frame_t frame = {.pc = xt_frame->pc, .sp = xt_frame->a1, .next_pc = xt_frame->a0, .exc_frame = xt_frame};
+    int n = 0;
+
+    if (depth <= 0) {
+        *corrupted = false;
+        return 0;
+    }
+    pcs[n++] = esp_cpu_process_stack_pc(frame.pc);
+    /* Same checks as esp_backtrace_print_from_frame(), the first PC is recorded even if corrupted */
+    *corrupted = !(esp_stack_ptr_is_sane(frame.sp) &&
+                   (esp_ptr_executable((void *)esp_cpu_process_stack_pc(frame.pc)) ||
+                    xt_frame->exccause == EXCCAUSE_INSTR_PROHIBITED));
+    while (n < depth && frame.next_pc != 0 && !*corrupted) {
+        if (!esp_backtrace_get_next_frame(&frame)) {
+            *corrupted = true;
+        }
+        pcs[n++] = esp_cpu_process_stack_pc(frame.pc);
+    }
+    return n;
+}
+
 void panic_prepare_frame_from_ctx(void* frame)
 {
     /* Nothing to cleanup on xtensa */
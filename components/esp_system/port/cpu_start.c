@@ -106,6 +106,10 @@
 
 #include "bootloader_mem.h"
 
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+#include "esp_boot_trace.h"
+#endif
+
 #if CONFIG_APP_BUILD_TYPE_RAM
 #include "esp_rom_spiflash.h"
 #include "bootloader_init.h"
@@ -448,6 +452,10 @@ void IRAM_ATTR call_start_cpu0(void)
     }
 #endif
 
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_record(ESP_BOOT_TRACE_APP_START);
+#endif
+
 #if !CONFIG_APP_BUILD_TYPE_PURE_RAM_APP && !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE && !SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
     // It helps to fix missed cache settings for other cores. It happens when bootloader is unicore.
     do_multicore_settings();
@@ -634,7 +642,12 @@ void IRAM_ATTR call_start_cpu0(void)
 #endif // SOC_CPU_CORES_NUM > 1
 
 #if CONFIG_SPIRAM_MEMTEST
-    if (esp_psram_is_initialized()) {
+    bool skip_ext_ram_test = false;
+#if CONFIG_ESP_SYSTEM_SKIP_REINIT_AFTER_DEEP_SLEEP
+    // the memory passed the test at the first boot, and it's lost in deep sleep anyway
+    skip_ext_ram_test = (rst_reas[0] == RESET_REASON_CORE_DEEP_SLEEP);
+#endif
+    if (esp_psram_is_initialized() && !skip_ext_ram_test) {
         bool ext_ram_ok = esp_psram_extram_test();
         if (!ext_ram_ok) {
             ESP_EARLY_LOGE(TAG, "External RAM failed memory test!");
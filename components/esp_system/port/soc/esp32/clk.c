@@ -61,6 +61,13 @@ static void select_rtc_slow_clk(slow_clk_sel_t slow_clk)
      */
     int retry_32k_xtal = RTC_XTAL_CAL_RETRY;
 
+#if CONFIG_ESP_SYSTEM_SKIP_REINIT_AFTER_DEEP_SLEEP
+    if (esp_clk_slowclk_cal_retained(rtc_slow_clk_src)) {
+        ESP_EARLY_LOGD(TAG, "RTC_SLOW_CLK calibration value kept over deep sleep: %" PRIu32, esp_clk_slowclk_cal_get());
+        return;
+    }
+#endif
+
     do {
         if (rtc_slow_clk_src == SOC_RTC_SLOW_CLK_SRC_XTAL32K) {
             /* 32k XTAL oscillator needs to be enabled and running before it can
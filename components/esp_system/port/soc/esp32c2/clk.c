@@ -154,6 +154,13 @@ static void select_rtc_slow_clk(slow_clk_sel_t slow_clk)
      */
     int retry_ext_clk = 3;
 
+#if CONFIG_ESP_SYSTEM_SKIP_REINIT_AFTER_DEEP_SLEEP
+    if (esp_clk_slowclk_cal_retained(rtc_slow_clk_src)) {
+        ESP_EARLY_LOGD(TAG, "RTC_SLOW_CLK calibration value kept over deep sleep: %" PRIu32, esp_clk_slowclk_cal_get());
+        return;
+    }
+#endif
+
     do {
         if (rtc_slow_clk_src == SOC_RTC_SLOW_CLK_SRC_OSC_SLOW) {
             /* external clock needs to be connected to PIN0 before it can
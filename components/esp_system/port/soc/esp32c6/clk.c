@@ -151,6 +151,13 @@ static void select_rtc_slow_clk(soc_rtc_slow_clk_src_t rtc_slow_clk_src)
      */
     int retry_32k_xtal = 3;
 
+#if CONFIG_ESP_SYSTEM_SKIP_REINIT_AFTER_DEEP_SLEEP
+    if (esp_clk_slowclk_cal_retained(rtc_slow_clk_src)) {
+        ESP_EARLY_LOGD(TAG, "RTC_SLOW_CLK calibration value kept over deep sleep: %" PRIu32, esp_clk_slowclk_cal_get());
+        return;
+    }
+#endif
+
     do {
         if (rtc_slow_clk_src == SOC_RTC_SLOW_CLK_SRC_XTAL32K || rtc_slow_clk_src == SOC_RTC_SLOW_CLK_SRC_OSC_SLOW) {
             /* 32k XTAL oscillator needs to be enabled and running before it can
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <inttypes.h>
 
 #include "esp_attr.h"
 #include "esp_err.h"
@@ -19,9 +20,15 @@
 
 #include "soc/soc_caps.h"
 #include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "esp_private/esp_clk.h"
 
 #include "esp_private/startup_internal.h"
 
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+#include "esp_boot_trace.h"
+#endif
+
 // Ensure that system configuration matches the underlying number of cores.
 // This should enable us to avoid checking for both every time.
 #if !(SOC_CPU_CORES_NUM > 1) && !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
@@ -116,6 +123,60 @@ static void do_global_ctors(void)
  * system_init_fn.txt file.
  * @param stage_num Stage number of the init function call (0, 1).
  */
+static void call_system_init_fn(const esp_system_init_fn_t *p, int core_id)
+{
+    // During core init, stdout is not initialized yet, so use early logging.
+    ESP_EARLY_LOGD(TAG, "calling init function: %p on core: %d", p->fn, core_id);
+#if CONFIG_ESP_SYSTEM_INIT_FN_TIMING
+    uint32_t start = esp_cpu_get_cycle_count();
+#endif
+    esp_err_t err = (*(p->fn))();
+#if CONFIG_ESP_SYSTEM_INIT_FN_TIMING
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    ESP_EARLY_LOGI(TAG, "init function %s on core %d took %"PRIu32" us", p->name, core_id, cycles / (esp_clk_cpu_freq() / 1000000));
+#endif
+    if (err != ESP_OK) {
+        ESP_EARLY_LOGE(TAG, "init function %p has failed (0x%x), aborting", p->fn, err);
+        abort();
+    }
+}
+
+#if !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
+// Number of the claimed and of the finished ESP_SYSTEM_INIT_ANY_CORE functions, per stage
+static volatile uint32_t s_any_core_fn_claimed[2];
+static volatile uint32_t s_any_core_fn_done[2];
+#endif
+
+// Claim the any core function of the given ordinal, fails if another core has claimed it
+static bool claim_any_core_fn(uint32_t stage_num, uint32_t ordinal)
+{
+#if !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
+    return esp_cpu_compare_and_set(&s_any_core_fn_claimed[stage_num], ordinal, ordinal + 1);
+#else
+    return true;
+#endif
+}
+
+// Wait until the given number of any core functions have finished, on whichever core
+static void wait_any_core_fn_done(uint32_t stage_num, uint32_t count)
+{
+#if !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
+    while (s_any_core_fn_done[stage_num] < count) {
+        esp_rom_delay_us(10);
+    }
+#endif
+}
+
+static void set_any_core_fn_done(uint32_t stage_num)
+{
+#if !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
+    uint32_t done;
+    do {
+        done = s_any_core_fn_done[stage_num];
+    } while (!esp_cpu_compare_and_set(&s_any_core_fn_done[stage_num], done, done + 1));
+#endif
+}
+
 __attribute__((no_sanitize_undefined)) /* TODO: IDF-8133 */
 static void do_system_init_fn(uint32_t stage_num)
 {
@@ -123,17 +184,29 @@ static void do_system_init_fn(uint32_t stage_num)
     extern esp_system_init_fn_t _esp_system_init_fn_array_end;
 
     esp_system_init_fn_t *p;
+    // All the cores count the any core functions in the same order, the functions are sorted by priority
+    uint32_t any_core_ordinal = 0;
+    uint32_t any_core_prio_ordinal = 0;
+    uint16_t any_core_prio = 0;
 
     int core_id = esp_cpu_get_core_id();
     for (p = &_esp_system_init_fn_array_start; p < &_esp_system_init_fn_array_end; ++p) {
-        if (p->stage == stage_num && (p->cores & BIT(core_id)) != 0) {
-            // During core init, stdout is not initialized yet, so use early logging.
-            ESP_EARLY_LOGD(TAG, "calling init function: %p on core: %d", p->fn, core_id);
-            esp_err_t err = (*(p->fn))();
-            if (err != ESP_OK) {
-                ESP_EARLY_LOGE(TAG, "init function %p has failed (0x%x), aborting", p->fn, err);
-                abort();
+        if (p->stage != stage_num) {
+            continue;
+        }
+        if (p->cores == ESP_SYSTEM_INIT_ANY_CORE) {
+            if (any_core_ordinal == 0 || p->priority != any_core_prio) {
+                any_core_prio = p->priority;
+                any_core_prio_ordinal = any_core_ordinal;
+            }
+            if (claim_any_core_fn(stage_num, any_core_ordinal++)) {
+                // the any core functions with a lower priority must have finished
+                wait_any_core_fn_done(stage_num, any_core_prio_ordinal);
+                call_system_init_fn(p, core_id);
+                set_any_core_fn_done(stage_num);
             }
+        } else if ((p->cores & BIT(core_id)) != 0) {
+            call_system_init_fn(p, core_id);
         }
     }
 
@@ -201,6 +274,9 @@ static void start_cpu0_default(void)
 {
     // Initialize core components and services.
     do_core_init();
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_record(ESP_BOOT_TRACE_CORE_INIT_DONE);
+#endif
 
     // Execute constructors.
     do_global_ctors();
@@ -208,6 +284,9 @@ static void start_cpu0_default(void)
     // Execute init functions of other components; blocks
     // until all cores finish (when !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE).
     do_secondary_init();
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_record(ESP_BOOT_TRACE_SECONDARY_INIT_DONE);
+#endif
 
 #if SOC_CPU_CORES_NUM > 1 && !CONFIG_ESP_SYSTEM_SINGLE_CORE_MODE
     s_system_full_inited = true;
@@ -55,6 +55,8 @@ bool g_twdt_isr = false;
 
 // --------------------------------------------------- Definitions -----------------------------------------------------
 
+#define TWDT_MAX_SLOTS      32  // One bit of the reset mask per slot, further entries are only kept in the list
+
 // ---------------------- Typedefs -------------------------
 
 /**
@@ -65,7 +67,8 @@ struct twdt_entry {
     SLIST_ENTRY(twdt_entry) slist_entry;
     TaskHandle_t task_handle;   // NULL if user entry
     const char *user_name;      // NULL if task entry
-    bool has_reset;
+    uint32_t reset_bit;         // Bit of the entry in the reset and active masks, 0 if the entry has no slot
+    bool has_reset;             // Reset flag of an entry without a slot, protected by the spinlock
 };
 
 // Structure used to hold run time configuration of the TWDT
@@ -73,6 +76,15 @@ typedef struct twdt_obj twdt_obj_t;
 struct twdt_obj {
     twdt_ctx_t impl_ctx;
     SLIST_HEAD(entry_list_head, twdt_entry) entries_slist;
+    /* The masks and slots are written under the spinlock, but read without it by the reset functions, which
+     * only take the spinlock when their entry is the last one to reset */
+    uint32_t active_mask;       // Bits of the subscribed entries
+    uint32_t reset_mask;        // Bits of the entries which have reset since the last feed of the timer
+    TaskHandle_t slot_tasks[TWDT_MAX_SLOTS];        // Task handle of each bit, NULL for user entries
+    twdt_entry_t *slot_entries[TWDT_MAX_SLOTS];     // Entry of each bit
+    /* Entries subscribed once all the slots are taken are only found in the list, and reset under the spinlock */
+    uint32_t unslotted_count;   // Number of entries without a slot
+    uint32_t unslotted_pending; // Number of entries without a slot which have not reset since the last feed
     uint32_t idle_core_mask;    // Current core's who's idle tasks are subscribed
     bool panic; // Flag to trigger panic when TWDT times out
     bool waiting_for_task; // Flag to start the timer as soon as a task is added
@@ -102,13 +114,56 @@ static void task_wdt_timer_feed(void)
 {
     esp_task_wdt_impl_timer_feed(p_twdt_obj->impl_ctx);
 
-    /* Clear the has_reset flag in each entry */
-    twdt_entry_t *entry;
-    SLIST_FOREACH(entry, &p_twdt_obj->entries_slist, slist_entry) {
-        entry->has_reset = false;
+    /* Clear the reset flag of each entry */
+    __atomic_store_n(&p_twdt_obj->reset_mask, 0, __ATOMIC_RELAXED);
+    if (p_twdt_obj->unslotted_count != 0) {
+        twdt_entry_t *entry;
+        SLIST_FOREACH(entry, &p_twdt_obj->entries_slist, slist_entry) {
+            entry->has_reset = false;
+        }
+        p_twdt_obj->unslotted_pending = p_twdt_obj->unslotted_count;
     }
 }
 
+/**
+ * @brief Whether an entry has reset since the last feed of the timer
+ */
+static inline bool entry_has_reset(const twdt_entry_t *entry)
+{
+    if (entry->reset_bit == 0) {
+        return entry->has_reset;
+    }
+    return (__atomic_load_n(&p_twdt_obj->reset_mask, __ATOMIC_RELAXED) & entry->reset_bit) != 0;
+}
+
+/**
+ * @brief Mark an entry as reset, and feed the timer if it is the last subscribed entry to reset
+ *
+ * Called without the spinlock. Once an entry has reset, further calls until the next feed only read the reset mask.
+ *
+ * @param reset_bit Bit of the entry
+ */
+static void mark_entry_reset(uint32_t reset_bit)
+{
+    if (__atomic_load_n(&p_twdt_obj->reset_mask, __ATOMIC_RELAXED) & reset_bit) {
+        return;
+    }
+    uint32_t reset_mask = __atomic_or_fetch(&p_twdt_obj->reset_mask, reset_bit, __ATOMIC_RELAXED);
+    uint32_t active_mask = __atomic_load_n(&p_twdt_obj->active_mask, __ATOMIC_ACQUIRE);
+    if ((reset_mask & active_mask) != active_mask) {
+        return;
+    }
+    /* Check again under the spinlock: an entry may have been added, or the timer fed from the other core. The entries
+     * without a slot must have reset too. */
+    portENTER_CRITICAL(&spinlock);
+    active_mask = p_twdt_obj->active_mask;
+    reset_mask = __atomic_load_n(&p_twdt_obj->reset_mask, __ATOMIC_RELAXED);
+    if (active_mask != 0 && (reset_mask & active_mask) == active_mask && p_twdt_obj->unslotted_pending == 0) {
+        task_wdt_timer_feed();
+    }
+    portEXIT_CRITICAL(&spinlock);
+}
+
 /**
  * @brief Checks whether a user entry exists and if all other entries have been reset
  *
@@ -125,7 +180,7 @@ static bool find_entry_and_check_all_reset(twdt_entry_t *user_entry, bool *all_r
     SLIST_FOREACH(entry, &p_twdt_obj->entries_slist, slist_entry) {
         if (entry == user_entry) {
             found_user_entry = true;
-        } else if (entry->has_reset == false) {
+        } else if (!entry_has_reset(entry)) {
             found_non_reset = true;
         }
     }
@@ -150,7 +205,7 @@ static twdt_entry_t *find_entry_from_task_handle_and_check_all_reset(TaskHandle_
     SLIST_FOREACH(entry, &p_twdt_obj->entries_slist, slist_entry) {
         if (entry->task_handle == handle) {
             target = entry;
-        } else if (entry->has_reset == false) {
+        } else if (!entry_has_reset(entry)) {
             found_non_reset = true;
         }
     }
@@ -159,6 +214,48 @@ static twdt_entry_t *find_entry_from_task_handle_and_check_all_reset(TaskHandle_
     return target;
 }
 
+/**
+ * @brief Mark an entry which was not found in the slots as reset, and feed the timer if all entries have reset
+ *
+ * Called without the spinlock, when the entry was not found in the slots but some entries have no slot.
+ *
+ * @param[in] is_task Whether the entry is a task entry or user entry
+ * @param[in] entry_data Data associated with the entry (either a task handle or user entry)
+ * @return ESP_OK if the entry was found, ESP_ERR_NOT_FOUND otherwise
+ */
+static esp_err_t reset_unslotted_entry(bool is_task, void *entry_data)
+{
+    bool all_reset;
+    twdt_entry_t *entry;
+    uint32_t reset_bit = 0;
+
+    portENTER_CRITICAL(&spinlock);
+    if (is_task) {
+        entry = find_entry_from_task_handle_and_check_all_reset((TaskHandle_t)entry_data, &all_reset);
+    } else {
+        entry = find_entry_and_check_all_reset((twdt_entry_t *)entry_data, &all_reset) ? entry_data : NULL;
+    }
+    if (entry == NULL) {
+        portEXIT_CRITICAL(&spinlock);
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (entry->reset_bit != 0) {
+        // The entry was given a slot after the caller looked for it
+        reset_bit = entry->reset_bit;
+    } else if (!entry->has_reset) {
+        entry->has_reset = true;
+        p_twdt_obj->unslotted_pending--;
+        if (all_reset) {
+            task_wdt_timer_feed();
+        }
+    }
+    portEXIT_CRITICAL(&spinlock);
+    if (reset_bit != 0) {
+        mark_entry_reset(reset_bit);
+    }
+    return ESP_OK;
+}
+
 /**
  * @brief Create a task/user entry and add it to the task WDT
  *
@@ -194,6 +291,19 @@ static esp_err_t add_entry(bool is_task, void *entry_data, twdt_entry_t **entry_
         bool entry_found = find_entry_and_check_all_reset(entry, &all_reset);
         ESP_GOTO_ON_FALSE_ISR(!entry_found, ESP_ERR_INVALID_ARG, state_err, TAG, "user is already subscribed");
     }
+    // Assign a free bit to the entry. Once all the bits are taken, the entry is only kept in the list.
+    const uint32_t free_mask = ~p_twdt_obj->active_mask;
+    if (free_mask != 0) {
+        const int slot = __builtin_ctz(free_mask);
+        entry->reset_bit = BIT(slot);
+        p_twdt_obj->slot_tasks[slot] = entry->task_handle;
+        p_twdt_obj->slot_entries[slot] = entry;
+        __atomic_and_fetch(&p_twdt_obj->reset_mask, ~entry->reset_bit, __ATOMIC_RELAXED);
+        __atomic_store_n(&p_twdt_obj->active_mask, p_twdt_obj->active_mask | entry->reset_bit, __ATOMIC_RELEASE);
+    } else {
+        p_twdt_obj->unslotted_pending++;
+        __atomic_store_n(&p_twdt_obj->unslotted_count, p_twdt_obj->unslotted_count + 1, __ATOMIC_RELEASE);
+    }
     // Add entry to list
     SLIST_INSERT_HEAD(&p_twdt_obj->entries_slist, entry, slist_entry);
     // Start the timer if it has not been started yet and was waiting on a task to registered
@@ -241,6 +351,18 @@ static esp_err_t delete_entry(bool is_task, void *entry_data)
     }
     // Remove entry
     SLIST_REMOVE(&p_twdt_obj->entries_slist, entry, twdt_entry, slist_entry);
+    if (entry->reset_bit != 0) {
+        const int slot = __builtin_ctz(entry->reset_bit);
+        __atomic_store_n(&p_twdt_obj->active_mask, p_twdt_obj->active_mask & ~entry->reset_bit, __ATOMIC_RELEASE);
+        __atomic_and_fetch(&p_twdt_obj->reset_mask, ~entry->reset_bit, __ATOMIC_RELAXED);
+        p_twdt_obj->slot_tasks[slot] = NULL;
+        p_twdt_obj->slot_entries[slot] = NULL;
+    } else {
+        if (!entry->has_reset) {
+            p_twdt_obj->unslotted_pending--;
+        }
+        __atomic_store_n(&p_twdt_obj->unslotted_count, p_twdt_obj->unslotted_count - 1, __ATOMIC_RELEASE);
+    }
     /* Stop the timer if we don't have any more tasks/objects to watch */
     if (SLIST_EMPTY(&p_twdt_obj->entries_slist)) {
         p_twdt_obj->waiting_for_task = true;
@@ -694,49 +816,56 @@ esp_err_t esp_task_wdt_add_user(const char *user_name, esp_task_wdt_user_handle_
 esp_err_t esp_task_wdt_reset(void)
 {
     ESP_RETURN_ON_FALSE(p_twdt_obj != NULL, ESP_ERR_INVALID_STATE, TAG, "TWDT was never initialized");
-    esp_err_t ret;
     TaskHandle_t handle = xTaskGetCurrentTaskHandle();
 
-    portENTER_CRITICAL(&spinlock);
-    // Find entry from task handle
-    bool all_reset;
-    twdt_entry_t *entry;
-    entry = find_entry_from_task_handle_and_check_all_reset(handle, &all_reset);
-    ESP_GOTO_ON_FALSE_ISR((entry != NULL), ESP_ERR_NOT_FOUND, err, TAG, "task not found");
-    // Mark entry as reset and issue timer reset if all entries have been reset
-    entry->has_reset = true;    // Reset the task if it's on the task list
-    if (all_reset) {    // Reset if all other tasks in list have reset in
-        task_wdt_timer_feed();
+    // Find the bit of the task among the subscribed entries, without taking the spinlock
+    uint32_t reset_bit = 0;
+    uint32_t active_mask = __atomic_load_n(&p_twdt_obj->active_mask, __ATOMIC_ACQUIRE);
+    while (active_mask != 0) {
+        const int slot = __builtin_ctz(active_mask);
+        if (p_twdt_obj->slot_tasks[slot] == handle) {
+            reset_bit = BIT(slot);
+            break;
+        }
+        active_mask &= active_mask - 1;
     }
-    ret = ESP_OK;
-err:
-    portEXIT_CRITICAL(&spinlock);
-
-    return ret;
+    if (reset_bit == 0 && __atomic_load_n(&p_twdt_obj->unslotted_count, __ATOMIC_ACQUIRE) != 0) {
+        // The task may be one of the entries without a slot
+        ESP_RETURN_ON_ERROR(reset_unslotted_entry(true, (void *)handle), TAG, "task not found");
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_FALSE(reset_bit != 0, ESP_ERR_NOT_FOUND, TAG, "task not found");
+    // Mark entry as reset and issue timer reset if all entries have been reset
+    mark_entry_reset(reset_bit);
+    return ESP_OK;
 }
 
 esp_err_t esp_task_wdt_reset_user(esp_task_wdt_user_handle_t user_handle)
 {
     ESP_RETURN_ON_FALSE(user_handle != NULL, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
     ESP_RETURN_ON_FALSE(p_twdt_obj != NULL, ESP_ERR_INVALID_STATE, TAG, "TWDT was never initialized");
-    esp_err_t ret;
 
-    portENTER_CRITICAL(&spinlock);
-    // Check if entry exists
-    bool all_reset;
+    // Check if entry exists, without taking the spinlock. The handle is only compared, it may have been deleted.
     twdt_entry_t *entry = (twdt_entry_t *)user_handle;
-    bool entry_found = find_entry_and_check_all_reset(entry, &all_reset);
-    ESP_GOTO_ON_FALSE_ISR(entry_found, ESP_ERR_NOT_FOUND, err, TAG, "user handle not found");
-    // Mark entry as reset and issue timer reset if all entries have been reset
-    entry->has_reset = true;    // Reset the task if it's on the task list
-    if (all_reset) {    // Reset if all other tasks in list have reset in
-        task_wdt_timer_feed();
+    uint32_t reset_bit = 0;
+    uint32_t active_mask = __atomic_load_n(&p_twdt_obj->active_mask, __ATOMIC_ACQUIRE);
+    while (active_mask != 0) {
+        const int slot = __builtin_ctz(active_mask);
+        if (p_twdt_obj->slot_entries[slot] == entry) {
+            reset_bit = BIT(slot);
+            break;
+        }
+        active_mask &= active_mask - 1;
     }
-    ret = ESP_OK;
-err:
-    portEXIT_CRITICAL(&spinlock);
-
-    return ret;
+    if (reset_bit == 0 && __atomic_load_n(&p_twdt_obj->unslotted_count, __ATOMIC_ACQUIRE) != 0) {
+        // The user may be one of the entries without a slot
+        ESP_RETURN_ON_ERROR(reset_unslotted_entry(false, (void *)entry), TAG, "user handle not found");
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_FALSE(reset_bit != 0, ESP_ERR_NOT_FOUND, TAG, "user handle not found");
+    // Mark entry as reset and issue timer reset if all entries have been reset
+    mark_entry_reset(reset_bit);
+    return ESP_OK;
 }
 
 esp_err_t esp_task_wdt_delete(TaskHandle_t task_handle)
@@ -796,7 +925,7 @@ esp_err_t esp_task_wdt_print_triggered_tasks(task_wdt_msg_handler msg_handler, v
 
     // Find what entries triggered the TWDT timeout (i.e., which entries have not been reset)
     SLIST_FOREACH(entry, &p_twdt_obj->entries_slist, slist_entry) {
-        if (!entry->has_reset) {
+        if (!entry_has_reset(entry)) {
             const char *cpu;
             const char *name = entry->task_handle ? pcTaskGetName(entry->task_handle) : entry->user_name;
             const UBaseType_t affinity = get_task_affinity(entry->task_handle);
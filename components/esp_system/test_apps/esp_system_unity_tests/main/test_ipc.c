@@ -209,4 +209,46 @@ TEST_CASE("Test ipc call nonblocking when FreeRTOS Scheduler is suspended", "[ip
     xTaskResumeAll();
 #endif
 }
+
+static void test_func_ipc_increment_on_cpu1(void *arg)
+{
+    TEST_ASSERT_EQUAL(1, xPortGetCoreID());
+    int *val = (int *)arg;
+    *val = *val + 1;
+}
+
+TEST_CASE("Test ipc call batch and completion", "[ipc]")
+{
+    int vals[CONFIG_ESP_IPC_QUEUE_SIZE] = { 0 };
+    esp_ipc_call_desc_t calls[CONFIG_ESP_IPC_QUEUE_SIZE];
+    for (int i = 0; i < CONFIG_ESP_IPC_QUEUE_SIZE; i++) {
+        calls[i].func = test_func_ipc_increment_on_cpu1;
+        calls[i].arg = &vals[i];
+    }
+
+    esp_ipc_completion_t completion;
+    esp_ipc_completion_init(&completion);
+    TEST_ESP_OK(esp_ipc_completion_wait(&completion, 0));
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_ipc_call_batch(1, calls, 0, &completion));
+    TEST_ESP_OK(esp_ipc_call_batch(1, calls, CONFIG_ESP_IPC_QUEUE_SIZE, &completion));
+    TEST_ESP_OK(esp_ipc_completion_wait(&completion, portMAX_DELAY));
+    for (int i = 0; i < CONFIG_ESP_IPC_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL(1, vals[i]);
+    }
+
+    // Keep the IPC task busy for 100 ms, then fill its queue
+    int val = 0;
+    TEST_ESP_OK(esp_ipc_call_async(1, test_func_ipc_cb2, &val, &completion));
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+    TEST_ESP_OK(esp_ipc_call_batch(1, calls, CONFIG_ESP_IPC_QUEUE_SIZE, &completion));
+    TEST_ESP_ERR(ESP_ERR_NO_MEM, esp_ipc_call_async(1, test_func_ipc_increment_on_cpu1, &val, &completion));
+
+    TEST_ESP_ERR(ESP_ERR_TIMEOUT, esp_ipc_completion_wait(&completion, 0));
+    TEST_ESP_OK(esp_ipc_completion_wait(&completion, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(1, val);
+    for (int i = 0; i < CONFIG_ESP_IPC_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL(2, vals[i]);
+    }
+}
 #endif /* !CONFIG_FREERTOS_UNICORE */
@@ -5,6 +5,7 @@
  */
 
 #include "unity.h"
+#include <inttypes.h>
 #include <sys/time.h>
 #include <sys/param.h>
 #include "esp_sleep.h"
@@ -31,6 +32,7 @@
 #include "esp_private/esp_clk_tree_common.h"
 #include "esp_private/uart_share_hw_ctrl.h"
 #include "esp_random.h"
+#include "esp_heap_caps.h"
 #include "nvs_flash.h"
 #include "nvs.h"
 
@@ -624,4 +626,74 @@ static void check_time_deepsleep(void)
 
 TEST_CASE_MULTIPLE_STAGES("check a time after wakeup from deep sleep", "[deepsleep][reset=DEEPSLEEP_RESET]", trigger_deepsleep, check_time_deepsleep);
 
+#if CONFIG_ESP_SYSTEM_SKIP_REINIT_AFTER_DEEP_SLEEP && SOC_RTC_MEM_SUPPORTED
+#define SKIP_REINIT_SLEEP_US        1000000
+
+static RTC_DATA_ATTR uint32_t s_skip_reinit_cal;
+static RTC_DATA_ATTR struct timeval s_skip_reinit_sleep_start;
+static RTC_DATA_ATTR int s_skip_reinit_wakeups;
+
+static void skip_reinit_deep_sleep(void)
+{
+    s_skip_reinit_cal = esp_clk_slowclk_cal_get();
+    gettimeofday(&s_skip_reinit_sleep_start, NULL);
+    esp_sleep_enable_timer_wakeup(SKIP_REINIT_SLEEP_US);
+    esp_deep_sleep_start();
+}
+
+static void check_rtc_time_after_skipped_reinit(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    TEST_ASSERT_EQUAL(ESP_RST_DEEPSLEEP, esp_reset_reason());
+
+    // The slow clock wasn't calibrated again, and the retained calibration still matches the clock
+    TEST_ASSERT_EQUAL_UINT32(s_skip_reinit_cal, esp_clk_slowclk_cal_get());
+    uint32_t cal = rtc_clk_cal(RTC_CAL_RTC_MUX, 1024);
+    TEST_ASSERT_UINT32_WITHIN(s_skip_reinit_cal / 50, s_skip_reinit_cal, cal);
+
+    // The time of day went on during the sleep, and the startup
+    int64_t slept_us = (int64_t)(now.tv_sec - s_skip_reinit_sleep_start.tv_sec) * 1000000 +
+                       (now.tv_usec - s_skip_reinit_sleep_start.tv_usec);
+    printf("wakeup %d: slept %" PRId64 " us\n", s_skip_reinit_wakeups + 1, slept_us);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT64(SKIP_REINIT_SLEEP_US, slept_us);
+    TEST_ASSERT_LESS_THAN_INT64(SKIP_REINIT_SLEEP_US + 2000000, slept_us);
+
+    // The RTC time keeps the pace of the main XTAL, within 1%
+    uint64_t rtc_start = esp_clk_rtc_time();
+    int64_t timer_start = esp_timer_get_time();
+    esp_rom_delay_us(200000);
+    int64_t rtc_us = esp_clk_rtc_time() - rtc_start;
+    int64_t timer_us = esp_timer_get_time() - timer_start;
+    TEST_ASSERT_INT64_WITHIN(timer_us / 100, timer_us, rtc_us);
+
+#if CONFIG_SPIRAM
+    // External RAM is usable without the memory test of the first boot
+    uint32_t *ext = heap_caps_malloc(4096, MALLOC_CAP_SPIRAM);
+    TEST_ASSERT_NOT_NULL(ext);
+    for (int i = 0; i < 1024; i++) {
+        ext[i] = 0x5a5a0000 | i;
+    }
+    for (int i = 0; i < 1024; i++) {
+        TEST_ASSERT_EQUAL_HEX32(0x5a5a0000 | i, ext[i]);
+    }
+    free(ext);
+#endif
+}
+
+static void check_rtc_time_and_sleep(void)
+{
+    check_rtc_time_after_skipped_reinit();
+    s_skip_reinit_wakeups++;
+    skip_reinit_deep_sleep();
+}
+
+TEST_CASE_MULTIPLE_STAGES("RTC time stays accurate over deep sleep wakeups without slow clock calibration",
+                          "[deepsleep][reset=DEEPSLEEP_RESET,DEEPSLEEP_RESET,DEEPSLEEP_RESET]",
+                          skip_reinit_deep_sleep,
+                          check_rtc_time_and_sleep,
+                          check_rtc_time_and_sleep,
+                          check_rtc_time_after_skipped_reinit);
+#endif // CONFIG_ESP_SYSTEM_SKIP_REINIT_AFTER_DEEP_SLEEP && SOC_RTC_MEM_SUPPORTED
+
 #endif // SOC_DEEP_SLEEP_SUPPORTED
@@ -235,4 +235,85 @@ TEST_CASE("Task WDT user feed", "[task_wdt]")
     TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_deinit());
 }
 
+TEST_CASE("Task WDT feed requires all users", "[task_wdt]")
+{
+    esp_task_wdt_user_handle_t user_handle_a;
+    esp_task_wdt_user_handle_t user_handle_b;
+    timeout_flag = false;
+    esp_task_wdt_config_t twdt_config = {
+        .timeout_ms = TASK_WDT_TIMEOUT_MS,
+        .idle_core_mask = 0,
+        .trigger_panic = false,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_init(&twdt_config));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_add_user("user_a", &user_handle_a));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_add_user("user_b", &user_handle_b));
+    // Only one of the users resets, many times
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset_user(user_handle_a));
+        esp_rom_delay_us((TASK_WDT_TIMEOUT_MS * 1000) / 8);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset_user(user_handle_a));
+        esp_rom_delay_us((TASK_WDT_TIMEOUT_MS * 1000) / 8);
+    }
+    TEST_ASSERT_EQUAL(true, timeout_flag);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_delete_user(user_handle_b));
+    // A deleted user can't reset anymore
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_task_wdt_reset_user(user_handle_b));
+    timeout_flag = false;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset_user(user_handle_a));
+    esp_rom_delay_us((TASK_WDT_TIMEOUT_MS * 1000) / 2);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset_user(user_handle_a));
+    esp_rom_delay_us((TASK_WDT_TIMEOUT_MS * 1000) / 2);
+    TEST_ASSERT_EQUAL(false, timeout_flag);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_delete_user(user_handle_a));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_deinit());
+}
+
+#define TEST_TWDT_USERS    40  // More users than reset mask bits
+
+TEST_CASE("Task WDT subscribes more than 32 tasks and users", "[task_wdt]")
+{
+    esp_task_wdt_user_handle_t user_handles[TEST_TWDT_USERS];
+    timeout_flag = false;
+    esp_task_wdt_config_t twdt_config = {
+        .timeout_ms = TASK_WDT_TIMEOUT_MS,
+        .idle_core_mask = 0,
+        .trigger_panic = false,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_init(&twdt_config));
+    for (int i = 0; i < TEST_TWDT_USERS; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_add_user("test_user", &user_handles[i]));
+    }
+    // The task is subscribed beyond the reset mask bits
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_add(NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_status(NULL));
+    // The timer is only fed once every entry has reset, whatever the order
+    for (int round = 0; round < 3; round++) {
+        esp_rom_delay_us((TASK_WDT_TIMEOUT_MS * 1000) / 2);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset());
+        for (int i = 0; i < TEST_TWDT_USERS; i++) {
+            const int user = (round % 2) ? TEST_TWDT_USERS - 1 - i : i;
+            TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset_user(user_handles[user]));
+        }
+    }
+    esp_rom_delay_us((TASK_WDT_TIMEOUT_MS * 1000) / 2);
+    TEST_ASSERT_EQUAL(false, timeout_flag);
+    // A single entry without a bit which doesn't reset triggers the timeout
+    for (int i = 0; i < TEST_TWDT_USERS - 1; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset_user(user_handles[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_reset());
+    esp_rom_delay_us(TASK_WDT_TIMEOUT_MS * 1000);
+    TEST_ASSERT_EQUAL(true, timeout_flag);
+    // A freed slot can be reused
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_delete_user(user_handles[0]));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_add_user("test_user", &user_handles[0]));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_delete(NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_task_wdt_status(NULL));
+    for (int i = 0; i < TEST_TWDT_USERS; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_delete_user(user_handles[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_wdt_deinit());
+}
+
 #endif // CONFIG_ESP_TASK_WDT_EN
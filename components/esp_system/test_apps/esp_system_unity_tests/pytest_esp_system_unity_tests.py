@@ -20,6 +20,18 @@ def test_esp_system(dut: Dut) -> None:
     dut.run_all_single_board_cases(timeout=60)
 
 
+@pytest.mark.generic
+@pytest.mark.parametrize(
+    'config',
+    [
+        pytest.param('skip_reinit_deep_sleep', marks=[pytest.mark.supported_targets]),
+        pytest.param('psram_skip_reinit_deep_sleep', marks=[pytest.mark.esp32, pytest.mark.esp32s2, pytest.mark.esp32s3]),
+    ]
+)
+def test_esp_system_skip_reinit_deep_sleep(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='deepsleep', timeout=60)
+
+
 @pytest.mark.generic
 @pytest.mark.parametrize(
     'config',
@@ -76,6 +76,10 @@ typedef struct {
     //                                !< `CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD`
     const char* name;               //!< Timer name, used in esp_timer_dump() function
     bool skip_unhandled_events;     //!< Setting to skip unhandled events in light sleep for periodic timers
+    uint32_t slack_us;              //!< Time in microseconds by which the callback may be dispatched later than
+    //                                !< the timer expires; lets esp_timer dispatch the callbacks of timers expiring
+    //                                !< close to each other with a single alarm. 0 dispatches the callback as soon as
+    //                                !< possible. Should be smaller than the period of periodic timers.
 } esp_timer_create_args_t;
 
 /**
@@ -5,6 +5,7 @@
  */
 
 #include <sys/param.h>
+#include <stdlib.h>
 #include <string.h>
 #include "soc/soc.h"
 #include "esp_types.h"
@@ -49,6 +50,7 @@ struct esp_timer {
         uint32_t event_id;
     };
     void* arg;
+    uint32_t slack;                 // the callback may be dispatched up to this many microseconds after the alarm
 #if WITH_PROFILING
     const char* name;
     size_t times_triggered;
@@ -56,6 +58,12 @@ struct esp_timer {
     size_t times_skipped;
     uint64_t total_callback_run_time;
 #endif // WITH_PROFILING
+#if CONFIG_ESP_TIMER_ARMED_TIMERS_PAIRING_HEAP
+    struct esp_timer* heap_child;   // first child of the timer in the heap of armed timers
+    struct esp_timer* heap_next;    // next sibling
+    struct esp_timer* heap_prev;    // previous sibling, or the parent if this is the first child
+    uint32_t heap_seq;              // arming order, timers with equal alarms are triggered in this order
+#endif
     LIST_ENTRY(esp_timer) list_entry;
 };
 
@@ -63,6 +71,10 @@ static inline bool is_initialized(void);
 static esp_err_t timer_insert(esp_timer_handle_t timer, bool without_update_alarm);
 static esp_err_t timer_remove(esp_timer_handle_t timer);
 static bool timer_armed(esp_timer_handle_t timer);
+static esp_timer_handle_t timer_list_first(esp_timer_dispatch_t dispatch_method);
+static esp_timer_handle_t timer_list_next(esp_timer_handle_t timer);
+static esp_timer_handle_t timer_list_skip(esp_timer_handle_t timer);
+static uint64_t timer_list_deadline(esp_timer_dispatch_t dispatch_method, flags_t ignored_flags);
 static void timer_list_lock(esp_timer_dispatch_t timer_type);
 static void timer_list_unlock(esp_timer_dispatch_t timer_type);
 
@@ -73,10 +85,18 @@ static void timer_remove_inactive(esp_timer_handle_t timer);
 
 __attribute__((unused)) static const char* TAG = "esp_timer";
 
+#if CONFIG_ESP_TIMER_ARMED_TIMERS_PAIRING_HEAP
+// pairing heaps of currently armed timers for two dispatch methods: ISR and TASK,
+// the root of each heap is the timer with the earliest alarm
+static esp_timer_handle_t s_timers[ESP_TIMER_MAX];
+// arming order of the timers in each heap
+static uint32_t s_timer_seq[ESP_TIMER_MAX];
+#else
 // lists of currently armed timers for two dispatch methods: ISR and TASK
 static LIST_HEAD(esp_timer_list, esp_timer) s_timers[ESP_TIMER_MAX] = {
     [0 ...(ESP_TIMER_MAX - 1)] = LIST_HEAD_INITIALIZER(s_timers)
 };
+#endif
 #if WITH_PROFILING
 // lists of unarmed timers for two dispatch methods: ISR and TASK,
 // used only to be able to dump statistics about all the timers
@@ -113,6 +133,7 @@ esp_err_t esp_timer_create(const esp_timer_create_args_t* args,
     }
     result->callback = args->callback;
     result->arg = args->arg;
+    result->slack = args->slack_us;
     result->flags = (args->dispatch_method ? FL_ISR_DISPATCH_METHOD : 0) |
                     (args->skip_unhandled_events ? FL_SKIP_UNHANDLED_EVENTS : 0);
 #if WITH_PROFILING
@@ -283,6 +304,7 @@ esp_err_t esp_timer_delete(esp_timer_handle_t timer)
         // We do this because we want to free memory of the timer in a task context instead of an isr context.
         timer->flags &= ~FL_ISR_DISPATCH_METHOD;
         timer->event_id = EVENT_ID_DELETE_TIMER;
+        timer->slack = 0;
         timer->alarm = alarm;
         timer->period = 0;
         err = timer_insert(timer, false);
@@ -291,13 +313,133 @@ esp_err_t esp_timer_delete(esp_timer_handle_t timer)
     return err;
 }
 
-static IRAM_ATTR esp_err_t timer_insert(esp_timer_handle_t timer, bool without_update_alarm)
+#if CONFIG_ESP_TIMER_ARMED_TIMERS_PAIRING_HEAP
+
+/*
+ * Armed timers are kept in a pairing heap: a tree where every timer triggers no earlier than its parent.
+ * The children of a timer are linked through heap_next, heap_prev points to the previous sibling or, for
+ * the first child, to the parent. Arming a timer is a single comparison with the root, removing a timer
+ * merges its children pairwise, which takes O(log n) amortized time.
+ */
+
+static IRAM_ATTR bool timer_heap_before(esp_timer_handle_t a, esp_timer_handle_t b)
+{
+    return a->alarm < b->alarm || (a->alarm == b->alarm && (int32_t)(a->heap_seq - b->heap_seq) < 0);
+}
+
+/* Join two heaps, a and b must be roots without siblings. Returns the new root. */
+static IRAM_ATTR esp_timer_handle_t timer_heap_meld(esp_timer_handle_t a, esp_timer_handle_t b)
+{
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+    if (timer_heap_before(b, a)) {
+        esp_timer_handle_t tmp = a;
+        a = b;
+        b = tmp;
+    }
+    // b becomes the first child of a
+    b->heap_prev = a;
+    b->heap_next = a->heap_child;
+    if (a->heap_child) {
+        a->heap_child->heap_prev = b;
+    }
+    a->heap_child = b;
+    return a;
+}
+
+/* Join the heaps of a list of siblings into one heap. Returns its root. */
+static IRAM_ATTR esp_timer_handle_t timer_heap_merge_pairs(esp_timer_handle_t first)
+{
+    // First pass: join the siblings in pairs from left to right, collecting the results in reverse order
+    esp_timer_handle_t pairs = NULL;
+    while (first) {
+        esp_timer_handle_t a = first;
+        esp_timer_handle_t b = a->heap_next;
+        first = b ? b->heap_next : NULL;
+        a->heap_next = a->heap_prev = NULL;
+        if (b) {
+            b->heap_next = b->heap_prev = NULL;
+        }
+        esp_timer_handle_t pair = timer_heap_meld(a, b);
+        pair->heap_next = pairs;
+        pairs = pair;
+    }
+    // Second pass: join the pairs from right to left
+    esp_timer_handle_t root = NULL;
+    while (pairs) {
+        esp_timer_handle_t next = pairs->heap_next;
+        pairs->heap_next = NULL;
+        root = timer_heap_meld(pairs, root);
+        pairs = next;
+    }
+    return root;
+}
+
+static IRAM_ATTR void timer_list_add(esp_timer_handle_t timer, esp_timer_dispatch_t dispatch_method)
+{
+    timer->heap_child = timer->heap_next = timer->heap_prev = NULL;
+    timer->heap_seq = s_timer_seq[dispatch_method]++;
+    s_timers[dispatch_method] = timer_heap_meld(s_timers[dispatch_method], timer);
+}
+
+static IRAM_ATTR void timer_list_del(esp_timer_handle_t timer, esp_timer_dispatch_t dispatch_method)
+{
+    if (timer == s_timers[dispatch_method]) {
+        s_timers[dispatch_method] = timer_heap_merge_pairs(timer->heap_child);
+    } else {
+        // cut the subtree of the timer out of the heap
+        if (timer->heap_prev->heap_child == timer) {
+            timer->heap_prev->heap_child = timer->heap_next;
+        } else {
+            timer->heap_prev->heap_next = timer->heap_next;
+        }
+        if (timer->heap_next) {
+            timer->heap_next->heap_prev = timer->heap_prev;
+        }
+        s_timers[dispatch_method] = timer_heap_meld(s_timers[dispatch_method], timer_heap_merge_pairs(timer->heap_child));
+    }
+    timer->heap_child = timer->heap_next = timer->heap_prev = NULL;
+}
+
+static IRAM_ATTR esp_timer_handle_t timer_list_first(esp_timer_dispatch_t dispatch_method)
+{
+    return s_timers[dispatch_method];
+}
+
+/* Next timer of a pre-order walk of the heap, the walk doesn't visit the timers in alarm order */
+static IRAM_ATTR esp_timer_handle_t timer_list_next(esp_timer_handle_t timer)
+{
+    if (timer->heap_child) {
+        return timer->heap_child;
+    }
+    return timer_list_skip(timer);
+}
+
+/* Next timer of the walk which is not in the subtree of the timer, i.e. which may trigger before it */
+static IRAM_ATTR esp_timer_handle_t timer_list_skip(esp_timer_handle_t timer)
+{
+    while (timer) {
+        if (timer->heap_next) {
+            return timer->heap_next;
+        }
+        // go back to the first sibling, its heap_prev is the parent (or NULL for the root)
+        while (timer->heap_prev && timer->heap_prev->heap_child != timer) {
+            timer = timer->heap_prev;
+        }
+        timer = timer->heap_prev;
+    }
+    return NULL;
+}
+
+#else // CONFIG_ESP_TIMER_ARMED_TIMERS_PAIRING_HEAP
+
+static IRAM_ATTR void timer_list_add(esp_timer_handle_t timer, esp_timer_dispatch_t dispatch_method)
 {
-#if WITH_PROFILING
-    timer_remove_inactive(timer);
-#endif
     esp_timer_handle_t it, last = NULL;
-    esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
     if (LIST_FIRST(&s_timers[dispatch_method]) == NULL) {
         LIST_INSERT_HEAD(&s_timers[dispatch_method], timer, list_entry);
     } else {
@@ -313,8 +455,68 @@ static IRAM_ATTR esp_err_t timer_insert(esp_timer_handle_t timer, bool without_u
             LIST_INSERT_AFTER(last, timer, list_entry);
         }
     }
-    if (without_update_alarm == false && timer == LIST_FIRST(&s_timers[dispatch_method])) {
-        esp_timer_impl_set_alarm_id(timer->alarm, dispatch_method);
+}
+
+static IRAM_ATTR void timer_list_del(esp_timer_handle_t timer, esp_timer_dispatch_t dispatch_method)
+{
+    LIST_REMOVE(timer, list_entry);
+}
+
+static IRAM_ATTR esp_timer_handle_t timer_list_first(esp_timer_dispatch_t dispatch_method)
+{
+    return LIST_FIRST(&s_timers[dispatch_method]);
+}
+
+static IRAM_ATTR esp_timer_handle_t timer_list_next(esp_timer_handle_t timer)
+{
+    return LIST_NEXT(timer, list_entry);
+}
+
+/* The list is sorted, all timers following the timer trigger no earlier than it */
+static IRAM_ATTR esp_timer_handle_t timer_list_skip(esp_timer_handle_t timer)
+{
+    return NULL;
+}
+
+#endif // CONFIG_ESP_TIMER_ARMED_TIMERS_PAIRING_HEAP
+
+/*
+ * Latest time at which the alarm may be triggered, such that no timer is dispatched later than allowed by its slack.
+ * All timers expired by then are dispatched together. Timers with any of ignored_flags set are not considered.
+ */
+static IRAM_ATTR uint64_t timer_list_deadline(esp_timer_dispatch_t dispatch_method, flags_t ignored_flags)
+{
+    uint64_t deadline = UINT64_MAX;
+    esp_timer_handle_t it = timer_list_first(dispatch_method);
+    while (it) {
+        if (it->alarm > deadline) {
+            // neither this timer nor the timers triggering after it can move the deadline
+            it = timer_list_skip(it);
+            continue;
+        }
+        if ((it->flags & ignored_flags) == 0) {
+            deadline = MIN(deadline, it->alarm + it->slack);
+        }
+        it = timer_list_next(it);
+    }
+    return deadline;
+}
+
+/* Whether arming or disarming the timer may change the deadline of the timers which are armed besides it */
+static IRAM_ATTR bool timer_affects_deadline(esp_timer_handle_t timer, esp_timer_handle_t first_timer)
+{
+    return timer == first_timer || timer->alarm <= first_timer->alarm + first_timer->slack;
+}
+
+static IRAM_ATTR esp_err_t timer_insert(esp_timer_handle_t timer, bool without_update_alarm)
+{
+#if WITH_PROFILING
+    timer_remove_inactive(timer);
+#endif
+    esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
+    timer_list_add(timer, dispatch_method);
+    if (without_update_alarm == false && timer_affects_deadline(timer, timer_list_first(dispatch_method))) {
+        esp_timer_impl_set_alarm_id(timer_list_deadline(dispatch_method, 0), dispatch_method);
     }
     return ESP_OK;
 }
@@ -323,17 +525,13 @@ static IRAM_ATTR esp_err_t timer_remove(esp_timer_handle_t timer)
 {
     esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
     timer_list_lock(dispatch_method);
-    esp_timer_handle_t first_timer = LIST_FIRST(&s_timers[dispatch_method]);
-    LIST_REMOVE(timer, list_entry);
+    bool update_alarm = timer_affects_deadline(timer, timer_list_first(dispatch_method));
+    timer_list_del(timer, dispatch_method);
     timer->alarm = 0;
     timer->period = 0;
-    if (timer == first_timer) { // if this timer was the first in the list.
-        uint64_t next_timestamp = UINT64_MAX;
-        first_timer = LIST_FIRST(&s_timers[dispatch_method]);
-        if (first_timer) { // if after removing the timer from the list, this list is not empty.
-            next_timestamp = first_timer->alarm;
-        }
-        esp_timer_impl_set_alarm_id(next_timestamp, dispatch_method);
+    if (update_alarm) {
+        // UINT64_MAX if the list is empty now
+        esp_timer_impl_set_alarm_id(timer_list_deadline(dispatch_method, 0), dispatch_method);
     }
 #if WITH_PROFILING
     timer_insert_inactive(timer);
@@ -393,7 +591,7 @@ static bool timer_process_alarm(esp_timer_dispatch_t dispatch_method)
     bool processed = false;
     esp_timer_handle_t it;
     while (1) {
-        it = LIST_FIRST(&s_timers[dispatch_method]);
+        it = timer_list_first(dispatch_method);
         int64_t now = esp_timer_impl_get_time();
         ESP_COMPILER_DIAGNOSTIC_PUSH_IGNORE("-Wanalyzer-use-after-free") // False-positive detection. TODO GCC-366
         if (it == NULL || it->alarm > now) {
@@ -401,7 +599,7 @@ static bool timer_process_alarm(esp_timer_dispatch_t dispatch_method)
         }
         ESP_COMPILER_DIAGNOSTIC_POP("-Wanalyzer-use-after-free")
         processed = true;
-        LIST_REMOVE(it, list_entry);
+        timer_list_del(it, dispatch_method);
         if (it->event_id == EVENT_ID_DELETE_TIMER) {
             // It is handled only by ESP_TIMER_TASK (see esp_timer_delete()).
             // All the ESP_TIMER_ISR timers which should be deleted are moved by esp_timer_delete() to the ESP_TIMER_TASK list.
@@ -442,7 +640,7 @@ static bool timer_process_alarm(esp_timer_dispatch_t dispatch_method)
     } // while(1)
     if (it) {
         if (dispatch_method == ESP_TIMER_TASK || (dispatch_method != ESP_TIMER_TASK && processed == true)) {
-            esp_timer_impl_set_alarm_id(it->alarm, dispatch_method);
+            esp_timer_impl_set_alarm_id(timer_list_deadline(dispatch_method, 0), dispatch_method);
         }
     } else {
         if (processed) {
@@ -575,7 +773,7 @@ esp_err_t esp_timer_deinit(void)
 
     /* Check if there are any active timers */
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
-        if (!LIST_EMPTY(&s_timers[dispatch_method])) {
+        if (timer_list_first(dispatch_method) != NULL) {
             return ESP_ERR_INVALID_STATE;
         }
     }
@@ -619,6 +817,18 @@ static void print_timer_info(esp_timer_handle_t t, char** dst, size_t* dst_size)
     *dst_size -= cb;
 }
 
+#if CONFIG_ESP_TIMER_ARMED_TIMERS_PAIRING_HEAP
+static int timer_dump_compare(const void* a, const void* b)
+{
+    esp_timer_handle_t timer_a = *(const esp_timer_handle_t*) a;
+    esp_timer_handle_t timer_b = *(const esp_timer_handle_t*) b;
+    if (timer_heap_before(timer_a, timer_b)) {
+        return -1;
+    }
+    return timer_heap_before(timer_b, timer_a) ? 1 : 0;
+}
+#endif
+
 esp_err_t esp_timer_dump(FILE* stream)
 {
     /* Since timer lock is a critical section, we don't want to print directly
@@ -633,7 +843,7 @@ esp_err_t esp_timer_dump(FILE* stream)
     size_t timer_count = 0;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
-        LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
+        for (it = timer_list_first(dispatch_method); it != NULL; it = timer_list_next(it)) {
             ++timer_count;
         }
 #if WITH_PROFILING
@@ -655,13 +865,34 @@ esp_err_t esp_timer_dump(FILE* stream)
         return ESP_ERR_NO_MEM;
     }
 
+#if CONFIG_ESP_TIMER_ARMED_TIMERS_PAIRING_HEAP
+    /* The heap is not walked in alarm order, the armed timers are sorted before printing them */
+    size_t armed_size = timer_count + 3;
+    esp_timer_handle_t* armed = calloc(armed_size, sizeof(esp_timer_handle_t));
+    if (armed == NULL) {
+        free(print_buf);
+        return ESP_ERR_NO_MEM;
+    }
+#endif
+
     /* Print to the buffer */
     char* pos = print_buf;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
+#if CONFIG_ESP_TIMER_ARMED_TIMERS_PAIRING_HEAP
+        size_t armed_count = 0;
+        for (it = timer_list_first(dispatch_method); it != NULL && armed_count < armed_size; it = timer_list_next(it)) {
+            armed[armed_count++] = it;
+        }
+        qsort(armed, armed_count, sizeof(armed[0]), timer_dump_compare);
+        for (size_t i = 0; i < armed_count; ++i) {
+            print_timer_info(armed[i], &pos, &buf_size);
+        }
+#else
         LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
             print_timer_info(it, &pos, &buf_size);
         }
+#endif
 #if WITH_PROFILING
         LIST_FOREACH(it, &s_inactive_timers[dispatch_method], list_entry) {
             print_timer_info(it, &pos, &buf_size);
@@ -683,6 +914,9 @@ esp_err_t esp_timer_dump(FILE* stream)
         fputs(print_buf, stream);
     }
 
+#if CONFIG_ESP_TIMER_ARMED_TIMERS_PAIRING_HEAP
+    free(armed);
+#endif
     free(print_buf);
     return ESP_OK;
 }
@@ -692,7 +926,7 @@ int64_t IRAM_ATTR esp_timer_get_next_alarm(void)
     int64_t next_alarm = INT64_MAX;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
-        esp_timer_handle_t it = LIST_FIRST(&s_timers[dispatch_method]);
+        esp_timer_handle_t it = timer_list_first(dispatch_method);
         if (it) {
             if (next_alarm > it->alarm) {
                 next_alarm = it->alarm;
@@ -708,15 +942,11 @@ int64_t IRAM_ATTR esp_timer_get_next_alarm_for_wake_up(void)
     int64_t next_alarm = INT64_MAX;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
-        esp_timer_handle_t it = NULL;
-        LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
-            // timers with the SKIP_UNHANDLED_EVENTS flag do not want to wake up CPU from a sleep mode.
-            if ((it->flags & FL_SKIP_UNHANDLED_EVENTS) == 0) {
-                if (next_alarm > it->alarm) {
-                    next_alarm = it->alarm;
-                }
-                break;
-            }
+        // timers with the SKIP_UNHANDLED_EVENTS flag do not want to wake up CPU from a sleep mode,
+        // the others may let the CPU sleep until their slack has elapsed.
+        uint64_t deadline = timer_list_deadline(dispatch_method, FL_SKIP_UNHANDLED_EVENTS);
+        if (deadline != UINT64_MAX && next_alarm > (int64_t) deadline) {
+            next_alarm = deadline;
         }
         timer_list_unlock(dispatch_method);
     }
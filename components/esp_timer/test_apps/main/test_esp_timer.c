@@ -346,6 +346,146 @@ TEST_CASE("multiple timers are ordered correctly", "[esp_timer]")
 }
 #undef N
 
+#define N_MANY 200
+
+typedef struct {
+    esp_timer_handle_t timer;
+    uint64_t alarm;
+    int index;
+    bool stopped;
+} test_many_timers_args_t;
+
+typedef struct {
+    uint64_t last_alarm;
+    int last_index;
+    int count;
+    bool pass;
+} test_many_timers_common_t;
+
+static test_many_timers_common_t s_many_timers_common;
+
+static void test_many_timers_func(void* arg)
+{
+    test_many_timers_args_t* p = (test_many_timers_args_t*) arg;
+    test_many_timers_common_t* common = &s_many_timers_common;
+    // timers must expire in order of their alarms, timers with equal alarms in order of starting them
+    if (p->stopped || p->alarm < common->last_alarm ||
+            (p->alarm == common->last_alarm && p->index < common->last_index)) {
+        common->pass = false;
+    }
+    common->last_alarm = p->alarm;
+    common->last_index = p->index;
+    common->count++;
+}
+
+TEST_CASE("many timers started and stopped in random order expire in order", "[esp_timer]")
+{
+    test_many_timers_args_t* args = calloc(N_MANY, sizeof(test_many_timers_args_t));
+    TEST_ASSERT_NOT_NULL(args);
+    s_many_timers_common = (test_many_timers_common_t) {
+        .pass = true
+    };
+
+    esp_timer_create_args_t create_args = {
+        .callback = &test_many_timers_func,
+        .name = "many"
+    };
+    for (int i = 0; i < N_MANY; ++i) {
+        args[i].index = i;
+        create_args.arg = &args[i];
+        TEST_ESP_OK(esp_timer_create(&create_args, &args[i].timer));
+    }
+
+    // start the timers with few distinct timeouts, so that many of them have alarms close to each other
+    for (int i = 0; i < N_MANY; ++i) {
+        TEST_ESP_OK(esp_timer_start_once(args[i].timer, 100000 + (rand() % 8) * 10000));
+        TEST_ESP_OK(esp_timer_get_expiry_time(args[i].timer, &args[i].alarm));
+    }
+
+    // stop some of the timers in random order, and restart some of those
+    int expected = N_MANY;
+    for (int i = 0; i < N_MANY / 2; ++i) {
+        test_many_timers_args_t* p = &args[rand() % N_MANY];
+        if (!p->stopped) {
+            TEST_ESP_OK(esp_timer_stop(p->timer));
+            p->stopped = true;
+            expected--;
+        }
+    }
+    for (int i = 0; i < N_MANY; i += 4) {
+        if (args[i].stopped) {
+            TEST_ESP_OK(esp_timer_start_once(args[i].timer, 50000));
+            TEST_ESP_OK(esp_timer_get_expiry_time(args[i].timer, &args[i].alarm));
+            // the restarted timers are started last, but expire before the others
+            args[i].index += N_MANY;
+            args[i].stopped = false;
+            expected++;
+        }
+    }
+
+    vTaskDelay(300 / portTICK_PERIOD_MS);
+
+    TEST_ASSERT_EQUAL(expected, s_many_timers_common.count);
+    TEST_ASSERT_TRUE(s_many_timers_common.pass);
+
+    for (int i = 0; i < N_MANY; ++i) {
+        TEST_ESP_OK(esp_timer_delete(args[i].timer));
+    }
+    free(args);
+}
+#undef N_MANY
+
+static void test_slack_timer_func(void* arg)
+{
+    *(int64_t*) arg = esp_timer_get_time();
+}
+
+TEST_CASE("timers expiring within the slack of each other are dispatched together", "[esp_timer]")
+{
+    int64_t t_early = 0;
+    int64_t t_late = 0;
+    esp_timer_handle_t timer_early;
+    esp_timer_handle_t timer_late;
+    esp_timer_create_args_t create_args = {
+        .callback = &test_slack_timer_func,
+        .arg = &t_early,
+        .name = "early",
+        .slack_us = 20000
+    };
+    TEST_ESP_OK(esp_timer_create(&create_args, &timer_early));
+    create_args.arg = &t_late;
+    create_args.name = "late";
+    create_args.slack_us = 0;
+    TEST_ESP_OK(esp_timer_create(&create_args, &timer_late));
+
+    // the late timer expires within the slack of the early one, both are dispatched by the alarm of the late timer
+    int64_t t_start = esp_timer_get_time();
+    TEST_ESP_OK(esp_timer_start_once(timer_early, 20000));
+    TEST_ESP_OK(esp_timer_start_once(timer_late, 30000));
+    vTaskDelay(100 / portTICK_PERIOD_MS);
+    printf("early: %lld us, late: %lld us\n", t_early - t_start, t_late - t_start);
+    TEST_ASSERT_GREATER_OR_EQUAL(30000, t_early - t_start);
+    TEST_ASSERT_GREATER_OR_EQUAL(30000, t_late - t_start);
+    TEST_ASSERT_INT_WITHIN(1000, t_late, t_early);
+
+    // the late timer expires after the slack of the early one, the early one is dispatched when its slack elapses
+    TEST_ESP_OK(esp_timer_delete(timer_early));
+    create_args.arg = &t_early;
+    create_args.name = "early";
+    create_args.slack_us = 5000;
+    TEST_ESP_OK(esp_timer_create(&create_args, &timer_early));
+    t_start = esp_timer_get_time();
+    TEST_ESP_OK(esp_timer_start_once(timer_early, 20000));
+    TEST_ESP_OK(esp_timer_start_once(timer_late, 30000));
+    vTaskDelay(100 / portTICK_PERIOD_MS);
+    printf("early: %lld us, late: %lld us\n", t_early - t_start, t_late - t_start);
+    TEST_ASSERT_INT_WITHIN(3000, 23500, t_early - t_start);
+    TEST_ASSERT_GREATER_OR_EQUAL(30000, t_late - t_start);
+
+    TEST_ESP_OK(esp_timer_delete(timer_early));
+    TEST_ESP_OK(esp_timer_delete(timer_late));
+}
+
 static void test_short_intervals_timer_func(void* arg)
 {
     SemaphoreHandle_t done = (SemaphoreHandle_t) arg;
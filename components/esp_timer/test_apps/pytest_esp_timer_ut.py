@@ -6,6 +6,7 @@ from pytest_embedded import Dut
 CONFIGS = [
     pytest.param('general', marks=[pytest.mark.supported_targets]),
     pytest.param('release', marks=[pytest.mark.supported_targets]),
+    pytest.param('pairing_heap', marks=[pytest.mark.supported_targets]),
     pytest.param('single_core', marks=[pytest.mark.esp32]),
     pytest.param('freertos_compliance', marks=[pytest.mark.esp32]),
     pytest.param('isr_dispatch_esp32', marks=[pytest.mark.esp32]),
@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_now.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup ESPNOW_APIs
+  * @{
+  */
+
+/**
+ * @brief One frame of a batch
+ */
+typedef struct {
+    const uint8_t *peer_addr;   /*!< MAC address of the peer, which must be in the peer list. Can't be NULL, use the broadcast address to broadcast */
+    const uint8_t *data;        /*!< Data of the frame. Frames which follow each other with the same data and len share one copy of the data */
+    size_t len;                 /*!< Length of the data, at most ESP_NOW_MAX_DATA_LEN_V2 */
+} esp_now_batch_frame_t;
+
+/**
+ * @brief Outcome of a batch, reported once all its frames are sent
+ */
+typedef struct {
+    uint32_t batch_id;          /*!< Identifier returned by esp_now_batch_send */
+    size_t frame_count;         /*!< Number of frames in the batch */
+    size_t success_count;       /*!< Number of frames reported with ESP_NOW_SEND_SUCCESS */
+    size_t fail_count;          /*!< Number of frames reported with ESP_NOW_SEND_FAIL or rejected by esp_now_send */
+} esp_now_batch_result_t;
+
+/**
+ * @brief Callback reporting completed batches
+ *
+ * @note The callback runs from the batch task. Frames queued from it are sent once it returns.
+ *
+ * @param result    Outcome of the batch
+ * @param user_ctx  User context given in esp_now_batch_config_t
+ */
+typedef void (*esp_now_batch_done_cb_t)(const esp_now_batch_result_t *result, void *user_ctx);
+
+/**
+ * @brief Configuration of batched sending
+ */
+typedef struct {
+    size_t queue_depth;                 /*!< Number of frames which can wait in the queue of each peer */
+    size_t max_in_flight;               /*!< Number of frames passed to esp_now_send whose send callback hasn't been called yet */
+    int task_priority;                  /*!< Priority of the batch task */
+    size_t task_stack_size;             /*!< Stack size of the batch task, in bytes */
+    int task_core_id;                   /*!< Core to which the batch task is pinned, or -1 for no affinity */
+    esp_now_batch_done_cb_t done_cb;    /*!< Callback reporting completed batches, can be NULL */
+    void *user_ctx;                     /*!< User context passed to done_cb */
+} esp_now_batch_config_t;
+
+/**
+ * @brief Default configuration of batched sending
+ */
+#define ESP_NOW_BATCH_CONFIG_DEFAULT() { \
+    .queue_depth = 8, \
+    .max_in_flight = 4, \
+    .task_priority = 5, \
+    .task_stack_size = 3072, \
+    .task_core_id = -1, \
+    .done_cb = NULL, \
+    .user_ctx = NULL, \
+}
+
+/**
+ * @brief Statistics of the frames sent to one peer by batches
+ */
+typedef struct {
+    uint32_t queued;            /*!< Frames waiting in the queue of the peer */
+    uint32_t success;           /*!< Frames reported with ESP_NOW_SEND_SUCCESS */
+    uint32_t fail;              /*!< Frames reported with ESP_NOW_SEND_FAIL or rejected by esp_now_send */
+} esp_now_batch_peer_stats_t;
+
+/**
+  * @brief     Initialize batched sending
+  *
+  * Creates the batch task which takes the frames from the queues of the peers in turn and keeps up to
+  * config->max_in_flight of them passed to esp_now_send, so that the next frame is sent as soon as the
+  * previous one is reported.
+  *
+  * @attention 1. ESP-NOW must be initialized by esp_now_init first
+  * @attention 2. The send callback of ESP-NOW is registered by this function, so esp_now_register_send_cb
+  *               and esp_now_send must not be used until esp_now_batch_deinit is called
+  *
+  * @param     config  configuration of batched sending
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_INVALID_ARG : config is NULL or invalid
+  *          - ESP_ERR_INVALID_STATE : batched sending is already initialized
+  *          - ESP_ERR_NO_MEM : out of memory
+  *          - others : failed to register the send callback, see esp_now_register_send_cb
+  */
+esp_err_t esp_now_batch_init(const esp_now_batch_config_t *config);
+
+/**
+  * @brief     De-initialize batched sending
+  *
+  * Stops the batch task and unregisters the send callback. The frames still queued are discarded
+  * without being reported.
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_INVALID_STATE : batched sending is not initialized
+  */
+esp_err_t esp_now_batch_deinit(void);
+
+/**
+  * @brief     Queue a batch of frames
+  *
+  * The data of the frames is copied, so the buffers don't need to be valid after the function returns.
+  * Either all frames are queued or none of them. The frames of each peer are sent in order, while the
+  * peers are served in turn. Once all frames of the batch are sent, the outcome is reported by a single
+  * call of the done callback.
+  *
+  * @param     frames    frames to send
+  * @param     count     number of frames
+  * @param[out] batch_id identifier of the batch passed to the done callback, can be NULL
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_ESPNOW_NOT_INIT : batched sending is not initialized
+  *          - ESP_ERR_ESPNOW_ARG : invalid argument
+  *          - ESP_ERR_ESPNOW_NOT_FOUND : a peer is not in the peer list
+  *          - ESP_ERR_ESPNOW_NO_MEM : the queue of a peer is full or out of memory, retry once previous batches are done
+  */
+esp_err_t esp_now_batch_send(const esp_now_batch_frame_t *frames, size_t count, uint32_t *batch_id);
+
+/**
+  * @brief     Get the statistics of the frames sent to a peer by batches
+  *
+  * @param     peer_addr  peer MAC address
+  * @param[out] stats     statistics of the peer, all zero if no batch was sent to it
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_ESPNOW_NOT_INIT : batched sending is not initialized
+  *          - ESP_ERR_ESPNOW_ARG : invalid argument
+  */
+esp_err_t esp_now_batch_get_peer_stats(const uint8_t *peer_addr, esp_now_batch_peer_stats_t *stats);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
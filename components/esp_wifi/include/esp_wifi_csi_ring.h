@@ -0,0 +1,161 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_wifi_types.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup WiFi_APIs
+  * @{
+  */
+
+/**
+ * @brief CSI data of one received frame, stored in the CSI ring
+ */
+typedef struct {
+    wifi_pkt_rx_ctrl_t rx_ctrl; /*!< Received packet radio metadata header of the CSI data */
+    uint8_t mac[6];             /*!< Source MAC address of the CSI data */
+    uint8_t dmac[6];            /*!< Destination MAC address of the CSI data */
+    bool first_word_invalid;    /*!< The first four bytes of the CSI data are invalid due to hardware limitation */
+    uint16_t rx_seq;            /*!< RX sequence number of the Wi-Fi packet */
+    uint16_t len;               /*!< Length of the CSI data */
+    int8_t *buf;                /*!< CSI data, stored in the ring right after this entry */
+} esp_wifi_csi_entry_t;
+
+/**
+ * @brief Configuration of the CSI ring
+ */
+typedef struct {
+    size_t entry_count;         /*!< Number of entries of the ring */
+    size_t max_len;             /*!< Maximum length of the CSI data of an entry. CSI data which is longer is dropped */
+} esp_wifi_csi_ring_config_t;
+
+/**
+ * @brief Default configuration of the CSI ring
+ */
+#define ESP_WIFI_CSI_RING_CONFIG_DEFAULT() { \
+    .entry_count = 32, \
+    .max_len = 384, \
+}
+
+/**
+ * @brief Statistics of the CSI ring
+ */
+typedef struct {
+    uint32_t received;          /*!< Number of entries stored in the ring */
+    uint32_t dropped_full;      /*!< Number of CSI data dropped because the ring was full */
+    uint32_t dropped_oversized; /*!< Number of CSI data dropped because they were longer than max_len */
+    uint32_t max_used;          /*!< Largest number of entries in the ring, received but not released yet */
+} esp_wifi_csi_ring_stats_t;
+
+/**
+  * @brief     Initialize the CSI ring
+  *
+  * Allocates the ring and registers its own CSI receiving callback, which copies the CSI data of each frame to the
+  * next free entry, without allocating memory. The entries are taken in batches by esp_wifi_csi_ring_receive and
+  * read in place.
+  *
+  * @attention 1. Wi-Fi must be initialized by esp_wifi_init first
+  * @attention 2. The CSI receiving callback is registered by this function, so esp_wifi_set_csi_rx_cb must not be
+  *               called until esp_wifi_csi_ring_deinit is called
+  *
+  * @param     config  configuration of the CSI ring
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_INVALID_ARG : config is NULL or invalid
+  *          - ESP_ERR_INVALID_STATE : the CSI ring is already initialized
+  *          - ESP_ERR_NO_MEM : out of memory
+  *          - others : failed to register the CSI receiving callback, see esp_wifi_set_csi_rx_cb
+  */
+esp_err_t esp_wifi_csi_ring_init(const esp_wifi_csi_ring_config_t *config);
+
+/**
+  * @brief     De-initialize the CSI ring
+  *
+  * Unregisters the CSI receiving callback and frees the ring. Entries which were received but not released
+  * can't be used anymore.
+  *
+  * @attention CSI should be disabled by esp_wifi_set_csi first, so that the callback isn't running.
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_INVALID_STATE : the CSI ring is not initialized
+  */
+esp_err_t esp_wifi_csi_ring_deinit(void);
+
+/**
+  * @brief     Take a batch of entries from the CSI ring
+  *
+  * Waits until at least one entry is stored in the ring, then returns pointers to up to max_entries of the oldest
+  * entries which haven't been received yet. The entries stay valid, and their slots aren't reused, until they are
+  * given back by esp_wifi_csi_ring_release.
+  *
+  * @attention Only one task may receive from the CSI ring.
+  *
+  * @param     entries       array receiving the pointers to the entries
+  * @param     max_entries   number of elements of entries
+  * @param[out] count        number of entries returned
+  * @param     ticks_to_wait number of ticks to wait for an entry
+  *
+  * @return
+  *          - ESP_OK : succeed, *count is at least 1
+  *          - ESP_ERR_INVALID_ARG : entries or count is NULL, or max_entries is 0
+  *          - ESP_ERR_INVALID_STATE : the CSI ring is not initialized
+  *          - ESP_ERR_TIMEOUT : no entry was stored in the ring within ticks_to_wait
+  */
+esp_err_t esp_wifi_csi_ring_receive(const esp_wifi_csi_entry_t **entries, size_t max_entries, size_t *count,
+                                    TickType_t ticks_to_wait);
+
+/**
+  * @brief     Give the oldest received entries back to the CSI ring
+  *
+  * @param     count  number of entries to give back, in the order they were received
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_INVALID_ARG : count is larger than the number of entries received and not given back yet
+  *          - ESP_ERR_INVALID_STATE : the CSI ring is not initialized
+  */
+esp_err_t esp_wifi_csi_ring_release(size_t count);
+
+/**
+  * @brief     Get the statistics of the CSI ring
+  *
+  * @param[out] stats  statistics of the CSI ring
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_INVALID_ARG : stats is NULL
+  *          - ESP_ERR_INVALID_STATE : the CSI ring is not initialized
+  */
+esp_err_t esp_wifi_csi_ring_get_stats(esp_wifi_csi_ring_stats_t *stats);
+
+/**
+  * @brief     Reset the statistics of the CSI ring
+  *
+  * @return
+  *          - ESP_OK : succeed
+  *          - ESP_ERR_INVALID_STATE : the CSI ring is not initialized
+  */
+esp_err_t esp_wifi_csi_ring_reset_stats(void);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -26,6 +26,22 @@ extern "C" {
  */
 typedef struct wifi_netif_driver* wifi_netif_driver_t;
 
+/**
+ * @brief Statistics of the buffers exchanged between the WiFi driver and the network stack
+ *
+ * Received frames stay in a WiFi RX buffer until the network stack has processed them, so rx_buf_in_use_max compared
+ * to the number of dynamic RX buffers (CONFIG_ESP_WIFI_DYNAMIC_RX_BUFFER_NUM) shows whether the buffers are
+ * exhausted by the application being slower than the network.
+ */
+typedef struct {
+    uint32_t rx_buf_in_use;         /**< Number of RX buffers currently held by the network stack */
+    uint32_t rx_buf_in_use_max;     /**< Maximum number of RX buffers held by the network stack at the same time */
+    uint32_t rx_frames;             /**< Number of frames passed to the network stack */
+    uint32_t rx_dropped;            /**< Number of frames the network stack failed to take */
+    uint32_t tx_frames;             /**< Number of frames queued for transmission */
+    uint32_t tx_no_mem;             /**< Number of frames dropped as there was no free TX buffer */
+} wifi_netif_buffer_stats_t;
+
 /**
  * @brief Creates wifi driver instance to be used with esp-netif
  *
@@ -81,6 +97,29 @@ bool esp_wifi_is_if_ready_when_started(wifi_netif_driver_t ifx);
  */
 esp_err_t esp_wifi_register_if_rxcb(wifi_netif_driver_t ifx, esp_netif_receive_t fn, void * arg);
 
+/**
+ * @brief Get the statistics of the buffers exchanged between the WiFi driver and the network stack
+ *
+ * @note Requires CONFIG_ESP_WIFI_NETIF_BUFFER_STATS
+ *
+ * @param[out] stats Statistics of all WiFi interfaces
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_INVALID_ARG if stats is NULL
+ *  - ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_WIFI_NETIF_BUFFER_STATS is disabled
+ */
+esp_err_t esp_wifi_netif_get_buffer_stats(wifi_netif_buffer_stats_t *stats);
+
+/**
+ * @brief Reset the frame counters and the maximum number of RX buffers in use
+ *
+ * @return
+ *  - ESP_OK on success
+ *  - ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_WIFI_NETIF_BUFFER_STATS is disabled
+ */
+esp_err_t esp_wifi_netif_reset_buffer_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
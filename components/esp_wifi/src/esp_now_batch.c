@@ -0,0 +1,461 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_now.h"
+#include "esp_now_batch.h"
+
+/*
+ * The frames are queued per peer and sent by a task, which takes them from the peers in turn. A frame
+ * stays in an in-flight slot from esp_now_send until its send callback. The callback runs in the Wi-Fi
+ * task, it only posts the status to a queue and wakes up the batch task, which owns all the rest.
+ */
+
+#define BATCH_LOCK()     xSemaphoreTake(s_batch->lock, portMAX_DELAY)
+#define BATCH_UNLOCK()   xSemaphoreGive(s_batch->lock)
+
+typedef struct {
+    uint32_t id;
+    size_t frame_count;
+    size_t remaining;
+    size_t success_count;
+    size_t fail_count;
+    uint8_t data[];             // copies of the data of the frames
+} batch_t;
+
+typedef struct {
+    batch_t *batch;
+    const uint8_t *data;        // points into batch->data
+    size_t len;
+} batch_frame_t;
+
+typedef struct {
+    uint8_t addr[ESP_NOW_ETH_ALEN];
+    bool used;
+    size_t head;
+    size_t count;
+    size_t in_flight;
+    batch_frame_t *frames;      // ring of queue_depth frames
+    esp_now_batch_peer_stats_t stats;
+} batch_peer_t;
+
+typedef struct {
+    batch_frame_t frame;
+    batch_peer_t *peer;
+    uint32_t seq;               // order of the calls of esp_now_send
+    bool used;
+} batch_in_flight_t;
+
+typedef struct {
+    uint8_t addr[ESP_NOW_ETH_ALEN];
+    esp_now_send_status_t status;
+} batch_send_status_t;
+
+typedef struct {
+    esp_now_batch_config_t config;
+    SemaphoreHandle_t lock;
+    QueueHandle_t status_queue;
+    TaskHandle_t task;
+    SemaphoreHandle_t task_done;
+    volatile bool stop;
+    uint32_t next_id;
+    uint32_t next_seq;
+    size_t next_peer;           // round-robin position
+    batch_peer_t peers[ESP_NOW_MAX_TOTAL_PEER_NUM];
+    batch_in_flight_t *in_flight;
+    batch_frame_t *frames;
+} batch_ctx_t;
+
+static const char *TAG = "espnow_batch";
+static batch_ctx_t *s_batch = NULL;
+
+static void batch_send_cb(const uint8_t *mac_addr, esp_now_send_status_t status)
+{
+    batch_ctx_t *ctx = s_batch;
+    batch_send_status_t item = { .status = status };
+
+    if (ctx == NULL || mac_addr == NULL) {
+        return;
+    }
+    memcpy(item.addr, mac_addr, ESP_NOW_ETH_ALEN);
+    // there is never more status than in-flight frames, so the queue doesn't overflow
+    if (xQueueSend(ctx->status_queue, &item, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "send status lost");
+    }
+    xTaskNotifyGive(ctx->task);
+}
+
+static batch_peer_t *find_peer(const uint8_t *addr, bool add)
+{
+    batch_peer_t *free_peer = NULL;
+
+    for (int i = 0; i < ESP_NOW_MAX_TOTAL_PEER_NUM; i++) {
+        batch_peer_t *peer = &s_batch->peers[i];
+        if (peer->used && memcmp(peer->addr, addr, ESP_NOW_ETH_ALEN) == 0) {
+            return peer;
+        }
+        // the entry of a peer which was deleted from the peer list is reused once its queue is empty
+        if (add && free_peer == NULL && (!peer->used || (peer->count == 0 && peer->in_flight == 0 && !esp_now_is_peer_exist(peer->addr)))) {
+            free_peer = peer;
+        }
+    }
+    if (free_peer) {
+        memcpy(free_peer->addr, addr, ESP_NOW_ETH_ALEN);
+        memset(&free_peer->stats, 0, sizeof(free_peer->stats));
+        free_peer->head = 0;
+        free_peer->count = 0;
+        free_peer->in_flight = 0;
+        free_peer->used = true;
+    }
+    return free_peer;
+}
+
+/* Account a frame which is done, returns its batch if it was the last frame of the batch */
+static batch_t *frame_done(batch_peer_t *peer, batch_frame_t *frame, bool success)
+{
+    batch_t *batch = frame->batch;
+
+    if (success) {
+        peer->stats.success++;
+        batch->success_count++;
+    } else {
+        peer->stats.fail++;
+        batch->fail_count++;
+    }
+    return (--batch->remaining == 0) ? batch : NULL;
+}
+
+static void report_batch(batch_t *batch)
+{
+    if (s_batch->config.done_cb) {
+        esp_now_batch_result_t result = {
+            .batch_id = batch->id,
+            .frame_count = batch->frame_count,
+            .success_count = batch->success_count,
+            .fail_count = batch->fail_count,
+        };
+        s_batch->config.done_cb(&result, s_batch->config.user_ctx);
+    }
+    free(batch);
+}
+
+static void handle_send_status(const batch_send_status_t *item)
+{
+    batch_in_flight_t *oldest = NULL;
+    batch_t *done = NULL;
+
+    BATCH_LOCK();
+    // the callbacks of the frames sent to one peer come in order
+    for (size_t i = 0; i < s_batch->config.max_in_flight; i++) {
+        batch_in_flight_t *slot = &s_batch->in_flight[i];
+        if (slot->used && memcmp(slot->peer->addr, item->addr, ESP_NOW_ETH_ALEN) == 0 &&
+                (oldest == NULL || (int32_t)(slot->seq - oldest->seq) < 0)) {
+            oldest = slot;
+        }
+    }
+    if (oldest) {
+        oldest->used = false;
+        oldest->peer->in_flight--;
+        done = frame_done(oldest->peer, &oldest->frame, item->status == ESP_NOW_SEND_SUCCESS);
+    } else {
+        ESP_LOGD(TAG, "send status of an unknown frame");
+    }
+    BATCH_UNLOCK();
+
+    if (done) {
+        report_batch(done);
+    }
+}
+
+/* Pass queued frames to esp_now_send until the in-flight slots are used, returns true if ESP-NOW is out of buffers */
+static bool dispatch_frames(void)
+{
+    bool stalled = false;
+    batch_t *done = NULL;
+
+    do {
+        done = NULL;
+        BATCH_LOCK();
+        batch_in_flight_t *slot = NULL;
+        for (size_t i = 0; i < s_batch->config.max_in_flight; i++) {
+            if (!s_batch->in_flight[i].used) {
+                slot = &s_batch->in_flight[i];
+                break;
+            }
+        }
+
+        batch_peer_t *peer = NULL;
+        for (int i = 0; slot != NULL && i < ESP_NOW_MAX_TOTAL_PEER_NUM; i++) {
+            batch_peer_t *candidate = &s_batch->peers[(s_batch->next_peer + i) % ESP_NOW_MAX_TOTAL_PEER_NUM];
+            if (candidate->used && candidate->count > 0) {
+                peer = candidate;
+                s_batch->next_peer = (s_batch->next_peer + i + 1) % ESP_NOW_MAX_TOTAL_PEER_NUM;
+                break;
+            }
+        }
+        if (peer == NULL) {
+            BATCH_UNLOCK();
+            break;
+        }
+
+        batch_frame_t *frame = &peer->frames[peer->head];
+        // the slot is taken before the call, its callback may run before esp_now_send returns
+        slot->frame = *frame;
+        slot->peer = peer;
+        slot->seq = s_batch->next_seq++;
+        slot->used = true;
+        esp_err_t err = esp_now_send(peer->addr, frame->data, frame->len);
+        if (err == ESP_ERR_ESPNOW_NO_MEM) {
+            slot->used = false;
+            stalled = true;
+        } else {
+            peer->head = (peer->head + 1) % s_batch->config.queue_depth;
+            peer->count--;
+            peer->stats.queued--;
+            if (err == ESP_OK) {
+                peer->in_flight++;
+            } else {
+                ESP_LOGD(TAG, "esp_now_send failed (0x%x)", err);
+                slot->used = false;
+                done = frame_done(peer, &slot->frame, false);
+            }
+        }
+        BATCH_UNLOCK();
+
+        if (done) {
+            report_batch(done);
+        }
+    } while (!stalled);
+
+    return stalled;
+}
+
+static void batch_task(void *arg)
+{
+    bool stalled = false;
+    batch_send_status_t item;
+
+    while (!s_batch->stop) {
+        // if ESP-NOW ran out of buffers with no frame of ours in flight, poll until it has some again
+        ulTaskNotifyTake(pdTRUE, stalled ? 1 : portMAX_DELAY);
+        while (xQueueReceive(s_batch->status_queue, &item, 0) == pdTRUE) {
+            handle_send_status(&item);
+        }
+        if (!s_batch->stop) {
+            stalled = dispatch_frames();
+        }
+    }
+    xSemaphoreGive(s_batch->task_done);
+    vTaskDelete(NULL);
+}
+
+static void batch_free(batch_ctx_t *ctx)
+{
+    // a batch has frames either in a queue or in flight
+    for (size_t i = 0; ctx->in_flight && i < ctx->config.max_in_flight; i++) {
+        batch_in_flight_t *slot = &ctx->in_flight[i];
+        if (slot->used && --slot->frame.batch->remaining == 0) {
+            free(slot->frame.batch);
+        }
+    }
+    for (int i = 0; ctx->frames && i < ESP_NOW_MAX_TOTAL_PEER_NUM; i++) {
+        batch_peer_t *peer = &ctx->peers[i];
+        for (size_t j = 0; j < peer->count; j++) {
+            batch_frame_t *frame = &peer->frames[(peer->head + j) % ctx->config.queue_depth];
+            if (--frame->batch->remaining == 0) {
+                free(frame->batch);
+            }
+        }
+    }
+    if (ctx->status_queue) {
+        vQueueDelete(ctx->status_queue);
+    }
+    if (ctx->lock) {
+        vSemaphoreDelete(ctx->lock);
+    }
+    if (ctx->task_done) {
+        vSemaphoreDelete(ctx->task_done);
+    }
+    free(ctx->in_flight);
+    free(ctx->frames);
+    free(ctx);
+}
+
+esp_err_t esp_now_batch_init(const esp_now_batch_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    batch_ctx_t *ctx = NULL;
+
+    ESP_RETURN_ON_FALSE(config && config->queue_depth > 0 && config->max_in_flight > 0 && config->task_stack_size > 0,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid config");
+    ESP_RETURN_ON_FALSE(config->task_core_id >= -1 && config->task_core_id < CONFIG_FREERTOS_NUMBER_OF_CORES,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid core id");
+    ESP_RETURN_ON_FALSE(s_batch == NULL, ESP_ERR_INVALID_STATE, TAG, "already initialized");
+
+    ctx = calloc(1, sizeof(batch_ctx_t));
+    ESP_RETURN_ON_FALSE(ctx, ESP_ERR_NO_MEM, TAG, "no mem for context");
+    ctx->config = *config;
+    ctx->in_flight = calloc(config->max_in_flight, sizeof(batch_in_flight_t));
+    ctx->frames = calloc(ESP_NOW_MAX_TOTAL_PEER_NUM * config->queue_depth, sizeof(batch_frame_t));
+    ctx->lock = xSemaphoreCreateMutex();
+    ctx->task_done = xSemaphoreCreateBinary();
+    ctx->status_queue = xQueueCreate(config->max_in_flight, sizeof(batch_send_status_t));
+    ESP_GOTO_ON_FALSE(ctx->in_flight && ctx->frames && ctx->lock && ctx->task_done && ctx->status_queue,
+                      ESP_ERR_NO_MEM, err, TAG, "no mem for queues");
+    for (int i = 0; i < ESP_NOW_MAX_TOTAL_PEER_NUM; i++) {
+        ctx->peers[i].frames = &ctx->frames[i * config->queue_depth];
+    }
+
+    s_batch = ctx;
+    BaseType_t core_id = (config->task_core_id < 0) ? tskNO_AFFINITY : config->task_core_id;
+    ESP_GOTO_ON_FALSE(xTaskCreatePinnedToCore(batch_task, "espnow_batch", config->task_stack_size, NULL,
+                                              config->task_priority, &ctx->task, core_id) == pdPASS,
+                      ESP_ERR_NO_MEM, err, TAG, "create task failed");
+    ret = esp_now_register_send_cb(batch_send_cb);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "register send callback failed (0x%x)", ret);
+        ctx->stop = true;
+        xTaskNotifyGive(ctx->task);
+        xSemaphoreTake(ctx->task_done, portMAX_DELAY);
+        goto err;
+    }
+    return ESP_OK;
+
+err:
+    s_batch = NULL;
+    batch_free(ctx);
+    return ret;
+}
+
+esp_err_t esp_now_batch_deinit(void)
+{
+    batch_ctx_t *ctx = s_batch;
+
+    ESP_RETURN_ON_FALSE(ctx, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+    esp_now_unregister_send_cb();
+    ctx->stop = true;
+    xTaskNotifyGive(ctx->task);
+    xSemaphoreTake(ctx->task_done, portMAX_DELAY);
+    s_batch = NULL;
+    batch_free(ctx);
+    return ESP_OK;
+}
+
+esp_err_t esp_now_batch_send(const esp_now_batch_frame_t *frames, size_t count, uint32_t *batch_id)
+{
+    esp_err_t ret = ESP_OK;
+    size_t data_size = 0;
+    size_t needed[ESP_NOW_MAX_TOTAL_PEER_NUM] = { 0 };
+    batch_peer_t *peers[ESP_NOW_MAX_TOTAL_PEER_NUM];
+    size_t peer_count = 0;
+
+    if (s_batch == NULL) {
+        return ESP_ERR_ESPNOW_NOT_INIT;
+    }
+    if (frames == NULL || count == 0) {
+        return ESP_ERR_ESPNOW_ARG;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (frames[i].peer_addr == NULL || frames[i].data == NULL || frames[i].len == 0 ||
+                frames[i].len > ESP_NOW_MAX_DATA_LEN_V2) {
+            return ESP_ERR_ESPNOW_ARG;
+        }
+        if (i == 0 || frames[i].data != frames[i - 1].data || frames[i].len != frames[i - 1].len) {
+            data_size += frames[i].len;
+        }
+    }
+
+    batch_t *batch = malloc(sizeof(batch_t) + data_size);
+    if (batch == NULL) {
+        return ESP_ERR_ESPNOW_NO_MEM;
+    }
+
+    BATCH_LOCK();
+    // check that all frames fit before queuing any of them
+    for (size_t i = 0; i < count; i++) {
+        if (!esp_now_is_peer_exist(frames[i].peer_addr)) {
+            ret = ESP_ERR_ESPNOW_NOT_FOUND;
+            goto out;
+        }
+        batch_peer_t *peer = find_peer(frames[i].peer_addr, true);
+        if (peer == NULL) {
+            ret = ESP_ERR_ESPNOW_NO_MEM;
+            goto out;
+        }
+        size_t p = 0;
+        while (p < peer_count && peers[p] != peer) {
+            p++;
+        }
+        if (p == peer_count) {
+            peers[peer_count++] = peer;
+        }
+        if (peer->count + ++needed[p] > s_batch->config.queue_depth) {
+            ret = ESP_ERR_ESPNOW_NO_MEM;
+            goto out;
+        }
+    }
+
+    batch->id = s_batch->next_id++;
+    batch->frame_count = count;
+    batch->remaining = count;
+    batch->success_count = 0;
+    batch->fail_count = 0;
+    uint8_t *data = batch->data;
+    for (size_t i = 0; i < count; i++) {
+        if (i == 0 || frames[i].data != frames[i - 1].data || frames[i].len != frames[i - 1].len) {
+            memcpy(data, frames[i].data, frames[i].len);
+            data += frames[i].len;
+        }
+        batch_peer_t *peer = find_peer(frames[i].peer_addr, false);
+        batch_frame_t *frame = &peer->frames[(peer->head + peer->count) % s_batch->config.queue_depth];
+        frame->batch = batch;
+        frame->data = data - frames[i].len;
+        frame->len = frames[i].len;
+        peer->count++;
+        peer->stats.queued++;
+    }
+    if (batch_id) {
+        *batch_id = batch->id;
+    }
+    batch = NULL;
+
+out:
+    BATCH_UNLOCK();
+    if (batch) {
+        free(batch);
+    } else {
+        xTaskNotifyGive(s_batch->task);
+    }
+    return ret;
+}
+
+esp_err_t esp_now_batch_get_peer_stats(const uint8_t *peer_addr, esp_now_batch_peer_stats_t *stats)
+{
+    if (s_batch == NULL) {
+        return ESP_ERR_ESPNOW_NOT_INIT;
+    }
+    if (peer_addr == NULL || stats == NULL) {
+        return ESP_ERR_ESPNOW_ARG;
+    }
+
+    BATCH_LOCK();
+    batch_peer_t *peer = find_peer(peer_addr, false);
+    if (peer) {
+        *stats = peer->stats;
+    } else {
+        memset(stats, 0, sizeof(*stats));
+    }
+    BATCH_UNLOCK();
+    return ESP_OK;
+}
@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_wifi.h"
+#include "esp_wifi_csi_ring.h"
+
+/*
+ * The ring has a single producer, the CSI receiving callback in the Wi-Fi task, and a single consumer, the task
+ * calling esp_wifi_csi_ring_receive. The producer advances head once an entry is stored, the consumer advances
+ * read_pos when it hands out entries and tail when they are released, so the slots between tail and head are never
+ * written again until released. The positions run freely and are reduced modulo entry_count.
+ */
+
+typedef struct {
+    uint8_t *slots;
+    size_t slot_size;
+    size_t entry_count;
+    size_t max_len;
+    atomic_uint head;           // written by the producer
+    atomic_uint tail;           // written by the consumer
+    uint32_t read_pos;          // owned by the consumer
+    atomic_bool waiting;        // the consumer waits for data_sem
+    SemaphoreHandle_t data_sem;
+    atomic_uint received;
+    atomic_uint dropped_full;
+    atomic_uint dropped_oversized;
+    atomic_uint max_used;
+} csi_ring_t;
+
+static const char *TAG = "csi_ring";
+static csi_ring_t *s_csi_ring = NULL;
+
+static inline esp_wifi_csi_entry_t *csi_ring_entry(csi_ring_t *ring, uint32_t pos)
+{
+    return (esp_wifi_csi_entry_t *)(ring->slots + (pos % ring->entry_count) * ring->slot_size);
+}
+
+static void csi_ring_rx_cb(void *ctx, wifi_csi_info_t *info)
+{
+    csi_ring_t *ring = (csi_ring_t *)ctx;
+
+    if (info->len > ring->max_len) {
+        atomic_fetch_add(&ring->dropped_oversized, 1);
+        return;
+    }
+
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t used = head - atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (used == ring->entry_count) {
+        atomic_fetch_add(&ring->dropped_full, 1);
+        return;
+    }
+
+    esp_wifi_csi_entry_t *entry = csi_ring_entry(ring, head);
+    entry->rx_ctrl = info->rx_ctrl;
+    memcpy(entry->mac, info->mac, sizeof(entry->mac));
+    memcpy(entry->dmac, info->dmac, sizeof(entry->dmac));
+    entry->first_word_invalid = info->first_word_invalid;
+    entry->rx_seq = info->rx_seq;
+    entry->len = info->len;
+    memcpy(entry->buf, info->buf, info->len);
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+
+    atomic_fetch_add(&ring->received, 1);
+    if (used + 1 > atomic_load(&ring->max_used)) {
+        atomic_store(&ring->max_used, used + 1);
+    }
+    // Only wake up the consumer once it waits, not for every entry of a burst
+    if (atomic_exchange(&ring->waiting, false)) {
+        xSemaphoreGive(ring->data_sem);
+    }
+}
+
+esp_err_t esp_wifi_csi_ring_init(const esp_wifi_csi_ring_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    csi_ring_t *ring = NULL;
+
+    ESP_RETURN_ON_FALSE(config && config->entry_count > 0 && config->max_len > 0 && config->max_len <= UINT16_MAX,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid config");
+    ESP_RETURN_ON_FALSE(s_csi_ring == NULL, ESP_ERR_INVALID_STATE, TAG, "CSI ring already initialized");
+
+    ring = calloc(1, sizeof(csi_ring_t));
+    ESP_GOTO_ON_FALSE(ring, ESP_ERR_NO_MEM, err, TAG, "no mem for CSI ring");
+    // Keep the entries of the following slots aligned
+    ring->slot_size = (sizeof(esp_wifi_csi_entry_t) + config->max_len + 3) & ~(size_t)3;
+    ring->entry_count = config->entry_count;
+    ring->max_len = config->max_len;
+    ring->slots = calloc(ring->entry_count, ring->slot_size);
+    ESP_GOTO_ON_FALSE(ring->slots, ESP_ERR_NO_MEM, err, TAG, "no mem for CSI ring entries");
+    for (size_t i = 0; i < ring->entry_count; i++) {
+        esp_wifi_csi_entry_t *entry = csi_ring_entry(ring, i);
+        entry->buf = (int8_t *)(entry + 1);
+    }
+    ring->data_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(ring->data_sem, ESP_ERR_NO_MEM, err, TAG, "no mem for CSI ring semaphore");
+
+    ESP_GOTO_ON_ERROR(esp_wifi_set_csi_rx_cb(csi_ring_rx_cb, ring), err, TAG, "register CSI callback failed");
+    s_csi_ring = ring;
+    return ESP_OK;
+
+err:
+    if (ring) {
+        if (ring->data_sem) {
+            vSemaphoreDelete(ring->data_sem);
+        }
+        free(ring->slots);
+        free(ring);
+    }
+    return ret;
+}
+
+esp_err_t esp_wifi_csi_ring_deinit(void)
+{
+    ESP_RETURN_ON_FALSE(s_csi_ring, ESP_ERR_INVALID_STATE, TAG, "CSI ring not initialized");
+    esp_wifi_set_csi_rx_cb(NULL, NULL);
+    vSemaphoreDelete(s_csi_ring->data_sem);
+    free(s_csi_ring->slots);
+    free(s_csi_ring);
+    s_csi_ring = NULL;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_csi_ring_receive(const esp_wifi_csi_entry_t **entries, size_t max_entries, size_t *count,
+                                    TickType_t ticks_to_wait)
+{
+    ESP_RETURN_ON_FALSE(entries && max_entries > 0 && count, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(s_csi_ring, ESP_ERR_INVALID_STATE, TAG, "CSI ring not initialized");
+    csi_ring_t *ring = s_csi_ring;
+    TimeOut_t timeout;
+    uint32_t available;
+
+    *count = 0;
+    vTaskSetTimeOutState(&timeout);
+    while ((available = atomic_load_explicit(&ring->head, memory_order_acquire) - ring->read_pos) == 0) {
+        atomic_store(&ring->waiting, true);
+        // An entry stored before the flag was set doesn't wake us up
+        if (atomic_load_explicit(&ring->head, memory_order_acquire) != ring->read_pos) {
+            atomic_store(&ring->waiting, false);
+            continue;
+        }
+        if (xTaskCheckForTimeOut(&timeout, &ticks_to_wait) == pdTRUE) {
+            atomic_store(&ring->waiting, false);
+            return ESP_ERR_TIMEOUT;
+        }
+        xSemaphoreTake(ring->data_sem, ticks_to_wait);
+    }
+
+    size_t n = available < max_entries ? available : max_entries;
+    for (size_t i = 0; i < n; i++) {
+        entries[i] = csi_ring_entry(ring, ring->read_pos + i);
+    }
+    ring->read_pos += n;
+    *count = n;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_csi_ring_release(size_t count)
+{
+    ESP_RETURN_ON_FALSE(s_csi_ring, ESP_ERR_INVALID_STATE, TAG, "CSI ring not initialized");
+    csi_ring_t *ring = s_csi_ring;
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    ESP_RETURN_ON_FALSE(count <= ring->read_pos - tail, ESP_ERR_INVALID_ARG, TAG, "more entries than received");
+    atomic_store_explicit(&ring->tail, tail + count, memory_order_release);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_csi_ring_get_stats(esp_wifi_csi_ring_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(s_csi_ring, ESP_ERR_INVALID_STATE, TAG, "CSI ring not initialized");
+    stats->received = atomic_load(&s_csi_ring->received);
+    stats->dropped_full = atomic_load(&s_csi_ring->dropped_full);
+    stats->dropped_oversized = atomic_load(&s_csi_ring->dropped_oversized);
+    stats->max_used = atomic_load(&s_csi_ring->max_used);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_csi_ring_reset_stats(void)
+{
+    ESP_RETURN_ON_FALSE(s_csi_ring, ESP_ERR_INVALID_STATE, TAG, "CSI ring not initialized");
+    atomic_store(&s_csi_ring->received, 0);
+    atomic_store(&s_csi_ring->dropped_full, 0);
+    atomic_store(&s_csi_ring->dropped_oversized, 0);
+    atomic_store(&s_csi_ring->max_used, 0);
+    return ESP_OK;
+}
@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <stdatomic.h>
 #include "esp_wifi.h"
 #include "esp_netif.h"
 #include "esp_log.h"
@@ -30,32 +31,82 @@ static const char* TAG = "wifi_netif";
 static esp_netif_receive_t s_wifi_rxcbs[MAX_WIFI_IFS] = { NULL };
 static esp_netif_t *s_wifi_netifs[MAX_WIFI_IFS] = { NULL };
 
+#if CONFIG_ESP_WIFI_NETIF_BUFFER_STATS
+/**
+ * @brief Counters of the buffers exchanged with the network stack
+ */
+static struct {
+    atomic_uint rx_buf_in_use;
+    atomic_uint rx_buf_in_use_max;
+    atomic_uint rx_frames;
+    atomic_uint rx_dropped;
+    atomic_uint tx_frames;
+    atomic_uint tx_no_mem;
+} s_buffer_stats;
+
+static inline void wifi_stats_rx(esp_err_t ret)
+{
+    unsigned int in_use = atomic_fetch_add(&s_buffer_stats.rx_buf_in_use, 1) + 1;
+    unsigned int max = atomic_load(&s_buffer_stats.rx_buf_in_use_max);
+    while (in_use > max && !atomic_compare_exchange_weak(&s_buffer_stats.rx_buf_in_use_max, &max, in_use)) {
+    }
+    atomic_fetch_add(&s_buffer_stats.rx_frames, 1);
+    if (ret != ESP_OK) {
+        atomic_fetch_add(&s_buffer_stats.rx_dropped, 1);
+    }
+}
+
+static inline void wifi_stats_tx(esp_err_t ret)
+{
+    if (ret == ESP_OK) {
+        atomic_fetch_add(&s_buffer_stats.tx_frames, 1);
+    } else if (ret == ESP_ERR_NO_MEM) {
+        atomic_fetch_add(&s_buffer_stats.tx_no_mem, 1);
+    }
+}
+
+#define WIFI_STATS_RX(ret)  wifi_stats_rx(ret)
+#define WIFI_STATS_TX(ret)  wifi_stats_tx(ret)
+#define WIFI_STATS_RX_FREE() atomic_fetch_sub(&s_buffer_stats.rx_buf_in_use, 1)
+#else
+#define WIFI_STATS_RX(ret)
+#define WIFI_STATS_TX(ret)
+#define WIFI_STATS_RX_FREE()
+#endif
+
 /**
  * @brief WiFi netif driver IO functions, a thin glue layer
  *         to the original wifi interface API
  */
 static esp_err_t wifi_sta_receive(void *buffer, uint16_t len, void *eb)
 {
-    return s_wifi_rxcbs[WIFI_IF_STA](s_wifi_netifs[WIFI_IF_STA], buffer, len, eb);
+    esp_err_t ret = s_wifi_rxcbs[WIFI_IF_STA](s_wifi_netifs[WIFI_IF_STA], buffer, len, eb);
+    WIFI_STATS_RX(ret);
+    return ret;
 }
 
 #ifdef CONFIG_ESP_WIFI_SOFTAP_SUPPORT
 static esp_err_t wifi_ap_receive(void *buffer, uint16_t len, void *eb)
 {
-    return s_wifi_rxcbs[WIFI_IF_AP](s_wifi_netifs[WIFI_IF_AP], buffer, len, eb);
+    esp_err_t ret = s_wifi_rxcbs[WIFI_IF_AP](s_wifi_netifs[WIFI_IF_AP], buffer, len, eb);
+    WIFI_STATS_RX(ret);
+    return ret;
 }
 #endif
 
 #ifdef CONFIG_ESP_WIFI_NAN_ENABLE
 static esp_err_t wifi_nan_receive(void *buffer, uint16_t len, void *eb)
 {
-    return s_wifi_rxcbs[WIFI_IF_NAN](s_wifi_netifs[WIFI_IF_NAN], buffer, len, eb);
+    esp_err_t ret = s_wifi_rxcbs[WIFI_IF_NAN](s_wifi_netifs[WIFI_IF_NAN], buffer, len, eb);
+    WIFI_STATS_RX(ret);
+    return ret;
 }
 #endif
 
 static void wifi_free(void *h, void* buffer)
 {
     if (buffer) {
+        WIFI_STATS_RX_FREE();
         esp_wifi_internal_free_rx_buffer(buffer);
     }
 }
@@ -63,17 +114,22 @@ static void wifi_free(void *h, void* buffer)
 static esp_err_t wifi_transmit(void *h, void *buffer, size_t len)
 {
     wifi_netif_driver_t driver = h;
-    return esp_wifi_internal_tx(driver->wifi_if, buffer, len);
+    esp_err_t ret = esp_wifi_internal_tx(driver->wifi_if, buffer, len);
+    WIFI_STATS_TX(ret);
+    return ret;
 }
 
 static esp_err_t wifi_transmit_wrap(void *h, void *buffer, size_t len, void *netstack_buf)
 {
     wifi_netif_driver_t driver = h;
+    esp_err_t ret;
 #if CONFIG_SPIRAM
-    return esp_wifi_internal_tx_by_ref(driver->wifi_if, buffer, len, netstack_buf);
+    ret = esp_wifi_internal_tx_by_ref(driver->wifi_if, buffer, len, netstack_buf);
 #else
-    return esp_wifi_internal_tx(driver->wifi_if, buffer, len);
+    ret = esp_wifi_internal_tx(driver->wifi_if, buffer, len);
 #endif
+    WIFI_STATS_TX(ret);
+    return ret;
 }
 
 static esp_err_t wifi_driver_start(esp_netif_t * esp_netif, void * args)
@@ -181,3 +237,36 @@ esp_err_t esp_wifi_register_if_rxcb(wifi_netif_driver_t ifx, esp_netif_receive_t
     }
     return ESP_OK;
 }
+
+esp_err_t esp_wifi_netif_get_buffer_stats(wifi_netif_buffer_stats_t *stats)
+{
+#if CONFIG_ESP_WIFI_NETIF_BUFFER_STATS
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    stats->rx_buf_in_use = atomic_load(&s_buffer_stats.rx_buf_in_use);
+    stats->rx_buf_in_use_max = atomic_load(&s_buffer_stats.rx_buf_in_use_max);
+    stats->rx_frames = atomic_load(&s_buffer_stats.rx_frames);
+    stats->rx_dropped = atomic_load(&s_buffer_stats.rx_dropped);
+    stats->tx_frames = atomic_load(&s_buffer_stats.tx_frames);
+    stats->tx_no_mem = atomic_load(&s_buffer_stats.tx_no_mem);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t esp_wifi_netif_reset_buffer_stats(void)
+{
+#if CONFIG_ESP_WIFI_NETIF_BUFFER_STATS
+    // the buffers which are still held by the network stack stay counted
+    atomic_store(&s_buffer_stats.rx_buf_in_use_max, atomic_load(&s_buffer_stats.rx_buf_in_use));
+    atomic_store(&s_buffer_stats.rx_frames, 0);
+    atomic_store(&s_buffer_stats.rx_dropped, 0);
+    atomic_store(&s_buffer_stats.tx_frames, 0);
+    atomic_store(&s_buffer_stats.tx_no_mem, 0);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_wifi.h"
+#include "esp_event.h"
+#include "esp_now.h"
+#include "esp_now_batch.h"
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_WIFI_ESPNOW_BATCH_SEND
+
+#define TEST_BATCH_FRAMES   8
+
+static const uint8_t s_broadcast_mac[ESP_NOW_ETH_ALEN] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+static void batch_done_cb(const esp_now_batch_result_t *result, void *user_ctx)
+{
+    xQueueSend((QueueHandle_t)user_ctx, result, portMAX_DELAY);
+}
+
+TEST_CASE("ESP-NOW batch reports each batch once", "[espnow]")
+{
+    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    TEST_ESP_OK(esp_event_loop_create_default());
+    TEST_ESP_OK(esp_wifi_init(&cfg));
+    TEST_ESP_OK(esp_wifi_set_mode(WIFI_MODE_STA));
+    TEST_ESP_OK(esp_wifi_start());
+    TEST_ESP_OK(esp_now_init());
+
+    esp_now_peer_info_t peer = {
+        .channel = 0,
+        .ifidx = WIFI_IF_STA,
+        .encrypt = false,
+    };
+    memcpy(peer.peer_addr, s_broadcast_mac, ESP_NOW_ETH_ALEN);
+    TEST_ESP_OK(esp_now_add_peer(&peer));
+
+    QueueHandle_t results = xQueueCreate(4, sizeof(esp_now_batch_result_t));
+    TEST_ASSERT_NOT_NULL(results);
+    esp_now_batch_config_t config = ESP_NOW_BATCH_CONFIG_DEFAULT();
+    config.queue_depth = TEST_BATCH_FRAMES;
+    config.done_cb = batch_done_cb;
+    config.user_ctx = results;
+    TEST_ESP_OK(esp_now_batch_init(&config));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_now_batch_init(&config));
+
+    uint8_t data[32];
+    memset(data, 0x5a, sizeof(data));
+    esp_now_batch_frame_t frames[TEST_BATCH_FRAMES + 1];
+    for (int i = 0; i < TEST_BATCH_FRAMES + 1; i++) {
+        frames[i] = (esp_now_batch_frame_t) {
+            .peer_addr = s_broadcast_mac,
+            .data = data,
+            .len = sizeof(data),
+        };
+    }
+
+    // a batch which doesn't fit in the queue is rejected as a whole
+    TEST_ESP_ERR(ESP_ERR_ESPNOW_NO_MEM, esp_now_batch_send(frames, TEST_BATCH_FRAMES + 1, NULL));
+    const uint8_t unknown_mac[ESP_NOW_ETH_ALEN] = { 0x02, 0x11, 0x22, 0x33, 0x44, 0x55 };
+    esp_now_batch_frame_t unknown = { .peer_addr = unknown_mac, .data = data, .len = sizeof(data) };
+    TEST_ESP_ERR(ESP_ERR_ESPNOW_NOT_FOUND, esp_now_batch_send(&unknown, 1, NULL));
+
+    for (int i = 0; i < 3; i++) {
+        uint32_t batch_id;
+        esp_now_batch_result_t result;
+        TEST_ESP_OK(esp_now_batch_send(frames, TEST_BATCH_FRAMES, &batch_id));
+        TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(results, &result, pdMS_TO_TICKS(1000)));
+        TEST_ASSERT_EQUAL_UINT32(batch_id, result.batch_id);
+        TEST_ASSERT_EQUAL(TEST_BATCH_FRAMES, result.frame_count);
+        TEST_ASSERT_EQUAL(TEST_BATCH_FRAMES, result.success_count + result.fail_count);
+    }
+    TEST_ASSERT_EQUAL(0, uxQueueMessagesWaiting(results));
+
+    esp_now_batch_peer_stats_t stats;
+    TEST_ESP_OK(esp_now_batch_get_peer_stats(s_broadcast_mac, &stats));
+    TEST_ASSERT_EQUAL_UINT32(0, stats.queued);
+    TEST_ASSERT_EQUAL_UINT32(3 * TEST_BATCH_FRAMES, stats.success + stats.fail);
+
+    TEST_ESP_OK(esp_now_batch_deinit());
+    TEST_ESP_ERR(ESP_ERR_ESPNOW_NOT_INIT, esp_now_batch_send(frames, 1, NULL));
+    vQueueDelete(results);
+    TEST_ESP_OK(esp_now_deinit());
+    TEST_ESP_OK(esp_wifi_stop());
+    TEST_ESP_OK(esp_wifi_deinit());
+    TEST_ESP_OK(esp_event_loop_delete_default());
+}
+
+#endif // CONFIG_ESP_WIFI_ESPNOW_BATCH_SEND
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_wifi.h"
+#include "esp_event.h"
+#include "esp_wifi_csi_ring.h"
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_WIFI_CSI_RING
+
+TEST_CASE("CSI ring receive times out and counts nothing without traffic", "[wifi][csi]")
+{
+    const esp_wifi_csi_entry_t *entries[4];
+    size_t count = 0;
+    esp_wifi_csi_ring_config_t config = ESP_WIFI_CSI_RING_CONFIG_DEFAULT();
+
+    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    TEST_ESP_OK(esp_event_loop_create_default());
+    TEST_ESP_OK(esp_wifi_init(&cfg));
+    TEST_ESP_OK(esp_wifi_set_mode(WIFI_MODE_STA));
+    TEST_ESP_OK(esp_wifi_start());
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_wifi_csi_ring_receive(entries, 4, &count, 0));
+    config.entry_count = 0;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_wifi_csi_ring_init(&config));
+    config.entry_count = 8;
+    TEST_ESP_OK(esp_wifi_csi_ring_init(&config));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_wifi_csi_ring_init(&config));
+
+    // not connected and CSI disabled, so no entry arrives
+    TEST_ESP_ERR(ESP_ERR_TIMEOUT, esp_wifi_csi_ring_receive(entries, 4, &count, pdMS_TO_TICKS(50)));
+    TEST_ASSERT_EQUAL(0, count);
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_wifi_csi_ring_release(1));
+    TEST_ESP_OK(esp_wifi_csi_ring_release(0));
+
+    esp_wifi_csi_ring_stats_t stats;
+    TEST_ESP_OK(esp_wifi_csi_ring_get_stats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(0, stats.received);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dropped_full);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dropped_oversized);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.max_used);
+
+    TEST_ESP_OK(esp_wifi_csi_ring_deinit());
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_wifi_csi_ring_deinit());
+    TEST_ESP_OK(esp_wifi_stop());
+    TEST_ESP_OK(esp_wifi_deinit());
+    TEST_ESP_OK(esp_event_loop_delete_default());
+}
+
+#endif // CONFIG_ESP_WIFI_CSI_RING
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -43,6 +43,7 @@ extern "C" {
 #define SCAN_PREFERRED_CHAN_LIST CONFIG_ESP_WIFI_ROAMING_SCAN_CHAN_LIST
 #define DEFAULT_PREFERRED_SCAN_CHAN_LIST "None"
 #define SCAN_RESULTS_USABILITY_WINDOW CONFIG_ESP_WIFI_ROAMING_SCAN_EXPIRY_WINDOW
+#define SCAN_CHAN_HISTORY_ENABLED CONFIG_ESP_WIFI_ROAMING_SCAN_CHAN_HISTORY
 #define MAX_CANDIDATE_COUNT CONFIG_ESP_WIFI_ROAMING_MAX_CANDIDATES
 
 /* Legacy roaming configuration */
@@ -88,6 +89,12 @@ struct cand_bss {
 struct roaming_app {
     wifi_scan_config_t scan_params;
     bool scan_ongoing;
+#if SCAN_CHAN_HISTORY_ENABLED
+    wifi_scan_config_t history_scan_params;
+    uint16_t chan_history;      /* 2.4 GHz channels on which candidates were found by the last scans */
+    uint8_t chan_history_ssid[33];  /* Network the history belongs to, it is kept across roams */
+    bool history_scan;          /* The ongoing scan only covers the channels of history_scan_params */
+#endif
     int8_t current_rssi_threshold;
     char *btm_neighbor_list;
     struct timeval last_roamed_time;
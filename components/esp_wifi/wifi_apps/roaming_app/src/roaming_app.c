@@ -198,6 +198,14 @@ static void roaming_app_connected_event_handler(void* arg, esp_event_base_t even
     ESP_LOGD(ROAMING_TAG, "setting rssi threshold as %d", g_roaming_app.current_low_rssi_threshold);
     esp_wifi_set_rssi_threshold(g_roaming_app.current_low_rssi_threshold);
 #endif /*LOW_RSSI_ROAMING_ENABLED*/
+#if SCAN_CHAN_HISTORY_ENABLED
+    wifi_ap_record_t connected_ap;
+    roaming_app_get_ap_info(&connected_ap);
+    if (memcmp(g_roaming_app.chan_history_ssid, connected_ap.ssid, sizeof(g_roaming_app.chan_history_ssid)) != 0) {
+        memcpy(g_roaming_app.chan_history_ssid, connected_ap.ssid, sizeof(g_roaming_app.chan_history_ssid));
+        g_roaming_app.chan_history = 0;
+    }
+#endif /*SCAN_CHAN_HISTORY_ENABLED*/
     g_roaming_app.rrm_support = esp_rrm_is_rrm_supported_connection();
     g_roaming_app.btm_support = esp_wnm_is_btm_supported_connection();
     ESP_LOGD(ROAMING_TAG, "Station connected, RRM %ssupported, BTM %ssupported",
@@ -542,7 +550,7 @@ static bool candidate_profile_match(wifi_ap_record_t candidate)
     return candidate_security_match(candidate);
 }
 /* Remember to always call this function with the ROAM_SCAN_RESULTS_LOCK */
-static void parse_scan_results_and_roam(void)
+static bool parse_scan_results_and_roam(void)
 {
     int8_t rssi_threshold = g_roaming_app.current_rssi_threshold;
     uint8_t best_rssi_diff = rssi_threshold;
@@ -568,7 +576,7 @@ static void parse_scan_results_and_roam(void)
         best_ap = (struct cand_bss*)os_zalloc(sizeof(struct cand_bss));
         if (!best_ap) {
             ESP_LOGE(ROAMING_TAG,"Memory Allocation for candidate bss failed");
-            return;
+            return false;
         }
         os_memcpy(best_ap->bssid,g_roaming_app.scanned_aps.ap_records[best_ap_index].bssid , ETH_ALEN);
         best_ap->channel = g_roaming_app.scanned_aps.ap_records[best_ap_index].primary;
@@ -580,20 +588,88 @@ static void parse_scan_results_and_roam(void)
             ESP_LOGE(ROAMING_TAG, "Posting of roaming event failed");
         }
         os_free(best_ap);
+        return true;
     } else {
         ESP_LOGI(ROAMING_TAG, "Could not find a better AP with the threshold set to %d", g_roaming_app.current_rssi_threshold + 1);
     }
+    return false;
+}
+
+static void scan_done_event_handler(void *arg, ETS_STATUS status);
+
+#if SCAN_CHAN_HISTORY_ENABLED
+/* Remember to always call this function with the ROAM_SCAN_RESULTS_LOCK */
+static void update_chan_history(void)
+{
+    wifi_ap_record_t ap_info;
+    uint16_t history = 0;
+
+    roaming_app_get_ap_info(&ap_info);
+    for (uint16_t i = 0; i < g_roaming_app.scanned_aps.current_count; i++) {
+        wifi_ap_record_t *record = &g_roaming_app.scanned_aps.ap_records[i];
+        if (record->primary >= 1 && record->primary <= MAX_SCAN_CHAN_LIST_COUNT &&
+            memcmp(record->bssid, ap_info.bssid, ETH_ALEN) != 0 && candidate_profile_match(*record)) {
+            history |= (1 << record->primary);
+        }
+    }
+    g_roaming_app.chan_history = history;
 }
 
+/* Scan the channels not covered by the history scan, returns true if a scan was issued */
+static bool conduct_remaining_scan(void)
+{
+    wifi_scan_config_t *params = &g_roaming_app.history_scan_params;
+    uint16_t preferred = g_roaming_app.scan_params.channel_bitmap.ghz_2_channels;
+
+    *params = g_roaming_app.scan_params;
+    if (preferred) {
+        /* Keep the results of the history scan, the other channels are added to them */
+        params->channel_bitmap.ghz_2_channels = preferred & ~g_roaming_app.chan_history;
+        if (!params->channel_bitmap.ghz_2_channels) {
+            return false;
+        }
+    } else {
+        g_roaming_app.scanned_aps.current_count = 0;
+    }
+    if (esp_wifi_promiscuous_scan_start(params, scan_done_event_handler) < 0) {
+        ESP_LOGE(ROAMING_TAG, "failed to issue scan");
+        return false;
+    }
+    ESP_LOGI(ROAMING_TAG, "Issued Scan of the remaining channels");
+    return true;
+}
+#endif /*SCAN_CHAN_HISTORY_ENABLED*/
+
 static void scan_done_event_handler(void *arg, ETS_STATUS status)
 {
     if (status == ETS_OK) {
         ROAM_SCAN_RESULTS_LOCK();
         ESP_LOGD(ROAMING_TAG, "Scan Done properly");
-        g_roaming_app.scanned_aps.current_count = MAX_CANDIDATE_COUNT;
-        esp_wifi_scan_get_ap_records(&g_roaming_app.scanned_aps.current_count, g_roaming_app.scanned_aps.ap_records);
+        uint16_t count = MAX_CANDIDATE_COUNT - g_roaming_app.scanned_aps.current_count;
+        esp_wifi_scan_get_ap_records(&count, &g_roaming_app.scanned_aps.ap_records[g_roaming_app.scanned_aps.current_count]);
+        g_roaming_app.scanned_aps.current_count += count;
         print_ap_records(&g_roaming_app.scanned_aps);
+#if SCAN_CHAN_HISTORY_ENABLED
+        if (g_roaming_app.history_scan) {
+            g_roaming_app.history_scan = false;
+            if (parse_scan_results_and_roam()) {
+                /* Found on the known channels, the history stays valid */
+                g_roaming_app.scan_ongoing = false;
+                ROAM_SCAN_RESULTS_UNLOCK();
+                return;
+            }
+            if (conduct_remaining_scan()) {
+                /* The scan stays ongoing until the remaining channels are scanned */
+                ROAM_SCAN_RESULTS_UNLOCK();
+                return;
+            }
+        } else {
+            parse_scan_results_and_roam();
+        }
+        update_chan_history();
+#else
         parse_scan_results_and_roam();
+#endif /*SCAN_CHAN_HISTORY_ENABLED*/
         g_roaming_app.scan_ongoing = false;
         ROAM_SCAN_RESULTS_UNLOCK();
         } else {
@@ -602,11 +678,25 @@ static void scan_done_event_handler(void *arg, ETS_STATUS status)
 }
 static void conduct_scan(void)
 {
+    wifi_scan_config_t *params = &g_roaming_app.scan_params;
     /* Update scan time in global structure */
     gettimeofday(&g_roaming_app.scanned_aps.time, NULL);
         /* Issue scan */
     os_memset(&g_roaming_app.scanned_aps, 0, sizeof(struct scanned_ap_info));
-    if (esp_wifi_promiscuous_scan_start(&g_roaming_app.scan_params, scan_done_event_handler) < 0) {
+#if SCAN_CHAN_HISTORY_ENABLED
+    uint16_t history = g_roaming_app.chan_history;
+    if (g_roaming_app.scan_params.channel_bitmap.ghz_2_channels) {
+        history &= g_roaming_app.scan_params.channel_bitmap.ghz_2_channels;
+    }
+    g_roaming_app.history_scan = (history != 0);
+    if (g_roaming_app.history_scan) {
+        params = &g_roaming_app.history_scan_params;
+        *params = g_roaming_app.scan_params;
+        params->channel_bitmap.ghz_2_channels = history;
+        params->channel_bitmap.ghz_5_channels = 0;
+    }
+#endif /*SCAN_CHAN_HISTORY_ENABLED*/
+    if (esp_wifi_promiscuous_scan_start(params, scan_done_event_handler) < 0) {
         ESP_LOGE(ROAMING_TAG, "failed to issue scan");
         return;
     }
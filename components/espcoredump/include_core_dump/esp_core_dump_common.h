@@ -197,10 +197,22 @@ static inline void esp_core_dump_task_iterator_init(TaskIterator_t *iter)
     }
 }
 
+#if CONFIG_ESP_COREDUMP_TASK_FILTER
+/**
+ * @brief Check if a task is saved in the core dump
+ *
+ * @param handle Task handle.
+ *
+ * @return true if the task is the crashed task or is listed in CONFIG_ESP_COREDUMP_TASK_FILTER_NAMES.
+ */
+bool esp_core_dump_task_is_selected(void *handle);
+#endif
+
 /**
  * @brief Get the next task using the task iterator
  *
  * This function retrieves the next task in the traversal sequence.
+ * If CONFIG_ESP_COREDUMP_TASK_FILTER is enabled, the tasks which are not selected are skipped.
  *
  * @param task_iterator Pointer to the task iterator structure.
  *
@@ -208,7 +220,15 @@ static inline void esp_core_dump_task_iterator_init(TaskIterator_t *iter)
  */
 static inline int esp_core_dump_task_iterator_next(TaskIterator_t *task_iterator)
 {
+#if CONFIG_ESP_COREDUMP_TASK_FILTER
+    int ret;
+    do {
+        ret = xTaskGetNext(task_iterator);
+    } while (ret != -1 && task_iterator->pxTaskHandle != NULL && !esp_core_dump_task_is_selected(task_iterator->pxTaskHandle));
+    return ret;
+#else
     return xTaskGetNext(task_iterator);
+#endif
 }
 
 #ifdef __cplusplus
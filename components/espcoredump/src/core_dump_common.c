@@ -226,6 +226,33 @@ inline void esp_core_dump_reset_tasks_snapshots_iter(void)
     esp_core_dump_reset_fake_stacks();
 }
 
+#if CONFIG_ESP_COREDUMP_TASK_FILTER
+bool esp_core_dump_task_is_selected(void *handle)
+{
+    // Broken tasks are left to esp_core_dump_get_task_snapshot() to report, the crashed task is always saved
+    if (!esp_core_dump_tcb_addr_is_sane((uint32_t)handle) || handle == esp_core_dump_get_current_task_handle()) {
+        return true;
+    }
+
+    const char *name = pcTaskGetName((TaskHandle_t)handle);
+    const size_t name_len = strlen(name);
+    const char *sel = CONFIG_ESP_COREDUMP_TASK_FILTER_NAMES;
+
+    while (*sel) {
+        const char *sep = strchr(sel, ',');
+        const size_t sel_len = sep ? (size_t)(sep - sel) : strlen(sel);
+        if (sel_len == name_len && strncmp(sel, name, sel_len) == 0) {
+            return true;
+        }
+        if (!sep) {
+            break;
+        }
+        sel = sep + 1;
+    }
+    return false;
+}
+#endif
+
 bool esp_core_dump_get_task_snapshot(void *handle, core_dump_task_header_t *task,
                                      core_dump_mem_seg_header_t *interrupted_stack)
 {
@@ -8,7 +8,7 @@
 
 #if CONFIG_ESP_COREDUMP_CHECKSUM_CRC32
 
-#include "esp_rom_crc.h"
+#include "esp_crc.h"
 #include "esp_core_dump_types.h"
 
 const static char TAG[] __attribute__((unused)) = "esp_core_dump_crc";
@@ -53,7 +53,7 @@ static void core_dump_crc_update(core_dump_checksum_ctx cks_ctx, void* data, siz
 {
     if (data) {
         core_dump_crc_ctx_t *crc_ctx = cks_ctx;
-        crc_ctx->crc = esp_rom_crc32_le(crc_ctx->crc, data, data_len);
+        crc_ctx->crc = esp_crc32_le(crc_ctx->crc, data, data_len);
         // keep counter of cashed bytes
         crc_ctx->total_bytes_checksum += data_len;
     } else {
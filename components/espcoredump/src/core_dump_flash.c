@@ -54,6 +54,7 @@ esp_err_t esp_core_dump_write_data(core_dump_write_data_t *wr_data, void *data,
 #define ESP_COREDUMP_FLASH_WRITE(_off_, _data_, _len_)           esp_flash_write(esp_flash_default_chip, _data_, _off_, _len_)
 #define ESP_COREDUMP_FLASH_WRITE_ENCRYPTED(_off_, _data_, _len_) esp_flash_write_encrypted(esp_flash_default_chip, _off_, _data_, _len_)
 #define ESP_COREDUMP_FLASH_ERASE(_off_, _len_)                   esp_flash_erase_region(esp_flash_default_chip, _off_, _len_)
+#define ESP_COREDUMP_FLASH_READ(_off_, _data_, _len_)            esp_flash_read(esp_flash_default_chip, _data_, _off_, _len_)
 
 esp_err_t esp_core_dump_image_check(void);
 esp_err_t esp_core_dump_partition_and_size_get(const esp_partition_t **partition, uint32_t* size);
@@ -240,6 +241,54 @@ static esp_err_t esp_core_dump_flash_write_data(core_dump_write_data_t* wr_data,
     return ESP_OK;
 }
 
+static bool esp_core_dump_flash_sector_is_blank(uint32_t address)
+{
+    uint32_t buf[COREDUMP_CACHE_SIZE / sizeof(uint32_t)];
+
+    for (uint32_t off = 0; off < SPI_FLASH_SEC_SIZE; off += sizeof(buf)) {
+        if (ESP_COREDUMP_FLASH_READ(address + off, buf, sizeof(buf)) != ESP_OK) {
+            return false;
+        }
+        for (size_t i = 0; i < sizeof(buf) / sizeof(uint32_t); i++) {
+            if (buf[i] != UINT32_MAX) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static esp_err_t esp_core_dump_flash_erase(uint32_t sec_num)
+{
+    esp_err_t err = ESP_OK;
+    uint32_t erase_off = 0;
+    uint32_t erase_len = 0;
+
+    /* Reading a sector is much faster than erasing it, so the sectors which
+     * are already blank, e.g. after esp_core_dump_image_erase(), are not
+     * erased again. Consecutive sectors are erased at once to let the flash
+     * driver use block erase. */
+    for (uint32_t sec = 0; sec <= sec_num; sec++) {
+        uint32_t off = sec * SPI_FLASH_SEC_SIZE;
+        if (sec < sec_num && !esp_core_dump_flash_sector_is_blank(s_core_flash_config.partition.start + off)) {
+            if (erase_len == 0) {
+                erase_off = off;
+            }
+            erase_len += SPI_FLASH_SEC_SIZE;
+            continue;
+        }
+        if (erase_len) {
+            ESP_COREDUMP_LOGI("Erase flash %d bytes @ 0x%x", erase_len, s_core_flash_config.partition.start + erase_off);
+            err = ESP_COREDUMP_FLASH_ERASE(s_core_flash_config.partition.start + erase_off, erase_len);
+            if (err != ESP_OK) {
+                return err;
+            }
+            erase_len = 0;
+        }
+    }
+    return err;
+}
+
 static esp_err_t esp_core_dump_flash_write_prepare(core_dump_write_data_t *wr_data, uint32_t *data_len)
 {
     esp_err_t err = ESP_OK;
@@ -281,9 +330,8 @@ static esp_err_t esp_core_dump_flash_write_prepare(core_dump_write_data_t *wr_da
     }
 
     /* Erase the amount of sectors needed. */
-    ESP_COREDUMP_LOGI("Erase flash %d bytes @ 0x%x", sec_num * SPI_FLASH_SEC_SIZE, s_core_flash_config.partition.start + 0);
     ESP_COREDUMP_ASSERT(sec_num * SPI_FLASH_SEC_SIZE <= s_core_flash_config.partition.size);
-    err = ESP_COREDUMP_FLASH_ERASE(s_core_flash_config.partition.start + 0, sec_num * SPI_FLASH_SEC_SIZE);
+    err = esp_core_dump_flash_erase(sec_num);
     if (err != ESP_OK) {
         ESP_COREDUMP_LOGE("Failed to erase flash (%d)!", err);
     }
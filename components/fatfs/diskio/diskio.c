@@ -15,9 +15,17 @@
 #include "diskio_impl.h"
 #include "ffconf.h"
 #include "ff.h"
+#include "sdkconfig.h"
+#if CONFIG_FATFS_BLOCK_CACHE_SECTORS > 0
+#include "diskio_cache.h"
+#endif
 
 static ff_diskio_impl_t * s_impls[FF_VOLUMES] = { NULL };
 
+#if CONFIG_FATFS_BLOCK_CACHE_SECTORS > 0
+static ff_diskio_cache_t * s_caches[FF_VOLUMES] = { NULL };
+#endif
+
 #if FF_MULTI_PARTITION		/* Multiple partition configuration */
 const PARTITION VolToPart[FF_VOLUMES] = {
     {0, 0},    /* Logical drive 0 ==> Physical drive 0, auto detection */
@@ -67,6 +75,11 @@ void ff_diskio_register(BYTE pdrv, const ff_diskio_impl_t* discio_impl)
 {
     assert(pdrv < FF_VOLUMES);
 
+#if CONFIG_FATFS_BLOCK_CACHE_SECTORS > 0
+    ff_diskio_cache_delete(s_caches[pdrv]);
+    s_caches[pdrv] = NULL;
+#endif
+
     if (s_impls[pdrv]) {
         ff_diskio_impl_t* im = s_impls[pdrv];
         s_impls[pdrv] = NULL;
@@ -85,6 +98,11 @@ void ff_diskio_register(BYTE pdrv, const ff_diskio_impl_t* discio_impl)
 
 DSTATUS ff_disk_initialize (BYTE pdrv)
 {
+#if CONFIG_FATFS_BLOCK_CACHE_SECTORS > 0
+    // The medium may have changed, the cache is created again with its geometry on the next read
+    ff_diskio_cache_delete(s_caches[pdrv]);
+    s_caches[pdrv] = NULL;
+#endif
     return s_impls[pdrv]->init(pdrv);
 }
 DSTATUS ff_disk_status (BYTE pdrv)
@@ -93,14 +111,32 @@ DSTATUS ff_disk_status (BYTE pdrv)
 }
 DRESULT ff_disk_read (BYTE pdrv, BYTE* buff, LBA_t sector, UINT count)
 {
+#if CONFIG_FATFS_BLOCK_CACHE_SECTORS > 0
+    if (!s_caches[pdrv]) {
+        s_caches[pdrv] = ff_diskio_cache_create(pdrv, s_impls[pdrv]);
+    }
+    if (s_caches[pdrv]) {
+        return ff_diskio_cache_read(s_caches[pdrv], buff, sector, count);
+    }
+#endif
     return s_impls[pdrv]->read(pdrv, buff, sector, count);
 }
 DRESULT ff_disk_write (BYTE pdrv, const BYTE* buff, LBA_t sector, UINT count)
 {
+#if CONFIG_FATFS_BLOCK_CACHE_SECTORS > 0
+    if (s_caches[pdrv]) {
+        return ff_diskio_cache_write(s_caches[pdrv], buff, sector, count);
+    }
+#endif
     return s_impls[pdrv]->write(pdrv, buff, sector, count);
 }
 DRESULT ff_disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
 {
+#if CONFIG_FATFS_BLOCK_CACHE_SECTORS > 0
+    if (cmd == CTRL_TRIM && s_caches[pdrv]) {
+        ff_diskio_cache_invalidate(s_caches[pdrv]);
+    }
+#endif
     return s_impls[pdrv]->ioctl(pdrv, cmd, buff);
 }
 
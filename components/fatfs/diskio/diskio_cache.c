@@ -0,0 +1,197 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <sys/param.h>
+#include "diskio_impl.h"
+#include "diskio_cache.h"
+#include "ffconf.h"
+#include "ff.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "diskio_cache";
+
+typedef struct {
+    DWORD sector;
+    bool valid;
+    uint32_t last_use;
+    BYTE *data;
+} cache_line_t;
+
+struct ff_diskio_cache {
+    BYTE pdrv;
+    const ff_diskio_impl_t *impl;
+    size_t sector_size;
+    DWORD sector_count;
+    DWORD next_sector;              /* Sector following the last read one, to detect sequential reads */
+    UINT read_ahead;
+    uint32_t use_counter;
+    BYTE *buffer;                   /* Data of the lines, followed by the read-ahead buffer of 2 * read_ahead sectors */
+    BYTE *read_ahead_buffer;
+    size_t line_count;
+    cache_line_t lines[];
+};
+
+ff_diskio_cache_t *ff_diskio_cache_create(BYTE pdrv, const ff_diskio_impl_t *impl)
+{
+    WORD sector_size = FF_MAX_SS;
+    DWORD sector_count = 0;
+    const size_t line_count = CONFIG_FATFS_BLOCK_CACHE_SECTORS;
+
+    if (impl->ioctl(pdrv, GET_SECTOR_SIZE, &sector_size) != RES_OK ||
+        impl->ioctl(pdrv, GET_SECTOR_COUNT, &sector_count) != RES_OK) {
+        // Sectors are not read ahead without the size of the drive
+        sector_count = 0;
+    }
+
+    ff_diskio_cache_t *cache = calloc(1, sizeof(ff_diskio_cache_t) + line_count * sizeof(cache_line_t));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->pdrv = pdrv;
+    cache->impl = impl;
+    cache->sector_size = sector_size;
+    cache->sector_count = sector_count;
+    cache->next_sector = UINT32_MAX;
+    cache->line_count = line_count;
+    // The sectors read together must fit in the cache
+    cache->read_ahead = MIN(CONFIG_FATFS_BLOCK_CACHE_READ_AHEAD, line_count / 2);
+
+    cache->buffer = ff_memalloc((line_count + 2 * cache->read_ahead) * sector_size);
+    if (cache->buffer == NULL) {
+        free(cache);
+        return NULL;
+    }
+    for (size_t i = 0; i < line_count; i++) {
+        cache->lines[i].data = &cache->buffer[i * sector_size];
+    }
+    cache->read_ahead_buffer = &cache->buffer[line_count * sector_size];
+    ESP_LOGD(TAG, "drive %d: %d sectors of %d bytes, read ahead %d", pdrv, (int)line_count, (int)sector_size, (int)cache->read_ahead);
+    return cache;
+}
+
+void ff_diskio_cache_delete(ff_diskio_cache_t *cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+    ff_memfree(cache->buffer);
+    free(cache);
+}
+
+void ff_diskio_cache_invalidate(ff_diskio_cache_t *cache)
+{
+    for (size_t i = 0; i < cache->line_count; i++) {
+        cache->lines[i].valid = false;
+    }
+    cache->next_sector = UINT32_MAX;
+}
+
+static cache_line_t *find_line(ff_diskio_cache_t *cache, DWORD sector)
+{
+    for (size_t i = 0; i < cache->line_count; i++) {
+        if (cache->lines[i].valid && cache->lines[i].sector == sector) {
+            return &cache->lines[i];
+        }
+    }
+    return NULL;
+}
+
+static void insert_sectors(ff_diskio_cache_t *cache, const BYTE *buff, DWORD sector, UINT count)
+{
+    for (UINT i = 0; i < count; i++) {
+        cache_line_t *line = find_line(cache, sector + i);
+        if (line == NULL) {
+            // Replace the least recently used line
+            line = &cache->lines[0];
+            for (size_t j = 0; j < cache->line_count && line->valid; j++) {
+                if (!cache->lines[j].valid || cache->lines[j].last_use < line->last_use) {
+                    line = &cache->lines[j];
+                }
+            }
+            line->sector = sector + i;
+            line->valid = true;
+        }
+        memcpy(line->data, &buff[i * cache->sector_size], cache->sector_size);
+        line->last_use = ++cache->use_counter;
+    }
+}
+
+DRESULT ff_diskio_cache_read(ff_diskio_cache_t *cache, BYTE *buff, DWORD sector, UINT count)
+{
+    const bool sequential = (sector == cache->next_sector);
+    cache->next_sector = sector + count;
+
+    // Large reads of file data would only evict the other sectors, and the cache never holds newer data than the drive
+    if (count >= cache->line_count) {
+        return cache->impl->read(cache->pdrv, buff, sector, count);
+    }
+
+    UINT i = 0;
+    while (i < count) {
+        cache_line_t *line = find_line(cache, sector + i);
+        if (line != NULL) {
+            memcpy(&buff[i * cache->sector_size], line->data, cache->sector_size);
+            line->last_use = ++cache->use_counter;
+            i++;
+            continue;
+        }
+
+        // Read the sectors missing from the cache with one call, followed by the read-ahead ones
+        UINT n = 1;
+        while (i + n < count && find_line(cache, sector + i + n) == NULL) {
+            n++;
+        }
+        UINT ahead = 0;
+        if (sequential && i + n == count && n <= cache->read_ahead && sector + count < cache->sector_count) {
+            ahead = MIN(cache->read_ahead, cache->sector_count - (sector + count));
+        }
+
+        DRESULT res;
+        if (ahead > 0) {
+            res = cache->impl->read(cache->pdrv, cache->read_ahead_buffer, sector + i, n + ahead);
+            if (res != RES_OK) {
+                return res;
+            }
+            memcpy(&buff[i * cache->sector_size], cache->read_ahead_buffer, n * cache->sector_size);
+            insert_sectors(cache, cache->read_ahead_buffer, sector + i, n + ahead);
+        } else {
+            res = cache->impl->read(cache->pdrv, &buff[i * cache->sector_size], sector + i, n);
+            if (res != RES_OK) {
+                return res;
+            }
+            insert_sectors(cache, &buff[i * cache->sector_size], sector + i, n);
+        }
+        i += n;
+    }
+    return RES_OK;
+}
+
+DRESULT ff_diskio_cache_write(ff_diskio_cache_t *cache, const BYTE *buff, DWORD sector, UINT count)
+{
+    DRESULT res = cache->impl->write(cache->pdrv, buff, sector, count);
+    if (res == RES_OK && count < cache->line_count) {
+        // The FAT and directory sectors are often read back after being written
+        insert_sectors(cache, buff, sector, count);
+        return res;
+    }
+    for (UINT i = 0; i < count; i++) {
+        cache_line_t *line = find_line(cache, sector + i);
+        if (line == NULL) {
+            continue;
+        }
+        if (res == RES_OK) {
+            memcpy(line->data, &buff[i * cache->sector_size], cache->sector_size);
+        } else {
+            // The content of the sector on the drive is not known anymore
+            line->valid = false;
+        }
+    }
+    return res;
+}
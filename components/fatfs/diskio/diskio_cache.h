@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "diskio_impl.h"
+
+/**
+ * Block cache placed between FatFs and a diskio driver
+ *
+ * The cache holds the most recently used sectors of a drive (FAT, directory and
+ * file data alike) and is write-through, so the drive always holds the same data
+ * as the cache. When sequential reads are detected, the sectors following the
+ * requested ones are read ahead with the same driver call.
+ */
+typedef struct ff_diskio_cache ff_diskio_cache_t;
+
+/**
+ * Create the cache of a drive. The drive must be initialized, as its sector
+ * size and sector count are queried.
+ *
+ * @param pdrv  drive number
+ * @param impl  diskio driver of the drive
+ * @return pointer to the cache, NULL if there is not enough memory
+ */
+ff_diskio_cache_t *ff_diskio_cache_create(BYTE pdrv, const ff_diskio_impl_t *impl);
+
+/**
+ * Free the cache of a drive. NULL is ignored.
+ */
+void ff_diskio_cache_delete(ff_diskio_cache_t *cache);
+
+/**
+ * Drop all the sectors held by the cache
+ */
+void ff_diskio_cache_invalidate(ff_diskio_cache_t *cache);
+
+/**
+ * Read sectors through the cache, same arguments as disk_read
+ */
+DRESULT ff_diskio_cache_read(ff_diskio_cache_t *cache, BYTE *buff, DWORD sector, UINT count);
+
+/**
+ * Write sectors to the drive and update the cache, same arguments as disk_write
+ */
+DRESULT ff_diskio_cache_write(ff_diskio_cache_t *cache, const BYTE *buff, DWORD sector, UINT count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,9 +5,11 @@
  */
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 
 #include "ff.h"
 #include "esp_partition.h"
+#include "esp_private/partition_linux.h"
 #include "wear_levelling.h"
 #include "diskio_impl.h"
 #include "diskio_wl.h"
@@ -282,3 +284,62 @@ TEST_CASE("Test mounting 2 volumes, writing data and formatting the 2nd one, rea
     esp_result = wl_unmount(wl_handle1);
     REQUIRE(esp_result == ESP_OK);
 }
+
+TEST_CASE("Benchmark writing a file in small chunks with SPI NOR timing", "[fatfs][benchmark]")
+{
+    FRESULT fr_result;
+    esp_err_t esp_result;
+    const esp_partition_t *partition;
+    wl_handle_t wl_handle;
+    BYTE pdrv;
+    FATFS fs;
+    FIL file;
+    UINT bw;
+
+    prepare_fatfs("storage", &partition, &wl_handle, &pdrv);
+    char drv[3] = {(char)('0' + pdrv), ':', 0};
+    fr_result = f_mount(&fs, drv, 1);
+    REQUIRE(fr_result == FR_OK);
+
+    esp_partition_timing_model_t model = ESP_PARTITION_TIMING_MODEL_SPI_NOR_DEFAULT();
+    esp_partition_set_timing_model(&model);
+    esp_partition_clear_stats();
+
+    // Log-like workload: small appends, each synced to the flash
+    const uint32_t chunk_size = 128;
+    const uint32_t chunk_count = 256;
+    char chunk[chunk_size];
+    memset(chunk, 'a', chunk_size);
+
+    char path[16];
+    snprintf(path, sizeof(path), "%s/log.txt", drv);
+    fr_result = f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE);
+    REQUIRE(fr_result == FR_OK);
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        fr_result = f_write(&file, chunk, chunk_size, &bw);
+        REQUIRE(fr_result == FR_OK);
+        REQUIRE(bw == chunk_size);
+        fr_result = f_sync(&file);
+        REQUIRE(fr_result == FR_OK);
+    }
+    fr_result = f_close(&file);
+    REQUIRE(fr_result == FR_OK);
+
+    esp_partition_stats_t stats;
+    esp_partition_get_stats(&stats);
+    esp_partition_set_timing_model(NULL);
+    printf("[Benchmark][fatfs_small_appends]: iterations=%" PRIu32 " read_ops=%zu write_ops=%zu erase_ops=%zu read_bytes=%zu write_bytes=%zu "
+           "read_us=%" PRIu64 " write_us=%" PRIu64 " erase_us=%" PRIu64 "\n", chunk_count, stats.read_ops, stats.write_ops,
+           stats.erase_ops, stats.read_bytes, stats.write_bytes, stats.read_time_us, stats.write_time_us, stats.erase_time_us);
+
+    // A sync rewrites the data and directory sectors, and the FAT sectors when a cluster is allocated
+    REQUIRE(stats.erase_ops >= chunk_count);
+    REQUIRE(stats.erase_ops <= chunk_count * 4);
+
+    fr_result = f_mount(0, drv, 0);
+    REQUIRE(fr_result == FR_OK);
+    ff_diskio_unregister(pdrv);
+    ff_diskio_clear_pdrv_wl(wl_handle);
+    esp_result = wl_unmount(wl_handle);
+    REQUIRE(esp_result == ESP_OK);
+}
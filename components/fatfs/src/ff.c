@@ -476,6 +476,26 @@ static volatile BYTE SysLockVolume;	/* Volume id who is locking Files[] */
 #endif
 #endif
 
+#if FF_DIR_INDEX
+typedef struct {
+	WORD tag;		/* Upper 16 bits of the name hash (0:empty slot, 1:deleted slot) */
+	WORD ent;		/* Index of the top entry of the object in the directory */
+} DIRSLOT;
+
+typedef struct {
+	FATFS* fs;		/* Filesystem object the index belongs to (NULL:unused) */
+	WORD id;		/* Volume mount ID of the filesystem object */
+	BYTE bits;		/* Number of slots in power of 2 */
+	DWORD sclust;	/* Start cluster of the directory (0:root directory on FAT12/16) */
+	DWORD stamp;	/* Time of the last use */
+	UINT used;		/* Number of used and deleted slots */
+	DIRSLOT* slot;	/* Hash table (NULL:the directory can not be indexed) */
+} DIRINDEX;
+
+static DIRINDEX DirIndex[FF_VOLUMES][FF_DIR_INDEX];	/* Name indexes of the directories */
+static DWORD DirIndexTime[FF_VOLUMES];				/* Use counter of the name indexes */
+#endif
+
 #if FF_STR_VOLUME_ID
 #ifdef FF_VOLUME_STRS
 static const char *const VolumeStr[FF_VOLUMES] = {FF_VOLUME_STRS};	/* Pre-defined volume ID */
@@ -935,6 +955,34 @@ static void unlock_volume (
 	}
 }
 
+
+#if FF_FS_CONCURRENT_READ && !FF_FS_TINY
+/*-----------------------------------------------------------------------*/
+/* Read data sectors of a file with the volume unlocked                  */
+/*-----------------------------------------------------------------------*/
+/* The sectors are read into the user buffer or the file's own sector
+/  buffer, which are not shared with other tasks. FR_TIMEOUT is returned
+/  with the volume unlocked, any other result with the volume locked. */
+
+static FRESULT read_unlocked (
+	FFOBJID* obj,	/* Object being read */
+	BYTE* buff,		/* Data buffer to store the read data */
+	LBA_t sect,		/* Start sector */
+	UINT count		/* Number of sectors to read */
+)
+{
+	FATFS *fs = obj->fs;
+	DRESULT dr;
+
+
+	unlock_volume(fs, FR_OK);
+	dr = disk_read(fs->pdrv, buff, sect, count);
+	if (!lock_volume(fs, 0)) return FR_TIMEOUT;
+	if (!fs->fs_type || obj->id != fs->id) return FR_INVALID_OBJECT;	/* The volume has been unmounted or remounted meanwhile */
+	return dr == RES_OK ? FR_OK : FR_DISK_ERR;
+}
+#endif
+
 #endif
 
 
@@ -2379,44 +2427,340 @@ static FRESULT dir_read (
 
 
 
+#if FF_DIR_INDEX
 /*-----------------------------------------------------------------------*/
-/* Directory handling - Find an object in the directory                  */
+/* Directory handling - Name index                                       */
 /*-----------------------------------------------------------------------*/
+/* A name index maps the hash values of the names in a directory to the
+/  top entries of the objects, so that dir_find() compares only the objects
+/  with a matching hash instead of reading the whole directory. The index is
+/  built after a search in the directory went through DIR_INDEX_MIN_ENT entries,
+/  updated when objects are registered or removed and discarded when the volume
+/  is mounted. Each object has a key for its SFN and, if it has one, a key for
+/  its LFN. */
 
-static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
-	FF_DIR* dp					/* Pointer to the directory object with the file name */
+#define DIR_INDEX_BITS_MIN	6	/* Number of slots of a new index in power of 2 */
+#define DIR_INDEX_BITS_MAX	16	/* Max number of slots in power of 2 (bits of the tag) */
+#define DIR_INDEX_MIN_ENT	128	/* Number of entries searched in a directory to index it */
+
+static DWORD mix_hash (	/* Mix the bits of a value */
+	DWORD h
+)
+{
+	h ^= h >> 16; h *= 0x85EBCA6B;
+	h ^= h >> 13; h *= 0xC2B2AE35;
+	h ^= h >> 16;
+	return h;
+}
+
+
+static DWORD hash_sfn (	/* Hash value of an SFN */
+	const BYTE* sfn		/* Pointer to the SFN in directory form */
+)
+{
+	DWORD h = 0;
+	UINT i;
+
+
+	for (i = 0; i < 11; i++) h += mix_hash((DWORD)sfn[i] << 8 | i);
+	return h;
+}
+
+
+#if FF_USE_LFN
+static DWORD hash_lfn (	/* Hash value of the LFN in the working buffer */
+	const WCHAR* lfnbuf
+)
+{
+	DWORD h = 0;
+	UINT i;
+
+
+	for (i = 0; lfnbuf[i]; i++) h += mix_hash(ff_wtoupper(lfnbuf[i]) << 8 | i);
+	return h;
+}
+
+
+static DWORD hash_lfn_ent (	/* Part of the LFN hash value in an LFN entry, same as hash_lfn() for the characters */
+	const BYTE* dir			/* Pointer to the LFN entry */
+)
+{
+	DWORD h = 0;
+	UINT i, s;
+	WCHAR wc;
+
+
+	i = ((dir[LDIR_Ord] & 0x3F) - 1) * 13;	/* Offset of the characters in the name */
+	for (s = 0; s < 13; s++, i++) {
+		wc = ld_word(dir + LfnOfs[s]);
+		if (wc == 0) break;					/* End of the name */
+		h += mix_hash(ff_wtoupper(wc) << 8 | i);
+	}
+	return h;
+}
+#endif
+
+
+static int dir_index_vol (	/* Volume of the name indexes of a filesystem object */
+	FATFS* fs
+)
+{
+	int vol;
+
+
+	for (vol = 0; vol < FF_VOLUMES - 1 && FatFs[vol] != fs; vol++) ;
+	return vol;
+}
+
+
+static void dir_index_free (
+	DIRINDEX* di
+)
+{
+	ff_memfree(di->slot);
+	di->slot = 0;
+	di->fs = 0;
+}
+
+
+static void dir_index_clear (	/* Discard the name indexes of a filesystem object */
+	FATFS* fs
+)
+{
+	DIRINDEX *di = DirIndex[dir_index_vol(fs)];
+	UINT i;
+
+
+	for (i = 0; i < FF_DIR_INDEX; i++) {
+		if (di[i].fs) dir_index_free(&di[i]);
+	}
+}
+
+
+static DIRINDEX* dir_index_find (	/* Find the name index of a directory, NULL:not indexed */
+	FATFS* fs,
+	DWORD sclust	/* Start cluster of the directory */
+)
+{
+	DIRINDEX *di = DirIndex[dir_index_vol(fs)];
+	UINT i;
+
+
+	for (i = 0; i < FF_DIR_INDEX; i++) {
+		if (di[i].fs == fs && di[i].id == fs->id && di[i].sclust == sclust) return &di[i];
+	}
+	return 0;
+}
+
+
+static void dir_index_put (	/* Put a key into a slot, the table must have a free slot */
+	DIRINDEX* di,
+	WORD tag,
+	WORD ent
+)
+{
+	UINT i, mask = ((UINT)1 << di->bits) - 1;
+
+
+	for (i = tag >> (16 - di->bits); di->slot[i].tag > 1; i = (i + 1) & mask) ;
+	if (di->slot[i].tag == 0) di->used++;
+	di->slot[i].tag = tag;
+	di->slot[i].ent = ent;
+}
+
+
+static FRESULT dir_index_add (	/* FR_OK:succeeded, FR_NOT_ENOUGH_CORE:the index can not be extended */
+	DIRINDEX* di,
+	DWORD hash,		/* Hash value of the name */
+	DWORD ofs		/* Offset of the top entry of the object */
+)
+{
+	WORD tag = (WORD)(hash >> 16);
+	DIRSLOT *old;
+	UINT i, n;
+
+
+	if (tag < 2) tag += 2;
+	if ((di->used + 1) * 4 > (UINT)3 << di->bits) {	/* Extend the table when it gets 3/4 full */
+		if (di->bits >= DIR_INDEX_BITS_MAX) return FR_NOT_ENOUGH_CORE;
+		n = (UINT)1 << di->bits;
+		old = di->slot;
+		di->slot = ff_memalloc(n * 2 * sizeof (DIRSLOT));
+		if (!di->slot) {
+			di->slot = old;
+			return FR_NOT_ENOUGH_CORE;
+		}
+		memset(di->slot, 0, n * 2 * sizeof (DIRSLOT));
+		di->bits++;
+		di->used = 0;
+		for (i = 0; i < n; i++) {	/* Move the keys, the deleted slots are dropped */
+			if (old[i].tag > 1) dir_index_put(di, old[i].tag, old[i].ent);
+		}
+		ff_memfree(old);
+	}
+	dir_index_put(di, tag, (WORD)(ofs / SZDIRE));
+	return FR_OK;
+}
+
+
+static void dir_index_build (	/* Build the name index of a directory, di->slot is left NULL on failure */
+	DIRINDEX* di,
+	FF_DIR* dp		/* Directory to be indexed */
 )
 {
 	FRESULT res;
 	FATFS *fs = dp->obj.fs;
-	BYTE c;
+	FF_DIR dj;
+	BYTE c, a;
 #if FF_USE_LFN
-	BYTE a, ord, sum;
+	BYTE ord = 0xFF, sum = 0xFF;
+	DWORD hash = 0, blk = 0;
 #endif
 
-	res = dir_sdi(dp, 0);			/* Rewind directory object */
-	if (res != FR_OK) return res;
-#if FF_FS_EXFAT
-	if (fs->fs_type == FS_EXFAT) {	/* On the exFAT volume */
-		BYTE nc;
-		UINT di, ni;
-		WORD hash = xname_sum(fs->lfnbuf);		/* Hash value of the name to find */
 
-		while ((res = DIR_READ_FILE(dp)) == FR_OK) {	/* Read an item */
-#if FF_MAX_LFN < 255
-			if (fs->dirbuf[XDIR_NumName] > FF_MAX_LFN) continue;		/* Skip comparison if inaccessible object name */
-#endif
-			if (ld_word(fs->dirbuf + XDIR_NameHash) != hash) continue;	/* Skip comparison if hash mismatched */
-			for (nc = fs->dirbuf[XDIR_NumName], di = SZDIRE * 2, ni = 0; nc; nc--, di += 2, ni++) {	/* Compare the name */
-				if ((di % SZDIRE) == 0) di += 2;
-				if (ff_wtoupper(ld_word(fs->dirbuf + di)) != ff_wtoupper(fs->lfnbuf[ni])) break;
+	di->bits = DIR_INDEX_BITS_MIN;
+	di->used = 0;
+	di->slot = ff_memalloc(sizeof (DIRSLOT) << di->bits);
+	if (!di->slot) return;
+	memset(di->slot, 0, sizeof (DIRSLOT) << di->bits);
+
+	dj = *dp;
+	res = dir_sdi(&dj, 0);
+	while (res == FR_OK) {
+		res = move_window(fs, dj.sect);
+		if (res != FR_OK) break;
+		c = dj.dir[DIR_Name];
+		if (c == 0) { res = FR_NO_FILE; break; }	/* Reached to end of table */
+		a = dj.dir[DIR_Attr] & AM_MASK;
+#if FF_USE_LFN		/* LFN configuration, follow the entries in the same way as dir_find() */
+		if (c == DDEM || ((a & AM_VOL) && a != AM_LFN)) {	/* An entry without valid data */
+			ord = 0xFF;
+		} else {
+			if (a == AM_LFN) {			/* An LFN entry is found */
+				if (c & LLEF) {			/* Is it start of LFN sequence? */
+					sum = dj.dir[LDIR_Chksum];
+					c &= (BYTE)~LLEF; ord = c;
+					blk = dj.dptr; hash = 0;
+				}
+				if (c == ord && sum == dj.dir[LDIR_Chksum] && ld_word(dj.dir + LDIR_FstClusLO) == 0) {
+					hash += hash_lfn_ent(dj.dir);
+					ord--;
+				} else {
+					ord = 0xFF;
+				}
+			} else {					/* An SFN entry is found */
+				if (ord == 0 && sum == sum_sfn(dj.dir)) {	/* Has a valid LFN? */
+					res = dir_index_add(di, hash, blk);
+				} else {
+					blk = dj.dptr;
+				}
+				if (res == FR_OK) res = dir_index_add(di, hash_sfn(dj.dir), blk);
+				ord = 0xFF;
 			}
-			if (nc == 0 && !fs->lfnbuf[ni]) break;	/* Name matched? */
 		}
-		return res;
+#else		/* Non LFN configuration */
+		if (c != DDEM && !(a & AM_VOL)) res = dir_index_add(di, hash_sfn(dj.dir), dj.dptr);
+#endif
+		if (res == FR_OK) res = dir_next(&dj, 0);	/* Next entry */
+	}
+
+	if (res != FR_NO_FILE) {	/* Disk error, too large directory or not enough memory */
+		ff_memfree(di->slot);
+		di->slot = 0;
+	}
+}
+
+
+static void dir_index_new (	/* Create the name index of a directory in place of the least recently used one */
+	FF_DIR* dp
+)
+{
+	FATFS *fs = dp->obj.fs;
+	int vol = dir_index_vol(fs);
+	DIRINDEX *tbl = DirIndex[vol], *di = &tbl[0];
+	UINT i;
+
+
+	for (i = 1; i < FF_DIR_INDEX && di->fs; i++) {	/* Take an unused index or the least recently used one */
+		if (!tbl[i].fs || tbl[i].stamp < di->stamp) di = &tbl[i];
+	}
+	if (di->fs) dir_index_free(di);
+	di->fs = fs;
+	di->id = fs->id;
+	di->sclust = dp->obj.sclust;
+	di->stamp = ++DirIndexTime[vol];
+	dir_index_build(di, dp);	/* A directory which can not be indexed keeps the index without a table */
+}
+
+
+#if !FF_FS_READONLY
+static void dir_index_register (	/* Add a registered object to the name index of its directory */
+	FF_DIR* dp,						/* Directory object pointing the SFN entry of the object */
+	DWORD blk,						/* Offset of the top entry of the object */
+	int lfn							/* The object has an LFN */
+)
+{
+	FATFS *fs = dp->obj.fs;
+	DIRINDEX *di = dir_index_find(fs, dp->obj.sclust);
+
+
+	if (!di || !di->slot) return;
+#if FF_USE_LFN
+	if (lfn && dir_index_add(di, hash_lfn(fs->lfnbuf), blk) != FR_OK) {
+		dir_index_free(di);		/* Build it again on the next search */
+		return;
 	}
 #endif
-	/* On the FAT/FAT32 volume */
+	if (dir_index_add(di, hash_sfn(dp->fn), blk) != FR_OK) dir_index_free(di);
+}
+
+
+static void dir_index_remove (	/* Remove an object from the name index of its directory */
+	FF_DIR* dp,					/* Directory object of the object */
+	DWORD blk					/* Offset of the top entry of the object */
+)
+{
+	DIRINDEX *di = dir_index_find(dp->obj.fs, dp->obj.sclust);
+	UINT i;
+
+
+	if (!di || !di->slot) return;
+	for (i = 0; i < (UINT)1 << di->bits; i++) {
+		if (di->slot[i].tag > 1 && di->slot[i].ent == blk / SZDIRE) di->slot[i].tag = 1;	/* Mark the slot deleted */
+	}
+}
+
+
+static void dir_index_drop (	/* Discard the name index of a removed directory */
+	FATFS* fs,
+	DWORD sclust				/* Start cluster of the directory */
+)
+{
+	DIRINDEX *di = dir_index_find(fs, sclust);
+
+
+	if (di) dir_index_free(di);
+}
+#endif
+
+#endif	/* FF_DIR_INDEX */
+
+/*-----------------------------------------------------------------------*/
+/* Directory handling - Compare the entries with the name                */
+/*-----------------------------------------------------------------------*/
+
+static FRESULT dir_match (	/* FR_OK(0):found, FR_NO_FILE:not found, others:error */
+	FF_DIR* dp,				/* Pointer to the directory object with the file name, pointing the first entry to compare */
+	int one					/* 0:Compare up to the end of the table, 1:Compare only the object at the current entry */
+)
+{
+	FRESULT res;
+	FATFS *fs = dp->obj.fs;
+	BYTE c;
+#if FF_USE_LFN
+	BYTE a, ord, sum;
+#endif
+
 #if FF_USE_LFN
 	ord = sum = 0xFF; dp->blk_ofs = 0xFFFFFFFF;	/* Reset LFN sequence */
 #endif
@@ -2428,6 +2772,7 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 #if FF_USE_LFN		/* LFN configuration */
 		dp->obj.attr = a = dp->dir[DIR_Attr] & AM_MASK;
 		if (c == DDEM || ((a & AM_VOL) && a != AM_LFN)) {	/* An entry without valid data */
+			if (one) { res = FR_NO_FILE; break; }
 			ord = 0xFF; dp->blk_ofs = 0xFFFFFFFF;	/* Reset LFN sequence */
 		} else {
 			if (a == AM_LFN) {			/* An LFN entry is found */
@@ -2443,12 +2788,14 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 			} else {					/* An SFN entry is found */
 				if (ord == 0 && sum == sum_sfn(dp->dir)) break;	/* LFN matched? */
 				if (!(dp->fn[NSFLAG] & NS_LOSS) && !memcmp(dp->dir, dp->fn, 11)) break;	/* SFN matched? */
+				if (one) { res = FR_NO_FILE; break; }
 				ord = 0xFF; dp->blk_ofs = 0xFFFFFFFF;	/* Reset LFN sequence */
 			}
 		}
 #else		/* Non LFN configuration */
 		dp->obj.attr = dp->dir[DIR_Attr] & AM_MASK;
 		if (!(dp->dir[DIR_Attr] & AM_VOL) && !memcmp(dp->dir, dp->fn, 11)) break;	/* Is it a valid entry? */
+		if (one) { res = FR_NO_FILE; break; }
 #endif
 		res = dir_next(dp, 0);	/* Next entry */
 	} while (res == FR_OK);
@@ -2458,6 +2805,111 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 
 
 
+#if FF_DIR_INDEX
+/*-----------------------------------------------------------------------*/
+/* Directory handling - Find an object with the name index               */
+/*-----------------------------------------------------------------------*/
+
+static FRESULT dir_index_lookup (	/* FR_OK(0):succeeded, !=0:error */
+	FF_DIR* dp,						/* Pointer to the directory object with the file name */
+	DIRINDEX* di					/* Name index of the directory */
+)
+{
+	FRESULT res;
+	DWORD hash[2];
+	UINT n = 0, k, i, mask = ((UINT)1 << di->bits) - 1;
+	WORD tag;
+#if FF_USE_LFN
+	FATFS *fs = dp->obj.fs;
+
+	if (!(dp->fn[NSFLAG] & NS_NOLFN)) hash[n++] = hash_lfn(fs->lfnbuf);	/* The name can match an LFN */
+	if (!(dp->fn[NSFLAG] & NS_LOSS)) hash[n++] = hash_sfn(dp->fn);		/* The name can match an SFN */
+#else
+	hash[n++] = hash_sfn(dp->fn);
+#endif
+	for (k = 0; k < n; k++) {
+		tag = (WORD)(hash[k] >> 16);
+		if (tag < 2) tag += 2;
+		for (i = tag >> (16 - di->bits); di->slot[i].tag; i = (i + 1) & mask) {	/* Compare the objects with the same tag */
+			if (di->slot[i].tag != tag) continue;
+			res = dir_sdi(dp, (DWORD)di->slot[i].ent * SZDIRE);
+			if (res != FR_OK) return res;
+#if FF_USE_LFN
+			res = move_window(dp->obj.fs, dp->sect);
+			if (res != FR_OK) return res;
+			if ((dp->dir[DIR_Attr] & AM_MASK) == AM_LFN && !(dp->dir[DIR_Name] & LLEF)) continue;	/* The object has been replaced */
+#endif
+			res = dir_match(dp, 1);
+			if (res != FR_NO_FILE) return res;
+		}
+	}
+	return FR_NO_FILE;
+}
+
+#endif
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Directory handling - Find an object in the directory                  */
+/*-----------------------------------------------------------------------*/
+
+static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
+	FF_DIR* dp					/* Pointer to the directory object with the file name */
+)
+{
+	FRESULT res;
+#if FF_FS_EXFAT || FF_DIR_INDEX
+	FATFS *fs = dp->obj.fs;
+#endif
+#if FF_DIR_INDEX
+	DIRINDEX *di = 0;
+#endif
+
+	res = dir_sdi(dp, 0);			/* Rewind directory object */
+	if (res != FR_OK) return res;
+#if FF_FS_EXFAT
+	if (fs->fs_type == FS_EXFAT) {	/* On the exFAT volume */
+		BYTE nc;
+		UINT di, ni;
+		WORD hash = xname_sum(fs->lfnbuf);		/* Hash value of the name to find */
+
+		while ((res = DIR_READ_FILE(dp)) == FR_OK) {	/* Read an item */
+#if FF_MAX_LFN < 255
+			if (fs->dirbuf[XDIR_NumName] > FF_MAX_LFN) continue;		/* Skip comparison if inaccessible object name */
+#endif
+			if (ld_word(fs->dirbuf + XDIR_NameHash) != hash) continue;	/* Skip comparison if hash mismatched */
+			for (nc = fs->dirbuf[XDIR_NumName], di = SZDIRE * 2, ni = 0; nc; nc--, di += 2, ni++) {	/* Compare the name */
+				if ((di % SZDIRE) == 0) di += 2;
+				if (ff_wtoupper(ld_word(fs->dirbuf + di)) != ff_wtoupper(fs->lfnbuf[ni])) break;
+			}
+			if (nc == 0 && !fs->lfnbuf[ni]) break;	/* Name matched? */
+		}
+		return res;
+	}
+#endif
+	/* On the FAT/FAT32 volume */
+#if FF_DIR_INDEX
+	if (!(dp->fn[NSFLAG] & NS_DOT)) {	/* Dot entries are found without the index */
+		di = dir_index_find(fs, dp->obj.sclust);
+		if (di) {
+			di->stamp = ++DirIndexTime[dir_index_vol(fs)];
+			if (di->slot) return dir_index_lookup(dp, di);
+		}
+	}
+#endif
+	res = dir_match(dp, 0);
+#if FF_DIR_INDEX
+	if (!di && !(dp->fn[NSFLAG] & NS_DOT) && (res == FR_OK || res == FR_NO_FILE) && dp->dptr >= DIR_INDEX_MIN_ENT * SZDIRE) {
+		dir_index_new(dp);			/* Index the large directory for the next searches */
+		if (dp->sect && move_window(fs, dp->sect) != FR_OK) res = FR_DISK_ERR;	/* Reload the entry found */
+	}
+#endif
+	return res;
+}
+
+
+
 
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
@@ -2557,6 +3009,16 @@ static FRESULT dir_register (	/* FR_OK:succeeded, FR_DENIED:no free entry or too
 			fs->wflag = 1;
 		}
 	}
+#if FF_DIR_INDEX
+	if (res == FR_OK) {
+#if FF_USE_LFN
+		n = (sn[NSFLAG] & NS_LFN) ? (len + 12) / 13 : 0;	/* Number of LFN entries */
+		dir_index_register(dp, dp->dptr - n * SZDIRE, n != 0);
+#else
+		dir_index_register(dp, dp->dptr, 0);
+#endif
+	}
+#endif
 
 	return res;
 }
@@ -2579,6 +3041,9 @@ static FRESULT dir_remove (	/* FR_OK:Succeeded, FR_DISK_ERR:A disk error */
 #if FF_USE_LFN		/* LFN configuration */
 	DWORD last = dp->dptr;
 
+#if FF_DIR_INDEX
+	dir_index_remove(dp, (dp->blk_ofs == 0xFFFFFFFF) ? dp->dptr : dp->blk_ofs);
+#endif
 	res = (dp->blk_ofs == 0xFFFFFFFF) ? FR_OK : dir_sdi(dp, dp->blk_ofs);	/* Goto top of the entry block if LFN is exist */
 	if (res == FR_OK) {
 		do {
@@ -2597,6 +3062,9 @@ static FRESULT dir_remove (	/* FR_OK:Succeeded, FR_DISK_ERR:A disk error */
 	}
 #else			/* Non LFN configuration */
 
+#if FF_DIR_INDEX
+	dir_index_remove(dp, dp->dptr);
+#endif
 	res = move_window(fs, dp->sect);
 	if (res == FR_OK) {
 		dp->dir[DIR_Name] = DDEM;	/* Mark the entry 'deleted'.*/
@@ -3594,6 +4062,9 @@ static FRESULT mount_volume (	/* FR_OK(0): successful, !=0: an error occurred */
 
 	fs->fs_type = (BYTE)fmt;/* FAT sub-type (the filesystem object gets valid) */
 	fs->id = ++Fsid;		/* Volume mount ID */
+#if FF_DIR_INDEX
+	dir_index_clear(fs);	/* Discard the name indexes of the previous mount */
+#endif
 #if FF_USE_LFN == 1
 	fs->lfnbuf = LfnBuf;	/* Static LFN working buffer */
 #if FF_FS_EXFAT
@@ -3678,6 +4149,9 @@ FRESULT f_mount (
 	cfs = FatFs[vol];			/* Pointer to the filesystem object of the volume */
 
 	if (cfs) {					/* Unregister current filesystem object if regsitered */
+#if FF_DIR_INDEX
+		dir_index_clear(cfs);	/* Discard the name indexes of the volume */
+#endif
 		FatFs[vol] = 0;
 #if FF_FS_LOCK
 		clear_share(cfs);
@@ -3996,7 +4470,13 @@ FRESULT f_read (
 				if (csect + cc > fs->csize) {	/* Clip at cluster boundary */
 					cc = fs->csize - csect;
 				}
+#if FF_FS_REENTRANT && FF_FS_CONCURRENT_READ && !FF_FS_TINY
+				res = read_unlocked(&fp->obj, rbuff, sect, cc);
+				if (res == FR_TIMEOUT) return res;	/* The volume is not locked anymore */
+				if (res != FR_OK) ABORT(fs, res);
+#else
 				if (disk_read(fs->pdrv, rbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
+#endif
 #if !FF_FS_READONLY && FF_FS_MINIMIZE <= 2		/* Replace one of the read sectors with cached data if it contains a dirty sector */
 #if FF_FS_TINY
 				if (fs->wflag && fs->winsect - sect < cc) {
@@ -4019,7 +4499,13 @@ FRESULT f_read (
 					fp->flag &= (BYTE)~FA_DIRTY;
 				}
 #endif
+#if FF_FS_REENTRANT && FF_FS_CONCURRENT_READ
+				res = read_unlocked(&fp->obj, fp->buf, sect, 1);	/* Fill sector cache */
+				if (res == FR_TIMEOUT) return res;	/* The volume is not locked anymore */
+				if (res != FR_OK) ABORT(fs, res);
+#else
 				if (disk_read(fs->pdrv, fp->buf, sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);	/* Fill sector cache */
+#endif
 			}
 #endif
 			fp->sect = sect;
@@ -5068,6 +5554,9 @@ FRESULT f_unlink (
 			}
 			if (res == FR_OK) {
 				res = dir_remove(&dj);			/* Remove the directory entry */
+#if FF_DIR_INDEX
+				if (res == FR_OK && (dj.obj.attr & AM_DIR)) dir_index_drop(fs, dclst);	/* Discard the index of the removed directory */
+#endif
 				if (res == FR_OK && dclst != 0) {	/* Remove the cluster chain if exist */
 #if FF_FS_EXFAT
 					res = remove_chain(&obj, dclst, 0);
@@ -339,6 +339,25 @@
 /  The FF_FS_TIMEOUT defines timeout period in unit of O/S time tick.
 */
 
+#define FF_DIR_INDEX	CONFIG_FATFS_DIR_INDEX_DIRS
+/* The option FF_DIR_INDEX defines the number of directories of each volume which
+/  have a name index in the memory. The index of a large directory is built after
+/  a search in it and avoids reading the whole directory to find an object in it.
+/
+/   0: Disable the name index.
+/  >0: Number of indexed directories of each volume.
+*/
+
+#define FF_FS_CONCURRENT_READ	CONFIG_FATFS_CONCURRENT_READ
+/* The option FF_FS_CONCURRENT_READ releases the volume lock while f_read() reads file
+/  data sectors from the drive, so that other tasks can access the volume meanwhile.
+/  It requires FF_FS_REENTRANT == 1 and FF_FS_TINY == 0, and a disk driver which can
+/  handle a read while another request is in progress.
+/
+/   0: The volume is locked during the whole f_read().
+/   1: The volume is unlocked during the data sector reads of f_read().
+*/
+
 #define FF_USE_DYN_BUFFER CONFIG_FATFS_USE_DYN_BUFFERS
 /* The option FF_USE_DYN_BUFFER controls source of size used for buffers in the FS and FIL objects.
 /
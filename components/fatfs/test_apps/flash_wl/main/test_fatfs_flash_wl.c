@@ -176,6 +176,13 @@ TEST_CASE("(WL) pwrite() works well", "[fatfs][wear_levelling]")
     test_teardown();
 }
 
+TEST_CASE("(WL) readv(), writev(), preadv() and pwritev() work well", "[fatfs][wear_levelling]")
+{
+    test_setup();
+    test_fatfs_readv_writev("/spiflash/hello.txt");
+    test_teardown();
+}
+
 TEST_CASE("(WL) can open maximum number of files", "[fatfs][wear_levelling]")
 {
     size_t max_files = FOPEN_MAX - 3; /* account for stdin, stdout, stderr */
@@ -281,6 +288,13 @@ TEST_CASE("(WL) readdir, stat work as expected", "[fatfs][wear_levelling]")
     test_teardown();
 }
 
+TEST_CASE("(WL) files can be found in a large directory after it is modified", "[fatfs][wear_levelling]")
+{
+    test_setup();
+    test_fatfs_large_dir("/spiflash/large");
+    test_teardown();
+}
+
 TEST_CASE("(WL) opendir, readdir, rewinddir, seekdir work as expected", "[fatfs][wear_levelling]")
 {
     test_setup();
@@ -15,6 +15,9 @@ from pytest_embedded import Dut
         'fastseek',
         'auto_fsync',
         'no_dyn_buffers',
+        'block_cache',
+        'concurrent_read',
+        'dir_index',
     ]
 )
 def test_fatfs_flash_wl_generic(dut: Dut) -> None:
@@ -13,6 +13,7 @@
 #include <sys/time.h>
 #include <sys/unistd.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <errno.h>
 #include <utime.h>
 #include "unity.h"
@@ -198,6 +199,45 @@ void test_fatfs_pwrite_file(const char *filename)
     test_file_content(filename, "Hello, Dolly!");
 }
 
+void test_fatfs_readv_writev(const char* filename)
+{
+    int fd = open(filename, O_RDWR | O_CREAT | O_TRUNC);
+    TEST_ASSERT_NOT_EQUAL(-1, fd);
+
+    char hello[] = "Hello";
+    char sep[] = ", ";
+    char world[] = "world!";
+    const struct iovec wr_iov[] = {
+        { .iov_base = hello, .iov_len = strlen(hello) },
+        { .iov_base = sep, .iov_len = strlen(sep) },
+        { .iov_base = world, .iov_len = strlen(world) },
+    };
+    TEST_ASSERT_EQUAL(13, writev(fd, wr_iov, 3));
+    TEST_ASSERT_EQUAL(5, pwritev(fd, wr_iov, 1, 7));
+
+    char buf1[4] = { 0 };
+    char buf2[16] = { 0 };
+    const struct iovec rd_iov[] = {
+        { .iov_base = buf1, .iov_len = sizeof(buf1) - 1 },
+        { .iov_base = buf2, .iov_len = sizeof(buf2) - 1 },
+    };
+    TEST_ASSERT_EQUAL(0, lseek(fd, 0, SEEK_SET));
+    // The second buffer is only partially filled at the end of the file
+    TEST_ASSERT_EQUAL(13, readv(fd, rd_iov, 2));
+    TEST_ASSERT_EQUAL_STRING("Hel", buf1);
+    TEST_ASSERT_EQUAL_STRING("lo, Hello!", buf2);
+
+    memset(buf1, 0, sizeof(buf1));
+    memset(buf2, 0, sizeof(buf2));
+    TEST_ASSERT_EQUAL(6, preadv(fd, rd_iov, 2, 7));
+    TEST_ASSERT_EQUAL_STRING("Hel", buf1);
+    TEST_ASSERT_EQUAL_STRING("lo!", buf2);
+    // preadv does not move the file position
+    TEST_ASSERT_EQUAL(13, lseek(fd, 0, SEEK_CUR));
+
+    TEST_ASSERT_EQUAL(0, close(fd));
+}
+
 void test_fatfs_open_max_files(const char* filename_prefix, size_t files_count)
 {
     FILE** files = calloc(files_count, sizeof(FILE*));
@@ -816,6 +856,80 @@ void test_fatfs_readdir_stat(const char* dir_prefix)
     }
 }
 
+static void create_empty_file(const char* name)
+{
+    FILE* f = fopen(name, "w");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(0, fclose(f));
+}
+
+static void large_dir_file_name(char* name, size_t size, const char* dir_prefix, int i)
+{
+#if CONFIG_FATFS_LFN_NONE
+    snprintf(name, size, "%s/f%04d.txt", dir_prefix, i);
+#else
+    snprintf(name, size, (i % 2) ? "%s/f%04d.txt" : "%s/long file name %d.txt", dir_prefix, i);
+#endif
+}
+
+void test_fatfs_large_dir(const char* dir_prefix)
+{
+    char name[64];
+    char name_dst[64];
+    const int file_num = 300;   // empty files, they don't need clusters
+    struct stat st;
+
+    TEST_ASSERT_EQUAL(0, mkdir(dir_prefix, 0755));
+    for (int i = 0; i < file_num; i++) {
+        large_dir_file_name(name, sizeof(name), dir_prefix, i);
+        create_empty_file(name);
+    }
+
+    // the first searches go through the whole directory, the next ones may use the name index
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < file_num; i++) {
+            large_dir_file_name(name, sizeof(name), dir_prefix, i);
+            TEST_ASSERT_EQUAL(0, stat(name, &st));
+            TEST_ASSERT_TRUE(S_ISREG(st.st_mode));
+        }
+        snprintf(name, sizeof(name), "%s/missing.txt", dir_prefix);
+        TEST_ASSERT_EQUAL(-1, stat(name, &st));
+    }
+
+    // the searches must see the files removed, renamed and created after the first ones
+    for (int i = 0; i < file_num; i += 3) {
+        large_dir_file_name(name, sizeof(name), dir_prefix, i);
+        TEST_ASSERT_EQUAL(0, unlink(name));
+    }
+    for (int i = 1; i < file_num; i += 3) {
+        large_dir_file_name(name, sizeof(name), dir_prefix, i);
+        large_dir_file_name(name_dst, sizeof(name_dst), dir_prefix, i + file_num);
+        TEST_ASSERT_EQUAL(0, rename(name, name_dst));
+    }
+    for (int i = 0; i < file_num; i += 3) {
+        large_dir_file_name(name, sizeof(name), dir_prefix, i + 2 * file_num);
+        create_empty_file(name);
+    }
+    for (int i = 0; i < file_num; i++) {
+        large_dir_file_name(name, sizeof(name), dir_prefix, i);
+        TEST_ASSERT_EQUAL(i % 3 == 2 ? 0 : -1, stat(name, &st));
+        large_dir_file_name(name, sizeof(name), dir_prefix, i + file_num);
+        TEST_ASSERT_EQUAL(i % 3 == 1 ? 0 : -1, stat(name, &st));
+        large_dir_file_name(name, sizeof(name), dir_prefix, i + 2 * file_num);
+        TEST_ASSERT_EQUAL(i % 3 == 0 ? 0 : -1, stat(name, &st));
+    }
+
+    DIR* dir = opendir(dir_prefix);
+    TEST_ASSERT_NOT_NULL(dir);
+    struct dirent* de;
+    while ((de = readdir(dir)) != NULL) {
+        snprintf(name, sizeof(name), "%s/%s", dir_prefix, de->d_name);
+        TEST_ASSERT_EQUAL(0, unlink(name));
+    }
+    TEST_ASSERT_EQUAL(0, closedir(dir));
+    TEST_ASSERT_EQUAL(0, rmdir(dir_prefix));
+}
+
 void test_fatfs_opendir_readdir_rewinddir(const char* dir_prefix)
 {
     char name_dir_inner_file[64];
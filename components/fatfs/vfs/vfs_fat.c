@@ -79,6 +79,8 @@ static const char* TAG = "vfs_fat";
 static ssize_t vfs_fat_write(void* p, int fd, const void * data, size_t size);
 static off_t vfs_fat_lseek(void* p, int fd, off_t size, int mode);
 static ssize_t vfs_fat_read(void* ctx, int fd, void * dst, size_t size);
+static ssize_t vfs_fat_writev(void *ctx, int fd, const struct iovec *iov, int iovcnt);
+static ssize_t vfs_fat_readv(void *ctx, int fd, const struct iovec *iov, int iovcnt);
 static ssize_t vfs_fat_pread(void *ctx, int fd, void *dst, size_t size, off_t offset);
 static ssize_t vfs_fat_pwrite(void *ctx, int fd, const void *src, size_t size, off_t offset);
 static int vfs_fat_open(void* ctx, const char * path, int flags, int mode);
@@ -159,6 +161,8 @@ esp_err_t esp_vfs_fat_register_cfg(const esp_vfs_fat_conf_t* conf, FATFS** out_f
         .read_p = &vfs_fat_read,
         .pread_p = &vfs_fat_pread,
         .pwrite_p = &vfs_fat_pwrite,
+        .writev_p = &vfs_fat_writev,
+        .readv_p = &vfs_fat_readv,
         .open_p = &vfs_fat_open,
         .close_p = &vfs_fat_close,
         .fstat_p = &vfs_fat_fstat,
@@ -488,6 +492,88 @@ static ssize_t vfs_fat_read(void* ctx, int fd, void * dst, size_t size)
     return read;
 }
 
+/* Writes all buffers under a single lock, with one seek for O_APPEND and one sync for CONFIG_FATFS_IMMEDIATE_FSYNC */
+static ssize_t vfs_fat_writev(void *ctx, int fd, const struct iovec *iov, int iovcnt)
+{
+    vfs_fat_ctx_t *fat_ctx = (vfs_fat_ctx_t *) ctx;
+    FIL *file = &fat_ctx->files[fd];
+    FRESULT res;
+    _lock_acquire(&fat_ctx->lock);
+    if (fat_ctx->o_append[fd]) {
+        if ((res = f_lseek(file, f_size(file))) != FR_OK) {
+            ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
+            errno = fresult_to_errno(res);
+            _lock_release(&fat_ctx->lock);
+            return -1;
+        }
+    }
+    ssize_t total = 0;
+    bool size_requested = false;
+    for (int i = 0; i < iovcnt; ++i) {
+        unsigned written = 0;
+        size_requested |= iov[i].iov_len != 0;
+        res = f_write(file, iov[i].iov_base, iov[i].iov_len, &written);
+        total += written;
+        if (res != FR_OK) {
+            ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
+            errno = fresult_to_errno(res);
+            if (total == 0) {
+                _lock_release(&fat_ctx->lock);
+                return -1;
+            }
+            break;
+        }
+        if (written < iov[i].iov_len) {
+            break;
+        }
+    }
+    if (total == 0 && size_requested) {
+        errno = ENOSPC;
+        _lock_release(&fat_ctx->lock);
+        return -1;
+    }
+
+#if CONFIG_FATFS_IMMEDIATE_FSYNC
+    if (total > 0) {
+        res = f_sync(file);
+        if (res != FR_OK) {
+            ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
+            errno = fresult_to_errno(res);
+            _lock_release(&fat_ctx->lock);
+            return -1;
+        }
+    }
+#endif
+    _lock_release(&fat_ctx->lock);
+    return total;
+}
+
+static ssize_t vfs_fat_readv(void *ctx, int fd, const struct iovec *iov, int iovcnt)
+{
+    vfs_fat_ctx_t *fat_ctx = (vfs_fat_ctx_t *) ctx;
+    FIL *file = &fat_ctx->files[fd];
+    ssize_t total = 0;
+    _lock_acquire(&fat_ctx->lock);
+    for (int i = 0; i < iovcnt; ++i) {
+        unsigned read = 0;
+        FRESULT res = f_read(file, iov[i].iov_base, iov[i].iov_len, &read);
+        total += read;
+        if (res != FR_OK) {
+            ESP_LOGD(TAG, "%s: fresult=%d", __func__, res);
+            errno = fresult_to_errno(res);
+            if (total == 0) {
+                total = -1;
+            }
+            break;
+        }
+        if (read < iov[i].iov_len) {
+            break;
+        }
+    }
+    _lock_release(&fat_ctx->lock);
+    return total;
+}
+
 static ssize_t vfs_fat_pread(void *ctx, int fd, void *dst, size_t size, off_t offset)
 {
     ssize_t ret = -1;
@@ -47,6 +47,9 @@
 /* Include private IDF API additions for critical thread safety macros */
 #include "esp_private/freertos_idf_additions_priv.h"
 #include "freertos/idf_additions.h"
+#if ( CONFIG_FREERTOS_TASK_PROFILING == 1 )
+    #include "esp_cpu.h"
+#endif
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
@@ -461,6 +464,17 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( CONFIG_FREERTOS_TASK_PROFILING == 1 )
+        uint64_t ullProfRunTimeCycles;     /*< Number of CPU cycles the task has been running for. */
+        uint32_t ulProfContextSwitches;    /*< Number of times the task was switched in. */
+        uint32_t ulProfPreemptions;        /*< Number of times the task was switched out while still ready to run. */
+        uint32_t ulProfCoreMigrations;     /*< Number of times the task was switched in on another core than the last time. */
+        TickType_t xProfMaxBlockedTicks;   /*< Longest time between being switched out while blocked and being switched in again. */
+        TickType_t xProfBlockedSinceTick;  /*< Tick count when the task was last switched out while blocked. */
+        uint8_t ucProfBlocked;             /*< Set to pdTRUE while xProfBlockedSinceTick is valid. */
+        uint8_t ucProfLastCoreID;          /*< The core the task last ran on plus 1, or 0 if it never ran. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -537,6 +551,15 @@ PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL
 
 #endif
 
+#if ( CONFIG_FREERTOS_TASK_PROFILING == 1 )
+
+/* The cycle counters of the cores are not synchronized, so only the difference
+ * between two reads on the same core is used. */
+PRIVILEGED_DATA static uint32_t ulProfSwitchedInCycles[ configNUMBER_OF_CORES ] = { 0UL }; /*< Cycle count of each core the last time a task was switched in. */
+PRIVILEGED_DATA static BaseType_t xProfStarted[ configNUMBER_OF_CORES ] = { pdFALSE };     /*< Set once ulProfSwitchedInCycles is valid for a core. */
+
+#endif
+
 /* Spinlock required for SMP critical sections. This lock protects all of the
  * kernel's data structures such as various tasks lists, flags, and tick counts. */
 PRIVILEGED_DATA static portMUX_TYPE xKernelLock = portMUX_INITIALIZER_UNLOCKED;
@@ -3648,6 +3671,73 @@ get_next_task:
 #endif /* configNUMBER_OF_CORES > 1 */
 /*-----------------------------------------------------------*/
 
+#if ( CONFIG_FREERTOS_TASK_PROFILING == 1 )
+
+/*
+ * Update the profiling counters of the task switched out and the task switched
+ * in on a core. Called from vTaskSwitchContext() after the next task was
+ * selected. IDF addition.
+ */
+    static void prvProfileTaskSwitch( BaseType_t xCoreID,
+                                      TCB_t * pxPrevTCB )
+    {
+        const uint32_t ulNow = ( uint32_t ) esp_cpu_get_cycle_count();
+        TCB_t * const pxNextTCB = pxCurrentTCBs[ xCoreID ];
+
+        if( xProfStarted[ xCoreID ] != pdFALSE )
+        {
+            pxPrevTCB->ullProfRunTimeCycles += ( uint32_t ) ( ulNow - ulProfSwitchedInCycles[ xCoreID ] );
+        }
+        else
+        {
+            xProfStarted[ xCoreID ] = pdTRUE;
+        }
+
+        ulProfSwitchedInCycles[ xCoreID ] = ulNow;
+
+        if( pxNextTCB != pxPrevTCB )
+        {
+            /* A task leaving the CPU while it's still in a ready list was
+             * preempted (or yielded), otherwise it blocked or was suspended. */
+            if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPrevTCB->uxPriority ] ), &( pxPrevTCB->xStateListItem ) ) != pdFALSE )
+            {
+                pxPrevTCB->ulProfPreemptions++;
+            }
+            else
+            {
+                pxPrevTCB->xProfBlockedSinceTick = xTickCount;
+                pxPrevTCB->ucProfBlocked = pdTRUE;
+            }
+
+            pxNextTCB->ulProfContextSwitches++;
+
+            if( pxNextTCB->ucProfBlocked != pdFALSE )
+            {
+                const TickType_t xBlockedTicks = xTickCount - pxNextTCB->xProfBlockedSinceTick;
+
+                if( xBlockedTicks > pxNextTCB->xProfMaxBlockedTicks )
+                {
+                    pxNextTCB->xProfMaxBlockedTicks = xBlockedTicks;
+                }
+
+                pxNextTCB->ucProfBlocked = pdFALSE;
+            }
+
+            if( pxNextTCB->ucProfLastCoreID != ( uint8_t ) ( xCoreID + 1 ) )
+            {
+                if( pxNextTCB->ucProfLastCoreID != 0U )
+                {
+                    pxNextTCB->ulProfCoreMigrations++;
+                }
+
+                pxNextTCB->ucProfLastCoreID = ( uint8_t ) ( xCoreID + 1 );
+            }
+        }
+    }
+
+#endif /* CONFIG_FREERTOS_TASK_PROFILING */
+/*-----------------------------------------------------------*/
+
 void vTaskSwitchContext( void )
 {
     /* For SMP, we need to take the kernel lock here as we are about to access
@@ -3669,6 +3759,10 @@ void vTaskSwitchContext( void )
             xYieldPending[ xCurCoreID ] = pdFALSE;
             traceTASK_SWITCHED_OUT();
 
+            #if ( CONFIG_FREERTOS_TASK_PROFILING == 1 )
+                TCB_t * const pxPrevTCB = pxCurrentTCBs[ xCurCoreID ];
+            #endif
+
             #if ( configGENERATE_RUN_TIME_STATS == 1 )
             {
                 #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
@@ -3712,6 +3806,12 @@ void vTaskSwitchContext( void )
             taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
             traceTASK_SWITCHED_IN();
 
+            #if ( CONFIG_FREERTOS_TASK_PROFILING == 1 )
+            {
+                prvProfileTaskSwitch( xCurCoreID, pxPrevTCB );
+            }
+            #endif
+
             /* After the new task is switched in, update the global errno. */
             #if ( configUSE_POSIX_ERRNO == 1 )
             {
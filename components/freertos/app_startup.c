@@ -29,6 +29,9 @@
 #ifdef CONFIG_ESP_SYSTEM_GDBSTUB_RUNTIME
 #include "esp_gdbstub.h"                    /* Required by esp_gdbstub_init() */
 #endif // CONFIG_ESP_SYSTEM_GDBSTUB_RUNTIME
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+#include "esp_boot_trace.h"                 /* Required by esp_boot_trace_record() */
+#endif // CONFIG_BOOTLOADER_BOOT_TRACE
 
 /* ------------------------------------------------- App/OS Startup ----------------------------------------------------
  * - Functions related to application and FreeRTOS startup
@@ -205,6 +208,9 @@ static void main_task(void* args)
     */
     ESP_LOGI(MAIN_TAG, "Calling app_main()");
     extern void app_main(void);
+#if CONFIG_BOOTLOADER_BOOT_TRACE
+    esp_boot_trace_record(ESP_BOOT_TRACE_APP_MAIN);
+#endif
     app_main();
     ESP_LOGI(MAIN_TAG, "Returned from app_main()");
     vTaskDelete(NULL);
@@ -547,6 +547,41 @@ BaseType_t xTaskGetCoreID( TaskHandle_t xTask )
 #endif /* ( !CONFIG_FREERTOS_SMP && ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( !CONFIG_FREERTOS_SMP && ( CONFIG_FREERTOS_TASK_PROFILING == 1 ) )
+
+    void vTaskGetProfilingInfo( TaskHandle_t xTask,
+                                TaskProfilingInfo_t * pxProfilingInfo )
+    {
+        TCB_t * pxTCB;
+
+        configASSERT( pxProfilingInfo != NULL );
+
+        taskENTER_CRITICAL( &xKernelLock );
+        {
+            const BaseType_t xCoreID = portGET_CORE_ID();
+
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxProfilingInfo->ullRunTimeCycles = pxTCB->ullProfRunTimeCycles;
+            pxProfilingInfo->ulContextSwitches = pxTCB->ulProfContextSwitches;
+            pxProfilingInfo->ulPreemptions = pxTCB->ulProfPreemptions;
+            pxProfilingInfo->ulCoreMigrations = pxTCB->ulProfCoreMigrations;
+            pxProfilingInfo->xMaxBlockedTicks = pxTCB->xProfMaxBlockedTicks;
+            pxProfilingInfo->xLastCoreID = ( pxTCB->ucProfLastCoreID != 0U ) ? ( BaseType_t ) ( pxTCB->ucProfLastCoreID - 1U ) : tskNO_AFFINITY;
+
+            /* Include the current time slice if the task is running on this
+             * core. The cycle count of the other core can't be read. */
+            if( ( pxTCB == pxCurrentTCBs[ xCoreID ] ) && ( xProfStarted[ xCoreID ] != pdFALSE ) )
+            {
+                pxProfilingInfo->ullRunTimeCycles += ( uint32_t ) ( ( uint32_t ) esp_cpu_get_cycle_count() - ulProfSwitchedInCycles[ xCoreID ] );
+            }
+        }
+        taskEXIT_CRITICAL( &xKernelLock );
+    }
+
+#endif /* ( !CONFIG_FREERTOS_SMP && ( CONFIG_FREERTOS_TASK_PROFILING == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 uint8_t * pxTaskGetStackStart( TaskHandle_t xTask )
 {
     TCB_t * pxTCB;
@@ -0,0 +1,295 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * This file contains the implementation of the job pool functions in
+ * job_pool.h
+ *
+ * Each core has a slot holding a range of chunk indices. The task processing
+ * a slot takes chunks from the front of its range and, once its range is
+ * empty, steals the back half of the range of another slot. Every slot is
+ * protected by its own spinlock, which is only held for a few instructions.
+ *
+ * The calling task of vJobPoolParallelFor() processes the slot of the core it
+ * runs on and wakes the workers of the other cores, then waits for each woken
+ * worker to give the xDone semaphore. A worker only gives it once it can't
+ * find any chunk left, so no worker accesses the job after the call returned.
+ */
+
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/job_pool.h"
+#include "esp_heap_caps.h"
+
+/* Number of chunks per core if the caller does not set a chunk size. */
+#define jobpoolDEFAULT_CHUNKS_PER_CORE    4
+
+typedef struct
+{
+    portMUX_TYPE xLock;
+    size_t xNext; /*< Next chunk to be processed by the owner of the slot */
+    size_t xEnd;  /*< One past the last chunk of the slot */
+} JobPoolSlot_t;
+
+struct JobPool
+{
+    SemaphoreHandle_t xMutex;     /*< Serializes vJobPoolParallelFor() calls */
+    SemaphoreHandle_t xDone;      /*< Given by a worker when it has finished its part of a job */
+    TaskHandle_t xWorkers[ configNUMBER_OF_CORES ];
+    UBaseType_t uxWorkerCount;
+    volatile BaseType_t xDeleting;
+    JobPoolFunction_t pxFunction;
+    void * pvArg;
+    size_t xCount;
+    size_t xChunkSize;
+    JobPoolSlot_t xSlots[ configNUMBER_OF_CORES ];
+};
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+static BaseType_t prvTakeChunk( JobPoolSlot_t * pxSlot,
+                                size_t * pxChunk )
+{
+    BaseType_t xFound = pdFALSE;
+
+    portENTER_CRITICAL( &pxSlot->xLock );
+    {
+        if( pxSlot->xNext < pxSlot->xEnd )
+        {
+            *pxChunk = pxSlot->xNext++;
+            xFound = pdTRUE;
+        }
+    }
+    portEXIT_CRITICAL( &pxSlot->xLock );
+
+    return xFound;
+}
+
+static BaseType_t prvStealChunks( struct JobPool * pxJobPool,
+                                  BaseType_t xSlot )
+{
+    for( BaseType_t x = 1; x < configNUMBER_OF_CORES; x++ )
+    {
+        JobPoolSlot_t * pxVictim = &pxJobPool->xSlots[ ( xSlot + x ) % configNUMBER_OF_CORES ];
+        size_t xStart = 0;
+        size_t xEnd = 0;
+
+        portENTER_CRITICAL( &pxVictim->xLock );
+        {
+            if( pxVictim->xNext < pxVictim->xEnd )
+            {
+                /* Take the back half, rounded up so a single remaining chunk can be stolen as well */
+                xEnd = pxVictim->xEnd;
+                xStart = xEnd - ( xEnd - pxVictim->xNext + 1 ) / 2;
+                pxVictim->xEnd = xStart;
+            }
+        }
+        portEXIT_CRITICAL( &pxVictim->xLock );
+
+        if( xStart != xEnd )
+        {
+            JobPoolSlot_t * pxOwn = &pxJobPool->xSlots[ xSlot ];
+
+            portENTER_CRITICAL( &pxOwn->xLock );
+            {
+                pxOwn->xNext = xStart;
+                pxOwn->xEnd = xEnd;
+            }
+            portEXIT_CRITICAL( &pxOwn->xLock );
+
+            return pdTRUE;
+        }
+    }
+
+    return pdFALSE;
+}
+
+static void prvRunJob( struct JobPool * pxJobPool,
+                       BaseType_t xSlot )
+{
+    size_t xChunk;
+
+    do
+    {
+        while( prvTakeChunk( &pxJobPool->xSlots[ xSlot ], &xChunk ) != pdFALSE )
+        {
+            size_t xStart = xChunk * pxJobPool->xChunkSize;
+            size_t xEnd = pxJobPool->xCount - xStart;
+
+            xEnd = xStart + ( ( xEnd < pxJobPool->xChunkSize ) ? xEnd : pxJobPool->xChunkSize );
+            pxJobPool->pxFunction( pxJobPool->pvArg, xStart, xEnd );
+        }
+    } while( prvStealChunks( pxJobPool, xSlot ) != pdFALSE );
+}
+
+static void prvJobPoolWorker( void * pvParameters )
+{
+    struct JobPool * pxJobPool = ( struct JobPool * ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        if( pxJobPool->xDeleting != pdFALSE )
+        {
+            break;
+        }
+
+        /* Workers are pinned, so the core ID is also the slot of the worker */
+        prvRunJob( pxJobPool, xPortGetCoreID() );
+        ( void ) xSemaphoreGive( pxJobPool->xDone );
+    }
+
+    ( void ) xSemaphoreGive( pxJobPool->xDone );
+    vTaskDelete( NULL );
+}
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+JobPoolHandle_t xJobPoolCreate( const char * pcName,
+                                UBaseType_t uxPriority,
+                                configSTACK_DEPTH_TYPE usStackDepth )
+{
+    struct JobPool * pxJobPool;
+
+    /* The pool contains spinlocks, so it must be in internal memory */
+    pxJobPool = heap_caps_calloc( 1, sizeof( struct JobPool ), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT );
+
+    if( pxJobPool == NULL )
+    {
+        return NULL;
+    }
+
+    for( BaseType_t x = 0; x < configNUMBER_OF_CORES; x++ )
+    {
+        portMUX_INITIALIZE( &pxJobPool->xSlots[ x ].xLock );
+    }
+
+    pxJobPool->xMutex = xSemaphoreCreateMutex();
+    pxJobPool->xDone = xSemaphoreCreateCounting( configNUMBER_OF_CORES, 0 );
+
+    if( ( pxJobPool->xMutex == NULL ) || ( pxJobPool->xDone == NULL ) )
+    {
+        vJobPoolDelete( pxJobPool );
+        return NULL;
+    }
+
+    for( BaseType_t x = 0; x < configNUMBER_OF_CORES; x++ )
+    {
+        if( xTaskCreatePinnedToCore( prvJobPoolWorker, pcName, usStackDepth, pxJobPool, uxPriority, &pxJobPool->xWorkers[ x ], x ) != pdPASS )
+        {
+            vJobPoolDelete( pxJobPool );
+            return NULL;
+        }
+
+        pxJobPool->uxWorkerCount++;
+    }
+
+    return pxJobPool;
+}
+
+void vJobPoolDelete( JobPoolHandle_t xJobPool )
+{
+    configASSERT( xJobPool );
+
+    /* Let every worker exit, each one gives xDone a last time before deleting itself */
+    xJobPool->xDeleting = pdTRUE;
+
+    for( UBaseType_t x = 0; x < xJobPool->uxWorkerCount; x++ )
+    {
+        ( void ) xTaskNotifyGive( xJobPool->xWorkers[ x ] );
+    }
+
+    for( UBaseType_t x = 0; x < xJobPool->uxWorkerCount; x++ )
+    {
+        ( void ) xSemaphoreTake( xJobPool->xDone, portMAX_DELAY );
+    }
+
+    if( xJobPool->xDone != NULL )
+    {
+        vSemaphoreDelete( xJobPool->xDone );
+    }
+
+    if( xJobPool->xMutex != NULL )
+    {
+        vSemaphoreDelete( xJobPool->xMutex );
+    }
+
+    heap_caps_free( xJobPool );
+}
+
+void vJobPoolParallelFor( JobPoolHandle_t xJobPool,
+                          size_t xCount,
+                          size_t xChunkSize,
+                          JobPoolFunction_t pxFunction,
+                          void * pvArg )
+{
+    size_t xChunks;
+    UBaseType_t uxWoken = 0;
+
+    configASSERT( xJobPool );
+    configASSERT( pxFunction );
+
+    if( xCount == 0 )
+    {
+        return;
+    }
+
+    if( xChunkSize == 0 )
+    {
+        xChunkSize = xCount / ( configNUMBER_OF_CORES * jobpoolDEFAULT_CHUNKS_PER_CORE );
+        xChunkSize = ( xChunkSize != 0 ) ? xChunkSize : 1;
+    }
+
+    xChunks = xCount / xChunkSize + ( ( xCount % xChunkSize ) != 0 );
+
+    ( void ) xSemaphoreTake( xJobPool->xMutex, portMAX_DELAY );
+
+    /* No worker is running at this point, so the job can be set up without taking the slot locks */
+    xJobPool->pxFunction = pxFunction;
+    xJobPool->pvArg = pvArg;
+    xJobPool->xCount = xCount;
+    xJobPool->xChunkSize = xChunkSize;
+
+    for( BaseType_t x = 0; x < configNUMBER_OF_CORES; x++ )
+    {
+        const size_t xPerSlot = xChunks / configNUMBER_OF_CORES;
+        const size_t xExtra = xChunks % configNUMBER_OF_CORES;
+
+        xJobPool->xSlots[ x ].xNext = xPerSlot * x + ( ( ( size_t ) x < xExtra ) ? ( size_t ) x : xExtra );
+        xJobPool->xSlots[ x ].xEnd = xJobPool->xSlots[ x ].xNext + xPerSlot + ( ( ( size_t ) x < xExtra ) ? 1 : 0 );
+    }
+
+    /* The caller takes the place of the worker of its own core. It does not
+     * matter if the caller migrates to another core afterwards, as the slots
+     * are only used to split the work. */
+    const BaseType_t xCallerSlot = xPortGetCoreID();
+
+    if( xChunks > 1 )
+    {
+        for( BaseType_t x = 0; x < configNUMBER_OF_CORES; x++ )
+        {
+            if( x != xCallerSlot )
+            {
+                ( void ) xTaskNotifyGive( xJobPool->xWorkers[ x ] );
+                uxWoken++;
+            }
+        }
+    }
+
+    prvRunJob( xJobPool, xCallerSlot );
+
+    /* Join the workers */
+    while( uxWoken > 0 )
+    {
+        ( void ) xSemaphoreTake( xJobPool->xDone, portMAX_DELAY );
+        uxWoken--;
+    }
+
+    ( void ) xSemaphoreGive( xJobPool->xMutex );
+}
@@ -0,0 +1,261 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * This file contains the implementation of the message pool functions in
+ * message_pool.h
+ *
+ * A pool has two queues of message pointers: xFree holds the free messages
+ * and xSent the messages sent but not received yet. Both can hold all the
+ * messages of the pool, so putting a message in either of them never blocks.
+ * Blocking, waking up the waiting tasks and ISR safety are provided by the
+ * queues, which only ever copy a pointer.
+ */
+
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/message_pool.h"
+#include "esp_heap_caps.h"
+#include "esp_attr.h"
+
+struct MessagePool
+{
+    QueueHandle_t xFree;  /*< Free messages */
+    QueueHandle_t xSent;  /*< Messages sent and not received yet */
+    uint8_t * pucMessages;
+    size_t xMessageSize;  /*< Size of a message, rounded up to keep the alignment */
+    UBaseType_t uxMessageCount;
+    portMUX_TYPE xStatsLock;
+    UBaseType_t uxMinFree;
+    UBaseType_t uxAllocFailures;
+};
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+/* The helpers are inlined so the functions placed in IRAM don't call flash */
+FORCE_INLINE_ATTR void prvAssertMessage( struct MessagePool * pxMessagePool,
+                                         void * pvMessage )
+{
+    const size_t xOffset = ( uint8_t * ) pvMessage - pxMessagePool->pucMessages;
+
+    ( void ) xOffset;
+    configASSERT( ( ( uint8_t * ) pvMessage >= pxMessagePool->pucMessages ) &&
+                  ( xOffset < pxMessagePool->xMessageSize * pxMessagePool->uxMessageCount ) &&
+                  ( ( xOffset % pxMessagePool->xMessageSize ) == 0 ) );
+}
+
+FORCE_INLINE_ATTR void prvUpdateAllocStats( struct MessagePool * pxMessagePool,
+                                            BaseType_t xAllocated )
+{
+    portENTER_CRITICAL_SAFE( &pxMessagePool->xStatsLock );
+    {
+        if( xAllocated != pdFALSE )
+        {
+            const UBaseType_t uxFree = uxQueueMessagesWaitingFromISR( pxMessagePool->xFree );
+
+            if( uxFree < pxMessagePool->uxMinFree )
+            {
+                pxMessagePool->uxMinFree = uxFree;
+            }
+        }
+        else
+        {
+            pxMessagePool->uxAllocFailures++;
+        }
+    }
+    portEXIT_CRITICAL_SAFE( &pxMessagePool->xStatsLock );
+}
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+MessagePoolHandle_t xMessagePoolCreate( size_t xMessageSize,
+                                        UBaseType_t uxMessageCount,
+                                        UBaseType_t uxMemoryCaps )
+{
+    struct MessagePool * pxMessagePool;
+
+    configASSERT( xMessageSize > 0 );
+    configASSERT( uxMessageCount > 0 );
+
+    /* The pool contains a spinlock, so it must be in internal memory */
+    pxMessagePool = heap_caps_calloc( 1, sizeof( struct MessagePool ), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT );
+
+    if( pxMessagePool == NULL )
+    {
+        return NULL;
+    }
+
+    portMUX_INITIALIZE( &pxMessagePool->xStatsLock );
+    pxMessagePool->xMessageSize = ( xMessageSize + 3 ) & ~( size_t ) 3;
+    pxMessagePool->uxMessageCount = uxMessageCount;
+    pxMessagePool->uxMinFree = uxMessageCount;
+    pxMessagePool->pucMessages = heap_caps_malloc( pxMessagePool->xMessageSize * uxMessageCount, uxMemoryCaps );
+    pxMessagePool->xFree = xQueueCreate( uxMessageCount, sizeof( void * ) );
+    pxMessagePool->xSent = xQueueCreate( uxMessageCount, sizeof( void * ) );
+
+    if( ( pxMessagePool->pucMessages == NULL ) || ( pxMessagePool->xFree == NULL ) || ( pxMessagePool->xSent == NULL ) )
+    {
+        vMessagePoolDelete( pxMessagePool );
+        return NULL;
+    }
+
+    for( UBaseType_t x = 0; x < uxMessageCount; x++ )
+    {
+        void * pvMessage = pxMessagePool->pucMessages + x * pxMessagePool->xMessageSize;
+
+        ( void ) xQueueSend( pxMessagePool->xFree, &pvMessage, 0 );
+    }
+
+    return pxMessagePool;
+}
+
+void vMessagePoolDelete( MessagePoolHandle_t xMessagePool )
+{
+    configASSERT( xMessagePool );
+
+    if( xMessagePool->xSent != NULL )
+    {
+        vQueueDelete( xMessagePool->xSent );
+    }
+
+    if( xMessagePool->xFree != NULL )
+    {
+        vQueueDelete( xMessagePool->xFree );
+    }
+
+    heap_caps_free( xMessagePool->pucMessages );
+    heap_caps_free( xMessagePool );
+}
+
+void * pvMessagePoolAlloc( MessagePoolHandle_t xMessagePool,
+                           TickType_t xTicksToWait )
+{
+    void * pvMessage = NULL;
+    BaseType_t xAllocated;
+
+    configASSERT( xMessagePool );
+
+    xAllocated = xQueueReceive( xMessagePool->xFree, &pvMessage, xTicksToWait );
+    prvUpdateAllocStats( xMessagePool, xAllocated );
+
+    return ( xAllocated != pdFALSE ) ? pvMessage : NULL;
+}
+
+void * pvMessagePoolAllocFromISR( MessagePoolHandle_t xMessagePool )
+{
+    void * pvMessage = NULL;
+    BaseType_t xAllocated;
+
+    configASSERT( xMessagePool );
+
+    /* Nothing waits for the free queue to have room, so receiving from it never wakes a task */
+    xAllocated = xQueueReceiveFromISR( xMessagePool->xFree, &pvMessage, NULL );
+    prvUpdateAllocStats( xMessagePool, xAllocated );
+
+    return ( xAllocated != pdFALSE ) ? pvMessage : NULL;
+}
+
+void vMessagePoolSend( MessagePoolHandle_t xMessagePool,
+                       void * pvMessage )
+{
+    BaseType_t xSent;
+
+    configASSERT( xMessagePool );
+    prvAssertMessage( xMessagePool, pvMessage );
+
+    xSent = xQueueSend( xMessagePool->xSent, &pvMessage, 0 );
+    configASSERT( xSent != pdFALSE );
+    ( void ) xSent;
+}
+
+void vMessagePoolSendFromISR( MessagePoolHandle_t xMessagePool,
+                              void * pvMessage,
+                              BaseType_t * pxHigherPriorityTaskWoken )
+{
+    BaseType_t xSent;
+
+    configASSERT( xMessagePool );
+    prvAssertMessage( xMessagePool, pvMessage );
+
+    xSent = xQueueSendFromISR( xMessagePool->xSent, &pvMessage, pxHigherPriorityTaskWoken );
+    configASSERT( xSent != pdFALSE );
+    ( void ) xSent;
+}
+
+void * pvMessagePoolReceive( MessagePoolHandle_t xMessagePool,
+                             TickType_t xTicksToWait )
+{
+    void * pvMessage = NULL;
+
+    configASSERT( xMessagePool );
+
+    if( xQueueReceive( xMessagePool->xSent, &pvMessage, xTicksToWait ) == pdFALSE )
+    {
+        return NULL;
+    }
+
+    return pvMessage;
+}
+
+void * pvMessagePoolReceiveFromISR( MessagePoolHandle_t xMessagePool,
+                                    BaseType_t * pxHigherPriorityTaskWoken )
+{
+    void * pvMessage = NULL;
+
+    configASSERT( xMessagePool );
+
+    if( xQueueReceiveFromISR( xMessagePool->xSent, &pvMessage, pxHigherPriorityTaskWoken ) == pdFALSE )
+    {
+        return NULL;
+    }
+
+    return pvMessage;
+}
+
+void vMessagePoolRelease( MessagePoolHandle_t xMessagePool,
+                          void * pvMessage )
+{
+    BaseType_t xReleased;
+
+    configASSERT( xMessagePool );
+    prvAssertMessage( xMessagePool, pvMessage );
+
+    /* The free queue can't be full while a message is out of it, unless the message is released twice */
+    xReleased = xQueueSend( xMessagePool->xFree, &pvMessage, 0 );
+    configASSERT( xReleased != pdFALSE );
+    ( void ) xReleased;
+}
+
+void vMessagePoolReleaseFromISR( MessagePoolHandle_t xMessagePool,
+                                 void * pvMessage,
+                                 BaseType_t * pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReleased;
+
+    configASSERT( xMessagePool );
+    prvAssertMessage( xMessagePool, pvMessage );
+
+    xReleased = xQueueSendFromISR( xMessagePool->xFree, &pvMessage, pxHigherPriorityTaskWoken );
+    configASSERT( xReleased != pdFALSE );
+    ( void ) xReleased;
+}
+
+void vMessagePoolGetStats( MessagePoolHandle_t xMessagePool,
+                           MessagePoolStats_t * pxStats )
+{
+    configASSERT( xMessagePool );
+    configASSERT( pxStats );
+
+    portENTER_CRITICAL_SAFE( &xMessagePool->xStatsLock );
+    {
+        pxStats->uxMessageCount = xMessagePool->uxMessageCount;
+        pxStats->uxFree = uxQueueMessagesWaitingFromISR( xMessagePool->xFree );
+        pxStats->uxMinFree = xMessagePool->uxMinFree;
+        pxStats->uxAllocFailures = xMessagePool->uxAllocFailures;
+    }
+    portEXIT_CRITICAL_SAFE( &xMessagePool->xStatsLock );
+}
@@ -356,6 +356,25 @@
 
 #endif // CONFIG_SPIRAM
 
+/*------------------------------------------------------------------------------
+ * THREAD LOCAL STORAGE (PRIVATE)
+ *----------------------------------------------------------------------------*/
+
+#if !CONFIG_IDF_TARGET_LINUX
+
+/**
+ * @brief Reset the GCC TLS variables of the calling task
+ *
+ * The GCC TLS area (i.e., the "__thread" and "thread_local" variables) of a task
+ * is initialized on the task's stack when the task is created. This function
+ * sets all TLS variables of the calling task back to their initial values, e.g.,
+ * before a task starts running code which must not see the TLS variables left
+ * over by the code which previously ran in the task.
+ */
+    void vPortTLSReset( void );
+
+#endif /* !CONFIG_IDF_TARGET_LINUX */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -189,6 +189,43 @@ BaseType_t xTaskGetCoreID( TaskHandle_t xTask );
 
 #endif /* ( !CONFIG_FREERTOS_SMP && ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 
+#if ( !CONFIG_FREERTOS_SMP && CONFIG_FREERTOS_TASK_PROFILING )
+
+/**
+ * @brief Profiling counters of a task
+ *
+ * The counters are updated by the scheduler on every context switch, starting
+ * from the first context switch on each core.
+ */
+    typedef struct
+    {
+        uint64_t ullRunTimeCycles;   /**< Number of CPU cycles the task has been running for */
+        uint32_t ulContextSwitches;  /**< Number of times the task was switched in */
+        uint32_t ulPreemptions;      /**< Number of times the task was switched out while still ready to run (i.e., preempted or yielded) */
+        uint32_t ulCoreMigrations;   /**< Number of times the task was switched in on another core than the one it last ran on */
+        TickType_t xMaxBlockedTicks; /**< Longest time in ticks between the task being switched out while blocked or suspended and being switched in again */
+        BaseType_t xLastCoreID;      /**< Core the task last ran on, or tskNO_AFFINITY if it never ran */
+    } TaskProfilingInfo_t;
+
+/**
+ * @brief Get the profiling counters of a task
+ *
+ * Unlike vTaskGetRunTimeStats(), this function just copies a few counters of
+ * the task and does not format them, so it can be called periodically to feed
+ * the counters of all tasks to a monitoring system.
+ *
+ * @note Only available if CONFIG_FREERTOS_TASK_PROFILING is enabled.
+ * @note ullRunTimeCycles counts CPU cycles, which represent time only while the
+ * CPU frequency does not change (e.g. when Dynamic Frequency Scaling is not used).
+ *
+ * @param xTask Handle of the task to query. Set to NULL to query the calling task.
+ * @param[out] pxProfilingInfo Structure filled with the counters of the task
+ */
+    void vTaskGetProfilingInfo( TaskHandle_t xTask,
+                                TaskProfilingInfo_t * pxProfilingInfo );
+
+#endif /* ( !CONFIG_FREERTOS_SMP && CONFIG_FREERTOS_TASK_PROFILING ) */
+
 /**
  * Returns the start of the stack associated with xTask.
  *
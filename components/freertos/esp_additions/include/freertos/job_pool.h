@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * @brief Handle of a job pool
+ */
+typedef struct JobPool * JobPoolHandle_t;
+
+/**
+ * @brief Function called by a job pool to process a chunk of a parallel loop
+ *
+ * @param pvArg Argument passed to vJobPoolParallelFor()
+ * @param xStart Index of the first element of the chunk
+ * @param xEnd Index one past the last element of the chunk
+ */
+typedef void (* JobPoolFunction_t)( void * pvArg,
+                                    size_t xStart,
+                                    size_t xEnd );
+
+/**
+ * @brief Create a job pool
+ *
+ * A job pool owns one worker task pinned to each core. The workers sleep until
+ * vJobPoolParallelFor() is called, so an idle pool costs no CPU time.
+ *
+ * @param pcName Name of the worker tasks
+ * @param uxPriority Priority of the worker tasks. This should usually be the
+ * priority of the tasks calling vJobPoolParallelFor().
+ * @param usStackDepth Stack size of each worker task
+ *
+ * @return Handle of the job pool, or NULL if the memory could not be allocated
+ */
+JobPoolHandle_t xJobPoolCreate( const char * pcName,
+                                UBaseType_t uxPriority,
+                                configSTACK_DEPTH_TYPE usStackDepth );
+
+/**
+ * @brief Delete a job pool
+ *
+ * @note No vJobPoolParallelFor() call may be in progress on the pool.
+ *
+ * @param xJobPool Handle of the job pool
+ */
+void vJobPoolDelete( JobPoolHandle_t xJobPool );
+
+/**
+ * @brief Run a loop over xCount elements in parallel on all cores
+ *
+ * The range [0, xCount) is split into chunks of xChunkSize elements, which are
+ * initially distributed evenly between the cores. The calling task processes
+ * the chunks of the core it runs on and the workers of the pool process the
+ * chunks of the other cores. A core which runs out of chunks steals half of the
+ * remaining chunks of another core, so the load stays balanced even if chunks
+ * take different amounts of time.
+ *
+ * The function returns once all chunks have been processed. Concurrent calls on
+ * the same pool are serialized.
+ *
+ * @note pxFunction may be called from different tasks at the same time for
+ * different chunks.
+ *
+ * @param xJobPool Handle of the job pool
+ * @param xCount Number of elements
+ * @param xChunkSize Number of elements per chunk. Set to 0 to split the range
+ * into a few chunks per core.
+ * @param pxFunction Function called for each chunk
+ * @param pvArg Argument passed to pxFunction
+ */
+void vJobPoolParallelFor( JobPoolHandle_t xJobPool,
+                          size_t xCount,
+                          size_t xChunkSize,
+                          JobPoolFunction_t pxFunction,
+                          void * pvArg );
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * @brief Handle of a message pool
+ */
+typedef struct MessagePool * MessagePoolHandle_t;
+
+/**
+ * @brief Usage statistics of a message pool
+ */
+typedef struct
+{
+    UBaseType_t uxMessageCount;   /**< Number of messages of the pool */
+    UBaseType_t uxFree;           /**< Number of messages currently free */
+    UBaseType_t uxMinFree;        /**< Lowest number of free messages since the pool was created */
+    UBaseType_t uxAllocFailures;  /**< Number of allocations which failed or timed out because no message was free */
+} MessagePoolStats_t;
+
+/**
+ * @brief Create a message pool
+ *
+ * A message pool owns uxMessageCount messages of xMessageSize bytes and a
+ * queue of pointers to them. A sender allocates a message, fills it and sends
+ * it. The receiver gets the same message, reads it and releases it back to the
+ * pool. Only the pointer to the message goes through the queues, so the
+ * content of a message is never copied.
+ *
+ * The queue can hold all the messages of the pool, so sending a message
+ * never blocks.
+ *
+ * @param xMessageSize Size of a message in bytes
+ * @param uxMessageCount Number of messages
+ * @param uxMemoryCaps Memory capabilities of the messages (see esp_heap_caps.h),
+ * e.g. MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT. The messages are aligned to 4 bytes.
+ *
+ * @return Handle of the message pool, or NULL if the memory could not be allocated
+ */
+MessagePoolHandle_t xMessagePoolCreate( size_t xMessageSize,
+                                        UBaseType_t uxMessageCount,
+                                        UBaseType_t uxMemoryCaps );
+
+/**
+ * @brief Delete a message pool
+ *
+ * @note No task may be blocked on the pool, and the messages of the pool must
+ * not be used after this call.
+ *
+ * @param xMessagePool Handle of the message pool
+ */
+void vMessagePoolDelete( MessagePoolHandle_t xMessagePool );
+
+/**
+ * @brief Allocate a message from a pool
+ *
+ * @param xMessagePool Handle of the message pool
+ * @param xTicksToWait Maximum time to wait for a message to be released if
+ * none is free
+ *
+ * @return Pointer to the message, or NULL if no message became free in time
+ */
+void * pvMessagePoolAlloc( MessagePoolHandle_t xMessagePool,
+                           TickType_t xTicksToWait );
+
+/**
+ * @brief Allocate a message from a pool in an ISR
+ *
+ * @param xMessagePool Handle of the message pool
+ *
+ * @return Pointer to the message, or NULL if no message is free
+ */
+void * pvMessagePoolAllocFromISR( MessagePoolHandle_t xMessagePool );
+
+/**
+ * @brief Send an allocated message to the receivers of a pool
+ *
+ * The ownership of the message passes to the receiver, the sender must not
+ * access it anymore.
+ *
+ * @param xMessagePool Handle of the message pool
+ * @param pvMessage Message obtained from pvMessagePoolAlloc()
+ */
+void vMessagePoolSend( MessagePoolHandle_t xMessagePool,
+                       void * pvMessage );
+
+/**
+ * @brief Send an allocated message to the receivers of a pool in an ISR
+ *
+ * @param xMessagePool Handle of the message pool
+ * @param pvMessage Message obtained from pvMessagePoolAlloc()
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the message
+ * unblocked a task of higher priority than the interrupted task. Can be NULL.
+ */
+void vMessagePoolSendFromISR( MessagePoolHandle_t xMessagePool,
+                              void * pvMessage,
+                              BaseType_t * pxHigherPriorityTaskWoken );
+
+/**
+ * @brief Receive a message sent to a pool
+ *
+ * The message must be released with vMessagePoolRelease() once it has been
+ * processed.
+ *
+ * @param xMessagePool Handle of the message pool
+ * @param xTicksToWait Maximum time to wait for a message
+ *
+ * @return Pointer to the message, or NULL if no message was sent in time
+ */
+void * pvMessagePoolReceive( MessagePoolHandle_t xMessagePool,
+                             TickType_t xTicksToWait );
+
+/**
+ * @brief Receive a message sent to a pool in an ISR
+ *
+ * @param xMessagePool Handle of the message pool
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task of higher priority
+ * than the interrupted task was unblocked. Can be NULL.
+ *
+ * @return Pointer to the message, or NULL if no message is waiting
+ */
+void * pvMessagePoolReceiveFromISR( MessagePoolHandle_t xMessagePool,
+                                    BaseType_t * pxHigherPriorityTaskWoken );
+
+/**
+ * @brief Release a message back to its pool
+ *
+ * @note A message may also be released without having been sent, e.g. if
+ * filling it failed.
+ *
+ * @param xMessagePool Handle of the message pool
+ * @param pvMessage Message obtained from pvMessagePoolAlloc() or pvMessagePoolReceive()
+ */
+void vMessagePoolRelease( MessagePoolHandle_t xMessagePool,
+                          void * pvMessage );
+
+/**
+ * @brief Release a message back to its pool in an ISR
+ *
+ * @param xMessagePool Handle of the message pool
+ * @param pvMessage Message obtained from pvMessagePoolAlloc() or pvMessagePoolReceive()
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task of higher priority
+ * than the interrupted task was waiting for a free message. Can be NULL.
+ */
+void vMessagePoolReleaseFromISR( MessagePoolHandle_t xMessagePool,
+                                 void * pvMessage,
+                                 BaseType_t * pxHigherPriorityTaskWoken );
+
+/**
+ * @brief Get the usage statistics of a message pool
+ *
+ * @param xMessagePool Handle of the message pool
+ * @param pxStats Filled with the statistics
+ */
+void vMessagePoolGetStats( MessagePoolHandle_t xMessagePool,
+                           MessagePoolStats_t * pxStats );
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
@@ -9,6 +9,7 @@
 #include "task.h"
 #include "esp_system.h"
 #include "esp_memory_utils.h"
+#include "esp_private/freertos_idf_additions_priv.h"
 #include "sdkconfig.h"
 
 /* ----------------------------------------- Port Implementations (Common)  --------------------------------------------
@@ -103,3 +104,33 @@ void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
 #endif //configUSE_TIMERS
 
 #endif // configSUPPORT_STATIC_ALLOCATION == 1
+
+// -------------------- Thread Local Storage ---------------------
+
+/*
+The TLS area is placed on the task's stack by uxInitialiseStackTLS() in the port.
+Its address is derived from the thread pointer register using the same layout.
+*/
+void vPortTLSReset(void)
+{
+#if __XTENSA__
+    extern int _thread_local_start, _thread_local_end, _flash_rodata_start, _flash_rodata_align;
+    const uint32_t tls_area_size = (uint32_t)&_thread_local_end - (uint32_t)&_thread_local_start;
+    uint32_t threadptr;
+    __asm__ volatile("rur.threadptr %0" : "=r"(threadptr));
+    // Inverse of the THREADPTR register's initialization value in uxInitialiseStackTLS(), with TCB_SIZE being 8
+    const uint32_t tls_section_align = (uint32_t)&_flash_rodata_align;
+    const uint32_t base = (8 + tls_section_align - 1) & -tls_section_align;
+    void *tls_area = (void *)(threadptr + ((uint32_t)&_thread_local_start - (uint32_t)&_flash_rodata_start) + base);
+    memcpy(tls_area, &_thread_local_start, tls_area_size);
+#elif __riscv
+    extern char _thread_local_data_start, _thread_local_data_end;
+    extern char _thread_local_bss_start, _thread_local_bss_end;
+    const uint32_t tls_data_size = (uint32_t)&_thread_local_data_end - (uint32_t)&_thread_local_data_start;
+    const uint32_t tls_bss_size = (uint32_t)&_thread_local_bss_end - (uint32_t)&_thread_local_bss_start;
+    char *tls_area;
+    __asm__ volatile("mv %0, tp" : "=r"(tls_area));
+    memcpy(tls_area, &_thread_local_data_start, tls_data_size);
+    memset(tls_area + tls_data_size, 0, tls_bss_size);
+#endif
+}
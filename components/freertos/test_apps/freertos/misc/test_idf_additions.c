@@ -340,3 +340,67 @@ TEST_CASE("IDF additions: IDF tick hooks during scheduler suspension", "[freerto
 }
 
 #endif // !CONFIG_FREERTOS_SMP
+
+#if ( !CONFIG_FREERTOS_SMP && CONFIG_FREERTOS_TASK_PROFILING )
+
+/*
+Test vTaskGetProfilingInfo()
+
+Purpose:
+    - Test that the profiling counters of a task reflect how the task was scheduled
+
+Procedure:
+    - The unity task creates a higher priority task on the same core, then spins until the task is done
+    - The task blocks with vTaskDelay() a number of times, preempting the unity task each time it wakes up
+    - Read the profiling counters of both tasks
+
+Expected:
+    - The task was switched in at least once per delay, blocked for at least the delay time and ran on the
+      current core without migrating
+    - The unity task was preempted at least once per delay
+*/
+
+#define PROFILING_TEST_DELAYS       10
+#define PROFILING_TEST_DELAY_TICKS  2
+
+static volatile bool profiling_task_done;
+
+static void profiling_task(void *arg)
+{
+    for (int i = 0; i < PROFILING_TEST_DELAYS; i++) {
+        vTaskDelay(PROFILING_TEST_DELAY_TICKS);
+    }
+    profiling_task_done = true;
+    vTaskSuspend(NULL);
+}
+
+TEST_CASE("IDF additions: Task profiling counters", "[freertos]")
+{
+    TaskProfilingInfo_t unity_before;
+    TaskProfilingInfo_t unity_after;
+    TaskProfilingInfo_t task_info;
+    TaskHandle_t task_handle;
+
+    vTaskGetProfilingInfo(NULL, &unity_before);
+
+    profiling_task_done = false;
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(profiling_task, "profiling", 2048, NULL, UNITY_FREERTOS_PRIORITY + 1, &task_handle, xPortGetCoreID()));
+    while (!profiling_task_done) {
+        // spin, so the other task preempts this task each time its delay ends
+    }
+
+    vTaskGetProfilingInfo(NULL, &unity_after);
+    vTaskGetProfilingInfo(task_handle, &task_info);
+    vTaskDelete(task_handle);
+
+    TEST_ASSERT_GREATER_OR_EQUAL(PROFILING_TEST_DELAYS, task_info.ulContextSwitches);
+    TEST_ASSERT_GREATER_OR_EQUAL(PROFILING_TEST_DELAY_TICKS - 1, task_info.xMaxBlockedTicks);
+    TEST_ASSERT_NOT_EQUAL(0, task_info.ullRunTimeCycles);
+    TEST_ASSERT_EQUAL(xPortGetCoreID(), task_info.xLastCoreID);
+    TEST_ASSERT_EQUAL(0, task_info.ulCoreMigrations);
+
+    TEST_ASSERT_GREATER_OR_EQUAL(PROFILING_TEST_DELAYS, unity_after.ulPreemptions - unity_before.ulPreemptions);
+    TEST_ASSERT_GREATER_THAN(unity_before.ullRunTimeCycles, unity_after.ullRunTimeCycles);
+}
+
+#endif // ( !CONFIG_FREERTOS_SMP && CONFIG_FREERTOS_TASK_PROFILING )
@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/job_pool.h"
+#include "esp_rom_sys.h"
+#include "unity.h"
+#include "test_utils.h"
+
+/*
+Test vJobPoolParallelFor()
+
+Purpose:
+    - Test that every element of a parallel loop is processed exactly once, with and without a chunk size,
+      also if chunks take very different amounts of time
+    - Test that chunks are processed on all cores
+
+Procedure:
+    - Create a job pool
+    - Run parallel loops which increment a counter per element and record the core processing each chunk.
+      Chunks at the beginning of the range busy wait, so the core owning them has to get help from the others.
+    - Delete the job pool
+
+Expected:
+    - Each counter is incremented exactly once
+    - On multi-core targets, chunks were processed on more than one core
+*/
+
+#define JOB_POOL_TEST_ELEMENTS      1000
+
+typedef struct {
+    uint8_t counts[JOB_POOL_TEST_ELEMENTS];
+    volatile uint32_t core_mask;
+} job_pool_test_ctx_t;
+
+static void count_elements(void *arg, size_t start, size_t end)
+{
+    job_pool_test_ctx_t *ctx = (job_pool_test_ctx_t *)arg;
+
+    if (start < JOB_POOL_TEST_ELEMENTS / 4) {
+        esp_rom_delay_us(200);
+    }
+    for (size_t i = start; i < end; i++) {
+        ctx->counts[i]++;
+    }
+    __atomic_fetch_or(&ctx->core_mask, 1U << xPortGetCoreID(), __ATOMIC_RELAXED);
+}
+
+TEST_CASE("Job pool: parallel for processes every element once", "[freertos]")
+{
+    static job_pool_test_ctx_t ctx;
+    const size_t chunk_sizes[] = { 0, 1, 7, JOB_POOL_TEST_ELEMENTS, JOB_POOL_TEST_ELEMENTS + 1 };
+
+    JobPoolHandle_t pool = xJobPoolCreate("job_pool", UNITY_FREERTOS_PRIORITY, 2048);
+    TEST_ASSERT_NOT_NULL(pool);
+
+    for (int i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); i++) {
+        memset(&ctx, 0, sizeof(ctx));
+        vJobPoolParallelFor(pool, JOB_POOL_TEST_ELEMENTS, chunk_sizes[i], count_elements, &ctx);
+        for (int j = 0; j < JOB_POOL_TEST_ELEMENTS; j++) {
+            TEST_ASSERT_EQUAL(1, ctx.counts[j]);
+        }
+#if CONFIG_FREERTOS_NUMBER_OF_CORES > 1
+        if (chunk_sizes[i] < JOB_POOL_TEST_ELEMENTS) {
+            TEST_ASSERT_NOT_EQUAL(0, ctx.core_mask & (ctx.core_mask - 1));
+        }
+#endif
+    }
+
+    // An empty loop returns without calling the function
+    vJobPoolParallelFor(pool, 0, 0, count_elements, NULL);
+
+    vJobPoolDelete(pool);
+    // Let the idle tasks free the worker tasks before the memory leak check
+    vTaskDelay(10);
+}
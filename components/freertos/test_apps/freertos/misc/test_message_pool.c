@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/message_pool.h"
+#include "esp_heap_caps.h"
+#include "unity.h"
+#include "test_utils.h"
+
+/*
+Test message pool allocation, exhaustion and statistics
+
+Purpose:
+    - Test that every message of a pool can be allocated once, and that allocating from an empty pool fails
+    - Test that released messages can be allocated again
+    - Test that the statistics record the lowest number of free messages and the failed allocations
+
+Procedure:
+    - Create a pool of 4 messages
+    - Allocate all messages, then try to allocate one more with and without a timeout
+    - Release the messages and get the statistics
+    - Delete the pool
+
+Expected:
+    - The 4 messages are different and 4 byte aligned
+    - The extra allocations return NULL
+    - The statistics show 4 free messages, a minimum of 0 free messages and 2 failed allocations
+*/
+
+#define MESSAGE_POOL_TEST_COUNT     4
+
+typedef struct {
+    uint32_t seq;
+    uint8_t payload[61];
+} test_message_t;
+
+TEST_CASE("Message pool: allocation, exhaustion and statistics", "[freertos]")
+{
+    MessagePoolHandle_t pool = xMessagePoolCreate(sizeof(test_message_t), MESSAGE_POOL_TEST_COUNT, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(pool);
+
+    test_message_t *msgs[MESSAGE_POOL_TEST_COUNT];
+    for (int i = 0; i < MESSAGE_POOL_TEST_COUNT; i++) {
+        msgs[i] = pvMessagePoolAlloc(pool, 0);
+        TEST_ASSERT_NOT_NULL(msgs[i]);
+        TEST_ASSERT_EQUAL(0, (uintptr_t)msgs[i] & 3);
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_NOT_EQUAL(msgs[j], msgs[i]);
+        }
+    }
+    TEST_ASSERT_NULL(pvMessagePoolAlloc(pool, 0));
+    TEST_ASSERT_NULL(pvMessagePoolAlloc(pool, pdMS_TO_TICKS(10)));
+
+    for (int i = 0; i < MESSAGE_POOL_TEST_COUNT; i++) {
+        vMessagePoolRelease(pool, msgs[i]);
+    }
+
+    MessagePoolStats_t stats;
+    vMessagePoolGetStats(pool, &stats);
+    TEST_ASSERT_EQUAL(MESSAGE_POOL_TEST_COUNT, stats.uxMessageCount);
+    TEST_ASSERT_EQUAL(MESSAGE_POOL_TEST_COUNT, stats.uxFree);
+    TEST_ASSERT_EQUAL(0, stats.uxMinFree);
+    TEST_ASSERT_EQUAL(2, stats.uxAllocFailures);
+
+    vMessagePoolDelete(pool);
+}
+
+/*
+Test passing messages between tasks by reference
+
+Purpose:
+    - Test that the messages sent by a task are received in order, by reference, by another task
+    - Test that a sender blocked on an exhausted pool resumes once the receiver releases a message
+
+Procedure:
+    - Create a pool of 2 messages and a receiver task
+    - Send more messages than the pool holds, each filled with its sequence number
+    - The receiver checks each message and releases it
+
+Expected:
+    - The receiver gets every message once, in order, with its content intact
+    - All messages are free again at the end
+*/
+
+#define MESSAGE_POOL_TEST_MESSAGES  100
+
+typedef struct {
+    MessagePoolHandle_t pool;
+    TaskHandle_t main_task;
+    uint32_t received;
+    bool content_ok;
+} message_pool_test_ctx_t;
+
+static void receiver_task(void *arg)
+{
+    message_pool_test_ctx_t *ctx = (message_pool_test_ctx_t *)arg;
+
+    while (ctx->received < MESSAGE_POOL_TEST_MESSAGES) {
+        test_message_t *msg = pvMessagePoolReceive(ctx->pool, portMAX_DELAY);
+        if (msg->seq != ctx->received || msg->payload[sizeof(msg->payload) - 1] != (uint8_t)msg->seq) {
+            ctx->content_ok = false;
+        }
+        ctx->received++;
+        vMessagePoolRelease(ctx->pool, msg);
+    }
+    xTaskNotifyGive(ctx->main_task);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("Message pool: messages are passed by reference between tasks", "[freertos]")
+{
+    message_pool_test_ctx_t ctx = {
+        .pool = xMessagePoolCreate(sizeof(test_message_t), 2, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT),
+        .main_task = xTaskGetCurrentTaskHandle(),
+        .content_ok = true,
+    };
+    TEST_ASSERT_NOT_NULL(ctx.pool);
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(receiver_task, "receiver", 2048, &ctx, UNITY_FREERTOS_PRIORITY - 1, NULL));
+
+    for (uint32_t i = 0; i < MESSAGE_POOL_TEST_MESSAGES; i++) {
+        test_message_t *msg = pvMessagePoolAlloc(ctx.pool, portMAX_DELAY);
+        TEST_ASSERT_NOT_NULL(msg);
+        msg->seq = i;
+        memset(msg->payload, (uint8_t)i, sizeof(msg->payload));
+        vMessagePoolSend(ctx.pool, msg);
+    }
+
+    TEST_ASSERT_NOT_EQUAL(0, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_EQUAL(MESSAGE_POOL_TEST_MESSAGES, ctx.received);
+    TEST_ASSERT_TRUE(ctx.content_ok);
+
+    MessagePoolStats_t stats;
+    vMessagePoolGetStats(ctx.pool, &stats);
+    TEST_ASSERT_EQUAL(2, stats.uxFree);
+    TEST_ASSERT_EQUAL(0, stats.uxAllocFailures);
+
+    vMessagePoolDelete(ctx.pool);
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -268,6 +268,22 @@ bool cache_hal_writeback_addr(uint32_t vaddr, uint32_t size)
 }
 #endif  //#if SOC_CACHE_WRITEBACK_SUPPORTED
 
+#if SOC_CACHE_PRELOAD_SUPPORTED
+bool cache_hal_preload_addr(uint32_t vaddr, uint32_t size)
+{
+    bool valid = false;
+    uint32_t cache_level = 0;
+    uint32_t cache_id = 0;
+
+    valid = cache_hal_vaddr_to_cache_level_id(vaddr, size, &cache_level, &cache_id);
+    if (valid) {
+        cache_ll_preload_addr(cache_level, CACHE_TYPE_DATA, cache_id, vaddr, size);
+    }
+
+    return valid;
+}
+#endif  //#if SOC_CACHE_PRELOAD_SUPPORTED
+
 #if SOC_CACHE_FREEZE_SUPPORTED
 void cache_hal_freeze(uint32_t cache_level, cache_type_t type)
 {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -245,3 +245,62 @@ esp_err_t emac_hal_stop(emac_hal_context_t *hal)
 
     return ESP_OK;
 }
+
+#if SOC_EMAC_IEEE_1588_SUPPORT
+uint32_t emac_hal_ptp_start(emac_hal_context_t *hal, uint32_t ref_clk_hz)
+{
+    /* The sub-second increment is added when the accumulator of the addend overflows. Select the increment of
+       two reference clock periods so the accumulator overflows every other cycle at the nominal addend and
+       there is room to speed the system time up as well as to slow it down */
+    uint32_t sub_sec_incre = (2 * 1000000000ULL + ref_clk_hz - 1) / ref_clk_hz;
+    uint32_t addend = (uint32_t)((1000000000ULL << 32) / ((uint64_t)sub_sec_incre * ref_clk_hz));
+
+    emac_ll_ts_enable(hal->mac_regs, true);
+    emac_ll_ts_digital_rollover_enable(hal->mac_regs, true);
+    emac_ll_ts_ptp_v2_enable(hal->mac_regs, true);
+    emac_ll_ts_ptp_frame_types_enable(hal->mac_regs, true, true, true);
+    emac_ll_ts_all_frames_enable(hal->mac_regs, true);
+    emac_ll_ts_set_sub_sec_incre(hal->mac_regs, sub_sec_incre);
+    emac_ll_ts_fine_update_enable(hal->mac_regs, true);
+    emac_ll_ts_update_addend(hal->mac_regs, addend);
+    emac_ll_ts_init_time(hal->mac_regs, 0, 0);
+    return addend;
+}
+
+void emac_hal_ptp_stop(emac_hal_context_t *hal)
+{
+    emac_ll_ts_all_frames_enable(hal->mac_regs, false);
+    emac_ll_ts_enable(hal->mac_regs, false);
+}
+
+esp_err_t emac_hal_ptp_set_time(emac_hal_context_t *hal, uint32_t seconds, uint32_t nanoseconds)
+{
+    if (!emac_ll_ts_is_init_done(hal->mac_regs) || !emac_ll_ts_is_update_done(hal->mac_regs)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    emac_ll_ts_init_time(hal->mac_regs, seconds, nanoseconds);
+    return ESP_OK;
+}
+
+esp_err_t emac_hal_ptp_adj_time(emac_hal_context_t *hal, uint32_t seconds, uint32_t nanoseconds, bool subtract)
+{
+    if (!emac_ll_ts_is_init_done(hal->mac_regs) || !emac_ll_ts_is_update_done(hal->mac_regs)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    /* with the digital rollover, the nanoseconds to subtract are programmed as their complement to 1e9 */
+    if (subtract && nanoseconds) {
+        nanoseconds = 1000000000 - nanoseconds;
+    }
+    emac_ll_ts_update_time(hal->mac_regs, seconds, nanoseconds, subtract);
+    return ESP_OK;
+}
+
+esp_err_t emac_hal_ptp_set_addend(emac_hal_context_t *hal, uint32_t addend)
+{
+    if (!emac_ll_ts_is_addend_update_done(hal->mac_regs)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    emac_ll_ts_update_addend(hal->mac_regs, addend);
+    return ESP_OK;
+}
+#endif // SOC_EMAC_IEEE_1588_SUPPORT
@@ -559,12 +559,12 @@ static inline void emac_ll_disable_all_intr(emac_dma_dev_t *dma_regs)
     dma_regs->dmain_en.val = 0x00000000;
 }
 
-static inline void emac_ll_enable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
+__attribute__((always_inline)) static inline void emac_ll_enable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
 {
     dma_regs->dmain_en.val |= mask;
 }
 
-static inline void emac_ll_disable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
+__attribute__((always_inline)) static inline void emac_ll_disable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
 {
     dma_regs->dmain_en.val &= ~mask;
 }
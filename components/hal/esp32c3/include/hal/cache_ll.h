@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -345,6 +345,47 @@ static inline uint32_t cache_ll_l1_get_illegal_error_intr_status(uint32_t cache_
     return GET_PERI_REG_MASK(EXTMEM_CACHE_ILG_INT_ST_REG, mask);
 }
 
+/**
+ * @brief Clear the Cache access counters
+ */
+__attribute__((always_inline))
+static inline void cache_ll_l1_clear_access_counters(void)
+{
+    REG_WRITE(EXTMEM_CACHE_ACS_CNT_CLR_REG, EXTMEM_IBUS_ACS_CNT_CLR | EXTMEM_DBUS_ACS_CNT_CLR);
+}
+
+/**
+ * @brief Set the address ranges counted by the Cache access counters, and clear the counters
+ *
+ * Only the accesses inside these ranges are counted, they are set to the whole IBus and DBus
+ */
+static inline void cache_ll_l1_init_access_counters(void)
+{
+    REG_WRITE(EXTMEM_IBUS_TO_FLASH_START_VADDR_REG, SOC_IRAM0_CACHE_ADDRESS_LOW);
+    REG_WRITE(EXTMEM_IBUS_TO_FLASH_END_VADDR_REG, SOC_IRAM0_CACHE_ADDRESS_HIGH - 1);
+    REG_WRITE(EXTMEM_DBUS_TO_FLASH_START_VADDR_REG, SOC_DRAM0_CACHE_ADDRESS_LOW);
+    REG_WRITE(EXTMEM_DBUS_TO_FLASH_END_VADDR_REG, SOC_DRAM0_CACHE_ADDRESS_HIGH - 1);
+    cache_ll_l1_clear_access_counters();
+}
+
+/**
+ * @brief Get the Cache access counters
+ *
+ * @note There is no PSRAM on this chip, `dbus_psram_miss` is always 0
+ * @note The counters are 32 bits wide, they must be read and cleared often enough not to overflow
+ *
+ * @param[out] counters  Values of the counters since they were cleared
+ */
+__attribute__((always_inline))
+static inline void cache_ll_l1_get_access_counters(cache_access_counters_t *counters)
+{
+    counters->ibus_access = REG_READ(EXTMEM_IBUS_ACS_CNT_REG);
+    counters->ibus_miss = REG_READ(EXTMEM_IBUS_ACS_MISS_CNT_REG);
+    counters->dbus_access = REG_READ(EXTMEM_DBUS_ACS_CNT_REG);
+    counters->dbus_flash_miss = REG_READ(EXTMEM_DBUS_ACS_FLASH_MISS_CNT_REG);
+    counters->dbus_psram_miss = 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -618,6 +618,93 @@ static inline void cache_ll_writeback_addr(uint32_t cache_level, cache_type_t ty
     }
 }
 
+/**
+ * @brief Start to preload cache supported addr, the preload is done in the background
+ *
+ * @param cache_level       level of the cache
+ * @param type              see `cache_type_t`, only CACHE_TYPE_DATA is supported
+ * @param cache_id          id of the cache in this type and level
+ * @param vaddr             start address of the region to be preloaded
+ * @param size              size of the region to be preloaded, should not exceed the size of the cache
+ *
+ * @return Auto preload state before the manual preload, to be given to `cache_ll_end_preload`
+ */
+__attribute__((always_inline))
+static inline uint32_t cache_ll_start_preload_addr(uint32_t cache_level, cache_type_t type, uint32_t cache_id, uint32_t vaddr, uint32_t size)
+{
+    HAL_ASSERT(type == CACHE_TYPE_DATA);
+    if (cache_level == 2) {
+        return Cache_Start_L2_Cache_Preload(vaddr, size, 0);
+    }
+    return Cache_Start_L1_DCache_Preload(vaddr, size, 0);
+}
+
+/**
+ * @brief Check if the preload started by `cache_ll_start_preload_addr` is done
+ *
+ * @param cache_level       level of the cache
+ * @param type              see `cache_type_t`
+ * @param cache_id          id of the cache in this type and level
+ *
+ * @return true: done; false: in progress
+ */
+__attribute__((always_inline))
+static inline bool cache_ll_is_preload_done(uint32_t cache_level, cache_type_t type, uint32_t cache_id)
+{
+    if (cache_level == 2) {
+        return Cache_L2_Cache_Preload_Done();
+    }
+    return Cache_L1_DCache_Preload_Done();
+}
+
+/**
+ * @brief End a done preload and resume the auto preload
+ *
+ * @param cache_level       level of the cache
+ * @param type              see `cache_type_t`
+ * @param cache_id          id of the cache in this type and level
+ * @param autoload          auto preload state returned by `cache_ll_start_preload_addr`
+ */
+__attribute__((always_inline))
+static inline void cache_ll_end_preload(uint32_t cache_level, cache_type_t type, uint32_t cache_id, uint32_t autoload)
+{
+    if (cache_level == 2) {
+        Cache_End_L2_Cache_Preload(autoload);
+    } else {
+        Cache_End_L1_DCache_Preload(autoload);
+    }
+}
+
+/**
+ * @brief Preload cache supported addr
+ *
+ * Fill the DCache with a region in one burst, returns when the preload is done
+ *
+ * @param cache_level       level of the cache
+ * @param type              see `cache_type_t`, only CACHE_TYPE_DATA is supported
+ * @param cache_id          id of the cache in this type and level
+ * @param vaddr             start address of the region to be preloaded
+ * @param size              size of the region to be preloaded, should not exceed the size of the cache
+ */
+__attribute__((always_inline))
+static inline void cache_ll_preload_addr(uint32_t cache_level, cache_type_t type, uint32_t cache_id, uint32_t vaddr, uint32_t size)
+{
+    uint32_t autoload = 0;
+    if (cache_level == 2 || cache_level == CACHE_LL_LEVEL_ALL) {
+        autoload = cache_ll_start_preload_addr(2, type, cache_id, vaddr, size);
+        while (!cache_ll_is_preload_done(2, type, cache_id)) {
+        }
+        cache_ll_end_preload(2, type, cache_id, autoload);
+    }
+
+    if (cache_level == 1 || cache_level == 2 || cache_level == CACHE_LL_LEVEL_ALL) {
+        autoload = cache_ll_start_preload_addr(1, type, cache_id, vaddr, size);
+        while (!cache_ll_is_preload_done(1, type, cache_id)) {
+        }
+        cache_ll_end_preload(1, type, cache_id, autoload);
+    }
+}
+
 /**
  * @brief Writeback L1 DCache all
  *
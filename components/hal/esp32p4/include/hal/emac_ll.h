@@ -373,6 +373,94 @@ static inline void emac_ll_set_addr(emac_mac_dev_t *mac_regs, const uint8_t *add
     HAL_FORCE_MODIFY_U32_REG_FIELD(mac_regs->emacaddr0high, address0_hi, (addr[5] << 8) | addr[4]);
     mac_regs->emacaddr0low = (addr[3] << 24) | (addr[2] << 16) | (addr[1] << 8) | (addr[0]);
 }
+
+/* ptptsctrl */
+static inline void emac_ll_ts_enable(emac_mac_dev_t *mac_regs, bool enable)
+{
+    mac_regs->ptptsctrl.tsena = enable;
+}
+
+static inline void emac_ll_ts_fine_update_enable(emac_mac_dev_t *mac_regs, bool enable)
+{
+    mac_regs->ptptsctrl.tscfupdt = enable;
+}
+
+static inline void emac_ll_ts_digital_rollover_enable(emac_mac_dev_t *mac_regs, bool enable)
+{
+    mac_regs->ptptsctrl.tsctrlssr = enable;
+}
+
+static inline void emac_ll_ts_ptp_v2_enable(emac_mac_dev_t *mac_regs, bool enable)
+{
+    mac_regs->ptptsctrl.tsver2ena = enable;
+}
+
+static inline void emac_ll_ts_all_frames_enable(emac_mac_dev_t *mac_regs, bool enable)
+{
+    mac_regs->ptptsctrl.tsenall = enable;
+}
+
+static inline void emac_ll_ts_ptp_frame_types_enable(emac_mac_dev_t *mac_regs, bool ether, bool ipv4, bool ipv6)
+{
+    mac_regs->ptptsctrl.tsipena = ether;
+    mac_regs->ptptsctrl.tsipv4ena = ipv4;
+    mac_regs->ptptsctrl.tsipv6ena = ipv6;
+}
+
+static inline void emac_ll_ts_init_time(emac_mac_dev_t *mac_regs, uint32_t seconds, uint32_t nanoseconds)
+{
+    mac_regs->ptpsecupdt = seconds;
+    mac_regs->ptpnsecupdt.val = nanoseconds;
+    mac_regs->ptptsctrl.tsinit = 1;
+}
+
+static inline bool emac_ll_ts_is_init_done(emac_mac_dev_t *mac_regs)
+{
+    return !mac_regs->ptptsctrl.tsinit;
+}
+
+static inline void emac_ll_ts_update_time(emac_mac_dev_t *mac_regs, uint32_t seconds, uint32_t nanoseconds, bool subtract)
+{
+    mac_regs->ptpsecupdt = seconds;
+    mac_regs->ptpnsecupdt.val = (subtract ? (1U << 31) : 0) | nanoseconds;
+    mac_regs->ptptsctrl.tsupdt = 1;
+}
+
+static inline bool emac_ll_ts_is_update_done(emac_mac_dev_t *mac_regs)
+{
+    return !mac_regs->ptptsctrl.tsupdt;
+}
+
+static inline void emac_ll_ts_update_addend(emac_mac_dev_t *mac_regs, uint32_t addend)
+{
+    mac_regs->ptptsaddend = addend;
+    mac_regs->ptptsctrl.tsaddreg = 1;
+}
+
+static inline bool emac_ll_ts_is_addend_update_done(emac_mac_dev_t *mac_regs)
+{
+    return !mac_regs->ptptsctrl.tsaddreg;
+}
+
+/* ptpssinc */
+static inline void emac_ll_ts_set_sub_sec_incre(emac_mac_dev_t *mac_regs, uint32_t incre)
+{
+    HAL_FORCE_MODIFY_U32_REG_FIELD(mac_regs->ptpssinc, ssinc, incre);
+}
+
+/* ptpsec, ptpnsec */
+static inline void emac_ll_ts_get_time(emac_mac_dev_t *mac_regs, uint32_t *seconds, uint32_t *nanoseconds)
+{
+    uint32_t sec = mac_regs->ptpsec;
+    uint32_t nsec = mac_regs->ptpnsec.tsss;
+    /* the nanoseconds may have rolled over in between, read again in that case */
+    if (mac_regs->ptpsec != sec) {
+        sec = mac_regs->ptpsec;
+        nsec = mac_regs->ptpnsec.tsss;
+    }
+    *seconds = sec;
+    *nanoseconds = nsec;
+}
 /*************** End of mac regs operation *********************/
 
 
@@ -533,12 +621,12 @@ static inline void emac_ll_disable_all_intr(emac_dma_dev_t *dma_regs)
     dma_regs->dmain_en.val = 0x00000000;
 }
 
-static inline void emac_ll_enable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
+__attribute__((always_inline)) static inline void emac_ll_enable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
 {
     dma_regs->dmain_en.val |= mask;
 }
 
-static inline void emac_ll_disable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
+__attribute__((always_inline)) static inline void emac_ll_disable_corresponding_intr(emac_dma_dev_t *dma_regs, uint32_t mask)
 {
     dma_regs->dmain_en.val &= ~mask;
 }
@@ -689,6 +777,22 @@ static inline void emac_ll_clock_enable_rmii_output(void *ext_regs)
 /// the critical section needs to declare the __DECLARE_RCC_ATOMIC_ENV variable in advance
 #define emac_ll_clock_enable_rmii_output(...) (void)__DECLARE_RCC_ATOMIC_ENV; emac_ll_clock_enable_rmii_output(__VA_ARGS__)
 
+/**
+ * @brief Enable the PTP reference clock, sourced from XTAL
+ *
+ * @param ext_regs EMAC extension registers, unused on ESP32P4
+ * @param enable true to enable, false to disable
+ */
+static inline void emac_ll_clock_enable_ptp(void *ext_regs, bool enable)
+{
+    HP_SYS_CLKRST.peri_clk_ctrl01.reg_emac_ptp_ref_clk_src_sel = 0; // 0-XTAL, 1-PLL_F80M
+    HP_SYS_CLKRST.peri_clk_ctrl01.reg_emac_ptp_ref_clk_en = enable;
+}
+
+/// use a macro to wrap the function, force the caller to use it in a critical section
+/// the critical section needs to declare the __DECLARE_RCC_ATOMIC_ENV variable in advance
+#define emac_ll_clock_enable_ptp(...) (void)__DECLARE_RCC_ATOMIC_ENV; emac_ll_clock_enable_ptp(__VA_ARGS__)
+
 static inline void emac_ll_pause_frame_enable(void *ext_regs, bool enable)
 {
     HP_SYSTEM.sys_gmac_ctrl0.sys_phy_intf_sel = enable;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -377,6 +377,73 @@ static inline void cache_ll_writeback_addr(uint32_t cache_level, cache_type_t ty
     Cache_WriteBack_Addr(vaddr, size);
 }
 
+/**
+ * @brief Start to preload cache supported addr, the preload is done in the background
+ *
+ * @param cache_level       level of the cache
+ * @param type              see `cache_type_t`, only CACHE_TYPE_DATA is supported
+ * @param cache_id          id of the cache in this type and level
+ * @param vaddr             start address of the region to be preloaded
+ * @param size              size of the region to be preloaded, should not exceed the size of the cache
+ *
+ * @return Auto preload state before the manual preload, to be given to `cache_ll_end_preload`
+ */
+__attribute__((always_inline))
+static inline uint32_t cache_ll_start_preload_addr(uint32_t cache_level, cache_type_t type, uint32_t cache_id, uint32_t vaddr, uint32_t size)
+{
+    HAL_ASSERT(type == CACHE_TYPE_DATA);
+    return Cache_Start_DCache_Preload(vaddr, size, 0);
+}
+
+/**
+ * @brief Check if the preload started by `cache_ll_start_preload_addr` is done
+ *
+ * @param cache_level       level of the cache
+ * @param type              see `cache_type_t`
+ * @param cache_id          id of the cache in this type and level
+ *
+ * @return true: done; false: in progress
+ */
+__attribute__((always_inline))
+static inline bool cache_ll_is_preload_done(uint32_t cache_level, cache_type_t type, uint32_t cache_id)
+{
+    return Cache_DCache_Preload_Done();
+}
+
+/**
+ * @brief End a done preload and resume the auto preload
+ *
+ * @param cache_level       level of the cache
+ * @param type              see `cache_type_t`
+ * @param cache_id          id of the cache in this type and level
+ * @param autoload          auto preload state returned by `cache_ll_start_preload_addr`
+ */
+__attribute__((always_inline))
+static inline void cache_ll_end_preload(uint32_t cache_level, cache_type_t type, uint32_t cache_id, uint32_t autoload)
+{
+    Cache_End_DCache_Preload(autoload);
+}
+
+/**
+ * @brief Preload cache supported addr
+ *
+ * Fill the DCache with a region in one burst, returns when the preload is done
+ *
+ * @param cache_level       level of the cache
+ * @param type              see `cache_type_t`, only CACHE_TYPE_DATA is supported
+ * @param cache_id          id of the cache in this type and level
+ * @param vaddr             start address of the region to be preloaded
+ * @param size              size of the region to be preloaded, should not exceed the size of the cache
+ */
+__attribute__((always_inline))
+static inline void cache_ll_preload_addr(uint32_t cache_level, cache_type_t type, uint32_t cache_id, uint32_t vaddr, uint32_t size)
+{
+    uint32_t autoload = cache_ll_start_preload_addr(cache_level, type, cache_id, vaddr, size);
+    while (!cache_ll_is_preload_done(cache_level, type, cache_id)) {
+    }
+    cache_ll_end_preload(cache_level, type, cache_id, autoload);
+}
+
 /**
  * @brief Freeze ICache
  */
@@ -752,6 +819,46 @@ static inline uint32_t cache_ll_l1_get_illegal_error_intr_status(uint32_t cache_
     return GET_PERI_REG_MASK(EXTMEM_CACHE_ILG_INT_ST_REG, mask);
 }
 
+/**
+ * @brief Clear the Cache access counters
+ */
+__attribute__((always_inline))
+static inline void cache_ll_l1_clear_access_counters(void)
+{
+    REG_WRITE(EXTMEM_CACHE_ACS_CNT_CLR_REG, EXTMEM_ICACHE_ACS_CNT_CLR | EXTMEM_DCACHE_ACS_CNT_CLR);
+}
+
+/**
+ * @brief Set the address ranges counted by the Cache access counters, and clear the counters
+ *
+ * Only the accesses inside these ranges are counted, they are set to the whole IBus and DBus
+ */
+static inline void cache_ll_l1_init_access_counters(void)
+{
+    REG_WRITE(EXTMEM_IBUS_TO_FLASH_START_VADDR_REG, SOC_IRAM0_CACHE_ADDRESS_LOW);
+    REG_WRITE(EXTMEM_IBUS_TO_FLASH_END_VADDR_REG, SOC_IRAM0_CACHE_ADDRESS_HIGH - 1);
+    REG_WRITE(EXTMEM_DBUS_TO_FLASH_START_VADDR_REG, SOC_DRAM0_CACHE_ADDRESS_LOW);
+    REG_WRITE(EXTMEM_DBUS_TO_FLASH_END_VADDR_REG, SOC_DRAM0_CACHE_ADDRESS_HIGH - 1);
+    cache_ll_l1_clear_access_counters();
+}
+
+/**
+ * @brief Get the Cache access counters
+ *
+ * @note The counters are 32 bits wide, they must be read and cleared often enough not to overflow
+ *
+ * @param[out] counters  Values of the counters since they were cleared
+ */
+__attribute__((always_inline))
+static inline void cache_ll_l1_get_access_counters(cache_access_counters_t *counters)
+{
+    counters->ibus_access = REG_READ(EXTMEM_IBUS_ACS_CNT_REG);
+    counters->ibus_miss = REG_READ(EXTMEM_IBUS_ACS_MISS_CNT_REG);
+    counters->dbus_access = REG_READ(EXTMEM_DBUS_ACS_CNT_REG);
+    counters->dbus_flash_miss = REG_READ(EXTMEM_DBUS_ACS_FLASH_MISS_CNT_REG);
+    counters->dbus_psram_miss = REG_READ(EXTMEM_DBUS_ACS_SPIRAM_MISS_CNT_REG);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,6 @@
 
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -102,6 +102,20 @@ bool cache_hal_invalidate_addr(uint32_t vaddr, uint32_t size);
 bool cache_hal_writeback_addr(uint32_t vaddr, uint32_t size);
 #endif  //#if SOC_CACHE_WRITEBACK_SUPPORTED
 
+#if SOC_CACHE_PRELOAD_SUPPORTED
+/**
+ * @brief Preload Cache supported addr
+ *
+ * Fill the DCache with the region from the memory, the function returns when the preload is done
+ *
+ * @param vaddr  Start address of the region to preload
+ * @param size   Size of the region to preload
+ *
+ * @return       True for valid address. No operation if invalid
+ */
+bool cache_hal_preload_addr(uint32_t vaddr, uint32_t size);
+#endif  //#if SOC_CACHE_PRELOAD_SUPPORTED
+
 #if SOC_CACHE_FREEZE_SUPPORTED
 /**
  * @brief Freeze Cache
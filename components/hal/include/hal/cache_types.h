@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2010-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2010-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -34,6 +34,19 @@ typedef enum {
     CACHE_BUS_DBUS2 = BIT(5),
 } cache_bus_mask_t;
 
+/**
+ * @brief Cache access counters
+ *
+ * @note Not all chips count the data accesses to flash and to PSRAM separately, see `cache_ll_l1_get_access_counters`
+ */
+typedef struct {
+    uint32_t ibus_access;       ///< Number of instruction fetches through the cache
+    uint32_t ibus_miss;         ///< Number of instruction fetches which missed the cache
+    uint32_t dbus_access;       ///< Number of data accesses through the cache
+    uint32_t dbus_flash_miss;   ///< Number of data accesses to flash which missed the cache
+    uint32_t dbus_psram_miss;   ///< Number of data accesses to PSRAM which missed the cache
+} cache_access_counters_t;
+
 #ifdef __cplusplus
 }
 #endif
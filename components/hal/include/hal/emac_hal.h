@@ -276,6 +276,10 @@ void emac_hal_enable_flow_ctrl(emac_hal_context_t *hal, bool enable);
 
 #define emac_hal_get_intr_enable_status(hal) emac_ll_get_intr_enable_status((hal)->dma_regs)
 
+#define emac_hal_enable_corresponding_intr(hal, mask) emac_ll_enable_corresponding_intr((hal)->dma_regs, mask)
+
+#define emac_hal_disable_corresponding_intr(hal, mask) emac_ll_disable_corresponding_intr((hal)->dma_regs, mask)
+
 #define emac_hal_get_intr_status(hal) emac_ll_get_intr_status((hal)->dma_regs)
 
 #define emac_hal_clear_corresponding_intr(hal, bits) emac_ll_clear_corresponding_intr((hal)->dma_regs, bits)
@@ -288,6 +292,66 @@ void emac_hal_set_rx_tx_desc_addr(emac_hal_context_t *hal, eth_dma_rx_descriptor
 
 #define emac_hal_transmit_poll_demand(hal) emac_ll_transmit_poll_demand((hal)->dma_regs, 0)
 
+#if SOC_EMAC_IEEE_1588_SUPPORT
+#define emac_hal_clock_enable_ptp(hal, enable) emac_ll_clock_enable_ptp((hal)->ext_regs, enable)
+
+/**
+ * @brief Start the IEEE 1588 system time and timestamp all received and transmitted frames
+ *
+ * The system time is updated by the fine method and starts from zero.
+ *
+ * @param hal EMAC HAL context infostructure
+ * @param ref_clk_hz frequency of the PTP reference clock
+ * @return the addend at which the system time runs at the nominal rate, see emac_hal_ptp_set_addend
+ */
+uint32_t emac_hal_ptp_start(emac_hal_context_t *hal, uint32_t ref_clk_hz);
+
+/**
+ * @brief Stop the IEEE 1588 system time and the timestamping
+ *
+ * @param hal EMAC HAL context infostructure
+ */
+void emac_hal_ptp_stop(emac_hal_context_t *hal);
+
+/**
+ * @brief Set the IEEE 1588 system time
+ *
+ * @param hal EMAC HAL context infostructure
+ * @param seconds seconds of the new time
+ * @param nanoseconds nanoseconds of the new time, less than 1e9
+ * @return
+ *     - ESP_OK: succeed
+ *     - ESP_ERR_INVALID_STATE: a previous update of the system time is not completed yet
+ */
+esp_err_t emac_hal_ptp_set_time(emac_hal_context_t *hal, uint32_t seconds, uint32_t nanoseconds);
+
+/**
+ * @brief Add an offset to the IEEE 1588 system time, or subtract it
+ *
+ * @param hal EMAC HAL context infostructure
+ * @param seconds seconds of the offset
+ * @param nanoseconds nanoseconds of the offset, less than 1e9
+ * @param subtract true to subtract the offset from the system time
+ * @return
+ *     - ESP_OK: succeed
+ *     - ESP_ERR_INVALID_STATE: a previous update of the system time is not completed yet
+ */
+esp_err_t emac_hal_ptp_adj_time(emac_hal_context_t *hal, uint32_t seconds, uint32_t nanoseconds, bool subtract);
+
+/**
+ * @brief Set the addend of the fine update method, which sets the rate of the IEEE 1588 system time
+ *
+ * @param hal EMAC HAL context infostructure
+ * @param addend new addend, the system time runs faster with a greater addend
+ * @return
+ *     - ESP_OK: succeed
+ *     - ESP_ERR_INVALID_STATE: a previous update of the addend is not completed yet
+ */
+esp_err_t emac_hal_ptp_set_addend(emac_hal_context_t *hal, uint32_t addend);
+
+#define emac_hal_ptp_get_time(hal, seconds, nanoseconds) emac_ll_ts_get_time((hal)->mac_regs, seconds, nanoseconds)
+#endif // SOC_EMAC_IEEE_1588_SUPPORT
+
 #endif  // SOC_EMAC_SUPPORTED
 
 #ifdef __cplusplus
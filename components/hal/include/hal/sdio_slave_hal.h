@@ -221,6 +221,10 @@ typedef struct {
                                              * pre-negotiated value. Should be manually configured before using
                                              * the HAL.
                                              */
+    int                 send_aggregate_num; /**< Packet mode only. Max number of queued packets sent in one transfer,
+                                             * 0 or 1 to send the packets one by one. Should be manually configured
+                                             * before using the HAL.
+                                             */
     sdio_ringbuf_t      send_desc_queue;            /**< The ring buffer used to hold queued descriptors. Should be manually
                                              * initialized before using the HAL.
                                              */
@@ -119,6 +119,22 @@ static inline esp_err_t sdio_ringbuf_recv(sdio_ringbuf_t *buf, sdio_slave_hal_se
     return ESP_OK;
 }
 
+// same as ``sdio_ringbuf_recv`` with RINGBUF_GET_ONE, but get up to ``max_cnt`` descriptors at once
+static inline esp_err_t sdio_ringbuf_recv_max(sdio_ringbuf_t *buf, sdio_slave_hal_send_desc_t **start, sdio_slave_hal_send_desc_t **end, int max_cnt)
+{
+    HAL_ASSERT(buf->free_ptr == buf->read_ptr);   //must return before recv again
+    if (buf->read_ptr == buf->write_ptr) return ESP_ERR_NOT_FOUND; // no data
+
+    int cnt = ((buf->write_ptr + buf->size - buf->read_ptr) % buf->size) / SDIO_SLAVE_SEND_DESC_SIZE;
+    if (cnt > max_cnt) {
+        cnt = max_cnt;
+    }
+    *start = (sdio_slave_hal_send_desc_t *) sdio_ringbuf_offset_ptr(buf, RINGBUF_READ_PTR, SDIO_SLAVE_SEND_DESC_SIZE);
+    buf->read_ptr = sdio_ringbuf_offset_ptr(buf, RINGBUF_READ_PTR, cnt * SDIO_SLAVE_SEND_DESC_SIZE);
+    *end = (sdio_slave_hal_send_desc_t *) buf->read_ptr;
+    return ESP_OK;
+}
+
 static inline int sdio_ringbuf_return(sdio_ringbuf_t* buf, uint8_t *ptr)
 {
     HAL_ASSERT(sdio_ringbuf_offset_ptr(buf, RINGBUF_FREE_PTR, SDIO_SLAVE_SEND_DESC_SIZE) == ptr);
@@ -331,7 +347,15 @@ static esp_err_t send_check_new_packet(sdio_slave_context_t *hal)
     esp_err_t ret;
     sdio_slave_hal_send_desc_t *start = NULL;
     sdio_slave_hal_send_desc_t *end = NULL;
-    if (hal->sending_mode == SDIO_SLAVE_SEND_PACKET) {
+    if (hal->sending_mode == SDIO_SLAVE_SEND_PACKET && hal->send_aggregate_num > 1) {
+        ret = sdio_ringbuf_recv_max(&(hal->send_desc_queue), &start, &end, hal->send_aggregate_num);
+        if (ret == ESP_OK) {
+            // the packets queued so far are merged into one, only the last one keeps the eof
+            for (sdio_slave_hal_send_desc_t *desc = start; desc != end; desc = SEND_DESC_NEXT(desc)) {
+                desc->dma_desc.eof = 0;
+            }
+        }
+    } else if (hal->sending_mode == SDIO_SLAVE_SEND_PACKET) {
         ret = sdio_ringbuf_recv(&(hal->send_desc_queue), &start, &end, RINGBUF_GET_ONE);
     } else { //stream mode
         ret = sdio_ringbuf_recv(&(hal->send_desc_queue), &start, &end, RINGBUF_GET_ALL);
@@ -87,6 +87,7 @@ HEAP_IRAM_ATTR void *heap_caps_malloc( size_t size, uint32_t caps)
     if (!ptr && size > 0){
         heap_caps_alloc_failed(size, caps, __func__);
     }
+    HEAP_PSRAM_PROFILER_RECORD(ptr, size, caps);
 
     return ptr;
 }
@@ -128,6 +129,7 @@ HEAP_IRAM_ATTR void *heap_caps_malloc_default( size_t size )
         if (r==NULL && size > 0){
             heap_caps_alloc_failed(size, MALLOC_CAP_DEFAULT, __func__);
         }
+        HEAP_PSRAM_PROFILER_RECORD(r, size, MALLOC_CAP_DEFAULT);
 
         return r;
     }
@@ -162,6 +164,7 @@ HEAP_IRAM_ATTR void *heap_caps_realloc_default( void *ptr, size_t size )
         if (r==NULL && size>0){
             heap_caps_alloc_failed(size, MALLOC_CAP_DEFAULT, __func__);
         }
+        HEAP_PSRAM_PROFILER_RECORD(r, size, MALLOC_CAP_DEFAULT);
         return r;
     }
 }
@@ -186,6 +189,7 @@ HEAP_IRAM_ATTR void *heap_caps_malloc_prefer( size_t size, size_t num, ... )
     if (r == NULL && size > 0){
         heap_caps_alloc_failed(size, caps, __func__);
     }
+    HEAP_PSRAM_PROFILER_RECORD(r, size, caps);
     va_end( argp );
     return r;
 }
@@ -210,6 +214,7 @@ HEAP_IRAM_ATTR void *heap_caps_realloc_prefer( void *ptr, size_t size, size_t nu
     if (r == NULL && size > 0){
         heap_caps_alloc_failed(size, caps, __func__);
     }
+    HEAP_PSRAM_PROFILER_RECORD(r, size, caps);
     va_end( argp );
     return r;
 }
@@ -234,6 +239,7 @@ HEAP_IRAM_ATTR void *heap_caps_calloc_prefer( size_t n, size_t size, size_t num,
     if (r == NULL && size > 0){
         heap_caps_alloc_failed(size, caps, __func__);
     }
+    HEAP_PSRAM_PROFILER_RECORD(r, size, caps);
     va_end( argp );
     return r;
 }
@@ -246,6 +252,7 @@ HEAP_IRAM_ATTR void *heap_caps_realloc( void *ptr, size_t size, uint32_t caps)
     if (ptr == NULL && size > 0){
         heap_caps_alloc_failed(size, caps, __func__);
     }
+    HEAP_PSRAM_PROFILER_RECORD(ptr, size, caps);
 
     return ptr;
 }
@@ -258,6 +265,7 @@ HEAP_IRAM_ATTR void *heap_caps_calloc( size_t n, size_t size, uint32_t caps)
     if (!ptr && size > 0){
         heap_caps_alloc_failed(n * size, caps, __func__);
     }
+    HEAP_PSRAM_PROFILER_RECORD(ptr, n * size, caps);
 
     return ptr;
 }
@@ -511,15 +519,14 @@ HEAP_IRAM_ATTR void *heap_caps_aligned_alloc_default(size_t alignment, size_t si
         ret = heap_caps_aligned_alloc_base(alignment, size, MALLOC_CAP_DEFAULT | MALLOC_CAP_SPIRAM);
     }
 
-    if (ret != NULL) {
-        return ret;
+    if (ret == NULL) {
+        ret = heap_caps_aligned_alloc_base(alignment, size, MALLOC_CAP_DEFAULT);
     }
 
-    ret = heap_caps_aligned_alloc_base(alignment, size, MALLOC_CAP_DEFAULT);
-
     if (ret == NULL) {
         heap_caps_alloc_failed(size, MALLOC_CAP_DEFAULT, __func__);
     }
+    HEAP_PSRAM_PROFILER_RECORD(ret, size, MALLOC_CAP_DEFAULT);
 
     return ret;
 }
@@ -537,6 +544,7 @@ HEAP_IRAM_ATTR void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint
     if (ret == NULL) {
         heap_caps_alloc_failed(size, caps, __func__);
     }
+    HEAP_PSRAM_PROFILER_RECORD(ret, size, caps);
 
     return ret;
 }
@@ -67,7 +67,12 @@ HEAP_IRAM_ATTR void heap_caps_free( void *ptr)
     void *block_owner_ptr = MULTI_HEAP_REMOVE_BLOCK_OWNER_OFFSET(ptr);
     heap_t *heap = find_containing_heap(block_owner_ptr);
     assert(heap != NULL && "free() target pointer is outside heap areas");
-    multi_heap_free(heap->heap, block_owner_ptr);
+#if HEAP_CACHE_ENABLED
+    if (!heap_caps_cache_free(heap, block_owner_ptr))
+#endif
+    {
+        multi_heap_free(heap->heap, block_owner_ptr);
+    }
 
     CALL_HOOK(esp_heap_trace_free_hook, ptr);
 }
@@ -89,6 +94,24 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
 {
     void *ret = NULL;
 
+    if (caps & MALLOC_CAP_HINTS) {
+        uint32_t hints = caps & MALLOC_CAP_HINTS;
+        caps &= ~MALLOC_CAP_HINTS;
+        if (hints & MALLOC_CAP_STREAM) {
+            // streamed buffers must not share the cache lines at their ends with other data
+            caps |= MALLOC_CAP_CACHE_ALIGNED;
+        }
+        // an explicitly requested memory type overrides the hints
+        if (!(caps & (MALLOC_CAP_INTERNAL | MALLOC_CAP_SPIRAM | MALLOC_CAP_EXEC))) {
+            uint32_t preferred = (hints & MALLOC_CAP_HOT) ? MALLOC_CAP_INTERNAL : MALLOC_CAP_SPIRAM;
+            ret = heap_caps_aligned_alloc_base(alignment, size, caps | preferred);
+        }
+        if (ret == NULL) {
+            ret = heap_caps_aligned_alloc_base(alignment, size, caps);
+        }
+        return ret;
+    }
+
     // Alignment, size and caps may need to be modified because of hardware requirements.
     esp_heap_adjust_alignment_to_hw(&alignment, &size, &caps);
 
@@ -118,6 +141,21 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
         size = (size + 3) & (~3); // int overflow checked above
     }
 
+#if HEAP_CACHE_ENABLED
+    if (alignment <= UNALIGNED_MEM_ALIGNMENT_BYTES && !(caps & MALLOC_CAP_EXEC)) {
+        size_t block_size = MULTI_HEAP_ADD_BLOCK_OWNER_SIZE(size);
+        ret = heap_caps_cache_alloc(&block_size, caps);
+        if (ret != NULL) {
+            MULTI_HEAP_SET_BLOCK_OWNER(ret);
+            ret = MULTI_HEAP_ADD_BLOCK_OWNER_OFFSET(ret);
+            CALL_HOOK(esp_heap_trace_alloc_hook, ret, size, caps);
+            return ret;
+        }
+        size = MULTI_HEAP_REMOVE_BLOCK_OWNER_SIZE(block_size);
+    }
+    // if the heaps are exhausted, give the cached blocks back and try again
+    do {
+#endif
     for (int prio = 0; prio < SOC_MEMORY_TYPE_NO_PRIOS; prio++) {
         //Iterate over heaps and check capabilities at this priority
         heap_t *heap;
@@ -125,6 +163,10 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
             if (heap->heap == NULL) {
                 continue;
             }
+            // the ISR heap is reserved for the allocations which request it
+            if ((heap->caps[prio] & MALLOC_CAP_ISR) && !(caps & MALLOC_CAP_ISR)) {
+                continue;
+            }
             if ((heap->caps[prio] & caps) != 0) {
                 //Heap has at least one of the caps requested. If caps has other bits set that this prio
                 //doesn't cover, see if they're available in other prios.
@@ -160,6 +202,9 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
             }
         }
     }
+#if HEAP_CACHE_ENABLED
+    } while (heap_caps_cache_flush() != 0);
+#endif
 
     //Nothing usable found.
     return NULL;
@@ -182,6 +227,9 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_realloc_base( void *ptr, size_t siz
 
     //See if memory needs alignment because of hardware reasons.
     size_t alignment = UNALIGNED_MEM_ALIGNMENT_BYTES;
+    if (caps & MALLOC_CAP_STREAM) {
+        caps |= MALLOC_CAP_CACHE_ALIGNED;
+    }
     esp_heap_adjust_alignment_to_hw(&alignment, &size, &caps);
 
     if (ptr == NULL) {
@@ -227,7 +275,8 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_realloc_base( void *ptr, size_t siz
 
     // are the existing heap's capabilities compatible with the
     // requested ones?
-    bool compatible_caps = (caps & get_all_caps(heap)) == caps;
+    // placement hints are only used to choose the heap of a new allocation
+    bool compatible_caps = (caps & ~MALLOC_CAP_HINTS & get_all_caps(heap)) == (caps & ~MALLOC_CAP_HINTS);
 
     //Note we don't try realloc() on memory that needs to be aligned, that is handled
     //by the fallthrough code.
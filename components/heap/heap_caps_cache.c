@@ -0,0 +1,183 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "multi_heap.h"
+#include "heap_private.h"
+#include "freertos/FreeRTOS.h"
+
+/*
+This file implements a cache of small free blocks in front of the heaps, with one cache per CPU core.
+
+Freeing a small block from internal memory doesn't hand the block back to its heap, instead the block is pushed onto
+a list of blocks of the same size class in the cache of the calling core. A following allocation of the same size
+class on that core pops the block again. Each cache is protected by its own spinlock which is (apart from
+heap_caps_cache_flush() calls) only ever taken by one core, so allocations and frees served by the cache don't
+contend on the heap lock. Allocations which miss the cache are rounded up to the size of their size class, so the
+block fits the size class again when it is freed.
+
+Blocks held by a cache are counted as used by the heap. The caches are flushed when an allocation fails, before
+the allocation is retried.
+*/
+
+/* Only these caps are guaranteed by the cached blocks, requests for other capabilities bypass the cache */
+#define CACHE_CAPS (MALLOC_CAP_8BIT | MALLOC_CAP_32BIT | MALLOC_CAP_INTERNAL | MALLOC_CAP_DEFAULT)
+
+/* Block sizes of the size classes, as passed to multi_heap_malloc() (including the block owner) */
+static const uint16_t s_class_sizes[] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+
+#define NUM_CLASSES ((int)(sizeof(s_class_sizes) / sizeof(s_class_sizes[0])))
+
+typedef struct cached_block_ {
+    struct cached_block_ *next;
+} cached_block_t;
+
+typedef struct {
+    portMUX_TYPE lock;
+    cached_block_t *blocks[NUM_CLASSES];
+    uint8_t count[NUM_CLASSES];
+    heap_caps_cache_stats_t stats;
+} heap_cache_t;
+
+static heap_cache_t s_caches[portNUM_PROCESSORS] = {
+    [0 ... portNUM_PROCESSORS - 1] = { .lock = portMUX_INITIALIZER_UNLOCKED }
+};
+
+/* Smallest size class holding blocks of 'size' bytes, or -1 if the size is too large */
+HEAP_IRAM_ATTR static inline int size_class_for_alloc(size_t size)
+{
+    for (int i = 0; i < NUM_CLASSES; i++) {
+        if (size <= s_class_sizes[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Largest size class whose blocks fit into a block of 'size' bytes, or -1 if the block doesn't belong to a class */
+HEAP_IRAM_ATTR static inline int size_class_for_free(size_t size)
+{
+    if (size < s_class_sizes[0] || size >= s_class_sizes[NUM_CLASSES - 1] + s_class_sizes[0]) {
+        return -1;
+    }
+    int i = NUM_CLASSES - 1;
+    while (s_class_sizes[i] > size) {
+        i--;
+    }
+    return i;
+}
+
+HEAP_IRAM_ATTR void *heap_caps_cache_alloc(size_t *size, uint32_t caps)
+{
+    if ((caps & ~CACHE_CAPS) != 0) {
+        return NULL;
+    }
+
+    int cls = size_class_for_alloc(*size);
+    if (cls < 0) {
+        return NULL;
+    }
+
+    heap_cache_t *cache = &s_caches[xPortGetCoreID()];
+    portENTER_CRITICAL_SAFE(&cache->lock);
+    cached_block_t *block = cache->blocks[cls];
+    if (block != NULL) {
+        cache->blocks[cls] = block->next;
+        cache->count[cls]--;
+        cache->stats.hits++;
+        cache->stats.cached_blocks--;
+        cache->stats.cached_bytes -= s_class_sizes[cls];
+    } else {
+        cache->stats.misses++;
+    }
+    portEXIT_CRITICAL_SAFE(&cache->lock);
+
+    // let the caller allocate a block which fits this size class once it's freed
+    *size = s_class_sizes[cls];
+    return block;
+}
+
+HEAP_IRAM_ATTR bool heap_caps_cache_free(heap_t *heap, void *block)
+{
+    if ((get_all_caps(heap) & CACHE_CAPS) != CACHE_CAPS) {
+        return false;
+    }
+
+    int cls = size_class_for_free(multi_heap_get_allocated_size(heap->heap, block));
+    if (cls < 0) {
+        return false;
+    }
+
+    bool cached = false;
+    heap_cache_t *cache = &s_caches[xPortGetCoreID()];
+    portENTER_CRITICAL_SAFE(&cache->lock);
+    if (cache->count[cls] < CONFIG_HEAP_PER_CORE_CACHE_DEPTH) {
+        cached_block_t *cached_block = (cached_block_t *)block;
+        cached_block->next = cache->blocks[cls];
+        cache->blocks[cls] = cached_block;
+        cache->count[cls]++;
+        cache->stats.cached_frees++;
+        cache->stats.cached_blocks++;
+        cache->stats.cached_bytes += s_class_sizes[cls];
+        cached = true;
+    }
+    portEXIT_CRITICAL_SAFE(&cache->lock);
+    return cached;
+}
+
+HEAP_IRAM_ATTR size_t heap_caps_cache_flush(void)
+{
+    size_t released = 0;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        heap_cache_t *cache = &s_caches[core];
+
+        // detach all lists first, the heap lock must not be taken while holding the cache lock
+        cached_block_t *blocks[NUM_CLASSES];
+        portENTER_CRITICAL_SAFE(&cache->lock);
+        memcpy(blocks, cache->blocks, sizeof(blocks));
+        memset(cache->blocks, 0, sizeof(cache->blocks));
+        memset(cache->count, 0, sizeof(cache->count));
+        released += cache->stats.cached_bytes;
+        cache->stats.cached_blocks = 0;
+        cache->stats.cached_bytes = 0;
+        portEXIT_CRITICAL_SAFE(&cache->lock);
+
+        for (int cls = 0; cls < NUM_CLASSES; cls++) {
+            while (blocks[cls] != NULL) {
+                cached_block_t *block = blocks[cls];
+                blocks[cls] = block->next;
+                heap_t *heap = find_containing_heap(block);
+                assert(heap != NULL && "cached block is outside heap areas");
+                multi_heap_free(heap->heap, block);
+            }
+        }
+    }
+
+    return released;
+}
+
+void heap_caps_cache_get_stats(heap_caps_cache_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        heap_cache_t *cache = &s_caches[core];
+        portENTER_CRITICAL_SAFE(&cache->lock);
+        stats->hits += cache->stats.hits;
+        stats->misses += cache->stats.misses;
+        stats->cached_frees += cache->stats.cached_frees;
+        stats->cached_blocks += cache->stats.cached_blocks;
+        stats->cached_bytes += cache->stats.cached_bytes;
+        portEXIT_CRITICAL_SAFE(&cache->lock);
+    }
+}
@@ -13,6 +13,7 @@
 #include "multi_heap_platform.h"
 #include "esp_heap_caps_init.h"
 #include "heap_memory_layout.h"
+#include "esp_memory_utils.h"
 
 #include "esp_private/startup_internal.h"
 
@@ -160,6 +161,22 @@ void heap_caps_init(void)
             SLIST_INSERT_AFTER(&heaps_array[i-1], &heaps_array[i], next);
         }
     }
+
+#if CONFIG_HEAP_ISR_HEAP_SIZE > 0
+    /* The ISR heap is a static buffer in internal RAM. Allocations only get it if they request MALLOC_CAP_ISR, see
+       heap_caps_aligned_alloc_base(), so its lock is never held by other allocations. */
+    static uint8_t s_isr_heap[CONFIG_HEAP_ISR_HEAP_SIZE] __attribute__((aligned(4)));
+    uint32_t isr_heap_caps[SOC_MEMORY_TYPE_NO_PRIOS] = {
+        MALLOC_CAP_ISR | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT | MALLOC_CAP_32BIT,
+    };
+    if (esp_ptr_dma_capable(s_isr_heap)) {
+        isr_heap_caps[0] |= MALLOC_CAP_DMA;
+    }
+    esp_err_t err = heap_caps_add_region_with_caps(isr_heap_caps, (intptr_t)s_isr_heap, (intptr_t)s_isr_heap + sizeof(s_isr_heap));
+    if (err != ESP_OK) {
+        ESP_EARLY_LOGE(TAG, "Failed to register the ISR heap (0x%x)", err);
+    }
+#endif
 }
 
 esp_err_t heap_caps_add_region(intptr_t start, intptr_t end)
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_heap_caps_pool.h"
+#include "freertos/FreeRTOS.h"
+
+/*
+A pool is a single block of memory allocated with the requested caps and split into elements of equal size.
+Free elements are kept in a singly linked list which is stored in the free elements themselves, so allocating
+and freeing an element is just a list push or pop under the pool's spinlock.
+
+The pool structure itself holds the spinlock and is therefore always allocated from internal memory, the elements
+may live in any memory, e.g. DMA capable or external RAM.
+*/
+
+typedef struct pool_element_ {
+    struct pool_element_ *next;
+} pool_element_t;
+
+struct heap_caps_pool {
+    portMUX_TYPE lock;
+    uint8_t *storage;
+    size_t element_size;
+    size_t total_count;
+    size_t free_count;
+    size_t minimum_free;
+    pool_element_t *free_list;
+};
+
+esp_err_t heap_caps_pool_create(size_t element_size, size_t count, uint32_t caps, heap_caps_pool_handle_t *ret_pool)
+{
+    if (element_size == 0 || count == 0 || ret_pool == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // every element has to be able to hold the free list link, and stay aligned to it
+    element_size = (element_size + sizeof(pool_element_t) - 1) & ~(sizeof(pool_element_t) - 1);
+
+    size_t storage_size;
+    if (__builtin_mul_overflow(element_size, count, &storage_size)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    heap_caps_pool_handle_t pool = heap_caps_calloc(1, sizeof(struct heap_caps_pool), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (pool == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    pool->storage = heap_caps_aligned_alloc(sizeof(pool_element_t), storage_size, caps);
+    if (pool->storage == NULL) {
+        heap_caps_free(pool);
+        return ESP_ERR_NO_MEM;
+    }
+
+    portMUX_INITIALIZE(&pool->lock);
+    pool->element_size = element_size;
+    pool->total_count = count;
+    pool->free_count = count;
+    pool->minimum_free = count;
+
+    // build the list back to front, so elements are handed out in address order
+    pool->free_list = NULL;
+    for (size_t i = count; i > 0; i--) {
+        pool_element_t *element = (pool_element_t *)(pool->storage + (i - 1) * element_size);
+        element->next = pool->free_list;
+        pool->free_list = element;
+    }
+
+    *ret_pool = pool;
+    return ESP_OK;
+}
+
+esp_err_t heap_caps_pool_delete(heap_caps_pool_handle_t pool)
+{
+    if (pool == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (pool->free_count != pool->total_count) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    heap_caps_free(pool->storage);
+    heap_caps_free(pool);
+    return ESP_OK;
+}
+
+HEAP_IRAM_ATTR void *heap_caps_pool_alloc(heap_caps_pool_handle_t pool)
+{
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    portENTER_CRITICAL_SAFE(&pool->lock);
+    pool_element_t *element = pool->free_list;
+    if (element != NULL) {
+        pool->free_list = element->next;
+        pool->free_count--;
+        if (pool->free_count < pool->minimum_free) {
+            pool->minimum_free = pool->free_count;
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&pool->lock);
+
+    return element;
+}
+
+HEAP_IRAM_ATTR void heap_caps_pool_free(heap_caps_pool_handle_t pool, void *ptr)
+{
+    if (pool == NULL || ptr == NULL) {
+        return;
+    }
+
+    assert(heap_caps_pool_contains(pool, ptr) && "heap_caps_pool_free() pointer is not an element of the pool");
+
+    pool_element_t *element = (pool_element_t *)ptr;
+    portENTER_CRITICAL_SAFE(&pool->lock);
+    element->next = pool->free_list;
+    pool->free_list = element;
+    pool->free_count++;
+    portEXIT_CRITICAL_SAFE(&pool->lock);
+}
+
+HEAP_IRAM_ATTR bool heap_caps_pool_contains(heap_caps_pool_handle_t pool, const void *ptr)
+{
+    if (pool == NULL) {
+        return false;
+    }
+
+    uintptr_t start = (uintptr_t)pool->storage;
+    uintptr_t p = (uintptr_t)ptr;
+    if (p < start || p >= start + pool->element_size * pool->total_count) {
+        return false;
+    }
+    return ((p - start) % pool->element_size) == 0;
+}
+
+esp_err_t heap_caps_pool_get_info(heap_caps_pool_handle_t pool, heap_caps_pool_info_t *info)
+{
+    if (pool == NULL || info == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL_SAFE(&pool->lock);
+    info->element_size = pool->element_size;
+    info->total_count = pool->total_count;
+    info->free_count = pool->free_count;
+    info->minimum_free = pool->minimum_free;
+    portEXIT_CRITICAL_SAFE(&pool->lock);
+    return ESP_OK;
+}
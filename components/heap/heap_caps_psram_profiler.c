@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <string.h>
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "heap_private.h"
+#include "freertos/FreeRTOS.h"
+
+/*
+This file implements a profiler of the allocations placed in SPI RAM, grouped by call site.
+
+Every access to SPI RAM which misses the cache stalls the CPU for the refill of a whole cache line, and the heap
+can't tell which allocations are accessed often. The caches don't count misses per address, so the profiler records
+where SPI RAM allocations come from instead: call sites allocating many small blocks in SPI RAM usually hold hot
+structures which should be allocated with MALLOC_CAP_HOT, while large buffers are candidates for MALLOC_CAP_STREAM.
+The miss rate of the code using them can then be checked with the CPU performance counters.
+
+The call sites are kept in a small table, allocations from call sites which don't fit into the table anymore are
+only counted as dropped.
+*/
+
+static heap_caps_psram_callsite_t s_sites[CONFIG_HEAP_PSRAM_ALLOC_PROFILER_CALLSITES];
+static size_t s_site_num;
+static size_t s_dropped;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+HEAP_IRAM_ATTR void heap_caps_psram_profiler_record(const void *ptr, size_t size, uint32_t caps, const void *caller)
+{
+    if (ptr == NULL || !esp_ptr_external_ram(ptr)) {
+        return;
+    }
+
+    portENTER_CRITICAL_SAFE(&s_lock);
+    heap_caps_psram_callsite_t *site = NULL;
+    for (size_t i = 0; i < s_site_num; i++) {
+        if (s_sites[i].caller == caller) {
+            site = &s_sites[i];
+            break;
+        }
+    }
+    if (site == NULL && s_site_num < CONFIG_HEAP_PSRAM_ALLOC_PROFILER_CALLSITES) {
+        site = &s_sites[s_site_num++];
+        site->caller = caller;
+    }
+    if (site != NULL) {
+        site->count++;
+        site->total_bytes += size;
+        if (size > site->max_size) {
+            site->max_size = size;
+        }
+        if (caps & (MALLOC_CAP_COLD | MALLOC_CAP_STREAM)) {
+            site->hinted_count++;
+        }
+    } else {
+        s_dropped++;
+    }
+    portEXIT_CRITICAL_SAFE(&s_lock);
+}
+
+size_t heap_caps_psram_profiler_get_callsites(heap_caps_psram_callsite_t *sites, size_t max_sites)
+{
+    if (sites == NULL || max_sites == 0) {
+        return 0;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    size_t num = s_site_num < max_sites ? s_site_num : max_sites;
+    // selection of the most frequent call sites, the table is small
+    bool taken[CONFIG_HEAP_PSRAM_ALLOC_PROFILER_CALLSITES] = { false };
+    for (size_t n = 0; n < num; n++) {
+        size_t best = 0;
+        bool found = false;
+        for (size_t i = 0; i < s_site_num; i++) {
+            if (!taken[i] && (!found || s_sites[i].count > s_sites[best].count)) {
+                best = i;
+                found = true;
+            }
+        }
+        taken[best] = true;
+        sites[n] = s_sites[best];
+    }
+    portEXIT_CRITICAL(&s_lock);
+    return num;
+}
+
+void heap_caps_psram_profiler_dump(void)
+{
+    heap_caps_psram_callsite_t sites[CONFIG_HEAP_PSRAM_ALLOC_PROFILER_CALLSITES];
+    size_t num = heap_caps_psram_profiler_get_callsites(sites, CONFIG_HEAP_PSRAM_ALLOC_PROFILER_CALLSITES);
+
+    printf("SPI RAM allocations by call site:\n");
+    printf("%-12s %10s %12s %10s %10s %10s\n", "caller", "count", "bytes", "avg", "max", "hinted");
+    for (size_t i = 0; i < num; i++) {
+        printf("%-12p %10u %12u %10u %10u %10u\n", sites[i].caller, (unsigned)sites[i].count, (unsigned)sites[i].total_bytes,
+               (unsigned)(sites[i].total_bytes / sites[i].count), (unsigned)sites[i].max_size, (unsigned)sites[i].hinted_count);
+    }
+    if (s_dropped) {
+        printf("%u allocations from other call sites were not recorded, increase CONFIG_HEAP_PSRAM_ALLOC_PROFILER_CALLSITES\n", (unsigned)s_dropped);
+    }
+}
+
+void heap_caps_psram_profiler_reset(void)
+{
+    portENTER_CRITICAL(&s_lock);
+    memset(s_sites, 0, sizeof(s_sites));
+    s_site_num = 0;
+    s_dropped = 0;
+    portEXIT_CRITICAL(&s_lock);
+}
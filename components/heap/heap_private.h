@@ -7,6 +7,8 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
 #include <soc/soc_memory_layout.h>
 #include "multi_heap.h"
 #include "multi_heap_platform.h"
@@ -87,6 +89,29 @@ void *heap_caps_calloc_base(size_t n, size_t size, uint32_t caps);
 void *heap_caps_malloc_base(size_t size, uint32_t caps);
 void *heap_caps_aligned_alloc_base(size_t alignment, size_t size, uint32_t caps);
 
+/* Placement hints are not capabilities of any heap, they only select the preferred heaps */
+#define MALLOC_CAP_HINTS (MALLOC_CAP_HOT | MALLOC_CAP_COLD | MALLOC_CAP_STREAM)
+
+#if CONFIG_HEAP_PSRAM_ALLOC_PROFILER
+/* Record an allocation of 'size' bytes at 'ptr' made by 'caller', if it is placed in SPI RAM */
+void heap_caps_psram_profiler_record(const void *ptr, size_t size, uint32_t caps, const void *caller);
+#define HEAP_PSRAM_PROFILER_RECORD(ptr, size, caps) heap_caps_psram_profiler_record((ptr), (size), (caps), __builtin_return_address(0))
+#else
+#define HEAP_PSRAM_PROFILER_RECORD(ptr, size, caps)
+#endif
+
+#if CONFIG_HEAP_PER_CORE_CACHE && defined(MULTI_HEAP_FREERTOS)
+#define HEAP_CACHE_ENABLED 1
+
+/* Pop a cached block for an allocation of *size bytes (including the block owner) with caps.
+   Returns NULL on a miss. If the request belongs to a size class, *size is rounded up to the class size. */
+void *heap_caps_cache_alloc(size_t *size, uint32_t caps);
+
+/* Push a block which is about to be freed to the cache of the calling core.
+   Returns false if the block has to be freed to its heap. */
+bool heap_caps_cache_free(heap_t *heap, void *block);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,369 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sdkconfig.h>
+#include <inttypes.h>
+
+#define HEAP_TRACE_SRCFILE /* don't warn on inclusion here */
+#include "esp_heap_trace.h"
+#undef HEAP_TRACE_SRCFILE
+#include "esp_heap_caps.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_random.h"
+#include "freertos/FreeRTOS.h"
+
+#define STACK_DEPTH CONFIG_HEAP_TRACING_STACK_DEPTH
+
+#if CONFIG_HEAP_TRACING_SAMPLING
+
+/* The weight of a sample is tabulated for allocations of up to WEIGHT_TABLE_MAX times the sampling interval,
+   larger allocations are recorded with a probability so close to 1 that their weight is their size. */
+#define WEIGHT_TABLE_STEPS_PER_INTERVAL 4
+#define WEIGHT_TABLE_MAX                16
+#define WEIGHT_TABLE_SIZE               (WEIGHT_TABLE_STEPS_PER_INTERVAL * WEIGHT_TABLE_MAX + 1)
+#define LOG_TABLE_BITS                  6
+
+typedef enum {
+    TRACING_STARTED,
+    TRACING_STOPPED,
+    TRACING_ALLOC_PAUSED,
+} tracing_state_t;
+
+static portMUX_TYPE trace_mux = portMUX_INITIALIZER_UNLOCKED;
+static tracing_state_t tracing = TRACING_STOPPED;
+
+static heap_trace_callsite_t *s_sites;
+static size_t s_capacity;
+static size_t s_count;
+static bool s_has_overflowed;
+static size_t s_total_allocations;
+
+static uint32_t s_interval;
+static uint64_t s_recip_interval;       // 2^42 / interval, for the index into s_weight_q16
+static uint64_t s_ln2_interval_q16;     // interval * ln(2), Q16
+static uint32_t s_rand_state;
+
+/* Bytes left to allocate on each core before the next sample. The cores only update their own counter, without
+   lock; a preemption between the read and the write of a counter only shifts the next sample. */
+static int32_t s_bytes_until_sample[portNUM_PROCESSORS];
+
+/* x / (1 - e^-x) for x = i / WEIGHT_TABLE_STEPS_PER_INTERVAL, Q16: the inverse of the probability of an allocation of
+   x intervals to be sampled, times x */
+static uint32_t s_weight_q16[WEIGHT_TABLE_SIZE];
+
+/* log2(1 + (m + 0.5) / 2^LOG_TABLE_BITS), Q16 */
+static uint32_t s_log2_q16[1 << LOG_TABLE_BITS];
+
+/* Tables are computed once with the FPU or the soft-float library, the allocation path only uses integers
+   and stays safe to run while the flash cache is disabled */
+static void init_tables(void)
+{
+    s_weight_q16[0] = 1 << 16;
+    for (int i = 1; i < WEIGHT_TABLE_SIZE; i++) {
+        float x = (float)i / WEIGHT_TABLE_STEPS_PER_INTERVAL;
+        s_weight_q16[i] = (uint32_t)(x / (1.0f - expf(-x)) * 65536.0f);
+    }
+    for (int m = 0; m < (1 << LOG_TABLE_BITS); m++) {
+        s_log2_q16[m] = (uint32_t)(log2f(1.0f + (m + 0.5f) / (1 << LOG_TABLE_BITS)) * 65536.0f);
+    }
+}
+
+static HEAP_IRAM_ATTR uint32_t next_random(void)
+{
+    // xorshift32, statistical quality is enough to draw the sampling intervals
+    uint32_t x = s_rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rand_state = x;
+    return x;
+}
+
+/* Draw the distance to the next sample from an exponential distribution with a mean of s_interval bytes,
+   as interval * -ln(U) for U uniform in (0, 1) */
+static HEAP_IRAM_ATTR int32_t next_sample_distance(void)
+{
+    uint32_t u = next_random() | 1;
+    int lz = __builtin_clz(u);
+    uint32_t mantissa = ((u << lz) >> (31 - LOG_TABLE_BITS)) & ((1 << LOG_TABLE_BITS) - 1);
+    // -log2(u / 2^32) in Q16
+    uint32_t neg_log2_q16 = ((uint32_t)(1 + lz) << 16) - s_log2_q16[mantissa];
+    uint64_t distance = (s_ln2_interval_q16 * neg_log2_q16) >> 32;
+    if (distance == 0) {
+        return 1;
+    }
+    return distance > INT32_MAX ? INT32_MAX : (int32_t)distance;
+}
+
+/* Called for every allocation, before the call stack is read */
+static HEAP_IRAM_ATTR bool sample_allocation(size_t size)
+{
+    if (tracing != TRACING_STARTED || size == 0) {
+        return false;
+    }
+    int core = esp_cpu_get_core_id();
+    int32_t left = s_bytes_until_sample[core] - (int32_t)(size > INT32_MAX ? INT32_MAX : size);
+    if (left > 0) {
+        s_bytes_until_sample[core] = left;
+        return false;
+    }
+    s_bytes_until_sample[core] = next_sample_distance();
+    return true;
+}
+
+#define HEAP_TRACE_SAMPLE(size) sample_allocation(size)
+#define HEAP_TRACE_NO_FREE
+
+/* Number of bytes represented by a sampled allocation of the given size */
+static HEAP_IRAM_ATTR uint64_t sample_weight(size_t size)
+{
+    if (size >= (size_t)s_interval * WEIGHT_TABLE_MAX) {
+        return size;
+    }
+    // index in Q8
+    uint32_t pos = (uint32_t)(((uint64_t)size * s_recip_interval) >> 32);
+    uint32_t idx = pos >> 8;
+    uint32_t frac = pos & 0xff;
+    if (idx >= WEIGHT_TABLE_SIZE - 1) {
+        return size;
+    }
+    uint32_t weight_q16 = s_weight_q16[idx] + (((s_weight_q16[idx + 1] - s_weight_q16[idx]) * frac) >> 8);
+    return ((uint64_t)s_interval * weight_q16) >> 16;
+}
+
+static void reset_sampling(void)
+{
+    memset(s_sites, 0, sizeof(heap_trace_callsite_t) * s_capacity);
+    s_count = 0;
+    s_has_overflowed = false;
+    s_total_allocations = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        s_bytes_until_sample[core] = next_sample_distance();
+    }
+}
+
+esp_err_t heap_trace_init_standalone(heap_trace_record_t *record_buffer, size_t num_records)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t heap_trace_init_sampling(heap_trace_callsite_t *callsite_buffer, size_t num_callsites, size_t sample_interval)
+{
+    if ((tracing == TRACING_STARTED) || (tracing == TRACING_ALLOC_PAUSED)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (callsite_buffer == NULL || num_callsites == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (sample_interval == 0) {
+        sample_interval = CONFIG_HEAP_TRACING_SAMPLING_INTERVAL;
+    }
+
+    init_tables();
+    s_rand_state = esp_random() | 1;
+    s_interval = sample_interval;
+    s_recip_interval = ((uint64_t)WEIGHT_TABLE_STEPS_PER_INTERVAL << 40) / sample_interval;
+    s_ln2_interval_q16 = (uint64_t)((double)sample_interval * M_LN2 * 65536.0);
+    s_sites = callsite_buffer;
+    s_capacity = num_callsites;
+    reset_sampling();
+
+    return ESP_OK;
+}
+
+static esp_err_t set_tracing(tracing_state_t state)
+{
+    if (tracing == state) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    tracing = state;
+    return ESP_OK;
+}
+
+esp_err_t heap_trace_start(heap_trace_mode_t mode_param)
+{
+    if (s_sites == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (mode_param != HEAP_TRACE_ALL) {
+        // frees are not traced
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    portENTER_CRITICAL(&trace_mux);
+    set_tracing(TRACING_STOPPED);
+    reset_sampling();
+    const esp_err_t ret_val = set_tracing(TRACING_STARTED);
+    portEXIT_CRITICAL(&trace_mux);
+    return ret_val;
+}
+
+esp_err_t heap_trace_stop(void)
+{
+    portENTER_CRITICAL(&trace_mux);
+    const esp_err_t ret_val = set_tracing(TRACING_STOPPED);
+    portEXIT_CRITICAL(&trace_mux);
+    return ret_val;
+}
+
+esp_err_t heap_trace_alloc_pause(void)
+{
+    portENTER_CRITICAL(&trace_mux);
+    const esp_err_t ret_val = set_tracing(TRACING_ALLOC_PAUSED);
+    portEXIT_CRITICAL(&trace_mux);
+    return ret_val;
+}
+
+esp_err_t heap_trace_resume(void)
+{
+    portENTER_CRITICAL(&trace_mux);
+    const esp_err_t ret_val = set_tracing(TRACING_STARTED);
+    portEXIT_CRITICAL(&trace_mux);
+    return ret_val;
+}
+
+size_t heap_trace_get_count(void)
+{
+    return s_count;
+}
+
+esp_err_t heap_trace_get(size_t index, heap_trace_record_t *record)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static int compare_est_bytes(const void *a, const void *b)
+{
+    const heap_trace_callsite_t *site_a = a;
+    const heap_trace_callsite_t *site_b = b;
+    if (site_a->est_bytes == site_b->est_bytes) {
+        return 0;
+    }
+    return site_a->est_bytes < site_b->est_bytes ? 1 : -1;
+}
+
+esp_err_t heap_trace_get_callsites(heap_trace_callsite_t *callsites, size_t max_callsites, size_t *num_callsites)
+{
+    if (callsites == NULL || num_callsites == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // sort a snapshot of the call sites, without holding the lock
+    portENTER_CRITICAL(&trace_mux);
+    size_t count = s_count;
+    if (count > max_callsites) {
+        count = max_callsites;
+    }
+    memcpy(callsites, s_sites, sizeof(heap_trace_callsite_t) * count);
+    portEXIT_CRITICAL(&trace_mux);
+
+    qsort(callsites, count, sizeof(heap_trace_callsite_t), compare_est_bytes);
+    *num_callsites = count;
+    return ESP_OK;
+}
+
+esp_err_t heap_trace_summary(heap_trace_summary_t *summary)
+{
+    if (summary == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&trace_mux);
+    memset(summary, 0, sizeof(heap_trace_summary_t));
+    summary->mode = HEAP_TRACE_ALL;
+    summary->total_allocations = s_total_allocations;
+    summary->count = s_count;
+    summary->capacity = s_capacity;
+    summary->high_water_mark = s_count;
+    summary->has_overflowed = s_has_overflowed;
+    portEXIT_CRITICAL(&trace_mux);
+
+    return ESP_OK;
+}
+
+void heap_trace_dump(void)
+{
+    size_t count = 0;
+    heap_trace_callsite_t *sites = NULL;
+    if (s_capacity) {
+        sites = heap_caps_malloc(sizeof(heap_trace_callsite_t) * s_capacity, MALLOC_CAP_DEFAULT);
+    }
+    if (sites == NULL) {
+        printf("No call sites to dump\n");
+        return;
+    }
+    heap_trace_get_callsites(sites, s_capacity, &count);
+
+    printf("====== Heap Trace Sampling: %u call sites, 1 sample per %"PRIu32" bytes ======\n", count, s_interval);
+    printf("%12s %10s %8s %10s  call stack\n", "est. bytes", "est. count", "samples", "max size");
+    for (size_t i = 0; i < count; i++) {
+        const heap_trace_callsite_t *site = &sites[i];
+        printf("%12"PRIu64" %10"PRIu32" %8"PRIu32" %10u ",
+               site->est_bytes, site->est_count, site->samples, site->max_size);
+        for (int j = 0; j < STACK_DEPTH && site->alloced_by[j] != 0; j++) {
+            printf(" %p", site->alloced_by[j]);
+        }
+        printf("\n");
+    }
+    printf("====== %u samples%s ======\n", s_total_allocations,
+           s_has_overflowed ? ", call site buffer too small, some samples were dropped" : "");
+    heap_caps_free(sites);
+}
+
+void heap_trace_dump_caps(const uint32_t caps)
+{
+    // the call sites are not split by memory type
+    heap_trace_dump();
+}
+
+/* Add a sampled allocation to the statistics of its call stack */
+static HEAP_IRAM_ATTR void record_allocation(const heap_trace_record_t *r_allocation)
+{
+    if ((tracing != TRACING_STARTED) || (r_allocation->address == NULL)) {
+        return;
+    }
+    uint64_t weight = sample_weight(r_allocation->size);
+    uint32_t count = (uint32_t)((weight + r_allocation->size / 2) / r_allocation->size);
+
+    portENTER_CRITICAL(&trace_mux);
+
+    if (tracing == TRACING_STARTED) {
+        heap_trace_callsite_t *site = NULL;
+        for (size_t i = 0; i < s_count; i++) {
+            if (memcmp(s_sites[i].alloced_by, r_allocation->alloced_by, sizeof(void *) * STACK_DEPTH) == 0) {
+                site = &s_sites[i];
+                break;
+            }
+        }
+        if (site == NULL && s_count < s_capacity) {
+            site = &s_sites[s_count++];
+            memcpy(site->alloced_by, r_allocation->alloced_by, sizeof(void *) * STACK_DEPTH);
+        }
+        if (site != NULL) {
+            site->est_bytes += weight;
+            site->est_count += count;
+            site->samples++;
+            if (r_allocation->size > site->max_size) {
+                site->max_size = r_allocation->size;
+            }
+        } else {
+            s_has_overflowed = true;
+        }
+        s_total_allocations++;
+    }
+
+    portEXIT_CRITICAL(&trace_mux);
+}
+
+#include "heap_trace.inc"
+
+#endif // CONFIG_HEAP_TRACING_SAMPLING
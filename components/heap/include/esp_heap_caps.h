@@ -46,6 +46,10 @@ extern "C" {
 #define MALLOC_CAP_DMA_DESC_AHB     (1<<17) ///< Memory must be capable of containing AHB DMA descriptors
 #define MALLOC_CAP_DMA_DESC_AXI     (1<<18) ///< Memory must be capable of containing AXI DMA descriptors
 #define MALLOC_CAP_CACHE_ALIGNED    (1<<19) ///< Memory must be aligned to the cache line size of any intermediate caches
+#define MALLOC_CAP_HOT              (1<<20) ///< Placement hint: frequently accessed data, placed in internal memory if possible, otherwise anywhere else
+#define MALLOC_CAP_COLD             (1<<21) ///< Placement hint: rarely accessed data, placed in SPI RAM if possible to save internal memory, otherwise anywhere else
+#define MALLOC_CAP_STREAM           (1<<22) ///< Placement hint: large buffer accessed sequentially, placed in SPI RAM if possible and aligned to the cache line, so that it never shares a cache line with other data
+#define MALLOC_CAP_ISR              (1<<23) ///< Memory must be in the dedicated ISR heap (see CONFIG_HEAP_ISR_HEAP_SIZE), whose lock is only taken by the allocations requesting this capability
 
 #define MALLOC_CAP_INVALID          (1<<31) ///< Memory can't be used / list end marker
 
@@ -266,6 +270,80 @@ esp_err_t heap_caps_monitor_local_minimum_free_size_start(void);
  */
 esp_err_t heap_caps_monitor_local_minimum_free_size_stop(void);
 
+/**
+ * @brief Statistics of the per-core small block caches
+ */
+typedef struct {
+    size_t hits;           ///< Allocations served by a cache
+    size_t misses;         ///< Allocations of a cached size class which had to be served by a heap
+    size_t cached_frees;   ///< Frees which put the block into a cache instead of returning it to its heap
+    size_t cached_blocks;  ///< Blocks currently held by the caches
+    size_t cached_bytes;   ///< Total size of the blocks currently held by the caches
+} heap_caps_cache_stats_t;
+
+/**
+ * @brief Return all blocks held by the per-core small block caches to their heaps
+ *
+ * Blocks held by the caches are reported as used by heap_caps_get_free_size() and related functions.
+ * The caches are flushed automatically when an allocation fails, applications may also call this
+ * function periodically or before measuring the free heap size.
+ *
+ * @note Only available if CONFIG_HEAP_PER_CORE_CACHE is enabled.
+ *
+ * @return Number of bytes returned to the heaps
+ */
+size_t heap_caps_cache_flush(void);
+
+/**
+ * @brief Get the statistics of the per-core small block caches, summed over all cores
+ *
+ * @note Only available if CONFIG_HEAP_PER_CORE_CACHE is enabled.
+ *
+ * @param stats Pointer to the structure to fill
+ */
+void heap_caps_cache_get_stats(heap_caps_cache_stats_t *stats);
+
+/**
+ * @brief Allocation statistics of a call site placing memory in SPI RAM
+ */
+typedef struct {
+    const void *caller;    ///< Return address of the allocation call
+    size_t count;          ///< Number of allocations placed in SPI RAM
+    size_t total_bytes;    ///< Total size of the allocations placed in SPI RAM
+    size_t max_size;       ///< Size of the largest allocation placed in SPI RAM
+    size_t hinted_count;   ///< Number of those allocations which requested MALLOC_CAP_COLD or MALLOC_CAP_STREAM
+} heap_caps_psram_callsite_t;
+
+/**
+ * @brief Get the call sites which allocated memory in SPI RAM, the most frequent first
+ *
+ * The call site of an allocation is the return address of the heap_caps_*() function, or of malloc() and
+ * related functions if they call the heap directly as a tail call. Frequent small allocations placed in
+ * SPI RAM are the best candidates for MALLOC_CAP_HOT, as every access missing the cache stalls the CPU.
+ *
+ * @note Only available if CONFIG_HEAP_PSRAM_ALLOC_PROFILER is enabled.
+ *
+ * @param sites     Array to fill with the call sites
+ * @param max_sites Number of entries of the array
+ *
+ * @return Number of call sites filled in
+ */
+size_t heap_caps_psram_profiler_get_callsites(heap_caps_psram_callsite_t *sites, size_t max_sites);
+
+/**
+ * @brief Print the call sites which allocated memory in SPI RAM, the most frequent first
+ *
+ * @note Only available if CONFIG_HEAP_PSRAM_ALLOC_PROFILER is enabled.
+ */
+void heap_caps_psram_profiler_dump(void);
+
+/**
+ * @brief Clear the call sites recorded by the SPI RAM allocation profiler
+ *
+ * @note Only available if CONFIG_HEAP_PSRAM_ALLOC_PROFILER is enabled.
+ */
+void heap_caps_psram_profiler_reset(void);
+
 /**
  * @brief Get heap info for all regions with the given capabilities.
  *
@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque handle to a fixed-size object pool
+ */
+typedef struct heap_caps_pool *heap_caps_pool_handle_t;
+
+/**
+ * @brief Information about the usage of an object pool
+ */
+typedef struct {
+    size_t element_size;    ///< Size of each element in bytes, after rounding up for alignment
+    size_t total_count;     ///< Number of elements in the pool
+    size_t free_count;      ///< Number of elements currently free
+    size_t minimum_free;    ///< Lowest number of free elements since the pool was created
+} heap_caps_pool_info_t;
+
+/**
+ * @brief Create a pool of fixed-size elements
+ *
+ * The memory for all elements is allocated at once, with the given capabilities, when the pool is created.
+ * Allocating and freeing elements afterwards takes constant time and never touches the heap, so it neither
+ * fragments the heap nor depends on its state.
+ *
+ * @param element_size Size of each element in bytes. Rounded up to a multiple of the pointer size.
+ * @param count        Number of elements in the pool
+ * @param caps         Bitwise OR of MALLOC_CAP_* flags indicating the type of memory to allocate the elements from.
+ *                     The pool bookkeeping is always allocated from internal memory.
+ * @param[out] ret_pool Handle of the created pool
+ *
+ * @return
+ *         - ESP_OK on success
+ *         - ESP_ERR_INVALID_ARG if element_size or count is 0 or ret_pool is NULL
+ *         - ESP_ERR_NO_MEM if the memory for the pool could not be allocated
+ */
+esp_err_t heap_caps_pool_create(size_t element_size, size_t count, uint32_t caps, heap_caps_pool_handle_t *ret_pool);
+
+/**
+ * @brief Delete a pool and free its memory
+ *
+ * @param pool Handle of the pool
+ *
+ * @return
+ *         - ESP_OK on success
+ *         - ESP_ERR_INVALID_ARG if pool is NULL
+ *         - ESP_ERR_INVALID_STATE if elements of the pool are still allocated
+ */
+esp_err_t heap_caps_pool_delete(heap_caps_pool_handle_t pool);
+
+/**
+ * @brief Allocate an element from a pool
+ *
+ * @note This function can be called from an ISR, unless CONFIG_HEAP_PLACE_FUNCTION_INTO_FLASH is enabled.
+ *
+ * @param pool Handle of the pool
+ *
+ * @return Pointer to the element, aligned to the pointer size, or NULL if the pool is exhausted
+ */
+void *heap_caps_pool_alloc(heap_caps_pool_handle_t pool);
+
+/**
+ * @brief Return an element to the pool it was allocated from
+ *
+ * @note This function can be called from an ISR, unless CONFIG_HEAP_PLACE_FUNCTION_INTO_FLASH is enabled.
+ *
+ * @param pool Handle of the pool
+ * @param ptr  Pointer returned by heap_caps_pool_alloc() for this pool. NULL is ignored.
+ */
+void heap_caps_pool_free(heap_caps_pool_handle_t pool, void *ptr);
+
+/**
+ * @brief Check whether ptr points to an element of a pool
+ *
+ * @param pool Handle of the pool
+ * @param ptr  Pointer to check
+ *
+ * @return true if ptr is the address of an element of the pool, whether allocated or not
+ */
+bool heap_caps_pool_contains(heap_caps_pool_handle_t pool, const void *ptr);
+
+/**
+ * @brief Get information about the usage of a pool
+ *
+ * @param pool Handle of the pool
+ * @param[out] info Structure to fill
+ *
+ * @return
+ *         - ESP_OK on success
+ *         - ESP_ERR_INVALID_ARG if pool or info is NULL
+ */
+esp_err_t heap_caps_pool_get_info(heap_caps_pool_handle_t pool, heap_caps_pool_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif
@@ -61,6 +61,20 @@ typedef struct {
 #endif
 } heap_trace_summary_t;
 
+/**
+ * @brief Statistics of the allocations made from one call stack, in sampling mode
+ *
+ * The estimated values are extrapolated from the recorded samples and are exact for the call sites making only
+ * allocations larger than the sampling interval.
+ */
+typedef struct {
+    void *alloced_by[CONFIG_HEAP_TRACING_STACK_DEPTH]; ///< Call stack of the allocations
+    uint64_t est_bytes;                                ///< Estimated number of bytes allocated
+    uint32_t est_count;                                ///< Estimated number of allocations
+    uint32_t samples;                                  ///< Number of recorded allocations
+    size_t max_size;                                   ///< Size of the largest recorded allocation
+} heap_trace_callsite_t;
+
 /**
  * @brief Initialise heap tracing in standalone mode.
  *
@@ -89,6 +103,39 @@ esp_err_t heap_trace_init_standalone(heap_trace_record_t *record_buffer, size_t
  */
 esp_err_t heap_trace_init_tohost(void);
 
+/**
+ * @brief Initialise heap tracing in sampling mode.
+ *
+ * This function must be called before any other heap tracing functions.
+ *
+ * One allocation is recorded for every sample_interval bytes allocated on average, and added to the statistics of
+ * its call stack. heap_trace_get_count() returns the number of call sites, heap_trace_get() is not supported.
+ *
+ * @param callsite_buffer Buffer for the call site statistics, in internal RAM to record the allocations made from ISRs.
+ * @param num_callsites Size of the buffer, as number of call sites. Samples from further call sites are only counted
+ *                      in heap_trace_summary_t::has_overflowed.
+ * @param sample_interval Mean number of bytes allocated between two samples, 0 for CONFIG_HEAP_TRACING_SAMPLING_INTERVAL.
+ * @return
+ *  - ESP_ERR_INVALID_STATE Heap tracing is currently in progress.
+ *  - ESP_ERR_INVALID_ARG The buffer is NULL or empty.
+ *  - ESP_OK Heap tracing initialised successfully.
+ */
+esp_err_t heap_trace_init_sampling(heap_trace_callsite_t *callsite_buffer, size_t num_callsites, size_t sample_interval);
+
+/**
+ * @brief Copy the statistics of the call sites recorded in sampling mode, the largest estimated number of bytes first
+ *
+ * @note It is safe to call this function while heap tracing is running.
+ *
+ * @param[out] callsites Buffer receiving the call sites
+ * @param max_callsites Size of the buffer
+ * @param[out] num_callsites Number of call sites copied
+ * @return
+ * - ESP_ERR_INVALID_ARG callsites or num_callsites is NULL.
+ * - ESP_OK Call sites copied.
+ */
+esp_err_t heap_trace_get_callsites(heap_trace_callsite_t *callsites, size_t max_callsites, size_t *num_callsites);
+
 /**
  * @brief Start heap tracing. All heap allocations & frees will be traced, until heap_trace_stop() is called.
  *
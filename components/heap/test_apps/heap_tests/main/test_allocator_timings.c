@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
@@ -7,6 +7,7 @@
 #include <esp_types.h>
 #include <stdio.h>
 #include "unity.h"
+#include "unity_test_utils_bench.h"
 #include "esp_attr.h"
 #include "esp_heap_caps.h"
 #include "esp_log.h"
@@ -113,4 +114,26 @@ TEST_CASE("Heap many random allocations timings", "[heap]")
 
     TEST_ASSERT(heap_caps_check_integrity(MALLOC_CAP_DEFAULT, true));
 }
+
+static void bench_malloc_free(void *arg)
+{
+    heap_caps_free(heap_caps_malloc(*(size_t *)arg, MALLOC_CAP_DEFAULT));
+}
+
+TEST_CASE("Heap malloc/free benchmark", "[heap]")
+{
+    static const size_t sizes[] = { 16, 256, 4096 };
+    unity_utils_bench_config_t config = UNITY_UTILS_BENCH_CONFIG_DEFAULT(NULL);
+    config.iterations = 1000;
+    config.disable_interrupts = true;
+    for (int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "heap_malloc_free_%zu", sizes[i]);
+        config.name = name;
+        unity_utils_bench_result_t result;
+        unity_utils_bench_run(&config, bench_malloc_free, (void *)&sizes[i], &result);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(result.median, result.p99);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(result.p99, result.max);
+    }
+}
 #endif
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+
+// These tests only apply when the per-core cache is enabled
+#if CONFIG_HEAP_PER_CORE_CACHE
+
+TEST_CASE("small blocks freed are reused from the per-core cache", "[heap][cache]")
+{
+    heap_caps_cache_flush();
+    heap_caps_cache_stats_t before;
+    heap_caps_cache_get_stats(&before);
+
+    void *first = heap_caps_malloc(40, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(first);
+    heap_caps_free(first);
+
+    heap_caps_cache_stats_t stats;
+    heap_caps_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(before.cached_frees + 1, stats.cached_frees);
+    TEST_ASSERT_EQUAL(1, stats.cached_blocks);
+
+    // a slightly different size of the same size class gets the same block back
+    void *second = heap_caps_malloc(36, MALLOC_CAP_8BIT);
+    TEST_ASSERT_EQUAL_PTR(first, second);
+    heap_caps_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(before.hits + 1, stats.hits);
+    TEST_ASSERT_EQUAL(0, stats.cached_blocks);
+
+    // requests for other capabilities bypass the cache
+    heap_caps_free(second);
+    void *dma = heap_caps_malloc(40, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(dma);
+    heap_caps_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(before.hits + 1, stats.hits);
+    heap_caps_free(dma);
+
+    TEST_ASSERT_GREATER_THAN(0, heap_caps_cache_flush());
+    heap_caps_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.cached_blocks);
+    TEST_ASSERT_EQUAL(0, stats.cached_bytes);
+}
+
+TEST_CASE("per-core cache is flushed when the heap is exhausted", "[heap][cache]")
+{
+    // fill the caches with as many blocks as they take
+    void *blocks[CONFIG_HEAP_PER_CORE_CACHE_DEPTH * 2];
+    for (int i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++) {
+        blocks[i] = heap_caps_malloc(200, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    for (int i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++) {
+        heap_caps_free(blocks[i]);
+    }
+    heap_caps_cache_stats_t stats;
+    heap_caps_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.cached_blocks);
+
+    // the largest free block can only be allocated if nothing is held back by the cache
+    size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    void *huge = heap_caps_malloc(heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT),
+                                  MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NULL(huge);
+    heap_caps_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.cached_blocks);
+
+    huge = heap_caps_malloc(largest, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(huge);
+    heap_caps_free(huge);
+}
+
+#if CONFIG_FREERTOS_NUMBER_OF_CORES > 1
+static void alloc_free_task(void *arg)
+{
+    SemaphoreHandle_t done = (SemaphoreHandle_t)arg;
+    for (int i = 0; i < 10000; i++) {
+        uint8_t *p = heap_caps_malloc(16 + (i % 200), MALLOC_CAP_8BIT);
+        TEST_ASSERT_NOT_NULL(p);
+        memset(p, i, 16);
+        heap_caps_free(p);
+    }
+    xSemaphoreGive(done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("per-core cache handles concurrent allocations on all cores", "[heap][cache]")
+{
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(CONFIG_FREERTOS_NUMBER_OF_CORES, 0);
+    TEST_ASSERT_NOT_NULL(done);
+    for (int core = 0; core < CONFIG_FREERTOS_NUMBER_OF_CORES; core++) {
+        xTaskCreatePinnedToCore(alloc_free_task, "alloc_free", 4096, done, 5, NULL, core);
+    }
+    for (int core = 0; core < CONFIG_FREERTOS_NUMBER_OF_CORES; core++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(done, pdMS_TO_TICKS(10000)));
+    }
+    vSemaphoreDelete(done);
+    vTaskDelay(10); // let the idle task free the task stacks
+
+    heap_caps_cache_stats_t stats;
+    heap_caps_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.hits);
+    TEST_ASSERT_TRUE(heap_caps_check_integrity_all(true));
+}
+#endif // CONFIG_FREERTOS_NUMBER_OF_CORES > 1
+
+#endif // CONFIG_HEAP_PER_CORE_CACHE
@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <string.h>
+#include "unity.h"
+#include "esp_heap_caps.h"
+#include "esp_heap_caps_pool.h"
+#include "esp_memory_utils.h"
+
+TEST_CASE("object pool hands out all elements exactly once", "[heap][pool]")
+{
+    const size_t count = 10;
+    heap_caps_pool_handle_t pool;
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_pool_create(13, count, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, &pool));
+
+    heap_caps_pool_info_t info;
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_pool_get_info(pool, &info));
+    TEST_ASSERT_EQUAL(16, info.element_size);
+    TEST_ASSERT_EQUAL(count, info.total_count);
+    TEST_ASSERT_EQUAL(count, info.free_count);
+
+    void *elements[10];
+    for (int i = 0; i < count; i++) {
+        elements[i] = heap_caps_pool_alloc(pool);
+        TEST_ASSERT_NOT_NULL(elements[i]);
+        TEST_ASSERT_TRUE(heap_caps_pool_contains(pool, elements[i]));
+        TEST_ASSERT_EQUAL(0, (uintptr_t)elements[i] % sizeof(void *));
+        memset(elements[i], i, 13);
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_NOT_EQUAL(elements[j], elements[i]);
+        }
+    }
+    TEST_ASSERT_NULL(heap_caps_pool_alloc(pool));
+    TEST_ASSERT_FALSE(heap_caps_pool_contains(pool, (uint8_t *)elements[0] + 1));
+
+    // elements still in use can't be deleted
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, heap_caps_pool_delete(pool));
+
+    for (int i = 0; i < count; i++) {
+        uint8_t *element = elements[i];
+        TEST_ASSERT_EQUAL(i, element[12]);
+        heap_caps_pool_free(pool, element);
+    }
+    heap_caps_pool_free(pool, NULL);
+
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_pool_get_info(pool, &info));
+    TEST_ASSERT_EQUAL(count, info.free_count);
+    TEST_ASSERT_EQUAL(0, info.minimum_free);
+
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_pool_delete(pool));
+}
+
+TEST_CASE("object pool elements have the requested caps", "[heap][pool]")
+{
+    heap_caps_pool_handle_t pool;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, heap_caps_pool_create(0, 4, MALLOC_CAP_DMA, &pool));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, heap_caps_pool_create(32, 0, MALLOC_CAP_DMA, &pool));
+
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_pool_create(32, 4, MALLOC_CAP_DMA, &pool));
+    void *element = heap_caps_pool_alloc(pool);
+    TEST_ASSERT_TRUE(esp_ptr_dma_capable(element));
+    heap_caps_pool_free(pool, element);
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_pool_delete(pool));
+
+    // the pool memory is allocated up front
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, heap_caps_pool_create(1024, free_before / 1024 + 1, MALLOC_CAP_8BIT, &pool));
+}
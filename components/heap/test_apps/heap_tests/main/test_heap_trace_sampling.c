@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ Tests for the sampling heap tracing mode
+
+ Only compiled in if CONFIG_HEAP_TRACING_SAMPLING is set
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "unity.h"
+
+#include "esp_heap_caps.h"
+
+#ifdef CONFIG_HEAP_TRACING_SAMPLING
+
+#include "esp_heap_trace.h"
+
+#define TEST_SAMPLE_INTERVAL    256
+#define TEST_NUM_CALLSITES      32
+
+static heap_trace_callsite_t s_sites[TEST_NUM_CALLSITES];
+static heap_trace_callsite_t s_sorted[TEST_NUM_CALLSITES];
+
+/* All the allocations of a test are made from here, so that they have the same call stack */
+static void __attribute__((noinline)) alloc_and_free(size_t size, int count)
+{
+    for (int i = 0; i < count; i++) {
+        void *p = malloc(size);
+        TEST_ASSERT_NOT_NULL(p);
+        free(p);
+    }
+}
+
+static const heap_trace_callsite_t *find_site(size_t max_size)
+{
+    size_t count = 0;
+    TEST_ESP_OK(heap_trace_get_callsites(s_sorted, TEST_NUM_CALLSITES, &count));
+    for (size_t i = 0; i < count; i++) {
+        if (s_sorted[i].max_size == max_size) {
+            return &s_sorted[i];
+        }
+    }
+    return NULL;
+}
+
+TEST_CASE("heap trace sampling records large allocations exactly", "[heap-trace]")
+{
+    const size_t size = TEST_SAMPLE_INTERVAL * 64;
+    TEST_ESP_OK(heap_trace_init_sampling(s_sites, TEST_NUM_CALLSITES, TEST_SAMPLE_INTERVAL));
+    TEST_ESP_OK(heap_trace_start(HEAP_TRACE_ALL));
+    alloc_and_free(size, 10);
+    heap_trace_stop();
+
+    const heap_trace_callsite_t *site = find_site(size);
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL_UINT32(10, site->samples);
+    TEST_ASSERT_EQUAL_UINT32(10, site->est_count);
+    TEST_ASSERT_EQUAL_UINT64(10 * size, site->est_bytes);
+}
+
+TEST_CASE("heap trace sampling estimates small allocations", "[heap-trace]")
+{
+    const size_t size = 24;
+    const int count = 20000;
+    TEST_ESP_OK(heap_trace_init_sampling(s_sites, TEST_NUM_CALLSITES, TEST_SAMPLE_INTERVAL));
+    TEST_ESP_OK(heap_trace_start(HEAP_TRACE_ALL));
+    alloc_and_free(size, count);
+    heap_trace_stop();
+
+    const heap_trace_callsite_t *site = find_site(size);
+    TEST_ASSERT_NOT_NULL(site);
+    printf("%"PRIu32" samples, estimated %"PRIu64" bytes in %"PRIu32" allocations\n",
+           site->samples, site->est_bytes, site->est_count);
+    // about 1900 samples, the estimates are within a few percent
+    TEST_ASSERT_UINT64_WITHIN(size * count / 5, size * count, site->est_bytes);
+    TEST_ASSERT_UINT32_WITHIN(count / 5, count, site->est_count);
+    TEST_ASSERT_LESS_THAN_UINT32(count / 4, site->samples);
+    heap_trace_dump();
+}
+
+TEST_CASE("heap trace sampling API checks", "[heap-trace]")
+{
+    heap_trace_record_t record;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, heap_trace_init_sampling(NULL, TEST_NUM_CALLSITES, 0));
+    TEST_ESP_OK(heap_trace_init_sampling(s_sites, TEST_NUM_CALLSITES, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, heap_trace_start(HEAP_TRACE_LEAKS));
+    TEST_ESP_OK(heap_trace_start(HEAP_TRACE_ALL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, heap_trace_init_sampling(s_sites, TEST_NUM_CALLSITES, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, heap_trace_get(0, &record));
+    TEST_ESP_OK(heap_trace_stop());
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, heap_trace_stop());
+}
+
+#endif // CONFIG_HEAP_TRACING_SAMPLING
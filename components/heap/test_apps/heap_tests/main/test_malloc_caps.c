@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
@@ -354,3 +354,71 @@ TEST_CASE("test memory protection features", "[heap][mem_prot]")
     TEST_ASSERT_NULL(iram_ptr);
 #endif // CONFIG_ESP_SYSTEM_MEMPROT_FEATURE
 }
+
+TEST_CASE("placement hints select the preferred memory", "[heap]")
+{
+    void *hot = heap_caps_malloc(64, MALLOC_CAP_8BIT | MALLOC_CAP_HOT);
+    TEST_ASSERT_NOT_NULL(hot);
+    TEST_ASSERT(esp_ptr_internal(hot));
+
+    // without SPI RAM the hints fall back to the internal memory
+    void *cold = heap_caps_malloc(64, MALLOC_CAP_8BIT | MALLOC_CAP_COLD);
+    TEST_ASSERT_NOT_NULL(cold);
+    void *stream = heap_caps_malloc(1000, MALLOC_CAP_8BIT | MALLOC_CAP_STREAM);
+    TEST_ASSERT_NOT_NULL(stream);
+#if CONFIG_SPIRAM
+    TEST_ASSERT(esp_ptr_external_ram(cold));
+    TEST_ASSERT(esp_ptr_external_ram(stream));
+#endif
+
+    // explicit location caps always win over the hints
+    void *internal = heap_caps_malloc(64, MALLOC_CAP_INTERNAL | MALLOC_CAP_COLD);
+    TEST_ASSERT_NOT_NULL(internal);
+    TEST_ASSERT(esp_ptr_internal(internal));
+
+    hot = heap_caps_realloc(hot, 256, MALLOC_CAP_8BIT | MALLOC_CAP_HOT);
+    TEST_ASSERT_NOT_NULL(hot);
+    TEST_ASSERT(esp_ptr_internal(hot));
+
+    heap_caps_free(hot);
+    heap_caps_free(cold);
+    heap_caps_free(stream);
+    heap_caps_free(internal);
+}
+
+#if CONFIG_HEAP_ISR_HEAP_SIZE > 0
+TEST_CASE("ISR heap is only used by MALLOC_CAP_ISR allocations", "[heap]")
+{
+    TEST_ASSERT_LESS_OR_EQUAL(CONFIG_HEAP_ISR_HEAP_SIZE, heap_caps_get_total_size(MALLOC_CAP_ISR));
+    TEST_ASSERT_EQUAL(0, heap_caps_get_free_size(MALLOC_CAP_ISR | MALLOC_CAP_DEFAULT));
+
+    // exhaust the ISR heap
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_ISR);
+    void *blocks[CONFIG_HEAP_ISR_HEAP_SIZE / 64];
+    int count = 0;
+    intptr_t isr_start = INTPTR_MAX, isr_end = 0;
+    while (count < sizeof(blocks) / sizeof(blocks[0])) {
+        void *p = heap_caps_malloc(64, MALLOC_CAP_ISR);
+        if (p == NULL) {
+            break;
+        }
+        TEST_ASSERT(esp_ptr_internal(p));
+        isr_start = MIN(isr_start, (intptr_t)p);
+        isr_end = MAX(isr_end, (intptr_t)p + 64);
+        blocks[count++] = p;
+    }
+    TEST_ASSERT_GREATER_THAN(0, count);
+    TEST_ASSERT_NULL(heap_caps_malloc(64, MALLOC_CAP_ISR));
+
+    // the other allocations are still served, and never from the ISR heap
+    void *other = heap_caps_malloc(64, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(other);
+    TEST_ASSERT((intptr_t)other < isr_start || (intptr_t)other >= isr_end);
+    heap_caps_free(other);
+
+    for (int i = 0; i < count; i++) {
+        heap_caps_free(blocks[i]);
+    }
+    TEST_ASSERT_EQUAL(free_before, heap_caps_get_free_size(MALLOC_CAP_ISR));
+}
+#endif // CONFIG_HEAP_ISR_HEAP_SIZE > 0
@@ -37,6 +37,18 @@ def test_heap_poisoning_qemu(dut: Dut) -> None:
             dut._run_normal_case(case)
 
 
+@pytest.mark.generic
+@pytest.mark.supported_targets
+@pytest.mark.parametrize(
+    'config',
+    [
+        'per_core_cache'
+    ]
+)
+def test_heap_per_core_cache(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
+
+
 @pytest.mark.generic
 @pytest.mark.supported_targets
 @pytest.mark.parametrize(
@@ -114,6 +126,23 @@ def test_heap_trace_dump(dut: Dut) -> None:
     dut.run_all_single_board_cases(group='heap-trace')
 
 
+@pytest.mark.generic
+@pytest.mark.parametrize(
+    'target',
+    [
+        'esp32',
+    ]
+)
+@pytest.mark.parametrize(
+    'config',
+    [
+        'heap_trace_sampling'
+    ]
+)
+def test_heap_trace_sampling(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='heap-trace')
+
+
 @pytest.mark.generic
 @pytest.mark.supported_targets
 @pytest.mark.temp_skip_ci(targets=['esp32c61'], reason='support TBD')  # TODO [ESP32C61] IDF-9858 IDF-10989
@@ -486,6 +486,29 @@ int http_message_needs_eof(const http_parser *parser);
  * assumed that the caller cares about (and can detect) the transition between
  * URL and non-URL states by looking for these.
  */
+/* Finds the first CR or LF, a word at a time once the pointer is aligned.
+ * Unlike two memchr() calls, the data is scanned only once. */
+#define HAS_ZERO_BYTE(w)    (((w) - 0x01010101U) & ~(w) & 0x80808080U)
+
+static const char *
+find_eol(const char *p, size_t len)
+{
+  const char *pe = p + len;
+  uint32_t w;
+
+  for (; p != pe && ((uintptr_t) p & (sizeof(w) - 1)); p++) {
+    if (*p == CR || *p == LF) return p;
+  }
+  for (; (size_t) (pe - p) >= sizeof(w); p += sizeof(w)) {
+    memcpy(&w, p, sizeof(w));
+    if (HAS_ZERO_BYTE(w ^ 0x0D0D0D0DU) | HAS_ZERO_BYTE(w ^ 0x0A0A0A0AU)) break;
+  }
+  for (; p != pe; p++) {
+    if (*p == CR || *p == LF) return p;
+  }
+  return NULL;
+}
+
 static enum state
 parse_url_char(enum state s, const char ch)
 {
@@ -1332,7 +1355,15 @@ reexecute:
 
           switch (parser->header_state) {
             case h_general:
+            {
+              /* Skip the remaining token characters of the field without
+               * going through the header state switch for each of them */
+              const char* pe = data + len;
+              while (p + 1 < pe && TOKEN(p[1])) {
+                p++;
+              }
               break;
+            }
 
             case h_C:
               parser->index++;
@@ -1558,21 +1589,14 @@ reexecute:
           switch (h_state) {
             case h_general:
             {
-              const char* p_cr;
-              const char* p_lf;
+              const char* p_eol;
               size_t limit = data + len - p;
 
               limit = MIN(limit, HTTP_MAX_HEADER_SIZE);
 
-              p_cr = (const char*) memchr(p, CR, limit);
-              p_lf = (const char*) memchr(p, LF, limit);
-              if (p_cr != NULL) {
-                if (p_lf != NULL && p_cr >= p_lf)
-                  p = p_lf;
-                else
-                  p = p_cr;
-              } else if (UNLIKELY(p_lf != NULL)) {
-                p = p_lf;
+              p_eol = find_eol(p, limit);
+              if (p_eol != NULL) {
+                p = p_eol;
               } else {
                 p = data + len;
               }
@@ -0,0 +1,229 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "esp_json_arena.h"
+#include "esp_json_stream.h"
+
+/*
+ * The tree is built from the events of the streaming parser, the nodes are laid out in the arena directly instead
+ * of going through the global cJSON allocation hooks, which would affect every other user of cJSON. The free memory
+ * of the arena is the token buffer of the parser: a key or a string is unescaped right where it is then kept, and
+ * the token buffer is moved past each allocation, before the next token starts.
+ */
+
+#define ARENA_ALIGN     8   // cJSON nodes hold doubles
+
+typedef struct {
+    esp_json_arena_t *arena;
+    esp_json_stream_t *stream;
+    cJSON *root;
+    cJSON *parents[ESP_JSON_STREAM_MAX_DEPTH];
+    char *key;              // key of the next member of an object
+} arena_builder_t;
+
+static void arena_set_token_buf(arena_builder_t *builder)
+{
+    esp_json_arena_t *arena = builder->arena;
+
+    builder->stream->config.token_buf = (char *)arena->buf + arena->used;
+    builder->stream->config.token_buf_size = arena->size - arena->used;
+}
+
+static cJSON *arena_new_node(arena_builder_t *builder, int type, int depth)
+{
+    esp_json_arena_t *arena = builder->arena;
+
+    size_t start = (arena->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (start > arena->size || sizeof(cJSON) > arena->size - start) {
+        arena->exhausted = true;
+        return NULL;
+    }
+    arena->used = start + sizeof(cJSON);
+    arena_set_token_buf(builder);
+
+    cJSON *node = (cJSON *)(arena->buf + start);
+    memset(node, 0, sizeof(cJSON));
+    node->type = type;
+    node->string = builder->key;
+    builder->key = NULL;
+
+    if (depth == 0) {
+        builder->root = node;
+        return node;
+    }
+    // The first child points to the last one, as with cJSON_AddItemToArray()
+    cJSON *parent = builder->parents[depth - 1];
+    if (parent->child) {
+        cJSON *last = parent->child->prev;
+        last->next = node;
+        node->prev = last;
+    } else {
+        parent->child = node;
+    }
+    parent->child->prev = node;
+    return node;
+}
+
+// The key or string is in the token buffer, at the start of the free memory
+static char *arena_keep_token(arena_builder_t *builder, size_t len)
+{
+    esp_json_arena_t *arena = builder->arena;
+    char *token = (char *)arena->buf + arena->used;
+
+    arena->used += len + 1;
+    arena_set_token_buf(builder);
+    return token;
+}
+
+static esp_err_t arena_event(esp_json_event_t event, const char *value, size_t len, int depth, void *ctx)
+{
+    arena_builder_t *builder = ctx;
+    cJSON *node = NULL;
+    char *string;
+    double number;
+
+    switch (event) {
+    case ESP_JSON_EVENT_OBJECT_START:
+    case ESP_JSON_EVENT_ARRAY_START:
+        node = arena_new_node(builder, event == ESP_JSON_EVENT_OBJECT_START ? cJSON_Object : cJSON_Array, depth);
+        if (node) {
+            builder->parents[depth] = node;
+        }
+        break;
+    case ESP_JSON_EVENT_OBJECT_END:
+    case ESP_JSON_EVENT_ARRAY_END:
+        return ESP_OK;
+    case ESP_JSON_EVENT_KEY:
+        builder->key = arena_keep_token(builder, len);
+        return ESP_OK;
+    case ESP_JSON_EVENT_STRING:
+        string = arena_keep_token(builder, len);
+        node = arena_new_node(builder, cJSON_String, depth);
+        if (node) {
+            node->valuestring = string;
+        }
+        break;
+    case ESP_JSON_EVENT_NUMBER:
+        // Converted before the node is allocated over the number
+        number = strtod(value, NULL);
+        node = arena_new_node(builder, cJSON_Number, depth);
+        if (node) {
+            // Same saturation as cJSON_SetNumberValue()
+            node->valuedouble = number;
+            if (number >= INT_MAX) {
+                node->valueint = INT_MAX;
+            } else if (number <= (double)INT_MIN) {
+                node->valueint = INT_MIN;
+            } else {
+                node->valueint = (int)number;
+            }
+        }
+        break;
+    case ESP_JSON_EVENT_TRUE:
+        node = arena_new_node(builder, cJSON_True, depth);
+        if (node) {
+            node->valueint = 1;
+        }
+        break;
+    case ESP_JSON_EVENT_FALSE:
+        node = arena_new_node(builder, cJSON_False, depth);
+        break;
+    case ESP_JSON_EVENT_NULL:
+        node = arena_new_node(builder, cJSON_NULL, depth);
+        break;
+    }
+    return node ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t esp_json_arena_init(esp_json_arena_t *arena, void *buf, size_t size)
+{
+    if (!arena || !buf) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // align the start of the arena, the allocations are aligned relative to it
+    size_t skip = (ARENA_ALIGN - ((uintptr_t)buf & (ARENA_ALIGN - 1))) & (ARENA_ALIGN - 1);
+    arena->buf = (uint8_t *)buf + skip;
+    arena->size = size > skip ? size - skip : 0;
+    arena->used = 0;
+    arena->exhausted = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_json_arena_parse(esp_json_arena_t *arena, const char *json, size_t len, cJSON **out_root)
+{
+    esp_json_stream_t stream;
+    arena_builder_t builder = {
+        .arena = arena,
+        .stream = &stream,
+    };
+
+    if (!arena || !json || !out_root) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_root = NULL;
+    size_t used = arena->used;
+    arena->exhausted = false;
+    if (arena->used >= arena->size) {
+        arena->exhausted = true;
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_json_stream_config_t config = {
+        .callback = arena_event,
+        .ctx = &builder,
+        .token_buf = (char *)arena->buf + arena->used,
+        .token_buf_size = arena->size - arena->used,
+    };
+    esp_err_t ret = esp_json_stream_init(&stream, &config);
+    if (ret == ESP_OK) {
+        ret = esp_json_stream_feed(&stream, json, len);
+    }
+    if (ret == ESP_OK) {
+        ret = esp_json_stream_finish(&stream);
+    }
+
+    if (ret != ESP_OK) {
+        // nothing of the failed parse is referenced
+        arena->used = used;
+        if (ret == ESP_ERR_NO_MEM) {
+            arena->exhausted = true;
+        }
+        return ret == ESP_ERR_NO_MEM || ret == ESP_ERR_INVALID_SIZE ? ret : ESP_FAIL;
+    }
+    *out_root = builder.root;
+    return ESP_OK;
+}
+
+char *esp_json_arena_print(esp_json_arena_t *arena, const cJSON *item, bool format)
+{
+    if (!arena || !item) {
+        return NULL;
+    }
+
+    // cJSON_PrintPreallocated() prints into the buffer it is given, nothing is allocated from the hooks
+    char *out = (char *)arena->buf + arena->used;
+    size_t avail = arena->size - arena->used;
+    if (avail > INT32_MAX) {
+        avail = INT32_MAX;
+    }
+    if (!cJSON_PrintPreallocated((cJSON *)item, out, (int)avail, format)) {
+        return NULL;
+    }
+    arena->used += strlen(out) + 1;
+    return out;
+}
+
+void esp_json_arena_reset(esp_json_arena_t *arena)
+{
+    if (arena) {
+        arena->used = 0;
+        arena->exhausted = false;
+    }
+}
@@ -0,0 +1,470 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_json_stream.h"
+
+/*
+ * The document is tokenized one character at a time, so the chunks can split it anywhere. The lexer state tells
+ * which token is being collected, the parse state which token the grammar expects next. The keys, strings and
+ * numbers are collected in the caller's token buffer, the nesting is kept as one bit per level.
+ */
+
+enum {
+    LEX_NONE,
+    LEX_STRING,
+    LEX_ESCAPE,
+    LEX_UNICODE,
+    LEX_NUMBER,
+    LEX_LITERAL,
+};
+
+enum {
+    PS_VALUE,           // value, at the top level, after ':' and after ',' in an array
+    PS_VALUE_OR_END,    // value or ']', after '['
+    PS_KEY,             // key, after ',' in an object
+    PS_KEY_OR_END,      // key or '}', after '{'
+    PS_COLON,           // ':', after a key
+    PS_NEXT,            // ',' or the end of the container, after a value in a container
+    PS_DONE,            // the top level value is complete
+};
+
+static const struct {
+    const char *text;
+    esp_json_event_t event;
+} s_literals[] = {
+    { "true", ESP_JSON_EVENT_TRUE },
+    { "false", ESP_JSON_EVENT_FALSE },
+    { "null", ESP_JSON_EVENT_NULL },
+};
+
+static inline bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static inline bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static inline bool is_number_char(char c)
+{
+    return is_digit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+/* Checks a number against the JSON grammar, -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+ * strtod() is more lenient, it accepts "01", "1." or ".5" for example */
+static bool number_valid(const char *num, size_t len)
+{
+    size_t i = 0;
+
+    if (i < len && num[i] == '-') {
+        i++;
+    }
+    if (i < len && num[i] == '0') {
+        i++;
+    } else if (i < len && is_digit(num[i])) {
+        while (i < len && is_digit(num[i])) {
+            i++;
+        }
+    } else {
+        return false;
+    }
+    if (i < len && num[i] == '.') {
+        size_t digits = ++i;
+        while (i < len && is_digit(num[i])) {
+            i++;
+        }
+        if (i == digits) {
+            return false;
+        }
+    }
+    if (i < len && (num[i] == 'e' || num[i] == 'E')) {
+        i++;
+        if (i < len && (num[i] == '+' || num[i] == '-')) {
+            i++;
+        }
+        size_t digits = i;
+        while (i < len && is_digit(num[i])) {
+            i++;
+        }
+        if (i == digits) {
+            return false;
+        }
+    }
+    return i == len;
+}
+
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static esp_err_t emit(esp_json_stream_t *stream, esp_json_event_t event, bool with_token)
+{
+    const char *value = NULL;
+    size_t len = 0;
+
+    if (with_token) {
+        value = stream->config.token_buf;
+        len = stream->token_len;
+        stream->config.token_buf[len] = '\0';
+    }
+    return stream->config.callback(event, value, len, stream->depth, stream->config.ctx);
+}
+
+static inline esp_err_t token_append(esp_json_stream_t *stream, char c)
+{
+    if (stream->token_len >= stream->config.token_buf_size - 1) {
+        return ESP_ERR_NO_MEM;
+    }
+    stream->config.token_buf[stream->token_len++] = c;
+    return ESP_OK;
+}
+
+static esp_err_t token_append_utf8(esp_json_stream_t *stream, uint32_t cp)
+{
+    esp_err_t ret;
+
+    if (cp < 0x80) {
+        return token_append(stream, cp);
+    }
+    if (cp < 0x800) {
+        ret = token_append(stream, 0xC0 | (cp >> 6));
+    } else if (cp < 0x10000) {
+        ret = token_append(stream, 0xE0 | (cp >> 12));
+        if (ret == ESP_OK) {
+            ret = token_append(stream, 0x80 | ((cp >> 6) & 0x3F));
+        }
+    } else {
+        ret = token_append(stream, 0xF0 | (cp >> 18));
+        if (ret == ESP_OK) {
+            ret = token_append(stream, 0x80 | ((cp >> 12) & 0x3F));
+        }
+        if (ret == ESP_OK) {
+            ret = token_append(stream, 0x80 | ((cp >> 6) & 0x3F));
+        }
+    }
+    if (ret == ESP_OK) {
+        ret = token_append(stream, 0x80 | (cp & 0x3F));
+    }
+    return ret;
+}
+
+static inline bool in_object(const esp_json_stream_t *stream)
+{
+    return stream->containers & (1UL << (stream->depth - 1));
+}
+
+static void value_done(esp_json_stream_t *stream)
+{
+    stream->parse_state = stream->depth ? PS_NEXT : PS_DONE;
+}
+
+static esp_err_t string_end(esp_json_stream_t *stream)
+{
+    stream->lex_state = LEX_NONE;
+    if (stream->parse_state == PS_KEY || stream->parse_state == PS_KEY_OR_END) {
+        stream->parse_state = PS_COLON;
+        return emit(stream, ESP_JSON_EVENT_KEY, true);
+    }
+    value_done(stream);
+    return emit(stream, ESP_JSON_EVENT_STRING, true);
+}
+
+static esp_err_t number_end(esp_json_stream_t *stream)
+{
+    stream->lex_state = LEX_NONE;
+    /* The characters were checked while collecting them, their order is checked here */
+    if (!number_valid(stream->config.token_buf, stream->token_len)) {
+        return ESP_FAIL;
+    }
+    value_done(stream);
+    return emit(stream, ESP_JSON_EVENT_NUMBER, true);
+}
+
+static esp_err_t container_start(esp_json_stream_t *stream, bool object)
+{
+    esp_err_t ret;
+
+    if (stream->depth >= ESP_JSON_STREAM_MAX_DEPTH) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    ret = emit(stream, object ? ESP_JSON_EVENT_OBJECT_START : ESP_JSON_EVENT_ARRAY_START, false);
+    if (object) {
+        stream->containers |= 1UL << stream->depth;
+    } else {
+        stream->containers &= ~(1UL << stream->depth);
+    }
+    stream->depth++;
+    stream->parse_state = object ? PS_KEY_OR_END : PS_VALUE_OR_END;
+    return ret;
+}
+
+static esp_err_t container_end(esp_json_stream_t *stream, bool object)
+{
+    if (stream->depth == 0 || in_object(stream) != object) {
+        return ESP_FAIL;
+    }
+    stream->depth--;
+    value_done(stream);
+    return emit(stream, object ? ESP_JSON_EVENT_OBJECT_END : ESP_JSON_EVENT_ARRAY_END, false);
+}
+
+static esp_err_t value_start(esp_json_stream_t *stream, char c)
+{
+    stream->token_len = 0;
+    switch (c) {
+    case '{':
+        return container_start(stream, true);
+    case '[':
+        return container_start(stream, false);
+    case '"':
+        stream->lex_state = LEX_STRING;
+        return ESP_OK;
+    case 't':
+    case 'f':
+    case 'n':
+        stream->lex_state = LEX_LITERAL;
+        stream->literal = (c == 't') ? 0 : (c == 'f') ? 1 : 2;
+        stream->literal_pos = 1;
+        return ESP_OK;
+    default:
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            stream->lex_state = LEX_NUMBER;
+            return token_append(stream, c);
+        }
+        return ESP_FAIL;
+    }
+}
+
+static esp_err_t structural_char(esp_json_stream_t *stream, char c)
+{
+    if (is_space(c)) {
+        return ESP_OK;
+    }
+
+    switch (stream->parse_state) {
+    case PS_VALUE:
+        return value_start(stream, c);
+    case PS_VALUE_OR_END:
+        if (c == ']') {
+            return container_end(stream, false);
+        }
+        return value_start(stream, c);
+    case PS_KEY_OR_END:
+        if (c == '}') {
+            return container_end(stream, true);
+        }
+    /* fall through */
+    case PS_KEY:
+        if (c == '"') {
+            stream->token_len = 0;
+            stream->lex_state = LEX_STRING;
+            return ESP_OK;
+        }
+        return ESP_FAIL;
+    case PS_COLON:
+        if (c == ':') {
+            stream->parse_state = PS_VALUE;
+            return ESP_OK;
+        }
+        return ESP_FAIL;
+    case PS_NEXT:
+        if (c == ',') {
+            stream->parse_state = in_object(stream) ? PS_KEY : PS_VALUE;
+            return ESP_OK;
+        }
+        if (c == '}' || c == ']') {
+            return container_end(stream, c == '}');
+        }
+        return ESP_FAIL;
+    default:
+        // only white space after the top level value
+        return ESP_FAIL;
+    }
+}
+
+static esp_err_t string_char(esp_json_stream_t *stream, char c)
+{
+    if (stream->high_surrogate && c != '\\') {
+        // a high surrogate must be followed by the escaped low surrogate
+        return ESP_FAIL;
+    }
+    if (c == '"') {
+        return string_end(stream);
+    }
+    if (c == '\\') {
+        stream->lex_state = LEX_ESCAPE;
+        return ESP_OK;
+    }
+    if ((uint8_t)c < 0x20) {
+        return ESP_FAIL;
+    }
+    return token_append(stream, c);
+}
+
+static esp_err_t escape_char(esp_json_stream_t *stream, char c)
+{
+    static const char escapes[] = "\"\"\\\\//b\bf\fn\nr\rt\t";
+
+    if (stream->high_surrogate && c != 'u') {
+        return ESP_FAIL;
+    }
+    if (c == 'u') {
+        stream->lex_state = LEX_UNICODE;
+        stream->unicode = 0;
+        stream->unicode_digits = 0;
+        return ESP_OK;
+    }
+    for (int i = 0; escapes[i]; i += 2) {
+        if (escapes[i] == c) {
+            stream->lex_state = LEX_STRING;
+            return token_append(stream, escapes[i + 1]);
+        }
+    }
+    return ESP_FAIL;
+}
+
+static esp_err_t unicode_char(esp_json_stream_t *stream, char c)
+{
+    int digit = hex_value(c);
+
+    if (digit < 0) {
+        return ESP_FAIL;
+    }
+    stream->unicode = (stream->unicode << 4) | digit;
+    if (++stream->unicode_digits < 4) {
+        return ESP_OK;
+    }
+
+    uint32_t cp = stream->unicode;
+    stream->lex_state = LEX_STRING;
+    if (stream->high_surrogate) {
+        if (cp < 0xDC00 || cp > 0xDFFF) {
+            return ESP_FAIL;
+        }
+        cp = 0x10000 + (((uint32_t)stream->high_surrogate - 0xD800) << 10) + (cp - 0xDC00);
+        stream->high_surrogate = 0;
+    } else if (cp >= 0xD800 && cp <= 0xDBFF) {
+        stream->high_surrogate = cp;
+        return ESP_OK;
+    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+        return ESP_FAIL;
+    }
+    return token_append_utf8(stream, cp);
+}
+
+static esp_err_t literal_char(esp_json_stream_t *stream, char c)
+{
+    const char *text = s_literals[stream->literal].text;
+
+    if (text[stream->literal_pos] != c) {
+        return ESP_FAIL;
+    }
+    if (text[++stream->literal_pos] != '\0') {
+        return ESP_OK;
+    }
+    stream->lex_state = LEX_NONE;
+    value_done(stream);
+    return emit(stream, s_literals[stream->literal].event, false);
+}
+
+esp_err_t esp_json_stream_init(esp_json_stream_t *stream, const esp_json_stream_config_t *config)
+{
+    if (!stream || !config || !config->callback || !config->token_buf || config->token_buf_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(stream, 0, sizeof(esp_json_stream_t));
+    stream->config = *config;
+    stream->lex_state = LEX_NONE;
+    stream->parse_state = PS_VALUE;
+    return ESP_OK;
+}
+
+esp_err_t esp_json_stream_feed(esp_json_stream_t *stream, const char *data, size_t len)
+{
+    esp_err_t ret = ESP_OK;
+
+    if (!stream || (!data && len)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (stream->failed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (size_t i = 0; i < len && ret == ESP_OK; i++) {
+        char c = data[i];
+        stream->offset++;
+        switch (stream->lex_state) {
+        case LEX_STRING:
+            ret = string_char(stream, c);
+            break;
+        case LEX_ESCAPE:
+            ret = escape_char(stream, c);
+            break;
+        case LEX_UNICODE:
+            ret = unicode_char(stream, c);
+            break;
+        case LEX_LITERAL:
+            ret = literal_char(stream, c);
+            break;
+        case LEX_NUMBER:
+            if (is_number_char(c)) {
+                ret = token_append(stream, c);
+                break;
+            }
+            // the number ends with the first other character, which is then parsed
+            ret = number_end(stream);
+            if (ret == ESP_OK) {
+                ret = structural_char(stream, c);
+            }
+            break;
+        default:
+            ret = structural_char(stream, c);
+            break;
+        }
+    }
+
+    if (ret != ESP_OK) {
+        stream->failed = true;
+    }
+    return ret;
+}
+
+esp_err_t esp_json_stream_finish(esp_json_stream_t *stream)
+{
+    esp_err_t ret = ESP_OK;
+
+    if (!stream) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (stream->failed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (stream->lex_state == LEX_NUMBER) {
+        ret = number_end(stream);
+    }
+    if (ret == ESP_OK && (stream->lex_state != LEX_NONE || stream->parse_state != PS_DONE)) {
+        ret = ESP_FAIL;
+    }
+    if (ret != ESP_OK) {
+        stream->failed = true;
+    }
+    return ret;
+}
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "cJSON.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Memory provided by the caller for cJSON trees
+ *
+ * The nodes and strings of a tree parsed into an arena are allocated one after the other in the memory
+ * of the arena, without using the heap. The tree is released all at once with esp_json_arena_reset(),
+ * it must not be passed to cJSON_Delete(), or to the cJSON functions which free or replace items or strings
+ * of a tree.
+ *
+ * @note The tree is built by the parser of esp_json_stream.h, the global cJSON allocation hooks are neither
+ *       used nor changed, so other users of cJSON are not affected.
+ */
+typedef struct {
+    uint8_t *buf;       /*!< Memory of the arena */
+    size_t size;        /*!< Size of buf */
+    size_t used;        /*!< Number of bytes allocated */
+    bool exhausted;     /*!< An allocation didn't fit in the arena */
+} esp_json_arena_t;
+
+/**
+ * @brief Initialize an arena
+ *
+ * @param arena Arena
+ * @param buf   Memory of the arena, for example a static buffer or a buffer on the stack
+ * @param size  Size of buf
+ *
+ * @return
+ *    - ESP_OK on success
+ *    - ESP_ERR_INVALID_ARG if arena or buf is NULL
+ */
+esp_err_t esp_json_arena_init(esp_json_arena_t *arena, void *buf, size_t size);
+
+/**
+ * @brief Parse a JSON document into an arena
+ *
+ * Several documents can be parsed into the same arena, their trees are all released by esp_json_arena_reset().
+ * The document must be strict JSON, with objects and arrays nested at most ESP_JSON_STREAM_MAX_DEPTH deep.
+ *
+ * @param arena   Arena
+ * @param json    JSON document, doesn't need to be null terminated
+ * @param len     Length of the document
+ * @param[out] out_root Root of the parsed tree
+ *
+ * @return
+ *    - ESP_OK on success
+ *    - ESP_ERR_INVALID_ARG if an argument is NULL
+ *    - ESP_ERR_NO_MEM if the tree doesn't fit in the arena
+ *    - ESP_ERR_INVALID_SIZE if the objects and arrays are nested too deep
+ *    - ESP_FAIL if the document isn't valid JSON
+ */
+esp_err_t esp_json_arena_parse(esp_json_arena_t *arena, const char *json, size_t len, cJSON **out_root);
+
+/**
+ * @brief Print a cJSON tree into the free memory of an arena
+ *
+ * The tree can be allocated anywhere. To print into another buffer, use cJSON_PrintPreallocated(),
+ * which doesn't allocate either.
+ *
+ * @param arena  Arena
+ * @param item   Tree to print
+ * @param format Print with white space and new lines
+ *
+ * @return Null terminated JSON text in the arena, NULL if it doesn't fit
+ */
+char *esp_json_arena_print(esp_json_arena_t *arena, const cJSON *item, bool format);
+
+/**
+ * @brief Release everything allocated in an arena
+ *
+ * @param arena Arena
+ */
+void esp_json_arena_reset(esp_json_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
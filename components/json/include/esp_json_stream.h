@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum nesting of objects and arrays supported by the streaming parser */
+#define ESP_JSON_STREAM_MAX_DEPTH   32
+
+/**
+ * @brief Events reported by the streaming parser
+ */
+typedef enum {
+    ESP_JSON_EVENT_OBJECT_START,    /*!< '{' */
+    ESP_JSON_EVENT_OBJECT_END,      /*!< '}' */
+    ESP_JSON_EVENT_ARRAY_START,     /*!< '[' */
+    ESP_JSON_EVENT_ARRAY_END,       /*!< ']' */
+    ESP_JSON_EVENT_KEY,             /*!< Key of an object member, the value is the unescaped key */
+    ESP_JSON_EVENT_STRING,          /*!< String value, the value is the unescaped string */
+    ESP_JSON_EVENT_NUMBER,          /*!< Number value, the value is the number as written in the document */
+    ESP_JSON_EVENT_TRUE,            /*!< true */
+    ESP_JSON_EVENT_FALSE,           /*!< false */
+    ESP_JSON_EVENT_NULL,            /*!< null */
+} esp_json_event_t;
+
+/**
+ * @brief Callback receiving the parser events
+ *
+ * @param event Event
+ * @param value Null terminated key, string or number for the KEY, STRING and NUMBER events, NULL otherwise.
+ *              Only valid during the callback.
+ * @param len   Length of value. A string containing "\u0000" is longer than strlen(value).
+ * @param depth Number of objects and arrays containing the token, the start and end events of
+ *              a container report the depth of the container
+ * @param ctx   User context
+ *
+ * @return ESP_OK to continue parsing, any other value stops the parsing and is returned by
+ *         esp_json_stream_feed()
+ */
+typedef esp_err_t (*esp_json_stream_cb_t)(esp_json_event_t event, const char *value, size_t len, int depth, void *ctx);
+
+/**
+ * @brief Configuration of the streaming parser
+ */
+typedef struct {
+    esp_json_stream_cb_t callback;  /*!< Callback receiving the events */
+    void *ctx;                      /*!< User context passed to the callback */
+    char *token_buf;                /*!< Buffer collecting the keys, strings and numbers, which can be split over
+                                         several chunks of input */
+    size_t token_buf_size;          /*!< Size of token_buf, the longest token is one byte shorter */
+} esp_json_stream_config_t;
+
+/**
+ * @brief State of the streaming parser
+ *
+ * Allocated by the caller, for example on the stack of an HTTP handler, so parsing doesn't use the heap.
+ * The fields are private.
+ */
+typedef struct {
+    esp_json_stream_config_t config;
+    size_t offset;                  /*!< Number of bytes of input processed, the position of the error on failure */
+    size_t token_len;
+    uint32_t containers;            /*!< One bit per nesting level, set for objects */
+    uint32_t unicode;
+    uint16_t high_surrogate;
+    uint8_t depth;
+    uint8_t lex_state;
+    uint8_t parse_state;
+    uint8_t literal;
+    uint8_t literal_pos;
+    uint8_t unicode_digits;
+    bool failed;
+} esp_json_stream_t;
+
+/**
+ * @brief Initialize a streaming parser
+ *
+ * @param stream Parser state
+ * @param config Parser configuration
+ *
+ * @return
+ *    - ESP_OK on success
+ *    - ESP_ERR_INVALID_ARG if an argument is NULL or the token buffer is empty
+ */
+esp_err_t esp_json_stream_init(esp_json_stream_t *stream, const esp_json_stream_config_t *config);
+
+/**
+ * @brief Parse the next chunk of a JSON document
+ *
+ * The events are reported to the callback as soon as the tokens are complete, the chunks may split
+ * the tokens anywhere. Nothing is allocated.
+ *
+ * @param stream Parser state
+ * @param data   Next chunk of the document
+ * @param len    Length of the chunk
+ *
+ * @return
+ *    - ESP_OK if the chunk was parsed
+ *    - ESP_ERR_INVALID_ARG if an argument is NULL
+ *    - ESP_ERR_INVALID_STATE if parsing already failed
+ *    - ESP_ERR_NO_MEM if a token doesn't fit in the token buffer
+ *    - ESP_ERR_INVALID_SIZE if the objects and arrays are nested deeper than ESP_JSON_STREAM_MAX_DEPTH
+ *    - ESP_FAIL if the document isn't valid JSON, offset points after the invalid character
+ *    - the error returned by the callback
+ */
+esp_err_t esp_json_stream_feed(esp_json_stream_t *stream, const char *data, size_t len);
+
+/**
+ * @brief End the JSON document
+ *
+ * Reports a pending top level number, which can only end with the document.
+ *
+ * @param stream Parser state
+ *
+ * @return
+ *    - ESP_OK if a complete JSON value was parsed
+ *    - ESP_ERR_INVALID_ARG if stream is NULL
+ *    - ESP_ERR_INVALID_STATE if parsing already failed
+ *    - ESP_FAIL if the document is incomplete
+ *    - the error returned by the callback
+ */
+esp_err_t esp_json_stream_finish(esp_json_stream_t *stream);
+
+#ifdef __cplusplus
+}
+#endif
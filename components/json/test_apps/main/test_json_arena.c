@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "cJSON.h"
+#include "esp_json_arena.h"
+
+static bool in_arena(const esp_json_arena_t *arena, const void *ptr)
+{
+    return (const uint8_t *)ptr >= arena->buf && (const uint8_t *)ptr < arena->buf + arena->used;
+}
+
+TEST_CASE("arena parse builds the cJSON tree in the arena", "[json][arena]")
+{
+    static uint8_t buf[1024];
+    const char json[] = "{\"name\": \"esp\\u0021\", \"list\": [1, 2.5, -3e9, 3e9, true, false, null], \"empty\": {}}";
+    esp_json_arena_t arena;
+    cJSON *root;
+
+    TEST_ESP_OK(esp_json_arena_init(&arena, buf, sizeof(buf)));
+    // Not null terminated
+    TEST_ESP_OK(esp_json_arena_parse(&arena, json, strlen(json), &root));
+    TEST_ASSERT_TRUE(in_arena(&arena, root));
+    TEST_ASSERT_TRUE(cJSON_IsObject(root));
+
+    cJSON *name = cJSON_GetObjectItemCaseSensitive(root, "name");
+    TEST_ASSERT_TRUE(cJSON_IsString(name));
+    TEST_ASSERT_EQUAL_STRING("esp!", name->valuestring);
+    TEST_ASSERT_TRUE(in_arena(&arena, name->valuestring));
+    TEST_ASSERT_TRUE(in_arena(&arena, name->string));
+
+    cJSON *list = cJSON_GetObjectItemCaseSensitive(root, "list");
+    TEST_ASSERT_TRUE(cJSON_IsArray(list));
+    TEST_ASSERT_EQUAL(7, cJSON_GetArraySize(list));
+    TEST_ASSERT_EQUAL(1, cJSON_GetArrayItem(list, 0)->valueint);
+    TEST_ASSERT_EQUAL_DOUBLE(2.5, cJSON_GetArrayItem(list, 1)->valuedouble);
+    TEST_ASSERT_EQUAL(INT_MIN, cJSON_GetArrayItem(list, 2)->valueint);
+    TEST_ASSERT_EQUAL(INT_MAX, cJSON_GetArrayItem(list, 3)->valueint);
+    TEST_ASSERT_TRUE(cJSON_IsTrue(cJSON_GetArrayItem(list, 4)));
+    TEST_ASSERT_TRUE(cJSON_IsFalse(cJSON_GetArrayItem(list, 5)));
+    TEST_ASSERT_TRUE(cJSON_IsNull(cJSON_GetArrayItem(list, 6)));
+    // The first child points to the last one, like in the trees built by cJSON
+    TEST_ASSERT_EQUAL_PTR(cJSON_GetArrayItem(list, 6), list->child->prev);
+    TEST_ASSERT_NULL(cJSON_GetArrayItem(list, 6)->next);
+
+    cJSON *empty = cJSON_GetObjectItemCaseSensitive(root, "empty");
+    TEST_ASSERT_TRUE(cJSON_IsObject(empty));
+    TEST_ASSERT_NULL(empty->child);
+
+    char *out = esp_json_arena_print(&arena, root, false);
+    TEST_ASSERT_NOT_NULL(out);
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"esp!\",\"list\":[1,2.5,-3000000000,3000000000,true,false,null],\"empty\":{}}", out);
+
+    esp_json_arena_reset(&arena);
+    TEST_ASSERT_EQUAL(0, arena.used);
+}
+
+TEST_CASE("arena parse fails without keeping anything", "[json][arena]")
+{
+    // Large enough for the nodes of the too deeply nested document
+    static uint8_t buf[4096];
+    const char json[] = "{\"a\": [1, 2, 3], \"b\": \"some text\"}";
+    esp_json_arena_t arena;
+    cJSON *root;
+
+    TEST_ESP_OK(esp_json_arena_init(&arena, buf, sizeof(buf)));
+    TEST_ESP_OK(esp_json_arena_parse(&arena, "[]", 2, &root));
+    size_t used = arena.used;
+
+    // Invalid documents, including numbers which strtod() would accept
+    const char *invalid[] = { "[01]", "[1.]", "{\"a\":1,}", "{\"a\":tru}", "[1] 2", "{\"a\":[1}" };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_FAIL, esp_json_arena_parse(&arena, invalid[i], strlen(invalid[i]), &root),
+                                  invalid[i]);
+        TEST_ASSERT_NULL(root);
+        TEST_ASSERT_EQUAL(used, arena.used);
+    }
+
+    // Truncated documents
+    for (size_t len = 0; len < strlen(json); len++) {
+        TEST_ASSERT_EQUAL(ESP_FAIL, esp_json_arena_parse(&arena, json, len, &root));
+        TEST_ASSERT_EQUAL(used, arena.used);
+    }
+
+    // Nested too deep
+    char deep[2 * 40];
+    memset(deep, '[', 40);
+    memset(deep + 40, ']', 40);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_json_arena_parse(&arena, deep, sizeof(deep), &root));
+    TEST_ASSERT_EQUAL(used, arena.used);
+
+    // The tree doesn't fit, whether the last allocation is a node or a string
+    for (size_t size = 0; size <= sizeof(buf); size++) {
+        TEST_ESP_OK(esp_json_arena_init(&arena, buf, size));
+        esp_err_t ret = esp_json_arena_parse(&arena, json, strlen(json), &root);
+        if (ret == ESP_OK) {
+            TEST_ASSERT_EQUAL_STRING("some text", cJSON_GetObjectItemCaseSensitive(root, "b")->valuestring);
+            break;
+        }
+        TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, ret);
+        TEST_ASSERT_TRUE(arena.exhausted);
+        TEST_ASSERT_EQUAL(0, arena.used);
+    }
+    TEST_ASSERT_NOT_NULL(root);
+}
+
+static int s_hook_allocs;
+
+static void *counting_malloc(size_t size)
+{
+    s_hook_allocs++;
+    return malloc(size);
+}
+
+TEST_CASE("arena parse leaves the cJSON hooks alone", "[json][arena]")
+{
+    static uint8_t buf[256];
+    cJSON_Hooks hooks = {
+        .malloc_fn = counting_malloc,
+        .free_fn = free,
+    };
+    esp_json_arena_t arena;
+    cJSON *root;
+
+    cJSON_InitHooks(&hooks);
+    s_hook_allocs = 0;
+    TEST_ESP_OK(esp_json_arena_init(&arena, buf, sizeof(buf)));
+    TEST_ESP_OK(esp_json_arena_parse(&arena, "{\"a\": [\"b\"]}", 12, &root));
+    TEST_ASSERT_EQUAL(0, s_hook_allocs);
+
+    // The hooks of the application are still used by cJSON
+    cJSON *heap_root = cJSON_Parse("{\"a\": 1}");
+    TEST_ASSERT_NOT_NULL(heap_root);
+    TEST_ASSERT_GREATER_THAN(0, s_hook_allocs);
+    cJSON_Delete(heap_root);
+
+    cJSON_InitHooks(NULL);
+    heap_root = cJSON_Parse("[1, 2]");
+    char *out = cJSON_PrintUnformatted(heap_root);
+    TEST_ASSERT_EQUAL_STRING("[1,2]", out);
+    cJSON_free(out);
+    cJSON_Delete(heap_root);
+}
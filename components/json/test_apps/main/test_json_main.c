@@ -0,0 +1,31 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#define TEST_MEMORY_LEAK_THRESHOLD (-100)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    // Add a short delay of 100ms to allow the idle task to free any remaining memory
+    vTaskDelay(pdMS_TO_TICKS(100));
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_json_stream.h"
+
+#define TEST_TOKEN_BUF_SIZE 32
+
+// The events are logged as text, e.g. {k:a=n:1} for {"a": 1}
+typedef struct {
+    char log[256];
+    size_t len;
+} event_log_t;
+
+static esp_err_t log_event(esp_json_event_t event, const char *value, size_t len, int depth, void *ctx)
+{
+    static const char *const prefixes[] = {
+        [ESP_JSON_EVENT_OBJECT_START] = "{",
+        [ESP_JSON_EVENT_OBJECT_END] = "}",
+        [ESP_JSON_EVENT_ARRAY_START] = "[",
+        [ESP_JSON_EVENT_ARRAY_END] = "]",
+        [ESP_JSON_EVENT_KEY] = "k:",
+        [ESP_JSON_EVENT_STRING] = "s:",
+        [ESP_JSON_EVENT_NUMBER] = "n:",
+        [ESP_JSON_EVENT_TRUE] = "t",
+        [ESP_JSON_EVENT_FALSE] = "f",
+        [ESP_JSON_EVENT_NULL] = "z",
+    };
+    event_log_t *log = ctx;
+    int ret = snprintf(log->log + log->len, sizeof(log->log) - log->len, "%s%s%s", prefixes[event],
+                       value ? value : "", value ? "=" : "");
+    TEST_ASSERT(ret > 0 && (size_t)ret < sizeof(log->log) - log->len);
+    log->len += ret;
+    return ESP_OK;
+}
+
+// Parses a document fed in chunks of chunk_size bytes, returns the first error
+static esp_err_t parse_chunks(const char *json, size_t chunk_size, event_log_t *log)
+{
+    char token_buf[TEST_TOKEN_BUF_SIZE];
+    esp_json_stream_t stream;
+    esp_json_stream_config_t config = {
+        .callback = log_event,
+        .ctx = log,
+        .token_buf = token_buf,
+        .token_buf_size = sizeof(token_buf),
+    };
+    size_t len = strlen(json);
+
+    memset(log, 0, sizeof(event_log_t));
+    TEST_ESP_OK(esp_json_stream_init(&stream, &config));
+    for (size_t pos = 0; pos < len; pos += chunk_size) {
+        esp_err_t ret = esp_json_stream_feed(&stream, json + pos, len - pos < chunk_size ? len - pos : chunk_size);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return esp_json_stream_finish(&stream);
+}
+
+static esp_err_t parse(const char *json)
+{
+    event_log_t log;
+    return parse_chunks(json, strlen(json) + 1, &log);
+}
+
+TEST_CASE("stream parser reports the same events wherever the document is split", "[json][stream]")
+{
+    const char *json = " {\"a\" : [1, -2.5e+3, true, false, null], \"b\\u00e9\\ud83d\\ude00\": {\"c\\n\": \"\\\"x\\\"\"},"
+                       "\"d\": []} ";
+    const char *expected = "{k:a=[n:1=n:-2.5e+3=tfz]k:b\xc3\xa9\xf0\x9f\x98\x80={k:c\n=s:\"x\"=}k:d=[]}";
+    event_log_t log;
+
+    for (size_t chunk_size = 1; chunk_size <= strlen(json); chunk_size++) {
+        TEST_ESP_OK(parse_chunks(json, chunk_size, &log));
+        TEST_ASSERT_EQUAL_STRING(expected, log.log);
+    }
+
+    // A top level number only ends with the document
+    TEST_ESP_OK(parse_chunks("42", 1, &log));
+    TEST_ASSERT_EQUAL_STRING("n:42=", log.log);
+}
+
+TEST_CASE("stream parser rejects truncated documents", "[json][stream]")
+{
+    const char *truncated[] = {
+        "", " ", "{", "{\"a\"", "{\"a\":", "{\"a\":1", "{\"a\":1,", "[", "[1", "[1,", "\"abc", "\"\\", "\"\\u00e",
+        "\"\\ud83d\\ude0", "tru", "fals", "nul", "-", "1.", "1e", "1e+",
+    };
+
+    for (size_t i = 0; i < sizeof(truncated) / sizeof(truncated[0]); i++) {
+        // The chunks are valid so far, only the end of the document fails
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_FAIL, parse(truncated[i]), truncated[i]);
+    }
+}
+
+TEST_CASE("stream parser limits the nesting", "[json][stream]")
+{
+    char json[6 * ESP_JSON_STREAM_MAX_DEPTH + 1];
+    event_log_t log;
+
+    // Deepest supported nesting, alternating arrays and objects
+    size_t len = 0;
+    for (int i = 0; i < ESP_JSON_STREAM_MAX_DEPTH; i++) {
+        len += sprintf(json + len, "%s", i % 2 ? "{\"\":" : "[");
+    }
+    len += sprintf(json + len, "0");
+    for (int i = ESP_JSON_STREAM_MAX_DEPTH - 1; i >= 0; i--) {
+        len += sprintf(json + len, "%s", i % 2 ? "}" : "]");
+    }
+    TEST_ESP_OK(parse_chunks(json, 7, &log));
+
+    // One level deeper
+    memset(json, '[', ESP_JSON_STREAM_MAX_DEPTH + 1);
+    memset(json + ESP_JSON_STREAM_MAX_DEPTH + 1, ']', ESP_JSON_STREAM_MAX_DEPTH + 1);
+    json[2 * (ESP_JSON_STREAM_MAX_DEPTH + 1)] = '\0';
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, parse(json));
+
+    // Mismatched ends
+    TEST_ASSERT_EQUAL(ESP_FAIL, parse("[}"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, parse("{\"a\":[1}]"));
+    TEST_ASSERT_EQUAL(ESP_FAIL, parse("[]]"));
+}
+
+TEST_CASE("stream parser follows the JSON number grammar", "[json][stream]")
+{
+    const char *valid[] = {
+        "0", "-0", "7", "-12", "3.25", "-0.5", "1e3", "1E+3", "2.5e-3", "0e0", "10", "1234567890123456789012",
+    };
+    const char *invalid[] = {
+        "01", "-01", "00", "1.", "-", "--1", "+1", ".5", "-.5", "1.e3", "1e", "1e+", "1e-", "1e1.5", "1.2.3",
+        "0x10", "1-2", "1+", "2e3e4", "- 1",
+    };
+    char json[32];
+    event_log_t log;
+
+    for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+        // Ended by the document, and by the next character
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_OK, parse(valid[i]), valid[i]);
+        snprintf(json, sizeof(json), "[%s]", valid[i]);
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_OK, parse_chunks(json, 1, &log), json);
+    }
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_FAIL, parse(invalid[i]), invalid[i]);
+        snprintf(json, sizeof(json), "[%s]", invalid[i]);
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_FAIL, parse_chunks(json, 1, &log), json);
+    }
+}
+
+TEST_CASE("stream parser rejects invalid documents", "[json][stream]")
+{
+    const char *invalid[] = {
+        "1 2", "{} {}", "{\"a\" 1}", "{\"a\":1,}", "[1,]", "[,1]", "{1:2}", ",", "]", "'a'", "True", "nulL",
+        "\"a\x01\"", "\"\\x\"", "\"\\ude00\"", "\"\\ud83d\"", "\"\\ud83dx\"", "\"\\u12g4\"",
+    };
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_FAIL, parse(invalid[i]), invalid[i]);
+    }
+}
+
+TEST_CASE("stream parser stops on errors", "[json][stream]")
+{
+    char token_buf[4];
+    esp_json_stream_t stream;
+    event_log_t log = {};
+    esp_json_stream_config_t config = {
+        .callback = log_event,
+        .ctx = &log,
+        .token_buf = token_buf,
+        .token_buf_size = sizeof(token_buf),
+    };
+
+    // The longest token is one byte shorter than the buffer
+    TEST_ESP_OK(esp_json_stream_init(&stream, &config));
+    TEST_ESP_OK(esp_json_stream_feed(&stream, "[\"abc\",", 7));
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, esp_json_stream_feed(&stream, "\"abcd\"]", 7));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_json_stream_feed(&stream, "]", 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_json_stream_finish(&stream));
+
+    // The offset points after the invalid character
+    TEST_ESP_OK(esp_json_stream_init(&stream, &config));
+    TEST_ASSERT_EQUAL(ESP_FAIL, esp_json_stream_feed(&stream, "[1, x]", 6));
+    TEST_ASSERT_EQUAL(5, stream.offset);
+}
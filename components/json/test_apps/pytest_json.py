@@ -0,0 +1,17 @@
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: CC0-1.0
+import pytest
+from pytest_embedded import Dut
+
+
+@pytest.mark.esp32
+@pytest.mark.esp32c3
+@pytest.mark.generic
+def test_json(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
+
+
+@pytest.mark.linux
+@pytest.mark.host_test
+def test_json_linux(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
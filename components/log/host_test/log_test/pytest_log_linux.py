@@ -8,9 +8,10 @@ from pytest_embedded import Dut
 @pytest.mark.host_test
 @pytest.mark.parametrize('config', [
     'default',
-    'system_timestamp'
+    'system_timestamp',
     'tag_level_linked_list',
     'tag_level_linked_list_and_array_cache',
+    'tag_level_linked_list_and_hash_table_cache',
     'tag_level_none',
 ], indirect=True)
 def test_log_linux(dut: Dut) -> None:
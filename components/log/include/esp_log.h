@@ -57,6 +57,27 @@ void esp_log_write(esp_log_level_t level, const char* tag, const char* format, .
  */
 void esp_log_writev(esp_log_level_t level, const char* tag, const char* format, va_list args);
 
+/**
+ * @brief Wait until all buffered log messages have been written out
+ *
+ * If CONFIG_LOG_DEFERRED is enabled, log messages are written out by a low priority task. Call this function
+ * e.g. before a restart or before entering deep sleep to make sure no messages are lost.
+ * Otherwise, messages are written out directly and this function returns immediately.
+ *
+ * This function must not be called from an interrupt.
+ */
+void esp_log_flush(void);
+
+/**
+ * @brief Get the number of log messages dropped since startup
+ *
+ * If CONFIG_LOG_DEFERRED is enabled, messages are dropped while the buffer of the calling CPU is full.
+ * Otherwise, no messages are dropped and this function returns 0.
+ *
+ * @return Number of dropped messages
+ */
+uint32_t esp_log_get_dropped_count(void);
+
 /** @cond */
 
 #define LOG_FORMAT(letter, format)  LOG_COLOR_ ## letter #letter " (%" PRIu32 ") %s: " format LOG_RESET_COLOR "\n"
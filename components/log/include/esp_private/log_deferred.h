@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdarg.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Store a log message in the buffer of the current CPU, to be written out by the log output task
+ *
+ * @param format Format string of the message
+ * @param args   Arguments of the message
+ *
+ * @return true if the message was buffered (or dropped because the buffer is full),
+ *         false if the message must be written out directly by the caller
+ */
+bool esp_log_deferred_writev(const char *format, va_list args);
+
+/**
+ * @brief Write out a formatted log message using the function set with esp_log_set_vprintf()
+ *
+ * Implemented in log_write.c, used by the log output task.
+ */
+void esp_log_vprint(const char *format, va_list args);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * This file implements a hash table cache for storing and retrieving log tag
+ * levels in the ESP-IDF log library. Tags are placed in the table by a hash of
+ * the tag pointer, so a lookup only inspects a few slots next to the home slot
+ * of the tag and compares pointers, regardless of the number of cached tags.
+ *
+ * The table has TAG_CACHE_SIZE + 1 slots and uses linear probing limited to
+ * PROBE_LIMIT slots. The esp_log_cache_add function stores a tag in the first
+ * free slot of its probe window. If the window is full, one slot of the window
+ * is overwritten, picked in a round-robin way. Entries are never removed one by
+ * one, so a free slot in the window ends the search in esp_log_cache_get_level.
+ *
+ * The esp_log_cache_set_level function allows users to update the log level
+ * for a specific tag in the cache. As the same tag string may be referenced
+ * through several pointers, it compares tag strings across the whole table.
+ * If the tag is not found in the cache, it does not add a new entry.
+ *
+ * Compared to the binary min-heap, this cache does not keep track of how often
+ * tags are used and never reorders entries, which makes hits cheaper at the cost
+ * of occasionally evicting a frequently used tag.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "esp_log_level.h"
+#include "esp_private/log_level.h"
+#include "esp_compiler.h"
+#include "esp_assert.h"
+#include "sdkconfig.h"
+
+ESP_STATIC_ASSERT(((CONFIG_LOG_TAG_LEVEL_IMPL_CACHE_SIZE & (CONFIG_LOG_TAG_LEVEL_IMPL_CACHE_SIZE + 1)) == 0), "Number of tags to be cached must be 2**n - 1, n >= 2. [1, 3, 7, 15, 31, 63, 127, 255, ...]");
+#define TAG_CACHE_SIZE (CONFIG_LOG_TAG_LEVEL_IMPL_CACHE_SIZE)
+#define TABLE_SIZE     (TAG_CACHE_SIZE + 1)
+#define TABLE_BITS     (__builtin_ctz(TABLE_SIZE))
+#define PROBE_LIMIT    (TABLE_SIZE < 4 ? TABLE_SIZE : 4)
+
+typedef struct {
+    const char *tag;
+    uint32_t level;
+} cached_tag_entry_t;
+
+static cached_tag_entry_t s_table[TABLE_SIZE];
+static uint32_t s_victim = 0;
+
+static inline uint32_t home_slot(const char *tag)
+{
+    if (TABLE_BITS == 0) {
+        return 0;
+    }
+    // Fibonacci hashing: the top bits of the product depend on all bits of the pointer
+    return ((uint32_t)(uintptr_t)tag * 2654435769U) >> (32 - TABLE_BITS);
+}
+
+void esp_log_cache_set_level(const char *tag, esp_log_level_t level)
+{
+    // search in the cache and update all the entries of this tag
+    for (uint32_t i = 0; i < TABLE_SIZE; ++i) {
+        if (s_table[i].tag != NULL && strcmp(s_table[i].tag, tag) == 0) {
+            s_table[i].level = level;
+        }
+    }
+}
+
+bool esp_log_cache_get_level(const char *tag, esp_log_level_t *level)
+{
+    uint32_t slot = home_slot(tag);
+    for (uint32_t i = 0; i < PROBE_LIMIT; ++i) {
+        const cached_tag_entry_t *entry = &s_table[(slot + i) & (TABLE_SIZE - 1)];
+        if (entry->tag == tag) {
+            // Return level from cache
+            *level = (esp_log_level_t) entry->level;
+            return true;
+        }
+        if (entry->tag == NULL) {
+            break;
+        }
+    }
+    // Not found in cache
+    return false;
+}
+
+void esp_log_cache_clean(void)
+{
+    memset(s_table, 0, sizeof(s_table));
+    s_victim = 0;
+}
+
+void esp_log_cache_add(const char *tag, esp_log_level_t level)
+{
+    uint32_t slot = home_slot(tag);
+    uint32_t i;
+    for (i = 0; i < PROBE_LIMIT; ++i) {
+        const char *cached_tag = s_table[(slot + i) & (TABLE_SIZE - 1)].tag;
+        if (cached_tag == NULL || cached_tag == tag) {
+            break;
+        }
+    }
+    if (i == PROBE_LIMIT) {
+        // the probe window is full, evict one of its entries
+        i = s_victim++ % PROBE_LIMIT;
+    }
+    s_table[(slot + i) & (TABLE_SIZE - 1)] = (cached_tag_entry_t) {
+        .level = level,
+        .tag = tag
+    };
+}
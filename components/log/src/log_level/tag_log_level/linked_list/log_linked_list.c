@@ -14,9 +14,9 @@
  * The esp_log_linked_list_set_level() function allows users to set the log level
  * for a specific tag, and if the tag does not exist in the linked list, it adds
  * a new entry for that tag. The esp_log_linked_list_get_level() function
- * retrieves the log level for a given tag from the linked list. Please note that
- * this approach searches through the entire tag string to find a matching tag
- * during log level retrieval.
+ * retrieves the log level for a given tag from the linked list. Each entry keeps
+ * a hash of its tag string, so the looked up tag is hashed once and the whole
+ * strings are only compared for the entries with a matching hash.
  *
  * The esp_log_linked_list_clean() function enables users to clear the entire linked
  * list, freeing the memory occupied by the list entries.
@@ -28,6 +28,7 @@
  */
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -42,20 +43,24 @@
 
 typedef struct uncached_tag_entry_ {
     SLIST_ENTRY(uncached_tag_entry_) entries;
+    uint32_t hash;          // tag_hash() of the tag string
     uint8_t level;          // esp_log_level_t as uint8_t
     char tag[0];            // beginning of a zero-terminated string
 } uncached_tag_entry_t;
 
 static SLIST_HEAD(log_tags_head, uncached_tag_entry_) s_log_tags = SLIST_HEAD_INITIALIZER(s_log_tags);
 
-static inline esp_err_t add_to_list(const char *tag, esp_log_level_t level);
-static inline bool set_log_level(const char *tag, esp_log_level_t level);
+static inline uint32_t tag_hash(const char *tag, size_t *tag_len);
+static inline esp_err_t add_to_list(const char *tag, uint32_t hash, size_t tag_len, esp_log_level_t level);
+static inline bool set_log_level(const char *tag, uint32_t hash, esp_log_level_t level);
 
 bool esp_log_linked_list_set_level(const char *tag, esp_log_level_t level)
 {
-    if (!set_log_level(tag, level)) {
+    size_t tag_len;
+    uint32_t hash = tag_hash(tag, &tag_len);
+    if (!set_log_level(tag, hash, level)) {
         // no existing tag, append new one
-        return add_to_list(tag, level) == ESP_OK;
+        return add_to_list(tag, hash, tag_len, level) == ESP_OK;
     }
     return true;
 }
@@ -65,10 +70,11 @@ bool esp_log_linked_list_set_level(const char *tag, esp_log_level_t level)
 bool esp_log_linked_list_get_level(const char *tag, esp_log_level_t *level)
 {
     // Walk the linked list of all tags and see if given tag is present in the list.
-    // This is slow because tags are compared as strings.
+    // The strings are only compared when the hashes match.
+    uint32_t hash = tag_hash(tag, NULL);
     uncached_tag_entry_t *it;
     SLIST_FOREACH(it, &s_log_tags, entries) {
-        if (strcmp(tag, it->tag) == 0) {
+        if (it->hash == hash && strcmp(tag, it->tag) == 0) {
             *level = it->level;
             return true;
         }
@@ -85,27 +91,42 @@ void esp_log_linked_list_clean(void)
     }
 }
 
-static inline esp_err_t add_to_list(const char *tag, esp_log_level_t level)
+static inline uint32_t tag_hash(const char *tag, size_t *tag_len)
+{
+    // 32-bit FNV-1a
+    uint32_t hash = 2166136261U;
+    const char *p = tag;
+    for (; *p != '\0'; ++p) {
+        hash = (hash ^ (uint8_t) *p) * 16777619U;
+    }
+    if (tag_len) {
+        *tag_len = p - tag;
+    }
+    return hash;
+}
+
+static inline esp_err_t add_to_list(const char *tag, uint32_t hash, size_t tag_len, esp_log_level_t level)
 {
     // allocate new linked list entry and append it to the head of the list
-    size_t tag_len = strlen(tag) + 1;
+    tag_len += 1;
     size_t entry_size = offsetof(uncached_tag_entry_t, tag) + tag_len;
     uncached_tag_entry_t *new_entry = (uncached_tag_entry_t *) malloc(entry_size);
     if (!new_entry) {
         return ESP_ERR_NO_MEM;
     }
+    new_entry->hash = hash;
     new_entry->level = (uint8_t) level;
     memcpy(new_entry->tag, tag, tag_len);
     SLIST_INSERT_HEAD(&s_log_tags, new_entry, entries);
     return ESP_OK;
 }
 
-static inline bool set_log_level(const char *tag, esp_log_level_t level)
+static inline bool set_log_level(const char *tag, uint32_t hash, esp_log_level_t level)
 {
     // search for existing tag
     uncached_tag_entry_t *it = NULL;
     SLIST_FOREACH(it, &s_log_tags, entries) {
-        if (strcmp(it->tag, tag) == 0) {
+        if (it->hash == hash && strcmp(it->tag, tag) == 0) {
             // one tag in the linked list matched, update the level
             it->level = level;
             return true;
@@ -0,0 +1,770 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_compiler.h"
+#include "esp_memory_utils.h"
+#include "esp_log.h"
+#include "esp_private/log_deferred.h"
+#include "sdkconfig.h"
+
+/*
+In deferred mode a log message is stored as a record in the buffer of the calling CPU and written out later by the log
+output task. With CONFIG_LOG_DEFERRED_FORMAT_IN_TASK the message is not formatted by the caller: the caller scans the
+format string for the types of the arguments and stores the address of the format string together with the raw
+argument values. String arguments are stored as pointers if they are placed in flash, otherwise their contents are
+copied into the record. Messages which can't be stored this way, and all messages with
+CONFIG_LOG_DEFERRED_FORMAT_IN_CALLER, are formatted by the caller and stored as text (records without format string).
+
+Each buffer is only written by the CPU owning it, so no lock is shared between CPUs. The caller reserves space for the
+largest record at the head of the buffer with interrupts disabled on its CPU, then stores the message directly in the
+reserved space with interrupts enabled, so that the message doesn't have to be assembled on the stack of the caller.
+Other tasks and ISRs of the same CPU may reserve the following space in the meantime. Once the message is stored, the
+caller marks the record as ready and gives back the unused part of the reserved space if nobody reserved space after
+it. A reserved slot is always contiguous: if the space left at the end of the buffer is too small, it is skipped.
+
+The only consumer is the log output task, which formats the records and passes them to the function set with
+esp_log_set_vprintf(). The head index of a buffer is only written by its CPU, the tail index only by the log output
+task. Records carry a global sequence number, taken when the space is reserved, so that the task outputs the messages
+of all CPUs in the order they were logged. The task waits for the oldest record to be ready before it outputs any
+later record.
+
+The log output task announces in s_task_waiting that it is going to wait for a notification, and checks the buffers
+again before waiting. A producer notifies the task only if it finds this flag set after publishing a record; both
+sides issue a full barrier in between, so a record can't be left in the buffers while the task is waiting.
+*/
+
+#define RECORD_MAX_SIZE     256                     // maximum size of a record, including the header
+#define LINE_MAX_SIZE       384                     // maximum length of a formatted message
+#define SPEC_MAX_SIZE       24                      // maximum length of a single conversion specification
+#define BUFFER_SIZE         (CONFIG_LOG_DEFERRED_BUFFER_SIZE & ~3)
+#define STRING_IN_FLASH     UINT32_MAX              // length of a string argument which is stored as pointer
+#define RECORD_SKIP         ((const char *)UINTPTR_MAX) // format of the record filling the unused end of a buffer
+
+static const char *TAG = "log";
+
+typedef enum {
+    ARG_INVALID,        // conversion which can't be deferred, or malformed specification
+    ARG_NONE,           // "%%"
+    ARG_INT,
+    ARG_LONG,
+    ARG_LONG_LONG,
+    ARG_INTMAX,
+    ARG_SIZE,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,
+    ARG_LONG_DOUBLE,
+    ARG_PTR,
+    ARG_STR,
+} arg_type_t;
+
+typedef enum {
+    LEN_NONE,
+    LEN_LONG,
+    LEN_LONG_LONG,
+    LEN_INTMAX,
+    LEN_SIZE,
+    LEN_PTRDIFF,
+    LEN_LONG_DOUBLE,
+} arg_length_t;
+
+typedef struct {
+    arg_type_t type;
+    bool width_arg;     // width is given by an int argument ('*')
+    bool precision_arg; // precision is given by an int argument ('.*')
+    size_t len;         // length of the specification, starting with '%'
+} conv_spec_t;
+
+typedef struct {
+    uint32_t size;      // size of the record including this header, a multiple of 4
+    uint32_t seq;
+    const char *format; // NULL if the record holds the formatted message, or RECORD_SKIP
+    uint32_t ready;     // nonzero once the message is stored in the record
+} record_header_t;
+
+typedef struct {
+    uint32_t head;      // only written by the CPU owning the buffer
+    uint32_t tail;      // only written by the log output task
+    uint32_t dropped;   // number of messages dropped since the last report
+    uint8_t storage[BUFFER_SIZE] __attribute__((aligned(4)));
+} log_buffer_t;
+
+static log_buffer_t s_buffers[portNUM_PROCESSORS];
+static uint32_t s_seq;
+static TaskHandle_t s_task;
+static bool s_task_creating;
+static bool s_task_waiting;
+static uint32_t s_dropped_total;
+
+// only used by the log output task (or by esp_log_flush() if the task can't be created)
+static uint8_t s_record[RECORD_MAX_SIZE] __attribute__((aligned(4)));
+#if CONFIG_LOG_DEFERRED_FORMAT_IN_TASK
+static char s_line[LINE_MAX_SIZE];
+#endif
+
+#if CONFIG_LOG_DEFERRED_FORMAT_IN_TASK
+static void parse_spec(const char *start, conv_spec_t *spec)
+{
+    static const arg_type_t int_types[] = {
+        [LEN_NONE] = ARG_INT,
+        [LEN_LONG] = ARG_LONG,
+        [LEN_LONG_LONG] = ARG_LONG_LONG,
+        [LEN_INTMAX] = ARG_INTMAX,
+        [LEN_SIZE] = ARG_SIZE,
+        [LEN_PTRDIFF] = ARG_PTRDIFF,
+        [LEN_LONG_DOUBLE] = ARG_INVALID,
+    };
+    const char *p = start + 1;
+    arg_length_t length = LEN_NONE;
+
+    spec->type = ARG_INVALID;
+    spec->width_arg = false;
+    spec->precision_arg = false;
+
+    while (*p != '\0' && strchr("-+ #0'", *p) != NULL) {
+        p++;
+    }
+    if (*p == '*') {
+        spec->width_arg = true;
+        p++;
+    } else {
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            spec->precision_arg = true;
+            p++;
+        } else {
+            while (*p >= '0' && *p <= '9') {
+                p++;
+            }
+        }
+    }
+    switch (*p) {
+    case 'h':
+        p += (p[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        if (p[1] == 'l') {
+            length = LEN_LONG_LONG;
+            p += 2;
+        } else {
+            length = LEN_LONG;
+            p++;
+        }
+        break;
+    case 'q':
+        length = LEN_LONG_LONG;
+        p++;
+        break;
+    case 'j':
+        length = LEN_INTMAX;
+        p++;
+        break;
+    case 'z':
+        length = LEN_SIZE;
+        p++;
+        break;
+    case 't':
+        length = LEN_PTRDIFF;
+        p++;
+        break;
+    case 'L':
+        length = LEN_LONG_DOUBLE;
+        p++;
+        break;
+    default:
+        break;
+    }
+    switch (*p) {
+    case 'd':
+    case 'i':
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+        spec->type = int_types[length];
+        break;
+    case 'c':
+        spec->type = (length == LEN_NONE) ? ARG_INT : ARG_INVALID;
+        break;
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec->type = (length == LEN_LONG_DOUBLE) ? ARG_LONG_DOUBLE : ARG_DOUBLE;
+        break;
+    case 's':
+        // wide strings can't be copied
+        spec->type = (length == LEN_NONE) ? ARG_STR : ARG_INVALID;
+        break;
+    case 'p':
+        spec->type = ARG_PTR;
+        break;
+    case '%':
+        spec->type = (p == start + 1) ? ARG_NONE : ARG_INVALID;
+        break;
+    default:
+        // also "%n", which would have to write to the caller's memory
+        break;
+    }
+    spec->len = (*p != '\0') ? (size_t)(p + 1 - start) : (size_t)(p - start);
+    if (spec->len >= SPEC_MAX_SIZE) {
+        spec->type = ARG_INVALID;
+    }
+}
+
+static bool record_put(uint8_t *record, size_t *pos, const void *value, size_t size)
+{
+    size_t aligned_size = (size + 3) & ~3;
+    if (*pos + aligned_size > RECORD_MAX_SIZE) {
+        return false;
+    }
+    memcpy(record + *pos, value, size);
+    *pos += aligned_size;
+    return true;
+}
+
+static bool record_get(const uint8_t *record, size_t *pos, void *value, size_t size)
+{
+    const record_header_t *header = (const record_header_t *)record;
+    size_t aligned_size = (size + 3) & ~3;
+    if (*pos + aligned_size > header->size) {
+        return false;
+    }
+    memcpy(value, record + *pos, size);
+    *pos += aligned_size;
+    return true;
+}
+
+#define PUT_ARG(type) do {                                              \
+        type value = va_arg(args, type);                                \
+        if (!record_put(record, pos, &value, sizeof(value))) {          \
+            return true;                                                \
+        }                                                               \
+    } while (0)
+
+/*
+ * Store the arguments of a message behind the record header. Returns false if the format string contains a
+ * conversion which can't be deferred. If the arguments don't fit, the arguments stored so far are kept and the
+ * message is cut off at the first missing argument.
+ */
+static bool record_put_args(const char *format, va_list args, uint8_t *record, size_t *pos)
+{
+    conv_spec_t spec;
+    for (const char *p = strchr(format, '%'); p != NULL; p = strchr(p + spec.len, '%')) {
+        parse_spec(p, &spec);
+        if (spec.width_arg) {
+            PUT_ARG(int);
+        }
+        if (spec.precision_arg) {
+            PUT_ARG(int);
+        }
+        switch (spec.type) {
+        case ARG_INVALID:
+            return false;
+        case ARG_NONE:
+            break;
+        case ARG_INT:
+            PUT_ARG(int);
+            break;
+        case ARG_LONG:
+            PUT_ARG(long);
+            break;
+        case ARG_LONG_LONG:
+            PUT_ARG(long long);
+            break;
+        case ARG_INTMAX:
+            PUT_ARG(intmax_t);
+            break;
+        case ARG_SIZE:
+            PUT_ARG(size_t);
+            break;
+        case ARG_PTRDIFF:
+            PUT_ARG(ptrdiff_t);
+            break;
+        case ARG_DOUBLE:
+            PUT_ARG(double);
+            break;
+        case ARG_LONG_DOUBLE:
+            PUT_ARG(long double);
+            break;
+        case ARG_PTR:
+            PUT_ARG(void *);
+            break;
+        case ARG_STR: {
+            const char *str = va_arg(args, const char *);
+            if (str == NULL || esp_ptr_in_drom(str)) {
+                uint32_t len = STRING_IN_FLASH;
+                if (*pos + sizeof(len) + sizeof(str) > RECORD_MAX_SIZE) {
+                    return true;
+                }
+                record_put(record, pos, &len, sizeof(len));
+                record_put(record, pos, &str, sizeof(str));
+            } else {
+                // copy as much of the string as fits, with the terminating NUL
+                if (*pos + sizeof(uint32_t) + 4 > RECORD_MAX_SIZE) {
+                    return true;
+                }
+                uint32_t len = strnlen(str, RECORD_MAX_SIZE - *pos - sizeof(uint32_t) - 1);
+                record_put(record, pos, &len, sizeof(len));
+                memcpy(record + *pos, str, len);
+                record[*pos + len] = '\0';
+                *pos += (len + 1 + 3) & ~3;
+            }
+            break;
+        }
+        }
+    }
+    return true;
+}
+#endif // CONFIG_LOG_DEFERRED_FORMAT_IN_TASK
+
+/* Store the formatted message in the record. Returns the size of the record. */
+static size_t record_put_text(uint8_t *record, const char *format, va_list args)
+{
+    char *text = (char *)record + sizeof(record_header_t);
+    size_t text_size = RECORD_MAX_SIZE - sizeof(record_header_t);
+    int len = vsnprintf(text, text_size, format, args);
+    if (len < 0) {
+        len = 0;
+        text[0] = '\0';
+    } else if ((size_t)len >= text_size) {
+        // keep the line break of a message which is cut off
+        len = text_size - 1;
+        text[len - 1] = '\n';
+    }
+    return (sizeof(record_header_t) + len + 1 + 3) & ~3;
+}
+
+static uint32_t buffer_index(uint32_t index)
+{
+    return (index >= BUFFER_SIZE) ? index - BUFFER_SIZE : index;
+}
+
+/*
+ * Reserve RECORD_MAX_SIZE contiguous bytes at the head of the buffer. Returns NULL if the buffer is full.
+ * Must be called with interrupts disabled on the CPU owning the buffer.
+ */
+static uint8_t *buffer_reserve(log_buffer_t *buffer)
+{
+    uint32_t head = buffer->head;
+    uint32_t tail = __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE);
+    size_t used = (head >= tail) ? head - tail : BUFFER_SIZE - tail + head;
+    size_t skip = (BUFFER_SIZE - head < RECORD_MAX_SIZE) ? BUFFER_SIZE - head : 0;
+    // one word stays free, so that a full buffer can be told from an empty one
+    if (used + skip + RECORD_MAX_SIZE >= BUFFER_SIZE) {
+        __atomic_fetch_add(&buffer->dropped, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&s_dropped_total, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    if (skip != 0) {
+        // the consumer also skips an end which is too small for a header
+        if (skip >= sizeof(record_header_t)) {
+            record_header_t *header = (record_header_t *)(buffer->storage + head);
+            header->size = skip;
+            header->format = RECORD_SKIP;
+            header->ready = 1;
+        }
+        head = 0;
+    }
+    uint8_t *record = buffer->storage + head;
+    record_header_t *header = (record_header_t *)record;
+    header->size = RECORD_MAX_SIZE;
+    header->seq = __atomic_fetch_add(&s_seq, 1, __ATOMIC_RELAXED);
+    header->ready = 0;
+    __atomic_store_n(&buffer->head, buffer_index(head + RECORD_MAX_SIZE), __ATOMIC_RELEASE);
+    return record;
+}
+
+/*
+ * Mark a record reserved by buffer_reserve() as ready, holding size bytes. The unused part of the reserved space is
+ * given back if no space was reserved after it. Must be called with interrupts disabled on the CPU owning the buffer.
+ */
+static void buffer_commit(log_buffer_t *buffer, uint8_t *record, size_t size)
+{
+    record_header_t *header = (record_header_t *)record;
+    uint32_t start = record - buffer->storage;
+    if (buffer->head == buffer_index(start + RECORD_MAX_SIZE)) {
+        header->size = size;
+        __atomic_store_n(&buffer->head, buffer_index(start + size), __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&header->ready, 1, __ATOMIC_RELEASE);
+}
+
+static bool buffers_empty(void)
+{
+    for (int cpu = 0; cpu < portNUM_PROCESSORS; cpu++) {
+        if (__atomic_load_n(&s_buffers[cpu].head, __ATOMIC_ACQUIRE) != s_buffers[cpu].tail) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if CONFIG_LOG_DEFERRED_FORMAT_IN_TASK
+static void line_append(char *line, size_t line_size, size_t *len, const char *str, size_t str_len)
+{
+    str_len = MIN(str_len, line_size - 1 - *len);
+    memcpy(line + *len, str, str_len);
+    *len += str_len;
+}
+
+#define FORMAT_VALUE(value) do {                                                                    \
+        if (spec.width_arg && spec.precision_arg) {                                                 \
+            n = snprintf(line + len, line_size - len, fmt, width, precision, value);                \
+        } else if (spec.width_arg || spec.precision_arg) {                                          \
+            n = snprintf(line + len, line_size - len, fmt, spec.width_arg ? width : precision, value); \
+        } else {                                                                                    \
+            n = snprintf(line + len, line_size - len, fmt, value);                                  \
+        }                                                                                           \
+    } while (0)
+
+#define FORMAT_ARG(type) do {                                           \
+        type value;                                                     \
+        if (!record_get(record, &pos, &value, sizeof(value))) {         \
+            goto missing_arg;                                           \
+        }                                                               \
+        FORMAT_VALUE(value);                                            \
+    } while (0)
+
+/* Format a record like vsnprintf() would have formatted the message */
+static void format_record(const uint8_t *record, char *line, size_t line_size)
+{
+    const record_header_t *header = (const record_header_t *)record;
+    size_t pos = sizeof(record_header_t);
+    size_t len = 0;
+    const char *p = header->format;
+    conv_spec_t spec;
+
+    while (len < line_size - 1) {
+        const char *start = strchr(p, '%');
+        line_append(line, line_size, &len, p, start ? (size_t)(start - p) : strlen(p));
+        if (start == NULL) {
+            break;
+        }
+        parse_spec(start, &spec);
+        p = start + spec.len;
+        if (spec.type == ARG_NONE) {
+            line_append(line, line_size, &len, "%", 1);
+            continue;
+        }
+
+        char fmt[SPEC_MAX_SIZE];
+        memcpy(fmt, start, spec.len);
+        fmt[spec.len] = '\0';
+        int width = 0;
+        int precision = 0;
+        if (spec.width_arg && !record_get(record, &pos, &width, sizeof(width))) {
+            goto missing_arg;
+        }
+        if (spec.precision_arg && !record_get(record, &pos, &precision, sizeof(precision))) {
+            goto missing_arg;
+        }
+
+        int n = 0;
+        switch (spec.type) {
+        case ARG_INT:
+            FORMAT_ARG(int);
+            break;
+        case ARG_LONG:
+            FORMAT_ARG(long);
+            break;
+        case ARG_LONG_LONG:
+            FORMAT_ARG(long long);
+            break;
+        case ARG_INTMAX:
+            FORMAT_ARG(intmax_t);
+            break;
+        case ARG_SIZE:
+            FORMAT_ARG(size_t);
+            break;
+        case ARG_PTRDIFF:
+            FORMAT_ARG(ptrdiff_t);
+            break;
+        case ARG_DOUBLE:
+            FORMAT_ARG(double);
+            break;
+        case ARG_LONG_DOUBLE:
+            FORMAT_ARG(long double);
+            break;
+        case ARG_PTR:
+            FORMAT_ARG(void *);
+            break;
+        case ARG_STR: {
+            uint32_t str_len;
+            const char *str;
+            if (!record_get(record, &pos, &str_len, sizeof(str_len))) {
+                goto missing_arg;
+            }
+            if (str_len == STRING_IN_FLASH) {
+                if (!record_get(record, &pos, &str, sizeof(str))) {
+                    goto missing_arg;
+                }
+            } else {
+                str = (const char *)record + pos;
+                pos += (str_len + 1 + 3) & ~3;
+            }
+            FORMAT_VALUE(str);
+            break;
+        }
+        default:
+            // the producer doesn't store records with other conversions
+            goto missing_arg;
+        }
+        if (n < 0) {
+            break;
+        }
+        len += MIN((size_t)n, line_size - 1 - len);
+    }
+    line[len] = '\0';
+    if (len == line_size - 1) {
+        // keep the line break of a message which is cut off
+        line[len - 1] = '\n';
+    }
+    return;
+
+missing_arg:
+    len = MIN(len, line_size - 5);
+    line_append(line, line_size, &len, "...\n", 4);
+    line[len] = '\0';
+}
+#endif // CONFIG_LOG_DEFERRED_FORMAT_IN_TASK
+
+static void log_print(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    esp_log_vprint(format, args);
+    va_end(args);
+}
+
+static void report_dropped(void)
+{
+    uint32_t dropped = 0;
+    for (int cpu = 0; cpu < portNUM_PROCESSORS; cpu++) {
+        dropped += __atomic_exchange_n(&s_buffers[cpu].dropped, 0, __ATOMIC_RELAXED);
+    }
+    if (dropped != 0) {
+        log_print(LOG_FORMAT(W, "%" PRIu32 " log messages dropped, buffer full"), esp_log_timestamp(), TAG, dropped);
+    }
+}
+
+/* Returns the record at the tail of the buffer, or NULL if the buffer is empty */
+static const record_header_t *buffer_first(log_buffer_t *buffer)
+{
+    uint32_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = buffer->tail;
+    if (head == tail) {
+        return NULL;
+    }
+    const record_header_t *header = (const record_header_t *)(buffer->storage + tail);
+    if (BUFFER_SIZE - tail < sizeof(record_header_t) ||
+            (__atomic_load_n(&header->ready, __ATOMIC_ACQUIRE) && header->format == RECORD_SKIP)) {
+        // the unused end of the buffer, the next record is at the start
+        __atomic_store_n(&buffer->tail, 0, __ATOMIC_RELEASE);
+        if (head == 0) {
+            return NULL;
+        }
+        header = (const record_header_t *)buffer->storage;
+    }
+    return header;
+}
+
+/* Returns the buffer holding the oldest record, or NULL if there is none or if it isn't ready yet */
+static log_buffer_t *next_buffer(void)
+{
+    log_buffer_t *next = NULL;
+    const record_header_t *next_header = NULL;
+    for (int cpu = 0; cpu < portNUM_PROCESSORS; cpu++) {
+        log_buffer_t *buffer = &s_buffers[cpu];
+        const record_header_t *header = buffer_first(buffer);
+        if (header != NULL && (next == NULL || (int32_t)(header->seq - next_header->seq) < 0)) {
+            next = buffer;
+            next_header = header;
+        }
+    }
+    if (next == NULL || !__atomic_load_n(&next_header->ready, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+    return next;
+}
+
+/* Output the oldest buffered record. Returns false if there is no record ready to be output. */
+static bool output_next_record(void)
+{
+    report_dropped();
+
+    log_buffer_t *next = next_buffer();
+    if (next == NULL) {
+        return false;
+    }
+
+    record_header_t next_header;
+    memcpy(&next_header, next->storage + next->tail, sizeof(next_header));
+    memcpy(s_record, next->storage + next->tail, next_header.size);
+    if (next_header.format == NULL) {
+        log_print("%s", (const char *)s_record + sizeof(record_header_t));
+    } else {
+#if CONFIG_LOG_DEFERRED_FORMAT_IN_TASK
+        format_record(s_record, s_line, sizeof(s_line));
+        log_print("%s", s_line);
+#endif
+    }
+
+    // release the space only after the output, esp_log_flush() relies on that
+    __atomic_store_n(&next->tail, buffer_index(next->tail + next_header.size), __ATOMIC_RELEASE);
+    return true;
+}
+
+static void log_task(void *arg)
+{
+    s_task = xTaskGetCurrentTaskHandle();
+    while (true) {
+        if (!output_next_record()) {
+            __atomic_store_n(&s_task_waiting, true, __ATOMIC_RELAXED);
+            //Pairs with the barrier in wake_task() between publishing a record and checking s_task_waiting
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            if (next_buffer() == NULL) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+            __atomic_store_n(&s_task_waiting, false, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static bool create_task(void)
+{
+    if (__atomic_exchange_n(&s_task_creating, true, __ATOMIC_ACQ_REL)) {
+        // created by another caller, possibly still in progress; buffered messages are output once it runs
+        return true;
+    }
+    TaskHandle_t task;
+    if (xTaskCreate(&log_task, "log", CONFIG_LOG_DEFERRED_TASK_STACK_SIZE, NULL,
+                    CONFIG_LOG_DEFERRED_TASK_PRIORITY, &task) != pdPASS) {
+        __atomic_store_n(&s_task_creating, false, __ATOMIC_RELEASE);
+        return false;
+    }
+    __atomic_store_n(&s_task, task, __ATOMIC_RELEASE);
+    return true;
+}
+
+static void wake_task(void)
+{
+    //Pairs with the barrier in log_task() between setting s_task_waiting and checking the buffers
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&s_task_waiting, __ATOMIC_RELAXED) ||
+            !__atomic_exchange_n(&s_task_waiting, false, __ATOMIC_ACQ_REL)) {
+        return;
+    }
+    // s_task is set before the task waits for the first time
+    TaskHandle_t task = __atomic_load_n(&s_task, __ATOMIC_ACQUIRE);
+    if (xPortInIsrContext()) {
+        BaseType_t higher_priority_task_woken = pdFALSE;
+        vTaskNotifyGiveFromISR(task, &higher_priority_task_woken);
+        if (higher_priority_task_woken == pdTRUE) {
+            portYIELD_FROM_ISR();
+        }
+    } else {
+        xTaskNotifyGive(task);
+    }
+}
+
+bool esp_log_deferred_writev(const char *format, va_list args)
+{
+    if (unlikely(xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)) {
+        return false;
+    }
+    if (unlikely(__atomic_load_n(&s_task, __ATOMIC_ACQUIRE) == NULL) && !xPortInIsrContext() && !create_task()) {
+        return false;
+    }
+
+    // keeps other tasks and ISRs of this CPU away from the head of its buffer, until the space is reserved
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    log_buffer_t *buffer = &s_buffers[xPortGetCoreID()];
+    uint8_t *record = buffer_reserve(buffer);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+    if (record == NULL) {
+        return true;
+    }
+
+    record_header_t *header = (record_header_t *)record;
+    size_t size = sizeof(record_header_t);
+    bool deferred_format = false;
+#if CONFIG_LOG_DEFERRED_FORMAT_IN_TASK
+    // the record only keeps the address of the format string, it has to stay valid
+    if (esp_ptr_in_drom(format)) {
+        va_list args_copy;
+        va_copy(args_copy, args);
+        deferred_format = record_put_args(format, args_copy, record, &size);
+        va_end(args_copy);
+    }
+#endif
+    if (deferred_format) {
+        header->format = format;
+    } else {
+        size = record_put_text(record, format, args);
+        header->format = NULL;
+    }
+
+    // the task may have been moved to another CPU, the record stays in the buffer it was reserved in
+    state = portSET_INTERRUPT_MASK_FROM_ISR();
+    buffer_commit(buffer, record, size);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+
+    wake_task();
+    return true;
+}
+
+uint32_t esp_log_get_dropped_count(void)
+{
+    return __atomic_load_n(&s_dropped_total, __ATOMIC_RELAXED);
+}
+
+void esp_log_flush(void)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED || xPortInIsrContext()) {
+        // nothing is buffered before the scheduler is started, and an ISR can't wait for the output
+        return;
+    }
+    if (__atomic_load_n(&s_task, __ATOMIC_ACQUIRE) == xTaskGetCurrentTaskHandle()) {
+        // called by the function set with esp_log_set_vprintf()
+        while (output_next_record()) {
+        }
+        return;
+    }
+    while (!buffers_empty()) {
+        TaskHandle_t task = __atomic_load_n(&s_task, __ATOMIC_ACQUIRE);
+        if (task != NULL) {
+            xTaskNotifyGive(task);
+        } else if (!__atomic_load_n(&s_task_creating, __ATOMIC_ACQUIRE) && !create_task() &&
+                   !__atomic_exchange_n(&s_task_creating, true, __ATOMIC_ACQ_REL)) {
+            // e.g. the messages were logged from an ISR, and there is no memory for the task: output them here,
+            // holding s_task_creating so that neither the task nor another caller reads the buffers meanwhile.
+            // A record which isn't ready yet is left for the next round, after its writer had the time to run.
+            while (output_next_record()) {
+            }
+            __atomic_store_n(&s_task_creating, false, __ATOMIC_RELEASE);
+        }
+        vTaskDelay(1);
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#if CONFIG_LOG_DEFERRED
+
+static const char *TAG = "deferred";
+
+#define BUFFER_SIZE (1024)
+static char s_print_buffer[BUFFER_SIZE];
+static size_t s_counter;
+static int s_lines;
+
+static int print_to_buffer(const char *format, va_list args)
+{
+    int ret = vsnprintf(s_print_buffer + s_counter, BUFFER_SIZE - s_counter, format, args);
+    s_counter += ret;
+    s_lines++;
+    assert(s_counter < BUFFER_SIZE);
+    return ret;
+}
+
+static int slow_print_to_buffer(const char *format, va_list args)
+{
+    // like a slow output device
+    esp_rom_delay_us(1000 * 50);
+    return print_to_buffer(format, args);
+}
+
+static void reset_buffer(void)
+{
+    s_counter = 0;
+    s_lines = 0;
+    s_print_buffer[0] = 0;
+}
+
+TEST_CASE("deferred log copies string arguments which are not in flash", "[log]")
+{
+    char str[16];
+    strcpy(str, "original");
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_buffer();
+
+    ESP_LOGI(TAG, "%s %d %s", str, 42, "literal");
+    strcpy(str, "modified");
+    esp_log_flush();
+
+    esp_log_set_vprintf(old_vprintf);
+    printf("%s", s_print_buffer);
+    TEST_ASSERT_EQUAL(1, s_lines);
+    TEST_ASSERT_NOT_NULL(strstr(s_print_buffer, "deferred: original 42 literal"));
+}
+
+TEST_CASE("deferred log does not wait for the output", "[log]")
+{
+    const int messages = 10;
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(slow_print_to_buffer);
+    reset_buffer();
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < messages; i++) {
+        ESP_LOGI(TAG, "message %d", i);
+    }
+    int64_t logged = esp_timer_get_time();
+    esp_log_flush();
+    int64_t flushed = esp_timer_get_time();
+
+    esp_log_set_vprintf(old_vprintf);
+    printf("%s", s_print_buffer);
+    printf("logging took %lld us, output took %lld us\n", logged - start, flushed - start);
+    TEST_ASSERT_LESS_THAN(5000, logged - start);
+    TEST_ASSERT_GREATER_THAN(messages * 50000, flushed - start);
+    TEST_ASSERT_EQUAL(messages, s_lines);
+
+    // the messages are written out in order
+    const char *pos = s_print_buffer;
+    for (int i = 0; i < messages; i++) {
+        char expected[16];
+        snprintf(expected, sizeof(expected), "message %d", i);
+        pos = strstr(pos, expected);
+        TEST_ASSERT_NOT_NULL(pos);
+    }
+}
+
+static void log_from_small_stack_task(void *arg)
+{
+    ESP_LOGI(TAG, "small stack %d %s %d", 1, "two", 3);
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("deferred log can be used by a task with a small stack", "[log]")
+{
+    SemaphoreHandle_t done = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(done);
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_buffer();
+
+    // the message is stored in the buffer directly, not assembled on the stack of the caller
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(log_from_small_stack_task, "small", 1536, done, uxTaskPriorityGet(NULL) + 1, NULL));
+    TEST_ASSERT_TRUE(xSemaphoreTake(done, pdMS_TO_TICKS(1000)));
+    esp_log_flush();
+
+    esp_log_set_vprintf(old_vprintf);
+    vSemaphoreDelete(done);
+    printf("%s", s_print_buffer);
+    TEST_ASSERT_EQUAL(1, s_lines);
+    TEST_ASSERT_NOT_NULL(strstr(s_print_buffer, "deferred: small stack 1 two 3"));
+}
+
+static int s_message_lines;
+
+static int count_messages(const char *format, va_list args)
+{
+    char line[128];
+    int ret = vsnprintf(line, sizeof(line), format, args);
+    if (strstr(line, "counted message") != NULL) {
+        s_message_lines++;
+    }
+    esp_rom_delay_us(1000);
+    return ret;
+}
+
+TEST_CASE("deferred log counts dropped messages", "[log]")
+{
+    const int messages = 1000;
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(count_messages);
+    s_message_lines = 0;
+
+    uint32_t dropped_before = esp_log_get_dropped_count();
+    for (int i = 0; i < messages; i++) {
+        ESP_LOGI(TAG, "counted message %d", i);
+    }
+    esp_log_flush();
+    uint32_t dropped = esp_log_get_dropped_count() - dropped_before;
+
+    esp_log_set_vprintf(old_vprintf);
+    printf("%d messages written out, %" PRIu32 " dropped\n", s_message_lines, dropped);
+    TEST_ASSERT_GREATER_THAN(0, dropped);
+    TEST_ASSERT_EQUAL(messages, s_message_lines + dropped);
+}
+
+#endif // CONFIG_LOG_DEFERRED
@@ -77,24 +77,28 @@ TEST_CASE("LOG_LOCAL_LEVEL can be re-defined", "[log]")
      * to raise the log level.
      */
 
-    // for ESP_LOGx
+    // for ESP_LOGx, esp_log_flush() waits for the output in case it is deferred
     vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
     reset_buffer();
     ESP_LOGV(TAG1, "No VERBOSE log");
+    esp_log_flush();
     TEST_ASSERT_EQUAL(0, get_counter());
 
     reset_buffer();
     ESP_LOGD(TAG1, "There is a debug log");
+    esp_log_flush();
     TEST_ASSERT_EQUAL(0, get_counter());
 
     reset_buffer();
     esp_log_level_set("*", ESP_LOG_DEBUG);
     ESP_LOGD(TAG1, "There is a debug log");
+    esp_log_flush();
     TEST_ASSERT_GREATER_THAN(17, get_counter());
     TEST_ASSERT_NOT_NULL(strstr(get_buffer(), "There is a debug log"));
 
     reset_buffer();
     ESP_LOGI(TAG1, "There is an info log");
+    esp_log_flush();
     TEST_ASSERT_GREATER_THAN(17, get_counter());
     TEST_ASSERT_NOT_NULL(strstr(get_buffer(), "There is an info log"));
 
@@ -102,19 +106,23 @@ TEST_CASE("LOG_LOCAL_LEVEL can be re-defined", "[log]")
     esp_log_level_set("*", ESP_LOG_INFO);
     esp_log_level_set(TAG1, ESP_LOG_DEBUG);
     ESP_LOGD(TAG1, "There is a debug log");
+    esp_log_flush();
     TEST_ASSERT_NOT_NULL(strstr(get_buffer(), "There is a debug log"));
 
     reset_buffer();
     ESP_LOGD(TAG1, "There is 2nd debug log");
+    esp_log_flush();
     TEST_ASSERT_NOT_NULL(strstr(get_buffer(), "There is 2nd debug log"));
 
     esp_log_level_set("*", ESP_LOG_ERROR);
     reset_buffer();
     ESP_LOGI(TAG1, "There is an info log");
+    esp_log_flush();
     TEST_ASSERT_EQUAL(0, get_counter());
 
     reset_buffer();
     ESP_LOGE(TAG1, "There is an error log");
+    esp_log_flush();
     TEST_ASSERT_GREATER_THAN(17, get_counter());
     TEST_ASSERT_NOT_NULL(strstr(get_buffer(), "There is an error log"));
     esp_log_set_vprintf(old_vprintf);
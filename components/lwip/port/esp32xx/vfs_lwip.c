@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2017-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2017-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -92,6 +92,8 @@ void esp_vfs_lwip_sockets_register(void)
         .fstat = &lwip_fstat,
         .close = &lwip_close,
         .read = &lwip_read,
+        .writev = &lwip_writev,
+        .readv = &lwip_readv,
         .fcntl = &lwip_fcntl_r_wrapper,
         .ioctl = &lwip_ioctl_r_wrapper,
 #ifdef CONFIG_VFS_SUPPORT_SELECT
@@ -17,6 +17,7 @@
 #include <sys/types.h>
 #include <sys/select.h>
 #include <sys/poll.h>
+#include <sys/uio.h>
 #include "esp_task.h"
 #include "esp_random.h"
 #include "sdkconfig.h"
@@ -481,6 +482,10 @@ static inline uint32_t timeout_from_offered(uint32_t lease, uint32_t min)
  */
 #define LWIP_DNS                        1
 
+/** DNS maximum number of entries to maintain locally.
+ */
+#define DNS_TABLE_SIZE                  CONFIG_LWIP_DNS_TABLE_SIZE
+
 /** The maximum number of IP addresses per host
  */
 #define DNS_MAX_HOST_IP                 CONFIG_LWIP_DNS_MAX_HOST_IP
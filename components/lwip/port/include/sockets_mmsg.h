@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <sys/time.h>
+#include "lwip/sockets.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef MSG_WAITFORONE
+#define MSG_WAITFORONE  0x10000  /* recvmmsg(): Only block until the first message is received */
+#endif
+
+/**
+ * @brief Message header of sendmmsg() and recvmmsg()
+ */
+struct mmsghdr {
+    struct msghdr msg_hdr;  /*!< Message to send or receive */
+    unsigned int msg_len;   /*!< Number of bytes sent or received for this message */
+};
+
+/**
+ * @brief Send multiple messages on a socket with a single call
+ *
+ * The messages are sent in order, as if sendmsg() was called for each of them. The call stops at the first
+ * message which can't be sent.
+ *
+ * @param s      Socket descriptor
+ * @param msgvec Array of messages, msg_len of each sent message is set to the number of bytes sent
+ * @param vlen   Number of messages in the array
+ * @param flags  Flags passed to sendmsg() for each message
+ *
+ * @return Number of messages sent, or -1 with errno set if the first message couldn't be sent
+ */
+int lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+
+/**
+ * @brief Receive multiple messages from a socket with a single call
+ *
+ * The messages are received in order, as if recvmsg() was called for each of them. The call blocks until vlen
+ * messages are received unless the socket is non-blocking, MSG_DONTWAIT is given, or MSG_WAITFORONE is given and
+ * one message was received.
+ *
+ * @param s       Socket descriptor
+ * @param msgvec  Array of messages, msg_len of each received message is set to the number of bytes received
+ * @param vlen    Number of messages in the array
+ * @param flags   Flags passed to recvmsg() for each message, and MSG_WAITFORONE
+ * @param timeout If not NULL, no further message is received once the timeout elapsed. Like on other systems,
+ *                the timeout is only checked after a message was received.
+ *
+ * @return Number of messages received, or -1 with errno set if no message was received
+ */
+int lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timeval *timeout);
+
+static inline int sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{ return lwip_sendmmsg(s, msgvec, vlen, flags); }
+static inline int recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timeval *timeout)
+{ return lwip_recvmmsg(s, msgvec, vlen, flags, timeout); }
+
+#ifdef __cplusplus
+}
+#endif
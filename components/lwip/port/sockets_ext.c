@@ -1,9 +1,10 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <errno.h>
 #include "lwip/sockets.h"
 #include "lwip/priv/sockets_priv.h"
 #include "lwip/api.h"
@@ -11,6 +12,7 @@
 #include "lwip/tcp.h"
 #include "lwip/raw.h"
 #include "lwip/udp.h"
+#include "sockets_mmsg.h"
 
 #define LWIP_SOCKOPT_CHECK_OPTLEN_CONN_PCB(sock, optlen, opttype) do { \
   if (((optlen) < sizeof(opttype)) || ((sock)->conn == NULL) || ((sock)->conn->pcb.tcp == NULL)) { *err=EINVAL; goto exit; } }while(0)
@@ -106,3 +108,57 @@ exit:
     return true;
 #endif /* LWIP_IPV6 */
 }
+
+int lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    unsigned int sent;
+
+    if (msgvec == NULL && vlen > 0) {
+        errno = EFAULT;
+        return -1;
+    }
+    for (sent = 0; sent < vlen; sent++) {
+        ssize_t ret = lwip_sendmsg(s, &msgvec[sent].msg_hdr, flags);
+        if (ret < 0) {
+            /* the error is reported by the next call if some messages were sent */
+            return sent > 0 ? (int)sent : -1;
+        }
+        msgvec[sent].msg_len = (unsigned int)ret;
+    }
+    return (int)sent;
+}
+
+int lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timeval *timeout)
+{
+    unsigned int received;
+    int recv_flags = flags & ~MSG_WAITFORONE;
+    u32_t start = sys_now();
+    u32_t timeout_ms = 0;
+
+    if (msgvec == NULL && vlen > 0) {
+        errno = EFAULT;
+        return -1;
+    }
+    if (timeout != NULL) {
+        if (timeout->tv_sec < 0 || timeout->tv_usec < 0) {
+            errno = EINVAL;
+            return -1;
+        }
+        timeout_ms = (u32_t)(timeout->tv_sec * 1000 + timeout->tv_usec / 1000);
+    }
+    for (received = 0; received < vlen; received++) {
+        ssize_t ret = lwip_recvmsg(s, &msgvec[received].msg_hdr, recv_flags);
+        if (ret < 0) {
+            /* the error is reported by the next call if some messages were received */
+            return received > 0 ? (int)received : -1;
+        }
+        msgvec[received].msg_len = (unsigned int)ret;
+        if (flags & MSG_WAITFORONE) {
+            recv_flags |= MSG_DONTWAIT;
+        }
+        if (timeout != NULL && (u32_t)(sys_now() - start) >= timeout_ms) {
+            return (int)(received + 1);
+        }
+    }
+    return (int)received;
+}
@@ -5,6 +5,7 @@
  */
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
 #include <esp_types.h>
 
 #include "freertos/FreeRTOS.h"
@@ -18,6 +19,7 @@
 #include "lwip/inet.h"
 #include "lwip/netdb.h"
 #include "lwip/sockets.h"
+#include "sockets_mmsg.h"
 #include "lwip/tcpip.h"
 #include "lwip/prot/iana.h"
 #include "ping/ping_sock.h"
@@ -29,6 +31,8 @@
 #define ETH_PING_DURATION_MS (5000)
 #define ETH_PING_END_TIMEOUT_MS (ETH_PING_DURATION_MS * 2)
 #define TEST_ICMP_DESTINATION_DOMAIN_NAME "127.0.0.1"
+#define TEST_MMSG_PORT (3333)
+#define TEST_MMSG_NUM (4)
 
 
 TEST_GROUP(lwip);
@@ -319,6 +323,59 @@ TEST(lwip, sntp_client_time_2048)
     test_sntp_timestamps(2048, false); // NTP timestamp MSB is cleared for time after 2036
 }
 
+TEST(lwip, udp_sendmmsg_recvmmsg_localhost)
+{
+    test_case_uses_tcpip();
+
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(TEST_MMSG_PORT),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, sock);
+    TEST_ASSERT_EQUAL(0, bind(sock, (struct sockaddr *)&addr, sizeof(addr)));
+
+    char tx_data[TEST_MMSG_NUM][8];
+    struct iovec tx_iov[TEST_MMSG_NUM];
+    struct mmsghdr tx_msgs[TEST_MMSG_NUM];
+    memset(tx_data, 0, sizeof(tx_data));
+    memset(tx_msgs, 0, sizeof(tx_msgs));
+    for (int i = 0; i < TEST_MMSG_NUM; i++) {
+        int len = snprintf(tx_data[i], sizeof(tx_data[i]), "msg%d", i);
+        tx_iov[i].iov_base = tx_data[i];
+        tx_iov[i].iov_len = len + i; // datagrams of different lengths
+        tx_msgs[i].msg_hdr.msg_name = &addr;
+        tx_msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+        tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+        tx_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    TEST_ASSERT_EQUAL(TEST_MMSG_NUM, sendmmsg(sock, tx_msgs, TEST_MMSG_NUM, 0));
+
+    char rx_data[TEST_MMSG_NUM + 1][16];
+    struct iovec rx_iov[TEST_MMSG_NUM + 1];
+    struct mmsghdr rx_msgs[TEST_MMSG_NUM + 1];
+    memset(rx_msgs, 0, sizeof(rx_msgs));
+    for (int i = 0; i < TEST_MMSG_NUM + 1; i++) {
+        rx_iov[i].iov_base = rx_data[i];
+        rx_iov[i].iov_len = sizeof(rx_data[i]);
+        rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+        rx_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    vTaskDelay(pdMS_TO_TICKS(10));
+    // one more message than sent, MSG_WAITFORONE returns once no more datagrams are queued
+    TEST_ASSERT_EQUAL(TEST_MMSG_NUM, recvmmsg(sock, rx_msgs, TEST_MMSG_NUM + 1, MSG_WAITFORONE, NULL));
+    for (int i = 0; i < TEST_MMSG_NUM; i++) {
+        TEST_ASSERT_EQUAL(tx_msgs[i].msg_len, rx_msgs[i].msg_len);
+        TEST_ASSERT_EQUAL_MEMORY(tx_data[i], rx_data[i], rx_msgs[i].msg_len);
+    }
+
+    // nothing left to receive
+    TEST_ASSERT_EQUAL(-1, recvmmsg(sock, rx_msgs, 1, MSG_DONTWAIT, NULL));
+    TEST_ASSERT_EQUAL(EWOULDBLOCK, errno);
+    close(sock);
+}
+
 TEST_GROUP_RUNNER(lwip)
 {
     RUN_TEST_CASE(lwip, localhost_ping_test)
@@ -326,6 +383,7 @@ TEST_GROUP_RUNNER(lwip)
     RUN_TEST_CASE(lwip, dhcp_server_start_stop_localhost)
     RUN_TEST_CASE(lwip, sntp_client_time_2015)
     RUN_TEST_CASE(lwip, sntp_client_time_2048)
+    RUN_TEST_CASE(lwip, udp_sendmmsg_recvmmsg_localhost)
 }
 
 void app_main(void)
@@ -193,6 +193,39 @@ int esp_aes_crypt_ecb(esp_aes_context *ctx,
     return r;
 }
 
+/*
+ * AES-ECB encryption/decryption of consecutive blocks in one DMA transfer
+ */
+int esp_aes_crypt_ecb_blocks(esp_aes_context *ctx,
+                             int mode,
+                             size_t length,
+                             const unsigned char *input,
+                             unsigned char *output )
+{
+    int r = -1;
+
+    if (esp_aes_validate_input(ctx, input, output)) {
+        return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
+    }
+
+    if ( (length % AES_BLOCK_BYTES) || (length == 0) ) {
+        return ERR_ESP_AES_INVALID_INPUT_LENGTH;
+    }
+
+    if (!valid_key_length(ctx)) {
+        return MBEDTLS_ERR_AES_INVALID_KEY_LENGTH;
+    }
+
+    esp_aes_acquire_hardware();
+    ctx->key_in_hardware = 0;
+    ctx->key_in_hardware = aes_hal_setkey(ctx->key, ctx->key_bytes, mode);
+    aes_hal_mode_init(ESP_AES_BLOCK_MODE_ECB);
+    r = esp_aes_process_dma(ctx, input, output, length, NULL);
+    esp_aes_release_hardware();
+
+    return r;
+}
+
 /*
  * AES-CBC buffer encryption/decryption
  */
@@ -34,11 +34,14 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/lock.h>
 #include "mbedtls/aes.h"
+#include "mbedtls/platform_util.h"
 
 #include "aes/esp_aes.h"
+#include "esp_aes_internal.h"
 
 void esp_aes_xts_init( esp_aes_xts_context *ctx )
 {
@@ -282,3 +285,78 @@ int esp_aes_crypt_xts( esp_aes_xts_context *ctx,
 
     return ( 0 );
 }
+
+/*
+ * XTS-AES encryption/decryption of several data units of the same size
+ *
+ * The tweaks of all data units are computed in one ECB operation, and all
+ * blocks, XORed with their tweaks, are processed in a second one.
+ */
+int esp_aes_crypt_xts_units( esp_aes_xts_context *ctx,
+                             int mode,
+                             size_t unit_length,
+                             size_t units,
+                             const unsigned char data_units[][16],
+                             const unsigned char *input,
+                             unsigned char *output )
+{
+    int ret;
+    const size_t length = unit_length * units;
+
+    if ( units == 0 ) {
+        return ( 0 );
+    }
+
+    unsigned char *tweaks = NULL;
+    if ( unit_length >= 16 && unit_length % 16 == 0 && unit_length <= ( 1 << 20 ) * 16 ) {
+        tweaks = malloc( length );
+    }
+
+    /* Ciphertext stealing, or no memory for the tweaks: process unit by unit */
+    if ( tweaks == NULL ) {
+        for ( size_t u = 0; u < units; u++ ) {
+            ret = esp_aes_crypt_xts( ctx, mode, unit_length, data_units[u],
+                                     input + u * unit_length, output + u * unit_length );
+            if ( ret != 0 ) {
+                return ( ret );
+            }
+        }
+        return ( 0 );
+    }
+
+    ret = esp_aes_crypt_ecb_blocks( &ctx->tweak, MBEDTLS_AES_ENCRYPT, units * 16,
+                                    &data_units[0][0], tweaks );
+    if ( ret != 0 ) {
+        goto cleanup;
+    }
+
+    /* Expand the tweak of each unit to all of its blocks, from the last unit
+     * so that the tweaks of the units not expanded yet are not overwritten. */
+    for ( size_t u = units; u-- > 0; ) {
+        unsigned char tweak[16];
+        unsigned char *t = tweaks + u * unit_length;
+        memcpy( tweak, tweaks + u * 16, sizeof( tweak ) );
+        for ( size_t b = 0; b < unit_length; b += 16 ) {
+            memcpy( t + b, tweak, sizeof( tweak ) );
+            esp_gf128mul_x_ble( tweak, tweak );
+        }
+    }
+
+    for ( size_t i = 0; i < length; i++ ) {
+        output[i] = input[i] ^ tweaks[i];
+    }
+
+    ret = esp_aes_crypt_ecb_blocks( &ctx->crypt, mode, length, output, output );
+    if ( ret != 0 ) {
+        goto cleanup;
+    }
+
+    for ( size_t i = 0; i < length; i++ ) {
+        output[i] ^= tweaks[i];
+    }
+
+cleanup:
+    mbedtls_platform_zeroize( tweaks, length );
+    free( tweaks );
+    return ( ret );
+}
@@ -17,6 +17,20 @@ extern "C" {
 
 bool valid_key_length(const esp_aes_context *ctx);
 
+/**
+ * @brief           AES-ECB encryption or decryption of consecutive blocks
+ *
+ * The key is loaded once for all blocks, unlike when calling esp_aes_crypt_ecb for each block.
+ *
+ * @param ctx       AES context
+ * @param mode      ESP_AES_ENCRYPT or ESP_AES_DECRYPT
+ * @param length    Length of the data, a multiple of 16 bytes
+ * @param input     Input data
+ * @param output    Output data, can be the same buffer as input
+ * @return int      0 on success
+ */
+int esp_aes_crypt_ecb_blocks(esp_aes_context *ctx, int mode, size_t length, const unsigned char *input, unsigned char *output);
+
 #if SOC_AES_SUPPORT_DMA
 /**
  * @brief           Run a AES operation using DMA
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,13 +7,20 @@
 #include "bignum_impl.h"
 #include "mbedtls/bignum.h"
 #include "esp_private/esp_crypto_lock_internal.h"
+#include "esp_private/esp_crypto_accel_stats_internal.h"
 
 #include "hal/mpi_hal.h"
 #include "hal/mpi_ll.h"
 
 void esp_mpi_enable_hardware_hw_op( void )
 {
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    const int64_t wait_start = esp_crypto_accel_stats_wait_start();
     esp_crypto_mpi_lock_acquire();
+    esp_crypto_accel_stats_acquired(ESP_CRYPTO_ACCEL_MPI, wait_start);
+#else
+    esp_crypto_mpi_lock_acquire();
+#endif
 
     /* Enable RSA hardware */
     MPI_RCC_ATOMIC() {
@@ -34,6 +41,9 @@ void esp_mpi_disable_hardware_hw_op( void )
         mpi_ll_enable_bus_clock(false);
     }
 
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    esp_crypto_accel_stats_released(ESP_CRYPTO_ACCEL_MPI);
+#endif
     esp_crypto_mpi_lock_release();
 }
 
@@ -35,6 +35,9 @@ static const char *TAG = "crypto_shared_gdma";
 static gdma_channel_handle_t rx_channel;
 static gdma_channel_handle_t tx_channel;
 
+/* Peripheral the TX channel is connected to, -1 if none */
+static int tx_peripheral = -1;
+
 /* Allocate a new GDMA channel, will keep trying until NEW_CHANNEL_TIMEOUT_MS */
 static inline esp_err_t crypto_shared_gdma_new_channel(gdma_channel_alloc_config_t *channel_config, gdma_channel_handle_t *channel)
 {
@@ -95,8 +98,10 @@ static esp_err_t crypto_shared_gdma_init(void)
 #ifdef SOC_AES_SUPPORTED
     gdma_connect(rx_channel, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_AES, 0));
     gdma_connect(tx_channel, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_AES, 0));
+    tx_peripheral = GDMA_TRIG_PERIPH_AES;
 #elif SOC_SHA_SUPPORTED
     gdma_connect(tx_channel, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_SHA, 0));
+    tx_peripheral = GDMA_TRIG_PERIPH_SHA;
 #endif
 
     return ESP_OK;
@@ -109,23 +114,26 @@ err:
     return ret;
 }
 
-esp_err_t esp_crypto_shared_gdma_start(const lldesc_t *input, const lldesc_t *output, gdma_trigger_peripheral_t peripheral)
+/* Tx channel is shared between AES and SHA. Reconnecting it goes through the GDMA driver and its
+   group lock, so it is only done when the peripheral changes, e.g. not between the records of a TLS
+   connection, which all use AES. Otherwise the channel is only reset, as gdma_connect() would do. */
+static esp_err_t crypto_shared_gdma_connect_tx(gdma_trigger_peripheral_t peripheral)
 {
-    int rx_ch_id = 0;
-    esp_err_t ret = ESP_OK;
-
-    if (tx_channel == NULL) {
-        /* Allocate a pair of RX and TX for crypto, should only happen the first time we use the GMDA
-           or if user called esp_crypto_shared_gdma_release */
-        ret = crypto_shared_gdma_init();
-    }
-
-    if (ret != ESP_OK) {
-        return ret;
+#if SOC_AHB_GDMA_VERSION == 1 || SOC_AXI_GDMA_SUPPORTED
+    if (tx_peripheral == (int)peripheral) {
+        int tx_ch_id = 0;
+        gdma_get_channel_id(tx_channel, &tx_ch_id);
+#if SOC_AHB_GDMA_VERSION == 1
+        gdma_ll_tx_reset_channel(&GDMA, tx_ch_id);
+#else
+        axi_dma_ll_tx_reset_channel(&AXI_DMA, tx_ch_id);
+#endif /* SOC_AHB_GDMA_VERSION */
+        return ESP_OK;
     }
+#endif /* SOC_AHB_GDMA_VERSION == 1 || SOC_AXI_GDMA_SUPPORTED */
 
-    /* Tx channel is shared between AES and SHA, need to connect to peripheral every time */
     gdma_disconnect(tx_channel);
+    tx_peripheral = -1;
 
 #ifdef SOC_SHA_SUPPORTED
     if (peripheral == GDMA_TRIG_PERIPH_SHA) {
@@ -141,7 +149,31 @@ esp_err_t esp_crypto_shared_gdma_start(const lldesc_t *input, const lldesc_t *ou
         return ESP_ERR_INVALID_ARG;
     }
 
-    /* tx channel is reset by gdma_connect(), also reset rx to ensure a known state */
+    tx_peripheral = peripheral;
+    return ESP_OK;
+}
+
+esp_err_t esp_crypto_shared_gdma_start(const lldesc_t *input, const lldesc_t *output, gdma_trigger_peripheral_t peripheral)
+{
+    int rx_ch_id = 0;
+    esp_err_t ret = ESP_OK;
+
+    if (tx_channel == NULL) {
+        /* Allocate a pair of RX and TX for crypto, should only happen the first time we use the GMDA
+           or if user called esp_crypto_shared_gdma_release */
+        ret = crypto_shared_gdma_init();
+    }
+
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    ret = crypto_shared_gdma_connect_tx(peripheral);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    /* tx channel is reset by crypto_shared_gdma_connect_tx(), also reset rx to ensure a known state */
     gdma_get_channel_id(rx_channel, &rx_ch_id);
 
 #if SOC_AHB_GDMA_VERSION == 1
@@ -183,24 +215,12 @@ esp_err_t esp_crypto_shared_gdma_start_axi_ahb(const crypto_dma_desc_t *input, c
         }
     }
 
-    /* Tx channel is shared between AES and SHA, need to connect to peripheral every time */
-    gdma_disconnect(tx_channel);
-
-#ifdef SOC_SHA_SUPPORTED
-    if (peripheral == GDMA_TRIG_PERIPH_SHA) {
-        gdma_connect(tx_channel, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_SHA, 0));
-    } else
-#endif // SOC_SHA_SUPPORTED
-#ifdef SOC_AES_SUPPORTED
-    if (peripheral == GDMA_TRIG_PERIPH_AES) {
-        gdma_connect(tx_channel, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_AES, 0));
-    } else
-#endif // SOC_AES_SUPPORTED
-    {
-        return ESP_ERR_INVALID_ARG;
+    esp_err_t ret = crypto_shared_gdma_connect_tx(peripheral);
+    if (ret != ESP_OK) {
+        return ret;
     }
 
-    /* tx channel is reset by gdma_connect(), also reset rx to ensure a known state */
+    /* tx channel is reset by crypto_shared_gdma_connect_tx(), also reset rx to ensure a known state */
     gdma_get_channel_id(rx_channel, &rx_ch_id);
 
 #if SOC_AHB_GDMA_VERSION == 1
@@ -260,6 +280,7 @@ void esp_crypto_shared_gdma_free()
         gdma_disconnect(tx_channel);
         gdma_del_channel(tx_channel);
         tx_channel = NULL;
+        tx_peripheral = -1;
     }
 
     esp_crypto_sha_aes_lock_release();
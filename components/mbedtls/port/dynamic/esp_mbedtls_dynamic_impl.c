@@ -1,10 +1,16 @@
 /*
- * SPDX-FileCopyrightText: 2020-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <string.h>
+#include <sys/lock.h>
+#include <sys/param.h>
+#include <sys/queue.h>
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "esp_mbedtls_dynamic.h"
 #include "esp_mbedtls_dynamic_impl.h"
 
 #define COUNTER_SIZE (8)
@@ -34,6 +40,138 @@ void esp_mbedtls_free_buf(unsigned char *buf)
     mbedtls_free(temp);
 }
 
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_STATS
+typedef struct esp_mbedtls_dynamic_stats_entry {
+    const mbedtls_ssl_context *ssl;
+    esp_mbedtls_dynamic_buffer_stats_t stats;
+    SLIST_ENTRY(esp_mbedtls_dynamic_stats_entry) next;
+} esp_mbedtls_dynamic_stats_entry_t;
+
+static SLIST_HEAD(, esp_mbedtls_dynamic_stats_entry) s_stats_list = SLIST_HEAD_INITIALIZER(s_stats_list);
+static _lock_t s_stats_lock;
+
+/* Called with s_stats_lock held */
+static esp_mbedtls_dynamic_stats_entry_t *esp_mbedtls_find_stats(const mbedtls_ssl_context *ssl)
+{
+    esp_mbedtls_dynamic_stats_entry_t *entry;
+
+    SLIST_FOREACH(entry, &s_stats_list, next) {
+        if (entry->ssl == ssl) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+int esp_mbedtls_dynamic_stats_add(const mbedtls_ssl_context *ssl)
+{
+    int ret = 0;
+
+    _lock_acquire(&s_stats_lock);
+    esp_mbedtls_dynamic_stats_entry_t *entry = esp_mbedtls_find_stats(ssl);
+    if (entry) {
+        memset(&entry->stats, 0, sizeof(entry->stats));
+    } else {
+        entry = mbedtls_calloc(1, sizeof(esp_mbedtls_dynamic_stats_entry_t));
+        if (entry) {
+            entry->ssl = ssl;
+            SLIST_INSERT_HEAD(&s_stats_list, entry, next);
+        } else {
+            ESP_LOGE(TAG, "alloc(%d bytes) failed", (int)sizeof(esp_mbedtls_dynamic_stats_entry_t));
+            ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
+        }
+    }
+    _lock_release(&s_stats_lock);
+
+    return ret;
+}
+
+void esp_mbedtls_dynamic_stats_remove(const mbedtls_ssl_context *ssl)
+{
+    _lock_acquire(&s_stats_lock);
+    esp_mbedtls_dynamic_stats_entry_t *entry = esp_mbedtls_find_stats(ssl);
+    if (entry) {
+        SLIST_REMOVE(&s_stats_list, entry, esp_mbedtls_dynamic_stats_entry, next);
+        mbedtls_free(entry);
+    }
+    _lock_release(&s_stats_lock);
+}
+
+static void esp_mbedtls_dynamic_stats_record(const mbedtls_ssl_context *ssl, size_t len, bool tx, const void *buf)
+{
+    _lock_acquire(&s_stats_lock);
+    esp_mbedtls_dynamic_stats_entry_t *entry = esp_mbedtls_find_stats(ssl);
+    if (entry) {
+        esp_mbedtls_dynamic_buffer_stats_t *stats = &entry->stats;
+        if (!buf) {
+            stats->alloc_fail_count++;
+        } else {
+            if (tx) {
+                stats->tx_alloc_count++;
+                stats->tx_max_len = MAX(stats->tx_max_len, len);
+            } else {
+                stats->rx_alloc_count++;
+                stats->rx_max_len = MAX(stats->rx_max_len, len);
+            }
+            if (esp_ptr_external_ram(buf)) {
+                stats->psram_alloc_count++;
+            }
+        }
+    }
+    _lock_release(&s_stats_lock);
+}
+
+esp_err_t esp_mbedtls_dynamic_buffer_get_stats(const mbedtls_ssl_context *ssl, esp_mbedtls_dynamic_buffer_stats_t *stats)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    if (!ssl || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    _lock_acquire(&s_stats_lock);
+    esp_mbedtls_dynamic_stats_entry_t *entry = esp_mbedtls_find_stats(ssl);
+    if (entry) {
+        *stats = entry->stats;
+        ret = ESP_OK;
+    }
+    _lock_release(&s_stats_lock);
+
+    return ret;
+}
+#endif /* CONFIG_MBEDTLS_DYNAMIC_BUFFER_STATS */
+
+/**
+ * Allocate a TX/RX buffer with len bytes of data. Large buffers are placed in PSRAM if enabled,
+ * small ones and the rest of the mbedTLS working set stay in internal RAM.
+ */
+static struct esp_mbedtls_ssl_buf *esp_mbedtls_alloc_buf(mbedtls_ssl_context *ssl, size_t len, bool tx)
+{
+    struct esp_mbedtls_ssl_buf *esp_buf;
+    const size_t size = SSL_BUF_HEAD_OFFSET_SIZE + len;
+
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_RECORD_IN_PSRAM
+    if (len >= CONFIG_MBEDTLS_DYNAMIC_BUFFER_PSRAM_THRESHOLD) {
+        esp_buf = heap_caps_calloc_prefer(1, size, 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT,
+                                          MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    } else {
+        esp_buf = heap_caps_calloc_prefer(1, size, 2, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+                                          MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+#else
+    esp_buf = mbedtls_calloc(1, size);
+#endif
+
+#if CONFIG_MBEDTLS_DYNAMIC_BUFFER_STATS
+    esp_mbedtls_dynamic_stats_record(ssl, len, tx, esp_buf);
+#else
+    (void)ssl;
+    (void)tx;
+#endif
+
+    return esp_buf;
+}
+
 static void esp_mbedtls_init_ssl_buf(struct esp_mbedtls_ssl_buf *buf, unsigned int len)
 {
     if (buf) {
@@ -144,7 +282,7 @@ static int esp_mbedtls_alloc_tx_buf(mbedtls_ssl_context *ssl, int len)
         ssl->MBEDTLS_PRIVATE(out_buf) = NULL;
     }
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + len);
+    esp_buf = esp_mbedtls_alloc_buf(ssl, len, true);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + len);
         return MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -205,7 +343,7 @@ int esp_mbedtls_reset_add_rx_buffer(mbedtls_ssl_context *ssl)
         ssl->MBEDTLS_PRIVATE(in_buf) = NULL;
     }
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + MBEDTLS_SSL_IN_BUFFER_LEN);
+    esp_buf = esp_mbedtls_alloc_buf(ssl, MBEDTLS_SSL_IN_BUFFER_LEN, false);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + MBEDTLS_SSL_IN_BUFFER_LEN);
         return MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -256,7 +394,7 @@ int esp_mbedtls_add_tx_buffer(mbedtls_ssl_context *ssl, size_t buffer_len)
 
     buffer_len = tx_buffer_len(ssl, buffer_len);
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
+    esp_buf = esp_mbedtls_alloc_buf(ssl, buffer_len, true);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%zu bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -301,7 +439,7 @@ int esp_mbedtls_free_tx_buffer(mbedtls_ssl_context *ssl)
     esp_mbedtls_free_buf(ssl->MBEDTLS_PRIVATE(out_buf));
     init_tx_buffer(ssl, NULL);
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + TX_IDLE_BUFFER_SIZE);
+    esp_buf = esp_mbedtls_alloc_buf(ssl, TX_IDLE_BUFFER_SIZE, true);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + TX_IDLE_BUFFER_SIZE);
         return MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -369,7 +507,7 @@ int esp_mbedtls_add_rx_buffer(mbedtls_ssl_context *ssl)
         init_rx_buffer(ssl, NULL);
     }
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
+    esp_buf = esp_mbedtls_alloc_buf(ssl, buffer_len, false);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + buffer_len);
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
@@ -435,7 +573,7 @@ int esp_mbedtls_free_rx_buffer(mbedtls_ssl_context *ssl)
     esp_mbedtls_free_buf(ssl->MBEDTLS_PRIVATE(in_buf));
     init_rx_buffer(ssl, NULL);
 
-    esp_buf = mbedtls_calloc(1, SSL_BUF_HEAD_OFFSET_SIZE + 16);
+    esp_buf = esp_mbedtls_alloc_buf(ssl, 16, false);
     if (!esp_buf) {
         ESP_LOGE(TAG, "alloc(%d bytes) failed", SSL_BUF_HEAD_OFFSET_SIZE + 16);
         ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
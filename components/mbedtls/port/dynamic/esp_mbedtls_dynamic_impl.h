@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -83,6 +83,12 @@ int esp_mbedtls_free_rx_buffer(mbedtls_ssl_context *ssl);
 
 size_t esp_mbedtls_get_crt_size(mbedtls_x509_crt *cert, size_t *num);
 
+#ifdef CONFIG_MBEDTLS_DYNAMIC_BUFFER_STATS
+int esp_mbedtls_dynamic_stats_add(const mbedtls_ssl_context *ssl);
+
+void esp_mbedtls_dynamic_stats_remove(const mbedtls_ssl_context *ssl);
+#endif
+
 #ifdef CONFIG_MBEDTLS_DYNAMIC_FREE_CONFIG_DATA
 void esp_mbedtls_free_dhm(mbedtls_ssl_context *ssl);
 
@@ -304,6 +304,10 @@ int __wrap_mbedtls_ssl_setup(mbedtls_ssl_context *ssl, const mbedtls_ssl_config
 
     CHECK_OK(ssl_handshake_init(ssl));
 
+#ifdef CONFIG_MBEDTLS_DYNAMIC_BUFFER_STATS
+    CHECK_OK(esp_mbedtls_dynamic_stats_add(ssl));
+#endif
+
     mbedtls_free(ssl->MBEDTLS_PRIVATE(out_buf));
     ssl->MBEDTLS_PRIVATE(out_buf) = NULL;
     CHECK_OK(esp_mbedtls_setup_tx_buffer(ssl));
@@ -366,6 +370,10 @@ void __wrap_mbedtls_ssl_free(mbedtls_ssl_context *ssl)
         ssl->MBEDTLS_PRIVATE(in_buf) = NULL;
     }
 
+#ifdef CONFIG_MBEDTLS_DYNAMIC_BUFFER_STATS
+    esp_mbedtls_dynamic_stats_remove(ssl);
+#endif
+
     __real_mbedtls_ssl_free(ssl);
 }
 
@@ -6,17 +6,135 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_log.h"
 #include "esp_crypto_lock.h"
 #include "esp_private/esp_crypto_lock_internal.h"
+#include "esp_private/esp_crypto_accel_stats_internal.h"
 #include "ecc_impl.h"
 #include "hal/ecc_hal.h"
 #include "hal/ecc_ll.h"
 #include "soc/soc_caps.h"
 
+#if CONFIG_MBEDTLS_ECC_USE_INTERRUPT
+#include "esp_intr_alloc.h"
+#include "esp_pm.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+/* Point multiplication on SECP256R1 with the constant time option takes a few ms,
+   so a 2 second timeout is only reached if the peripheral is stuck */
+#define ECC_WAIT_INTR_TIMEOUT_MS 2000
+
+static const char *TAG = "ecc";
+
+static SemaphoreHandle_t op_complete_sem;
+#if defined(CONFIG_PM_ENABLE)
+static esp_pm_lock_handle_t s_pm_cpu_lock;
+static esp_pm_lock_handle_t s_pm_sleep_lock;
+#endif
+
+static IRAM_ATTR void esp_ecc_complete_isr(void *arg)
+{
+    BaseType_t higher_woken = pdFALSE;
+    ecc_ll_clear_interrupt();
+
+    xSemaphoreGiveFromISR(op_complete_sem, &higher_woken);
+    if (higher_woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static esp_err_t esp_ecc_isr_initialise(void)
+{
+    if (op_complete_sem == NULL) {
+        static StaticSemaphore_t op_sem_buf;
+        op_complete_sem = xSemaphoreCreateBinaryStatic(&op_sem_buf);
+        if (op_complete_sem == NULL) {
+            ESP_LOGE(TAG, "Failed to create intr semaphore");
+            return ESP_FAIL;
+        }
+
+        const int isr_flags = esp_intr_level_to_flags(CONFIG_MBEDTLS_ECC_INTERRUPT_LEVEL);
+
+        esp_err_t ret = esp_intr_alloc(ETS_ECC_INTR_SOURCE, isr_flags, esp_ecc_complete_isr, NULL, NULL);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to allocate ECC interrupt %d", ret);
+
+            // This should be treated as fatal error as this API would mostly
+            // be invoked within mbedTLS interface. There is no way for the system
+            // to proceed if the ECC interrupt allocation fails here.
+            abort();
+        }
+    }
+
+    /* Keep the CPU awake and at full speed while the task waits, as MPI does */
+#ifdef CONFIG_PM_ENABLE
+    if (s_pm_cpu_lock == NULL) {
+        if (esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "ecc_sleep", &s_pm_sleep_lock) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create PM sleep lock");
+            return ESP_FAIL;
+        }
+        if (esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "ecc_cpu", &s_pm_cpu_lock) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create PM CPU lock");
+            return ESP_FAIL;
+        }
+    }
+    esp_pm_lock_acquire(s_pm_cpu_lock);
+    esp_pm_lock_acquire(s_pm_sleep_lock);
+#endif
+
+    ecc_ll_clear_interrupt();
+    ecc_ll_enable_interrupt();
+    return ESP_OK;
+}
+#endif /* CONFIG_MBEDTLS_ECC_USE_INTERRUPT */
+
+/* Start the operation set up in the peripheral and wait for its completion. With the interrupt,
+   the calling task blocks, so the CPU is free for other tasks, e.g. the other handshakes of a
+   TLS server which wait for the accelerator. */
+static int esp_ecc_calc(void)
+{
+#if CONFIG_MBEDTLS_ECC_USE_INTERRUPT
+    if (esp_ecc_isr_initialise() != ESP_OK) {
+        return -1;
+    }
+    ecc_hal_start_calc();
+
+    int ret = 0;
+    if (!xSemaphoreTake(op_complete_sem, ECC_WAIT_INTR_TIMEOUT_MS / portTICK_PERIOD_MS)) {
+        ESP_LOGE(TAG, "Timed out waiting for completion of ECC Interrupt");
+        ret = -1;
+    }
+    ecc_ll_disable_interrupt();
+
+#ifdef CONFIG_PM_ENABLE
+    esp_pm_lock_release(s_pm_cpu_lock);
+    esp_pm_lock_release(s_pm_sleep_lock);
+#endif
+    return ret;
+#else
+    ecc_hal_start_calc();
+
+    while (!ecc_hal_is_calc_finished()) {
+        ;
+    }
+    return 0;
+#endif /* CONFIG_MBEDTLS_ECC_USE_INTERRUPT */
+}
+
 static void esp_ecc_acquire_hardware(void)
 {
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    const int64_t wait_start = esp_crypto_accel_stats_wait_start();
     esp_crypto_ecc_lock_acquire();
+    esp_crypto_accel_stats_acquired(ESP_CRYPTO_ACCEL_ECC, wait_start);
+#else
+    esp_crypto_ecc_lock_acquire();
+#endif
 
     ECC_RCC_ATOMIC() {
         ecc_ll_enable_bus_clock(true);
@@ -32,6 +150,9 @@ static void esp_ecc_release_hardware(void)
         ecc_ll_power_down();
     }
 
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    esp_crypto_accel_stats_released(ESP_CRYPTO_ACCEL_ECC);
+#endif
     esp_crypto_ecc_lock_release();
 }
 
@@ -53,18 +174,16 @@ int esp_ecc_point_multiply(const ecc_point_t *point, const uint8_t *scalar, ecc_
     */
     ecc_hal_enable_constant_time_point_mul(true);
 #endif /* SOC_ECC_CONSTANT_TIME_POINT_MUL */
-    ecc_hal_start_calc();
 
     memset(result, 0, sizeof(ecc_point_t));
 
     result->len = len;
 
-    while (!ecc_hal_is_calc_finished()) {
-        ;
+    ret = esp_ecc_calc();
+    if (ret == 0) {
+        ret = ecc_hal_read_mul_result(result->x, result->y, len);
     }
 
-    ret = ecc_hal_read_mul_result(result->x, result->y, len);
-
     esp_ecc_release_hardware();
 
     return ret;
@@ -77,13 +196,9 @@ int esp_ecc_point_verify(const ecc_point_t *point)
     esp_ecc_acquire_hardware();
     ecc_hal_write_verify_param(point->x, point->y, point->len);
     ecc_hal_set_mode(ECC_MODE_VERIFY);
-    ecc_hal_start_calc();
-
-    while (!ecc_hal_is_calc_finished()) {
-        ;
-    }
 
-    result = ecc_hal_read_verify_result();
+    /* A point which can't be checked is reported as not on the curve */
+    result = (esp_ecc_calc() == 0) ? ecc_hal_read_verify_result() : 0;
 
     esp_ecc_release_hardware();
 
@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "esp_crypto_accel_stats.h"
+#include "esp_private/esp_crypto_accel_stats_internal.h"
+
+static esp_crypto_accel_stats_t s_stats[ESP_CRYPTO_ACCEL_MAX];
+/* Time at which the accelerator was acquired, only accessed by the task holding it */
+static int64_t s_busy_start[ESP_CRYPTO_ACCEL_MAX];
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+int64_t esp_crypto_accel_stats_wait_start(void)
+{
+    return esp_timer_get_time();
+}
+
+void esp_crypto_accel_stats_acquired(esp_crypto_accel_t accel, int64_t wait_start)
+{
+    const int64_t now = esp_timer_get_time();
+    const uint32_t wait_time = (uint32_t)(now - wait_start);
+    esp_crypto_accel_stats_t *stats = &s_stats[accel];
+
+    s_busy_start[accel] = now;
+    portENTER_CRITICAL_SAFE(&s_stats_lock);
+    stats->wait_time_us += wait_time;
+    if (wait_time > stats->max_wait_time_us) {
+        stats->max_wait_time_us = wait_time;
+    }
+    portEXIT_CRITICAL_SAFE(&s_stats_lock);
+}
+
+void esp_crypto_accel_stats_released(esp_crypto_accel_t accel)
+{
+    const int64_t busy_time = esp_timer_get_time() - s_busy_start[accel];
+    esp_crypto_accel_stats_t *stats = &s_stats[accel];
+
+    portENTER_CRITICAL_SAFE(&s_stats_lock);
+    stats->op_count++;
+    stats->busy_time_us += busy_time;
+    portEXIT_CRITICAL_SAFE(&s_stats_lock);
+}
+
+void esp_crypto_accel_stats_add_bytes(esp_crypto_accel_t accel, uint32_t bytes)
+{
+    portENTER_CRITICAL_SAFE(&s_stats_lock);
+    s_stats[accel].byte_count += bytes;
+    portEXIT_CRITICAL_SAFE(&s_stats_lock);
+}
+
+esp_err_t esp_crypto_accel_get_stats(esp_crypto_accel_t accel, esp_crypto_accel_stats_t *stats)
+{
+    if ((unsigned)accel >= ESP_CRYPTO_ACCEL_MAX || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL_SAFE(&s_stats_lock);
+    *stats = s_stats[accel];
+    portEXIT_CRITICAL_SAFE(&s_stats_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_crypto_accel_reset_stats(esp_crypto_accel_t accel)
+{
+    if ((unsigned)accel >= ESP_CRYPTO_ACCEL_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL_SAFE(&s_stats_lock);
+    memset(&s_stats[accel], 0, sizeof(esp_crypto_accel_stats_t));
+    portEXIT_CRITICAL_SAFE(&s_stats_lock);
+    return ESP_OK;
+}
@@ -345,6 +345,25 @@ int esp_internal_aes_decrypt( esp_aes_context *ctx, const unsigned char input[16
 /** XTS-AES buffer encryption/decryption */
 int esp_aes_crypt_xts( esp_aes_xts_context *ctx, int mode, size_t length, const unsigned char data_unit[16], const unsigned char *input, unsigned char *output );
 
+/**
+ * \brief          XTS-AES encryption or decryption of consecutive data units of the same size
+ *
+ *                 Gives the same result as calling esp_aes_crypt_xts() for each data unit,
+ *                 but uses two accelerator operations for all of them when \p unit_length
+ *                 is a multiple of 16 bytes.
+ *
+ * \param ctx          The AES XTS context
+ * \param mode         MBEDTLS_AES_ENCRYPT or MBEDTLS_AES_DECRYPT
+ * \param unit_length  Length of each data unit in bytes, at least 16
+ * \param units        Number of data units
+ * \param data_units   Data unit number of each unit
+ * \param input        Input data of all the units, \p unit_length * \p units bytes
+ * \param output       Output data, can be the same buffer as \p input
+ *
+ * \return         \c 0 on success, a negative error code otherwise
+ */
+int esp_aes_crypt_xts_units( esp_aes_xts_context *ctx, int mode, size_t unit_length, size_t units, const unsigned char data_units[][16], const unsigned char *input, unsigned char *output );
+
 /** Deprecated, see esp_aes_internal_decrypt */
 void esp_aes_decrypt( esp_aes_context *ctx, const unsigned char input[16], unsigned char output[16] ) __attribute__((deprecated));
 
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Hardware accelerators with usage statistics
+ */
+typedef enum {
+    ESP_CRYPTO_ACCEL_MPI,   /*!< MPI (RSA) accelerator */
+    ESP_CRYPTO_ACCEL_ECC,   /*!< ECC accelerator */
+    ESP_CRYPTO_ACCEL_SHA,   /*!< SHA accelerator */
+    ESP_CRYPTO_ACCEL_MAX,   /*!< Number of accelerators */
+} esp_crypto_accel_t;
+
+/**
+ * @brief Usage statistics of a hardware accelerator
+ *
+ * The utilization of the accelerator over a period is the increase of busy_time_us divided by the
+ * length of the period. For SHA, the throughput while the accelerator is held is byte_count divided
+ * by busy_time_us.
+ */
+typedef struct {
+    uint32_t op_count;          /*!< Number of times the accelerator was acquired */
+    uint64_t busy_time_us;      /*!< Total time the accelerator was held by a task */
+    uint64_t wait_time_us;      /*!< Total time tasks waited to acquire the accelerator */
+    uint32_t max_wait_time_us;  /*!< Longest time a task waited to acquire the accelerator */
+    uint64_t byte_count;        /*!< Number of bytes processed, only counted for SHA */
+} esp_crypto_accel_stats_t;
+
+/**
+ * @brief Get the usage statistics of a hardware accelerator
+ *
+ * @note Only available if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS is enabled.
+ *
+ * @param accel Accelerator
+ * @param[out] stats Statistics of the accelerator since boot or since the last call of esp_crypto_accel_reset_stats()
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if accel is not valid or stats is NULL
+ */
+esp_err_t esp_crypto_accel_get_stats(esp_crypto_accel_t accel, esp_crypto_accel_stats_t *stats);
+
+/**
+ * @brief Reset the usage statistics of a hardware accelerator
+ *
+ * @param accel Accelerator
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if accel is not valid
+ */
+esp_err_t esp_crypto_accel_reset_stats(esp_crypto_accel_t accel);
+
+#ifdef __cplusplus
+}
+#endif
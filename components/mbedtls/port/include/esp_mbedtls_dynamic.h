@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "mbedtls/ssl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Statistics of the dynamic TX/RX buffers of an SSL context
+ *
+ * Every record sent or received may reallocate a buffer, the counts show how much heap churn
+ * a connection causes.
+ */
+typedef struct {
+    uint32_t tx_alloc_count;    /*!< Number of times the TX buffer was allocated */
+    uint32_t rx_alloc_count;    /*!< Number of times the RX buffer was allocated */
+    uint32_t psram_alloc_count; /*!< Number of these allocations placed in PSRAM */
+    uint32_t alloc_fail_count;  /*!< Number of failed allocations */
+    size_t tx_max_len;          /*!< Largest TX buffer allocated, in bytes */
+    size_t rx_max_len;          /*!< Largest RX buffer allocated, in bytes */
+} esp_mbedtls_dynamic_buffer_stats_t;
+
+/**
+ * @brief Get the dynamic TX/RX buffer statistics of an SSL context
+ *
+ * The statistics are collected from mbedtls_ssl_setup() until mbedtls_ssl_free(), over all the
+ * sessions of the context.
+ *
+ * @note Requires CONFIG_MBEDTLS_DYNAMIC_BUFFER_STATS
+ *
+ * @param ssl SSL context set up with mbedtls_ssl_setup()
+ * @param[out] stats Statistics of the context
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: ssl or stats is NULL
+ *      - ESP_ERR_NOT_FOUND: ssl is not set up
+ */
+esp_err_t esp_mbedtls_dynamic_buffer_get_stats(const mbedtls_ssl_context *ssl, esp_mbedtls_dynamic_buffer_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_crypto_accel_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+
+/**
+ * @brief Get the time at which a task starts waiting for an accelerator
+ */
+int64_t esp_crypto_accel_stats_wait_start(void);
+
+/**
+ * @brief Record that an accelerator was acquired
+ *
+ * @param accel Accelerator
+ * @param wait_start Value returned by esp_crypto_accel_stats_wait_start() before waiting for the accelerator
+ */
+void esp_crypto_accel_stats_acquired(esp_crypto_accel_t accel, int64_t wait_start);
+
+/**
+ * @brief Record that an accelerator is about to be released
+ *
+ * @param accel Accelerator
+ */
+void esp_crypto_accel_stats_released(esp_crypto_accel_t accel);
+
+/**
+ * @brief Record the bytes processed by an accelerator, called by the task holding it
+ *
+ * @param accel Accelerator
+ * @param bytes Number of bytes
+ */
+void esp_crypto_accel_stats_add_bytes(esp_crypto_accel_t accel, uint32_t bytes);
+
+#endif /* CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS */
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,11 +9,13 @@
 #include "soc/soc_caps.h"
 #include "soc/periph_defs.h"
 #include "esp_private/esp_crypto_lock_internal.h"
+#include "esp_private/esp_crypto_accel_stats_internal.h"
 #include "esp_private/periph_ctrl.h"
 
 #include "sha/sha_block.h"
 #include "hal/sha_hal.h"
 #include "hal/sha_ll.h"
+#include "sdkconfig.h"
 
 
 static _lock_t s_sha_lock;
@@ -57,7 +59,13 @@ inline static size_t block_length(esp_sha_type type)
 /* Lock the SHA peripheral and then enable it */
 void esp_sha_acquire_hardware()
 {
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    const int64_t wait_start = esp_crypto_accel_stats_wait_start();
     _lock_acquire(&s_sha_lock); /* Released when releasing hw with esp_sha_release_hardware() */
+    esp_crypto_accel_stats_acquired(ESP_CRYPTO_ACCEL_SHA, wait_start);
+#else
+    _lock_acquire(&s_sha_lock); /* Released when releasing hw with esp_sha_release_hardware() */
+#endif
 
     SHA_RCC_ATOMIC() {
         sha_ll_enable_bus_clock(true);
@@ -72,6 +80,9 @@ void esp_sha_release_hardware()
         sha_ll_enable_bus_clock(false);
     }
 
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    esp_crypto_accel_stats_released(ESP_CRYPTO_ACCEL_SHA);
+#endif
     _lock_release(&s_sha_lock);
 }
 
@@ -79,4 +90,7 @@ void esp_sha_release_hardware()
 void esp_sha_block(esp_sha_type sha_type, const void *data_block, bool is_first_block)
 {
     sha_hal_hash_block(sha_type, data_block, block_length(sha_type) / 4, is_first_block);
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    esp_crypto_accel_stats_add_bytes(ESP_CRYPTO_ACCEL_SHA, block_length(sha_type));
+#endif
 }
@@ -20,6 +20,7 @@
 #include "mbedtls/sha256.h"
 
 #include <string.h>
+#include <sys/param.h>
 
 #if defined(MBEDTLS_SELF_TEST)
 #if defined(MBEDTLS_PLATFORM_C)
@@ -31,6 +32,7 @@
 #endif /* MBEDTLS_SELF_TEST */
 
 #include "sha/sha_dma.h"
+#include "esp_sha_dma_priv.h"
 
 /* Implementation that should never be optimized out by the compiler */
 static void mbedtls_zeroize( void *v, size_t n )
@@ -164,11 +166,16 @@ int mbedtls_sha256_update( mbedtls_sha256_context *ctx, const unsigned char *inp
 
     len = (ilen / 64) * 64;
 
-    if ( len || local_len) {
+    /* Hash long inputs in slices, releasing the accelerator in between so that other users are not blocked */
+    const unsigned char *slice = input;
+    uint32_t remain = len;
+    while ( remain || local_len ) {
+        uint32_t slice_len = MIN(remain, ESP_SHA_DMA_SLICE_SIZE);
+
         esp_sha_acquire_hardware();
         esp_internal_sha_update_state(ctx);
 
-        int ret = esp_sha_dma(ctx->mode, input, len,  ctx->buffer, local_len, ctx->first_block);
+        int ret = esp_sha_dma(ctx->mode, slice, slice_len,  ctx->buffer, local_len, ctx->first_block);
 
         if (ret != 0) {
             esp_sha_release_hardware();
@@ -178,6 +185,10 @@ int mbedtls_sha256_update( mbedtls_sha256_context *ctx, const unsigned char *inp
         esp_sha_read_digest_state(ctx->mode, ctx->state);
 
         esp_sha_release_hardware();
+
+        slice += slice_len;
+        remain -= slice_len;
+        local_len = 0;
     }
 
     if ( ilen > 0 ) {
@@ -26,6 +26,7 @@
 #endif
 
 #include <string.h>
+#include <sys/param.h>
 
 #if defined(MBEDTLS_SELF_TEST)
 #if defined(MBEDTLS_PLATFORM_C)
@@ -37,6 +38,7 @@
 #endif /* MBEDTLS_SELF_TEST */
 
 #include "sha/sha_dma.h"
+#include "esp_sha_dma_priv.h"
 
 /* Implementation that should never be optimized out by the compiler */
 static void mbedtls_zeroize( void *v, size_t n )
@@ -210,7 +212,11 @@ int mbedtls_sha512_update( mbedtls_sha512_context *ctx, const unsigned char *inp
 
     len = (ilen / 128) * 128;
 
-    if ( len || local_len) {
+    /* Hash long inputs in slices, releasing the accelerator in between so that other users are not blocked */
+    const unsigned char *slice = input;
+    unsigned int remain = len;
+    while ( remain || local_len ) {
+        unsigned int slice_len = MIN(remain, ESP_SHA_DMA_SLICE_SIZE);
 
         esp_sha_acquire_hardware();
 
@@ -221,7 +227,7 @@ int mbedtls_sha512_update( mbedtls_sha512_context *ctx, const unsigned char *inp
             return ret;
         }
 
-        ret = esp_internal_sha512_dma_process(ctx, input, len, ctx->buffer, local_len);
+        ret = esp_internal_sha512_dma_process(ctx, slice, slice_len, ctx->buffer, local_len);
 
         if (ret != 0) {
             esp_sha_release_hardware();
@@ -232,6 +238,9 @@ int mbedtls_sha512_update( mbedtls_sha512_context *ctx, const unsigned char *inp
 
         esp_sha_release_hardware();
 
+        slice += slice_len;
+        remain -= slice_len;
+        local_len = 0;
     }
 
 
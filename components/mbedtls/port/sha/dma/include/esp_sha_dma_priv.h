@@ -6,14 +6,29 @@
 
 #pragma once
 
+#include <stdint.h>
 #include "soc/soc_caps.h"
 #include "esp_crypto_dma.h"
 #include "esp_err.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Maximum number of bytes hashed while holding the SHA accelerator
+ *
+ * Longer inputs are hashed in slices, the accelerator is released between them so that other
+ * users of the SHA (and AES) accelerator don't wait for the whole input. The size is a multiple
+ * of the block size of all SHA types.
+ */
+#if CONFIG_MBEDTLS_HARDWARE_SHA_SLICE_SIZE
+#define ESP_SHA_DMA_SLICE_SIZE  ((CONFIG_MBEDTLS_HARDWARE_SHA_SLICE_SIZE + 127) / 128 * 128)
+#else
+#define ESP_SHA_DMA_SLICE_SIZE  UINT32_MAX
+#endif
+
 /**
  * @brief Start the DMA engine
  *
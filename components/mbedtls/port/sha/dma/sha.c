@@ -30,6 +30,7 @@
 #include <sys/lock.h>
 
 #include "esp_private/esp_crypto_lock_internal.h"
+#include "esp_private/esp_crypto_accel_stats_internal.h"
 #include "esp_private/esp_cache_private.h"
 #include "esp_log.h"
 #include "esp_memory_utils.h"
@@ -108,7 +109,13 @@ inline static size_t block_length(esp_sha_type type)
 /* Enable SHA peripheral and then lock it */
 void esp_sha_acquire_hardware()
 {
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    const int64_t wait_start = esp_crypto_accel_stats_wait_start();
     SHA_LOCK(); /* Released when releasing hw with esp_sha_release_hardware() */
+    esp_crypto_accel_stats_acquired(ESP_CRYPTO_ACCEL_SHA, wait_start);
+#else
+    SHA_LOCK(); /* Released when releasing hw with esp_sha_release_hardware() */
+#endif
 
     SHA_RCC_ATOMIC() {
         sha_ll_enable_bus_clock(true);
@@ -132,6 +139,9 @@ void esp_sha_release_hardware()
 #endif
     }
 
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    esp_crypto_accel_stats_released(ESP_CRYPTO_ACCEL_SHA);
+#endif
     SHA_RELEASE();
 }
 
@@ -334,6 +344,10 @@ int esp_sha_dma(esp_sha_type sha_type, const void *input, uint32_t ilen,
         return -1;
     }
 
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+    esp_crypto_accel_stats_add_bytes(ESP_CRYPTO_ACCEL_SHA, ilen + buf_len);
+#endif
+
     /* DMA cannot access memory in flash, hash block by block instead of using DMA */
     if (!s_check_dma_capable(input) && (ilen != 0)) {
         esp_sha_block_mode(sha_type, input, ilen, buf, buf_len, is_first_block);
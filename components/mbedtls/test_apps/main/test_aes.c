@@ -1587,3 +1587,60 @@ TEST_CASE("mbedtls AES stack in PSRAM", "[mbedtls]")
 }
 
 #endif //CONFIG_FREERTOS_TASK_CREATE_ALLOW_EXT_MEM && CONFIG_SPIRAM_USE_MALLOC
+
+#if CONFIG_MBEDTLS_HARDWARE_AES
+#include "aes/esp_aes.h"
+
+TEST_CASE("mbedtls AES-XTS data units batch matches single units", "[aes]")
+{
+    const size_t unit_length = 32;
+    const size_t units = 64;
+    uint8_t key[64];
+    uint8_t (*data_units)[16] = heap_caps_calloc(units, 16, MALLOC_CAP_8BIT);
+    uint8_t *plaintext = heap_caps_malloc(unit_length * units, MALLOC_CAP_8BIT);
+    uint8_t *expected = heap_caps_malloc(unit_length * units, MALLOC_CAP_8BIT);
+    uint8_t *result = heap_caps_malloc(unit_length * units, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(data_units);
+    TEST_ASSERT_NOT_NULL(plaintext);
+    TEST_ASSERT_NOT_NULL(expected);
+    TEST_ASSERT_NOT_NULL(result);
+
+    for (int i = 0; i < sizeof(key); i++) {
+        key[i] = i;
+    }
+    for (int i = 0; i < unit_length * units; i++) {
+        plaintext[i] = i * 7;
+    }
+    // data units numbered by address, as NVS does
+    for (int u = 0; u < units; u++) {
+        uint32_t addr = 0x1000 + u * unit_length;
+        memcpy(data_units[u], &addr, sizeof(addr));
+    }
+
+    for (int keybits = 256; keybits <= 512; keybits += 256) {
+        mbedtls_aes_xts_context ctx;
+        mbedtls_aes_xts_init(&ctx);
+        TEST_ASSERT_EQUAL(0, mbedtls_aes_xts_setkey_enc(&ctx, key, keybits));
+        for (int u = 0; u < units; u++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_xts(&ctx, MBEDTLS_AES_ENCRYPT, unit_length, data_units[u],
+                                                       plaintext + u * unit_length, expected + u * unit_length));
+        }
+        TEST_ASSERT_EQUAL(0, esp_aes_crypt_xts_units(&ctx, MBEDTLS_AES_ENCRYPT, unit_length, units, data_units, plaintext, result));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, result, unit_length * units);
+        mbedtls_aes_xts_free(&ctx);
+
+        mbedtls_aes_xts_init(&ctx);
+        TEST_ASSERT_EQUAL(0, mbedtls_aes_xts_setkey_dec(&ctx, key, keybits));
+        // in place
+        TEST_ASSERT_EQUAL(0, esp_aes_crypt_xts_units(&ctx, MBEDTLS_AES_DECRYPT, unit_length, units, data_units, result, result));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(plaintext, result, unit_length * units);
+        mbedtls_aes_xts_free(&ctx);
+    }
+
+    free(data_units);
+    free(plaintext);
+    free(expected);
+    free(result);
+}
+
+#endif // CONFIG_MBEDTLS_HARDWARE_AES
@@ -3,7 +3,7 @@
  * Focus on testing functionality where we use ESP32 hardware
  * accelerated crypto features.
  *
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -22,6 +22,10 @@
 #include "test_utils.h"
 #include "ccomp_timer.h"
 #include "unity.h"
+#include "sdkconfig.h"
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+#include "esp_crypto_accel_stats.h"
+#endif
 
 /* Note: negative value here so that assert message prints a grep-able
    error hex value (mbedTLS uses -N for error codes) */
@@ -330,4 +334,28 @@ TEST_CASE("mbedtls ECP point verify with SECP256R1", "[mbedtls]")
 {
     test_ecp_verify(MBEDTLS_ECP_DP_SECP256R1, ecc_p256_mul_res_x, ecc_p256_mul_res_y);
 }
+
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS
+TEST_CASE("mbedtls ECP accelerator statistics", "[mbedtls]")
+{
+    esp_crypto_accel_stats_t stats;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_crypto_accel_reset_stats(ESP_CRYPTO_ACCEL_ECC));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_crypto_accel_get_stats(ESP_CRYPTO_ACCEL_ECC, &stats));
+    TEST_ASSERT_EQUAL(0, stats.op_count);
+    TEST_ASSERT_EQUAL(0, stats.busy_time_us);
+
+    test_ecp_verify(MBEDTLS_ECP_DP_SECP256R1, ecc_p256_mul_res_x, ecc_p256_mul_res_y);
+    test_ecp_mul(MBEDTLS_ECP_DP_SECP256R1, ecc_p256_point_x, ecc_p256_point_y, ecc_p256_scalar,
+                 ecc_p256_mul_res_x, ecc_p256_mul_res_y);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_crypto_accel_get_stats(ESP_CRYPTO_ACCEL_ECC, &stats));
+    /* The multiplication may verify the point first */
+    TEST_ASSERT_GREATER_OR_EQUAL(2, stats.op_count);
+    TEST_ASSERT_NOT_EQUAL(0, stats.busy_time_us);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_crypto_accel_get_stats(ESP_CRYPTO_ACCEL_MAX, &stats));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_crypto_accel_get_stats(ESP_CRYPTO_ACCEL_ECC, NULL));
+}
+#endif /* CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS */
 #endif /* CONFIG_MBEDTLS_HARDWARE_ECC */
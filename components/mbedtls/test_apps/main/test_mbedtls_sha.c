@@ -611,3 +611,45 @@ TEST_CASE("mbedtls SHA stack in PSRAM", "[mbedtls]")
 }
 
 #endif //CONFIG_FREERTOS_TASK_CREATE_ALLOW_EXT_MEM && CONFIG_SPIRAM_USE_MALLOC
+
+#if CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS && SOC_SHA_SUPPORT_DMA
+#include "esp_crypto_accel_stats.h"
+
+TEST_CASE("mbedtls SHA256 long input hashed in slices", "[mbedtls]")
+{
+    const size_t SZ = 64 * 1024;
+    const size_t CHUNK = 1024;
+    unsigned char sha256_once[32];
+    unsigned char sha256_chunks[32];
+    esp_crypto_accel_stats_t stats;
+
+    unsigned char *buffer = malloc(SZ);
+    TEST_ASSERT_NOT_NULL(buffer);
+    memset(buffer, 0x55, SZ);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_crypto_accel_reset_stats(ESP_CRYPTO_ACCEL_SHA));
+
+    /* One update call, hashed in slices of CONFIG_MBEDTLS_HARDWARE_SHA_SLICE_SIZE */
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256(buffer, SZ, sha256_once, false));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_crypto_accel_get_stats(ESP_CRYPTO_ACCEL_SHA, &stats));
+    TEST_ASSERT_GREATER_OR_EQUAL(SZ, stats.byte_count);
+#if CONFIG_MBEDTLS_HARDWARE_SHA_SLICE_SIZE
+    TEST_ASSERT_GREATER_OR_EQUAL(SZ / CONFIG_MBEDTLS_HARDWARE_SHA_SLICE_SIZE, stats.op_count);
+#endif
+    TEST_ASSERT_NOT_EQUAL(0, stats.busy_time_us);
+
+    /* Updates shorter than a slice give the same digest */
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_starts(&ctx, false));
+    for (size_t i = 0; i < SZ; i += CHUNK) {
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_update(&ctx, buffer + i, CHUNK));
+    }
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_finish(&ctx, sha256_chunks));
+    mbedtls_sha256_free(&ctx);
+    free(buffer);
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(sha256_chunks, sha256_once, sizeof(sha256_once));
+}
+#endif /* CONFIG_MBEDTLS_HARDWARE_ACCEL_STATS && SOC_SHA_SUPPORT_DMA */
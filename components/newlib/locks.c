@@ -6,7 +6,10 @@
 
 #include <sys/lock.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
 #include <sys/reent.h>
+#include "sdkconfig.h"
 #include "esp_attr.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
@@ -28,10 +31,85 @@
  *   is holding the lock at this time.
  * - Race conditions between lock_close & lock_init (for the same lock)
  *   are the responsibility of the caller.
+ * - With CONFIG_NEWLIB_STDIO_FAST_LOCK, the locks of stdin, stdout and
+ *   stderr are replaced by the lighter stdio locks below.
  */
 
 static portMUX_TYPE lock_init_spinlock = portMUX_INITIALIZER_UNLOCKED;
 
+#if CONFIG_NEWLIB_STDIO_FAST_LOCK
+/* Recursive locks of stdin, stdout and stderr.
+ *
+ * Every printf() or fwrite() call takes the lock of the stream, which is
+ * almost never contended. Taking a free stdio lock only takes an atomic
+ * increment of 'users', a task which finds the lock taken blocks on 'sem'
+ * until the holder hands the lock over in stdio_lock_release(). The holder
+ * only gives 'sem' if another task is waiting, so at most one give is
+ * pending at any time.
+ *
+ * These locks have no priority inheritance.
+ */
+typedef struct {
+    atomic_uint users;          /* Number of tasks holding or waiting for the lock */
+    _Atomic(TaskHandle_t) owner;    /* Only compared to the current task by other tasks */
+    uint32_t depth;             /* Recursion depth of the owner */
+    SemaphoreHandle_t sem;
+    StaticSemaphore_t sem_buf;
+} stdio_lock_t;
+
+static stdio_lock_t s_stdio_locks[3];
+
+static FORCE_INLINE_ATTR bool is_stdio_lock(const void *lock)
+{
+    return lock >= (const void *)&s_stdio_locks[0] && lock < (const void *)&s_stdio_locks[3];
+}
+
+static int IRAM_ATTR stdio_lock_acquire(stdio_lock_t *lock, uint32_t delay)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return 0; /* locking is a no-op before scheduler is up, so this "succeeds" */
+    }
+    if (!xPortCanYield()) {
+        abort(); /* recursive locks make no sense in ISR context */
+    }
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    if (atomic_load_explicit(&lock->owner, memory_order_relaxed) == self) {
+        lock->depth++;
+        return 0;
+    }
+    if (delay == 0) {
+        unsigned int expected = 0;
+        if (!atomic_compare_exchange_strong(&lock->users, &expected, 1)) {
+            return -1;
+        }
+    } else if (atomic_fetch_add(&lock->users, 1) != 0) {
+        /* Only _lock_try_acquire* use a delay other than portMAX_DELAY */
+        xSemaphoreTake(lock->sem, portMAX_DELAY);
+    }
+    atomic_store_explicit(&lock->owner, self, memory_order_relaxed);
+    lock->depth = 1;
+    return 0;
+}
+
+static void IRAM_ATTR stdio_lock_release(stdio_lock_t *lock)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return; /* locking is a no-op before scheduler is up */
+    }
+    assert(atomic_load_explicit(&lock->owner, memory_order_relaxed) == xTaskGetCurrentTaskHandle());
+
+    if (--lock->depth > 0) {
+        return;
+    }
+    atomic_store_explicit(&lock->owner, NULL, memory_order_relaxed);
+    if (atomic_fetch_sub(&lock->users, 1) != 1) {
+        /* Hand the lock over to a waiting task */
+        xSemaphoreGive(lock->sem);
+    }
+}
+#endif // CONFIG_NEWLIB_STDIO_FAST_LOCK
+
 /* Initialize the given lock by allocating a new mutex semaphore
    as the _lock_t value.
 
@@ -93,6 +171,11 @@ void IRAM_ATTR _lock_init_recursive(_lock_t *lock)
 */
 void IRAM_ATTR _lock_close(_lock_t *lock)
 {
+#if CONFIG_NEWLIB_STDIO_FAST_LOCK
+    if (is_stdio_lock(*lock)) {
+        return; /* shared by all standard streams, never deleted */
+    }
+#endif
     portENTER_CRITICAL(&lock_init_spinlock);
     if (*lock) {
         SemaphoreHandle_t h = (SemaphoreHandle_t)(*lock);
@@ -112,6 +195,11 @@ void _lock_close_recursive(_lock_t *lock) __attribute__((alias("_lock_close")));
 */
 static int IRAM_ATTR lock_acquire_generic(_lock_t *lock, uint32_t delay, uint8_t mutex_type)
 {
+#if CONFIG_NEWLIB_STDIO_FAST_LOCK
+    if (is_stdio_lock(*lock)) {
+        return stdio_lock_acquire((stdio_lock_t *)(*lock), delay);
+    }
+#endif
     SemaphoreHandle_t h = (SemaphoreHandle_t)(*lock);
     if (!h) {
         if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
@@ -177,6 +265,12 @@ int IRAM_ATTR _lock_try_acquire_recursive(_lock_t *lock)
 */
 static void IRAM_ATTR lock_release_generic(_lock_t *lock, uint8_t mutex_type)
 {
+#if CONFIG_NEWLIB_STDIO_FAST_LOCK
+    if (is_stdio_lock(*lock)) {
+        stdio_lock_release((stdio_lock_t *)(*lock));
+        return;
+    }
+#endif
     if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
         return; /* locking is a no-op before scheduler is up */
     }
@@ -372,6 +466,13 @@ void esp_newlib_locks_init(void)
     assert(handle == (SemaphoreHandle_t) &s_common_recursive_mutex);
     (void) handle;
 
+#if CONFIG_NEWLIB_STDIO_FAST_LOCK
+    for (size_t i = 0; i < sizeof(s_stdio_locks) / sizeof(s_stdio_locks[0]); i++) {
+        s_stdio_locks[i].sem = xSemaphoreCreateBinaryStatic(&s_stdio_locks[i].sem_buf);
+        assert(s_stdio_locks[i].sem != NULL);
+    }
+#endif
+
     /* Chip ROMs are built with older versions of newlib, and rely on different lock variables.
      * Initialize these locks to the same values.
      */
@@ -405,3 +506,25 @@ void esp_newlib_locks_init(void)
 #error Unsupported target
 #endif
 }
+
+void esp_newlib_locks_init_stdio(void)
+{
+#if CONFIG_NEWLIB_STDIO_FAST_LOCK
+    FILE *streams[] = {
+        _REENT_STDIN(_GLOBAL_REENT),
+        _REENT_STDOUT(_GLOBAL_REENT),
+        _REENT_STDERR(_GLOBAL_REENT),
+    };
+    _Static_assert(sizeof(streams) / sizeof(streams[0]) == sizeof(s_stdio_locks) / sizeof(s_stdio_locks[0]),
+                   "One stdio lock per standard stream");
+
+    for (size_t i = 0; i < sizeof(streams) / sizeof(streams[0]); i++) {
+        if (streams[i] == NULL || is_stdio_lock(streams[i]->_lock)) {
+            continue;
+        }
+        /* Called before the scheduler starts, so no one holds the lock replaced here */
+        __lock_close_recursive(streams[i]->_lock);
+        streams[i]->_lock = (_LOCK_T) &s_stdio_locks[i];
+    }
+#endif
+}
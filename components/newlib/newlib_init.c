@@ -196,6 +196,7 @@ void esp_newlib_init_global_stdio(const char *stdio_dev)
         __swsetup_r(_GLOBAL_REENT, _REENT_STDERR(_GLOBAL_REENT));
 #endif /* ESP_ROM_NEEDS_SWSETUP_WORKAROUND */
     }
+    esp_newlib_locks_init_stdio();
 }
 
 ESP_SYSTEM_INIT_FN(init_newlib_stdio, CORE, BIT(0), 115)
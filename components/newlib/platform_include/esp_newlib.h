@@ -71,6 +71,15 @@ void esp_sync_timekeeping_timers(void);
  */
 void esp_newlib_locks_init(void);
 
+/**
+ * Replace the locks of stdin, stdout and stderr of the global reent structure
+ * by the lightweight stdio locks, if CONFIG_NEWLIB_STDIO_FAST_LOCK is enabled.
+ *
+ * Called by esp_newlib_init_global_stdio(), not intended to be called from
+ * application code.
+ */
+void esp_newlib_locks_init_stdio(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,13 +6,13 @@
 #include <stdint.h>
 #include <time.h>
 #include <sys/time.h>
-#include <sys/lock.h>
 
 #include "esp_attr.h"
 #include "esp_system.h"
 
 #include "soc/rtc.h"
 #include "esp_rom_sys.h"
+#include "freertos/FreeRTOS.h"
 
 #include "esp_private/system_internal.h"
 #include "esp_private/esp_clk.h"
@@ -63,7 +63,14 @@ int64_t s_microseconds_offset = 0;
 static uint64_t s_boot_time; // when RTC is used to persist time, two RTC_STORE registers are used to store boot time instead
 #endif
 
-static _lock_t s_boot_time_lock;
+/*
+ * The boot time is read on every gettimeofday() call, so it is protected by a sequence counter instead of a lock.
+ * The counter is odd while the boot time is being written, and readers retry until they read the same even value
+ * before and after reading the boot time. The writers are serialized by a spinlock, and write within a critical
+ * section, so a reader can't preempt a writer on its own core and spin forever.
+ */
+static portMUX_TYPE s_boot_time_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t s_boot_time_seq;
 
 #if defined( CONFIG_ESP_TIME_FUNCS_USE_ESP_TIMER ) || defined( CONFIG_ESP_TIME_FUNCS_USE_RTC_TIMER )
 uint64_t esp_time_impl_get_time_since_boot(void)
@@ -97,26 +104,34 @@ uint64_t esp_time_impl_get_time(void)
 
 void esp_time_impl_set_boot_time(uint64_t time_us)
 {
-    _lock_acquire(&s_boot_time_lock);
+    portENTER_CRITICAL_SAFE(&s_boot_time_lock);
+    s_boot_time_seq++;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
 #ifdef CONFIG_ESP_TIME_FUNCS_USE_RTC_TIMER
     REG_WRITE(RTC_BOOT_TIME_LOW_REG, (uint32_t)(time_us & 0xffffffff));
     REG_WRITE(RTC_BOOT_TIME_HIGH_REG, (uint32_t)(time_us >> 32));
 #else
     s_boot_time = time_us;
 #endif
-    _lock_release(&s_boot_time_lock);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    s_boot_time_seq++;
+    portEXIT_CRITICAL_SAFE(&s_boot_time_lock);
 }
 
 uint64_t esp_time_impl_get_boot_time(void)
 {
     uint64_t result;
-    _lock_acquire(&s_boot_time_lock);
+    uint32_t seq;
+    do {
+        seq = s_boot_time_seq;
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
 #ifdef CONFIG_ESP_TIME_FUNCS_USE_RTC_TIMER
-    result = ((uint64_t) REG_READ(RTC_BOOT_TIME_LOW_REG)) + (((uint64_t) REG_READ(RTC_BOOT_TIME_HIGH_REG)) << 32);
+        result = ((uint64_t) REG_READ(RTC_BOOT_TIME_LOW_REG)) + (((uint64_t) REG_READ(RTC_BOOT_TIME_HIGH_REG)) << 32);
 #else
-    result = s_boot_time;
+        result = s_boot_time;
 #endif
-    _lock_release(&s_boot_time_lock);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    } while ((seq & 1) || seq != s_boot_time_seq);
     return result;
 }
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
@@ -111,4 +111,11 @@ TEST_CASE("Retargetable dynamic recursive locks", "[newlib_locks]")
     __lock_close_recursive(lock);
 }
 
+TEST_CASE("Retargetable locks of standard streams", "[newlib_locks]")
+{
+    /* With CONFIG_NEWLIB_STDIO_FAST_LOCK, these are not FreeRTOS mutexes */
+    test_inner_recursive(stdout->_lock);
+    test_inner_recursive(stderr->_lock);
+}
+
 #endif // _RETARGETABLE_LOCKING
@@ -254,6 +254,47 @@ TEST_CASE("test for no interlocking adjtime, gettimeofday and settimeofday funct
     }
 }
 
+#ifndef CONFIG_FREERTOS_UNICORE
+// the two values differ in both halves, a torn read of the boot time gives neither of them
+#define BOOT_TIME_A 0x00000000ffffffffULL
+#define BOOT_TIME_B 0x0000000100000000ULL
+
+static void set_boot_time_task(void *arg)
+{
+    SemaphoreHandle_t *sema = (SemaphoreHandle_t *) arg;
+    while (exit_flag == false) {
+        esp_time_impl_set_boot_time(BOOT_TIME_A);
+        esp_time_impl_set_boot_time(BOOT_TIME_B);
+    }
+    xSemaphoreGive(*sema);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("boot time read without lock is never torn", "[newlib]")
+{
+    uint64_t boot_time_saved = esp_time_impl_get_boot_time();
+
+    exit_flag = false;
+    SemaphoreHandle_t exit_sema = xSemaphoreCreateBinary();
+    xTaskCreatePinnedToCore(set_boot_time_task, "set_boot_time", 2048, &exit_sema, UNITY_FREERTOS_PRIORITY - 1, NULL, 1);
+
+    int torn_reads = 0;
+    for (int i = 0; i < 1000000 && torn_reads == 0; i++) {
+        uint64_t boot_time = esp_time_impl_get_boot_time();
+        if (boot_time != BOOT_TIME_A && boot_time != BOOT_TIME_B && boot_time != boot_time_saved) {
+            torn_reads++;
+        }
+    }
+
+    // Stop the writer before checking, it must not outlive the test
+    exit_flag = true;
+    TEST_ASSERT_TRUE(xSemaphoreTake(exit_sema, 2000 / portTICK_PERIOD_MS));
+    vSemaphoreDelete(exit_sema);
+    esp_time_impl_set_boot_time(boot_time_saved);
+    TEST_ASSERT_EQUAL_MESSAGE(0, torn_reads, "torn boot time read");
+}
+#endif
+
 #ifndef CONFIG_FREERTOS_UNICORE
 #define ADJTIME_CORRECTION_FACTOR 6
 
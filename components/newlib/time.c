@@ -6,6 +6,7 @@
 
 #include <errno.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <time.h>
 #include <limits.h>
 #include <reent.h>
@@ -40,11 +41,20 @@
 
 // stores the start time of the slew
 static uint64_t s_adjtime_start_us;
+// whether s_adjtime_start_us is not 0, it can be read without the lock unlike the 64-bit start time
+static bool s_adjtime_in_progress;
 // is how many microseconds total to slew
 static int64_t  s_adjtime_total_correction_us;
 
 static _lock_t s_time_lock;
 
+// Set the start time of the slew, s_time_lock must be taken
+static inline void adjtime_set_start_us(uint64_t start_us)
+{
+    s_adjtime_start_us = start_us;
+    __atomic_store_n(&s_adjtime_in_progress, start_us != 0, __ATOMIC_RELEASE);
+}
+
 // This function gradually changes boot_time to the correction value and immediately updates it.
 static uint64_t adjust_boot_time(void)
 {
@@ -52,7 +62,7 @@ static uint64_t adjust_boot_time(void)
 
     uint64_t boot_time = esp_time_impl_get_boot_time();
     if ((boot_time == 0) || (esp_time_impl_get_time_since_boot() < s_adjtime_start_us)) {
-        s_adjtime_start_us = 0;
+        adjtime_set_start_us(0);
     }
     if (s_adjtime_start_us > 0) {
         uint64_t since_boot = esp_time_impl_get_time_since_boot();
@@ -62,11 +72,11 @@ static uint64_t adjust_boot_time(void)
         // Example: if the time error is 1 second, then it will be compensate for 1 sec / 0,015625 = 64 seconds.
         int64_t correction = (since_boot >> ADJTIME_CORRECTION_FACTOR) - (s_adjtime_start_us >> ADJTIME_CORRECTION_FACTOR);
         if (correction > 0) {
-            s_adjtime_start_us = since_boot;
+            adjtime_set_start_us(since_boot);
             if (s_adjtime_total_correction_us < 0) {
                 if ((s_adjtime_total_correction_us + correction) >= 0) {
                     boot_time = boot_time + s_adjtime_total_correction_us;
-                    s_adjtime_start_us = 0;
+                    adjtime_set_start_us(0);
                 } else {
                     s_adjtime_total_correction_us += correction;
                     boot_time -= correction;
@@ -74,7 +84,7 @@ static uint64_t adjust_boot_time(void)
             } else {
                 if ((s_adjtime_total_correction_us - correction) <= 0) {
                     boot_time = boot_time + s_adjtime_total_correction_us;
-                    s_adjtime_start_us = 0;
+                    adjtime_set_start_us(0);
                 } else {
                     s_adjtime_total_correction_us -= correction;
                     boot_time += correction;
@@ -89,6 +99,12 @@ static uint64_t adjust_boot_time(void)
 // Get the adjusted boot time.
 static uint64_t get_adjusted_boot_time(void)
 {
+    // Without an adjtime() correction in progress the boot time doesn't change, it is read without taking the lock.
+    // A correction started concurrently is applied by the next call. The slew itself is only read and updated
+    // under the lock.
+    if (!__atomic_load_n(&s_adjtime_in_progress, __ATOMIC_ACQUIRE)) {
+        return esp_time_impl_get_boot_time();
+    }
     _lock_acquire(&s_time_lock);
     uint64_t adjust_time = adjust_boot_time();
     _lock_release(&s_time_lock);
@@ -101,7 +117,7 @@ static void adjtime_corr_stop(void)
     _lock_acquire(&s_time_lock);
     if (s_adjtime_start_us != 0) {
         adjust_boot_time();
-        s_adjtime_start_us = 0;
+        adjtime_set_start_us(0);
     }
     _lock_release(&s_time_lock);
 }
@@ -141,7 +157,7 @@ WEAK_UNLESS_TIMEFUNC_IMPL int adjtime(const struct timeval *delta, struct timeva
         _lock_acquire(&s_time_lock);
         // If correction is already in progress (s_adjtime_start_time_us != 0), then apply accumulated corrections.
         adjust_boot_time();
-        s_adjtime_start_us = esp_time_impl_get_time_since_boot();
+        adjtime_set_start_us(esp_time_impl_get_time_since_boot());
         s_adjtime_total_correction_us = sec * 1000000L + usec;
         _lock_release(&s_time_lock);
     }
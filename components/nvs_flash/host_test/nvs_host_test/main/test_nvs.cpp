@@ -17,6 +17,8 @@
 #include <string.h>
 #include <string>
 #include <random>
+#include <vector>
+#include <algorithm>
 #include "test_fixtures.hpp"
 #include "spi_flash_mmap.h"
 
@@ -1920,6 +1922,159 @@ TEST_CASE("Check that orphaned blobs are erased during init", "[nvs]")
     TEST_ESP_OK(storage.writeItem(1, nvs::ItemType::BLOB, "key3", blob, sizeof(blob)));
 }
 
+TEST_CASE("Streamed blobs can be written in parts and read at an offset", "[nvs]")
+{
+    const size_t blob_size = nvs::Page::CHUNK_MAX_SIZE * 3;
+    uint8_t blob[blob_size];
+    uint8_t blob_read[blob_size];
+    PartitionEmulationFixture f(0, 6);
+    TEST_ESP_OK(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), 0, 6));
+    for (size_t i = 0; i < blob_size; i++) {
+        blob[i] = i * 7;
+    }
+    nvs_handle_t handle;
+    TEST_ESP_OK(nvs_open("test", NVS_READWRITE, &handle));
+    TEST_ESP_OK(nvs_set_i32(handle, "int", 42));
+
+    nvs_blob_writer_t writer;
+    TEST_ESP_OK(nvs_blob_writer_open(handle, "abc", &writer));
+    for (size_t offset = 0; offset < blob_size; offset += 999) {
+        TEST_ESP_OK(nvs_blob_writer_write(writer, blob + offset, std::min<size_t>(999, blob_size - offset)));
+    }
+    TEST_ESP_OK(nvs_blob_writer_close(writer));
+
+    size_t read_size = blob_size;
+    TEST_ESP_OK(nvs_get_blob(handle, "abc", blob_read, &read_size));
+    CHECK(read_size == blob_size);
+    CHECK(memcmp(blob, blob_read, blob_size) == 0);
+
+    // parts crossing the chunk boundaries
+    const size_t offsets[] = {0, 1, nvs::Page::CHUNK_MAX_SIZE - 10, nvs::Page::CHUNK_MAX_SIZE * 2 + 5};
+    for (size_t offset : offsets) {
+        memset(blob_read, 0xee, blob_size);
+        read_size = 100;
+        TEST_ESP_OK(nvs_get_blob_at(handle, "abc", offset, blob_read, &read_size));
+        CHECK(read_size == 100);
+        CHECK(memcmp(blob + offset, blob_read, read_size) == 0);
+    }
+
+    // the length is trimmed at the end of the blob
+    read_size = 100;
+    TEST_ESP_OK(nvs_get_blob_at(handle, "abc", blob_size - 30, blob_read, &read_size));
+    CHECK(read_size == 30);
+    CHECK(memcmp(blob + blob_size - 30, blob_read, read_size) == 0);
+    TEST_ESP_ERR(nvs_get_blob_at(handle, "abc", blob_size + 1, blob_read, &read_size), ESP_ERR_NVS_INVALID_LENGTH);
+
+    // a single page blob is read at an offset as well
+    TEST_ESP_OK(nvs_set_blob(handle, "small", blob, 64));
+    read_size = 16;
+    TEST_ESP_OK(nvs_get_blob_at(handle, "small", 40, blob_read, &read_size));
+    CHECK(read_size == 16);
+    CHECK(memcmp(blob + 40, blob_read, read_size) == 0);
+    TEST_ESP_ERR(nvs_get_blob_at(handle, "missing", 0, blob_read, &read_size), ESP_ERR_NVS_NOT_FOUND);
+
+    int32_t value;
+    TEST_ESP_OK(nvs_get_i32(handle, "int", &value));
+    CHECK(value == 42);
+    nvs_close(handle);
+
+    TEST_ESP_OK(nvs_flash_deinit_partition(f.part()->get_partition_name()));
+}
+
+TEST_CASE("Streamed blob replaces the previous value when it is closed", "[nvs]")
+{
+    const size_t blob_size = nvs::Page::CHUNK_MAX_SIZE * 2;
+    uint8_t blob[blob_size];
+    uint8_t blob2[blob_size];
+    uint8_t blob_read[blob_size];
+    PartitionEmulationFixture f(0, 6);
+    TEST_ESP_OK(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), 0, 6));
+    memset(blob, 0x11, blob_size);
+    memset(blob2, 0x22, blob_size);
+    nvs_handle_t handle;
+    TEST_ESP_OK(nvs_open("test", NVS_READWRITE, &handle));
+    TEST_ESP_OK(nvs_set_blob(handle, "abc", blob, blob_size));
+
+    // the old value stays readable while the new one is written, and is kept if the writer is aborted
+    nvs_blob_writer_t writer;
+    TEST_ESP_OK(nvs_blob_writer_open(handle, "abc", &writer));
+    TEST_ESP_OK(nvs_blob_writer_write(writer, blob2, blob_size));
+    size_t read_size = blob_size;
+    TEST_ESP_OK(nvs_get_blob(handle, "abc", blob_read, &read_size));
+    CHECK(memcmp(blob, blob_read, blob_size) == 0);
+    nvs_blob_writer_abort(writer);
+    read_size = blob_size;
+    TEST_ESP_OK(nvs_get_blob(handle, "abc", blob_read, &read_size));
+    CHECK(memcmp(blob, blob_read, blob_size) == 0);
+
+    TEST_ESP_OK(nvs_blob_writer_open(handle, "abc", &writer));
+    TEST_ESP_OK(nvs_blob_writer_write(writer, blob2, blob_size));
+    TEST_ESP_OK(nvs_blob_writer_close(writer));
+    read_size = blob_size;
+    TEST_ESP_OK(nvs_get_blob(handle, "abc", blob_read, &read_size));
+    CHECK(memcmp(blob2, blob_read, blob_size) == 0);
+
+    // the blob survives a reinit, and the previous version is erased
+    nvs_close(handle);
+    TEST_ESP_OK(nvs_flash_deinit_partition(f.part()->get_partition_name()));
+    TEST_ESP_OK(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), 0, 6));
+    TEST_ESP_OK(nvs_open("test", NVS_READWRITE, &handle));
+    read_size = blob_size;
+    TEST_ESP_OK(nvs_get_blob(handle, "abc", blob_read, &read_size));
+    CHECK(memcmp(blob2, blob_read, blob_size) == 0);
+
+    // an empty value
+    TEST_ESP_OK(nvs_blob_writer_open(handle, "abc", &writer));
+    TEST_ESP_OK(nvs_blob_writer_close(writer));
+    read_size = blob_size;
+    TEST_ESP_OK(nvs_get_blob(handle, "abc", blob_read, &read_size));
+    CHECK(read_size == 0);
+    nvs_close(handle);
+
+    TEST_ESP_OK(nvs_flash_deinit_partition(f.part()->get_partition_name()));
+}
+
+TEST_CASE("Streamed blob write failures are handled", "[nvs]")
+{
+    const size_t blob_size = nvs::Page::CHUNK_MAX_SIZE;
+    uint8_t blob[blob_size] = {0x11};
+    uint8_t blob_read[blob_size];
+    PartitionEmulationFixture f(0, 5);
+    TEST_ESP_OK(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), 0, 5));
+    nvs_handle_t handle;
+    TEST_ESP_OK(nvs_open("test", NVS_READONLY, &handle));
+    nvs_blob_writer_t writer;
+    TEST_ESP_ERR(nvs_blob_writer_open(handle, "abc", &writer), ESP_ERR_NVS_READ_ONLY);
+    nvs_close(handle);
+
+    TEST_ESP_OK(nvs_open("test", NVS_READWRITE, &handle));
+    TEST_ESP_ERR(nvs_blob_writer_open(handle, "this_key_is_too_long", &writer), ESP_ERR_NVS_KEY_TOO_LONG);
+    TEST_ESP_OK(nvs_set_blob(handle, "abc", blob, blob_size / 2));
+
+    // at most 4 pages of 5 hold a blob
+    std::vector<uint8_t> big(nvs::Page::CHUNK_MAX_SIZE * 4 + 1, 0x22);
+    TEST_ESP_OK(nvs_blob_writer_open(handle, "abc", &writer));
+    TEST_ESP_OK(nvs_blob_writer_write(writer, blob, blob_size));
+    TEST_ESP_ERR(nvs_blob_writer_write(writer, big.data(), big.size() - blob_size), ESP_ERR_NVS_VALUE_TOO_LONG);
+    TEST_ESP_ERR(nvs_blob_writer_write(writer, blob, 1), ESP_ERR_NVS_INVALID_STATE);
+    TEST_ESP_ERR(nvs_blob_writer_close(writer), ESP_ERR_NVS_INVALID_STATE);
+
+    size_t read_size = blob_size;
+    TEST_ESP_OK(nvs_get_blob(handle, "abc", blob_read, &read_size));
+    CHECK(read_size == blob_size / 2);
+    CHECK(memcmp(blob, blob_read, read_size) == 0);
+
+    // the space of the discarded chunks is available again
+    TEST_ESP_OK(nvs_set_blob(handle, "abc2", blob, blob_size));
+
+    TEST_ESP_OK(nvs_begin_transaction(handle));
+    TEST_ESP_ERR(nvs_blob_writer_open(handle, "abc", &writer), ESP_ERR_NVS_INVALID_STATE);
+    TEST_ESP_OK(nvs_abort_transaction(handle));
+    nvs_close(handle);
+
+    TEST_ESP_OK(nvs_flash_deinit_partition(f.part()->get_partition_name()));
+}
+
 TEST_CASE("nvs blob fragmentation test", "[nvs]")
 {
     PartitionEmulationFixture f(0, 4);
@@ -3895,6 +4050,33 @@ TEST_CASE("nvs find key tests", "[nvs]")
     nvs_close(handle_2);
     TEST_ESP_OK(nvs_flash_deinit_partition(NVS_DEFAULT_PART_NAME));
 }
+TEST_CASE("benchmark item updates with SPI NOR timing", "[nvs][benchmark]")
+{
+    PartitionEmulationFixture f(0, 8);
+    nvs::Storage storage(f.part());
+    TEST_ESP_OK(storage.init(0, 8));
+
+    esp_partition_timing_model_t model = ESP_PARTITION_TIMING_MODEL_SPI_NOR_DEFAULT();
+    esp_partition_set_timing_model(&model);
+    esp_partition_clear_stats();
+
+    const size_t updates = nvs::Page::ENTRY_COUNT * 8 * 2;
+    for (size_t i = 0; i < updates; ++i) {
+        TEST_ESP_OK(storage.writeItem(1, "i", static_cast<int>(i)));
+    }
+
+    esp_partition_stats_t stats;
+    esp_partition_get_stats(&stats);
+    esp_partition_set_timing_model(NULL);
+    s_perf << "[Benchmark][nvs_item_update]: iterations=" << updates << " read_ops=" << stats.read_ops << " write_ops=" << stats.write_ops
+           << " erase_ops=" << stats.erase_ops << " read_bytes=" << stats.read_bytes << " write_bytes=" << stats.write_bytes
+           << " read_us=" << stats.read_time_us << " write_us=" << stats.write_time_us << " erase_us=" << stats.erase_time_us << std::endl;
+
+    // Each update writes one entry and marks the previous one erased, pages are only erased once full
+    CHECK(stats.erase_ops <= updates / nvs::Page::ENTRY_COUNT + 8);
+    CHECK(stats.write_bytes < updates * nvs::Page::ENTRY_SIZE * 2);
+}
+
 /* Add new tests above */
 /* This test has to be the final one */
 
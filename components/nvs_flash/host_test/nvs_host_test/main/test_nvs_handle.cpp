@@ -266,3 +266,103 @@ TEST_CASE("NVSHandleSimple correctly sets/gets char enum", "[partition_mgr]")
 
     REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition(NVS_DEFAULT_PART_NAME) == ESP_OK);
 }
+
+TEST_CASE("NVSHandleSimple transaction stages changes until commit", "[partition_mgr]")
+{
+    PartitionEmulationFixture f(0, 10);
+
+    const uint32_t NVS_FLASH_SECTOR = 6;
+    const uint32_t NVS_FLASH_SECTOR_COUNT_MIN = 3;
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT_MIN)
+            == ESP_OK);
+
+    nvs::NVSHandleSimple *handle;
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->open_handle(NVS_DEFAULT_PART_NAME, "ns_1", NVS_READWRITE, &handle) == ESP_OK);
+    nvs::NVSHandleSimple *reader;
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->open_handle(NVS_DEFAULT_PART_NAME, "ns_1", NVS_READONLY, &reader) == ESP_OK);
+
+    CHECK(handle->set_item("erased", 1) == ESP_OK);
+    CHECK(handle->set_item("counter", 1) == ESP_OK);
+
+    CHECK(handle->begin_transaction() == ESP_OK);
+    CHECK(handle->begin_transaction() == ESP_ERR_NVS_INVALID_STATE);
+    CHECK(reader->begin_transaction() == ESP_ERR_NVS_READ_ONLY);
+
+    CHECK(handle->set_item("counter", 2) == ESP_OK);
+    CHECK(handle->set_item("counter", 3) == ESP_OK);
+    CHECK(handle->set_string("str", "staged") == ESP_OK);
+    CHECK(handle->erase_item("erased") == ESP_OK);
+    CHECK(handle->erase_item("missing") == ESP_ERR_NVS_NOT_FOUND);
+    CHECK(handle->erase_all() == ESP_ERR_NVS_INVALID_STATE);
+
+    // the transaction's own handle sees the staged values, other handles don't
+    int value = 0;
+    CHECK(handle->get_item("counter", value) == ESP_OK);
+    CHECK(value == 3);
+    CHECK(handle->get_item("erased", value) == ESP_ERR_NVS_NOT_FOUND);
+    size_t size = 0;
+    CHECK(handle->get_item_size(nvs::ItemType::SZ, "str", size) == ESP_OK);
+    CHECK(size == strlen("staged") + 1);
+    CHECK(reader->get_item("counter", value) == ESP_OK);
+    CHECK(value == 1);
+    CHECK(reader->get_item("erased", value) == ESP_OK);
+
+    CHECK(handle->commit() == ESP_OK);
+
+    CHECK(reader->get_item("counter", value) == ESP_OK);
+    CHECK(value == 3);
+    CHECK(reader->get_item("erased", value) == ESP_ERR_NVS_NOT_FOUND);
+    char str[16];
+    CHECK(reader->get_string("str", str, sizeof(str)) == ESP_OK);
+    CHECK(strcmp(str, "staged") == 0);
+
+    // aborted changes are discarded
+    CHECK(handle->abort_transaction() == ESP_ERR_NVS_INVALID_STATE);
+    CHECK(handle->begin_transaction() == ESP_OK);
+    CHECK(handle->set_item("counter", 4) == ESP_OK);
+    CHECK(handle->abort_transaction() == ESP_OK);
+    CHECK(handle->get_item("counter", value) == ESP_OK);
+    CHECK(value == 3);
+
+    delete reader;
+    delete handle;
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition(NVS_DEFAULT_PART_NAME) == ESP_OK);
+}
+
+TEST_CASE("NVSHandleSimple transaction which doesn't fit leaves storage unchanged", "[partition_mgr]")
+{
+    PartitionEmulationFixture f(0, 10);
+
+    const uint32_t NVS_FLASH_SECTOR = 6;
+    const uint32_t NVS_FLASH_SECTOR_COUNT_MIN = 3;
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT_MIN)
+            == ESP_OK);
+
+    nvs::NVSHandleSimple *handle;
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->open_handle(NVS_DEFAULT_PART_NAME, "ns_1", NVS_READWRITE, &handle) == ESP_OK);
+
+    CHECK(handle->set_item("counter", 1) == ESP_OK);
+
+    // three blobs of 3000 bytes each can't fit into the two usable pages at once
+    uint8_t blob[3000];
+    memset(blob, 0xab, sizeof(blob));
+    CHECK(handle->begin_transaction() == ESP_OK);
+    CHECK(handle->set_item("counter", 2) == ESP_OK);
+    CHECK(handle->set_blob("blob_1", blob, sizeof(blob)) == ESP_OK);
+    CHECK(handle->set_blob("blob_2", blob, sizeof(blob)) == ESP_OK);
+    CHECK(handle->set_blob("blob_3", blob, sizeof(blob)) == ESP_OK);
+    CHECK(handle->commit() == ESP_ERR_NVS_NOT_ENOUGH_SPACE);
+
+    int value = 0;
+    CHECK(handle->get_item("counter", value) == ESP_OK);
+    CHECK(value == 1);
+    size_t size = 0;
+    CHECK(handle->get_item_size(nvs::ItemType::BLOB, "blob_1", size) == ESP_ERR_NVS_NOT_FOUND);
+
+    delete handle;
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition(NVS_DEFAULT_PART_NAME) == ESP_OK);
+}
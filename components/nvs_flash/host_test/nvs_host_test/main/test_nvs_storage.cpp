@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -43,3 +43,177 @@ TEST_CASE("Storage iterator recognizes blob with VerOffset::VER_1_OFFSET", "[nvs
 
     REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition("test") == ESP_OK);
 }
+
+TEST_CASE("Storage finds items on all pages after page compaction", "[nvs_storage]")
+{
+    const uint32_t NVS_FLASH_SECTOR = 6;
+    const uint32_t NVS_FLASH_SECTOR_COUNT_MIN = 4;
+    PartitionEmulationFixture f(0, 10, "test");
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT_MIN)
+            == ESP_OK);
+
+    nvs::Storage *storage = nvs::NVSPartitionManager::get_instance()->lookup_storage_from_name("test");
+    uint8_t ns_index;
+    REQUIRE(storage->createOrOpenNamespace("test_ns", true, ns_index) == ESP_OK);
+
+    const size_t KEY_COUNT = 150;
+    char key[16];
+    uint8_t blob[100];
+
+    // rewriting all keys several times moves items between pages and provokes page compaction
+    for (uint32_t round = 0; round < 5; ++round) {
+        for (uint32_t i = 0; i < KEY_COUNT; ++i) {
+            snprintf(key, sizeof(key), "key_%03u", (unsigned) i);
+            CHECK(storage->writeItem(ns_index, key, round * 1000 + i) == ESP_OK);
+        }
+        std::fill_n(blob, sizeof(blob), static_cast<uint8_t>(round));
+        CHECK(storage->writeItem(ns_index, nvs::ItemType::BLOB, "blob", blob, sizeof(blob)) == ESP_OK);
+    }
+
+    for (uint32_t i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "key_%03u", (unsigned) i);
+        uint32_t value = 0;
+        CHECK(storage->readItem(ns_index, key, value) == ESP_OK);
+        CHECK(value == 4000 + i);
+    }
+    uint8_t blob_read[sizeof(blob)];
+    CHECK(storage->readItem(ns_index, nvs::ItemType::BLOB, "blob", blob_read, sizeof(blob_read)) == ESP_OK);
+    CHECK(memcmp(blob, blob_read, sizeof(blob)) == 0);
+
+    uint32_t value = 0;
+    CHECK(storage->readItem(ns_index, "missing", value) == ESP_ERR_NVS_NOT_FOUND);
+
+    for (uint32_t i = 0; i < KEY_COUNT; i += 2) {
+        snprintf(key, sizeof(key), "key_%03u", (unsigned) i);
+        CHECK(storage->eraseItem(ns_index, key) == ESP_OK);
+    }
+    for (uint32_t i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "key_%03u", (unsigned) i);
+        CHECK(storage->readItem(ns_index, key, value) == ((i % 2) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND));
+    }
+
+    CHECK(storage->eraseNamespace(ns_index) == ESP_OK);
+    CHECK(storage->readItem(ns_index, "key_001", value) == ESP_ERR_NVS_NOT_FOUND);
+    CHECK(storage->readItem(ns_index, nvs::ItemType::BLOB, "blob", blob_read, sizeof(blob_read)) == ESP_ERR_NVS_NOT_FOUND);
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition("test") == ESP_OK);
+}
+
+TEST_CASE("Storage compacts pages ahead of writes when collecting garbage", "[nvs_storage]")
+{
+    const uint32_t NVS_FLASH_SECTOR = 6;
+    const uint32_t NVS_FLASH_SECTOR_COUNT_MIN = 4;
+    PartitionEmulationFixture f(0, 10, "test");
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT_MIN)
+            == ESP_OK);
+
+    nvs::Storage *storage = nvs::NVSPartitionManager::get_instance()->lookup_storage_from_name("test");
+    uint8_t ns_index;
+    REQUIRE(storage->createOrOpenNamespace("test_ns", true, ns_index) == ESP_OK);
+
+    // nothing to do on a fresh partition
+    bool compacted = true;
+    CHECK(storage->collectGarbage(16, compacted) == ESP_OK);
+    CHECK(compacted == false);
+
+    const size_t KEY_COUNT = 50;
+    char key[16];
+    size_t compactions = 0;
+    for (uint32_t round = 0; round < 20; ++round) {
+        for (uint32_t i = 0; i < KEY_COUNT; ++i) {
+            snprintf(key, sizeof(key), "key_%02u", (unsigned) i);
+            REQUIRE(storage->writeItem(ns_index, key, round * 1000 + i) == ESP_OK);
+
+            REQUIRE(storage->collectGarbage(16, compacted) == ESP_OK);
+            if (compacted) {
+                ++compactions;
+                // the page just compacted provides enough space, no second compaction is due
+                CHECK(storage->collectGarbage(16, compacted) == ESP_OK);
+                CHECK(compacted == false);
+            }
+        }
+    }
+    CHECK(compactions > 0);
+
+    for (uint32_t i = 0; i < KEY_COUNT; ++i) {
+        snprintf(key, sizeof(key), "key_%02u", (unsigned) i);
+        uint32_t value = 0;
+        CHECK(storage->readItem(ns_index, key, value) == ESP_OK);
+        CHECK(value == 19000 + i);
+    }
+
+    size_t pages_compacted = 1;
+    CHECK(nvs::NVSPartitionManager::get_instance()->collect_garbage("missing", 1, 16, &pages_compacted)
+            == ESP_ERR_NVS_NOT_INITIALIZED);
+    CHECK(nvs::NVSPartitionManager::get_instance()->collect_garbage(nullptr, 4, 16, &pages_compacted) == ESP_OK);
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition("test") == ESP_OK);
+}
+
+TEST_CASE("Storage returns current values when reading keys repeatedly", "[nvs_storage]")
+{
+    const uint32_t NVS_FLASH_SECTOR = 6;
+    const uint32_t NVS_FLASH_SECTOR_COUNT_MIN = 3;
+    PartitionEmulationFixture f(0, 10, "test");
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), NVS_FLASH_SECTOR, NVS_FLASH_SECTOR_COUNT_MIN)
+            == ESP_OK);
+
+    nvs::Storage *storage = nvs::NVSPartitionManager::get_instance()->lookup_storage_from_name("test");
+    uint8_t ns_index;
+    REQUIRE(storage->createOrOpenNamespace("test_ns", true, ns_index) == ESP_OK);
+
+    const uint8_t blob[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t blob_read[sizeof(blob)];
+    CHECK(storage->writeItem(ns_index, "counter", static_cast<uint32_t>(1)) == ESP_OK);
+    CHECK(storage->writeItem(ns_index, nvs::ItemType::BLOB, "calib", blob, sizeof(blob)) == ESP_OK);
+    CHECK(storage->writeItem(ns_index, nvs::ItemType::SZ, "name", "abc", 4) == ESP_OK);
+
+    for (uint32_t i = 2; i < 5; ++i) {
+        uint32_t value = 0;
+        CHECK(storage->readItem(ns_index, "counter", value) == ESP_OK);
+        CHECK(value == i - 1);
+        CHECK(storage->readItem(ns_index, "counter", value) == ESP_OK);
+        CHECK(value == i - 1);
+        CHECK(storage->writeItem(ns_index, "counter", i) == ESP_OK);
+
+        size_t size = 0;
+        CHECK(storage->getItemDataSize(ns_index, nvs::ItemType::BLOB, "calib", size) == ESP_OK);
+        CHECK(size == sizeof(blob));
+        CHECK(storage->readItem(ns_index, nvs::ItemType::BLOB, "calib", blob_read, sizeof(blob_read)) == ESP_OK);
+        CHECK(memcmp(blob, blob_read, sizeof(blob)) == 0);
+    }
+
+    // reading with a wrong size must still fail, even though the value is cached
+    uint16_t small_value;
+    CHECK(storage->readItem(ns_index, "counter", small_value) == ESP_ERR_NVS_NOT_FOUND);
+    char name[8];
+    CHECK(storage->readItem(ns_index, nvs::ItemType::SZ, "name", name, sizeof(name)) == ESP_OK);
+    CHECK(strcmp(name, "abc") == 0);
+    CHECK(storage->readItem(ns_index, nvs::ItemType::SZ, "name", name, 2) == ESP_ERR_NVS_INVALID_LENGTH);
+
+    CHECK(storage->eraseItem(ns_index, "counter") == ESP_OK);
+    uint32_t value = 0;
+    CHECK(storage->readItem(ns_index, "counter", value) == ESP_ERR_NVS_NOT_FOUND);
+
+    CHECK(storage->eraseNamespace(ns_index) == ESP_OK);
+    CHECK(storage->readItem(ns_index, nvs::ItemType::BLOB, "calib", blob_read, sizeof(blob_read)) == ESP_ERR_NVS_NOT_FOUND);
+    CHECK(storage->readItem(ns_index, nvs::ItemType::SZ, "name", name, sizeof(name)) == ESP_ERR_NVS_NOT_FOUND);
+
+    nvs_value_cache_stats_t stats = {};
+    storage->fillValueCacheStats(stats);
+#ifdef CONFIG_NVS_VALUE_CACHE
+    CHECK(stats.hits > 0);
+    CHECK(stats.misses > 0);
+    CHECK(stats.entry_count == 0);
+    CHECK(stats.used_bytes == 0);
+    CHECK(stats.capacity == CONFIG_NVS_VALUE_CACHE_SIZE);
+#else
+    CHECK(stats.hits == 0);
+    CHECK(stats.capacity == 0);
+#endif
+
+    REQUIRE(nvs::NVSPartitionManager::get_instance()->deinit_partition("test") == ESP_OK);
+}
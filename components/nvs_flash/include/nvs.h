@@ -127,6 +127,11 @@ typedef struct {
  */
 typedef struct nvs_opaque_iterator_t *nvs_iterator_t;
 
+/**
+ * Opaque pointer type representing a blob value being written in parts
+ */
+typedef struct nvs_opaque_blob_writer_t *nvs_blob_writer_t;
+
 /**
  * @brief      Open non-volatile storage with a given namespace from the default NVS partition
  *
@@ -501,6 +506,103 @@ esp_err_t nvs_get_str (nvs_handle_t handle, const char* key, char* out_value, si
 esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length);
 /**@}*/
 
+/**
+ * @brief      Read a part of a blob value
+ *
+ * Only the chunks of the blob which hold the requested part are read, so a large blob
+ * can be processed piece by piece without a buffer for the whole value.
+ *
+ * @param[in]     handle     Handle obtained from nvs_open function.
+ * @param[in]     key        Key name. Maximum length is (NVS_KEY_NAME_MAX_SIZE-1) characters. Shouldn't be empty.
+ * @param[in]     offset     Offset in the blob of the first byte to read.
+ * @param[out]    out_value  Pointer to the output buffer.
+ * @param[inout]  length     A non-zero pointer to the size of out_value. Set to the number of bytes read,
+ *                           which is less than the size of out_value if the end of the blob is reached.
+ *
+ * @return
+ *             - ESP_OK if the part was read successfully
+ *             - ESP_ERR_NVS_NOT_FOUND if the requested key doesn't exist
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_NVS_INVALID_LENGTH if \c offset is larger than the size of the blob
+ *             - ESP_ERR_NVS_INVALID_STATE if the key is modified by the active transaction on this handle
+ *             - ESP_ERR_INVALID_ARG if out_value or length is NULL
+ *             - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_get_blob_at(nvs_handle_t handle, const char* key, size_t offset, void* out_value, size_t* length);
+
+/**
+ * @brief      Start writing a blob value in parts
+ *
+ * The data passed to nvs_blob_writer_write is written to flash chunk by chunk as it arrives, so only
+ * one chunk (about 4 kB of heap) is buffered by the writer. The previous value of the key, if any,
+ * stays readable until nvs_blob_writer_close stores the new one. If the device is reset before that,
+ * the written chunks are erased by the next nvs_flash_init.
+ *
+ * The key must not be set or erased through another handle while the writer is open. The writer
+ * can't be used inside a transaction.
+ *
+ * @param[in]  handle  Handle obtained from nvs_open function, opened in NVS_READWRITE mode.
+ * @param[in]  key     Key name. Maximum length is (NVS_KEY_NAME_MAX_SIZE-1) characters. Shouldn't be empty.
+ * @param[out] writer  Set to the new writer, to be passed to nvs_blob_writer_close or nvs_blob_writer_abort.
+ *
+ * @return
+ *             - ESP_OK if the writer was created
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_NVS_READ_ONLY if storage handle was opened as read only
+ *             - ESP_ERR_NVS_INVALID_STATE if a transaction is active on this handle
+ *             - ESP_ERR_NVS_KEY_TOO_LONG if the key name is too long
+ *             - ESP_ERR_NO_MEM if memory couldn't be allocated for the writer
+ *             - ESP_ERR_INVALID_ARG if key or writer is NULL
+ */
+esp_err_t nvs_blob_writer_open(nvs_handle_t handle, const char* key, nvs_blob_writer_t* writer);
+
+/**
+ * @brief      Append data to a blob value being written
+ *
+ * If an error is returned, the data written so far is discarded, the writer must then be released
+ * with nvs_blob_writer_abort.
+ *
+ * @param[in]  writer  Writer obtained from nvs_blob_writer_open.
+ * @param[in]  data    The data to append.
+ * @param[in]  length  Length of the data in bytes.
+ *
+ * @return
+ *             - ESP_OK if the data was appended
+ *             - ESP_ERR_NVS_VALUE_TOO_LONG if the blob would be larger than the maximum size of a blob
+ *             - ESP_ERR_NVS_NOT_ENOUGH_SPACE if there is not enough space in the partition
+ *             - ESP_ERR_NVS_INVALID_HANDLE if the handle of the writer has been closed
+ *             - ESP_ERR_NVS_INVALID_STATE if a previous call failed
+ *             - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_blob_writer_write(nvs_blob_writer_t writer, const void* data, size_t length);
+
+/**
+ * @brief      Store the blob value and release the writer
+ *
+ * The blob replaces the previous value of the key, as if it was written by nvs_set_blob.
+ * The writer is released in any case.
+ *
+ * @param[in]  writer  Writer obtained from nvs_blob_writer_open.
+ *
+ * @return
+ *             - ESP_OK if the value was stored
+ *             - ESP_ERR_NVS_NOT_ENOUGH_SPACE if there is not enough space in the partition
+ *             - ESP_ERR_NVS_INVALID_HANDLE if the handle of the writer has been closed
+ *             - ESP_ERR_NVS_INVALID_STATE if a previous call failed
+ *             - ESP_ERR_NVS_REMOVE_FAILED if the value was stored, but the previous value couldn't be erased
+ *             - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_blob_writer_close(nvs_blob_writer_t writer);
+
+/**
+ * @brief      Discard the data written by a writer and release it
+ *
+ * The previous value of the key is kept.
+ *
+ * @param[in]  writer  Writer obtained from nvs_blob_writer_open. May be NULL.
+ */
+void nvs_blob_writer_abort(nvs_blob_writer_t writer);
+
 /**
  * @brief      Lookup key-value pair with given key name.
  *
@@ -566,16 +668,64 @@ esp_err_t nvs_erase_all(nvs_handle_t handle);
  * to non-volatile storage. Individual implementations may write to storage at other times,
  * but this is not guaranteed.
  *
+ * If a transaction has been started with \c nvs_transaction_begin, all staged changes are written
+ * and the transaction ends. The space they need is checked and the values they replace are read
+ * before anything is written. If any of the changes can't be written, the keys written so far are
+ * restored to their previous values and the transaction ends as well.
+ *
  * @param[in]  handle  Storage handle obtained with nvs_open.
  *                     Handles that were opened read only cannot be used.
  *
  * @return
  *             - ESP_OK if the changes have been written successfully
  *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
- *             - other error codes from the underlying storage driver
+ *             - ESP_ERR_NVS_NOT_ENOUGH_SPACE if the staged changes of a transaction don't fit
+ *               into the partition; nothing has been written in this case
+ *             - other error codes from the underlying storage driver. If restoring a key after a failed
+ *               write fails as well, the error of the restore is returned and the keys are only partly
+ *               restored
  */
 esp_err_t nvs_commit(nvs_handle_t handle);
 
+/**
+ * @brief      Start staging changes made through a handle
+ *
+ * After this call, nvs_set_*, nvs_set_str, nvs_set_blob and nvs_erase_key calls made through the
+ * handle are only recorded in RAM. nvs_get_*, nvs_get_str, nvs_get_blob and nvs_find_key calls made
+ * through the same handle return the recorded values. The changes are written by \c nvs_commit
+ * in one go or discarded by \c nvs_transaction_abort. Repeated changes of the same key are
+ * written only once. Closing the handle discards the staged changes.
+ *
+ * Staged changes require heap memory for a copy of each value. While committing, the values being
+ * replaced are read into heap memory as well, so that they can be restored if a later change fails.
+ * A transaction does not protect against power loss during \c nvs_commit: after a reset, some of
+ * the changes may have been written and others not.
+ *
+ * nvs_erase_all can't be called on a handle with an active transaction.
+ *
+ * @param[in]  handle  Storage handle obtained with nvs_open.
+ *                     Handles that were opened read only cannot be used.
+ *
+ * @return
+ *             - ESP_OK if the transaction has been started
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_NVS_READ_ONLY if handle was opened as read only
+ *             - ESP_ERR_NVS_INVALID_STATE if a transaction is already active on this handle
+ */
+esp_err_t nvs_transaction_begin(nvs_handle_t handle);
+
+/**
+ * @brief      Discard the changes staged since \c nvs_transaction_begin
+ *
+ * @param[in]  handle  Storage handle obtained with nvs_open.
+ *
+ * @return
+ *             - ESP_OK if the staged changes have been discarded
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_NVS_INVALID_STATE if no transaction is active on this handle
+ */
+esp_err_t nvs_transaction_abort(nvs_handle_t handle);
+
 /**
  * @brief      Close the storage handle and free any allocated resources
  *
@@ -635,6 +785,33 @@ typedef struct {
  */
 esp_err_t nvs_get_stats(const char *part_name, nvs_stats_t *nvs_stats);
 
+/**
+ * @note Info about the value cache of an NVS partition, see CONFIG_NVS_VALUE_CACHE.
+ */
+typedef struct {
+    size_t hits;              /**< Number of lookups served from the cache. */
+    size_t misses;            /**< Number of lookups which had to access flash. */
+    size_t entry_count;       /**< Number of values currently cached. */
+    size_t used_bytes;        /**< RAM used by the cached values, including bookkeeping. */
+    size_t capacity;          /**< Maximum RAM the cache may use. */
+} nvs_value_cache_stats_t;
+
+/**
+ * @brief      Fill structure nvs_value_cache_stats_t with the value cache counters of a partition.
+ *
+ * @param[in]   part_name   Partition name NVS in the partition table.
+ *                          If pass a NULL than will use NVS_DEFAULT_PART_NAME ("nvs").
+ *
+ * @param[out]  stats       Returns filled structure nvs_value_cache_stats_t.
+ *
+ * @return
+ *             - ESP_OK if stats has been filled.
+ *             - ESP_ERR_NVS_NOT_INITIALIZED if the storage driver is not initialized.
+ *             - ESP_ERR_INVALID_ARG if stats is equal to NULL.
+ *             - ESP_ERR_NOT_SUPPORTED if CONFIG_NVS_VALUE_CACHE is disabled.
+ */
+esp_err_t nvs_get_value_cache_stats(const char *part_name, nvs_value_cache_stats_t *stats);
+
 /**
  * @brief      Calculate all entries in a namespace.
  *
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -130,6 +130,28 @@ esp_err_t nvs_flash_deinit(void);
  */
 esp_err_t nvs_flash_deinit_partition(const char* partition_label);
 
+/**
+ * @brief Compact pages of initialized NVS partitions ahead of time
+ *
+ * When a write doesn't fit into the active page anymore and only one free page is left,
+ * NVS has to copy the live entries of the page with the most erased entries to the free
+ * page and erase the old page before the write can complete. This function does the same
+ * work outside of the write path, so it can be called from a low priority task or when the
+ * application is idle. A page is only compacted if the active page has at most
+ * CONFIG_NVS_GC_ACTIVE_PAGE_FREE_ENTRIES free entries left and compacting gains more entries
+ * than that.
+ *
+ * @param[in]  partition_label  Label of the partition, or NULL to process all initialized partitions
+ * @param[in]  max_pages        Maximum number of pages to compact
+ * @param[out] pages_compacted  Number of pages which have been compacted, may be NULL
+ *
+ * @return
+ *      - ESP_OK on success, including the case that no page had to be compacted
+ *      - ESP_ERR_NVS_NOT_INITIALIZED if the storage for given partition is not initialized
+ *      - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_flash_collect_garbage(const char *partition_label, size_t max_pages, size_t *pages_compacted);
+
 /**
  * @brief Erase the default NVS partition
  *
@@ -208,11 +208,40 @@ public:
 
     /**
      * Commits all changes done through this handle so far.
-     * Currently, NVS writes to storage right after the set and get functions,
+     * Outside of a transaction, NVS writes to storage right after the set and erase functions,
      * but this is not guaranteed.
+     * Inside a transaction (see \ref begin_transaction), all staged changes are written to storage and
+     * the transaction ends.
      */
     virtual esp_err_t commit() = 0;
 
+    /**
+     * @brief      Start a transaction.
+     *
+     * Until \ref commit or \ref abort_transaction is called, set and erase operations through this handle
+     * are only staged in RAM. Get operations through this handle return the staged values.
+     * commit() writes the staged changes one after another and either applies all of them or, in case of an error,
+     * restores the previous values of the keys written so far. This does not make the group atomic with regards
+     * to power loss during the commit.
+     *
+     * @return
+     *             - ESP_OK if the transaction has been started
+     *             - ESP_ERR_NVS_INVALID_STATE if a transaction is already active on this handle
+     *             - ESP_ERR_NVS_READ_ONLY if the handle has been opened as read only
+     *             - ESP_ERR_NOT_SUPPORTED if the handle implementation doesn't support transactions
+     */
+    virtual esp_err_t begin_transaction() { return ESP_ERR_NOT_SUPPORTED; }
+
+    /**
+     * @brief      Discard all changes staged since \ref begin_transaction and end the transaction.
+     *
+     * @return
+     *             - ESP_OK if the staged changes have been discarded
+     *             - ESP_ERR_NVS_INVALID_STATE if no transaction is active on this handle
+     *             - ESP_ERR_NOT_SUPPORTED if the handle implementation doesn't support transactions
+     */
+    virtual esp_err_t abort_transaction() { return ESP_ERR_NOT_SUPPORTED; }
+
     /**
      * @brief      Calculate all entries in the scope of the handle.
      *
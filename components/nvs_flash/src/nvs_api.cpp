@@ -17,6 +17,10 @@
 #include "esp_err.h"
 #include <esp_rom_crc.h>
 #include "nvs_internal.h"
+#ifdef CONFIG_NVS_GC_TASK
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
 
 // Uncomment this line to force output from this module
 // #define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
@@ -54,6 +58,44 @@ extern "C" void nvs_dump(const char *partName);
 using namespace std;
 using namespace nvs;
 
+#ifdef CONFIG_NVS_GC_TASK
+static void nvs_gc_task(void *arg)
+{
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_NVS_GC_TASK_INTERVAL_MS));
+
+        // compact one page per lock acquisition so that other tasks never wait for more than one page erase
+        for (size_t i = 0; i < CONFIG_NVS_GC_TASK_MAX_PAGES; ++i) {
+            size_t compacted = 0;
+            esp_err_t err = nvs_flash_collect_garbage(nullptr, 1, &compacted);
+            if (err != ESP_OK) {
+                ESP_LOGD(TAG, "Background garbage collection failed: %s", esp_err_to_name(err));
+                break;
+            }
+            if (compacted == 0) {
+                break;
+            }
+        }
+    }
+}
+
+static esp_err_t nvs_gc_task_start(void)
+{
+    static TaskHandle_t s_nvs_gc_task_handle;
+
+    if (s_nvs_gc_task_handle != nullptr) {
+        return ESP_OK;
+    }
+
+    if (xTaskCreate(nvs_gc_task, "nvs_gc", CONFIG_NVS_GC_TASK_STACK_SIZE, nullptr,
+            CONFIG_NVS_GC_TASK_PRIORITY, &s_nvs_gc_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create the background garbage collection task");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+#endif // CONFIG_NVS_GC_TASK
+
 static intrusive_list<NVSHandleEntry> s_nvs_handles;
 
 static nvs::Storage* lookup_storage_from_name(const char *name)
@@ -116,6 +158,11 @@ extern "C" esp_err_t nvs_flash_init_partition_ptr(const esp_partition_t *partiti
     if (init_res != ESP_OK) {
         delete part;
     }
+#ifdef CONFIG_NVS_GC_TASK
+    else {
+        init_res = nvs_gc_task_start();
+    }
+#endif
 
     return init_res;
 }
@@ -129,7 +176,13 @@ extern "C" esp_err_t nvs_flash_init_partition(const char *part_name)
     }
     Lock lock;
 
-    return NVSPartitionManager::get_instance()->init_partition(part_name);
+    esp_err_t err = NVSPartitionManager::get_instance()->init_partition(part_name);
+#ifdef CONFIG_NVS_GC_TASK
+    if (err == ESP_OK) {
+        err = nvs_gc_task_start();
+    }
+#endif
+    return err;
 }
 
 extern "C" esp_err_t nvs_flash_init(void)
@@ -169,7 +222,13 @@ extern "C" esp_err_t nvs_flash_secure_init_partition(const char *part_name, nvs_
     }
     Lock lock;
 
-    return NVSPartitionManager::get_instance()->secure_init_partition(part_name, cfg);
+    esp_err_t err = NVSPartitionManager::get_instance()->secure_init_partition(part_name, cfg);
+#ifdef CONFIG_NVS_GC_TASK
+    if (err == ESP_OK) {
+        err = nvs_gc_task_start();
+    }
+#endif
+    return err;
 }
 
 extern "C" esp_err_t nvs_flash_secure_init(nvs_sec_cfg_t* cfg)
@@ -251,6 +310,20 @@ extern "C" esp_err_t nvs_flash_deinit(void)
     return nvs_flash_deinit_partition(NVS_DEFAULT_PART_NAME);
 }
 
+extern "C" esp_err_t nvs_flash_collect_garbage(const char *part_name, size_t max_pages, size_t *pages_compacted)
+{
+    esp_err_t lock_result = Lock::init();
+    if (lock_result != ESP_OK) {
+        return lock_result;
+    }
+    Lock lock;
+
+    return NVSPartitionManager::get_instance()->collect_garbage(part_name,
+            max_pages,
+            CONFIG_NVS_GC_ACTIVE_PAGE_FREE_ENTRIES,
+            pages_compacted);
+}
+
 static esp_err_t nvs_find_ns_handle(nvs_handle_t c_handle, NVSHandleSimple** handle)
 {
     auto it = find_if(begin(s_nvs_handles), end(s_nvs_handles), [=](NVSHandleEntry& e) -> bool {
@@ -409,7 +482,7 @@ extern "C" esp_err_t nvs_set_u64 (nvs_handle_t handle, const char* key, uint64_t
 extern "C" esp_err_t nvs_commit(nvs_handle_t c_handle)
 {
     Lock lock;
-    // no-op for now, to be used when intermediate cache is added
+    // no-op unless a transaction is active
     NVSHandleSimple *handle;
     auto err = nvs_find_ns_handle(c_handle, &handle);
     if (err != ESP_OK) {
@@ -418,6 +491,30 @@ extern "C" esp_err_t nvs_commit(nvs_handle_t c_handle)
     return handle->commit();
 }
 
+extern "C" esp_err_t nvs_transaction_begin(nvs_handle_t c_handle)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s", __func__);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->begin_transaction();
+}
+
+extern "C" esp_err_t nvs_transaction_abort(nvs_handle_t c_handle)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s", __func__);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->abort_transaction();
+}
+
 extern "C" esp_err_t nvs_set_str(nvs_handle_t c_handle, const char* key, const char* value)
 {
     Lock lock;
@@ -536,6 +633,113 @@ extern "C" esp_err_t nvs_get_blob(nvs_handle_t c_handle, const char* key, void*
     return nvs_get_str_or_blob(c_handle, nvs::ItemType::BLOB, key, out_value, length);
 }
 
+extern "C" esp_err_t nvs_get_blob_at(nvs_handle_t c_handle, const char* key, size_t offset, void* out_value, size_t* length)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s %s %d", __func__, key, static_cast<int>(offset));
+    if (out_value == nullptr || length == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->get_blob_at(key, offset, out_value, *length);
+}
+
+struct nvs_opaque_blob_writer_t : public ExceptionlessAllocatable {
+    nvs_handle_t handle;
+    nvs::Storage::BlobWriter state;
+    bool failed;
+};
+
+static void release_blob_writer(nvs_blob_writer_t writer)
+{
+    NVSHandleSimple *handle;
+    if (nvs_find_ns_handle(writer->handle, &handle) == ESP_OK) {
+        handle->abort_blob_write(writer->state);
+    } else {
+        // the handle is closed, its storage may be gone with it
+        delete [] writer->state.buffer;
+    }
+    delete writer;
+}
+
+extern "C" esp_err_t nvs_blob_writer_open(nvs_handle_t c_handle, const char* key, nvs_blob_writer_t* writer)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s %s", __func__, key);
+    if (key == nullptr || writer == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    nvs_blob_writer_t new_writer = new (std::nothrow) nvs_opaque_blob_writer_t;
+    if (new_writer == nullptr) {
+        return ESP_ERR_NO_MEM;
+    }
+    new_writer->handle = c_handle;
+    new_writer->failed = false;
+    err = handle->begin_blob_write(key, new_writer->state);
+    if (err != ESP_OK) {
+        delete new_writer;
+        return err;
+    }
+    *writer = new_writer;
+    return ESP_OK;
+}
+
+extern "C" esp_err_t nvs_blob_writer_write(nvs_blob_writer_t writer, const void* data, size_t length)
+{
+    Lock lock;
+    if (writer == nullptr || (data == nullptr && length > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (writer->failed) {
+        return ESP_ERR_NVS_INVALID_STATE;
+    }
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(writer->handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = handle->write_blob_data(writer->state, data, length);
+    if (err != ESP_OK) {
+        // don't leave the chunks written so far until the writer is released
+        handle->abort_blob_write(writer->state);
+        writer->failed = true;
+    }
+    return err;
+}
+
+extern "C" esp_err_t nvs_blob_writer_close(nvs_blob_writer_t writer)
+{
+    Lock lock;
+    if (writer == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    NVSHandleSimple *handle;
+    auto err = writer->failed ? ESP_ERR_NVS_INVALID_STATE : nvs_find_ns_handle(writer->handle, &handle);
+    if (err == ESP_OK) {
+        err = handle->end_blob_write(writer->state);
+    }
+    release_blob_writer(writer);
+    return err;
+}
+
+extern "C" void nvs_blob_writer_abort(nvs_blob_writer_t writer)
+{
+    Lock lock;
+    if (writer != nullptr) {
+        release_blob_writer(writer);
+    }
+}
+
 extern "C" esp_err_t nvs_get_stats(const char* part_name, nvs_stats_t* nvs_stats)
 {
     Lock lock;
@@ -562,6 +766,30 @@ extern "C" esp_err_t nvs_get_stats(const char* part_name, nvs_stats_t* nvs_stats
     return pStorage->fillStats(*nvs_stats);
 }
 
+extern "C" esp_err_t nvs_get_value_cache_stats(const char* part_name, nvs_value_cache_stats_t* stats)
+{
+    Lock lock;
+    nvs::Storage* pStorage;
+
+    if (stats == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *stats = {};
+
+#ifdef CONFIG_NVS_VALUE_CACHE
+    pStorage = lookup_storage_from_name((part_name == nullptr) ? NVS_DEFAULT_PART_NAME : part_name);
+    if (pStorage == nullptr) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    pStorage->fillValueCacheStats(*stats);
+    return ESP_OK;
+#else
+    (void) pStorage;
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 extern "C" esp_err_t nvs_get_used_entry_count(nvs_handle_t c_handle, size_t* used_entries)
 {
     Lock lock;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -62,30 +62,36 @@ esp_err_t NVSEncryptedPartition::read(size_t src_offset, void* dst, size_t size)
     return ESP_OK;
 }
 
-esp_err_t NVSEncryptedPartition::write(size_t addr, const void* src, size_t size)
+esp_err_t NVSEncryptedPartition::encryptEntries(uint32_t relAddr, uint8_t* buf, size_t size)
 {
-    if (size % ESP_ENCRYPT_BLOCK_SIZE != 0) return ESP_ERR_INVALID_SIZE;
-
-    // copy data to buffer for encryption
-    uint8_t* buf = new (std::nothrow) uint8_t [size];
-
-    if (!buf) return ESP_ERR_NO_MEM;
-
-    memcpy(buf, src, size);
-
-    // encrypt data
-    uint8_t entrySize = sizeof(Item);
+    // each entry is a separate XTS data unit, numbered by its address
+    const size_t entrySize = sizeof(Item);
+    const size_t entries = size / entrySize;
+
+#ifdef MBEDTLS_AES_ALT
+    /* Encrypt all entries of a multi-entry write with two accelerator operations,
+     * instead of three for each entry.*/
+    if (entries > 1) {
+        uint8_t (*data_units)[16] = new (std::nothrow) uint8_t [entries][16];
+        if (data_units) {
+            memset(data_units, 0, entries * sizeof(data_units[0]));
+            for (size_t entry = 0; entry < entries; entry++) {
+                uint32_t entryAddr = relAddr + entry * entrySize;
+                memcpy(data_units[entry], &entryAddr, sizeof(entryAddr));
+            }
+            int ret = esp_aes_crypt_xts_units(&mEctxt, MBEDTLS_AES_ENCRYPT, entrySize, entries, data_units, buf, buf);
+            delete [] data_units;
+            return (ret == 0) ? ESP_OK : ESP_ERR_NVS_XTS_ENCR_FAILED;
+        }
+    }
+#endif // MBEDTLS_AES_ALT
 
     //sector num required as an arr by mbedtls. Should have been just uint64/32.
     uint8_t data_unit[16];
 
-    /* Use relative address instead of absolute address (relocatable), so that host-generated
-     * encrypted nvs images can be used*/
-    uint32_t relAddr = addr;
-
     memset(data_unit, 0, sizeof(data_unit));
 
-    for(uint8_t entry = 0; entry < (size/entrySize); entry++)
+    for (size_t entry = 0; entry < entries; entry++)
     {
         uint32_t offset = entry * entrySize;
         uint32_t *addr_loc = (uint32_t*) &data_unit[0];
@@ -97,13 +103,35 @@ esp_err_t NVSEncryptedPartition::write(size_t addr, const void* src, size_t size
                                   data_unit,
                                   buf + offset,
                                   buf + offset) != 0)  {
-            delete [] buf;
             return ESP_ERR_NVS_XTS_ENCR_FAILED;
         }
     }
 
+    return ESP_OK;
+}
+
+esp_err_t NVSEncryptedPartition::write(size_t addr, const void* src, size_t size)
+{
+    if (size % ESP_ENCRYPT_BLOCK_SIZE != 0) return ESP_ERR_INVALID_SIZE;
+
+    // copy data to buffer for encryption
+    uint8_t* buf = new (std::nothrow) uint8_t [size];
+
+    if (!buf) return ESP_ERR_NO_MEM;
+
+    memcpy(buf, src, size);
+
+    // encrypt data
+    /* Use relative address instead of absolute address (relocatable), so that host-generated
+     * encrypted nvs images can be used*/
+    esp_err_t result = encryptEntries(addr, buf, size);
+    if (result != ESP_OK) {
+        delete [] buf;
+        return result;
+    }
+
     // write data
-    esp_err_t result = esp_partition_write(mESPPartition, addr, buf, size);
+    result = esp_partition_write(mESPPartition, addr, buf, size);
 
     delete [] buf;
 
@@ -1,16 +1,8 @@
-// Copyright 2019 Espressif Systems (Shanghai) PTE LTD
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-//
-//         http://www.apache.org/licenses/LICENSE-2.0
-//
-// Unless required by applicable law or agreed to in writing, software
-// distributed under the License is distributed on an "AS IS" BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-// See the License for the specific language governing permissions and
-// limitations under the License.
+/*
+ * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
 
 #ifndef NVS_ENCRYPTED_PARTITION_HPP_
 #define NVS_ENCRYPTED_PARTITION_HPP_
@@ -34,6 +26,8 @@ public:
     esp_err_t write(size_t dst_offset, const void* src, size_t size) override;
 
 protected:
+    esp_err_t encryptEntries(uint32_t relAddr, uint8_t* buf, size_t size);
+
     mbedtls_aes_xts_context mEctxt;
     mbedtls_aes_xts_context mDctxt;
 };
@@ -1,22 +1,33 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <cstdlib>
+#include <cstring>
 #include "nvs_handle.hpp"
 #include "nvs_partition_manager.hpp"
+#include "esp_log.h"
+
+static const char *TAG = "nvs";
 
 namespace nvs {
 
 NVSHandleSimple::~NVSHandleSimple() {
+    clear_transaction();
     NVSPartitionManager::get_instance()->close_handle(this);
 }
 
+NVSHandleSimple::StagedItem::~StagedItem() {
+    std::free(mData);
+    std::free(mOldData);
+}
+
 esp_err_t NVSHandleSimple::set_typed_item(ItemType datatype, const char *key, const void* data, size_t dataSize)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransactionActive) return stage_item(datatype, key, data, dataSize, false);
 
     return mStoragePtr->writeItem(mNsIndex, datatype, key, data, dataSize);
 }
@@ -24,6 +35,10 @@ esp_err_t NVSHandleSimple::set_typed_item(ItemType datatype, const char *key, co
 esp_err_t NVSHandleSimple::get_typed_item(ItemType datatype, const char *key, void* data, size_t dataSize)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mTransactionActive) {
+        StagedItem *staged = find_staged(key);
+        if (staged) return get_staged_item(staged, datatype, data, dataSize);
+    }
 
     return mStoragePtr->readItem(mNsIndex, datatype, key, data, dataSize);
 }
@@ -32,6 +47,7 @@ esp_err_t NVSHandleSimple::set_string(const char *key, const char* str)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransactionActive) return stage_item(nvs::ItemType::SZ, key, str, strlen(str) + 1, false);
 
     return mStoragePtr->writeItem(mNsIndex, nvs::ItemType::SZ, key, str, strlen(str) + 1);
 }
@@ -40,6 +56,7 @@ esp_err_t NVSHandleSimple::set_blob(const char *key, const void* blob, size_t le
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransactionActive) return stage_item(nvs::ItemType::BLOB, key, blob, len, false);
 
     return mStoragePtr->writeItem(mNsIndex, nvs::ItemType::BLOB, key, blob, len);
 }
@@ -47,6 +64,10 @@ esp_err_t NVSHandleSimple::set_blob(const char *key, const void* blob, size_t le
 esp_err_t NVSHandleSimple::get_string(const char *key, char* out_str, size_t len)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mTransactionActive) {
+        StagedItem *staged = find_staged(key);
+        if (staged) return get_staged_item(staged, nvs::ItemType::SZ, out_str, len);
+    }
 
     return mStoragePtr->readItem(mNsIndex, nvs::ItemType::SZ, key, out_str, len);
 }
@@ -54,13 +75,63 @@ esp_err_t NVSHandleSimple::get_string(const char *key, char* out_str, size_t len
 esp_err_t NVSHandleSimple::get_blob(const char *key, void* out_blob, size_t len)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mTransactionActive) {
+        StagedItem *staged = find_staged(key);
+        if (staged) return get_staged_item(staged, nvs::ItemType::BLOB, out_blob, len);
+    }
 
     return mStoragePtr->readItem(mNsIndex, nvs::ItemType::BLOB, key, out_blob, len);
 }
 
+esp_err_t NVSHandleSimple::begin_blob_write(const char *key, Storage::BlobWriter &writer)
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransactionActive) return ESP_ERR_NVS_INVALID_STATE;
+
+    return mStoragePtr->beginBlobWrite(mNsIndex, key, writer);
+}
+
+esp_err_t NVSHandleSimple::write_blob_data(Storage::BlobWriter &writer, const void *data, size_t len)
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mTransactionActive) return ESP_ERR_NVS_INVALID_STATE;
+
+    return mStoragePtr->appendBlobData(writer, data, len);
+}
+
+esp_err_t NVSHandleSimple::end_blob_write(Storage::BlobWriter &writer)
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mTransactionActive) return ESP_ERR_NVS_INVALID_STATE;
+
+    return mStoragePtr->finishBlobWrite(writer);
+}
+
+void NVSHandleSimple::abort_blob_write(Storage::BlobWriter &writer)
+{
+    mStoragePtr->abortBlobWrite(writer);
+}
+
+esp_err_t NVSHandleSimple::get_blob_at(const char *key, size_t offset, void *out_blob, size_t &len)
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mTransactionActive && find_staged(key)) return ESP_ERR_NVS_INVALID_STATE;
+
+    return mStoragePtr->readBlobPart(mNsIndex, key, offset, out_blob, len);
+}
+
 esp_err_t NVSHandleSimple::get_item_size(ItemType datatype, const char *key, size_t &size)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mTransactionActive) {
+        StagedItem *staged = find_staged(key);
+        if (staged) {
+            if (staged->mErase || staged->mDatatype != datatype) return ESP_ERR_NVS_NOT_FOUND;
+            size = staged->mDataSize;
+            return ESP_OK;
+        }
+    }
 
     return mStoragePtr->getItemDataSize(mNsIndex, datatype, key, size);
 }
@@ -70,9 +141,16 @@ esp_err_t NVSHandleSimple::find_key(const char* key, nvs_type_t &nvstype)
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
 
     nvs::ItemType datatype;
-    esp_err_t err = mStoragePtr->findKey(mNsIndex, key, &datatype);
-    if(err != ESP_OK)
-        return err;
+    esp_err_t err = ESP_OK;
+    StagedItem *staged = mTransactionActive ? find_staged(key) : nullptr;
+    if (staged) {
+        if (staged->mErase) return ESP_ERR_NVS_NOT_FOUND;
+        datatype = staged->mDatatype;
+    } else {
+        err = mStoragePtr->findKey(mNsIndex, key, &datatype);
+        if(err != ESP_OK)
+            return err;
+    }
 
     if(datatype == ItemType::BLOB_IDX || datatype == ItemType::BLOB)
         datatype = ItemType::BLOB_DATA;
@@ -86,6 +164,17 @@ esp_err_t NVSHandleSimple::erase_item(const char* key)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransactionActive) {
+        // report a missing key right away, like the non-transactional erase does
+        StagedItem *staged = find_staged(key);
+        if (staged) {
+            if (staged->mErase) return ESP_ERR_NVS_NOT_FOUND;
+        } else {
+            esp_err_t err = mStoragePtr->findKey(mNsIndex, key, nullptr);
+            if (err != ESP_OK) return err;
+        }
+        return stage_item(ItemType::ANY, key, nullptr, 0, true);
+    }
 
     return mStoragePtr->eraseItem(mNsIndex, key);
 }
@@ -94,6 +183,7 @@ esp_err_t NVSHandleSimple::erase_all()
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransactionActive) return ESP_ERR_NVS_INVALID_STATE;
 
     return mStoragePtr->eraseNamespace(mNsIndex);
 }
@@ -101,10 +191,211 @@ esp_err_t NVSHandleSimple::erase_all()
 esp_err_t NVSHandleSimple::commit()
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (!mTransactionActive) return ESP_OK;
+
+    // Everything which can fail without touching the flash is done for the whole group first: the space
+    // check, and reading the values being replaced. Only then the items are written, one after another.
+    esp_err_t err = check_transaction_space();
+
+    for (auto it = mStaged.begin(); err == ESP_OK && it != mStaged.end(); ++it) {
+        err = save_replaced_item(*it);
+    }
+
+    bool written = false;
+    for (auto it = mStaged.begin(); err == ESP_OK && it != mStaged.end(); ++it) {
+        err = write_staged_item(*it);
+        written |= it->mApplied;
+    }
+
+    if (err != ESP_OK && written) {
+        ESP_LOGE(TAG, "Transaction commit failed (0x%x), restoring the keys written so far", err);
+        // keys are unique within the staged list, so the order of restoring doesn't matter
+        for (auto it = mStaged.begin(); it != mStaged.end(); ++it) {
+            esp_err_t rollback_err = rollback_staged_item(*it);
+            if (rollback_err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to restore key %s (0x%x)", it->mKey, rollback_err);
+                // the partition doesn't hold the previous values anymore, which matters more than the cause
+                err = rollback_err;
+            }
+        }
+    }
+
+    clear_transaction();
+    return err;
+}
+
+esp_err_t NVSHandleSimple::begin_transaction()
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransactionActive) return ESP_ERR_NVS_INVALID_STATE;
+
+    mTransactionActive = true;
+    return ESP_OK;
+}
+
+esp_err_t NVSHandleSimple::abort_transaction()
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (!mTransactionActive) return ESP_ERR_NVS_INVALID_STATE;
+
+    clear_transaction();
+    return ESP_OK;
+}
+
+esp_err_t NVSHandleSimple::stage_item(ItemType datatype, const char *key, const void *data, size_t dataSize, bool erase)
+{
+    if (strlen(key) > Item::MAX_KEY_LENGTH) return ESP_ERR_NVS_KEY_TOO_LONG;
+    if (datatype == ItemType::SZ && dataSize > Page::CHUNK_MAX_SIZE) return ESP_ERR_NVS_VALUE_TOO_LONG;
+    if (!erase && !isVariableLengthType(datatype) && dataSize > sizeof(uint64_t)) return ESP_ERR_INVALID_ARG;
+
+    StagedItem *staged = new (std::nothrow) StagedItem;
+    if (!staged) return ESP_ERR_NO_MEM;
+
+    if (dataSize) {
+        staged->mData = static_cast<uint8_t*>(std::malloc(dataSize));
+        if (!staged->mData) {
+            delete staged;
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(staged->mData, data, dataSize);
+    }
+    strncpy(staged->mKey, key, sizeof(staged->mKey) - 1);
+    staged->mKey[sizeof(staged->mKey) - 1] = 0;
+    staged->mDatatype = datatype;
+    staged->mErase = erase;
+    staged->mDataSize = dataSize;
+
+    // the last operation on a key wins
+    StagedItem *previous = find_staged(key);
+    if (previous) {
+        mStaged.erase(previous);
+        delete previous;
+    }
+    mStaged.push_back(staged);
+    return ESP_OK;
+}
+
+NVSHandleSimple::StagedItem *NVSHandleSimple::find_staged(const char *key)
+{
+    for (auto it = mStaged.begin(); it != mStaged.end(); ++it) {
+        if (strncmp(it->mKey, key, Item::MAX_KEY_LENGTH) == 0) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t NVSHandleSimple::get_staged_item(StagedItem *staged, ItemType datatype, void *data, size_t dataSize)
+{
+    if (staged->mErase || staged->mDatatype != datatype) return ESP_ERR_NVS_NOT_FOUND;
+
+    if (!isVariableLengthType(datatype)) {
+        if (dataSize != staged->mDataSize) return ESP_ERR_NVS_TYPE_MISMATCH;
+    } else if (dataSize < staged->mDataSize) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
 
+    memcpy(data, staged->mData, staged->mDataSize);
     return ESP_OK;
 }
 
+esp_err_t NVSHandleSimple::check_transaction_space()
+{
+    nvs_stats_t stats;
+    esp_err_t err = mStoragePtr->fillStats(stats);
+    if (err != ESP_OK) return err;
+
+    size_t required = 0;
+    for (auto it = mStaged.begin(); it != mStaged.end(); ++it) {
+        if (it->mErase) continue;
+
+        // header entry plus data entries, blobs need an additional header per chunk and the blob index
+        required += 1;
+        if (isVariableLengthType(it->mDatatype)) {
+            required += (it->mDataSize + Page::ENTRY_SIZE - 1) / Page::ENTRY_SIZE;
+        }
+        if (it->mDatatype == ItemType::BLOB) {
+            required += it->mDataSize / Page::CHUNK_MAX_SIZE + 1;
+        }
+    }
+
+    // one page always has to stay free for page compaction
+    size_t capacity = stats.total_entries - stats.used_entries;
+    capacity = (capacity > Page::ENTRY_COUNT) ? capacity - Page::ENTRY_COUNT : 0;
+
+    return (required > capacity) ? ESP_ERR_NVS_NOT_ENOUGH_SPACE : ESP_OK;
+}
+
+esp_err_t NVSHandleSimple::save_replaced_item(StagedItem &staged)
+{
+    // remember the value being replaced to be able to restore it if a later item fails
+    ItemType oldDatatype = staged.mDatatype;
+    esp_err_t err = ESP_OK;
+#ifdef CONFIG_NVS_LEGACY_DUP_KEYS_COMPATIBILITY
+    // values of other types remain untouched by a set, only an erase may remove them
+    if (staged.mErase)
+#endif
+    {
+        err = mStoragePtr->findKey(mNsIndex, staged.mKey, &oldDatatype);
+    }
+    if (oldDatatype == ItemType::BLOB_IDX || oldDatatype == ItemType::BLOB_DATA) {
+        oldDatatype = ItemType::BLOB;
+    }
+
+    size_t oldDataSize = 0;
+    if (err == ESP_OK) {
+        err = mStoragePtr->getItemDataSize(mNsIndex, oldDatatype, staged.mKey, oldDataSize);
+    }
+    if (err == ESP_OK) {
+        if (!isVariableLengthType(oldDatatype)) {
+            oldDataSize = static_cast<uint8_t>(oldDatatype) & 0x0f;
+        }
+        staged.mOldData = static_cast<uint8_t*>(std::malloc(oldDataSize ? oldDataSize : 1));
+        if (!staged.mOldData) return ESP_ERR_NO_MEM;
+        err = mStoragePtr->readItem(mNsIndex, oldDatatype, staged.mKey, staged.mOldData, oldDataSize);
+        if (err != ESP_OK) return err;
+        staged.mOldPresent = true;
+        staged.mOldDatatype = oldDatatype;
+        staged.mOldDataSize = oldDataSize;
+    } else if (err != ESP_ERR_NVS_NOT_FOUND) {
+        return err;
+    }
+    return ESP_OK;
+}
+
+esp_err_t NVSHandleSimple::write_staged_item(StagedItem &staged)
+{
+    esp_err_t err;
+    if (staged.mErase) {
+        err = staged.mOldPresent ? mStoragePtr->eraseItem(mNsIndex, staged.mKey) : ESP_OK;
+    } else {
+        err = mStoragePtr->writeItem(mNsIndex, staged.mDatatype, staged.mKey, staged.mData, staged.mDataSize);
+    }
+    if (err != ESP_OK) return err;
+
+    staged.mApplied = true;
+    return ESP_OK;
+}
+
+esp_err_t NVSHandleSimple::rollback_staged_item(StagedItem &staged)
+{
+    if (!staged.mApplied) return ESP_OK;
+
+    if (staged.mOldPresent) {
+        return mStoragePtr->writeItem(mNsIndex, staged.mOldDatatype, staged.mKey, staged.mOldData, staged.mOldDataSize);
+    } else if (!staged.mErase) {
+        return mStoragePtr->eraseItem(mNsIndex, staged.mDatatype, staged.mKey);
+    }
+    return ESP_OK;
+}
+
+void NVSHandleSimple::clear_transaction()
+{
+    mStaged.clearAndFreeNodes();
+    mTransactionActive = false;
+}
+
 esp_err_t NVSHandleSimple::get_used_entry_count(size_t& used_entries)
 {
     used_entries = 0;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -51,6 +51,22 @@ public:
 
     esp_err_t get_item_size(ItemType datatype, const char *key, size_t &size) override;
 
+    /**
+     * Streaming blob write, see Storage::beginBlobWrite(). Not supported inside a transaction.
+     */
+    esp_err_t begin_blob_write(const char *key, Storage::BlobWriter &writer);
+
+    esp_err_t write_blob_data(Storage::BlobWriter &writer, const void *data, size_t len);
+
+    esp_err_t end_blob_write(Storage::BlobWriter &writer);
+
+    void abort_blob_write(Storage::BlobWriter &writer);
+
+    /**
+     * Reads up to len bytes of a blob starting at offset, len is set to the number of bytes read.
+     */
+    esp_err_t get_blob_at(const char *key, size_t offset, void *out_blob, size_t &len);
+
     esp_err_t find_key(const char *key, nvs_type_t &nvstype) override;
 
     esp_err_t erase_item(const char *key) override;
@@ -59,6 +75,10 @@ public:
 
     esp_err_t commit() override;
 
+    esp_err_t begin_transaction() override;
+
+    esp_err_t abort_transaction() override;
+
     esp_err_t get_used_entry_count(size_t &usedEntries) override;
 
     esp_err_t getItemDataSize(ItemType datatype, const char *key, size_t &dataSize);
@@ -80,6 +100,43 @@ public:
     Storage *get_storage() const;
 
 private:
+    /**
+     * A set or erase operation staged by a transaction, together with the value it replaced once it is applied.
+     */
+    struct StagedItem : public intrusive_list_node<StagedItem>, public ExceptionlessAllocatable {
+        ~StagedItem();
+
+        char mKey[Item::MAX_KEY_LENGTH + 1];
+        ItemType mDatatype;
+        bool mErase;
+        uint8_t *mData = nullptr;
+        size_t mDataSize = 0;
+
+        bool mApplied = false;
+        bool mOldPresent = false;
+        ItemType mOldDatatype = ItemType::ANY;
+        uint8_t *mOldData = nullptr;
+        size_t mOldDataSize = 0;
+    };
+
+    typedef intrusive_list<StagedItem> TStagedList;
+
+    esp_err_t stage_item(ItemType datatype, const char *key, const void *data, size_t dataSize, bool erase);
+
+    StagedItem *find_staged(const char *key);
+
+    esp_err_t get_staged_item(StagedItem *staged, ItemType datatype, void *data, size_t dataSize);
+
+    esp_err_t check_transaction_space();
+
+    esp_err_t save_replaced_item(StagedItem &staged);
+
+    esp_err_t write_staged_item(StagedItem &staged);
+
+    esp_err_t rollback_staged_item(StagedItem &staged);
+
+    void clear_transaction();
+
     /**
      * The underlying storage's object.
      */
@@ -101,6 +158,16 @@ private:
      * Upon opening, a handle is valid. It becomes invalid if the underlying storage is de-initialized.
      */
     uint8_t valid;
+
+    /**
+     * Whether set and erase operations are staged instead of written to storage immediately.
+     */
+    bool mTransactionActive = false;
+
+    /**
+     * Operations staged by the active transaction, in the order in which they will be applied.
+     */
+    TStagedList mStaged;
 };
 
 } // nvs
@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstring>
+#include <new>
+#include "nvs_key_index.hpp"
+#include "nvs_page.hpp"
+#include "esp_rom_crc.h"
+
+namespace nvs
+{
+
+KeyIndex::KeyIndex()
+{
+}
+
+KeyIndex::~KeyIndex()
+{
+    deinit();
+}
+
+esp_err_t KeyIndex::init(size_t capacity)
+{
+    deinit();
+
+    // round up to a power of two so that the home slot can be computed with a mask
+    size_t pow2 = 1;
+    while (pow2 < capacity) {
+        pow2 <<= 1;
+    }
+
+    mSlots = new (std::nothrow) Slot[pow2];
+    if (!mSlots) {
+        return ESP_ERR_NO_MEM;
+    }
+    mCapacity = pow2;
+    mUsed = 0;
+    mComplete = false;
+    return ESP_OK;
+}
+
+void KeyIndex::deinit()
+{
+    delete [] mSlots;
+    mSlots = nullptr;
+    mCapacity = 0;
+    mUsed = 0;
+    mComplete = false;
+}
+
+void KeyIndex::reset()
+{
+    if (!mSlots) {
+        return;
+    }
+    for (size_t i = 0; i < mCapacity; ++i) {
+        mSlots[i] = Slot();
+    }
+    mUsed = 0;
+    mComplete = true;
+}
+
+uint32_t KeyIndex::hash(uint8_t nsIndex, const char* key)
+{
+    uint32_t result = 0xffffffff;
+    result = esp_rom_crc32_le(result, &nsIndex, sizeof(nsIndex));
+    result = esp_rom_crc32_le(result, reinterpret_cast<const uint8_t*>(key), strnlen(key, Item::MAX_KEY_LENGTH));
+    return result;
+}
+
+void KeyIndex::insert(uint8_t nsIndex, const char* key, Page* page)
+{
+    if (!mSlots) {
+        return;
+    }
+
+    const uint32_t h = hash(nsIndex, key);
+    size_t i = home(h);
+    while (mSlots[i].mPage != nullptr) {
+        Slot& slot = mSlots[i];
+        if (slot.mHash == h && slot.mNsIndex == nsIndex && slot.mPage == page) {
+            if (slot.mCount == UINT8_MAX) {
+                mComplete = false;
+            } else {
+                ++slot.mCount;
+            }
+            return;
+        }
+        i = (i + 1) & (mCapacity - 1);
+    }
+
+    // keep at least a quarter of the table empty to bound the probe length
+    if (mUsed + 1 > mCapacity - mCapacity / 4) {
+        mComplete = false;
+        return;
+    }
+
+    mSlots[i].mPage = page;
+    mSlots[i].mHash = h;
+    mSlots[i].mNsIndex = nsIndex;
+    mSlots[i].mCount = 1;
+    ++mUsed;
+}
+
+void KeyIndex::remove(uint8_t nsIndex, const char* key, Page* page)
+{
+    if (!mSlots) {
+        return;
+    }
+
+    const uint32_t h = hash(nsIndex, key);
+    for (size_t i = home(h); mSlots[i].mPage != nullptr; i = (i + 1) & (mCapacity - 1)) {
+        Slot& slot = mSlots[i];
+        if (slot.mHash == h && slot.mNsIndex == nsIndex && slot.mPage == page) {
+            if (--slot.mCount == 0) {
+                eraseSlot(i);
+            }
+            return;
+        }
+    }
+}
+
+void KeyIndex::removeNamespace(uint8_t nsIndex)
+{
+    if (!mSlots) {
+        return;
+    }
+
+    for (size_t i = 0; i < mCapacity;) {
+        if (mSlots[i].mPage != nullptr && mSlots[i].mNsIndex == nsIndex) {
+            // eraseSlot may shift another slot into i, so check the same position again
+            eraseSlot(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void KeyIndex::relocate(Page* oldPage, Page* newPage)
+{
+    if (!mSlots) {
+        return;
+    }
+
+    for (size_t i = 0; i < mCapacity;) {
+        if (mSlots[i].mPage != oldPage) {
+            ++i;
+            continue;
+        }
+        Slot moved = mSlots[i];
+        eraseSlot(i);
+
+        size_t j = home(moved.mHash);
+        while (mSlots[j].mPage != nullptr
+                && !(mSlots[j].mHash == moved.mHash && mSlots[j].mNsIndex == moved.mNsIndex && mSlots[j].mPage == newPage)) {
+            j = (j + 1) & (mCapacity - 1);
+        }
+        if (mSlots[j].mPage == nullptr) {
+            moved.mPage = newPage;
+            mSlots[j] = moved;
+            ++mUsed;
+        } else if (mSlots[j].mCount > UINT8_MAX - moved.mCount) {
+            mSlots[j].mCount = UINT8_MAX;
+            mComplete = false;
+        } else {
+            mSlots[j].mCount += moved.mCount;
+        }
+        // slot i now holds a different entry (or is empty), don't advance
+    }
+}
+
+size_t KeyIndex::find(uint8_t nsIndex, const char* key, Page* (&candidates)[MAX_CANDIDATES]) const
+{
+    if (!mSlots) {
+        return SIZE_MAX;
+    }
+
+    const uint32_t h = hash(nsIndex, key);
+    size_t count = 0;
+    for (size_t i = home(h); mSlots[i].mPage != nullptr; i = (i + 1) & (mCapacity - 1)) {
+        const Slot& slot = mSlots[i];
+        if (slot.mHash != h || slot.mNsIndex != nsIndex) {
+            continue;
+        }
+        if (count == MAX_CANDIDATES) {
+            return SIZE_MAX;
+        }
+
+        // insertion sort by sequence number keeps the order in which Storage walks the page list
+        uint32_t seqNumber = UINT32_MAX;
+        slot.mPage->getSeqNumber(seqNumber);
+        size_t pos = count;
+        while (pos > 0) {
+            uint32_t otherSeqNumber = UINT32_MAX;
+            candidates[pos - 1]->getSeqNumber(otherSeqNumber);
+            if (otherSeqNumber <= seqNumber) {
+                break;
+            }
+            candidates[pos] = candidates[pos - 1];
+            --pos;
+        }
+        candidates[pos] = slot.mPage;
+        ++count;
+    }
+    return count;
+}
+
+void KeyIndex::eraseSlot(size_t index)
+{
+    // backward shift deletion, keeps probe sequences intact without tombstones
+    size_t hole = index;
+    size_t i = index;
+    while (true) {
+        i = (i + 1) & (mCapacity - 1);
+        if (mSlots[i].mPage == nullptr) {
+            break;
+        }
+        size_t h = home(mSlots[i].mHash);
+        // move slot i into the hole if its home position is not within (hole, i]
+        bool inRange = (hole <= i) ? (hole < h && h <= i) : (hole < h || h <= i);
+        if (!inRange) {
+            mSlots[hole] = mSlots[i];
+            hole = i;
+        }
+    }
+    mSlots[hole] = Slot();
+    --mUsed;
+}
+
+} // namespace nvs
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef nvs_key_index_hpp
+#define nvs_key_index_hpp
+
+#include <cstdint>
+#include <cstddef>
+#include "esp_err.h"
+#include "nvs_memory_management.hpp"
+
+namespace nvs
+{
+
+class Page;
+
+/**
+ * @brief Partition-wide index mapping <namespace, key> to the pages holding items with that key.
+ *
+ * Each slot records one page together with the number of live items (including blob chunks) that the
+ * page holds for a given <namespace, key>. Storage keeps the counters up to date on every item write,
+ * erase and page relocation, so a lookup only has to probe the few pages returned by the index instead
+ * of every page in the partition.
+ *
+ * The index is "complete" as long as every live item has been accounted for. A complete index may also
+ * answer negative lookups. If the table runs out of slots or an operation could not be tracked
+ * reliably, the index is marked incomplete and callers fall back to scanning all pages for negative
+ * results. Stale slots (which can appear when a page drops a corrupted item on its own) only cost an
+ * additional page probe, they never produce wrong results.
+ */
+class KeyIndex
+{
+public:
+    /** Maximum number of pages a single lookup may return */
+    static const size_t MAX_CANDIDATES = 8;
+
+    KeyIndex();
+    ~KeyIndex();
+
+    /**
+     * Allocate the slot table. Must be called before any other operation.
+     * The index starts out empty and incomplete.
+     */
+    esp_err_t init(size_t capacity);
+
+    /** Free the slot table */
+    void deinit();
+
+    /** Drop all slots and mark the index as complete, to be followed by a full rebuild with insert() */
+    void reset();
+
+    /** Account one more item with <nsIndex, key> stored on page */
+    void insert(uint8_t nsIndex, const char* key, Page* page);
+
+    /** Account one item with <nsIndex, key> less on page */
+    void remove(uint8_t nsIndex, const char* key, Page* page);
+
+    /** Drop all slots belonging to nsIndex */
+    void removeNamespace(uint8_t nsIndex);
+
+    /** All items of page oldPage have been copied to page newPage */
+    void relocate(Page* oldPage, Page* newPage);
+
+    /**
+     * Collect the pages holding items with <nsIndex, key>, ordered by page sequence number.
+     *
+     * @return number of pages stored in candidates or SIZE_MAX if the result doesn't fit into
+     *         MAX_CANDIDATES entries and the caller has to scan all pages.
+     */
+    size_t find(uint8_t nsIndex, const char* key, Page* (&candidates)[MAX_CANDIDATES]) const;
+
+    /** Declare that the index doesn't track all items anymore */
+    void invalidate()
+    {
+        mComplete = false;
+    }
+
+    bool isValid() const
+    {
+        return mSlots != nullptr;
+    }
+
+    bool isComplete() const
+    {
+        return mSlots != nullptr && mComplete;
+    }
+
+private:
+    KeyIndex(const KeyIndex& other);
+    const KeyIndex& operator= (const KeyIndex& rhs);
+
+    struct Slot : public ExceptionlessAllocatable {
+        Page* mPage = nullptr;
+        uint32_t mHash = 0;
+        uint8_t mNsIndex = 0;
+        uint8_t mCount = 0;
+    };
+
+    static uint32_t hash(uint8_t nsIndex, const char* key);
+
+    size_t home(uint32_t hash) const
+    {
+        return hash & (mCapacity - 1);
+    }
+
+    void eraseSlot(size_t index);
+
+    Slot* mSlots = nullptr;
+    size_t mCapacity = 0;
+    size_t mUsed = 0;
+    bool mComplete = false;
+}; // class KeyIndex
+
+} // namespace nvs
+
+#endif /* nvs_key_index_hpp */
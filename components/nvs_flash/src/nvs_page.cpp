@@ -301,6 +301,60 @@ esp_err_t Page::readItem(uint8_t nsIndex, ItemType datatype, const char* key, vo
     return ESP_OK;
 }
 
+esp_err_t Page::readItemPart(uint8_t nsIndex, ItemType datatype, const char* key, size_t offset, void* data, size_t dataSize, uint8_t chunkIdx)
+{
+    size_t index = 0;
+    Item item;
+
+    if (mState == PageState::INVALID) {
+        return ESP_ERR_NVS_INVALID_STATE;
+    }
+
+    esp_err_t rc = findItem(nsIndex, datatype, key, index, item, chunkIdx);
+    if (rc != ESP_OK) {
+        return rc;
+    }
+
+    if (!isVariableLengthType(datatype)) {
+        return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+
+    const size_t itemSize = item.varLength.dataSize;
+    if (offset > itemSize || dataSize > itemSize - offset) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    // all entries are read to check the CRC, only the requested part is copied
+    uint8_t* dst = reinterpret_cast<uint8_t*>(data);
+    uint32_t crc = 0xffffffff;
+    size_t pos = 0;
+    for (size_t i = index + 1; i < index + item.span; ++i) {
+        Item ditem;
+        rc = readEntry(i, ditem);
+        if (rc != ESP_OK) {
+            return rc;
+        }
+        size_t entrySize = ENTRY_SIZE;
+        entrySize = (itemSize - pos < entrySize) ? itemSize - pos : entrySize;
+        crc = esp_rom_crc32_le(crc, ditem.rawData, entrySize);
+
+        size_t from = (offset > pos) ? offset - pos : 0;
+        size_t to = (offset + dataSize < pos + entrySize) ? offset + dataSize - pos : entrySize;
+        if (from < to) {
+            memcpy(dst + pos + from - offset, ditem.rawData + from, to - from);
+        }
+        pos += entrySize;
+    }
+    if (crc != item.varLength.dataCrc32) {
+        rc = eraseEntryAndSpan(index);
+        if (rc != ESP_OK) {
+            return rc;
+        }
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
 esp_err_t Page::cmpItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx, VerOffset chunkStart)
 {
     size_t index = 0;
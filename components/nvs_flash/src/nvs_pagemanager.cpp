@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -132,8 +132,12 @@ esp_err_t PageManager::load(Partition *partition, uint32_t baseSector, uint32_t
     return ESP_OK;
 }
 
-esp_err_t PageManager::requestNewPage()
+esp_err_t PageManager::requestNewPage(Page** freedPage)
 {
+    if (freedPage) {
+        *freedPage = nullptr;
+    }
+
     if (mFreePageList.empty()) {
         return ESP_ERR_NVS_INVALID_STATE;
     }
@@ -175,6 +179,9 @@ esp_err_t PageManager::requestNewPage()
     if (err != ESP_OK) {
         return err;
     }
+    if (freedPage) {
+        *freedPage = erasedPage;
+    }
     err = erasedPage->copyItems(*newPage);
     if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
         return err;
@@ -195,6 +202,36 @@ esp_err_t PageManager::requestNewPage()
     return ESP_OK;
 }
 
+bool PageManager::isCompactionDue(size_t maxFreeEntries)
+{
+    // with two free pages, requestNewPage doesn't have to erase anything
+    if (mFreePageList.size() != 1 || mPageList.empty()) {
+        return false;
+    }
+
+    Page& activePage = back();
+    size_t freeEntries = 0;
+    if (activePage.state() == Page::PageState::UNINITIALIZED) {
+        freeEntries = Page::ENTRY_COUNT;
+    } else if (activePage.state() == Page::PageState::ACTIVE) {
+        freeEntries = Page::ENTRY_COUNT - activePage.getUsedEntryCount() - activePage.getErasedEntryCount();
+    }
+    if (freeEntries > maxFreeEntries) {
+        return false;
+    }
+
+    size_t maxUnusedItems = 0;
+    for (auto it = begin(); it != end(); ++it) {
+        auto unused = Page::ENTRY_COUNT - it->getUsedEntryCount();
+        if (unused > maxUnusedItems) {
+            maxUnusedItems = unused;
+        }
+    }
+
+    // the free entries of the active page are lost when it is marked full
+    return maxUnusedItems > freeEntries;
+}
+
 esp_err_t PageManager::activatePage()
 {
     if (mFreePageList.empty()) {
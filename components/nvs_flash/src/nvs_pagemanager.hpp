@@ -52,7 +52,21 @@ public:
         return mPageCount;
     }
 
-    esp_err_t requestNewPage();
+    /**
+     * Make a new page active. If no spare free page is available, the page with the most erased entries is
+     * compacted: its items are copied to the new page and it is erased afterwards.
+     *
+     * @param[out] freedPage If not null, set to the page whose items were moved to the new page (back()), or
+     *                       to nullptr if no items were moved. Set as soon as moving starts, even if it fails.
+     */
+    esp_err_t requestNewPage(Page** freedPage = nullptr);
+
+    /**
+     * Check whether the next call to requestNewPage would have to compact a page and if it's worth doing that now.
+     * This is the case if at most maxFreeEntries entries are left on the active page and compacting the page with
+     * the most erased entries yields more free entries than that.
+     */
+    bool isCompactionDue(size_t maxFreeEntries);
 
     esp_err_t fillStats(nvs_stats_t& nvsStats);
 
@@ -231,6 +231,50 @@ size_t NVSPartitionManager::open_handles_size()
     return nvs_handles.size();
 }
 
+esp_err_t NVSPartitionManager::collect_garbage(const char *part_name,
+        size_t max_pages,
+        size_t max_free_entries,
+        size_t *pages_compacted)
+{
+    size_t compacted = 0;
+    esp_err_t err = ESP_OK;
+
+    if (part_name != nullptr) {
+        Storage* storage = lookup_storage_from_name(part_name);
+        if (storage == nullptr) {
+            return ESP_ERR_NVS_NOT_INITIALIZED;
+        }
+
+        while (compacted < max_pages) {
+            bool didCompact;
+            err = storage->collectGarbage(max_free_entries, didCompact);
+            if (err != ESP_OK || !didCompact) {
+                break;
+            }
+            ++compacted;
+        }
+    } else {
+        for (auto it = nvs_storage_list.begin(); it != nvs_storage_list.end() && compacted < max_pages; ++it) {
+            while (compacted < max_pages) {
+                bool didCompact;
+                err = it->collectGarbage(max_free_entries, didCompact);
+                if (err != ESP_OK || !didCompact) {
+                    break;
+                }
+                ++compacted;
+            }
+            if (err != ESP_OK) {
+                break;
+            }
+        }
+    }
+
+    if (pages_compacted != nullptr) {
+        *pages_compacted = compacted;
+    }
+    return err;
+}
+
 Storage* NVSPartitionManager::lookup_storage_from_name(const char* name)
 {
     auto it = find_if(begin(nvs_storage_list), end(nvs_storage_list), [=](Storage& e) -> bool {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -36,6 +36,8 @@ public:
 
     size_t open_handles_size();
 
+    esp_err_t collect_garbage(const char *part_name, size_t max_pages, size_t max_free_entries, size_t *pages_compacted);
+
 protected:
     NVSPartitionManager() { }
 
@@ -188,6 +188,8 @@ esp_err_t Storage::init(uint32_t baseSector, uint32_t sectorCount)
         return err;
     }
 
+    mValueCache.clear();
+
     // load namespaces list
     clearNamespaces();
     std::fill_n(mNamespaceUsage.data(), mNamespaceUsage.byteSize() / 4, 0);
@@ -241,6 +243,8 @@ esp_err_t Storage::init(uint32_t baseSector, uint32_t sectorCount)
     // Purge the blob index list
     blobIdxList.clearAndFreeNodes();
 
+    buildKeyIndex();
+
     mState = StorageState::ACTIVE;
 
 #ifdef DEBUG_STORAGE
@@ -254,8 +258,66 @@ bool Storage::isValid() const
     return mState == StorageState::ACTIVE;
 }
 
+void Storage::buildKeyIndex()
+{
+#ifdef CONFIG_NVS_KEY_INDEX
+    if (!mKeyIndex.isValid() && mKeyIndex.init(CONFIG_NVS_KEY_INDEX_SIZE) != ESP_OK) {
+        // not fatal, lookups just keep scanning all pages
+        ESP_LOGW(TAG, "Not enough memory for key index of partition %s", getPartName());
+        return;
+    }
+
+    mKeyIndex.reset();
+    for (auto it = mPageManager.begin(); it != mPageManager.end(); ++it) {
+        size_t itemIndex = 0;
+        Item item;
+        while (it->findItem(Page::NS_ANY, ItemType::ANY, nullptr, itemIndex, item) == ESP_OK) {
+            mKeyIndex.insert(item.nsIndex, item.key, it);
+            itemIndex += item.span;
+        }
+    }
+
+    if (!mKeyIndex.isComplete()) {
+        ESP_LOGW(TAG, "Key index of partition %s is too small, consider increasing CONFIG_NVS_KEY_INDEX_SIZE", getPartName());
+    }
+#endif // CONFIG_NVS_KEY_INDEX
+}
+
+esp_err_t Storage::requestNewPage()
+{
+    Page* freedPage = nullptr;
+    auto err = mPageManager.requestNewPage(&freedPage);
+    if (freedPage != nullptr) {
+        if (err == ESP_OK) {
+            mKeyIndex.relocate(freedPage, &mPageManager.back());
+        } else {
+            // items may be present on both pages now
+            mKeyIndex.invalidate();
+        }
+    }
+    return err;
+}
+
 esp_err_t Storage::findItem(uint8_t nsIndex, ItemType datatype, const char* key, Page* &page, Item& item, uint8_t chunkIdx, VerOffset chunkStart)
 {
+    if (mKeyIndex.isValid() && nsIndex != Page::NS_ANY && key != nullptr) {
+        Page* candidates[KeyIndex::MAX_CANDIDATES];
+        size_t count = mKeyIndex.find(nsIndex, key, candidates);
+        if (count != SIZE_MAX) {
+            for (size_t i = 0; i < count; ++i) {
+                size_t itemIndex = 0;
+                auto err = candidates[i]->findItem(nsIndex, datatype, key, itemIndex, item, chunkIdx, chunkStart);
+                if (err == ESP_OK) {
+                    page = candidates[i];
+                    return ESP_OK;
+                }
+            }
+            if (mKeyIndex.isComplete()) {
+                return ESP_ERR_NVS_NOT_FOUND;
+            }
+        }
+    }
+
     for (auto it = std::begin(mPageManager); it != std::end(mPageManager); ++it) {
         size_t itemIndex = 0;
         auto err = it->findItem(nsIndex, datatype, key, itemIndex, item, chunkIdx, chunkStart);
@@ -267,14 +329,8 @@ esp_err_t Storage::findItem(uint8_t nsIndex, ItemType datatype, const char* key,
     return ESP_ERR_NVS_NOT_FOUND;
 }
 
-esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const void* data, size_t dataSize, VerOffset chunkStart)
+size_t Storage::getMaxBlobSize()
 {
-    uint8_t chunkCount = 0;
-    TUsedPageList usedPages;
-    size_t remainingSize = dataSize;
-    size_t offset = 0;
-    esp_err_t err = ESP_OK;
-
     /* Check how much maximum data can be accommodated**/
     uint32_t max_pages = mPageManager.getPageCount() - 1;
 
@@ -282,7 +338,18 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
        max_pages = (Page::CHUNK_ANY-1)/2;
     }
 
-    if (dataSize > max_pages * Page::CHUNK_MAX_SIZE) {
+    return max_pages * Page::CHUNK_MAX_SIZE;
+}
+
+esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const void* data, size_t dataSize, VerOffset chunkStart)
+{
+    uint8_t chunkCount = 0;
+    TUsedPageList usedPages;
+    size_t remainingSize = dataSize;
+    size_t offset = 0;
+    esp_err_t err = ESP_OK;
+
+    if (dataSize > getMaxBlobSize()) {
         return ESP_ERR_NVS_VALUE_TOO_LONG;
     }
 
@@ -298,7 +365,7 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
                     return err;
                 }
             }
-            err = mPageManager.requestNewPage();
+            err = requestNewPage();
             if (err != ESP_OK) {
                 return err;
             } else if(getCurrentPage().getVarDataTailroom() == tailroom) {
@@ -326,6 +393,7 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
             NVS_ASSERT_OR_RETURN(err != ESP_ERR_NVS_PAGE_FULL, err);
             break;
         } else {
+            mKeyIndex.insert(nsIndex, key, &page);
             UsedPageNode* node = new (std::nothrow) UsedPageNode();
             if (!node) {
                 err = ESP_ERR_NO_MEM;
@@ -340,7 +408,7 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
                         break;
                     }
                 }
-                err = mPageManager.requestNewPage();
+                err = requestNewPage();
                 if (err != ESP_OK) {
                     break;
                 }
@@ -357,6 +425,9 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
 
             err = getCurrentPage().writeItem(nsIndex, ItemType::BLOB_IDX, key, item.data, sizeof(item.data));
             NVS_ASSERT_OR_RETURN(err != ESP_ERR_NVS_PAGE_FULL, err);
+            if (err == ESP_OK) {
+                mKeyIndex.insert(nsIndex, key, &getCurrentPage());
+            }
             break;
         }
     } while (1);
@@ -365,7 +436,9 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
         /* Anything failed, then we should erase all the written chunks*/
         int ii=0;
         for (auto it = std::begin(usedPages); it != std::end(usedPages); it++) {
-            it->mPage->eraseItem(nsIndex, ItemType::BLOB_DATA, key, ii++);
+            if (it->mPage->eraseItem(nsIndex, ItemType::BLOB_DATA, key, ii++) == ESP_OK) {
+                mKeyIndex.remove(nsIndex, key, it->mPage);
+            }
         }
     }
     usedPages.clearAndFreeNodes();
@@ -378,6 +451,8 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
         return ESP_ERR_NVS_NOT_INITIALIZED;
     }
 
+    mValueCache.invalidate(nsIndex, key);
+
     Page* findPage = nullptr;
     bool matchedTypePageFound = false;
     Item item;
@@ -480,7 +555,7 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
                     return err;
                 }
             }
-            err = mPageManager.requestNewPage();
+            err = requestNewPage();
             if (err != ESP_OK) {
                 return err;
             }
@@ -495,6 +570,7 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
         } else if (err != ESP_OK) {
             return err;
         }
+        mKeyIndex.insert(nsIndex, key, &getCurrentPage());
     }
 
     if (findPage) {
@@ -520,6 +596,7 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
         if (err != ESP_OK) {
             return err;
         }
+        mKeyIndex.remove(nsIndex, key, findPage);
     }
 #ifdef DEBUG_STORAGE
     debugCheck();
@@ -678,10 +755,27 @@ esp_err_t Storage::readItem(uint8_t nsIndex, ItemType datatype, const char* key,
         return ESP_ERR_NVS_NOT_INITIALIZED;
     }
 
+    const uint8_t* cachedData;
+    size_t cachedSize;
+    if (mValueCache.find(nsIndex, datatype, key, cachedData, cachedSize)) {
+        // size mismatches are left to the flash read path to report
+        bool sizeMatches = isVariableLengthType(datatype) ? (dataSize >= cachedSize) : (dataSize == cachedSize);
+        if (datatype == ItemType::BLOB) {
+            sizeMatches = (dataSize == cachedSize);
+        }
+        if (sizeMatches) {
+            memcpy(data, cachedData, cachedSize);
+            return ESP_OK;
+        }
+    }
+
     Item item;
     Page* findPage = nullptr;
     if (datatype == ItemType::BLOB) {
         auto err = readMultiPageBlob(nsIndex, key, data, dataSize);
+        if (err == ESP_OK) {
+            mValueCache.insert(nsIndex, datatype, key, data, dataSize);
+        }
         if (err != ESP_ERR_NVS_NOT_FOUND) {
             return err;
         } // else check if the blob is stored with earlier version format without index
@@ -691,8 +785,12 @@ esp_err_t Storage::readItem(uint8_t nsIndex, ItemType datatype, const char* key,
     if (err != ESP_OK) {
         return err;
     }
-    return findPage->readItem(nsIndex, datatype, key, data, dataSize);
-
+    err = findPage->readItem(nsIndex, datatype, key, data, dataSize);
+    if (err == ESP_OK) {
+        mValueCache.insert(nsIndex, datatype, key, data,
+                           isVariableLengthType(datatype) ? item.varLength.dataSize : dataSize);
+    }
+    return err;
 }
 
 esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffset chunkStart)
@@ -703,6 +801,8 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
     Item item;
     Page* findPage = nullptr;
 
+    mValueCache.invalidate(nsIndex, key);
+
     auto err = findItem(nsIndex, ItemType::BLOB_IDX, key, findPage, item, Page::CHUNK_ANY, chunkStart);
     if (err != ESP_OK) {
         return err;
@@ -712,6 +812,7 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
     if (err != ESP_OK) {
         return err;
     }
+    mKeyIndex.remove(nsIndex, key, findPage);
 
     // If caller requires delete of VER_ANY
     // We may face dirty NVS partition and version duplicates can be there
@@ -724,6 +825,7 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
             if (err != ESP_OK) {
                 return err;
             }
+            mKeyIndex.remove(nsIndex, key, findPage);
         } else if (err != ESP_ERR_NVS_NOT_FOUND) {
             return err;
         }
@@ -749,6 +851,9 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
                 // check if item.chunkIndex is within the version range indicated by chunkStart, if so, delete it
                 if((item.chunkIndex >= minChunkIndex) && (item.chunkIndex < maxChunkIndex)) {
                     err = it->eraseEntryAndSpan(itemIndex);
+                    if (err == ESP_OK) {
+                        mKeyIndex.remove(nsIndex, key, it);
+                    }
                 }
 
                 // continue findItem until end of page
@@ -763,6 +868,281 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
     return ESP_OK;
 }
 
+esp_err_t Storage::beginBlobWrite(uint8_t nsIndex, const char* key, BlobWriter& writer)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    if (strlen(key) > Item::MAX_KEY_LENGTH) {
+        return ESP_ERR_NVS_KEY_TOO_LONG;
+    }
+
+    Item item;
+    Page* findPage = nullptr;
+    auto err = findItem(nsIndex, ItemType::BLOB_IDX, key, findPage, item);
+    if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
+        return err;
+    }
+
+    strlcpy(writer.key, key, sizeof(writer.key));
+    writer.nsIndex = nsIndex;
+    writer.replacing = (err == ESP_OK);
+    writer.prevStart = writer.replacing ? item.blobIndex.chunkStart : VerOffset::VER_0_OFFSET;
+    NVS_ASSERT_OR_RETURN(writer.prevStart == VerOffset::VER_0_OFFSET || writer.prevStart == VerOffset::VER_1_OFFSET, ESP_FAIL);
+    /* Toggle the version, the existing blob stays readable until the new one is complete */
+    writer.chunkStart = (writer.replacing && writer.prevStart == VerOffset::VER_0_OFFSET)
+                        ? VerOffset::VER_1_OFFSET : VerOffset::VER_0_OFFSET;
+    writer.chunkCount = 0;
+    writer.dataSize = 0;
+    writer.bufferUsed = 0;
+    writer.buffer = new (std::nothrow) uint8_t[Page::CHUNK_MAX_SIZE];
+    if (!writer.buffer) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t Storage::flushBlobData(BlobWriter& writer, bool all)
+{
+    esp_err_t err;
+
+    /* Without all, only a full buffer is written, and the rest of it stays buffered if the
+     * current page has less room. With all, an empty blob is stored as one empty chunk. */
+    while (all ? (writer.bufferUsed > 0 || writer.chunkCount == 0) : writer.bufferUsed == Page::CHUNK_MAX_SIZE) {
+        if (writer.chunkCount == (Page::CHUNK_ANY-1)/2) {
+            return ESP_ERR_NVS_VALUE_TOO_LONG;
+        }
+
+        Page& page = getCurrentPage();
+        size_t tailroom = page.getVarDataTailroom();
+        if (tailroom == 0 || (tailroom < writer.bufferUsed && tailroom < Page::CHUNK_MAX_SIZE/10)) {
+            /* The tailroom is too small for a chunk */
+            if (page.state() != Page::PageState::FULL) {
+                err = page.markFull();
+                if (err != ESP_OK) {
+                    return err;
+                }
+            }
+            err = requestNewPage();
+            if (err != ESP_OK) {
+                return err;
+            } else if (getCurrentPage().getVarDataTailroom() == tailroom) {
+                /* We got the same page or we are not improving.*/
+                return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+            }
+            continue;
+        }
+
+        size_t chunkSize = (writer.bufferUsed > tailroom) ? tailroom : writer.bufferUsed;
+        err = page.writeItem(writer.nsIndex, ItemType::BLOB_DATA, writer.key, writer.buffer, chunkSize,
+                             static_cast<uint8_t> (writer.chunkStart) + writer.chunkCount);
+        if (err != ESP_OK) {
+            NVS_ASSERT_OR_RETURN(err != ESP_ERR_NVS_PAGE_FULL, err);
+            return err;
+        }
+        mKeyIndex.insert(writer.nsIndex, writer.key, &page);
+        writer.chunkCount++;
+        memmove(writer.buffer, writer.buffer + chunkSize, writer.bufferUsed - chunkSize);
+        writer.bufferUsed -= chunkSize;
+
+        if ((tailroom - chunkSize) < Page::ENTRY_SIZE) {
+            if (page.state() != Page::PageState::FULL) {
+                err = page.markFull();
+                if (err != ESP_OK) {
+                    return err;
+                }
+            }
+            err = requestNewPage();
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t Storage::appendBlobData(BlobWriter& writer, const void* data, size_t dataSize)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    if (dataSize > getMaxBlobSize() - writer.dataSize) {
+        return ESP_ERR_NVS_VALUE_TOO_LONG;
+    }
+
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    while (dataSize > 0) {
+        size_t copySize = Page::CHUNK_MAX_SIZE - writer.bufferUsed;
+        copySize = (dataSize < copySize) ? dataSize : copySize;
+        memcpy(writer.buffer + writer.bufferUsed, src, copySize);
+        writer.bufferUsed += copySize;
+        writer.dataSize += copySize;
+        src += copySize;
+        dataSize -= copySize;
+
+        auto err = flushBlobData(writer, false);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t Storage::finishBlobWrite(BlobWriter& writer)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    auto err = flushBlobData(writer, true);
+    if (err == ESP_OK) {
+        /* All chunks are stored. Now store the index.*/
+        Item item;
+        std::fill_n(item.data, sizeof(item.data), 0xff);
+        item.blobIndex.dataSize = writer.dataSize;
+        item.blobIndex.chunkCount = writer.chunkCount;
+        item.blobIndex.chunkStart = writer.chunkStart;
+
+        /* Other items may have been written to the page since the last chunk */
+        err = getCurrentPage().writeItem(writer.nsIndex, ItemType::BLOB_IDX, writer.key, item.data, sizeof(item.data));
+        if (err == ESP_ERR_NVS_PAGE_FULL) {
+            Page& page = getCurrentPage();
+            err = (page.state() != Page::PageState::FULL) ? page.markFull() : ESP_OK;
+            if (err == ESP_OK) {
+                err = requestNewPage();
+            }
+            if (err == ESP_OK) {
+                err = getCurrentPage().writeItem(writer.nsIndex, ItemType::BLOB_IDX, writer.key, item.data, sizeof(item.data));
+                if (err == ESP_ERR_NVS_PAGE_FULL) {
+                    err = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+                }
+            }
+        }
+    }
+    if (err != ESP_OK) {
+        abortBlobWrite(writer);
+        return err;
+    }
+    mKeyIndex.insert(writer.nsIndex, writer.key, &getCurrentPage());
+    mValueCache.invalidate(writer.nsIndex, writer.key);
+
+    // the chunks belong to the stored blob now
+    writer.chunkCount = 0;
+    delete [] writer.buffer;
+    writer.buffer = nullptr;
+
+    if (writer.replacing) {
+        /* Erase the blob with earlier version*/
+        err = eraseMultiPageBlob(writer.nsIndex, writer.key, writer.prevStart);
+        if (err == ESP_ERR_FLASH_OP_FAIL) {
+            return ESP_ERR_NVS_REMOVE_FAILED;
+        }
+        return err;
+    }
+
+    /* Support for earlier versions where BLOBS were stored without index */
+    Page* findPage = nullptr;
+    Item item;
+    err = findItem(writer.nsIndex, ItemType::BLOB, writer.key, findPage, item);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        return ESP_OK;
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = findPage->eraseItem(writer.nsIndex, ItemType::BLOB, writer.key);
+    if (err == ESP_ERR_FLASH_OP_FAIL) {
+        return ESP_ERR_NVS_REMOVE_FAILED;
+    }
+    if (err == ESP_OK) {
+        mKeyIndex.remove(writer.nsIndex, writer.key, findPage);
+    }
+    return err;
+}
+
+void Storage::abortBlobWrite(BlobWriter& writer)
+{
+    /* Erase the chunks written so far, the ones left behind by a failure are orphans which init() erases */
+    for (uint8_t chunkNum = 0; chunkNum < writer.chunkCount && mState == StorageState::ACTIVE; chunkNum++) {
+        const uint8_t chunkIdx = static_cast<uint8_t> (writer.chunkStart) + chunkNum;
+        Page* findPage = nullptr;
+        Item item;
+        if (findItem(writer.nsIndex, ItemType::BLOB_DATA, writer.key, findPage, item, chunkIdx) == ESP_OK &&
+                findPage->eraseItem(writer.nsIndex, ItemType::BLOB_DATA, writer.key, chunkIdx) == ESP_OK) {
+            mKeyIndex.remove(writer.nsIndex, writer.key, findPage);
+        }
+    }
+    writer.chunkCount = 0;
+    delete [] writer.buffer;
+    writer.buffer = nullptr;
+}
+
+esp_err_t Storage::readBlobPart(uint8_t nsIndex, const char* key, size_t offset, void* data, size_t& dataSize)
+{
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    Item item;
+    Page* findPage = nullptr;
+    auto err = findItem(nsIndex, ItemType::BLOB_IDX, key, findPage, item);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        /* Support for earlier versions where BLOBS were stored without index */
+        err = findItem(nsIndex, ItemType::BLOB, key, findPage, item);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (offset > item.varLength.dataSize) {
+            return ESP_ERR_NVS_INVALID_LENGTH;
+        }
+        dataSize = std::min(dataSize, item.varLength.dataSize - offset);
+        return findPage->readItemPart(nsIndex, ItemType::BLOB, key, offset, data, dataSize);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    const uint8_t chunkCount = item.blobIndex.chunkCount;
+    const VerOffset chunkStart = item.blobIndex.chunkStart;
+    const size_t blobSize = item.blobIndex.dataSize;
+    if (offset > blobSize) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    dataSize = std::min(dataSize, blobSize - offset);
+
+    /* Read only the chunks which overlap the requested part */
+    uint8_t* dst = static_cast<uint8_t*>(data);
+    size_t chunkOffset = 0;
+    for (uint8_t chunkNum = 0; chunkNum < chunkCount && chunkOffset < offset + dataSize; chunkNum++) {
+        const uint8_t chunkIdx = static_cast<uint8_t> (chunkStart) + chunkNum;
+        err = findItem(nsIndex, ItemType::BLOB_DATA, key, findPage, item, chunkIdx);
+        if (err != ESP_OK) {
+            break;
+        }
+        const size_t chunkSize = item.varLength.dataSize;
+        if (chunkOffset + chunkSize > offset) {
+            const size_t from = (offset > chunkOffset) ? offset - chunkOffset : 0;
+            const size_t to = std::min(chunkSize, offset + dataSize - chunkOffset);
+            err = findPage->readItemPart(nsIndex, ItemType::BLOB_DATA, key, from, dst + chunkOffset + from - offset, to - from, chunkIdx);
+            if (err != ESP_OK) {
+                break;
+            }
+        }
+        chunkOffset += chunkSize;
+    }
+
+    if (err == ESP_OK && chunkOffset < offset + dataSize) {
+        /* The size of the entry in the index is inconsistent with the sum of the sizes of chunks */
+        err = ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    if (err == ESP_ERR_NVS_NOT_FOUND || err == ESP_ERR_NVS_INVALID_LENGTH) {
+        // cleanup if a chunk is not found or the size is inconsistent
+        eraseMultiPageBlob(nsIndex, key);
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    return err;
+}
+
 esp_err_t Storage::eraseItem(uint8_t nsIndex, ItemType datatype, const char* key)
 {
     if (mState != StorageState::ACTIVE) {
@@ -773,6 +1153,8 @@ esp_err_t Storage::eraseItem(uint8_t nsIndex, ItemType datatype, const char* key
         return eraseMultiPageBlob(nsIndex, key);
     }
 
+    mValueCache.invalidate(nsIndex, key);
+
     Item item;
     Page* findPage = nullptr;
     auto err = findItem(nsIndex, datatype, key, findPage, item);
@@ -784,7 +1166,11 @@ esp_err_t Storage::eraseItem(uint8_t nsIndex, ItemType datatype, const char* key
         return eraseMultiPageBlob(nsIndex, key);
     }
 
-    return findPage->eraseItem(nsIndex, datatype, key);
+    err = findPage->eraseItem(nsIndex, datatype, key);
+    if (err == ESP_OK) {
+        mKeyIndex.remove(nsIndex, key, findPage);
+    }
+    return err;
 }
 
 esp_err_t Storage::eraseNamespace(uint8_t nsIndex)
@@ -793,6 +1179,8 @@ esp_err_t Storage::eraseNamespace(uint8_t nsIndex)
         return ESP_ERR_NVS_NOT_INITIALIZED;
     }
 
+    mValueCache.invalidateNamespace(nsIndex);
+
     for (auto it = std::begin(mPageManager); it != std::end(mPageManager); ++it) {
         while (true) {
             auto err = it->eraseItem(nsIndex, ItemType::ANY, nullptr);
@@ -804,6 +1192,7 @@ esp_err_t Storage::eraseNamespace(uint8_t nsIndex)
             }
         }
     }
+    mKeyIndex.removeNamespace(nsIndex);
     return ESP_OK;
 
 }
@@ -834,6 +1223,11 @@ esp_err_t Storage::getItemDataSize(uint8_t nsIndex, ItemType datatype, const cha
         return ESP_ERR_NVS_NOT_INITIALIZED;
     }
 
+    const uint8_t* cachedData;
+    if (mValueCache.find(nsIndex, datatype, key, cachedData, dataSize)) {
+        return ESP_OK;
+    }
+
     Item item;
     Page* findPage = nullptr;
     auto err = findItem(nsIndex, datatype, key, findPage, item);
@@ -893,6 +1287,36 @@ esp_err_t Storage::fillStats(nvs_stats_t& nvsStats)
     return mPageManager.fillStats(nvsStats);
 }
 
+esp_err_t Storage::collectGarbage(size_t maxFreeEntries, bool& compacted)
+{
+    compacted = false;
+
+    if (mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    if (!mPageManager.isCompactionDue(maxFreeEntries)) {
+        return ESP_OK;
+    }
+
+    // Do now what the next write running out of space in the active page would have to do
+    Page& page = getCurrentPage();
+    if (page.state() == Page::PageState::ACTIVE) {
+        auto err = page.markFull();
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    auto err = requestNewPage();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    compacted = true;
+    return ESP_OK;
+}
+
 esp_err_t Storage::calcEntriesInNamespace(uint8_t nsIndex, size_t& usedEntries)
 {
     usedEntries = 0;
@@ -13,6 +13,8 @@
 #include "nvs_types.hpp"
 #include "nvs_page.hpp"
 #include "nvs_pagemanager.hpp"
+#include "nvs_key_index.hpp"
+#include "nvs_value_cache.hpp"
 #include "nvs_memory_management.hpp"
 #include "partition.hpp"
 
@@ -56,6 +58,22 @@ class Storage : public intrusive_list_node<Storage>, public ExceptionlessAllocat
     typedef intrusive_list<BlobIndexNode> TBlobIndexList;
 
 public:
+    /**
+     * State of a blob which is written in parts by appendBlobData().
+     * The data is buffered until it fills the rest of a page, then it is written as one chunk.
+     */
+    struct BlobWriter {
+        char key[Item::MAX_KEY_LENGTH + 1];
+        uint8_t nsIndex;
+        bool replacing;         // an indexed blob with this key exists and is erased by finishBlobWrite()
+        VerOffset prevStart;    // version of the existing blob
+        VerOffset chunkStart;   // version of the blob being written
+        uint8_t chunkCount;
+        size_t dataSize;
+        uint8_t* buffer;        // Page::CHUNK_MAX_SIZE bytes
+        size_t bufferUsed;
+    };
+
     ~Storage();
 
     Storage(Partition *partition) : mPartition(partition) {
@@ -122,12 +140,29 @@ public:
 
     esp_err_t eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffset chunkStart = VerOffset::VER_ANY);
 
+    esp_err_t beginBlobWrite(uint8_t nsIndex, const char* key, BlobWriter& writer);
+
+    esp_err_t appendBlobData(BlobWriter& writer, const void* data, size_t dataSize);
+
+    esp_err_t finishBlobWrite(BlobWriter& writer);
+
+    void abortBlobWrite(BlobWriter& writer);
+
+    esp_err_t readBlobPart(uint8_t nsIndex, const char* key, size_t offset, void* data, size_t& dataSize);
+
     void debugDump();
 
     void debugCheck();
 
     esp_err_t fillStats(nvs_stats_t& nvsStats);
 
+    void fillValueCacheStats(nvs_value_cache_stats_t& stats) const
+    {
+        mValueCache.fillStats(stats);
+    }
+
+    esp_err_t collectGarbage(size_t maxFreeEntries, bool& compacted);
+
     esp_err_t calcEntriesInNamespace(uint8_t nsIndex, size_t& usedEntries);
 
     bool findEntry(nvs_opaque_iterator_t* it, const char* name);
@@ -155,6 +190,14 @@ protected:
 
     esp_err_t findItem(uint8_t nsIndex, ItemType datatype, const char* key, Page* &page, Item& item, uint8_t chunkIdx = Page::CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
 
+    esp_err_t requestNewPage();
+
+    size_t getMaxBlobSize();
+
+    esp_err_t flushBlobData(BlobWriter& writer, bool all);
+
+    void buildKeyIndex();
+
 protected:
     Partition *mPartition;
     size_t mPageCount;
@@ -162,6 +205,12 @@ protected:
     TNamespaces mNamespaces;
     CompressedEnumTable<bool, 1, 256> mNamespaceUsage;
     StorageState mState = StorageState::INVALID;
+    KeyIndex mKeyIndex;
+#ifdef CONFIG_NVS_VALUE_CACHE
+    ValueCache mValueCache{CONFIG_NVS_VALUE_CACHE_SIZE, CONFIG_NVS_VALUE_CACHE_MAX_ITEM_SIZE};
+#else
+    ValueCache mValueCache;
+#endif
 };
 
 } // namespace nvs
@@ -6,7 +6,7 @@
 #include "nvs_types.hpp"
 #include "nvs_page.hpp"
 #include "esp_log.h"
-#include "esp_rom_crc.h"
+#include "esp_crc.h"
 
 #define TAG "nvs"
 
@@ -15,10 +15,10 @@ uint32_t Item::calculateCrc32() const
 {
     uint32_t result = 0xffffffff;
     const uint8_t* p = reinterpret_cast<const uint8_t*>(this);
-    result = esp_rom_crc32_le(result, p + offsetof(Item, nsIndex),
-                              offsetof(Item, crc32) - offsetof(Item, nsIndex));
-    result = esp_rom_crc32_le(result, p + offsetof(Item, key), sizeof(key));
-    result = esp_rom_crc32_le(result, p + offsetof(Item, data), sizeof(data));
+    result = esp_crc32_le(result, p + offsetof(Item, nsIndex),
+                          offsetof(Item, crc32) - offsetof(Item, nsIndex));
+    result = esp_crc32_le(result, p + offsetof(Item, key), sizeof(key));
+    result = esp_crc32_le(result, p + offsetof(Item, data), sizeof(data));
     return result;
 }
 
@@ -26,17 +26,17 @@ uint32_t Item::calculateCrc32WithoutValue() const
 {
     uint32_t result = 0xffffffff;
     const uint8_t* p = reinterpret_cast<const uint8_t*>(this);
-    result = esp_rom_crc32_le(result, p + offsetof(Item, nsIndex),
-                              offsetof(Item, datatype) - offsetof(Item, nsIndex));
-    result = esp_rom_crc32_le(result, p + offsetof(Item, key), sizeof(key));
-    result = esp_rom_crc32_le(result, p + offsetof(Item, chunkIndex), sizeof(chunkIndex));
+    result = esp_crc32_le(result, p + offsetof(Item, nsIndex),
+                          offsetof(Item, datatype) - offsetof(Item, nsIndex));
+    result = esp_crc32_le(result, p + offsetof(Item, key), sizeof(key));
+    result = esp_crc32_le(result, p + offsetof(Item, chunkIndex), sizeof(chunkIndex));
     return result;
 }
 
 uint32_t Item::calculateCrc32(const uint8_t* data, size_t size)
 {
     uint32_t result = 0xffffffff;
-    result = esp_rom_crc32_le(result, data, size);
+    result = esp_crc32_le(result, data, size);
     return result;
 }
 
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstring>
+#include <new>
+#include "nvs_value_cache.hpp"
+
+namespace nvs
+{
+
+ValueCache::~ValueCache()
+{
+    clear();
+}
+
+bool ValueCache::find(uint8_t nsIndex, ItemType datatype, const char* key, const uint8_t* &data, size_t &dataSize)
+{
+    if (mCapacity == 0) {
+        return false;
+    }
+
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+        if (it->mNsIndex == nsIndex && it->mDatatype == datatype
+                && strncmp(it->mKey, key, Item::MAX_KEY_LENGTH) == 0) {
+            Entry* entry = it;
+            if (entry != &mEntries.front()) {
+                mEntries.erase(it);
+                mEntries.push_front(entry);
+            }
+            data = entry->data();
+            dataSize = entry->mDataSize;
+            ++mHits;
+            return true;
+        }
+    }
+
+    ++mMisses;
+    return false;
+}
+
+void ValueCache::insert(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize)
+{
+    if (dataSize > mMaxItemSize || sizeof(Entry) + dataSize > mCapacity) {
+        return;
+    }
+
+    // a value read in legacy format may already be cached under the same key
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+        if (it->mNsIndex == nsIndex && it->mDatatype == datatype
+                && strncmp(it->mKey, key, Item::MAX_KEY_LENGTH) == 0) {
+            erase(it);
+            break;
+        }
+    }
+
+    while (mUsed + sizeof(Entry) + dataSize > mCapacity) {
+        erase(&mEntries.back());
+    }
+
+    // the value is stored right behind the entry, Entry::data() relies on that
+    void* mem = Entry::operator new(sizeof(Entry) + dataSize, std::nothrow);
+    if (mem == nullptr) {
+        return;
+    }
+    Entry* entry = ::new (mem) Entry;
+    entry->mNsIndex = nsIndex;
+    entry->mDatatype = datatype;
+    strncpy(entry->mKey, key, sizeof(entry->mKey) - 1);
+    entry->mKey[sizeof(entry->mKey) - 1] = 0;
+    entry->mDataSize = dataSize;
+    memcpy(entry->data(), data, dataSize);
+
+    mEntries.push_front(entry);
+    mUsed += entry->footprint();
+}
+
+void ValueCache::invalidate(uint8_t nsIndex, const char* key)
+{
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+        Entry* entry = it;
+        ++it;
+        if (entry->mNsIndex == nsIndex && strncmp(entry->mKey, key, Item::MAX_KEY_LENGTH) == 0) {
+            erase(entry);
+        }
+    }
+}
+
+void ValueCache::invalidateNamespace(uint8_t nsIndex)
+{
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+        Entry* entry = it;
+        ++it;
+        if (entry->mNsIndex == nsIndex) {
+            erase(entry);
+        }
+    }
+}
+
+void ValueCache::clear()
+{
+    while (!mEntries.empty()) {
+        erase(&mEntries.front());
+    }
+}
+
+void ValueCache::fillStats(nvs_value_cache_stats_t& stats) const
+{
+    stats.hits = mHits;
+    stats.misses = mMisses;
+    stats.entry_count = mEntries.size();
+    stats.used_bytes = mUsed;
+    stats.capacity = mCapacity;
+}
+
+void ValueCache::erase(Entry* entry)
+{
+    mEntries.erase(entry);
+    mUsed -= entry->footprint();
+    delete entry;
+}
+
+} // namespace nvs
@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef nvs_value_cache_hpp
+#define nvs_value_cache_hpp
+
+#include <cstdint>
+#include <cstddef>
+#include "nvs.h"
+#include "nvs_types.hpp"
+#include "intrusive_list.h"
+#include "nvs_memory_management.hpp"
+
+namespace nvs
+{
+
+/**
+ * @brief Least recently used cache of item values read from flash.
+ *
+ * Entries are keyed by namespace index, item type and key. Storage adds the value of each successful read
+ * which is not larger than the maximum item size and drops all entries of a key before the key is written
+ * or erased. The total size of all entries, including their bookkeeping, never exceeds the capacity given
+ * on construction; the least recently used entries are evicted to make room for new ones.
+ * A cache constructed with zero capacity never stores anything.
+ */
+class ValueCache
+{
+public:
+    ValueCache(size_t capacity = 0, size_t maxItemSize = 0)
+        : mCapacity(capacity), mMaxItemSize(maxItemSize) { }
+
+    ~ValueCache();
+
+    /**
+     * Look up the cached value of <nsIndex, datatype, key> and count a hit or miss.
+     * On a hit, data points to the cached value until the next call modifying the cache.
+     */
+    bool find(uint8_t nsIndex, ItemType datatype, const char* key, const uint8_t* &data, size_t &dataSize);
+
+    /** Store a value which has just been read from flash */
+    void insert(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize);
+
+    /** Drop cached values of key, regardless of their type */
+    void invalidate(uint8_t nsIndex, const char* key);
+
+    /** Drop all cached values of namespace nsIndex */
+    void invalidateNamespace(uint8_t nsIndex);
+
+    /** Drop all cached values, the hit and miss counters are left unchanged */
+    void clear();
+
+    void fillStats(nvs_value_cache_stats_t& stats) const;
+
+private:
+    ValueCache(const ValueCache& other);
+    const ValueCache& operator= (const ValueCache& rhs);
+
+    struct Entry : public intrusive_list_node<Entry>, public ExceptionlessAllocatable {
+        uint8_t mNsIndex;
+        ItemType mDatatype;
+        char mKey[Item::MAX_KEY_LENGTH + 1];
+        size_t mDataSize;
+
+        uint8_t* data()
+        {
+            return reinterpret_cast<uint8_t*>(this + 1);
+        }
+
+        size_t footprint() const
+        {
+            return sizeof(Entry) + mDataSize;
+        }
+    };
+
+    typedef intrusive_list<Entry> TEntryList;
+
+    void erase(Entry* entry);
+
+    /** Most recently used entries first */
+    TEntryList mEntries;
+    size_t mCapacity;
+    size_t mMaxItemSize;
+    size_t mUsed = 0;
+    size_t mHits = 0;
+    size_t mMisses = 0;
+}; // class ValueCache
+
+} // namespace nvs
+
+#endif /* nvs_value_cache_hpp */
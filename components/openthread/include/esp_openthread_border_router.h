@@ -86,6 +86,21 @@ esp_err_t esp_openthread_rcp_deinit(void);
  */
 esp_err_t esp_openthread_rcp_init(void);
 
+/**
+ * @brief   Gets the statistics of the spinel link to RCP.
+ *
+ * @note The time spent sending a frame is the time the OpenThread task is blocked by the transfer, it can be used
+ *       with the byte counts to check whether the link is the bottleneck between the host and the radio.
+ *
+ * @param[out]  stats   The link statistics.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ *
+ */
+esp_err_t esp_openthread_rcp_get_link_stats(esp_openthread_rcp_link_stats_t *stats);
+
 /**
  * @brief   Sets the meshcop(e) instance name.
  *
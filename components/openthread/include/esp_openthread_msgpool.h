@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The usage statistics of the platform message pool
+ *
+ */
+typedef struct {
+    uint16_t internal_num;      /*!< The number of message buffers in internal RAM */
+    uint16_t internal_free;     /*!< The number of free message buffers in internal RAM */
+    uint16_t psram_num;         /*!< The number of message buffers in PSRAM */
+    uint16_t psram_free;        /*!< The number of free message buffers in PSRAM */
+    uint16_t min_free;          /*!< The minimum number of free message buffers since the pool was created */
+    uint32_t alloc_failed;      /*!< The number of allocations which failed because the pool was empty */
+} esp_openthread_msgpool_stats_t;
+
+/**
+ * @brief This function gets the usage statistics of the platform message pool.
+ *
+ * @note This function is only available when CONFIG_OPENTHREAD_PLATFORM_MSGPOOL_MANAGEMENT is enabled.
+ *       It should be called with the OpenThread lock held.
+ *
+ * @param[out] stats    The message pool statistics.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ *      - ESP_ERR_INVALID_STATE if the message pool isn't created
+ *
+ */
+esp_err_t esp_openthread_msgpool_get_stats(esp_openthread_msgpool_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -180,6 +180,20 @@ typedef struct {
 
 typedef void (*esp_openthread_rcp_failure_handler)(void);
 
+/**
+ * @brief The statistics of the spinel link to the RCP
+ *
+ */
+typedef struct {
+    uint64_t tx_frame_count;    /*!< The number of spinel frames sent to the RCP */
+    uint64_t tx_byte_count;     /*!< The number of spinel bytes sent to the RCP, without the link framing */
+    uint64_t tx_time_us;        /*!< The total time spent sending spinel frames, in microseconds */
+    uint32_t tx_max_time_us;    /*!< The longest time spent sending a spinel frame, in microseconds */
+    uint64_t rx_frame_count;    /*!< The number of spinel frames received from the RCP */
+    uint64_t rx_byte_count;     /*!< The number of spinel bytes received from the RCP, without the link framing */
+    uint64_t rx_drop_count;     /*!< The number of frames from the RCP dropped because they were invalid or too long */
+} esp_openthread_rcp_link_stats_t;
+
 #ifdef __cplusplus
 }
 #endif
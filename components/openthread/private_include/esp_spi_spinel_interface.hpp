@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -113,6 +113,14 @@ public:
      */
     const otRcpInterfaceMetrics *GetRcpInterfaceMetrics(void) const { return &mInterfaceMetrics; }
 
+    /**
+     * Returns the statistics of the link to the RCP.
+     *
+     * @returns The link statistics.
+     *
+     */
+    const esp_openthread_rcp_link_stats_t &GetLinkStats(void) const { return m_link_stats; }
+
     /**
      * This methods registers the callback for RCP failure.
      *
@@ -181,6 +189,7 @@ private:
     esp_openthread_rcp_failure_handler mRcpFailureHandler;
 
     otRcpInterfaceMetrics mInterfaceMetrics;
+    esp_openthread_rcp_link_stats_t m_link_stats;
 };
 
 } // namespace openthread
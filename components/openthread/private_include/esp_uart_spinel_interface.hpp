@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -122,6 +122,14 @@ public:
      */
     const otRcpInterfaceMetrics *GetRcpInterfaceMetrics(void) const { return &mInterfaceMetrics; }
 
+    /**
+     * Returns the statistics of the link to the RCP.
+     *
+     * @returns The link statistics.
+     *
+     */
+    const esp_openthread_rcp_link_stats_t &GetLinkStats(void) const { return m_link_stats; }
+
     /**
      * This methods registers the callback for RCP failure.
      *
@@ -189,6 +197,7 @@ private:
     int m_uart_fd;
 
     otRcpInterfaceMetrics mInterfaceMetrics;
+    esp_openthread_rcp_link_stats_t m_link_stats;
 
     // Non-copyable, intentionally not implemented.
     UartSpinelInterface(const UartSpinelInterface &);
@@ -4,9 +4,11 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdatomic.h>
 #include "esp_openthread_task_queue.h"
 #include "esp_check.h"
 #include "esp_err.h"
+#include "esp_heap_caps.h"
 #include "esp_openthread_common_macro.h"
 #include "esp_openthread_platform.h"
 #include "esp_openthread_types.h"
@@ -14,32 +16,103 @@
 #include "esp_vfs_eventfd.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/portmacro.h"
-#include "freertos/queue.h"
+#include "freertos/task.h"
 #include "openthread/tasklet.h"
 
-static QueueHandle_t s_task_queue = NULL;
-static int s_task_queue_event_fd = -1;
-static const char *task_queue_workflow = "task_queue";
-
 #define OT_TASK_QUEUE_SENDING_WAIT_TIME pdMS_TO_TICKS(100)
 
+/*
+ * The task queue is a bounded multi-producer single-consumer ring. Each slot carries a sequence number which tells
+ * whether it is free for the position a producer reserved, or holds a task for the position the mainloop reads next,
+ * so tasks and ISRs on any core post without a lock. The event fd is only written when the mainloop isn't already
+ * woken up, and the mainloop runs all queued tasks at each wakeup.
+ */
 typedef struct {
+    atomic_uint sequence;
     esp_openthread_task_t task;
     void *arg;
-} task_storage_t;
+} task_slot_t;
+
+static task_slot_t *s_task_slots = NULL;
+static uint32_t s_task_slot_mask = 0;
+static atomic_uint s_task_enqueue_pos;
+static uint32_t s_task_dequeue_pos = 0;
+static atomic_bool s_task_wakeup_pending;
+static int s_task_queue_event_fd = -1;
+static const char *task_queue_workflow = "task_queue";
 
 esp_err_t esp_openthread_task_queue_init(const esp_openthread_platform_config_t *config)
 {
+    uint32_t slot_count = 1;
+    while (slot_count < config->port_config.task_queue_size) {
+        slot_count <<= 1;
+    }
+
     s_task_queue_event_fd = eventfd(0, EFD_SUPPORT_ISR);
     ESP_RETURN_ON_FALSE(s_task_queue_event_fd >= 0, ESP_FAIL, OT_PLAT_LOG_TAG,
                         "Failed to create OpenThread task queue event fd");
-    s_task_queue = xQueueCreate(config->port_config.task_queue_size, sizeof(task_storage_t));
-    ESP_RETURN_ON_FALSE(s_task_queue != NULL, ESP_ERR_NO_MEM, OT_PLAT_LOG_TAG,
+    // Posted from ISRs, so the slots must stay accessible while the cache is disabled
+    s_task_slots = heap_caps_calloc(slot_count, sizeof(task_slot_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(s_task_slots != NULL, ESP_ERR_NO_MEM, OT_PLAT_LOG_TAG,
                         "Failed to create OpenThread task queue");
+    for (uint32_t i = 0; i < slot_count; i++) {
+        atomic_init(&s_task_slots[i].sequence, i);
+    }
+    s_task_slot_mask = slot_count - 1;
+    atomic_init(&s_task_enqueue_pos, 0);
+    s_task_dequeue_pos = 0;
+    atomic_init(&s_task_wakeup_pending, false);
     return esp_openthread_platform_workflow_register(&esp_openthread_task_queue_update,
                                                      &esp_openthread_task_queue_process, task_queue_workflow);
 }
 
+static bool IRAM_ATTR task_queue_push(esp_openthread_task_t task, void *arg)
+{
+    task_slot_t *slot;
+    uint32_t pos = atomic_load_explicit(&s_task_enqueue_pos, memory_order_relaxed);
+
+    while (true) {
+        slot = &s_task_slots[pos & s_task_slot_mask];
+        uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - pos);
+        if (diff == 0) {
+            // The slot is free, reserve it
+            if (atomic_compare_exchange_weak_explicit(&s_task_enqueue_pos, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The slot still holds the task posted one round earlier: the queue is full
+            return false;
+        } else {
+            // Another producer reserved the slot first
+            pos = atomic_load_explicit(&s_task_enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    slot->task = task;
+    slot->arg = arg;
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+    return true;
+}
+
+static bool task_queue_pop(esp_openthread_task_t *task, void **arg)
+{
+    task_slot_t *slot = &s_task_slots[s_task_dequeue_pos & s_task_slot_mask];
+    uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+    // Empty, or the producer which reserved the slot hasn't stored its task yet
+    if ((int32_t)(sequence - (s_task_dequeue_pos + 1)) < 0) {
+        return false;
+    }
+    *task = slot->task;
+    *arg = slot->arg;
+    // Free the slot for the position one round later
+    atomic_store_explicit(&slot->sequence, s_task_dequeue_pos + s_task_slot_mask + 1, memory_order_release);
+    s_task_dequeue_pos++;
+    return true;
+}
+
 void otTaskletsSignalPending(otInstance *aInstance)
 {
     uint64_t val = 1;
@@ -50,26 +123,25 @@ void otTaskletsSignalPending(otInstance *aInstance)
 
 esp_err_t IRAM_ATTR esp_openthread_task_queue_post(esp_openthread_task_t task, void *arg)
 {
-    task_storage_t task_storage = {
-        .task = task,
-        .arg = arg,
-    };
     uint64_t val = 1;
     ssize_t ret;
-    BaseType_t task_woken = pdFALSE;
 
     if (!xPortCanYield()) {
-        ESP_RETURN_ON_FALSE_ISR(xQueueSendFromISR(s_task_queue, &task_storage, &task_woken), ESP_FAIL, OT_PLAT_LOG_TAG,
+        ESP_RETURN_ON_FALSE_ISR(task_queue_push(task, arg), ESP_FAIL, OT_PLAT_LOG_TAG,
                                 "Failed to post task to OpenThread task queue");
     } else {
-        ESP_RETURN_ON_FALSE(xQueueSend(s_task_queue, &task_storage, OT_TASK_QUEUE_SENDING_WAIT_TIME), ESP_FAIL, OT_PLAT_LOG_TAG,
-                            "Failed to post task to OpenThread task queue");
+        TickType_t start = xTaskGetTickCount();
+        while (!task_queue_push(task, arg)) {
+            ESP_RETURN_ON_FALSE(xTaskGetTickCount() - start < OT_TASK_QUEUE_SENDING_WAIT_TIME, ESP_FAIL, OT_PLAT_LOG_TAG,
+                                "Failed to post task to OpenThread task queue");
+            vTaskDelay(1);
+        }
     }
-    ret = write(s_task_queue_event_fd, &val, sizeof(val));
-    assert(ret == sizeof(val));
 
-    if (task_woken) {
-        portYIELD_FROM_ISR_NO_ARG();
+    // One wakeup of the mainloop runs all the tasks posted until it clears the flag
+    if (!atomic_exchange(&s_task_wakeup_pending, true)) {
+        ret = write(s_task_queue_event_fd, &val, sizeof(val));
+        assert(ret == sizeof(val));
     }
     return ESP_OK;
 }
@@ -86,7 +158,8 @@ void esp_openthread_task_queue_update(esp_openthread_mainloop_context_t *mainloo
 
 esp_err_t esp_openthread_task_queue_process(otInstance *instance, const esp_openthread_mainloop_context_t *mainloop)
 {
-    task_storage_t task_storage;
+    esp_openthread_task_t task;
+    void *arg;
 
     if (FD_ISSET(s_task_queue_event_fd, &mainloop->read_fds)) {
         uint64_t val;
@@ -94,10 +167,15 @@ esp_err_t esp_openthread_task_queue_process(otInstance *instance, const esp_open
         assert(ret == sizeof(val));
     }
 
-    ESP_RETURN_ON_FALSE(s_task_queue != NULL, ESP_ERR_INVALID_STATE, OT_PLAT_LOG_TAG,
+    ESP_RETURN_ON_FALSE(s_task_slots != NULL, ESP_ERR_INVALID_STATE, OT_PLAT_LOG_TAG,
                         "OpenThread task queue not initialized");
-    while (xQueueReceive(s_task_queue, &task_storage, 0) == pdTRUE) {
-        task_storage.task(task_storage.arg);
+    // Cleared before draining, so a task posted after the last one taken wakes up the mainloop again. This has to be
+    // a read-modify-write: a plain store could be reordered after the loads of the slots, and a producer could still
+    // see the flag set after the mainloop found its slot empty. Either the exchange reads the flag set by a producer
+    // and the slots it published are visible, or that producer finds the flag cleared and writes the event fd.
+    atomic_exchange(&s_task_wakeup_pending, false);
+    while (task_queue_pop(&task, &arg)) {
+        task(arg);
     }
 
     return ESP_OK;
@@ -105,9 +183,9 @@ esp_err_t esp_openthread_task_queue_process(otInstance *instance, const esp_open
 
 esp_err_t esp_openthread_task_queue_deinit(void)
 {
-    if (s_task_queue) {
-        vQueueDelete(s_task_queue);
-        s_task_queue = NULL;
+    if (s_task_slots) {
+        free(s_task_slots);
+        s_task_slots = NULL;
     }
     if (s_task_queue_event_fd >= 0) {
         close(s_task_queue_event_fd);
@@ -1,52 +1,121 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include "openthread-core-config.h"
 #include "esp_openthread_common_macro.h"
+#include "esp_openthread_msgpool.h"
+#include "esp_check.h"
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
+#include "sdkconfig.h"
 #include "openthread/instance.h"
 #include "openthread/platform/messagepool.h"
 
-int s_buffer_pool_head = -1;
-otMessageBuffer **s_buffer_pool_pointer = NULL;
+/*
+ * The message buffers are split into two tiers. The first CONFIG_OPENTHREAD_MSGPOOL_INTERNAL_BUFFER_NUM buffers are
+ * allocated from internal RAM and handed out first, so the messages of a network with light traffic stay in fast
+ * memory. The others are allocated from PSRAM and only used when the internal buffers are exhausted. Each tier
+ * keeps its free buffers in a stack, and the tier of a freed buffer is found from its address.
+ */
 
-void otPlatMessagePoolInit(otInstance *aInstance, uint16_t aMinNumFreeBuffers, size_t aBufferSize)
+typedef struct {
+    otMessageBuffer *start;
+    otMessageBuffer *end;
+    otMessageBuffer **free_stack;
+    int head;
+    uint16_t num;
+} msgpool_tier_t;
+
+static msgpool_tier_t s_internal_tier;
+static msgpool_tier_t s_psram_tier;
+static uint16_t s_min_free;
+static uint32_t s_alloc_failed;
+
+static void msgpool_tier_init(msgpool_tier_t *tier, uint16_t num, size_t buffer_size, uint32_t caps)
 {
-    otMessageBuffer *buffer_pool = (otMessageBuffer *)heap_caps_calloc(aMinNumFreeBuffers, aBufferSize, MALLOC_CAP_SPIRAM);
-    s_buffer_pool_pointer = (otMessageBuffer **)heap_caps_calloc(aMinNumFreeBuffers, sizeof(otMessageBuffer **), MALLOC_CAP_SPIRAM);
-    if (buffer_pool == NULL || s_buffer_pool_pointer == NULL) {
+    tier->num = num;
+    tier->head = -1;
+    if (num == 0) {
+        return;
+    }
+    uint8_t *buffers = (uint8_t *)heap_caps_calloc(num, buffer_size, caps);
+    tier->free_stack = (otMessageBuffer **)heap_caps_calloc(num, sizeof(otMessageBuffer *), caps);
+    if (buffers == NULL || tier->free_stack == NULL) {
         ESP_LOGE(OT_PLAT_LOG_TAG, "Failed to create message buffer pool");
         assert(false);
     }
-    for (uint16_t i = 0; i < aMinNumFreeBuffers; i++) {
-        s_buffer_pool_pointer[i] = buffer_pool + i * aBufferSize / sizeof(otMessageBuffer);
+    for (uint16_t i = 0; i < num; i++) {
+        tier->free_stack[i] = (otMessageBuffer *)(buffers + i * buffer_size);
     }
-    s_buffer_pool_head = aMinNumFreeBuffers - 1;
-    ESP_LOGI(OT_PLAT_LOG_TAG, "Create message buffer pool successfully, size %d", aMinNumFreeBuffers*aBufferSize);
+    tier->start = (otMessageBuffer *)buffers;
+    tier->end = (otMessageBuffer *)(buffers + num * buffer_size);
+    tier->head = num - 1;
+}
+
+void otPlatMessagePoolInit(otInstance *aInstance, uint16_t aMinNumFreeBuffers, size_t aBufferSize)
+{
+    uint16_t internal_num = CONFIG_OPENTHREAD_MSGPOOL_INTERNAL_BUFFER_NUM;
+
+    if (internal_num > aMinNumFreeBuffers) {
+        internal_num = aMinNumFreeBuffers;
+    }
+    msgpool_tier_init(&s_internal_tier, internal_num, aBufferSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    msgpool_tier_init(&s_psram_tier, aMinNumFreeBuffers - internal_num, aBufferSize, MALLOC_CAP_SPIRAM);
+    s_min_free = aMinNumFreeBuffers;
+    s_alloc_failed = 0;
+    ESP_LOGI(OT_PLAT_LOG_TAG, "Create message buffer pool successfully, size %d (%d in internal RAM)",
+             aMinNumFreeBuffers * aBufferSize, internal_num * aBufferSize);
 }
 
 otMessageBuffer *otPlatMessagePoolNew(otInstance *aInstance)
 {
     otMessageBuffer *ret = NULL;
-    if (s_buffer_pool_head >= 0) {
-        ret = s_buffer_pool_pointer[s_buffer_pool_head];
-        s_buffer_pool_head--;
+    msgpool_tier_t *tier = s_internal_tier.head >= 0 ? &s_internal_tier : &s_psram_tier;
+
+    if (tier->head >= 0) {
+        ret = tier->free_stack[tier->head];
+        tier->head--;
+        uint16_t num_free = otPlatMessagePoolNumFreeBuffers(aInstance);
+        if (num_free < s_min_free) {
+            s_min_free = num_free;
+        }
+    } else {
+        s_alloc_failed++;
     }
     return ret;
 }
 
 void otPlatMessagePoolFree(otInstance *aInstance, otMessageBuffer *aBuffer)
 {
-    s_buffer_pool_head++;
-    s_buffer_pool_pointer[s_buffer_pool_head] = aBuffer;
+    msgpool_tier_t *tier = &s_psram_tier;
+
+    if (aBuffer >= s_internal_tier.start && aBuffer < s_internal_tier.end) {
+        tier = &s_internal_tier;
+    }
+    tier->head++;
+    tier->free_stack[tier->head] = aBuffer;
 }
 
 uint16_t otPlatMessagePoolNumFreeBuffers(otInstance *aInstance)
 {
-    return s_buffer_pool_head + 1;
+    return (s_internal_tier.head + 1) + (s_psram_tier.head + 1);
+}
+
+esp_err_t esp_openthread_msgpool_get_stats(esp_openthread_msgpool_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats != NULL, ESP_ERR_INVALID_ARG, OT_PLAT_LOG_TAG, "Invalid stats");
+    ESP_RETURN_ON_FALSE(s_internal_tier.free_stack != NULL || s_psram_tier.free_stack != NULL, ESP_ERR_INVALID_STATE,
+                        OT_PLAT_LOG_TAG, "Message pool isn't created");
+
+    stats->internal_num = s_internal_tier.num;
+    stats->internal_free = s_internal_tier.head + 1;
+    stats->psram_num = s_psram_tier.num;
+    stats->psram_free = s_psram_tier.head + 1;
+    stats->min_free = s_min_free;
+    stats->alloc_failed = s_alloc_failed;
+    return ESP_OK;
 }
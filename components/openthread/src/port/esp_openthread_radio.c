@@ -604,10 +604,10 @@ static void IRAM_ATTR convert_to_ot_frame(uint8_t *data, esp_ieee802154_frame_in
     radio_frame->mInfo.mRxInfo.mRssi = frame_info->rssi;
     radio_frame->mInfo.mRxInfo.mLqi = frame_info->lqi;
     radio_frame->mInfo.mRxInfo.mAckedWithFramePending = frame_info->pending;
-    radio_frame->mInfo.mRxInfo.mTimestamp = otPlatTimeGet();
-
 #if OPENTHREAD_CONFIG_MAC_CSL_RECEIVER_ENABLE
     radio_frame->mInfo.mRxInfo.mTimestamp = frame_info->timestamp;
+#else
+    radio_frame->mInfo.mRxInfo.mTimestamp = otPlatTimeGet();
 #endif // OPENTHREAD_CONFIG_MAC_CSL_RECEIVER_ENABLE
 }
 
@@ -714,8 +714,11 @@ void IRAM_ATTR esp_ieee802154_receive_done(uint8_t *data, esp_ieee802154_frame_i
     s_with_security_enh_ack = false;
 #endif // OPENTHREAD_CONFIG_THREAD_VERSION >= OT_THREAD_VERSION_1_2
     s_recv_queue.tail = (s_recv_queue.tail + 1) % CONFIG_IEEE802154_RX_BUFFER_SIZE;
-    atomic_fetch_add(&s_recv_queue.used, 1);
-    set_event(EVENT_RX_DONE);
+    // The frames are handed to OpenThread in place and esp_openthread_radio_process drains the whole queue,
+    // so the main loop only needs to be woken up for the first frame of a burst.
+    if (atomic_fetch_add(&s_recv_queue.used, 1) == 0) {
+        set_event(EVENT_RX_DONE);
+    }
 }
 
 void IRAM_ATTR esp_ieee802154_transmit_failed(const uint8_t *frame, esp_ieee802154_tx_error_t error)
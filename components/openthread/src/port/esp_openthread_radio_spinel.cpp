@@ -116,6 +116,13 @@ esp_err_t esp_openthread_rcp_deinit(void)
     return ESP_OK;
 }
 
+esp_err_t esp_openthread_rcp_get_link_stats(esp_openthread_rcp_link_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats != NULL, ESP_ERR_INVALID_ARG, OT_PLAT_LOG_TAG, "Invalid stats");
+    *stats = s_spinel_interface.GetSpinelInterface().GetLinkStats();
+    return ESP_OK;
+}
+
 esp_err_t esp_openthread_rcp_init(void)
 {
     const esp_openthread_radio_config_t *radio_config = esp_openthread_radio_config_get();
@@ -79,7 +79,9 @@ esp_err_t esp_openthread_uart_init_port(const esp_openthread_uart_config_t *conf
     ESP_RETURN_ON_ERROR(
         uart_set_pin(config->port, config->tx_pin, config->rx_pin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE),
         OT_PLAT_LOG_TAG, "uart_set_pin failed");
-    ESP_RETURN_ON_ERROR(uart_driver_install(config->port, ESP_OPENTHREAD_UART_BUFFER_SIZE, 0, 0, NULL, 0),
+    // The TX ring buffer lets the writes return once the data is queued, the driver ISR feeds the FIFO.
+    ESP_RETURN_ON_ERROR(uart_driver_install(config->port, ESP_OPENTHREAD_UART_BUFFER_SIZE, ESP_OPENTHREAD_UART_BUFFER_SIZE,
+                                            0, NULL, 0),
                         OT_PLAT_LOG_TAG, "uart_driver_install failed");
     uart_vfs_dev_use_driver(config->port);
     return ESP_OK;
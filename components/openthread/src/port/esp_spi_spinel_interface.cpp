@@ -18,6 +18,7 @@
 #include "driver/spi_master.h"
 #include "hal/gpio_types.h"
 #include "ncp/ncp_spi.hpp"
+#include "openthread/platform/time.h"
 
 using ot::Spinel::SpiFrame;
 using ot::Spinel::SpinelInterface;
@@ -31,6 +32,7 @@ SpiSpinelInterface::SpiSpinelInterface(void)
     , m_receiver_frame_context(nullptr)
     , m_receive_frame_buffer(nullptr)
     , mRcpFailureHandler(nullptr)
+    , m_link_stats()
 {
 }
 
@@ -117,7 +119,15 @@ otError SpiSpinelInterface::SendFrame(const uint8_t *frame, uint16_t length)
     memcpy(&m_tx_buffer[kSPIFrameHeaderSize], frame, length);
     uint16_t rx_data_size =
         length < kSmallPacketSize ? kSmallPacketSize : length; // We'll use tx_size to receive small packets piggybacked
+    uint64_t start = otPlatTimeGet();
     if (ConductSPITransaction(false, length, rx_data_size) == ESP_OK) {
+        uint32_t tx_time = static_cast<uint32_t>(otPlatTimeGet() - start);
+        m_link_stats.tx_frame_count++;
+        m_link_stats.tx_byte_count += length;
+        m_link_stats.tx_time_us += tx_time;
+        if (tx_time > m_link_stats.tx_max_time_us) {
+            m_link_stats.tx_max_time_us = tx_time;
+        }
         return OT_ERROR_NONE;
     } else {
         return OT_ERROR_FAILED;
@@ -183,8 +193,11 @@ esp_err_t SpiSpinelInterface::ConductSPITransaction(bool reset, uint16_t tx_data
             ESP_LOGW(OT_PLAT_LOG_TAG, "insufficient buffer space to hold a frame of length %d...",
                      rx_frame.GetHeaderDataLen());
             m_receive_frame_buffer->DiscardFrame();
+            m_link_stats.rx_drop_count++;
             return ESP_ERR_NO_MEM;
         }
+        m_link_stats.rx_frame_count++;
+        m_link_stats.rx_byte_count += rx_frame.GetHeaderDataLen();
         m_receiver_frame_callback(m_receiver_frame_context);
     } else {
         m_pending_data_len = 0;
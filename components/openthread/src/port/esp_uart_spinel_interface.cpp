@@ -32,6 +32,7 @@ UartSpinelInterface::UartSpinelInterface(void)
     , m_receiver_frame_context(nullptr)
     , m_receive_frame_buffer(nullptr)
     , m_uart_fd(-1)
+    , m_link_stats()
     , mRcpFailureHandler(nullptr)
 {
 }
@@ -93,7 +94,17 @@ otError UartSpinelInterface::SendFrame(const uint8_t *frame, uint16_t length)
     SuccessOrExit(error = hdlc_encoder.Encode(frame, length));
     SuccessOrExit(error = hdlc_encoder.EndFrame());
 
-    SuccessOrExit(error = Write(encoder_buffer.GetFrame(), encoder_buffer.GetLength()));
+    {
+        uint64_t start = otPlatTimeGet();
+        SuccessOrExit(error = Write(encoder_buffer.GetFrame(), encoder_buffer.GetLength()));
+        uint32_t tx_time = static_cast<uint32_t>(otPlatTimeGet() - start);
+        m_link_stats.tx_frame_count++;
+        m_link_stats.tx_byte_count += length;
+        m_link_stats.tx_time_us += tx_time;
+        if (tx_time > m_link_stats.tx_max_time_us) {
+            m_link_stats.tx_max_time_us = tx_time;
+        }
+    }
 
 exit:
     if (error != OT_ERROR_NONE) {
@@ -115,13 +126,13 @@ void UartSpinelInterface::Process(const void *aMainloopContext)
 
 int UartSpinelInterface::TryReadAndDecode(void)
 {
-    uint8_t buffer[UART_HW_FIFO_LEN(m_uart_config.port)];
     ssize_t rval;
 
+    // Read up to a whole frame at once, the UART driver buffers the bytes received since the last read.
     do {
-        rval = read(m_uart_fd, buffer, sizeof(buffer));
+        rval = read(m_uart_fd, m_uart_rx_buffer, kMaxFrameSize);
         if (rval > 0) {
-            m_hdlc_decoder.Decode(buffer, static_cast<uint16_t>(rval));
+            m_hdlc_decoder.Decode(m_uart_rx_buffer, static_cast<uint16_t>(rval));
         }
     } while (rval > 0);
 
@@ -250,9 +261,12 @@ void UartSpinelInterface::HandleHdlcFrame(otError error)
 {
     if (error == OT_ERROR_NONE) {
         ESP_LOGD(OT_PLAT_LOG_TAG, "received hdlc radio frame");
+        m_link_stats.rx_frame_count++;
+        m_link_stats.rx_byte_count += m_receive_frame_buffer->GetLength();
         m_receiver_frame_callback(m_receiver_frame_context);
     } else {
         ESP_LOGE(OT_PLAT_LOG_TAG, "dropping radio frame: %s", otThreadErrorToString(error));
+        m_link_stats.rx_drop_count++;
         m_receive_frame_buffer->DiscardFrame();
     }
 }
@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdatomic.h>
+#include <sys/select.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "unity.h"
+#include "esp_vfs_eventfd.h"
+#include "esp_openthread_task_queue.h"
+
+#define TEST_QUEUE_SIZE         16
+#define TEST_PRODUCER_COUNT     4
+#define TEST_POSTS_PER_PRODUCER 5000
+
+typedef struct {
+    SemaphoreHandle_t producers_done;
+    SemaphoreHandle_t mainloop_done;
+    atomic_int post_failures;
+    // Only accessed by the mainloop task until it gives mainloop_done
+    bool stop;
+    uint32_t executed;
+    uint32_t lost_wakeups;
+    uint32_t select_failures;
+} task_queue_test_ctx_t;
+
+static void count_task(void *arg)
+{
+    task_queue_test_ctx_t *ctx = arg;
+    ctx->executed++;
+}
+
+// Posted after all the other tasks, so the mainloop runs them all before it stops
+static void stop_task(void *arg)
+{
+    task_queue_test_ctx_t *ctx = arg;
+    ctx->stop = true;
+}
+
+static void producer_task(void *arg)
+{
+    task_queue_test_ctx_t *ctx = arg;
+    for (int i = 0; i < TEST_POSTS_PER_PRODUCER; i++) {
+        if (esp_openthread_task_queue_post(count_task, ctx) != ESP_OK) {
+            atomic_fetch_add(&ctx->post_failures, 1);
+        }
+    }
+    xSemaphoreGive(ctx->producers_done);
+    vTaskDelete(NULL);
+}
+
+// Runs the task queue part of the OpenThread mainloop
+static void mainloop_task(void *arg)
+{
+    task_queue_test_ctx_t *ctx = arg;
+    while (!ctx->stop) {
+        esp_openthread_mainloop_context_t mainloop = {
+            .max_fd = -1,
+            .timeout = { .tv_sec = 1 },
+        };
+        FD_ZERO(&mainloop.read_fds);
+        FD_ZERO(&mainloop.write_fds);
+        FD_ZERO(&mainloop.error_fds);
+        esp_openthread_task_queue_update(&mainloop);
+
+        uint32_t executed = ctx->executed;
+        int ret = select(mainloop.max_fd + 1, &mainloop.read_fds, NULL, NULL, &mainloop.timeout);
+        if (ret < 0) {
+            ctx->select_failures++;
+            break;
+        }
+        esp_openthread_task_queue_process(NULL, &mainloop);
+        // Tasks which were waiting while the event fd stayed silent
+        if (ret == 0 && ctx->executed != executed) {
+            ctx->lost_wakeups++;
+        }
+    }
+    xSemaphoreGive(ctx->mainloop_done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("task queue wakes up the mainloop for every post of several producers", "[openthread][task_queue]")
+{
+    esp_vfs_eventfd_config_t eventfd_config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    esp_openthread_platform_config_t config = {
+        .port_config = {
+            .task_queue_size = TEST_QUEUE_SIZE,
+        },
+    };
+    task_queue_test_ctx_t ctx = {
+        .producers_done = xSemaphoreCreateCounting(TEST_PRODUCER_COUNT, 0),
+        .mainloop_done = xSemaphoreCreateBinary(),
+    };
+    TEST_ASSERT_NOT_NULL(ctx.producers_done);
+    TEST_ASSERT_NOT_NULL(ctx.mainloop_done);
+    TEST_ESP_OK(esp_vfs_eventfd_register(&eventfd_config));
+    TEST_ESP_OK(esp_openthread_task_queue_init(&config));
+
+    // The queue is small, so the producers on all cores keep racing with the mainloop draining it
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(mainloop_task, "mainloop", 4096, &ctx, 5, NULL, 0));
+    for (int i = 0; i < TEST_PRODUCER_COUNT; i++) {
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(producer_task, "producer", 4096, &ctx, 5, NULL,
+                                                          i % portNUM_PROCESSORS));
+    }
+    for (int i = 0; i < TEST_PRODUCER_COUNT; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(ctx.producers_done, pdMS_TO_TICKS(30000)));
+    }
+
+    TEST_ESP_OK(esp_openthread_task_queue_post(stop_task, &ctx));
+    TEST_ASSERT_TRUE(xSemaphoreTake(ctx.mainloop_done, pdMS_TO_TICKS(5000)));
+
+    TEST_ASSERT_EQUAL(0, atomic_load(&ctx.post_failures));
+    TEST_ASSERT_EQUAL(0, ctx.select_failures);
+    TEST_ASSERT_EQUAL(0, ctx.lost_wakeups);
+    TEST_ASSERT_EQUAL(TEST_PRODUCER_COUNT * TEST_POSTS_PER_PRODUCER, ctx.executed);
+
+    TEST_ESP_OK(esp_openthread_task_queue_deinit());
+    TEST_ESP_OK(esp_vfs_eventfd_unregister());
+    vSemaphoreDelete(ctx.producers_done);
+    vSemaphoreDelete(ctx.mainloop_done);
+}
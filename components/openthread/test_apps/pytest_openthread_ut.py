@@ -0,0 +1,12 @@
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: CC0-1.0
+import pytest
+from pytest_embedded import Dut
+
+
+@pytest.mark.esp32c6
+@pytest.mark.esp32h2
+@pytest.mark.esp32s3
+@pytest.mark.generic
+def test_openthread(dut: Dut) -> None:
+    dut.run_all_single_board_cases()
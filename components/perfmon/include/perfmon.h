@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -10,12 +10,17 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "sdkconfig.h"
 #include "esp_err.h"
 #include "esp_log.h"
 
+#include "perfmon_region.h"
+
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
 #include "xtensa_perfmon_access.h"
 #include "xtensa_perfmon_masks.h"
 #include "xtensa_perfmon_apis.h"
 #include "xtensa/xt_perf_consts.h"
+#endif
 
 #endif // _PERF_MON_H_
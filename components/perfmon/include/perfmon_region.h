@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Events which can be counted by the performance counters of the CPU
+ *
+ * Not every CPU can count every event, use perfmon_event_is_supported() to check if an event can be counted.
+ */
+typedef enum {
+    PERFMON_EVENT_CYCLES,           /*!< CPU cycles */
+    PERFMON_EVENT_INSTRUCTIONS,     /*!< Retired instructions */
+    PERFMON_EVENT_LOAD_STALLS,      /*!< Cycles stalled waiting for data loads */
+    PERFMON_EVENT_JUMP_STALLS,      /*!< Cycles stalled because of jumps and taken branches */
+    PERFMON_EVENT_IDLE_CYCLES,      /*!< Cycles spent waiting for an interrupt */
+    PERFMON_EVENT_LOADS,            /*!< Load instructions */
+    PERFMON_EVENT_STORES,           /*!< Store instructions */
+    PERFMON_EVENT_JUMPS,            /*!< Unconditional jumps, calls and returns */
+    PERFMON_EVENT_BRANCHES,         /*!< Conditional branches */
+    PERFMON_EVENT_BRANCHES_TAKEN,   /*!< Conditional branches which were taken */
+    PERFMON_EVENT_MAX,              /*!< Number of events */
+} perfmon_event_t;
+
+/**
+ * @brief Result of a performance counter
+ */
+typedef struct {
+    perfmon_event_t event;  /*!< Counted event */
+    uint64_t value;         /*!< Number of events counted */
+    bool overflow;          /*!< The counter overflowed, value is not valid */
+} perfmon_result_t;
+
+/**
+ * @brief Configuration of perfmon_measure()
+ */
+typedef struct {
+    const perfmon_event_t *events;      /*!< List of the events to count */
+    size_t events_num;                  /*!< Number of events in the list */
+    void (*call_function)(void *params);/*!< Function to be measured */
+    void *call_params;                  /*!< Parameter passed to call_function */
+    uint32_t repeat_count;              /*!< Number of calls of call_function for each group of events */
+} perfmon_measure_config_t;
+
+/**
+ * @brief Get the number of events which can be counted at the same time
+ *
+ * @return Number of performance counters of the CPU
+ */
+size_t perfmon_get_counter_num(void);
+
+/**
+ * @brief Check if an event can be counted by the CPU
+ *
+ * @param event Event to check
+ *
+ * @return true if the event is supported
+ */
+bool perfmon_event_is_supported(perfmon_event_t event);
+
+/**
+ * @brief Get a short description of an event, e.g. "cycles"
+ *
+ * @param event Event
+ *
+ * @return Description of the event, "unknown" if the event is not valid
+ */
+const char *perfmon_event_name(perfmon_event_t event);
+
+/**
+ * @brief Start counting events on the current core
+ *
+ * Each event is assigned to one performance counter of the current core. The counters count everything that runs
+ * on the core until perfmon_region_stop() is called, including interrupts and other tasks. So the region should be
+ * short or run from a task pinned to a core.
+ *
+ * @note On CPUs which use the performance counter as cycle counter (ESP32-C2, ESP32-C3, ESP32-C6 and ESP32-H2),
+ *       esp_cpu_get_cycle_count() is stopped while a region counts another event than PERFMON_EVENT_CYCLES.
+ *
+ * @param events List of distinct events to count
+ * @param count  Number of events, at most perfmon_get_counter_num()
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if events is NULL, count is 0 or an event is listed twice
+ *      - ESP_ERR_NOT_SUPPORTED if there are more events than counters or an event is not supported
+ *      - ESP_ERR_INVALID_STATE if a region is already started on the current core
+ */
+esp_err_t perfmon_region_start(const perfmon_event_t *events, size_t count);
+
+/**
+ * @brief Stop counting events on the current core
+ *
+ * @param[out] results Array of the results, one entry for each event given to perfmon_region_start(), in the same
+ *                     order. May be NULL to discard the results.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if no region is started on the current core
+ */
+esp_err_t perfmon_region_stop(perfmon_result_t *results);
+
+/**
+ * @brief Count events during calls of a function
+ *
+ * The events are split into groups of perfmon_get_counter_num() events. For each group, the function is called
+ * repeat_count times in a counted region, and the smallest value of each counter is kept. Taking the minimum filters
+ * out the calls which were disturbed by interrupts or cache misses.
+ *
+ * @note The calling task should be pinned to a core.
+ *
+ * @param[in]  config  Configuration of the measurement
+ * @param[out] results Array of config->events_num results, in the order of config->events
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if one of the required parameters is not defined
+ *      - ESP_ERR_NOT_SUPPORTED if one of the events is not supported
+ *      - ESP_ERR_INVALID_STATE if a region is already started on the current core
+ *      - ESP_FAIL if a counter overflowed in all calls
+ */
+esp_err_t perfmon_measure(const perfmon_measure_config_t *config, perfmon_result_t *results);
+
+/**
+ * @brief Print results to a stream
+ *
+ * Prints one line per result. If the results contain both cycles and instructions, the number of instructions per
+ * cycle is printed as well.
+ *
+ * @param stream  Stream to print to, stdout if NULL
+ * @param name    Name of the measured code, printed at the start of each line
+ * @param results Array of results
+ * @param count   Number of results
+ */
+void perfmon_report(FILE *stream, const char *name, const perfmon_result_t *results, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
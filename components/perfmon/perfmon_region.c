@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "soc/soc_caps.h"
+#include "perfmon_region.h"
+#include "perfmon_port.h"
+
+static const char *TAG = "perfmon";
+
+static perfmon_port_region_t s_regions[SOC_CPU_CORES_NUM];
+
+static const char *const s_event_names[PERFMON_EVENT_MAX] = {
+    [PERFMON_EVENT_CYCLES]          = "cycles",
+    [PERFMON_EVENT_INSTRUCTIONS]    = "instructions",
+    [PERFMON_EVENT_LOAD_STALLS]     = "load stalls",
+    [PERFMON_EVENT_JUMP_STALLS]     = "jump stalls",
+    [PERFMON_EVENT_IDLE_CYCLES]     = "idle cycles",
+    [PERFMON_EVENT_LOADS]           = "loads",
+    [PERFMON_EVENT_STORES]          = "stores",
+    [PERFMON_EVENT_JUMPS]           = "jumps",
+    [PERFMON_EVENT_BRANCHES]        = "branches",
+    [PERFMON_EVENT_BRANCHES_TAKEN]  = "branches taken",
+};
+
+size_t perfmon_get_counter_num(void)
+{
+    return perfmon_port_get_counter_num();
+}
+
+bool perfmon_event_is_supported(perfmon_event_t event)
+{
+    if ((unsigned)event >= PERFMON_EVENT_MAX) {
+        return false;
+    }
+    return perfmon_port_event_is_supported(event);
+}
+
+const char *perfmon_event_name(perfmon_event_t event)
+{
+    if ((unsigned)event >= PERFMON_EVENT_MAX) {
+        return "unknown";
+    }
+    return s_event_names[event];
+}
+
+esp_err_t perfmon_region_start(const perfmon_event_t *events, size_t count)
+{
+    if (events == NULL || count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (count > perfmon_port_get_counter_num()) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!perfmon_event_is_supported(events[i])) {
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (events[j] == events[i]) {
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+    }
+
+    esp_err_t ret = ESP_OK;
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    perfmon_port_region_t *region = &s_regions[esp_cpu_get_core_id()];
+    if (region->active) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        region->active = true;
+        region->count = count;
+        for (size_t i = 0; i < count; i++) {
+            region->events[i] = events[i];
+        }
+        perfmon_port_start(region);
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+    return ret;
+}
+
+esp_err_t perfmon_region_stop(perfmon_result_t *results)
+{
+    perfmon_result_t values[PERFMON_PORT_COUNTERS_MAX];
+    esp_err_t ret = ESP_OK;
+    size_t count = 0;
+
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    perfmon_port_region_t *region = &s_regions[esp_cpu_get_core_id()];
+    if (!region->active) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        perfmon_port_stop(region, values);
+        region->active = false;
+        count = region->count;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+
+    if (ret == ESP_OK && results != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            results[i] = values[i];
+        }
+    }
+    return ret;
+}
+
+esp_err_t perfmon_measure(const perfmon_measure_config_t *config, perfmon_result_t *results)
+{
+    if (config == NULL || results == NULL || config->events == NULL || config->events_num == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (config->call_function == NULL) {
+        ESP_LOGE(TAG, "Parameter call_function must be defined.");
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < config->events_num; i++) {
+        if (!perfmon_event_is_supported(config->events[i])) {
+            ESP_LOGE(TAG, "Event %s is not supported.", perfmon_event_name(config->events[i]));
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+        results[i] = (perfmon_result_t) {
+            .event = config->events[i],
+            .value = UINT64_MAX,
+            .overflow = true,
+        };
+    }
+
+    const size_t counter_num = perfmon_port_get_counter_num();
+    for (size_t first = 0; first < config->events_num; first += counter_num) {
+        size_t count = config->events_num - first;
+        count = (count < counter_num) ? count : counter_num;
+
+        for (uint32_t n = 0; n < config->repeat_count; n++) {
+            perfmon_result_t values[PERFMON_PORT_COUNTERS_MAX];
+            esp_err_t ret = perfmon_region_start(&config->events[first], count);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+            config->call_function(config->call_params);
+            ret = perfmon_region_stop(values);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+            for (size_t i = 0; i < count; i++) {
+                perfmon_result_t *result = &results[first + i];
+                if (!values[i].overflow && values[i].value < result->value) {
+                    result->value = values[i].value;
+                    result->overflow = false;
+                }
+            }
+        }
+    }
+
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < config->events_num; i++) {
+        if (results[i].overflow) {
+            results[i].value = 0;
+            ret = ESP_FAIL;
+        }
+    }
+    return ret;
+}
+
+void perfmon_report(FILE *stream, const char *name, const perfmon_result_t *results, size_t count)
+{
+    const perfmon_result_t *cycles = NULL;
+    const perfmon_result_t *instructions = NULL;
+
+    if (stream == NULL) {
+        stream = stdout;
+    }
+    if (name == NULL) {
+        name = "perfmon";
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (results[i].overflow) {
+            fprintf(stream, "%s: %-16s  overflow\n", name, perfmon_event_name(results[i].event));
+            continue;
+        }
+        fprintf(stream, "%s: %-16s %10" PRIu64 "\n", name, perfmon_event_name(results[i].event), results[i].value);
+        if (results[i].event == PERFMON_EVENT_CYCLES) {
+            cycles = &results[i];
+        } else if (results[i].event == PERFMON_EVENT_INSTRUCTIONS) {
+            instructions = &results[i];
+        }
+    }
+    if (cycles != NULL && instructions != NULL && cycles->value != 0) {
+        uint64_t ipc_x100 = instructions->value * 100 / cycles->value;
+        fprintf(stream, "%s: %-16s %7" PRIu64 ".%02" PRIu64 "\n", name, "instr. per cycle", ipc_x100 / 100, ipc_x100 % 100);
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Two kinds of RISC-V CPUs are supported:
+ *
+ * - CPUs with the Espressif performance counter CSRs (SOC_CPU_HAS_CSR_PC) have a single 32-bit counter, PCCR, which
+ *   counts the events enabled in PCER while PCMR enables it. The same counter is used as the CPU cycle counter, so
+ *   its configuration is saved when a region starts and restored when it stops. The counter is set to saturate, a
+ *   saturated counter is reported as an overflow. A region counting cycles while the counter already counts cycles
+ *   only reads the counter, so the cycle count stays continuous.
+ *
+ * - Other CPUs implement the standard mcycle and minstret counters, which can count cycles and instructions at the
+ *   same time. They are 64-bit wide and never overflow in practice.
+ */
+
+#include "sdkconfig.h"
+#include "soc/soc_caps.h"
+#include "riscv/csr.h"
+#include "riscv/rv_utils.h"
+#include "perfmon_port.h"
+
+#if SOC_CPU_HAS_CSR_PC
+
+#define PCMR_COUNT_EN       (1 << 0)
+#define PCMR_COUNT_SAT      (1 << 1)
+
+static const uint32_t s_event_pcer[PERFMON_EVENT_MAX] = {
+    [PERFMON_EVENT_CYCLES]          = (1 << 0),
+    [PERFMON_EVENT_INSTRUCTIONS]    = (1 << 1),
+    [PERFMON_EVENT_LOAD_STALLS]     = (1 << 2),
+    [PERFMON_EVENT_JUMP_STALLS]     = (1 << 3),
+    [PERFMON_EVENT_IDLE_CYCLES]     = (1 << 4),
+    [PERFMON_EVENT_LOADS]           = (1 << 5),
+    [PERFMON_EVENT_STORES]          = (1 << 6),
+    [PERFMON_EVENT_JUMPS]           = (1 << 7),
+    [PERFMON_EVENT_BRANCHES]        = (1 << 8),
+    [PERFMON_EVENT_BRANCHES_TAKEN]  = (1 << 9),
+};
+
+size_t perfmon_port_get_counter_num(void)
+{
+    return 1;
+}
+
+bool perfmon_port_event_is_supported(perfmon_event_t event)
+{
+    return true;
+}
+
+/* The counter is already used as cycle counter, so a region counting cycles only needs to read it */
+static inline bool shares_cycle_counter(const perfmon_port_region_t *region)
+{
+    return region->events[0] == PERFMON_EVENT_CYCLES &&
+           region->saved[1] == s_event_pcer[PERFMON_EVENT_CYCLES] &&
+           (region->saved[0] & PCMR_COUNT_EN) != 0;
+}
+
+void perfmon_port_start(perfmon_port_region_t *region)
+{
+    region->saved[0] = RV_READ_CSR(CSR_PCMR_MACHINE);
+    region->saved[1] = RV_READ_CSR(CSR_PCER_MACHINE);
+    if (shares_cycle_counter(region)) {
+        region->saved[2] = RV_READ_CSR(CSR_PCCR_MACHINE);
+        return;
+    }
+
+    RV_WRITE_CSR(CSR_PCMR_MACHINE, 0);
+    region->saved[2] = RV_READ_CSR(CSR_PCCR_MACHINE);
+    RV_WRITE_CSR(CSR_PCER_MACHINE, s_event_pcer[region->events[0]]);
+    RV_WRITE_CSR(CSR_PCCR_MACHINE, 0);
+    RV_WRITE_CSR(CSR_PCMR_MACHINE, PCMR_COUNT_EN | PCMR_COUNT_SAT);
+}
+
+void perfmon_port_stop(perfmon_port_region_t *region, perfmon_result_t *results)
+{
+    uint32_t value;
+    bool overflow = false;
+
+    if (shares_cycle_counter(region)) {
+        value = RV_READ_CSR(CSR_PCCR_MACHINE) - (uint32_t)region->saved[2];
+    } else {
+        RV_WRITE_CSR(CSR_PCMR_MACHINE, 0);
+        value = RV_READ_CSR(CSR_PCCR_MACHINE);
+        overflow = (value == UINT32_MAX);
+
+        // The cycle count stood still during the region, unless cycles were counted
+        uint32_t ccount = region->saved[2];
+        if (region->events[0] == PERFMON_EVENT_CYCLES) {
+            ccount += value;
+        }
+        RV_WRITE_CSR(CSR_PCER_MACHINE, region->saved[1]);
+        RV_WRITE_CSR(CSR_PCCR_MACHINE, ccount);
+        RV_WRITE_CSR(CSR_PCMR_MACHINE, region->saved[0]);
+    }
+
+    results[0] = (perfmon_result_t) {
+        .event = region->events[0],
+        .value = value,
+        .overflow = overflow,
+    };
+}
+
+#else // SOC_CPU_HAS_CSR_PC
+
+static inline uint64_t read_counter(perfmon_event_t event)
+{
+    uint32_t hi, lo;
+
+    // Read the high word again if the low word wrapped in between
+    if (event == PERFMON_EVENT_CYCLES) {
+        do {
+            hi = RV_READ_CSR(mcycleh);
+            lo = RV_READ_CSR(mcycle);
+        } while (hi != RV_READ_CSR(mcycleh));
+    } else {
+        do {
+            hi = RV_READ_CSR(minstreth);
+            lo = RV_READ_CSR(minstret);
+        } while (hi != RV_READ_CSR(minstreth));
+    }
+    return ((uint64_t)hi << 32) | lo;
+}
+
+size_t perfmon_port_get_counter_num(void)
+{
+    return 2;
+}
+
+bool perfmon_port_event_is_supported(perfmon_event_t event)
+{
+    return event == PERFMON_EVENT_CYCLES || event == PERFMON_EVENT_INSTRUCTIONS;
+}
+
+void perfmon_port_start(perfmon_port_region_t *region)
+{
+    for (size_t i = 0; i < region->count; i++) {
+        region->saved[i] = read_counter(region->events[i]);
+    }
+}
+
+void perfmon_port_stop(perfmon_port_region_t *region, perfmon_result_t *results)
+{
+    uint64_t values[PERFMON_PORT_COUNTERS_MAX];
+
+    for (size_t i = 0; i < region->count; i++) {
+        values[i] = read_counter(region->events[i]);
+    }
+    for (size_t i = 0; i < region->count; i++) {
+        results[i] = (perfmon_result_t) {
+            .event = region->events[i],
+            .value = values[i] - region->saved[i],
+            .overflow = false,
+        };
+    }
+}
+
+#endif // SOC_CPU_HAS_CSR_PC
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_assert.h"
+#include "xtensa-debug-module.h"
+#include "eri.h"
+#include "xtensa/xt_perf_consts.h"
+#include "xtensa_perfmon_access.h"
+#include "perfmon_port.h"
+
+ESP_STATIC_ASSERT(ERI_PERFMON_MAX >= PERFMON_PORT_COUNTERS_MAX, "Not enough performance counters");
+
+typedef struct {
+    uint16_t select;
+    uint16_t mask;
+} event_select_t;
+
+static const event_select_t s_event_select[PERFMON_EVENT_MAX] = {
+    [PERFMON_EVENT_CYCLES]          = { XTPERF_CNT_CYCLES,      XTPERF_MASK_CYCLES },
+    [PERFMON_EVENT_INSTRUCTIONS]    = { XTPERF_CNT_INSN,        XTPERF_MASK_INSN_ALL },
+    [PERFMON_EVENT_LOAD_STALLS]     = { XTPERF_CNT_D_STALL,     XTPERF_MASK_D_STALL_ALL },
+    [PERFMON_EVENT_JUMP_STALLS]     = { XTPERF_CNT_BUBBLES,     XTPERF_MASK_BUBBLES_CTI },
+    [PERFMON_EVENT_IDLE_CYCLES]     = { XTPERF_CNT_BUBBLES,     XTPERF_MASK_BUBBLES_WAITI },
+    [PERFMON_EVENT_LOADS]           = { XTPERF_CNT_D_LOAD_U1,   XTPERF_MASK_D_LOAD_ALL },
+    [PERFMON_EVENT_STORES]          = { XTPERF_CNT_D_STORE_U1,  XTPERF_MASK_D_STORE_ALL },
+    [PERFMON_EVENT_JUMPS]           = { XTPERF_CNT_INSN,        XTPERF_MASK_INSN_JX | XTPERF_MASK_INSN_CALLX | XTPERF_MASK_INSN_RET |
+                                                                XTPERF_MASK_INSN_J | XTPERF_MASK_INSN_CALL },
+    [PERFMON_EVENT_BRANCHES]        = { XTPERF_CNT_INSN,        XTPERF_MASK_INSN_BRANCH_TAKEN | XTPERF_MASK_INSN_BRANCH_NOT_TAKEN },
+    [PERFMON_EVENT_BRANCHES_TAKEN]  = { XTPERF_CNT_INSN,        XTPERF_MASK_INSN_BRANCH_TAKEN },
+};
+
+size_t perfmon_port_get_counter_num(void)
+{
+    return PERFMON_PORT_COUNTERS_MAX;
+}
+
+bool perfmon_port_event_is_supported(perfmon_event_t event)
+{
+    return true;
+}
+
+void perfmon_port_start(perfmon_port_region_t *region)
+{
+    xtensa_perfmon_stop();
+    for (size_t i = 0; i < region->count; i++) {
+        const event_select_t *sel = &s_event_select[region->events[i]];
+        // Count at all interrupt levels, the counter is also reset here
+        xtensa_perfmon_init(i, sel->select, sel->mask, 0, -1);
+        // The overflow bit is sticky, clear it
+        eri_write(ERI_PERFMON_PMSTAT0 + i * sizeof(int32_t), PMSTAT_OVFL);
+    }
+    xtensa_perfmon_start();
+}
+
+void perfmon_port_stop(perfmon_port_region_t *region, perfmon_result_t *results)
+{
+    xtensa_perfmon_stop();
+    for (size_t i = 0; i < region->count; i++) {
+        results[i] = (perfmon_result_t) {
+            .event = region->events[i],
+            .value = xtensa_perfmon_value(i),
+            .overflow = xtensa_perfmon_overflow(i) != ESP_OK,
+        };
+    }
+}
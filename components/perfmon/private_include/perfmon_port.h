@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "perfmon_region.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Upper bound of the number of counters of all supported CPUs */
+#define PERFMON_PORT_COUNTERS_MAX   2
+
+/**
+ * @brief State of the region of one core
+ *
+ * Filled in by perfmon_region_start(), except for the saved field which belongs to the port.
+ */
+typedef struct {
+    bool active;
+    size_t count;
+    perfmon_event_t events[PERFMON_PORT_COUNTERS_MAX];
+    uint64_t saved[PERFMON_PORT_COUNTERS_MAX + 1];
+} perfmon_port_region_t;
+
+/**
+ * @brief Get the number of counters of the CPU, at most PERFMON_PORT_COUNTERS_MAX
+ */
+size_t perfmon_port_get_counter_num(void);
+
+/**
+ * @brief Check if the CPU can count an event
+ */
+bool perfmon_port_event_is_supported(perfmon_event_t event);
+
+/**
+ * @brief Program and start the counters for the events of a region
+ *
+ * Called with interrupts disabled, region->events and region->count are valid and supported.
+ */
+void perfmon_port_start(perfmon_port_region_t *region);
+
+/**
+ * @brief Stop the counters of a region and read them
+ *
+ * Called with interrupts disabled on the core which started the region. Restores any counter state the port
+ * changed in perfmon_port_start().
+ */
+void perfmon_port_stop(perfmon_port_region_t *region, perfmon_result_t *results);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_cpu.h"
+#include "perfmon.h"
+#include "unity.h"
+
+#define DELAY_LOOPS 1000
+
+static void delay(void *params)
+{
+    for (int i = 0 ; i < DELAY_LOOPS ; i++) {
+        __asm__ __volatile__("nop");
+    }
+}
+
+TEST_CASE("perfmon region counts cycles and instructions", "[perfmon]")
+{
+    TEST_ASSERT_GREATER_OR_EQUAL(1, perfmon_get_counter_num());
+    TEST_ASSERT_TRUE(perfmon_event_is_supported(PERFMON_EVENT_CYCLES));
+    TEST_ASSERT_TRUE(perfmon_event_is_supported(PERFMON_EVENT_INSTRUCTIONS));
+
+    const perfmon_event_t cycles = PERFMON_EVENT_CYCLES;
+    perfmon_result_t result;
+    TEST_ESP_OK(perfmon_region_start(&cycles, 1));
+    delay(NULL);
+    TEST_ESP_OK(perfmon_region_stop(&result));
+    TEST_ASSERT_EQUAL(PERFMON_EVENT_CYCLES, result.event);
+    TEST_ASSERT_FALSE(result.overflow);
+    TEST_ASSERT_GREATER_THAN_UINT32(DELAY_LOOPS, (uint32_t)result.value);
+
+    const perfmon_event_t instructions = PERFMON_EVENT_INSTRUCTIONS;
+    TEST_ESP_OK(perfmon_region_start(&instructions, 1));
+    delay(NULL);
+    TEST_ESP_OK(perfmon_region_stop(&result));
+    TEST_ASSERT_EQUAL(PERFMON_EVENT_INSTRUCTIONS, result.event);
+    TEST_ASSERT_FALSE(result.overflow);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(DELAY_LOOPS, (uint32_t)result.value);
+}
+
+TEST_CASE("perfmon region does not stop the cycle counter", "[perfmon]")
+{
+    const perfmon_event_t instructions = PERFMON_EVENT_INSTRUCTIONS;
+
+    esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+    TEST_ESP_OK(perfmon_region_start(&instructions, 1));
+    TEST_ESP_OK(perfmon_region_stop(NULL));
+    delay(NULL);
+    TEST_ASSERT_GREATER_THAN_UINT32(DELAY_LOOPS, esp_cpu_get_cycle_count() - start);
+}
+
+TEST_CASE("perfmon region argument and state checks", "[perfmon]")
+{
+    const perfmon_event_t events[] = { PERFMON_EVENT_CYCLES, PERFMON_EVENT_CYCLES };
+    const perfmon_event_t invalid = PERFMON_EVENT_MAX;
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, perfmon_region_stop(NULL));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, perfmon_region_start(NULL, 1));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, perfmon_region_start(events, 0));
+    TEST_ESP_ERR(ESP_ERR_NOT_SUPPORTED, perfmon_region_start(&invalid, 1));
+    if (perfmon_get_counter_num() >= 2) {
+        TEST_ESP_ERR(ESP_ERR_INVALID_ARG, perfmon_region_start(events, 2));
+    } else {
+        TEST_ESP_ERR(ESP_ERR_NOT_SUPPORTED, perfmon_region_start(events, 2));
+    }
+
+    TEST_ESP_OK(perfmon_region_start(events, 1));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, perfmon_region_start(events, 1));
+    TEST_ESP_OK(perfmon_region_stop(NULL));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, perfmon_region_stop(NULL));
+}
+
+TEST_CASE("perfmon_measure and perfmon_report", "[perfmon]")
+{
+    perfmon_event_t events[PERFMON_EVENT_MAX];
+    perfmon_result_t results[PERFMON_EVENT_MAX];
+    size_t events_num = 0;
+
+    // Measure every supported event, more events than counters are split into groups
+    for (int i = 0; i < PERFMON_EVENT_MAX; i++) {
+        if (perfmon_event_is_supported(i)) {
+            events[events_num++] = i;
+        }
+    }
+
+    perfmon_measure_config_t config = {
+        .events = events,
+        .events_num = events_num,
+        .call_function = delay,
+        .call_params = NULL,
+        .repeat_count = 20,
+    };
+    TEST_ESP_OK(perfmon_measure(&config, results));
+    for (size_t i = 0; i < events_num; i++) {
+        TEST_ASSERT_EQUAL(events[i], results[i].event);
+        TEST_ASSERT_FALSE(results[i].overflow);
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(DELAY_LOOPS, (uint32_t)results[0].value);
+
+    char *out_str = NULL;
+    size_t out_len = 0;
+    FILE *out_stream = open_memstream(&out_str, &out_len);
+    perfmon_report(out_stream, "delay", results, events_num);
+    fclose(out_stream);
+
+    TEST_ASSERT_NOT_NULL(strstr(out_str, "delay: cycles"));
+    TEST_ASSERT_NOT_NULL(strstr(out_str, "delay: instructions"));
+    TEST_ASSERT_NOT_NULL(strstr(out_str, "instr. per cycle"));
+    free(out_str);
+
+    config.call_function = NULL;
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, perfmon_measure(&config, results));
+}
@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <protobuf-c/protobuf-c.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Arena allocator for the protobuf-c messages of a request
+ *
+ * The fields of a message unpacked with the allocator of the arena are
+ * allocated one after the other in the memory of the arena, instead of
+ * one heap allocation per field. Allocations which don't fit in the arena
+ * fall back to the heap, so freeing the message with the same allocator
+ * is still needed, freeing the arena memory does nothing.
+ */
+typedef struct {
+    ProtobufCAllocator allocator;   /*!< Allocator to pass to the unpack and free_unpacked functions */
+    uint8_t *buf;                   /*!< Memory of the arena */
+    size_t size;                    /*!< Size of buf */
+    size_t used;                    /*!< Number of bytes allocated in buf */
+} protocomm_arena_t;
+
+/**
+ * @brief   Declare an arena of CONFIG_ESP_PROTOCOMM_ARENA_SIZE bytes on the stack
+ *
+ * The arena lives until the end of the enclosing block, typically the
+ * handler of a request.
+ */
+#define PROTOCOMM_ARENA_DECLARE(name) \
+    uint8_t name##_mem[CONFIG_ESP_PROTOCOMM_ARENA_SIZE] __attribute__((aligned(8))); \
+    protocomm_arena_t name; \
+    protocomm_arena_init(&name, name##_mem, sizeof(name##_mem))
+
+/**
+ * @brief   Initialize an arena
+ *
+ * @param[in] arena Arena to initialize
+ * @param[in] buf   Memory of the arena, aligned on 8 bytes
+ * @param[in] size  Size of buf
+ */
+void protocomm_arena_init(protocomm_arena_t *arena, void *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include "protocomm_arena.h"
+
+#define ARENA_ALIGN 8
+
+static void *arena_alloc(void *allocator_data, size_t size)
+{
+    protocomm_arena_t *arena = (protocomm_arena_t *) allocator_data;
+    size_t start = (arena->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    if (start <= arena->size && size <= arena->size - start) {
+        arena->used = start + size;
+        return arena->buf + start;
+    }
+    /* The request is larger than expected, keep serving it from the heap */
+    return malloc(size);
+}
+
+static void arena_free(void *allocator_data, void *pointer)
+{
+    protocomm_arena_t *arena = (protocomm_arena_t *) allocator_data;
+    uint8_t *p = (uint8_t *) pointer;
+
+    if (p >= arena->buf && p < arena->buf + arena->size) {
+        return;
+    }
+    free(pointer);
+}
+
+void protocomm_arena_init(protocomm_arena_t *arena, void *buf, size_t size)
+{
+    arena->allocator.alloc = arena_alloc;
+    arena->allocator.free = arena_free;
+    arena->allocator.allocator_data = arena;
+    arena->buf = (uint8_t *) buf;
+    arena->size = size;
+    arena->used = 0;
+}
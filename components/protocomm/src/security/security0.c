@@ -13,6 +13,7 @@
 
 #include <protocomm_security.h>
 #include <protocomm_security0.h>
+#include <protocomm_arena.h>
 
 #include "session.pb-c.h"
 #include "sec0.pb-c.h"
@@ -67,14 +68,15 @@ static esp_err_t sec0_req_handler(protocomm_security_handle_t handle,
     SessionData resp;
     esp_err_t ret;
 
-    req = session_data__unpack(NULL, inlen, inbuf);
+    PROTOCOMM_ARENA_DECLARE(arena);
+    req = session_data__unpack(&arena.allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack setup_req");
         return ESP_ERR_INVALID_ARG;
     }
     if (req->sec_ver != protocomm_security0.ver) {
         ESP_LOGE(TAG, "Security version mismatch. Closing connection");
-        session_data__free_unpacked(req, NULL);
+        session_data__free_unpacked(req, &arena.allocator);
         return ESP_ERR_INVALID_ARG;
     }
 
@@ -82,12 +84,12 @@ static esp_err_t sec0_req_handler(protocomm_security_handle_t handle,
     ret = sec0_session_setup(session_id, req, &resp);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Session setup error %d", ret);
-        session_data__free_unpacked(req, NULL);
+        session_data__free_unpacked(req, &arena.allocator);
         return ESP_FAIL;
     }
 
     resp.sec_ver = req->sec_ver;
-    session_data__free_unpacked(req, NULL);
+    session_data__free_unpacked(req, &arena.allocator);
 
     *outlen = session_data__get_packed_size(&resp);
     *outbuf = (uint8_t *) malloc(*outlen);
@@ -85,6 +85,38 @@ esp_err_t esp_pthread_set_cfg(const esp_pthread_cfg_t *cfg);
  */
 esp_err_t esp_pthread_get_cfg(esp_pthread_cfg_t *p);
 
+/**
+ * @brief Create pthread tasks in advance and park them for reuse
+ *
+ * Creates \c count FreeRTOS tasks with the stack size, priority, core affinity, stack memory capabilities and
+ * name of \c cfg and parks them until a pthread_create() call with a compatible configuration runs a thread in one
+ * of them. See CONFIG_PTHREAD_TASK_POOL_SIZE for the conditions under which a parked task is reused.
+ *
+ * This can be used to allocate the stacks of short lived threads in external RAM once, by setting
+ * cfg->stack_alloc_caps to MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, instead of allocating them each time a thread
+ * is created.
+ *
+ * @note A thread name set in cfg must match the name set with esp_pthread_set_cfg() by the creator of the threads.
+ *       If cfg->thread_name is NULL, the tasks get the default name CONFIG_PTHREAD_TASK_NAME_DEFAULT.
+ *
+ * @param cfg   The configuration of the tasks, NULL to use the default configuration
+ * @param count Number of tasks to create
+ *
+ * @return
+ *      - ESP_OK if the tasks were created and parked
+ *      - ESP_ERR_NOT_SUPPORTED if CONFIG_PTHREAD_TASK_POOL_SIZE is 0
+ *      - ESP_ERR_INVALID_ARG if stack_size is less than PTHREAD_STACK_MIN
+ *      - ESP_ERR_INVALID_ARG if stack_alloc_caps does not include MALLOC_CAP_8BIT
+ *      - ESP_ERR_INVALID_SIZE if there is no room for count more tasks in the pool
+ *      - ESP_ERR_NO_MEM if out of memory. The tasks created before the error stay parked.
+ */
+esp_err_t esp_pthread_pool_reserve(const esp_pthread_cfg_t *cfg, size_t count);
+
+/**
+ * @brief Delete all parked pthread tasks and free their stacks
+ */
+void esp_pthread_pool_clear(void);
+
 /**
  * @brief Initialize pthread library
  */
@@ -103,6 +103,16 @@ esp_err_t esp_pthread_get_cfg(esp_pthread_cfg_t *p)
     return ESP_ERR_NOT_FOUND;
 }
 
+esp_err_t esp_pthread_pool_reserve(const esp_pthread_cfg_t *cfg, size_t count)
+{
+    // Threads are created by the host, there is no task to park
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void esp_pthread_pool_clear(void)
+{
+}
+
 __attribute__((constructor)) esp_err_t esp_pthread_init(void)
 {
     if (pthread_key_create(&s_pthread_cfg_key, esp_pthread_cfg_key_destructor) != 0) {
@@ -18,9 +18,8 @@
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "esp_private/startup_internal.h"
-#if CONFIG_SPIRAM
 #include "esp_private/freertos_idf_additions_priv.h"
-#endif
+#include "esp_newlib.h"
 #include "esp_heap_caps.h"
 #include "soc/soc_memory_layout.h"
 
@@ -49,11 +48,19 @@ typedef struct esp_pthread_entry {
     void                       *task_arg;       ///< Task arguments
 } esp_pthread_t;
 
-/** pthread wrapper task arg */
-typedef struct {
-    void *(*func)(void *);  ///< user task entry
+/** pthread wrapper task arg, lives as long as the FreeRTOS task */
+typedef struct esp_pthread_task_arg {
+    void *(*func)(void *);  ///< user task entry, NULL while the task waits for a thread to run
     void *arg;              ///< user task argument
     esp_pthread_cfg_t cfg;  ///< pthread configuration
+    bool reusable;          ///< True if the task returned from the user task entry and can run another thread
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+    SLIST_ENTRY(esp_pthread_task_arg) pool_node;    ///< Pool list node struct.
+    TaskHandle_t                handle;             ///< FreeRTOS task handle
+    uint32_t                    stack_size;         ///< Stack size of the task, in StackType_t units
+    BaseType_t                  core_id;            ///< Core affinity of the task
+    uint32_t                    stack_alloc_caps;   ///< Memory capabilities of the stack
+#endif
 } esp_pthread_task_arg_t;
 
 /** pthread mutex FreeRTOS wrapper */
@@ -67,6 +74,11 @@ portMUX_TYPE pthread_lazy_init_lock  = portMUX_INITIALIZER_UNLOCKED; // Used for
 static SLIST_HEAD(esp_thread_list_head, esp_pthread_entry) s_threads_list
     = SLIST_HEAD_INITIALIZER(s_threads_list);
 static pthread_key_t s_pthread_cfg_key;
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+static SLIST_HEAD(esp_pthread_pool_head, esp_pthread_task_arg) s_pool_list
+    = SLIST_HEAD_INITIALIZER(s_pool_list);
+static size_t s_pool_count;
+#endif
 
 static int pthread_mutex_lock_internal(esp_pthread_mutex_t *mux, TickType_t tmo);
 
@@ -139,6 +151,52 @@ static void pthread_delete(esp_pthread_t *pthread)
     free(pthread);
 }
 
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+/* Must be called with s_threads_lock held */
+static bool pthread_pool_put(esp_pthread_task_arg_t *task_arg)
+{
+    if (s_pool_count >= CONFIG_PTHREAD_TASK_POOL_SIZE) {
+        return false;
+    }
+    SLIST_INSERT_HEAD(&s_pool_list, task_arg, pool_node);
+    s_pool_count++;
+    return true;
+}
+
+/* Must be called with s_threads_lock held */
+static esp_pthread_task_arg_t *pthread_pool_get(uint32_t stack_size, BaseType_t core_id,
+                                                uint32_t stack_alloc_caps, const char *task_name)
+{
+    esp_pthread_task_arg_t *it;
+    SLIST_FOREACH(it, &s_pool_list, pool_node) {
+        if (it->stack_size >= stack_size && it->core_id == core_id && it->stack_alloc_caps == stack_alloc_caps
+                && strncmp(pcTaskGetName(it->handle), task_name, configMAX_TASK_NAME_LEN - 1) == 0) {
+            SLIST_REMOVE(&s_pool_list, it, esp_pthread_task_arg, pool_node);
+            s_pool_count--;
+            return it;
+        }
+    }
+    return NULL;
+}
+#else
+static inline bool pthread_pool_put(esp_pthread_task_arg_t *task_arg)
+{
+    return false;
+}
+#endif
+
+/* Deletes the task of an exited pthread, or parks it if it can run another thread.
+ * Must be called with s_threads_lock held, a reusable task may only be deleted while
+ * it does not hold the lock itself. */
+static void pthread_release_task(TaskHandle_t handle, esp_pthread_task_arg_t *task_arg)
+{
+    if (task_arg->reusable && pthread_pool_put(task_arg)) {
+        return;
+    }
+    vTaskDelete(handle);
+    free(task_arg);
+}
+
 /* Call this function to configure pthread stacks in Pthreads */
 esp_err_t esp_pthread_set_cfg(const esp_pthread_cfg_t *cfg)
 {
@@ -218,6 +276,21 @@ esp_pthread_cfg_t esp_pthread_get_default_config(void)
     return cfg;
 }
 
+static void pthread_exit_internal(void *value_ptr, bool reusable);
+
+static void pthread_wait_for_start(esp_pthread_task_arg_t *task_arg)
+{
+    bool started;
+
+    do {
+        xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+        // A parked task may still get a notification which was meant for its previous thread
+        _lock_acquire(&s_threads_lock);
+        started = (task_arg->func != NULL);
+        _lock_release(&s_threads_lock);
+    } while (!started);
+}
+
 static void pthread_task_func(void *arg)
 {
     void *rval = NULL;
@@ -225,25 +298,33 @@ static void pthread_task_func(void *arg)
 
     ESP_LOGV(TAG, "%s ENTER %p", __FUNCTION__, task_arg->func);
 
-    // wait for start
-    xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
-
-    if (task_arg->cfg.inherit_cfg) {
-        /* If inherit option is set, then do a set_cfg() ourselves for future forks,
-        but first set thread_name to NULL to enable inheritance of the name too.
-        (This also to prevents dangling pointers to name of tasks that might
-        possibly have been deleted when we use the configuration).*/
-        esp_pthread_cfg_t *cfg = &task_arg->cfg;
-        cfg->thread_name = NULL;
-        esp_pthread_set_cfg(cfg);
-    }
-    ESP_LOGV(TAG, "%s START %p", __FUNCTION__, task_arg->func);
-    rval = task_arg->func(task_arg->arg);
-    ESP_LOGV(TAG, "%s END %p", __FUNCTION__, task_arg->func);
+    for (bool reused = false;; reused = true) {
+        // wait for start
+        pthread_wait_for_start(task_arg);
 
-    pthread_exit(rval);
+        if (reused) {
+            /* A new thread starts with fresh thread local storage and newlib state
+            (errno, stdio buffers...), as if it was running in a new task */
+            vPortTLSReset();
+            esp_reent_cleanup();
+            esp_reent_init(__getreent());
+        }
+        if (task_arg->cfg.inherit_cfg) {
+            /* If inherit option is set, then do a set_cfg() ourselves for future forks,
+            but first set thread_name to NULL to enable inheritance of the name too.
+            (This also to prevents dangling pointers to name of tasks that might
+            possibly have been deleted when we use the configuration).*/
+            esp_pthread_cfg_t *cfg = &task_arg->cfg;
+            cfg->thread_name = NULL;
+            esp_pthread_set_cfg(cfg);
+        }
+        ESP_LOGV(TAG, "%s START %p", __FUNCTION__, task_arg->func);
+        rval = task_arg->func(task_arg->arg);
+        ESP_LOGV(TAG, "%s END %p", __FUNCTION__, task_arg->func);
 
-    ESP_LOGV(TAG, "%s EXIT", __FUNCTION__);
+        // Only returns if the task has been parked to run another thread
+        pthread_exit_internal(rval, true);
+    }
 }
 
 #if CONFIG_SPIRAM && CONFIG_FREERTOS_SMP
@@ -297,6 +378,129 @@ static BaseType_t pthread_create_freertos_task_with_caps(TaskFunction_t pxTaskCo
 #endif
 }
 
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+/* Runs a new thread in a compatible parked task. Returns the handle of the task, NULL if no parked task fits. */
+static TaskHandle_t pthread_pool_start(esp_pthread_t *pthread, uint32_t stack_size, BaseType_t prio,
+                                       BaseType_t core_id, uint32_t stack_alloc_caps, const char *task_name,
+                                       const esp_pthread_cfg_t *cfg, void *(*start_routine)(void *), void *arg)
+{
+    TaskHandle_t handle = NULL;
+
+    _lock_acquire(&s_threads_lock);
+    esp_pthread_task_arg_t *task_arg = pthread_pool_get(stack_size, core_id, stack_alloc_caps, task_name);
+    if (task_arg) {
+        handle = task_arg->handle;
+        if (uxTaskPriorityGet(handle) != prio) {
+            vTaskPrioritySet(handle, prio);
+        }
+        task_arg->cfg = *cfg;
+        task_arg->arg = arg;
+        task_arg->func = start_routine;
+        pthread->task_arg = task_arg;
+        pthread->handle = handle;
+        SLIST_INSERT_HEAD(&s_threads_list, pthread, list_node);
+    }
+    _lock_release(&s_threads_lock);
+
+    if (handle) {
+        // start task
+        xTaskNotify(handle, 0, eNoAction);
+    }
+    return handle;
+}
+#endif
+
+esp_err_t esp_pthread_pool_reserve(const esp_pthread_cfg_t *cfg, size_t count)
+{
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+    esp_pthread_cfg_t pool_cfg = esp_pthread_get_default_config();
+
+    if (cfg) {
+        if (cfg->stack_size < PTHREAD_STACK_MIN) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (cfg->stack_alloc_caps != 0 && !(cfg->stack_alloc_caps & MALLOC_CAP_8BIT)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        // Same rules as in pthread_create()
+        pool_cfg.stack_size = cfg->stack_size;
+        if (cfg->prio && cfg->prio < configMAX_PRIORITIES) {
+            pool_cfg.prio = cfg->prio;
+        }
+        if (cfg->pin_to_core >= 0 && cfg->pin_to_core < CONFIG_FREERTOS_NUMBER_OF_CORES) {
+            pool_cfg.pin_to_core = cfg->pin_to_core;
+        }
+        if (cfg->stack_alloc_caps != 0) {
+            pool_cfg.stack_alloc_caps = cfg->stack_alloc_caps;
+        }
+        pool_cfg.thread_name = cfg->thread_name;
+    }
+
+    const char *task_name = pool_cfg.thread_name ? pool_cfg.thread_name : CONFIG_PTHREAD_TASK_NAME_DEFAULT;
+    const uint32_t stack_size = (pool_cfg.stack_size + sizeof(StackType_t) - 1) / sizeof(StackType_t);
+
+    _lock_acquire(&s_threads_lock);
+    bool fits = (count <= CONFIG_PTHREAD_TASK_POOL_SIZE - s_pool_count);
+    _lock_release(&s_threads_lock);
+    if (!fits) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        esp_pthread_task_arg_t *task_arg = calloc(1, sizeof(esp_pthread_task_arg_t));
+        if (task_arg == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        task_arg->stack_size = stack_size;
+        task_arg->core_id = pool_cfg.pin_to_core;
+        task_arg->stack_alloc_caps = pool_cfg.stack_alloc_caps;
+
+        // The task waits in pthread_task_func() until a thread is started in it
+        BaseType_t res = pthread_create_freertos_task_with_caps(&pthread_task_func,
+                                                                task_name,
+                                                                stack_size,
+                                                                task_arg,
+                                                                pool_cfg.prio,
+                                                                pool_cfg.pin_to_core,
+                                                                pool_cfg.stack_alloc_caps,
+                                                                &task_arg->handle);
+        if (res != pdPASS) {
+            free(task_arg);
+            return ESP_ERR_NO_MEM;
+        }
+
+        _lock_acquire(&s_threads_lock);
+        bool parked = pthread_pool_put(task_arg);
+        if (!parked) {
+            // The pool was filled by exiting threads in the meantime
+            pthread_release_task(task_arg->handle, task_arg);
+        }
+        _lock_release(&s_threads_lock);
+        if (!parked) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+    }
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+void esp_pthread_pool_clear(void)
+{
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+    _lock_acquire(&s_threads_lock);
+    while (!SLIST_EMPTY(&s_pool_list)) {
+        esp_pthread_task_arg_t *task_arg = SLIST_FIRST(&s_pool_list);
+        SLIST_REMOVE_HEAD(&s_pool_list, pool_node);
+        vTaskDelete(task_arg->handle);
+        free(task_arg);
+    }
+    s_pool_count = 0;
+    _lock_release(&s_threads_lock);
+#endif
+}
+
 int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
                    void *(*start_routine)(void *), void *arg)
 {
@@ -309,16 +513,9 @@ int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
         return ENOMEM;
     }
 
-    esp_pthread_task_arg_t *task_arg = calloc(1, sizeof(esp_pthread_task_arg_t));
-    if (task_arg == NULL) {
-        ESP_LOGE(TAG, "Failed to allocate task args!");
-        return ENOMEM;
-    }
-
     esp_pthread_t *pthread = calloc(1, sizeof(esp_pthread_t));
     if (pthread == NULL) {
         ESP_LOGE(TAG, "Failed to allocate pthread data!");
-        free(task_arg);
         return ENOMEM;
     }
 
@@ -327,6 +524,7 @@ int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
     BaseType_t core_id = get_default_pthread_core();
     const char *task_name = CONFIG_PTHREAD_TASK_NAME_DEFAULT;
     uint32_t stack_alloc_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    esp_pthread_cfg_t task_cfg = { 0 };
 
     esp_pthread_cfg_t *pthread_cfg = pthread_getspecific(s_pthread_cfg_key);
     if (pthread_cfg) {
@@ -358,7 +556,7 @@ int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
         // Note: validity has been checked during esp_pthread_set_cfg()
         stack_alloc_caps = pthread_cfg->stack_alloc_caps;
 
-        task_arg->cfg = *pthread_cfg;
+        task_cfg = *pthread_cfg;
     }
 
     if (attr) {
@@ -380,8 +578,31 @@ int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
     // Note: float division of ceil(m / n) ==
     //       integer division of (m + n - 1) / n
     stack_size = (stack_size + sizeof(StackType_t) - 1) / sizeof(StackType_t);
+
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+    xHandle = pthread_pool_start(pthread, stack_size, prio, core_id, stack_alloc_caps, task_name,
+                                 &task_cfg, start_routine, arg);
+    if (xHandle != NULL) {
+        *thread = (pthread_t)pthread; // pointer value fit into pthread_t (uint32_t)
+        ESP_LOGV(TAG, "Reused task %"PRIx32, (uint32_t)xHandle);
+        return 0;
+    }
+#endif
+
+    esp_pthread_task_arg_t *task_arg = calloc(1, sizeof(esp_pthread_task_arg_t));
+    if (task_arg == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate task args!");
+        free(pthread);
+        return ENOMEM;
+    }
     task_arg->func = start_routine;
     task_arg->arg = arg;
+    task_arg->cfg = task_cfg;
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+    task_arg->stack_size = stack_size;
+    task_arg->core_id = core_id;
+    task_arg->stack_alloc_caps = stack_alloc_caps;
+#endif
     pthread->task_arg = task_arg;
 
     BaseType_t res = pthread_create_freertos_task_with_caps(&pthread_task_func,
@@ -404,6 +625,9 @@ int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
         }
     }
     pthread->handle = xHandle;
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+    task_arg->handle = xHandle;
+#endif
 
     _lock_acquire(&s_threads_lock);
 
@@ -426,6 +650,7 @@ int pthread_join(pthread_t thread, void **retval)
     int ret = 0;
     bool wait = false;
     void *child_task_retval = 0;
+    esp_pthread_task_arg_t *task_arg = NULL;
 
     ESP_LOGV(TAG, "%s %p", __FUNCTION__, pthread);
 
@@ -456,6 +681,7 @@ int pthread_join(pthread_t thread, void **retval)
                 wait = true;
             } else { // thread has exited and task is already suspended, or about to be suspended
                 child_task_retval = pthread->retval;
+                task_arg = pthread->task_arg;
                 pthread_delete(pthread);
             }
         }
@@ -467,12 +693,15 @@ int pthread_join(pthread_t thread, void **retval)
             xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
             _lock_acquire(&s_threads_lock);
             child_task_retval = pthread->retval;
+            task_arg = pthread->task_arg;
             pthread_delete(pthread);
             _lock_release(&s_threads_lock);
         }
         /* clean up thread local storage before task deletion */
         pthread_internal_local_storage_destructor_callback(handle);
-        vTaskDelete(handle);
+        _lock_acquire(&s_threads_lock);
+        pthread_release_task(handle, task_arg);
+        _lock_release(&s_threads_lock);
     }
 
     if (retval) {
@@ -504,19 +733,24 @@ int pthread_detach(pthread_t thread)
         pthread->detached = true;
     } else {
         // pthread already stopped
+        esp_pthread_task_arg_t *task_arg = pthread->task_arg;
         pthread_delete(pthread);
         /* clean up thread local storage before task deletion */
         pthread_internal_local_storage_destructor_callback(handle);
-        vTaskDelete(handle);
+        pthread_release_task(handle, task_arg);
     }
     _lock_release(&s_threads_lock);
     ESP_LOGV(TAG, "%s %p EXIT %d", __FUNCTION__, pthread, ret);
     return ret;
 }
 
-void pthread_exit(void *value_ptr)
+/* Only returns if reusable is true and the task has been parked to run another thread.
+ * Only a task which returned from the user task entry can be reused, pthread_exit()
+ * may be called with an arbitrary amount of stack in use. */
+static void pthread_exit_internal(void *value_ptr, bool reusable)
 {
     bool detached = false;
+    bool parked = false;
     /* clean up thread local storage before task deletion */
     pthread_internal_local_storage_destructor_callback(NULL);
 
@@ -526,13 +760,17 @@ void pthread_exit(void *value_ptr)
     if (!pthread) {
         assert(false && "Failed to find pthread for current task!");
     }
-    if (pthread->task_arg) {
-        free(pthread->task_arg);
+    esp_pthread_task_arg_t *task_arg = pthread->task_arg;
+    reusable = reusable && CONFIG_PTHREAD_TASK_POOL_SIZE > 0;
+    task_arg->reusable = reusable;
+    if (reusable) {
+        task_arg->func = NULL;
     }
     if (pthread->detached) {
         // auto-free for detached threads
         pthread_delete(pthread);
         detached = true;
+        parked = reusable && pthread_pool_put(task_arg);
     } else {
         // Set return value
         pthread->retval = value_ptr;
@@ -550,9 +788,16 @@ void pthread_exit(void *value_ptr)
     _lock_release(&s_threads_lock);
     // note: if this thread is joinable then after giving back s_threads_mux
     // this task could be deleted at any time, so don't take another lock or
-    // do anything that might lock (such as printing to stdout)
+    // do anything that might lock (such as printing to stdout).
+    // A reusable task is only deleted with s_threads_lock held, so it can still
+    // take s_threads_lock while it waits for its next thread.
+
+    if (parked || (!detached && reusable)) {
+        return;
+    }
 
     if (detached) {
+        free(task_arg);
         vTaskDelete(NULL);
     } else {
         vTaskSuspend(NULL);
@@ -562,6 +807,14 @@ void pthread_exit(void *value_ptr)
     abort();
 }
 
+void pthread_exit(void *value_ptr)
+{
+    pthread_exit_internal(value_ptr, false);
+
+    // Should never be reached
+    abort();
+}
+
 int pthread_cancel(pthread_t thread)
 {
     ESP_LOGE(TAG, "%s: not supported!", __FUNCTION__);
@@ -1,10 +1,11 @@
 /*
- * SPDX-FileCopyrightText: 2017-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2017-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <pthread.h>
 #include <string.h>
 #include "esp_err.h"
@@ -23,12 +24,19 @@ const static char *TAG = "esp_pthread";
 
 typedef struct esp_pthread_cond_waiter {
     SemaphoreHandle_t   wait_sem;           ///< task specific semaphore to wait on
+    bool                signaled;           ///< set when the waiter is removed from the list by a signal or broadcast
     TAILQ_ENTRY(esp_pthread_cond_waiter) link;  ///< stash on the list of semaphores to be notified
 } esp_pthread_cond_waiter_t;
 
+TAILQ_HEAD(esp_pthread_cond_waiter_list, esp_pthread_cond_waiter);
+
+/* The list of waiters is protected by a spinlock, which is only held to add or remove the waiters. Signaling
+ * removes the waiters from the list before their semaphores are given outside of the critical section, so that
+ * a waiter which times out knows whether its semaphore is still going to be given.
+ */
 typedef struct esp_pthread_cond {
-    _lock_t lock;                      ///< lock that protects the list of semaphores
-    TAILQ_HEAD(, esp_pthread_cond_waiter) waiter_list;  ///< head of the list of semaphores
+    portMUX_TYPE lock;                      ///< lock that protects the list of semaphores
+    struct esp_pthread_cond_waiter_list waiter_list;  ///< head of the list of semaphores
 } esp_pthread_cond_t;
 
 static int s_check_and_init_if_static(pthread_cond_t *cv)
@@ -59,13 +67,18 @@ int pthread_cond_signal(pthread_cond_t *cv)
 
     esp_pthread_cond_t *cond = (esp_pthread_cond_t *) *cv;
 
-    _lock_acquire_recursive(&cond->lock);
+    portENTER_CRITICAL(&cond->lock);
     esp_pthread_cond_waiter_t *entry;
     entry = TAILQ_FIRST(&cond->waiter_list);
+    if (entry) {
+        TAILQ_REMOVE(&cond->waiter_list, entry, link);
+        entry->signaled = true;
+    }
+    portEXIT_CRITICAL(&cond->lock);
+
     if (entry) {
         xSemaphoreGive(entry->wait_sem);
     }
-    _lock_release_recursive(&cond->lock);
 
     return 0;
 }
@@ -78,13 +91,22 @@ int pthread_cond_broadcast(pthread_cond_t *cv)
     }
 
     esp_pthread_cond_t *cond = (esp_pthread_cond_t *) *cv;
+    struct esp_pthread_cond_waiter_list signaled = TAILQ_HEAD_INITIALIZER(signaled);
 
-    _lock_acquire_recursive(&cond->lock);
+    portENTER_CRITICAL(&cond->lock);
     esp_pthread_cond_waiter_t *entry;
     TAILQ_FOREACH(entry, &cond->waiter_list, link) {
+        entry->signaled = true;
+    }
+    TAILQ_CONCAT(&signaled, &cond->waiter_list, link);
+    portEXIT_CRITICAL(&cond->lock);
+
+    esp_pthread_cond_waiter_t *next;
+    for (entry = TAILQ_FIRST(&signaled); entry != NULL; entry = next) {
+        // the waiter may return as soon as its semaphore is given
+        next = TAILQ_NEXT(entry, link);
         xSemaphoreGive(entry->wait_sem);
     }
-    _lock_release_recursive(&cond->lock);
 
     return 0;
 }
@@ -153,22 +175,31 @@ int pthread_cond_timedwait(pthread_cond_t *cv, pthread_mutex_t *mut, const struc
     // Around 80 bytes
     StaticSemaphore_t sem_buffer;
     // Create semaphore: first take will block
-    w.wait_sem = xSemaphoreCreateCountingStatic(1, 0, &sem_buffer);
+    w.wait_sem = xSemaphoreCreateBinaryStatic(&sem_buffer);
+    w.signaled = false;
 
-    _lock_acquire_recursive(&cond->lock);
+    portENTER_CRITICAL(&cond->lock);
     TAILQ_INSERT_TAIL(&cond->waiter_list, &w, link);
-    _lock_release_recursive(&cond->lock);
+    portEXIT_CRITICAL(&cond->lock);
     pthread_mutex_unlock(mut);
 
     if (xSemaphoreTake(w.wait_sem, timeout_ticks) == pdTRUE) {
         ret = 0;
     } else {
-        ret = ETIMEDOUT;
+        portENTER_CRITICAL(&cond->lock);
+        bool signaled = w.signaled;
+        if (!signaled) {
+            TAILQ_REMOVE(&cond->waiter_list, &w, link);
+        }
+        portEXIT_CRITICAL(&cond->lock);
+        if (signaled) {
+            // signaled after the timeout, the semaphore is about to be given and must not be deleted before
+            xSemaphoreTake(w.wait_sem, portMAX_DELAY);
+            ret = 0;
+        } else {
+            ret = ETIMEDOUT;
+        }
     }
-
-    _lock_acquire_recursive(&cond->lock);
-    TAILQ_REMOVE(&cond->waiter_list, &w, link);
-    _lock_release_recursive(&cond->lock);
     vSemaphoreDelete(w.wait_sem);
 
     pthread_mutex_lock(mut);
@@ -227,7 +258,7 @@ int pthread_cond_init(pthread_cond_t *cv, const pthread_condattr_t *att)
         return ENOMEM;
     }
 
-    _lock_init_recursive(&cond->lock);
+    portMUX_INITIALIZE(&cond->lock);
     TAILQ_INIT(&cond->waiter_list);
 
     *cv = (pthread_cond_t) cond;
@@ -250,15 +281,14 @@ int pthread_cond_destroy(pthread_cond_t *cv)
         return EINVAL;
     }
 
-    _lock_acquire_recursive(&cond->lock);
+    portENTER_CRITICAL(&cond->lock);
     if (!TAILQ_EMPTY(&cond->waiter_list)) {
         ret = EBUSY;
     }
-    _lock_release_recursive(&cond->lock);
+    portEXIT_CRITICAL(&cond->lock);
 
     if (ret == 0) {
         *cv = (pthread_cond_t) 0;
-        _lock_close_recursive(&cond->lock);
         free(cond);
     }
 
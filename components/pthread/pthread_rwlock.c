@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <pthread.h>
 #include <string.h>
+#include <stdbool.h>
 #include <stdatomic.h>
 #include "esp_err.h"
 #include "esp_attr.h"
@@ -23,28 +24,36 @@
 #include "esp_log.h"
 const static char *TAG = "pthread_rw_lock";
 
+/*
+ * The state of the lock is kept in one atomic word, so that uncontended locking and unlocking is a single
+ * compare-and-swap or atomic add. The mutex and the condition variable are only used by the tasks which have to
+ * block: a blocking task sets RWLOCK_WAITERS before it checks the state again with the mutex held, and the task
+ * unlocking sees the flag in the same atomic operation which releases the lock, so no wakeup is lost.
+ */
+#define RWLOCK_WRITER           (1U << 31)  ///< a writer holds the lock
+#define RWLOCK_WRITERS_WAITING  (1U << 30)  ///< writers are blocked, new readers have to wait behind them
+#define RWLOCK_WAITERS          (1U << 29)  ///< readers or writers are blocked, unlocking has to wake them up
+#define RWLOCK_READERS_MASK     (RWLOCK_WAITERS - 1)    ///< number of readers holding the lock
+
 /** pthread rw_mutex FreeRTOS wrapper */
 typedef struct {
+    atomic_uint state;
+
     /**
-     *
+     * Signaled when the lock is released and tasks are waiting
      */
     pthread_cond_t cv;
 
     pthread_mutex_t resource_mutex;
 
     /**
-     * Number of current readers holding this lock, negative number means waiting readers
+     * Number of blocked readers and writers, protected by resource_mutex
      */
-    int8_t active_readers;
-
-    uint8_t active_writers;
-    uint8_t waiting_writers;
+    uint32_t waiting_readers;
+    uint32_t waiting_writers;
 
 } esp_pthread_rwlock_t;
 
-#define WRITER_QUEUE_SIZE 4
-#define READER_QUEUE_SIZE 4
-
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
                         const pthread_rwlockattr_t *attr)
 {
@@ -76,8 +85,8 @@ int pthread_rwlock_init(pthread_rwlock_t *rwlock,
         return ENOMEM;
     }
 
-    esp_rwlock->active_readers = 0;
-    esp_rwlock->active_writers = 0;
+    atomic_init(&esp_rwlock->state, 0);
+    esp_rwlock->waiting_readers = 0;
     esp_rwlock->waiting_writers = 0;
 
     *rwlock = (pthread_rwlock_t) esp_rwlock;
@@ -120,7 +129,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
     // TODO: necessary?
     pthread_mutex_lock(&esp_rwlock->resource_mutex);
 
-    if (esp_rwlock->active_readers != 0 || esp_rwlock->active_writers > 0 || esp_rwlock->waiting_writers > 0) {
+    if (atomic_load(&esp_rwlock->state) != 0 || esp_rwlock->waiting_readers > 0 || esp_rwlock->waiting_writers > 0) {
         pthread_mutex_unlock(&esp_rwlock->resource_mutex);
         return EBUSY;
     }
@@ -157,6 +166,52 @@ static int checkrw_lock(pthread_rwlock_t *rwlock)
     return 0;
 }
 
+/**
+ * Add a reader unless one of the bits in @p blocking is set.
+ */
+static bool try_add_reader(esp_pthread_rwlock_t *esp_rwlock, unsigned blocking)
+{
+    unsigned state = atomic_load(&esp_rwlock->state);
+    while (!(state & blocking)) {
+        if (atomic_compare_exchange_weak(&esp_rwlock->state, &state, state + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Set the writer bit unless one of the bits in @p blocking is set.
+ */
+static bool try_set_writer(esp_pthread_rwlock_t *esp_rwlock, unsigned blocking)
+{
+    unsigned state = atomic_load(&esp_rwlock->state);
+    while (!(state & blocking)) {
+        if (atomic_compare_exchange_weak(&esp_rwlock->state, &state, state | RWLOCK_WRITER)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Clear the waiting flags which don't apply anymore.
+ * Must be called with resource_mutex held.
+ */
+static void update_waiting_flags(esp_pthread_rwlock_t *esp_rwlock)
+{
+    unsigned clear = 0;
+    if (esp_rwlock->waiting_writers == 0) {
+        clear |= RWLOCK_WRITERS_WAITING;
+        if (esp_rwlock->waiting_readers == 0) {
+            clear |= RWLOCK_WAITERS;
+        }
+    }
+    if (clear) {
+        atomic_fetch_and(&esp_rwlock->state, ~clear);
+    }
+}
+
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 {
     esp_pthread_rwlock_t *esp_rwlock;
@@ -168,22 +223,22 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
+    if (try_add_reader(esp_rwlock, RWLOCK_WRITER | RWLOCK_WRITERS_WAITING)) {
+        return 0;
+    }
+
     res = pthread_mutex_lock(&esp_rwlock->resource_mutex);
     if (res != 0) {
         return res;
     }
 
-    if (esp_rwlock->active_writers == 0) {
-        esp_rwlock->active_readers++;
-    } else {
-        while (true) {
-            pthread_cond_wait(&esp_rwlock->cv, &esp_rwlock->resource_mutex);
-            if (esp_rwlock->active_writers == 0 && esp_rwlock->waiting_writers == 0) {
-                esp_rwlock->active_readers++;
-                break;
-            }
-        }
+    esp_rwlock->waiting_readers++;
+    atomic_fetch_or(&esp_rwlock->state, RWLOCK_WAITERS);
+    while (!try_add_reader(esp_rwlock, RWLOCK_WRITER | RWLOCK_WRITERS_WAITING)) {
+        pthread_cond_wait(&esp_rwlock->cv, &esp_rwlock->resource_mutex);
     }
+    esp_rwlock->waiting_readers--;
+    update_waiting_flags(esp_rwlock);
 
     pthread_mutex_unlock(&esp_rwlock->resource_mutex);
 
@@ -201,21 +256,7 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
-    res = pthread_mutex_trylock(&esp_rwlock->resource_mutex);
-    if (res != 0) {
-        return res;
-    }
-
-    if (esp_rwlock->active_writers == 0) {
-        esp_rwlock->active_readers++;
-        res = 0;
-    } else {
-        res = EBUSY;
-    }
-
-    pthread_mutex_unlock(&esp_rwlock->resource_mutex);
-
-    return res;
+    return try_add_reader(esp_rwlock, RWLOCK_WRITER) ? 0 : EBUSY;
 }
 
 int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
@@ -229,17 +270,22 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
+    if (try_set_writer(esp_rwlock, RWLOCK_READERS_MASK | RWLOCK_WRITER | RWLOCK_WRITERS_WAITING)) {
+        return 0;
+    }
+
     res = pthread_mutex_lock(&esp_rwlock->resource_mutex);
     if (res != 0) {
         return res;
     }
 
     esp_rwlock->waiting_writers++;
-    while (esp_rwlock->active_readers > 0 || esp_rwlock->active_writers > 0) {
+    atomic_fetch_or(&esp_rwlock->state, RWLOCK_WAITERS | RWLOCK_WRITERS_WAITING);
+    while (!try_set_writer(esp_rwlock, RWLOCK_READERS_MASK | RWLOCK_WRITER)) {
         pthread_cond_wait(&esp_rwlock->cv, &esp_rwlock->resource_mutex);
     }
     esp_rwlock->waiting_writers--;
-    esp_rwlock->active_writers++;
+    update_waiting_flags(esp_rwlock);
 
     pthread_mutex_unlock(&esp_rwlock->resource_mutex);
 
@@ -257,23 +303,8 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
-    res = pthread_mutex_trylock(&esp_rwlock->resource_mutex);
-    if (res != 0) {
-        return res;
-    }
-
-    if (esp_rwlock->active_readers > 0 ||
-            esp_rwlock->active_writers > 0 ||
-            esp_rwlock->waiting_writers > 0) { // the last check for waiting_writers is to avoid skipping the queue
-        res = EBUSY;
-    } else {
-        esp_rwlock->active_writers++;
-        res = 0;
-    }
-
-    pthread_mutex_unlock(&esp_rwlock->resource_mutex);
-
-    return res;
+    // the check for waiting writers is to avoid skipping the queue
+    return try_set_writer(esp_rwlock, RWLOCK_READERS_MASK | RWLOCK_WRITER | RWLOCK_WRITERS_WAITING) ? 0 : EBUSY;
 }
 
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
@@ -287,27 +318,32 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
     }
 
     esp_rwlock = (esp_pthread_rwlock_t *)*rwlock;
-    res = pthread_mutex_lock(&esp_rwlock->resource_mutex);
-    if (res != 0) {
-        return res;
-    }
+    unsigned state = atomic_load(&esp_rwlock->state);
+    bool wake;
 
-    assert(!(esp_rwlock->active_readers > 0 && esp_rwlock->active_writers > 0));
+    // while the caller holds the lock, nobody else can set or clear the writer bit
+    if (state & RWLOCK_WRITER) {
+        // we are a writer
+        unsigned old = atomic_fetch_and(&esp_rwlock->state, ~RWLOCK_WRITER);
+        wake = (old & RWLOCK_WAITERS) != 0;
+    } else if (state & RWLOCK_READERS_MASK) {
+        // we are a reader, only blocked writers wait for the last reader
+        unsigned old = atomic_fetch_sub(&esp_rwlock->state, 1);
+        wake = (old & RWLOCK_WAITERS) && (old & RWLOCK_READERS_MASK) == 1;
+    } else {
+        // the lock isn't held, unlocking it does nothing
+        return 0;
+    }
 
-    if (esp_rwlock->active_readers > 0) {
-        // we are a reader
-        esp_rwlock->active_readers--;
-        if (esp_rwlock->active_readers == 0) {
-            pthread_cond_broadcast(&esp_rwlock->cv);
+    if (wake) {
+        res = pthread_mutex_lock(&esp_rwlock->resource_mutex);
+        if (res != 0) {
+            return res;
         }
-    } else {
-        // we are a writer
-        esp_rwlock->active_writers = 0;
         pthread_cond_broadcast(&esp_rwlock->cv);
+        pthread_mutex_unlock(&esp_rwlock->resource_mutex);
     }
 
-    pthread_mutex_unlock(&esp_rwlock->resource_mutex);
-
     return 0;
 }
 
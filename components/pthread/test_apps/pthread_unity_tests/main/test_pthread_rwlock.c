@@ -1,11 +1,14 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
 
 #include "sdkconfig.h"
 
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
 #include <errno.h>
 #include <stdatomic.h>
 
@@ -18,6 +21,7 @@
 #include <pthread.h>
 
 #include "unity.h"
+#include "test_utils.h"
 
 TEST_CASE("pthread_rwlock_init invalid arg", "[pthread][rwlock]")
 {
@@ -382,3 +386,73 @@ TEST_CASE("trywrlock lock statically initialized lock", "[pthread][rwlock]")
     TEST_ASSERT_EQUAL_INT(pthread_rwlock_unlock(&rwlock), 0);
     TEST_ASSERT_EQUAL_INT(pthread_rwlock_destroy(&rwlock), 0);
 }
+
+#define RWLOCK_BENCHMARK_ITERATIONS 10000
+
+typedef struct {
+    pthread_rwlock_t *rwlock;
+    bool write;
+    int failures;
+} rwlock_benchmark_ctx_t;
+
+// The failures are counted here and checked by the test task
+static void *rwlock_benchmark_thread(void *arg)
+{
+    rwlock_benchmark_ctx_t *ctx = (rwlock_benchmark_ctx_t *) arg;
+    for (int i = 0; i < RWLOCK_BENCHMARK_ITERATIONS; i++) {
+        int ret = ctx->write ? pthread_rwlock_wrlock(ctx->rwlock) : pthread_rwlock_rdlock(ctx->rwlock);
+        if (ret != 0) {
+            ctx->failures++;
+            continue;
+        }
+        if (pthread_rwlock_unlock(ctx->rwlock) != 0) {
+            ctx->failures++;
+        }
+    }
+    return NULL;
+}
+
+TEST_CASE("rwlock benchmark", "[pthread][rwlock]")
+{
+    pthread_rwlock_t rwlock;
+    TEST_ASSERT_EQUAL_INT(pthread_rwlock_init(&rwlock, NULL), 0);
+
+    rwlock_benchmark_ctx_t rd_ctx = { .rwlock = &rwlock, .write = false };
+    int64_t start = esp_timer_get_time();
+    rwlock_benchmark_thread(&rd_ctx);
+    int64_t rd_time = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL_INT(0, rd_ctx.failures);
+
+    rwlock_benchmark_ctx_t wr_ctx = { .rwlock = &rwlock, .write = true };
+    start = esp_timer_get_time();
+    rwlock_benchmark_thread(&wr_ctx);
+    int64_t wr_time = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL_INT(0, wr_ctx.failures);
+
+    // readers on all cores at once share the lock without blocking
+    pthread_t threads[CONFIG_FREERTOS_NUMBER_OF_CORES];
+    rwlock_benchmark_ctx_t ctx[CONFIG_FREERTOS_NUMBER_OF_CORES];
+    start = esp_timer_get_time();
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        ctx[i] = (rwlock_benchmark_ctx_t) { .rwlock = &rwlock, .write = false };
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, rwlock_benchmark_thread, &ctx[i]));
+    }
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        TEST_ASSERT_EQUAL(0, pthread_join(threads[i], NULL));
+    }
+    int64_t concurrent_rd_time = esp_timer_get_time() - start;
+    for (int i = 0; i < CONFIG_FREERTOS_NUMBER_OF_CORES; i++) {
+        TEST_ASSERT_EQUAL_INT(0, ctx[i].failures);
+    }
+
+    IDF_LOG_PERFORMANCE("rwlock_rdlock_unlock", "%"PRId64" ns", rd_time * 1000 / RWLOCK_BENCHMARK_ITERATIONS);
+    IDF_LOG_PERFORMANCE("rwlock_wrlock_unlock", "%"PRId64" ns", wr_time * 1000 / RWLOCK_BENCHMARK_ITERATIONS);
+    IDF_LOG_PERFORMANCE("rwlock_concurrent_rdlock_unlock", "%"PRId64" ns, %d threads",
+                        concurrent_rd_time * 1000 / (RWLOCK_BENCHMARK_ITERATIONS * CONFIG_FREERTOS_NUMBER_OF_CORES),
+                        CONFIG_FREERTOS_NUMBER_OF_CORES);
+
+    TEST_ASSERT_EQUAL_INT(pthread_rwlock_destroy(&rwlock), 0);
+
+    // Wait a few ticks to allow freertos idle task to free up memory
+    vTaskDelay(10);
+}
@@ -0,0 +1,224 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include "sdkconfig.h"
+#include <errno.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+
+#include "esp_pthread.h"
+#include <pthread.h>
+
+#include "unity.h"
+
+#if CONFIG_PTHREAD_TASK_POOL_SIZE > 0
+
+#define TEST_POOL_STACK_SIZE    4096
+
+static void *get_task_handle(void *arg)
+{
+    *(TaskHandle_t *)arg = xTaskGetCurrentTaskHandle();
+    return arg;
+}
+
+static void *get_task_priority(void *arg)
+{
+    *(UBaseType_t *)arg = uxTaskPriorityGet(NULL);
+    return NULL;
+}
+
+static void *exit_thread(void *arg)
+{
+    pthread_exit(arg);
+}
+
+static void *give_and_wait(void *arg)
+{
+    SemaphoreHandle_t done = (SemaphoreHandle_t)arg;
+    xSemaphoreGive(done);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    return NULL;
+}
+
+static size_t get_free_heap(void)
+{
+    return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+TEST_CASE("pthread task pool reuses the task of a joined thread", "[pthread-pool]")
+{
+    pthread_t thread;
+    TaskHandle_t first = NULL;
+    TaskHandle_t second = NULL;
+    void *rval = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, get_task_handle, &first));
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, &rval));
+    TEST_ASSERT_EQUAL_PTR(&first, rval);
+
+    // The stack of the parked task is reused, so only the small pthread descriptor is allocated
+    size_t free_before = get_free_heap();
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, get_task_handle, &second));
+    TEST_ASSERT_LESS_THAN(CONFIG_PTHREAD_TASK_STACK_SIZE_DEFAULT, free_before - get_free_heap());
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_EQUAL_PTR(first, second);
+
+    esp_pthread_pool_clear();
+}
+
+typedef struct {
+    TaskHandle_t handle;
+    int tls_data;
+    int tls_bss;
+    int err;
+} thread_state_t;
+
+static __thread int s_tls_data = 42;
+static __thread int s_tls_bss;
+
+// Records the per-thread state seen at start, then leaves it modified for the next thread
+static void *get_and_modify_thread_state(void *arg)
+{
+    thread_state_t *state = (thread_state_t *)arg;
+    state->handle = xTaskGetCurrentTaskHandle();
+    state->tls_data = s_tls_data;
+    state->tls_bss = s_tls_bss;
+    state->err = errno;
+
+    s_tls_data = 1;
+    s_tls_bss = 2;
+    errno = EINVAL;
+    return NULL;
+}
+
+TEST_CASE("pthread task pool starts threads with fresh thread local storage", "[pthread-pool]")
+{
+    pthread_t thread;
+    thread_state_t state[2] = {};
+
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, get_and_modify_thread_state, &state[i]));
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+    }
+    TEST_ASSERT_EQUAL_PTR(state[0].handle, state[1].handle);
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_INT(42, state[i].tls_data);
+        TEST_ASSERT_EQUAL_INT(0, state[i].tls_bss);
+        TEST_ASSERT_EQUAL_INT(0, state[i].err);
+    }
+
+    esp_pthread_pool_clear();
+}
+
+TEST_CASE("pthread task pool parks detached threads", "[pthread-pool]")
+{
+    pthread_t thread;
+    pthread_attr_t attr;
+    SemaphoreHandle_t done = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(done);
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_attr_init(&attr));
+    TEST_ASSERT_EQUAL_INT(0, pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED));
+
+    const UBaseType_t task_count = uxTaskGetNumberOfTasks();
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, &attr, give_and_wait, done));
+    TEST_ASSERT_TRUE(xSemaphoreTake(done, pdMS_TO_TICKS(100)));
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    // The task of the thread stays alive, parked in the pool
+    TEST_ASSERT_EQUAL(task_count + 1, uxTaskGetNumberOfTasks());
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, &attr, give_and_wait, done));
+    TEST_ASSERT_TRUE(xSemaphoreTake(done, pdMS_TO_TICKS(100)));
+    TEST_ASSERT_EQUAL(task_count + 1, uxTaskGetNumberOfTasks());
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    esp_pthread_pool_clear();
+    TEST_ASSERT_EQUAL(task_count, uxTaskGetNumberOfTasks());
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_attr_destroy(&attr));
+    vSemaphoreDelete(done);
+}
+
+TEST_CASE("pthread task pool does not reuse a task after pthread_exit", "[pthread-pool]")
+{
+    pthread_t thread;
+
+    esp_pthread_pool_clear();
+    const UBaseType_t task_count = uxTaskGetNumberOfTasks();
+
+    // A thread which leaves through pthread_exit() is deleted when it is joined
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, exit_thread, NULL));
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+    TEST_ASSERT_EQUAL(task_count, uxTaskGetNumberOfTasks());
+}
+
+TEST_CASE("esp_pthread_pool_reserve parks tasks for pthread_create", "[pthread-pool]")
+{
+    pthread_t threads[2];
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(2, 0);
+    TEST_ASSERT_NOT_NULL(done);
+
+    esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+    cfg.stack_size = TEST_POOL_STACK_SIZE;
+    cfg.thread_name = "pooled";
+    TEST_ASSERT_EQUAL(ESP_OK, esp_pthread_pool_reserve(&cfg, 2));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_pthread_set_cfg(&cfg));
+
+    size_t free_before = get_free_heap();
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, give_and_wait, done));
+    }
+    TEST_ASSERT_LESS_THAN(TEST_POOL_STACK_SIZE, free_before - get_free_heap());
+
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE(xSemaphoreTake(done, pdMS_TO_TICKS(100)));
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(threads[i], NULL));
+    }
+
+    esp_pthread_cfg_t default_cfg = esp_pthread_get_default_config();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_pthread_set_cfg(&default_cfg));
+    esp_pthread_pool_clear();
+    vSemaphoreDelete(done);
+}
+
+TEST_CASE("pthread task pool sets the priority of a reused task", "[pthread-pool]")
+{
+    pthread_t thread;
+    UBaseType_t prio = 0;
+
+    esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_pthread_pool_reserve(&cfg, 1));
+
+    cfg.prio = CONFIG_PTHREAD_TASK_PRIO_DEFAULT + 1;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_pthread_set_cfg(&cfg));
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, get_task_priority, &prio));
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+    TEST_ASSERT_EQUAL(CONFIG_PTHREAD_TASK_PRIO_DEFAULT + 1, prio);
+
+    cfg = esp_pthread_get_default_config();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_pthread_set_cfg(&cfg));
+    esp_pthread_pool_clear();
+}
+
+TEST_CASE("esp_pthread_pool_reserve checks its arguments", "[pthread-pool]")
+{
+    esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_pthread_pool_reserve(&cfg, CONFIG_PTHREAD_TASK_POOL_SIZE + 1));
+
+    cfg.stack_alloc_caps = MALLOC_CAP_32BIT;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_pthread_pool_reserve(&cfg, 1));
+
+    cfg = esp_pthread_get_default_config();
+    cfg.stack_size = PTHREAD_STACK_MIN - 1;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_pthread_pool_reserve(&cfg, 1));
+}
+
+#endif // CONFIG_PTHREAD_TASK_POOL_SIZE > 0
@@ -30,6 +30,19 @@ def test_pthread_single_core(dut: Dut) -> None:
     dut.run_all_single_board_cases(group='!thread-specific', timeout=300)
 
 
+@pytest.mark.generic
+@pytest.mark.supported_targets
+@pytest.mark.parametrize(
+    'config',
+    [
+        'task_pool',
+    ],
+    indirect=True,
+)
+def test_pthread_task_pool(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='pthread-pool', timeout=300)
+
+
 @pytest.mark.generic
 @pytest.mark.supported_targets
 @pytest.mark.parametrize(
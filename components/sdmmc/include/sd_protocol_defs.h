@@ -3,7 +3,7 @@
  *
  * SPDX-License-Identifier: ISC
  *
- * SPDX-FileContributor: 2016-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileContributor: 2016-2024 Espressif Systems (Shanghai) CO LTD
  */
 /*
  * Copyright (c) 2006 Uwe Stuehler <uwe@openbsd.org>
@@ -46,6 +46,7 @@ extern "C" {
 #define MMC_SET_BLOCKLEN                16      /* R1 */
 #define MMC_READ_BLOCK_SINGLE           17      /* R1 */
 #define MMC_READ_BLOCK_MULTIPLE         18      /* R1 */
+#define MMC_SEND_TUNING_BLOCK_HS200     21      /* R1 */
 #define MMC_WRITE_DAT_UNTIL_STOP        20      /* R1 */
 #define MMC_SET_BLOCK_COUNT             23      /* R1 */
 #define MMC_WRITE_BLOCK_SINGLE          24      /* R1 */
@@ -59,6 +60,8 @@ extern "C" {
 #define SD_SEND_RELATIVE_ADDR           3       /* R6 */
 #define SD_SEND_SWITCH_FUNC             6       /* R1 */
 #define SD_SEND_IF_COND                 8       /* R7 */
+#define SD_SWITCH_VOLTAGE               11      /* R1 */
+#define SD_SEND_TUNING_BLOCK            19      /* R1 */
 #define SD_ERASE_GROUP_START            32      /* R1 */
 #define SD_ERASE_GROUP_END              33      /* R1 */
 #define SD_READ_OCR                     58      /* R3 */
@@ -67,6 +70,7 @@ extern "C" {
 /* SD application commands */                   /* response type */
 #define SD_APP_SET_BUS_WIDTH            6       /* R1 */
 #define SD_APP_SD_STATUS                13      /* R2 */
+#define SD_APP_SET_WR_BLK_ERASE_COUNT   23      /* R1 */
 #define SD_APP_OP_COND                  41      /* R3 */
 #define SD_APP_SEND_SCR                 51      /* R1 */
 
@@ -99,6 +103,7 @@ extern "C" {
 #define MMC_OCR_1_65V_1_95V             (1<<7)
 
 #define SD_OCR_SDHC_CAP                 (1<<30)
+#define SD_OCR_S18_RA                   (1<<24) /* S18R in ACMD41 argument, S18A in response */
 #define SD_OCR_VOL_MASK                 0xFF8000 /* bits 23:15 */
 
 /* SD mode R1 response type bits */
@@ -164,6 +169,9 @@ extern "C" {
 #define SD_ARG_BUS_WIDTH_1              0
 #define SD_ARG_BUS_WIDTH_4              2
 
+/* SD_APP_SET_WR_BLK_ERASE_COUNT (ACMD23) argument */
+#define SD_ARG_WR_BLK_ERASE_COUNT_MASK  0x7FFFFF /* bits 22:0 */
+
 /* EXT_CSD fields */
 #define EXT_CSD_SANITIZE_START          165     /* WO */
 #define EXT_CSD_ERASED_MEM_CONT         181     /* RO */
@@ -180,6 +188,7 @@ extern "C" {
 #define EXT_CSD_PWR_CL_26_360           203     /* RO */
 #define EXT_CSD_SEC_COUNT               212     /* RO */
 #define EXT_CSD_SEC_FEATURE_SUPPORT     231     /* RO */
+#define EXT_CSD_PWR_CL_200_360          237     /* RO */
 #define EXT_CSD_S_CMD_SET               504     /* RO */
 
 /* EXT_CSD field definitions */
@@ -209,6 +218,8 @@ extern "C" {
 #define EXT_CSD_CARD_TYPE_F_52M         (1 << 1)        /* SDR at "rated voltages */
 #define EXT_CSD_CARD_TYPE_F_52M_1_8V    (1 << 2)        /* DDR, 1.8V or 3.3V I/O */
 #define EXT_CSD_CARD_TYPE_F_52M_1_2V    (1 << 3)        /* DDR, 1.2V I/O */
+#define EXT_CSD_CARD_TYPE_F_HS200_1_8V  (1 << 4)        /* HS200 SDR, 1.8V I/O */
+#define EXT_CSD_CARD_TYPE_F_HS200_1_2V  (1 << 5)        /* HS200 SDR, 1.2V I/O */
 #define EXT_CSD_CARD_TYPE_26M           0x01
 #define EXT_CSD_CARD_TYPE_52M           0x03
 #define EXT_CSD_CARD_TYPE_52M_V18       0x07
@@ -411,6 +422,9 @@ extern "C" {
 
 #define SD_SSR_SIZE 64                 /* SD status register */
 
+#define SD_TUNING_BLOCK_SIZE            64      /* CMD19, and CMD21 on a 4-bit bus */
+#define MMC_TUNING_BLOCK_SIZE_8BIT      128     /* CMD21 on an 8-bit bus */
+
 /**
  * @brief Extract up to 32 sequential bits from an array of 32-bit words
  *
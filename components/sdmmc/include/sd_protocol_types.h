@@ -108,6 +108,14 @@ typedef struct {
     uint32_t data[512 / 8 / sizeof(uint32_t)];  /*!< response data */
 } sdmmc_switch_func_rsp_t;
 
+/**
+ * Buffer of a scatter-gather data transfer
+ */
+typedef struct {
+    void* buf;                  /*!< DMA capable buffer */
+    size_t size;                /*!< length of the buffer, multiple of 4 bytes */
+} sdmmc_sg_entry_t;
+
 /**
  * SD/MMC command information
  */
@@ -149,6 +157,10 @@ typedef struct {
     /** @endcond */
     esp_err_t error;            /*!< error returned from transfer */
     uint32_t timeout_ms;        /*!< response timeout, in milliseconds */
+    const sdmmc_sg_entry_t* sg; /*!< if not NULL, the data is transferred from or into these buffers in order,
+                                     datalen is their total length and data points to the first one.
+                                     Only for hosts with SDMMC_HOST_FLAG_SG */
+    size_t sg_count;            /*!< number of elements of sg */
 } sdmmc_command_t;
 
 /**
@@ -156,6 +168,7 @@ typedef struct {
  *
  * This will only take effect when the host works in SDMMC_FREQ_HIGHSPEED or SDMMC_FREQ_52M.
  * Driver will print out how long the delay is, in picosecond (ps).
+ * In UHS-I SDR50/SDR104 and HS200 modes, the phase is selected by the tuning procedure instead.
  */
 typedef enum {
     SDMMC_DELAY_PHASE_0,            /*!< Delay phase 0 */
@@ -183,6 +196,10 @@ typedef struct {
                                                  Currently this is only used by the SDIO driver. Set this flag when
                                                  using SDIO CMD53 byte mode, with user buffer that is behind the cache
                                                  or not aligned to 4 byte boundary. */
+#define SDMMC_HOST_FLAG_SG      BIT(7)      /*!< host supports scatter-gather data transfers, see sdmmc_command_t::sg */
+#define SDMMC_HOST_FLAG_UHS1    BIT(8)      /*!< host supports UHS-I SDR50 and SDR104 modes of SD cards.
+                                                 The I/O voltage is switched to 1.8V through `pwr_ctrl_handle`. */
+#define SDMMC_HOST_FLAG_HS200   BIT(9)      /*!< host supports HS200 mode of eMMC devices, with `io_voltage` of 1.8V */
     int slot;                   /*!< slot number, to be passed to host functions */
     int max_freq_khz;           /*!< max frequency supported by the host */
 #define SDMMC_FREQ_DEFAULT      20000       /*!< SD/MMC Default speed (limited by clock divider) */
@@ -190,7 +207,10 @@ typedef struct {
 #define SDMMC_FREQ_PROBING      400         /*!< SD/MMC probing speed */
 #define SDMMC_FREQ_52M          52000       /*!< MMC 52MHz speed */
 #define SDMMC_FREQ_26M          26000       /*!< MMC 26MHz speed */
-    float io_voltage;           /*!< I/O voltage used by the controller (voltage switching is not supported) */
+#define SDMMC_FREQ_SDR50        100000      /*!< SD UHS-I SDR50 speed (limited by clock divider) */
+#define SDMMC_FREQ_SDR104       208000      /*!< SD UHS-I SDR104 speed (limited by clock divider) */
+#define SDMMC_FREQ_HS200        200000      /*!< MMC HS200 speed (limited by clock divider) */
+    float io_voltage;           /*!< I/O voltage used by the controller. Switched to 1.8V by the driver in UHS-I mode */
     esp_err_t (*init)(void);    /*!< Host function to initialize the driver */
     esp_err_t (*set_bus_width)(int slot, size_t width);    /*!< host function to set bus width */
     size_t (*get_bus_width)(int slot); /*!< host function to get bus width */
@@ -229,7 +249,7 @@ typedef struct {
     sdmmc_ssr_t ssr;            /*!< decoded SSR (SD Status Register) value */
     sdmmc_ext_csd_t ext_csd;    /*!< decoded EXT_CSD (Extended Card Specific Data) register value */
     uint16_t rca;               /*!< RCA (Relative Card Address) */
-    uint16_t max_freq_khz;      /*!< Maximum frequency, in kHz, supported by the card */
+    uint32_t max_freq_khz;      /*!< Maximum frequency, in kHz, supported by the card */
     int real_freq_khz;          /*!< Real working frequency, in kHz, configured on the host controller */
     uint32_t is_mem : 1;        /*!< Bit indicates if the card is a memory card */
     uint32_t is_sdio : 1;       /*!< Bit indicates if the card is an IO card */
@@ -237,7 +257,9 @@ typedef struct {
     uint32_t num_io_functions : 3;  /*!< If is_sdio is 1, contains the number of IO functions on the card */
     uint32_t log_bus_width : 2; /*!< log2(bus width supported by card) */
     uint32_t is_ddr : 1;        /*!< Card supports DDR mode */
-    uint32_t reserved : 23;     /*!< Reserved for future expansion */
+    uint32_t is_uhs1 : 1;       /*!< Card works with 1.8V signalling in a UHS-I mode */
+    uint32_t is_hs200 : 1;      /*!< Card works in HS200 mode */
+    uint32_t reserved : 21;     /*!< Reserved for future expansion */
 } sdmmc_card_t;
 
 /**
@@ -81,6 +81,48 @@ esp_err_t sdmmc_write_sectors(sdmmc_card_t* card, const void* src,
 esp_err_t sdmmc_read_sectors(sdmmc_card_t* card, void* dst,
         size_t start_sector, size_t sector_count);
 
+/**
+ * Write sectors to SD/MMC card from several buffers
+ *
+ * If the host supports scatter-gather transfers (SDMMC_HOST_FLAG_SG) and all buffers
+ * can be used for DMA, the sectors are written with a single multi-block write command.
+ * Otherwise, each buffer is written with sdmmc_write_sectors().
+ *
+ * @param card  pointer to card information structure previously initialized
+ *              using sdmmc_card_init
+ * @param sg    buffers to read data from, in order; the size of each buffer
+ *              must be a multiple of card->csd.sector_size
+ * @param sg_count  number of buffers
+ * @param start_sector  sector where to start writing
+ * @return
+ *      - ESP_OK on success or sg_count equal to 0
+ *      - ESP_ERR_INVALID_SIZE if the size of a buffer is not a multiple of the sector size
+ *      - One of the error codes from SDMMC host controller
+ */
+esp_err_t sdmmc_write_sectors_sg(sdmmc_card_t* card, const sdmmc_sg_entry_t* sg, size_t sg_count,
+        size_t start_sector);
+
+/**
+ * Read sectors from the SD/MMC card into several buffers
+ *
+ * If the host supports scatter-gather transfers (SDMMC_HOST_FLAG_SG) and all buffers
+ * can be used for DMA, the sectors are read with a single multi-block read command.
+ * Otherwise, each buffer is read with sdmmc_read_sectors().
+ *
+ * @param card  pointer to card information structure previously initialized
+ *              using sdmmc_card_init
+ * @param sg    buffers to write data into, in order; the size of each buffer
+ *              must be a multiple of card->csd.sector_size
+ * @param sg_count  number of buffers
+ * @param start_sector  sector where to start reading
+ * @return
+ *      - ESP_OK on success or sg_count equal to 0
+ *      - ESP_ERR_INVALID_SIZE if the size of a buffer is not a multiple of the sector size
+ *      - One of the error codes from SDMMC host controller
+ */
+esp_err_t sdmmc_read_sectors_sg(sdmmc_card_t* card, const sdmmc_sg_entry_t* sg, size_t sg_count,
+        size_t start_sector);
+
 /**
  * Erase given number of sectors from the SD/MMC card
  *
@@ -394,6 +394,40 @@ esp_err_t sdmmc_send_cmd_send_status(sdmmc_card_t* card, uint32_t* out_status)
     return ESP_OK;
 }
 
+esp_err_t sdmmc_send_cmd_set_wr_blk_erase_count(sdmmc_card_t* card, size_t block_count)
+{
+    sdmmc_command_t cmd = {
+            .opcode = SD_APP_SET_WR_BLK_ERASE_COUNT,
+            .arg = block_count & SD_ARG_WR_BLK_ERASE_COUNT_MASK,
+            .flags = SCF_CMD_AC | SCF_RSP_R1
+    };
+    return sdmmc_send_app_cmd(card, &cmd);
+}
+
+static esp_err_t write_sectors_dma(sdmmc_card_t* card, const void* src, const sdmmc_sg_entry_t* sg, size_t sg_count,
+        size_t start_block, size_t block_count, size_t buffer_len);
+static esp_err_t read_sectors_dma(sdmmc_card_t* card, void* dst, const sdmmc_sg_entry_t* sg, size_t sg_count,
+        size_t start_block, size_t block_count, size_t buffer_len);
+
+/* Allocates a DMA-capable bounce buffer for up to SDMMC_BOUNCE_BUF_MAX_BLOCKS blocks,
+ * retrying with fewer blocks if there is not enough memory.
+ */
+static esp_err_t alloc_bounce_buffer(size_t block_size, size_t block_count, esp_dma_mem_info_t* dma_mem_info,
+        void** out_buf, size_t* out_size, size_t* out_block_count)
+{
+    size_t count = MIN(block_count, SDMMC_BOUNCE_BUF_MAX_BLOCKS);
+    esp_err_t err;
+    while (true) {
+        err = esp_dma_capable_malloc(block_size * count, dma_mem_info, out_buf, out_size);
+        if (err == ESP_OK || count == 1) {
+            break;
+        }
+        count /= 2;
+    }
+    *out_block_count = count;
+    return err;
+}
+
 esp_err_t sdmmc_write_sectors(sdmmc_card_t* card, const void* src,
         size_t start_block, size_t block_count)
 {
@@ -416,23 +450,25 @@ esp_err_t sdmmc_write_sectors(sdmmc_card_t* card, const void* src,
         err = sdmmc_write_sectors_dma(card, src, start_block, block_count, block_size * block_count);
     } else {
         // SDMMC peripheral needs DMA-capable buffers. Split the write into
-        // separate single block writes, if needed, and allocate a temporary
+        // several multi-block writes, if needed, and allocate a temporary
         // DMA-capable buffer.
         void *tmp_buf = NULL;
         size_t actual_size = 0;
+        size_t chunk_blocks = 0;
         // Clear the SPIRAM flag. We don't want to force the allocation into SPIRAM, the allocator
         // will decide based on the buffer size and memory availability.
         dma_mem_info.extra_heap_caps &= ~MALLOC_CAP_SPIRAM;
-        err = esp_dma_capable_malloc(block_size, &dma_mem_info, &tmp_buf, &actual_size);
+        err = alloc_bounce_buffer(block_size, block_count, &dma_mem_info, &tmp_buf, &actual_size, &chunk_blocks);
         if (err != ESP_OK) {
             return err;
         }
 
         const uint8_t* cur_src = (const uint8_t*) src;
-        for (size_t i = 0; i < block_count; ++i) {
-            memcpy(tmp_buf, cur_src, block_size);
-            cur_src += block_size;
-            err = sdmmc_write_sectors_dma(card, tmp_buf, start_block + i, 1, actual_size);
+        for (size_t i = 0; i < block_count; i += chunk_blocks) {
+            size_t count = MIN(chunk_blocks, block_count - i);
+            memcpy(tmp_buf, cur_src, block_size * count);
+            cur_src += block_size * count;
+            err = sdmmc_write_sectors_dma(card, tmp_buf, start_block + i, count, actual_size);
             if (err != ESP_OK) {
                 ESP_LOGD(TAG, "%s: error 0x%x writing block %d+%d",
                         __func__, err, start_block, i);
@@ -446,6 +482,12 @@ esp_err_t sdmmc_write_sectors(sdmmc_card_t* card, const void* src,
 
 esp_err_t sdmmc_write_sectors_dma(sdmmc_card_t* card, const void* src,
         size_t start_block, size_t block_count, size_t buffer_len)
+{
+    return write_sectors_dma(card, src, NULL, 0, start_block, block_count, buffer_len);
+}
+
+static esp_err_t write_sectors_dma(sdmmc_card_t* card, const void* src, const sdmmc_sg_entry_t* sg, size_t sg_count,
+        size_t start_block, size_t block_count, size_t buffer_len)
 {
     if (start_block + block_count > card->csd.capacity) {
         return ESP_ERR_INVALID_SIZE;
@@ -457,7 +499,9 @@ esp_err_t sdmmc_write_sectors_dma(sdmmc_card_t* card, const void* src,
             .data = (void*) src,
             .datalen = block_count * block_size,
             .buflen = buffer_len,
-            .timeout_ms = SDMMC_WRITE_CMD_TIMEOUT_MS
+            .timeout_ms = SDMMC_WRITE_CMD_TIMEOUT_MS,
+            .sg = sg,
+            .sg_count = sg_count,
     };
     if (block_count == 1) {
         cmd.opcode = MMC_WRITE_BLOCK_SINGLE;
@@ -469,6 +513,15 @@ esp_err_t sdmmc_write_sectors_dma(sdmmc_card_t* card, const void* src,
     } else {
         cmd.arg = start_block * block_size;
     }
+    if (block_count > 1 && !card->is_mmc) {
+        /* Let the SD card pre-erase the blocks of the multi-block write. This is only a hint
+         * for the card, so the write goes on if the command fails.
+         */
+        esp_err_t err = sdmmc_send_cmd_set_wr_blk_erase_count(card, block_count);
+        if (err != ESP_OK) {
+            ESP_LOGD(TAG, "%s: sdmmc_send_cmd_set_wr_blk_erase_count returned 0x%x", __func__, err);
+        }
+    }
     esp_err_t err = sdmmc_send_cmd(card, &cmd);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "%s: sdmmc_send_cmd returned 0x%x", __func__, err);
@@ -543,32 +596,116 @@ esp_err_t sdmmc_read_sectors(sdmmc_card_t* card, void* dst,
         err = sdmmc_read_sectors_dma(card, dst, start_block, block_count, block_size * block_count);
     } else {
         // SDMMC peripheral needs DMA-capable buffers. Split the read into
-        // separate single block reads, if needed, and allocate a temporary
+        // several multi-block reads, if needed, and allocate a temporary
         // DMA-capable buffer.
         void *tmp_buf = NULL;
         size_t actual_size = 0;
-        err = esp_dma_capable_malloc(block_size, &dma_mem_info, &tmp_buf, &actual_size);
+        size_t chunk_blocks = 0;
+        err = alloc_bounce_buffer(block_size, block_count, &dma_mem_info, &tmp_buf, &actual_size, &chunk_blocks);
         if (err != ESP_OK) {
             return err;
         }
         uint8_t* cur_dst = (uint8_t*) dst;
-        for (size_t i = 0; i < block_count; ++i) {
-            err = sdmmc_read_sectors_dma(card, tmp_buf, start_block + i, 1, actual_size);
+        for (size_t i = 0; i < block_count; i += chunk_blocks) {
+            size_t count = MIN(chunk_blocks, block_count - i);
+            err = sdmmc_read_sectors_dma(card, tmp_buf, start_block + i, count, actual_size);
             if (err != ESP_OK) {
                 ESP_LOGD(TAG, "%s: error 0x%x writing block %d+%d",
                         __func__, err, start_block, i);
                 break;
             }
-            memcpy(cur_dst, tmp_buf, block_size);
-            cur_dst += block_size;
+            memcpy(cur_dst, tmp_buf, block_size * count);
+            cur_dst += block_size * count;
         }
         free(tmp_buf);
     }
     return err;
 }
 
+/* Checks the buffers of a scatter-gather transfer. Returns the number of sectors in *out_block_count,
+ * and whether all buffers can be used for DMA by the host in one command in *out_use_sg.
+ */
+static esp_err_t check_sg_entries(sdmmc_card_t* card, const sdmmc_sg_entry_t* sg, size_t sg_count,
+        size_t* out_block_count, bool* out_use_sg)
+{
+    if (sg == NULL && sg_count > 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t block_size = card->csd.sector_size;
+    esp_dma_mem_info_t dma_mem_info;
+    card->host.get_dma_info(card->host.slot, &dma_mem_info);
+#ifdef SOC_SDMMC_PSRAM_DMA_CAPABLE
+    dma_mem_info.extra_heap_caps |= MALLOC_CAP_SPIRAM;
+#endif
+    size_t block_count = 0;
+    bool use_sg = (card->host.flags & SDMMC_HOST_FLAG_SG) != 0;
+    for (size_t i = 0; i < sg_count; ++i) {
+        if (sg[i].size == 0 || sg[i].size % block_size != 0) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        block_count += sg[i].size / block_size;
+        if (!esp_dma_is_buffer_alignment_satisfied(sg[i].buf, sg[i].size, dma_mem_info)
+            #if !SOC_SDMMC_PSRAM_DMA_CAPABLE
+                || esp_ptr_external_ram(sg[i].buf)
+            #endif
+        ) {
+            use_sg = false;
+        }
+    }
+    *out_block_count = block_count;
+    *out_use_sg = use_sg;
+    return ESP_OK;
+}
+
+esp_err_t sdmmc_write_sectors_sg(sdmmc_card_t* card, const sdmmc_sg_entry_t* sg, size_t sg_count,
+        size_t start_sector)
+{
+    size_t block_count;
+    bool use_sg;
+    esp_err_t err = check_sg_entries(card, sg, sg_count, &block_count, &use_sg);
+    if (err != ESP_OK || block_count == 0) {
+        return err;
+    }
+    if (use_sg && sg_count > 1) {
+        return write_sectors_dma(card, sg[0].buf, sg, sg_count, start_sector, block_count, sg[0].size);
+    }
+    // One command per buffer, bouncing the buffers which can not be used for DMA
+    for (size_t i = 0; i < sg_count && err == ESP_OK; ++i) {
+        const size_t count = sg[i].size / card->csd.sector_size;
+        err = sdmmc_write_sectors(card, sg[i].buf, start_sector, count);
+        start_sector += count;
+    }
+    return err;
+}
+
+esp_err_t sdmmc_read_sectors_sg(sdmmc_card_t* card, const sdmmc_sg_entry_t* sg, size_t sg_count,
+        size_t start_sector)
+{
+    size_t block_count;
+    bool use_sg;
+    esp_err_t err = check_sg_entries(card, sg, sg_count, &block_count, &use_sg);
+    if (err != ESP_OK || block_count == 0) {
+        return err;
+    }
+    if (use_sg && sg_count > 1) {
+        return read_sectors_dma(card, sg[0].buf, sg, sg_count, start_sector, block_count, sg[0].size);
+    }
+    for (size_t i = 0; i < sg_count && err == ESP_OK; ++i) {
+        const size_t count = sg[i].size / card->csd.sector_size;
+        err = sdmmc_read_sectors(card, sg[i].buf, start_sector, count);
+        start_sector += count;
+    }
+    return err;
+}
+
 esp_err_t sdmmc_read_sectors_dma(sdmmc_card_t* card, void* dst,
         size_t start_block, size_t block_count, size_t buffer_len)
+{
+    return read_sectors_dma(card, dst, NULL, 0, start_block, block_count, buffer_len);
+}
+
+static esp_err_t read_sectors_dma(sdmmc_card_t* card, void* dst, const sdmmc_sg_entry_t* sg, size_t sg_count,
+        size_t start_block, size_t block_count, size_t buffer_len)
 {
     if (start_block + block_count > card->csd.capacity) {
         return ESP_ERR_INVALID_SIZE;
@@ -580,6 +717,8 @@ esp_err_t sdmmc_read_sectors_dma(sdmmc_card_t* card, void* dst,
             .data = (void*) dst,
             .datalen = block_count * block_size,
             .buflen = buffer_len,
+            .sg = sg,
+            .sg_count = sg_count,
     };
     if (block_count == 1) {
         cmd.opcode = MMC_READ_BLOCK_SINGLE;
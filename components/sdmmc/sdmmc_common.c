@@ -40,6 +40,10 @@ esp_err_t sdmmc_init_ocr(sdmmc_card_t* card)
 
     if ((card->ocr & SD_OCR_SDHC_CAP) != 0) {
         acmd41_arg |= SD_OCR_SDHC_CAP;
+        /* Only SDHC/SDXC cards may accept to switch to 1.8V signalling */
+        if (host_can_do_uhs1(card)) {
+            acmd41_arg |= SD_OCR_S18_RA;
+        }
     }
 
     /* Send SEND_OP_COND (ACMD41) command to the card until it becomes ready. */
@@ -49,6 +53,7 @@ esp_err_t sdmmc_init_ocr(sdmmc_card_t* card)
     if (err == ESP_ERR_TIMEOUT && !host_is_spi(card)) {
         ESP_LOGD(TAG, "send_op_cond timeout, trying MMC");
         card->is_mmc = 1;
+        acmd41_arg &= ~SD_OCR_S18_RA;
         err = sdmmc_send_cmd_send_op_cond(card, acmd41_arg, &card->ocr);
     }
 
@@ -56,6 +61,10 @@ esp_err_t sdmmc_init_ocr(sdmmc_card_t* card)
         ESP_LOGE(TAG, "%s: send_op_cond (1) returned 0x%x", __func__, err);
         return err;
     }
+    if ((acmd41_arg & SD_OCR_S18_RA) && (card->ocr & SD_OCR_S18_RA)) {
+        ESP_LOGD(TAG, "card accepts 1.8V signalling");
+        card->is_uhs1 = 1;
+    }
     if (host_is_spi(card)) {
         err = sdmmc_send_cmd_read_ocr(card, &card->ocr);
         if (err != ESP_OK) {
@@ -250,6 +259,135 @@ esp_err_t sdmmc_init_host_frequency(sdmmc_card_t* card)
     return ESP_OK;
 }
 
+/* Tuning block patterns, as defined by the SD and eMMC specifications */
+static const uint8_t s_tuning_block_4bit[SD_TUNING_BLOCK_SIZE] = {
+    0xff, 0x0f, 0xff, 0x00, 0xff, 0xcc, 0xc3, 0xcc,
+    0xc3, 0x3c, 0xcc, 0xff, 0xfe, 0xff, 0xfe, 0xef,
+    0xff, 0xdf, 0xff, 0xdd, 0xff, 0xfb, 0xff, 0xfb,
+    0xbf, 0xff, 0x7f, 0xff, 0x77, 0xf7, 0xbd, 0xef,
+    0xff, 0xf0, 0xff, 0xf0, 0x0f, 0xfc, 0xcc, 0x3c,
+    0xcc, 0x33, 0xcc, 0xcf, 0xff, 0xef, 0xff, 0xee,
+    0xff, 0xfd, 0xff, 0xfd, 0xdf, 0xff, 0xbf, 0xff,
+    0xbb, 0xff, 0xf7, 0xff, 0xf7, 0x7f, 0x7b, 0xde,
+};
+
+static const uint8_t s_tuning_block_8bit[MMC_TUNING_BLOCK_SIZE_8BIT] = {
+    0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00,
+    0xff, 0xff, 0xcc, 0xcc, 0xcc, 0x33, 0xcc, 0xcc,
+    0xcc, 0x33, 0x33, 0xcc, 0xcc, 0xcc, 0xff, 0xff,
+    0xff, 0xee, 0xff, 0xff, 0xff, 0xee, 0xee, 0xff,
+    0xff, 0xff, 0xdd, 0xff, 0xff, 0xff, 0xdd, 0xdd,
+    0xff, 0xff, 0xff, 0xbb, 0xff, 0xff, 0xff, 0xbb,
+    0xbb, 0xff, 0xff, 0xff, 0x77, 0xff, 0xff, 0xff,
+    0x77, 0x77, 0xff, 0x77, 0xbb, 0xdd, 0xee, 0xff,
+    0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0x00,
+    0x00, 0xff, 0xff, 0xcc, 0xcc, 0xcc, 0x33, 0xcc,
+    0xcc, 0xcc, 0x33, 0x33, 0xcc, 0xcc, 0xcc, 0xff,
+    0xff, 0xff, 0xee, 0xff, 0xff, 0xff, 0xee, 0xee,
+    0xff, 0xff, 0xff, 0xdd, 0xff, 0xff, 0xff, 0xdd,
+    0xdd, 0xff, 0xff, 0xff, 0xbb, 0xff, 0xff, 0xff,
+    0xbb, 0xbb, 0xff, 0xff, 0xff, 0x77, 0xff, 0xff,
+    0xff, 0x77, 0x77, 0xff, 0x77, 0xbb, 0xdd, 0xee,
+};
+
+static bool tuning_phase_passes(sdmmc_card_t* card, sdmmc_delay_phase_t phase,
+        void* buf, size_t buf_size, const uint8_t* pattern, size_t pattern_size)
+{
+    esp_err_t err = (*card->host.set_input_delay)(card->host.slot, phase);
+    if (err != ESP_OK) {
+        ESP_LOGD(TAG, "%s: phase %d can't be set (0x%x)", __func__, phase, err);
+        return false;
+    }
+    for (int i = 0; i < SDMMC_TUNING_BLOCKS_PER_PHASE; ++i) {
+        sdmmc_command_t cmd = {
+            .opcode = card->is_mmc ? MMC_SEND_TUNING_BLOCK_HS200 : SD_SEND_TUNING_BLOCK,
+            .flags = SCF_CMD_ADTC | SCF_CMD_READ | SCF_RSP_R1,
+            .data = buf,
+            .datalen = pattern_size,
+            .buflen = buf_size,
+            .blklen = pattern_size,
+        };
+        memset(buf, 0, pattern_size);
+        err = sdmmc_send_cmd(card, &cmd);
+        if (err != ESP_OK || memcmp(buf, pattern, pattern_size) != 0) {
+            ESP_LOGV(TAG, "%s: phase %d, block %d failed (0x%x)", __func__, phase, i, err);
+            return false;
+        }
+    }
+    return true;
+}
+
+esp_err_t sdmmc_init_host_tuning(sdmmc_card_t* card)
+{
+    /* Above 50 MHz, the data output delay of the card is a large part of the
+     * clock period, so the sampling point of the host is found by trying each
+     * input delay phase with tuning blocks, and choosing the middle of the
+     * widest range of phases which work.
+     */
+    const bool uhs1_tuning = card->is_uhs1 && card->max_freq_khz > SDMMC_FREQ_HIGHSPEED;
+    if (!uhs1_tuning && !card->is_hs200) {
+        return ESP_OK;
+    }
+    if (card->host.set_input_delay == NULL) {
+        ESP_LOGW(TAG, "host can't change input delay phase, skipping tuning");
+        return ESP_OK;
+    }
+
+    const uint8_t* pattern = s_tuning_block_4bit;
+    size_t pattern_size = sizeof(s_tuning_block_4bit);
+    if (card->is_mmc && card->log_bus_width == 3) {
+        pattern = s_tuning_block_8bit;
+        pattern_size = sizeof(s_tuning_block_8bit);
+    }
+    void* buf = NULL;
+    size_t actual_size = 0;
+    esp_dma_mem_info_t dma_mem_info;
+    card->host.get_dma_info(card->host.slot, &dma_mem_info);
+    esp_err_t err = esp_dma_capable_malloc(pattern_size, &dma_mem_info, &buf, &actual_size);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    bool passes[SDMMC_DELAY_PHASE_COUNT];
+    int pass_count = 0;
+    for (int phase = 0; phase < SDMMC_DELAY_PHASE_COUNT; ++phase) {
+        passes[phase] = tuning_phase_passes(card, phase, buf, actual_size, pattern, pattern_size);
+        pass_count += passes[phase];
+    }
+    free(buf);
+    if (pass_count == 0) {
+        ESP_LOGE(TAG, "%s: no input delay phase works at %d kHz", __func__, card->real_freq_khz);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    /* The phases are evenly spaced over one clock period, so a range of
+     * working phases may wrap around from the last one to the first one.
+     */
+    int best_start = 0;
+    int best_len = 0;
+    for (int start = 0; start < SDMMC_DELAY_PHASE_COUNT; ++start) {
+        int len = 0;
+        while (len < SDMMC_DELAY_PHASE_COUNT && passes[(start + len) % SDMMC_DELAY_PHASE_COUNT]) {
+            ++len;
+        }
+        if (len > best_len) {
+            best_start = start;
+            best_len = len;
+        }
+    }
+    const sdmmc_delay_phase_t best = (best_start + (best_len - 1) / 2) % SDMMC_DELAY_PHASE_COUNT;
+    ESP_LOGD(TAG, "%s: %d of %d phases work, using phase %d", __func__,
+             pass_count, SDMMC_DELAY_PHASE_COUNT, best);
+
+    err = (*card->host.set_input_delay)(card->host.slot, best);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "host.set_input_delay failed (0x%x)", err);
+        return err;
+    }
+    card->host.input_delay_phase = best;
+    return ESP_OK;
+}
+
 void sdmmc_flip_byte_order(uint32_t* response, size_t size)
 {
     assert(size % (2 * sizeof(uint32_t)) == 0);
@@ -290,7 +428,11 @@ void sdmmc_card_print_info(FILE* stream, const sdmmc_card_t* card)
         const float freq = card->real_freq_khz < 1000 ? card->real_freq_khz : card->real_freq_khz / 1000.0;
         const char *max_freq_unit = card->max_freq_khz < 1000 ? "kHz" : "MHz";
         const float max_freq = card->max_freq_khz < 1000 ? card->max_freq_khz : card->max_freq_khz / 1000.0;
-        fprintf(stream, "Speed: %.2f %s (limit: %.2f %s)%s\n", freq, freq_unit, max_freq, max_freq_unit, card->is_ddr ? ", DDR" : "");
+        const char *bus_mode = card->is_hs200 ? ", HS200" : card->is_uhs1 ? ", UHS-I" : card->is_ddr ? ", DDR" : "";
+        fprintf(stream, "Speed: %.2f %s (limit: %.2f %s)%s\n", freq, freq_unit, max_freq, max_freq_unit, bus_mode);
+        if (card->is_hs200 || card->is_uhs1) {
+            fprintf(stream, "Input delay phase: %d\n", (int) card->host.input_delay_phase);
+        }
     }
 
     fprintf(stream, "Size: %lluMB\n", ((uint64_t) card->csd.capacity) * card->csd.sector_size / (1024 * 1024));
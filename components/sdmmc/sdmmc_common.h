@@ -45,12 +45,29 @@
 
 #define SDMMC_SD_DISCARD_TIMEOUT  250    // SD erase (discard) timeout
 
+/* Maximum number of blocks per transfer when a non DMA-capable buffer has to be
+ * copied through a temporary buffer.
+ */
+#define SDMMC_BOUNCE_BUF_MAX_BLOCKS     8
+
 /* Maximum retry/error count for SEND_OP_COND (CMD1).
  * These are somewhat arbitrary, values originate from OpenBSD driver.
  */
 #define SDMMC_SEND_OP_COND_MAX_RETRIES  300
 #define SDMMC_SEND_OP_COND_MAX_ERRORS   3
 
+/* I/O voltage of UHS-I modes, and time the card needs to switch its I/O lines
+ * after VOLTAGE_SWITCH (CMD11), during which the card clock is stopped.
+ */
+#define SDMMC_UHS1_IO_VOLTAGE_MV        1800
+#define SDMMC_UHS1_VOLTAGE_SWITCH_DELAY_MS  5
+
+/* Number of tuning blocks read with each input delay phase.
+ * A phase is usable only if all of them are received without errors.
+ */
+#define SDMMC_TUNING_BLOCKS_PER_PHASE   4
+#define SDMMC_DELAY_PHASE_COUNT         (SDMMC_DELAY_PHASE_3 + 1)
+
 /* supported arguments for erase command 38 */
 #define SDMMC_SD_ERASE_ARG      0
 #define SDMMC_SD_DISCARD_ARG    1
@@ -77,10 +94,12 @@ esp_err_t sdmmc_send_cmd_send_scr(sdmmc_card_t* card, sdmmc_scr_t *out_scr);
 esp_err_t sdmmc_send_cmd_set_bus_width(sdmmc_card_t* card, int width);
 esp_err_t sdmmc_send_cmd_send_status(sdmmc_card_t* card, uint32_t* out_status);
 esp_err_t sdmmc_send_cmd_crc_on_off(sdmmc_card_t* card, bool crc_enable);
+esp_err_t sdmmc_send_cmd_set_wr_blk_erase_count(sdmmc_card_t* card, size_t block_count);
 
 /* Higher level functions */
 esp_err_t sdmmc_enable_hs_mode(sdmmc_card_t* card);
 esp_err_t sdmmc_enable_hs_mode_and_check(sdmmc_card_t* card);
+esp_err_t sdmmc_enable_uhs1_mode(sdmmc_card_t* card);
 esp_err_t sdmmc_write_sectors_dma(sdmmc_card_t* card, const void* src,
         size_t start_block, size_t block_count, size_t buffer_len);
 esp_err_t sdmmc_read_sectors_dma(sdmmc_card_t* card, void* dst,
@@ -130,6 +149,7 @@ esp_err_t sdmmc_init_sd_blocklen(sdmmc_card_t* card);
 esp_err_t sdmmc_init_sd_scr(sdmmc_card_t* card);
 esp_err_t sdmmc_init_sd_ssr(sdmmc_card_t* card);
 esp_err_t sdmmc_init_sd_wait_data_ready(sdmmc_card_t* card);
+esp_err_t sdmmc_init_sd_uhs1_voltage_switch(sdmmc_card_t* card);
 esp_err_t sdmmc_init_mmc_read_ext_csd(sdmmc_card_t* card);
 esp_err_t sdmmc_init_mmc_read_cid(sdmmc_card_t* card);
 esp_err_t sdmmc_init_host_bus_width(sdmmc_card_t* card);
@@ -138,6 +158,7 @@ esp_err_t sdmmc_init_io_bus_width(sdmmc_card_t* card);
 esp_err_t sdmmc_init_mmc_bus_width(sdmmc_card_t* card);
 esp_err_t sdmmc_init_card_hs_mode(sdmmc_card_t* card);
 esp_err_t sdmmc_init_host_frequency(sdmmc_card_t* card);
+esp_err_t sdmmc_init_host_tuning(sdmmc_card_t* card);
 esp_err_t sdmmc_init_mmc_check_ext_csd(sdmmc_card_t* card);
 
 /* Various helper functions */
@@ -146,6 +167,16 @@ static inline bool host_is_spi(const sdmmc_card_t* card)
     return (card->host.flags & SDMMC_HOST_FLAG_SPI) != 0;
 }
 
+static inline bool host_can_do_uhs1(const sdmmc_card_t* card)
+{
+    /* UHS-I modes are only defined for 4-line SD mode, and need the I/O voltage to be switched */
+    return !host_is_spi(card) &&
+           (card->host.flags & SDMMC_HOST_FLAG_UHS1) &&
+           (card->host.flags & SDMMC_HOST_FLAG_4BIT) &&
+           card->host.pwr_ctrl_handle != NULL &&
+           card->host.max_freq_khz > SDMMC_FREQ_HIGHSPEED;
+}
+
 static inline uint32_t get_host_ocr(float voltage)
 {
     // TODO: report exact voltage to the card
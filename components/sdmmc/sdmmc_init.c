@@ -95,6 +95,9 @@ esp_err_t sdmmc_card_init(const sdmmc_host_t* config, sdmmc_card_t* card)
     ESP_LOGD(TAG, "%s: card type is %s", __func__,
             is_sdio ? "SDIO" : is_mmc ? "MMC" : "SD");
 
+    /* Switch SD card and host to 1.8V signalling, if the card has accepted it */
+    SDMMC_INIT_STEP(is_sdmem, sdmmc_init_sd_uhs1_voltage_switch);
+
     /* Read the contents of CID register*/
     SDMMC_INIT_STEP(is_mem, sdmmc_init_cid);
 
@@ -148,6 +151,9 @@ esp_err_t sdmmc_card_init(const sdmmc_host_t* config, sdmmc_card_t* card)
     /* Switch to the host to use card->max_freq_khz frequency. */
     SDMMC_INIT_STEP(always, sdmmc_init_host_frequency);
 
+    /* Find the input delay phase for UHS-I SDR50/SDR104 and HS200 modes */
+    SDMMC_INIT_STEP(!is_spi, sdmmc_init_host_tuning);
+
     /* Sanity check after switching the bus mode and frequency */
     SDMMC_INIT_STEP(is_sdmem, sdmmc_check_scr);
     /* Sanity check after eMMC switch to HS mode */
@@ -52,7 +52,16 @@ esp_err_t sdmmc_init_mmc_read_ext_csd(sdmmc_card_t* card)
     }
     card_type = ext_csd[EXT_CSD_CARD_TYPE];
     card->is_ddr = 0;
-    if (card_type & EXT_CSD_CARD_TYPE_F_52M_1_8V) {
+    card->is_hs200 = 0;
+    if ((card_type & EXT_CSD_CARD_TYPE_F_HS200_1_8V) &&
+            (card->host.flags & SDMMC_HOST_FLAG_HS200) &&
+            (card->host.flags & (SDMMC_HOST_FLAG_4BIT | SDMMC_HOST_FLAG_8BIT)) &&
+            card->host.io_voltage < 1.95f &&
+            card->host.max_freq_khz > SDMMC_FREQ_52M) {
+        ESP_LOGD(TAG, "card and host support HS200 mode");
+        card->max_freq_khz = SDMMC_FREQ_HS200;
+        card->is_hs200 = 1;
+    } else if (card_type & EXT_CSD_CARD_TYPE_F_52M_1_8V) {
         card->max_freq_khz = SDMMC_FREQ_52M;
         if ((card->host.flags & SDMMC_HOST_FLAG_DDR) &&
                 card->host.max_freq_khz >= SDMMC_FREQ_26M &&
@@ -69,16 +78,21 @@ esp_err_t sdmmc_init_mmc_read_ext_csd(sdmmc_card_t* card)
     }
     /* For MMC cards, use speed value from EXT_CSD */
     card->csd.tr_speed = card->max_freq_khz * 1000;
-    ESP_LOGD(TAG, "MMC card type %d, max_freq_khz=%d, is_ddr=%d", card_type, card->max_freq_khz, card->is_ddr);
+    ESP_LOGD(TAG, "MMC card type %d, max_freq_khz=%" PRIu32 ", is_ddr=%d, is_hs200=%d",
+             card_type, card->max_freq_khz, card->is_ddr, card->is_hs200);
     card->max_freq_khz = MIN(card->max_freq_khz, card->host.max_freq_khz);
 
+    int power_class_index = EXT_CSD_PWR_CL_26_360;
+    if (card->is_hs200) {
+        power_class_index = EXT_CSD_PWR_CL_200_360;
+    } else if (card->max_freq_khz > SDMMC_FREQ_26M) {
+        power_class_index = EXT_CSD_PWR_CL_52_360;
+    }
     if (card->host.flags & SDMMC_HOST_FLAG_8BIT) {
-        card->ext_csd.power_class = ext_csd[(card->max_freq_khz > SDMMC_FREQ_26M) ?
-                EXT_CSD_PWR_CL_52_360 : EXT_CSD_PWR_CL_26_360] >> 4;
+        card->ext_csd.power_class = ext_csd[power_class_index] >> 4;
         card->log_bus_width = 3;
     } else if (card->host.flags & SDMMC_HOST_FLAG_4BIT) {
-        card->ext_csd.power_class = ext_csd[(card->max_freq_khz > SDMMC_FREQ_26M) ?
-                EXT_CSD_PWR_CL_52_360 : EXT_CSD_PWR_CL_26_360] & 0x0f;
+        card->ext_csd.power_class = ext_csd[power_class_index] & 0x0f;
         card->log_bus_width = 2;
     } else {
         card->ext_csd.power_class = 0; //card must be able to do full rate at powerclass 0 in 1-bit mode
@@ -143,12 +157,27 @@ esp_err_t sdmmc_init_mmc_bus_width(sdmmc_card_t* card)
             return err;
         }
     }
+
+    if (card->is_hs200) {
+        /* HS200 timing can only be selected once the bus width is 4 or 8 bit */
+        err = sdmmc_mmc_switch(card, EXT_CSD_CMD_SET_NORMAL,
+                EXT_CSD_HS_TIMING, EXT_CSD_HS_TIMING_HS200);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "%s: mmc_switch EXT_CSD_HS_TIMING_HS200 error 0x%x",
+                    __func__, err);
+            return err;
+        }
+    }
     return ESP_OK;
 }
 
 esp_err_t sdmmc_mmc_enable_hs_mode(sdmmc_card_t* card)
 {
     esp_err_t err;
+    if (card->is_hs200) {
+        /* HS200 timing is selected after the bus width, see sdmmc_init_mmc_bus_width() */
+        return ESP_OK;
+    }
     if (card->max_freq_khz > SDMMC_FREQ_26M) {
         /* switch to high speed timing */
         err = sdmmc_mmc_switch(card, EXT_CSD_CMD_SET_NORMAL,
@@ -170,6 +170,36 @@ esp_err_t sdmmc_init_sd_wait_data_ready(sdmmc_card_t* card)
     return ESP_OK;
 }
 
+esp_err_t sdmmc_init_sd_uhs1_voltage_switch(sdmmc_card_t* card)
+{
+    /* The card has accepted 1.8V signalling in its ACMD41 response.
+     * VOLTAGE_SWITCH (CMD11) makes the card switch its I/O lines, then the host
+     * does the same while the card clock is stopped. The clock is gated by the
+     * host between commands, since the always-on mode ends with ACMD41.
+     */
+    if (!card->is_uhs1) {
+        return ESP_OK;
+    }
+    sdmmc_command_t cmd = {
+        .opcode = SD_SWITCH_VOLTAGE,
+        .flags = SCF_CMD_AC | SCF_RSP_R1,
+    };
+    esp_err_t err = sdmmc_send_cmd(card, &cmd);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "%s: voltage_switch returned 0x%x", __func__, err);
+        return err;
+    }
+    err = sd_pwr_ctrl_set_io_voltage(card->host.pwr_ctrl_handle, SDMMC_UHS1_IO_VOLTAGE_MV);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "%s: failed to set voltage (0x%x)", __func__, err);
+        return err;
+    }
+    card->host.io_voltage = SDMMC_UHS1_IO_VOLTAGE_MV / 1000.0f;
+    vTaskDelay(pdMS_TO_TICKS(SDMMC_UHS1_VOLTAGE_SWITCH_DELAY_MS) + 1);
+    ESP_LOGD(TAG, "switched to 1.8V signalling");
+    return ESP_OK;
+}
+
 esp_err_t sdmmc_send_cmd_switch_func(sdmmc_card_t* card,
         uint32_t mode, uint32_t group, uint32_t function,
         sdmmc_switch_func_rsp_t* resp)
@@ -270,6 +300,61 @@ out:
     return err;
 }
 
+esp_err_t sdmmc_enable_uhs1_mode(sdmmc_card_t* card)
+{
+    /* Select the fastest UHS-I access mode supported by both the card and the host.
+     * ESP_ERR_NOT_SUPPORTED is returned if only SDR12 and SDR25 can be used.
+     */
+    if (card->log_bus_width != 2) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    size_t actual_size = 0;
+    sdmmc_switch_func_rsp_t *response = NULL;
+    esp_dma_mem_info_t dma_mem_info;
+    card->host.get_dma_info(card->host.slot, &dma_mem_info);
+    esp_err_t err = esp_dma_capable_malloc(sizeof(*response), &dma_mem_info, (void *)&response, &actual_size);
+    if (err != ESP_OK) {
+        return err;
+    }
+    assert(actual_size == sizeof(*response));
+
+    err = sdmmc_send_cmd_switch_func(card, 0, SD_ACCESS_MODE, 0, response);
+    if (err != ESP_OK) {
+        ESP_LOGD(TAG, "%s: sdmmc_send_cmd_switch_func (1) returned 0x%x", __func__, err);
+        goto out;
+    }
+    uint32_t supported_mask = SD_SFUNC_SUPPORTED(response->data, 1);
+    uint32_t mode;
+    uint32_t mode_freq_khz;
+    if ((supported_mask & BIT(SD_ACCESS_MODE_SDR104)) && card->host.max_freq_khz > SDMMC_FREQ_SDR50) {
+        mode = SD_ACCESS_MODE_SDR104;
+        mode_freq_khz = SDMMC_FREQ_SDR104;
+    } else if (supported_mask & BIT(SD_ACCESS_MODE_SDR50)) {
+        mode = SD_ACCESS_MODE_SDR50;
+        mode_freq_khz = SDMMC_FREQ_SDR50;
+    } else {
+        err = ESP_ERR_NOT_SUPPORTED;
+        goto out;
+    }
+    err = sdmmc_send_cmd_switch_func(card, 1, SD_ACCESS_MODE, mode, response);
+    if (err != ESP_OK) {
+        ESP_LOGD(TAG, "%s: sdmmc_send_cmd_switch_func (2) returned 0x%x", __func__, err);
+        goto out;
+    }
+    if (SD_SFUNC_SELECTED(response->data, SD_ACCESS_MODE) != mode) {
+        ESP_LOGW(TAG, "%s: card didn't switch to access mode %" PRIu32, __func__, mode);
+        err = ESP_ERR_NOT_SUPPORTED;
+        goto out;
+    }
+    ESP_LOGD(TAG, "%s: using access mode %s", __func__, mode == SD_ACCESS_MODE_SDR104 ? "SDR104" : "SDR50");
+    card->max_freq_khz = MIN(card->host.max_freq_khz, mode_freq_khz);
+
+out:
+    free(response);
+    return err;
+}
+
 esp_err_t sdmmc_enable_hs_mode_and_check(sdmmc_card_t* card)
 {
     /* All cards should support at least default speed */
@@ -280,8 +365,17 @@ esp_err_t sdmmc_enable_hs_mode_and_check(sdmmc_card_t* card)
         return ESP_OK;
     }
 
+    esp_err_t err;
+    if (card->is_uhs1) {
+        /* Card uses 1.8V signalling, try UHS-I modes before HS mode (SDR25) */
+        err = sdmmc_enable_uhs1_mode(card);
+        if (err != ESP_ERR_NOT_SUPPORTED) {
+            return err;
+        }
+    }
+
     /* Try to enabled HS mode */
-    esp_err_t err = sdmmc_enable_hs_mode(card);
+    err = sdmmc_enable_hs_mode(card);
     if (err != ESP_OK) {
         return err;
     }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -328,6 +328,71 @@ typedef struct emac_mac_dev_s {
         };
         uint32_t val;
     } emacwdogto;
+    uint32_t reserved_0e0[392];
+    volatile union {
+        struct {
+            uint32_t tsena : 1;      /*When this bit is set  the timestamp is added for the transmit and receive frames.*/
+            uint32_t tscfupdt : 1;   /*This bit selects the method for updating the system time. 1'b0: Coarse method. 1'b1: Fine method  the system time is incremented by the sub-second increment when the accumulator of the addend overflows.*/
+            uint32_t tsinit : 1;     /*When this bit is set  the system time is initialized with the value of the system time seconds and nanoseconds update registers. This bit is cleared when the initialization is complete.*/
+            uint32_t tsupdt : 1;     /*When this bit is set  the system time is updated (added or subtracted) with the value of the system time seconds and nanoseconds update registers. This bit is cleared when the update is complete.*/
+            uint32_t tstrig : 1;     /*When this bit is set  the timestamp interrupt is generated when the system time becomes greater than the value of the target time registers.*/
+            uint32_t tsaddreg : 1;   /*When this bit is set  the content of the timestamp addend register is updated in the PTP block for fine correction. This bit is cleared when the update is complete.*/
+            uint32_t reserved6 : 2;
+            uint32_t tsenall : 1;    /*When this bit is set  the timestamp snapshot is enabled for all frames received by the MAC.*/
+            uint32_t tsctrlssr : 1;  /*This bit controls the rollover of the nanoseconds register. 1'b0: Binary rollover  the register rolls over after 0x7FFFFFFF. 1'b1: Digital rollover  the register rolls over after 0x3B9AC9FF (999 999 999).*/
+            uint32_t tsver2ena : 1;  /*When this bit is set  the IEEE 1588 version 2 format is used to process the PTP frames. When this bit is reset  the version 1 format is used.*/
+            uint32_t tsipena : 1;    /*When this bit is set  the MAC processes the PTP frames sent directly over Ethernet.*/
+            uint32_t tsipv6ena : 1;  /*When this bit is set  the MAC processes the PTP frames sent over IPv6-UDP.*/
+            uint32_t tsipv4ena : 1;  /*When this bit is set  the MAC processes the PTP frames sent over IPv4-UDP.*/
+            uint32_t tsevntena : 1;  /*When this bit is set  the timestamp snapshot is taken only for the event messages (SYNC  Delay_Req  Pdelay_Req or Pdelay_Resp).*/
+            uint32_t tsmstrena : 1;  /*When this bit is set  the snapshot is taken only for the messages relevant to the master node. Otherwise  the snapshot is taken for the messages relevant to the slave node.*/
+            uint32_t snaptypsel : 2; /*These bits along with Bits 15 and 14 decide the set of PTP frame types for which the snapshot is taken.*/
+            uint32_t tsenmacaddr : 1; /*When this bit is set  the destination address of the PTP frames is checked against the MAC address registers.*/
+            uint32_t reserved19 : 13;
+        };
+        uint32_t val;
+    } ptptsctrl;
+    volatile union {
+        struct {
+            uint32_t ssinc : 8; /*The value programmed in this field is added to the contents of the sub-second register with every update.*/
+            uint32_t reserved8 : 24;
+        };
+        uint32_t val;
+    } ptpssinc;
+    volatile uint32_t ptpsec;              /*Seconds of the system time.*/
+    volatile union {
+        struct {
+            uint32_t tsss : 31; /*Sub-seconds of the system time  in nanoseconds when the digital rollover is selected.*/
+            uint32_t reserved31 : 1;
+        };
+        uint32_t val;
+    } ptpnsec;
+    volatile uint32_t ptpsecupdt;          /*Seconds to be initialized in or added to (subtracted from) the system time.*/
+    volatile union {
+        struct {
+            uint32_t tsss : 31;   /*Sub-seconds to be initialized in or added to (subtracted from) the system time.*/
+            uint32_t addsub : 1;  /*When this bit is set  the time value is subtracted from the system time instead of being added.*/
+        };
+        uint32_t val;
+    } ptpnsecupdt;
+    volatile uint32_t ptptsaddend;         /*Value added to the accumulator of the fine correction method at every clock cycle of the PTP reference clock.*/
+    volatile uint32_t ptptgtsec;           /*Seconds of the target time.*/
+    volatile uint32_t ptptgtnsec;          /*Nanoseconds of the target time.*/
+    volatile union {
+        struct {
+            uint32_t tshwr : 16; /*Most significant 16 bits of the seconds of the system time.*/
+            uint32_t reserved16 : 16;
+        };
+        uint32_t val;
+    } ptpsechigh;
+    volatile union {
+        struct {
+            uint32_t tssovf : 1;   /*This bit is set when the seconds of the system time overflow.*/
+            uint32_t tstargt : 1;  /*This bit is set when the system time exceeds the value of the target time.*/
+            uint32_t reserved2 : 30;
+        };
+        uint32_t val;
+    } ptptsstatus;
 } emac_mac_dev_t;
 
 extern emac_mac_dev_t EMAC_MAC;
@@ -62,6 +62,8 @@
 #include "esp_private/freertos_idf_additions_priv.h"
 #include "esp_log.h"
 #include "esp_cpu.h"
+#include "esp_private/esp_clk.h"
+#include "esp_spi_flash_counters.h"
 
 static __attribute__((unused)) const char *TAG = "cache";
 
@@ -76,6 +78,44 @@ void spi_flash_restore_cache(uint32_t cpuid, uint32_t saved_state);
 // Used only on ROM impl. in idf, this param unused, cache status hold by hal
 static uint32_t s_flash_op_cache_state[2];
 
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+static esp_flash_cache_counter_t s_cache_disabled_stats;
+static uint32_t s_cache_disabled_ts;
+
+// Called right before the caches are disabled, the other CPU (if any) is already stalled
+FORCE_INLINE_ATTR void cache_disabled_counter_start(void)
+{
+    s_cache_disabled_ts = esp_cpu_get_cycle_count();
+}
+
+// Called once the caches are enabled again, so flash functions may be used
+FORCE_INLINE_ATTR void cache_disabled_counter_stop(void)
+{
+    uint32_t time = (esp_cpu_get_cycle_count() - s_cache_disabled_ts) / (esp_clk_cpu_freq() / 1000000);
+
+    s_cache_disabled_stats.count++;
+    s_cache_disabled_stats.time += time;
+    if (time > s_cache_disabled_stats.max_time) {
+        s_cache_disabled_stats.max_time = time;
+        const char *name = (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) ? pcTaskGetName(NULL) : "";
+        strlcpy(s_cache_disabled_stats.max_time_task, name, sizeof(s_cache_disabled_stats.max_time_task));
+    }
+}
+
+const esp_flash_cache_counter_t *esp_flash_get_cache_counters(void)
+{
+    return &s_cache_disabled_stats;
+}
+
+void spi_flash_reset_cache_counters(void)
+{
+    memset(&s_cache_disabled_stats, 0, sizeof(s_cache_disabled_stats));
+}
+#else
+#define cache_disabled_counter_start()
+#define cache_disabled_counter_stop()
+#endif // CONFIG_SPI_FLASH_ENABLE_COUNTERS
+
 
 #ifndef CONFIG_FREERTOS_UNICORE
 static SemaphoreHandle_t s_flash_op_mutex;
@@ -211,6 +251,7 @@ void IRAM_ATTR spi_flash_disable_interrupts_caches_and_other_cpu(void)
         }
     }
 
+    cache_disabled_counter_start();
     // Kill interrupts that aren't located in IRAM
     esp_intr_noniram_disable();
     // This CPU executes this routine, with non-IRAM interrupts and the scheduler
@@ -248,6 +289,7 @@ void IRAM_ATTR spi_flash_enable_interrupts_caches_and_other_cpu(void)
         // Signal to spi_flash_op_block_task that flash operation is complete
         s_flash_op_complete = true;
     }
+    cache_disabled_counter_stop();
 
     // Re-enable non-iram interrupts
     esp_intr_noniram_enable();
@@ -327,6 +369,7 @@ void spi_flash_op_unlock(void)
 void IRAM_ATTR spi_flash_disable_interrupts_caches_and_other_cpu(void)
 {
     spi_flash_op_lock();
+    cache_disabled_counter_start();
     esp_intr_noniram_disable();
     spi_flash_disable_cache(0, &s_flash_op_cache_state[0]);
 }
@@ -334,6 +377,7 @@ void IRAM_ATTR spi_flash_disable_interrupts_caches_and_other_cpu(void)
 void IRAM_ATTR spi_flash_enable_interrupts_caches_and_other_cpu(void)
 {
     spi_flash_restore_cache(0, s_flash_op_cache_state[0]);
+    cache_disabled_counter_stop();
     esp_intr_noniram_enable();
     spi_flash_op_unlock();
 }
@@ -20,7 +20,11 @@
 #include "esp_rom_caps.h"
 #include "esp_rom_spiflash.h"
 #include "esp_private/esp_clk.h"
+#include "esp_private/cache_utils.h"
 #include "esp_spi_flash_counters.h"
+#if CONFIG_SPI_FLASH_READ_THROUGH_CACHE
+#include "esp_flash_encrypt.h"
+#endif
 
 #if CONFIG_IDF_TARGET_ESP32S2
 #include "esp_crypto_lock.h" // for locking flash encryption peripheral
@@ -95,6 +99,7 @@ const esp_flash_counters_t *esp_flash_get_counters(void)
 void esp_flash_reset_counters(void)
 {
     memset(&esp_flash_stats, 0, sizeof(esp_flash_stats));
+    spi_flash_reset_cache_counters();
 }
 
 void esp_flash_dump_counters(FILE* stream)
@@ -103,6 +108,8 @@ void esp_flash_dump_counters(FILE* stream)
         fprintf(stream, " read: count=%8ld  time=%8ldus  bytes=%8ld\n", esp_flash_stats.read.count, esp_flash_stats.read.time, esp_flash_stats.read.bytes);
         fprintf(stream, "write: count=%8ld  time=%8ldus  bytes=%8ld\n", esp_flash_stats.write.count, esp_flash_stats.write.time, esp_flash_stats.write.bytes);
         fprintf(stream, "erase: count=%8ld  time=%8ldus  bytes=%8ld\n", esp_flash_stats.erase.count, esp_flash_stats.erase.time, esp_flash_stats.erase.bytes);
+        const esp_flash_cache_counter_t *cache = esp_flash_get_cache_counters();
+        fprintf(stream, "cache disabled: count=%8ld  time=%8ldus  max=%8ldus  max task=%s\n", cache->count, cache->time, cache->max_time, cache->max_time_task);
     }
 }
 
@@ -847,6 +854,37 @@ esp_err_t IRAM_ATTR esp_flash_set_protected_region(esp_flash_t *chip, const esp_
     return rom_spiflash_api_funcs->end(chip, err);
 }
 
+#if CONFIG_SPI_FLASH_READ_THROUGH_CACHE
+extern const esp_flash_os_functions_t esp_flash_noos_functions;
+
+/* Large reads of the main flash are copied through a temporary cache mapping. The cache reads
+ * ahead while the data is copied, and neither the cache nor the interrupts are disabled, so
+ * this is much faster than slicing the read into short SPI1 transactions. The data seen
+ * through the cache is decrypted, so this is only possible when flash encryption is off.
+ */
+static esp_err_t s_read_through_cache(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t length)
+{
+    if (chip != esp_flash_default_chip || chip->os_func == &esp_flash_noos_functions || esp_flash_encryption_enabled()) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    COUNTER_START();
+    const uint32_t map_start = address & ~(SPI_FLASH_MMU_PAGE_SIZE - 1);
+    const void *ptr;
+    spi_flash_mmap_handle_t handle;
+    esp_err_t err = spi_flash_mmap(map_start, address + length - map_start, SPI_FLASH_MMAP_DATA, &ptr, &handle);
+    if (err != ESP_OK) {
+        // Not enough free MMU pages, use the normal path
+        return err;
+    }
+    memcpy(buffer, (const uint8_t *)ptr + (address - map_start), length);
+    spi_flash_munmap(handle);
+    COUNTER_ADD_BYTES(read, length);
+    COUNTER_STOP(read);
+    return ESP_OK;
+}
+#endif // CONFIG_SPI_FLASH_READ_THROUGH_CACHE
+
 esp_err_t IRAM_ATTR esp_flash_read(esp_flash_t *chip, void *buffer, uint32_t address, uint32_t length)
 {
     esp_err_t err = rom_spiflash_api_funcs->chip_check(&chip);
@@ -858,6 +896,12 @@ esp_err_t IRAM_ATTR esp_flash_read(esp_flash_t *chip, void *buffer, uint32_t add
         return ESP_OK;
     }
 
+#if CONFIG_SPI_FLASH_READ_THROUGH_CACHE
+    if (length >= CONFIG_SPI_FLASH_READ_THROUGH_CACHE_MIN_SIZE && s_read_through_cache(chip, buffer, address, length) == ESP_OK) {
+        return ESP_OK;
+    }
+#endif
+
     //when the cache is disabled, only the DRAM can be read, check whether we need to receive in another buffer in DRAM.
     bool direct_read = false;
     //If the buffer is internal already, it's ok to use it directly
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <sys/lock.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "esp_flash.h"
+#include "esp_flash_async.h"
+#include "spi_flash_mmap.h"
+
+static const char TAG[] = "spi_flash_async";
+
+typedef enum {
+    ASYNC_OP_ERASE,
+    ASYNC_OP_WRITE,
+} async_op_type_t;
+
+typedef struct {
+    async_op_type_t type;
+    esp_flash_t *chip;
+    const void *buffer;
+    uint32_t address;
+    uint32_t length;
+    esp_flash_async_cb_t cb;
+    void *arg;
+} async_op_t;
+
+static QueueHandle_t s_op_queue;
+static _lock_t s_init_lock;
+
+static esp_err_t async_erase(const async_op_t *op)
+{
+#if CONFIG_SPI_FLASH_AUTO_SUSPEND
+    // The flash suspends the erase whenever the cache needs it, no need to split the region
+    const uint32_t chunk_size = op->length;
+#else
+    const uint32_t chunk_size = SPI_FLASH_SEC_SIZE;
+#endif
+    esp_err_t ret = ESP_OK;
+
+    for (uint32_t offset = 0; offset < op->length && ret == ESP_OK; offset += chunk_size) {
+        ret = esp_flash_erase_region(op->chip, op->address + offset, chunk_size);
+        taskYIELD();
+    }
+    return ret;
+}
+
+static esp_err_t async_write(const async_op_t *op)
+{
+    esp_err_t ret = ESP_OK;
+
+    for (uint32_t offset = 0; offset < op->length && ret == ESP_OK; offset += CONFIG_SPI_FLASH_WRITE_CHUNK_SIZE) {
+        uint32_t len = op->length - offset;
+        len = (len < CONFIG_SPI_FLASH_WRITE_CHUNK_SIZE) ? len : CONFIG_SPI_FLASH_WRITE_CHUNK_SIZE;
+        ret = esp_flash_write(op->chip, (const uint8_t *)op->buffer + offset, op->address + offset, len);
+        taskYIELD();
+    }
+    return ret;
+}
+
+static void async_task(void *arg)
+{
+    async_op_t op;
+
+    while (true) {
+        xQueueReceive(s_op_queue, &op, portMAX_DELAY);
+        esp_err_t ret = (op.type == ASYNC_OP_ERASE) ? async_erase(&op) : async_write(&op);
+        if (ret != ESP_OK) {
+            ESP_LOGD(TAG, "operation at 0x%"PRIx32" failed: %s", op.address, esp_err_to_name(ret));
+        }
+        if (op.cb) {
+            op.cb(op.chip, ret, op.arg);
+        }
+    }
+}
+
+static esp_err_t async_init(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    _lock_acquire(&s_init_lock);
+    if (s_op_queue == NULL) {
+        QueueHandle_t queue = xQueueCreate(CONFIG_SPI_FLASH_ASYNC_QUEUE_SIZE, sizeof(async_op_t));
+        if (queue == NULL) {
+            ret = ESP_ERR_NO_MEM;
+        } else {
+            s_op_queue = queue;
+            if (xTaskCreate(async_task, "flash_async", CONFIG_SPI_FLASH_ASYNC_TASK_STACK_SIZE, NULL,
+                            CONFIG_SPI_FLASH_ASYNC_TASK_PRIORITY, NULL) != pdPASS) {
+                s_op_queue = NULL;
+                vQueueDelete(queue);
+                ret = ESP_ERR_NO_MEM;
+            }
+        }
+    }
+    _lock_release(&s_init_lock);
+    return ret;
+}
+
+static esp_err_t async_queue(const async_op_t *op)
+{
+    esp_err_t ret = async_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "failed to create the worker task");
+        return ret;
+    }
+    if (xQueueSend(s_op_queue, op, 0) != pdTRUE) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_flash_async_erase_region(esp_flash_t *chip, uint32_t start, uint32_t len, esp_flash_async_cb_t cb, void *arg)
+{
+    if ((start % SPI_FLASH_SEC_SIZE) != 0 || (len % SPI_FLASH_SEC_SIZE) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const async_op_t op = {
+        .type = ASYNC_OP_ERASE,
+        .chip = chip,
+        .address = start,
+        .length = len,
+        .cb = cb,
+        .arg = arg,
+    };
+    return async_queue(&op);
+}
+
+esp_err_t esp_flash_async_write(esp_flash_t *chip, const void *buffer, uint32_t address, uint32_t length, esp_flash_async_cb_t cb, void *arg)
+{
+    if (buffer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const async_op_t op = {
+        .type = ASYNC_OP_WRITE,
+        .chip = chip,
+        .buffer = buffer,
+        .address = address,
+        .length = length,
+        .cb = cb,
+        .arg = arg,
+    };
+    return async_queue(&op);
+}
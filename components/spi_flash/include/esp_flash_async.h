@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_flash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Callback called when an asynchronous operation is done
+ *
+ * The callback runs in the context of the asynchronous operations task, it should not block for a long time.
+ *
+ * @param chip   Chip given to the operation, NULL if the operation was done on the default chip
+ * @param result ESP_OK if the whole operation succeeded, the error of the failed flash operation otherwise
+ * @param arg    User argument given to the operation
+ */
+typedef void (*esp_flash_async_cb_t)(esp_flash_t *chip, esp_err_t result, void *arg);
+
+/**
+ * @brief Erase a region of the flash chip without blocking the caller
+ *
+ * The erase is done by a worker task, sector by sector, yielding between each sector. If
+ * CONFIG_SPI_FLASH_AUTO_SUSPEND is enabled, the region is erased in a single call of esp_flash_erase_region(), as
+ * the cache keeps working while the flash is erasing. Operations are processed in the order they are queued.
+ *
+ * @param chip     Pointer to identify flash chip. If NULL, esp_flash_default_chip is used.
+ * @param start    Address to start erasing flash. Must be sector aligned.
+ * @param len      Length of region to erase. Must also be sector aligned.
+ * @param cb       Callback called when the erase is done, may be NULL
+ * @param arg      Argument passed to the callback
+ *
+ * @return
+ *      - ESP_OK if the erase is queued
+ *      - ESP_ERR_INVALID_ARG if start or len is not sector aligned
+ *      - ESP_ERR_NO_MEM if the worker task could not be created or the queue is full
+ */
+esp_err_t esp_flash_async_erase_region(esp_flash_t *chip, uint32_t start, uint32_t len, esp_flash_async_cb_t cb, void *arg);
+
+/**
+ * @brief Write data to the flash chip without blocking the caller
+ *
+ * The write is done by a worker task, in chunks of CONFIG_SPI_FLASH_WRITE_CHUNK_SIZE bytes, yielding between each
+ * chunk. Operations are processed in the order they are queued, so a write queued after an erase of the same region
+ * sees the erased flash.
+ *
+ * @note The buffer is not copied, it must stay valid and unchanged until the callback is called.
+ *
+ * @param chip     Pointer to identify flash chip. If NULL, esp_flash_default_chip is used.
+ * @param buffer   Buffer with the data to write
+ * @param address  Address on flash to write to
+ * @param length   Length (in bytes) of data to write
+ * @param cb       Callback called when the write is done, may be NULL
+ * @param arg      Argument passed to the callback
+ *
+ * @return
+ *      - ESP_OK if the write is queued
+ *      - ESP_ERR_INVALID_ARG if buffer is NULL
+ *      - ESP_ERR_NO_MEM if the worker task could not be created or the queue is full
+ */
+esp_err_t esp_flash_async_write(esp_flash_t *chip, const void *buffer, uint32_t address, uint32_t length, esp_flash_async_cb_t cb, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -49,6 +49,11 @@ void spi_flash_disable_interrupts_caches_and_other_cpu_no_os(void);
 // This function is implied to be called when other CPU is not running or running code from IRAM.
 void spi_flash_enable_interrupts_caches_no_os(void);
 
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+// Reset the statistics returned by esp_flash_get_cache_counters()
+void spi_flash_reset_cache_counters(void);
+#endif
+
 // Mark the pages containing a flash region as having been
 // erased or written to. This means the flash cache needs
 // to be evicted before these pages can be flash_mmap()ed again,
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -35,12 +35,25 @@ typedef struct {
     esp_flash_counter_t erase;  /*!< counters for erase action, like `esp_flash_erase`*/
 } esp_flash_counters_t;
 
+/**
+ * Structure holding statistics of the periods during which the caches were disabled by flash operations
+ *
+ * While the caches are disabled, the code and data in flash and PSRAM can't be accessed: tasks are not scheduled
+ * and only the interrupt handlers placed in IRAM run, on both CPUs.
+ */
+typedef struct {
+    uint32_t count;     /*!< number of times the caches were disabled */
+    uint32_t time;      /*!< total time the caches were disabled, in microseconds */
+    uint32_t max_time;  /*!< longest time the caches were disabled at once, in microseconds */
+    char max_time_task[CONFIG_FREERTOS_MAX_TASK_NAME_LEN];  /*!< name of the task whose flash operation disabled the caches for max_time, empty before the scheduler is started */
+} esp_flash_cache_counter_t;
+
 // for deprecate old api
 typedef esp_flash_counter_t   spi_flash_counter_t;
 typedef esp_flash_counters_t  spi_flash_counters_t;
 
 /**
- * @brief  Reset SPI flash operation counters
+ * @brief  Reset SPI flash operation counters, including the cache disabled counters
  */
 void esp_flash_reset_counters(void);
 void spi_flash_reset_counters(void) __attribute__((deprecated("Please use 'esp_flash_reset_counters' instead")));
@@ -60,6 +73,17 @@ void spi_flash_dump_counters(void) __attribute__((deprecated("Please use 'esp_fl
 const esp_flash_counters_t* esp_flash_get_counters(void);
 const spi_flash_counters_t* spi_flash_get_counters(void) __attribute__((deprecated("Please use 'esp_flash_get_counters' instead")));
 
+/**
+ * @brief  Return the statistics of the periods during which the caches were disabled by flash operations
+ *
+ * Operations on the main flash chip disable the caches on both CPUs for their whole duration, unless the
+ * caches don't need to be disabled, e.g. with CONFIG_SPI_FLASH_AUTO_SUSPEND. Comparing these statistics with the deadlines of an
+ * application tells whether the deadlines can be missed because of flash writes, e.g. by NVS or a file system.
+ *
+ * @return  pointer to the esp_flash_cache_counter_t structure holding the statistics
+ */
+const esp_flash_cache_counter_t* esp_flash_get_cache_counters(void);
+
 #ifdef __cplusplus
 }
 #endif
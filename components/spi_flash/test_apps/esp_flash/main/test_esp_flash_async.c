@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include "unity.h"
+#include "esp_flash.h"
+#include "esp_flash_async.h"
+#include "esp_partition.h"
+#include "spi_flash_mmap.h"
+#include "sdkconfig.h"
+
+#if CONFIG_SPI_FLASH_ASYNC_API
+
+#define TEST_ASYNC_LEN  (4 * SPI_FLASH_SEC_SIZE)
+
+extern const esp_partition_t *get_test_data_partition(void);
+
+typedef struct {
+    SemaphoreHandle_t done;
+    esp_err_t result;
+} async_test_ctx_t;
+
+static void async_done_cb(esp_flash_t *chip, esp_err_t result, void *arg)
+{
+    async_test_ctx_t *ctx = (async_test_ctx_t *)arg;
+    ctx->result = result;
+    xSemaphoreGive(ctx->done);
+}
+
+TEST_CASE("esp_flash_async erase and write in order", "[esp_flash]")
+{
+    const esp_partition_t *part = get_test_data_partition();
+    uint8_t *tx_buf = malloc(TEST_ASYNC_LEN);
+    uint8_t *rx_buf = malloc(TEST_ASYNC_LEN);
+    TEST_ASSERT_NOT_NULL(tx_buf);
+    TEST_ASSERT_NOT_NULL(rx_buf);
+    for (int i = 0; i < TEST_ASYNC_LEN; i++) {
+        tx_buf[i] = i * 7 + 3;
+    }
+
+    async_test_ctx_t erase_ctx = { .done = xSemaphoreCreateBinary(), .result = ESP_FAIL };
+    async_test_ctx_t write_ctx = { .done = xSemaphoreCreateBinary(), .result = ESP_FAIL };
+    TEST_ASSERT_NOT_NULL(erase_ctx.done);
+    TEST_ASSERT_NOT_NULL(write_ctx.done);
+
+    // Both calls return before the flash is touched, the write is done after the erase
+    TEST_ESP_OK(esp_flash_async_erase_region(NULL, part->address, TEST_ASYNC_LEN, async_done_cb, &erase_ctx));
+    TEST_ESP_OK(esp_flash_async_write(NULL, tx_buf, part->address, TEST_ASYNC_LEN, async_done_cb, &write_ctx));
+
+    TEST_ASSERT_TRUE(xSemaphoreTake(erase_ctx.done, pdMS_TO_TICKS(5000)));
+    TEST_ESP_OK(erase_ctx.result);
+    TEST_ASSERT_TRUE(xSemaphoreTake(write_ctx.done, pdMS_TO_TICKS(5000)));
+    TEST_ESP_OK(write_ctx.result);
+
+    TEST_ESP_OK(esp_flash_read(NULL, rx_buf, part->address, TEST_ASYNC_LEN));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(tx_buf, rx_buf, TEST_ASYNC_LEN);
+
+    vSemaphoreDelete(erase_ctx.done);
+    vSemaphoreDelete(write_ctx.done);
+    free(tx_buf);
+    free(rx_buf);
+}
+
+TEST_CASE("esp_flash_async rejects unaligned erase", "[esp_flash]")
+{
+    const esp_partition_t *part = get_test_data_partition();
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_flash_async_erase_region(NULL, part->address + 1, SPI_FLASH_SEC_SIZE, NULL, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_flash_async_erase_region(NULL, part->address, SPI_FLASH_SEC_SIZE - 1, NULL, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_flash_async_write(NULL, NULL, part->address, 4, NULL, NULL));
+}
+
+#endif // CONFIG_SPI_FLASH_ASYNC_API
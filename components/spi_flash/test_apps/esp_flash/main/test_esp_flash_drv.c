@@ -1088,4 +1088,27 @@ void test_flash_counter(const esp_partition_t* part)
 }
 
 TEST_CASE_FLASH("SPI flash counter test", test_flash_counter);
+
+#if !CONFIG_SPI_FLASH_AUTO_SUSPEND && !(CONFIG_SPIRAM_FETCH_INSTRUCTIONS && CONFIG_SPIRAM_RODATA)
+TEST_CASE("SPI flash cache disabled counter test", "[esp_flash]")
+{
+    const esp_partition_t* part = get_test_data_partition();
+    esp_flash_cache_counter_t cache_counter;
+
+    esp_flash_reset_counters();
+    cache_counter = *esp_flash_get_cache_counters();
+    TEST_ASSERT_EQUAL_UINT32(0, cache_counter.count);
+    TEST_ASSERT_EQUAL_UINT32(0, cache_counter.max_time);
+
+    // an erase on the main flash disables the caches at least once
+    TEST_ASSERT_EQUAL(ESP_OK, esp_flash_erase_region(part->flash_chip, part->address, TEST_CNT_ERASE_LEN));
+    esp_flash_dump_counters(stdout);
+
+    cache_counter = *esp_flash_get_cache_counters();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, cache_counter.count);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, cache_counter.max_time);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(cache_counter.max_time, cache_counter.time);
+    TEST_ASSERT_EQUAL_STRING(pcTaskGetName(NULL), cache_counter.max_time_task);
+}
+#endif
 #endif //CONFIG_SPI_FLASH_ENABLE_COUNTERS
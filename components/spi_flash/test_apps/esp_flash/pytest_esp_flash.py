@@ -1,4 +1,4 @@
-# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: Apache-2.0
 import pytest
 from pytest_embedded import Dut
@@ -13,6 +13,7 @@ from pytest_embedded import Dut
         'flash_qio',
         'verify',
         'special',
+        'read_through_cache',
     ],
     indirect=True,
 )
@@ -21,6 +21,7 @@
 #include "esp_vfs.h"
 #include "esp_err.h"
 #include "esp_rom_spiflash.h"
+#include "esp_heap_caps.h"
 
 #include "spiffs_api.h"
 
@@ -83,6 +84,18 @@ static time_t vfs_spiffs_get_mtime(const spiffs_stat* s);
 
 static esp_spiffs_t * _efs[CONFIG_SPIFFS_MAX_PARTITIONS];
 
+static void esp_spiffs_gc_task_delete(esp_spiffs_t *efs)
+{
+    if (efs->gc_task == NULL) {
+        return;
+    }
+    xTaskNotifyGive(efs->gc_task);
+    xSemaphoreTake(efs->gc_task_done, portMAX_DELAY);
+    vSemaphoreDelete(efs->gc_task_done);
+    efs->gc_task = NULL;
+    efs->gc_task_done = NULL;
+}
+
 static void esp_spiffs_free(esp_spiffs_t ** efs)
 {
     esp_spiffs_t * e = *efs;
@@ -91,6 +104,7 @@ static void esp_spiffs_free(esp_spiffs_t ** efs)
     }
     *efs = NULL;
 
+    esp_spiffs_gc_task_delete(e);
     if (e->fs) {
         SPIFFS_unmount(e->fs);
         free(e->fs);
@@ -99,6 +113,7 @@ static void esp_spiffs_free(esp_spiffs_t ** efs)
     free(e->fds);
     free(e->cache);
     free(e->work);
+    spiffs_name_index_delete(e->name_index);
     free(e);
 }
 
@@ -202,6 +217,11 @@ static esp_err_t esp_spiffs_init(const esp_vfs_spiffs_conf_t* conf)
         ESP_LOGE(TAG, "spiffs partition is too large for spiffs_span_ix type. Please increase CONFIG_SPIFFS_PAGE_SIZE.");
         return ESP_ERR_INVALID_ARG;
     }
+    // the pages in use are tracked in a 32-bit mask of spiffs_cache
+    if (conf->cache_pages > ESP_SPIFFS_MAX_CACHE_PAGES) {
+        ESP_LOGE(TAG, "cache_pages must not be larger than %d", ESP_SPIFFS_MAX_CACHE_PAGES);
+        return ESP_ERR_INVALID_ARG;
+    }
 
     esp_spiffs_t * efs = calloc(1, sizeof(esp_spiffs_t));
     if (efs == NULL) {
@@ -236,9 +256,14 @@ static esp_err_t esp_spiffs_init(const esp_vfs_spiffs_conf_t* conf)
     }
 
 #if SPIFFS_CACHE
-    efs->cache_sz = sizeof(spiffs_cache) + conf->max_files * (sizeof(spiffs_cache_page)
+    const size_t cache_pages = conf->cache_pages ? conf->cache_pages : conf->max_files;
+    efs->cache_sz = sizeof(spiffs_cache) + cache_pages * (sizeof(spiffs_cache_page)
                           + efs->cfg.log_page_size);
-    efs->cache = calloc(1, efs->cache_sz);
+    if (conf->cache_in_psram) {
+        efs->cache = heap_caps_calloc_prefer(1, efs->cache_sz, 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_DEFAULT);
+    } else {
+        efs->cache = calloc(1, efs->cache_sz);
+    }
     if (efs->cache == NULL) {
         ESP_LOGE(TAG, "cache buffer could not be allocated");
         esp_spiffs_free(&efs);
@@ -254,6 +279,14 @@ static esp_err_t esp_spiffs_init(const esp_vfs_spiffs_conf_t* conf)
         return ESP_ERR_NO_MEM;
     }
 
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+    if (spiffs_name_index_create(CONFIG_SPIFFS_NAME_INDEX_SIZE, &efs->name_index) != ESP_OK) {
+        ESP_LOGE(TAG, "name index could not be allocated");
+        esp_spiffs_free(&efs);
+        return ESP_ERR_NO_MEM;
+    }
+#endif
+
     efs->fs = calloc(1, sizeof(spiffs));
     if (efs->fs == NULL) {
         ESP_LOGE(TAG, "spiffs could not be allocated");
@@ -286,6 +319,9 @@ static esp_err_t esp_spiffs_init(const esp_vfs_spiffs_conf_t* conf)
         esp_spiffs_free(&efs);
         return ESP_FAIL;
     }
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+    spiffs_name_index_build(efs->name_index, efs->fs);
+#endif
     _efs[index] = efs;
     return ESP_OK;
 }
@@ -322,6 +358,10 @@ esp_err_t esp_spiffs_check(const char* partition_label)
         SPIFFS_clearerr(_efs[index]->fs);
         return ESP_FAIL;
     }
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+    // The check may have deleted broken objects
+    spiffs_name_index_build(_efs[index]->name_index, _efs[index]->fs);
+#endif
     return ESP_OK;
 }
 
@@ -375,6 +415,9 @@ esp_err_t esp_spiffs_format(const char* partition_label)
             SPIFFS_clearerr(_efs[index]->fs);
             return ESP_FAIL;
         }
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+        spiffs_name_index_build(_efs[index]->name_index, _efs[index]->fs);
+#endif
     } else {
         esp_spiffs_free(&_efs[index]);
     }
@@ -399,6 +442,86 @@ esp_err_t esp_spiffs_gc(const char* partition_label, size_t size_to_gc)
     return ESP_OK;
 }
 
+static bool esp_spiffs_gc_task_in_budget(TickType_t start, const esp_spiffs_gc_task_config_t *config)
+{
+    return xTaskGetTickCount() - start < pdMS_TO_TICKS(config->time_budget_ms);
+}
+
+static void esp_spiffs_gc_task(void *arg)
+{
+    esp_spiffs_t *efs = (esp_spiffs_t *)arg;
+    const esp_spiffs_gc_task_config_t *config = &efs->gc_config;
+
+    /* The internal GC functions are called under the file system lock, the SPIFFS_gc* API would
+     * set the error code of the file system, which the VFS functions of the other tasks read.
+     * A notification asks the task to exit.
+     */
+    while (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(config->interval_ms)) == 0) {
+        const TickType_t start = xTaskGetTickCount();
+        s32_t res;
+        do {
+            // erases one block which holds only deleted pages, between the steps the lock is released
+            SPIFFS_LOCK(efs->fs);
+            res = SPIFFS_mounted(efs->fs) ? spiffs_gc_quick(efs->fs, 0) : SPIFFS_ERR_NOT_MOUNTED;
+            SPIFFS_UNLOCK(efs->fs);
+        } while (res == SPIFFS_OK && esp_spiffs_gc_task_in_budget(start, config));
+
+        if (res != SPIFFS_ERR_NOT_MOUNTED && config->reserve_bytes > 0 && esp_spiffs_gc_task_in_budget(start, config)) {
+            SPIFFS_LOCK(efs->fs);
+            if (SPIFFS_mounted(efs->fs)) {
+                res = spiffs_gc_check(efs->fs, config->reserve_bytes);
+                if (res != SPIFFS_OK) {
+                    ESP_LOGD(TAG, "background GC could not free %u bytes, %" PRId32, (unsigned)config->reserve_bytes, res);
+                }
+            }
+            SPIFFS_UNLOCK(efs->fs);
+        }
+    }
+    xSemaphoreGive(efs->gc_task_done);
+    vTaskDelete(NULL);
+}
+
+esp_err_t esp_spiffs_gc_task_start(const char* partition_label, const esp_spiffs_gc_task_config_t *config)
+{
+    if (config == NULL || config->interval_ms == 0 || config->task_core_id >= portNUM_PROCESSORS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    int index;
+    if (esp_spiffs_by_label(partition_label, &index) != ESP_OK) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_spiffs_t *efs = _efs[index];
+    if (efs->gc_task != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    efs->gc_config = *config;
+    efs->gc_task_done = xSemaphoreCreateBinary();
+    if (efs->gc_task_done == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    const BaseType_t core_id = (config->task_core_id < 0) ? tskNO_AFFINITY : config->task_core_id;
+    if (xTaskCreatePinnedToCore(esp_spiffs_gc_task, "spiffs_gc", config->task_stack_size, efs,
+                                config->task_priority, &efs->gc_task, core_id) != pdPASS) {
+        ESP_LOGE(TAG, "GC task could not be created");
+        vSemaphoreDelete(efs->gc_task_done);
+        efs->gc_task_done = NULL;
+        efs->gc_task = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_spiffs_gc_task_stop(const char* partition_label)
+{
+    int index;
+    if (esp_spiffs_by_label(partition_label, &index) != ESP_OK || _efs[index]->gc_task == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_spiffs_gc_task_delete(_efs[index]);
+    return ESP_OK;
+}
+
 esp_err_t esp_vfs_spiffs_register(const esp_vfs_spiffs_conf_t * conf)
 {
     assert(conf->base_path);
@@ -533,12 +656,88 @@ static int spiffs_mode_conv(int m)
     return res;
 }
 
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+/* Opens the object of the name index matching the path. Returns SPIFFS_ERR_NOT_FOUND if none does,
+ * or another negative value with the SPIFFS error code set if the flash could not be accessed. */
+static spiffs_file spiffs_open_indexed(esp_spiffs_t *efs, const char *path, spiffs_flags flags, spiffs_mode mode)
+{
+    spiffs_obj_id ids[SPIFFS_NAME_INDEX_MAX_CANDIDATES];
+    const size_t count = spiffs_name_index_find(efs->name_index, path, ids, SPIFFS_NAME_INDEX_MAX_CANDIDATES);
+    for (size_t i = 0; i < count; ++i) {
+        spiffs_file fd = SPIFFS_open_by_id(efs->fs, ids[i], flags & ~SPIFFS_O_CREAT, mode);
+        if (fd < 0) {
+            if (SPIFFS_errno(efs->fs) != SPIFFS_ERR_NOT_FOUND) {
+                return -1;
+            }
+            // The object does not exist any more
+            SPIFFS_clearerr(efs->fs);
+            spiffs_name_index_remove(efs->name_index, path, ids[i]);
+            continue;
+        }
+        // Only a hash of the name is indexed, compare the name stored in the object index header
+        spiffs_stat s;
+        if (SPIFFS_fstat(efs->fs, fd, &s) != SPIFFS_OK) {
+            const s32_t err = SPIFFS_errno(efs->fs);
+            (void) SPIFFS_close(efs->fs, fd);
+            efs->fs->err_code = err;
+            return -1;
+        }
+        if (strcmp((const char *) s.name, path) == 0) {
+            return fd;
+        }
+        (void) SPIFFS_close(efs->fs, fd);
+    }
+    return SPIFFS_ERR_NOT_FOUND;
+}
+#endif // CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+
+/* SPIFFS_open() which resolves the path with the name index; on error, the SPIFFS error code is set */
+static spiffs_file spiffs_open_path(esp_spiffs_t *efs, const char *path, spiffs_flags flags, spiffs_mode mode)
+{
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+    // Exclusive creation has to fail for existing files, leave it to SPIFFS
+    if (!(flags & SPIFFS_O_EXCL)) {
+        // Truncate only after the name is verified, a hash collision must not truncate another file
+        spiffs_file fd = spiffs_open_indexed(efs, path, flags & ~SPIFFS_O_TRUNC, mode);
+        if (fd >= 0) {
+            if ((flags & SPIFFS_O_TRUNC) && SPIFFS_ftruncate(efs->fs, fd, 0) < 0) {
+                const s32_t err = SPIFFS_errno(efs->fs);
+                (void) SPIFFS_close(efs->fs, fd);
+                efs->fs->err_code = err;
+                return -1;
+            }
+            return fd;
+        }
+        if (fd != SPIFFS_ERR_NOT_FOUND) {
+            return -1;
+        }
+        if (!(flags & SPIFFS_O_CREAT) && spiffs_name_index_is_complete(efs->name_index)) {
+            efs->fs->err_code = SPIFFS_ERR_NOT_FOUND;
+            return -1;
+        }
+    }
+    spiffs_file fd = SPIFFS_open(efs->fs, path, flags, mode);
+    if (fd >= 0) {
+        spiffs_stat s;
+        if (SPIFFS_fstat(efs->fs, fd, &s) == SPIFFS_OK) {
+            spiffs_name_index_insert(efs->name_index, path, s.obj_id);
+        } else {
+            SPIFFS_clearerr(efs->fs);
+            spiffs_name_index_set_incomplete(efs->name_index);
+        }
+    }
+    return fd;
+#else
+    return SPIFFS_open(efs->fs, path, flags, mode);
+#endif
+}
+
 static int vfs_spiffs_open(void* ctx, const char * path, int flags, int mode)
 {
     assert(path);
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
     int spiffs_flags = spiffs_mode_conv(flags);
-    int fd = SPIFFS_open(efs->fs, path, spiffs_flags, mode);
+    int fd = spiffs_open_path(efs, path, spiffs_flags, mode);
     if (fd < 0) {
         errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
         SPIFFS_clearerr(efs->fs);
@@ -632,13 +831,29 @@ static int vfs_spiffs_fsync(void* ctx, int fd)
 
 #ifdef CONFIG_VFS_SUPPORT_DIR
 
+/* SPIFFS_stat() which resolves the path with the name index */
+static s32_t spiffs_stat_path(esp_spiffs_t *efs, const char *path, spiffs_stat *s)
+{
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+    spiffs_file fd = spiffs_open_path(efs, path, SPIFFS_RDONLY, 0);
+    if (fd < 0) {
+        return fd;
+    }
+    s32_t res = SPIFFS_fstat(efs->fs, fd, s);
+    (void) SPIFFS_close(efs->fs, fd);
+    return res;
+#else
+    return SPIFFS_stat(efs->fs, path, s);
+#endif
+}
+
 static int vfs_spiffs_stat(void* ctx, const char * path, struct stat * st)
 {
     assert(path);
     assert(st);
     spiffs_stat s;
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
-    off_t res = SPIFFS_stat(efs->fs, path, &s);
+    off_t res = spiffs_stat_path(efs, path, &s);
     if (res < 0) {
         errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
         SPIFFS_clearerr(efs->fs);
@@ -659,12 +874,25 @@ static int vfs_spiffs_rename(void* ctx, const char *src, const char *dst)
     assert(src);
     assert(dst);
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+    spiffs_stat s;
+    if (spiffs_stat_path(efs, src, &s) < 0) {
+        errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
+        SPIFFS_clearerr(efs->fs);
+        return -1;
+    }
+#endif
     int res = SPIFFS_rename(efs->fs, src, dst);
     if (res < 0) {
         errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
         SPIFFS_clearerr(efs->fs);
         return -1;
     }
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+    // The object keeps its ID, only the name changes
+    spiffs_name_index_remove(efs->name_index, src, s.obj_id);
+    spiffs_name_index_insert(efs->name_index, dst, s.obj_id);
+#endif
     return res;
 }
 
@@ -672,7 +900,25 @@ static int vfs_spiffs_unlink(void* ctx, const char *path)
 {
     assert(path);
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
+#if CONFIG_SPIFFS_NAME_INDEX_SIZE > 0
+    int res = -1;
+    spiffs_file fd = spiffs_open_path(efs, path, SPIFFS_WRONLY, 0);
+    if (fd >= 0) {
+        spiffs_stat s;
+        res = SPIFFS_fstat(efs->fs, fd, &s);
+        if (res < 0) {
+            (void) SPIFFS_close(efs->fs, fd);
+        } else {
+            // SPIFFS_fremove() releases the file descriptor
+            res = SPIFFS_fremove(efs->fs, fd);
+            if (res == SPIFFS_OK) {
+                spiffs_name_index_remove(efs->name_index, path, s.obj_id);
+            }
+        }
+    }
+#else
     int res = SPIFFS_remove(efs->fs, path);
+#endif
     if (res < 0) {
         errno = spiffs_res_to_errno(SPIFFS_errno(efs->fs));
         SPIFFS_clearerr(efs->fs);
@@ -821,7 +1067,7 @@ static int vfs_spiffs_truncate(void* ctx, const char *path, off_t length)
 {
     assert(path);
     esp_spiffs_t * efs = (esp_spiffs_t *)ctx;
-    int fd = SPIFFS_open(efs->fs, path, SPIFFS_WRONLY, 0);
+    int fd = spiffs_open_path(efs, path, SPIFFS_WRONLY, 0);
     if (fd < 0) {
         goto err;
     }
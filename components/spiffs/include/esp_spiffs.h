@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,8 @@
 #define _ESP_SPIFFS_H_
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -22,8 +24,16 @@ typedef struct {
         const char* partition_label;    /*!< Optional, label of SPIFFS partition to use. If set to NULL, first partition with subtype=spiffs will be used. */
         size_t max_files;               /*!< Maximum files that could be open at the same time. */
         bool format_if_mount_failed;    /*!< If true, it will format the file system if it fails to mount. */
+        size_t cache_pages;             /*!< Optional, number of logical pages kept in the page cache, at most ESP_SPIFFS_MAX_CACHE_PAGES.
+                                             If set to 0, max_files pages are cached. Ignored if CONFIG_SPIFFS_CACHE is disabled. */
+        bool cache_in_psram;            /*!< If true, the page cache is allocated from external RAM when it is available. */
 } esp_vfs_spiffs_conf_t;
 
+/**
+ * @brief Maximum number of pages in the page cache of a SPIFFS partition
+ */
+#define ESP_SPIFFS_MAX_CACHE_PAGES  32
+
 /**
  * Register and mount SPIFFS to VFS with given path prefix.
  *
@@ -124,6 +134,64 @@ esp_err_t esp_spiffs_check(const char* partition_label);
  */
 esp_err_t esp_spiffs_gc(const char* partition_label, size_t size_to_gc);
 
+/**
+ * @brief Configuration of the background garbage collection task
+ */
+typedef struct {
+        uint32_t interval_ms;           /*!< Period at which the task collects garbage, in milliseconds. */
+        uint32_t time_budget_ms;        /*!< Time after which the task stops collecting garbage until the next period, in milliseconds.
+                                             The current step is always finished, one step erases at most one block. */
+        size_t reserve_bytes;           /*!< If not 0, the task also moves data to keep at least this amount of space free,
+                                             like esp_spiffs_gc does. If 0, it only erases the blocks which hold no data. */
+        int task_priority;              /*!< Priority of the task. */
+        size_t task_stack_size;         /*!< Stack size of the task, in bytes. */
+        int task_core_id;               /*!< Core to which the task is pinned, or -1 for no affinity. */
+} esp_spiffs_gc_task_config_t;
+
+/**
+ * @brief Default configuration of the background garbage collection task
+ */
+#define ESP_SPIFFS_GC_TASK_CONFIG_DEFAULT() { \
+        .interval_ms = 1000, \
+        .time_budget_ms = 50, \
+        .reserve_bytes = 0, \
+        .task_priority = 1, \
+        .task_stack_size = 4096, \
+        .task_core_id = -1, \
+}
+
+/**
+ * @brief Start a task which collects garbage in the background
+ *
+ * Writing to a file may need to erase blocks first, which makes some writes much slower than others
+ * when the partition is getting full. The task periodically erases the blocks which only hold deleted
+ * pages, so that they are not erased by the next write. It holds the file system lock for one step
+ * at a time and gives up after config->time_budget_ms in each period, so that the files stay accessible.
+ *
+ * The task is stopped by esp_spiffs_gc_task_stop or when the partition is unregistered.
+ *
+ * @param partition_label  Label of the partition. The partition must be already mounted.
+ * @param config           Configuration of the task
+ * @return
+ *          - ESP_OK on success
+ *          - ESP_ERR_INVALID_ARG if config is NULL or invalid
+ *          - ESP_ERR_INVALID_STATE if the partition is not mounted or the task is already running
+ *          - ESP_ERR_NO_MEM if the task could not be created
+ */
+esp_err_t esp_spiffs_gc_task_start(const char* partition_label, const esp_spiffs_gc_task_config_t *config);
+
+/**
+ * @brief Stop the background garbage collection task
+ *
+ * Waits until the current step of the task is finished.
+ *
+ * @param partition_label  Label of the partition, as passed to esp_spiffs_gc_task_start.
+ * @return
+ *          - ESP_OK on success
+ *          - ESP_ERR_INVALID_STATE if the partition is not mounted or the task is not running
+ */
+esp_err_t esp_spiffs_gc_task_stop(const char* partition_label);
+
 #ifdef __cplusplus
 }
 #endif
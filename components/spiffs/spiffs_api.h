@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -13,6 +13,8 @@
 #include "freertos/semphr.h"
 #include "spiffs.h"
 #include "esp_compiler.h"
+#include "spiffs_name_index.h"
+#include "esp_spiffs.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,6 +37,10 @@ typedef struct {
     uint32_t fds_sz;                        /*!< File Descriptor Buffer Length */
     uint8_t *cache;                         /*!< Cache Buffer */
     uint32_t cache_sz;                      /*!< Cache Buffer Length */
+    spiffs_name_index_t *name_index;        /*!< Index of file names, NULL if disabled */
+    TaskHandle_t gc_task;                   /*!< Background GC task, NULL if not running */
+    SemaphoreHandle_t gc_task_done;         /*!< Given by the GC task when it exits */
+    esp_spiffs_gc_task_config_t gc_config;  /*!< Configuration of the GC task */
 } esp_spiffs_t;
 
 s32_t spiffs_api_read(spiffs *fs, uint32_t addr, uint32_t size, uint8_t *dst);
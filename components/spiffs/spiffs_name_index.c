@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/lock.h>
+#include "esp_log.h"
+#include "spiffs_name_index.h"
+
+static const char* TAG = "SPIFFS";
+
+typedef struct {
+    uint32_t hash;
+    spiffs_obj_id id;
+} name_index_entry_t;
+
+struct spiffs_name_index {
+    _lock_t lock;
+    size_t capacity;
+    size_t count;
+    bool complete;
+    name_index_entry_t entries[];   // sorted by hash
+};
+
+static uint32_t name_hash(const char *name)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (const uint8_t *p = (const uint8_t *) name; *p; ++p) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+/* Returns the position of the first entry with a hash not lower than the given one */
+static size_t lower_bound(const spiffs_name_index_t *index, uint32_t hash)
+{
+    size_t lo = 0;
+    size_t hi = index->count;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (index->entries[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+esp_err_t spiffs_name_index_create(size_t capacity, spiffs_name_index_t **out_index)
+{
+    spiffs_name_index_t *index = calloc(1, sizeof(spiffs_name_index_t) + capacity * sizeof(name_index_entry_t));
+    if (index == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    index->capacity = capacity;
+    *out_index = index;
+    return ESP_OK;
+}
+
+void spiffs_name_index_delete(spiffs_name_index_t *index)
+{
+    if (index == NULL) {
+        return;
+    }
+    _lock_close(&index->lock);
+    free(index);
+}
+
+static void insert_locked(spiffs_name_index_t *index, uint32_t hash, spiffs_obj_id id)
+{
+    if (index->count == index->capacity) {
+        index->complete = false;
+        return;
+    }
+    const size_t pos = lower_bound(index, hash);
+    memmove(&index->entries[pos + 1], &index->entries[pos], (index->count - pos) * sizeof(name_index_entry_t));
+    index->entries[pos].hash = hash;
+    index->entries[pos].id = id;
+    ++index->count;
+}
+
+void spiffs_name_index_build(spiffs_name_index_t *index, spiffs *fs)
+{
+    _lock_acquire(&index->lock);
+    index->count = 0;
+    index->complete = true;
+    spiffs_DIR dir;
+    struct spiffs_dirent de;
+    if (SPIFFS_opendir(fs, "/", &dir) == NULL) {
+        index->complete = false;
+    } else {
+        while (SPIFFS_readdir(&dir, &de) != NULL) {
+            insert_locked(index, name_hash((const char *) de.name), de.obj_id);
+        }
+        // readdir returns NULL with an error code set if the lookup pages could not be read
+        if (SPIFFS_errno(fs) != SPIFFS_OK && SPIFFS_errno(fs) != SPIFFS_VIS_END) {
+            index->complete = false;
+        }
+        SPIFFS_closedir(&dir);
+    }
+    SPIFFS_clearerr(fs);
+    if (!index->complete) {
+        ESP_LOGW(TAG, "name index holds %u of the files, other opens scan the flash", (unsigned) index->count);
+    }
+    _lock_release(&index->lock);
+}
+
+size_t spiffs_name_index_find(spiffs_name_index_t *index, const char *name, spiffs_obj_id *ids, size_t max_ids)
+{
+    const uint32_t hash = name_hash(name);
+    size_t found = 0;
+    _lock_acquire(&index->lock);
+    for (size_t pos = lower_bound(index, hash);
+            pos < index->count && index->entries[pos].hash == hash && found < max_ids; ++pos) {
+        ids[found++] = index->entries[pos].id;
+    }
+    _lock_release(&index->lock);
+    return found;
+}
+
+static void remove_locked(spiffs_name_index_t *index, uint32_t hash, spiffs_obj_id id)
+{
+    for (size_t pos = lower_bound(index, hash); pos < index->count && index->entries[pos].hash == hash; ++pos) {
+        if (index->entries[pos].id == id) {
+            --index->count;
+            memmove(&index->entries[pos], &index->entries[pos + 1], (index->count - pos) * sizeof(name_index_entry_t));
+            return;
+        }
+    }
+}
+
+void spiffs_name_index_insert(spiffs_name_index_t *index, const char *name, spiffs_obj_id id)
+{
+    const uint32_t hash = name_hash(name);
+    _lock_acquire(&index->lock);
+    remove_locked(index, hash, id);
+    insert_locked(index, hash, id);
+    _lock_release(&index->lock);
+}
+
+void spiffs_name_index_remove(spiffs_name_index_t *index, const char *name, spiffs_obj_id id)
+{
+    const uint32_t hash = name_hash(name);
+    _lock_acquire(&index->lock);
+    remove_locked(index, hash, id);
+    _lock_release(&index->lock);
+}
+
+void spiffs_name_index_set_incomplete(spiffs_name_index_t *index)
+{
+    _lock_acquire(&index->lock);
+    index->complete = false;
+    _lock_release(&index->lock);
+}
+
+bool spiffs_name_index_is_complete(spiffs_name_index_t *index)
+{
+    _lock_acquire(&index->lock);
+    bool complete = index->complete;
+    _lock_release(&index->lock);
+    return complete;
+}
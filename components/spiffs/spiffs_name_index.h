@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "spiffs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief In-RAM index from file names to SPIFFS object IDs
+ *
+ * Only a hash of each name is stored, so a lookup returns candidate object IDs which have to be
+ * verified against the name stored on flash. The index holds at most a fixed number of entries;
+ * while all objects of the file system fit in it, the index is complete and a name which is not
+ * found in the index does not exist on the file system.
+ */
+typedef struct spiffs_name_index spiffs_name_index_t;
+
+/** Maximum number of object IDs returned by one spiffs_name_index_find() call */
+#define SPIFFS_NAME_INDEX_MAX_CANDIDATES    4
+
+esp_err_t spiffs_name_index_create(size_t capacity, spiffs_name_index_t **out_index);
+
+void spiffs_name_index_delete(spiffs_name_index_t *index);
+
+/* Fills the index with all objects of a mounted file system */
+void spiffs_name_index_build(spiffs_name_index_t *index, spiffs *fs);
+
+/* Returns the number of candidate object IDs stored into ids */
+size_t spiffs_name_index_find(spiffs_name_index_t *index, const char *name, spiffs_obj_id *ids, size_t max_ids);
+
+/* Adds an object, the index becomes incomplete if it is full */
+void spiffs_name_index_insert(spiffs_name_index_t *index, const char *name, spiffs_obj_id id);
+
+void spiffs_name_index_remove(spiffs_name_index_t *index, const char *name, spiffs_obj_id id);
+
+/* Marks the index as incomplete, e.g. when an object could not be added */
+void spiffs_name_index_set_incomplete(spiffs_name_index_t *index);
+
+bool spiffs_name_index_is_complete(spiffs_name_index_t *index);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -10,8 +10,10 @@
 #include <string.h>
 #include <time.h>
 #include <fcntl.h>
+#include <errno.h>
 #include <sys/time.h>
 #include <sys/unistd.h>
+#include <sys/stat.h>
 #include "unity.h"
 #include "esp_log.h"
 #include "esp_system.h"
@@ -769,6 +771,53 @@ TEST_CASE("readdir with large number of files", "[spiffs][timeout=30]")
     test_teardown();
 }
 
+TEST_CASE("files are found by name after remount, rename and unlink", "[spiffs]")
+{
+    test_setup();
+    char name[32];
+    for (int i = 0; i < 8; ++i) {
+        snprintf(name, sizeof(name), "/spiffs/idx%d.txt", i);
+        test_spiffs_create_file_with_text(name, spiffs_test_hello_str);
+    }
+    // A remount builds the name index from the files on flash
+    test_teardown();
+    esp_vfs_spiffs_conf_t conf = {
+        .base_path = "/spiffs",
+        .partition_label = spiffs_test_partition_label,
+        .max_files = 5,
+        .format_if_mount_failed = false
+    };
+    TEST_ESP_OK(esp_vfs_spiffs_register(&conf));
+
+    struct stat st;
+    for (int i = 0; i < 8; ++i) {
+        snprintf(name, sizeof(name), "/spiffs/idx%d.txt", i);
+        test_spiffs_read_file(name);
+        TEST_ASSERT_EQUAL(0, stat(name, &st));
+        TEST_ASSERT_EQUAL(strlen(spiffs_test_hello_str), st.st_size);
+    }
+    errno = 0;
+    TEST_ASSERT_NULL(fopen("/spiffs/idx8.txt", "r"));
+    TEST_ASSERT_EQUAL(ENOENT, errno);
+
+    TEST_ASSERT_EQUAL(0, rename("/spiffs/idx0.txt", "/spiffs/idx_renamed.txt"));
+    TEST_ASSERT_EQUAL(-1, stat("/spiffs/idx0.txt", &st));
+    test_spiffs_read_file("/spiffs/idx_renamed.txt");
+
+    TEST_ASSERT_EQUAL(0, unlink("/spiffs/idx1.txt"));
+    TEST_ASSERT_NULL(fopen("/spiffs/idx1.txt", "r"));
+    test_spiffs_create_file_with_text("/spiffs/idx1.txt", "truncated\n");
+    test_spiffs_create_file_with_text("/spiffs/idx1.txt", spiffs_test_hello_str);
+    test_spiffs_read_file("/spiffs/idx1.txt");
+
+    for (int i = 1; i < 8; ++i) {
+        snprintf(name, sizeof(name), "/spiffs/idx%d.txt", i);
+        TEST_ASSERT_EQUAL(0, unlink(name));
+    }
+    TEST_ASSERT_EQUAL(0, unlink("/spiffs/idx_renamed.txt"));
+    test_teardown();
+}
+
 TEST_CASE("multiple tasks can use same volume", "[spiffs]")
 {
     test_setup();
@@ -964,3 +1013,67 @@ TEST_CASE("SPIFFS garbage-collect", "[spiffs][timeout=60]")
 
     test_teardown();
 }
+
+TEST_CASE("SPIFFS background GC task", "[spiffs][timeout=60]")
+{
+    esp_spiffs_gc_task_config_t gc_config = ESP_SPIFFS_GC_TASK_CONFIG_DEFAULT();
+    gc_config.interval_ms = 10;
+
+    // should fail until the partition is initialized
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_spiffs_gc_task_start(spiffs_test_partition_label, &gc_config));
+
+    test_setup();
+
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_spiffs_gc_task_start(spiffs_test_partition_label, NULL));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_spiffs_gc_task_stop(spiffs_test_partition_label));
+    TEST_ESP_OK(esp_spiffs_gc_task_start(spiffs_test_partition_label, &gc_config));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_spiffs_gc_task_start(spiffs_test_partition_label, &gc_config));
+
+    // leave deleted blocks behind while the task erases them
+    const size_t buf_size = 8192;
+    char *buf = calloc(1, buf_size);
+    TEST_ASSERT_NOT_NULL(buf);
+    test_spiffs_create_file_with_text("/spiffs/gc_keep.txt", spiffs_test_hello_str);
+    for (int i = 0; i < 20; i++) {
+        FILE *f = fopen("/spiffs/gc_tmp.bin", "wb");
+        TEST_ASSERT_NOT_NULL(f);
+        TEST_ASSERT_EQUAL(buf_size, fwrite(buf, 1, buf_size, f));
+        TEST_ASSERT_EQUAL(0, fclose(f));
+        TEST_ASSERT_EQUAL(0, unlink("/spiffs/gc_tmp.bin"));
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    free(buf);
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    test_spiffs_read_file("/spiffs/gc_keep.txt");
+    TEST_ESP_OK(esp_spiffs_check(spiffs_test_partition_label));
+
+    TEST_ESP_OK(esp_spiffs_gc_task_stop(spiffs_test_partition_label));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_spiffs_gc_task_stop(spiffs_test_partition_label));
+
+    // unregistering the partition stops the task
+    gc_config.reserve_bytes = 4096;
+    TEST_ESP_OK(esp_spiffs_gc_task_start(spiffs_test_partition_label, &gc_config));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    test_teardown();
+}
+
+TEST_CASE("SPIFFS page cache can be configured", "[spiffs]")
+{
+    esp_vfs_spiffs_conf_t conf = {
+      .base_path = "/spiffs",
+      .partition_label = spiffs_test_partition_label,
+      .max_files = 5,
+      .format_if_mount_failed = true,
+      .cache_pages = ESP_SPIFFS_MAX_CACHE_PAGES + 1,
+      .cache_in_psram = true
+    };
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, esp_vfs_spiffs_register(&conf));
+
+    // the cache is allocated from internal RAM if there is no PSRAM
+    conf.cache_pages = 16;
+    TEST_ESP_OK(esp_vfs_spiffs_register(&conf));
+    test_spiffs_create_file_with_text("/spiffs/cache.txt", spiffs_test_hello_str);
+    test_spiffs_read_file("/spiffs/cache.txt");
+    test_teardown();
+}
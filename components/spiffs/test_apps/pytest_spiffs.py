@@ -10,6 +10,7 @@ from pytest_embedded import Dut
 @pytest.mark.parametrize('config', [
     'default',
     'release',
+    'name_index',
 ], indirect=True)
 def test_spiffs_generic(dut: Dut) -> None:
     dut.run_all_single_board_cases(timeout=120)
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _ESP_TRANSPORT_BUFFERED_H_
+#define _ESP_TRANSPORT_BUFFERED_H_
+
+#include <stddef.h>
+#include "esp_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Buffered transport configuration structure
+ */
+typedef struct {
+    size_t rx_buffer_size;      /*!< Size of the read-ahead buffer, 0 to read directly from the parent */
+    size_t tx_buffer_size;      /*!< Size of the buffer coalescing the writes, 0 to write directly to the parent */
+} esp_transport_buffered_config_t;
+
+/**
+ * @brief      Create a buffered transport on top of another transport
+ *
+ * Reads smaller than the read-ahead buffer are served from data read from the parent in chunks
+ * of the buffer size, so parsing small headers (e.g. the websocket transport stacked on the
+ * buffered transport) doesn't cost one socket or TLS read each.
+ *
+ * Writes smaller than the write buffer are collected and sent with one write to the parent when
+ * the buffer is full, before reading or polling for read, on esp_transport_buffered_flush() and
+ * on close. The websocket transport flushes its parent after each frame.
+ *
+ * The parent transport is not destroyed with the buffered transport.
+ *
+ * @param[in]  parent_handle  The transport to read from and write to, e.g. a TCP or SSL transport
+ * @param[in]  config         The buffer sizes
+ *
+ * @return
+ *  - transport
+ *  - NULL if an argument is invalid or the buffers can't be allocated
+ */
+esp_transport_handle_t esp_transport_buffered_init(esp_transport_handle_t parent_handle, const esp_transport_buffered_config_t *config);
+
+/**
+ * @brief      Send the data collected in the write buffer
+ *
+ * @param[in]  t           The buffered transport handle
+ * @param[in]  timeout_ms  The timeout milliseconds of each write to the parent
+ *
+ * @return
+ *  - 0 if all the data was sent
+ *  - (-1) if a write to the parent failed or timed out, the unsent data stays in the buffer
+ */
+int esp_transport_buffered_flush(esp_transport_handle_t t, int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ESP_TRANSPORT_BUFFERED_H_ */
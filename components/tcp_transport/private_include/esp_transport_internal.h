@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2020-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2020-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -20,6 +20,7 @@ extern "C" {
 #endif
 
 typedef int (*get_socket_func)(esp_transport_handle_t t);
+typedef int (*flush_func)(esp_transport_handle_t t, int timeout_ms);
 
 /**
  * Transport layer error structure including
@@ -52,6 +53,7 @@ struct esp_transport_item_t {
     connect_async_func _connect_async;      /*!< non-blocking connect function of this transport */
     payload_transfer_func  _parent_transfer;        /*!< Function returning underlying transport layer */
     get_socket_func        _get_socket;             /*!< Function returning the transport's socket */
+    flush_func             _flush;                  /*!< Function sending the data buffered by the transport */
     esp_transport_keep_alive_t *keep_alive_cfg;     /*!< TCP keep-alive config */
     struct esp_foundation_transport *foundation;          /*!< Foundation transport pointer available from each transport */
 
@@ -126,6 +128,20 @@ void capture_tcp_transport_error(esp_transport_handle_t t, enum esp_tcp_transpor
  */
 int esp_transport_get_socket(esp_transport_handle_t t);
 
+/**
+ * @brief Sends the data buffered by the supplied transport handle
+ *
+ * Transports buffering their writes, and transports stacked on them, implement it,
+ * it does nothing for the other transports.
+ *
+ * @param t Transport handle
+ * @param timeout_ms The timeout milliseconds
+ *
+ * @return 0 if no data is left in the buffers
+ *         -1 in case of error
+ */
+int esp_transport_flush(esp_transport_handle_t t, int timeout_ms);
+
 /**
  * @brief      Captures the current errno
  *
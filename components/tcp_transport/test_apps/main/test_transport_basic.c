@@ -1,8 +1,9 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
+#include <string.h>
 #include "unity_fixture.h"
 #include "memory_checks.h"
 
@@ -10,6 +11,7 @@
 #include "esp_transport_tcp.h"
 #include "esp_transport_ssl.h"
 #include "esp_transport_ws.h"
+#include "esp_transport_buffered.h"
 #include "esp_log.h"
 
 
@@ -63,10 +65,81 @@ TEST(transport_basic, transport_list_init_multiple_and_destroy)
     TEST_ASSERT_EQUAL(ESP_OK, esp_transport_list_destroy(transport_list));
 }
 
+static const char s_fake_rx_data[] = "0123456789abcdef";
+static int s_fake_rx_pos;
+static int s_fake_reads;
+static int s_fake_writes;
+
+static int fake_read(esp_transport_handle_t t, char *buffer, int len, int timeout_ms)
+{
+    int avail = sizeof(s_fake_rx_data) - 1 - s_fake_rx_pos;
+    int rlen = len < avail ? len : avail;
+    memcpy(buffer, s_fake_rx_data + s_fake_rx_pos, rlen);
+    s_fake_rx_pos += rlen;
+    s_fake_reads++;
+    return rlen;
+}
+
+static int fake_write(esp_transport_handle_t t, const char *buffer, int len, int timeout_ms)
+{
+    s_fake_writes++;
+    return len;
+}
+
+TEST(transport_basic, transport_buffered_read_ahead_and_write_coalescing)
+{
+    esp_transport_handle_t fake = esp_transport_init();
+    esp_transport_set_func(fake, NULL, fake_read, fake_write, NULL, NULL, NULL, NULL);
+    s_fake_rx_pos = s_fake_reads = s_fake_writes = 0;
+    esp_transport_buffered_config_t config = {
+        .rx_buffer_size = 8,
+        .tx_buffer_size = 16,
+    };
+    esp_transport_handle_t buffered = esp_transport_buffered_init(fake, &config);
+    TEST_ASSERT_NOT_NULL(buffered);
+
+    char data[16];
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(2, esp_transport_read(buffered, data, 2, 0));
+        TEST_ASSERT_EQUAL_MEMORY(s_fake_rx_data + 2 * i, data, 2);
+    }
+    TEST_ASSERT_EQUAL(1, s_fake_reads);
+    // reads as large as the buffer bypass it
+    TEST_ASSERT_EQUAL(8, esp_transport_read(buffered, data, 8, 0));
+    TEST_ASSERT_EQUAL(2, s_fake_reads);
+
+    TEST_ASSERT_EQUAL(2, esp_transport_write(buffered, "ab", 2, 0));
+    TEST_ASSERT_EQUAL(4, esp_transport_write(buffered, "cdef", 4, 0));
+    TEST_ASSERT_EQUAL(0, s_fake_writes);
+    TEST_ASSERT_EQUAL(0, esp_transport_buffered_flush(buffered, 0));
+    TEST_ASSERT_EQUAL(1, s_fake_writes);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_transport_destroy(buffered));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_transport_destroy(fake));
+}
+
+TEST(transport_basic, transport_ws_on_buffered_init_destroy)
+{
+    esp_transport_handle_t ssl = esp_transport_ssl_init();
+    esp_transport_buffered_config_t config = {
+        .rx_buffer_size = 512,
+        .tx_buffer_size = 512,
+    };
+    esp_transport_handle_t buffered = esp_transport_buffered_init(ssl, &config);
+    TEST_ASSERT_NOT_NULL(buffered);
+    esp_transport_handle_t ws = esp_transport_ws_init(buffered);
+    TEST_ASSERT_NOT_NULL(ws);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_transport_destroy(ws));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_transport_destroy(buffered));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_transport_destroy(ssl));
+}
+
 TEST_GROUP_RUNNER(transport_basic)
 {
     RUN_TEST_CASE(transport_basic, transport_list_init_and_destroy);
     RUN_TEST_CASE(transport_basic, transport_ssl_init_destroy_no_list);
     RUN_TEST_CASE(transport_basic, transport_ws_init_destroy_no_list);
     RUN_TEST_CASE(transport_basic, transport_list_init_multiple_and_destroy);
+    RUN_TEST_CASE(transport_basic, transport_buffered_read_ahead_and_write_coalescing);
+    RUN_TEST_CASE(transport_basic, transport_ws_on_buffered_init_destroy);
 }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -316,6 +316,14 @@ int esp_transport_get_socket(esp_transport_handle_t t)
     return -1;
 }
 
+int esp_transport_flush(esp_transport_handle_t t, int timeout_ms)
+{
+    if (t && t->_flush) {
+        return t->_flush(t, timeout_ms);
+    }
+    return 0;
+}
+
 esp_err_t esp_transport_translate_error(enum esp_tcp_transport_err_t error)
 {
     esp_err_t err = ESP_FAIL;
@@ -0,0 +1,212 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_transport.h"
+#include "esp_transport_buffered.h"
+#include "esp_transport_internal.h"
+
+static const char *TAG = "transport_buffered";
+
+typedef struct {
+    esp_transport_handle_t parent;
+    char *rx_buffer;
+    size_t rx_size;
+    size_t rx_pos;              /*!< Offset of the first unread byte in rx_buffer */
+    size_t rx_len;              /*!< Number of unread bytes in rx_buffer */
+    char *tx_buffer;
+    size_t tx_size;
+    size_t tx_len;              /*!< Number of unsent bytes in tx_buffer */
+    int last_timeout_ms;        /*!< Timeout of the last write, used to flush on close */
+} transport_buffered_t;
+
+static int buffered_flush(esp_transport_handle_t t, int timeout_ms)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+    size_t sent = 0;
+
+    while (sent < buffered->tx_len) {
+        int ret = esp_transport_write(buffered->parent, buffered->tx_buffer + sent, buffered->tx_len - sent, timeout_ms);
+        if (ret <= 0) {
+            ESP_LOGE(TAG, "Error flushing %d bytes (%d)", (int)(buffered->tx_len - sent), ret);
+            // keep what wasn't sent for the next flush
+            memmove(buffered->tx_buffer, buffered->tx_buffer + sent, buffered->tx_len - sent);
+            buffered->tx_len -= sent;
+            return -1;
+        }
+        sent += ret;
+    }
+    buffered->tx_len = 0;
+    return 0;
+}
+
+static void buffered_reset(transport_buffered_t *buffered)
+{
+    buffered->rx_pos = 0;
+    buffered->rx_len = 0;
+    buffered->tx_len = 0;
+}
+
+static int buffered_connect(esp_transport_handle_t t, const char *host, int port, int timeout_ms)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+    buffered_reset(buffered);
+    return esp_transport_connect(buffered->parent, host, port, timeout_ms);
+}
+
+static int buffered_connect_async(esp_transport_handle_t t, const char *host, int port, int timeout_ms)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+    buffered_reset(buffered);
+    return esp_transport_connect_async(buffered->parent, host, port, timeout_ms);
+}
+
+static int buffered_read(esp_transport_handle_t t, char *buffer, int len, int timeout_ms)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+
+    if (buffered->rx_len == 0) {
+        // the peer may be waiting for our pending data before it answers
+        if (buffered->tx_len && buffered_flush(t, timeout_ms) < 0) {
+            return -1;
+        }
+        if ((size_t)len >= buffered->rx_size) {
+            return esp_transport_read(buffered->parent, buffer, len, timeout_ms);
+        }
+        int ret = esp_transport_read(buffered->parent, buffered->rx_buffer, buffered->rx_size, timeout_ms);
+        if (ret <= 0) {
+            return ret;
+        }
+        buffered->rx_pos = 0;
+        buffered->rx_len = ret;
+    }
+
+    int to_read = (buffered->rx_len >= (size_t)len) ? len : (int)buffered->rx_len;
+    memcpy(buffer, buffered->rx_buffer + buffered->rx_pos, to_read);
+    buffered->rx_pos += to_read;
+    buffered->rx_len -= to_read;
+    return to_read;
+}
+
+static int buffered_write(esp_transport_handle_t t, const char *buffer, int len, int timeout_ms)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+
+    buffered->last_timeout_ms = timeout_ms;
+    if (buffered->tx_len && (size_t)len > buffered->tx_size - buffered->tx_len) {
+        if (buffered_flush(t, timeout_ms) < 0) {
+            return -1;
+        }
+    }
+    if ((size_t)len >= buffered->tx_size) {
+        return esp_transport_write(buffered->parent, buffer, len, timeout_ms);
+    }
+    memcpy(buffered->tx_buffer + buffered->tx_len, buffer, len);
+    buffered->tx_len += len;
+    return len;
+}
+
+static int buffered_poll_read(esp_transport_handle_t t, int timeout_ms)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+
+    if (buffered->rx_len) {
+        return 1;
+    }
+    if (buffered->tx_len && buffered_flush(t, timeout_ms) < 0) {
+        return -1;
+    }
+    return esp_transport_poll_read(buffered->parent, timeout_ms);
+}
+
+static int buffered_poll_write(esp_transport_handle_t t, int timeout_ms)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+
+    if (buffered->tx_len < buffered->tx_size) {
+        return 1;
+    }
+    return esp_transport_poll_write(buffered->parent, timeout_ms);
+}
+
+static int buffered_close(esp_transport_handle_t t)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+
+    if (buffered->tx_len) {
+        buffered_flush(t, buffered->last_timeout_ms);
+    }
+    buffered_reset(buffered);
+    return esp_transport_close(buffered->parent);
+}
+
+static int buffered_destroy(esp_transport_handle_t t)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+    free(buffered->rx_buffer);
+    free(buffered->tx_buffer);
+    free(buffered);
+    return 0;
+}
+
+static int buffered_get_socket(esp_transport_handle_t t)
+{
+    transport_buffered_t *buffered = esp_transport_get_context_data(t);
+    return esp_transport_get_socket(buffered->parent);
+}
+
+int esp_transport_buffered_flush(esp_transport_handle_t t, int timeout_ms)
+{
+    if (t == NULL || t->_flush != buffered_flush) {
+        ESP_LOGE(TAG, "Transport must be a valid buffered handle");
+        return -1;
+    }
+    return buffered_flush(t, timeout_ms);
+}
+
+esp_transport_handle_t esp_transport_buffered_init(esp_transport_handle_t parent_handle, const esp_transport_buffered_config_t *config)
+{
+    if (parent_handle == NULL || config == NULL) {
+        ESP_LOGE(TAG, "Invalid parent transport or config");
+        return NULL;
+    }
+    esp_transport_handle_t t = esp_transport_init();
+    if (t == NULL) {
+        return NULL;
+    }
+    transport_buffered_t *buffered = calloc(1, sizeof(transport_buffered_t));
+    ESP_TRANSPORT_MEM_CHECK(TAG, buffered, {
+        esp_transport_destroy(t);
+        return NULL;
+    });
+    buffered->parent = parent_handle;
+    buffered->rx_size = config->rx_buffer_size;
+    buffered->tx_size = config->tx_buffer_size;
+    if (buffered->rx_size) {
+        buffered->rx_buffer = malloc(buffered->rx_size);
+    }
+    if (buffered->tx_size) {
+        buffered->tx_buffer = malloc(buffered->tx_size);
+    }
+    ESP_TRANSPORT_MEM_CHECK(TAG, (buffered->rx_buffer || !buffered->rx_size) && (buffered->tx_buffer || !buffered->tx_size), {
+        free(buffered->rx_buffer);
+        free(buffered->tx_buffer);
+        free(buffered);
+        esp_transport_destroy(t);
+        return NULL;
+    });
+    t->foundation = parent_handle->foundation;
+
+    esp_transport_set_func(t, buffered_connect, buffered_read, buffered_write, buffered_close,
+                           buffered_poll_read, buffered_poll_write, buffered_destroy);
+    esp_transport_set_async_connect_func(t, buffered_connect_async);
+    esp_transport_set_context_data(t, buffered);
+    t->_get_socket = buffered_get_socket;
+    t->_flush = buffered_flush;
+    return t;
+}
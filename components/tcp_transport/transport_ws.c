@@ -400,6 +400,11 @@ static int _ws_write(esp_transport_handle_t t, int opcode, int mask_flag, const
         return -1;
     }
     if (len == 0) {
+        // send the frame now if the parent collects the writes
+        if (esp_transport_flush(ws->parent, timeout_ms) < 0) {
+            ESP_LOGE(TAG, "Error flush frame");
+            return -1;
+        }
         return 0;
     }
 
@@ -412,6 +417,10 @@ static int _ws_write(esp_transport_handle_t t, int opcode, int mask_flag, const
             buffer[i] = (buffer[i] ^ mask[i % 4]);
         }
     }
+    if (ret > 0 && esp_transport_flush(ws->parent, timeout_ms) < 0) {
+        ESP_LOGE(TAG, "Error flush frame");
+        return -1;
+    }
     return ret;
 }
 
@@ -641,6 +650,12 @@ static int ws_poll_write(esp_transport_handle_t t, int timeout_ms)
     return esp_transport_poll_write(ws->parent, timeout_ms);;
 }
 
+static int ws_flush(esp_transport_handle_t t, int timeout_ms)
+{
+    transport_ws_t *ws = esp_transport_get_context_data(t);
+    return esp_transport_flush(ws->parent, timeout_ms);
+}
+
 static int ws_close(esp_transport_handle_t t)
 {
     transport_ws_t *ws = esp_transport_get_context_data(t);
@@ -737,6 +752,7 @@ esp_transport_handle_t esp_transport_ws_init(esp_transport_handle_t parent_handl
 
     esp_transport_set_context_data(t, ws);
     t->_get_socket = ws_get_socket;
+    t->_flush = ws_flush;
     return t;
 }
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2016-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2016-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -35,6 +35,7 @@ extern "C" {
     .software = {                                                             \
         .waterproof_threshold_divider = 0.8,                                  \
         .processing_period = 10,                                              \
+        .idle_processing_period = 0,                                          \
         .intr_message_size = 14,                                              \
         .event_message_size = 20                                              \
     }                                                                         \
@@ -56,6 +57,9 @@ extern "C" {
 typedef struct {
     float waterproof_threshold_divider;        //!< Waterproof guard channel threshold divider
     uint8_t processing_period;                 //!< Processing period(ms)
+    uint16_t idle_processing_period;           //!< Processing period(ms) used while no channel is touched, 0 to always use processing_period.
+                                               //!< The threshold crossings are detected by the hardware, the processing period
+                                               //!< is restored by the first touch interrupt.
     uint8_t intr_message_size;                 //!< Interrupt message queue size
     uint8_t event_message_size;                //!< Event message queue size
 } touch_elem_sw_config_t;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2016-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2016-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -9,6 +9,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/queue.h"
+#include "freertos/timers.h"
 #include "esp_sleep.h"
 #include "esp_timer.h"
 #include "esp_check.h"
@@ -72,6 +73,8 @@
 
 #define TE_PROCESSING_PERIOD(obj)                 ((obj)->global_config->software.processing_period)
 #define TE_WATERPROOF_DIVIDER(obj)                ((obj)->global_config->software.waterproof_threshold_divider)
+#define TE_IDLE_PROCESSING_PERIOD(obj)            ((obj)->global_config->software.idle_processing_period)
+#define TE_IDLE_ENTER_PERIODS                     10    //Number of processing periods without any touch before switching to the idle period
 
 typedef enum {
     TE_INTR_PRESS = 0,          //Touch sensor press interrupt(TOUCH_PAD_INTR_MASK_ACTIVE)
@@ -98,6 +101,10 @@ typedef struct {
     SemaphoreHandle_t mutex;                                //Global resource mutex
     bool is_set_threshold;                                  //Threshold configuration state bit
     uint32_t denoise_channel_raw;                           //De-noise channel(TO) raw signal
+    uint32_t active_channel_mask;                           //Channels being touched
+    uint8_t idle_periods;                                   //Number of processing periods without any touch
+    volatile bool is_idle;                                  //Processing timer runs at the idle processing period
+    volatile bool is_resume_pending;                        //Switching back to the processing period was requested from the ISR
 } te_obj_t;
 
 static te_obj_t *s_te_obj = NULL;
@@ -127,6 +134,7 @@ static float te_channel_get_equ_cap(touch_pad_t channel_num);
 static uint32_t te_read_raw_signal(touch_pad_t channel_num);
 static void te_intr_cb(void *arg);
 static void te_proc_timer_cb(void *arg);
+static void te_proc_resume(void *arg, uint32_t unused);
 static inline esp_err_t te_object_set_threshold(void);
 static inline void te_object_process_state(void);
 static inline void te_object_update_state(te_intr_msg_t te_intr_msg);
@@ -192,6 +200,9 @@ esp_err_t touch_element_start(void)
             break;
         }
         s_te_obj->is_set_threshold = false;  //Threshold configuration will be set on touch sense start
+        s_te_obj->is_idle = false;
+        s_te_obj->idle_periods = 0;
+        s_te_obj->active_channel_mask = 0;
         ret = esp_timer_start_periodic(s_te_obj->proc_timer, TE_PROCESSING_PERIOD(s_te_obj) * 1000);
         if (ret != ESP_OK) {
             break;
@@ -412,66 +423,149 @@ static void te_intr_cb(void *arg)
     }
     if (need_send_queue) {
         xQueueSendFromISR(s_te_obj->intr_msg_queue, &te_intr_msg, &task_awoken);
+#if CONFIG_FREERTOS_USE_TIMERS
+        /*< esp-timer can not be restarted from ISR, the timer task switches back to the processing period */
+        if (s_te_obj->is_idle && !s_te_obj->is_resume_pending) {
+            s_te_obj->is_resume_pending = true;
+            if (xTimerPendFunctionCallFromISR(te_proc_resume, NULL, 0, &task_awoken) != pdPASS) {
+                s_te_obj->is_resume_pending = false;
+            }
+        }
+#endif
     }
     if (task_awoken == pdTRUE) {
         portYIELD_FROM_ISR();
     }
 }
 
+static void te_proc_resume(void *arg, uint32_t unused)
+{
+    TE_UNUSED(arg);
+    TE_UNUSED(unused);
+    if (s_te_obj == NULL) {
+        return;
+    }
+    s_te_obj->is_resume_pending = false;
+    if (s_te_obj->is_idle) {
+        s_te_obj->is_idle = false;
+        s_te_obj->idle_periods = 0;
+        esp_timer_restart(s_te_obj->proc_timer, TE_PROCESSING_PERIOD(s_te_obj) * 1000);
+    }
+}
+
+static void te_proc_intr_msg(te_intr_msg_t te_intr_msg)
+{
+    if (te_intr_msg.intr_type == TE_INTR_PRESS || te_intr_msg.intr_type == TE_INTR_RELEASE) {
+        if (te_intr_msg.intr_type == TE_INTR_PRESS) {
+            s_te_obj->active_channel_mask |= BIT(te_intr_msg.channel_num);
+        } else {
+            s_te_obj->active_channel_mask &= ~BIT(te_intr_msg.channel_num);
+        }
+        te_object_update_state(te_intr_msg);
+        if ((s_te_obj->sleep_handle != NULL) && (te_intr_msg.intr_type == TE_INTR_RELEASE)) {
+#ifdef CONFIG_PM_ENABLE
+            esp_pm_lock_release(s_te_obj->sleep_handle->pm_lock);
+#endif
+        }
+    } else if (te_intr_msg.intr_type == TE_INTR_SCAN_DONE) {
+        if (s_te_obj->is_set_threshold != true) {
+            s_te_obj->is_set_threshold = true;
+            te_object_set_threshold();  //TODO: add set threshold error processing
+            ESP_LOGD(TE_DEBUG_TAG, "Set threshold");
+            if (s_te_obj->sleep_handle != NULL) {
+#ifdef CONFIG_PM_ENABLE
+                esp_pm_lock_release(s_te_obj->sleep_handle->pm_lock);
+#endif
+            }
+        }
+        if (waterproof_check_state()) {
+            te_waterproof_handle_t waterproof_handle = s_te_obj->waterproof_handle;
+            if (waterproof_handle->is_shield_level_set != true) {
+                waterproof_handle->is_shield_level_set = true;
+                touch_pad_waterproof_t wp_conf;
+                wp_conf.shield_driver = waterproof_get_shield_level(waterproof_handle->shield_channel);
+                wp_conf.guard_ring_pad = (waterproof_guard_check_state() ? waterproof_handle->guard_device->channel : TOUCH_WATERPROOF_GUARD_NOUSE);
+                touch_pad_waterproof_set_config(&wp_conf);
+                touch_pad_waterproof_enable();
+                ESP_LOGD(TE_DEBUG_TAG, "Set waterproof shield level");
+            }
+        }
+        ESP_LOGD(TE_DEBUG_TAG, "read denoise channel %"PRIu32, s_te_obj->denoise_channel_raw);
+    } else if (te_intr_msg.intr_type == TE_INTR_TIMEOUT) { //Timeout processing
+        touch_pad_timeout_resume();
+    }
+}
+
+/**
+ * @brief Switch the processing timer between the processing period and the idle processing period
+ *
+ * The idle processing period is used once no channel has been touched for TE_IDLE_ENTER_PERIODS processing periods,
+ * the processing period is restored as soon as a touch interrupt is received.
+ */
+static void te_proc_update_period(bool has_intr_msg)
+{
+    if (TE_IDLE_PROCESSING_PERIOD(s_te_obj) == 0) {
+        return;
+    }
+    if (s_te_obj->is_idle) {
+        if (has_intr_msg || s_te_obj->active_channel_mask != 0) {
+            s_te_obj->is_idle = false;
+            s_te_obj->idle_periods = 0;
+            esp_timer_restart(s_te_obj->proc_timer, TE_PROCESSING_PERIOD(s_te_obj) * 1000);
+        }
+        return;
+    }
+    if (has_intr_msg || s_te_obj->active_channel_mask != 0 || s_te_obj->is_set_threshold != true) {
+        s_te_obj->idle_periods = 0;
+        return;
+    }
+    if (++s_te_obj->idle_periods < TE_IDLE_ENTER_PERIODS) {
+        return;
+    }
+    /*< Set the idle flag before checking the queue, so that an interrupt message is either seen here or resumes from the ISR */
+    s_te_obj->is_idle = true;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (uxQueueMessagesWaiting(s_te_obj->intr_msg_queue) > 0) {
+        s_te_obj->is_idle = false;
+        return;
+    }
+    esp_timer_restart(s_te_obj->proc_timer, TE_IDLE_PROCESSING_PERIOD(s_te_obj) * 1000);
+    ESP_LOGD(TE_DEBUG_TAG, "Enter idle processing period");
+}
+
 /**
  * @brief esp-timer callback routine
  *
  * This function is an esp-timer daemon routine, all the touch sensor
  * application(button, slider, etc...) will be processed in here.
  *
+ * All the interrupt messages received since the last period are processed at once, a channel
+ * which changed its state again is left for the next period so that none of its events is lost.
  */
 static void te_proc_timer_cb(void *arg)
 {
     TE_UNUSED(arg);
     te_intr_msg_t te_intr_msg;
-    te_intr_msg.intr_type = TE_INTR_MAX;
+    uint32_t updated_channel_mask = 0;
+    bool has_intr_msg = false;
     BaseType_t ret = xSemaphoreTake(s_te_obj->mutex, 0);
     if (ret != pdPASS) {
         return;
     }
-    ret = xQueueReceive(s_te_obj->intr_msg_queue, &te_intr_msg, 0);
-    if (ret == pdPASS) {
-        if (te_intr_msg.intr_type == TE_INTR_PRESS || te_intr_msg.intr_type == TE_INTR_RELEASE) {
-            te_object_update_state(te_intr_msg);
-            if ((s_te_obj->sleep_handle != NULL) && (te_intr_msg.intr_type == TE_INTR_RELEASE)) {
-#ifdef CONFIG_PM_ENABLE
-                esp_pm_lock_release(s_te_obj->sleep_handle->pm_lock);
-#endif
-            }
-        } else if (te_intr_msg.intr_type == TE_INTR_SCAN_DONE) {
-            if (s_te_obj->is_set_threshold != true) {
-                s_te_obj->is_set_threshold = true;
-                te_object_set_threshold();  //TODO: add set threshold error processing
-                ESP_LOGD(TE_DEBUG_TAG, "Set threshold");
-                if (s_te_obj->sleep_handle != NULL) {
-#ifdef CONFIG_PM_ENABLE
-                    esp_pm_lock_release(s_te_obj->sleep_handle->pm_lock);
-#endif
-                }
-            }
-            if (waterproof_check_state()) {
-                te_waterproof_handle_t waterproof_handle = s_te_obj->waterproof_handle;
-                if (waterproof_handle->is_shield_level_set != true) {
-                    waterproof_handle->is_shield_level_set = true;
-                    touch_pad_waterproof_t wp_conf;
-                    wp_conf.shield_driver = waterproof_get_shield_level(waterproof_handle->shield_channel);
-                    wp_conf.guard_ring_pad = (waterproof_guard_check_state() ? waterproof_handle->guard_device->channel : TOUCH_WATERPROOF_GUARD_NOUSE);
-                    touch_pad_waterproof_set_config(&wp_conf);
-                    touch_pad_waterproof_enable();
-                    ESP_LOGD(TE_DEBUG_TAG, "Set waterproof shield level");
-                }
-            }
-            ESP_LOGD(TE_DEBUG_TAG, "read denoise channel %"PRIu32, s_te_obj->denoise_channel_raw);
-        } else if (te_intr_msg.intr_type == TE_INTR_TIMEOUT) { //Timeout processing
-            touch_pad_timeout_resume();
+    while (xQueuePeek(s_te_obj->intr_msg_queue, &te_intr_msg, 0) == pdPASS) {
+        bool is_channel_msg = (te_intr_msg.intr_type == TE_INTR_PRESS || te_intr_msg.intr_type == TE_INTR_RELEASE);
+        if (is_channel_msg && (updated_channel_mask & BIT(te_intr_msg.channel_num))) {
+            break;
+        }
+        xQueueReceive(s_te_obj->intr_msg_queue, &te_intr_msg, 0);
+        if (is_channel_msg) {
+            updated_channel_mask |= BIT(te_intr_msg.channel_num);
         }
+        te_proc_intr_msg(te_intr_msg);
+        has_intr_msg = true;
     }
     te_object_process_state();
+    te_proc_update_period(has_intr_msg);
     xSemaphoreGive(s_te_obj->mutex);
 }
 
@@ -727,6 +821,8 @@ static esp_err_t te_hw_init(const touch_elem_hw_config_t *hardware_init)
 static esp_err_t te_sw_init(const touch_elem_sw_config_t *software_init)
 {
     TE_CHECK(software_init->processing_period > 1, ESP_ERR_INVALID_ARG);
+    TE_CHECK(software_init->idle_processing_period == 0 ||
+             software_init->idle_processing_period >= software_init->processing_period, ESP_ERR_INVALID_ARG);
     TE_CHECK(software_init->waterproof_threshold_divider > 0, ESP_ERR_INVALID_ARG);
     TE_CHECK(software_init->intr_message_size >= (TOUCH_PAD_MAX - 1), ESP_ERR_INVALID_ARG);
     TE_CHECK(software_init->event_message_size > 0, ESP_ERR_INVALID_ARG);
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Single producer, single consumer ring buffer shared between the main CPU and the LP core
+ *
+ * The ring is placed in LP memory by declaring its storage in the LP core program, for example
+ * `uint32_t sample_ring[ULP_LP_CORE_RING_STORAGE_WORDS(4096)];`, and is accessed from the main CPU
+ * through the exported ulp_sample_ring symbol. The data follows this header in the storage.
+ *
+ * One side only writes and the other side only reads, no lock is taken, so the LP core never waits
+ * for the main CPU. The fields are private.
+ */
+typedef struct {
+    volatile uint32_t head;             /*!< Number of bytes written since the ring was initialized, only updated by the producer */
+    volatile uint32_t tail;             /*!< Number of bytes read since the ring was initialized, only updated by the consumer */
+    uint32_t size;                      /*!< Size of the data area, a power of two */
+    uint32_t wakeup_threshold;          /*!< Number of bytes in the ring at which the LP core wakes up the main CPU */
+} ulp_lp_core_ring_t;
+
+/**
+ * @brief Number of 32-bit words of storage needed by a ring holding size bytes
+ */
+#define ULP_LP_CORE_RING_STORAGE_WORDS(size)    ((sizeof(ulp_lp_core_ring_t) + (size) + 3) / 4)
+
+/**
+ * @brief Initialize a ring
+ *
+ * @note Initialize the ring from the main CPU after loading the LP core program and before running it, as the
+ *       LP core program starts again from main() at every wakeup.
+ *
+ * @param ring              Ring storage, of at least ULP_LP_CORE_RING_STORAGE_WORDS(size) words
+ * @param size              Size of the data area, must be a power of two
+ * @param wakeup_threshold  When written by the LP core, wake up the main CPU once the ring holds this number of
+ *                          bytes. 0 disables the wakeup.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if ring is NULL, size is not a power of two or wakeup_threshold is larger than size
+ */
+esp_err_t ulp_lp_core_ring_init(ulp_lp_core_ring_t *ring, size_t size, size_t wakeup_threshold);
+
+/**
+ * @brief Write data to the ring
+ *
+ * The data is written entirely or not at all, so that a reader consuming multiples of a sample size always
+ * gets complete samples.
+ *
+ * When called from the LP core, the main CPU is woken up by ulp_lp_core_wakeup_main_processor() when this
+ * write makes the number of bytes in the ring reach the wakeup threshold.
+ *
+ * @param ring  Ring
+ * @param data  Data to write
+ * @param len   Length of data
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if ring or data is NULL
+ *      - ESP_ERR_NO_MEM if the free space of the ring is shorter than len
+ */
+esp_err_t ulp_lp_core_ring_write(ulp_lp_core_ring_t *ring, const void *data, size_t len);
+
+/**
+ * @brief Read data from the ring
+ *
+ * @param ring  Ring
+ * @param buf   Buffer receiving the data
+ * @param len   Size of buf
+ *
+ * @return Number of bytes read, 0 if the ring is empty
+ */
+size_t ulp_lp_core_ring_read(ulp_lp_core_ring_t *ring, void *buf, size_t len);
+
+/**
+ * @brief Get the number of bytes which can be read from the ring
+ *
+ * @param ring  Ring
+ *
+ * @return Number of bytes in the ring
+ */
+size_t ulp_lp_core_ring_get_used(const ulp_lp_core_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
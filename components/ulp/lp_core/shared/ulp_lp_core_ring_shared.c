@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "ulp_lp_core_ring_shared.h"
+#if IS_ULP_COCPU
+#include "ulp_lp_core_utils.h"
+#endif
+
+/* head and tail are free running counters, only the producer writes head and only the consumer writes tail.
+   The fences order the accesses to the data with the update of the counters, as seen by the other core. */
+#define RING_FENCE()    __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+static inline uint8_t *ring_data(const ulp_lp_core_ring_t *ring)
+{
+    return (uint8_t *)(ring + 1);
+}
+
+esp_err_t ulp_lp_core_ring_init(ulp_lp_core_ring_t *ring, size_t size, size_t wakeup_threshold)
+{
+    if (!ring || size == 0 || (size & (size - 1)) != 0 || wakeup_threshold > size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ring->head = 0;
+    ring->tail = 0;
+    ring->size = size;
+    ring->wakeup_threshold = wakeup_threshold;
+    RING_FENCE();
+    return ESP_OK;
+}
+
+size_t ulp_lp_core_ring_get_used(const ulp_lp_core_ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
+
+esp_err_t ulp_lp_core_ring_write(ulp_lp_core_ring_t *ring, const void *data, size_t len)
+{
+    if (!ring || !data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t head = ring->head;
+    uint32_t used = head - ring->tail;
+    if (len > ring->size - used) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    uint32_t offset = head & (ring->size - 1);
+    size_t first = ring->size - offset;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(ring_data(ring) + offset, data, first);
+    memcpy(ring_data(ring), (const uint8_t *)data + first, len - first);
+
+    /* the data has to be visible before the consumer sees the new head */
+    RING_FENCE();
+    ring->head = head + len;
+
+#if IS_ULP_COCPU
+    /* wake up only when the threshold is crossed, not again until the reader brought the ring below it */
+    if (ring->wakeup_threshold && used < ring->wakeup_threshold && used + len >= ring->wakeup_threshold) {
+        ulp_lp_core_wakeup_main_processor();
+    }
+#endif
+    return ESP_OK;
+}
+
+size_t ulp_lp_core_ring_read(ulp_lp_core_ring_t *ring, void *buf, size_t len)
+{
+    if (!ring || !buf) {
+        return 0;
+    }
+
+    uint32_t tail = ring->tail;
+    uint32_t used = ring->head - tail;
+    if (len > used) {
+        len = used;
+    }
+    /* the data written before head was updated is read after head */
+    RING_FENCE();
+
+    uint32_t offset = tail & (ring->size - 1);
+    size_t first = ring->size - offset;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(buf, ring_data(ring) + offset, first);
+    memcpy((uint8_t *)buf + first, ring_data(ring), len - first);
+
+    /* the data has to be copied out before the producer may overwrite it */
+    RING_FENCE();
+    ring->tail = tail + len;
+    return len;
+}
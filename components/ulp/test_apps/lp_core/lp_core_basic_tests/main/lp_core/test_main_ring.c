@@ -0,0 +1,27 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include "ulp_lp_core_ring_shared.h"
+#include "test_shared.h"
+
+uint32_t sample_ring[ULP_LP_CORE_RING_STORAGE_WORDS(RING_TEST_SIZE)];
+volatile uint32_t ring_sample_cnt;
+
+int main(void)
+{
+    ulp_lp_core_ring_t *ring = (ulp_lp_core_ring_t *)sample_ring;
+
+    for (int i = 0; i < RING_TEST_SAMPLES_PER_RUN; i++) {
+        uint32_t sample = ring_sample_cnt;
+        if (ulp_lp_core_ring_write(ring, &sample, sizeof(sample)) != ESP_OK) {
+            break;
+        }
+        ring_sample_cnt++;
+    }
+
+    return 0;
+}
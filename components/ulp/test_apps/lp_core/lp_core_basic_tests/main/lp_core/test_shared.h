@@ -15,6 +15,10 @@
 /* LP UART test param */
 #define UART_BUF_SIZE  1024
 
+/* LP core ring test params */
+#define RING_TEST_SIZE              512
+#define RING_TEST_SAMPLES_PER_RUN   16
+
 typedef enum {
     LP_CORE_READ_WRITE_TEST = 1,
     LP_CORE_DELAY_TEST,
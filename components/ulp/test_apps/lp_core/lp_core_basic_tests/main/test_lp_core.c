@@ -12,6 +12,7 @@
 #include "lp_core_test_app.h"
 #include "lp_core_test_app_counter.h"
 #include "lp_core_test_app_isr.h"
+#include "lp_core_test_app_ring.h"
 
 #if SOC_LP_TIMER_SUPPORTED
 #include "lp_core_test_app_set_timer_wakeup.h"
@@ -20,6 +21,7 @@
 #include "lp_core_test_app_gpio.h"
 #include "ulp_lp_core.h"
 #include "ulp_lp_core_lp_timer_shared.h"
+#include "ulp_lp_core_ring_shared.h"
 #include "test_shared.h"
 #include "unity.h"
 #include "esp_sleep.h"
@@ -46,6 +48,9 @@ extern const uint8_t lp_core_main_gpio_bin_end[]   asm("_binary_lp_core_test_app
 extern const uint8_t lp_core_main_isr_bin_start[] asm("_binary_lp_core_test_app_isr_bin_start");
 extern const uint8_t lp_core_main_isr_bin_end[]   asm("_binary_lp_core_test_app_isr_bin_end");
 
+extern const uint8_t lp_core_main_ring_bin_start[] asm("_binary_lp_core_test_app_ring_bin_start");
+extern const uint8_t lp_core_main_ring_bin_end[]   asm("_binary_lp_core_test_app_ring_bin_end");
+
 static void load_and_start_lp_core_firmware(ulp_lp_core_cfg_t* cfg, const uint8_t* firmware_start, const uint8_t* firmware_end)
 {
     TEST_ASSERT(ulp_lp_core_load_binary(firmware_start,
@@ -257,6 +262,38 @@ TEST_CASE("LP Timer can wakeup lp core periodically", "[lp_core]")
     TEST_ASSERT_INT_WITHIN_MESSAGE(5, expected_run_count, ulp_counter, "LP Core did not wake up the expected number of times");
 }
 
+TEST_CASE("LP core streams samples to the main CPU through a shared ring", "[lp_core]")
+{
+    ulp_lp_core_cfg_t cfg = {
+        .wakeup_source = ULP_LP_CORE_WAKEUP_SOURCE_LP_TIMER,
+        .lp_timer_sleep_duration_us = LP_TIMER_TEST_SLEEP_DURATION_US,
+    };
+
+    TEST_ASSERT(ulp_lp_core_load_binary(lp_core_main_ring_bin_start,
+                                        (lp_core_main_ring_bin_end - lp_core_main_ring_bin_start)) == ESP_OK);
+    ulp_lp_core_ring_t *ring = (ulp_lp_core_ring_t *)&ulp_sample_ring;
+    TEST_ASSERT_EQUAL(ESP_OK, ulp_lp_core_ring_init(ring, RING_TEST_SIZE, 0));
+    TEST_ASSERT(ulp_lp_core_run(&cfg) == ESP_OK);
+
+    uint32_t expected = 0;
+    uint32_t samples[RING_TEST_SAMPLES_PER_RUN];
+    int64_t start = esp_timer_get_time();
+    while (esp_timer_get_time() - start < LP_TIMER_TEST_DURATION_S * 1000 * 1000) {
+        size_t len = ulp_lp_core_ring_read(ring, samples, sizeof(samples));
+        TEST_ASSERT_EQUAL(0, len % sizeof(uint32_t));
+        for (size_t i = 0; i < len / sizeof(uint32_t); i++) {
+            TEST_ASSERT_EQUAL(expected, samples[i]);
+            expected++;
+        }
+        vTaskDelay(1);
+    }
+    ulp_lp_core_stop();
+
+    printf("Read %"PRIu32" samples written by the LP core\n", expected);
+    TEST_ASSERT_GREATER_THAN(RING_TEST_SAMPLES_PER_RUN, expected);
+    TEST_ASSERT_UINT32_WITHIN(RING_TEST_SIZE / sizeof(uint32_t), ulp_ring_sample_cnt, expected);
+}
+
 static bool ulp_is_running(uint32_t *counter_variable)
 {
     uint32_t start_cnt = *counter_variable;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -11,6 +11,7 @@
 #include "freertos/task.h"
 #include "unity_test_utils_memory.h"
 #include "unity_test_utils_cache.h"
+#include "unity_test_utils_bench.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Function measured by a benchmark
+ *
+ * @param arg User argument given to unity_utils_bench_run()
+ */
+typedef void (*unity_utils_bench_fn_t)(void *arg);
+
+/**
+ * @brief Configuration of a benchmark
+ */
+typedef struct {
+    const char *name;           /*!< Name of the benchmark, printed with the results */
+    uint32_t warmup_iterations; /*!< Calls of the function before the measurement, which fill the caches and the branch predictor */
+    uint32_t iterations;        /*!< Number of measured calls */
+    bool disable_interrupts;    /*!< Disable the interrupts of the current core during each measured call */
+    const void *evict_addr;     /*!< Region written back and invalidated from the cache before each measured call, e.g. the
+                                     buffer processed by the function, so that each call starts with a cold cache. Must be in
+                                     cacheable memory (flash or PSRAM). NULL to keep the cache as the previous call left it */
+    size_t evict_size;          /*!< Size of the region at evict_addr */
+} unity_utils_bench_config_t;
+
+/**
+ * @brief Default configuration of a benchmark
+ */
+#define UNITY_UTILS_BENCH_CONFIG_DEFAULT(bench_name) { \
+    .name = bench_name, \
+    .warmup_iterations = 10, \
+    .iterations = 100, \
+    .disable_interrupts = false, \
+    .evict_addr = NULL, \
+    .evict_size = 0, \
+}
+
+/**
+ * @brief Results of a benchmark, in CPU cycles per call
+ */
+typedef struct {
+    uint32_t iterations;        /*!< Number of measured calls */
+    uint32_t min;               /*!< Fastest call */
+    uint32_t median;            /*!< Median, the lower one for an even number of calls */
+    uint32_t p90;               /*!< 90th percentile */
+    uint32_t p99;               /*!< 99th percentile */
+    uint32_t max;               /*!< Slowest call */
+    uint32_t mean;              /*!< Mean of all calls */
+} unity_utils_bench_result_t;
+
+/**
+ * @brief Measure the CPU cycles taken by a function
+ *
+ * After the warm-up calls, each call is timed separately with the CPU cycle counter, and the cost of reading the counter
+ * is subtracted. The results are printed in a single line which can be parsed by the test scripts:
+ *
+ *     [Benchmark][<name>]: iterations=100 min=812 median=830 p90=845 p99=1210 max=1304 mean=838 cpu_mhz=160
+ *
+ * @note The cycle counters of the cores are independent, so the calling task must be pinned to a core. The unity task
+ *       is, unless it creates other tasks which run the benchmark.
+ * @note With interrupts enabled, p99 and max include the interrupts and context switches which happen during the calls.
+ *
+ * @param config Configuration of the benchmark
+ * @param fn     Function to measure
+ * @param arg    Argument passed to the function
+ * @param[out] result Results of the benchmark
+ */
+void unity_utils_bench_run(const unity_utils_bench_config_t *config, unity_utils_bench_fn_t fn, void *arg, unity_utils_bench_result_t *result);
+
+/**
+ * @brief Assert that the median of a benchmark is below a limit
+ *
+ * A regression gate which is robust to the occasional slow call, e.g., interrupted by an interrupt.
+ */
+#define TEST_BENCH_MEDIAN_LESS_THAN(result, max_cycles) \
+    TEST_ASSERT_LESS_THAN_UINT32_MESSAGE((max_cycles), (result)->median, "Benchmark median exceeds the limit")
+
+/**
+ * @brief Assert that the 99th percentile of a benchmark is below a limit
+ *
+ * A regression gate for the jitter of the measured function.
+ */
+#define TEST_BENCH_P99_LESS_THAN(result, max_cycles) \
+    TEST_ASSERT_LESS_THAN_UINT32_MESSAGE((max_cycles), (result)->p99, "Benchmark 99th percentile exceeds the limit")
+
+#ifdef __cplusplus
+}
+#endif
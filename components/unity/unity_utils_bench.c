@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "unity.h"
+#include "unity_test_utils_bench.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_cpu.h"
+#include "esp_cache.h"
+#include "esp_heap_caps.h"
+#include "esp_private/esp_clk.h"
+
+#define BENCH_OVERHEAD_SAMPLES  16
+
+static uint32_t bench_overhead(void)
+{
+    uint32_t overhead = UINT32_MAX;
+    for (int i = 0; i < BENCH_OVERHEAD_SAMPLES; i++) {
+        uint32_t start = esp_cpu_get_cycle_count();
+        uint32_t end = esp_cpu_get_cycle_count();
+        if (end - start < overhead) {
+            overhead = end - start;
+        }
+    }
+    return overhead;
+}
+
+static uint32_t bench_call(const unity_utils_bench_config_t *config, unity_utils_bench_fn_t fn, void *arg, uint32_t overhead)
+{
+    UBaseType_t intr_state = 0;
+    if (config->evict_addr) {
+        TEST_ESP_OK(esp_cache_msync((void *)config->evict_addr, config->evict_size,
+                                    ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE | ESP_CACHE_MSYNC_FLAG_UNALIGNED));
+    }
+    if (config->disable_interrupts) {
+        intr_state = portSET_INTERRUPT_MASK_FROM_ISR();
+    }
+    uint32_t start = esp_cpu_get_cycle_count();
+    fn(arg);
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    if (config->disable_interrupts) {
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(intr_state);
+    }
+    return cycles > overhead ? cycles - overhead : 0;
+}
+
+static int bench_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of the sorted samples */
+static uint32_t bench_percentile(const uint32_t *samples, uint32_t count, uint32_t percent)
+{
+    uint32_t rank = (uint32_t)(((uint64_t)count * percent + 99) / 100);
+    return samples[rank > 0 ? rank - 1 : 0];
+}
+
+void unity_utils_bench_run(const unity_utils_bench_config_t *config, unity_utils_bench_fn_t fn, void *arg, unity_utils_bench_result_t *result)
+{
+    TEST_ASSERT_NOT_NULL(config);
+    TEST_ASSERT_NOT_NULL(fn);
+    TEST_ASSERT_NOT_NULL(result);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, config->iterations);
+    // kept in internal RAM, so that storing the samples doesn't disturb the cache
+    uint32_t *samples = heap_caps_malloc(config->iterations * sizeof(uint32_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL_MESSAGE(samples, "Not enough memory for the benchmark samples");
+
+    uint32_t overhead = bench_overhead();
+    for (uint32_t i = 0; i < config->warmup_iterations; i++) {
+        fn(arg);
+    }
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < config->iterations; i++) {
+        samples[i] = bench_call(config, fn, arg, overhead);
+        total += samples[i];
+    }
+    qsort(samples, config->iterations, sizeof(uint32_t), bench_compare);
+
+    result->iterations = config->iterations;
+    result->min = samples[0];
+    result->median = samples[(config->iterations - 1) / 2];
+    result->p90 = bench_percentile(samples, config->iterations, 90);
+    result->p99 = bench_percentile(samples, config->iterations, 99);
+    result->max = samples[config->iterations - 1];
+    result->mean = (uint32_t)(total / config->iterations);
+    free(samples);
+
+    printf("[Benchmark][%s]: iterations=%"PRIu32" min=%"PRIu32" median=%"PRIu32" p90=%"PRIu32" p99=%"PRIu32
+           " max=%"PRIu32" mean=%"PRIu32" cpu_mhz=%d\n",
+           config->name ? config->name : "unnamed", result->iterations, result->min, result->median, result->p90,
+           result->p99, result->max, result->mean, esp_clk_cpu_freq() / 1000000);
+}
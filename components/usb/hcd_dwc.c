@@ -2483,18 +2483,28 @@ static bool _buffer_flush_all(pipe_t *pipe, bool canceled)
 
 esp_err_t hcd_urb_enqueue(hcd_pipe_handle_t pipe_hdl, urb_t *urb)
 {
-    // Check that URB has not already been enqueued
-    HCD_CHECK(urb->hcd_ptr == NULL && urb->hcd_var == URB_HCD_STATE_IDLE, ESP_ERR_INVALID_STATE);
-    pipe_t *pipe = (pipe_t *)pipe_hdl;
-    // Check if the ISOC pipe can handle all packets:
-    // In case the pipe's interval is too long and there are too many ISOC packets, they might not fit into the transfer descriptor list
-    HCD_CHECK(
-        !((pipe->ep_char.type == USB_DWC_XFER_TYPE_ISOCHRONOUS) && (urb->transfer.num_isoc_packets * pipe->ep_char.periodic.interval > XFER_LIST_LEN_ISOC)),
-        ESP_ERR_INVALID_SIZE
-    );
+    return hcd_urb_enqueue_multi(pipe_hdl, &urb, 1);
+}
 
-    // Sync user's data from cache to memory. For OUT and CTRL transfers
-    CACHE_SYNC_DATA_BUFFER_C2M(pipe, urb);
+esp_err_t hcd_urb_enqueue_multi(hcd_pipe_handle_t pipe_hdl, urb_t **urbs, int num_urbs)
+{
+    HCD_CHECK(urbs != NULL && num_urbs > 0, ESP_ERR_INVALID_ARG);
+    pipe_t *pipe = (pipe_t *)pipe_hdl;
+    for (int i = 0; i < num_urbs; i++) {
+        urb_t *urb = urbs[i];
+        // Check that URB has not already been enqueued
+        HCD_CHECK(urb->hcd_ptr == NULL && urb->hcd_var == URB_HCD_STATE_IDLE, ESP_ERR_INVALID_STATE);
+        // Check if the ISOC pipe can handle all packets:
+        // In case the pipe's interval is too long and there are too many ISOC packets, they might not fit into the transfer descriptor list
+        HCD_CHECK(
+            !((pipe->ep_char.type == USB_DWC_XFER_TYPE_ISOCHRONOUS) && (urb->transfer.num_isoc_packets * pipe->ep_char.periodic.interval > XFER_LIST_LEN_ISOC)),
+            ESP_ERR_INVALID_SIZE
+        );
+    }
+    for (int i = 0; i < num_urbs; i++) {
+        // Sync user's data from cache to memory. For OUT and CTRL transfers
+        CACHE_SYNC_DATA_BUFFER_C2M(pipe, urbs[i]);
+    }
 
     HCD_ENTER_CRITICAL();
     // Check that pipe and port are in the correct state to receive URBs
@@ -2502,14 +2512,17 @@ esp_err_t hcd_urb_enqueue(hcd_pipe_handle_t pipe_hdl, urb_t *urb)
                         && pipe->state == HCD_PIPE_STATE_ACTIVE             // The pipe must be in the correct state
                         && !pipe->cs_flags.pipe_cmd_processing,             // Pipe cannot currently be processing a pipe command
                         ESP_ERR_INVALID_STATE);
-    // Use the URB's reserved_ptr to store the pipe's
-    urb->hcd_ptr = (void *)pipe;
-    // Add the URB to the pipe's pending tailq
-    urb->hcd_var = URB_HCD_STATE_PENDING;
-    TAILQ_INSERT_TAIL(&pipe->pending_urb_tailq, urb, tailq_entry);
-    pipe->num_urb_pending++;
-    // use the URB's reserved_flags to store the URB's current state
-    if (_buffer_can_fill(pipe)) {
+    for (int i = 0; i < num_urbs; i++) {
+        urb_t *urb = urbs[i];
+        // Use the URB's reserved_ptr to store the pipe's
+        urb->hcd_ptr = (void *)pipe;
+        // Add the URB to the pipe's pending tailq
+        urb->hcd_var = URB_HCD_STATE_PENDING;
+        TAILQ_INSERT_TAIL(&pipe->pending_urb_tailq, urb, tailq_entry);
+        pipe->num_urb_pending++;
+    }
+    // All the URBs are pending, fill every free buffer so that the next one starts as soon as the current one is done
+    while (_buffer_can_fill(pipe)) {
         _buffer_fill(pipe);
     }
     if (_buffer_can_exec(pipe)) {
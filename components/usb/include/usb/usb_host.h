@@ -41,6 +41,10 @@ typedef struct usb_host_client_handle_s *usb_host_client_handle_t;
 #define USB_HOST_LIB_EVENT_FLAGS_NO_CLIENTS     0x01    /**< All clients have been deregistered from the USB Host Library */
 #define USB_HOST_LIB_EVENT_FLAGS_ALL_FREE       0x02    /**< The USB Host Library has freed all devices */
 
+// --------------------- Transfers -------------------------
+
+#define USB_HOST_TRANSFER_SUBMIT_MULTI_MAX      16      /**< Maximum number of transfers submitted by usb_host_transfer_submit_multi() */
+
 /**
  * @brief The type event in a client event message
  */
@@ -615,6 +619,28 @@ esp_err_t usb_host_transfer_free(usb_transfer_t *transfer);
  */
 esp_err_t usb_host_transfer_submit(usb_transfer_t *transfer);
 
+/**
+ * @brief Submit multiple non-control transfers to the same endpoint
+ *
+ * - All the transfers must target the same device and endpoint, and are executed in the order of the array
+ * - The transfers are queued to the endpoint at once, so that the next transfer starts as soon as the previous one is
+ *   done. Keeping several transfers queued on a bulk endpoint is needed to reach the bandwidth of the bus.
+ * - Either all the transfers are submitted, or none of them is
+ * - On completion, each transfer's callback will be called from the client's usb_host_client_handle_events()
+ *   function. The callbacks of the transfers completed since the last call are all called in the same call.
+ *
+ * @param[in] transfers Array of initialized transfer objects
+ * @param[in] num_transfers Number of transfers in the array, at most USB_HOST_TRANSFER_SUBMIT_MULTI_MAX
+ *
+ * @return
+ *    - ESP_OK: Transfers submitted successfully
+ *    - ESP_ERR_INVALID_ARG: Invalid argument, or the transfers don't target the same endpoint
+ *    - ESP_ERR_NOT_FINISHED: A transfer is already in-flight
+ *    - ESP_ERR_NOT_FOUND: Endpoint address not found
+ *    - ESP_ERR_INVALID_STATE: Endpoint pipe is not in a correct state to submit transfers
+ */
+esp_err_t usb_host_transfer_submit_multi(usb_transfer_t **transfers, int num_transfers);
+
 /**
  * @brief Submit a control transfer
  *
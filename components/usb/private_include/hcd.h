@@ -523,6 +523,25 @@ hcd_pipe_event_t hcd_pipe_get_event(hcd_pipe_handle_t pipe_hdl);
  */
 esp_err_t hcd_urb_enqueue(hcd_pipe_handle_t pipe_hdl, urb_t *urb);
 
+/**
+ * @brief Enqueue multiple URBs to a particular pipe
+ *
+ * Same as hcd_urb_enqueue(), but all the URBs are added to the pipe in a single critical section, in order. This allows
+ * the pipe to fill all of its buffers at once instead of one URB at a time. The URBs are checked before any of them is
+ * enqueued, so either all of them or none of them is enqueued.
+ *
+ * @param[in] pipe_hdl Pipe handle
+ * @param[in] urbs Array of URBs to enqueue
+ * @param[in] num_urbs Number of URBs in the array
+ *
+ * @return
+ *    - ESP_OK: URBs enqueued successfully
+ *    - ESP_ERR_INVALID_ARG: Invalid argument
+ *    - ESP_ERR_INVALID_SIZE: An ISOC URB has too many packets for the pipe
+ *    - ESP_ERR_INVALID_STATE: Conditions not met to enqueue the URBs
+ */
+esp_err_t hcd_urb_enqueue_multi(hcd_pipe_handle_t pipe_hdl, urb_t **urbs, int num_urbs);
+
 /**
  * @brief Dequeue an URB from a particular pipe
  *
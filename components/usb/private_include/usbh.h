@@ -668,6 +668,23 @@ esp_err_t usbh_dev_submit_ctrl_urb(usb_device_handle_t dev_hdl, urb_t *urb);
  */
 esp_err_t usbh_ep_enqueue_urb(usbh_ep_handle_t ep_hdl, urb_t *urb);
 
+/**
+ * @brief Enqueue multiple URBs to an endpoint
+ *
+ * Same as usbh_ep_enqueue_urb(), but all the URBs are enqueued to the endpoint's pipe at once. Either all of them or
+ * none of them is enqueued.
+ *
+ * @param[in] ep_hdl Endpoint handle
+ * @param[in] urbs Array of URBs to enqueue
+ * @param[in] num_urbs Number of URBs in the array
+ *
+ * @return
+ *    - ESP_OK: URBs enqueued successfully
+ *    - ESP_ERR_INVALID_ARG: Invalid argument
+ *    - ESP_ERR_INVALID_STATE: The pipe is not in an active state or the URBs can't be enqueued
+ */
+esp_err_t usbh_ep_enqueue_urbs(usbh_ep_handle_t ep_hdl, urb_t **urbs, int num_urbs);
+
 /**
  * @brief Dequeue a URB from an endpoint
  *
@@ -1592,6 +1592,59 @@ err:
     return ret;
 }
 
+esp_err_t usb_host_transfer_submit_multi(usb_transfer_t **transfers, int num_transfers)
+{
+    HOST_CHECK(transfers != NULL && num_transfers > 0 && num_transfers <= USB_HOST_TRANSFER_SUBMIT_MULTI_MAX, ESP_ERR_INVALID_ARG);
+    HOST_CHECK(transfers[0] != NULL, ESP_ERR_INVALID_ARG);
+    usb_device_handle_t dev_hdl = transfers[0]->device_handle;
+    uint8_t bEndpointAddress = transfers[0]->bEndpointAddress;
+    // Check that transfers and target endpoint are valid
+    HOST_CHECK(dev_hdl != NULL, ESP_ERR_INVALID_ARG);   // Target device must be set
+    HOST_CHECK((bEndpointAddress & USB_B_ENDPOINT_ADDRESS_EP_NUM_MASK) != 0, ESP_ERR_INVALID_ARG);
+
+    urb_t *urbs[USB_HOST_TRANSFER_SUBMIT_MULTI_MAX];
+    for (int i = 0; i < num_transfers; i++) {
+        // All transfers must target the same endpoint
+        HOST_CHECK(transfers[i] != NULL
+                   && transfers[i]->device_handle == dev_hdl
+                   && transfers[i]->bEndpointAddress == bEndpointAddress, ESP_ERR_INVALID_ARG);
+        urbs[i] = __containerof(transfers[i], urb_t, transfer);
+        // Check that we are not submitting a transfer already in-flight
+        HOST_CHECK(!urbs[i]->usb_host_inflight, ESP_ERR_NOT_FINISHED);
+    }
+
+    usbh_ep_handle_t ep_hdl;
+    ep_wrapper_t *ep_wrap = NULL;
+    esp_err_t ret;
+
+    ret = usbh_ep_get_handle(dev_hdl, bEndpointAddress, &ep_hdl);
+    if (ret != ESP_OK) {
+        print_error_ep_get_handle(ret);
+        return ret;
+    }
+    ep_wrap = usbh_ep_get_context(ep_hdl);
+    assert(ep_wrap != NULL);
+    for (int i = 0; i < num_transfers; i++) {
+        urbs[i]->usb_host_inflight = true;
+    }
+    HOST_ENTER_CRITICAL();
+    ep_wrap->dynamic.num_urb_inflight += num_transfers;
+    HOST_EXIT_CRITICAL();
+
+    ret = usbh_ep_enqueue_urbs(ep_hdl, urbs, num_transfers);
+    if (ret != ESP_OK) {
+        ESP_LOGE(USB_HOST_TAG, "Enqueue URBs error: %s", esp_err_to_name(ret));
+        // None of the URBs were enqueued
+        HOST_ENTER_CRITICAL();
+        ep_wrap->dynamic.num_urb_inflight -= num_transfers;
+        HOST_EXIT_CRITICAL();
+        for (int i = 0; i < num_transfers; i++) {
+            urbs[i]->usb_host_inflight = false;
+        }
+    }
+    return ret;
+}
+
 esp_err_t usb_host_transfer_submit_control(usb_host_client_handle_t client_hdl, usb_transfer_t *transfer)
 {
     HOST_CHECK(client_hdl != NULL && transfer != NULL, ESP_ERR_INVALID_ARG);
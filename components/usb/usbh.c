@@ -1552,22 +1552,30 @@ hcd_err:
 
 esp_err_t usbh_ep_enqueue_urb(usbh_ep_handle_t ep_hdl, urb_t *urb)
 {
-    USBH_CHECK(ep_hdl != NULL && urb != NULL, ESP_ERR_INVALID_ARG);
-    USBH_CHECK(urb_check_args(urb), ESP_ERR_INVALID_ARG);
+    USBH_CHECK(urb != NULL, ESP_ERR_INVALID_ARG);
+    return usbh_ep_enqueue_urbs(ep_hdl, &urb, 1);
+}
+
+esp_err_t usbh_ep_enqueue_urbs(usbh_ep_handle_t ep_hdl, urb_t **urbs, int num_urbs)
+{
+    USBH_CHECK(ep_hdl != NULL && urbs != NULL && num_urbs > 0, ESP_ERR_INVALID_ARG);
 
     endpoint_t *ep_obj = (endpoint_t *)ep_hdl;
 
-    USBH_CHECK(transfer_check_usb_compliance(&(urb->transfer),
-                                             USB_EP_DESC_GET_XFERTYPE(ep_obj->constant.ep_desc),
-                                             USB_EP_DESC_GET_MPS(ep_obj->constant.ep_desc),
-                                             USB_EP_DESC_GET_EP_DIR(ep_obj->constant.ep_desc)),
-               ESP_ERR_INVALID_ARG);
-    // Check that the EP's underlying pipe is in the active state before submitting the URB
+    for (int i = 0; i < num_urbs; i++) {
+        USBH_CHECK(urbs[i] != NULL && urb_check_args(urbs[i]), ESP_ERR_INVALID_ARG);
+        USBH_CHECK(transfer_check_usb_compliance(&(urbs[i]->transfer),
+                                                 USB_EP_DESC_GET_XFERTYPE(ep_obj->constant.ep_desc),
+                                                 USB_EP_DESC_GET_MPS(ep_obj->constant.ep_desc),
+                                                 USB_EP_DESC_GET_EP_DIR(ep_obj->constant.ep_desc)),
+                   ESP_ERR_INVALID_ARG);
+    }
+    // Check that the EP's underlying pipe is in the active state before submitting the URBs
     if (hcd_pipe_get_state(ep_obj->constant.pipe_hdl) != HCD_PIPE_STATE_ACTIVE) {
         return ESP_ERR_INVALID_STATE;
     }
-    // Enqueue the URB to the EP's underlying pipe
-    return hcd_urb_enqueue(ep_obj->constant.pipe_hdl, urb);
+    // Enqueue the URBs to the EP's underlying pipe
+    return hcd_urb_enqueue_multi(ep_obj->constant.pipe_hdl, urbs, num_urbs);
 }
 
 esp_err_t usbh_ep_dequeue_urb(usbh_ep_handle_t ep_hdl, urb_t **urb_ret)
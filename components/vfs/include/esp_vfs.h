@@ -21,6 +21,7 @@
 #include <sys/time.h>
 #include <sys/termios.h>
 #include <sys/poll.h>
+#include <sys/uio.h>
 #ifdef __clang__ // TODO LLVM-330
 #include <sys/dirent.h>
 #else
@@ -121,6 +122,22 @@ typedef struct
         ssize_t (*pwrite_p)(void *ctx, int fd, const void *src, size_t size, off_t offset);          /*!< pwrite with context pointer */
         ssize_t (*pwrite)(int fd, const void *src, size_t size, off_t offset);                       /*!< pwrite without context pointer */
     };
+    union {
+        ssize_t (*writev_p)(void *ctx, int fd, const struct iovec *iov, int iovcnt);                 /*!< writev with context pointer */
+        ssize_t (*writev)(int fd, const struct iovec *iov, int iovcnt);                              /*!< writev without context pointer */
+    };
+    union {
+        ssize_t (*readv_p)(void *ctx, int fd, const struct iovec *iov, int iovcnt);                  /*!< readv with context pointer */
+        ssize_t (*readv)(int fd, const struct iovec *iov, int iovcnt);                               /*!< readv without context pointer */
+    };
+    union {
+        ssize_t (*pwritev_p)(void *ctx, int fd, const struct iovec *iov, int iovcnt, off_t offset);  /*!< pwritev with context pointer */
+        ssize_t (*pwritev)(int fd, const struct iovec *iov, int iovcnt, off_t offset);               /*!< pwritev without context pointer */
+    };
+    union {
+        ssize_t (*preadv_p)(void *ctx, int fd, const struct iovec *iov, int iovcnt, off_t offset);   /*!< preadv with context pointer */
+        ssize_t (*preadv)(int fd, const struct iovec *iov, int iovcnt, off_t offset);                /*!< preadv without context pointer */
+    };
     union {
         int (*open_p)(void* ctx, const char * path, int flags, int mode);                            /*!< open with context pointer */
         int (*open)(const char * path, int flags, int mode);                                         /*!< open without context pointer */
@@ -473,6 +490,68 @@ ssize_t esp_vfs_pread(int fd, void *dst, size_t size, off_t offset);
  */
 ssize_t esp_vfs_pwrite(int fd, const void *src, size_t size, off_t offset);
 
+/**
+ *
+ * @brief Implements the VFS layer of POSIX writev()
+ *
+ * If the VFS driver does not implement writev, the buffers are written one by one with write().
+ *
+ * @param fd         File descriptor used for write
+ * @param iov        Array of buffers to write
+ * @param iovcnt     Number of elements of iov
+ *
+ * @return           A positive return value indicates the number of bytes written. -1 is return on failure and errno is
+ *                   set accordingly.
+ */
+ssize_t esp_vfs_writev(int fd, const struct iovec *iov, int iovcnt);
+
+/**
+ *
+ * @brief Implements the VFS layer of POSIX readv()
+ *
+ * If the VFS driver does not implement readv, the buffers are filled one by one with read().
+ *
+ * @param fd         File descriptor used for read
+ * @param iov        Array of buffers to fill
+ * @param iovcnt     Number of elements of iov
+ *
+ * @return           A positive return value indicates the number of bytes read. -1 is return on failure and errno is
+ *                   set accordingly.
+ */
+ssize_t esp_vfs_readv(int fd, const struct iovec *iov, int iovcnt);
+
+/**
+ *
+ * @brief Implements the VFS layer of pwritev()
+ *
+ * If the VFS driver does not implement pwritev, the buffers are written one by one with pwrite().
+ *
+ * @param fd         File descriptor used for write
+ * @param iov        Array of buffers to write
+ * @param iovcnt     Number of elements of iov
+ * @param offset     Starting offset of the write
+ *
+ * @return           A positive return value indicates the number of bytes written. -1 is return on failure and errno is
+ *                   set accordingly.
+ */
+ssize_t esp_vfs_pwritev(int fd, const struct iovec *iov, int iovcnt, off_t offset);
+
+/**
+ *
+ * @brief Implements the VFS layer of preadv()
+ *
+ * If the VFS driver does not implement preadv, the buffers are filled one by one with pread().
+ *
+ * @param fd         File descriptor used for read
+ * @param iov        Array of buffers to fill
+ * @param iovcnt     Number of elements of iov
+ * @param offset     Starting offset of the read
+ *
+ * @return           A positive return value indicates the number of bytes read. -1 is return on failure and errno is
+ *                   set accordingly.
+ */
+ssize_t esp_vfs_preadv(int fd, const struct iovec *iov, int iovcnt, off_t offset);
+
 /**
  *
  * @brief Dump the existing VFS FDs data to FILE* fp
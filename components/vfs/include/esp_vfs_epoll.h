@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_VFS_EPOLLIN     (1 << 0)    /*!< The FD is ready for reading */
+#define ESP_VFS_EPOLLOUT    (1 << 1)    /*!< The FD is ready for writing */
+#define ESP_VFS_EPOLLERR    (1 << 2)    /*!< An exceptional condition is pending on the FD */
+
+/**
+ * @brief Operations of esp_vfs_epoll_ctl()
+ */
+typedef enum {
+    ESP_VFS_EPOLL_CTL_ADD,      /*!< Add a FD to the interest list */
+    ESP_VFS_EPOLL_CTL_MOD,      /*!< Change the events and the user data of a FD in the interest list */
+    ESP_VFS_EPOLL_CTL_DEL,      /*!< Remove a FD from the interest list */
+} esp_vfs_epoll_op_t;
+
+/**
+ * @brief Events of interest of a FD, or events ready on a FD
+ */
+typedef struct {
+    uint32_t events;            /*!< Bit mask of ESP_VFS_EPOLLIN, ESP_VFS_EPOLLOUT and ESP_VFS_EPOLLERR */
+    int fd;                     /*!< FD the events are ready on, set by esp_vfs_epoll_wait() */
+    void *data;                 /*!< User data given to esp_vfs_epoll_ctl(), returned by esp_vfs_epoll_wait() */
+} esp_vfs_epoll_event_t;
+
+/**
+ * @brief Handle of an epoll instance
+ */
+typedef struct esp_vfs_epoll *esp_vfs_epoll_handle_t;
+
+/**
+ * @brief Create an epoll instance
+ *
+ * An epoll instance keeps an interest list of FDs across calls of esp_vfs_epoll_wait().
+ * The FDs of the interest list are split per VFS driver when they are added, so waiting
+ * only needs to hand the prepared sets to the drivers. This provides the functionality
+ * of esp_vfs_select() with less work per call when the same FDs are waited for
+ * repeatedly, e.g. in an event loop.
+ *
+ * @param[out] out_handle handle of the new instance
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if out_handle is NULL
+ *      - ESP_ERR_NO_MEM if out of memory
+ */
+esp_err_t esp_vfs_epoll_create(esp_vfs_epoll_handle_t *out_handle);
+
+/**
+ * @brief Delete an epoll instance
+ *
+ * The FDs of the interest list are not closed.
+ *
+ * @param handle handle of the instance, must not be waited on
+ */
+void esp_vfs_epoll_delete(esp_vfs_epoll_handle_t handle);
+
+/**
+ * @brief Add, modify or remove a FD of the interest list
+ *
+ * A FD has to be removed from the interest list before it is closed.
+ *
+ * @param handle handle of the instance
+ * @param op operation
+ * @param fd file descriptor
+ * @param event events of interest and user data of the FD, ignored for ESP_VFS_EPOLL_CTL_DEL
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is invalid, or the FD is not open
+ *      - ESP_ERR_INVALID_STATE if the FD is already in the interest list (ESP_VFS_EPOLL_CTL_ADD)
+ *      - ESP_ERR_NOT_FOUND if the FD is not in the interest list (ESP_VFS_EPOLL_CTL_MOD, ESP_VFS_EPOLL_CTL_DEL)
+ *      - ESP_ERR_NOT_SUPPORTED if the VFS driver of the FD does not support select
+ */
+esp_err_t esp_vfs_epoll_ctl(esp_vfs_epoll_handle_t handle, esp_vfs_epoll_op_t op, int fd, const esp_vfs_epoll_event_t *event);
+
+/**
+ * @brief Wait for events on the FDs of the interest list
+ *
+ * The events are level-triggered, as with select(). Only one task may wait on an instance at a time,
+ * and the interest list must not be modified during the wait.
+ *
+ * @param handle handle of the instance
+ * @param[out] events array filled with the ready FDs and their events
+ * @param max_events number of elements of events, greater than zero
+ * @param timeout_ms timeout in milliseconds, -1 to wait forever
+ *
+ * @return number of ready FDs stored in events, 0 on timeout, -1 on error with errno set
+ */
+int esp_vfs_epoll_wait(esp_vfs_epoll_handle_t handle, esp_vfs_epoll_event_t *events, int max_events, int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -72,6 +72,18 @@ const vfs_entry_t *get_vfs_for_path(const char *path);
  */
 const vfs_entry_t *get_vfs_for_index(int index);
 
+/**
+ * Get the VFS and the local FD a global FD is mapped to.
+ *
+ * @param fd global file descriptor
+ * @param[out] out_vfs_index VFS index of the FD
+ * @param[out] out_local_fd FD within the VFS
+ * @param[out] out_is_socket true if the FD is a permanent FD of the socket VFS
+ *
+ * @return true if the FD is in use, false otherwise.
+ */
+bool get_vfs_fd_info(int fd, int *out_vfs_index, int *out_local_fd, bool *out_is_socket);
+
 #ifdef __cplusplus
 }
 #endif
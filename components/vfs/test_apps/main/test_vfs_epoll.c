@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <unistd.h>
+#include "unity.h"
+#include "esp_vfs.h"
+#include "esp_vfs_epoll.h"
+#include "esp_vfs_eventfd.h"
+
+TEST_CASE("epoll reports ready eventfds", "[vfs][epoll]")
+{
+    esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    TEST_ESP_OK(esp_vfs_eventfd_register(&config));
+    int fd1 = eventfd(0, 0);
+    int fd2 = eventfd(0, 0);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd1);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd2);
+
+    esp_vfs_epoll_handle_t epoll;
+    TEST_ESP_OK(esp_vfs_epoll_create(&epoll));
+    esp_vfs_epoll_event_t event = {
+        .events = ESP_VFS_EPOLLIN,
+        .data = &fd1,
+    };
+    TEST_ESP_OK(esp_vfs_epoll_ctl(epoll, ESP_VFS_EPOLL_CTL_ADD, fd1, &event));
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_vfs_epoll_ctl(epoll, ESP_VFS_EPOLL_CTL_ADD, fd1, &event));
+    TEST_ESP_ERR(ESP_ERR_NOT_FOUND, esp_vfs_epoll_ctl(epoll, ESP_VFS_EPOLL_CTL_MOD, fd2, &event));
+    event.data = &fd2;
+    TEST_ESP_OK(esp_vfs_epoll_ctl(epoll, ESP_VFS_EPOLL_CTL_ADD, fd2, &event));
+
+    esp_vfs_epoll_event_t ready[2];
+    TEST_ASSERT_EQUAL(0, esp_vfs_epoll_wait(epoll, ready, 2, 10));
+
+    // The interest list is kept across the calls, and the events are level-triggered
+    uint64_t val = 1;
+    TEST_ASSERT_EQUAL(sizeof(val), write(fd2, &val, sizeof(val)));
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(1, esp_vfs_epoll_wait(epoll, ready, 2, 10));
+        TEST_ASSERT_EQUAL(fd2, ready[0].fd);
+        TEST_ASSERT_EQUAL(ESP_VFS_EPOLLIN, ready[0].events);
+        TEST_ASSERT_EQUAL_PTR(&fd2, ready[0].data);
+    }
+
+    TEST_ASSERT_EQUAL(sizeof(val), write(fd1, &val, sizeof(val)));
+    TEST_ASSERT_EQUAL(2, esp_vfs_epoll_wait(epoll, ready, 2, -1));
+    TEST_ASSERT_EQUAL(1, esp_vfs_epoll_wait(epoll, ready, 1, -1));
+
+    TEST_ESP_OK(esp_vfs_epoll_ctl(epoll, ESP_VFS_EPOLL_CTL_DEL, fd2, NULL));
+    TEST_ASSERT_EQUAL(1, esp_vfs_epoll_wait(epoll, ready, 2, 10));
+    TEST_ASSERT_EQUAL(fd1, ready[0].fd);
+    TEST_ASSERT_EQUAL(sizeof(val), read(fd1, &val, sizeof(val)));
+    TEST_ASSERT_EQUAL(0, esp_vfs_epoll_wait(epoll, ready, 2, 10));
+
+    TEST_ESP_OK(esp_vfs_epoll_ctl(epoll, ESP_VFS_EPOLL_CTL_DEL, fd1, NULL));
+    esp_vfs_epoll_delete(epoll);
+    TEST_ASSERT_EQUAL(0, close(fd1));
+    TEST_ASSERT_EQUAL(0, close(fd2));
+    TEST_ESP_OK(esp_vfs_eventfd_unregister());
+}
@@ -294,6 +294,34 @@ TEST_CASE("esp_vfs_register_fd_range checks for overlap", "[vfs]")
     TEST_ESP_ERR(ESP_ERR_INVALID_ARG, err);
 }
 
+static ssize_t unregister_test_vfs_write(int fd, const void *data, size_t size)
+{
+    return size;
+}
+
+TEST_CASE("esp_vfs_unregister_with_id releases all FDs of the VFS", "[vfs]")
+{
+    esp_vfs_t desc = {
+        .flags = ESP_VFS_FLAG_DEFAULT,
+        .write = unregister_test_vfs_write,
+    };
+    esp_vfs_id_t vfs_id;
+    TEST_ESP_OK(esp_vfs_register_with_id(&desc, NULL, &vfs_id));
+
+    int fds[CONFIG_VFS_MAX_COUNT + 2];
+    for (int i = 0; i < sizeof(fds) / sizeof(fds[0]); i++) {
+        TEST_ESP_OK(esp_vfs_register_fd(vfs_id, &fds[i]));
+        TEST_ASSERT_EQUAL(1, write(fds[i], "a", 1));
+    }
+
+    TEST_ESP_OK(esp_vfs_unregister_with_id(vfs_id));
+    for (int i = 0; i < sizeof(fds) / sizeof(fds[0]); i++) {
+        errno = 0;
+        TEST_ASSERT_EQUAL(-1, write(fds[i], "a", 1));
+        TEST_ASSERT_EQUAL(EBADF, errno);
+    }
+}
+
 static void socket_init(int *socket_fd)
 {
     const struct addrinfo hints = {
@@ -12,7 +12,6 @@
 #include <sys/ioctl.h>
 #include <sys/reent.h>
 #include <sys/unistd.h>
-#include <sys/lock.h>
 #include <sys/param.h>
 #include <dirent.h>
 #include "freertos/FreeRTOS.h"
@@ -44,7 +43,7 @@ static const char *TAG = "vfs";
 #endif
 
 #define LEN_PATH_PREFIX_IGNORED SIZE_MAX /* special length value for VFS which is never recognised by open() */
-#define FD_TABLE_ENTRY_UNUSED   (fd_table_t) { .permanent = false, .has_pending_close = false, .has_pending_select = false, .vfs_index = -1, .local_fd = -1 }
+#define FD_TABLE_ENTRY_UNUSED   (fd_table_t) { .permanent = false, .has_pending_close = false, .has_pending_select = false, .vfs_index = -1, .local_fd = -1, ._reserved2 = 0 }
 
 typedef uint8_t local_fd_t;
 _Static_assert((1 << (sizeof(local_fd_t)*8)) >= MAX_FDS, "file descriptor type too small");
@@ -53,14 +52,24 @@ typedef int8_t vfs_index_t;
 _Static_assert((1 << (sizeof(vfs_index_t)*8)) >= VFS_MAX_COUNT, "VFS index type too small");
 _Static_assert(((vfs_index_t) -1) < 0, "vfs_index_t must be a signed type");
 
-typedef struct {
-    bool permanent :1;
-    bool has_pending_close :1;
-    bool has_pending_select :1;
-    uint8_t _reserved :5;
-    vfs_index_t vfs_index;
-    local_fd_t local_fd;
+/*
+ * The entries of the FD table are read and written as a whole with 32-bit atomic operations, so there is no lock
+ * around the table. A free entry is claimed with a compare-and-swap, and entries are modified with compare-and-swap
+ * loops, so operations on different FDs never wait for each other and a reader always gets a consistent entry.
+ */
+typedef union {
+    struct {
+        bool permanent :1;
+        bool has_pending_close :1;
+        bool has_pending_select :1;
+        uint8_t _reserved :5;
+        vfs_index_t vfs_index;
+        local_fd_t local_fd;
+        uint8_t _reserved2;
+    };
+    uint32_t word;
 } fd_table_t;
+_Static_assert(sizeof(fd_table_t) == sizeof(uint32_t), "FD table entry must be accessible atomically");
 
 typedef struct {
     bool isset; // none or at least one bit is set in the following 3 fd sets
@@ -72,8 +81,75 @@ typedef struct {
 static vfs_entry_t* s_vfs[VFS_MAX_COUNT] = { 0 };
 static size_t s_vfs_count = 0;
 
+/* Entries registered with a path prefix, sorted by decreasing prefix length,
+ * so that the first entry matching a path has the longest matching prefix.
+ */
+static vfs_entry_t* s_vfs_by_prefix[VFS_MAX_COUNT] = { 0 };
+static size_t s_vfs_by_prefix_count = 0;
+
 static fd_table_t s_fd_table[MAX_FDS] = { [0 ... MAX_FDS-1] = FD_TABLE_ENTRY_UNUSED };
-static _lock_t s_fd_table_lock;
+
+static inline fd_table_t fd_table_get(int fd)
+{
+    return (fd_table_t) { .word = __atomic_load_n(&s_fd_table[fd].word, __ATOMIC_ACQUIRE) };
+}
+
+/* Replaces the entry if it still equals *expected, otherwise updates *expected with the current entry */
+static inline bool fd_table_replace(int fd, fd_table_t *expected, fd_table_t desired)
+{
+    return __atomic_compare_exchange_n(&s_fd_table[fd].word, &expected->word, desired.word,
+                                       false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+/* Claims the entry if it is free */
+static bool fd_table_claim(int fd, fd_table_t desired)
+{
+    fd_table_t entry = fd_table_get(fd);
+    while (entry.vfs_index == -1) {
+        if (fd_table_replace(fd, &entry, desired)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Frees the entry if it belongs to the VFS vfs_index */
+static void fd_table_release_if_owned(int fd, int vfs_index)
+{
+    fd_table_t entry = fd_table_get(fd);
+    while (entry.vfs_index == vfs_index) {
+        if (fd_table_replace(fd, &entry, FD_TABLE_ENTRY_UNUSED)) {
+            return;
+        }
+    }
+}
+
+static void prefix_table_insert(vfs_entry_t* entry)
+{
+    size_t i = s_vfs_by_prefix_count;
+    // entries with the same prefix length stay in the order of registration
+    while (i > 0 && s_vfs_by_prefix[i - 1]->path_prefix_len < entry->path_prefix_len) {
+        s_vfs_by_prefix[i] = s_vfs_by_prefix[i - 1];
+        --i;
+    }
+    s_vfs_by_prefix[i] = entry;
+    ++s_vfs_by_prefix_count;
+}
+
+static void prefix_table_remove(const vfs_entry_t* entry)
+{
+    size_t i = 0;
+    while (i < s_vfs_by_prefix_count && s_vfs_by_prefix[i] != entry) {
+        ++i;
+    }
+    if (i == s_vfs_by_prefix_count) {
+        return;
+    }
+    for (; i + 1 < s_vfs_by_prefix_count; ++i) {
+        s_vfs_by_prefix[i] = s_vfs_by_prefix[i + 1];
+    }
+    s_vfs_by_prefix[--s_vfs_by_prefix_count] = NULL;
+}
 
 esp_err_t esp_vfs_register_common(const char* base_path, size_t len, const esp_vfs_t* vfs, void* ctx, int *vfs_index)
 {
@@ -114,6 +190,9 @@ esp_err_t esp_vfs_register_common(const char* base_path, size_t len, const esp_v
     entry->path_prefix_len = len;
     entry->ctx = ctx;
     entry->offset = index;
+    if (len != LEN_PATH_PREFIX_IGNORED) {
+        prefix_table_insert(entry);
+    }
 
     if (vfs_index) {
         *vfs_index = index;
@@ -138,25 +217,21 @@ esp_err_t esp_vfs_register_fd_range(const esp_vfs_t *vfs, void *ctx, int min_fd,
     esp_err_t ret = esp_vfs_register_common("", LEN_PATH_PREFIX_IGNORED, vfs, ctx, &index);
 
     if (ret == ESP_OK) {
-        _lock_acquire(&s_fd_table_lock);
         for (int i = min_fd; i < max_fd; ++i) {
-            if (s_fd_table[i].vfs_index != -1) {
-                free(s_vfs[index]);
-                s_vfs[index] = NULL;
+            fd_table_t entry = FD_TABLE_ENTRY_UNUSED;
+            entry.permanent = true;
+            entry.vfs_index = index;
+            entry.local_fd = i;
+            if (!fd_table_claim(i, entry)) {
                 for (int j = min_fd; j < i; ++j) {
-                    if (s_fd_table[j].vfs_index == index) {
-                        s_fd_table[j] = FD_TABLE_ENTRY_UNUSED;
-                    }
+                    fd_table_release_if_owned(j, index);
                 }
-                _lock_release(&s_fd_table_lock);
+                free(s_vfs[index]);
+                s_vfs[index] = NULL;
                 ESP_LOGD(TAG, "esp_vfs_register_fd_range cannot set fd %d (used by other VFS)", i);
                 return ESP_ERR_INVALID_ARG;
             }
-            s_fd_table[i].permanent = true;
-            s_fd_table[i].vfs_index = index;
-            s_fd_table[i].local_fd = i;
         }
-        _lock_release(&s_fd_table_lock);
 
         ESP_LOGW(TAG, "esp_vfs_register_fd_range is successful for range <%d; %d) and VFS ID %d", min_fd, max_fd, index);
     }
@@ -180,17 +255,14 @@ esp_err_t esp_vfs_unregister_with_id(esp_vfs_id_t vfs_id)
         return ESP_ERR_INVALID_ARG;
     }
     vfs_entry_t* vfs = s_vfs[vfs_id];
+    prefix_table_remove(vfs);
     free(vfs);
     s_vfs[vfs_id] = NULL;
 
-    _lock_acquire(&s_fd_table_lock);
     // Delete all references from the FD lookup-table
-    for (int j = 0; j < VFS_MAX_COUNT; ++j) {
-        if (s_fd_table[j].vfs_index == vfs_id) {
-            s_fd_table[j] = FD_TABLE_ENTRY_UNUSED;
-        }
+    for (int j = 0; j < MAX_FDS; ++j) {
+        fd_table_release_if_owned(j, vfs_id);
     }
-    _lock_release(&s_fd_table_lock);
 
     return ESP_OK;
 }
@@ -225,22 +297,17 @@ esp_err_t esp_vfs_register_fd_with_local_fd(esp_vfs_id_t vfs_id, int local_fd, b
     }
 
     esp_err_t ret = ESP_ERR_NO_MEM;
-    _lock_acquire(&s_fd_table_lock);
     for (int i = 0; i < MAX_FDS; ++i) {
-        if (s_fd_table[i].vfs_index == -1) {
-            s_fd_table[i].permanent = permanent;
-            s_fd_table[i].vfs_index = vfs_id;
-            if (local_fd >= 0) {
-                s_fd_table[i].local_fd = local_fd;
-            } else {
-                s_fd_table[i].local_fd = i;
-            }
+        fd_table_t entry = FD_TABLE_ENTRY_UNUSED;
+        entry.permanent = permanent;
+        entry.vfs_index = vfs_id;
+        entry.local_fd = (local_fd >= 0) ? local_fd : i;
+        if (fd_table_claim(i, entry)) {
             *fd = i;
             ret = ESP_OK;
             break;
         }
     }
-    _lock_release(&s_fd_table_lock);
 
     ESP_LOGD(TAG, "esp_vfs_register_fd_with_local_fd(%d, %d, %d, 0x%p) finished with %s",
              vfs_id, local_fd, permanent, fd, esp_err_to_name(ret));
@@ -257,13 +324,13 @@ esp_err_t esp_vfs_unregister_fd(esp_vfs_id_t vfs_id, int fd)
         return ret;
     }
 
-    _lock_acquire(&s_fd_table_lock);
-    fd_table_t *item = s_fd_table + fd;
-    if (item->permanent == true && item->vfs_index == vfs_id && item->local_fd == fd) {
-        *item = FD_TABLE_ENTRY_UNUSED;
-        ret = ESP_OK;
+    fd_table_t item = fd_table_get(fd);
+    while (item.permanent == true && item.vfs_index == vfs_id && item.local_fd == fd) {
+        if (fd_table_replace(fd, &item, FD_TABLE_ENTRY_UNUSED)) {
+            ret = ESP_OK;
+            break;
+        }
     }
-    _lock_release(&s_fd_table_lock);
 
     ESP_LOGD(TAG, "esp_vfs_unregister_fd(%d, %d) finished with %s", vfs_id, fd, esp_err_to_name(ret));
 
@@ -276,18 +343,17 @@ void esp_vfs_dump_fds(FILE *fp)
     fprintf(fp, "------------------------------------------------------\n");
     fprintf(fp, "<VFS Path Prefix>-<FD seen by App>-<FD seen by driver>\n");
     fprintf(fp, "------------------------------------------------------\n");
-    _lock_acquire(&s_fd_table_lock);
     for (int index = 0; index < MAX_FDS; index++) {
-        if (s_fd_table[index].vfs_index != -1) {
-            vfs = s_vfs[s_fd_table[index].vfs_index];
+        const fd_table_t entry = fd_table_get(index);
+        if (entry.vfs_index != -1) {
+            vfs = s_vfs[entry.vfs_index];
             if (strcmp(vfs->path_prefix, "")) {
-                fprintf(fp, "(%s) - 0x%x - 0x%x\n", vfs->path_prefix, index, s_fd_table[index].local_fd);
+                fprintf(fp, "(%s) - 0x%x - 0x%x\n", vfs->path_prefix, index, entry.local_fd);
             } else {
-                fprintf(fp, "(socket) - 0x%x - 0x%x\n", index, s_fd_table[index].local_fd);
+                fprintf(fp, "(socket) - 0x%x - 0x%x\n", index, entry.local_fd);
             }
         }
     }
-    _lock_release(&s_fd_table_lock);
 }
 
 /*
@@ -331,7 +397,7 @@ static const vfs_entry_t *get_vfs_for_fd(int fd)
 {
     const vfs_entry_t *vfs = NULL;
     if (fd_valid(fd)) {
-        const int index = s_fd_table[fd].vfs_index; // single read -> no locking is required
+        const int index = fd_table_get(fd).vfs_index;
         vfs = get_vfs_for_index(index);
     }
     return vfs;
@@ -342,16 +408,29 @@ static inline int get_local_fd(const vfs_entry_t *vfs, int fd)
     int local_fd = -1;
 
     if (vfs && fd_valid(fd)) {
-        local_fd = s_fd_table[fd].local_fd; // single read -> no locking is required
+        local_fd = fd_table_get(fd).local_fd;
     }
 
     return local_fd;
 }
 
+bool get_vfs_fd_info(int fd, int *out_vfs_index, int *out_local_fd, bool *out_is_socket)
+{
+    if (!fd_valid(fd)) {
+        return false;
+    }
+    const fd_table_t entry = fd_table_get(fd);
+    const int vfs_index = entry.vfs_index;
+    *out_vfs_index = vfs_index;
+    *out_local_fd = entry.local_fd;
+    *out_is_socket = entry.permanent;
+    return vfs_index >= 0;
+}
+
 static const char* translate_path(const vfs_entry_t* vfs, const char* src_path)
 {
     assert(strncmp(src_path, vfs->path_prefix, vfs->path_prefix_len) == 0);
-    if (strlen(src_path) == vfs->path_prefix_len) {
+    if (src_path[vfs->path_prefix_len] == '\0') {
         // special case when src_path matches the path prefix exactly
         return "/";
     }
@@ -360,42 +439,27 @@ static const char* translate_path(const vfs_entry_t* vfs, const char* src_path)
 
 const vfs_entry_t* get_vfs_for_path(const char* path)
 {
-    const vfs_entry_t* best_match = NULL;
-    ssize_t best_match_prefix_len = -1;
     size_t len = strlen(path);
-    for (size_t i = 0; i < s_vfs_count; ++i) {
-        const vfs_entry_t* vfs = s_vfs[i];
-        if (!vfs || vfs->path_prefix_len == LEN_PATH_PREFIX_IGNORED) {
-            continue;
-        }
+    // Entries are sorted by decreasing prefix length, so the first match is the
+    // longest one; i.e. if "/dev" and "/dev/uart" both match, for "/dev/uart/1"
+    // path, "/dev/uart" is checked first. The default VFS with an empty prefix
+    // comes last.
+    for (size_t i = 0; i < s_vfs_by_prefix_count; ++i) {
+        const vfs_entry_t* vfs = s_vfs_by_prefix[i];
         // match path prefix
         if (len < vfs->path_prefix_len ||
             memcmp(path, vfs->path_prefix, vfs->path_prefix_len) != 0) {
             continue;
         }
-        // this is the default VFS and we don't have a better match yet.
-        if (vfs->path_prefix_len == 0 && !best_match) {
-            best_match = vfs;
-            continue;
-        }
         // if path is not equal to the prefix, expect to see a path separator
         // i.e. don't match "/data" prefix for "/data1/foo.txt" path
-        if (len > vfs->path_prefix_len &&
+        if (vfs->path_prefix_len > 0 && len > vfs->path_prefix_len &&
                 path[vfs->path_prefix_len] != '/') {
             continue;
         }
-        // Out of all matching path prefixes, select the longest one;
-        // i.e. if "/dev" and "/dev/uart" both match, for "/dev/uart/1" path,
-        // choose "/dev/uart",
-        // This causes all s_vfs_count VFS entries to be scanned when opening
-        // a file by name. This can be optimized by introducing a table for
-        // FS search order, sorted so that longer prefixes are checked first.
-        if (best_match_prefix_len < (ssize_t) vfs->path_prefix_len) {
-            best_match_prefix_len = (ssize_t) vfs->path_prefix_len;
-            best_match = vfs;
-        }
+        return vfs;
     }
-    return best_match;
+    return NULL;
 }
 
 /*
@@ -469,17 +533,14 @@ int esp_vfs_open(struct _reent *r, const char * path, int flags, int mode)
     int fd_within_vfs;
     CHECK_AND_CALL(fd_within_vfs, r, vfs, open, path_within_vfs, flags, mode);
     if (fd_within_vfs >= 0) {
-        _lock_acquire(&s_fd_table_lock);
+        fd_table_t entry = FD_TABLE_ENTRY_UNUSED;
+        entry.vfs_index = vfs->offset;
+        entry.local_fd = fd_within_vfs;
         for (int i = 0; i < MAX_FDS; ++i) {
-            if (s_fd_table[i].vfs_index == -1) {
-                s_fd_table[i].permanent = false;
-                s_fd_table[i].vfs_index = vfs->offset;
-                s_fd_table[i].local_fd = fd_within_vfs;
-                _lock_release(&s_fd_table_lock);
+            if (fd_table_claim(i, entry)) {
                 return i;
             }
         }
-        _lock_release(&s_fd_table_lock);
         int ret;
         CHECK_AND_CALL(ret, r, vfs, close, fd_within_vfs);
         (void) ret; // remove "set but not used" warning
@@ -557,6 +618,107 @@ ssize_t esp_vfs_pwrite(int fd, const void *src, size_t size, off_t offset)
     return ret;
 }
 
+/* Number of bytes transferred by a generic vectored I/O loop: the result of the first transfer if it
+ * failed, otherwise the sum of the transfers up to and including the first short one */
+#define VECTORED_IO_FALLBACK(total, iov, iovcnt, transfer) \
+    total = 0; \
+    for (int i = 0; i < iovcnt; ++i) { \
+        ssize_t n = (transfer); \
+        if (n < 0) { \
+            if (total == 0) { \
+                total = -1; \
+            } \
+            break; \
+        } \
+        total += n; \
+        if ((size_t) n < iov[i].iov_len) { \
+            break; \
+        } \
+    }
+
+static const vfs_entry_t *get_vfs_for_iov(struct _reent *r, int fd, const struct iovec *iov, int iovcnt, int *local_fd)
+{
+    const vfs_entry_t* vfs = get_vfs_for_fd(fd);
+    *local_fd = get_local_fd(vfs, fd);
+    if (vfs == NULL || *local_fd < 0) {
+        __errno_r(r) = EBADF;
+        return NULL;
+    }
+    if (iovcnt < 0 || (iovcnt > 0 && iov == NULL)) {
+        __errno_r(r) = EINVAL;
+        return NULL;
+    }
+    return vfs;
+}
+
+ssize_t esp_vfs_writev(int fd, const struct iovec *iov, int iovcnt)
+{
+    struct _reent *r = __getreent();
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_iov(r, fd, iov, iovcnt, &local_fd);
+    if (vfs == NULL) {
+        return -1;
+    }
+    ssize_t ret;
+    if (vfs->vfs.writev) {
+        CHECK_AND_CALL(ret, r, vfs, writev, local_fd, iov, iovcnt);
+        return ret;
+    }
+    VECTORED_IO_FALLBACK(ret, iov, iovcnt, esp_vfs_write(r, fd, iov[i].iov_base, iov[i].iov_len));
+    return ret;
+}
+
+ssize_t esp_vfs_readv(int fd, const struct iovec *iov, int iovcnt)
+{
+    struct _reent *r = __getreent();
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_iov(r, fd, iov, iovcnt, &local_fd);
+    if (vfs == NULL) {
+        return -1;
+    }
+    ssize_t ret;
+    if (vfs->vfs.readv) {
+        CHECK_AND_CALL(ret, r, vfs, readv, local_fd, iov, iovcnt);
+        return ret;
+    }
+    VECTORED_IO_FALLBACK(ret, iov, iovcnt, esp_vfs_read(r, fd, iov[i].iov_base, iov[i].iov_len));
+    return ret;
+}
+
+ssize_t esp_vfs_pwritev(int fd, const struct iovec *iov, int iovcnt, off_t offset)
+{
+    struct _reent *r = __getreent();
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_iov(r, fd, iov, iovcnt, &local_fd);
+    if (vfs == NULL) {
+        return -1;
+    }
+    ssize_t ret;
+    if (vfs->vfs.pwritev) {
+        CHECK_AND_CALL(ret, r, vfs, pwritev, local_fd, iov, iovcnt, offset);
+        return ret;
+    }
+    VECTORED_IO_FALLBACK(ret, iov, iovcnt, esp_vfs_pwrite(fd, iov[i].iov_base, iov[i].iov_len, offset + total));
+    return ret;
+}
+
+ssize_t esp_vfs_preadv(int fd, const struct iovec *iov, int iovcnt, off_t offset)
+{
+    struct _reent *r = __getreent();
+    int local_fd;
+    const vfs_entry_t* vfs = get_vfs_for_iov(r, fd, iov, iovcnt, &local_fd);
+    if (vfs == NULL) {
+        return -1;
+    }
+    ssize_t ret;
+    if (vfs->vfs.preadv) {
+        CHECK_AND_CALL(ret, r, vfs, preadv, local_fd, iov, iovcnt, offset);
+        return ret;
+    }
+    VECTORED_IO_FALLBACK(ret, iov, iovcnt, esp_vfs_pread(fd, iov[i].iov_base, iov[i].iov_len, offset + total));
+    return ret;
+}
+
 int esp_vfs_close(struct _reent *r, int fd)
 {
     const vfs_entry_t* vfs = get_vfs_for_fd(fd);
@@ -568,15 +730,18 @@ int esp_vfs_close(struct _reent *r, int fd)
     int ret;
     CHECK_AND_CALL(ret, r, vfs, close, local_fd);
 
-    _lock_acquire(&s_fd_table_lock);
-    if (!s_fd_table[fd].permanent) {
-        if (s_fd_table[fd].has_pending_select) {
-            s_fd_table[fd].has_pending_close = true;
+    fd_table_t entry = fd_table_get(fd);
+    while (!entry.permanent) {
+        fd_table_t closed = entry;
+        if (entry.has_pending_select) {
+            closed.has_pending_close = true;
         } else {
-            s_fd_table[fd] = FD_TABLE_ENTRY_UNUSED;
+            closed = FD_TABLE_ENTRY_UNUSED;
+        }
+        if (fd_table_replace(fd, &entry, closed)) {
+            break;
         }
     }
-    _lock_release(&s_fd_table_lock);
     return ret;
 }
 
@@ -927,8 +1092,9 @@ static int set_global_fd_sets(const fds_triple_t *vfs_fds_triple, int size, fd_s
         const fds_triple_t *item = &vfs_fds_triple[i];
         if (item->isset) {
             for (int fd = 0; fd < MAX_FDS; ++fd) {
-                if (s_fd_table[fd].vfs_index == i) {
-                    const int local_fd = s_fd_table[fd].local_fd; // single read -> no locking is required
+                const fd_table_t entry = fd_table_get(fd);
+                if (entry.vfs_index == i) {
+                    const int local_fd = entry.local_fd;
                     if (readfds && esp_vfs_safe_fd_isset(local_fd, &item->readfds)) {
                         ESP_LOGD(TAG, "FD %d in readfds was set from VFS ID %d", fd, i);
                         FD_SET(fd, readfds);
@@ -1003,14 +1169,20 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
 
     int (*socket_select)(int, fd_set *, fd_set *, fd_set *, struct timeval *) = NULL;
     for (int fd = 0; fd < nfds; ++fd) {
-        _lock_acquire(&s_fd_table_lock);
-        const bool is_socket_fd = s_fd_table[fd].permanent;
-        const int vfs_index = s_fd_table[fd].vfs_index;
-        const int local_fd = s_fd_table[fd].local_fd;
+        fd_table_t entry = fd_table_get(fd);
         if (esp_vfs_safe_fd_isset(fd, errorfds)) {
-            s_fd_table[fd].has_pending_select = true;
+            while (!entry.has_pending_select) {
+                fd_table_t selected = entry;
+                selected.has_pending_select = true;
+                if (fd_table_replace(fd, &entry, selected)) {
+                    entry = selected;
+                    break;
+                }
+            }
         }
-        _lock_release(&s_fd_table_lock);
+        const bool is_socket_fd = entry.permanent;
+        const int vfs_index = entry.vfs_index;
+        const int local_fd = entry.local_fd;
 
         if (vfs_index < 0) {
             continue;
@@ -1164,13 +1336,14 @@ int esp_vfs_select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds
         }
         sel_sem.sem = NULL;
     }
-    _lock_acquire(&s_fd_table_lock);
     for (int fd = 0; fd < nfds; ++fd) {
-        if (s_fd_table[fd].has_pending_close) {
-            s_fd_table[fd] = FD_TABLE_ENTRY_UNUSED;
+        fd_table_t entry = fd_table_get(fd);
+        while (entry.has_pending_close) {
+            if (fd_table_replace(fd, &entry, FD_TABLE_ENTRY_UNUSED)) {
+                break;
+            }
         }
     }
-    _lock_release(&s_fd_table_lock);
     free(vfs_fds_triple);
     free(driver_args);
 
@@ -1187,8 +1360,8 @@ void esp_vfs_select_triggered(esp_vfs_select_sem_t sem)
         xSemaphoreGive(sem.sem);
     } else {
         // Another way would be to go through s_fd_table and find the VFS
-        // which has a permanent FD. But in order to avoid to lock
-        // s_fd_table_lock we go through the VFS table.
+        // which has a permanent FD. But the VFS table is much shorter, so we
+        // go through the VFS table.
         for (int i = 0; i < s_vfs_count; ++i) {
             // Note: s_vfs_count could have changed since the start of vfs_select() call. However, that change doesn't
             // matter here stop_socket_select() will be called for only valid VFS drivers.
@@ -1207,8 +1380,8 @@ void esp_vfs_select_triggered_isr(esp_vfs_select_sem_t sem, BaseType_t *woken)
         xSemaphoreGiveFromISR(sem.sem, woken);
     } else {
         // Another way would be to go through s_fd_table and find the VFS
-        // which has a permanent FD. But in order to avoid to lock
-        // s_fd_table_lock we go through the VFS table.
+        // which has a permanent FD. But the VFS table is much shorter, so we
+        // go through the VFS table.
         for (int i = 0; i < s_vfs_count; ++i) {
             // Note: s_vfs_count could have changed since the start of vfs_select() call. However, that change doesn't
             // matter here stop_socket_select() will be called for only valid VFS drivers.
@@ -1345,6 +1518,14 @@ ssize_t pread(int fd, void *dst, size_t size, off_t offset)
     __attribute__((alias("esp_vfs_pread")));
 ssize_t pwrite(int fd, const void *src, size_t size, off_t offset)
     __attribute__((alias("esp_vfs_pwrite")));
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
+    __attribute__((alias("esp_vfs_writev")));
+ssize_t readv(int fd, const struct iovec *iov, int iovcnt)
+    __attribute__((alias("esp_vfs_readv")));
+ssize_t pwritev(int fd, const struct iovec *iov, int iovcnt, off_t offset)
+    __attribute__((alias("esp_vfs_pwritev")));
+ssize_t preadv(int fd, const struct iovec *iov, int iovcnt, off_t offset)
+    __attribute__((alias("esp_vfs_preadv")));
 off_t _lseek_r(struct _reent *r, int fd, off_t size, int mode)
     __attribute__((alias("esp_vfs_lseek")));
 int _fcntl_r(struct _reent *r, int fd, int cmd, int arg)
@@ -0,0 +1,297 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_vfs.h"
+#include "esp_vfs_epoll.h"
+#include "esp_vfs_private.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_VFS_SUPPRESS_SELECT_DEBUG_OUTPUT
+#define LOG_LOCAL_LEVEL ESP_LOG_NONE
+#endif //CONFIG_VFS_SUPPRESS_SELECT_DEBUG_OUTPUT
+#include "esp_log.h"
+
+#ifdef CONFIG_VFS_SUPPORT_SELECT
+
+static const char *TAG = "vfs_epoll";
+
+#define VFS_MAX_COUNT  CONFIG_VFS_MAX_COUNT
+
+typedef struct {
+    bool isset;
+    fd_set readfds;
+    fd_set writefds;
+    fd_set errorfds;
+} epoll_fds_t;
+
+typedef struct {
+    int vfs_index;          // -1 if the FD is not in the interest list
+    int local_fd;
+    bool is_socket;
+    uint32_t events;
+    void *data;
+} epoll_item_t;
+
+struct esp_vfs_epoll {
+    epoll_item_t items[MAX_FDS];            // interest list, indexed by the global FD
+    int nfds;                               // highest FD of the interest list plus one
+    size_t vfs_fd_count[VFS_MAX_COUNT];     // number of FDs of the interest list for each VFS
+    epoll_fds_t vfs_fds[VFS_MAX_COUNT];     // sets of local FDs for each non-socket VFS
+    epoll_fds_t socket_fds;                 // sets of global FDs for the socket VFS
+    int socket_vfs_index;                   // -1 if there is no socket in the interest list
+    // State of a call of esp_vfs_epoll_wait
+    epoll_fds_t vfs_fds_ready[VFS_MAX_COUNT];
+    epoll_fds_t socket_fds_ready;
+    void *driver_args[VFS_MAX_COUNT];
+    SemaphoreHandle_t sem;
+};
+
+esp_err_t esp_vfs_epoll_create(esp_vfs_epoll_handle_t *out_handle)
+{
+    if (out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_vfs_epoll_handle_t handle = heap_caps_calloc(1, sizeof(struct esp_vfs_epoll), VFS_MALLOC_FLAGS);
+    if (handle == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    handle->sem = xSemaphoreCreateBinary();
+    if (handle->sem == NULL) {
+        free(handle);
+        return ESP_ERR_NO_MEM;
+    }
+    for (int fd = 0; fd < MAX_FDS; ++fd) {
+        handle->items[fd].vfs_index = -1;
+    }
+    handle->socket_vfs_index = -1;
+    *out_handle = handle;
+    return ESP_OK;
+}
+
+void esp_vfs_epoll_delete(esp_vfs_epoll_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    vSemaphoreDelete(handle->sem);
+    free(handle);
+}
+
+static inline void update_fd_set(int fd, fd_set *fds, bool set)
+{
+    if (set) {
+        FD_SET(fd, fds);
+    } else {
+        FD_CLR(fd, fds);
+    }
+}
+
+static void set_item_events(esp_vfs_epoll_handle_t handle, int fd, uint32_t events)
+{
+    epoll_item_t *item = &handle->items[fd];
+    // Sockets are handled by socket_select() which takes global FDs, other drivers take local FDs
+    epoll_fds_t *fds = item->is_socket ? &handle->socket_fds : &handle->vfs_fds[item->vfs_index];
+    const int set_fd = item->is_socket ? fd : item->local_fd;
+
+    update_fd_set(set_fd, &fds->readfds, events & ESP_VFS_EPOLLIN);
+    update_fd_set(set_fd, &fds->writefds, events & ESP_VFS_EPOLLOUT);
+    update_fd_set(set_fd, &fds->errorfds, events & ESP_VFS_EPOLLERR);
+    fds->isset = handle->vfs_fd_count[item->vfs_index] > 0;
+    item->events = events;
+}
+
+esp_err_t esp_vfs_epoll_ctl(esp_vfs_epoll_handle_t handle, esp_vfs_epoll_op_t op, int fd, const esp_vfs_epoll_event_t *event)
+{
+    if (handle == NULL || fd < 0 || fd >= MAX_FDS || (op != ESP_VFS_EPOLL_CTL_DEL && event == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    epoll_item_t *item = &handle->items[fd];
+
+    switch (op) {
+    case ESP_VFS_EPOLL_CTL_ADD: {
+        if (item->vfs_index >= 0) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        int vfs_index;
+        int local_fd;
+        bool is_socket;
+        if (!get_vfs_fd_info(fd, &vfs_index, &local_fd, &is_socket)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        const vfs_entry_t *vfs = get_vfs_for_index(vfs_index);
+        if (vfs == NULL) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (is_socket ? (vfs->vfs.socket_select == NULL ||
+                         (handle->socket_vfs_index >= 0 && handle->socket_vfs_index != vfs_index))
+                      : vfs->vfs.start_select == NULL) {
+            ESP_LOGD(TAG, "FD %d: VFS ID %d does not support select", fd, vfs_index);
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+        item->vfs_index = vfs_index;
+        item->local_fd = local_fd;
+        item->is_socket = is_socket;
+        item->data = event->data;
+        ++handle->vfs_fd_count[vfs_index];
+        if (is_socket) {
+            handle->socket_vfs_index = vfs_index;
+        }
+        handle->nfds = MAX(handle->nfds, fd + 1);
+        set_item_events(handle, fd, event->events);
+        return ESP_OK;
+    }
+    case ESP_VFS_EPOLL_CTL_MOD:
+        if (item->vfs_index < 0) {
+            return ESP_ERR_NOT_FOUND;
+        }
+        item->data = event->data;
+        set_item_events(handle, fd, event->events);
+        return ESP_OK;
+    case ESP_VFS_EPOLL_CTL_DEL:
+        if (item->vfs_index < 0) {
+            return ESP_ERR_NOT_FOUND;
+        }
+        --handle->vfs_fd_count[item->vfs_index];
+        set_item_events(handle, fd, 0);
+        if (item->is_socket && handle->vfs_fd_count[item->vfs_index] == 0) {
+            handle->socket_vfs_index = -1;
+        }
+        item->vfs_index = -1;
+        while (handle->nfds > 0 && handle->items[handle->nfds - 1].vfs_index < 0) {
+            --handle->nfds;
+        }
+        return ESP_OK;
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+}
+
+static void call_end_selects(esp_vfs_epoll_handle_t handle, int end_index)
+{
+    for (int i = 0; i < end_index; ++i) {
+        const vfs_entry_t *vfs = get_vfs_for_index(i);
+        if (vfs && vfs->vfs.end_select && handle->vfs_fds_ready[i].isset) {
+            esp_err_t err = vfs->vfs.end_select(handle->driver_args[i]);
+            if (err != ESP_OK) {
+                ESP_LOGD(TAG, "end_select failed: %s", esp_err_to_name(err));
+            }
+        }
+    }
+}
+
+int esp_vfs_epoll_wait(esp_vfs_epoll_handle_t handle, esp_vfs_epoll_event_t *events, int max_events, int timeout_ms)
+{
+    if (handle == NULL || events == NULL || max_events <= 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    esp_vfs_select_sem_t sel_sem = {
+        .is_sem_local = true,
+        .sem = handle->sem,
+    };
+    int (*socket_select)(int, fd_set *, fd_set *, fd_set *, struct timeval *) = NULL;
+    if (handle->socket_vfs_index >= 0) {
+        const vfs_entry_t *vfs = get_vfs_for_index(handle->socket_vfs_index);
+        if (vfs == NULL) {
+            errno = EBADF;
+            return -1;
+        }
+        socket_select = vfs->vfs.socket_select;
+        sel_sem.is_sem_local = false;
+        sel_sem.sem = vfs->vfs.get_socket_select_semaphore();
+    } else {
+        // A driver may have triggered the semaphore after the previous wait was over
+        xSemaphoreTake(handle->sem, 0);
+    }
+
+    // The drivers write the ready FDs into the sets given to start_select
+    memcpy(handle->vfs_fds_ready, handle->vfs_fds, sizeof(handle->vfs_fds_ready));
+    for (int i = 0; i < VFS_MAX_COUNT; ++i) {
+        epoll_fds_t *fds = &handle->vfs_fds_ready[i];
+        if (!fds->isset) {
+            continue;
+        }
+        const vfs_entry_t *vfs = get_vfs_for_index(i);
+        esp_err_t err = ESP_ERR_INVALID_STATE;
+        if (vfs && vfs->vfs.start_select) {
+            err = vfs->vfs.start_select(MAX_FDS, &fds->readfds, &fds->writefds, &fds->errorfds, sel_sem,
+                                        &handle->driver_args[i]);
+        }
+        if (err != ESP_OK) {
+            ESP_LOGD(TAG, "start_select failed for VFS ID %d: %s", i, esp_err_to_name(err));
+            call_end_selects(handle, i);
+            errno = (vfs == NULL) ? EBADF : EINTR;
+            return -1;
+        }
+    }
+
+    int ret = 0;
+    if (socket_select) {
+        struct timeval tv = {
+            .tv_sec = timeout_ms / 1000,
+            .tv_usec = (timeout_ms % 1000) * 1000,
+        };
+        handle->socket_fds_ready = handle->socket_fds;
+        ret = socket_select(handle->nfds, &handle->socket_fds_ready.readfds, &handle->socket_fds_ready.writefds,
+                            &handle->socket_fds_ready.errorfds, timeout_ms < 0 ? NULL : &tv);
+    } else {
+        TickType_t ticks_to_wait = portMAX_DELAY;
+        if (timeout_ms >= 0) {
+            // Wait for AT LEAST the timeout, see esp_vfs_select()
+            ticks_to_wait = ((timeout_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS) + 1;
+        }
+        xSemaphoreTake(handle->sem, ticks_to_wait);
+    }
+
+    call_end_selects(handle, VFS_MAX_COUNT);
+    if (socket_select && sel_sem.sem) {
+        // Same as in esp_vfs_select(): the socket semaphore belongs to the calling thread, clear it
+        SemaphoreHandle_t *s = sel_sem.sem;
+        xSemaphoreTake(*s, 0);
+    }
+    if (ret < 0) {
+        return -1; // errno is set by socket_select
+    }
+
+    int count = 0;
+    for (int fd = 0; fd < handle->nfds && count < max_events; ++fd) {
+        const epoll_item_t *item = &handle->items[fd];
+        if (item->vfs_index < 0) {
+            continue;
+        }
+        const epoll_fds_t *fds = item->is_socket ? &handle->socket_fds_ready : &handle->vfs_fds_ready[item->vfs_index];
+        const int set_fd = item->is_socket ? fd : item->local_fd;
+        uint32_t ready = 0;
+        if ((item->events & ESP_VFS_EPOLLIN) && FD_ISSET(set_fd, &fds->readfds)) {
+            ready |= ESP_VFS_EPOLLIN;
+        }
+        if ((item->events & ESP_VFS_EPOLLOUT) && FD_ISSET(set_fd, &fds->writefds)) {
+            ready |= ESP_VFS_EPOLLOUT;
+        }
+        if ((item->events & ESP_VFS_EPOLLERR) && FD_ISSET(set_fd, &fds->errorfds)) {
+            ready |= ESP_VFS_EPOLLERR;
+        }
+        if (ready) {
+            events[count].events = ready;
+            events[count].fd = fd;
+            events[count].data = item->data;
+            ++count;
+        }
+    }
+    return count;
+}
+
+#endif // CONFIG_VFS_SUPPORT_SELECT
@@ -0,0 +1,284 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "WL_Cache.h"
+
+static const char *TAG = "wl_cache";
+
+#define WL_CACHE_RESULT_CHECK(result) \
+    if (result != ESP_OK) { \
+        ESP_LOGE(TAG,"%s(%d): result = 0x%08" PRIx32, __FUNCTION__, __LINE__, (uint32_t) result); \
+        return (result); \
+    }
+
+static uint32_t now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+static bool is_erased(const uint8_t *data, size_t size)
+{
+    const uint32_t *words = (const uint32_t *)data;
+    for (size_t i = 0; i < size / sizeof(uint32_t); i++) {
+        if (words[i] != UINT32_MAX) {
+            return false;
+        }
+    }
+    return true;
+}
+
+WL_Cache::WL_Cache(Flash_Access *flash, size_t line_size)
+{
+    this->flash = flash;
+    this->line_size = line_size;
+}
+
+WL_Cache::~WL_Cache()
+{
+    free(this->lines);
+    free(this->buffer);
+}
+
+esp_err_t WL_Cache::init(size_t line_count, uint32_t flush_timeout_ms, bool write_order)
+{
+    this->lines = (cache_line_t *)calloc(line_count, sizeof(cache_line_t));
+    this->buffer = (uint8_t *)malloc(line_count * this->line_size);
+    if (this->lines == NULL || this->buffer == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t i = 0; i < line_count; i++) {
+        this->lines[i].data = &this->buffer[i * this->line_size];
+    }
+    this->line_count = line_count;
+    this->flush_timeout_ms = flush_timeout_ms;
+    this->write_order = write_order;
+    return ESP_OK;
+}
+
+size_t WL_Cache::get_flash_size()
+{
+    return this->flash->get_flash_size();
+}
+
+size_t WL_Cache::get_sector_size()
+{
+    return this->flash->get_sector_size();
+}
+
+esp_err_t WL_Cache::check_range(size_t addr, size_t size)
+{
+    const size_t flash_size = this->get_flash_size();
+    if (addr > flash_size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (size > flash_size - addr) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
+
+WL_Cache::cache_line_t *WL_Cache::find_line(size_t addr)
+{
+    for (size_t i = 0; i < this->line_count; i++) {
+        if (this->lines[i].valid && this->lines[i].addr == addr) {
+            return &this->lines[i];
+        }
+    }
+    return NULL;
+}
+
+WL_Cache::cache_line_t *WL_Cache::oldest_dirty_line()
+{
+    cache_line_t *oldest = NULL;
+    for (size_t i = 0; i < this->line_count; i++) {
+        cache_line_t *line = &this->lines[i];
+        if (line->dirty && (oldest == NULL || line->dirty_seq < oldest->dirty_seq)) {
+            oldest = line;
+        }
+    }
+    return oldest;
+}
+
+void WL_Cache::set_dirty(cache_line_t *line)
+{
+    if (!line->dirty) {
+        line->dirty = true;
+        line->dirty_seq = ++this->dirty_counter;
+        line->dirty_since_ms = now_ms();
+    }
+}
+
+esp_err_t WL_Cache::write_back(cache_line_t *line)
+{
+    ESP_LOGV(TAG, "%s - addr= 0x%08" PRIx32, __func__, (uint32_t) line->addr);
+    esp_err_t result = this->flash->erase_range(line->addr, this->line_size);
+    WL_CACHE_RESULT_CHECK(result);
+    if (!is_erased(line->data, this->line_size)) {
+        result = this->flash->write(line->addr, line->data, this->line_size);
+        WL_CACHE_RESULT_CHECK(result);
+    }
+    line->dirty = false;
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::evict(cache_line_t *line)
+{
+    if (!line->dirty) {
+        return ESP_OK;
+    }
+    if (!this->write_order) {
+        return this->write_back(line);
+    }
+    // Keep the order of the updates on flash: the lines modified before this one go first
+    cache_line_t *oldest;
+    while ((oldest = this->oldest_dirty_line()) != NULL && oldest->dirty_seq <= line->dirty_seq) {
+        esp_err_t result = this->write_back(oldest);
+        WL_CACHE_RESULT_CHECK(result);
+    }
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::get_line(size_t addr, bool load, cache_line_t **out_line)
+{
+    cache_line_t *line = this->find_line(addr);
+    if (line == NULL) {
+        line = &this->lines[0];
+        for (size_t i = 0; i < this->line_count && line->valid; i++) {
+            if (!this->lines[i].valid || this->lines[i].last_use < line->last_use) {
+                line = &this->lines[i];
+            }
+        }
+        esp_err_t result = this->evict(line);
+        WL_CACHE_RESULT_CHECK(result);
+
+        line->valid = false;
+        if (load) {
+            result = this->flash->read(addr, line->data, this->line_size);
+            WL_CACHE_RESULT_CHECK(result);
+        } else {
+            memset(line->data, 0xff, this->line_size);
+        }
+        line->addr = addr;
+        line->valid = true;
+    }
+    line->last_use = ++this->use_counter;
+    *out_line = line;
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::erase_sector(size_t sector)
+{
+    return this->erase_range(sector * this->get_sector_size(), this->get_sector_size());
+}
+
+esp_err_t WL_Cache::erase_range(size_t start_address, size_t size)
+{
+    esp_err_t result = this->check_range(start_address, size);
+    WL_CACHE_RESULT_CHECK(result);
+
+    while (size > 0) {
+        const size_t offset = start_address % this->line_size;
+        const size_t len = (size < this->line_size - offset) ? size : this->line_size - offset;
+        cache_line_t *line;
+        // A fully erased line does not need to be read from flash
+        result = this->get_line(start_address - offset, len != this->line_size, &line);
+        WL_CACHE_RESULT_CHECK(result);
+        memset(&line->data[offset], 0xff, len);
+        this->set_dirty(line);
+        start_address += len;
+        size -= len;
+    }
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::write(size_t dest_addr, const void *src, size_t size)
+{
+    esp_err_t result = this->check_range(dest_addr, size);
+    WL_CACHE_RESULT_CHECK(result);
+
+    const uint8_t *data = (const uint8_t *)src;
+    while (size > 0) {
+        const size_t offset = dest_addr % this->line_size;
+        const size_t len = (size < this->line_size - offset) ? size : this->line_size - offset;
+        cache_line_t *line;
+        result = this->get_line(dest_addr - offset, true, &line);
+        WL_CACHE_RESULT_CHECK(result);
+        // Writing to flash can only clear bits, do the same in RAM
+        for (size_t i = 0; i < len; i++) {
+            line->data[offset + i] &= data[i];
+        }
+        this->set_dirty(line);
+        dest_addr += len;
+        data += len;
+        size -= len;
+    }
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::read(size_t src_addr, void *dest, size_t size)
+{
+    esp_err_t result = this->check_range(src_addr, size);
+    WL_CACHE_RESULT_CHECK(result);
+
+    uint8_t *data = (uint8_t *)dest;
+    while (size > 0) {
+        const size_t offset = src_addr % this->line_size;
+        const size_t len = (size < this->line_size - offset) ? size : this->line_size - offset;
+        cache_line_t *line = this->find_line(src_addr - offset);
+        if (line != NULL) {
+            memcpy(data, &line->data[offset], len);
+        } else {
+            result = this->flash->read(src_addr, data, len);
+            WL_CACHE_RESULT_CHECK(result);
+        }
+        src_addr += len;
+        data += len;
+        size -= len;
+    }
+    return ESP_OK;
+}
+
+esp_err_t WL_Cache::flush()
+{
+    while (true) {
+        cache_line_t *next = NULL;
+        if (this->write_order) {
+            next = this->oldest_dirty_line();
+        } else {
+            for (size_t i = 0; i < this->line_count; i++) {
+                cache_line_t *line = &this->lines[i];
+                if (line->dirty && (next == NULL || line->addr < next->addr)) {
+                    next = line;
+                }
+            }
+        }
+        if (next == NULL) {
+            return ESP_OK;
+        }
+        esp_err_t result = this->write_back(next);
+        WL_CACHE_RESULT_CHECK(result);
+    }
+}
+
+esp_err_t WL_Cache::flush_expired()
+{
+    if (this->flush_timeout_ms == 0) {
+        return ESP_OK;
+    }
+    const uint32_t now = now_ms();
+    cache_line_t *line;
+    while ((line = this->oldest_dirty_line()) != NULL && now - line->dirty_since_ms >= this->flush_timeout_ms) {
+        esp_err_t result = this->write_back(line);
+        WL_CACHE_RESULT_CHECK(result);
+    }
+    return ESP_OK;
+}
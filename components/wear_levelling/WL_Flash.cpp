@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -245,16 +245,23 @@ esp_err_t WL_Flash::recoverPos()
 {
     esp_err_t result = ESP_OK;
     size_t position = 0;
+    size_t count = this->state.wl_part_max_sec_pos;
     ESP_LOGV(TAG, "%s start", __func__);
-    for (size_t i = 0; i < this->state.wl_part_max_sec_pos; i++) {
+    // The position records are written one after another, so all records before the current position are set
+    // and all records after it are not. Binary search for the first record which is not set.
+    while (count > 0) {
         bool pos_bits;
-        position = i;
+        size_t step = count / 2;
+        size_t i = position + step;
         result = this->partition->read(this->addr_state1 + sizeof(wl_state_t) + i * this->cfg.wl_pos_update_record_size, this->temp_buff, this->cfg.wl_pos_update_record_size);
         pos_bits = this->OkBuffSet(i);
         WL_RESULT_CHECK(result);
-        ESP_LOGV(TAG, "%s - check pos: result=0x%08" PRIx32 ", position= %" PRIu32 ", pos_bits= 0x%08" PRIx32 , __func__, (uint32_t) result, (uint32_t) position, (uint32_t) pos_bits);
-        if (pos_bits == false) {
-            break; // we have found position
+        ESP_LOGV(TAG, "%s - check pos: result=0x%08" PRIx32 ", position= %" PRIu32 ", pos_bits= 0x%08" PRIx32 , __func__, (uint32_t) result, (uint32_t) i, (uint32_t) pos_bits);
+        if (pos_bits) {
+            position = i + 1;
+            count -= step + 1;
+        } else {
+            count = step;
         }
     }
 
@@ -1,12 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include "crc32.h"
-#include "esp_rom_crc.h"
+#include "esp_crc.h"
 
 unsigned int crc32::crc32_le(unsigned int crc, unsigned char const *buf, unsigned int len)
 {
-    return ::esp_rom_crc32_le(crc, buf, len);
+    return ::esp_crc32_le(crc, buf, len);
 }
@@ -1,11 +1,12 @@
 /*
- * SPDX-FileCopyrightText: 2016-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2016-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 
 #include "esp_partition.h"
 #include "esp_private/partition_linux.h"
@@ -229,6 +230,51 @@ TEST_CASE("power down test", "[wear_levelling]")
     REQUIRE(result == ESP_OK);
 }
 
+TEST_CASE("mount reads few position records", "[wear_levelling]")
+{
+    esp_err_t result;
+    wl_handle_t wl_handle;
+
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "storage");
+
+    result = wl_mount(partition, &wl_handle);
+    REQUIRE(result == ESP_OK);
+
+    size_t sector_size = wl_sector_size(wl_handle);
+    uint32_t *sector_data = new uint32_t[sector_size / sizeof(uint32_t)];
+    for (uint32_t m = 0; m < sector_size / sizeof(uint32_t); m++) {
+        sector_data[m] = m;
+    }
+
+    // Move the dummy sector far from the first position record (WL_DEFAULT_UPDATERATE is 16)
+    for (int i = 0; i < 16 * 100; i++) {
+        result = wl_erase_range(wl_handle, 0, sector_size);
+        REQUIRE(result == ESP_OK);
+    }
+    result = wl_write(wl_handle, 0, sector_data, sector_size);
+    REQUIRE(result == ESP_OK);
+
+    result = wl_unmount(wl_handle);
+    REQUIRE(result == ESP_OK);
+
+    // The position of the dummy sector is found by a binary search over the position records
+    esp_partition_clear_stats();
+    result = wl_mount(partition, &wl_handle);
+    REQUIRE(result == ESP_OK);
+    REQUIRE(esp_partition_get_read_ops() < 32);
+
+    uint32_t *read_data = new uint32_t[sector_size / sizeof(uint32_t)];
+    result = wl_read(wl_handle, 0, read_data, sector_size);
+    REQUIRE(result == ESP_OK);
+    REQUIRE(memcmp(sector_data, read_data, sector_size) == 0);
+
+    result = wl_unmount(wl_handle);
+    REQUIRE(result == ESP_OK);
+
+    delete[] sector_data;
+    delete[] read_data;
+}
+
 // Calculates wl status blocks offsets and status block size
 void calculate_wl_state_address_info(const esp_partition_t *partition, size_t *offset_state_1, size_t *offset_state_2, size_t *state_size)
 {
@@ -421,3 +467,47 @@ TEST_CASE("power down between WL status 1 and WL status 2 update", "[wear_levell
 
     free(tmp_state);
 }
+
+TEST_CASE("benchmark sector rewrites with SPI NOR timing", "[wear_levelling][benchmark]")
+{
+    esp_err_t result;
+    wl_handle_t wl_handle;
+
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "storage");
+
+    result = wl_mount(partition, &wl_handle);
+    REQUIRE(result == ESP_OK);
+
+    size_t sector_size = wl_sector_size(wl_handle);
+    uint8_t *sector_data = new uint8_t[sector_size];
+    memset(sector_data, 0x5a, sector_size);
+
+    esp_partition_timing_model_t model = ESP_PARTITION_TIMING_MODEL_SPI_NOR_DEFAULT();
+    esp_partition_set_timing_model(&model);
+    esp_partition_clear_stats();
+
+    // Rewrite the same logical sector, as a FAT table or a log file does
+    const int rewrites = TEST_COUNT_MAX * 10;
+    for (int i = 0; i < rewrites; i++) {
+        result = wl_erase_range(wl_handle, 0, sector_size);
+        REQUIRE(result == ESP_OK);
+        result = wl_write(wl_handle, 0, sector_data, sector_size);
+        REQUIRE(result == ESP_OK);
+    }
+
+    esp_partition_stats_t stats;
+    esp_partition_get_stats(&stats);
+    printf("[Benchmark][wl_sector_rewrite]: iterations=%d read_ops=%zu write_ops=%zu erase_ops=%zu read_bytes=%zu write_bytes=%zu "
+           "read_us=%" PRIu64 " write_us=%" PRIu64 " erase_us=%" PRIu64 "\n", rewrites, stats.read_ops, stats.write_ops,
+           stats.erase_ops, stats.read_bytes, stats.write_bytes, stats.read_time_us, stats.write_time_us, stats.erase_time_us);
+
+    // Moving the dummy sector every WL_DEFAULT_UPDATERATE erases must not double the flash erases
+    REQUIRE(stats.erase_ops < rewrites * 2);
+    REQUIRE(stats.write_bytes < (size_t) rewrites * sector_size * 2);
+
+    esp_partition_set_timing_model(NULL);
+    result = wl_unmount(wl_handle);
+    REQUIRE(result == ESP_OK);
+
+    delete[] sector_data;
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -104,6 +104,20 @@ esp_err_t wl_write(wl_handle_t handle, size_t dest_addr, const void *src, size_t
 */
 esp_err_t wl_read(wl_handle_t handle, size_t src_addr, void *dest, size_t size);
 
+/**
+* @brief Write back the sectors held in the write-back cache of the WL storage
+*
+* Does nothing if the cache is disabled (CONFIG_WL_WRITE_CACHE_SECTORS is 0).
+*
+* @param handle WL module instance that was initialized before
+*
+* @return
+*       - ESP_OK, if all cached sectors were written back;
+*       - ESP_ERR_NOT_FOUND, if the handle is not valid;
+*       - or one of error codes from lower-level flash driver.
+*/
+esp_err_t wl_flush(wl_handle_t handle);
+
 /**
 * @brief Get the actual flash size in use for the WL storage partition
 *
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef _WL_Cache_H_
+#define _WL_Cache_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "Flash_Access.h"
+
+/**
+* @brief Write-back cache of flash sectors on top of a Flash_Access instance
+*
+* Erases and writes are applied to sectors held in RAM, and a sector is written back to the flash with
+* a single erase and write when it is evicted, when it is dirty for longer than the flush timeout, or
+* when flush() is called. Several updates of the same sector then cost one erase of the flash.
+*/
+class WL_Cache : public Flash_Access
+{
+public:
+    WL_Cache(Flash_Access *flash, size_t line_size);
+    ~WL_Cache() override;
+
+    esp_err_t init(size_t line_count, uint32_t flush_timeout_ms, bool write_order);
+
+    size_t get_flash_size() override;
+    size_t get_sector_size() override;
+
+    esp_err_t erase_sector(size_t sector) override;
+    esp_err_t erase_range(size_t start_address, size_t size) override;
+
+    esp_err_t write(size_t dest_addr, const void *src, size_t size) override;
+    esp_err_t read(size_t src_addr, void *dest, size_t size) override;
+
+    /* Writes back all dirty sectors. The underlying Flash_Access is not flushed. */
+    esp_err_t flush() override;
+    /* Writes back the sectors which are dirty for longer than the flush timeout */
+    esp_err_t flush_expired();
+
+protected:
+    typedef struct {
+        size_t addr;
+        uint8_t *data;
+        bool valid;
+        bool dirty;
+        uint32_t last_use;          /*!< Value of use_counter at the last access, for LRU eviction */
+        uint32_t dirty_seq;         /*!< Value of dirty_counter when the line became dirty */
+        uint32_t dirty_since_ms;
+    } cache_line_t;
+
+    Flash_Access *flash;
+    size_t line_size;
+    size_t line_count = 0;
+    cache_line_t *lines = NULL;
+    uint8_t *buffer = NULL;
+    uint32_t use_counter = 0;
+    uint32_t dirty_counter = 0;
+    uint32_t flush_timeout_ms = 0;
+    bool write_order = true;
+
+    esp_err_t check_range(size_t addr, size_t size);
+    cache_line_t *find_line(size_t addr);
+    cache_line_t *oldest_dirty_line();
+    esp_err_t get_line(size_t addr, bool load, cache_line_t **out_line);
+    void set_dirty(cache_line_t *line);
+    esp_err_t write_back(cache_line_t *line);
+    esp_err_t evict(cache_line_t *line);
+};
+
+#endif // _WL_Cache_H_
@@ -319,6 +319,42 @@ TEST(wear_levelling, version_update)
 }
 #endif // CONFIG_WL_SECTOR_SIZE_4096
 
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+TEST(wear_levelling, write_cache_keeps_data_across_mount)
+{
+    const esp_partition_t *partition = get_test_data_partition();
+    wl_handle_t handle;
+    TEST_ESP_OK(wl_mount(partition, &handle));
+
+    size_t sector_size = wl_sector_size(handle);
+    uint32_t *buff = (uint32_t *) malloc(sector_size);
+    TEST_ASSERT_NOT_NULL(buff);
+
+    // Update more sectors than the cache holds, several times, to go through evictions
+    for (int pass = 0; pass < 3; pass++) {
+        for (int m = 0; m < CONFIG_WL_WRITE_CACHE_SECTORS * 2; m++) {
+            for (int i = 0; i < sector_size / sizeof(uint32_t); i++) {
+                buff[i] = pass * 0x10000 + m * 0x100 + i;
+            }
+            TEST_ESP_OK(wl_erase_range(handle, sector_size * m, sector_size));
+            TEST_ESP_OK(wl_write(handle, sector_size * m, buff, sector_size));
+        }
+    }
+    TEST_ESP_OK(wl_flush(handle));
+    TEST_ESP_OK(wl_unmount(handle));
+
+    TEST_ESP_OK(wl_mount(partition, &handle));
+    for (int m = 0; m < CONFIG_WL_WRITE_CACHE_SECTORS * 2; m++) {
+        TEST_ESP_OK(wl_read(handle, sector_size * m, buff, sector_size));
+        for (int i = 0; i < sector_size / sizeof(uint32_t); i++) {
+            TEST_ASSERT_EQUAL_HEX32(2 * 0x10000 + m * 0x100 + i, buff[i]);
+        }
+    }
+    TEST_ESP_OK(wl_unmount(handle));
+    free(buff);
+}
+#endif // CONFIG_WL_WRITE_CACHE_SECTORS > 0
+
 TEST_GROUP_RUNNER(wear_levelling)
 {
     RUN_TEST_CASE(wear_levelling, wl_unmount_doesnt_leak_memory)
@@ -329,6 +365,9 @@ TEST_GROUP_RUNNER(wear_levelling)
 #if CONFIG_WL_SECTOR_SIZE_4096
     RUN_TEST_CASE(wear_levelling, version_update)
 #endif
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+    RUN_TEST_CASE(wear_levelling, write_cache_keeps_data_across_mount)
+#endif
 }
 
 void app_main(void)
@@ -1,4 +1,4 @@
-# SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: CC0-1.0
 import pytest
 from pytest_embedded import Dut
@@ -12,6 +12,7 @@ from pytest_embedded import Dut
     '512perf',
     '512safe',
     'release',
+    'write_cache',
 ], indirect=True)
 def test_wear_levelling(dut: Dut) -> None:
     dut.expect_unity_test_output()
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -13,6 +13,7 @@
 #include "WL_Flash.h"
 #include "WL_Ext_Perf.h"
 #include "WL_Ext_Safe.h"
+#include "WL_Cache.h"
 #include "SPI_Flash.h"
 #include "Partition.h"
 
@@ -40,8 +41,17 @@
 #define WL_CURRENT_VERSION  2
 #endif //WL_CURRENT_VERSION
 
+#if CONFIG_WL_WRITE_CACHE_FLUSH_ORDER_WRITE
+#define WL_CACHE_WRITE_ORDER    true
+#else
+#define WL_CACHE_WRITE_ORDER    false
+#endif //CONFIG_WL_WRITE_CACHE_FLUSH_ORDER_WRITE
+
 typedef struct {
     WL_Flash *instance;
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+    WL_Cache *cache;
+#endif
     _lock_t lock;
 } wl_instance_t;
 
@@ -51,6 +61,27 @@ static const char *TAG = "wear_levelling";
 
 static esp_err_t check_handle(wl_handle_t handle, const char *func);
 
+// Erases, writes and reads go through the write-back cache, if there is one
+static Flash_Access *get_flash_access(wl_handle_t handle)
+{
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+    if (s_instances[handle].cache != NULL) {
+        return s_instances[handle].cache;
+    }
+#endif
+    return s_instances[handle].instance;
+}
+
+static esp_err_t flush_expired(wl_handle_t handle, esp_err_t result)
+{
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+    if (result == ESP_OK && s_instances[handle].cache != NULL) {
+        result = s_instances[handle].cache->flush_expired();
+    }
+#endif
+    return result;
+}
+
 esp_err_t wl_mount(const esp_partition_t *partition, wl_handle_t *out_handle)
 {
     // Initialize variables before the first jump to cleanup label
@@ -58,6 +89,10 @@ esp_err_t wl_mount(const esp_partition_t *partition, wl_handle_t *out_handle)
     WL_Flash *wl_flash = NULL;
     void *part_ptr = NULL;
     Partition *part = NULL;
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+    void *cache_ptr = NULL;
+    WL_Cache *cache = NULL;
+#endif
     esp_err_t result = ESP_OK;
     *out_handle = WL_INVALID_HANDLE;
 
@@ -147,6 +182,26 @@ esp_err_t wl_mount(const esp_partition_t *partition, wl_handle_t *out_handle)
         goto out;
     }
 
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+    // A read-only partition is never written, so it does not need the cache
+    if (!part->is_readonly()) {
+        cache_ptr = malloc(sizeof(WL_Cache));
+        if (cache_ptr == NULL) {
+            result = ESP_ERR_NO_MEM;
+            ESP_LOGE(TAG, "%s: can't allocate WL_Cache", __func__);
+            goto out;
+        }
+        cache = new (cache_ptr) WL_Cache(wl_flash, cfg.flash_sector_size);
+        result = cache->init(CONFIG_WL_WRITE_CACHE_SECTORS, CONFIG_WL_WRITE_CACHE_FLUSH_TIMEOUT_MS,
+                             WL_CACHE_WRITE_ORDER);
+        if (ESP_OK != result) {
+            ESP_LOGE(TAG, "%s: can't allocate %d cache sectors", __func__, CONFIG_WL_WRITE_CACHE_SECTORS);
+            goto out;
+        }
+    }
+    s_instances[*out_handle].cache = cache;
+#endif
+
     s_instances[*out_handle].instance = wl_flash;
     // Initialise the lock for respective WL handle
     _lock_init(&s_instances[*out_handle].lock);
@@ -157,6 +212,12 @@ esp_err_t wl_mount(const esp_partition_t *partition, wl_handle_t *out_handle)
 out:
     _lock_release(&s_instances_lock);
     *out_handle = WL_INVALID_HANDLE;
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+    if (cache) {
+        cache->~WL_Cache();
+    }
+    free(cache_ptr);
+#endif
     if (wl_flash) {
         wl_flash->~WL_Flash();
         free(wl_flash);
@@ -176,9 +237,18 @@ esp_err_t wl_unmount(wl_handle_t handle)
     if (result == ESP_OK) {
         // We use placement new in wl_mount, so call destructor directly
         Partition *part = s_instances[handle].instance->get_part();
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+        if (s_instances[handle].cache != NULL) {
+            result = s_instances[handle].cache->flush();
+            s_instances[handle].cache->~WL_Cache();
+            free(s_instances[handle].cache);
+            s_instances[handle].cache = NULL;
+        }
+#endif
         // We have to flush state of the component
         if (!part->is_readonly()) {
-            result = s_instances[handle].instance->flush();
+            esp_err_t flush_result = s_instances[handle].instance->flush();
+            result = (result == ESP_OK) ? flush_result : result;
         }
         part->~Partition();
         free(part);
@@ -198,7 +268,8 @@ esp_err_t wl_erase_range(wl_handle_t handle, size_t start_addr, size_t size)
         return result;
     }
     _lock_acquire(&s_instances[handle].lock);
-    result = s_instances[handle].instance->erase_range(start_addr, size);
+    result = get_flash_access(handle)->erase_range(start_addr, size);
+    result = flush_expired(handle, result);
     _lock_release(&s_instances[handle].lock);
     return result;
 }
@@ -210,7 +281,8 @@ esp_err_t wl_write(wl_handle_t handle, size_t dest_addr, const void *src, size_t
         return result;
     }
     _lock_acquire(&s_instances[handle].lock);
-    result = s_instances[handle].instance->write(dest_addr, src, size);
+    result = get_flash_access(handle)->write(dest_addr, src, size);
+    result = flush_expired(handle, result);
     _lock_release(&s_instances[handle].lock);
     return result;
 }
@@ -222,8 +294,25 @@ esp_err_t wl_read(wl_handle_t handle, size_t src_addr, void *dest, size_t size)
         return result;
     }
     _lock_acquire(&s_instances[handle].lock);
-    result = s_instances[handle].instance->read(src_addr, dest, size);
+    result = get_flash_access(handle)->read(src_addr, dest, size);
+    result = flush_expired(handle, result);
+    _lock_release(&s_instances[handle].lock);
+    return result;
+}
+
+esp_err_t wl_flush(wl_handle_t handle)
+{
+    esp_err_t result = check_handle(handle, __func__);
+    if (result != ESP_OK) {
+        return result;
+    }
+#if CONFIG_WL_WRITE_CACHE_SECTORS > 0
+    _lock_acquire(&s_instances[handle].lock);
+    if (s_instances[handle].cache != NULL) {
+        result = s_instances[handle].cache->flush();
+    }
     _lock_release(&s_instances[handle].lock);
+#endif
     return result;
 }
 
@@ -16,6 +16,7 @@
 #include <string.h>
 #include <esp_err.h>
 #include <esp_log.h>
+#include <protocomm_arena.h>
 
 #include "wifi_constants.pb-c.h"
 #include "wifi_config.pb-c.h"
@@ -308,7 +309,8 @@ esp_err_t wifi_prov_config_data_handler(uint32_t session_id, const uint8_t *inbu
     WiFiConfigPayload resp;
     esp_err_t ret;
 
-    req = wi_fi_config_payload__unpack(NULL, inlen, inbuf);
+    PROTOCOMM_ARENA_DECLARE(arena);
+    req = wi_fi_config_payload__unpack(&arena.allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack config data");
         return ESP_ERR_INVALID_ARG;
@@ -322,7 +324,7 @@ esp_err_t wifi_prov_config_data_handler(uint32_t session_id, const uint8_t *inbu
     }
 
     resp.msg = req->msg + 1; /* Response is request + 1 */
-    wi_fi_config_payload__free_unpacked(req, NULL);
+    wi_fi_config_payload__free_unpacked(req, &arena.allocator);
 
     *outlen = wi_fi_config_payload__get_packed_size(&resp);
     if (*outlen <= 0) {
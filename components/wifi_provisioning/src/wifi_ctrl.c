@@ -8,6 +8,7 @@
 #include <esp_log.h>
 #include <string.h>
 #include <esp_err.h>
+#include <protocomm_arena.h>
 
 #include "wifi_ctrl.pb-c.h"
 
@@ -145,7 +146,8 @@ esp_err_t wifi_ctrl_handler(uint32_t session_id, const uint8_t *inbuf, ssize_t i
     WiFiCtrlPayload resp;
     esp_err_t ret = ESP_OK;
 
-    req = wi_fi_ctrl_payload__unpack(NULL, inlen, inbuf);
+    PROTOCOMM_ARENA_DECLARE(arena);
+    req = wi_fi_ctrl_payload__unpack(&arena.allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack ctrl message");
         return ESP_ERR_INVALID_ARG;
@@ -177,7 +179,7 @@ esp_err_t wifi_ctrl_handler(uint32_t session_id, const uint8_t *inbuf, ssize_t i
     ESP_LOGD(TAG, "Response packet size : %d", *outlen);
     exit:
 
-    wi_fi_ctrl_payload__free_unpacked(req, NULL);
+    wi_fi_ctrl_payload__free_unpacked(req, &arena.allocator);
     wifi_ctrl_cmd_cleanup(&resp, priv_data);
     return ret;
 }
@@ -16,6 +16,7 @@
 #include <esp_log.h>
 #include <string.h>
 #include <esp_err.h>
+#include <protocomm_arena.h>
 #include <esp_wifi.h>
 
 #include "wifi_scan.pb-c.h"
@@ -262,7 +263,8 @@ esp_err_t wifi_prov_scan_handler(uint32_t session_id, const uint8_t *inbuf, ssiz
     WiFiScanPayload resp;
     esp_err_t ret = ESP_OK;
 
-    req = wi_fi_scan_payload__unpack(NULL, inlen, inbuf);
+    PROTOCOMM_ARENA_DECLARE(arena);
+    req = wi_fi_scan_payload__unpack(&arena.allocator, inlen, inbuf);
     if (!req) {
         ESP_LOGE(TAG, "Unable to unpack scan message");
         return ESP_ERR_INVALID_ARG;
@@ -294,7 +296,7 @@ esp_err_t wifi_prov_scan_handler(uint32_t session_id, const uint8_t *inbuf, ssiz
     ESP_LOGD(TAG, "Response packet size : %d", *outlen);
     exit:
 
-    wi_fi_scan_payload__free_unpacked(req, NULL);
+    wi_fi_scan_payload__free_unpacked(req, &arena.allocator);
     wifi_prov_scan_cmd_cleanup(&resp, priv_data);
     return ret;
 }
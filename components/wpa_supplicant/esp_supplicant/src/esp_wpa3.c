@@ -15,15 +15,43 @@
 #include "esp_wpa3_i.h"
 #include "endian.h"
 #include "esp_hostap.h"
+#include "crypto/sha256.h"
 #include <inttypes.h>
 
 static struct sae_pt *g_sae_pt;
+static u8 g_sae_pt_hash[SHA256_MAC_LEN];    /* Hash of the SSID, password and identifier g_sae_pt was derived from */
 static struct sae_data g_sae_data;
 static struct wpabuf *g_sae_token = NULL;
 static struct wpabuf *g_sae_commit = NULL;
 static struct wpabuf *g_sae_confirm = NULL;
 int g_allowed_groups[] = { IANA_SECP256R1, 0 };
 
+/* Deriving the PT takes most of the time of an H2E commit, keep it while the profile doesn't change */
+static struct sae_pt *wpa3_get_sae_pt(const struct wifi_ssid *ssid, const u8 *pw, const char *pwd_id)
+{
+    size_t pw_len = os_strlen((const char *)pw);
+    size_t pwd_id_len = pwd_id ? os_strlen(pwd_id) : 0;
+    u8 lens[3] = { ssid->len, pw_len, pwd_id_len };
+    const u8 *addr[4] = { lens, ssid->ssid, pw, (const u8 *)pwd_id };
+    size_t len[4] = { sizeof(lens), ssid->len, pw_len, pwd_id_len };
+    u8 hash[SHA256_MAC_LEN];
+
+    if (sha256_vector(pwd_id ? 4 : 3, addr, len, hash) < 0) {
+        return NULL;
+    }
+    if (g_sae_pt && os_memcmp_const(hash, g_sae_pt_hash, sizeof(hash)) == 0) {
+        return g_sae_pt;
+    }
+
+    esp_wpa3_free_sae_pt();
+    g_sae_pt = sae_derive_pt(g_allowed_groups, ssid->ssid, ssid->len, pw, pw_len, pwd_id);
+    if (g_sae_pt) {
+        os_memcpy(g_sae_pt_hash, hash, sizeof(hash));
+    }
+    forced_memzero(hash, sizeof(hash));
+    return g_sae_pt;
+}
+
 static esp_err_t wpa3_build_sae_commit(u8 *bssid, size_t *sae_msg_len)
 {
     int default_group = IANA_SECP256R1;
@@ -86,16 +114,17 @@ static esp_err_t wpa3_build_sae_commit(u8 *bssid, size_t *sae_msg_len)
         }
     }
 
-    if (use_pt && !g_sae_pt) {
-        g_sae_pt = sae_derive_pt(g_allowed_groups, ssid->ssid, ssid->len, pw, strlen((const char *)pw), valid_pwd_id ? sae_pwd_id : NULL);
-    }
-
     if (wpa_sta_cur_pmksa_matches_akm()) {
         wpa_printf(MSG_INFO, "wpa3: Skip SAE and use cached PMK instead");
         *sae_msg_len = 0;
         return ESP_FAIL;
     }
 
+    if (use_pt && !wpa3_get_sae_pt(ssid, pw, valid_pwd_id ? sae_pwd_id : NULL)) {
+        wpa_printf(MSG_ERROR, "wpa3: failed to derive SAE PT");
+        return ESP_FAIL;
+    }
+
     if (g_sae_commit) {
         wpabuf_free(g_sae_commit);
         g_sae_commit = NULL;
@@ -207,10 +236,15 @@ void esp_wpa3_free_sae_data(void)
         g_sae_confirm = NULL;
     }
     sae_clear_data(&g_sae_data);
+}
+
+void esp_wpa3_free_sae_pt(void)
+{
     if (g_sae_pt) {
         sae_deinit_pt(g_sae_pt);
         g_sae_pt = NULL;
     }
+    forced_memzero(g_sae_pt_hash, sizeof(g_sae_pt_hash));
 }
 
 static u8 *wpa3_build_sae_msg(u8 *bssid, u32 sae_msg_type, size_t *sae_msg_len)
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2019-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2019-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -12,6 +12,7 @@
 
 void esp_wifi_register_wpa3_cb(struct wpa_funcs *wpa_cb);
 void esp_wpa3_free_sae_data(void);
+void esp_wpa3_free_sae_pt(void);
 
 #else /* CONFIG_WPA3_SAE */
 
@@ -25,6 +26,10 @@ static inline void esp_wpa3_free_sae_data(void)
 {
 }
 
+static inline void esp_wpa3_free_sae_pt(void)
+{
+}
+
 #endif /* CONFIG_WPA3_SAE */
 
 #ifdef CONFIG_SAE
@@ -194,6 +194,7 @@ bool wpa_deattach(void)
 {
     struct wpa_sm *sm = &gWpaSm;
     esp_wpa3_free_sae_data();
+    esp_wpa3_free_sae_pt();
 #ifdef CONFIG_ESP_WIFI_ENTERPRISE_SUPPORT
     if (sm->wpa_sm_eap_disable) {
         sm->wpa_sm_eap_disable();
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
 #include <string.h>
+#include <inttypes.h>
 #include "sdkconfig.h"
 #include "esp_check.h"
 #include "esp_vfs_fat.h"
@@ -166,7 +167,7 @@ sdmmc_card_t * mount_sdcard(void)
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
 
-    ESP_LOGI(TAG, "Card size: %lluMB, speed: %dMHz",
+    ESP_LOGI(TAG, "Card size: %lluMB, speed: %" PRIu32 "MHz",
              (((uint64_t)sdmmc_card->csd.capacity) * sdmmc_card->csd.sector_size) >> 20,
              sdmmc_card->max_freq_khz / 1000);
 
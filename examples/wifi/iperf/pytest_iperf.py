@@ -32,23 +32,7 @@ NO_BANDWIDTH_LIMIT = -1  # iperf send bandwith is not limited
 BEST_PERFORMANCE_CONFIG = '99'
 
 
-@pytest.mark.esp32
-@pytest.mark.temp_skip_ci(targets=['esp32s2', 'esp32c3', 'esp32s3'], reason='lack of runners (run only for ESP32)')
-@pytest.mark.timeout(1200)
-@pytest.mark.wifi_iperf
-@pytest.mark.parametrize('config', [
-    BEST_PERFORMANCE_CONFIG
-], indirect=True)
-def test_wifi_throughput_basic(
-    dut: Dut,
-    log_performance: Callable[[str, str], None],
-    check_performance: Callable[[str, float, str], None],
-) -> None:
-    """
-    steps: |
-      1. test TCP tx rx and UDP tx rx throughput
-      2. compare with the pre-defined pass standard
-    """
+def run_wifi_throughput(dut: Dut, config: str, log_performance: Callable[[str, str], None]) -> dict:
     # 1. wait for DUT
     dut.expect('iperf>')
 
@@ -63,25 +47,64 @@ def test_wifi_throughput_basic(
     }
 
     test_result = {
-        'tcp_tx': IperfUtility.TestResult('tcp', 'tx', BEST_PERFORMANCE_CONFIG),
-        'tcp_rx': IperfUtility.TestResult('tcp', 'rx', BEST_PERFORMANCE_CONFIG),
-        'udp_tx': IperfUtility.TestResult('udp', 'tx', BEST_PERFORMANCE_CONFIG),
-        'udp_rx': IperfUtility.TestResult('udp', 'rx', BEST_PERFORMANCE_CONFIG),
+        'tcp_tx': IperfUtility.TestResult('tcp', 'tx', config),
+        'tcp_rx': IperfUtility.TestResult('tcp', 'rx', config),
+        'udp_tx': IperfUtility.TestResult('udp', 'tx', config),
+        'udp_rx': IperfUtility.TestResult('udp', 'rx', config),
     }
 
-    test_utility = IperfUtility.IperfTestUtility(dut, BEST_PERFORMANCE_CONFIG, ap_info['ssid'], ap_info['password'],
+    test_utility = IperfUtility.IperfTestUtility(dut, config, ap_info['ssid'], ap_info['password'],
                                                  pc_nic_ip, pc_iperf_log_file, test_result)
 
     # 3. run test for TCP Tx, Rx and UDP Tx, Rx
     for _ in range(RETRY_COUNT_FOR_BEST_PERFORMANCE):
         test_utility.run_all_cases(0, NO_BANDWIDTH_LIMIT)
 
-    # 4. log performance and compare with pass standard
+    # 4. log performance
     for throughput_type in test_result:
         log_performance('{}_throughput'.format(throughput_type),
                         '{:.02f} Mbps'.format(test_result[throughput_type].get_best_throughput()))
+    return test_result
+
+
+@pytest.mark.esp32
+@pytest.mark.temp_skip_ci(targets=['esp32s2', 'esp32c3', 'esp32s3'], reason='lack of runners (run only for ESP32)')
+@pytest.mark.timeout(1200)
+@pytest.mark.wifi_iperf
+@pytest.mark.parametrize('config', [
+    BEST_PERFORMANCE_CONFIG
+], indirect=True)
+def test_wifi_throughput_basic(
+    dut: Dut,
+    log_performance: Callable[[str, str], None],
+    check_performance: Callable[[str, float, str], None],
+) -> None:
+    """
+    steps: |
+      1. test TCP tx rx and UDP tx rx throughput
+      2. compare with the pre-defined pass standard
+    """
+    test_result = run_wifi_throughput(dut, BEST_PERFORMANCE_CONFIG, log_performance)
 
     # do check after logging, otherwise test will exit immediately if check fail, some performance can't be logged.
     for throughput_type in test_result:
         check_performance('{}_throughput'.format(throughput_type),
                           test_result[throughput_type].get_best_throughput(), dut.target)
+
+
+@pytest.mark.esp32
+@pytest.mark.timeout(1200)
+@pytest.mark.wifi_iperf
+@pytest.mark.parametrize('config', [
+    'core_locking'
+], indirect=True)
+def test_wifi_throughput_core_locking(
+    dut: Dut,
+    log_performance: Callable[[str, str], None],
+) -> None:
+    """
+    steps: |
+      1. test TCP tx rx and UDP tx rx throughput with the TCP/IP core locked from the Wi-Fi task
+      2. log the results to compare them with the default configuration
+    """
+    run_wifi_throughput(dut, 'core_locking', log_performance)
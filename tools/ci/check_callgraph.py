@@ -348,6 +348,41 @@ def list_refs_from_to_sections(refs: List[Reference], from_sections: List[str],
     return found
 
 
+def find_reachable_from_roots(symbols: List[Symbol], root_sections: List[str], root_patterns: List[str],
+                               to_sections: List[str]) -> List[List[Symbol]]:
+    """
+    Find the symbols in to_sections which are reachable from the root symbols over the references.
+    The roots are the symbols placed in root_sections and the symbols matching one of root_patterns.
+    The search doesn't continue past a symbol in to_sections, so only the first symbol of every offending
+    call chain is reported. Returns the chains from a root to each reported symbol.
+    """
+    roots = [sym for sym in symbols
+             if sym.section in root_sections or any(fnmatch.fnmatch(sym.name, p) for p in root_patterns)]
+    parents: Dict[Symbol, Optional[Symbol]] = {sym: None for sym in roots}
+    queue = list(roots)
+    found: List[Symbol] = []
+    while queue:
+        sym = queue.pop(0)
+        for sym_to in sym.refers_to:
+            if sym_to in parents:
+                continue
+            parents[sym_to] = sym
+            if sym_to.section in to_sections:
+                found.append(sym_to)
+            else:
+                queue.append(sym_to)
+
+    chains = []
+    for sym in found:
+        chain: List[Symbol] = []
+        node: Optional[Symbol] = sym
+        while node is not None:
+            chain.insert(0, node)
+            node = parents[node]
+        chains.append(chain)
+    return chains
+
+
 def find_files_recursive(root_path: str, ext: str) -> Generator[str, None, None]:
     for root, _, files in os.walk(root_path):
         for basename in files:
@@ -395,6 +430,33 @@ def main() -> None:
         action='store_true',
         help='If set, exits with non-zero code when any references found',
     )
+    find_reachable_parser = action_sub.add_parser(
+        'find-reachable',
+        help='List the symbols in the given target sections which are reachable from the given root symbols, '
+             'directly or through other functions, with the call chain leading to them.',
+    )
+    find_reachable_parser.add_argument(
+        '--from-sections', default='.iram0.text',
+        help='comma-separated list of sections, all the symbols placed there are roots (default: .iram0.text)'
+    )
+    find_reachable_parser.add_argument(
+        '--roots', help='comma-separated list of root symbol names, e.g. interrupt handlers. '
+                        'Wildcards are supported.'
+    )
+    find_reachable_parser.add_argument(
+        '--to-sections', default='.flash.text',
+        help='comma-separated list of target sections (default: .flash.text)'
+    )
+    find_reachable_parser.add_argument(
+        '--ignore-refs', help='Comma-separated list of symbol pairs to exclude from the references list.'
+                              'The caller and the callee are separated by a slash. '
+                              'Wildcards are supported. Example: my_lib_*/some_lib_in_flash_*.'
+    )
+    find_reachable_parser.add_argument(
+        '--exit-code',
+        action='store_true',
+        help='If set, exits with non-zero code when any symbols found',
+    )
     action_sub.add_parser(
         'all-refs',
         help='Print the list of all references',
@@ -416,12 +478,12 @@ def main() -> None:
     if not rtl_list:
         raise RuntimeError('No RTL files specified')
 
-    if args.action == 'find-refs' and args.ignore_refs:
+    if args.action in ('find-refs', 'find-reachable') and args.ignore_refs:
         ignore_pairs = [IgnorePair(pair) for pair in args.ignore_refs.split(',')]
     else:
         ignore_pairs = []
 
-    _, refs = get_symbols_and_refs(rtl_list, args.elf_file, ignore_pairs)
+    symbols, refs = get_symbols_and_refs(rtl_list, args.elf_file, ignore_pairs)
 
     if args.action == 'find-refs':
         from_sections = args.from_sections.split(',') if args.from_sections else []
@@ -431,6 +493,15 @@ def main() -> None:
         )
         if args.exit_code and found:
             raise SystemExit(1)
+    elif args.action == 'find-reachable':
+        from_sections = args.from_sections.split(',') if args.from_sections else []
+        roots = args.roots.split(',') if args.roots else []
+        to_sections = args.to_sections.split(',') if args.to_sections else []
+        chains = find_reachable_from_roots(symbols, from_sections, roots, to_sections)
+        for chain in chains:
+            print(' -> '.join('{} ({})'.format(sym.name, sym.section) for sym in chain))
+        if args.exit_code and chains:
+            raise SystemExit(1)
     elif args.action == 'all-refs':
         for r in refs:
             print(str(r))
@@ -0,0 +1,238 @@
+#
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+"""
+Selection of the flash functions to place in IRAM from an execution profile.
+
+The functions and their sizes are read from the linker map file of the application, built with -ffunction-sections
+so that each function has its own input section. The profile is a list of sampled program counters. The functions
+with the most samples per byte are selected until the IRAM budget is spent, and written as mapping fragments which
+place them with the 'noflash' scheme.
+"""
+
+import bisect
+import os
+import re
+import struct
+from typing import BinaryIO, Dict, Iterable, List, Optional, Set, TextIO, Tuple
+
+# Output sections holding code executed from flash
+FLASH_TEXT_SECTIONS = ('.flash.text',)
+
+# Input section prefixes of a function and of its literal pool (Xtensa)
+TEXT_PREFIX = '.text.'
+LITERAL_PREFIX = '.literal.'
+
+_IDENTIFIER = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+_OBJECT = re.compile(r'^[A-Za-z_][A-Za-z0-9_-]*$')
+_OUTPUT_SECTION = re.compile(r'^(\.\S+)(?:\s|$)')
+_INPUT_SECTION = re.compile(r'^\s+(\.\S+)\s*$')
+_INPUT_SECTION_LINE = re.compile(r'^\s+(\.\S+)?\s*(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S+\.a)\((\S+)\)\s*$')
+
+
+class Function:
+    """
+    A function placed in flash, with the input sections which move with it.
+    """
+
+    def __init__(self, archive: str, obj: str, symbol: str) -> None:
+        self.archive = archive
+        self.obj = obj
+        self.symbol = symbol
+        self.address = 0
+        self.text_size = 0
+        self.size = 0
+        self.samples = 0
+
+    @property
+    def density(self) -> float:
+        return self.samples / self.size if self.size else 0.0
+
+    def fragment_entry(self) -> str:
+        return '%s:%s (noflash)' % (self.obj, self.symbol)
+
+    def __repr__(self) -> str:
+        return '%s:%s:%s' % (self.archive, self.obj, self.symbol)
+
+
+def object_name(obj_file: str) -> str:
+    """
+    Name of an object file as written in the mapping fragments, e.g. 'tlsf' for 'tlsf.c.obj'
+    """
+    name, ext = os.path.splitext(obj_file)
+    if ext in ('.obj', '.o'):
+        name = os.path.splitext(name)[0]
+    return name
+
+
+def parse_map(map_file: TextIO) -> List[Function]:
+    """
+    Collect the functions placed in the flash text output sections from a GNU ld map file.
+
+    Long input section names are printed on their own line, followed by a line with the address, the size and the
+    object file.
+    """
+    functions = {}  # type: Dict[Tuple[str, str, str], Function]
+    in_flash_text = False
+    in_memory_map = False
+    pending_name = None  # type: Optional[str]
+
+    for line in map_file:
+        line = line.rstrip('\n')
+        if not in_memory_map:
+            in_memory_map = line.startswith('Linker script and memory map')
+            continue
+
+        out_match = _OUTPUT_SECTION.match(line)
+        if out_match:
+            in_flash_text = out_match.group(1) in FLASH_TEXT_SECTIONS
+            pending_name = None
+            continue
+        if not in_flash_text:
+            continue
+
+        name_match = _INPUT_SECTION.match(line)
+        if name_match:
+            pending_name = name_match.group(1)
+            continue
+
+        match = _INPUT_SECTION_LINE.match(line)
+        if not match:
+            pending_name = None
+            continue
+        name = match.group(1) or pending_name
+        pending_name = None
+        if not name:
+            continue
+
+        if name.startswith(TEXT_PREFIX):
+            symbol = name[len(TEXT_PREFIX):]
+            is_text = True
+        elif name.startswith(LITERAL_PREFIX):
+            symbol = name[len(LITERAL_PREFIX):]
+            is_text = False
+        else:
+            continue
+
+        archive = os.path.basename(match.group(4))
+        obj = object_name(match.group(5))
+        address = int(match.group(2), 16)
+        size = int(match.group(3), 16)
+        if size == 0:
+            continue
+
+        key = (archive, obj, symbol)
+        function = functions.get(key)
+        if function is None:
+            function = Function(archive, obj, symbol)
+            functions[key] = function
+        function.size += size
+        if is_text:
+            function.address = address
+            function.text_size = size
+
+    return [f for f in functions.values() if f.text_size]
+
+
+def parse_text_profile(profile_file: TextIO) -> Iterable[Tuple[int, int]]:
+    """
+    Read a text profile, one sampled address per line with an optional count: '0x42001234 [count]'.
+    Empty lines and lines starting with '#' are ignored.
+    """
+    for line in profile_file:
+        line = line.split('#', 1)[0].strip()
+        if not line:
+            continue
+        fields = line.replace(',', ' ').split()
+        count = int(fields[1]) if len(fields) > 1 else 1
+        yield int(fields[0], 16), count
+
+
+def parse_gmon_profile(profile_file: BinaryIO) -> Iterable[Tuple[int, int]]:
+    """
+    Read the histogram records of a gmon.out file, e.g. written by the 'profile' command of OpenOCD.
+    Each bucket of the histogram is attributed to its start address.
+    """
+    data = profile_file.read()
+    if data[:4] != b'gmon':
+        raise ValueError('not a gmon.out file')
+    offset = 20  # cookie, version, spare
+    while offset < len(data):
+        tag = data[offset]
+        offset += 1
+        if tag != 0:
+            # call graph and basic block records are not used
+            raise ValueError('unsupported gmon.out record %d' % tag)
+        low_pc, high_pc, hist_size, _ = struct.unpack_from('<IIII', data, offset)
+        offset += 16 + 15 + 1  # dimension and its abbreviation
+        counts = struct.unpack_from('<%dH' % hist_size, data, offset)
+        offset += 2 * hist_size
+        step = (high_pc - low_pc) / hist_size if hist_size else 0
+        for i, count in enumerate(counts):
+            if count:
+                yield low_pc + int(i * step), count
+
+
+def attribute_samples(functions: List[Function], samples: Iterable[Tuple[int, int]]) -> int:
+    """
+    Add the samples to the functions containing their address, return the total number of samples
+    """
+    by_address = sorted(functions, key=lambda f: f.address)
+    starts = [f.address for f in by_address]
+    total = 0
+    for address, count in samples:
+        total += count
+        i = bisect.bisect_right(starts, address) - 1
+        if i >= 0 and address < by_address[i].address + by_address[i].text_size:
+            by_address[i].samples += count
+    return total
+
+
+def select_functions(functions: List[Function], budget: int, min_samples: int = 1,
+                     exclude: Optional[Set[str]] = None) -> Tuple[List[Function], List[Function]]:
+    """
+    Select the functions with the most samples per byte which fit in the budget.
+
+    Returns the selected functions, hottest first, and the hot functions which can't be written in a fragment.
+    """
+    exclude = exclude or set()
+    selected = []  # type: List[Function]
+    skipped = []  # type: List[Function]
+    used = 0
+    for function in sorted(functions, key=lambda f: (-f.density, f.size)):
+        if function.samples < min_samples:
+            continue
+        if function.archive in exclude:
+            continue
+        if not _IDENTIFIER.match(function.symbol) or not _OBJECT.match(function.obj):
+            # e.g. clones like 'foo.constprop.0', which the fragment grammar can't name
+            skipped.append(function)
+            continue
+        # keep the 4 byte alignment of the IRAM sections
+        size = (function.size + 3) & ~3
+        if used + size > budget:
+            continue
+        used += size
+        selected.append(function)
+    return selected, skipped
+
+
+def write_fragments(functions: List[Function], output: TextIO, prefix: str = 'iram_profile',
+                    comment: Optional[str] = None) -> None:
+    """
+    Write one mapping fragment per archive, placing the selected functions in IRAM
+    """
+    if comment:
+        for line in comment.splitlines():
+            output.write('# %s\n' % line)
+    by_archive = {}  # type: Dict[str, List[Function]]
+    for function in functions:
+        by_archive.setdefault(function.archive, []).append(function)
+    for archive in sorted(by_archive):
+        name = re.sub(r'[^A-Za-z0-9_]', '_', '%s_%s' % (prefix, os.path.splitext(archive)[0]))
+        output.write('\n[mapping:%s]\n' % name)
+        output.write('archive: %s\n' % archive)
+        output.write('entries:\n')
+        for function in sorted(by_archive[archive], key=lambda f: (f.obj, f.symbol)):
+            output.write('    %s\n' % function.fragment_entry())
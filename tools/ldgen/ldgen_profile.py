@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+# Generates linker fragments placing the hottest flash functions of an execution profile in IRAM.
+#
+import argparse
+import sys
+
+from ldgen.profile import attribute_samples
+from ldgen.profile import parse_gmon_profile
+from ldgen.profile import parse_map
+from ldgen.profile import parse_text_profile
+from ldgen.profile import select_functions
+from ldgen.profile import write_fragments
+
+
+def main() -> None:
+    argparser = argparse.ArgumentParser(description='Place the hottest flash functions of a profile in IRAM')
+
+    argparser.add_argument(
+        '--map', '-m',
+        help='Linker map file of the profiled application',
+        type=argparse.FileType('r'),
+        required=True)
+
+    profile_group = argparser.add_mutually_exclusive_group(required=True)
+
+    profile_group.add_argument(
+        '--profile', '-p',
+        help='Text file of sampled program counters, one "address [count]" per line',
+        type=argparse.FileType('r'))
+
+    profile_group.add_argument(
+        '--gmon',
+        help='gmon.out histogram, e.g. from the "profile" command of OpenOCD',
+        type=argparse.FileType('rb'))
+
+    argparser.add_argument(
+        '--budget', '-b',
+        help='Maximum number of bytes of IRAM to use',
+        type=int,
+        required=True)
+
+    argparser.add_argument(
+        '--min-samples',
+        help='Minimum number of samples of a function to be placed in IRAM',
+        type=int,
+        default=2)
+
+    argparser.add_argument(
+        '--exclude',
+        help='Archive to leave in flash, e.g. libmain.a',
+        action='append',
+        default=[])
+
+    argparser.add_argument(
+        '--output', '-o',
+        help='Output linker fragment file',
+        type=argparse.FileType('w'),
+        required=True)
+
+    args = argparser.parse_args()
+
+    functions = parse_map(args.map)
+    if not functions:
+        print('no function found in the flash text sections of %s, is -ffunction-sections used?' % args.map.name)
+        sys.exit(1)
+
+    samples = parse_gmon_profile(args.gmon) if args.gmon else parse_text_profile(args.profile)
+    total = attribute_samples(functions, samples)
+    if total == 0:
+        print('the profile is empty')
+        sys.exit(1)
+
+    selected, skipped = select_functions(functions, args.budget, args.min_samples, set(args.exclude))
+    flash_samples = sum(f.samples for f in functions)
+    selected_samples = sum(f.samples for f in selected)
+    selected_size = sum((f.size + 3) & ~3 for f in selected)
+
+    comment = ('Generated by ldgen_profile.py, do not edit.\n'
+               '%d functions, %d bytes of IRAM, %d of the %d samples executed from flash.'
+               % (len(selected), selected_size, selected_samples, flash_samples))
+    write_fragments(selected, args.output, comment=comment)
+
+    print('%d/%d samples in flash functions, %d functions use %d bytes of IRAM and cover %.1f%% of them'
+          % (flash_samples, total, len(selected), selected_size,
+             100.0 * selected_samples / flash_samples if flash_samples else 0.0))
+    for function in skipped:
+        print('warning: %r has %d samples but can\'t be named in a fragment' % (function, function.samples))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+#
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+
+import io
+import os
+import struct
+import sys
+import unittest
+
+try:
+    from ldgen.profile import attribute_samples, parse_gmon_profile, parse_map, parse_text_profile, select_functions, write_fragments
+except ImportError:
+    sys.path.append(os.path.dirname(os.path.dirname(__file__)))
+    from ldgen.profile import attribute_samples, parse_gmon_profile, parse_map, parse_text_profile, select_functions, write_fragments
+
+
+class ProfileTest(unittest.TestCase):
+
+    def setUp(self):
+        with open(os.path.join(os.path.dirname(__file__), 'data', 'profile.map')) as map_file:
+            self.functions = parse_map(map_file)
+        self.by_name = {f.symbol: f for f in self.functions}
+
+    def add_samples(self, text):
+        return attribute_samples(self.functions, parse_text_profile(io.StringIO(text)))
+
+    def test_parse_map(self):
+        # only the functions in the flash text output section, with their literals
+        self.assertEqual({'hot_small', 'hot_large', 'tlsf_helper', 'clone.constprop.0', 'cold'}, set(self.by_name))
+        hot_small = self.by_name['hot_small']
+        self.assertEqual(('libmain.a', 'app_main'), (hot_small.archive, hot_small.obj))
+        self.assertEqual(0x400d0028, hot_small.address)
+        self.assertEqual(0x18, hot_small.text_size)
+        self.assertEqual(0x20, hot_small.size)
+        self.assertEqual(0x100, self.by_name['cold'].size)
+        self.assertEqual('tlsf', self.by_name['tlsf_helper'].obj)
+
+    def test_attribute_samples(self):
+        total = self.add_samples('# comment\n0x400d0028\n0x400d003c 3\n0x400d0040 10\n0x40080000 5\n0x400d0020\n')
+        self.assertEqual(20, total)
+        self.assertEqual(4, self.by_name['hot_small'].samples)
+        self.assertEqual(10, self.by_name['hot_large'].samples)
+        # samples in IRAM and in literal pools are not attributed
+        self.assertEqual(14, sum(f.samples for f in self.functions))
+
+    def test_select_by_density(self):
+        self.add_samples('0x400d0028 4\n0x400d0040 40\n0x400d0440 20\n0x400d0480 20\n0x400d04a0 1\n')
+        selected, skipped = select_functions(self.functions, 0x60, min_samples=2)
+        # hot_small has 4 samples in 0x20 bytes, tlsf_helper 20 in 0x40, hot_large doesn't fit
+        self.assertEqual(['clone.constprop.0'], [f.symbol for f in skipped])
+        self.assertEqual(['tlsf_helper', 'hot_small'], [f.symbol for f in selected])
+
+        selected, _ = select_functions(self.functions, 0x1000, min_samples=2)
+        self.assertEqual(['tlsf_helper', 'hot_small', 'hot_large'], [f.symbol for f in selected])
+
+        selected, _ = select_functions(self.functions, 0x1000, min_samples=2, exclude={'libmain.a'})
+        self.assertEqual(['tlsf_helper'], [f.symbol for f in selected])
+
+    def test_write_fragments(self):
+        self.add_samples('0x400d0028 4\n0x400d0440 20\n')
+        selected, _ = select_functions(self.functions, 0x1000)
+        output = io.StringIO()
+        write_fragments(selected, output, comment='test')
+        self.assertEqual('# test\n'
+                         '\n[mapping:iram_profile_libheap]\n'
+                         'archive: libheap.a\n'
+                         'entries:\n'
+                         '    tlsf:tlsf_helper (noflash)\n'
+                         '\n[mapping:iram_profile_libmain]\n'
+                         'archive: libmain.a\n'
+                         'entries:\n'
+                         '    app_main:hot_small (noflash)\n', output.getvalue())
+
+    def test_gmon(self):
+        # 8 buckets of 0x10 bytes from 0x400d0020
+        header = b'gmon' + struct.pack('<I', 1) + b'\0' * 12
+        counts = [0, 2, 0, 0, 7, 0, 0, 0]
+        hist = (b'\0' + struct.pack('<IIII', 0x400d0020, 0x400d00a0, len(counts), 100) + b'seconds'.ljust(15, b'\0')
+                + b's' + struct.pack('<%dH' % len(counts), *counts))
+        samples = list(parse_gmon_profile(io.BytesIO(header + hist)))
+        self.assertEqual([(0x400d0030, 2), (0x400d0060, 7)], samples)
+        attribute_samples(self.functions, samples)
+        self.assertEqual(2, self.by_name['hot_small'].samples)
+        self.assertEqual(7, self.by_name['hot_large'].samples)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "esp_timer.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "flash_benchmark.h"
+
+#define NVS_LABEL           "nvs_bench"
+#define NVS_KEY_COUNT       16
+#define NVS_BLOB_SIZE       256
+#define NVS_WRITE_I32_OPS   200
+#define NVS_WRITE_BLOB_OPS  100
+#define NVS_READ_BLOB_OPS   500
+
+static void nvs_key(char *key, size_t size, char prefix, uint32_t index)
+{
+    snprintf(key, size, "%c%u", prefix, (unsigned)(index % NVS_KEY_COUNT));
+}
+
+void bench_nvs(void)
+{
+    ESP_ERROR_CHECK(nvs_flash_erase_partition(NVS_LABEL));
+    int64_t t = esp_timer_get_time();
+    ESP_ERROR_CHECK(nvs_flash_init_partition(NVS_LABEL));
+    flash_bench_report_time("nvs", "mount_empty", esp_timer_get_time() - t);
+
+    nvs_handle_t handle;
+    ESP_ERROR_CHECK(nvs_open_from_partition(NVS_LABEL, "bench", NVS_READWRITE, &handle));
+    uint8_t *blob = malloc(NVS_BLOB_SIZE);
+    assert(blob != NULL);
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    flash_bench_workload_t w;
+
+    // Every value is different, so every operation writes to flash
+    flash_bench_workload_start(&w, "nvs", "write_i32", NVS_WRITE_I32_OPS);
+    for (int32_t i = 0; i < NVS_WRITE_I32_OPS; i++) {
+        nvs_key(key, sizeof(key), 'i', flash_bench_rand());
+        t = esp_timer_get_time();
+        ESP_ERROR_CHECK(nvs_set_i32(handle, key, i));
+        ESP_ERROR_CHECK(nvs_commit(handle));
+        flash_bench_workload_op(&w, t, sizeof(i));
+    }
+    flash_bench_workload_end(&w);
+
+    // The keys are written in turn, so that all of them exist for the read workload
+    flash_bench_workload_start(&w, "nvs", "write_blob", NVS_WRITE_BLOB_OPS);
+    for (int i = 0; i < NVS_WRITE_BLOB_OPS; i++) {
+        for (int j = 0; j < NVS_BLOB_SIZE; j++) {
+            blob[j] = i + j;
+        }
+        nvs_key(key, sizeof(key), 'b', i);
+        t = esp_timer_get_time();
+        ESP_ERROR_CHECK(nvs_set_blob(handle, key, blob, NVS_BLOB_SIZE));
+        ESP_ERROR_CHECK(nvs_commit(handle));
+        flash_bench_workload_op(&w, t, NVS_BLOB_SIZE);
+    }
+    flash_bench_workload_end(&w);
+
+    flash_bench_workload_start(&w, "nvs", "read_blob", NVS_READ_BLOB_OPS);
+    for (int i = 0; i < NVS_READ_BLOB_OPS; i++) {
+        nvs_key(key, sizeof(key), 'b', flash_bench_rand());
+        size_t size = NVS_BLOB_SIZE;
+        t = esp_timer_get_time();
+        ESP_ERROR_CHECK(nvs_get_blob(handle, key, blob, &size));
+        flash_bench_workload_op(&w, t, size);
+    }
+    flash_bench_workload_end(&w);
+
+    nvs_close(handle);
+    ESP_ERROR_CHECK(nvs_flash_deinit_partition(NVS_LABEL));
+
+    t = esp_timer_get_time();
+    ESP_ERROR_CHECK(nvs_flash_init_partition(NVS_LABEL));
+    flash_bench_report_time("nvs", "mount", esp_timer_get_time() - t);
+
+    free(blob);
+    ESP_ERROR_CHECK(nvs_flash_deinit_partition(NVS_LABEL));
+    ESP_ERROR_CHECK(nvs_flash_erase_partition(NVS_LABEL));
+}
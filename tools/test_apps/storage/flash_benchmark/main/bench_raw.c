@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "flash_benchmark.h"
+
+#define RAW_LABEL           "raw"
+#define RAW_SECTOR_SIZE     4096
+#define RAW_RAND_READ_SIZE  512
+#define RAW_RAND_READ_OPS   256
+#define RAW_RAND_WRITE_OPS  64
+#define RAW_APPEND_SIZE     256
+
+void bench_raw(void)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, RAW_LABEL);
+    assert(part != NULL);
+    const size_t sectors = part->size / RAW_SECTOR_SIZE;
+    uint8_t *buf = malloc(RAW_SECTOR_SIZE);
+    assert(buf != NULL);
+    for (int i = 0; i < RAW_SECTOR_SIZE; i++) {
+        buf[i] = i;
+    }
+    flash_bench_workload_t w;
+
+    // Each sector is erased right before it is written
+    flash_bench_workload_start(&w, "raw", "seq_write", sectors);
+    for (size_t i = 0; i < sectors; i++) {
+        int64_t t = esp_timer_get_time();
+        ESP_ERROR_CHECK(esp_partition_erase_range(part, i * RAW_SECTOR_SIZE, RAW_SECTOR_SIZE));
+        ESP_ERROR_CHECK(esp_partition_write(part, i * RAW_SECTOR_SIZE, buf, RAW_SECTOR_SIZE));
+        flash_bench_workload_op(&w, t, RAW_SECTOR_SIZE);
+    }
+    flash_bench_workload_end(&w);
+
+    flash_bench_workload_start(&w, "raw", "seq_read", sectors);
+    for (size_t i = 0; i < sectors; i++) {
+        int64_t t = esp_timer_get_time();
+        ESP_ERROR_CHECK(esp_partition_read(part, i * RAW_SECTOR_SIZE, buf, RAW_SECTOR_SIZE));
+        flash_bench_workload_op(&w, t, RAW_SECTOR_SIZE);
+    }
+    flash_bench_workload_end(&w);
+
+    flash_bench_workload_start(&w, "raw", "rand_read", RAW_RAND_READ_OPS);
+    for (int i = 0; i < RAW_RAND_READ_OPS; i++) {
+        size_t offset = (flash_bench_rand() % (part->size / RAW_RAND_READ_SIZE)) * RAW_RAND_READ_SIZE;
+        int64_t t = esp_timer_get_time();
+        ESP_ERROR_CHECK(esp_partition_read(part, offset, buf, RAW_RAND_READ_SIZE));
+        flash_bench_workload_op(&w, t, RAW_RAND_READ_SIZE);
+    }
+    flash_bench_workload_end(&w);
+
+    flash_bench_workload_start(&w, "raw", "rand_write", RAW_RAND_WRITE_OPS);
+    for (int i = 0; i < RAW_RAND_WRITE_OPS; i++) {
+        size_t offset = (flash_bench_rand() % sectors) * RAW_SECTOR_SIZE;
+        int64_t t = esp_timer_get_time();
+        ESP_ERROR_CHECK(esp_partition_erase_range(part, offset, RAW_SECTOR_SIZE));
+        ESP_ERROR_CHECK(esp_partition_write(part, offset, buf, RAW_SECTOR_SIZE));
+        flash_bench_workload_op(&w, t, RAW_SECTOR_SIZE);
+    }
+    flash_bench_workload_end(&w);
+
+    // Log records written into erased flash, the way a simple data logger would do
+    ESP_ERROR_CHECK(esp_partition_erase_range(part, 0, part->size));
+    const size_t records = part->size / RAW_APPEND_SIZE / 2;
+    flash_bench_workload_start(&w, "raw", "append", records);
+    for (size_t i = 0; i < records; i++) {
+        int64_t t = esp_timer_get_time();
+        ESP_ERROR_CHECK(esp_partition_write(part, i * RAW_APPEND_SIZE, buf, RAW_APPEND_SIZE));
+        flash_bench_workload_op(&w, t, RAW_APPEND_SIZE);
+    }
+    flash_bench_workload_end(&w);
+
+    free(buf);
+}
@@ -0,0 +1,187 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "esp_vfs_fat.h"
+#include "esp_spiffs.h"
+#include "flash_benchmark.h"
+
+#define FILE_SIZE           (128 * 1024)
+#define SEQ_CHUNK_SIZE      4096
+#define RAND_CHUNK_SIZE     512
+#define RAND_READ_OPS       256
+#define RAND_WRITE_OPS      64
+#define APPEND_RECORD_SIZE  128
+#define APPEND_OPS          256
+
+/* File system on the partition with the given label */
+typedef struct {
+    const char *name;
+    const char *label;
+    const char *file_path;
+    void (*mount)(void);
+    void (*unmount)(void);
+} vfs_backend_t;
+
+static void erase_partition(const char *label)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    assert(part != NULL);
+    ESP_ERROR_CHECK(esp_partition_erase_range(part, 0, part->size));
+}
+
+/* Time of one read or write of a file, at offset unless it is negative. The latency includes fsync if do_sync is set. */
+static void file_op(flash_bench_workload_t *w, int fd, off_t offset, void *buf, size_t size, bool is_write, bool do_sync)
+{
+    int64_t t = esp_timer_get_time();
+    if (offset >= 0) {
+        off_t pos = lseek(fd, offset, SEEK_SET);
+        assert(pos == offset);
+    }
+    ssize_t len = is_write ? write(fd, buf, size) : read(fd, buf, size);
+    assert(len == (ssize_t)size);
+    if (do_sync) {
+        int err = fsync(fd);
+        assert(err == 0);
+    }
+    flash_bench_workload_op(w, t, size);
+}
+
+static void bench_vfs(const vfs_backend_t *fs)
+{
+    erase_partition(fs->label);
+    int64_t t = esp_timer_get_time();
+    fs->mount();
+    flash_bench_report_time(fs->name, "mount_format", esp_timer_get_time() - t);
+
+    uint8_t *buf = malloc(SEQ_CHUNK_SIZE);
+    assert(buf != NULL);
+    for (int i = 0; i < SEQ_CHUNK_SIZE; i++) {
+        buf[i] = i;
+    }
+    flash_bench_workload_t w;
+
+    int fd = open(fs->file_path, O_WRONLY | O_CREAT | O_TRUNC);
+    assert(fd >= 0);
+    flash_bench_workload_start(&w, fs->name, "seq_write", FILE_SIZE / SEQ_CHUNK_SIZE);
+    for (size_t i = 0; i < FILE_SIZE / SEQ_CHUNK_SIZE; i++) {
+        // The data only has to be on flash once the whole file is written
+        file_op(&w, fd, -1, buf, SEQ_CHUNK_SIZE, true, i == FILE_SIZE / SEQ_CHUNK_SIZE - 1);
+    }
+    flash_bench_workload_end(&w);
+    close(fd);
+
+    fd = open(fs->file_path, O_RDONLY);
+    assert(fd >= 0);
+    flash_bench_workload_start(&w, fs->name, "seq_read", FILE_SIZE / SEQ_CHUNK_SIZE);
+    for (size_t i = 0; i < FILE_SIZE / SEQ_CHUNK_SIZE; i++) {
+        file_op(&w, fd, -1, buf, SEQ_CHUNK_SIZE, false, false);
+    }
+    flash_bench_workload_end(&w);
+
+    flash_bench_workload_start(&w, fs->name, "rand_read", RAND_READ_OPS);
+    for (int i = 0; i < RAND_READ_OPS; i++) {
+        off_t offset = (flash_bench_rand() % (FILE_SIZE / RAND_CHUNK_SIZE)) * RAND_CHUNK_SIZE;
+        file_op(&w, fd, offset, buf, RAND_CHUNK_SIZE, false, false);
+    }
+    flash_bench_workload_end(&w);
+    close(fd);
+
+    fd = open(fs->file_path, O_RDWR);
+    assert(fd >= 0);
+    flash_bench_workload_start(&w, fs->name, "rand_write_sync", RAND_WRITE_OPS);
+    for (int i = 0; i < RAND_WRITE_OPS; i++) {
+        off_t offset = (flash_bench_rand() % (FILE_SIZE / RAND_CHUNK_SIZE)) * RAND_CHUNK_SIZE;
+        file_op(&w, fd, offset, buf, RAND_CHUNK_SIZE, true, true);
+    }
+    flash_bench_workload_end(&w);
+    close(fd);
+    unlink(fs->file_path);
+
+    // Records appended to a log file, each of them has to be on flash before the next one
+    fd = open(fs->file_path, O_WRONLY | O_CREAT | O_APPEND);
+    assert(fd >= 0);
+    flash_bench_workload_start(&w, fs->name, "append_sync", APPEND_OPS);
+    for (int i = 0; i < APPEND_OPS; i++) {
+        file_op(&w, fd, -1, buf, APPEND_RECORD_SIZE, true, true);
+    }
+    flash_bench_workload_end(&w);
+    close(fd);
+
+    fs->unmount();
+    t = esp_timer_get_time();
+    fs->mount();
+    flash_bench_report_time(fs->name, "mount", esp_timer_get_time() - t);
+
+    free(buf);
+    unlink(fs->file_path);
+    fs->unmount();
+}
+
+/* ------------------------------------------------------ FATFS ----------------------------------------------------- */
+
+static wl_handle_t s_wl_handle = WL_INVALID_HANDLE;
+
+static void fatfs_mount(void)
+{
+    const esp_vfs_fat_mount_config_t mount_config = {
+        .max_files = 2,
+        .format_if_mount_failed = true,
+        .allocation_unit_size = CONFIG_WL_SECTOR_SIZE,
+    };
+    ESP_ERROR_CHECK(esp_vfs_fat_spiflash_mount_rw_wl("/fatfs", "fatfs", &mount_config, &s_wl_handle));
+}
+
+static void fatfs_unmount(void)
+{
+    ESP_ERROR_CHECK(esp_vfs_fat_spiflash_unmount_rw_wl("/fatfs", s_wl_handle));
+}
+
+void bench_fatfs(void)
+{
+    const vfs_backend_t fs = {
+        .name = "fatfs",
+        .label = "fatfs",
+        .file_path = "/fatfs/bench.bin",
+        .mount = fatfs_mount,
+        .unmount = fatfs_unmount,
+    };
+    bench_vfs(&fs);
+}
+
+/* ----------------------------------------------------- SPIFFS ----------------------------------------------------- */
+
+static void spiffs_mount(void)
+{
+    const esp_vfs_spiffs_conf_t conf = {
+        .partition_label = "spiffs",
+        .max_files = 2,
+        .format_if_mount_failed = true,
+    };
+    ESP_ERROR_CHECK(esp_vfs_spiffs_register(&conf));
+}
+
+static void spiffs_unmount(void)
+{
+    ESP_ERROR_CHECK(esp_vfs_spiffs_unregister("spiffs"));
+}
+
+void bench_spiffs(void)
+{
+    const vfs_backend_t fs = {
+        .name = "spiffs",
+        .label = "spiffs",
+        .file_path = "/spiffs/bench.bin",
+        .mount = spiffs_mount,
+        .unmount = spiffs_unmount,
+    };
+    bench_vfs(&fs);
+}
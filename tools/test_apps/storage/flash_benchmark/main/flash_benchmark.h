@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Measurements of one workload: a sequence of operations of the same kind
+ *
+ * The latency of each operation is kept to compute percentiles, and the flash
+ * operation counters are reset at the start of the workload.
+ */
+typedef struct {
+    const char *backend;        /*!< "raw", "nvs", "fatfs" or "spiffs" */
+    const char *workload;       /*!< e.g. "seq_write" */
+    uint32_t *latency_us;       /*!< latency of each operation */
+    size_t max_ops;             /*!< number of elements of latency_us */
+    size_t ops;                 /*!< number of operations recorded */
+    uint64_t bytes;             /*!< number of bytes of data transferred by the operations */
+    int64_t start_us;           /*!< time of the start of the workload */
+} flash_bench_workload_t;
+
+/* Start a workload of at most max_ops operations */
+void flash_bench_workload_start(flash_bench_workload_t *w, const char *backend, const char *workload, size_t max_ops);
+
+/* Record an operation which started at op_start_us and transferred bytes of data */
+void flash_bench_workload_op(flash_bench_workload_t *w, int64_t op_start_us, size_t bytes);
+
+/* Print the results of the workload as a JSON object, which is parsed by pytest_flash_benchmark.py */
+void flash_bench_workload_end(flash_bench_workload_t *w);
+
+/* Print the duration of a single operation, e.g. mounting a file system */
+void flash_bench_report_time(const char *backend, const char *workload, int64_t us);
+
+/* Deterministic pseudo-random numbers, so that every run does the same operations */
+uint32_t flash_bench_rand(void);
+
+void bench_raw(void);
+void bench_nvs(void);
+void bench_fatfs(void);
+void bench_spiffs(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sdkconfig.h"
+#include "esp_idf_version.h"
+#include "esp_flash.h"
+#include "esp_timer.h"
+#include "spi_flash_mmap.h"
+#include "flash_benchmark.h"
+
+#if CONFIG_ESPTOOLPY_FLASHMODE_QIO
+#define FLASH_MODE  "qio"
+#elif CONFIG_ESPTOOLPY_FLASHMODE_QOUT
+#define FLASH_MODE  "qout"
+#elif CONFIG_ESPTOOLPY_FLASHMODE_DIO
+#define FLASH_MODE  "dio"
+#elif CONFIG_ESPTOOLPY_FLASHMODE_DOUT
+#define FLASH_MODE  "dout"
+#else
+#define FLASH_MODE  "opi"
+#endif
+
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+#define ERASE_COUNTERS  "true"
+#else
+#define ERASE_COUNTERS  "false"
+#endif
+
+typedef struct {
+    const char *name;
+    void (*func)(void);
+} benchmark_t;
+
+static const benchmark_t s_benchmarks[] = {
+    { "raw",    bench_raw },
+    { "nvs",    bench_nvs },
+    { "fatfs",  bench_fatfs },
+    { "spiffs", bench_spiffs },
+};
+
+static uint32_t s_rand_state = 1;
+
+uint32_t flash_bench_rand(void)
+{
+    // xorshift32
+    s_rand_state ^= s_rand_state << 13;
+    s_rand_state ^= s_rand_state >> 17;
+    s_rand_state ^= s_rand_state << 5;
+    return s_rand_state;
+}
+
+void flash_bench_workload_start(flash_bench_workload_t *w, const char *backend, const char *workload, size_t max_ops)
+{
+    *w = (flash_bench_workload_t) {
+        .backend = backend,
+        .workload = workload,
+        .latency_us = calloc(max_ops, sizeof(uint32_t)),
+        .max_ops = max_ops,
+    };
+    assert(w->latency_us != NULL);
+    s_rand_state = 1;
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+    esp_flash_reset_counters();
+#endif
+    w->start_us = esp_timer_get_time();
+}
+
+void flash_bench_workload_op(flash_bench_workload_t *w, int64_t op_start_us, size_t bytes)
+{
+    assert(w->ops < w->max_ops);
+    w->latency_us[w->ops++] = esp_timer_get_time() - op_start_us;
+    w->bytes += bytes;
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    const uint32_t x = *(const uint32_t *)a;
+    const uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted values */
+static uint32_t percentile(const uint32_t *sorted, size_t count, int p)
+{
+    size_t rank = (count * p + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void flash_bench_workload_end(flash_bench_workload_t *w)
+{
+    const int64_t total_us = esp_timer_get_time() - w->start_us;
+    uint32_t erase_count = 0;
+    uint32_t erase_bytes = 0;
+    uint32_t write_bytes = 0;
+#if CONFIG_SPI_FLASH_ENABLE_COUNTERS
+    const esp_flash_counters_t *counters = esp_flash_get_counters();
+    erase_count = counters->erase.count;
+    erase_bytes = counters->erase.bytes;
+    write_bytes = counters->write.bytes;
+#endif
+    assert(w->ops > 0);
+    qsort(w->latency_us, w->ops, sizeof(uint32_t), compare_u32);
+
+    printf("[flash_benchmark] {\"backend\": \"%s\", \"workload\": \"%s\", \"ops\": %u, \"bytes\": %" PRIu64 ", "
+           "\"total_us\": %" PRId64 ", \"kib_per_s\": %.2f, "
+           "\"latency_us\": {\"p50\": %" PRIu32 ", \"p90\": %" PRIu32 ", \"p99\": %" PRIu32 ", \"max\": %" PRIu32 "}, "
+           "\"flash_erase_count\": %" PRIu32 ", \"flash_erase_bytes\": %" PRIu32 ", \"flash_write_bytes\": %" PRIu32 "}\n",
+           w->backend, w->workload, (unsigned) w->ops, w->bytes,
+           total_us, (double)w->bytes * 1000000.0 / 1024.0 / (double)total_us,
+           percentile(w->latency_us, w->ops, 50), percentile(w->latency_us, w->ops, 90),
+           percentile(w->latency_us, w->ops, 99), w->latency_us[w->ops - 1],
+           erase_count, erase_bytes, write_bytes);
+    free(w->latency_us);
+    w->latency_us = NULL;
+}
+
+void flash_bench_report_time(const char *backend, const char *workload, int64_t us)
+{
+    printf("[flash_benchmark] {\"backend\": \"%s\", \"workload\": \"%s\", \"total_us\": %" PRId64 "}\n",
+           backend, workload, us);
+}
+
+void app_main(void)
+{
+    uint32_t flash_id = 0;
+    uint32_t flash_size = 0;
+    ESP_ERROR_CHECK(esp_flash_read_id(NULL, &flash_id));
+    ESP_ERROR_CHECK(esp_flash_get_physical_size(NULL, &flash_size));
+    printf("[flash_benchmark_info] {\"target\": \"%s\", \"idf_version\": \"%s\", \"cpu_freq_mhz\": %d, "
+           "\"flash_id\": \"0x%06" PRIx32 "\", \"flash_size\": %" PRIu32 ", \"flash_mode\": \"%s\", \"flash_freq\": \"%s\", "
+           "\"erase_counters\": " ERASE_COUNTERS "}\n",
+           CONFIG_IDF_TARGET, esp_get_idf_version(), CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+           flash_id, flash_size, FLASH_MODE, CONFIG_ESPTOOLPY_FLASHFREQ);
+
+    for (int i = 0; i < sizeof(s_benchmarks) / sizeof(s_benchmarks[0]); i++) {
+        printf("Running %s benchmarks\n", s_benchmarks[i].name);
+        s_benchmarks[i].func();
+    }
+    printf("[flash_benchmark] done\n");
+}
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_netif.h"
+#include "lwip/sockets.h"
+#include "perf_benchmarks.h"
+
+#define LWIP_CHUNK_SIZE     1460
+#define LWIP_TOTAL_SIZE     (512 * 1024)
+
+typedef struct {
+    int listen_sock;
+    SemaphoreHandle_t done;
+} lwip_bench_t;
+
+static void tcp_sink_task(void *arg)
+{
+    lwip_bench_t *bench = (lwip_bench_t *)arg;
+    uint8_t *buf = malloc(LWIP_CHUNK_SIZE);
+    assert(buf != NULL);
+
+    int sock = accept(bench->listen_sock, NULL, NULL);
+    assert(sock >= 0);
+    size_t received = 0;
+    while (received < LWIP_TOTAL_SIZE) {
+        int len = recv(sock, buf, LWIP_CHUNK_SIZE, 0);
+        if (len <= 0) {
+            break;
+        }
+        received += len;
+    }
+    close(sock);
+    free(buf);
+    xSemaphoreGive(bench->done);
+    vTaskDelete(NULL);
+}
+
+void bench_lwip(void)
+{
+    ESP_ERROR_CHECK(esp_netif_init());
+
+    lwip_bench_t bench = {
+        .listen_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_IP),
+        .done = xSemaphoreCreateBinary(),
+    };
+    assert(bench.listen_sock >= 0 && bench.done != NULL);
+
+    // Let the stack pick a free port
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+        .sin_port = 0,
+    };
+    socklen_t addr_len = sizeof(addr);
+    int ret = bind(bench.listen_sock, (struct sockaddr *)&addr, sizeof(addr));
+    ret |= getsockname(bench.listen_sock, (struct sockaddr *)&addr, &addr_len);
+    ret |= listen(bench.listen_sock, 1);
+    assert(ret == 0);
+
+    xTaskCreate(tcp_sink_task, "tcp_sink", 3072, &bench, uxTaskPriorityGet(NULL), NULL);
+
+    int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+    assert(sock >= 0);
+    ret = connect(sock, (struct sockaddr *)&addr, sizeof(addr));
+    assert(ret == 0);
+
+    uint8_t *buf = calloc(1, LWIP_CHUNK_SIZE);
+    assert(buf != NULL);
+    int64_t start = esp_timer_get_time();
+    for (size_t sent = 0; sent < LWIP_TOTAL_SIZE;) {
+        size_t len = LWIP_TOTAL_SIZE - sent;
+        len = (len < LWIP_CHUNK_SIZE) ? len : LWIP_CHUNK_SIZE;
+        int written = send(sock, buf, len, 0);
+        assert(written > 0);
+        sent += written;
+    }
+    xSemaphoreTake(bench.done, portMAX_DELAY);
+    int64_t us = esp_timer_get_time() - start;
+    perf_benchmark_report("lwip_tcp_loopback_throughput", perf_benchmark_kib_per_s(LWIP_TOTAL_SIZE, us), "KiB/s");
+
+    free(buf);
+    close(sock);
+    close(bench.listen_sock);
+    vTaskDelay(1); // let the sink task delete itself
+    vSemaphoreDelete(bench.done);
+}
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "esp_timer.h"
+#include "esp_vfs_fat.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "perf_benchmarks.h"
+
+/* ------------------------------------------------------- NVS ------------------------------------------------------ */
+
+#define NVS_SET_ITERATIONS  100
+#define NVS_GET_ITERATIONS  1000
+
+void bench_nvs(void)
+{
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        err = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(err);
+
+    nvs_handle_t handle;
+    ESP_ERROR_CHECK(nvs_open("bench", NVS_READWRITE, &handle));
+
+    // Every value is different, so every iteration writes to flash
+    int64_t start = esp_timer_get_time();
+    for (int32_t i = 0; i < NVS_SET_ITERATIONS; i++) {
+        ESP_ERROR_CHECK(nvs_set_i32(handle, "value", i));
+        ESP_ERROR_CHECK(nvs_commit(handle));
+    }
+    int64_t us = esp_timer_get_time() - start;
+    perf_benchmark_report("nvs_set_i32_commit", (double)us / NVS_SET_ITERATIONS, "us");
+
+    int32_t value;
+    start = esp_timer_get_time();
+    for (int i = 0; i < NVS_GET_ITERATIONS; i++) {
+        ESP_ERROR_CHECK(nvs_get_i32(handle, "value", &value));
+    }
+    us = esp_timer_get_time() - start;
+    perf_benchmark_report("nvs_get_i32", (double)us / NVS_GET_ITERATIONS, "us");
+
+    ESP_ERROR_CHECK(nvs_erase_all(handle));
+    ESP_ERROR_CHECK(nvs_commit(handle));
+    nvs_close(handle);
+    ESP_ERROR_CHECK(nvs_flash_deinit());
+}
+
+/* ------------------------------------------------------ FATFS ----------------------------------------------------- */
+
+#define FATFS_BASE_PATH     "/bench"
+#define FATFS_FILE_PATH     FATFS_BASE_PATH "/bench.bin"
+#define FATFS_CHUNK_SIZE    4096
+#define FATFS_FILE_SIZE     (128 * 1024)
+
+void bench_fatfs(void)
+{
+    wl_handle_t wl_handle;
+    const esp_vfs_fat_mount_config_t mount_config = {
+        .max_files = 2,
+        .format_if_mount_failed = true,
+        .allocation_unit_size = CONFIG_WL_SECTOR_SIZE,
+    };
+    ESP_ERROR_CHECK(esp_vfs_fat_spiflash_mount_rw_wl(FATFS_BASE_PATH, "storage", &mount_config, &wl_handle));
+
+    uint8_t *buf = malloc(FATFS_CHUNK_SIZE);
+    assert(buf != NULL);
+    for (int i = 0; i < FATFS_CHUNK_SIZE; i++) {
+        buf[i] = i;
+    }
+
+    int64_t start = esp_timer_get_time();
+    FILE *f = fopen(FATFS_FILE_PATH, "wb");
+    assert(f != NULL);
+    for (size_t written = 0; written < FATFS_FILE_SIZE; written += FATFS_CHUNK_SIZE) {
+        size_t ret = fwrite(buf, 1, FATFS_CHUNK_SIZE, f);
+        assert(ret == FATFS_CHUNK_SIZE);
+    }
+    fflush(f);
+    fsync(fileno(f));
+    fclose(f);
+    int64_t us = esp_timer_get_time() - start;
+    perf_benchmark_report("fatfs_write_throughput", perf_benchmark_kib_per_s(FATFS_FILE_SIZE, us), "KiB/s");
+
+    start = esp_timer_get_time();
+    f = fopen(FATFS_FILE_PATH, "rb");
+    assert(f != NULL);
+    for (size_t read = 0; read < FATFS_FILE_SIZE; read += FATFS_CHUNK_SIZE) {
+        size_t ret = fread(buf, 1, FATFS_CHUNK_SIZE, f);
+        assert(ret == FATFS_CHUNK_SIZE);
+    }
+    fclose(f);
+    us = esp_timer_get_time() - start;
+    perf_benchmark_report("fatfs_read_throughput", perf_benchmark_kib_per_s(FATFS_FILE_SIZE, us), "KiB/s");
+
+    free(buf);
+    unlink(FATFS_FILE_PATH);
+    ESP_ERROR_CHECK(esp_vfs_fat_spiflash_unmount_rw_wl(FATFS_BASE_PATH, wl_handle));
+}
@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/ringbuf.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_event.h"
+#include "perf_benchmarks.h"
+
+/* ------------------------------------------------------ Heap ------------------------------------------------------ */
+
+#define HEAP_ITERATIONS 1000
+
+static void bench_heap_size(size_t size, const char *name)
+{
+    esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+    for (int i = 0; i < HEAP_ITERATIONS; i++) {
+        void *p = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+        assert(p != NULL);
+        heap_caps_free(p);
+    }
+    esp_cpu_cycle_count_t cycles = esp_cpu_get_cycle_count() - start;
+    perf_benchmark_report(name, (double)cycles / HEAP_ITERATIONS, "cycles");
+}
+
+void bench_heap(void)
+{
+    bench_heap_size(32, "heap_malloc_free_32");
+    bench_heap_size(1024, "heap_malloc_free_1024");
+}
+
+/* ------------------------------------------------------ Queue ----------------------------------------------------- */
+
+#define QUEUE_ITERATIONS 1000
+
+typedef struct {
+    QueueHandle_t request;
+    QueueHandle_t response;
+} echo_queues_t;
+
+static void queue_echo_task(void *arg)
+{
+    echo_queues_t *queues = (echo_queues_t *)arg;
+    uint32_t item;
+
+    for (int i = 0; i < QUEUE_ITERATIONS; i++) {
+        xQueueReceive(queues->request, &item, portMAX_DELAY);
+        xQueueSend(queues->response, &item, portMAX_DELAY);
+    }
+    vTaskDelete(NULL);
+}
+
+void bench_queue(void)
+{
+    echo_queues_t queues = {
+        .request = xQueueCreate(1, sizeof(uint32_t)),
+        .response = xQueueCreate(1, sizeof(uint32_t)),
+    };
+    assert(queues.request != NULL && queues.response != NULL);
+    uint32_t item = 0;
+
+    // Send and receive from the same task, without blocking
+    esp_cpu_cycle_count_t start = esp_cpu_get_cycle_count();
+    for (int i = 0; i < QUEUE_ITERATIONS; i++) {
+        xQueueSend(queues.request, &item, 0);
+        xQueueReceive(queues.request, &item, 0);
+    }
+    esp_cpu_cycle_count_t cycles = esp_cpu_get_cycle_count() - start;
+    perf_benchmark_report("queue_send_receive", (double)cycles / QUEUE_ITERATIONS, "cycles");
+
+    // Round trip through a task of higher priority, which includes two context switches
+    TaskHandle_t echo_task;
+    xTaskCreatePinnedToCore(queue_echo_task, "echo", 2048, &queues, uxTaskPriorityGet(NULL) + 1, &echo_task, xPortGetCoreID());
+    int64_t start_us = esp_timer_get_time();
+    for (int i = 0; i < QUEUE_ITERATIONS; i++) {
+        xQueueSend(queues.request, &item, portMAX_DELAY);
+        xQueueReceive(queues.response, &item, portMAX_DELAY);
+    }
+    int64_t us = esp_timer_get_time() - start_us;
+    perf_benchmark_report("queue_round_trip", (double)us / QUEUE_ITERATIONS, "us");
+
+    vTaskDelay(1); // let the echo task delete itself
+    vQueueDelete(queues.request);
+    vQueueDelete(queues.response);
+}
+
+/* ---------------------------------------------------- esp_event --------------------------------------------------- */
+
+#define EVENT_ITERATIONS 500
+
+ESP_EVENT_DEFINE_BASE(BENCH_EVENT);
+
+typedef struct {
+    SemaphoreHandle_t done;
+    int64_t latency_sum;
+} event_bench_t;
+
+static void event_handler(void *arg, esp_event_base_t base, int32_t id, void *data)
+{
+    event_bench_t *bench = (event_bench_t *)arg;
+    bench->latency_sum += esp_timer_get_time() - *(int64_t *)data;
+    xSemaphoreGive(bench->done);
+}
+
+void bench_event(void)
+{
+    event_bench_t bench = {
+        .done = xSemaphoreCreateBinary(),
+    };
+    assert(bench.done != NULL);
+
+    esp_event_loop_handle_t loop;
+    const esp_event_loop_args_t loop_args = {
+        .queue_size = 4,
+        .task_name = "bench_evt",
+        .task_priority = uxTaskPriorityGet(NULL) + 1,
+        .task_stack_size = 3072,
+        .task_core_id = xPortGetCoreID(),
+    };
+    ESP_ERROR_CHECK(esp_event_loop_create(&loop_args, &loop));
+    ESP_ERROR_CHECK(esp_event_handler_register_with(loop, BENCH_EVENT, 0, event_handler, &bench));
+
+    for (int i = 0; i < EVENT_ITERATIONS; i++) {
+        int64_t posted = esp_timer_get_time();
+        ESP_ERROR_CHECK(esp_event_post_to(loop, BENCH_EVENT, 0, &posted, sizeof(posted), portMAX_DELAY));
+        xSemaphoreTake(bench.done, portMAX_DELAY);
+    }
+    perf_benchmark_report("esp_event_post_dispatch_latency", (double)bench.latency_sum / EVENT_ITERATIONS, "us");
+
+    ESP_ERROR_CHECK(esp_event_loop_delete(loop));
+    vSemaphoreDelete(bench.done);
+}
+
+/* ---------------------------------------------------- esp_timer --------------------------------------------------- */
+
+#define TIMER_PERIOD_US     1000
+#define TIMER_ITERATIONS    500
+
+typedef struct {
+    SemaphoreHandle_t done;
+    int count;
+    int64_t timestamps[TIMER_ITERATIONS + 1];
+} timer_bench_t;
+
+static void timer_callback(void *arg)
+{
+    timer_bench_t *bench = (timer_bench_t *)arg;
+    if (bench->count <= TIMER_ITERATIONS) {
+        bench->timestamps[bench->count++] = esp_timer_get_time();
+        if (bench->count > TIMER_ITERATIONS) {
+            xSemaphoreGive(bench->done);
+        }
+    }
+}
+
+void bench_timer(void)
+{
+    timer_bench_t *bench = calloc(1, sizeof(timer_bench_t));
+    assert(bench != NULL);
+    bench->done = xSemaphoreCreateBinary();
+    assert(bench->done != NULL);
+
+    esp_timer_handle_t timer;
+    const esp_timer_create_args_t timer_args = {
+        .callback = timer_callback,
+        .arg = bench,
+        .name = "bench",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &timer));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(timer, TIMER_PERIOD_US));
+    xSemaphoreTake(bench->done, portMAX_DELAY);
+    ESP_ERROR_CHECK(esp_timer_stop(timer));
+    ESP_ERROR_CHECK(esp_timer_delete(timer));
+
+    // Jitter is the difference between the measured and the configured period
+    int64_t jitter_sum = 0;
+    int64_t jitter_max = 0;
+    for (int i = 1; i <= TIMER_ITERATIONS; i++) {
+        int64_t jitter = llabs(bench->timestamps[i] - bench->timestamps[i - 1] - TIMER_PERIOD_US);
+        jitter_sum += jitter;
+        jitter_max = (jitter > jitter_max) ? jitter : jitter_max;
+    }
+    perf_benchmark_report("esp_timer_jitter_avg", (double)jitter_sum / TIMER_ITERATIONS, "us");
+    perf_benchmark_report("esp_timer_jitter_max", (double)jitter_max, "us");
+
+    vSemaphoreDelete(bench->done);
+    free(bench);
+}
+
+/* ----------------------------------------------------- Ringbuf ---------------------------------------------------- */
+
+#define RINGBUF_SIZE        4096
+#define RINGBUF_ITEM_SIZE   128
+#define RINGBUF_TOTAL_SIZE  (256 * 1024)
+
+typedef struct {
+    RingbufHandle_t ringbuf;
+    SemaphoreHandle_t done;
+} ringbuf_bench_t;
+
+static void ringbuf_consumer_task(void *arg)
+{
+    ringbuf_bench_t *bench = (ringbuf_bench_t *)arg;
+    size_t received = 0;
+
+    while (received < RINGBUF_TOTAL_SIZE) {
+        size_t size;
+        void *item = xRingbufferReceive(bench->ringbuf, &size, portMAX_DELAY);
+        received += size;
+        vRingbufferReturnItem(bench->ringbuf, item);
+    }
+    xSemaphoreGive(bench->done);
+    vTaskDelete(NULL);
+}
+
+void bench_ringbuf(void)
+{
+    ringbuf_bench_t bench = {
+        .ringbuf = xRingbufferCreate(RINGBUF_SIZE, RINGBUF_TYPE_NOSPLIT),
+        .done = xSemaphoreCreateBinary(),
+    };
+    assert(bench.ringbuf != NULL && bench.done != NULL);
+    static uint8_t item[RINGBUF_ITEM_SIZE];
+
+    xTaskCreate(ringbuf_consumer_task, "consumer", 2048, &bench, uxTaskPriorityGet(NULL), NULL);
+    int64_t start = esp_timer_get_time();
+    for (size_t sent = 0; sent < RINGBUF_TOTAL_SIZE; sent += sizeof(item)) {
+        xRingbufferSend(bench.ringbuf, item, sizeof(item), portMAX_DELAY);
+    }
+    xSemaphoreTake(bench.done, portMAX_DELAY);
+    int64_t us = esp_timer_get_time() - start;
+    perf_benchmark_report("ringbuf_throughput", perf_benchmark_kib_per_s(RINGBUF_TOTAL_SIZE, us), "KiB/s");
+
+    vTaskDelay(1); // let the consumer task delete itself
+    vRingbufferDelete(bench.ringbuf);
+    vSemaphoreDelete(bench.done);
+}
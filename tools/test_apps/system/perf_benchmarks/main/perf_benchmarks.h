@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Print the result of a benchmark as a JSON object, which is parsed by pytest_perf_benchmarks.py
+ *
+ * @param name  Name of the result, unique within the app
+ * @param value Measured value
+ * @param unit  Unit of the value
+ */
+void perf_benchmark_report(const char *name, double value, const char *unit);
+
+/* Convert a number of bytes transferred in a number of microseconds to KiB/s */
+static inline double perf_benchmark_kib_per_s(uint64_t bytes, int64_t us)
+{
+    return (double)bytes * 1000000.0 / 1024.0 / (double)us;
+}
+
+void bench_heap(void);
+void bench_queue(void);
+void bench_event(void);
+void bench_timer(void);
+void bench_ringbuf(void);
+void bench_nvs(void);
+void bench_fatfs(void);
+void bench_lwip(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "esp_idf_version.h"
+#include "esp_system.h"
+#include "perf_benchmarks.h"
+
+typedef struct {
+    const char *name;
+    void (*func)(void);
+} benchmark_t;
+
+static const benchmark_t s_benchmarks[] = {
+    { "heap",       bench_heap },
+    { "queue",      bench_queue },
+    { "esp_event",  bench_event },
+    { "esp_timer",  bench_timer },
+    { "ringbuf",    bench_ringbuf },
+    { "nvs",        bench_nvs },
+    { "fatfs",      bench_fatfs },
+    { "lwip",       bench_lwip },
+};
+
+void perf_benchmark_report(const char *name, double value, const char *unit)
+{
+    printf("[perf_benchmark] {\"name\": \"%s\", \"value\": %.2f, \"unit\": \"%s\"}\n", name, value, unit);
+}
+
+void app_main(void)
+{
+    printf("[perf_benchmark_info] {\"target\": \"%s\", \"idf_version\": \"%s\", \"cpu_freq_mhz\": %d}\n",
+           CONFIG_IDF_TARGET, esp_get_idf_version(), CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+
+    for (int i = 0; i < sizeof(s_benchmarks) / sizeof(s_benchmarks[0]); i++) {
+        printf("Running %s benchmarks\n", s_benchmarks[i].name);
+        s_benchmarks[i].func();
+    }
+    printf("[perf_benchmark] done\n");
+}
@@ -0,0 +1,45 @@
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: CC0-1.0
+import json
+import logging
+import os
+import re
+from typing import Callable
+
+import pytest
+from pytest_embedded import Dut
+
+RESULT_PATTERN = re.compile(rb'\[perf_benchmark\] (\{.*\}|done)\r?\n')
+INFO_PATTERN = re.compile(rb'\[perf_benchmark_info\] (\{.*\})\r?\n')
+
+
+@pytest.mark.generic
+@pytest.mark.esp32
+@pytest.mark.esp32s2
+@pytest.mark.esp32s3
+@pytest.mark.esp32c3
+@pytest.mark.esp32c6
+@pytest.mark.esp32h2
+@pytest.mark.parametrize('config', [
+    'default',
+    'flash_placement',
+    'opt_perf',
+], indirect=True)
+def test_perf_benchmarks(dut: Dut, config: str, log_performance: Callable[[str, str], None]) -> None:
+    report = json.loads(dut.expect(INFO_PATTERN, timeout=30).group(1))
+    report['config'] = config
+    report['results'] = []
+
+    while True:
+        match = dut.expect(RESULT_PATTERN, timeout=120).group(1)
+        if match == b'done':
+            break
+        result = json.loads(match)
+        report['results'].append(result)
+        log_performance(result['name'], '{} {}'.format(result['value'], result['unit']))
+
+    # One file per chip and config, to be compared between IDF versions or configs
+    report_file = os.path.join(dut.logdir, 'perf_benchmarks_{}_{}.json'.format(report['target'], config))
+    with open(report_file, 'w') as f:
+        json.dump(report, f, indent=4)
+    logging.info('Benchmark results written to %s', report_file)